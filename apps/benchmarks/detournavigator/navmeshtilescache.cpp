@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <random>
 
 namespace
@@ -266,6 +267,46 @@ namespace
     {
         setToBoundedNonEmptyCache<64 * 1024 * 1024>(state);
     }
+
+    struct SharedCache
+    {
+        NavMeshTilesCache mCache;
+        std::vector<Key> mKeys;
+
+        explicit SharedCache(std::size_t shards)
+            : mCache(16 * 1024 * 1024, shards)
+        {
+            std::minstd_rand random;
+            fillCache(std::back_inserter(mKeys), random, mCache);
+            generateKeys(std::back_inserter(mKeys), mKeys.size() * 3 / 10, random);
+        }
+    };
+
+    std::unique_ptr<SharedCache> sharedCache;
+
+    // Every thread does a mix of lookups and inserts on the same cache like async navmesh workers do
+    void getAndSetFromSharedCache(benchmark::State& state)
+    {
+        if (state.thread_index() == 0)
+            sharedCache = std::make_unique<SharedCache>(static_cast<std::size_t>(state.range(0)));
+
+        std::size_t n = static_cast<std::size_t>(state.thread_index()) * 7919;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            const auto& key = sharedCache->mKeys[n++ % sharedCache->mKeys.size()];
+            auto result = sharedCache->mCache.get(key.mAgentBounds, key.mTilePosition, key.mRecastMesh);
+            if (!result)
+                result = sharedCache->mCache.set(
+                    key.mAgentBounds, key.mTilePosition, key.mRecastMesh, std::make_unique<PreparedNavMeshData>());
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+
+        if (state.thread_index() == 0)
+            state.counters["hitRate"] = static_cast<double>(sharedCache->mCache.getStats().mHitCount)
+                / static_cast<double>(std::max<std::size_t>(sharedCache->mCache.getStats().mGetCount, 1));
+    }
 } // namespace
 
 BENCHMARK(getFromFilledCache_1m_100hit);
@@ -280,5 +321,6 @@ BENCHMARK(setToBoundedNonEmptyCache_1m);
 BENCHMARK(setToBoundedNonEmptyCache_4m);
 BENCHMARK(setToBoundedNonEmptyCache_16m);
 BENCHMARK(setToBoundedNonEmptyCache_64m);
+BENCHMARK(getAndSetFromSharedCache)->Arg(1)->Arg(16)->ThreadRange(1, 8)->UseRealTime();
 
 BENCHMARK_MAIN();
@@ -1,11 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include "components/esm/refid.hpp"
+#include "components/misc/strings/lower.hpp"
 
 #include <algorithm>
 #include <cstddef>
+#include <map>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -99,6 +102,76 @@ namespace
         return generateSerializedRefIds(generateESM3ExteriorCellRefIds(random), serialize);
     }
 
+    template <class Random>
+    std::vector<std::string> generateStrings(std::size_t size, Random& random)
+    {
+        std::vector<std::string> result;
+        result.reserve(refIdsCount);
+        std::generate_n(std::back_inserter(result), refIdsCount, [&] { return generateText(size, random); });
+        return result;
+    }
+
+    void constructStringRefId(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateStrings(state.range(0), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(ESM::RefId::stringRefId(values[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    void compareStringRefIdWithString(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateStringRefIds(state.range(0), random);
+        const std::vector<std::string> values = generateSerializedRefIds(
+            refIds, [](ESM::RefId v) { return Misc::StringUtils::lowerCase(v.getRefIdString()); });
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(refIds[i] == values[i]);
+            if (++i >= refIds.size())
+                i = 0;
+        }
+    }
+
+    // Same container as used by Store<T> for the records
+    void findInUnorderedMapByRefId(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateStringRefIds(state.range(0), random);
+        std::unordered_map<ESM::RefId, std::size_t> map;
+        for (std::size_t i = 0; i < refIds.size(); i += 2)
+            map.emplace(refIds[i], i);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(refIds[i]));
+            if (++i >= refIds.size())
+                i = 0;
+        }
+    }
+
+    void findInMapByRefId(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateStringRefIds(state.range(0), random);
+        std::map<ESM::RefId, std::size_t> map;
+        for (std::size_t i = 0; i < refIds.size(); i += 2)
+            map.emplace(refIds[i], i);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(refIds[i]));
+            if (++i >= refIds.size())
+                i = 0;
+        }
+    }
+
     void serializeRefId(benchmark::State& state)
     {
         std::minstd_rand random;
@@ -235,6 +308,11 @@ namespace
     }
 }
 
+BENCHMARK(constructStringRefId)->RangeMultiplier(4)->Range(8, 64);
+BENCHMARK(constructStringRefId)->Arg(32)->ThreadRange(2, 8);
+BENCHMARK(compareStringRefIdWithString)->RangeMultiplier(4)->Range(8, 64);
+BENCHMARK(findInUnorderedMapByRefId)->RangeMultiplier(4)->Range(8, 64);
+BENCHMARK(findInMapByRefId)->RangeMultiplier(4)->Range(8, 64);
 BENCHMARK(serializeRefId)->RangeMultiplier(4)->Range(8, 64);
 BENCHMARK(deserializeRefId)->RangeMultiplier(4)->Range(8, 64);
 BENCHMARK(serializeTextStringRefId)->RangeMultiplier(4)->Range(8, 64);
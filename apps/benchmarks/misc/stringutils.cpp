@@ -0,0 +1,199 @@
+#include <benchmark/benchmark.h>
+
+#include "components/misc/strings/algorithm.hpp"
+#include "components/misc/strings/lower.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t valuesCount = 64 * 1024;
+
+    // Parts of record ids and file names from Morrowind and its expansions
+    constexpr std::string_view idPrefixes[] = { "ex_", "in_", "furn_", "flora_", "misc_", "terrain_", "active_",
+        "light_", "contain_", "de_", "Ex_", "In_", "T_Dae_", "AB_", "BM_", "Furn_De_" };
+    constexpr std::string_view idParts[] = { "hlaalu", "redoran", "telvanni", "imp", "dwrv", "velothi", "nord",
+        "ashland", "bc", "ac", "mh", "common", "Bench", "Crate", "Barrel", "Wall", "Door", "Tower", "Strongh",
+        "Cave", "Rock", "Tree", "Kelp", "Bannerpole", "Lamp", "Statue" };
+    constexpr std::string_view pathDirectories[] = { "meshes/", "textures/", "icons/", "sound/fx/", "meshes/x/",
+        "meshes/i/", "meshes/f/", "meshes/tr/x/", "textures/tr/", "meshes/base_anim/" };
+    constexpr std::string_view pathExtensions[] = { ".nif", ".dds", ".tga", ".kf", ".wav" };
+
+    template <class Random, std::size_t size>
+    std::string_view pick(const std::string_view (&values)[size], Random& random)
+    {
+        return values[std::uniform_int_distribution<std::size_t>(0, size - 1)(random)];
+    }
+
+    template <class Random>
+    std::string generateId(Random& random)
+    {
+        std::string result(pick(idPrefixes, random));
+        const std::size_t parts = std::uniform_int_distribution<std::size_t>(1, 4)(random);
+        for (std::size_t i = 0; i < parts; ++i)
+        {
+            if (i != 0)
+                result += '_';
+            result += pick(idParts, random);
+        }
+        result += '_';
+        result += std::to_string(std::uniform_int_distribution<int>(1, 20)(random));
+        return result;
+    }
+
+    template <class Random>
+    std::string generatePath(Random& random)
+    {
+        std::string id = generateId(random);
+        Misc::StringUtils::lowerCaseInPlace(id);
+        return std::string(pick(pathDirectories, random)) + id + std::string(pick(pathExtensions, random));
+    }
+
+    std::string randomizeCase(std::string_view value, std::minstd_rand& random)
+    {
+        std::string result(value);
+        std::bernoulli_distribution distribution(0.5);
+        for (char& c : result)
+            if (c >= 'a' && c <= 'z' && distribution(random))
+                c = static_cast<char>(c - 'a' + 'A');
+        return result;
+    }
+
+    std::vector<std::string> generateValues(std::int64_t corpus, std::minstd_rand& random)
+    {
+        std::vector<std::string> result;
+        result.reserve(valuesCount);
+        std::generate_n(std::back_inserter(result), valuesCount,
+            [&] { return corpus == 0 ? generateId(random) : generatePath(random); });
+        return result;
+    }
+
+    // Implementations before they processed blocks of bytes, to compare with
+    bool scalarCiEqual(std::string_view x, std::string_view y)
+    {
+        return x.size() == y.size()
+            && std::equal(x.begin(), x.end(), y.begin(), [](char l, char r) {
+                   return Misc::StringUtils::toLower(l) == Misc::StringUtils::toLower(r);
+               });
+    }
+
+    bool scalarCiLess(std::string_view x, std::string_view y)
+    {
+        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), Misc::StringUtils::CiCharLess());
+    }
+
+    std::string scalarLowerCase(std::string_view value)
+    {
+        std::string result(value);
+        for (char& c : result)
+            c = Misc::StringUtils::toLower(c);
+        return result;
+    }
+
+    template <class Compare>
+    void compareEqualValues(benchmark::State& state, Compare&& compare)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateValues(state.range(0), random);
+        std::vector<std::string> others;
+        others.reserve(values.size());
+        for (const std::string& value : values)
+            others.push_back(randomizeCase(value, random));
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(compare(values[i], others[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    // Neighbours in a sorted corpus share long prefixes, like the keys of a std::map do
+    template <class Compare>
+    void compareSortedValues(benchmark::State& state, Compare&& compare)
+    {
+        std::minstd_rand random;
+        std::vector<std::string> values = generateValues(state.range(0), random);
+        std::sort(values.begin(), values.end(), scalarCiLess);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(compare(values[i], values[i + 1]));
+            if (++i + 1 >= values.size())
+                i = 0;
+        }
+    }
+
+    template <class Lower>
+    void lowerValues(benchmark::State& state, Lower&& lower)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateValues(state.range(0), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(lower(values[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    void ciEqual(benchmark::State& state)
+    {
+        compareEqualValues(state, [](std::string_view x, std::string_view y) {
+            return Misc::StringUtils::ciEqual(x, y);
+        });
+    }
+
+    void ciEqualScalar(benchmark::State& state)
+    {
+        compareEqualValues(state, [](std::string_view x, std::string_view y) { return scalarCiEqual(x, y); });
+    }
+
+    void ciLess(benchmark::State& state)
+    {
+        compareSortedValues(state, [](std::string_view x, std::string_view y) {
+            return Misc::StringUtils::ciLess(x, y);
+        });
+    }
+
+    void ciLessScalar(benchmark::State& state)
+    {
+        compareSortedValues(state, [](std::string_view x, std::string_view y) { return scalarCiLess(x, y); });
+    }
+
+    void ciFind(benchmark::State& state)
+    {
+        compareSortedValues(state, [](std::string_view x, std::string_view y) {
+            return Misc::StringUtils::ciFind(x, y.substr(y.size() / 2));
+        });
+    }
+
+    void lowerCase(benchmark::State& state)
+    {
+        lowerValues(state, [](std::string_view value) { return Misc::StringUtils::lowerCase(value); });
+    }
+
+    void lowerCaseScalar(benchmark::State& state)
+    {
+        lowerValues(state, [](std::string_view value) { return scalarLowerCase(value); });
+    }
+}
+
+// Argument 0 is for the corpus of record ids, 1 is for the corpus of paths
+BENCHMARK(ciEqual)->DenseRange(0, 1);
+BENCHMARK(ciEqualScalar)->DenseRange(0, 1);
+BENCHMARK(ciLess)->DenseRange(0, 1);
+BENCHMARK(ciLessScalar)->DenseRange(0, 1);
+BENCHMARK(ciFind)->DenseRange(0, 1);
+BENCHMARK(lowerCase)->DenseRange(0, 1);
+BENCHMARK(lowerCaseScalar)->DenseRange(0, 1);
+
+BENCHMARK_MAIN();
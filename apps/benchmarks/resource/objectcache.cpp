@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <components/resource/objectcache.hpp>
+
+#include <osg/Object>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t pathsCount = 4096;
+
+    struct Object : osg::Object
+    {
+        Object() = default;
+
+        Object(const Object& other, const osg::CopyOp& copyOp = osg::CopyOp())
+            : osg::Object(other, copyOp)
+        {
+        }
+
+        META_Object(ResourceBenchmark, Object)
+    };
+
+    const std::vector<std::string>& getPaths()
+    {
+        static const std::vector<std::string> paths = [] {
+            std::vector<std::string> result;
+            result.reserve(pathsCount);
+            for (std::size_t i = 0; i < pathsCount; ++i)
+                result.push_back("meshes/x/ex_common_building_" + std::to_string(i) + ".nif");
+            return result;
+        }();
+        return paths;
+    }
+
+    template <class Cache>
+    Cache& getCache()
+    {
+        static const osg::ref_ptr<Cache> cache = [] {
+            osg::ref_ptr<Cache> result(new Cache);
+            for (const std::string& path : getPaths())
+                result->addEntryToObjectCache(path, new Object);
+            return result;
+        }();
+        return *cache;
+    }
+
+    // Mostly lookups of already loaded objects with an occasional insertion, like preloading cells while the main
+    // thread keeps requesting what is already there
+    template <class Cache>
+    void getRefFromObjectCache(benchmark::State& state)
+    {
+        Cache& cache = getCache<Cache>();
+        const std::vector<std::string>& paths = getPaths();
+        std::minstd_rand random(static_cast<unsigned>(state.thread_index()));
+        std::uniform_int_distribution<std::size_t> distribution(0, paths.size() - 1);
+        std::size_t i = 0;
+
+        for (auto _ : state)
+        {
+            const std::string& path = paths[distribution(random)];
+            if (++i % 64 == 0)
+                cache.addEntryToObjectCache(path, new Object);
+            else
+                benchmark::DoNotOptimize(cache.getRefFromObjectCache(path));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    using SingleShardCache = Resource::GenericObjectCache<std::string, 1>;
+    using ShardedCache = Resource::GenericObjectCache<std::string>;
+}
+
+BENCHMARK_TEMPLATE(getRefFromObjectCache, SingleShardCache)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(getRefFromObjectCache, ShardedCache)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/skinning.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    // Similar to a body part of a humanoid: every vertex is influenced by up to 4 of the skeleton bones and
+    // neighbouring vertices often share the same influences
+    constexpr std::size_t boneCount = 40;
+    constexpr std::size_t verticesPerGroup = 8;
+
+    struct Mesh
+    {
+        SkinningInfluences mInfluences;
+        std::vector<osg::Matrixf> mBones;
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mNormals;
+    };
+
+    Mesh makeMesh(std::size_t vertexCount, std::size_t influencesPerVertex)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::uniform_int_distribution<std::size_t> boneDistribution(0, boneCount - 1);
+
+        Mesh result;
+        for (std::size_t i = 0; i < boneCount; ++i)
+            result.mBones.push_back(osg::Matrixf::rotate(distribution(random), osg::Vec3f(0, 0, 1))
+                * osg::Matrixf::translate(distribution(random), distribution(random), distribution(random)));
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            result.mPositions.emplace_back(distribution(random), distribution(random), distribution(random));
+            result.mNormals.emplace_back(distribution(random), distribution(random), distribution(random));
+        }
+
+        std::vector<std::pair<std::size_t, float>> weights(influencesPerVertex);
+        std::vector<unsigned short> vertices;
+        for (std::size_t first = 0; first < vertexCount; first += verticesPerGroup)
+        {
+            for (auto& [bone, weight] : weights)
+            {
+                bone = boneDistribution(random);
+                weight = 1.0f / influencesPerVertex;
+            }
+            vertices.clear();
+            for (std::size_t i = first; i < std::min(first + verticesPerGroup, vertexCount); ++i)
+                vertices.push_back(static_cast<unsigned short>(i));
+            result.mInfluences.addGroup(weights, vertices);
+        }
+
+        return result;
+    }
+
+    void skin(benchmark::State& state)
+    {
+        const Mesh mesh = makeMesh(state.range(0), state.range(1));
+        const osg::Matrixf transform = osg::Matrixf::translate(0, 0, 1);
+        std::vector<SkinningMatrix> matrices;
+        std::vector<osg::Vec3f> positions(mesh.mPositions.size());
+        std::vector<osg::Vec3f> normals(mesh.mNormals.size());
+
+        for (auto _ : state)
+        {
+            blendSkinningMatrices(mesh.mInfluences, mesh.mBones, transform, matrices);
+            skinPositions(mesh.mInfluences, matrices, mesh.mPositions, positions);
+            skinNormals(mesh.mInfluences, matrices, mesh.mNormals, normals);
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::DoNotOptimize(normals.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(skin)->ArgsProduct({ { 1000, 4000, 16000 }, { 1, 2, 4 } });
+
+BENCHMARK_MAIN();
@@ -0,0 +1,420 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm3/cellref.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esmterrain/storage.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/nif/data.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nif/node.hpp>
+#include <components/nifbullet/bulletnifloader.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
+
+#include <osg/Array>
+#include <osg/Image>
+#include <osg/Node>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Everything a cell load does on the loading threads, without the game world around it: reading the references
+    // of a cell record, converting its meshes into scene graphs and collision shapes, making instances of them and
+    // building the terrain chunks. Run with OPENMW_BENCHMARK_DATA pointing to a data directory to also measure the
+    // meshes of an actual game.
+
+    constexpr std::size_t refIdsCount = 64;
+
+    std::string makeCellRecord(std::size_t refsCount)
+    {
+        ESM::Cell cell;
+        cell.blank();
+        cell.mData.mX = 2;
+        cell.mData.mY = -3;
+
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+        writer.save();
+        writer.startRecord(ESM::REC_CELL);
+        cell.save(writer);
+
+        for (std::size_t i = 0; i < refsCount; ++i)
+        {
+            ESM::CellRef ref;
+            ref.blank();
+            ref.mRefNum.mIndex = static_cast<std::uint32_t>(i + 1);
+            ref.mRefNum.mContentFile = 0;
+            ref.mRefID = ESM::RefId::stringRefId("ex_common_building_" + std::to_string(i % refIdsCount));
+            ref.mPos.pos[0] = static_cast<float>(i % 64) * 128.0f;
+            ref.mPos.pos[1] = static_cast<float>(i / 64) * 128.0f;
+            ref.mPos.rot[2] = static_cast<float>(i % 7);
+            ref.save(writer);
+        }
+
+        writer.endRecord(ESM::REC_CELL);
+        writer.close();
+        return writer.takeData();
+    }
+
+    // The same reading CellStore::load does for every content file contributing to a cell
+    void loadCellRefs(benchmark::State& state)
+    {
+        const std::string data = makeCellRecord(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            ESM::ESMReader reader;
+            reader.open(std::make_unique<Files::IMemStream>(data.data(), data.size()), "stream");
+            reader.getRecName();
+            reader.getRecHeader();
+
+            ESM::Cell cell;
+            bool deleted = false;
+            cell.load(reader, deleted, false);
+
+            ESM::CellRef ref;
+            std::size_t count = 0;
+            while (ESM::Cell::getNextRef(reader, ref, deleted))
+            {
+                benchmark::DoNotOptimize(ref);
+                ++count;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // A static made of shapesCount grids of gridSize x gridSize vertices, roughly what a building of the base game is
+    std::unique_ptr<Nif::NIFFile> makeNifFile(std::size_t shapesCount, std::size_t gridSize)
+    {
+        constexpr VFS::Path::NormalizedView path("meshes/benchmark.nif");
+
+        auto file = std::make_unique<Nif::NIFFile>(path);
+        file->mVersion = Nif::NIFFile::VER_MW;
+        file->mHash = "benchmark";
+
+        const auto init = [](Nif::NiAVObject& object) {
+            object.mExtra = Nif::ExtraPtr(nullptr);
+            object.mController = Nif::NiTimeControllerPtr(nullptr);
+            object.mFlags = 0;
+            object.mTransform = Nif::NiTransform::getIdentity();
+            object.mCollision = Nif::NiCollisionObjectPtr(nullptr);
+        };
+
+        Nif::NiNode* const root = file->mArena.create<Nif::NiNode>();
+        root->recType = Nif::RC_NiNode;
+        root->mName = "root";
+        init(*root);
+        file->mRecords.push_back(root);
+        file->mRoots.push_back(root);
+
+        for (std::size_t i = 0; i < shapesCount; ++i)
+        {
+            Nif::NiTriShapeData* const data = file->mArena.create<Nif::NiTriShapeData>();
+            data->recType = Nif::RC_NiTriShapeData;
+            for (std::size_t y = 0; y < gridSize; ++y)
+            {
+                for (std::size_t x = 0; x < gridSize; ++x)
+                {
+                    const float height = 16.0f * std::sin(static_cast<float>(x + i)) * std::cos(static_cast<float>(y));
+                    data->mVertices.emplace_back(x * 32.0f, y * 32.0f, height + i * 64.0f);
+                    data->mNormals.emplace_back(0, 0, 1);
+                }
+            }
+            for (std::size_t y = 0; y + 1 < gridSize; ++y)
+            {
+                for (std::size_t x = 0; x + 1 < gridSize; ++x)
+                {
+                    const auto index = static_cast<unsigned short>(y * gridSize + x);
+                    const auto side = static_cast<unsigned short>(gridSize);
+                    data->mTriangles.insert(data->mTriangles.end(),
+                        { index, static_cast<unsigned short>(index + 1), static_cast<unsigned short>(index + side),
+                            static_cast<unsigned short>(index + 1), static_cast<unsigned short>(index + side + 1),
+                            static_cast<unsigned short>(index + side) });
+                }
+            }
+            data->mNumVertices = static_cast<std::uint16_t>(data->mVertices.size());
+            data->mNumTriangles = static_cast<std::uint16_t>(data->mTriangles.size() / 3);
+            file->mRecords.push_back(data);
+
+            Nif::NiTriShape* const shape = file->mArena.create<Nif::NiTriShape>();
+            shape->recType = Nif::RC_NiTriShape;
+            shape->mName = "shape" + std::to_string(i);
+            init(*shape);
+            shape->mData = Nif::NiGeometryDataPtr(data);
+            shape->mSkin = Nif::NiSkinInstancePtr(nullptr);
+            shape->mShaderProperty = Nif::BSShaderPropertyPtr(nullptr);
+            shape->mAlphaProperty = Nif::NiAlphaPropertyPtr(nullptr);
+            shape->mParents.push_back(root);
+            file->mRecords.push_back(shape);
+
+            root->mChildren.push_back(Nif::NiAVObjectPtr(shape));
+        }
+
+        return file;
+    }
+
+    struct NifResources
+    {
+        VFS::Manager mVfs;
+        Resource::ImageManager mImageManager{ &mVfs, 0 };
+        Resource::BgsmFileManager mMaterialManager{ &mVfs, 0 };
+    };
+
+    void convertNif(benchmark::State& state)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = makeNifFile(static_cast<std::size_t>(state.range(0)), 8);
+        NifResources resources;
+
+        for (auto _ : state)
+        {
+            osg::ref_ptr<osg::Node> node
+                = NifOsg::Loader::load(*file, &resources.mImageManager, &resources.mMaterialManager);
+            benchmark::DoNotOptimize(node);
+        }
+    }
+
+    void loadNifCollision(benchmark::State& state)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = makeNifFile(static_cast<std::size_t>(state.range(0)), 8);
+
+        for (auto _ : state)
+        {
+            NifBullet::BulletNifLoader loader;
+            osg::ref_ptr<Resource::BulletShape> shape = loader.load(*file);
+            benchmark::DoNotOptimize(shape);
+        }
+    }
+
+    // What every reference of an already loaded mesh costs
+    void instantiateNif(benchmark::State& state)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = makeNifFile(static_cast<std::size_t>(state.range(0)), 8);
+        NifResources resources;
+        const osg::ref_ptr<osg::Node> base
+            = NifOsg::Loader::load(*file, &resources.mImageManager, &resources.mMaterialManager);
+
+        for (auto _ : state)
+        {
+            osg::ref_ptr<osg::Node> instance = Resource::SceneManager::cloneNode(base);
+            benchmark::DoNotOptimize(instance);
+        }
+    }
+
+    class TerrainStorage final : public ESMTerrain::Storage
+    {
+    public:
+        explicit TerrainStorage(const VFS::Manager* vfs)
+            : ESMTerrain::Storage(vfs)
+        {
+            constexpr int dataTypes
+                = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+
+            ESM::Land land;
+            land.add(dataTypes);
+            ESM::Land::LandData& data = *land.getLandData();
+
+            data.mMinHeight = 0;
+            data.mMaxHeight = 0;
+            for (int row = 0; row < ESM::Land::LAND_SIZE; ++row)
+            {
+                for (int col = 0; col < ESM::Land::LAND_SIZE; ++col)
+                {
+                    const std::size_t index = static_cast<std::size_t>(row * ESM::Land::LAND_SIZE + col);
+                    const float height = 1024.0f * std::sin(col / 9.0f) * std::cos(row / 7.0f);
+                    data.mHeights[index] = height;
+                    data.mMinHeight = std::min(data.mMinHeight, height);
+                    data.mMaxHeight = std::max(data.mMaxHeight, height);
+                    data.mNormals[3 * index] = 0;
+                    data.mNormals[3 * index + 1] = 0;
+                    data.mNormals[3 * index + 2] = 127;
+                    data.mColours[3 * index] = 255;
+                    data.mColours[3 * index + 1] = static_cast<std::uint8_t>(col * 3);
+                    data.mColours[3 * index + 2] = static_cast<std::uint8_t>(row * 3);
+                }
+            }
+            for (std::size_t i = 0; i < data.mTextures.size(); ++i)
+                data.mTextures[i] = static_cast<std::uint16_t>((i * 7 + i / 16) % (mTextures.size() + 1));
+
+            mLand = new ESMTerrain::LandObject(land, dataTypes);
+        }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(ESM::ExteriorCellLocation /*cellLocation*/) override
+        {
+            return mLand;
+        }
+
+        const std::string* getLandTexture(std::uint16_t index, int /*plugin*/) override
+        {
+            if (index >= mTextures.size())
+                return nullptr;
+            return &mTextures[index];
+        }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY, ESM::RefId /*worldspace*/) override
+        {
+            minX = -16;
+            maxX = 16;
+            minY = -16;
+            maxY = 16;
+        }
+
+    private:
+        const std::vector<std::string> mTextures{
+            "textures/tx_ai_grass_01.dds",
+            "textures/tx_ai_dirt_01.dds",
+            "textures/tx_ai_mudflats_01.dds",
+            "textures/tx_bc_moss.dds",
+        };
+        osg::ref_ptr<const ESMTerrain::LandObject> mLand;
+    };
+
+    // ChunkManager::createChunk fills the vertex buffers of every chunk, state.range(0) is the LOD level
+    void fillTerrainVertexBuffers(benchmark::State& state)
+    {
+        VFS::Manager vfs;
+        TerrainStorage storage(&vfs);
+        const int lodLevel = static_cast<int>(state.range(0));
+
+        for (auto _ : state)
+        {
+            osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array;
+            osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array;
+            osg::ref_ptr<osg::Vec4ubArray> colours = new osg::Vec4ubArray;
+            storage.fillVertexBuffers(lodLevel, 1.0f, osg::Vec2f(0.5f, 0.5f), ESM::Cell::sDefaultWorldspaceId,
+                *positions, *normals, *colours);
+            benchmark::DoNotOptimize(positions);
+        }
+    }
+
+    void getTerrainBlendmaps(benchmark::State& state)
+    {
+        VFS::Manager vfs;
+        TerrainStorage storage(&vfs);
+        const float chunkSize = 1.0f / static_cast<float>(state.range(0));
+
+        for (auto _ : state)
+        {
+            // Blendmaps are cached, a chunk seen for the first time is what loading a cell pays for
+            storage.clearCache();
+            Terrain::Storage::ImageVector blendmaps;
+            std::vector<Terrain::LayerInfo> layers;
+            storage.getBlendmaps(chunkSize, osg::Vec2f(chunkSize / 2, chunkSize / 2), blendmaps, layers,
+                ESM::Cell::sDefaultWorldspaceId);
+            benchmark::DoNotOptimize(blendmaps);
+        }
+    }
+
+    struct DataSet
+    {
+        VFS::Manager mVfs;
+        std::vector<VFS::Path::Normalized> mMeshes;
+    };
+
+    constexpr std::size_t maxDataSetMeshes = 256;
+
+    std::unique_ptr<DataSet> openDataSet(const std::filesystem::path& path)
+    {
+        auto result = std::make_unique<DataSet>();
+        result->mVfs.addArchive(std::make_unique<VFS::FileSystemArchive>(path));
+        result->mVfs.buildIndex();
+
+        for (const VFS::Path::Normalized& file : result->mVfs.getRecursiveDirectoryIterator("meshes/"))
+        {
+            if (!file.view().ends_with(".nif"))
+                continue;
+            result->mMeshes.push_back(file);
+            if (result->mMeshes.size() == maxDataSetMeshes)
+                break;
+        }
+
+        return result;
+    }
+
+    // A cold load of every mesh of the data set: nothing is cached, like meshes of a cell visited for the first time
+    void loadDataSetMeshes(benchmark::State& state, const DataSet& dataSet)
+    {
+        Resource::ImageManager imageManager(&dataSet.mVfs, 0);
+        Resource::BgsmFileManager materialManager(&dataSet.mVfs, 0);
+        std::size_t failed = 0;
+
+        for (auto _ : state)
+        {
+            for (const VFS::Path::Normalized& path : dataSet.mMeshes)
+            {
+                try
+                {
+                    Nif::NIFFile file(path);
+                    Nif::Reader reader(file, nullptr);
+                    reader.parse(dataSet.mVfs.get(path));
+
+                    osg::ref_ptr<osg::Node> node = NifOsg::Loader::load(file, &imageManager, &materialManager);
+                    benchmark::DoNotOptimize(node);
+
+                    NifBullet::BulletNifLoader loader;
+                    osg::ref_ptr<Resource::BulletShape> shape = loader.load(file);
+                    benchmark::DoNotOptimize(shape);
+                }
+                catch (const std::exception&)
+                {
+                    ++failed;
+                }
+            }
+        }
+
+        state.counters["failed"] = static_cast<double>(failed) / state.iterations();
+        state.SetItemsProcessed(state.iterations() * dataSet.mMeshes.size());
+    }
+}
+
+BENCHMARK(loadCellRefs)->Arg(100)->Arg(1000)->Arg(10000)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(convertNif)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(loadNifCollision)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(instantiateNif)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(fillTerrainVertexBuffers)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(getTerrainBlendmaps)->Arg(1)->Arg(2)->Arg(4);
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+
+    std::unique_ptr<DataSet> dataSet;
+    if (const char* path = std::getenv("OPENMW_BENCHMARK_DATA"))
+    {
+        dataSet = openDataSet(path);
+        if (dataSet->mMeshes.empty())
+            std::cerr << "No meshes found in " << path << std::endl;
+        else
+            benchmark::RegisterBenchmark("loadDataSetMeshes", loadDataSetMeshes, std::cref(*dataSet))
+                ->Unit(benchmark::kMillisecond);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
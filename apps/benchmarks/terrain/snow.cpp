@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <components/terrain/buffercache.hpp>
+#include <components/terrain/subdivisiontracker.hpp>
+#include <components/terrain/terrainsubdivider.hpp>
+
+#include <osg/Geometry>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+namespace
+{
+    // Same layout as a ChunkManager chunk at LOD 0: Morrowind cells have 65 vertices on a side,
+    // so a quarter cell chunk has 17 and a half cell chunk 33
+    constexpr float cellWorldSize = 8192.0f;
+    constexpr unsigned cellVertices = 65;
+
+    osg::ref_ptr<osg::Geometry> makeLandChunk(Terrain::BufferCache& bufferCache, unsigned numVerts)
+    {
+        const float chunkWorldSize = cellWorldSize * (numVerts - 1) / (cellVertices - 1);
+        const float spacing = chunkWorldSize / (numVerts - 1);
+
+        osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec4ubArray> colors = new osg::Vec4ubArray;
+        positions->reserve(numVerts * numVerts);
+        normals->reserve(numVerts * numVerts);
+        colors->reserve(numVerts * numVerts);
+
+        for (unsigned col = 0; col < numVerts; ++col)
+        {
+            for (unsigned row = 0; row < numVerts; ++row)
+            {
+                const float x = row * spacing - chunkWorldSize / 2;
+                const float y = col * spacing - chunkWorldSize / 2;
+                const float height = 512.0f * std::sin(x / 1500.0f) * std::cos(y / 1100.0f);
+                positions->push_back(osg::Vec3f(x, y, height));
+
+                osg::Vec3f normal(-std::cos(x / 1500.0f) / 3.0f, std::sin(y / 1100.0f) / 2.0f, 1.0f);
+                normal.normalize();
+                normals->push_back(normal);
+
+                colors->push_back(osg::Vec4ub(255, 255, 255, 255));
+            }
+        }
+
+        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+        geometry->setVertexArray(positions);
+        geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+        geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+        geometry->setTexCoordArray(0, bufferCache.getUVBuffer(numVerts), osg::Array::BIND_PER_VERTEX);
+        geometry->addPrimitiveSet(bufferCache.getIndexBuffer(numVerts, 0));
+        return geometry;
+    }
+
+    void subdivide(benchmark::State& state)
+    {
+        Terrain::BufferCache bufferCache;
+        const osg::ref_ptr<osg::Geometry> chunk = makeLandChunk(bufferCache, static_cast<unsigned>(state.range(0)));
+        const int levels = static_cast<int>(state.range(1));
+
+        for (auto _ : state)
+        {
+            osg::ref_ptr<osg::Geometry> result = Terrain::TerrainSubdivider::subdivide(chunk.get(), levels);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    void updateTracker(benchmark::State& state)
+    {
+        const int chunkCount = static_cast<int>(state.range(0));
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(chunkCount))));
+        constexpr float chunkWorldSize = cellWorldSize / 4;
+
+        Terrain::SubdivisionTracker tracker;
+        tracker.setMaxTrailDistance(2 * side * chunkWorldSize);
+        // Keep every chunk tracked for the whole run
+        tracker.setMaxTrailTime(1e9f);
+        tracker.setDecayStartTime(1e9f);
+
+        for (int i = 0; i < chunkCount; ++i)
+        {
+            const int x = i % side;
+            const int y = i / side;
+            tracker.markChunkSubdivided(osg::Vec2f((x + 0.5f) / 4, (y + 0.5f) / 4), 1 + i % 3,
+                osg::Vec2f((x + 0.5f) * chunkWorldSize, (y + 0.5f) * chunkWorldSize));
+        }
+
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(0.0f, side * chunkWorldSize);
+
+        for (auto _ : state)
+        {
+            tracker.update(1.0f / 60.0f, osg::Vec2f(distribution(random), distribution(random)));
+            benchmark::DoNotOptimize(tracker.getTrackedChunkCount());
+        }
+
+        state.SetItemsProcessed(state.iterations() * chunkCount);
+    }
+} // namespace
+
+BENCHMARK(subdivide)->ArgsProduct({ { 17, 33 }, { 1, 2, 3 } });
+BENCHMARK(updateTracker)->Arg(1024)->Arg(4096)->Arg(16384);
+
+BENCHMARK_MAIN();
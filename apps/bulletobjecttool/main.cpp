@@ -27,11 +27,13 @@
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <iomanip>
+#include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
@@ -39,6 +41,7 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -89,6 +92,13 @@ namespace
             bpo::value<Fallback::FallbackMap>()->default_value(Fallback::FallbackMap(), "")->multitoken()->composing(),
             "fallback values");
 
+        addOption("threads",
+            bpo::value<std::size_t>()->default_value(std::max<std::size_t>(std::thread::hardware_concurrency() - 1, 1)),
+            "number of threads for parallel processing");
+
+        addOption("write-collision-cache", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "store loaded collision shapes in the cache directory to be used by the engine");
+
         Files::ConfigurationManager::addCommonOptions(result);
 
         return result;
@@ -150,12 +160,22 @@ namespace
         StringsVector contentFiles{ "builtin.omwscripts" };
         const auto& configContentFiles = variables["content"].as<StringsVector>();
         contentFiles.insert(contentFiles.end(), configContentFiles.begin(), configContentFiles.end());
+        const std::size_t threadsNumber = variables["threads"].as<std::size_t>();
+
+        if (threadsNumber < 1)
+        {
+            std::cerr << "Invalid threads number: " << threadsNumber << ", expected >= 1";
+            return -1;
+        }
+
+        const bool writeCollisionCache = variables["write-collision-cache"].as<bool>();
 
         Fallback::Map::init(variables["fallback"].as<Fallback::FallbackMap>().mMap);
 
         VFS::Manager vfs;
 
-        VFS::registerArchives(&vfs, fileCollections, archives, true, &encoder.getStatelessEncoder());
+        VFS::registerArchives(&vfs, fileCollections, archives, true, &encoder.getStatelessEncoder(),
+            config.getCachePath() / "vfsindex.bin");
 
         Settings::Manager::load(config);
 
@@ -177,9 +197,11 @@ namespace
         Resource::BgsmFileManager bgsmFileManager(&vfs, expiryDelay);
         Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager, &bgsmFileManager, expiryDelay);
         Resource::BulletShapeManager bulletShapeManager(&vfs, &sceneManager, &nifFileManager, expiryDelay);
+        if (writeCollisionCache)
+            bulletShapeManager.setShapeCacheDirectory(config.getCachePath() / "collision");
 
-        Resource::forEachBulletObject(
-            readers, vfs, bulletShapeManager, esmData, [](const ESM::Cell& cell, const Resource::BulletObject& object) {
+        Resource::forEachBulletObject(readers, vfs, bulletShapeManager, esmData, threadsNumber,
+            [](const ESM::Cell& cell, const Resource::BulletObject& object) {
                 Log(Debug::Verbose) << "Found bullet object in " << (cell.isExterior() ? "exterior" : "interior")
                                     << " cell \"" << cell.getDescription() << "\":"
                                     << " fileName=\"" << object.mShape->mFileName << '"'
@@ -13,8 +13,10 @@
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace Bsa
@@ -309,6 +311,33 @@ namespace Bsa
                 }));
         }
 
+        TEST(BSAFileTest, getFileShouldReturnContentOfAddedFilesAfterReopen)
+        {
+            const std::filesystem::path path = makeOutputPath();
+            std::filesystem::remove(path);
+
+            {
+                BSAFile file;
+                file.open(path);
+                std::istringstream first("first file content");
+                file.addFile("a", first);
+                std::istringstream second("second");
+                file.addFile("b", second);
+            }
+
+            BSAFile file;
+            file.open(path);
+
+            std::vector<std::string> contents;
+            for (const BSAFile::FileStruct& record : file.getList())
+            {
+                const Files::IStreamPtr stream = file.getFile(&record);
+                contents.emplace_back(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+            }
+
+            EXPECT_THAT(contents, UnorderedElementsAre("first file content", "second"));
+        }
+
 // std::streambuf in MSVC does not support buffers larger than 2**31 - 1:
 // https://developercommunity.visualstudio.com/t/stdbasic-stringbuf-is-broken/290124
 #ifndef _MSC_VER
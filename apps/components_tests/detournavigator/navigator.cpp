@@ -182,6 +182,36 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_path_from_nearby_start_should_reuse_cached_path)
+    {
+        mSettings.mMaxPathCacheSize = 1;
+        mNavigator = std::make_unique<NavigatorImpl>(
+            mSettings, std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max()));
+
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentBounds, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, {}, mOut),
+            Status::Success);
+
+        std::deque<osg::Vec3f> path;
+        EXPECT_EQ(findPath(*mNavigator, mAgentBounds, mStart + osg::Vec3f(1, 1, 0), mEnd, Flag_walk, mAreaCosts,
+                      mEndTolerance, {}, std::back_inserter(path)),
+            Status::Success);
+
+        EXPECT_EQ(path, mPath);
+        const Stats stats = mNavigator->getStats();
+        EXPECT_EQ(stats.mPathCache.mGetCount, 2);
+        EXPECT_EQ(stats.mPathCache.mHitCount, 1);
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, find_path_to_the_start_position_should_contain_single_point)
     {
         const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
@@ -730,6 +760,32 @@ namespace
             << (result ? *result : osg::Vec3f());
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, update_then_batched_raycast_should_return_position_for_each_request)
+    {
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        const std::array requests{
+            RaycastRequest{ osg::Vec3f(57, 460, 1), osg::Vec3f(460, 57, 1) },
+            RaycastRequest{ osg::Vec3f(1e5f, 1e5f, 1), osg::Vec3f(1e5f + 1, 1e5f, 1) },
+            RaycastRequest{ osg::Vec3f(460, 57, 1), osg::Vec3f(57, 460, 1) },
+        };
+        std::array<std::optional<osg::Vec3f>, 3> results;
+        raycast(*mNavigator, mAgentBounds, requests, Flag_walk, results);
+
+        for (std::size_t i = 0; i < requests.size(); ++i)
+            EXPECT_EQ(results[i], raycast(*mNavigator, mAgentBounds, requests[i].mStart, requests[i].mEnd, Flag_walk))
+                << i;
+        EXPECT_TRUE(results[0].has_value());
+        EXPECT_FALSE(results[1].has_value());
+        EXPECT_TRUE(results[2].has_value());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest,
         update_for_oscillating_object_that_does_not_change_navmesh_should_not_trigger_navmesh_update)
     {
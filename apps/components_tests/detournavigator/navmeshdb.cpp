@@ -7,6 +7,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <sqlite3.h>
+
+#include <filesystem>
 #include <limits>
 #include <random>
 
@@ -63,6 +66,15 @@ namespace
         EXPECT_EQ(result->mVersion, version);
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, inserted_tile_should_not_be_found_by_other_input)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 146 }, TileVersion{ 1 });
+        std::vector<std::byte> otherInput = input;
+        otherInput.back() = ~otherInput.back();
+        EXPECT_FALSE(mDb.findTile(worldspace, tilePosition, otherInput).has_value());
+        EXPECT_FALSE(mDb.getTileData(worldspace, tilePosition, otherInput).has_value());
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, inserted_tile_should_change_max_tile_id)
     {
         insertTile(TileId{ 53 }, TileVersion{ 1 });
@@ -167,6 +179,193 @@ namespace
                     << "x=" << x << " y=" << y;
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, committed_write_batch_should_keep_tiles)
+    {
+        mDb.startWriteBatch();
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 53 }, TileVersion{ 1 });
+        EXPECT_EQ(mDb.getWriteBatchSize(), 1);
+        mDb.commitWriteBatch();
+        EXPECT_FALSE(mDb.hasWriteBatch());
+        EXPECT_EQ(mDb.getWriteBatchSize(), 0);
+        EXPECT_TRUE(mDb.findTile(worldspace, tilePosition, input).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, failed_write_in_batch_should_keep_previous_writes)
+    {
+        const TileId tileId{ 53 };
+        const TileVersion version{ 1 };
+        mDb.startWriteBatch();
+        const auto [worldspace, tilePosition, input, data] = insertTile(tileId, version);
+        const ShapeId shapeId{ 13 };
+        const std::string hash = "hash";
+        const Sqlite3::ConstBlob blob{ hash.data(), static_cast<int>(hash.size()) };
+        ASSERT_EQ(mDb.insertShape(shapeId, "name", ShapeType::Collision, blob), 1);
+        EXPECT_THROW(mDb.insertTile(tileId, worldspace, tilePosition, version, input, data), std::runtime_error);
+        EXPECT_FALSE(mDb.hasWriteBatch());
+        EXPECT_TRUE(mDb.findTile(worldspace, tilePosition, input).has_value());
+        EXPECT_TRUE(mDb.hasShapeId(shapeId));
+    }
+
+    TEST(DetourNavigatorNavMeshDbWriteBatchTest, write_batch_to_full_db_should_keep_tiles_that_fit)
+    {
+        NavMeshDb db(":memory:", 4 * 4096);
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TileVersion version{ 1 };
+        std::minstd_rand random;
+        std::vector<std::vector<std::byte>> inputs;
+        db.startWriteBatch();
+        try
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                std::vector<std::byte> input(256);
+                generateRange(input.begin(), input.end(), random);
+                db.insertTile(TileId{ i + 1 }, worldspace, TilePosition{ i, 0 }, version, input, input);
+                inputs.push_back(std::move(input));
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        ASSERT_FALSE(db.hasWriteBatch());
+        ASSERT_LT(inputs.size(), 1000);
+        ASSERT_GT(inputs.size(), 0);
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+            EXPECT_TRUE(db.findTile(worldspace, TilePosition{ static_cast<int>(i), 0 }, inputs[i]).has_value()) << i;
+    }
+
+    TEST(DetourNavigatorNavMeshDbMigrationTest, should_add_input_hash_to_db_with_tiles_looked_up_by_input)
+    {
+        const std::filesystem::path path
+            = std::filesystem::temp_directory_path() / "openmw_components_tests_navmeshdb_migration.db";
+        std::filesystem::remove(path);
+        {
+            sqlite3* db = nullptr;
+            ASSERT_EQ(sqlite3_open(path.string().c_str(), &db), SQLITE_OK);
+            const char* oldSchema = R"(
+                CREATE TABLE tiles (
+                    tile_id INTEGER PRIMARY KEY,
+                    revision INTEGER NOT NULL DEFAULT 1,
+                    worldspace TEXT NOT NULL,
+                    tile_position_x INTEGER NOT NULL,
+                    tile_position_y INTEGER NOT NULL,
+                    version INTEGER NOT NULL,
+                    input BLOB,
+                    data BLOB
+                );
+                CREATE UNIQUE INDEX index_unique_tiles_by_worldspace_and_tile_position_and_input
+                    ON tiles (worldspace, tile_position_x, tile_position_y, input);
+                INSERT INTO tiles (tile_id, worldspace, tile_position_x, tile_position_y, version, input, data)
+                    VALUES (1, 'sys::default', 3, 4, 1, x'00', x'00');
+            )";
+            EXPECT_EQ(sqlite3_exec(db, oldSchema, nullptr, nullptr, nullptr), SQLITE_OK);
+            sqlite3_close(db);
+        }
+        {
+            NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+            EXPECT_EQ(db.getMaxTileId(), TileId{ 0 });
+            const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+            const TilePosition tilePosition{ 3, 4 };
+            const std::vector<std::byte> input(32, std::byte{ 1 });
+            const std::vector<std::byte> data(32, std::byte{ 2 });
+            ASSERT_EQ(db.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+            const auto result = db.getTileData(worldspace, tilePosition, input);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->mData, data);
+        }
+        std::filesystem::remove(path);
+    }
+
+    struct DetourNavigatorNavMeshDbMergeTest : DetourNavigatorNavMeshDbTest
+    {
+        const std::filesystem::path mSourcePath
+            = std::filesystem::temp_directory_path() / "openmw_components_tests_navmeshdb_merge.db";
+
+        DetourNavigatorNavMeshDbMergeTest() { std::filesystem::remove(mSourcePath); }
+
+        ~DetourNavigatorNavMeshDbMergeTest() override { std::filesystem::remove(mSourcePath); }
+
+        NavMeshDb makeSource() { return NavMeshDb(mSourcePath.string(), std::numeric_limits<std::uint64_t>::max()); }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDbMergeTest, should_copy_tiles_and_shapes)
+    {
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        const std::string shapeHash = "hash";
+        const Sqlite3::ConstBlob shapeHashData{ shapeHash.data(), static_cast<int>(shapeHash.size()) };
+        insertTile(TileId{ 1 }, TileVersion{ 1 });
+        {
+            NavMeshDb source = makeSource();
+            const TilePosition tilePosition{ 5, 6 };
+            ASSERT_EQ(source.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+            ASSERT_EQ(source.insertShape(ShapeId{ 42 }, "shape", ShapeType::Collision, shapeHashData), 1);
+        }
+        EXPECT_EQ(mDb.merge(mSourcePath.string(), false), 1);
+        const auto tile = mDb.getTileData(worldspace, TilePosition{ 5, 6 }, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, TileId{ 2 });
+        EXPECT_EQ(tile->mData, data);
+        EXPECT_EQ(mDb.findShapeId("shape", ShapeType::Collision, shapeHashData), ShapeId{ 42 });
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbMergeTest, should_replace_tile_with_same_input)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        const std::vector<std::byte> sourceData = generateData();
+        {
+            NavMeshDb source = makeSource();
+            ASSERT_EQ(source.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 2 }, input, sourceData), 1);
+        }
+        EXPECT_EQ(mDb.merge(mSourcePath.string(), false), 1);
+        const auto tile = mDb.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mVersion, TileVersion{ 2 });
+        EXPECT_EQ(tile->mData, sourceData);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbMergeTest, should_keep_tile_at_same_position_with_other_input)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        const std::vector<std::byte> sourceInput = generateData();
+        {
+            NavMeshDb source = makeSource();
+            ASSERT_EQ(source.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, sourceInput, data), 1);
+        }
+        EXPECT_EQ(mDb.merge(mSourcePath.string(), false), 1);
+        EXPECT_TRUE(mDb.findTile(worldspace, tilePosition, input).has_value());
+        EXPECT_TRUE(mDb.findTile(worldspace, tilePosition, sourceInput).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbMergeTest, should_replace_tiles_at_same_position_when_requested)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        const std::vector<std::byte> sourceInput = generateData();
+        {
+            NavMeshDb source = makeSource();
+            ASSERT_EQ(source.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, sourceInput, data), 1);
+        }
+        EXPECT_EQ(mDb.merge(mSourcePath.string(), true), 1);
+        EXPECT_FALSE(mDb.findTile(worldspace, tilePosition, input).has_value());
+        EXPECT_TRUE(mDb.findTile(worldspace, tilePosition, sourceInput).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbMergeTest, should_throw_when_shape_has_other_id)
+    {
+        const std::string shapeHash = "hash";
+        const Sqlite3::ConstBlob shapeHashData{ shapeHash.data(), static_cast<int>(shapeHash.size()) };
+        ASSERT_EQ(mDb.insertShape(ShapeId{ 1 }, "shape", ShapeType::Collision, shapeHashData), 1);
+        {
+            NavMeshDb source = makeSource();
+            ASSERT_EQ(source.insertShape(ShapeId{ 2 }, "shape", ShapeType::Collision, shapeHashData), 1);
+        }
+        insertTile(TileId{ 1 }, TileVersion{ 1 });
+        EXPECT_THROW(mDb.merge(mSourcePath.string(), false), std::runtime_error);
+        EXPECT_FALSE(mDb.hasShapeId(ShapeId{ 2 }));
+        EXPECT_NO_THROW(insertTile(TileId{ 2 }, TileVersion{ 1 }));
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, should_support_file_size_limit)
     {
         mDb = NavMeshDb(":memory:", 4096);
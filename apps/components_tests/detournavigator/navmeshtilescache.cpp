@@ -4,6 +4,7 @@
 #include <components/detournavigator/preparednavmeshdata.hpp>
 #include <components/detournavigator/recast.hpp>
 #include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/stats.hpp>
 
 #include <osg/Vec3f>
 
@@ -367,4 +368,34 @@ namespace
         EXPECT_FALSE(cache.set(mAgentBounds, mTilePosition, anotherRecastMesh, std::move(anotherData)));
         EXPECT_TRUE(cache.get(mAgentBounds, mTilePosition, mRecastMesh));
     }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, get_from_sharded_cache_should_return_cached_value)
+    {
+        const std::size_t shards = 4;
+        const std::size_t maxSize = shards * 2 * (mRecastMeshSize + mPreparedNavMeshDataSize);
+        NavMeshTilesCache cache(maxSize, shards);
+        const auto copy = clone(*mPreparedNavMeshData);
+
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData));
+        const auto result = cache.get(mAgentBounds, mTilePosition, mRecastMesh);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result.get(), *copy);
+        EXPECT_FALSE(cache.get(mAgentBounds, TilePosition(1, 1), mRecastMesh));
+    }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, stats_for_sharded_cache_should_sum_all_shards)
+    {
+        const std::size_t shards = 4;
+        const std::size_t maxSize = shards * 4 * (mRecastMeshSize + mPreparedNavMeshDataSize);
+        NavMeshTilesCache cache(maxSize, shards);
+
+        for (int i = 0; i < 4; ++i)
+            cache.set(mAgentBounds, TilePosition(i, 0), mRecastMesh, makePeparedNavMeshData(3));
+        cache.get(mAgentBounds, TilePosition(0, 0), mRecastMesh);
+
+        const NavMeshTilesCacheStats stats = cache.getStats();
+        EXPECT_EQ(stats.mCachedNavMeshTiles + stats.mUsedNavMeshTiles, 4);
+        EXPECT_EQ(stats.mGetCount, 1);
+        EXPECT_EQ(stats.mHitCount, 1);
+    }
 }
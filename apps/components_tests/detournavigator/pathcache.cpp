@@ -0,0 +1,88 @@
+#include "settings.hpp"
+
+#include <components/detournavigator/navmeshcacheitem.hpp>
+#include <components/detournavigator/pathcache.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Tests;
+
+    struct DetourNavigatorPathCacheTest : Test
+    {
+        const Settings mSettings = makeSettings();
+        NavMeshCacheItem mNavMesh{ 1, mSettings };
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const osg::Vec3f mStart{ 52, 460, 1 };
+        const osg::Vec3f mEnd{ 460, 52, 1 };
+        const std::vector<osg::Vec3f> mPath{ mStart, mEnd };
+        std::vector<osg::Vec3f> mOut;
+
+        PathCache::Key makeKey(const osg::Vec3f& start, const osg::Vec3f& end) const
+        {
+            return PathCache::makeKey(mAgentBounds, start, end, Flag_walk, AreaCosts{}, 0);
+        }
+    };
+
+    TEST_F(DetourNavigatorPathCacheTest, get_from_empty_cache_should_return_nothing)
+    {
+        PathCache cache(1);
+        EXPECT_EQ(cache.get(makeKey(mStart, mEnd), mNavMesh, mOut), std::nullopt);
+        EXPECT_EQ(cache.getStats().mGetCount, 1);
+        EXPECT_EQ(cache.getStats().mHitCount, 0);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, get_should_return_result_for_nearby_start_and_same_end)
+    {
+        PathCache cache(1);
+        cache.set(makeKey(mStart, mEnd), mNavMesh, mSettings.mRecast, Status::StartPolygonNotFound, mPath);
+        EXPECT_EQ(cache.get(makeKey(mStart + osg::Vec3f(1, 1, 1), mEnd), mNavMesh, mOut),
+            Status::StartPolygonNotFound);
+        EXPECT_EQ(mOut, mPath);
+        EXPECT_EQ(cache.getStats().mHitCount, 1);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, get_should_return_nothing_for_different_end)
+    {
+        PathCache cache(1);
+        cache.set(makeKey(mStart, mEnd), mNavMesh, mSettings.mRecast, Status::StartPolygonNotFound, mPath);
+        EXPECT_EQ(cache.get(makeKey(mStart, mEnd + osg::Vec3f(1, 0, 0)), mNavMesh, mOut), std::nullopt);
+        EXPECT_EQ(cache.get(makeKey(mStart + osg::Vec3f(PathCache::sStartCellSize, 0, 0), mEnd), mNavMesh, mOut),
+            std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, failed_result_should_not_be_valid_after_navmesh_change)
+    {
+        PathCache cache(1);
+        cache.set(makeKey(mStart, mEnd), mNavMesh, mSettings.mRecast, Status::StartPolygonNotFound, mPath);
+        mNavMesh.markAsEmpty(TilePosition(0, 0));
+        EXPECT_EQ(cache.get(makeKey(mStart, mEnd), mNavMesh, mOut), std::nullopt);
+        EXPECT_EQ(cache.getStats().mSize, 0);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, found_path_over_missing_tiles_should_not_be_cached)
+    {
+        PathCache cache(1);
+        cache.set(makeKey(mStart, mEnd), mNavMesh, mSettings.mRecast, Status::Success, mPath);
+        EXPECT_EQ(cache.getStats().mSize, 0);
+        EXPECT_EQ(cache.get(makeKey(mStart, mEnd), mNavMesh, mOut), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, set_should_evict_least_recently_used_result)
+    {
+        PathCache cache(2);
+        const osg::Vec3f otherEnd = mEnd + osg::Vec3f(1, 0, 0);
+        const osg::Vec3f thirdEnd = mEnd + osg::Vec3f(2, 0, 0);
+        cache.set(makeKey(mStart, mEnd), mNavMesh, mSettings.mRecast, Status::StartPolygonNotFound, mPath);
+        cache.set(makeKey(mStart, otherEnd), mNavMesh, mSettings.mRecast, Status::EndPolygonNotFound, mPath);
+        EXPECT_EQ(cache.get(makeKey(mStart, mEnd), mNavMesh, mOut), Status::StartPolygonNotFound);
+        cache.set(makeKey(mStart, thirdEnd), mNavMesh, mSettings.mRecast, Status::EndPolygonNotFound, mPath);
+        EXPECT_EQ(cache.getStats().mSize, 2);
+        EXPECT_EQ(cache.get(makeKey(mStart, otherEnd), mNavMesh, mOut), std::nullopt);
+        EXPECT_EQ(cache.get(makeKey(mStart, mEnd), mNavMesh, mOut), Status::StartPolygonNotFound);
+    }
+}
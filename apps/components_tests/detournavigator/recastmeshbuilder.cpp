@@ -8,6 +8,7 @@
 #include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 
 #include <DetourCommon.h>
@@ -115,6 +116,49 @@ namespace
         EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground }));
     }
 
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_scaled_transformed_bhv_triangle_mesh_shape)
+    {
+        btTriangleMesh mesh;
+        mesh.addTriangle(btVector3(-1, -1, 0), btVector3(-1, 1, 0), btVector3(1, -1, 0));
+        btBvhTriangleMeshShape shape(&mesh, true);
+        btScaledBvhTriangleMeshShape scaled(&shape, btVector3(2, 3, 4));
+        RecastMeshBuilder builder(mBounds);
+        builder.addObject(static_cast<const btCollisionShape&>(scaled),
+            btTransform(btMatrix3x3::getIdentity(), btVector3(1, 2, 3)), AreaType_ground, mSource, mObjectTransform);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getVertices(),
+            std::vector<float>({
+                -1, -1, 3, // vertex 0
+                -1, 5, 3, // vertex 1
+                3, -1, 3, // vertex 2
+            }))
+            << recastMesh->getMesh().getVertices();
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>({ 2, 1, 0 }));
+        EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground }));
+    }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_bhv_triangle_mesh_shape_with_16_bit_indices_and_shared_vertices)
+    {
+        btTriangleMesh mesh(false);
+        mesh.addTriangle(btVector3(-1, -1, 0), btVector3(-1, 1, 0), btVector3(1, -1, 0), true);
+        mesh.addTriangle(btVector3(1, -1, 0), btVector3(-1, 1, 0), btVector3(1, 1, 0), true);
+        btBvhTriangleMeshShape shape(&mesh, true);
+        RecastMeshBuilder builder(mBounds);
+        builder.addObject(static_cast<const btCollisionShape&>(shape), btTransform::getIdentity(), AreaType_ground,
+            mSource, mObjectTransform);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getVertices(),
+            std::vector<float>({
+                -1, -1, 0, // vertex 0
+                -1, 1, 0, // vertex 1
+                1, -1, 0, // vertex 2
+                1, 1, 0, // vertex 3
+            }))
+            << recastMesh->getMesh().getVertices();
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>({ 2, 1, 0, 3, 1, 2 }));
+        EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground, AreaType_ground }));
+    }
+
     TEST_F(DetourNavigatorRecastMeshBuilderTest, add_heightfield_terrian_shape)
     {
         const std::array<btScalar, 4> heightfieldData{ { 0, 0, 0, 0 } };
@@ -231,6 +231,41 @@ namespace
         EXPECT_EQ(manager.getMesh(mWorldspace, TilePosition(0, 0)), nullptr);
     }
 
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest,
+        get_mesh_after_moving_one_of_objects_should_return_same_mesh_as_built_from_scratch)
+    {
+        const btBoxShape staticShape(btVector3(20, 20, 100));
+        const btBoxShape movedShape(btVector3(10, 10, 50));
+        const CollisionShape staticCollisionShape(mInstance, staticShape, mObjectTransform);
+        const CollisionShape movedCollisionShape(mInstance, movedShape, mObjectTransform);
+        const btTransform movedTransform(btMatrix3x3::getIdentity(), btVector3(50, 50, 0));
+
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        manager.addObject(ObjectId(&staticShape), staticCollisionShape, btTransform::getIdentity(),
+            AreaType::AreaType_ground, nullptr);
+        manager.addObject(ObjectId(&movedShape), movedCollisionShape, btTransform::getIdentity(),
+            AreaType::AreaType_ground, nullptr);
+        ASSERT_NE(manager.getMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        manager.updateObject(ObjectId(&movedShape), movedTransform, AreaType::AreaType_ground, nullptr);
+        manager.takeChangedTiles(nullptr);
+        const auto updated = manager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(updated, nullptr);
+
+        TileCachedRecastMeshManager expectedManager(mSettings);
+        expectedManager.setWorldspace(mWorldspace, nullptr);
+        expectedManager.addObject(ObjectId(&staticShape), staticCollisionShape, btTransform::getIdentity(),
+            AreaType::AreaType_ground, nullptr);
+        expectedManager.addObject(
+            ObjectId(&movedShape), movedCollisionShape, movedTransform, AreaType::AreaType_ground, nullptr);
+        const auto expected = expectedManager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(expected, nullptr);
+
+        EXPECT_EQ(updated->getMesh().getVertices(), expected->getMesh().getVertices());
+        EXPECT_EQ(updated->getMesh().getIndices(), expected->getMesh().getIndices());
+        EXPECT_EQ(updated->getMesh().getAreaTypes(), expected->getMesh().getAreaTypes());
+    }
+
     TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest,
         get_mesh_for_not_changed_object_after_update_should_return_recast_mesh_for_same_tiles)
     {
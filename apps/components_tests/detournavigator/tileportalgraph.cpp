@@ -0,0 +1,80 @@
+#include <components/detournavigator/tileportalgraph.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    // Tile of unit size with portals in the middle of the requested sides
+    TilePortals makePortals(const TilePosition& position, bool px, bool pz, bool nx, bool nz)
+    {
+        const float x = static_cast<float>(position.x());
+        const float z = static_cast<float>(position.y());
+        TilePortals result;
+        if (px)
+            result.mSides[0] = osg::Vec3f(x + 1, 0, z + 0.5f);
+        if (pz)
+            result.mSides[1] = osg::Vec3f(x + 0.5f, 0, z + 1);
+        if (nx)
+            result.mSides[2] = osg::Vec3f(x, 0, z + 0.5f);
+        if (nz)
+            result.mSides[3] = osg::Vec3f(x + 0.5f, 0, z);
+        return result;
+    }
+
+    struct DetourNavigatorTilePortalGraphTest : Test
+    {
+        TilePortalGraph mGraph;
+        std::vector<osg::Vec3f> mOut;
+
+        void addGrid(int width, int height)
+        {
+            for (int x = 0; x < width; ++x)
+                for (int y = 0; y < height; ++y)
+                    mGraph.setTile(TilePosition(x, y), makePortals(TilePosition(x, y), true, true, true, true));
+        }
+    };
+
+    TEST_F(DetourNavigatorTilePortalGraphTest, find_portal_path_for_missing_start_tile_should_fail)
+    {
+        addGrid(2, 1);
+        EXPECT_FALSE(mGraph.findPortalPath(TilePosition(-1, 0), osg::Vec3f(-0.5f, 0, 0.5f), TilePosition(1, 0),
+            osg::Vec3f(1.5f, 0, 0.5f), 1, 16, mOut));
+    }
+
+    TEST_F(DetourNavigatorTilePortalGraphTest, find_portal_path_in_same_tile_should_return_no_crossings)
+    {
+        addGrid(1, 1);
+        EXPECT_TRUE(mGraph.findPortalPath(
+            TilePosition(0, 0), osg::Vec3f(0.1f, 0, 0.1f), TilePosition(0, 0), osg::Vec3f(0.9f, 0, 0.9f), 1, 16, mOut));
+        EXPECT_THAT(mOut, IsEmpty());
+    }
+
+    TEST_F(DetourNavigatorTilePortalGraphTest, find_portal_path_should_return_every_stride_crossing_except_last)
+    {
+        addGrid(5, 1);
+        EXPECT_TRUE(mGraph.findPortalPath(
+            TilePosition(0, 0), osg::Vec3f(0.5f, 0, 0.5f), TilePosition(4, 0), osg::Vec3f(4.5f, 0, 0.5f), 2, 16, mOut));
+        EXPECT_THAT(mOut, ElementsAre(osg::Vec3f(2, 0, 0.5f)));
+    }
+
+    TEST_F(DetourNavigatorTilePortalGraphTest, find_portal_path_should_go_around_tile_without_portals)
+    {
+        addGrid(3, 2);
+        mGraph.setTile(TilePosition(1, 0), makePortals(TilePosition(1, 0), false, false, false, false));
+        EXPECT_TRUE(mGraph.findPortalPath(
+            TilePosition(0, 0), osg::Vec3f(0.5f, 0, 0.5f), TilePosition(2, 0), osg::Vec3f(2.5f, 0, 0.5f), 1, 16, mOut));
+        EXPECT_THAT(mOut, ElementsAre(osg::Vec3f(0.5f, 0, 1), osg::Vec3f(1, 0, 1.5f), osg::Vec3f(2, 0, 1.5f)));
+    }
+
+    TEST_F(DetourNavigatorTilePortalGraphTest, find_portal_path_for_disconnected_tiles_should_fail)
+    {
+        addGrid(3, 1);
+        mGraph.removeTile(TilePosition(1, 0));
+        EXPECT_FALSE(mGraph.findPortalPath(
+            TilePosition(0, 0), osg::Vec3f(0.5f, 0, 0.5f), TilePosition(2, 0), osg::Vec3f(2.5f, 0, 0.5f), 1, 16, mOut));
+    }
+}
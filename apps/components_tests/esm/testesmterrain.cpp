@@ -0,0 +1,51 @@
+#include <components/esm/esmterrain.hpp>
+#include <components/esm3/loadland.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+
+    ESM::Land makeLand(int dataTypes)
+    {
+        ESM::Land land;
+        land.mDataTypes = dataTypes;
+        land.mLandData = std::make_unique<ESM::LandRecordData>();
+        land.mLandData->mDataLoaded = dataTypes;
+        land.mLandData->mHeights.fill(42);
+        land.mLandData->mMinHeight = 42;
+        land.mLandData->mMaxHeight = 42;
+        land.mLandData->mNormals.fill(1);
+        land.mLandData->mColours.fill(2);
+        land.mLandData->mTextures.fill(3);
+        return land;
+    }
+
+    TEST(ESMLandDataTest, shouldKeepOnlyRequestedDataTypes)
+    {
+        const ESM::Land land = makeLand(ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR);
+        const ESM::LandData data(land, ESM::Land::DATA_VHGT);
+        EXPECT_EQ(data.getLoadFlags(), ESM::Land::DATA_VHGT);
+        ASSERT_EQ(data.getHeights().size(), ESM::Land::LAND_NUM_VERTS);
+        EXPECT_EQ(data.getHeights().front(), 42);
+        EXPECT_EQ(data.getMinHeight(), 42);
+        EXPECT_EQ(data.getMaxHeight(), 42);
+        EXPECT_TRUE(data.getNormals().empty());
+        EXPECT_TRUE(data.getColors().empty());
+        EXPECT_TRUE(data.getTextures().empty());
+    }
+
+    TEST(ESMLandDataTest, shouldNotLoadAbsentDataTypes)
+    {
+        const ESM::Land land = makeLand(ESM::Land::DATA_VCLR);
+        const ESM::LandData data(land, ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX);
+        EXPECT_EQ(data.getLoadFlags(), ESM::Land::DATA_VCLR);
+        ASSERT_EQ(data.getColors().size(), 3 * ESM::Land::LAND_NUM_VERTS);
+        EXPECT_EQ(data.getColors().front(), 2);
+        EXPECT_TRUE(data.getHeights().empty());
+        EXPECT_TRUE(data.getTextures().empty());
+    }
+}
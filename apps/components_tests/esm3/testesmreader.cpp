@@ -0,0 +1,155 @@
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/files/compressedfile.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace ESM
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        std::string makeContentFile()
+        {
+            std::stringstream stream;
+            ESMWriter writer;
+            writer.setFormatVersion(DefaultFormatVersion);
+            writer.save(stream);
+
+            writer.startRecord(REC_STAT);
+            writer.writeHNString("NAME", "first");
+            writer.writeHNString("MODL", "first.nif");
+            writer.endRecord(REC_STAT);
+
+            writer.startRecord(REC_STAT);
+            writer.writeHNString("NAME", "second");
+            writer.writeHNT("DATA", std::uint32_t{ 42 });
+            writer.endRecord(REC_STAT);
+
+            writer.close();
+            return stream.str();
+        }
+
+        struct Esm3EsmReaderTest : Test
+        {
+            const std::string mContent = makeContentFile();
+            std::filesystem::path mPath;
+
+            void SetUp() override
+            {
+                const auto testInfo = UnitTest::GetInstance()->current_test_info();
+                mPath = TestingOpenMW::outputFilePath(
+                    std::string(testInfo->test_suite_name()) + "." + testInfo->name() + ".esp");
+                std::ofstream(mPath, std::ios::binary) << mContent;
+            }
+        };
+
+        void readSecondRecord(ESMReader& reader)
+        {
+            ASSERT_TRUE(reader.hasMoreRecs());
+            EXPECT_EQ(reader.getRecName(), "STAT");
+            reader.getRecHeader();
+            EXPECT_EQ(reader.getHNString("NAME"), "second");
+            std::uint32_t data = 0;
+            reader.getHNT(data, "DATA");
+            EXPECT_EQ(data, 42);
+            EXPECT_FALSE(reader.hasMoreSubs());
+            EXPECT_FALSE(reader.hasMoreRecs());
+        }
+
+        TEST_F(Esm3EsmReaderTest, openByPathShouldReadSameAsStream)
+        {
+            ESMReader fromFile;
+            fromFile.open(mPath);
+            ESMReader fromStream;
+            fromStream.open(std::make_unique<std::istringstream>(mContent), mPath);
+
+            for (ESMReader* reader : { &fromFile, &fromStream })
+            {
+                EXPECT_EQ(reader->getFileSize(), mContent.size());
+                ASSERT_TRUE(reader->hasMoreRecs());
+                EXPECT_EQ(reader->getRecName(), "STAT");
+                reader->getRecHeader();
+                EXPECT_EQ(reader->getHNString("NAME"), "first");
+                EXPECT_EQ(reader->getHNString("MODL"), "first.nif");
+                readSecondRecord(*reader);
+                EXPECT_EQ(reader->getFileOffset(), mContent.size());
+            }
+        }
+
+        TEST_F(Esm3EsmReaderTest, openByPathShouldReadCompressedFile)
+        {
+            const std::filesystem::path path = TestingOpenMW::outputFilePath("Esm3EsmReaderTest.compressed.esp");
+            {
+                std::ofstream stream(path, std::ios::binary);
+                Files::writeCompressedFile(mContent, stream, 16);
+            }
+
+            ESMReader reader;
+            reader.open(path);
+            EXPECT_EQ(reader.getFileSize(), mContent.size());
+            EXPECT_EQ(reader.getRecName(), "STAT");
+            reader.getRecHeader();
+            reader.skipRecord();
+            const ESM_Context context = reader.getContext();
+            readSecondRecord(reader);
+
+            reader.restoreContext(context);
+            readSecondRecord(reader);
+        }
+
+        TEST_F(Esm3EsmReaderTest, skipRecordShouldMoveToNextRecord)
+        {
+            ESMReader reader;
+            reader.open(mPath);
+            EXPECT_EQ(reader.getRecName(), "STAT");
+            reader.getRecHeader();
+            reader.skipRecord();
+            readSecondRecord(reader);
+        }
+
+        TEST_F(Esm3EsmReaderTest, restoreContextShouldReturnToSavedPosition)
+        {
+            ESMReader reader;
+            reader.open(mPath);
+            EXPECT_EQ(reader.getRecName(), "STAT");
+            reader.getRecHeader();
+            reader.skipRecord();
+            const ESM_Context context = reader.getContext();
+            readSecondRecord(reader);
+
+            reader.restoreContext(context);
+            readSecondRecord(reader);
+
+            ESMReader other;
+            other.restoreContext(context);
+            readSecondRecord(other);
+        }
+
+        TEST_F(Esm3EsmReaderTest, getRecordShouldReturnRecordThatCanBeReadAgain)
+        {
+            ESMReader reader;
+            reader.open(mPath);
+            EXPECT_EQ(reader.getRecName(), "STAT");
+            reader.getRecHeader();
+            reader.skipRecord();
+            EXPECT_EQ(reader.getRecName(), "STAT");
+            reader.getRecHeader();
+            const std::string record = reader.getRecord();
+            EXPECT_FALSE(reader.hasMoreRecs());
+            EXPECT_TRUE(mContent.ends_with(record));
+
+            ESMReader other;
+            other.openRaw(std::make_unique<std::istringstream>(record), mPath);
+            other.setFormatVersion(reader.getFormatVersion());
+            readSecondRecord(other);
+        }
+    }
+}
@@ -4,8 +4,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <random>
+#include <sstream>
 
 namespace ESM
 {
@@ -51,6 +54,78 @@ namespace ESM
             EXPECT_THROW(writer.writeMaybeFixedSizeString(generateRandomString(33), 32), std::runtime_error);
         }
 
+        TEST_F(Esm3EsmWriterTest, writeRecordShouldCopyRecordWrittenSeparately)
+        {
+            std::stringstream expected;
+            std::stringstream record;
+            std::stringstream result;
+
+            {
+                ESMWriter writer;
+                writer.setFormatVersion(CurrentSaveGameFormatVersion);
+                writer.save(expected);
+                writer.startRecord(REC_CSTA);
+                writer.writeHNString("NAME", "value");
+                writer.endRecord(REC_CSTA);
+            }
+
+            {
+                ESMWriter writer;
+                writer.setFormatVersion(CurrentSaveGameFormatVersion);
+                writer.saveRecords(record);
+                writer.startRecord(REC_CSTA);
+                writer.writeHNString("NAME", "value");
+                writer.endRecord(REC_CSTA);
+            }
+
+            ESMWriter writer;
+            writer.setFormatVersion(CurrentSaveGameFormatVersion);
+            writer.save(result);
+            writer.writeRecord(record.str());
+            writer.close();
+
+            EXPECT_EQ(writer.getRecordCount(), 2);
+            EXPECT_EQ(result.str(), expected.str());
+        }
+
+        TEST_F(Esm3EsmWriterTest, saveWithoutStreamShouldProduceSameDataAsSaveToStream)
+        {
+            const std::string name = generateRandomString(300);
+            const auto write = [&](ESMWriter& writer) {
+                writer.startRecord(REC_CSTA);
+                writer.writeHNString("NAME", "value");
+                writer.writeHNT("DATA", std::uint32_t{ 42 });
+                writer.endRecord(REC_CSTA);
+                writer.startRecord(REC_STAT, 0x20);
+                writer.writeHNString("NAME", name);
+                writer.endRecord(REC_STAT);
+                writer.close();
+            };
+
+            std::stringstream stream;
+            ESMWriter streamWriter;
+            streamWriter.setFormatVersion(CurrentSaveGameFormatVersion);
+            streamWriter.save(stream);
+            write(streamWriter);
+
+            ESMWriter memoryWriter;
+            memoryWriter.setFormatVersion(CurrentSaveGameFormatVersion);
+            memoryWriter.save();
+            write(memoryWriter);
+
+            const std::string data = memoryWriter.takeData();
+            EXPECT_EQ(data, stream.str());
+            EXPECT_EQ(memoryWriter.getRecordCount(), streamWriter.getRecordCount());
+            const std::size_t position = data.find("CSTA");
+            ASSERT_NE(position, std::string::npos);
+            std::uint32_t recordSize = 0;
+            std::memcpy(&recordSize, data.data() + position + 4, sizeof(recordSize));
+            EXPECT_EQ(recordSize, 8 + 5 + 8 + 4);
+            std::uint32_t subRecordSize = 0;
+            std::memcpy(&subRecordSize, data.data() + position + 16 + 4, sizeof(subRecordSize));
+            EXPECT_EQ(subRecordSize, 5);
+        }
+
         struct Esm3EsmWriterRefIdSizeTest : TestWithParam<std::pair<RefId, std::size_t>>
         {
         };
@@ -13,6 +13,7 @@
 #include <components/esm3/loadweap.hpp>
 #include <components/esm3/player.hpp>
 #include <components/esm3/quickkeys.hpp>
+#include <components/esm3/savedgame.hpp>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -286,6 +287,35 @@ namespace ESM
             EXPECT_EQ(result.mNumShorts, record.mNumShorts);
         }
 
+        TEST_F(Esm3SaveLoadRecordTest, savedGameShouldNotChange)
+        {
+            SavedGame record;
+            record.mContentFiles = { "Morrowind.esm", "Tribunal.esm" };
+            record.mPlayerName = generateRandomString(32);
+            record.mPlayerLevel = 3;
+            record.mPlayerClassId = generateRandomRefId(32);
+            record.mPlayerCellName = generateRandomString(32);
+            record.mInGameTime = { .mGameHour = 13, .mDay = 2, .mMonth = 4, .mYear = 427 };
+            record.mTimePlayed = 42;
+            record.mDescription = generateRandomString(64);
+            record.mScreenshot = { 'j', 'p', 'g' };
+            record.mCurrentDay = 5;
+            record.mCurrentHealth = 10;
+            record.mMaximumHealth = 20;
+            record.mCellsFile = "cells - 1.omwcells";
+            SavedGame result;
+            saveAndLoadRecord(record, CurrentSaveGameFormatVersion, result);
+            EXPECT_EQ(result.mContentFiles, record.mContentFiles);
+            EXPECT_EQ(result.mPlayerName, record.mPlayerName);
+            EXPECT_EQ(result.mPlayerClassId, record.mPlayerClassId);
+            EXPECT_EQ(result.mPlayerCellName, record.mPlayerCellName);
+            EXPECT_EQ(result.mTimePlayed, record.mTimePlayed);
+            EXPECT_EQ(result.mDescription, record.mDescription);
+            EXPECT_EQ(result.mScreenshot, record.mScreenshot);
+            EXPECT_EQ(result.mMaximumHealth, record.mMaximumHealth);
+            EXPECT_EQ(result.mCellsFile, record.mCellsFile);
+        }
+
         TEST_P(Esm3SaveLoadRecordTest, playerShouldNotChange)
         {
             // Player state is not saved to vanilla ESM format.
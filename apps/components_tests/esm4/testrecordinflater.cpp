@@ -0,0 +1,99 @@
+#include <components/bsa/memorystream.hpp>
+#include <components/esm4/common.hpp>
+#include <components/esm4/reader.hpp>
+#include <components/esm4/recordinflater.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM4;
+
+    std::vector<char> compress(const std::string& data)
+    {
+        uLongf size = compressBound(static_cast<uLong>(data.size()));
+        std::vector<char> result(size);
+        compress2(reinterpret_cast<Bytef*>(result.data()), &size, reinterpret_cast<const Bytef*>(data.data()),
+            static_cast<uLong>(data.size()), Z_DEFAULT_COMPRESSION);
+        result.resize(size);
+        return result;
+    }
+
+    std::string toString(Bsa::MemoryInputStream& stream, std::size_t size)
+    {
+        return std::string(stream.getRawData(), size);
+    }
+
+    struct ESM4RecordInflaterTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePath("recordinflater.esm");
+        std::ofstream mFile{ mPath, std::ios::binary };
+
+        void writeHeader(std::uint32_t typeId, std::uint32_t size, std::uint32_t flags)
+        {
+            RecordHeader header{};
+            header.record.typeId = typeId;
+            header.record.dataSize = size;
+            header.record.flags = flags;
+            mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        std::streamoff writeCompressedRecord(const std::string& data)
+        {
+            const std::vector<char> compressed = compress(data);
+            writeHeader(REC_GMST, sizeof(std::uint32_t) + compressed.size(), Rec_Compressed);
+            const std::uint32_t size = data.size();
+            mFile.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            const std::streamoff position = mFile.tellp();
+            mFile.write(compressed.data(), compressed.size());
+            return position;
+        }
+    };
+
+    TEST_F(ESM4RecordInflaterTest, inflateRecordShouldReturnInflatedData)
+    {
+        const std::string data(1000, 'a');
+        std::vector<char> compressed = compress(data);
+        const auto result = inflateRecord(0, compressed, data.size());
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(toString(*result, data.size()), data);
+    }
+
+    TEST_F(ESM4RecordInflaterTest, takeShouldReturnRecordsInsideGroupsAndDropSkipped)
+    {
+        writeHeader(REC_TES4, 0, 0);
+        writeHeader(REC_GRUP, 0, 0);
+        const std::streamoff first = writeCompressedRecord("first");
+        writeHeader(REC_GMST, 4, 0);
+        mFile.write("data", 4);
+        const std::streamoff second = writeCompressedRecord("second record");
+        mFile.close();
+
+        RecordInflater inflater(mPath, sizeof(RecordHeader), 2, 1);
+
+        const auto secondData = inflater.take(second, 13);
+        ASSERT_NE(secondData, nullptr);
+        EXPECT_EQ(toString(*secondData, 13), "second record");
+        EXPECT_EQ(inflater.take(first, 5), nullptr);
+    }
+
+    TEST_F(ESM4RecordInflaterTest, takeShouldReturnNullptrForUnexpectedSize)
+    {
+        writeHeader(REC_TES4, 0, 0);
+        const std::streamoff position = writeCompressedRecord("first");
+        mFile.close();
+
+        RecordInflater inflater(mPath, sizeof(RecordHeader), 1, 1);
+
+        EXPECT_EQ(inflater.take(position, 6), nullptr);
+    }
+}
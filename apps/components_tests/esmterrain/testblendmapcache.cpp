@@ -0,0 +1,87 @@
+#include <components/esmterrain/blendmapcache.hpp>
+
+#include <osg/Image>
+
+#include <gtest/gtest.h>
+
+namespace ESMTerrain
+{
+    namespace
+    {
+        using namespace testing;
+
+        std::shared_ptr<const Blendmaps> makeBlendmaps(int imageSize)
+        {
+            auto result = std::make_shared<Blendmaps>();
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->allocateImage(imageSize, imageSize, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
+            result->mImages.push_back(std::move(image));
+            result->mLayers.push_back(Terrain::LayerInfo{});
+            return result;
+        }
+
+        BlendmapKey makeKey(float x)
+        {
+            return BlendmapKey{ ESM::RefId(), 1.0f, osg::Vec2f(x, 0.5f) };
+        }
+
+        TEST(ESMTerrainBlendmapCacheTest, getShouldReturnNullptrForMissingKey)
+        {
+            BlendmapCache cache(1024);
+            EXPECT_EQ(cache.get(makeKey(0.5f)), nullptr);
+        }
+
+        TEST(ESMTerrainBlendmapCacheTest, getShouldReturnInsertedValue)
+        {
+            BlendmapCache cache(1024);
+            const std::shared_ptr<const Blendmaps> value = makeBlendmaps(4);
+            cache.insert(makeKey(0.5f), value);
+            EXPECT_EQ(cache.get(makeKey(0.5f)), value);
+            EXPECT_EQ(cache.getCount(), 1);
+            EXPECT_EQ(cache.getSize(), 16);
+        }
+
+        TEST(ESMTerrainBlendmapCacheTest, insertShouldReplaceValueForSameKey)
+        {
+            BlendmapCache cache(1024);
+            cache.insert(makeKey(0.5f), makeBlendmaps(4));
+            const std::shared_ptr<const Blendmaps> value = makeBlendmaps(2);
+            cache.insert(makeKey(0.5f), value);
+            EXPECT_EQ(cache.get(makeKey(0.5f)), value);
+            EXPECT_EQ(cache.getCount(), 1);
+            EXPECT_EQ(cache.getSize(), 4);
+        }
+
+        TEST(ESMTerrainBlendmapCacheTest, insertShouldEvictLeastRecentlyUsedWhenFull)
+        {
+            BlendmapCache cache(32);
+            cache.insert(makeKey(0.5f), makeBlendmaps(4));
+            cache.insert(makeKey(1.5f), makeBlendmaps(4));
+            ASSERT_NE(cache.get(makeKey(0.5f)), nullptr);
+            cache.insert(makeKey(2.5f), makeBlendmaps(4));
+            EXPECT_NE(cache.get(makeKey(0.5f)), nullptr);
+            EXPECT_EQ(cache.get(makeKey(1.5f)), nullptr);
+            EXPECT_NE(cache.get(makeKey(2.5f)), nullptr);
+            EXPECT_EQ(cache.getSize(), 32);
+        }
+
+        TEST(ESMTerrainBlendmapCacheTest, insertShouldKeepValueLargerThanLimit)
+        {
+            BlendmapCache cache(8);
+            cache.insert(makeKey(0.5f), makeBlendmaps(2));
+            cache.insert(makeKey(1.5f), makeBlendmaps(4));
+            EXPECT_EQ(cache.get(makeKey(0.5f)), nullptr);
+            EXPECT_NE(cache.get(makeKey(1.5f)), nullptr);
+        }
+
+        TEST(ESMTerrainBlendmapCacheTest, clearShouldRemoveAllValues)
+        {
+            BlendmapCache cache(1024);
+            cache.insert(makeKey(0.5f), makeBlendmaps(4));
+            cache.clear();
+            EXPECT_EQ(cache.get(makeKey(0.5f)), nullptr);
+            EXPECT_EQ(cache.getCount(), 0);
+            EXPECT_EQ(cache.getSize(), 0);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include <components/files/compressedfile.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace Files;
+
+    std::string makeContent(std::size_t size)
+    {
+        std::string result;
+        for (std::size_t i = 0; i < size; ++i)
+            result.push_back(static_cast<char>(i * 7 % 251));
+        return result;
+    }
+
+    std::filesystem::path writeFile(const std::string& name, const std::string& content, std::size_t blockSize)
+    {
+        const std::filesystem::path path = outputFilePath(name);
+        std::ofstream stream(path, std::ios::binary);
+        writeCompressedFile(content, stream, blockSize);
+        return path;
+    }
+
+    TEST(FilesCompressedFileTest, shouldReadOriginalContent)
+    {
+        const std::string content = makeContent(1000);
+        const std::filesystem::path path = writeFile("compressed", content, 64);
+        EXPECT_TRUE(isCompressedFile(path));
+        const IStreamPtr stream = openCompressedFileStream(path);
+        const std::string result(std::istreambuf_iterator<char>(*stream), {});
+        EXPECT_EQ(result, content);
+    }
+
+    TEST(FilesCompressedFileTest, shouldSeekAcrossBlocks)
+    {
+        const std::string content = makeContent(1000);
+        const IStreamPtr stream = openCompressedFileStream(writeFile("compressedSeek", content, 64));
+
+        stream->seekg(0, std::ios_base::end);
+        EXPECT_EQ(stream->tellg(), content.size());
+
+        for (const std::size_t position : { 900, 10, 70, 64, 999 })
+        {
+            stream->seekg(position);
+            ASSERT_EQ(stream->tellg(), position);
+            char value = 0;
+            stream->read(&value, 1);
+            EXPECT_EQ(value, content[position]) << position;
+            EXPECT_EQ(stream->tellg(), position + 1);
+        }
+
+        stream->seekg(60);
+        std::string buffer(10, '\0');
+        stream->read(buffer.data(), buffer.size());
+        EXPECT_EQ(buffer, content.substr(60, 10));
+    }
+
+    TEST(FilesCompressedFileTest, shouldHandleEmptyContent)
+    {
+        const IStreamPtr stream = openCompressedFileStream(writeFile("compressedEmpty", {}, 64));
+        EXPECT_EQ(stream->get(), std::char_traits<char>::eof());
+    }
+
+    TEST(FilesCompressedFileTest, plainFileShouldNotBeCompressed)
+    {
+        const std::filesystem::path path = outputFilePath("plain");
+        std::ofstream(path, std::ios::binary) << "TES3";
+        EXPECT_FALSE(isCompressedFile(path));
+    }
+}
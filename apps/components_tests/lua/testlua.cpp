@@ -1,6 +1,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+
 #include <components/lua/luastate.hpp>
 #include <components/testing/expecterror.hpp>
 #include <components/testing/util.hpp>
@@ -262,4 +265,29 @@ return {
         // without safe get we crash here
         EXPECT_ERROR(LuaUtil::safeGet(t, "any key"), "meta index error");
     }
+
+    TEST_F(LuaStateTest, ScriptCache)
+    {
+        const std::filesystem::path cachePath = TestingOpenMW::outputFilePath("luaScriptCache.omwcache");
+        std::filesystem::remove(cachePath);
+        const VFS::Path::Normalized path(counterPath);
+
+        mLua.readScriptCache(cachePath);
+        mLua.runInNewSandbox(path);
+        mLua.writeScriptCache();
+        ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+        {
+            LuaUtil::LuaState lua{ mVFS.get(), &mCfg };
+            lua.readScriptCache(cachePath);
+            sol::table script = lua.runInNewSandbox(path);
+            EXPECT_EQ(LuaUtil::call(script["get"]).get<int>(), 42);
+        }
+
+        std::ofstream(cachePath, std::ios::binary) << "OMWLUABC broken";
+        LuaUtil::LuaState lua{ mVFS.get(), &mCfg };
+        lua.readScriptCache(cachePath);
+        sol::table script = lua.runInNewSandbox(path);
+        EXPECT_EQ(LuaUtil::call(script["get"]).get<int>(), 42);
+    }
 }
@@ -539,6 +539,33 @@ CUSTOM: customdata.lua
         EXPECT_EQ(counter4, 25);
     }
 
+    TEST_F(LuaScriptsContainerTest, TimerCallbackCanAddTimers)
+    {
+        using TimerType = LuaUtil::ScriptsContainer::TimerType;
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        const int test1Id = getId(test1Path);
+        EXPECT_TRUE(scripts.addCustomScript(test1Id));
+
+        int counter1 = 0, counter2 = 0;
+        sol::function fn2 = sol::make_object(mLua.unsafeState(), [&]() { counter2++; });
+        sol::function fn1 = sol::make_object(mLua.unsafeState(), [&]() {
+            counter1++;
+            // Earlier than the timer being called
+            scripts.setupUnsavableTimer(TimerType::SIMULATION_TIME, 1, test1Id, fn2);
+        });
+
+        for (int i = 0; i < 100; ++i)
+            scripts.setupUnsavableTimer(TimerType::SIMULATION_TIME, 5 + i, test1Id, fn1);
+
+        scripts.processTimers(50, 0);
+        EXPECT_EQ(counter1, 46);
+        EXPECT_EQ(counter2, 46);
+
+        scripts.processTimers(200, 0);
+        EXPECT_EQ(counter1, 100);
+        EXPECT_EQ(counter2, 100);
+    }
+
     TEST_F(LuaScriptsContainerTest, CallbackWrapper)
     {
         sol::state_view view = mLua.unsafeState();
@@ -193,6 +193,111 @@ namespace
         EXPECT_ERROR(lua.safe_script("ro_t.nested.x = 5"), "userdata value");
     }
 
+    TEST(LuaSerializationTest, NumberArray)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+            table[i] = i * 0.5;
+
+        std::string serialized = LuaUtil::serialize(table);
+        EXPECT_EQ(serialized.size(), 86); // version, type, size, 10x double
+        for (bool readOnly : { false, true })
+        {
+            sol::table res = LuaUtil::deserialize(lua, serialized, nullptr, readOnly);
+            for (int i = 1; i <= 10; ++i)
+                EXPECT_DOUBLE_EQ(res.get<double>(i), i * 0.5);
+        }
+    }
+
+    TEST(LuaSerializationTest, IntegerArray)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+            table[i] = i - 5;
+
+        std::string serialized = LuaUtil::serialize(table);
+        EXPECT_EQ(serialized.size(), 46); // version, type, size, 10x int32
+        sol::table res = LuaUtil::deserialize(lua, serialized);
+        for (int i = 1; i <= 10; ++i)
+            EXPECT_EQ(res.get<int>(i), i - 5);
+    }
+
+    TEST(LuaSerializationTest, RecordArray)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+        {
+            sol::table record(lua, sol::create);
+            record["x"] = i;
+            record["name"] = "marker" + std::to_string(i);
+            table[i] = record;
+        }
+
+        std::string serialized = LuaUtil::serialize(table);
+        EXPECT_LT(serialized.size(), 200);
+        for (bool readOnly : { false, true })
+        {
+            sol::table res = LuaUtil::deserialize(lua, serialized, nullptr, readOnly);
+            for (int i = 1; i <= 10; ++i)
+            {
+                sol::table record = res[i];
+                EXPECT_EQ(record.get<int>("x"), i);
+                EXPECT_EQ(record.get<std::string>("name"), "marker" + std::to_string(i));
+            }
+        }
+    }
+
+    TEST(LuaSerializationTest, ArrayWithDifferentRecordsShouldBeSerializedAsTable)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+        {
+            sol::table record(lua, sol::create);
+            record[i % 2 == 0 ? "x" : "y"] = i;
+            table[i] = record;
+        }
+
+        std::string serialized = LuaUtil::serialize(table);
+        sol::table res = LuaUtil::deserialize(lua, serialized);
+        for (int i = 1; i <= 10; ++i)
+        {
+            sol::table record = res[i];
+            EXPECT_EQ(record.get<int>(i % 2 == 0 ? "x" : "y"), i);
+            EXPECT_EQ(record.get<sol::object>(i % 2 == 0 ? "y" : "x"), sol::nil);
+        }
+    }
+
+    TEST(LuaSerializationTest, ArrayWithHoleShouldBeSerializedAsTable)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+            if (i != 5)
+                table[i] = i;
+
+        std::string serialized = LuaUtil::serialize(table);
+        EXPECT_EQ(serialized.size(), 165); // version, table start and end, 9x number key and value
+        sol::table res = LuaUtil::deserialize(lua, serialized);
+        EXPECT_EQ(res.get<sol::object>(5), sol::nil);
+        EXPECT_EQ(res.get<int>(10), 10);
+    }
+
+    TEST(LuaSerializationTest, TruncatedArrayShouldThrow)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+            table[i] = i;
+
+        std::string serialized = LuaUtil::serialize(table);
+        serialized.pop_back();
+        EXPECT_ERROR(LuaUtil::deserialize(lua, serialized), "Unexpected end of serialized data.");
+    }
+
     struct TestStruct1
     {
         double a, b;
@@ -276,4 +381,45 @@ namespace
         EXPECT_EQ(ry.b, 3);
     }
 
+    TEST(LuaSerializationTest, TableSerializer)
+    {
+        sol::state lua;
+        LuaUtil::TableSerializer inner;
+        inner.add("a", LuaUtil::serialize(sol::make_object(lua, 1.5)));
+        inner.add("nil", LuaUtil::serialize(sol::nil));
+        inner.add("longer key than thirty two characters",
+            LuaUtil::serialize(sol::make_object(lua, std::string("value"))));
+        LuaUtil::TableSerializer outer;
+        outer.add("inner", inner);
+        outer.add("b", LuaUtil::serialize(sol::make_object(lua, true)));
+
+        sol::table res = LuaUtil::deserialize(lua, outer.finish());
+        EXPECT_EQ(res.get<bool>("b"), true);
+        sol::table innerRes = res["inner"];
+        EXPECT_EQ(innerRes.get<double>("a"), 1.5);
+        EXPECT_EQ(innerRes.get<std::string>("longer key than thirty two characters"), "value");
+        EXPECT_EQ(innerRes.get<sol::object>("nil"), sol::nil);
+
+        EXPECT_EQ(LuaUtil::TableSerializer().finish(), LuaUtil::serialize(sol::table(lua, sol::create)));
+    }
+
+    TEST(LuaSerializationTest, SharedBinaryData)
+    {
+        sol::state lua;
+        EXPECT_EQ(LuaUtil::serializeShared(sol::nil), nullptr);
+        EXPECT_EQ(LuaUtil::toStringView(nullptr), "");
+
+        sol::table table(lua, sol::create);
+        table["x"] = TestStruct1{ 1.5, 2.5 };
+        TestSerializer serializer;
+        const LuaUtil::SharedBinaryData shared = LuaUtil::serializeShared(table, &serializer);
+        ASSERT_NE(shared, nullptr);
+        EXPECT_EQ(*shared, LuaUtil::serialize(table, &serializer));
+
+        sol::table first = LuaUtil::deserialize(lua, LuaUtil::toStringView(shared), &serializer);
+        sol::table second = LuaUtil::deserialize(lua, LuaUtil::toStringView(shared), &serializer);
+        first["x"] = 1;
+        EXPECT_EQ(second.get<TestStruct1>("x").a, 1.5);
+    }
+
 }
@@ -0,0 +1,69 @@
+#include <components/lua/smallblockpool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using LuaUtil::SmallBlockPool;
+
+    TEST(LuaUtilSmallBlockPoolTest, isPooledShouldBeTrueOnlyForSmallNonEmptyBlocks)
+    {
+        EXPECT_FALSE(SmallBlockPool::isPooled(0));
+        EXPECT_TRUE(SmallBlockPool::isPooled(1));
+        EXPECT_TRUE(SmallBlockPool::isPooled(SmallBlockPool::sMaxBlockSize));
+        EXPECT_FALSE(SmallBlockPool::isPooled(SmallBlockPool::sMaxBlockSize + 1));
+    }
+
+    TEST(LuaUtilSmallBlockPoolTest, isSameClassShouldBeTrueForSizesRoundedUpToSameGranule)
+    {
+        EXPECT_TRUE(SmallBlockPool::isSameClass(1, SmallBlockPool::sGranularity));
+        EXPECT_FALSE(SmallBlockPool::isSameClass(SmallBlockPool::sGranularity, SmallBlockPool::sGranularity + 1));
+    }
+
+    TEST(LuaUtilSmallBlockPoolTest, allocateShouldReturnAlignedDistinctBlocks)
+    {
+        SmallBlockPool pool;
+        std::set<void*> blocks;
+        for (std::size_t size = 1; size <= SmallBlockPool::sMaxBlockSize; ++size)
+        {
+            void* const block = pool.allocate(size);
+            ASSERT_NE(block, nullptr);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t), 0);
+            std::memset(block, 0xAB, size);
+            EXPECT_TRUE(blocks.insert(block).second);
+        }
+    }
+
+    TEST(LuaUtilSmallBlockPoolTest, allocateShouldReuseDeallocatedBlockOfSameClass)
+    {
+        SmallBlockPool pool;
+        void* const block = pool.allocate(24);
+        pool.deallocate(block, 24);
+        EXPECT_EQ(pool.allocate(32), block);
+    }
+
+    TEST(LuaUtilSmallBlockPoolTest, allocateShouldNotReuseDeallocatedBlockOfOtherClass)
+    {
+        SmallBlockPool pool;
+        void* const block = pool.allocate(16);
+        pool.deallocate(block, 16);
+        EXPECT_NE(pool.allocate(17), block);
+    }
+
+    TEST(LuaUtilSmallBlockPoolTest, allocateShouldAddSlabsWhenFull)
+    {
+        SmallBlockPool pool;
+        std::vector<void*> blocks;
+        for (std::size_t i = 0; i < 2 * SmallBlockPool::sSlabSize / SmallBlockPool::sMaxBlockSize; ++i)
+            blocks.push_back(pool.allocate(SmallBlockPool::sMaxBlockSize));
+        EXPECT_EQ(pool.getReservedSize(), 2 * SmallBlockPool::sSlabSize);
+        EXPECT_EQ(std::set<void*>(blocks.begin(), blocks.end()).size(), blocks.size());
+    }
+}
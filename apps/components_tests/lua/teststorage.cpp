@@ -60,6 +60,13 @@ namespace
             EXPECT_EQ(get<int>(lua, "ro:get('y')"), 7);
 
             EXPECT_THAT(get<std::string>(lua, "table.concat(callbackCalls, ', ')"), "test_x, test_*, test_*");
+
+            lua.safe_script("mutable:setValues({x=1, z=2})");
+            EXPECT_EQ(get<int>(lua, "ro:get('x')"), 1);
+            EXPECT_EQ(get<int>(lua, "ro:get('y')"), 7);
+            EXPECT_EQ(get<int>(lua, "ro:get('z')"), 2);
+            EXPECT_THAT(
+                get<std::string>(lua, "table.concat(callbackCalls, ', ')"), "test_x, test_*, test_*, test_*");
         });
     }
 
@@ -100,7 +107,8 @@ namespace
             lua.safe_script("temporary:set('y', 2)");
 
             const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage.bin";
-            storage.save(lua, tmpFile);
+            storage.save(tmpFile);
+            storage.waitForSave();
             EXPECT_EQ(get<int>(lua, "permanent:get('x')"), 1);
             EXPECT_EQ(get<int>(lua, "temporary:get('y')"), 2);
 
@@ -125,4 +133,38 @@ namespace
         });
     }
 
+    TEST(LuaUtilStorageTest, SavingShouldBeSkippedWithoutChanges)
+    {
+        LuaUtil::LuaState luaState{ nullptr, nullptr };
+        luaState.protectedCall([](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            auto& lua = view.sol();
+            const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_unchanged.bin";
+
+            {
+                LuaUtil::LuaStorage storage;
+                storage.setActive(true);
+                lua["section"] = storage.getMutableSection(lua, "section");
+                lua.safe_script("section:set('x', { y = 'abc', z = 7 })");
+                storage.save(tmpFile);
+                storage.waitForSave();
+            }
+
+            LuaUtil::LuaStorage storage;
+            storage.setActive(true);
+            storage.load(lua, tmpFile);
+            std::filesystem::remove(tmpFile);
+            storage.save(tmpFile);
+            storage.waitForSave();
+            EXPECT_FALSE(std::filesystem::exists(tmpFile));
+
+            lua["section"] = storage.getMutableSection(lua, "section");
+            EXPECT_EQ(get<std::string>(lua, "section:get('x').y"), "abc");
+            lua.safe_script("section:set('w', 1)");
+            storage.save(tmpFile);
+            storage.waitForSave();
+            EXPECT_TRUE(std::filesystem::exists(tmpFile));
+        });
+    }
+
 }
@@ -232,4 +232,72 @@ namespace
     {
         EXPECT_EQ(ciFind("foobar", "baz"), std::string_view::npos);
     }
+
+    TEST(MiscStringsCiFind, should_find_substring_longer_than_block)
+    {
+        EXPECT_EQ(ciFind("meshes/x/EX_HLAALU_B_01.NIF meshes/x/ex_hlaalu_b_02.nif", "MESHES/X/EX_HLAALU_B_02"), 28);
+    }
+
+    std::string makeAllBytes()
+    {
+        std::string result;
+        for (int i = 0; i < 256; ++i)
+            result.push_back(static_cast<char>(i));
+        return result;
+    }
+
+    TEST(MiscStringsLowerCase, should_lower_case_only_ascii_letters_of_any_length)
+    {
+        const std::string bytes = makeAllBytes();
+        for (std::size_t size = 0; size <= bytes.size(); ++size)
+        {
+            const std::string_view value = std::string_view(bytes).substr(bytes.size() - size);
+            std::string expected(value);
+            for (char& c : expected)
+                if (c >= 'A' && c <= 'Z')
+                    c = static_cast<char>(c - 'A' + 'a');
+            EXPECT_EQ(lowerCase(value), expected) << size;
+        }
+    }
+
+    TEST(MiscStringsCiEqual, should_compare_every_byte_of_long_strings)
+    {
+        const std::string value = "Meshes\\Xbase_anim.1st.NIF\xC4\xE4 ";
+        for (std::size_t size = 0; size <= value.size(); ++size)
+        {
+            const std::string prefix = value.substr(0, size);
+            EXPECT_TRUE(ciEqual(prefix, lowerCase(prefix))) << size;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                std::string changed = prefix;
+                changed[i] = static_cast<char>(changed[i] ^ 0x40);
+                EXPECT_FALSE(ciEqual(prefix, changed)) << size << " " << i;
+            }
+        }
+    }
+
+    TEST(MiscStringsCiLess, should_match_lexicographical_compare_of_lower_case_characters)
+    {
+        const std::string value = "ex_hlaalu_b_01 \xC4\x7F\x80 ZA[a_`{";
+        for (std::size_t size = 0; size <= value.size(); ++size)
+            for (std::size_t i = 0; i < size; ++i)
+                for (char c : makeAllBytes())
+                {
+                    const std::string left = value.substr(0, size);
+                    std::string right = left;
+                    right[i] = c;
+                    right.resize(size - (i + size) % 2);
+                    const bool expected = std::lexicographical_compare(
+                        left.begin(), left.end(), right.begin(), right.end(), CiCharLess());
+                    ASSERT_EQ(ciLess(left, right), expected) << size << " " << i << " " << int(c);
+                    ASSERT_EQ(ciCompareLen(left, right, size), expected ? -1 : (ciLess(right, left) ? 1 : 0))
+                        << size << " " << i << " " << int(c);
+                }
+    }
+
+    TEST(MiscStringsCiEndsWith, should_compare_suffix_longer_than_block)
+    {
+        EXPECT_TRUE(ciEndsWith("textures/tx_ashl_banner_01.DDS", "TX_ASHL_BANNER_01.dds"));
+        EXPECT_FALSE(ciEndsWith("textures/tx_ashl_banner_01.dds", "tx_ashl_banner_02.dds"));
+    }
 }
@@ -0,0 +1,172 @@
+#include <components/myguiplatform/textureatlas.hpp>
+
+#include <osg/Image>
+#include <osg/Texture2D>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MyGUIPlatform;
+
+    constexpr int pageSize = 1024;
+
+    osg::ref_ptr<osg::Image> makeImage(int width, int height)
+    {
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        image->setInternalTextureFormat(GL_RGBA8);
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+            {
+                unsigned char* pixel = image->data(x, y);
+                pixel[0] = static_cast<unsigned char>(x);
+                pixel[1] = static_cast<unsigned char>(y);
+                pixel[2] = 0;
+                pixel[3] = 255;
+            }
+        return image;
+    }
+
+    // Position of the image in the page, in rows of the page image
+    void getPosition(const TextureAtlas::Region& region, int height, int& x, int& y)
+    {
+        x = static_cast<int>(region.mOffset.x() * pageSize + 0.5f);
+        y = pageSize - height - static_cast<int>(region.mOffset.y() * pageSize + 0.5f);
+    }
+
+    const osg::Image& getPageImage(const TextureAtlas::Region& region)
+    {
+        return *TextureAtlas::getTexture(*region.mPage)->getImage();
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldNotPackLargeImages)
+    {
+        TextureAtlas atlas;
+        EXPECT_FALSE(atlas.add(*makeImage(128, 32)));
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldPackSameImageOnce)
+    {
+        TextureAtlas atlas;
+        const osg::ref_ptr<osg::Image> image = makeImage(32, 32);
+        const auto first = atlas.add(*image);
+        const auto second = atlas.add(*image);
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        EXPECT_EQ(first->mPage, second->mPage);
+        EXPECT_EQ(first->mOffset, second->mOffset);
+        EXPECT_EQ(first->mScale, osg::Vec2f(32.f / pageSize, 32.f / pageSize));
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldPackImagesWithDifferentFormatsIntoDifferentPages)
+    {
+        TextureAtlas atlas;
+        const osg::ref_ptr<osg::Image> rgba = makeImage(16, 16);
+        osg::ref_ptr<osg::Image> luminance = new osg::Image;
+        luminance->allocateImage(16, 16, 1, GL_LUMINANCE, GL_UNSIGNED_BYTE);
+        luminance->setInternalTextureFormat(GL_LUMINANCE8);
+        const auto first = atlas.add(*rgba);
+        const auto second = atlas.add(*luminance);
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        EXPECT_NE(first->mPage, second->mPage);
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldCopyPixelsAndClampBorders)
+    {
+        TextureAtlas atlas;
+        const osg::ref_ptr<osg::Image> image = makeImage(8, 4);
+        atlas.add(*makeImage(16, 16));
+        const auto region = atlas.add(*image);
+        ASSERT_TRUE(region);
+
+        int x = 0;
+        int y = 0;
+        getPosition(*region, 4, x, y);
+        const osg::Image& page = getPageImage(*region);
+        for (int row = -1; row <= 4; ++row)
+            for (int column = -1; column <= 8; ++column)
+            {
+                const unsigned char* pixel = page.data(x + column, y + row);
+                EXPECT_EQ(pixel[0], std::clamp(column, 0, 7)) << column << " " << row;
+                EXPECT_EQ(pixel[1], std::clamp(row, 0, 3)) << column << " " << row;
+            }
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldNotModifyTextureInUse)
+    {
+        TextureAtlas atlas;
+        const auto first = atlas.add(*makeImage(16, 16));
+        ASSERT_TRUE(first);
+        const osg::ref_ptr<osg::Texture2D> texture = TextureAtlas::getTexture(*first->mPage);
+        const osg::ref_ptr<osg::Image> image = texture->getImage();
+        const unsigned int modifiedCount = image->getModifiedCount();
+
+        const auto second = atlas.add(*makeImage(16, 16));
+        ASSERT_TRUE(second);
+        EXPECT_EQ(first->mPage, second->mPage);
+        EXPECT_NE(TextureAtlas::getTexture(*first->mPage), texture);
+        EXPECT_EQ(texture->getImage(), image);
+        EXPECT_EQ(image->getModifiedCount(), modifiedCount);
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldStartNewPageWhenFull)
+    {
+        TextureAtlas atlas;
+        // Cells are 72 texels wide with borders, so 14 fit in a row and 14 rows in a page
+        std::vector<osg::ref_ptr<osg::Image>> images;
+        for (int i = 0; i < 14 * 14 + 1; ++i)
+            images.push_back(makeImage(64, 64));
+        const auto first = atlas.add(*images.front());
+        for (std::size_t i = 1; i + 1 < images.size(); ++i)
+            EXPECT_EQ(atlas.add(*images[i])->mPage, first->mPage);
+        EXPECT_NE(atlas.add(*images.back())->mPage, first->mPage);
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldNotPackCompressedImagesOfPartialBlocks)
+    {
+        TextureAtlas atlas;
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(6, 6, 1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, GL_UNSIGNED_BYTE);
+        EXPECT_FALSE(atlas.add(*image));
+    }
+
+    TEST(MyGUIPlatformTextureAtlasTest, shouldMirrorBorderBlocksOfCompressedImages)
+    {
+        TextureAtlas atlas;
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(4, 4, 1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, GL_UNSIGNED_BYTE);
+        image->setInternalTextureFormat(GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+        // Two reference colours followed by one byte of 2 bit indices per row
+        const std::uint8_t block[8] = { 0x12, 0x34, 0x56, 0x78, 0b11100100, 0b00011011, 0b01010101, 0b11111111 };
+        std::memcpy(image->data(), block, sizeof(block));
+
+        const auto region = atlas.add(*image);
+        ASSERT_TRUE(region);
+
+        int x = 0;
+        int y = 0;
+        getPosition(*region, 4, x, y);
+        const osg::Image& page = getPageImage(*region);
+        const auto getBlock = [&](int blockX, int blockY) {
+            return page.data() + ((y / 4 + blockY) * (pageSize / 4) + x / 4 + blockX) * sizeof(block);
+        };
+
+        EXPECT_EQ(std::memcmp(getBlock(0, 0), block, sizeof(block)), 0);
+
+        const std::uint8_t horizontal[8] = { 0x12, 0x34, 0x56, 0x78, 0b00011011, 0b11100100, 0b01010101, 0b11111111 };
+        EXPECT_EQ(std::memcmp(getBlock(-1, 0), horizontal, sizeof(block)), 0);
+        EXPECT_EQ(std::memcmp(getBlock(1, 0), horizontal, sizeof(block)), 0);
+
+        const std::uint8_t vertical[8] = { 0x12, 0x34, 0x56, 0x78, 0b11111111, 0b01010101, 0b00011011, 0b11100100 };
+        EXPECT_EQ(std::memcmp(getBlock(0, -1), vertical, sizeof(block)), 0);
+        EXPECT_EQ(std::memcmp(getBlock(0, 1), vertical, sizeof(block)), 0);
+    }
+}
@@ -0,0 +1,84 @@
+#include <components/nif/recordarena.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Nif
+{
+    namespace
+    {
+        struct TestRecord : Record
+        {
+            std::vector<int>* mDestroyed = nullptr;
+            int mId = 0;
+
+            void read(NIFStream* /*nif*/) override {}
+
+            ~TestRecord() override
+            {
+                if (mDestroyed != nullptr)
+                    mDestroyed->push_back(mId);
+            }
+        };
+
+        struct alignas(64) AlignedRecord : Record
+        {
+            void read(NIFStream* /*nif*/) override {}
+        };
+
+        struct ThrowingRecord : Record
+        {
+            ThrowingRecord() { throw std::runtime_error("test"); }
+
+            void read(NIFStream* /*nif*/) override {}
+        };
+
+        TEST(NifRecordArenaTest, shouldDestroyRecordsInReverseOrderOfCreation)
+        {
+            std::vector<int> destroyed;
+            {
+                RecordArena arena;
+                for (int i = 0; i < 3; ++i)
+                {
+                    TestRecord* const record = arena.create<TestRecord>();
+                    record->mDestroyed = &destroyed;
+                    record->mId = i;
+                }
+                EXPECT_EQ(arena.size(), 3);
+            }
+            EXPECT_EQ(destroyed, (std::vector<int>{ 2, 1, 0 }));
+        }
+
+        TEST(NifRecordArenaTest, shouldCreateRecordsBeyondReservedSize)
+        {
+            RecordArena arena;
+            arena.reserve(sizeof(TestRecord));
+            std::vector<TestRecord*> records;
+            for (int i = 0; i < 1000; ++i)
+            {
+                records.push_back(arena.create<TestRecord>());
+                records.back()->mId = i;
+            }
+            for (int i = 0; i < 1000; ++i)
+                EXPECT_EQ(records[i]->mId, i);
+        }
+
+        TEST(NifRecordArenaTest, shouldAlignRecords)
+        {
+            RecordArena arena;
+            arena.create<TestRecord>();
+            const AlignedRecord* const record = arena.create<AlignedRecord>();
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(record) % alignof(AlignedRecord), 0);
+        }
+
+        TEST(NifRecordArenaTest, shouldNotKeepRecordWhenConstructorThrows)
+        {
+            RecordArena arena;
+            EXPECT_THROW(arena.create<ThrowingRecord>(), std::runtime_error);
+            EXPECT_EQ(arena.size(), 0);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    std::shared_ptr<Nif::FloatKeyMap> makeKeys(
+        unsigned int interpolationType, std::initializer_list<std::pair<float, float>> keys)
+    {
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = interpolationType;
+        for (const auto& [time, value] : keys)
+            result->mKeys.emplace_back(time, Nif::FloatKeyMap::KeyType{ value, 0, 0 });
+        return result;
+    }
+
+    TEST(NifOsgValueInterpolatorTest, emptyKeysShouldGiveDefaultValue)
+    {
+        const FloatInterpolator interpolator(nullptr, 42);
+        EXPECT_TRUE(interpolator.empty());
+        EXPECT_EQ(interpolator.interpKey(1), 42);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldClampToFirstAndLastKeys)
+    {
+        const FloatInterpolator interpolator(makeKeys(Nif::InterpolationType_Linear, { { 1, 10 }, { 2, 20 } }));
+        EXPECT_EQ(interpolator.interpKey(0), 10);
+        EXPECT_EQ(interpolator.interpKey(3), 20);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldInterpolateLinearKeys)
+    {
+        const FloatInterpolator interpolator(
+            makeKeys(Nif::InterpolationType_Linear, { { 0, 0 }, { 1, 10 }, { 3, 30 }, { 3.5f, 0 } }));
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 5);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(2), 20);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3.25f), 15);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.25f), 2.5f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldUseNearestConstantKey)
+    {
+        const FloatInterpolator interpolator(makeKeys(Nif::InterpolationType_Constant, { { 0, 1 }, { 1, 2 } }));
+        EXPECT_EQ(interpolator.interpKey(0.25f), 1);
+        EXPECT_EQ(interpolator.interpKey(0.75f), 2);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldFindEvenlySpacedKeysInAnyOrder)
+    {
+        const FloatInterpolator interpolator(makeKeys(
+            Nif::InterpolationType_Linear, { { 0, 0 }, { 0.1f, 1 }, { 0.2f, 2 }, { 0.3f, 3 }, { 0.4f, 4 } }));
+        EXPECT_NEAR(interpolator.interpKey(0.35f), 3.5f, 1e-5f);
+        EXPECT_NEAR(interpolator.interpKey(0.05f), 0.5f, 1e-5f);
+        EXPECT_NEAR(interpolator.interpKey(0.2f), 2, 1e-5f);
+        EXPECT_NEAR(interpolator.interpKey(0.25f), 2.5f, 1e-5f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldInterpolateAroundKeysWithSameTime)
+    {
+        const FloatInterpolator interpolator(
+            makeKeys(Nif::InterpolationType_Linear, { { 0, 0 }, { 1, 10 }, { 1, 20 }, { 2, 30 } }));
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 5);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1.5f), 25);
+    }
+}
@@ -0,0 +1,111 @@
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapecache.hpp>
+#include <components/testing/util.hpp>
+
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    CollisionShapePtr makeTriangleMeshCompound()
+    {
+        auto mesh = std::make_unique<btTriangleMesh>();
+        mesh->addTriangle(btVector3(0, 0, 0), btVector3(1, 0, 0), btVector3(0, 1, 0));
+        mesh->addTriangle(btVector3(1, 0, 0), btVector3(1, 1, 0), btVector3(0, 1, 0));
+        auto meshShape = std::make_unique<TriangleMeshShape>(mesh.release(), true);
+        auto scaledShape = std::make_unique<ScaledTriangleMeshShape>(meshShape.release(), btVector3(2, 2, 2));
+        std::unique_ptr<btCompoundShape, DeleteCollisionShape> compound(new btCompoundShape);
+        btTransform transform = btTransform::getIdentity();
+        transform.setOrigin(btVector3(1, 2, 3));
+        compound->addChildShape(transform, scaledShape.release());
+        return CollisionShapePtr(compound.release());
+    }
+
+    struct ResourceBulletShapeCacheTest : Test
+    {
+        TestingOpenMW::VFSTestFile mFile{ "content" };
+        TestingOpenMW::VFSTestFile mChangedFile{ "changed content" };
+        const std::unique_ptr<VFS::Manager> mVFS = TestingOpenMW::createTestVFS({
+            { VFS::Path::NormalizedView("meshes/a.nif"), &mFile },
+            { VFS::Path::NormalizedView("meshes/b.nif"), &mChangedFile },
+            { VFS::Path::NormalizedView("meshes/a.dae"), &mFile },
+        });
+        const BulletShapeCache mCache{ *mVFS, TestingOpenMW::outputDirPath("bulletshapecache") };
+    };
+
+    TEST_F(ResourceBulletShapeCacheTest, makeKey_should_return_nullopt_for_not_nif_files)
+    {
+        EXPECT_EQ(mCache.makeKey(VFS::Path::NormalizedView("meshes/a.dae")), std::nullopt);
+    }
+
+    TEST_F(ResourceBulletShapeCacheTest, makeKey_should_depend_on_path_and_content)
+    {
+        const auto a = mCache.makeKey(VFS::Path::NormalizedView("meshes/a.nif"));
+        const auto b = mCache.makeKey(VFS::Path::NormalizedView("meshes/b.nif"));
+        ASSERT_TRUE(a.has_value());
+        ASSERT_TRUE(b.has_value());
+        EXPECT_NE(*a, *b);
+        EXPECT_EQ(mCache.makeKey(VFS::Path::NormalizedView("meshes/a.nif")), a);
+    }
+
+    TEST_F(ResourceBulletShapeCacheTest, read_should_return_nullptr_when_there_is_no_shape)
+    {
+        EXPECT_EQ(mCache.read("missing"), nullptr);
+    }
+
+    TEST_F(ResourceBulletShapeCacheTest, read_should_return_nullptr_for_invalid_file)
+    {
+        std::ofstream(TestingOpenMW::outputDirPath("bulletshapecache") / "invalid.shape") << "invalid";
+        EXPECT_EQ(mCache.read("invalid"), nullptr);
+    }
+
+    TEST_F(ResourceBulletShapeCacheTest, read_should_return_written_shape)
+    {
+        BulletShape shape;
+        shape.mFileName = VFS::Path::Normalized("meshes/a.nif");
+        shape.mFileHash = "hash";
+        shape.mCollisionBox.mExtents = osg::Vec3f(1, 2, 3);
+        shape.mCollisionBox.mCenter = osg::Vec3f(4, 5, 6);
+        shape.mVisualCollisionType = VisualCollisionType::Camera;
+        shape.mAnimatedShapes.emplace(42, 0);
+        shape.mCollisionShape = makeTriangleMeshCompound();
+
+        mCache.write("shape", shape);
+        const osg::ref_ptr<BulletShape> result = mCache.read("shape");
+
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result->mFileName, shape.mFileName);
+        EXPECT_EQ(result->mFileHash, shape.mFileHash);
+        EXPECT_EQ(result->mCollisionBox.mExtents, shape.mCollisionBox.mExtents);
+        EXPECT_EQ(result->mCollisionBox.mCenter, shape.mCollisionBox.mCenter);
+        EXPECT_EQ(result->mVisualCollisionType, shape.mVisualCollisionType);
+        EXPECT_EQ(result->mAnimatedShapes, shape.mAnimatedShapes);
+        EXPECT_EQ(result->mAvoidCollisionShape, nullptr);
+        ASSERT_NE(result->mCollisionShape, nullptr);
+        ASSERT_TRUE(result->mCollisionShape->isCompound());
+
+        const btCompoundShape& expected = static_cast<const btCompoundShape&>(*shape.mCollisionShape);
+        const btCompoundShape& actual = static_cast<const btCompoundShape&>(*result->mCollisionShape);
+        ASSERT_EQ(actual.getNumChildShapes(), 1);
+        EXPECT_EQ(actual.getChildTransform(0).getOrigin(), expected.getChildTransform(0).getOrigin());
+        ASSERT_EQ(actual.getChildShape(0)->getShapeType(), SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE);
+        EXPECT_EQ(actual.getChildShape(0)->getLocalScaling(), btVector3(2, 2, 2));
+
+        btVector3 expectedMin;
+        btVector3 expectedMax;
+        expected.getAabb(btTransform::getIdentity(), expectedMin, expectedMax);
+        btVector3 actualMin;
+        btVector3 actualMax;
+        actual.getAabb(btTransform::getIdentity(), actualMin, actualMax);
+        EXPECT_EQ(actualMin, expectedMin);
+        EXPECT_EQ(actualMax, expectedMax);
+    }
+}
@@ -0,0 +1,52 @@
+#include <components/resource/memoryregistry.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    TEST(ResourceMemoryRegistryTest, shouldCollectSubsystemsOnUpdate)
+    {
+        MemoryRegistry registry;
+        std::size_t physics = 1;
+        registry.add("Physics", [&] { return MemoryUsage{ .mCpu = physics }; });
+        registry.add("Cells", [] { return MemoryUsage{ .mCpu = 2, .mGpu = 3 }; });
+        EXPECT_THAT(registry.getSubsystems(), IsEmpty());
+
+        registry.update();
+        physics = 10;
+        const MemoryRegistry::Subsystems subsystems = registry.getSubsystems();
+        ASSERT_EQ(subsystems.size(), 2);
+        EXPECT_EQ(subsystems[0].first, "Cells");
+        EXPECT_EQ(subsystems[1].first, "Physics");
+        EXPECT_EQ(subsystems[1].second.mCpu, 1);
+
+        const MemoryUsage total = registry.getTotal();
+        EXPECT_EQ(total.mCpu, 3);
+        EXPECT_EQ(total.mGpu, 3);
+    }
+
+    TEST(ResourceMemoryRegistryTest, removeShouldDropSubsystemFromCollectedValues)
+    {
+        MemoryRegistry registry;
+        registry.add("Lua", [] { return MemoryUsage{ .mCpu = 1 }; });
+        registry.update();
+        registry.remove("Lua");
+        EXPECT_THAT(registry.getSubsystems(), IsEmpty());
+        registry.update();
+        EXPECT_THAT(registry.getSubsystems(), IsEmpty());
+    }
+
+    TEST(ResourceMemoryRegistryTest, formatMemoryUsageShouldIncludeTotal)
+    {
+        const MemoryRegistry::Subsystems subsystems = {
+            { "Lua", MemoryUsage{ .mCpu = 1024 * 1024, .mGpu = 0 } },
+        };
+        EXPECT_EQ(formatMemoryUsage(subsystems),
+            "Lua: 1.0 MB CPU, 0.0 MB GPU\n"
+            "Total: 1.0 MB CPU, 0.0 MB GPU\n");
+    }
+}
@@ -5,6 +5,9 @@
 
 #include <osg/Object>
 
+#include <set>
+#include <string>
+
 namespace Resource
 {
     namespace
@@ -139,6 +142,90 @@ namespace Resource
             EXPECT_THAT(cache->getRefFromObjectCacheOrNone(key), Optional(value));
         }
 
+        TEST(ResourceGenericObjectCacheTest, updateShouldEvictLeastRecentlyUsedItemsAboveMaxSize)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setMaxSize(200);
+
+            const double expiryDelay = 100;
+
+            cache->addEntryToObjectCache(1, new Object, CacheEntryCost{ .mSize = 100 }, 1);
+            cache->addEntryToObjectCache(2, new Object, CacheEntryCost{ .mSize = 100 }, 2);
+            cache->addEntryToObjectCache(3, new Object, CacheEntryCost{ .mSize = 100 }, 3);
+
+            cache->update(4, expiryDelay);
+
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(1), std::nullopt);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(2), Optional(_));
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(3), Optional(_));
+
+            const CacheStats stats = cache->getStats();
+            EXPECT_EQ(stats.mEvicted, 1);
+            EXPECT_EQ(stats.mExpired, 0);
+            EXPECT_EQ(stats.mMemory, 200);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldPreferEvictingItemsQuickToLoad)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setMaxSize(100);
+
+            const double expiryDelay = 100;
+
+            cache->addEntryToObjectCache(1, new Object, CacheEntryCost{ .mSize = 100, .mLoadTime = 1 }, 1);
+            cache->addEntryToObjectCache(2, new Object, CacheEntryCost{ .mSize = 100, .mLoadTime = 0 }, 2);
+
+            cache->update(3, expiryDelay);
+
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(_));
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldNotEvictExternallyReferencedItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setMaxSize(100);
+
+            const double expiryDelay = 100;
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(1, value, CacheEntryCost{ .mSize = 100 }, 1);
+            cache->addEntryToObjectCache(2, new Object, CacheEntryCost{ .mSize = 100 }, 2);
+
+            cache->update(3, expiryDelay);
+
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(value));
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldNotEvictWithoutMaxSize)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+
+            const double expiryDelay = 100;
+
+            cache->addEntryToObjectCache(1, new Object, CacheEntryCost{ .mSize = 100 }, 1);
+            cache->addEntryToObjectCache(2, new Object, CacheEntryCost{ .mSize = 100 }, 2);
+
+            cache->update(3, expiryDelay);
+
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(_));
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(2), Optional(_));
+            EXPECT_EQ(cache->getStats().mMemory, 200);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, addEntryToObjectCacheShouldReplaceSizeOfExistingItem)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+
+            cache->addEntryToObjectCache(1, new Object, CacheEntryCost{ .mSize = 100 });
+            cache->addEntryToObjectCache(1, new Object, CacheEntryCost{ .mSize = 30 });
+            EXPECT_EQ(cache->getStats().mMemory, 30);
+
+            cache->removeFromObjectCache(1);
+            EXPECT_EQ(cache->getStats().mMemory, 0);
+        }
+
         TEST(ResourceGenericObjectCacheTest, updateShouldKeepNotExpiredItems)
         {
             osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
@@ -373,5 +460,67 @@ namespace Resource
             cache->addEntryToObjectCache(key, value);
             EXPECT_TRUE(cache->checkInObjectCache(std::string_view("key"), 0));
         }
+
+        TEST(ResourceGenericObjectCacheTest, lowerBoundShouldReturnLeastKeyFromAllShards)
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> cache(new GenericObjectCache<std::string>);
+            for (int i = 0; i < 100; i += 2)
+                cache->addEntryToObjectCache(std::to_string(1000 + i), nullptr);
+            for (int i = 0; i < 98; i += 2)
+            {
+                EXPECT_THAT(cache->lowerBound(std::to_string(1000 + i)), Optional(Pair(std::to_string(1000 + i), _)));
+                EXPECT_THAT(
+                    cache->lowerBound(std::to_string(1000 + i + 1)), Optional(Pair(std::to_string(1000 + i + 2), _)))
+                    << i;
+            }
+            EXPECT_EQ(cache->lowerBound(std::to_string(1099)), std::nullopt);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getStatsShouldSumAllShards)
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> cache(new GenericObjectCache<std::string>);
+            for (int i = 0; i < 100; ++i)
+                cache->addEntryToObjectCache(std::to_string(i), nullptr, CacheEntryCost{ .mSize = 10 });
+            for (int i = 0; i < 200; ++i)
+                cache->getRefFromObjectCache(std::to_string(i));
+            const CacheStats stats = cache->getStats();
+            EXPECT_EQ(stats.mSize, 100);
+            EXPECT_EQ(stats.mMemory, 1000);
+            EXPECT_EQ(stats.mGet, 200);
+            EXPECT_EQ(stats.mHit, 100);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldEvictLeastRecentlyUsedItemsFromAllShards)
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> cache(new GenericObjectCache<std::string>);
+            cache->setMaxSize(500);
+
+            const double expiryDelay = 1000;
+
+            for (int i = 0; i < 100; ++i)
+                cache->addEntryToObjectCache(std::to_string(i), new Object, CacheEntryCost{ .mSize = 10 }, i + 1);
+
+            cache->update(101, expiryDelay);
+
+            for (int i = 0; i < 50; ++i)
+                EXPECT_EQ(cache->getRefFromObjectCacheOrNone(std::to_string(i)), std::nullopt) << i;
+            for (int i = 50; i < 100; ++i)
+                EXPECT_THAT(cache->getRefFromObjectCacheOrNone(std::to_string(i)), Optional(_)) << i;
+            EXPECT_EQ(cache->getStats().mEvicted, 50);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, callShouldVisitItemsFromAllShards)
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> cache(new GenericObjectCache<std::string>);
+            std::set<std::string> expected;
+            for (int i = 0; i < 100; ++i)
+            {
+                cache->addEntryToObjectCache(std::to_string(i), nullptr);
+                expected.insert(std::to_string(i));
+            }
+            std::set<std::string> actual;
+            cache->call([&](const std::string& key, osg::Object* /*value*/) { actual.insert(key); });
+            EXPECT_EQ(actual, expected);
+        }
     }
 }
@@ -0,0 +1,193 @@
+#include <components/resource/texturecompressor.hpp>
+
+#include <osg/Image>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    using Texels = std::array<std::uint8_t, 16 * 4>;
+
+    std::array<int, 3> decodeRgb565(const std::uint8_t* data)
+    {
+        const int value = data[0] | (data[1] << 8);
+        const int r = (value >> 11) & 31;
+        const int g = (value >> 5) & 63;
+        const int b = value & 31;
+        return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+    }
+
+    std::array<int, 3> decodeBc1Texel(const std::uint8_t* block, std::size_t texel)
+    {
+        const std::array<int, 3> color0 = decodeRgb565(block);
+        const std::array<int, 3> color1 = decodeRgb565(block + 2);
+        const int index = (block[4 + texel / 4] >> (2 * (texel % 4))) & 3;
+        std::array<int, 3> result;
+        for (std::size_t channel = 0; channel < 3; ++channel)
+        {
+            const int weights[4][2] = { { 3, 0 }, { 0, 3 }, { 2, 1 }, { 1, 2 } };
+            result[channel] = (weights[index][0] * color0[channel] + weights[index][1] * color1[channel]) / 3;
+        }
+        return result;
+    }
+
+    int decodeBc3AlphaTexel(const std::uint8_t* block, std::size_t texel)
+    {
+        std::uint64_t indices = 0;
+        for (std::size_t i = 0; i < 6; ++i)
+            indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+        const int index = static_cast<int>((indices >> (3 * texel)) & 7);
+        if (index < 2)
+            return block[index];
+        return ((8 - index) * block[0] + (index - 1) * block[1]) / 7;
+    }
+
+    Texels makeTexels(auto&& getTexel)
+    {
+        Texels result;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const std::array<std::uint8_t, 4> texel = getTexel(i);
+            for (std::size_t channel = 0; channel < 4; ++channel)
+                result[i * 4 + channel] = texel[channel];
+        }
+        return result;
+    }
+
+    int getMaxColorError(const Texels& texels)
+    {
+        std::array<std::uint8_t, 8> block;
+        encodeBc1Block(texels.data(), block.data());
+        int result = 0;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const std::array<int, 3> decoded = decodeBc1Texel(block.data(), i);
+            for (std::size_t channel = 0; channel < 3; ++channel)
+                result = std::max(result, std::abs(decoded[channel] - texels[i * 4 + channel]));
+        }
+        return result;
+    }
+
+    osg::ref_ptr<osg::Image> makeImage(int width, int height, GLenum format, std::uint8_t alpha)
+    {
+        osg::ref_ptr<osg::Image> image(new osg::Image);
+        image->allocateImage(width, height, 1, format, GL_UNSIGNED_BYTE);
+        const int components = format == GL_RGBA ? 4 : 3;
+        for (int i = 0; i < width * height; ++i)
+        {
+            image->data()[i * components] = static_cast<std::uint8_t>(i * 7);
+            image->data()[i * components + 1] = static_cast<std::uint8_t>(i * 3);
+            image->data()[i * components + 2] = 128;
+            if (components == 4)
+                image->data()[i * components + 3] = alpha;
+        }
+        return image;
+    }
+
+    TEST(ResourceTextureCompressorTest, encodeBc1BlockShouldKeepSolidColor)
+    {
+        const Texels texels = makeTexels([](std::size_t) { return std::array<std::uint8_t, 4>{ 255, 0, 0, 255 }; });
+        EXPECT_EQ(getMaxColorError(texels), 0);
+    }
+
+    TEST(ResourceTextureCompressorTest, encodeBc1BlockShouldKeepTwoColors)
+    {
+        const Texels texels = makeTexels([](std::size_t i) {
+            const std::uint8_t value = i % 3 == 0 ? 255 : 0;
+            return std::array<std::uint8_t, 4>{ value, value, value, 255 };
+        });
+        EXPECT_EQ(getMaxColorError(texels), 0);
+    }
+
+    TEST(ResourceTextureCompressorTest, encodeBc1BlockShouldApproximateGradient)
+    {
+        const Texels texels = makeTexels([](std::size_t i) {
+            const auto value = static_cast<std::uint8_t>(i * 16);
+            return std::array<std::uint8_t, 4>{ value, static_cast<std::uint8_t>(value / 2), 64, 255 };
+        });
+        EXPECT_LE(getMaxColorError(texels), 40);
+    }
+
+    TEST(ResourceTextureCompressorTest, encodeBc1BlockShouldSelectFourColorMode)
+    {
+        const Texels texels = makeTexels([](std::size_t i) {
+            const auto value = static_cast<std::uint8_t>(255 - i * 16);
+            return std::array<std::uint8_t, 4>{ value, value, value, 255 };
+        });
+        std::array<std::uint8_t, 8> block;
+        encodeBc1Block(texels.data(), block.data());
+        EXPECT_GT(block[0] | (block[1] << 8), block[2] | (block[3] << 8));
+    }
+
+    TEST(ResourceTextureCompressorTest, encodeBc3AlphaBlockShouldKeepAlphaExtremes)
+    {
+        const Texels texels = makeTexels([](std::size_t i) {
+            return std::array<std::uint8_t, 4>{ 0, 0, 0, static_cast<std::uint8_t>(i % 2 == 0 ? 255 : 0) };
+        });
+        std::array<std::uint8_t, 8> block;
+        encodeBc3AlphaBlock(texels.data(), block.data());
+        for (std::size_t i = 0; i < 16; ++i)
+            EXPECT_EQ(decodeBc3AlphaTexel(block.data(), i), texels[i * 4 + 3]) << i;
+    }
+
+    TEST(ResourceTextureCompressorTest, encodeBc3AlphaBlockShouldApproximateAlphaGradient)
+    {
+        const Texels texels = makeTexels(
+            [](std::size_t i) { return std::array<std::uint8_t, 4>{ 0, 0, 0, static_cast<std::uint8_t>(i * 17) }; });
+        std::array<std::uint8_t, 8> block;
+        encodeBc3AlphaBlock(texels.data(), block.data());
+        for (std::size_t i = 0; i < 16; ++i)
+            EXPECT_LE(std::abs(decodeBc3AlphaTexel(block.data(), i) - texels[i * 4 + 3]), 19) << i;
+    }
+
+    TEST(ResourceTextureCompressorTest, canCompressImageShouldRequireUncompressedRgbWithSizesMultipleOfFour)
+    {
+        EXPECT_TRUE(canCompressImage(*makeImage(8, 4, GL_RGB, 255)));
+        EXPECT_TRUE(canCompressImage(*makeImage(4, 8, GL_RGBA, 255)));
+        EXPECT_FALSE(canCompressImage(*makeImage(6, 4, GL_RGB, 255)));
+        osg::ref_ptr<osg::Image> luminance(new osg::Image);
+        luminance->allocateImage(4, 4, 1, GL_LUMINANCE, GL_UNSIGNED_BYTE);
+        EXPECT_FALSE(canCompressImage(*luminance));
+    }
+
+    TEST(ResourceTextureCompressorTest, compressImageShouldUseDxt1AndGenerateMipmapsForOpaqueImage)
+    {
+        const osg::ref_ptr<osg::Image> image = compressImage(*makeImage(8, 8, GL_RGBA, 255));
+        EXPECT_EQ(image->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGB_S3TC_DXT1_EXT));
+        EXPECT_EQ(image->s(), 8);
+        EXPECT_EQ(image->t(), 8);
+        ASSERT_EQ(image->getNumMipmapLevels(), 4u);
+        EXPECT_EQ(image->getMipmapLevels(), osg::Image::MipmapDataType({ 32, 40, 48 }));
+    }
+
+    TEST(ResourceTextureCompressorTest, compressImageShouldUseDxt5ForTranslucentImage)
+    {
+        const osg::ref_ptr<osg::Image> image = compressImage(*makeImage(4, 4, GL_RGBA, 128));
+        EXPECT_EQ(image->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT));
+        ASSERT_EQ(image->getNumMipmapLevels(), 3u);
+        EXPECT_EQ(image->getMipmapLevels(), osg::Image::MipmapDataType({ 16, 32 }));
+        EXPECT_EQ(image->data()[0], 128);
+        EXPECT_EQ(image->data()[1], 128);
+    }
+
+    TEST(ResourceTextureCompressorTest, compressImageShouldKeepPrecomputedMipmaps)
+    {
+        osg::ref_ptr<osg::Image> source = makeImage(8, 8, GL_RGB, 255);
+        const unsigned size = 8 * 8 * 3 + 4 * 4 * 3;
+        unsigned char* const data = new unsigned char[size]();
+        std::copy(source->data(), source->data() + 8 * 8 * 3, data);
+        source->setImage(8, 8, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, data, osg::Image::USE_NEW_DELETE);
+        source->setMipmapLevels({ 8 * 8 * 3 });
+        const osg::ref_ptr<osg::Image> image = compressImage(*source);
+        ASSERT_EQ(image->getNumMipmapLevels(), 2u);
+        EXPECT_EQ(image->getMipmapLevels(), osg::Image::MipmapDataType({ 32 }));
+    }
+}
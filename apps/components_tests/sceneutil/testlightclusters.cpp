@@ -0,0 +1,71 @@
+#include <components/sceneutil/lightclusters.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct SceneUtilLightClustersTest : Test
+    {
+        LightClusters mClusters{ 2 };
+
+        SceneUtilLightClustersTest() { mClusters.reset(osg::Matrixf::perspective(60, 16.0 / 9.0, 1, 8192)); }
+
+        std::size_t countClustersWithLights() const
+        {
+            std::size_t result = 0;
+            for (int i = 0; i < LightClusters::sCount; ++i)
+                if (!mClusters.getLights(i).empty())
+                    ++result;
+            return result;
+        }
+    };
+
+    TEST_F(SceneUtilLightClustersTest, lightShouldBeInClustersOfPointsInsideItsBounds)
+    {
+        const osg::BoundingSphere bound(osg::Vec3f(100, -50, -1000), 200);
+        mClusters.addLight(bound, 3);
+        for (const osg::Vec3f& offset :
+            { osg::Vec3f(0, 0, 0), osg::Vec3f(199, 0, 0), osg::Vec3f(0, -199, 0), osg::Vec3f(0, 0, 199) })
+            EXPECT_THAT(mClusters.getLights(mClusters.getCluster(bound.center() + offset)), ElementsAre(3.f))
+                << offset.x() << " " << offset.y() << " " << offset.z();
+    }
+
+    TEST_F(SceneUtilLightClustersTest, lightShouldNotBeInClustersFarFromIt)
+    {
+        mClusters.addLight(osg::BoundingSphere(osg::Vec3f(0, 0, -1000), 100), 1);
+        EXPECT_THAT(mClusters.getLights(mClusters.getCluster(osg::Vec3f(0, 0, -5000))), IsEmpty());
+        EXPECT_THAT(mClusters.getLights(mClusters.getCluster(osg::Vec3f(1000, 0, -1000))), IsEmpty());
+    }
+
+    TEST_F(SceneUtilLightClustersTest, lightBehindCameraShouldBeIgnored)
+    {
+        mClusters.addLight(osg::BoundingSphere(osg::Vec3f(0, 0, 500), 100), 1);
+        EXPECT_EQ(countClustersWithLights(), 0);
+    }
+
+    TEST_F(SceneUtilLightClustersTest, lightAroundCameraShouldCoverWholeScreen)
+    {
+        mClusters.addLight(osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10), 1);
+        for (const osg::Vec3f& position : { osg::Vec3f(-5, -5, -1.1f), osg::Vec3f(5, 5, -1.1f) })
+            EXPECT_THAT(mClusters.getLights(mClusters.getCluster(position)), ElementsAre(1.f));
+    }
+
+    TEST_F(SceneUtilLightClustersTest, clusterShouldKeepFirstLightsWhenFull)
+    {
+        const osg::BoundingSphere bound(osg::Vec3f(0, 0, -1000), 100);
+        for (int i = 1; i <= 3; ++i)
+            mClusters.addLight(bound, i);
+        EXPECT_THAT(mClusters.getLights(mClusters.getCluster(bound.center())), ElementsAre(1.f, 2.f));
+    }
+
+    TEST_F(SceneUtilLightClustersTest, resetShouldRemoveLights)
+    {
+        mClusters.addLight(osg::BoundingSphere(osg::Vec3f(0, 0, -1000), 100), 1);
+        mClusters.reset(osg::Matrixf::perspective(60, 16.0 / 9.0, 1, 8192));
+        EXPECT_EQ(countClustersWithLights(), 0);
+    }
+}
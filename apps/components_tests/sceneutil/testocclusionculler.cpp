@@ -0,0 +1,98 @@
+#include <components/sceneutil/occlusionculler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    constexpr int width = 16;
+    constexpr int height = 8;
+
+    // The identity view projection makes world positions match normalized device coordinates, so a window depth of
+    // 0.5 is at z = 0
+    struct SceneUtilDepthPyramidTest : Test
+    {
+        std::vector<float> mDepth = std::vector<float>(width * height, 0.5f);
+        DepthPyramid mPyramid;
+
+        void build(bool reverseZ = false) { mPyramid.build(mDepth, width, height, osg::Matrixf(), reverseZ); }
+    };
+
+    TEST_F(SceneUtilDepthPyramidTest, emptyPyramidShouldNotOccludeAnything)
+    {
+        EXPECT_TRUE(mPyramid.empty());
+        EXPECT_FALSE(mPyramid.isOccluded(osg::BoundingBox(-0.5f, -0.5f, 0.5f, 0.5f, 0.5f, 0.9f)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, shouldHaveLevelsDownToSingleTexel)
+    {
+        build();
+        EXPECT_EQ(mPyramid.getLevelCount(), 5);
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxBehindDepthShouldBeOccluded)
+    {
+        build();
+        EXPECT_TRUE(mPyramid.isOccluded(osg::BoundingBox(-0.5f, -0.5f, 0.1f, 0.5f, 0.5f, 0.9f)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxInFrontOfDepthShouldNotBeOccluded)
+    {
+        build();
+        EXPECT_FALSE(mPyramid.isOccluded(osg::BoundingBox(-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.9f)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxBehindHoleInDepthShouldNotBeOccluded)
+    {
+        mDepth[2 * width + 5] = 1.f;
+        build();
+        // Covers the texel at x = 5, y = 2
+        EXPECT_FALSE(mPyramid.isOccluded(osg::BoundingBox(-0.5f, -0.5f, 0.1f, -0.3f, -0.4f, 0.9f)));
+        EXPECT_TRUE(mPyramid.isOccluded(osg::BoundingBox(0.3f, 0.4f, 0.1f, 0.5f, 0.5f, 0.9f)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxOutsideOfViewShouldNotBeOccluded)
+    {
+        build();
+        EXPECT_FALSE(mPyramid.isOccluded(osg::BoundingBox(1.5f, -0.5f, 0.1f, 2.f, 0.5f, 0.9f)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, reversedDepthShouldOccludeBoxesWithSmallerDepth)
+    {
+        build(true);
+        EXPECT_TRUE(mPyramid.isOccluded(osg::BoundingBox(-0.5f, -0.5f, 0.1f, 0.5f, 0.5f, 0.4f)));
+        EXPECT_FALSE(mPyramid.isOccluded(osg::BoundingBox(-0.5f, -0.5f, 0.1f, 0.5f, 0.5f, 0.6f)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxAroundCameraShouldNotBeOccluded)
+    {
+        mDepth.assign(mDepth.size(), 0.f);
+        mPyramid.build(mDepth, width, height, osg::Matrixf::perspective(60, 2, 1, 1000), false);
+        EXPECT_FALSE(mPyramid.isOccluded(osg::BoundingBox(-10, -10, -100, 10, 10, 10)));
+        EXPECT_TRUE(mPyramid.isOccluded(osg::BoundingBox(-10, -10, -100, 10, 10, -90)));
+    }
+
+    TEST(SceneUtilOcclusionCullerTest, shouldProvideViewProjectionOfRecordedFrame)
+    {
+        OcclusionCuller culler;
+        culler.setViewProjection(42, osg::Matrixf());
+        EXPECT_TRUE(culler.getViewProjection(42).has_value());
+        EXPECT_FALSE(culler.getViewProjection(43).has_value());
+        EXPECT_FALSE(culler.getViewProjection(46).has_value());
+    }
+
+    TEST(SceneUtilOcclusionCullerTest, shouldIgnoreOldDepth)
+    {
+        OcclusionCuller culler;
+        EXPECT_EQ(culler.getDepthPyramid(1), nullptr);
+        const std::vector<float> depth(width * height, 0.5f);
+        culler.setDepth(10, depth, width, height, osg::Matrixf(), false);
+        EXPECT_NE(culler.getDepthPyramid(11), nullptr);
+        EXPECT_NE(culler.getDepthPyramid(10 + OcclusionCuller::sMaxAge), nullptr);
+        EXPECT_EQ(culler.getDepthPyramid(11 + OcclusionCuller::sMaxAge), nullptr);
+    }
+}
@@ -0,0 +1,128 @@
+#include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/parallelupdate.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <osg/FrameStamp>
+#include <osg/Group>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct TestCallback : NodeCallback<TestCallback>, ParallelUpdateCallback
+    {
+        int mSerial = 0;
+        std::atomic_int mParallel{ 0 };
+        bool mCanRunParallel = true;
+
+        void operator()(osg::Node* node, osg::NodeVisitor* nv)
+        {
+            if (!ParallelUpdateVisitor::isUpdated(*node, *this, *this, nv))
+                ++mSerial;
+            traverse(node, nv);
+        }
+
+        bool updateParallel(osg::Node& /*node*/, osg::NodeVisitor& /*nv*/) override
+        {
+            if (!mCanRunParallel)
+                return false;
+            ++mParallel;
+            return true;
+        }
+    };
+
+    struct SceneUtilParallelUpdateVisitorTest : Test
+    {
+        osg::ref_ptr<WorkQueue> mWorkQueue = new WorkQueue(2);
+        osg::ref_ptr<ParallelUpdateVisitor> mVisitor = new ParallelUpdateVisitor(*mWorkQueue, 2);
+        osg::ref_ptr<osg::FrameStamp> mFrameStamp = new osg::FrameStamp;
+        osg::ref_ptr<osg::Group> mRoot = new osg::Group;
+        std::vector<osg::ref_ptr<TestCallback>> mCallbacks;
+
+        SceneUtilParallelUpdateVisitorTest()
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                osg::ref_ptr<osg::Node> node = new osg::Node;
+                mCallbacks.push_back(new TestCallback);
+                node->addUpdateCallback(mCallbacks.back());
+                mRoot->addChild(node);
+            }
+        }
+
+        void updateTraversal()
+        {
+            mVisitor->reset();
+            mVisitor->setFrameStamp(mFrameStamp);
+            mVisitor->setTraversalNumber(mFrameStamp->getFrameNumber());
+            mRoot->accept(*mVisitor);
+        }
+
+        void frame()
+        {
+            mFrameStamp->setFrameNumber(mFrameStamp->getFrameNumber() + 1);
+            mVisitor->updateParallel(mFrameStamp);
+            updateTraversal();
+        }
+    };
+
+    TEST_F(SceneUtilParallelUpdateVisitorTest, firstTraversalShouldUpdateSerially)
+    {
+        frame();
+        for (const osg::ref_ptr<TestCallback>& callback : mCallbacks)
+        {
+            EXPECT_EQ(callback->mSerial, 1);
+            EXPECT_EQ(callback->mParallel, 0);
+        }
+    }
+
+    TEST_F(SceneUtilParallelUpdateVisitorTest, callbacksVisitedByPreviousTraversalShouldUpdateInParallelOnce)
+    {
+        frame();
+        frame();
+        frame();
+        for (const osg::ref_ptr<TestCallback>& callback : mCallbacks)
+        {
+            EXPECT_EQ(callback->mSerial, 1);
+            EXPECT_EQ(callback->mParallel, 2);
+        }
+    }
+
+    TEST_F(SceneUtilParallelUpdateVisitorTest, shouldUpdateSeriallyWhenParallelUpdateIsRefused)
+    {
+        mCallbacks.front()->mCanRunParallel = false;
+        frame();
+        frame();
+        EXPECT_EQ(mCallbacks.front()->mSerial, 2);
+        EXPECT_EQ(mCallbacks.back()->mSerial, 1);
+    }
+
+    TEST_F(SceneUtilParallelUpdateVisitorTest, shouldUpdateSeriallyWithoutParallelUpdate)
+    {
+        frame();
+        mFrameStamp->setFrameNumber(mFrameStamp->getFrameNumber() + 1);
+        updateTraversal();
+        for (const osg::ref_ptr<TestCallback>& callback : mCallbacks)
+        {
+            EXPECT_EQ(callback->mSerial, 2);
+            EXPECT_EQ(callback->mParallel, 0);
+        }
+    }
+
+    TEST_F(SceneUtilParallelUpdateVisitorTest, nodeWithSeveralParentsShouldBeUpdatedOnce)
+    {
+        osg::ref_ptr<osg::Group> other = new osg::Group;
+        other->addChild(mRoot->getChild(0));
+        mRoot->addChild(other);
+        frame();
+        frame();
+        EXPECT_EQ(mCallbacks.front()->mParallel, 1);
+        EXPECT_EQ(mVisitor->getCount(), mCallbacks.size());
+    }
+}
@@ -0,0 +1,80 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    osg::Matrixf makeBoneMatrix(float angle, const osg::Vec3f& translation)
+    {
+        return osg::Matrixf::rotate(angle, osg::Vec3f(0, 0, 1)) * osg::Matrixf::translate(translation);
+    }
+
+    void expectNear(const osg::Vec3f& actual, const osg::Vec3f& expected)
+    {
+        EXPECT_NEAR(actual.x(), expected.x(), 1e-5f);
+        EXPECT_NEAR(actual.y(), expected.y(), 1e-5f);
+        EXPECT_NEAR(actual.z(), expected.z(), 1e-5f);
+    }
+
+    struct SceneUtilSkinningTest : Test
+    {
+        const std::vector<osg::Matrixf> mBones{ makeBoneMatrix(0.5f, osg::Vec3f(1, 2, 3)),
+            makeBoneMatrix(-1.0f, osg::Vec3f(-4, 0, 1)) };
+        const osg::Matrixf mTransform = osg::Matrixf::translate(osg::Vec3f(0, 0, 10));
+        const std::vector<std::pair<std::size_t, float>> mWeights{ { 0, 0.25f }, { 1, 0.75f } };
+        const std::vector<unsigned short> mVertices{ 0, 2 };
+        SkinningInfluences mInfluences;
+
+        SceneUtilSkinningTest() { mInfluences.addGroup(mWeights, mVertices); }
+
+        osg::Matrixf getExpectedMatrix() const
+        {
+            osg::Matrixf result(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+            for (const auto& [index, weight] : mWeights)
+                for (int i = 0; i < 16; ++i)
+                    if (i % 4 != 3)
+                        result.ptr()[i] += mBones[index].ptr()[i] * weight;
+            return result * mTransform;
+        }
+    };
+
+    TEST_F(SceneUtilSkinningTest, shouldMatchBlendedOsgMatrix)
+    {
+        std::vector<SkinningMatrix> matrices;
+        blendSkinningMatrices(mInfluences, mBones, mTransform, matrices);
+        ASSERT_EQ(matrices.size(), 1);
+
+        const std::vector<osg::Vec3f> source{ osg::Vec3f(1, 2, 3), osg::Vec3f(4, 5, 6), osg::Vec3f(-1, 0.5f, 2) };
+        std::vector<osg::Vec3f> positions(source.size());
+        std::vector<osg::Vec3f> normals(source.size());
+        skinPositions(mInfluences, matrices, source, positions);
+        skinNormals(mInfluences, matrices, source, normals);
+
+        const osg::Matrixf expected = getExpectedMatrix();
+        for (unsigned short vertex : mVertices)
+        {
+            expectNear(positions[vertex], expected.preMult(source[vertex]));
+            expectNear(normals[vertex], osg::Matrixf::transform3x3(source[vertex], expected));
+        }
+    }
+
+    TEST_F(SceneUtilSkinningTest, shouldNotChangeVerticesWithoutInfluences)
+    {
+        std::vector<SkinningMatrix> matrices;
+        blendSkinningMatrices(mInfluences, mBones, mTransform, matrices);
+
+        const std::vector<osg::Vec4f> source(4, osg::Vec4f(1, 0, 0, -1));
+        std::vector<osg::Vec4f> tangents(source.size(), osg::Vec4f(7, 7, 7, 7));
+        skinTangents(mInfluences, matrices, source, tangents);
+
+        EXPECT_EQ(tangents[1], osg::Vec4f(7, 7, 7, 7));
+        EXPECT_EQ(tangents[3], osg::Vec4f(7, 7, 7, 7));
+        EXPECT_EQ(tangents[0].w(), -1);
+    }
+}
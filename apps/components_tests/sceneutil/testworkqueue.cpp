@@ -0,0 +1,118 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilParallelForTest, shouldCallFunctionForEachIndexOnce)
+    {
+        WorkQueue workQueue(4);
+        std::vector<std::atomic_int> calls(1000);
+
+        parallelFor(workQueue, calls.size(), workQueue.getNumThreads(), [&](std::size_t i) { ++calls[i]; });
+
+        for (const std::atomic_int& v : calls)
+            EXPECT_EQ(v, 1);
+    }
+
+    TEST(SceneUtilParallelForTest, shouldNotDeadlockWhenCalledFromWorkItemOnSingleThreadedQueue)
+    {
+        struct Item : WorkItem
+        {
+            WorkQueue* mWorkQueue = nullptr;
+            std::atomic_size_t mSum{ 0 };
+
+            void doWork() override
+            {
+                parallelFor(*mWorkQueue, 100, 8, [&](std::size_t i) { mSum += i; });
+            }
+        };
+
+        WorkQueue workQueue(1);
+        const osg::ref_ptr<Item> item = new Item;
+        item->mWorkQueue = &workQueue;
+        workQueue.addWorkItem(item);
+        item->waitTillDone();
+
+        EXPECT_EQ(item->mSum, 4950);
+    }
+
+    TEST(SceneUtilParallelForTest, shouldRethrowExceptionAfterAllCallsAreCompleted)
+    {
+        WorkQueue workQueue(2);
+        std::atomic_int calls{ 0 };
+
+        EXPECT_THROW(parallelFor(workQueue, 10, 2,
+                         [&](std::size_t i) {
+                             ++calls;
+                             if (i == 3)
+                                 throw std::runtime_error("test");
+                         }),
+            std::runtime_error);
+
+        EXPECT_EQ(calls, 10);
+    }
+
+    TEST(SceneUtilWorkQueueTest, shouldStartItemsOfHigherPriorityFirst)
+    {
+        WorkQueue workQueue(0);
+        const osg::ref_ptr<WorkItem> low = new WorkItem;
+        const osg::ref_ptr<WorkItem> normal = new WorkItem;
+        const osg::ref_ptr<WorkItem> high = new WorkItem;
+        const osg::ref_ptr<WorkItem> highFront = new WorkItem;
+
+        workQueue.addWorkItem(low, WorkPriority::Low);
+        workQueue.addWorkItem(normal);
+        workQueue.addWorkItem(high, WorkPriority::High);
+        workQueue.addWorkItem(highFront, WorkPriority::High, true);
+
+        EXPECT_EQ(workQueue.getNumItems(), 4);
+        EXPECT_EQ(workQueue.removeWorkItem(), highFront);
+        EXPECT_EQ(workQueue.removeWorkItem(), high);
+        EXPECT_EQ(workQueue.removeWorkItem(), normal);
+        EXPECT_EQ(workQueue.removeWorkItem(), low);
+    }
+
+    TEST(SceneUtilWorkQueueTest, abortWorkItemShouldRemoveQueuedItemAndMarkItDone)
+    {
+        struct Item : WorkItem
+        {
+            bool mAborted = false;
+
+            void abort() override { mAborted = true; }
+        };
+
+        WorkQueue workQueue(0);
+        const osg::ref_ptr<Item> item = new Item;
+        const osg::ref_ptr<WorkItem> other = new WorkItem;
+        workQueue.addWorkItem(item, WorkPriority::Low);
+        workQueue.addWorkItem(other, WorkPriority::Low);
+
+        workQueue.abortWorkItem(*item);
+
+        EXPECT_TRUE(item->mAborted);
+        EXPECT_TRUE(item->isDone());
+        EXPECT_EQ(workQueue.getNumItems(), 1);
+        EXPECT_EQ(workQueue.removeWorkItem(), other);
+    }
+
+    TEST(SceneUtilWorkItemTest, waitTillDoneShouldReturnAfterSignalDoneFromOtherThread)
+    {
+        const osg::ref_ptr<WorkItem> item = new WorkItem;
+        std::thread thread([&] { item->signalDone(); });
+        item->waitTillDone();
+        thread.join();
+
+        EXPECT_TRUE(item->isDone());
+        item->waitTillDone();
+    }
+}
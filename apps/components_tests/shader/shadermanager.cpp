@@ -231,4 +231,36 @@ namespace
             EXPECT_FALSE(mManager.getShader(Files::pathToUnicodeString(templateName), mDefines));
         });
     }
+
+    TEST_F(ShaderManagerTest, usage_manifest_should_create_programs_used_by_previous_run)
+    {
+        const std::string content
+            = "#version 120\n"
+              "#define FLAG @flag\n"
+              "void main() {}\n";
+        const std::string name = "lib/" + std::string(UnitTest::GetInstance()->current_test_info()->name());
+        for (const std::string extension : { ".vert", ".frag" })
+        {
+            std::ofstream stream(TestingOpenMW::outputFilePathWithSubDir(name + extension));
+            stream << content;
+        }
+        const std::filesystem::path manifest = TestingOpenMW::outputFilePath(
+            std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".omwcache");
+
+        mDefines["flag"] = "1";
+        mManager.readUsageManifest(manifest);
+        ASSERT_TRUE(mManager.getProgram(name, mDefines));
+        mManager.writeUsageManifest();
+
+        ShaderManager next;
+        next.setShaderPath(TestingOpenMW::outputDir());
+        next.readUsageManifest(manifest);
+        const std::vector<osg::ref_ptr<osg::Program>> programs = next.createManifestPrograms();
+        ASSERT_EQ(programs.size(), 1);
+        ASSERT_EQ(programs[0]->getNumShaders(), 2);
+        EXPECT_EQ(programs[0]->getShader(0)->getShaderSource(),
+            "#version 120\n"
+            "#define FLAG 1\n"
+            "void main() {}\n");
+    }
 }
@@ -0,0 +1,79 @@
+#include <components/terrain/subdivisioncache.hpp>
+
+#include <osg/Array>
+
+#include <gtest/gtest.h>
+
+namespace Terrain
+{
+    namespace
+    {
+        SubdivisionKey makeKey(int x, int level)
+        {
+            return SubdivisionKey{
+                .mCenter = osg::Vec2f(x * 0.125f, 0.0f), .mLod = 0, .mLodFlags = 0, .mSubdivisionLevel = level
+            };
+        }
+
+        // Takes 12 bytes per vertex
+        osg::ref_ptr<osg::Geometry> makeGeometry(unsigned numVerts)
+        {
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+            geometry->setVertexArray(new osg::Vec3Array(numVerts));
+            return geometry;
+        }
+
+        TEST(TerrainSubdivisionCacheTest, getShouldReturnInsertedGeometryForSameChunkAndLevel)
+        {
+            SubdivisionCache cache(1024);
+            const osg::ref_ptr<osg::Geometry> geometry = makeGeometry(3);
+            cache.insert(makeKey(1, 2), geometry);
+            EXPECT_EQ(cache.get(makeKey(1, 2)), geometry);
+            EXPECT_EQ(cache.get(makeKey(1, 1)), nullptr);
+            EXPECT_EQ(cache.get(makeKey(2, 2)), nullptr);
+            EXPECT_EQ(cache.getSize(), 36);
+        }
+
+        TEST(TerrainSubdivisionCacheTest, insertShouldKeepFirstGeometryForSameKey)
+        {
+            SubdivisionCache cache(1024);
+            const osg::ref_ptr<osg::Geometry> first = makeGeometry(3);
+            cache.insert(makeKey(1, 2), first);
+            cache.insert(makeKey(1, 2), makeGeometry(6));
+            EXPECT_EQ(cache.get(makeKey(1, 2)), first);
+            EXPECT_EQ(cache.getSize(), 36);
+        }
+
+        TEST(TerrainSubdivisionCacheTest, insertShouldEvictLeastRecentlyUsedOverBudget)
+        {
+            SubdivisionCache cache(100);
+            cache.insert(makeKey(1, 1), makeGeometry(3));
+            cache.insert(makeKey(2, 1), makeGeometry(3));
+            ASSERT_NE(cache.get(makeKey(1, 1)), nullptr);
+            cache.insert(makeKey(3, 1), makeGeometry(3));
+            EXPECT_NE(cache.get(makeKey(1, 1)), nullptr);
+            EXPECT_EQ(cache.get(makeKey(2, 1)), nullptr);
+            EXPECT_NE(cache.get(makeKey(3, 1)), nullptr);
+            EXPECT_EQ(cache.getSize(), 72);
+            EXPECT_EQ(cache.getStats().mEvicted, 1);
+        }
+
+        TEST(TerrainSubdivisionCacheTest, insertShouldIgnoreGeometryLargerThanBudget)
+        {
+            SubdivisionCache cache(100);
+            cache.insert(makeKey(1, 1), makeGeometry(3));
+            cache.insert(makeKey(2, 1), makeGeometry(9));
+            EXPECT_NE(cache.get(makeKey(1, 1)), nullptr);
+            EXPECT_EQ(cache.get(makeKey(2, 1)), nullptr);
+        }
+
+        TEST(TerrainSubdivisionCacheTest, clearShouldRemoveAllGeometry)
+        {
+            SubdivisionCache cache(1024);
+            cache.insert(makeKey(1, 1), makeGeometry(3));
+            cache.clear();
+            EXPECT_EQ(cache.get(makeKey(1, 1)), nullptr);
+            EXPECT_EQ(cache.getSize(), 0);
+        }
+    }
+}
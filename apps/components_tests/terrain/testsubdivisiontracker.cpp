@@ -0,0 +1,73 @@
+#include <components/terrain/subdivisiontracker.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Terrain
+{
+    namespace
+    {
+        constexpr float sFar = 100000.0f;
+
+        osg::Vec2f cellCenter(int x, int y)
+        {
+            return osg::Vec2f(x * 0.125f, y * 0.125f);
+        }
+
+        osg::Vec2f worldCenter(int x, int y)
+        {
+            return osg::Vec2f(x * 1024.0f, y * 1024.0f);
+        }
+
+        TEST(TerrainSubdivisionTrackerTest, untrackedChunkShouldUseDistanceLevel)
+        {
+            const SubdivisionTracker tracker;
+            EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(0, 0), 0.0f), 3);
+            EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(0, 0), 1000.0f), 1);
+            EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(0, 0), sFar), 0);
+        }
+
+        TEST(TerrainSubdivisionTrackerTest, trackedChunkShouldKeepHighestMarkedLevel)
+        {
+            SubdivisionTracker tracker;
+            tracker.markChunkSubdivided(cellCenter(1, 2), 2, worldCenter(1, 2));
+            tracker.markChunkSubdivided(cellCenter(1, 2), 1, worldCenter(1, 2));
+            EXPECT_EQ(tracker.getTrackedChunkCount(), 1);
+            EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(1, 2), sFar), 2);
+            EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(2, 1), sFar), 0);
+        }
+
+        TEST(TerrainSubdivisionTrackerTest, manyChunksShouldStayFindableAfterGrowingAndReleasing)
+        {
+            SubdivisionTracker tracker;
+            constexpr int size = 40;
+            for (int x = 0; x < size; ++x)
+                for (int y = 0; y < size; ++y)
+                    tracker.markChunkSubdivided(cellCenter(x, y), 2, worldCenter(x, y));
+            ASSERT_EQ(tracker.getTrackedChunkCount(), size * size);
+
+            // Releases everything beyond trail distance and decays everything beyond active range
+            tracker.update(200.0f, osg::Vec2f(0, 0));
+
+            std::size_t kept = 0;
+            for (int x = 0; x < size; ++x)
+                for (int y = 0; y < size; ++y)
+                {
+                    const float distance = worldCenter(x, y).length();
+                    if (distance <= 3072.0f)
+                        ++kept;
+                    EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(x, y), sFar), distance <= 1536.0f ? 2 : 0)
+                        << x << " " << y;
+                }
+            EXPECT_EQ(tracker.getTrackedChunkCount(), kept);
+        }
+
+        TEST(TerrainSubdivisionTrackerTest, clearShouldRemoveAllChunks)
+        {
+            SubdivisionTracker tracker;
+            tracker.markChunkSubdivided(cellCenter(0, 0), 3, worldCenter(0, 0));
+            tracker.clear();
+            EXPECT_EQ(tracker.getTrackedChunkCount(), 0);
+            EXPECT_EQ(tracker.getSubdivisionLevel(cellCenter(0, 0), sFar), 0);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#include <components/terrain/snowdetection.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Terrain
+{
+    namespace
+    {
+        TEST(TerrainTypeTableTest, getTypeShouldReturnIndexOfFirstContainedPattern)
+        {
+            TerrainTypeTable table({ "snow", "ash", "mud" });
+            EXPECT_EQ(table.getType("textures/tx_bm_snow_01.dds"), 0);
+            EXPECT_EQ(table.getType("textures/tx_ash_02.dds"), 1);
+            EXPECT_EQ(table.getType("textures/tx_mud_snow.dds"), 0);
+        }
+
+        TEST(TerrainTypeTableTest, getTypeShouldIgnoreCase)
+        {
+            TerrainTypeTable table({ "snow" });
+            EXPECT_EQ(table.getType("Textures/TX_Snow.dds"), 0);
+        }
+
+        TEST(TerrainTypeTableTest, getTypeShouldReturnNoTypeWithoutMatch)
+        {
+            TerrainTypeTable table({ "snow" });
+            EXPECT_EQ(table.getType("textures/tx_grass.dds"), TerrainTypeTable::sNoType);
+            EXPECT_EQ(table.getType(""), TerrainTypeTable::sNoType);
+        }
+
+        TEST(TerrainTypeTableTest, getTypeShouldReturnSameTypeForRepeatedPath)
+        {
+            TerrainTypeTable table({ "snow", "ash" });
+            EXPECT_EQ(table.getType("textures/tx_ash.dds"), 1);
+            EXPECT_EQ(table.getType("textures/tx_ash.dds"), 1);
+        }
+    }
+}
@@ -80,6 +80,14 @@ namespace
         EXPECT_EQ(result, "a\xE2\x80\x99");
     }
 
+    TEST(Utf8EncoderTest, getUtf8ShouldLookUpUntilZeroAfterNonAscii)
+    {
+        const std::string input("\x93quoted text longer than a block\x94 and ascii after it\0ignored \x92", 61);
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        const std::string_view result = encoder.getUtf8(input);
+        EXPECT_EQ(result, "\xE2\x80\x9Cquoted text longer than a block\xE2\x80\x9D and ascii after it");
+    }
+
     TEST_P(Utf8EncoderTest, getUtf8ShouldConvertFromLegacyEncodingToUtf8)
     {
         const std::string input(readContent(GetParam().mLegacyEncodingFileName));
@@ -130,6 +138,20 @@ namespace
         EXPECT_EQ(result, "a\xe2");
     }
 
+    TEST(Utf8EncoderTest, getLegacyEncShouldConvertBackEveryPositionOfNonAsciiCharacter)
+    {
+        const std::string ascii = "The Lusty Argonian Maid, volume ";
+        StatelessUtf8Encoder encoder(FromType::WINDOWS_1252);
+        for (std::size_t i = 0; i <= ascii.size(); ++i)
+        {
+            const std::string input = ascii.substr(0, i) + "\x85\xE9" + ascii.substr(i);
+            std::string buffer;
+            const std::string utf8(encoder.getUtf8(input, BufferAllocationPolicy::FitToRequiredSize, buffer));
+            EXPECT_EQ(utf8, ascii.substr(0, i) + "\xE2\x80\xA6\xC3\xA9" + ascii.substr(i)) << i;
+            EXPECT_EQ(encoder.getLegacyEnc(utf8, BufferAllocationPolicy::FitToRequiredSize, buffer), input) << i;
+        }
+    }
+
     TEST_P(Utf8EncoderTest, getLegacyEncShouldConvertFromUtf8ToLegacyEncoding)
     {
         const std::string input(readContent(GetParam().mUtf8FileName));
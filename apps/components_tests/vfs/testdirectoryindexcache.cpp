@@ -0,0 +1,116 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/directoryindexcache.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct VFSDirectoryIndexCacheTest : Test
+        {
+            const std::filesystem::path mRoot;
+            const std::filesystem::path mCacheFile;
+
+            VFSDirectoryIndexCacheTest()
+                : mRoot(TestingOpenMW::outputDirPath(makeName("data")))
+                , mCacheFile(TestingOpenMW::outputFilePath(makeName("cache.bin")))
+            {
+                std::filesystem::remove_all(mRoot);
+                std::filesystem::remove(mCacheFile);
+                createFile("a.txt");
+                createFile("meshes/b.nif");
+                createFile("meshes/x/c.nif");
+            }
+
+            static std::string makeName(std::string_view suffix)
+            {
+                const auto testInfo = UnitTest::GetInstance()->current_test_info();
+                return std::format("{}.{}.{}", testInfo->test_suite_name(), testInfo->name(), suffix);
+            }
+
+            void createFile(const std::filesystem::path& relative) const
+            {
+                std::filesystem::create_directories((mRoot / relative).parent_path());
+                std::ofstream(mRoot / relative) << "content";
+            }
+
+            // Directory time resolution may be coarse, make sure the change is visible
+            void touch(const std::filesystem::path& relative) const
+            {
+                const std::filesystem::path dir = mRoot / relative;
+                std::filesystem::last_write_time(dir, std::filesystem::last_write_time(dir) + std::chrono::seconds(1));
+            }
+        };
+
+        TEST_F(VFSDirectoryIndexCacheTest, listFilesShouldReturnAllFilesRelativeToRoot)
+        {
+            DirectoryIndexCache cache(mCacheFile);
+            EXPECT_THAT(cache.listFiles(mRoot), UnorderedElementsAre("a.txt", "meshes/b.nif", "meshes/x/c.nif"));
+            EXPECT_EQ(cache.getScannedCount(), 3);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, listFilesShouldNotScanUnchangedDirectoriesFromSavedCache)
+        {
+            {
+                DirectoryIndexCache cache(mCacheFile);
+                cache.listFiles(mRoot);
+                cache.save();
+            }
+
+            DirectoryIndexCache cache(mCacheFile);
+            EXPECT_THAT(cache.listFiles(mRoot), UnorderedElementsAre("a.txt", "meshes/b.nif", "meshes/x/c.nif"));
+            EXPECT_EQ(cache.getScannedCount(), 0);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, listFilesShouldScanOnlyChangedDirectories)
+        {
+            {
+                DirectoryIndexCache cache(mCacheFile);
+                cache.listFiles(mRoot);
+                cache.save();
+            }
+
+            createFile("meshes/d.nif");
+            touch("meshes");
+
+            DirectoryIndexCache cache(mCacheFile);
+            EXPECT_THAT(cache.listFiles(mRoot),
+                UnorderedElementsAre("a.txt", "meshes/b.nif", "meshes/d.nif", "meshes/x/c.nif"));
+            EXPECT_EQ(cache.getScannedCount(), 1);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, listFilesShouldScanNewSubdirectories)
+        {
+            {
+                DirectoryIndexCache cache(mCacheFile);
+                cache.listFiles(mRoot);
+                cache.save();
+            }
+
+            createFile("textures/e.dds");
+            touch("");
+
+            DirectoryIndexCache cache(mCacheFile);
+            EXPECT_THAT(cache.listFiles(mRoot),
+                UnorderedElementsAre("a.txt", "meshes/b.nif", "meshes/x/c.nif", "textures/e.dds"));
+            EXPECT_EQ(cache.getScannedCount(), 2);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, shouldIgnoreDamagedCacheFile)
+        {
+            std::ofstream(mCacheFile, std::ios::binary) << "OMWVFSIC garbage";
+
+            DirectoryIndexCache cache(mCacheFile);
+            EXPECT_THAT(cache.listFiles(mRoot), UnorderedElementsAre("a.txt", "meshes/b.nif", "meshes/x/c.nif"));
+            EXPECT_EQ(cache.getScannedCount(), 3);
+        }
+    }
+}
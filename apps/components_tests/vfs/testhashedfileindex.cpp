@@ -0,0 +1,78 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/hashedfileindex.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <format>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        TEST(VFSHashedFileIndexTest, findShouldReturnNullptrWhenEmpty)
+        {
+            const HashedFileIndex index;
+            EXPECT_EQ(index.find("meshes/a.nif"), nullptr);
+        }
+
+        TEST(VFSHashedFileIndexTest, findShouldReturnFileForEachPath)
+        {
+            std::vector<TestingOpenMW::VFSTestFile> files;
+            files.reserve(1000);
+            FileMap map;
+            for (int i = 0; i < 1000; ++i)
+            {
+                files.emplace_back(std::to_string(i));
+                map.emplace(Path::Normalized(std::format("meshes/{}.nif", i)), &files.back());
+            }
+
+            HashedFileIndex index;
+            index.build(map);
+
+            EXPECT_EQ(index.size(), map.size());
+            for (const auto& [path, file] : map)
+                EXPECT_EQ(index.find(path.view()), file) << path.value();
+        }
+
+        TEST(VFSHashedFileIndexTest, findShouldReturnNullptrForMissingPath)
+        {
+            TestingOpenMW::VFSTestFile file("content");
+            const FileMap map{ { Path::Normalized("meshes/a.nif"), &file } };
+
+            HashedFileIndex index;
+            index.build(map);
+
+            EXPECT_EQ(index.find("meshes/b.nif"), nullptr);
+            EXPECT_EQ(index.find("meshes/a.ni"), nullptr);
+        }
+
+        TEST(VFSHashedFileIndexTest, findShouldSupportEmptyPath)
+        {
+            TestingOpenMW::VFSTestFile file("content");
+            const FileMap map{ { Path::Normalized(""), &file } };
+
+            HashedFileIndex index;
+            index.build(map);
+
+            EXPECT_EQ(index.find(""), &file);
+        }
+
+        TEST(VFSHashedFileIndexTest, clearShouldRemoveAllFiles)
+        {
+            TestingOpenMW::VFSTestFile file("content");
+            const FileMap map{ { Path::Normalized("meshes/a.nif"), &file } };
+
+            HashedFileIndex index;
+            index.build(map);
+            index.clear();
+
+            EXPECT_EQ(index.size(), 0);
+            EXPECT_EQ(index.find("meshes/a.nif"), nullptr);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/file.hpp>
+#include <components/vfs/readaheadcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        class RangeFile final : public TestingOpenMW::VFSTestFile
+        {
+        public:
+            RangeFile(const std::filesystem::path& path, std::size_t offset, std::size_t size)
+                : TestingOpenMW::VFSTestFile({})
+                , mRange{ &path, offset, size }
+            {
+            }
+
+            std::optional<StoredRange> getStoredRange() const override { return mRange; }
+
+        private:
+            StoredRange mRange;
+        };
+
+        std::string readAll(std::istream& stream)
+        {
+            return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+
+        struct VFSReadAheadCacheTest : Test
+        {
+            const std::filesystem::path mPath;
+
+            VFSReadAheadCacheTest()
+                : mPath(TestingOpenMW::outputFilePath(
+                    std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".archive"))
+            {
+                std::ofstream(mPath, std::ios::binary) << "aaaabbbbccccdddd";
+            }
+        };
+
+        TEST_F(VFSReadAheadCacheTest, takeShouldReturnNullptrForNotPrefetchedFile)
+        {
+            ReadAheadCache cache(1024);
+            const RangeFile file(mPath, 0, 4);
+            EXPECT_EQ(cache.take(file), nullptr);
+        }
+
+        TEST_F(VFSReadAheadCacheTest, takeShouldReturnContentOfPrefetchedFilesInAnyOrder)
+        {
+            ReadAheadCache cache(1024);
+            const RangeFile a(mPath, 0, 4);
+            const RangeFile c(mPath, 8, 4);
+            const RangeFile d(mPath, 12, 4);
+            const std::vector<const File*> files{ &d, &a, &c };
+            cache.prefetch(files);
+            EXPECT_EQ(cache.getSize(), 12);
+
+            const Files::IStreamPtr cStream = cache.take(c);
+            ASSERT_NE(cStream, nullptr);
+            EXPECT_EQ(readAll(*cStream), "cccc");
+            const Files::IStreamPtr aStream = cache.take(a);
+            ASSERT_NE(aStream, nullptr);
+            EXPECT_EQ(readAll(*aStream), "aaaa");
+            const Files::IStreamPtr dStream = cache.take(d);
+            ASSERT_NE(dStream, nullptr);
+            EXPECT_EQ(readAll(*dStream), "dddd");
+            EXPECT_EQ(cache.getSize(), 0);
+        }
+
+        TEST_F(VFSReadAheadCacheTest, takeShouldHandOutFileOnce)
+        {
+            ReadAheadCache cache(1024);
+            const RangeFile b(mPath, 4, 4);
+            const std::vector<const File*> files{ &b };
+            cache.prefetch(files);
+            EXPECT_NE(cache.take(b), nullptr);
+            EXPECT_EQ(cache.take(b), nullptr);
+        }
+
+        TEST_F(VFSReadAheadCacheTest, prefetchShouldIgnoreFilesWithoutStoredRange)
+        {
+            ReadAheadCache cache(1024);
+            const TestingOpenMW::VFSTestFile file("content");
+            const std::vector<const File*> files{ &file };
+            cache.prefetch(files);
+            EXPECT_EQ(cache.getSize(), 0);
+            EXPECT_EQ(cache.take(file), nullptr);
+        }
+
+        TEST_F(VFSReadAheadCacheTest, prefetchShouldDropOldestFilesWhenFull)
+        {
+            ReadAheadCache cache(8);
+            const RangeFile a(mPath, 0, 4);
+            const RangeFile b(mPath, 4, 4);
+            const RangeFile c(mPath, 8, 4);
+            const std::vector<const File*> first{ &a, &b };
+            cache.prefetch(first);
+            const std::vector<const File*> second{ &c };
+            cache.prefetch(second);
+            EXPECT_EQ(cache.getSize(), 8);
+            EXPECT_EQ(cache.take(a), nullptr);
+            EXPECT_NE(cache.take(b), nullptr);
+            EXPECT_NE(cache.take(c), nullptr);
+        }
+
+        TEST_F(VFSReadAheadCacheTest, prefetchShouldIgnoreFilesBeyondEndOfArchive)
+        {
+            ReadAheadCache cache(1024);
+            const RangeFile file(mPath, 12, 8);
+            const std::vector<const File*> files{ &file };
+            cache.prefetch(files);
+            EXPECT_EQ(cache.take(file), nullptr);
+        }
+    }
+}
@@ -119,6 +119,16 @@ namespace NavMeshTool
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
+            addOption("shard-index", bpo::value<std::size_t>()->default_value(0),
+                "generate only the tiles of this shard, from 0 to shard-count - 1");
+
+            addOption("shard-count", bpo::value<std::size_t>()->default_value(1),
+                "split the tiles into this number of shards generated separately, for example on different machines");
+
+            addOption("merge",
+                bpo::value<StringsVector>()->default_value(StringsVector(), "")->multitoken()->composing(),
+                "merge navmeshdb files, for example generated for each shard, into the navmeshdb and quit");
+
             Files::ConfigurationManager::addCommonOptions(result);
 
             return result;
@@ -179,6 +189,18 @@ namespace NavMeshTool
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
+            const Shard shard{
+                .mIndex = variables["shard-index"].as<std::size_t>(),
+                .mCount = variables["shard-count"].as<std::size_t>(),
+            };
+            const auto& mergedDbPaths = variables["merge"].as<StringsVector>();
+
+            if (shard.mCount < 1 || shard.mIndex >= shard.mCount)
+            {
+                std::cerr << "Invalid shard: " << shard.mIndex << " of " << shard.mCount
+                          << ", expected shard-count >= 1 and shard-index < shard-count";
+                return -1;
+            }
 
 #ifdef WIN32
             if (writeBinaryLog)
@@ -189,7 +211,8 @@ namespace NavMeshTool
 
             VFS::Manager vfs;
 
-            VFS::registerArchives(&vfs, fileCollections, archives, true, &encoder.getStatelessEncoder());
+            VFS::registerArchives(&vfs, fileCollections, archives, true, &encoder.getStatelessEncoder(),
+                config.getCachePath() / "vfsindex.bin");
 
             Settings::Manager::load(config);
 
@@ -203,6 +226,21 @@ namespace NavMeshTool
             Log(Debug::Info) << "Using navmeshdb at " << dbPath;
 
             DetourNavigator::NavMeshDb db(dbPath, maxDbFileSize);
+            db.setWriteAheadLog(Settings::navigator().mNavmeshdbWriteAheadLog);
+
+            if (!mergedDbPaths.empty())
+            {
+                for (const std::string& path : mergedDbPaths)
+                {
+                    Log(Debug::Info) << "Merging navmeshdb at " << path << "...";
+                    const std::size_t merged = db.merge(path, removeUnusedTiles);
+                    Log(Debug::Info) << "Merged " << merged << " tiles";
+                }
+                Log(Debug::Info) << "Vacuuming the database...";
+                db.vacuum();
+                Log(Debug::Info) << "Done";
+                return 0;
+            }
 
             ESM::ReadersCache readers;
             EsmLoader::Query query;
@@ -223,6 +261,8 @@ namespace NavMeshTool
             Resource::BgsmFileManager bgsmFileManager(&vfs, expiryDelay);
             Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager, &bgsmFileManager, expiryDelay);
             Resource::BulletShapeManager bulletShapeManager(&vfs, &sceneManager, &nifFileManager, expiryDelay);
+            if (Settings::models().mCacheCollisionShapes)
+                bulletShapeManager.setShapeCacheDirectory(config.getCachePath() / "collision");
             DetourNavigator::RecastGlobalAllocator::init();
             DetourNavigator::Settings navigatorSettings
                 = DetourNavigator::makeSettingsFromSettingsManager(Debug::getRecastMaxLogLevel());
@@ -233,7 +273,7 @@ namespace NavMeshTool
                 navigatorSettings, readers, vfs, bulletShapeManager, esmData, processInteriorCells, writeBinaryLog);
 
             const Status status = generateAllNavMeshTiles(agentBounds, navigatorSettings, threadsNumber,
-                removeUnusedTiles, writeBinaryLog, cellsData, std::move(db));
+                removeUnusedTiles, writeBinaryLog, shard, cellsData, std::move(db));
 
             switch (status)
             {
@@ -255,14 +255,18 @@ namespace NavMeshTool
     }
 
     Status generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, std::size_t threadsNumber,
-        bool removeUnusedTiles, bool writeBinaryLog, WorldspaceData& data, NavMeshDb&& db)
+        bool removeUnusedTiles, bool writeBinaryLog, const Shard& shard, WorldspaceData& data, NavMeshDb&& db)
     {
         Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
 
+        if (shard.mCount > 1)
+            Log(Debug::Info) << "Generating shard " << shard.mIndex << " of " << shard.mCount << " shards";
+
         SceneUtil::WorkQueue workQueue(threadsNumber);
         auto navMeshTileConsumer
             = std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles, writeBinaryLog);
         std::size_t tiles = 0;
+        std::size_t tileIndex = 0;
         std::mt19937_64 random;
 
         for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
@@ -275,8 +279,12 @@ namespace NavMeshTool
 
             std::vector<TilePosition> worldspaceTiles;
 
-            DetourNavigator::getTilesPositions(
-                range, [&](const TilePosition& tilePosition) { worldspaceTiles.push_back(tilePosition); });
+            // Tiles are spread over the shards in the order they are visited, so nearby tiles of similar cost go to
+            // different shards
+            DetourNavigator::getTilesPositions(range, [&](const TilePosition& tilePosition) {
+                if (tileIndex++ % shard.mCount == shard.mIndex)
+                    worldspaceTiles.push_back(tilePosition);
+            });
 
             tiles += worldspaceTiles.size();
 
@@ -21,9 +21,16 @@ namespace NavMeshTool
         NotEnoughSpace,
     };
 
+    // Part of the tiles generated by one of several processes, usually on different machines, each into its own db
+    struct Shard
+    {
+        std::size_t mIndex = 0;
+        std::size_t mCount = 1;
+    };
+
     Status generateAllNavMeshTiles(const DetourNavigator::AgentBounds& agentBounds,
         const DetourNavigator::Settings& settings, std::size_t threadsNumber, bool removeUnusedTiles,
-        bool writeBinaryLog, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
+        bool writeBinaryLog, const Shard& shard, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
 }
 
 #endif
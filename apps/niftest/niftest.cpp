@@ -1,19 +1,35 @@
 /// Program to test .nif files both on the FileSystem and in BSA archives.
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include <osg/ref_ptr>
+
 #include <components/bgsm/file.hpp>
 #include <components/files/configurationmanager.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/nif/niffile.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/keyframe.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/archive.hpp>
 #include <components/vfs/bsaarchive.hpp>
 #include <components/vfs/filesystemarchive.hpp>
@@ -119,99 +135,291 @@ std::unique_ptr<VFS::Archive> makeArchive(const std::filesystem::path& path)
     return nullptr;
 }
 
-bool readFile(
-    const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs, bool quiet)
+struct Options
 {
-    const auto [fileType, fileClass] = classifyFile(path);
-    if (fileClass != FileClass::NIF && fileClass != FileClass::Material)
-        return false;
+    bool mQuiet = false;
+    bool mConvert = false;
+    std::size_t mThreads = 1;
+    std::filesystem::path mReport;
+};
+
+/// Files of an archive or a directory, or the files given on the command line.
+struct DataSource
+{
+    std::filesystem::path mPath;
+    std::unique_ptr<VFS::Manager> mVFS;
+    /// Files given on the command line without archives are opened directly.
+    bool mOpenFromVFS = true;
+    std::unique_ptr<Resource::ImageManager> mImageManager;
+    std::unique_ptr<Resource::BgsmFileManager> mMaterialManager;
+};
+
+struct FileTask
+{
+    const DataSource* mSource;
+    std::filesystem::path mPath;
+    FileType mType;
+    FileClass mClass;
+};
+
+struct FileReport
+{
+    bool mSuccess = false;
+    std::size_t mRecords = 0;
+    std::size_t mRoots = 0;
+    std::uint64_t mAllocatedBytes = 0;
+    double mParseTime = 0;
+    double mConvertTime = 0;
+    std::string mError;
+};
+
+namespace
+{
+    // Bytes allocated by the current thread, files are read by a single thread each
+    thread_local std::uint64_t sAllocatedBytes = 0;
 
-    const std::string pathStr = Files::pathToUnicodeString(path);
-    if (!quiet)
+    double getDuration(std::chrono::steady_clock::time_point start)
     {
-        std::cout << "Reading " << getFileTypeName(fileType) << " file '" << pathStr << "'";
-        if (!source.empty())
-            std::cout << " from '" << Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) << "'";
-        std::cout << std::endl;
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
     }
-    const std::filesystem::path fullPath = !source.empty() ? source / path : path;
-    try
+
+    std::string getSourceName(const DataSource& source)
     {
-        switch (fileClass)
-        {
-            case FileClass::NIF:
-            {
-                Nif::NIFFile file(VFS::Path::Normalized(Files::pathToUnicodeString(fullPath)));
-                Nif::Reader reader(file, nullptr);
-                if (vfs != nullptr)
-                    reader.parse(vfs->get(pathStr));
-                else
-                    reader.parse(Files::openConstrainedFileStream(fullPath));
-                break;
-            }
-            case FileClass::Material:
-            {
-                if (vfs != nullptr)
-                    Bgsm::parse(vfs->get(pathStr));
-                else
-                    Bgsm::parse(Files::openConstrainedFileStream(fullPath));
-                break;
-            }
-            default:
-                break;
-        }
+        if (source.mPath.empty())
+            return {};
+        return Files::pathToUnicodeString(isBSA(source.mPath) ? source.mPath.filename() : source.mPath);
     }
-    catch (std::exception& e)
+
+    // Keeps the report one line per file
+    std::string escapeField(std::string_view value)
     {
-        std::cerr << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
+        std::string result(value);
+        std::replace_if(result.begin(), result.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+        return result;
     }
-    return true;
 }
 
-/// Check all the nif files in a given VFS::Archive
-/// \note Can not read a bsa file inside of a bsa file.
-void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath, bool quiet)
+void* operator new(std::size_t size)
 {
-    if (archive == nullptr)
-        return;
+    sAllocatedBytes += size;
+    if (void* const result = std::malloc(size == 0 ? 1 : size))
+        return result;
+    throw std::bad_alloc();
+}
 
-    if (!quiet)
-        std::cout << "Reading data source '" << Files::pathToUnicodeString(archivePath) << "'" << std::endl;
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept
+{
+    std::free(pointer);
+}
 
-    VFS::Manager vfs;
-    vfs.addArchive(std::move(archive));
-    vfs.buildIndex();
+/// Collects files to read from data sources and reads them using multiple threads.
+class Validator
+{
+public:
+    explicit Validator(const Options& options)
+        : mOptions(options)
+    {
+    }
+
+    DataSource& addSource(const std::filesystem::path& path, std::unique_ptr<VFS::Manager> vfs, bool openFromVFS)
+    {
+        auto source = std::make_unique<DataSource>();
+        source->mPath = path;
+        source->mVFS = std::move(vfs);
+        source->mOpenFromVFS = openFromVFS;
+        if (mOptions.mConvert)
+        {
+            constexpr double expiryDelay = 0;
+            source->mImageManager = std::make_unique<Resource::ImageManager>(source->mVFS.get(), expiryDelay);
+            source->mMaterialManager = std::make_unique<Resource::BgsmFileManager>(source->mVFS.get(), expiryDelay);
+        }
+        mSources.push_back(std::move(source));
+        return *mSources.back();
+    }
 
-    for (const auto& name : vfs.getRecursiveDirectoryIterator())
+    /// @return False if the file is neither a NIF nor a material file
+    bool addFile(const DataSource& source, const std::filesystem::path& path)
     {
-        readFile(archivePath, name.value(), &vfs, quiet);
+        const auto [fileType, fileClass] = classifyFile(path);
+        if (fileClass != FileClass::NIF && fileClass != FileClass::Material)
+            return false;
+        mTasks.push_back(FileTask{ &source, path, fileType, fileClass });
+        return true;
     }
 
-    if (!archivePath.empty() && !isBSA(archivePath))
+    /// Add all the nif files in a given VFS::Archive
+    /// \note Can not read a bsa file inside of a bsa file.
+    void addVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath)
     {
-        const Files::Collections fileCollections({ archivePath });
-        const Files::MultiDirCollection& bsaCol = fileCollections.getCollection("bsa");
-        const Files::MultiDirCollection& ba2Col = fileCollections.getCollection("ba2");
-        for (const Files::MultiDirCollection& collection : { bsaCol, ba2Col })
+        if (archive == nullptr)
+            return;
+
+        if (!mOptions.mQuiet)
+            std::cout << "Reading data source '" << Files::pathToUnicodeString(archivePath) << "'" << std::endl;
+
+        auto vfs = std::make_unique<VFS::Manager>();
+        vfs->addArchive(std::move(archive));
+        vfs->buildIndex();
+        DataSource& source = addSource(archivePath, std::move(vfs), true);
+
+        for (const auto& name : source.mVFS->getRecursiveDirectoryIterator())
+            addFile(source, name.value());
+
+        if (!archivePath.empty() && !isBSA(archivePath))
         {
-            for (auto& file : collection)
+            const Files::Collections fileCollections({ archivePath });
+            const Files::MultiDirCollection& bsaCol = fileCollections.getCollection("bsa");
+            const Files::MultiDirCollection& ba2Col = fileCollections.getCollection("ba2");
+            for (const Files::MultiDirCollection& collection : { bsaCol, ba2Col })
             {
-                try
+                for (auto& file : collection)
                 {
-                    readVFS(VFS::makeBsaArchive(file.second, nullptr), file.second, quiet);
+                    try
+                    {
+                        addVFS(VFS::makeBsaArchive(file.second, nullptr), file.second);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::cerr << "Failed to read archive file '" << Files::pathToUnicodeString(file.second)
+                                  << "': " << e.what() << std::endl;
+                    }
                 }
-                catch (const std::exception& e)
+            }
+        }
+    }
+
+    void run()
+    {
+        std::vector<FileReport> reports(mTasks.size());
+        const auto start = std::chrono::steady_clock::now();
+
+        SceneUtil::WorkQueue workQueue(mOptions.mThreads - 1);
+        SceneUtil::parallelFor(workQueue, mTasks.size(), mOptions.mThreads - 1,
+            [&](std::size_t i) { reports[i] = readFile(mTasks[i]); });
+
+        const std::size_t failed = static_cast<std::size_t>(
+            std::count_if(reports.begin(), reports.end(), [](const FileReport& v) { return !v.mSuccess; }));
+
+        if (!mOptions.mQuiet)
+            std::cout << "Read " << mTasks.size() << " files in " << getDuration(start) / 1000 << " s, " << failed
+                      << " failed" << std::endl;
+
+        if (!mOptions.mReport.empty())
+            writeReport(reports);
+    }
+
+private:
+    const Options& mOptions;
+    std::vector<std::unique_ptr<DataSource>> mSources;
+    std::vector<FileTask> mTasks;
+    std::mutex mOutputMutex;
+
+    FileReport readFile(const FileTask& task)
+    {
+        const std::string pathStr = Files::pathToUnicodeString(task.mPath);
+        const DataSource& source = *task.mSource;
+        if (!mOptions.mQuiet)
+        {
+            std::ostringstream message;
+            message << "Reading " << getFileTypeName(task.mType) << " file '" << pathStr << "'";
+            if (!source.mPath.empty())
+                message << " from '" << getSourceName(source) << "'";
+            const std::lock_guard lock(mOutputMutex);
+            std::cout << message.str() << std::endl;
+        }
+
+        const std::filesystem::path fullPath = !source.mPath.empty() ? source.mPath / task.mPath : task.mPath;
+        const auto open = [&] {
+            return source.mOpenFromVFS ? source.mVFS->get(pathStr) : Files::openConstrainedFileStream(fullPath);
+        };
+
+        FileReport report;
+        const std::uint64_t allocatedBytes = sAllocatedBytes;
+        try
+        {
+            switch (task.mClass)
+            {
+                case FileClass::NIF:
                 {
-                    std::cerr << "Failed to read archive file '" << Files::pathToUnicodeString(file.second)
-                              << "': " << e.what() << std::endl;
+                    auto start = std::chrono::steady_clock::now();
+                    Nif::NIFFile file(VFS::Path::Normalized(Files::pathToUnicodeString(fullPath)));
+                    Nif::Reader reader(file, nullptr);
+                    reader.parse(open());
+                    report.mParseTime = getDuration(start);
+                    report.mRecords = file.mRecords.size();
+                    report.mRoots = file.mRoots.size();
+
+                    if (mOptions.mConvert)
+                    {
+                        start = std::chrono::steady_clock::now();
+                        if (task.mType == FileType::KF)
+                        {
+                            osg::ref_ptr<SceneUtil::KeyframeHolder> keyframes = new SceneUtil::KeyframeHolder;
+                            NifOsg::Loader::loadKf(file, *keyframes);
+                        }
+                        else
+                            NifOsg::Loader::load(file, source.mImageManager.get(), source.mMaterialManager.get());
+                        report.mConvertTime = getDuration(start);
+                    }
+                    break;
                 }
+                case FileClass::Material:
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    Bgsm::parse(open());
+                    report.mParseTime = getDuration(start);
+                    break;
+                }
+                default:
+                    break;
             }
+            report.mSuccess = true;
+        }
+        catch (const std::exception& e)
+        {
+            report.mError = e.what();
+            const std::lock_guard lock(mOutputMutex);
+            std::cerr << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
         }
+        report.mAllocatedBytes = sAllocatedBytes - allocatedBytes;
+        return report;
     }
-}
+
+    void writeReport(const std::vector<FileReport>& reports) const
+    {
+        std::ofstream stream(mOptions.mReport);
+        if (!stream)
+        {
+            std::cerr << "Failed to open report file '" << Files::pathToUnicodeString(mOptions.mReport) << "'"
+                      << std::endl;
+            return;
+        }
+
+        stream << "file\tsource\ttype\tresult\trecords\troots\tallocated bytes\tparse ms\tconvert ms\terror\n";
+        for (std::size_t i = 0; i < mTasks.size(); ++i)
+        {
+            const FileTask& task = mTasks[i];
+            const FileReport& report = reports[i];
+            stream << escapeField(Files::pathToUnicodeString(task.mPath)) << '\t'
+                   << escapeField(getSourceName(*task.mSource)) << '\t' << getFileTypeName(task.mType) << '\t'
+                   << (report.mSuccess ? "ok" : "failed") << '\t' << report.mRecords << '\t' << report.mRoots << '\t'
+                   << report.mAllocatedBytes << '\t' << report.mParseTime << '\t' << report.mConvertTime << '\t'
+                   << escapeField(report.mError) << '\n';
+        }
+
+        if (!stream)
+            std::cerr << "Failed to write report file '" << Files::pathToUnicodeString(mOptions.mReport) << "'"
+                      << std::endl;
+    }
+};
 
 bool parseOptions(int argc, char** argv, Files::PathContainer& files, Files::PathContainer& archives,
-    bool& writeDebugLog, bool& quiet)
+    bool& writeDebugLog, Options& options)
 {
     bpo::options_description desc(
         R"(Ensure that OpenMW can use the provided NIF, KF, BTO/BTR, RDT, PSA, BGEM/BGSM and BSA/BA2 files
@@ -227,6 +435,10 @@ Allowed options)");
     addOption("quiet,q", "do not log read archives/files");
     addOption("archives", bpo::value<Files::MaybeQuotedPathContainer>(), "path to archive files to provide files");
     addOption("input-file", bpo::value<Files::MaybeQuotedPathContainer>(), "input file");
+    addOption("threads,j", bpo::value<std::size_t>()->default_value(1), "number of threads reading files");
+    addOption("convert,c", "also convert NIF and KF files into scene graphs like the engine does");
+    addOption("report", bpo::value<Files::MaybeQuotedPath>(),
+        "write a tab separated report with the result, record count, allocated bytes and time of each file");
 
     // Default option if none provided
     bpo::positional_options_description p;
@@ -244,7 +456,17 @@ Allowed options)");
             return false;
         }
         writeDebugLog = variables.count("write-debug-log") > 0;
-        quiet = variables.count("quiet") > 0;
+        options.mQuiet = variables.count("quiet") > 0;
+        options.mConvert = variables.count("convert") > 0;
+        options.mThreads = variables["threads"].as<std::size_t>();
+        if (options.mThreads < 1)
+        {
+            std::cout << "Invalid threads number: " << options.mThreads << ", expected >= 1\n\n"
+                      << desc << std::endl;
+            return false;
+        }
+        if (const auto it = variables.find("report"); it != variables.end())
+            options.mReport = it->second.as<Files::MaybeQuotedPath>();
         if (variables.count("input-file"))
         {
             files = asPathContainer(variables["input-file"].as<Files::MaybeQuotedPathContainer>());
@@ -268,50 +490,49 @@ int main(int argc, char** argv)
 {
     Files::PathContainer files, sources;
     bool writeDebugLog = false;
-    bool quiet = false;
-    if (!parseOptions(argc, argv, files, sources, writeDebugLog, quiet))
+    Options options;
+    if (!parseOptions(argc, argv, files, sources, writeDebugLog, options))
         return 1;
 
     Nif::Reader::setLoadUnsupportedFiles(true);
     Nif::Reader::setWriteNifDebugLog(writeDebugLog);
 
-    std::unique_ptr<VFS::Manager> vfs;
-    if (!sources.empty())
+    auto vfs = std::make_unique<VFS::Manager>();
+    const bool openFromVFS = !sources.empty();
+    for (const std::filesystem::path& path : sources)
     {
-        vfs = std::make_unique<VFS::Manager>();
-        for (const std::filesystem::path& path : sources)
-        {
-            const std::string pathStr = Files::pathToUnicodeString(path);
-            if (!quiet)
-                std::cout << "Adding data source '" << pathStr << "'" << std::endl;
+        const std::string pathStr = Files::pathToUnicodeString(path);
+        if (!options.mQuiet)
+            std::cout << "Adding data source '" << pathStr << "'" << std::endl;
 
-            try
-            {
-                if (auto archive = makeArchive(path))
-                    vfs->addArchive(std::move(archive));
-                else
-                    std::cerr << "Error: '" << pathStr << "' is not an archive or directory" << std::endl;
-            }
-            catch (std::exception& e)
-            {
-                std::cerr << "Failed to add data source '" << pathStr << "':  " << e.what() << std::endl;
-            }
+        try
+        {
+            if (auto archive = makeArchive(path))
+                vfs->addArchive(std::move(archive));
+            else
+                std::cerr << "Error: '" << pathStr << "' is not an archive or directory" << std::endl;
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "Failed to add data source '" << pathStr << "':  " << e.what() << std::endl;
         }
-
-        vfs->buildIndex();
     }
+    vfs->buildIndex();
+
+    Validator validator(options);
+    const DataSource& commandLineSource = validator.addSource({}, std::move(vfs), openFromVFS);
 
     for (const auto& path : files)
     {
         const std::string pathStr = Files::pathToUnicodeString(path);
         try
         {
-            const bool isFile = readFile({}, path, vfs.get(), quiet);
+            const bool isFile = validator.addFile(commandLineSource, path);
             if (!isFile)
             {
                 if (auto archive = makeArchive(path))
                 {
-                    readVFS(std::move(archive), path, quiet);
+                    validator.addVFS(std::move(archive), path);
                 }
                 else
                 {
@@ -325,5 +546,7 @@ int main(int argc, char** argv)
             std::cerr << "Failed to read '" << pathStr << "':  " << e.what() << std::endl;
         }
     }
+
+    validator.run();
     return 0;
 }
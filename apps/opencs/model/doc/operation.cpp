@@ -2,11 +2,15 @@
 
 #include <algorithm>
 #include <exception>
+#include <optional>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <QTimer>
 
 #include <components/debug/debuglog.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include <apps/opencs/model/doc/messages.hpp>
 
@@ -18,6 +22,12 @@ namespace CSMDoc
 {
     namespace
     {
+        // Steps are performed until this is exceeded before progress and messages are reported
+        constexpr auto maxExecuteDuration = std::chrono::milliseconds(10);
+
+        // Steps of a parallel stage performed at once per thread
+        constexpr std::size_t parallelStepsPerThread = 16;
+
         std::string_view operationToString(State value)
         {
             switch (value)
@@ -53,6 +63,66 @@ void CSMDoc::Operation::prepareStages()
         iter->second = iter->first->setup();
         mTotalSteps += iter->second;
     }
+
+    const unsigned threads = std::thread::hardware_concurrency();
+    const bool hasParallelStages
+        = std::any_of(mStages.begin(), mStages.end(), [](const auto& stage) { return stage.first->isParallel(); });
+    if (mWorkQueue == nullptr && hasParallelStages && threads > 1)
+        mWorkQueue = new SceneUtil::WorkQueue(threads - 1);
+}
+
+void CSMDoc::Operation::performStep(Messages& messages)
+{
+    try
+    {
+        mCurrentStage->first->perform(mCurrentStep++, messages);
+    }
+    catch (const std::exception& e)
+    {
+        messages.add(CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError);
+        abort();
+    }
+
+    ++mCurrentStepTotal;
+}
+
+void CSMDoc::Operation::performParallelSteps(Messages& messages)
+{
+    Stage& stage = *mCurrentStage->first;
+    const int first = mCurrentStep;
+    const std::size_t count = std::min(static_cast<std::size_t>(mCurrentStage->second - first),
+        parallelStepsPerThread * (mWorkQueue->getNumThreads() + 1));
+
+    std::vector<Messages> stepMessages(count, Messages(mDefaultSeverity));
+    std::vector<std::optional<std::string>> errors(count);
+
+    SceneUtil::parallelFor(*mWorkQueue, count, mWorkQueue->getNumThreads(), [&](std::size_t i) {
+        try
+        {
+            stage.perform(first + static_cast<int>(i), stepMessages[i]);
+        }
+        catch (const std::exception& e)
+        {
+            errors[i] = e.what();
+        }
+    });
+
+    // Report in the order of steps and stop at the first failed one, as if they were performed one by one
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (const Message& message : stepMessages[i])
+            messages.add(message.mId, message.mMessage, message.mHint, message.mSeverity);
+
+        ++mCurrentStep;
+        ++mCurrentStepTotal;
+
+        if (errors[i].has_value())
+        {
+            messages.add(CSMWorld::UniversalId(), *errors[i], "", Message::Severity_SeriousError);
+            abort();
+            return;
+        }
+    }
 }
 
 CSMDoc::Operation::Operation(State type, bool ordered, bool finalAlways)
@@ -137,6 +207,7 @@ void CSMDoc::Operation::executeStage()
     }
 
     Messages messages(mDefaultSeverity);
+    const auto start = std::chrono::steady_clock::now();
 
     while (mCurrentStage != mStages.end())
     {
@@ -144,23 +215,16 @@ void CSMDoc::Operation::executeStage()
         {
             mCurrentStep = 0;
             ++mCurrentStage;
+            continue;
         }
+
+        if (mWorkQueue != nullptr && mCurrentStage->first->isParallel())
+            performParallelSteps(messages);
         else
-        {
-            try
-            {
-                mCurrentStage->first->perform(mCurrentStep++, messages);
-            }
-            catch (const std::exception& e)
-            {
-                emit reportMessage(
-                    Message(CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError), mType);
-                abort();
-            }
+            performStep(messages);
 
-            ++mCurrentStepTotal;
+        if (std::chrono::steady_clock::now() - start >= maxExecuteDuration)
             break;
-        }
     }
 
     emit progress(mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
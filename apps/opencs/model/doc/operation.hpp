@@ -8,11 +8,18 @@
 
 #include <QObject>
 
+#include <osg/ref_ptr>
+
 #include "messages.hpp"
 #include "state.hpp"
 
 class QTimer;
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace CSMDoc
 {
     class Stage;
@@ -35,9 +42,14 @@ namespace CSMDoc
         bool mPrepared;
         Message::Severity mDefaultSeverity;
         std::optional<std::chrono::steady_clock::time_point> mStart;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
 
         void prepareStages();
 
+        void performStep(Messages& messages);
+
+        void performParallelSteps(Messages& messages);
+
     public:
         Operation(State type, bool ordered, bool finalAlways = false);
         ///< \param ordered Stages must be executed in the given order.
@@ -14,6 +14,9 @@ namespace CSMDoc
 
         virtual void perform(int stage, Messages& messages) = 0;
         ///< Messages resulting from this stage will be appended to \a messages.
+
+        virtual bool isParallel() const { return false; }
+        ///< \return Can different steps of this stage be performed at the same time from different threads?
     };
 }
 
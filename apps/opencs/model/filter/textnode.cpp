@@ -16,6 +16,11 @@ CSMFilter::TextNode::TextNode(int columnId, const std::string& text)
     , mRegExp(QRegularExpression::anchoredPattern(QString::fromUtf8(mText.c_str())),
           QRegularExpression::CaseInsensitiveOption)
 {
+    const auto id = static_cast<CSMWorld::Columns::ColumnId>(mColumnId);
+    mHasEnums = CSMWorld::Columns::hasEnums(id);
+    if (mHasEnums)
+        for (const auto& [value, name] : CSMWorld::Columns::getEnums(id))
+            mEnumNames.push_back(QString::fromUtf8(name.c_str()));
 }
 
 bool CSMFilter::TextNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
@@ -38,16 +43,12 @@ bool CSMFilter::TextNode::test(const CSMWorld::IdTableBase& table, int row, cons
     {
         string = data.toString();
     }
-    else if ((data.typeId() == QMetaType::Int || data.typeId() == QMetaType::UInt)
-        && CSMWorld::Columns::hasEnums(static_cast<CSMWorld::Columns::ColumnId>(mColumnId)))
+    else if ((data.typeId() == QMetaType::Int || data.typeId() == QMetaType::UInt) && mHasEnums)
     {
         int value = data.toInt();
 
-        std::vector<std::pair<int, std::string>> enums
-            = CSMWorld::Columns::getEnums(static_cast<CSMWorld::Columns::ColumnId>(mColumnId));
-
-        if (value >= 0 && value < static_cast<int>(enums.size()))
-            string = QString::fromUtf8(enums[value].second.c_str());
+        if (value >= 0 && value < static_cast<int>(mEnumNames.size()))
+            string = mEnumNames[value];
     }
     else if (data.typeId() == QMetaType::Bool)
     {
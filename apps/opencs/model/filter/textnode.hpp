@@ -6,6 +6,7 @@
 #include <vector>
 
 #include <QRegularExpression>
+#include <QString>
 
 #include <apps/opencs/model/world/idtablebase.hpp>
 
@@ -18,6 +19,9 @@ namespace CSMFilter
         int mColumnId;
         std::string mText;
         QRegularExpression mRegExp;
+        bool mHasEnums = false;
+        // Names of the values of an enum column, converted once instead of for every tested row
+        std::vector<QString> mEnumNames;
 
     public:
         TextNode(int columnId, const std::string& text);
@@ -194,6 +194,10 @@ void CSMPrefs::State::declare()
             "Sets the gradient color to use in conjunction with the night background color. Ignored if "
             "the gradient option is disabled.");
     declareBool(mValues->mRendering.mSceneDayNightSwitchNodes, "Use Day/Night Switch Nodes");
+    declareBool(mValues->mRendering.mDistantTerrain, "Distant Terrain")
+        .setTooltip("Draw the terrain of the worldspace around the loaded cells with a lower level of detail.");
+    declareInt(mValues->mRendering.mDistantTerrainViewDistance, "Distant Terrain View Distance (Cells)")
+        .setRange(1, 256);
 
     declareCategory("Tooltips");
     declareBool(mValues->mTooltips.mScene, "Show Tooltips in 3D Scenes");
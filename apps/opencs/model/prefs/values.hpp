@@ -273,6 +273,8 @@ namespace CSMPrefs
         Settings::SettingValue<std::string> mSceneNightGradientColour{ mIndex, sName, "scene-night-gradient-colour",
             "#2f3333" };
         Settings::SettingValue<bool> mSceneDayNightSwitchNodes{ mIndex, sName, "scene-day-night-switch-nodes", true };
+        Settings::SettingValue<bool> mDistantTerrain{ mIndex, sName, "distant-terrain", false };
+        Settings::SettingValue<int> mDistantTerrainViewDistance{ mIndex, sName, "distant-terrain-view-distance", 16 };
     };
 
     struct TooltipsCategory : Settings::WithIndex
@@ -19,11 +19,12 @@ class QObject;
 
 namespace
 {
-    std::string getEnumValue(const std::vector<std::pair<int, std::string>>& values, int index)
+    const std::string& getEnumValue(const std::vector<std::pair<int, std::string>>& values, int index)
     {
+        static const std::string empty;
         if (index < 0 || index >= static_cast<int>(values.size()))
         {
-            return "";
+            return empty;
         }
         return values[index].second;
     }
@@ -67,6 +68,9 @@ CSMWorld::IdTableProxyModel::IdTableProxyModel(QObject* parent)
     , mSourceModel(nullptr)
 {
     setSortCaseSensitivity(Qt::CaseInsensitive);
+    // Filter nodes only test the columns of the row itself, so inserted and changed rows are filtered on their own
+    // instead of filtering the whole table again
+    setDynamicSortFilter(true);
 
     mFilterTimer->setSingleShot(true);
     int intervalSetting = CSMPrefs::State::get()["ID Tables"]["filter-delay"].toInt();
@@ -114,8 +118,8 @@ bool CSMWorld::IdTableProxyModel::lessThan(const QModelIndex& left, const QModel
 
     if (valuesIt != mEnumColumnCache.end())
     {
-        std::string first = getEnumValue(valuesIt->second, left.data().toInt());
-        std::string second = getEnumValue(valuesIt->second, right.data().toInt());
+        const std::string& first = getEnumValue(valuesIt->second, left.data().toInt());
+        const std::string& second = getEnumValue(valuesIt->second, right.data().toInt());
         return first < second;
     }
     return QSortFilterProxyModel::lessThan(left, right);
@@ -160,19 +164,14 @@ void CSMWorld::IdTableProxyModel::settingChanged(const CSMPrefs::Setting* settin
 
 void CSMWorld::IdTableProxyModel::sourceRowsInserted(const QModelIndex& parent, int /*start*/, int end)
 {
-    refreshFilter();
     if (!parent.isValid())
     {
         emit rowAdded(getRecordId(end).toUtf8().constData());
     }
 }
 
-void CSMWorld::IdTableProxyModel::sourceRowsRemoved(const QModelIndex& /*parent*/, int /*start*/, int /*end*/)
-{
-    refreshFilter();
-}
+void CSMWorld::IdTableProxyModel::sourceRowsRemoved(const QModelIndex& /*parent*/, int /*start*/, int /*end*/) {}
 
 void CSMWorld::IdTableProxyModel::sourceDataChanged(const QModelIndex& /*topLeft*/, const QModelIndex& /*bottomRight*/)
 {
-    refreshFilter();
 }
@@ -0,0 +1,58 @@
+#include "distantterrain.hpp"
+
+#include <osg/Group>
+#include <osg/PolygonOffset>
+#include <osg/StateSet>
+
+#include <components/esm3/loadcell.hpp>
+#include <components/terrain/quadtreeworld.hpp>
+
+#include <apps/opencs/model/world/data.hpp>
+
+#include "mask.hpp"
+#include "terrainstorage.hpp"
+
+namespace CSVRender
+{
+    namespace
+    {
+        constexpr int compositeMapResolution = 512;
+        constexpr float compositeMapLevel = 0.01f;
+        constexpr float lodFactor = 1.f;
+        constexpr int vertexLodMod = 0;
+        constexpr float maxCompositeGeometrySize = 4.f;
+        constexpr double expiryDelay = 0;
+    }
+
+    DistantTerrain::DistantTerrain(osg::Group* parent, CSMWorld::Data& data)
+        : mParent(parent)
+        , mNode(new osg::Group)
+        , mStorage(std::make_unique<TerrainStorage>(data))
+    {
+        // Push the chunks back in depth, so that the terrain of the loaded cells covers them where both are drawn
+        osg::StateSet* stateSet = mNode->getOrCreateStateSet();
+        stateSet->setAttributeAndModes(new osg::PolygonOffset(1.f, 4.f), osg::StateAttribute::ON);
+        mParent->addChild(mNode);
+
+        mTerrain = std::make_unique<Terrain::QuadTreeWorld>(mNode, mParent, data.getResourceSystem().get(),
+            mStorage.get(), Mask_DistantTerrain, ~0u, 0, compositeMapResolution, compositeMapLevel, lodFactor,
+            vertexLodMod, maxCompositeGeometrySize, false, ESM::Cell::sDefaultWorldspaceId, expiryDelay);
+    }
+
+    DistantTerrain::~DistantTerrain()
+    {
+        mTerrain.reset();
+        mParent->removeChild(mNode);
+    }
+
+    void DistantTerrain::setViewDistance(float distance)
+    {
+        mTerrain->setViewDistance(distance);
+    }
+
+    void DistantTerrain::reload()
+    {
+        mTerrain->clearAssociatedCaches();
+        mTerrain->rebuildViews();
+    }
+}
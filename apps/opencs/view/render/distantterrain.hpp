@@ -0,0 +1,51 @@
+#ifndef OPENCS_VIEW_DISTANTTERRAIN_H
+#define OPENCS_VIEW_DISTANTTERRAIN_H
+
+#include <memory>
+
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Group;
+}
+
+namespace Terrain
+{
+    class QuadTreeWorld;
+}
+
+namespace CSMWorld
+{
+    class Data;
+}
+
+namespace CSVRender
+{
+    class TerrainStorage;
+
+    /// \brief Terrain of the whole worldspace with geometry and texture LOD
+    ///
+    /// Chunks are loaded around the camera while the scene is culled. The terrain is drawn behind the terrain of the
+    /// loaded cells, which stays the one that is edited and picked.
+    class DistantTerrain
+    {
+        osg::ref_ptr<osg::Group> mParent;
+        osg::ref_ptr<osg::Group> mNode;
+        std::unique_ptr<TerrainStorage> mStorage;
+        std::unique_ptr<Terrain::QuadTreeWorld> mTerrain;
+
+    public:
+        DistantTerrain(osg::Group* parent, CSMWorld::Data& data);
+
+        ~DistantTerrain();
+
+        /// \param distance Distance from the camera at which chunks are no longer drawn, in units
+        void setViewDistance(float distance);
+
+        /// Reload all chunks to show changed land or land textures.
+        void reload();
+    };
+}
+
+#endif
@@ -8,6 +8,8 @@
 #include <type_traits>
 
 #include <apps/opencs/model/doc/document.hpp>
+#include <apps/opencs/model/prefs/category.hpp>
+#include <apps/opencs/model/prefs/setting.hpp>
 #include <apps/opencs/model/world/cellselection.hpp>
 #include <apps/opencs/model/world/columns.hpp>
 #include <apps/opencs/model/world/data.hpp>
@@ -25,12 +27,15 @@
 #include <components/misc/constants.hpp>
 #include <components/misc/scalableicon.hpp>
 
+#include <QTimer>
+
 #include <osg/Camera>
 #include <osg/Vec3f>
 #include <osg/ref_ptr>
 #include <osgViewer/View>
 
 #include "../../model/prefs/shortcut.hpp"
+#include "../../model/prefs/state.hpp"
 
 #include "../../model/world/idtable.hpp"
 
@@ -38,6 +43,7 @@
 #include "../widget/scenetooltoggle2.hpp"
 
 #include "cellarrow.hpp"
+#include "distantterrain.hpp"
 #include "editmode.hpp"
 #include "mask.hpp"
 #include "terrainshapemode.hpp"
@@ -251,6 +257,17 @@ void CSVRender::PagedWorldspaceWidget::handleInteractionPress(const WorldspaceHi
     WorldspaceWidget::handleInteractionPress(hit, type);
 }
 
+void CSVRender::PagedWorldspaceWidget::settingChanged(const CSMPrefs::Setting* setting)
+{
+    if (*setting == "Rendering/distant-terrain" || *setting == "Rendering/distant-terrain-view-distance")
+    {
+        updateDistantTerrain();
+        flagAsModified();
+    }
+    else
+        WorldspaceWidget::settingChanged(setting);
+}
+
 void CSVRender::PagedWorldspaceWidget::referenceableDataChanged(
     const QModelIndex& topLeft, const QModelIndex& bottomRight)
 {
@@ -390,6 +407,8 @@ void CSVRender::PagedWorldspaceWidget::landDataChanged(const QModelIndex& topLef
             flagAsModified();
         }
     }
+
+    scheduleDistantTerrainReload();
 }
 
 void CSVRender::PagedWorldspaceWidget::landAboutToBeRemoved(const QModelIndex& parent, int start, int end)
@@ -405,6 +424,8 @@ void CSVRender::PagedWorldspaceWidget::landAboutToBeRemoved(const QModelIndex& p
             flagAsModified();
         }
     }
+
+    scheduleDistantTerrainReload();
 }
 
 void CSVRender::PagedWorldspaceWidget::landAdded(const QModelIndex& parent, int start, int end)
@@ -420,6 +441,8 @@ void CSVRender::PagedWorldspaceWidget::landAdded(const QModelIndex& parent, int
             flagAsModified();
         }
     }
+
+    scheduleDistantTerrainReload();
 }
 
 void CSVRender::PagedWorldspaceWidget::landTextureDataChanged(
@@ -427,6 +450,7 @@ void CSVRender::PagedWorldspaceWidget::landTextureDataChanged(
 {
     for (auto cellIt : mCells)
         cellIt.second->landTextureChanged(topLeft, bottomRight);
+    scheduleDistantTerrainReload();
     flagAsModified();
 }
 
@@ -434,6 +458,7 @@ void CSVRender::PagedWorldspaceWidget::landTextureAboutToBeRemoved(const QModelI
 {
     for (auto cellIt : mCells)
         cellIt.second->landTextureAboutToBeRemoved(parent, start, end);
+    scheduleDistantTerrainReload();
     flagAsModified();
 }
 
@@ -441,6 +466,7 @@ void CSVRender::PagedWorldspaceWidget::landTextureAdded(const QModelIndex& paren
 {
     for (auto cellIt : mCells)
         cellIt.second->landTextureAdded(parent, start, end);
+    scheduleDistantTerrainReload();
     flagAsModified();
 }
 
@@ -519,6 +545,27 @@ void CSVRender::PagedWorldspaceWidget::moveCellSelection(int x, int y)
     mSelection = std::move(newSelection);
 }
 
+void CSVRender::PagedWorldspaceWidget::updateDistantTerrain()
+{
+    if (!CSMPrefs::get()["Rendering"]["distant-terrain"].isTrue())
+    {
+        mDistantTerrain.reset();
+        return;
+    }
+
+    if (mDistantTerrain == nullptr)
+        mDistantTerrain = std::make_unique<DistantTerrain>(mRootNode, mDocument.getData());
+
+    const int viewDistance = CSMPrefs::get()["Rendering"]["distant-terrain-view-distance"].toInt();
+    mDistantTerrain->setViewDistance(static_cast<float>(viewDistance * Constants::CellSizeInUnits));
+}
+
+void CSVRender::PagedWorldspaceWidget::scheduleDistantTerrainReload()
+{
+    if (mDistantTerrain != nullptr)
+        mDistantTerrainReloadTimer->start();
+}
+
 void CSVRender::PagedWorldspaceWidget::addCellToSceneFromCamera(int offsetX, int offsetY)
 {
     osg::Vec3f eye, center, up;
@@ -544,6 +591,7 @@ CSVRender::PagedWorldspaceWidget::PagedWorldspaceWidget(QWidget* parent, CSMDoc:
     , mWorldspace("std::default")
     , mControlElements(nullptr)
     , mDisplayCellCoord(true)
+    , mDistantTerrainReloadTimer(new QTimer(this))
 {
     QAbstractItemModel* cells = document.getData().getTableModel(CSMWorld::UniversalId::Type_Cells);
 
@@ -586,6 +634,13 @@ CSVRender::PagedWorldspaceWidget::PagedWorldspaceWidget(QWidget* parent, CSMDoc:
     CSMPrefs::Shortcut* loadCameraSouthCellShortcut = new CSMPrefs::Shortcut("scene-load-cam-southcell", this);
     connect(loadCameraSouthCellShortcut, qOverload<>(&CSMPrefs::Shortcut::activated), this,
         &PagedWorldspaceWidget::loadSouthCell);
+
+    // Land is changed many times in a row while it is edited, rebuilding all chunks every time would stall the view
+    mDistantTerrainReloadTimer->setSingleShot(true);
+    mDistantTerrainReloadTimer->setInterval(1000);
+    connect(mDistantTerrainReloadTimer, &QTimer::timeout, this, &PagedWorldspaceWidget::reloadDistantTerrain);
+
+    updateDistantTerrain();
 }
 
 CSVRender::PagedWorldspaceWidget::~PagedWorldspaceWidget()
@@ -742,7 +797,13 @@ CSVRender::WorldspaceWidget::dropRequirments CSVRender::PagedWorldspaceWidget::g
 
 unsigned int CSVRender::PagedWorldspaceWidget::getVisibilityMask() const
 {
-    return WorldspaceWidget::getVisibilityMask() | mControlElements->getSelectionMask();
+    unsigned int mask = WorldspaceWidget::getVisibilityMask() | mControlElements->getSelectionMask();
+
+    // The distant terrain is hidden together with the terrain of the loaded cells
+    if (mask & Mask_Terrain)
+        mask |= Mask_DistantTerrain;
+
+    return mask;
 }
 
 void CSVRender::PagedWorldspaceWidget::clearSelection(int elementMask)
@@ -965,6 +1026,15 @@ void CSVRender::PagedWorldspaceWidget::assetTablesChanged()
     }
 }
 
+void CSVRender::PagedWorldspaceWidget::reloadDistantTerrain()
+{
+    if (mDistantTerrain == nullptr)
+        return;
+
+    mDistantTerrain->reload();
+    flagAsModified();
+}
+
 void CSVRender::PagedWorldspaceWidget::loadCameraCell()
 {
     addCellToSceneFromCamera(0, 0);
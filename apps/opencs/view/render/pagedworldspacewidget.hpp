@@ -2,6 +2,7 @@
 #define OPENCS_VIEW_PAGEDWORLDSPACEWIDGET_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,6 +17,7 @@
 
 class QModelIndex;
 class QObject;
+class QTimer;
 class QWidget;
 
 namespace osg
@@ -30,6 +32,11 @@ namespace CSMDoc
     class Document;
 }
 
+namespace CSMPrefs
+{
+    class Setting;
+}
+
 namespace CSMWorld
 {
     class UniversalId;
@@ -45,6 +52,7 @@ namespace CSVWidget
 namespace CSVRender
 {
     class Cell;
+    class DistantTerrain;
     class TagBase;
 
     class PagedWorldspaceWidget : public WorldspaceWidget
@@ -57,6 +65,8 @@ namespace CSVRender
         std::string mWorldspace;
         CSVWidget::SceneToolToggle2* mControlElements;
         bool mDisplayCellCoord;
+        std::unique_ptr<DistantTerrain> mDistantTerrain;
+        QTimer* mDistantTerrainReloadTimer;
 
     private:
         std::pair<int, int> getCoordinatesFromId(const std::string& record) const;
@@ -102,6 +112,12 @@ namespace CSVRender
 
         void addCellToSceneFromCamera(int offsetX, int offsetY);
 
+        /// Create or destroy the distant terrain according to the user settings.
+        void updateDistantTerrain();
+
+        /// Reload the distant terrain once the land stops changing.
+        void scheduleDistantTerrainReload();
+
     public:
         PagedWorldspaceWidget(QWidget* parent, CSMDoc::Document& document);
         ///< \note Sets the cell area selection to an invalid value to indicate that currently
@@ -183,6 +199,8 @@ namespace CSVRender
 
         void handleInteractionPress(const WorldspaceHitResult& hit, InteractionType type) override;
 
+        void settingChanged(const CSMPrefs::Setting* setting) override;
+
     signals:
 
         void cellSelectionChanged(const CSMWorld::CellSelection& selection);
@@ -205,6 +223,8 @@ namespace CSVRender
 
         void assetTablesChanged();
 
+        void reloadDistantTerrain();
+
         void loadCameraCell();
 
         void loadEastCell();
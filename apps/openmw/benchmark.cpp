@@ -0,0 +1,319 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include <osg/Math>
+#include <osg/Stats>
+
+#include "mwbase/environment.hpp"
+#include "mwbase/windowmanager.hpp"
+#include "mwbase/world.hpp"
+
+#include "mwworld/class.hpp"
+#include "mwworld/player.hpp"
+
+#include "mwmechanics/creaturestats.hpp"
+
+#include "profile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace OMW
+{
+    namespace
+    {
+        const std::array<std::string, 5> osgStats = {
+            "Event traversal time taken",
+            "Update traversal time taken",
+            "Cull traversal time taken",
+            "Draw traversal time taken",
+            "GPU draw time taken",
+        };
+
+        BenchmarkWaypoint parseWaypoint(double time, BenchmarkWaypoint::Kind kind, std::istream& stream)
+        {
+            BenchmarkWaypoint result{ .mTime = time, .mKind = kind, .mPosition = {}, .mZRot = 0, .mXRot = 0 };
+            stream >> result.mPosition.x() >> result.mPosition.y() >> result.mPosition.z() >> result.mZRot;
+            if (!stream)
+                throw std::runtime_error("position and rotation are expected");
+            if (!(stream >> result.mXRot))
+            {
+                if (!stream.eof())
+                    throw std::runtime_error("invalid x rotation");
+                result.mXRot = 0;
+            }
+            return result;
+        }
+
+        double getPercentile(const std::vector<double>& sorted, double percentile)
+        {
+            // Nearest rank
+            const auto rank = static_cast<std::size_t>(std::ceil(percentile / 100 * sorted.size()));
+            return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\';
+                stream << c;
+            }
+            stream << '"';
+        }
+    }
+
+    BenchmarkRoute parseBenchmarkRoute(std::istream& stream)
+    {
+        BenchmarkRoute result;
+        std::string line;
+        std::size_t lineNumber = 0;
+        bool ended = false;
+        while (std::getline(stream, line))
+        {
+            ++lineNumber;
+            const std::size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#')
+                continue;
+
+            try
+            {
+                if (ended)
+                    throw std::runtime_error("entries after the end");
+
+                std::istringstream lineStream(line);
+                double time = 0;
+                std::string action;
+                if (!(lineStream >> time >> action))
+                    throw std::runtime_error("time and action are expected");
+                if (!std::isfinite(time) || time < result.mDuration)
+                    throw std::runtime_error("time must not decrease");
+
+                if (action == "move")
+                    result.mWaypoints.push_back(parseWaypoint(time, BenchmarkWaypoint::Kind::Move, lineStream));
+                else if (action == "teleport")
+                    result.mWaypoints.push_back(parseWaypoint(time, BenchmarkWaypoint::Kind::Teleport, lineStream));
+                else if (action == "console")
+                {
+                    std::string command;
+                    std::getline(lineStream >> std::ws, command);
+                    while (!command.empty() && (command.back() == '\r' || command.back() == ' '))
+                        command.pop_back();
+                    if (command.empty())
+                        throw std::runtime_error("command is expected");
+                    result.mCommands.push_back(BenchmarkCommand{ .mTime = time, .mCommand = std::move(command) });
+                }
+                else if (action == "end")
+                    ended = true;
+                else
+                    throw std::runtime_error("unknown action \"" + action + "\"");
+
+                result.mDuration = time;
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error(
+                    "Invalid benchmark route line " + std::to_string(lineNumber) + ": " + std::string(e.what()));
+            }
+        }
+        return result;
+    }
+
+    BenchmarkRoute loadBenchmarkRoute(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path);
+        if (!stream.is_open())
+            throw std::runtime_error("Failed to open benchmark route: " + path.string());
+        return parseBenchmarkRoute(stream);
+    }
+
+    FrameTimeSummary summarizeFrameTimes(std::vector<double> frameTimes)
+    {
+        FrameTimeSummary result;
+        if (frameTimes.empty())
+            return result;
+
+        std::sort(frameTimes.begin(), frameTimes.end());
+        result.mFrames = frameTimes.size();
+        result.mMean = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / frameTimes.size();
+        result.mP50 = getPercentile(frameTimes, 50);
+        result.mP90 = getPercentile(frameTimes, 90);
+        result.mP95 = getPercentile(frameTimes, 95);
+        result.mP99 = getPercentile(frameTimes, 99);
+        result.mP999 = getPercentile(frameTimes, 99.9);
+        result.mMax = frameTimes.back();
+        const auto countOver = [&](double threshold) {
+            return static_cast<std::size_t>(
+                frameTimes.end() - std::upper_bound(frameTimes.begin(), frameTimes.end(), threshold));
+        };
+        result.mOver50Ms = countOver(50);
+        result.mOver100Ms = countOver(100);
+        return result;
+    }
+
+    std::optional<std::size_t> getPeakMemoryUsage()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return std::nullopt;
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return std::nullopt;
+#ifdef __APPLE__
+        return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+
+    Benchmark::Benchmark(BenchmarkRoute route)
+        : mRoute(std::move(route))
+    {
+    }
+
+    bool Benchmark::update(unsigned frameNumber, double dt)
+    {
+        if (mLastFrame.has_value())
+            return false;
+
+        if (mFirstFrame.has_value())
+            mTime += dt;
+        else
+            mFirstFrame = frameNumber;
+
+        for (; mNextCommand < mRoute.mCommands.size() && mRoute.mCommands[mNextCommand].mTime <= mTime; ++mNextCommand)
+            MWBase::Environment::get().getWindowManager()->executeCommandInConsole(
+                mRoute.mCommands[mNextCommand].mCommand);
+
+        movePlayer();
+
+        if (mTime < mRoute.mDuration)
+            return true;
+
+        mLastFrame = frameNumber;
+        return false;
+    }
+
+    void Benchmark::movePlayer()
+    {
+        const std::vector<BenchmarkWaypoint>& waypoints = mRoute.mWaypoints;
+        bool teleported = false;
+        for (; mWaypoint < waypoints.size() && waypoints[mWaypoint].mTime <= mTime; ++mWaypoint)
+            teleported = teleported || waypoints[mWaypoint].mKind == BenchmarkWaypoint::Kind::Teleport;
+
+        if (mWaypoint == 0)
+            return;
+
+        const BenchmarkWaypoint& previous = waypoints[mWaypoint - 1];
+        osg::Vec3f position = previous.mPosition;
+        float zRot = previous.mZRot;
+        float xRot = previous.mXRot;
+        if (mWaypoint < waypoints.size() && waypoints[mWaypoint].mKind == BenchmarkWaypoint::Kind::Move)
+        {
+            const BenchmarkWaypoint& next = waypoints[mWaypoint];
+            const auto factor = static_cast<float>((mTime - previous.mTime) / (next.mTime - previous.mTime));
+            position += (next.mPosition - previous.mPosition) * factor;
+            zRot += (next.mZRot - previous.mZRot) * factor;
+            xRot += (next.mXRot - previous.mXRot) * factor;
+        }
+
+        MWBase::World& world = *MWBase::Environment::get().getWorld();
+        MWWorld::Ptr player = world.getPlayerPtr();
+        if (teleported)
+        {
+            player.getClass().getCreatureStats(player).setTeleported(true);
+            world.getPlayer().setTeleported(true);
+        }
+        player = world.moveObject(player, position, true, true);
+        world.rotateObject(player, osg::Vec3f(osg::DegreesToRadians(xRot), 0, osg::DegreesToRadians(zRot)));
+    }
+
+    void Benchmark::addFrame(unsigned frameNumber, std::chrono::steady_clock::duration duration)
+    {
+        if (isOnRoute(frameNumber))
+            mFrameTimes.push_back(std::chrono::duration<double, std::milli>(duration).count());
+    }
+
+    void Benchmark::addStats(unsigned frameNumber, const osg::Stats& stats)
+    {
+        if (!isOnRoute(frameNumber))
+            return;
+
+        const auto add = [&](const std::string& name) {
+            double value = 0;
+            if (!stats.getAttribute(frameNumber, name, value))
+                return;
+            Average& average = mTimings[name];
+            average.mSum += value;
+            ++average.mCount;
+        };
+
+        forEachUserStatsValue([&](const UserStats& v) { add(v.mTaken); });
+        for (const std::string& name : osgStats)
+            add(name);
+    }
+
+    bool Benchmark::isOnRoute(unsigned frameNumber) const
+    {
+        // The first frame is skipped because it may include loading the start of the route
+        return mFirstFrame.has_value() && frameNumber > *mFirstFrame
+            && (!mLastFrame.has_value() || frameNumber < *mLastFrame);
+    }
+
+    void Benchmark::writeReport(std::ostream& stream) const
+    {
+        const FrameTimeSummary summary = summarizeFrameTimes(mFrameTimes);
+        stream << "{\n";
+        stream << "  \"completed\": " << (mLastFrame.has_value() ? "true" : "false") << ",\n";
+        stream << "  \"duration\": " << mTime << ",\n";
+        stream << "  \"frames\": " << summary.mFrames << ",\n";
+        stream << "  \"frameTimeMs\": {\n";
+        stream << "    \"mean\": " << summary.mMean << ",\n";
+        stream << "    \"p50\": " << summary.mP50 << ",\n";
+        stream << "    \"p90\": " << summary.mP90 << ",\n";
+        stream << "    \"p95\": " << summary.mP95 << ",\n";
+        stream << "    \"p99\": " << summary.mP99 << ",\n";
+        stream << "    \"p99.9\": " << summary.mP999 << ",\n";
+        stream << "    \"max\": " << summary.mMax << "\n";
+        stream << "  },\n";
+        stream << "  \"hitches\": {\n";
+        stream << "    \"over50ms\": " << summary.mOver50Ms << ",\n";
+        stream << "    \"over100ms\": " << summary.mOver100Ms << "\n";
+        stream << "  },\n";
+        stream << "  \"averageTimeTakenMs\": {";
+        bool first = true;
+        for (const auto& [name, average] : mTimings)
+        {
+            stream << (first ? "\n" : ",\n") << "    ";
+            writeString(stream, name);
+            // Stats are collected in seconds
+            stream << ": " << average.mSum / average.mCount * 1000;
+            first = false;
+        }
+        stream << (first ? "},\n" : "\n  },\n");
+        stream << "  \"peakMemoryBytes\": ";
+        if (const std::optional<std::size_t> memory = getPeakMemoryUsage())
+            stream << *memory;
+        else
+            stream << "null";
+        stream << "\n}\n";
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef OPENMW_BENCHMARK_H
+#define OPENMW_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <osg/Vec3f>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace OMW
+{
+    struct BenchmarkWaypoint
+    {
+        enum class Kind
+        {
+            // The player moves in a straight line from the previous waypoint
+            Move,
+            // The player is placed at the waypoint
+            Teleport,
+        };
+
+        double mTime;
+        Kind mKind;
+        osg::Vec3f mPosition;
+        // In degrees
+        float mZRot;
+        float mXRot;
+    };
+
+    struct BenchmarkCommand
+    {
+        double mTime;
+        std::string mCommand;
+    };
+
+    /// @brief A recorded player path with console commands to run along it.
+    /// @par Every line of a route file starts with the time in seconds since the start of the route followed by one of:
+    /// "move x y z zRot [xRot]", "teleport x y z zRot [xRot]", "console command" and "end". Rotations are in degrees.
+    /// Times must not decrease. The route ends with the last entry. Empty lines and lines starting with # are ignored.
+    struct BenchmarkRoute
+    {
+        std::vector<BenchmarkWaypoint> mWaypoints;
+        std::vector<BenchmarkCommand> mCommands;
+        double mDuration = 0;
+    };
+
+    /// @throw std::runtime_error when the route is invalid
+    BenchmarkRoute parseBenchmarkRoute(std::istream& stream);
+
+    BenchmarkRoute loadBenchmarkRoute(const std::filesystem::path& path);
+
+    struct FrameTimeSummary
+    {
+        std::size_t mFrames = 0;
+        // In milliseconds
+        double mMean = 0;
+        double mP50 = 0;
+        double mP90 = 0;
+        double mP95 = 0;
+        double mP99 = 0;
+        double mP999 = 0;
+        double mMax = 0;
+        std::size_t mOver50Ms = 0;
+        std::size_t mOver100Ms = 0;
+    };
+
+    /// @param frameTimes in milliseconds
+    FrameTimeSummary summarizeFrameTimes(std::vector<double> frameTimes);
+
+    /// @return Peak resident memory of the process in bytes.
+    std::optional<std::size_t> getPeakMemoryUsage();
+
+    /// @brief Follows a route with the player and collects frame times and timing stats while doing so.
+    class Benchmark
+    {
+    public:
+        explicit Benchmark(BenchmarkRoute route);
+
+        /// Advance along the route, moving the player and running the commands that are due. Must be called once per
+        /// frame while the game is running.
+        /// @return Whether the route is not finished yet.
+        bool update(unsigned frameNumber, double dt);
+
+        /// Add the frame duration if the frame was a part of the route.
+        void addFrame(unsigned frameNumber, std::chrono::steady_clock::duration duration);
+
+        /// Add the time taken by the engine subsystems and traversals in the frame if it was a part of the route.
+        void addStats(unsigned frameNumber, const osg::Stats& stats);
+
+        void writeReport(std::ostream& stream) const;
+
+    private:
+        struct Average
+        {
+            double mSum = 0;
+            std::size_t mCount = 0;
+        };
+
+        const BenchmarkRoute mRoute;
+        double mTime = 0;
+        std::size_t mNextCommand = 0;
+        std::size_t mWaypoint = 0;
+        std::optional<unsigned> mFirstFrame;
+        std::optional<unsigned> mLastFrame;
+        std::vector<double> mFrameTimes;
+        std::map<std::string, Average, std::less<>> mTimings;
+
+        void movePlayer();
+
+        bool isOnRoute(unsigned frameNumber) const;
+    };
+}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/trace.hpp>
 
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/format.hpp>
@@ -23,6 +24,7 @@
 #include <components/sdlutil/imagetosurface.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
+#include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
@@ -34,6 +36,10 @@
 #include <components/sceneutil/glextensions.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
+#include <components/shader/compileprograms.hpp>
+#include <components/shader/programbinarycache.hpp>
+#include <components/shader/shadermanager.hpp>
+
 #include <components/files/configurationmanager.hpp>
 
 #include <components/version/version.hpp>
@@ -47,6 +53,8 @@
 
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
+#include <components/sceneutil/parallelupdate.hpp>
 #include <components/sceneutil/screencapture.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
 #include <components/sceneutil/util.hpp>
@@ -71,8 +79,11 @@
 #include "mwworld/datetimemanager.hpp"
 #include "mwworld/worldimp.hpp"
 
+#include "mwrender/renderingmanager.hpp"
 #include "mwrender/vismask.hpp"
 
+#include "mwphysics/physicssystem.hpp"
+
 #include "mwclass/classes.hpp"
 
 #include "mwdialogue/dialoguemanagerimp.hpp"
@@ -83,6 +94,7 @@
 
 #include "mwstate/statemanagerimp.hpp"
 
+#include "benchmark.hpp"
 #include "profile.hpp"
 
 namespace
@@ -149,10 +161,14 @@ namespace
 
         void operator()(osg::GraphicsContext* graphicsContext) override
         {
-            Log(Debug::Info) << "OpenGL Vendor: " << glGetString(GL_VENDOR);
-            Log(Debug::Info) << "OpenGL Renderer: " << glGetString(GL_RENDERER);
-            Log(Debug::Info) << "OpenGL Version: " << glGetString(GL_VERSION);
+            const std::string vendor = getString(GL_VENDOR);
+            const std::string renderer = getString(GL_RENDERER);
+            const std::string version = getString(GL_VERSION);
+            Log(Debug::Info) << "OpenGL Vendor: " << vendor;
+            Log(Debug::Info) << "OpenGL Renderer: " << renderer;
+            Log(Debug::Info) << "OpenGL Version: " << version;
             glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &mMaxTextureImageUnits);
+            mDriver = vendor + '\n' + renderer + '\n' + version;
         }
 
         int getMaxTextureImageUnits() const
@@ -162,8 +178,18 @@ namespace
             return mMaxTextureImageUnits;
         }
 
+        // Vendor, renderer and version of the GL implementation
+        const std::string& getDriver() const { return mDriver; }
+
     private:
         int mMaxTextureImageUnits = 0;
+        std::string mDriver;
+
+        static std::string getString(GLenum name)
+        {
+            const GLubyte* const value = glGetString(name);
+            return value == nullptr ? std::string() : std::string(reinterpret_cast<const char*>(value));
+        }
     };
 
     void reportStats(unsigned frameNumber, osgViewer::Viewer& viewer, std::ostream& stream)
@@ -174,23 +200,84 @@ namespace
         for (osg::Camera* camera : cameras)
             camera->getStats()->report(stream, frameNumber);
     }
+
+    void addBenchmarkStats(unsigned frameNumber, osgViewer::Viewer& viewer, OMW::Benchmark& benchmark)
+    {
+        benchmark.addStats(frameNumber, *viewer.getViewerStats());
+        osgViewer::Viewer::Cameras cameras;
+        viewer.getCameras(cameras);
+        for (osg::Camera* camera : cameras)
+            benchmark.addStats(frameNumber, *camera->getStats());
+    }
+
+    void writeBenchmarkReport(const OMW::Benchmark& benchmark, const std::filesystem::path& path)
+    {
+        std::ofstream stream(path, std::ios_base::out);
+        if (!stream.is_open())
+        {
+            Log(Debug::Error) << "Failed to open file to write benchmark report \"" << path
+                              << "\": " << std::generic_category().message(errno);
+            return;
+        }
+        benchmark.writeReport(stream);
+        Log(Debug::Info) << "Benchmark report is written to: " << path;
+    }
+
+#ifdef OPENMW_TRACING
+    void writeTrace()
+    {
+#ifdef _WIN32
+        const auto* traceFile = _wgetenv(L"OPENMW_TRACE_FILE");
+#else
+        const auto* traceFile = std::getenv("OPENMW_TRACE_FILE");
+#endif
+        if (traceFile == nullptr)
+            return;
+
+        const std::filesystem::path path(traceFile);
+        std::ofstream stream(path, std::ios_base::out);
+        if (!stream.is_open())
+        {
+            Log(Debug::Warning) << "Failed to open file to write trace \"" << path
+                                << "\": " << std::generic_category().message(errno);
+            return;
+        }
+        Debug::Trace::writeChromeTrace(stream);
+        Log(Debug::Info) << "Trace is written to: " << path;
+    }
+#endif
 }
 
 void OMW::Engine::executeLocalScripts()
 {
     MWWorld::LocalScripts& localScripts = mWorld->getLocalScripts();
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto run = [&](const std::pair<ESM::RefId, MWWorld::Ptr>& script) {
+        MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
+        mScriptManager->run(script.first, interpreterContext);
+    };
 
     localScripts.startIteration();
     std::pair<ESM::RefId, MWWorld::Ptr> script;
     while (localScripts.getNext(script))
+        run(script);
+
+    // Deferrable scripts use what is left of the budget and continue from the same place next frame
+    const std::chrono::duration<float, std::milli> budget(Settings::game().mLocalScriptsTimeBudget);
+    localScripts.startDeferredIteration();
+    while (localScripts.getNextDeferred(script))
     {
-        MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
-        mScriptManager->run(script.first, interpreterContext);
+        run(script);
+        if (budget.count() > 0 && std::chrono::steady_clock::now() - start >= budget)
+            break;
     }
 }
 
 bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 {
+    OPENMW_TRACE_SCOPE("Frame");
+
     const osg::Timer_t frameStart = mViewer->getStartTick();
     const osg::Timer* const timer = osg::Timer::instance();
     osg::Stats* const stats = mViewer->getViewerStats();
@@ -202,7 +289,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         // update input
         {
             ScopedProfile<UserStatsType::Input> profile(frameStart, frameNumber, *timer, *stats);
-            mInputManager->update(frametime, false);
+            mInputManager->update(frametime, mBenchmark != nullptr);
         }
 
         // When the window is minimized, pause the game. Currently this *has* to be here to work around a MyGUI bug.
@@ -236,6 +323,14 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         {
             ScopedProfile<UserStatsType::State> profile(frameStart, frameNumber, *timer, *stats);
             mStateManager->update(frametime);
+
+            if (mBenchmark != nullptr)
+            {
+                const MWBase::StateManager::State state = mStateManager->getState();
+                if (state == MWBase::StateManager::State_Ended
+                    || (state == MWBase::StateManager::State_Running && !mBenchmark->update(frameNumber, frametime)))
+                    mStateManager->requestQuit();
+            }
         }
 
         bool paused = mWorld->getTimeManager()->isPaused();
@@ -323,24 +418,43 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 
     mUnrefQueue->flush(*mWorkQueue);
 
+    // Memory usage changes slowly, there is no need to collect it every frame unless it is shown
+    Resource::MemoryRegistry& memoryRegistry = mResourceSystem->getMemoryRegistry();
+    if (reportResource || frameNumber % 60 == 0)
+        memoryRegistry.update();
+
     if (reportResource)
     {
         stats->setAttribute(frameNumber, "FrameNumber", frameNumber);
 
         mResourceSystem->reportStats(frameNumber, stats);
+        memoryRegistry.reportStats(frameNumber, *stats);
 
-        stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
-        stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
+        mWorkQueue->reportStats(frameNumber, *stats);
 
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
     }
 
+    // Timer queries have a cost, measure only while the stats overlay or offline collection shows them
+    const bool reportGpuTimers = reportResource || stats->collectStats("gpu");
+    SceneUtil::GpuTimer::setEnabled(reportGpuTimers);
+    if (reportGpuTimers)
+        SceneUtil::GpuTimer::reportStats(frameNumber, *stats);
+
     mStereoManager->updateSettings(Settings::camera().mNearClip, Settings::camera().mViewingDistance);
 
-    mViewer->eventTraversal();
-    mViewer->updateTraversal();
+    {
+        OPENMW_TRACE_SCOPE("Event Traversal");
+        mViewer->eventTraversal();
+    }
+
+    {
+        OPENMW_TRACE_SCOPE("Update Traversal");
+        mParallelUpdateVisitor->updateParallel(mViewer->getFrameStamp());
+        mViewer->updateTraversal();
+    }
 
     // update focus object for GUI
     {
@@ -351,9 +465,15 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     // if there is a separate Lua thread, it starts the update now
     mLuaWorker->allowUpdate(frameStart, frameNumber, *stats);
 
-    mViewer->renderingTraversals();
+    {
+        OPENMW_TRACE_SCOPE("Rendering Traversals");
+        mViewer->renderingTraversals();
+    }
 
-    mLuaWorker->finishUpdate(frameStart, frameNumber, *stats);
+    {
+        OPENMW_TRACE_SCOPE("Wait Lua Worker");
+        mLuaWorker->finishUpdate(frameStart, frameNumber, *stats);
+    }
 
     return true;
 }
@@ -369,6 +489,7 @@ OMW::Engine::Engine(Files::ConfigurationManager& configurationManager)
     , mUseSound(true)
     , mCompileAll(false)
     , mCompileAllDialogue(false)
+    , mWarmShaders(false)
     , mWarningsMode(1)
     , mScriptConsoleMode(false)
     , mActivationDistanceOverride(-1)
@@ -405,6 +526,8 @@ OMW::Engine::~Engine()
     mDialogueManager = nullptr;
     mJournal = nullptr;
     mWindowManager = nullptr;
+    if (mScriptManager != nullptr)
+        mScriptManager->writeCache();
     mScriptManager = nullptr;
     mWorld = nullptr;
     mStereoManager = nullptr;
@@ -412,6 +535,11 @@ OMW::Engine::~Engine()
     mInputManager = nullptr;
     mStateManager = nullptr;
     mLuaWorker = nullptr;
+    if (mLuaManager != nullptr)
+    {
+        mResourceSystem->getMemoryRegistry().remove("Lua");
+        mLuaManager->writeScriptCache();
+    }
     mLuaManager = nullptr;
     mL10nManager = nullptr;
 
@@ -422,6 +550,8 @@ OMW::Engine::~Engine()
 
     mViewer = nullptr;
 
+    if (mResourceSystem != nullptr)
+        mResourceSystem->getSceneManager()->getShaderManager().writeUsageManifest();
     mResourceSystem.reset();
 
     mEncoder = nullptr;
@@ -686,6 +816,7 @@ void OMW::Engine::createWindow()
 
     mViewer->realize();
     mGlMaxTextureImageUnits = identifyOp->getMaxTextureImageUnits();
+    mGlDriver = identifyOp->getDriver();
 
     mViewer->getEventQueue()->getCurrentEventState()->setWindowRectangle(
         0, 0, graphicsWindow->getTraits()->width, graphicsWindow->getTraits()->height);
@@ -731,21 +862,45 @@ void OMW::Engine::prepareEngine()
     createWindow();
 
     mVFS = std::make_unique<VFS::Manager>();
+    mVFS->setReadAheadCacheSize(static_cast<std::size_t>(Settings::cells().mReadAheadCacheSize) * 1024 * 1024);
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder());
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder(),
+        mCfgMgr.getCachePath() / "vfsindex.bin");
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
+    constexpr std::size_t mebibyte = 1024 * 1024;
+    mResourceSystem->getImageManager()->setMaxCacheSize(
+        static_cast<std::size_t>(Settings::cells().mTextureCacheMaxSize.get()) * mebibyte);
+    mResourceSystem->getImageManager()->setMaxTextureSize(Settings::general().mMaxTextureSize);
+    mResourceSystem->getSceneManager()->setMaxCacheSize(
+        static_cast<std::size_t>(Settings::cells().mModelCacheMaxSize.get()) * mebibyte);
+    mResourceSystem->getNifFileManager()->setMaxCacheSize(
+        static_cast<std::size_t>(Settings::cells().mNifCacheMaxSize.get()) * mebibyte);
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
         false); // keep to Off for now to allow better state sharing
     mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
         Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap, Settings::general().mAnisotropy);
+    if (Settings::models().mCacheConvertedModels)
+        mResourceSystem->getSceneManager()->setCompiledSceneCacheDirectory(mCfgMgr.getCachePath() / "models");
+    Shader::ShaderManager& shaderManager = mResourceSystem->getSceneManager()->getShaderManager();
+    if (Settings::shaders().mCacheProgramBinaries)
+    {
+        shaderManager.setProgramBinaryCacheDirectory(mCfgMgr.getCachePath() / "shaders", mGlDriver);
+        mViewer->getCamera()->getGraphicsContext()->add(
+            Shader::makeStoreProgramBinariesOperation(shaderManager.getProgramBinaryCache()));
+    }
+    if (Settings::shaders().mPrecompileShaders || mWarmShaders)
+        shaderManager.readUsageManifest(mCfgMgr.getCachePath() / "shaders.omwcache");
     mEnvironment.setResourceSystem(*mResourceSystem);
 
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
 
+    mParallelUpdateVisitor = new SceneUtil::ParallelUpdateVisitor(*mWorkQueue, mWorkQueue->getNumThreads());
+    mViewer->setUpdateVisitor(mParallelUpdateVisitor);
+
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
         new SceneUtil::WriteScreenshotToFileOperation(mCfgMgr.getScreenshotPath(),
             Settings::general().mScreenshotFormat,
@@ -760,8 +915,11 @@ void OMW::Engine::prepareEngine()
     mL10nManager->setPreferredLocales(Settings::general().mPreferredLocales, Settings::general().mGmstOverridesL10n);
     mEnvironment.setL10nManager(*mL10nManager);
 
-    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
+    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs", mCfgMgr.getUserDataPath());
     mEnvironment.setLuaManager(*mLuaManager);
+    mResourceSystem->getMemoryRegistry().add("Lua", [this] {
+        return Resource::MemoryUsage{ .mCpu = static_cast<std::size_t>(mLuaManager->getMemoryUsage()) };
+    });
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
@@ -838,8 +996,14 @@ void OMW::Engine::prepareEngine()
 
     Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
     Loading::AsyncListener asyncListener(*listener);
-    auto dataLoading = std::async(std::launch::async,
-        [&] { mWorld->loadData(mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder.get(), &asyncListener); });
+    const std::filesystem::path contentCache
+        = Settings::general().mCacheContentFiles ? mCfgMgr.getCachePath() / "content.omwcache" : std::filesystem::path();
+    // Only derived from the groundcover files, unlike the content cache it can't change the loaded records
+    const std::filesystem::path groundcoverCache = mCfgMgr.getCachePath() / "groundcover.omwcache";
+    auto dataLoading = std::async(std::launch::async, [&] {
+        mWorld->loadData(mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder.get(), contentCache,
+            groundcoverCache, &asyncListener);
+    });
 
     if (!mSkipMenu)
     {
@@ -858,6 +1022,22 @@ void OMW::Engine::prepareEngine()
     listener->loadingOff();
 
     mWorld->init(mMaxRecastLogLevel, mViewer, std::move(rootNode), mWorkQueue.get(), *mUnrefQueue);
+    if (Settings::shaders().mPrecompileShaders || mWarmShaders)
+    {
+        // Global defines are final once the rendering is set up, programs are compiled while the loading screen and
+        // the menu are shown or all within the first frame when warming
+        using namespace std::chrono_literals;
+        mViewer->getCamera()->getGraphicsContext()->add(new Shader::CompileProgramsOperation(
+            mResourceSystem->getSceneManager()->getShaderManager().createManifestPrograms(),
+            mWarmShaders ? std::chrono::steady_clock::duration::zero() : std::chrono::steady_clock::duration(2ms)));
+    }
+    if (Settings::terrain().mCacheCompositeMaps)
+        mWorld->getRenderingManager()->setCompositeMapCacheDirectory(mCfgMgr.getCachePath() / "composite");
+    if (Settings::general().mCacheCompressedTextures)
+        mResourceSystem->getImageManager()->setTextureCompressionCacheDirectory(
+            mCfgMgr.getCachePath() / "textures", mWorld->getRenderingManager()->getWorkQueue());
+    if (Settings::models().mCacheCollisionShapes)
+        mWorld->getPhysics()->getShapeManager()->setShapeCacheDirectory(mCfgMgr.getCachePath() / "collision");
     mEnvironment.setWorldScene(mWorld->getWorldScene());
     mWorld->setupPlayer();
     mWorld->setRandomSeed(mRandomSeed);
@@ -895,6 +1075,8 @@ void OMW::Engine::prepareEngine()
 
     mScriptManager = std::make_unique<MWScript::ScriptManager>(mWorld->getStore(), *mScriptContext, mWarningsMode);
     mEnvironment.setScriptManager(*mScriptManager);
+    if (!mWorld->getContentKey().empty())
+        mScriptManager->readCache(mCfgMgr.getCachePath() / "scripts.omwcache", mWorld->getContentKey());
 
     // Create game mechanics system
     mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>();
@@ -911,6 +1093,7 @@ void OMW::Engine::prepareEngine()
     if (mCompileAll)
     {
         std::pair<int, int> result = mScriptManager->compileAll();
+        mScriptManager->writeCache();
         if (result.first)
             Log(Debug::Info) << "compiled " << result.second << " of " << result.first << " scripts ("
                              << 100 * static_cast<double>(result.second) / result.first << "%)";
@@ -924,6 +1107,8 @@ void OMW::Engine::prepareEngine()
     }
 
     mLuaManager->loadPermanentStorage(mCfgMgr.getUserConfigPath());
+    if (Settings::lua().mBytecodeCache)
+        mLuaManager->readScriptCache(mCfgMgr.getCachePath() / "lua_bytecode.omwcache");
     mLuaManager->init();
 
     // starts a separate lua thread if "lua num threads" > 0
@@ -935,6 +1120,8 @@ void OMW::Engine::go()
 {
     assert(!mContentFiles.empty());
 
+    OPENMW_TRACE_THREAD_NAME("Main");
+
     Log(Debug::Info) << "OSG version: " << osgGetVersion();
     SDL_version sdlVersion;
     SDL_GetVersion(&sdlVersion);
@@ -959,6 +1146,12 @@ void OMW::Engine::go()
 
     mEnvironment.setFrameRateLimit(Settings::video().mFramerateLimit);
 
+    if (!mBenchmarkRoute.empty())
+    {
+        mBenchmark = std::make_unique<Benchmark>(loadBenchmarkRoute(mBenchmarkRoute));
+        Log(Debug::Info) << "Benchmark route is loaded from: " << mBenchmarkRoute;
+    }
+
     prepareEngine();
 
 #ifdef _WIN32
@@ -992,7 +1185,7 @@ void OMW::Engine::go()
     osg::ref_ptr<Resource::StatsHandler> resourcesHandler = new Resource::StatsHandler(stats.is_open(), *mVFS);
     mViewer->addEventHandler(resourcesHandler);
 
-    if (stats.is_open())
+    if (stats.is_open() || mBenchmark != nullptr)
         Resource::collectStatistics(*mViewer);
 
     // Start the game
@@ -1000,7 +1193,7 @@ void OMW::Engine::go()
     {
         mStateManager->loadGame(mSaveGameFile);
     }
-    else if (!mSkipMenu)
+    else if (!mSkipMenu && mBenchmark == nullptr)
     {
         // start in main menu
         mWindowManager->pushGuiMode(MWGui::GM_MainMenu);
@@ -1051,7 +1244,7 @@ void OMW::Engine::go()
             timeManager.setRenderingSimulationTime(timeManager.getRenderingSimulationTime() + dt);
         }
 
-        if (stats)
+        if (stats || mBenchmark != nullptr)
         {
             // The delay is required because rendering happens in parallel to the main thread and stats from there is
             // available with delay.
@@ -1062,15 +1255,30 @@ void OMW::Engine::go()
                 // frames inside a simulation frame.
                 const unsigned currentFrameNumber = mViewer->getFrameStamp()->getFrameNumber();
                 for (unsigned i = frameNumber; i <= currentFrameNumber; ++i)
-                    reportStats(i - statsReportDelay, *mViewer, stats);
+                {
+                    if (stats)
+                        reportStats(i - statsReportDelay, *mViewer, stats);
+                    if (mBenchmark != nullptr)
+                        addBenchmarkStats(i - statsReportDelay, *mViewer, *mBenchmark);
+                }
             }
         }
 
         frameRateLimiter.limit();
+
+        if (mBenchmark != nullptr)
+            mBenchmark->addFrame(frameNumber, frameRateLimiter.getLastFrameDuration());
     }
 
+    if (mBenchmark != nullptr)
+        writeBenchmarkReport(*mBenchmark, mBenchmarkReport);
+
     mLuaWorker->join();
 
+#ifdef OPENMW_TRACING
+    writeTrace();
+#endif
+
     // Save user settings
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
     Settings::ShaderManager::get().save();
@@ -1087,6 +1295,11 @@ void OMW::Engine::setCompileAllDialogue(bool all)
     mCompileAllDialogue = all;
 }
 
+void OMW::Engine::setWarmShaders(bool warm)
+{
+    mWarmShaders = warm;
+}
+
 void OMW::Engine::setSoundUsage(bool soundUsage)
 {
     mUseSound = soundUsage;
@@ -1131,3 +1344,9 @@ void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
 }
+
+void OMW::Engine::setBenchmark(const std::filesystem::path& route, const std::filesystem::path& report)
+{
+    mBenchmarkRoute = route;
+    mBenchmarkReport = report;
+}
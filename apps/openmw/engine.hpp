@@ -24,6 +24,7 @@ namespace SceneUtil
 {
     class WorkQueue;
     class AsyncScreenCaptureOperation;
+    class ParallelUpdateVisitor;
     class UnrefQueue;
 }
 
@@ -122,6 +123,8 @@ struct SDL_Window;
 
 namespace OMW
 {
+    class Benchmark;
+
     /// \brief Main engine class, that brings together all the components of OpenMW
     class Engine
     {
@@ -130,6 +133,7 @@ namespace OMW
         std::unique_ptr<Resource::ResourceSystem> mResourceSystem;
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
         std::unique_ptr<SceneUtil::UnrefQueue> mUnrefQueue;
+        osg::ref_ptr<SceneUtil::ParallelUpdateVisitor> mParallelUpdateVisitor;
         std::unique_ptr<MWWorld::World> mWorld;
         std::unique_ptr<MWSound::SoundManager> mSoundManager;
         std::unique_ptr<MWScript::ScriptManager> mScriptManager;
@@ -163,12 +167,16 @@ namespace OMW
         bool mUseSound;
         bool mCompileAll;
         bool mCompileAllDialogue;
+        bool mWarmShaders;
         int mWarningsMode;
         std::string mFocusName;
         bool mScriptConsoleMode;
         std::filesystem::path mStartupScript;
         int mActivationDistanceOverride;
         std::filesystem::path mSaveGameFile;
+        std::filesystem::path mBenchmarkRoute;
+        std::filesystem::path mBenchmarkReport;
+        std::unique_ptr<Benchmark> mBenchmark;
         // Grab mouse?
         bool mGrab;
 
@@ -185,6 +193,7 @@ namespace OMW
 
         Files::ConfigurationManager& mCfgMgr;
         int mGlMaxTextureImageUnits;
+        std::string mGlDriver;
 
         // not implemented
         Engine(const Engine&);
@@ -243,6 +252,9 @@ namespace OMW
         /// Compile all dialogue scripts at startup?
         void setCompileAllDialogue(bool all);
 
+        /// Compile all shader programs used by previous runs before the first frame?
+        void setWarmShaders(bool warm);
+
         /// Font encoding
         void setEncoding(const ToUTF8::FromType& encoding);
 
@@ -264,6 +276,9 @@ namespace OMW
 
         void setRandomSeed(unsigned int seed);
 
+        /// Follow the route with the player instead of taking input and write a performance report when it ends.
+        void setBenchmark(const std::filesystem::path& route, const std::filesystem::path& report);
+
         void setRecastMaxLogLevel(Debug::Level value) { mMaxRecastLogLevel = value; }
     };
 }
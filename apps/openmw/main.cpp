@@ -146,10 +146,13 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
     // scripts
     engine.setCompileAll(variables["script-all"].as<bool>());
     engine.setCompileAllDialogue(variables["script-all-dialogue"].as<bool>());
+    engine.setWarmShaders(variables["warm-shaders"].as<bool>());
     engine.setScriptConsoleMode(variables["script-console"].as<bool>());
     engine.setStartupScript(variables["script-run"].as<std::string>());
     engine.setWarningsMode(variables["script-warn"].as<int>());
     engine.setSaveGameFile(variables["load-savegame"].as<Files::MaybeQuotedPath>().u8string());
+    engine.setBenchmark(variables["benchmark"].as<Files::MaybeQuotedPath>().u8string(),
+        variables["benchmark-report"].as<Files::MaybeQuotedPath>().u8string());
 
     // other settings
     Fallback::Map::init(variables["fallback"].as<Fallback::FallbackMap>().mMap);
@@ -163,6 +163,9 @@ namespace MWBase
             = 0;
 
         virtual std::string formatResourceUsageStats() const = 0;
+
+        // Writes the profiler stats of every script to a CSV file in the user data directory and returns its path.
+        virtual std::filesystem::path exportProfile() const = 0;
     };
 
 }
@@ -66,6 +66,9 @@ namespace MWBase
         virtual void updateCell(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) = 0;
         ///< Moves an object to a new cell
 
+        virtual void updatePosition(const MWWorld::Ptr& ptr) = 0;
+        ///< Notify that an object was moved
+
         virtual void drop(const MWWorld::CellStore* cellStore) = 0;
         ///< Deregister all objects in the given cell.
 
@@ -239,6 +242,9 @@ namespace MWBase
 
         virtual std::vector<MWWorld::Ptr> getEnemiesNearby(const MWWorld::Ptr& actor) = 0;
 
+        /// @return Actor in the scene with the given actor id or empty Ptr if it is not known to the mechanics
+        virtual MWWorld::Ptr searchActorViaActorId(int actorId) const = 0;
+
         /// Recursive versions of above methods
         virtual void getActorsFollowing(const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out) = 0;
         virtual void getActorsSidingWith(const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out) = 0;
@@ -1,6 +1,7 @@
 #ifndef GAME_MWBASE_SCRIPTMANAGER_H
 #define GAME_MWBASE_SCRIPTMANAGER_H
 
+#include <string>
 #include <string_view>
 
 namespace Interpreter
@@ -59,6 +60,9 @@ namespace MWBase
         virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
 
         virtual const Compiler::Extensions& getExtensions() const = 0;
+
+        virtual std::string formatExecutionStats() const = 0;
+        ///< Return a table of the time spent in each script since the last clear().
     };
 }
 
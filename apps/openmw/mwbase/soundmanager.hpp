@@ -192,6 +192,10 @@ namespace MWBase
         ///< Play a 3D sound at \a initialPos. If the sound should be moving, it must be updated using
         ///< Sound::setPosition.
 
+        virtual void preloadSound(const ESM::RefId& soundId) = 0;
+        ///< Decode the sound in advance, so it does not have to be read when it is played for the first time.
+        /// \note Can be called from any thread.
+
         virtual void stopSound(Sound* sound) = 0;
         ///< Stop the given sound from playing
 
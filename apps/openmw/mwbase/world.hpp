@@ -135,6 +135,12 @@ namespace MWBase
 
         virtual void write(ESM::ESMWriter& writer, Loading::Listener& listener) const = 0;
 
+        virtual void writeCellsFile(ESM::ESMWriter& writer, Loading::Listener& listener) = 0;
+        ///< Write the state of all cells. The following calls to write will skip the cells with the same state.
+
+        virtual void clearCellsFile() = 0;
+        ///< Make write include all cells again.
+
         virtual void readRecord(ESM::ESMReader& reader, uint32_t type) = 0;
 
         virtual void useDeathCamera() = 0;
@@ -414,6 +420,9 @@ namespace MWBase
         virtual bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        virtual void queueLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
+        ///< request Line of Sight to be computed in background, so that a later getLOS is a cache lookup
+
         virtual float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false)
             = 0;
@@ -211,6 +211,18 @@ namespace MWClass
         }
     }
 
+    void Creature::getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const
+    {
+        const MWWorld::LiveCellRef<ESM::Creature>* ref = ptr.get<ESM::Creature>();
+        const ESM::RefId& ourId = ref->mBase->mOriginal.empty() ? ptr.getCellRef().getRefId() : ref->mBase->mOriginal;
+
+        for (const ESM::SoundGenerator& sound : MWBase::Environment::get().getESMStore()->get<ESM::SoundGenerator>())
+        {
+            if (sound.mCreature == ourId && !sound.mSound.empty())
+                sounds.push_back(sound.mSound);
+        }
+    }
+
     std::string_view Creature::getName(const MWWorld::ConstPtr& ptr) const
     {
         return getNameOrId<ESM::Creature>(ptr);
@@ -111,6 +111,9 @@ namespace MWClass
         ///< Get a list of models to preload that this object may use (directly or indirectly). default implementation:
         ///< list getModel().
 
+        void getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const override;
+        ///< List the sounds of the sound generators made for this creature.
+
         bool isBipedal(const MWWorld::ConstPtr& ptr) const override;
         bool canFly(const MWWorld::ConstPtr& ptr) const override;
         bool canSwim(const MWWorld::ConstPtr& ptr) const override;
@@ -100,6 +100,15 @@ namespace MWClass
         return getClassModel<ESM::Door>(ptr);
     }
 
+    void Door::getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const
+    {
+        const MWWorld::LiveCellRef<ESM::Door>* ref = ptr.get<ESM::Door>();
+        if (!ref->mBase->mOpenSound.empty())
+            sounds.push_back(ref->mBase->mOpenSound);
+        if (!ref->mBase->mCloseSound.empty())
+            sounds.push_back(ref->mBase->mCloseSound);
+    }
+
     std::string_view Door::getName(const MWWorld::ConstPtr& ptr) const
     {
         return getNameOrId<ESM::Door>(ptr);
@@ -197,14 +197,41 @@ bool MWDialogue::Filter::testPlayer(const ESM::DialInfo& info) const
     if (!info.mCell.empty())
     {
         // supports partial matches, just like getPcCell
-        std::string_view playerCell = MWBase::Environment::get().getWorld()->getCellName(player.getCell());
-        if (!Misc::StringUtils::ciStartsWith(playerCell, info.mCell.getRefIdString()))
+        if (!Misc::StringUtils::ciStartsWith(getPlayerCell(), info.mCell.getRefIdString()))
             return false;
     }
 
     return true;
 }
 
+int MWDialogue::Filter::getDisposition() const
+{
+    if (!mDisposition.has_value())
+        mDisposition = MWBase::Environment::get().getMechanicsManager()->getDerivedDisposition(mActor);
+    return *mDisposition;
+}
+
+std::string_view MWDialogue::Filter::getPlayerCell() const
+{
+    if (!mPlayerCell.has_value())
+        mPlayerCell = MWBase::Environment::get().getWorld()->getCellName(MWMechanics::getPlayer().getCell());
+    return *mPlayerCell;
+}
+
+std::string_view MWDialogue::Filter::getActorCell() const
+{
+    if (!mActorCell.has_value())
+        mActorCell = MWBase::Environment::get().getWorld()->getCellName(mActor.getCell());
+    return *mActorCell;
+}
+
+const std::vector<const ESM::DialInfo*>& MWDialogue::Filter::getCandidates(const ESM::Dialogue& dialogue) const
+{
+    MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>().getInfos(
+        dialogue, mActor.getCellRef().getRefId(), mCandidates);
+    return mCandidates;
+}
+
 bool MWDialogue::Filter::testSelectStructs(const ESM::DialInfo& info) const
 {
     for (const auto& select : info.mSelects)
@@ -221,7 +248,7 @@ bool MWDialogue::Filter::testDisposition(const ESM::DialInfo& info, bool invert)
     if (isCreature)
         return true;
 
-    int actorDisposition = MWBase::Environment::get().getMechanicsManager()->getDerivedDisposition(mActor);
+    const int actorDisposition = getDisposition();
     // For service refusal, the disposition check is inverted. However, a value of 0 still means "always succeed".
     return invert ? (info.mData.mDisposition == 0 || actorDisposition < info.mData.mDisposition)
                   : (actorDisposition >= info.mData.mDisposition);
@@ -595,8 +622,7 @@ bool MWDialogue::Filter::getSelectStructBoolean(const SelectWrapper& select) con
 
         case ESM::DialogueCondition::Function_NotCell:
         {
-            std::string_view actorCell = MWBase::Environment::get().getWorld()->getCellName(mActor.getCell());
-            return !Misc::StringUtils::ciStartsWith(actorCell, select.getCellName());
+            return !Misc::StringUtils::ciStartsWith(getActorCell(), select.getCellName());
         }
         case ESM::DialogueCondition::Function_SameSex:
             if (!mActor.getClass().isNpc())
@@ -742,13 +768,13 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (const auto& info : dialogue.mInfo)
+    for (const ESM::DialInfo* info : getCandidates(dialogue))
     {
-        if (testActor(info) && testPlayer(info) && testSelectStructs(info))
+        if (testActor(*info) && testPlayer(*info) && testSelectStructs(*info))
         {
-            if (testDisposition(info, invertDisposition))
+            if (testDisposition(*info, invertDisposition))
             {
-                infos.emplace_back(&dialogue, &info);
+                infos.emplace_back(&dialogue, info);
                 if (!searchAll)
                     break;
             }
@@ -766,11 +792,11 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find(ESM::RefId::stringRefId("Info Refusal"));
 
-        for (const auto& info : infoRefusalDialogue.mInfo)
-            if (testActor(info) && testPlayer(info) && testSelectStructs(info)
-                && testDisposition(info, invertDisposition))
+        for (const ESM::DialInfo* info : getCandidates(infoRefusalDialogue))
+            if (testActor(*info) && testPlayer(*info) && testSelectStructs(*info)
+                && testDisposition(*info, invertDisposition))
             {
-                infos.emplace_back(&infoRefusalDialogue, &info);
+                infos.emplace_back(&infoRefusalDialogue, info);
                 if (!searchAll)
                     break;
             }
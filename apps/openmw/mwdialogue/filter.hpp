@@ -1,6 +1,8 @@
 #ifndef GAME_MWDIALOGUE_FILTER_H
 #define GAME_MWDIALOGUE_FILTER_H
 
+#include <optional>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,21 @@ namespace MWDialogue
         int mChoice;
         bool mTalkedToPlayer;
 
+        // The runtime state doesn't change while a filter is used, so these are computed once for all infos
+        mutable std::optional<int> mDisposition;
+        mutable std::optional<std::string_view> mPlayerCell;
+        mutable std::optional<std::string_view> mActorCell;
+        mutable std::vector<const ESM::DialInfo*> mCandidates;
+
+        int getDisposition() const;
+
+        std::string_view getPlayerCell() const;
+
+        std::string_view getActorCell() const;
+
+        const std::vector<const ESM::DialInfo*>& getCandidates(const ESM::Dialogue& dialogue) const;
+        ///< Infos of \a dialogue which don't require a different actor, in the dialogue order.
+
         bool testActor(const ESM::DialInfo& info) const;
         ///< Is this the right actor for this \a info?
 
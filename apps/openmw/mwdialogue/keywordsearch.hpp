@@ -2,8 +2,11 @@
 #define GAME_MWDIALOGUE_KEYWORDSEARCH_H
 
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <queue>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include <components/misc/strings/algorithm.hpp>
@@ -29,69 +32,103 @@ namespace MWDialogue
         {
             if (keyword.empty())
                 return;
-            buildTrie(keyword, value, 0, mRoot);
+
+            std::size_t node = 0;
+            for (char c : keyword)
+            {
+                const char ch = Misc::StringUtils::toLower(c);
+                const auto found = mNodes[node].mChildren.find(ch);
+                if (found != mNodes[node].mChildren.end())
+                {
+                    node = found->second;
+                    continue;
+                }
+                const std::size_t child = mNodes.size();
+                mNodes[node].mChildren.emplace(ch, child);
+                mNodes.emplace_back().mDepth = mNodes[node].mDepth + 1;
+                node = child;
+            }
+
+            if (mNodes[node].mKeyword != sNone)
+                throw std::runtime_error("duplicate keyword inserted");
+
+            mNodes[node].mKeyword = mValues.size();
+            mValues.push_back(value);
+            mLinksBuilt = false;
         }
 
         void clear()
         {
-            mRoot.mChildren.clear();
-            mRoot.mKeyword.clear();
+            mNodes.resize(1);
+            mNodes.front().mChildren.clear();
+            mNodes.front().mKeyword = sNone;
+            mValues.clear();
+            mLinksBuilt = false;
         }
 
         bool containsKeyword(std::string_view keyword, Value& value) const
         {
-            const Entry* current = &mRoot;
+            std::size_t node = 0;
             for (char c : keyword)
             {
-                auto it = current->mChildren.find(Misc::StringUtils::toLower(c));
-                if (it == current->mChildren.end())
+                const auto found = mNodes[node].mChildren.find(Misc::StringUtils::toLower(c));
+                if (found == mNodes[node].mChildren.end())
                     return false;
-                else if (Misc::StringUtils::ciEqual(it->second.mKeyword, keyword))
-                {
-                    value = it->second.mValue;
-                    return true;
-                }
-                current = &it->second;
+                node = found->second;
             }
-            return false;
+            if (mNodes[node].mKeyword == sNone)
+                return false;
+            value = mValues[mNodes[node].mKeyword];
+            return true;
         }
 
         void highlightKeywords(Point beg, Point end, std::vector<Match>& out) const
         {
+            buildLinks();
+
+            // A single pass over the text finds every keyword ending at each position, only keywords which start
+            // a word are kept
             std::vector<Match> matches;
+            std::size_t node = 0;
             for (Point i = beg; i != end; ++i)
             {
-                if (i != beg)
+                const char ch = Misc::StringUtils::toLower(*i);
+                while (true)
                 {
-                    Point prev = i;
-                    --prev;
-                    constexpr std::string_view wordSeparators = "\n\r \t'\"";
-                    if (wordSeparators.find(*prev) == std::string_view::npos)
-                        continue;
+                    const auto found = mNodes[node].mChildren.find(ch);
+                    if (found != mNodes[node].mChildren.end())
+                    {
+                        node = found->second;
+                        break;
+                    }
+                    if (node == 0)
+                        break;
+                    node = mNodes[node].mFailure;
                 }
 
-                const Entry* current = &mRoot;
-                for (Point it = i; it != end; ++it)
+                for (std::size_t output = mNodes[node].mKeyword != sNone ? node : mNodes[node].mOutput;
+                     output != sNone; output = mNodes[output].mOutput)
                 {
-                    auto found = current->mChildren.find(Misc::StringUtils::toLower(*it));
-                    if (found == current->mChildren.end())
-                        break;
-                    current = &found->second;
-                    if (!current->mKeyword.empty())
+                    const Point matchBeg = i + 1 - mNodes[output].mDepth;
+                    if (matchBeg != beg)
                     {
-                        std::string_view remainingText(it + 1, end);
-                        std::string_view remainingKeyword = std::string_view(current->mKeyword).substr(it + 1 - i);
-                        if (Misc::StringUtils::ciStartsWith(remainingText, remainingKeyword))
-                        {
-                            Match match;
-                            match.mValue = current->mValue;
-                            match.mBeg = i;
-                            match.mEnd = i + current->mKeyword.size();
-                            matches.push_back(match);
-                        }
+                        constexpr std::string_view wordSeparators = "\n\r \t'\"";
+                        if (wordSeparators.find(*(matchBeg - 1)) == std::string_view::npos)
+                            continue;
                     }
+
+                    Match match;
+                    match.mValue = mValues[mNodes[output].mKeyword];
+                    match.mBeg = matchBeg;
+                    match.mEnd = i + 1;
+                    matches.push_back(match);
                 }
             }
+
+            std::sort(matches.begin(), matches.end(), [](const Match& left, const Match& right) {
+                return left.mBeg < right.mBeg || (left.mBeg == right.mBeg && left.mEnd < right.mEnd);
+            });
+
             // resolve overlapping keywords
             while (!matches.empty())
             {
@@ -130,50 +167,66 @@ namespace MWDialogue
         }
 
     private:
-        struct Entry
+        static constexpr std::size_t sNone = std::numeric_limits<std::size_t>::max();
+
+        struct Node
         {
-            std::string mKeyword;
-            Value mValue;
-            std::map<char, Entry> mChildren;
+            std::map<char, std::size_t> mChildren;
+            std::size_t mDepth = 0;
+            // Index of the value of the keyword ending here
+            std::size_t mKeyword = sNone;
+            // Node of the longest proper suffix present in the trie
+            std::size_t mFailure = 0;
+            // Nearest node with a keyword along the failure links
+            std::size_t mOutput = sNone;
         };
 
-        void buildTrie(std::string_view keyword, Value value, size_t depth, Entry& entry)
+        void buildLinks() const
         {
-            const char ch = Misc::StringUtils::toLower(keyword[depth]);
-            const auto found = entry.mChildren.find(ch);
+            if (mLinksBuilt)
+                return;
 
-            if (found == entry.mChildren.end())
+            std::queue<std::size_t> queue;
+            mNodes.front().mOutput = sNone;
+            for (const auto& [ch, child] : mNodes.front().mChildren)
             {
-                entry.mChildren[ch].mValue = value;
-                entry.mChildren[ch].mKeyword = keyword;
+                mNodes[child].mFailure = 0;
+                mNodes[child].mOutput = sNone;
+                queue.push(child);
             }
-            else
+
+            while (!queue.empty())
             {
-                if (!found->second.mKeyword.empty())
+                const std::size_t node = queue.front();
+                queue.pop();
+                for (const auto& [ch, child] : mNodes[node].mChildren)
                 {
-                    std::string_view existingKeyword = found->second.mKeyword;
-                    if (Misc::StringUtils::ciEqual(keyword, existingKeyword))
-                        throw std::runtime_error("duplicate keyword inserted");
-                    if (depth >= existingKeyword.size())
-                        throw std::runtime_error("unexpected");
-                    // Turn this Entry into a branch and append a leaf to hold its current value
-                    if (depth + 1 < existingKeyword.size())
+                    std::size_t failure = mNodes[node].mFailure;
+                    while (true)
                     {
-                        buildTrie(existingKeyword, found->second.mValue, depth + 1, found->second);
-                        found->second.mKeyword.clear();
+                        const auto found = mNodes[failure].mChildren.find(ch);
+                        if (found != mNodes[failure].mChildren.end())
+                        {
+                            failure = found->second;
+                            break;
+                        }
+                        if (failure == 0)
+                            break;
+                        failure = mNodes[failure].mFailure;
                     }
+                    mNodes[child].mFailure = failure;
+                    mNodes[child].mOutput = mNodes[failure].mKeyword != sNone ? failure : mNodes[failure].mOutput;
+                    queue.push(child);
                 }
-                if (depth + 1 == keyword.size())
-                {
-                    found->second.mValue = value;
-                    found->second.mKeyword = keyword;
-                }
-                else // depth+1 < keyword.size()
-                    buildTrie(keyword, value, depth + 1, found->second);
             }
+
+            mLinksBuilt = true;
         }
 
-        Entry mRoot;
+        std::vector<Value> mValues;
+        // Links are built on the first search after seeding, so adding topics one by one stays cheap
+        mutable std::vector<Node> mNodes = std::vector<Node>(1);
+        mutable bool mLinksBuilt = false;
     };
 
 }
@@ -1,5 +1,6 @@
 #include "bookpage.hpp"
 
+#include <algorithm>
 #include <optional>
 
 #include "MyGUI_FactoryManager.h"
@@ -104,6 +105,8 @@ namespace MWGui
         Contents mContents;
         Styles mStyles;
         MyGUI::IntRect mRect;
+        // Changed when the typesetter rewinds the book, so that displays of the book lay out its text again
+        unsigned int mRevision = 0;
 
         void setColour(size_t section, size_t line, size_t run, const MyGUI::Colour& colour) const override
         {
@@ -139,16 +142,16 @@ namespace MWGui
         template <typename Visitor>
         void visitRuns(int top, int bottom, MyGUI::IFont* font, Visitor const& visitor) const
         {
-            for (Sections::const_iterator i = mSections.begin(); i != mSections.end(); ++i)
-            {
-                if (top >= mRect.bottom || bottom <= i->mRect.top)
-                    continue;
+            // Sections and their lines are laid out from top to bottom, so the first one reaching into the range is
+            // found with a binary search and drawing the visible part of a long book doesn't go over all of it
+            const auto isAbove = [top](const auto& item) { return item.mRect.bottom <= top; };
 
-                for (Lines::const_iterator j = i->mLines.begin(); j != i->mLines.end(); ++j)
+            for (Sections::const_iterator i = std::partition_point(mSections.begin(), mSections.end(), isAbove);
+                 i != mSections.end() && i->mRect.top < bottom; ++i)
+            {
+                for (Lines::const_iterator j = std::partition_point(i->mLines.begin(), i->mLines.end(), isAbove);
+                     j != i->mLines.end() && j->mRect.top < bottom; ++j)
                 {
-                    if (top >= j->mRect.bottom || bottom <= j->mRect.top)
-                        continue;
-
                     for (Runs::const_iterator k = j->mRuns.begin(); k != j->mRuns.end(); ++k)
                         if (!font || k->mStyle->mFont == font)
                             visitor(*i, *j, *k);
@@ -248,6 +251,16 @@ namespace MWGui
             }
         };
 
+        struct Checkpoint
+        {
+            size_t mSections;
+            size_t mContents;
+            size_t mStyles;
+            MyGUI::IntRect mRect;
+            Content const* mCurrentContent;
+            Alignment mCurrentAlignment;
+        };
+
         typedef TypesetBookImpl Book;
         typedef std::shared_ptr<Book> BookPtr;
         typedef std::vector<PartialText>::const_iterator PartialTextConstIterator;
@@ -267,6 +280,8 @@ namespace MWGui
         Book::Content const* mCurrentContent;
         Alignment mCurrentAlignment;
 
+        std::optional<Checkpoint> mCheckpoint;
+
         Typesetter(size_t width, size_t height)
             : mPageWidth(width)
             , mPageHeight(height)
@@ -403,6 +418,48 @@ namespace MWGui
             mCurrentAlignment = sectionAlignment;
         }
 
+        void checkpoint() override
+        {
+            add_partial_text();
+
+            mRun = nullptr;
+            mLine = nullptr;
+            mSection = nullptr;
+
+            mCheckpoint = Checkpoint{
+                .mSections = mBook->mSections.size(),
+                .mContents = mBook->mContents.size(),
+                .mStyles = mBook->mStyles.size(),
+                .mRect = mBook->mRect,
+                .mCurrentContent = mCurrentContent,
+                .mCurrentAlignment = mCurrentAlignment,
+            };
+        }
+
+        void rewind() override
+        {
+            assert(mCheckpoint.has_value());
+
+            mPartialWhitespace.clear();
+            mPartialWord.clear();
+
+            mRun = nullptr;
+            mLine = nullptr;
+            mSection = nullptr;
+
+            // Everything written before the checkpoint only refers to the contents and styles created before it
+            mBook->mSections.resize(mCheckpoint->mSections);
+            mSectionAlignment.resize(mCheckpoint->mSections);
+            mBook->mContents.resize(mCheckpoint->mContents);
+            mBook->mStyles.resize(mCheckpoint->mStyles);
+            mBook->mRect = mCheckpoint->mRect;
+            mBook->mPages.clear();
+            ++mBook->mRevision;
+
+            mCurrentContent = mCheckpoint->mCurrentContent;
+            mCurrentAlignment = mCheckpoint->mCurrentAlignment;
+        }
+
         TypesetBook::Ptr complete() override
         {
             int curPageStart = 0;
@@ -410,6 +467,8 @@ namespace MWGui
 
             add_partial_text();
 
+            mBook->mPages.clear();
+
             std::vector<Alignment>::iterator sa = mSectionAlignment.begin();
             for (Sections::iterator i = mBook->mSections.begin(); i != mBook->mSections.end(); ++i, ++sa)
             {
@@ -946,6 +1005,7 @@ namespace MWGui
         std::function<void(intptr_t)> mLinkClicked;
 
         std::shared_ptr<TypesetBookImpl> mBook;
+        unsigned int mBookRevision;
 
         MyGUI::ILayerNode* mNode;
         ActiveTextFormats mActiveTextFormats;
@@ -957,6 +1017,7 @@ namespace MWGui
             mViewBottom = 0;
             mFocusItem = nullptr;
             mItemActive = false;
+            mBookRevision = 0;
             mNode = nullptr;
         }
 
@@ -1059,7 +1120,7 @@ namespace MWGui
         {
             std::shared_ptr<TypesetBookImpl> newBook = std::dynamic_pointer_cast<TypesetBookImpl>(book);
 
-            if (mBook != newBook)
+            if (mBook != newBook || (newBook != nullptr && newBook->mRevision != mBookRevision))
             {
                 mFocusItem = nullptr;
                 mItemActive = 0;
@@ -1077,6 +1138,7 @@ namespace MWGui
                 {
                     createActiveFormats(newBook);
 
+                    mBookRevision = newBook->mRevision;
                     mBook = std::move(newBook);
                     setPage(newPage);
 
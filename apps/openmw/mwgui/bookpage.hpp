@@ -143,6 +143,15 @@ namespace MWGui
         /// using the specified style.
         virtual void write(Style* style, size_t begin, size_t end) = 0;
 
+        /// Remember the end of the document written so far. The text written
+        /// afterwards starts a new section.
+        virtual void checkpoint() = 0;
+
+        /// Discard everything written since the last checkpoint, also after
+        /// the document was completed, so that it can be extended instead of
+        /// being typeset again. The completed book is updated in place.
+        virtual void rewind() = 0;
+
         /// Finalize the document layout, and return a pointer to it.
         virtual TypesetBook::Ptr complete() = 0;
     };
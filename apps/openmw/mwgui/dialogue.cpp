@@ -584,6 +584,7 @@ namespace MWGui
             return;
         // Reset history
         mHistoryContents.clear();
+        mHistoryTypesetter.reset();
     }
 
     bool DialogueWindow::setKeywords(const std::list<std::string>& keyWords)
@@ -615,6 +616,8 @@ namespace MWGui
             mDeleteLater.push_back(std::move(linkPair.second));
         mTopicLinks.clear();
         mKeywordSearch.clear();
+        // The history links to the topics
+        mHistoryTypesetter.reset();
 
         int services = mPtr.getClass().getServices(mPtr);
 
@@ -689,10 +692,24 @@ namespace MWGui
             mScrollBar->setVisible(true);
         }
 
-        BookTypesetter::Ptr typesetter = BookTypesetter::create(mHistory->getWidth(), std::numeric_limits<int>::max());
+        if (mHistoryTypesetter == nullptr || mHistoryTypesetWidth != mHistory->getWidth())
+        {
+            mHistoryTypesetter = BookTypesetter::create(mHistory->getWidth(), std::numeric_limits<int>::max());
+            mHistoryTypesetWidth = mHistory->getWidth();
+            mHistoryTypesetCount = 0;
+        }
+        else
+        {
+            // Drop the choices written after the history last time
+            mHistoryTypesetter->rewind();
+        }
+
+        BookTypesetter::Ptr typesetter = mHistoryTypesetter;
+
+        for (; mHistoryTypesetCount < mHistoryContents.size(); ++mHistoryTypesetCount)
+            mHistoryContents[mHistoryTypesetCount]->write(typesetter, &mKeywordSearch, mTopicLinks);
 
-        for (const auto& text : mHistoryContents)
-            text->write(typesetter, &mKeywordSearch, mTopicLinks);
+        typesetter->checkpoint();
 
         BookTypesetter::Style* body = typesetter->createStyle({}, MyGUI::Colour::White, false);
 
@@ -204,6 +204,10 @@ namespace MWGui
         std::list<std::string> mKeywords;
 
         std::vector<std::unique_ptr<DialogueText>> mHistoryContents;
+        // Keeps the typeset history, so that new responses are added to it instead of typesetting all of it again
+        BookTypesetter::Ptr mHistoryTypesetter;
+        size_t mHistoryTypesetCount = 0;
+        int mHistoryTypesetWidth = 0;
         std::vector<std::pair<std::string, int>> mChoices;
         std::vector<BookTypesetter::Style*> mChoiceStyles;
         bool mGoodbye;
@@ -18,6 +18,10 @@
 
 namespace MWGui
 {
+    namespace
+    {
+        constexpr int itemSize = 42;
+    }
 
     ItemView::ItemView()
         : mScrollView(nullptr)
@@ -41,44 +45,50 @@ namespace MWGui
             throw std::runtime_error("Item view needs a scroll view");
 
         mScrollView->setCanvasAlign(MyGUI::Align::Left | MyGUI::Align::Top);
+
+        // The scroll view has no event for its scroll bars, the items in view are checked once per frame instead
+        MyGUI::Gui::getInstance().eventFrameStart += MyGUI::newDelegate(this, &ItemView::onFrame);
+    }
+
+    void ItemView::shutdownOverride()
+    {
+        MyGUI::Gui::getInstance().eventFrameStart -= MyGUI::newDelegate(this, &ItemView::onFrame);
+
+        Base::shutdownOverride();
     }
 
     void ItemView::layoutWidgets()
     {
-        if (!mScrollView->getChildCount())
+        if (mDragArea == nullptr)
             return;
 
-        int x = 0;
-        int y = 0;
-        MyGUI::Widget* dragArea = mScrollView->getChildAt(0);
         int maxHeight = mScrollView->getHeight();
 
-        mRows = std::max(maxHeight / 42, 1);
-        mItemCount = dragArea->getChildCount();
-        bool showScrollbar = static_cast<int>(std::ceil(mItemCount / float(mRows))) > mScrollView->getWidth() / 42;
+        mRows = std::max(maxHeight / itemSize, 1);
+        bool showScrollbar
+            = static_cast<int>(std::ceil(mItemCount / float(mRows))) > mScrollView->getWidth() / itemSize;
         if (showScrollbar)
         {
             maxHeight -= 18;
-            mRows = std::max(maxHeight / 42, 1);
+            mRows = std::max(maxHeight / itemSize, 1);
         }
 
-        for (int i = 0; i < mItemCount; ++i)
-        {
-            MyGUI::Widget* w = dragArea->getChildAt(i);
-
-            w->setPosition(x, y);
+        // Items fill the grid column by column
+        const int columns = std::max((mItemCount + mRows - 1) / mRows, 1);
 
-            y += 42;
+        MyGUI::IntSize size
+            = MyGUI::IntSize(std::max(mScrollView->getSize().width, columns * itemSize), mScrollView->getSize().height);
 
-            if (y > maxHeight - 42 && i < mItemCount - 1)
-            {
-                x += 42;
-                y = 0;
-            }
-        }
-        x += 42;
+        // Canvas size must be expressed with VScroll disabled, otherwise MyGUI would expand the scroll area when the
+        // scrollbar is hidden
+        mScrollView->setVisibleVScroll(false);
+        mScrollView->setVisibleHScroll(false);
+        mScrollView->setCanvasSize(size);
+        mScrollView->setVisibleVScroll(true);
+        mScrollView->setVisibleHScroll(true);
+        mDragArea->setSize(size);
 
-        MyGUI::IntSize size = MyGUI::IntSize(std::max(mScrollView->getSize().width, x), mScrollView->getSize().height);
+        updateVisibleItems(true);
 
         if (Settings::gui().mControllerMenus)
         {
@@ -88,40 +98,53 @@ namespace MWGui
                 mControllerFocus = -1;
             updateControllerFocus(-1, mControllerFocus);
         }
-
-        // Canvas size must be expressed with VScroll disabled, otherwise MyGUI would expand the scroll area when the
-        // scrollbar is hidden
-        mScrollView->setVisibleVScroll(false);
-        mScrollView->setVisibleHScroll(false);
-        mScrollView->setCanvasSize(size);
-        mScrollView->setVisibleVScroll(true);
-        mScrollView->setVisibleHScroll(true);
-        dragArea->setSize(size);
     }
 
-    void ItemView::update()
+    void ItemView::updateVisibleItems(bool force)
     {
-        while (mScrollView->getChildCount())
-            MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
+        if (mDragArea == nullptr || !mModel)
+            return;
 
-        if (!mModel)
+        // One more column on each side, so that partially visible columns are always covered
+        const int viewWidth = mScrollView->getWidth();
+        const int viewLeft = -mScrollView->getViewOffset().left;
+        const int firstColumn = std::max(viewLeft / itemSize - 1, 0);
+        const int endColumn = (viewLeft + viewWidth) / itemSize + 2;
+        const int first = std::min(firstColumn * mRows, mItemCount);
+        const int end = std::min(endColumn * mRows, mItemCount);
+
+        if (!force && first == mFirstVisibleItem && end == mEndVisibleItem)
             return;
 
-        mModel->update();
+        mFirstVisibleItem = first;
+        mEndVisibleItem = end;
 
-        MyGUI::Widget* dragArea = mScrollView->createWidget<MyGUI::Widget>(
-            {}, 0, 0, mScrollView->getWidth(), mScrollView->getHeight(), MyGUI::Align::Stretch);
-        dragArea->setNeedMouseFocus(true);
-        dragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
-        dragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        const std::size_t capacity = static_cast<std::size_t>((viewWidth / itemSize + 4) * mRows);
+        if (mWidgets.size() < capacity)
+        {
+            while (mWidgets.size() < capacity)
+            {
+                ItemWidget* itemWidget = mDragArea->createWidget<ItemWidget>(
+                    "MW_ItemIcon", MyGUI::IntCoord(0, 0, itemSize, itemSize), MyGUI::Align::Default);
+                itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+                itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
+                itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+                mWidgets.push_back(itemWidget);
+            }
+            // Items map to other widgets with a larger pool
+            mBoundItems.assign(mWidgets.size(), -1);
+        }
 
-        for (ItemModel::ModelIndex i = 0; i < static_cast<int>(mModel->getItemCount()); ++i)
+        for (int i = first; i < end; ++i)
         {
+            const std::size_t slot = static_cast<std::size_t>(i) % mWidgets.size();
+            if (!force && mBoundItems[slot] == i)
+                continue;
+
             const ItemStack& item = mModel->getItem(i);
 
-            ItemWidget* itemWidget = dragArea->createWidget<ItemWidget>(
-                "MW_ItemIcon", MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
-            itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+            ItemWidget* itemWidget = mWidgets[slot];
+            itemWidget->setPosition((i / mRows) * itemSize, (i % mRows) * itemSize);
             itemWidget->setUserData(std::make_pair(i, mModel.get()));
             ItemWidget::ItemState state = ItemWidget::None;
             if (item.mType == ItemStack::Type_Barter)
@@ -130,17 +153,69 @@ namespace MWGui
                 state = ItemWidget::Equip;
             itemWidget->setItem(item.mBase, state);
             itemWidget->setCount(item.mCount);
+            itemWidget->setControllerFocus(mControllerActiveWindow && i == mControllerFocus);
+            itemWidget->setVisible(true);
+
+            mBoundItems[slot] = i;
+        }
+
+        for (std::size_t slot = 0; slot < mWidgets.size(); ++slot)
+        {
+            if (mBoundItems[slot] >= first && mBoundItems[slot] < end)
+                continue;
+            mWidgets[slot]->setVisible(false);
+            mBoundItems[slot] = -1;
+        }
+    }
+
+    ItemWidget* ItemView::getItemWidget(int index)
+    {
+        if (index < mFirstVisibleItem || index >= mEndVisibleItem || mWidgets.empty())
+            return nullptr;
+        return mWidgets[static_cast<std::size_t>(index) % mWidgets.size()];
+    }
+
+    void ItemView::onFrame(float /*dt*/)
+    {
+        if (mDragArea != nullptr && getInheritedVisible())
+            updateVisibleItems(false);
+    }
 
-            itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
-            itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+    void ItemView::update()
+    {
+        if (!mModel)
+        {
+            while (mScrollView->getChildCount())
+                MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
+            mDragArea = nullptr;
+            mWidgets.clear();
+            mBoundItems.clear();
+            mFirstVisibleItem = 0;
+            mEndVisibleItem = 0;
+            mItemCount = 0;
+            return;
+        }
+
+        mModel->update();
+
+        if (mDragArea == nullptr)
+        {
+            mDragArea = mScrollView->createWidget<MyGUI::Widget>(
+                {}, 0, 0, mScrollView->getWidth(), mScrollView->getHeight(), MyGUI::Align::Stretch);
+            mDragArea->setNeedMouseFocus(true);
+            mDragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
+            mDragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
         }
 
+        mItemCount = static_cast<int>(mModel->getItemCount());
+
         layoutWidgets();
     }
 
     void ItemView::resetScrollBars()
     {
         mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
+        updateVisibleItems(false);
         if (Settings::gui().mControllerMenus)
         {
             updateControllerFocus(mControllerFocus, 0);
@@ -166,6 +241,7 @@ namespace MWGui
         else
             mScrollView->setViewOffset(
                 MyGUI::IntPoint(static_cast<int>(mScrollView->getViewOffset().left + rel * 0.3f), 0));
+        updateVisibleItems(false);
     }
 
     void ItemView::setSize(const MyGUI::IntSize& value)
@@ -215,10 +291,7 @@ namespace MWGui
             case SDL_CONTROLLER_BUTTON_A:
                 // Select the focused item, if any.
                 if (mControllerFocus >= 0 && mControllerFocus < mItemCount)
-                {
-                    MyGUI::Widget* dragArea = mScrollView->getChildAt(0);
-                    onSelectedItem(dragArea->getChildAt(mControllerFocus));
-                }
+                    eventItemClicked(mControllerFocus);
                 break;
             case SDL_CONTROLLER_BUTTON_RIGHTSTICK:
                 // Toggle info tooltip
@@ -269,29 +342,28 @@ namespace MWGui
         if (!mItemCount)
             return;
 
-        MyGUI::Widget* dragArea = mScrollView->getChildAt(0);
-
         if (prevFocus >= 0 && prevFocus < mItemCount)
         {
-            ItemWidget* prev = static_cast<ItemWidget*>(dragArea->getChildAt(prevFocus));
+            ItemWidget* prev = getItemWidget(prevFocus);
             if (prev)
                 prev->setControllerFocus(false);
         }
 
         if (mControllerActiveWindow && newFocus >= 0 && newFocus < mItemCount)
         {
-            ItemWidget* focused = static_cast<ItemWidget*>(dragArea->getChildAt(newFocus));
+            // Scroll the list to keep the active item in view, before its widget is looked up
+            int column = newFocus / mRows;
+            if (column <= 3)
+                mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
+            else
+                mScrollView->setViewOffset(MyGUI::IntPoint(-itemSize * (column - 3), 0));
+            updateVisibleItems(false);
+
+            ItemWidget* focused = getItemWidget(newFocus);
             if (focused)
             {
                 focused->setControllerFocus(true);
 
-                // Scroll the list to keep the active item in view
-                int column = newFocus / mRows;
-                if (column <= 3)
-                    mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
-                else
-                    mScrollView->setViewOffset(MyGUI::IntPoint(-42 * (column - 3), 0));
-
                 MWBase::WindowManager* winMgr = MWBase::Environment::get().getWindowManager();
                 winMgr->restoreControllerTooltips();
 
@@ -3,11 +3,16 @@
 
 #include <MyGUI_Widget.h>
 
+#include <vector>
+
 #include "itemmodel.hpp"
 
 namespace MWGui
 {
+    class ItemWidget;
 
+    /// Grid of the items of a model, only the items in view and the columns next to them have a widget. Widgets are
+    /// reused for other items when scrolling, so large inventories open as fast as small ones.
     class ItemView final : public MyGUI::Widget
     {
         MYGUI_RTTI_DERIVED(ItemView)
@@ -40,9 +45,18 @@ namespace MWGui
 
     private:
         void initialiseOverride() override;
+        void shutdownOverride() override;
 
         void layoutWidgets();
 
+        /// Bind the widgets to the items in view, rebinding all of them if \a force is set
+        void updateVisibleItems(bool force);
+
+        /// @return Widget showing the item, nullptr if the item is out of view
+        ItemWidget* getItemWidget(int index);
+
+        void onFrame(float dt);
+
         void setSize(const MyGUI::IntSize& value) override;
         void setCoord(const MyGUI::IntCoord& value) override;
 
@@ -52,6 +66,13 @@ namespace MWGui
 
         std::unique_ptr<ItemModel> mModel;
         MyGUI::ScrollView* mScrollView;
+        MyGUI::Widget* mDragArea = nullptr;
+
+        // Item i is shown by the widget i % mWidgets.size(), so the items staying in view keep their widget
+        std::vector<ItemWidget*> mWidgets;
+        std::vector<int> mBoundItems;
+        int mFirstVisibleItem = 0;
+        int mEndVisibleItem = 0;
 
         int mItemCount = 0;
         int mRows = 1;
@@ -16,6 +16,7 @@
 #include <components/misc/rng.hpp>
 #include <components/myguiplatform/myguitexture.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/incrementalcompileoperation.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/recursivedirectoryiterator.hpp>
@@ -157,6 +158,8 @@ namespace MWGui
         {
             mOldIcoMin = ico->getMinimumTimeAvailableForGLCompileAndDeletePerFrame();
             mOldIcoMax = ico->getMaximumNumOfObjectsToCompilePerFrame();
+            if (const auto* budgeted = dynamic_cast<const SceneUtil::IncrementalCompileOperation*>(ico))
+                mOldIcoMaxBytes = budgeted->getMaxBytesPerFrame();
         }
 
         setVisible(true);
@@ -198,6 +201,8 @@ namespace MWGui
         {
             ico->setMinimumTimeAvailableForGLCompileAndDeletePerFrame(mOldIcoMin);
             ico->setMaximumNumOfObjectsToCompilePerFrame(mOldIcoMax);
+            if (auto* budgeted = dynamic_cast<SceneUtil::IncrementalCompileOperation*>(ico))
+                budgeted->setMaxBytesPerFrame(mOldIcoMaxBytes);
         }
 
         MWBase::Environment::get().getWindowManager()->removeGuiMode(GM_Loading);
@@ -341,6 +346,8 @@ namespace MWGui
         {
             ico->setMinimumTimeAvailableForGLCompileAndDeletePerFrame(1.f / getTargetFrameRate());
             ico->setMaximumNumOfObjectsToCompilePerFrame(1000);
+            if (auto* budgeted = dynamic_cast<SceneUtil::IncrementalCompileOperation*>(ico))
+                budgeted->setMaxBytesPerFrame(0);
         }
 
         // at the time this function is called we are in the middle of a frame,
@@ -1,6 +1,7 @@
 #ifndef MWGUI_LOADINGSCREEN_H
 #define MWGUI_LOADINGSCREEN_H
 
+#include <cstddef>
 #include <memory>
 
 #include <osg/Timer>
@@ -73,6 +74,7 @@ namespace MWGui
         bool mShowWallpaper;
         float mOldIcoMin = 0.f;
         unsigned int mOldIcoMax = 0;
+        std::size_t mOldIcoMaxBytes = 0;
 
         MyGUI::Widget* mLoadingBox;
 
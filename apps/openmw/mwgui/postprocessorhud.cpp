@@ -17,6 +17,10 @@
 #include <MyGUI_WidgetInput.h>
 #include <MyGUI_Window.h>
 
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
 #include <components/files/configurationmanager.hpp>
 #include <components/fx/technique.hpp>
 #include <components/fx/widgets.hpp>
@@ -90,6 +94,10 @@ namespace MWGui
         mShaderInfo->setEditMultiLine(true);
         mShaderInfo->setNeedMouseFocus(false);
 
+        mGpuTime = mConfigLayout->createWidget<Gui::AutoSizedTextBox>("NormalText", {}, MyGUI::Align::Default);
+        mGpuTime->setTextAlign(MyGUI::Align::Left | MyGUI::Align::Top);
+        mGpuTime->setNeedMouseFocus(false);
+
         mConfigLayout->setVisibleVScroll(true);
 
         mConfigArea = mConfigLayout->createWidget<MyGUI::Widget>({}, {}, MyGUI::Align::Default);
@@ -241,6 +249,7 @@ namespace MWGui
     {
         toggleMode(Settings::ShaderManager::Mode::Debug);
         updateTechniques();
+        MWBase::Environment::get().getWorld()->getPostProcessor()->setTechniqueTimingEnabled(true);
     }
 
     void PostProcessorHud::onClose()
@@ -248,6 +257,55 @@ namespace MWGui
         Settings::ShaderManager::get().save();
         Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
         toggleMode(Settings::ShaderManager::Mode::Normal);
+        MWBase::Environment::get().getWorld()->getPostProcessor()->setTechniqueTimingEnabled(false);
+    }
+
+    void PostProcessorHud::onFrame(float duration)
+    {
+        if (!isVisible())
+            return;
+
+        // Often enough to follow changes, rarely enough to be readable
+        constexpr float updateInterval = 0.5f;
+
+        mGpuTimeUpdate += duration;
+        if (mGpuTimeUpdate < updateInterval)
+            return;
+        mGpuTimeUpdate = 0.f;
+
+        updateGpuTime();
+    }
+
+    void PostProcessorHud::updateGpuTime()
+    {
+        auto* processor = MWBase::Environment::get().getWorld()->getPostProcessor();
+
+        std::optional<double> selected;
+        double total = 0;
+        for (const auto& technique : processor->getTechniques())
+        {
+            const std::string name = technique->getName();
+            const std::optional<double> time = processor->getTechniqueGpuTime(name);
+            if (!time)
+                continue;
+            total += *time;
+            if (name == mSelectedTechnique)
+                selected = time;
+        }
+
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        if (selected)
+            ss << "#{fontcolourhtml=header}#{OMWShaders:GpuTime}: #{fontcolourhtml=normal} " << *selected
+               << " ms   ";
+        if (total > 0)
+            ss << "#{fontcolourhtml=header}#{OMWShaders:GpuTimeTotal}: #{fontcolourhtml=normal} " << total << " ms";
+
+        const std::string caption = ss.str();
+        const bool wasEmpty = mGpuTime->getCaption().empty();
+        mGpuTime->setCaptionWithReplacing(caption);
+        if (wasEmpty != caption.empty())
+            layout();
     }
 
     void PostProcessorHud::layout()
@@ -259,6 +317,13 @@ namespace MWGui
 
         int totalHeight = mShaderInfo->getTop() + mShaderInfo->getTextSize().height + padding;
 
+        mGpuTime->setVisible(!mGpuTime->getCaption().empty());
+        if (mGpuTime->getVisible())
+        {
+            mGpuTime->setCoord(padding, totalHeight, mShaderInfo->getSize().width, mGpuTime->getTextSize().height);
+            totalHeight += mGpuTime->getHeight() + padding;
+        }
+
         mConfigArea->setCoord({ padding, totalHeight, mShaderInfo->getSize().width, mConfigLayout->getHeight() });
 
         int childHeights = 0;
@@ -316,6 +381,8 @@ namespace MWGui
         if (technique->getStatus() == Fx::Technique::Status::File_Not_exists)
             return;
 
+        mSelectedTechnique = technique->getName();
+
         while (mConfigArea->getChildCount() > 0)
             MyGUI::Gui::getInstance().destroyWidget(mConfigArea->getChildAt(0));
 
@@ -375,6 +442,8 @@ namespace MWGui
 
         mShaderInfo->setCaptionWithReplacing(ss.str());
 
+        updateGpuTime();
+
         if (Settings::ShaderManager::get().getMode() == Settings::ShaderManager::Mode::Debug)
         {
             if (technique->getUniformMap().size() > 0)
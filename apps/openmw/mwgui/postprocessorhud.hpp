@@ -19,6 +19,7 @@ namespace Gui
 {
     class AutoSizedButton;
     class AutoSizedEditBox;
+    class AutoSizedTextBox;
 }
 
 namespace MWGui
@@ -39,6 +40,8 @@ namespace MWGui
 
         void onClose() override;
 
+        void onFrame(float duration) override;
+
         void updateTechniques();
 
         void toggleMode(Settings::ShaderManager::Mode mode);
@@ -82,6 +85,8 @@ namespace MWGui
 
         void layout();
 
+        void updateGpuTime();
+
         ListWrapper* mActiveList;
         ListWrapper* mInactiveList;
 
@@ -96,6 +101,10 @@ namespace MWGui
 
         MyGUI::EditBox* mFilter;
         Gui::AutoSizedEditBox* mShaderInfo;
+        Gui::AutoSizedTextBox* mGpuTime;
+
+        std::string mSelectedTechnique;
+        float mGpuTimeUpdate = 0.f;
 
         std::string mOverrideHint;
 
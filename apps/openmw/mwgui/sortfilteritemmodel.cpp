@@ -27,6 +27,10 @@
 #include "../mwmechanics/alchemy.hpp"
 #include "../mwmechanics/spellutil.hpp"
 
+#include <optional>
+#include <string>
+#include <vector>
+
 namespace
 {
     unsigned int getTypeOrder(unsigned int type)
@@ -62,9 +66,58 @@ namespace
         return std::numeric_limits<unsigned int>::max();
     }
 
-    bool compareType(unsigned int type1, unsigned int type2)
+    int getChargePercent(const MWWorld::Ptr& item)
+    {
+        // 1. enchanted items showed before non-enchanted
+        // 2. item with lesser charge percent comes after items with more charge percent
+        // 3. item with constant effect comes before items with non-constant effects
+        const ESM::RefId& enchantment = item.getClass().getEnchantment(item);
+        if (enchantment.empty())
+            return -1;
+
+        const ESM::Enchantment* ench
+            = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(enchantment);
+        if (!ench)
+            return -1;
+        if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
+            return 101;
+        return static_cast<int>(item.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
+    }
+
+    // Everything the order of an item depends on. Computed once per item and update rather than twice per
+    // comparison, since looking up names and enchantments dominates sorting large inventories.
+    struct SortKey
+    {
+        MWGui::ItemStack::Type mType;
+        unsigned int mRecordType;
+        unsigned int mTypeOrder;
+        std::string mName;
+        int mChargePercent;
+        std::optional<int> mHealth;
+        float mRemainingUsageTime;
+        int mValue;
+        float mWeight;
+        ESM::RefId mRefId;
+        std::size_t mIndex;
+    };
+
+    SortKey makeSortKey(const MWGui::ItemStack& item, std::size_t index)
     {
-        return getTypeOrder(type1) < getTypeOrder(type2);
+        const MWWorld::Ptr& base = item.mBase;
+        const MWWorld::Class& cls = base.getClass();
+        return SortKey{
+            .mType = item.mType,
+            .mRecordType = base.getType(),
+            .mTypeOrder = getTypeOrder(base.getType()),
+            .mName = Utf8Stream::lowerCaseUtf8(cls.getName(base)),
+            .mChargePercent = getChargePercent(base),
+            .mHealth = cls.hasItemHealth(base) ? std::optional<int>(cls.getItemHealth(base)) : std::nullopt,
+            .mRemainingUsageTime = cls.getRemainingUsageTime(base),
+            .mValue = cls.getValue(base),
+            .mWeight = cls.getWeight(base),
+            .mRefId = base.getCellRef().getRefId(),
+            .mIndex = index,
+        };
     }
 
     struct Compare
@@ -74,95 +127,41 @@ namespace
             : mSortByType(true)
         {
         }
-        bool operator()(const MWGui::ItemStack& left, const MWGui::ItemStack& right)
+        bool operator()(const SortKey& left, const SortKey& right) const
         {
             if (mSortByType && left.mType != right.mType)
                 return left.mType < right.mType;
 
-            float result = 0;
-
             // compare items by type
-            auto leftType = left.mBase.getType();
-            auto rightType = right.mBase.getType();
-
-            if (leftType != rightType)
-                return compareType(leftType, rightType);
+            if (left.mRecordType != right.mRecordType)
+                return left.mTypeOrder < right.mTypeOrder;
 
             // compare items by name
-            std::string leftName = Utf8Stream::lowerCaseUtf8(left.mBase.getClass().getName(left.mBase));
-            std::string rightName = Utf8Stream::lowerCaseUtf8(right.mBase.getClass().getName(right.mBase));
-
-            result = leftName.compare(rightName);
-            if (result != 0)
-                return result < 0;
-
-            // compare items by enchantment:
-            // 1. enchanted items showed before non-enchanted
-            // 2. item with lesser charge percent comes after items with more charge percent
-            // 3. item with constant effect comes before items with non-constant effects
-            int leftChargePercent = -1;
-            int rightChargePercent = -1;
-            const ESM::RefId& leftNameEnch = left.mBase.getClass().getEnchantment(left.mBase);
-            const ESM::RefId& rightNameEnch = right.mBase.getClass().getEnchantment(right.mBase);
-
-            if (!leftNameEnch.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(leftNameEnch);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        leftChargePercent = 101;
-                    else
-                        leftChargePercent
-                            = static_cast<int>(left.mBase.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
-                }
-            }
-
-            if (!rightNameEnch.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(rightNameEnch);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        rightChargePercent = 101;
-                    else
-                        rightChargePercent
-                            = static_cast<int>(right.mBase.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
-                }
-            }
+            const int nameOrder = left.mName.compare(right.mName);
+            if (nameOrder != 0)
+                return nameOrder < 0;
 
-            result = leftChargePercent - rightChargePercent;
-            if (result != 0)
-                return result > 0;
+            // compare items by enchantment
+            if (left.mChargePercent != right.mChargePercent)
+                return left.mChargePercent > right.mChargePercent;
 
             // compare items by condition
-            if (left.mBase.getClass().hasItemHealth(left.mBase) && right.mBase.getClass().hasItemHealth(right.mBase))
-            {
-                result = left.mBase.getClass().getItemHealth(left.mBase)
-                    - right.mBase.getClass().getItemHealth(right.mBase);
-                if (result != 0)
-                    return result > 0;
-            }
+            if (left.mHealth && right.mHealth && *left.mHealth != *right.mHealth)
+                return *left.mHealth > *right.mHealth;
 
             // compare items by remaining usage time
-            result = left.mBase.getClass().getRemainingUsageTime(left.mBase)
-                - right.mBase.getClass().getRemainingUsageTime(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mRemainingUsageTime != right.mRemainingUsageTime)
+                return left.mRemainingUsageTime > right.mRemainingUsageTime;
 
             // compare items by value
-            result = left.mBase.getClass().getValue(left.mBase) - right.mBase.getClass().getValue(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mValue != right.mValue)
+                return left.mValue > right.mValue;
 
             // compare items by weight
-            result = left.mBase.getClass().getWeight(left.mBase) - right.mBase.getClass().getWeight(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mWeight != right.mWeight)
+                return left.mWeight > right.mWeight;
 
-            return left.mBase.getCellRef().getRefId() < right.mBase.getCellRef().getRefId();
+            return left.mRefId < right.mRefId;
         }
     };
 }
@@ -374,7 +373,8 @@ namespace MWGui
 
         size_t count = mSourceModel->getItemCount();
 
-        mItems.clear();
+        std::vector<ItemStack> items;
+        items.reserve(count);
         for (size_t i = 0; i < count; ++i)
         {
             ItemStack item = mSourceModel->getItem(i);
@@ -391,12 +391,22 @@ namespace MWGui
             }
 
             if (item.mCount > 0 && filterAccepts(item))
-                mItems.push_back(item);
+                items.push_back(std::move(item));
         }
 
+        std::vector<SortKey> keys;
+        keys.reserve(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+            keys.push_back(makeSortKey(items[i], i));
+
         Compare cmp;
         cmp.mSortByType = mSortByType;
-        std::sort(mItems.begin(), mItems.end(), cmp);
+        std::sort(keys.begin(), keys.end(), cmp);
+
+        mItems.clear();
+        mItems.reserve(keys.size());
+        for (const SortKey& key : keys)
+            mItems.push_back(std::move(items[key.mIndex]));
     }
 
     void SortFilterItemModel::onClose()
@@ -34,6 +34,8 @@
 
 #include <components/sceneutil/workqueue.hpp>
 
+#include <components/files/configurationmanager.hpp>
+
 #include <components/translation/translation.hpp>
 
 #include <components/myguiplatform/additivelayer.hpp>
@@ -327,7 +329,8 @@ namespace MWGui
         mGuiModeStates[GM_MainMenu] = GuiModeState(menu.get());
         mWindows.push_back(std::move(menu));
 
-        mLocalMapRender = std::make_unique<MWRender::LocalMap>(mViewer->getSceneData()->asGroup());
+        mLocalMapRender = std::make_unique<MWRender::LocalMap>(mViewer->getSceneData()->asGroup(), mWorkQueue,
+            Settings::map().mCacheLocalMaps ? mCfgMgr.getCachePath() / "localmap" : std::filesystem::path());
         auto map = std::make_unique<MapWindow>(mCustomMarkers, mDragAndDrop.get(), mLocalMapRender.get(), mWorkQueue);
         mMap = map.get();
         mWindows.push_back(std::move(map));
@@ -1627,6 +1630,11 @@ namespace MWGui
         mConsole->executeFile(path);
     }
 
+    void WindowManager::executeCommandInConsole(const std::string& command)
+    {
+        mConsole->execute(command);
+    }
+
     std::vector<MWGui::WindowBase*> WindowManager::getGuiModeWindows(GuiMode mode)
     {
         return mGuiModeStates[mode].mWindows;
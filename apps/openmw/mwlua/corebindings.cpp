@@ -146,7 +146,7 @@ namespace MWLua
         {
             api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData) {
                 context.mLuaEvents->addGlobalEvent(
-                    { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    { std::move(eventName), LuaUtil::serializeShared(eventData, context.mSerializer) });
             };
             api["sound"]
                 = context.cachePackage("openmw_core_sound", [context]() { return initCoreSoundBindings(context); });
@@ -159,7 +159,7 @@ namespace MWLua
                     throw std::logic_error("Can't send global events when no game is loaded");
                 }
                 context.mLuaEvents->addGlobalEvent(
-                    { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    { std::move(eventName), LuaUtil::serializeShared(eventData, context.mSerializer) });
             };
         }
 
@@ -94,6 +94,19 @@ namespace MWLua
             });
         };
 
+        api["getMemoryUsage"] = [](sol::this_state lua) {
+            sol::table result(lua, sol::create);
+            for (const auto& [name, usage] :
+                MWBase::Environment::get().getResourceSystem()->getMemoryRegistry().getSubsystems())
+            {
+                sol::table subsystem(lua, sol::create);
+                subsystem["cpu"] = usage.mCpu;
+                subsystem["gpu"] = usage.mGpu;
+                result[name] = subsystem;
+            }
+            return result;
+        };
+
         return LuaUtil::makeReadOnly(api);
     }
 }
@@ -38,14 +38,14 @@ namespace MWLua
     void LuaEvents::callEventHandlers()
     {
         for (const Global& e : mGlobalEventBatch)
-            mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
+            mGlobalScripts.receiveEvent(e.mEventName, LuaUtil::toStringView(e.mEventData));
         mGlobalEventBatch.clear();
         for (const Local& e : mLocalEventBatch)
         {
             MWWorld::Ptr ptr = MWBase::Environment::get().getWorldModel()->getPtr(e.mDest);
             LocalScripts* scripts = ptr.isEmpty() ? nullptr : ptr.getRefData().getLuaScripts();
             if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
+                scripts->receiveEvent(e.mEventName, LuaUtil::toStringView(e.mEventData));
             else
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << e.mDest.toString()
                                   << ". Object not found or has no attached scripts";
@@ -56,7 +56,7 @@ namespace MWLua
     void LuaEvents::callMenuEventHandlers()
     {
         for (const Global& e : mMenuEvents)
-            mMenuScripts.receiveEvent(e.mEventName, e.mEventData);
+            mMenuScripts.receiveEvent(e.mEventName, LuaUtil::toStringView(e.mEventData));
         mMenuEvents.clear();
     }
 
@@ -65,8 +65,8 @@ namespace MWLua
     {
         esm.writeHNString("LUAE", event.mEventName);
         esm.writeFormId(dest, true);
-        if (!event.mEventData.empty())
-            saveLuaBinaryData(esm, event.mEventData);
+        if (event.mEventData != nullptr && !event.mEventData->empty())
+            saveLuaBinaryData(esm, *event.mEventData);
     }
 
     void LuaEvents::load(lua_State* lua, ESM::ESMReader& esm, const std::map<int, int>& contentFileMapping,
@@ -77,14 +77,16 @@ namespace MWLua
         {
             std::string name = esm.getHString();
             ESM::RefNum dest = esm.getFormId(true);
-            std::string data = loadLuaBinaryData(esm);
+            std::string binary = loadLuaBinaryData(esm);
+            LuaUtil::SharedBinaryData data;
             try
             {
-                data = LuaUtil::serialize(LuaUtil::deserialize(lua, data, serializer), serializer);
+                data = LuaUtil::serializeShared(LuaUtil::deserialize(lua, binary, serializer), serializer);
             }
             catch (std::exception& e)
             {
                 Log(Debug::Error) << "loadEvent: invalid event data: " << e.what();
+                data = std::make_shared<const LuaUtil::BinaryData>(std::move(binary));
             }
             if (dest.isSet())
             {
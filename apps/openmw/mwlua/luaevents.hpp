@@ -5,6 +5,7 @@
 #include <string>
 
 #include <components/esm3/cellref.hpp> // defines RefNum that is used as a unique id
+#include <components/lua/serialization.hpp>
 
 struct lua_State;
 
@@ -14,11 +15,6 @@ namespace ESM
     class ESMWriter;
 }
 
-namespace LuaUtil
-{
-    class UserdataSerializer;
-}
-
 namespace MWLua
 {
 
@@ -37,13 +33,14 @@ namespace MWLua
         struct Global
         {
             std::string mEventName;
-            std::string mEventData;
+            LuaUtil::SharedBinaryData mEventData;
         };
         struct Local
         {
             ESM::RefNum mDest;
             std::string mEventName;
-            std::string mEventData;
+            // Shared by all events of a broadcast
+            LuaUtil::SharedBinaryData mEventData;
         };
 
         void addGlobalEvent(Global event) { mNewGlobalEventBatch.push_back(std::move(event)); }
@@ -1,6 +1,7 @@
 #include "luamanagerimp.hpp"
 
 #include <filesystem>
+#include <fstream>
 
 #include <MyGUI_InputManager.h>
 #include <osg/Stats>
@@ -15,6 +16,8 @@
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 
+#include <components/files/conversion.hpp>
+
 #include <components/settings/values.hpp>
 
 #include <components/l10n/manager.hpp>
@@ -67,8 +70,10 @@ namespace MWLua
             .mLogMemoryUsage = Settings::lua().mLogMemoryUsage };
     }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
-        : mLua(vfs, &mConfiguration, createLuaStateSettings())
+    LuaManager::LuaManager(
+        const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& userDataPath)
+        : mUserDataPath(userDataPath)
+        , mLua(vfs, &mConfiguration, createLuaStateSettings())
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
@@ -160,20 +165,18 @@ namespace MWLua
 
     void LuaManager::savePermanentStorage(const std::filesystem::path& userConfigPath)
     {
-        mLua.protectedCall([&](LuaUtil::LuaView& view) {
-            if (mGlobalScriptsStarted)
-                mGlobalStorage.save(view.sol(), userConfigPath / "global_storage.bin");
-            mPlayerStorage.save(view.sol(), userConfigPath / "player_storage.bin");
-        });
+        if (mGlobalScriptsStarted)
+            mGlobalStorage.save(userConfigPath / "global_storage.bin");
+        mPlayerStorage.save(userConfigPath / "player_storage.bin");
     }
 
     void LuaManager::sendLocalEvent(
         const MWWorld::Ptr& target, const std::string& name, const std::optional<sol::table>& data)
     {
-        LuaUtil::BinaryData binary = {};
+        LuaUtil::SharedBinaryData binary;
         if (data)
         {
-            binary = LuaUtil::serialize(*data, mLocalSerializer.get());
+            binary = LuaUtil::serializeShared(*data, mLocalSerializer.get());
         }
         mLuaEvents.addLocalEvent({ getId(target), name, std::move(binary) });
     }
@@ -886,10 +889,7 @@ namespace MWLua
 
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
 
-        std::vector<Stats> activeStats;
-        mGlobalScripts.collectStats(activeStats);
-        for (LocalScripts* scripts : mActiveLocalScripts)
-            scripts->collectStats(activeStats);
+        const std::vector<Stats> activeStats = collectActiveStats();
 
         std::vector<Stats> selectedStats;
         MWWorld::Ptr selectedPtr = MWBase::Environment::get().getWindowManager()->getConsoleSelectedObject();
@@ -912,6 +912,9 @@ namespace MWLua
         out << "  [active]:   Sum over all active (i.e. currently in scene) instances of each script;\n";
         out << "  [inactive]: Sum over all inactive instances of each script;\n";
         out << "  [for selected object]: Only for the object that is selected in the console;\n";
+        out << "  time:       Averaged time per frame spent in handlers of active instances, microseconds;\n";
+        out << "  worst:      The longest time spent in handlers of one instance in a frame, microseconds;\n";
+        out << "Use the 'luaprofile' console command to write these statistics to a CSV file.\n";
         out << "\n";
 
         out << std::left;
@@ -960,6 +963,82 @@ namespace MWLua
             out << "\n";
         }
 
+        out << "\n";
+        out << std::left << " " << std::setw(nameW) << "*** Time per script and handler" << std::right;
+        out << std::setw(valueW) << "time";
+        out << std::setw(valueW) << "worst";
+        out << "\n";
+
+        for (size_t i = 0; i < mConfiguration.size(); ++i)
+        {
+            const Stats& stats = activeStats[i];
+            if (stats.mHandlers.empty())
+                continue;
+
+            out << std::left;
+            out << " " << std::setw(nameW) << mConfiguration[i].mScriptPath.value();
+            if (mConfiguration[i].mScriptPath.value().size() > nameW)
+                out << "\n " << std::setw(nameW) << ""; // if path is too long, break line
+            out << std::right;
+            out << std::setw(valueW) << static_cast<int64_t>(stats.mAvgTime);
+            out << std::setw(valueW) << static_cast<int64_t>(stats.mMaxFrameTime);
+            out << "\n";
+
+            for (const auto& [name, handler] : stats.mHandlers)
+            {
+                out << std::left << "   " << std::setw(nameW - 2) << name << std::right;
+                out << std::setw(valueW) << static_cast<int64_t>(handler.mAvgTime);
+                out << std::setw(valueW) << static_cast<int64_t>(handler.mMaxTime);
+                out << "\n";
+            }
+        }
+
         return out.str();
     }
+
+    std::vector<LuaUtil::ScriptsContainer::ScriptStats> LuaManager::collectActiveStats() const
+    {
+        std::vector<LuaUtil::ScriptsContainer::ScriptStats> result;
+        mGlobalScripts.collectStats(result);
+        for (LocalScripts* scripts : mActiveLocalScripts)
+            scripts->collectStats(result);
+        return result;
+    }
+
+    std::filesystem::path LuaManager::exportProfile() const
+    {
+        const auto quoted = [](std::string_view value) {
+            std::string result = "\"";
+            for (const char c : value)
+            {
+                if (c == '"')
+                    result += '"';
+                result += c;
+            }
+            result += '"';
+            return result;
+        };
+
+        const std::vector<LuaUtil::ScriptsContainer::ScriptStats> activeStats = collectActiveStats();
+        const std::filesystem::path path = mUserDataPath / "lua_profile.csv";
+        std::ofstream stream(path);
+        if (!stream.is_open())
+            throw std::runtime_error("Failed to open " + Files::pathToUnicodeString(path));
+
+        stream << "script,handler,time_us,worst_frame_time_us,instructions,memory_bytes\n";
+        for (size_t i = 0; i < mConfiguration.size(); ++i)
+        {
+            const LuaUtil::ScriptsContainer::ScriptStats& stats = activeStats[i];
+            const std::string script = quoted(mConfiguration[i].mScriptPath.value());
+            stream << script << ",," << stats.mAvgTime << ',' << stats.mMaxFrameTime << ','
+                   << stats.mAvgInstructionCount << ',' << stats.mMemoryUsage << '\n';
+            for (const auto& [name, handler] : stats.mHandlers)
+                stream << script << ',' << quoted(name) << ',' << handler.mAvgTime << ',' << handler.mMaxTime << ",,\n";
+        }
+
+        stream.close();
+        if (!stream)
+            throw std::runtime_error("Failed to write " + Files::pathToUnicodeString(path));
+        return path;
+    }
 }
@@ -35,7 +35,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir);
+        LuaManager(
+            const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& userDataPath);
         LuaManager(const LuaManager&) = delete;
         LuaManager(LuaManager&&) = delete;
         ~LuaManager();
@@ -46,6 +47,9 @@ namespace MWLua
         void loadPermanentStorage(const std::filesystem::path& userConfigPath);
         void savePermanentStorage(const std::filesystem::path& userConfigPath) override;
 
+        void readScriptCache(const std::filesystem::path& path) { mLua.readScriptCache(path); }
+        void writeScriptCache() const { mLua.writeScriptCache(); }
+
         // \brief Executes lua handlers. Defaults to running in parallel with OSG Cull.
         //
         // The OSG Cull is expensive enough that we have "free" time to
@@ -166,7 +170,9 @@ namespace MWLua
         bool isProcessingInputEvents() const { return mProcessingInputEvents; }
 
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+        std::uint64_t getMemoryUsage() const { return mLua.getTotalMemoryUsage(); }
         std::string formatResourceUsageStats() const override;
+        std::filesystem::path exportProfile() const override;
 
         LuaUtil::InputAction::Registry& inputActions() { return mInputActions; }
         LuaUtil::InputTrigger::Registry& inputTriggers() { return mInputTriggers; }
@@ -182,6 +188,7 @@ namespace MWLua
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
         void reloadAllScriptsImpl();
         void synchronizedUpdateUnsafe();
+        std::vector<LuaUtil::ScriptsContainer::ScriptStats> collectActiveStats() const;
 
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
@@ -190,6 +197,7 @@ namespace MWLua
         bool mNewGameStarted = false;
         bool mReloadAllScriptsRequested = false;
         bool mRunningSynchronizedUpdates = false;
+        std::filesystem::path mUserDataPath;
         LuaUtil::ScriptsConfiguration mConfiguration;
         LuaUtil::LuaState mLua;
         LuaUi::ResourceManager mUiResourceManager;
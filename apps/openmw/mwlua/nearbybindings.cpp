@@ -134,6 +134,41 @@ namespace MWLua
                 return rayCasting->castSphere(from, to, radius, collisionType);
             }
         };
+        api["castRays"] = [](const sol::table& rays, sol::optional<sol::table> options, sol::this_state lua) {
+            std::vector<MWWorld::ConstPtr> ignore;
+            int collisionType = MWPhysics::CollisionType_Default;
+            float radius = 0;
+            if (options)
+            {
+                ignore = parseIgnoreList<MWWorld::ConstPtr>(*options);
+                collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
+                radius = options->get<sol::optional<float>>("radius").value_or(0);
+            }
+            std::vector<MWPhysics::RayCastingRequest> requests;
+            requests.reserve(rays.size());
+            for (std::size_t i = 1; i <= rays.size(); ++i)
+            {
+                const sol::table ray = rays[i];
+                requests.push_back({ ray.get<osg::Vec3f>("from"), ray.get<osg::Vec3f>("to") });
+            }
+            std::vector<MWPhysics::RayCastingResult> results(requests.size());
+            const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
+            if (radius <= 0)
+                rayCasting->castRays(requests, results, ignore, collisionType);
+            else
+            {
+                for (const auto& ptr : ignore)
+                {
+                    if (!ptr.isEmpty())
+                        throw std::logic_error("Currently castRays doesn't support `ignore` when radius > 0");
+                }
+                rayCasting->castSpheres(requests, radius, results, collisionType);
+            }
+            sol::table res(lua, sol::create);
+            for (std::size_t i = 0; i < results.size(); ++i)
+                res[i + 1] = std::move(results[i]);
+            return res;
+        };
         // TODO: async raycasting
         /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
             const Callback& luaCallback, const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table>
@@ -199,6 +234,9 @@ namespace MWLua
         api["doors"] = LObjectList{ objectLists->getDoorsInScene() };
         api["items"] = LObjectList{ objectLists->getItemsInScene() };
         api["players"] = LObjectList{ objectLists->getPlayers() };
+        api["findInRadius"] = [objectLists](const osg::Vec3f& position, float radius, const LObjectList& list) {
+            return LObjectList{ objectLists->findInRadius(position, radius, list.mIds) };
+        };
 
         api["NAVIGATOR_FLAGS"]
             = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, DetourNavigator::Flag>(lua,
@@ -342,6 +380,41 @@ namespace MWLua
                       *MWBase::Environment::get().getWorld()->getNavigator(), agentBounds, from, to, includeFlags);
               };
 
+        api["castNavigationRays"]
+            = [](const sol::table& rays, const sol::optional<sol::table>& options, sol::this_state lua) {
+                  DetourNavigator::AgentBounds agentBounds = defaultAgentBounds;
+                  DetourNavigator::Flags includeFlags = defaultIncludeFlags;
+
+                  if (options.has_value())
+                  {
+                      if (const auto& t = options->get<sol::optional<sol::table>>("agentBounds"))
+                      {
+                          if (const auto& v = t->get<sol::optional<DetourNavigator::CollisionShapeType>>("shapeType"))
+                              agentBounds.mShapeType = *v;
+                          if (const auto& v = t->get<sol::optional<osg::Vec3f>>("halfExtents"))
+                              agentBounds.mHalfExtents = *v;
+                      }
+                      if (const auto& v = options->get<sol::optional<DetourNavigator::Flags>>("includeFlags"))
+                          includeFlags = *v;
+                  }
+
+                  std::vector<DetourNavigator::RaycastRequest> requests;
+                  requests.reserve(rays.size());
+                  for (std::size_t i = 1; i <= rays.size(); ++i)
+                  {
+                      const sol::table ray = rays[i];
+                      requests.push_back({ ray.get<osg::Vec3f>("from"), ray.get<osg::Vec3f>("to") });
+                  }
+                  std::vector<std::optional<osg::Vec3f>> results(requests.size());
+                  DetourNavigator::raycast(*MWBase::Environment::get().getWorld()->getNavigator(), agentBounds,
+                      requests, includeFlags, results);
+                  sol::table res(lua, sol::create);
+                  for (std::size_t i = 0; i < results.size(); ++i)
+                      if (results[i].has_value())
+                          res[i + 1] = *results[i];
+                  return res;
+              };
+
         api["findNearestNavMeshPosition"] = [](const osg::Vec3f& position, const sol::optional<sol::table>& options) {
             DetourNavigator::AgentBounds agentBounds = defaultAgentBounds;
             std::optional<osg::Vec3f> searchAreaHalfExtents;
@@ -178,6 +178,12 @@ namespace MWLua
             };
             listT[sol::meta_function::pairs] = lua["ipairsForArray"].template get<sol::function>();
             listT[sol::meta_function::ipairs] = lua["ipairsForArray"].template get<sol::function>();
+            listT["sendEvent"] = [context](const ListT& list, std::string eventName, const sol::object& eventData) {
+                // Serialized once, all the events share the data
+                const LuaUtil::SharedBinaryData data = LuaUtil::serializeShared(eventData, context.mSerializer);
+                for (const ObjectId& id : *list.mIds)
+                    context.mLuaEvents->addLocalEvent({ id, eventName, data });
+            };
         }
 
         osg::Vec3f toEulerRotation(const sol::object& transform, bool isActor)
@@ -339,7 +345,7 @@ namespace MWLua
             objectT[sol::meta_function::to_string] = &ObjectT::toString;
             objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData) {
                 context.mLuaEvents->addLocalEvent(
-                    { dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    { dest.id(), std::move(eventName), LuaUtil::serializeShared(eventData, context.mSerializer) });
             };
 
             objectT["activateBy"] = [](const ObjectT& object, const ObjectT& actor) {
@@ -629,6 +635,21 @@ namespace MWLua
                 return ObjectList<ObjectT>{ std::move(list) };
             };
 
+            inventoryT["records"] = [](const InventoryT& inventory) {
+                const MWWorld::Ptr& ptr = inventory.mObj.ptr();
+                MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
+                // A copy allows to change the inventory in the loop
+                auto items = std::make_shared<std::vector<std::pair<std::string, int>>>();
+                for (const MWWorld::Ptr& item : store)
+                    items->emplace_back(item.getCellRef().getRefId().serializeText(), item.getCellRef().getCount());
+                return [items, index = std::make_shared<std::size_t>(0)](
+                           sol::this_state lua) -> std::tuple<sol::object, sol::object> {
+                    if (*index >= items->size())
+                        return { sol::nil, sol::nil };
+                    const auto& [recordId, count] = (*items)[(*index)++];
+                    return { sol::make_object(lua, recordId), sol::make_object(lua, count) };
+                };
+            };
             inventoryT["countOf"] = [](const InventoryT& inventory, std::string_view recordId) {
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
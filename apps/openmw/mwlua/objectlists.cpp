@@ -1,5 +1,10 @@
 #include "objectlists.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <utility>
+
 #include <components/misc/resourcehelpers.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -11,6 +16,28 @@
 
 namespace MWLua
 {
+    namespace
+    {
+        constexpr float gridCellSize = 1024;
+
+        int toGridCoord(float value)
+        {
+            return static_cast<int>(std::floor(value / gridCellSize));
+        }
+
+        std::int64_t getGridKey(int x, int y)
+        {
+            return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        std::optional<osg::Vec3f> getPosition(ObjectId id)
+        {
+            const MWWorld::Ptr ptr = MWBase::Environment::get().getWorldModel()->getPtr(id);
+            if (ptr.isEmpty())
+                return std::nullopt;
+            return ptr.getRefData().getPosition().asVec3();
+        }
+    }
 
     void ObjectLists::update()
     {
@@ -21,6 +48,66 @@ namespace MWLua
         mItemsInScene.updateList();
     }
 
+    const ObjectLists::ObjectGroup* ObjectLists::findGroup(const ObjectIdList& list) const
+    {
+        for (const ObjectGroup* group :
+            { &mActivatorsInScene, &mActorsInScene, &mContainersInScene, &mDoorsInScene, &mItemsInScene })
+            if (group->mList == list)
+                return group;
+        return nullptr;
+    }
+
+    ObjectIdList ObjectLists::findInRadius(const osg::Vec3f& position, float radius, const ObjectIdList& list) const
+    {
+        std::vector<std::pair<float, ObjectId>> found;
+        const float radius2 = radius * radius;
+        const auto check = [&](const osg::Vec3f& objectPosition, ObjectId id) {
+            const float distance2 = (objectPosition - position).length2();
+            if (distance2 <= radius2)
+                found.emplace_back(distance2, id);
+        };
+
+        if (const ObjectGroup* group = findGroup(list))
+        {
+            group->buildGrid();
+            const int minX = toGridCoord(position.x() - radius);
+            const int maxX = toGridCoord(position.x() + radius);
+            const int minY = toGridCoord(position.y() - radius);
+            const int maxY = toGridCoord(position.y() + radius);
+            const auto checkEntries = [&](const std::vector<GridEntry>& entries) {
+                for (const GridEntry& entry : entries)
+                    check(entry.mPosition, entry.mId);
+            };
+            // A large radius covers more grid cells than there are non-empty ones
+            if (static_cast<std::size_t>(maxX - minX + 1) * static_cast<std::size_t>(maxY - minY + 1)
+                > group->mGrid.size())
+            {
+                for (const auto& [key, entries] : group->mGrid)
+                    checkEntries(entries);
+            }
+            else
+            {
+                for (int x = minX; x <= maxX; ++x)
+                    for (int y = minY; y <= maxY; ++y)
+                        if (const auto it = group->mGrid.find(getGridKey(x, y)); it != group->mGrid.end())
+                            checkEntries(it->second);
+            }
+        }
+        else if (list != nullptr)
+        {
+            for (const ObjectId id : *list)
+                if (const std::optional<osg::Vec3f> objectPosition = getPosition(id))
+                    check(*objectPosition, id);
+        }
+
+        std::sort(found.begin(), found.end());
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        result->reserve(found.size());
+        for (const auto& [distance2, id] : found)
+            result->push_back(id);
+        return result;
+    }
+
     void ObjectLists::clear()
     {
         mActivatorsInScene.clear();
@@ -74,6 +161,7 @@ namespace MWLua
                 mList->push_back(id);
             mChanged = false;
         }
+        mGridValid = false;
     }
 
     void ObjectLists::ObjectGroup::clear()
@@ -81,6 +169,23 @@ namespace MWLua
         mChanged = false;
         mList->clear();
         mSet.clear();
+        mGrid.clear();
+        mGridValid = false;
+    }
+
+    void ObjectLists::ObjectGroup::buildGrid() const
+    {
+        if (mGridValid)
+            return;
+        for (auto& [key, entries] : mGrid)
+            entries.clear();
+        for (const ObjectId id : *mList)
+        {
+            if (const std::optional<osg::Vec3f> position = getPosition(id))
+                mGrid[getGridKey(toGridCoord(position->x()), toGridCoord(position->y()))].push_back({ *position, id });
+        }
+        std::erase_if(mGrid, [](const auto& v) { return v.second.empty(); });
+        mGridValid = true;
     }
 
     void ObjectLists::addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
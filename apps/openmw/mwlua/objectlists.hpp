@@ -1,7 +1,12 @@
 #ifndef MWLUA_OBJECTLISTS_H
 #define MWLUA_OBJECTLISTS_H
 
+#include <cstdint>
 #include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Vec3f>
 
 #include "object.hpp"
 
@@ -27,18 +32,35 @@ namespace MWLua
 
         void setPlayer(const MWWorld::Ptr& player) { *mPlayers = { getId(player) }; }
 
+        // Objects from the list within the radius, the closest first. Lists of this class are searched using a grid
+        // built on first use in a frame, other lists are scanned.
+        ObjectIdList findInRadius(const osg::Vec3f& position, float radius, const ObjectIdList& list) const;
+
     private:
+        struct GridEntry
+        {
+            osg::Vec3f mPosition;
+            ObjectId mId;
+        };
+
         struct ObjectGroup
         {
             void updateList();
             void clear();
+            void buildGrid() const;
 
             bool mChanged = false;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
             std::set<ObjectId> mSet;
+
+            // Objects of mList by horizontal grid cell. Positions are taken when the grid is built, so it is
+            // invalidated every frame.
+            mutable std::unordered_map<std::int64_t, std::vector<GridEntry>> mGrid;
+            mutable bool mGridValid = false;
         };
 
         ObjectGroup* chooseGroup(const MWWorld::Ptr& ptr);
+        const ObjectGroup* findGroup(const ObjectIdList& list) const;
         void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
@@ -24,6 +24,16 @@ namespace MWLua
                 throw std::runtime_error("Expected game object, got: " + LuaUtil::toString(obj));
         }
 
+        explicit ObjectVariant(const LObject& obj)
+            : mVariant(obj)
+        {
+        }
+
+        explicit ObjectVariant(const GObject& obj)
+            : mVariant(obj)
+        {
+        }
+
         bool isSelfObject() const { return std::holds_alternative<SelfObject*>(mVariant); }
         bool isLObject() const { return std::holds_alternative<LObject>(mVariant); }
         bool isGObject() const { return std::holds_alternative<GObject>(mVariant); }
@@ -48,6 +58,19 @@ namespace MWLua
                 mVariant);
         }
 
+        const MWWorld::Ptr& ptrOrEmpty() const
+        {
+            return std::visit(
+                [](auto&& variant) -> const MWWorld::Ptr& {
+                    using T = std::decay_t<decltype(variant)>;
+                    if constexpr (std::is_same_v<T, SelfObject*>)
+                        return variant->ptrOrEmpty();
+                    else
+                        return variant.ptrOrEmpty();
+                },
+                mVariant);
+        }
+
         Object object() const { return Object(ptr()); }
 
     private:
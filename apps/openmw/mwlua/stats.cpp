@@ -62,6 +62,28 @@ namespace
 
 namespace MWLua
 {
+    template <class F>
+    static void forEachObject(const sol::object& objects, F&& f)
+    {
+        if (objects.is<LObjectList>())
+        {
+            for (const ObjectId& id : *objects.as<LObjectList>().mIds)
+                f(ObjectVariant(LObject(id)));
+        }
+        else if (objects.is<GObjectList>())
+        {
+            for (const ObjectId& id : *objects.as<GObjectList>().mIds)
+                f(ObjectVariant(GObject(id)));
+        }
+        else
+        {
+            const sol::table table = LuaUtil::cast<sol::table>(objects);
+            const std::size_t size = table.size();
+            for (std::size_t i = 1; i <= size; ++i)
+                f(ObjectVariant(table.get<sol::object>(i)));
+        }
+    }
+
     static void addStatUpdateAction(MWLua::LuaManager* manager, const SelfObject& obj)
     {
         if (!obj.mStatsCache.empty())
@@ -532,6 +554,29 @@ namespace sol
 
 namespace MWLua
 {
+    // Three values (health, magicka, fatigue) per actor, nil for objects which are not available actors
+    template <class G>
+    static void fillDynamicValues(
+        const Context& context, const sol::object& actors, std::string_view prop, G getter, sol::table& values)
+    {
+        const std::size_t previousSize = values.size();
+        std::size_t size = 0;
+        forEachObject(actors, [&](const ObjectVariant& object) {
+            const MWWorld::Ptr& ptr = object.ptrOrEmpty();
+            const bool isActor = !ptr.isEmpty() && ptr.getClass().isActor();
+            for (int i = 0; i < 3; ++i)
+            {
+                ++size;
+                if (isActor)
+                    values[size] = DynamicStat::create(object, i)->get(context, prop, getter);
+                else
+                    values[size] = sol::nil;
+            }
+        });
+        for (std::size_t i = size + 1; i <= previousSize; ++i)
+            values[i] = sol::nil;
+    }
+
     void addActorStatsBindings(sol::table& actor, const Context& context)
     {
         sol::state_view lua = context.sol();
@@ -581,6 +626,19 @@ namespace MWLua
         dynamic["health"] = addIndexedAccessor<DynamicStat>(0);
         dynamic["magicka"] = addIndexedAccessor<DynamicStat>(1);
         dynamic["fatigue"] = addIndexedAccessor<DynamicStat>(2);
+        dynamic["getValues"] = [context](const sol::object& actors, std::string_view prop,
+                                   sol::optional<sol::table> result) {
+            sol::table values = result ? *result : sol::table(context.sol(), sol::create);
+            if (prop == "base")
+                fillDynamicValues(context, actors, prop, &MWMechanics::DynamicStat<float>::getBase, values);
+            else if (prop == "current")
+                fillDynamicValues(context, actors, prop, &MWMechanics::DynamicStat<float>::getCurrent, values);
+            else if (prop == "modifier")
+                fillDynamicValues(context, actors, prop, &MWMechanics::DynamicStat<float>::getModifier, values);
+            else
+                throw std::runtime_error("Unknown dynamic stat property: " + std::string(prop));
+            return values;
+        };
 
         auto attributeStatT = lua.new_usertype<AttributeStat>("AttributeStat");
         addProp(context, attributeStatT, "base", &MWMechanics::AttributeValue::getBase);
@@ -420,7 +420,7 @@ namespace MWLua
         };
         player["sendMenuEvent"] = [context](const Object& object, std::string eventName, const sol::object& eventData) {
             verifyPlayer(object);
-            context.mLuaEvents->addMenuEvent({ std::move(eventName), LuaUtil::serialize(eventData) });
+            context.mLuaEvents->addMenuEvent({ std::move(eventName), LuaUtil::serializeShared(eventData) });
         };
 
         player["getCrimeLevel"] = [](const Object& o) -> int {
@@ -5,6 +5,7 @@
 #include "apps/openmw/profile.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/settings/values.hpp>
 
 #include <cassert>
@@ -73,6 +74,8 @@ namespace MWLua
 
     void Worker::run() noexcept
     {
+        OPENMW_TRACE_THREAD_NAME("Lua Worker");
+
         while (true)
         {
             std::unique_lock<std::mutex> lk(mMutex);
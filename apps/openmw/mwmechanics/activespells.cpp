@@ -1,6 +1,8 @@
 #include "activespells.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <utility>
 
 #include <components/debug/debuglog.hpp>
 
@@ -69,6 +71,34 @@ namespace
             effects.emplace_back(effect);
         }
     }
+
+    // Sorted keys of the active spells, to check every ability and equipped item against without searching all spells
+    using EquipmentKey = std::pair<ESM::RefNum, ESM::RefId>;
+
+    std::vector<ESM::RefId> getSourceSpellIds(const MWMechanics::ActiveSpells& spells)
+    {
+        std::vector<ESM::RefId> result;
+        for (const auto& params : spells)
+            result.push_back(params.getSourceSpellId());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<EquipmentKey> getEquipmentKeys(const MWMechanics::ActiveSpells& spells)
+    {
+        std::vector<EquipmentKey> result;
+        for (const auto& params : spells)
+            if (params.hasFlag(ESM::ActiveSpells::Flag_Equipment))
+                result.emplace_back(params.getItem(), params.getSourceSpellId());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    template <class T>
+    void insertSorted(std::vector<T>& values, T value)
+    {
+        values.insert(std::upper_bound(values.begin(), values.end(), value), std::move(value));
+    }
 }
 
 namespace MWMechanics
@@ -298,12 +328,19 @@ namespace MWMechanics
         {
             // Vanilla only does this on cell change I think
             const auto& spells = creatureStats.getSpells();
+            std::vector<ESM::RefId> activeIds = getSourceSpellIds(*this);
             for (const ESM::Spell* spell : spells)
             {
                 if (spell->mData.mType != ESM::Spell::ST_Spell && spell->mData.mType != ESM::Spell::ST_Power
-                    && !isSpellActive(spell->mId))
+                    && !std::binary_search(activeIds.begin(), activeIds.end(), spell->mId))
                 {
+                    const std::size_t count = mSpells.size();
                     initParams(ptr, ActiveSpellParams{ spell, ptr, true }, context);
+                    // Applying the new spell may have purged others
+                    if (mSpells.size() == count + 1)
+                        insertSorted(activeIds, spell->mId);
+                    else
+                        activeIds = getSourceSpellIds(*this);
                 }
             }
         }
@@ -316,6 +353,7 @@ namespace MWMechanics
             {
                 context.mPlayNonLooping = !store.isFirstEquip();
                 const auto world = MWBase::Environment::get().getWorld();
+                std::vector<EquipmentKey> equipment = getEquipmentKeys(*this);
                 for (int slotIndex = 0; slotIndex < MWWorld::InventoryStore::Slots; slotIndex++)
                 {
                     auto slot = store.getSlot(slotIndex);
@@ -328,13 +366,8 @@ namespace MWMechanics
                         = world->getStore().get<ESM::Enchantment>().search(enchantmentId);
                     if (enchantment == nullptr || enchantment->mData.mType != ESM::Enchantment::ConstantEffect)
                         continue;
-                    if (std::find_if(mSpells.begin(), mSpells.end(),
-                            [&](const ActiveSpellParams& params) {
-                                return params.mItem == slot->getCellRef().getRefNum()
-                                    && params.hasFlag(ESM::ActiveSpells::Flag_Equipment)
-                                    && params.mSourceSpellId == slot->getCellRef().getRefId();
-                            })
-                        != mSpells.end())
+                    EquipmentKey key(slot->getCellRef().getRefNum(), slot->getCellRef().getRefId());
+                    if (std::binary_search(equipment.begin(), equipment.end(), key))
                         continue;
                     // world->breakInvisibility leads to a stack overflow as it calls this method so just break
                     // invisibility manually
@@ -343,6 +376,8 @@ namespace MWMechanics
                     const bool added = initParams(ptr, ActiveSpellParams{ *slot, enchantment, ptr }, context);
                     if (added)
                         context.mUpdateSpellWindow = true;
+                    // Purging may have removed the spells of other items
+                    equipment = getEquipmentKeys(*this);
                 }
             }
         }
@@ -1,11 +1,15 @@
 #ifndef OPENMW_MECHANICS_ACTOR_H
 #define OPENMW_MECHANICS_ACTOR_H
 
+#include <array>
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include "character.hpp"
 #include "creaturestats.hpp"
 #include "greetingstate.hpp"
+#include "movement.hpp"
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -31,6 +35,7 @@ namespace MWMechanics
         Actor(const MWWorld::Ptr& ptr, MWRender::Animation& animation)
             : mCharacterController(ptr, animation)
             , mPositionAdjusted(ptr.getClass().getCreatureStats(ptr).getFallHeight() > 0)
+            , mActorId(ptr.getClass().getCreatureStats(ptr).getActorId())
         {
         }
 
@@ -39,6 +44,9 @@ namespace MWMechanics
         /// Notify this actor of its new base object Ptr, use when the object changed cells
         void updatePtr(const MWWorld::Ptr& newPtr) { mCharacterController.updatePtr(newPtr); }
 
+        /// Actor id of the object at the time it was added to the scene
+        int getActorId() const { return mActorId; }
+
         CharacterController& getCharacterController() { return mCharacterController; }
         const CharacterController& getCharacterController() const { return mCharacterController; }
 
@@ -59,6 +67,26 @@ namespace MWMechanics
             return mEngageCombat.update(duration, MWBase::Environment::get().getWorld()->getPrng());
         }
 
+        /// Add the frame duration to the time since the last AI update.
+        /// @return Time since the last AI update if the AI updates during this frame, which happens every interval
+        /// frames shifted by the phase
+        std::optional<float> updateAiTimer(unsigned frame, unsigned phase, unsigned interval, float duration)
+        {
+            mAiDuration += duration;
+            if ((frame + phase) % interval != 0)
+                return std::nullopt;
+            return std::exchange(mAiDuration, 0.f);
+        }
+
+        /// Remember the movement chosen by the AI, to repeat it during the frames the AI does not update
+        void setAiMovement(const Movement& movement) { mAiMovement = { movement.mPosition[0], movement.mPosition[1] }; }
+
+        void applyAiMovement(Movement& movement) const
+        {
+            movement.mPosition[0] = mAiMovement[0];
+            movement.mPosition[1] = mAiMovement[1];
+        }
+
         void setPositionAdjusted(bool adjusted) { mPositionAdjusted = adjusted; }
         bool getPositionAdjusted() const { return mPositionAdjusted; }
 
@@ -76,9 +104,12 @@ namespace MWMechanics
         GreetingState mGreetingState{ GreetingState::None };
         Misc::DeviatingPeriodicTimer mEngageCombat{ 1.0f, 0.25f,
             Misc::Rng::deviate(0, 0.25f, MWBase::Environment::get().getWorld()->getPrng()) };
+        float mAiDuration{ 0.f };
+        std::array<float, 2> mAiMovement{};
         bool mIsTurningToPlayer{ false };
         bool mInvalid{ false };
         bool mPositionAdjusted;
+        int mActorId;
     };
 
 }
@@ -1,7 +1,13 @@
 #include "actors.hpp"
 
+#include <algorithm>
 #include <array>
+#include <future>
 #include <optional>
+#include <thread>
+#include <unordered_map>
+
+#include <osg/Stats>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
@@ -58,6 +64,23 @@
 
 namespace
 {
+    // Indices of Actors::mAiLodStats
+    enum AiLodStat
+    {
+        AiLodFull,
+        AiLodVisible,
+        AiLodHidden,
+        AiLodSkipped,
+    };
+
+    // Distant actors are too small on screen for a pose a frame or two old to be noticed
+    unsigned getAnimationUpdateInterval(float distanceToPlayer)
+    {
+        const Settings::GameCategory& settings = Settings::game();
+        if (!settings.mAnimationUpdateLod || distanceToPlayer <= settings.mAnimationLodDistance)
+            return 1;
+        return static_cast<unsigned>(settings.mAnimationLodInterval.get());
+    }
 
     bool isConscious(const MWWorld::Ptr& ptr)
     {
@@ -119,7 +142,7 @@ namespace
 
     template <class T>
     void forEachFollowingPackage(
-        const std::list<MWMechanics::Actor>& actors, const MWWorld::Ptr& actorPtr, const MWWorld::Ptr& player, T&& func)
+        const MWMechanics::ActorStore& actors, const MWWorld::Ptr& actorPtr, const MWWorld::Ptr& player, T&& func)
     {
         for (const MWMechanics::Actor& actor : actors)
         {
@@ -319,7 +342,7 @@ namespace MWMechanics
         }
 
         void updateHeadTracking(
-            const MWWorld::Ptr& ptr, const std::list<Actor>& actors, bool isPlayer, CharacterController& ctrl)
+            const MWWorld::Ptr& ptr, const ActorStore& actors, bool isPlayer, CharacterController& ctrl)
         {
             float sqrHeadTrackDistance = std::numeric_limits<float>::max();
             MWWorld::Ptr headTrackTarget;
@@ -1199,11 +1222,13 @@ namespace MWMechanics
         MWRender::Animation* anim = MWBase::Environment::get().getWorld()->getAnimation(ptr);
         if (!anim)
             return;
-        const auto it = mActors.emplace(mActors.end(), ptr, *anim);
-        mIndex.emplace(ptr.mRef, it);
+        Actor& actor = mActors.emplace(ptr, *anim);
+        mIndex.emplace(ptr.mRef, &actor);
+        mActorIdIndex.insert_or_assign(actor.getActorId(), &actor);
+        mGrid.update(&actor, ptr.getRefData().getPosition().asVec3());
 
         if (updateImmediately)
-            it->getCharacterController().update(0);
+            actor.getCharacterController().update(0);
 
         // We should initially hide actors outside of processing range.
         // Note: since we update player after other actors, distance will be incorrect during teleportation.
@@ -1211,7 +1236,7 @@ namespace MWMechanics
         if (MWBase::Environment::get().getWorld()->getPlayer().wasTeleported())
             return;
 
-        updateVisibility(ptr, it->getCharacterController());
+        updateVisibility(ptr, actor.getCharacterController());
     }
 
     void Actors::updateVisibility(const MWWorld::Ptr& ptr, CharacterController& ctrl) const
@@ -1251,6 +1276,8 @@ namespace MWMechanics
         {
             if (!keepActive)
                 removeTemporaryEffects(iter->second->getPtr());
+            mGrid.erase(iter->second);
+            eraseActorId(*iter->second);
             iter->second->invalidate();
             mIndex.erase(iter);
         }
@@ -1301,6 +1328,13 @@ namespace MWMechanics
             iter->second->updatePtr(ptr);
     }
 
+    void Actors::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        const auto iter = mIndex.find(ptr.mRef);
+        if (iter != mIndex.end())
+            mGrid.update(iter->second, ptr.getRefData().getPosition().asVec3());
+    }
+
     void Actors::dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore)
     {
         for (Actor& actor : mActors)
@@ -1310,11 +1344,145 @@ namespace MWMechanics
             {
                 removeTemporaryEffects(actor.getPtr());
                 mIndex.erase(actor.getPtr().mRef);
+                mGrid.erase(&actor);
+                eraseActorId(actor);
                 actor.invalidate();
             }
         }
     }
 
+    void Actors::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Mechanics AI Full", mAiLodStats[AiLodFull]);
+        stats.setAttribute(frameNumber, "Mechanics AI Visible", mAiLodStats[AiLodVisible]);
+        stats.setAttribute(frameNumber, "Mechanics AI Hidden", mAiLodStats[AiLodHidden]);
+        stats.setAttribute(frameNumber, "Mechanics AI Skipped", mAiLodStats[AiLodSkipped]);
+    }
+
+    void Actors::rateCombatTargets(const osg::Vec3f& playerPos, float processingRange) const
+    {
+        // Below this many targets the threads cost more than the ratings, execute rates them itself
+        constexpr std::size_t minParallelRatings = 16;
+        constexpr std::size_t minRatingsPerJob = 4;
+
+        struct CombatTargetRating
+        {
+            MWWorld::Ptr mActor;
+            MWWorld::Ptr mTarget;
+            const CombatActionCandidates* mCandidates;
+            float mRating = 0;
+        };
+
+        // Looking up the targets may search the world and create their stats, collecting the items of the actors
+        // modifies them, do it before sharing them with the jobs
+        const MWWorld::Ptr player = getPlayer();
+        std::vector<CombatTargetRating> ratings;
+        std::vector<MWWorld::Ptr> targets;
+        for (const Actor& actor : mActors)
+        {
+            if (actor.isInvalid())
+                continue;
+            const MWWorld::Ptr& ptr = actor.getPtr();
+            if (ptr == player)
+                continue;
+            CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
+            AiSequence& sequence = stats.getAiSequence();
+            // Also drops the ratings of the actors execute skipped during the last frame
+            sequence.setCombatTargetRatings({});
+            // Targets are only rated to choose between them while a combat package is the current one
+            if (stats.isDead() || sequence.getTypeId() != AiPackageTypeId::Combat
+                || (playerPos - ptr.getRefData().getPosition().asVec3()).length2()
+                    > processingRange * processingRange)
+                continue;
+            targets.clear();
+            sequence.getCombatTargets(targets);
+            const CombatActionCandidates& candidates = sequence.getCombatActionCandidates(ptr);
+            for (const MWWorld::Ptr& target : targets)
+            {
+                if (target.isEmpty() || !target.getClass().isActor())
+                    continue;
+                target.getClass().getCreatureStats(target);
+                ratings.push_back(CombatTargetRating{ ptr, target, &candidates });
+            }
+        }
+
+        if (ratings.size() < minParallelRatings)
+            return;
+
+        // Every rating only reads the actors, which are not modified until all jobs are done. Each job writes its own
+        // ratings, so the result does not depend on how the jobs are scheduled.
+        const std::size_t jobs = std::clamp<std::size_t>(
+            std::thread::hardware_concurrency(), 1, ratings.size() / minRatingsPerJob);
+        const auto rate = [&](std::size_t job) {
+            for (std::size_t i = job; i < ratings.size(); i += jobs)
+                ratings[i].mRating
+                    = getBestActionRating(ratings[i].mActor, ratings[i].mTarget, *ratings[i].mCandidates);
+        };
+        std::vector<std::future<void>> futures;
+        futures.reserve(jobs - 1);
+        for (std::size_t job = 1; job < jobs; ++job)
+            futures.push_back(std::async(std::launch::async, rate, job));
+        rate(0);
+        for (std::future<void>& future : futures)
+            future.get();
+
+        for (auto it = ratings.begin(); it != ratings.end();)
+        {
+            const MWWorld::Ptr actor = it->mActor;
+            std::vector<std::pair<const MWWorld::LiveCellRefBase*, float>> actorRatings;
+            for (; it != ratings.end() && it->mActor == actor; ++it)
+                actorRatings.emplace_back(it->mTarget.mRef, it->mRating);
+            actor.getClass().getCreatureStats(actor).getAiSequence().setCombatTargetRatings(std::move(actorRatings));
+        }
+    }
+
+    void Actors::executeAiPackages(Actor& actor, float distanceToPlayerSqr, float duration)
+    {
+        const MWWorld::Ptr& ptr = actor.getPtr();
+        CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
+        AiSequence& sequence = stats.getAiSequence();
+        const Settings::GameCategory& settings = Settings::game();
+        if (!settings.mAiUpdateLod)
+        {
+            sequence.execute(ptr, actor.getCharacterController(), duration);
+            return;
+        }
+
+        // Combat and pursuit react to the target moving, they can't wait
+        AiLodStat tier = AiLodFull;
+        unsigned interval = 1;
+        const float lodDistance = settings.mAiLodDistance;
+        if (distanceToPlayerSqr > lodDistance * lodDistance && !sequence.isInCombat() && !sequence.isInPursuit())
+        {
+            // The line of sight to the player is already queued for this frame, this is a cache lookup
+            if (MWBase::Environment::get().getWorld()->getLOS(ptr, getPlayer()))
+            {
+                tier = AiLodVisible;
+                interval = static_cast<unsigned>(settings.mAiLodVisibleInterval.get());
+            }
+            else
+            {
+                tier = AiLodHidden;
+                interval = static_cast<unsigned>(settings.mAiLodHiddenInterval.get());
+            }
+        }
+        ++mAiLodStats[tier];
+
+        // Actor ids spread the updates of the actors with the same interval over its frames
+        Movement& movement = ptr.getClass().getMovementSettings(ptr);
+        const std::optional<float> aiDuration
+            = actor.updateAiTimer(mAiFrame, static_cast<unsigned>(stats.getActorId()), interval, duration);
+        if (!aiDuration.has_value())
+        {
+            ++mAiLodStats[AiLodSkipped];
+            actor.applyAiMovement(movement);
+            return;
+        }
+
+        sequence.execute(ptr, actor.getCharacterController(), *aiDuration);
+        actor.setAiMovement(movement);
+    }
+
     void Actors::predictAndAvoidCollisions(float duration) const
     {
         if (!MWBase::Environment::get().getMechanicsManager()->isAIActive())
@@ -1339,15 +1507,20 @@ namespace MWMechanics
 
         std::vector<CacheEntry> cache;
         cache.reserve(mActors.size());
+        std::unordered_map<const Actor*, std::size_t> cacheIndices;
+        cacheIndices.reserve(mActors.size());
         for (const Actor& actor : mActors)
         {
             if (actor.isInvalid())
                 continue;
             const MWWorld::Ptr& ptr = actor.getPtr();
             const MWWorld::Class& cls = ptr.getClass();
+            cacheIndices.emplace(&actor, cache.size());
             cache.push_back({ ptr, cls.getMaxSpeed(ptr), world->getHalfExtents(ptr), cls.getMovementSettings(ptr) });
         }
 
+        std::vector<const Actor*> neighbours;
+
         for (const CacheEntry& cached : cache)
         {
             const MWWorld::Ptr& ptr = cached.mPtr;
@@ -1411,9 +1584,18 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for (const CacheEntry& otherCached : cache)
+            // Iterate through the other actors close enough and predict collisions.
+            neighbours.clear();
+            mGrid.forEachInRange(basePos, maxDistToCheck, [&](const Actor* other, const osg::Vec3f& /*otherPos*/) {
+                neighbours.push_back(other);
+                return true;
+            });
+            for (const Actor* other : neighbours)
             {
+                const auto otherIndex = cacheIndices.find(other);
+                if (otherIndex == cacheIndices.end())
+                    continue;
+                const CacheEntry& otherCached = cache[otherIndex->second];
                 const MWWorld::Ptr& otherPtr = otherCached.mPtr;
                 if (otherPtr == ptr || otherPtr == currentTarget)
                     continue;
@@ -1528,6 +1710,11 @@ namespace MWMechanics
             }
             const int actorsProcessingRange = Settings::game().mActorsProcessingRange;
 
+            if (aiActive)
+                rateCombatTargets(playerPos, static_cast<float>(actorsProcessingRange));
+
+            mAiLodStats = {};
+
             // AI and magic effects update
             for (Actor& actor : mActors)
             {
@@ -1613,7 +1800,10 @@ namespace MWMechanics
                             CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
                             if (isConscious(actor.getPtr()) && !(luaControls && luaControls->mDisableAI))
                             {
-                                stats.getAiSequence().execute(actor.getPtr(), ctrl, duration);
+                                // Greetings, idle dialogue, crime and sneak checks all look for the player, let the
+                                // physics workers raycast it ahead of the next frame
+                                MWBase::Environment::get().getWorld()->queueLOS(actor.getPtr(), player);
+                                executeAiPackages(actor, distSqr, duration);
                                 updateGreetingState(actor.getPtr(), actor, mTimerUpdateHello > 0);
                                 playIdleDialogue(actor.getPtr());
                                 updateMovementSpeed(actor.getPtr());
@@ -1641,6 +1831,8 @@ namespace MWMechanics
                 }
             }
 
+            ++mAiFrame;
+
             if (Settings::game().mNPCsAvoidCollisions)
                 predictAndAvoidCollisions(duration);
 
@@ -1672,6 +1864,8 @@ namespace MWMechanics
 
                 CharacterController& ctrl = actor.getCharacterController();
                 ctrl.setActive(active);
+                ctrl.setAnimationUpdateInterval(
+                    getAnimationUpdateInterval(dist), static_cast<unsigned>(stats.getActorId()));
 
                 if (!inRange)
                 {
@@ -1720,15 +1914,14 @@ namespace MWMechanics
                     luaControls->mJump = false;
             }
 
-            for (auto it = mActors.begin(); it != mActors.end();)
+            for (auto it = mActors.begin(); it != mActors.end(); ++it)
             {
                 if (it->isInvalid())
                 {
-                    it = mActors.erase(it);
+                    mActors.erase(it);
                     continue;
                 }
                 const Actor& actor = *it;
-                it++;
                 const MWWorld::Class& cls = actor.getPtr().getClass();
                 CreatureStats& stats = cls.getCreatureStats(actor.getPtr());
 
@@ -2102,26 +2295,20 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if (actor.isInvalid())
-                continue;
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                out.push_back(actor.getPtr());
-        }
+        mGrid.forEachInRange(position, radius, [&](const Actor* actor, const osg::Vec3f& /*actorPosition*/) {
+            out.push_back(actor->getPtr());
+            return true;
+        });
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if (actor.isInvalid())
-                continue;
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                return true;
-        }
-
-        return false;
+        bool found = false;
+        mGrid.forEachInRange(position, radius, [&](const Actor* /*actor*/, const osg::Vec3f& /*actorPosition*/) {
+            found = true;
+            return false;
+        });
+        return found;
     }
 
     std::vector<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actorPtr, bool excludeInfighting) const
@@ -2296,6 +2483,25 @@ namespace MWMechanics
         return list;
     }
 
+    MWWorld::Ptr Actors::searchActorViaActorId(int actorId) const
+    {
+        const auto it = mActorIdIndex.find(actorId);
+        if (it == mActorIdIndex.end())
+            return MWWorld::Ptr();
+        // The actor id of the object could have been replaced while it is in the scene, e.g. by loading its state
+        const MWWorld::Ptr& ptr = it->second->getPtr();
+        if (!ptr.getClass().getCreatureStats(ptr).matchesActorId(actorId) || ptr.getCellRef().getCount() <= 0)
+            return MWWorld::Ptr();
+        return ptr;
+    }
+
+    void Actors::eraseActorId(const Actor& actor)
+    {
+        const auto it = mActorIdIndex.find(actor.getActorId());
+        if (it != mActorIdIndex.end() && it->second == &actor)
+            mActorIdIndex.erase(it);
+    }
+
     void Actors::write(ESM::ESMWriter& writer, Loading::Listener& listener) const
     {
         writer.startRecord(ESM::REC_DCOU);
@@ -2325,6 +2531,8 @@ namespace MWMechanics
     void Actors::clear()
     {
         mIndex.clear();
+        mActorIdIndex.clear();
+        mGrid.clear();
         mActors.clear();
         mDeathCount.clear();
     }
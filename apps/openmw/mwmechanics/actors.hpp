@@ -1,13 +1,16 @@
 #ifndef GAME_MWMECHANICS_ACTORS_H
 #define GAME_MWMECHANICS_ACTORS_H
 
-#include <list>
+#include <array>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "actor.hpp"
+#include "actorstore.hpp"
+#include "spatialgrid.hpp"
 
 namespace ESM
 {
@@ -17,6 +20,7 @@ namespace ESM
 
 namespace osg
 {
+    class Stats;
     class Vec3f;
 }
 
@@ -41,10 +45,12 @@ namespace MWMechanics
     class Actors
     {
     public:
-        std::list<Actor>::const_iterator begin() const { return mActors.begin(); }
-        std::list<Actor>::const_iterator end() const { return mActors.end(); }
+        ActorStore::const_iterator begin() const { return mActors.begin(); }
+        std::default_sentinel_t end() const { return mActors.end(); }
         std::size_t size() const { return mActors.size(); }
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void notifyDied(const MWWorld::Ptr& actor);
 
         /// Check if the target actor was detected by an observer
@@ -72,6 +78,11 @@ namespace MWMechanics
         void updateActor(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) const;
         ///< Updates an actor with a new Ptr
 
+        void updatePosition(const MWWorld::Ptr& ptr);
+        ///< Record the new position of a moved actor for range queries
+        ///
+        /// \note Ignored, if \a ptr is not a registered actor.
+
         void dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore);
         ///< Deregister all actors (except for \a ignore) in the given cell.
 
@@ -152,6 +163,9 @@ namespace MWMechanics
         /// Unlike getActorsFighting, also returns actors that *would* fight the given actor if they saw him.
         std::vector<MWWorld::Ptr> getEnemiesNearby(const MWWorld::Ptr& actor) const;
 
+        /// @return Actor in the scene with the given actor id or empty Ptr if there is no such actor
+        MWWorld::Ptr searchActorViaActorId(int actorId) const;
+
         void write(ESM::ESMWriter& writer, Loading::Listener& listener) const;
 
         void readRecord(ESM::ESMReader& reader, uint32_t type);
@@ -169,8 +183,12 @@ namespace MWMechanics
 
     private:
         std::map<ESM::RefId, int> mDeathCount;
-        std::list<Actor> mActors;
-        std::map<const MWWorld::LiveCellRefBase*, std::list<Actor>::iterator> mIndex;
+        ActorStore mActors;
+        std::unordered_map<const MWWorld::LiveCellRefBase*, Actor*> mIndex;
+        std::unordered_map<int, Actor*> mActorIdIndex;
+        // Positions of the registered actors for range queries, kept up to date by updatePosition
+        static constexpr float sGridCellSize = 1024;
+        SpatialGrid<const Actor*> mGrid{ sGridCellSize };
         // We should add a delay between summoned creature death and its corpse despawning
         float mTimerDisposeSummonsCorpses = 0.2f;
         float mTimerUpdateHeadTrack = 0;
@@ -178,9 +196,14 @@ namespace MWMechanics
         float mTimerUpdateHello = 0;
         float mSneakTimer = 0; // Times update of sneak icon
         float mSneakSkillTimer = 0; // Times sneak skill progress from "avoid notice"
+        unsigned mAiFrame = 0;
+        // Actors updated at full, visible and hidden AI rate during the last frame, and the skipped AI updates
+        std::array<std::size_t, 4> mAiLodStats{};
 
         void updateVisibility(const MWWorld::Ptr& ptr, CharacterController& ctrl) const;
 
+        void eraseActorId(const Actor& actor);
+
         void adjustMagicEffects(const MWWorld::Ptr& creature, float duration) const;
 
         void calculateRestoration(const MWWorld::Ptr& ptr, float duration) const;
@@ -193,6 +216,13 @@ namespace MWMechanics
 
         void predictAndAvoidCollisions(float duration) const;
 
+        /// Run the AI packages, or skip them during this frame if the actor is far enough to update less often
+        void executeAiPackages(Actor& actor, float distanceToPlayerSqr, float duration);
+
+        /// Rate the combat targets of the actors in range on several threads, before the AI update uses the ratings
+        /// to choose the targets.
+        void rateCombatTargets(const osg::Vec3f& playerPos, float processingRange) const;
+
         /** Start combat between two actors
             @Notes: If againstPlayer = true then actor2 should be the Player.
                     If one of the combatants is creature it should be actor1.
@@ -0,0 +1,167 @@
+#ifndef OPENMW_MWMECHANICS_ACTORSTORE_H
+#define OPENMW_MWMECHANICS_ACTORSTORE_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "actor.hpp"
+
+namespace MWMechanics
+{
+    /// @brief Actors kept in chunks of contiguous slots instead of a heap node each.
+    /// @par Actors never move, references to them are valid until they are erased. Erased slots are reused by the next
+    /// actors. Iterators refer to slots by index and are not invalidated by emplacing, actors emplaced in a new slot
+    /// while iterating are visited by the same iteration.
+    class ActorStore
+    {
+        template <class Store, class Value>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Actor;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            Iterator() = default;
+
+            Iterator(Store& store, std::size_t slot)
+                : mStore(&store)
+                , mSlot(store.findOccupied(slot))
+            {
+            }
+
+            std::size_t getSlot() const { return mSlot; }
+
+            reference operator*() const { return mStore->get(mSlot); }
+
+            pointer operator->() const { return &mStore->get(mSlot); }
+
+            Iterator& operator++()
+            {
+                mSlot = mStore->findOccupied(mSlot + 1);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const Iterator& other) const = default;
+
+            friend bool operator==(const Iterator& iterator, std::default_sentinel_t)
+            {
+                return iterator.isEnd();
+            }
+
+        private:
+            Store* mStore = nullptr;
+            std::size_t mSlot = 0;
+
+            bool isEnd() const { return mSlot >= mStore->mOccupied.size(); }
+        };
+
+    public:
+        using iterator = Iterator<ActorStore, Actor>;
+        using const_iterator = Iterator<const ActorStore, const Actor>;
+
+        template <class... Args>
+        Actor& emplace(Args&&... args)
+        {
+            std::size_t slot;
+            if (!mFree.empty())
+            {
+                slot = mFree.back();
+                mFree.pop_back();
+            }
+            else
+            {
+                slot = mOccupied.size();
+                if (slot % sChunkSize == 0)
+                    mChunks.push_back(std::make_unique<Chunk>());
+                mOccupied.push_back(false);
+            }
+
+            try
+            {
+                getSlot(slot).emplace(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                mFree.push_back(slot);
+                throw;
+            }
+
+            mOccupied[slot] = true;
+            ++mSize;
+            return *getSlot(slot);
+        }
+
+        /// Destroy the actor at the position of the iterator, the iterator can still be incremented.
+        void erase(const iterator& it)
+        {
+            const std::size_t slot = it.getSlot();
+            getSlot(slot).reset();
+            mOccupied[slot] = false;
+            mFree.push_back(slot);
+            --mSize;
+        }
+
+        void clear()
+        {
+            mChunks.clear();
+            mOccupied.clear();
+            mFree.clear();
+            mSize = 0;
+        }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        iterator begin() { return iterator(*this, 0); }
+        const_iterator begin() const { return const_iterator(*this, 0); }
+
+        std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    private:
+        static constexpr std::size_t sChunkSize = 32;
+        using Chunk = std::array<std::optional<Actor>, sChunkSize>;
+
+        // Chunks are never reallocated, unlike the storage of a vector of actors would be
+        std::vector<std::unique_ptr<Chunk>> mChunks;
+        // Kept apart from the actors, so skipping the free slots does not touch them
+        std::vector<bool> mOccupied;
+        std::vector<std::size_t> mFree;
+        std::size_t mSize = 0;
+
+        std::optional<Actor>& getSlot(std::size_t slot) { return (*mChunks[slot / sChunkSize])[slot % sChunkSize]; }
+
+        const std::optional<Actor>& getSlot(std::size_t slot) const
+        {
+            return (*mChunks[slot / sChunkSize])[slot % sChunkSize];
+        }
+
+        Actor& get(std::size_t slot) { return *getSlot(slot); }
+
+        const Actor& get(std::size_t slot) const { return *getSlot(slot); }
+
+        std::size_t findOccupied(std::size_t slot) const
+        {
+            while (slot < mOccupied.size() && !mOccupied[slot])
+                ++slot;
+            return slot;
+        }
+    };
+}
+
+#endif
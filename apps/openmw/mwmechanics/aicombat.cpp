@@ -212,7 +212,8 @@ namespace MWMechanics
 
             if (characterController.readyToPrepareAttack())
             {
-                currentAction = prepareNextAction(actor, target);
+                storage.mActionCandidates.update(actor);
+                currentAction = prepareNextAction(actor, target, storage.mActionCandidates);
                 actionCooldown = currentAction->getActionCooldown();
             }
         }
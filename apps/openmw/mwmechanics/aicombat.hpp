@@ -36,6 +36,7 @@ namespace MWMechanics
         osg::Vec3f mLastTargetPos;
         const MWWorld::CellStore* mCell;
         std::unique_ptr<Action> mCurrentAction;
+        CombatActionCandidates mActionCandidates;
         float mActionCooldown;
         float mStrength;
         bool mForceNoShortcut;
@@ -162,7 +162,71 @@ namespace MWMechanics
         return mWeapon.get<ESM::Weapon>()->mBase;
     }
 
-    std::unique_ptr<Action> prepareNextAction(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    namespace
+    {
+        // Items are removed from the store by setting their count to 0, which changes its revision, so this only
+        // guards against counts changed behind the back of the store
+        bool isAvailable(const MWWorld::Ptr& item)
+        {
+            return item.getCellRef().getCount() != 0;
+        }
+
+        float rateAmmoCandidates(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy,
+            const std::vector<MWWorld::Ptr>& ammo, int ammoType, MWWorld::Ptr& bestAmmo)
+        {
+            float bestAmmoRating = 0.f;
+            for (const MWWorld::Ptr& item : ammo)
+            {
+                if (!isAvailable(item))
+                    continue;
+                float rating = rateWeapon(item, actor, enemy, ammoType);
+                if (rating > bestAmmoRating)
+                {
+                    bestAmmoRating = rating;
+                    bestAmmo = item;
+                }
+            }
+            return bestAmmoRating;
+        }
+    }
+
+    void CombatActionCandidates::update(const MWWorld::Ptr& actor)
+    {
+        MWWorld::ContainerStore& store = actor.getClass().getContainerStore(actor);
+        if (mStore == &store && mRevision == store.getRevision())
+            return;
+
+        mStore = &store;
+        mRevision = store.getRevision();
+        mPotions.clear();
+        mMagicItems.clear();
+        mWeapons.clear();
+        mArrows.clear();
+        mBolts.clear();
+
+        const bool hasInventoryStore = actor.getClass().hasInventoryStore(actor);
+        for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+        {
+            if (it->getType() == ESM::Potion::sRecordId)
+                mPotions.push_back(*it);
+            // TODO remove inventory store check, creatures should be able to use enchanted items they cannot equip
+            else if (hasInventoryStore && !it->getClass().getEnchantment(*it).empty())
+                mMagicItems.push_back(it);
+
+            if (!hasInventoryStore || it->getType() != ESM::Weapon::sRecordId)
+                continue;
+            const int type = it->get<ESM::Weapon>()->mBase->mData.mType;
+            if (type == ESM::Weapon::Arrow)
+                mArrows.push_back(*it);
+            else if (type == ESM::Weapon::Bolt)
+                mBolts.push_back(*it);
+            else
+                mWeapons.push_back(*it);
+        }
+    }
+
+    std::unique_ptr<Action> prepareNextAction(
+        const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, const CombatActionCandidates& candidates)
     {
         Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
 
@@ -176,59 +240,57 @@ namespace MWMechanics
             return bestAction;
         }
 
-        const bool hasInventoryStore = actor.getClass().hasInventoryStore(actor);
-        MWWorld::ContainerStore& store = actor.getClass().getContainerStore(actor);
-        for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+        for (const MWWorld::Ptr& potion : candidates.mPotions)
         {
-            if (it->getType() == ESM::Potion::sRecordId)
+            if (!isAvailable(potion))
+                continue;
+            float rating = ratePotion(potion, actor);
+            if (rating > bestActionRating)
             {
-                float rating = ratePotion(*it, actor);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                    bestAction = std::make_unique<ActionPotion>(*it);
-                    antiFleeRating = std::numeric_limits<float>::max();
-                }
+                bestActionRating = rating;
+                bestAction = std::make_unique<ActionPotion>(potion);
+                antiFleeRating = std::numeric_limits<float>::max();
             }
-            // TODO remove inventory store check, creatures should be able to use enchanted items they cannot equip
-            else if (hasInventoryStore && !it->getClass().getEnchantment(*it).empty())
+        }
+
+        for (const MWWorld::ContainerStoreIterator& it : candidates.mMagicItems)
+        {
+            if (!isAvailable(*it))
+                continue;
+            float rating = rateMagicItem(*it, actor, enemy);
+            if (rating > bestActionRating)
             {
-                float rating = rateMagicItem(*it, actor, enemy);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                    bestAction = std::make_unique<ActionEnchantedItem>(it);
-                    antiFleeRating = std::numeric_limits<float>::max();
-                }
+                bestActionRating = rating;
+                bestAction = std::make_unique<ActionEnchantedItem>(it);
+                antiFleeRating = std::numeric_limits<float>::max();
             }
         }
 
-        if (hasInventoryStore)
-        {
-            MWWorld::Ptr bestArrow;
-            float bestArrowRating = rateAmmo(actor, enemy, bestArrow, ESM::Weapon::Arrow);
+        MWWorld::Ptr bestArrow;
+        float bestArrowRating = rateAmmoCandidates(actor, enemy, candidates.mArrows, ESM::Weapon::Arrow, bestArrow);
 
-            MWWorld::Ptr bestBolt;
-            float bestBoltRating = rateAmmo(actor, enemy, bestBolt, ESM::Weapon::Bolt);
+        MWWorld::Ptr bestBolt;
+        float bestBoltRating = rateAmmoCandidates(actor, enemy, candidates.mBolts, ESM::Weapon::Bolt, bestBolt);
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+        for (const MWWorld::Ptr& item : candidates.mWeapons)
+        {
+            if (!isAvailable(item))
+                continue;
+            float rating = rateWeapon(item, actor, enemy, -1, bestArrowRating, bestBoltRating);
+            if (rating > bestActionRating)
             {
-                float rating = rateWeapon(*it, actor, enemy, -1, bestArrowRating, bestBoltRating);
-                if (rating > bestActionRating)
-                {
-                    const ESM::Weapon* weapon = it->get<ESM::Weapon>()->mBase;
-                    int ammotype = getWeaponType(weapon->mData.mType)->mAmmoType;
-
-                    MWWorld::Ptr ammo;
-                    if (ammotype == ESM::Weapon::Arrow)
-                        ammo = bestArrow;
-                    else if (ammotype == ESM::Weapon::Bolt)
-                        ammo = bestBolt;
-
-                    bestActionRating = rating;
-                    bestAction = std::make_unique<ActionWeapon>(*it, ammo);
-                    antiFleeRating = vanillaRateWeaponAndAmmo(*it, ammo, actor, enemy);
-                }
+                const ESM::Weapon* weapon = item.get<ESM::Weapon>()->mBase;
+                int ammotype = getWeaponType(weapon->mData.mType)->mAmmoType;
+
+                MWWorld::Ptr ammo;
+                if (ammotype == ESM::Weapon::Arrow)
+                    ammo = bestArrow;
+                else if (ammotype == ESM::Weapon::Bolt)
+                    ammo = bestBolt;
+
+                bestActionRating = rating;
+                bestAction = std::make_unique<ActionWeapon>(item, ammo);
+                antiFleeRating = vanillaRateWeaponAndAmmo(item, ammo, actor, enemy);
             }
         }
 
@@ -252,7 +314,8 @@ namespace MWMechanics
         return bestAction;
     }
 
-    float getBestActionRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    float getBestActionRating(
+        const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, const CombatActionCandidates& candidates)
     {
         Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
 
@@ -263,30 +326,30 @@ namespace MWMechanics
             return bestActionRating;
         }
 
-        if (actor.getClass().hasInventoryStore(actor))
+        for (const MWWorld::ContainerStoreIterator& it : candidates.mMagicItems)
         {
-            MWWorld::InventoryStore& store = actor.getClass().getInventoryStore(actor);
-
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            if (!isAvailable(*it))
+                continue;
+            float rating = rateMagicItem(*it, actor, enemy);
+            if (rating > bestActionRating)
             {
-                float rating = rateMagicItem(*it, actor, enemy);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                }
+                bestActionRating = rating;
             }
+        }
 
-            float bestArrowRating = rateAmmo(actor, enemy, ESM::Weapon::Arrow);
+        MWWorld::Ptr bestAmmo;
+        float bestArrowRating = rateAmmoCandidates(actor, enemy, candidates.mArrows, ESM::Weapon::Arrow, bestAmmo);
 
-            float bestBoltRating = rateAmmo(actor, enemy, ESM::Weapon::Bolt);
+        float bestBoltRating = rateAmmoCandidates(actor, enemy, candidates.mBolts, ESM::Weapon::Bolt, bestAmmo);
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+        for (const MWWorld::Ptr& item : candidates.mWeapons)
+        {
+            if (!isAvailable(item))
+                continue;
+            float rating = rateWeapon(item, actor, enemy, -1, bestArrowRating, bestBoltRating);
+            if (rating > bestActionRating)
             {
-                float rating = rateWeapon(*it, actor, enemy, -1, bestArrowRating, bestBoltRating);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                }
+                bestActionRating = rating;
             }
         }
 
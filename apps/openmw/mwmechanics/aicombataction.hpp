@@ -1,7 +1,9 @@
 #ifndef OPENMW_AICOMBAT_ACTION_H
 #define OPENMW_AICOMBAT_ACTION_H
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "../mwworld/containerstore.hpp"
 #include "../mwworld/ptr.hpp"
@@ -99,8 +101,27 @@ namespace MWMechanics
         const ESM::Weapon* getWeapon() const override;
     };
 
-    std::unique_ptr<Action> prepareNextAction(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
-    float getBestActionRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
+    /// @brief Items of an actor worth rating as combat actions, collected again only when its inventory changes.
+    struct CombatActionCandidates
+    {
+        const MWWorld::ContainerStore* mStore = nullptr;
+        std::uint64_t mRevision = 0;
+        std::vector<MWWorld::Ptr> mPotions;
+        std::vector<MWWorld::ContainerStoreIterator> mMagicItems;
+        std::vector<MWWorld::Ptr> mWeapons;
+        std::vector<MWWorld::Ptr> mArrows;
+        std::vector<MWWorld::Ptr> mBolts;
+
+        /// Collect the items again if the inventory of the actor changed since the last update.
+        void update(const MWWorld::Ptr& actor);
+    };
+
+    std::unique_ptr<Action> prepareNextAction(
+        const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, const CombatActionCandidates& candidates);
+
+    /// @note Only reads the actors and the candidates, which must be up to date.
+    float getBestActionRating(
+        const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, const CombatActionCandidates& candidates);
 
     float getDistanceMinusHalfExtents(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool minusZDist = false);
     float getMaxAttackDistance(const MWWorld::Ptr& actor);
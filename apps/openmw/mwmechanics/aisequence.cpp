@@ -233,17 +233,45 @@ namespace MWMechanics
         return mDone;
     }
 
+    const CombatActionCandidates& AiSequence::getCombatActionCandidates(const MWWorld::Ptr& actor)
+    {
+        assert(getTypeId() == AiPackageTypeId::Combat);
+        CombatActionCandidates& candidates = mAiState.get<AiCombatStorage>().mActionCandidates;
+        candidates.update(actor);
+        return candidates;
+    }
+
+    void AiSequence::setCombatTargetRatings(
+        std::vector<std::pair<const MWWorld::LiveCellRefBase*, float>>&& ratings)
+    {
+        mCombatTargetRatings = std::move(ratings);
+    }
+
     namespace
     {
         bool isActualAiPackage(AiPackageTypeId packageTypeId)
         {
             return (packageTypeId >= AiPackageTypeId::Wander && packageTypeId <= AiPackageTypeId::Activate);
         }
+
+        float getCombatTargetRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& target,
+            const std::vector<std::pair<const MWWorld::LiveCellRefBase*, float>>& ratings,
+            const CombatActionCandidates& candidates)
+        {
+            const auto it = std::find_if(
+                ratings.begin(), ratings.end(), [&](const auto& rating) { return rating.first == target.mRef; });
+            if (it != ratings.end())
+                return it->second;
+            return MWMechanics::getBestActionRating(actor, target, candidates);
+        }
     }
 
     void AiSequence::execute(
         const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange)
     {
+        // Ratings are only valid for the frame they were computed for
+        const auto combatTargetRatings = std::exchange(mCombatTargetRatings, {});
+
         if (actor == getPlayer())
         {
             // Players don't use this.
@@ -279,6 +307,7 @@ namespace MWMechanics
             osg::Vec3f vActorPos = actor.getRefData().getPosition().asVec3();
 
             float bestRating = 0.f;
+            const CombatActionCandidates& candidates = getCombatActionCandidates(actor);
 
             for (auto it = mPackages.begin(); it != mPackages.end();)
             {
@@ -296,7 +325,7 @@ namespace MWMechanics
                 {
                     float rating = 0.f;
                     if (MWMechanics::canFight(actor, target))
-                        rating = MWMechanics::getBestActionRating(actor, target);
+                        rating = getCombatTargetRating(actor, target, combatTargetRatings, candidates);
 
                     const ESM::Position& targetPos = target.getRefData().getPosition();
 
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "aipackagetypeid.hpp"
@@ -13,6 +14,7 @@
 namespace MWWorld
 {
     class Ptr;
+    class LiveCellRefBase;
 }
 
 namespace ESM
@@ -27,6 +29,7 @@ namespace MWMechanics
 {
     class AiPackage;
     class CharacterController;
+    struct CombatActionCandidates;
 
     using AiPackages = std::vector<std::shared_ptr<AiPackage>>;
 
@@ -51,6 +54,9 @@ namespace MWMechanics
         AiPackageTypeId mLastAiPackage;
         AiState mAiState;
 
+        /// Best action ratings against the combat targets, computed ahead of the next execute
+        std::vector<std::pair<const MWWorld::LiveCellRefBase*, float>> mCombatTargetRatings;
+
         void onPackageAdded(const AiPackage& package);
         void onPackageRemoved(const AiPackage& package);
 
@@ -145,6 +151,14 @@ namespace MWMechanics
         /// Removes all pursue packages until first non-pursue or stack empty.
         void stopPursuit();
 
+        /// Items of the actor worth rating as combat actions, brought up to date.
+        /** Only available while a combat package is the current one. **/
+        const CombatActionCandidates& getCombatActionCandidates(const MWWorld::Ptr& actor);
+
+        /// Use these best action ratings against the combat targets to choose the target during the next execute.
+        /** Targets without a rating are rated by execute itself. **/
+        void setCombatTargetRatings(std::vector<std::pair<const MWWorld::LiveCellRefBase*, float>>&& ratings);
+
         /// Execute current package, switching if needed.
         void execute(const MWWorld::Ptr& actor, CharacterController& characterController, float duration,
             bool outOfRange = false);
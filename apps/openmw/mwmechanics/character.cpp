@@ -3016,6 +3016,12 @@ namespace MWMechanics
             mAnimation->setActive(active);
     }
 
+    void CharacterController::setAnimationUpdateInterval(unsigned int interval, unsigned int phase) const
+    {
+        if (mAnimation)
+            mAnimation->setUpdateInterval(interval, phase);
+    }
+
     void CharacterController::setHeadTrackTarget(const MWWorld::ConstPtr& target)
     {
         mHeadTrackTarget = target;
@@ -1,9 +1,11 @@
+#include <algorithm>
+#include <iterator>
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadlevlist.hpp>
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/esmstore.hpp"
-#include "../mwworld/manualref.hpp"
 #include "../mwworld/ptr.hpp"
 
 #include "../mwbase/environment.hpp"
@@ -33,7 +35,6 @@ namespace MWMechanics
         if (Misc::Rng::roll0to99(prng) < levItem->mChanceNone)
             return ESM::RefId();
 
-        std::vector<const ESM::RefId*> candidates;
         int highestLevel = 0;
         for (const auto& levelledItem : items)
         {
@@ -46,36 +47,34 @@ namespace MWMechanics
         if (creature)
             allLevels = levItem->mFlags & ESM::CreatureLevList::AllLevels;
 
-        for (const auto& levelledItem : items)
-        {
-            if (playerLevel >= levelledItem.mLevel && (allLevels || levelledItem.mLevel == highestLevel))
-                candidates.push_back(&levelledItem.mId);
-        }
-        if (candidates.empty())
+        const auto isCandidate = [&](const ESM::LevelledListBase::LevelItem& levelledItem) {
+            return playerLevel >= levelledItem.mLevel && (allLevels || levelledItem.mLevel == highestLevel);
+        };
+
+        // Candidates are counted and then picked by index, there is no need to collect them
+        const auto candidatesCount = std::count_if(items.begin(), items.end(), isCandidate);
+        if (candidatesCount == 0)
             return ESM::RefId();
-        const ESM::RefId& item = *candidates[Misc::Rng::rollDice(candidates.size(), prng)];
+        auto candidate = std::find_if(items.begin(), items.end(), isCandidate);
+        for (int i = Misc::Rng::rollDice(static_cast<int>(candidatesCount), prng); i > 0; --i)
+            candidate = std::find_if(std::next(candidate), items.end(), isCandidate);
+        const ESM::RefId& item = candidate->mId;
 
         // Vanilla doesn't fail on nonexistent items in levelled lists
-        if (!MWBase::Environment::get().getESMStore()->find(item))
+        const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
+        const int type = store.find(item);
+        if (type == 0)
         {
             Log(Debug::Warning) << "Warning: ignoring nonexistent item " << item << " in levelled list "
                                 << levItem->mId;
             return ESM::RefId();
         }
 
-        // Is this another levelled item or a real item?
-        MWWorld::ManualRef ref(*MWBase::Environment::get().getESMStore(), item, 1);
-        if (ref.getPtr().getType() != ESM::ItemLevList::sRecordId
-            && ref.getPtr().getType() != ESM::CreatureLevList::sRecordId)
-        {
-            return item;
-        }
-        else
-        {
-            if (ref.getPtr().getType() == ESM::ItemLevList::sRecordId)
-                return getLevelledItem(ref.getPtr().get<ESM::ItemLevList>()->mBase, false, prng, level);
-            else
-                return getLevelledItem(ref.getPtr().get<ESM::CreatureLevList>()->mBase, true, prng, level);
-        }
+        // Is this another levelled item or a real item? The record type is enough to tell, no reference is needed.
+        if (type == ESM::ItemLevList::sRecordId)
+            return getLevelledItem(store.get<ESM::ItemLevList>().find(item), false, prng, level);
+        if (type == ESM::CreatureLevList::sRecordId)
+            return getLevelledItem(store.get<ESM::CreatureLevList>().find(item), true, prng, level);
+        return item;
     }
 }
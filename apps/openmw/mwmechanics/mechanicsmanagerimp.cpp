@@ -287,6 +287,12 @@ namespace MWMechanics
             mObjects.updateObject(old, ptr);
     }
 
+    void MechanicsManager::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        if (ptr.getClass().isActor())
+            mActors.updatePosition(ptr);
+    }
+
     void MechanicsManager::drop(const MWWorld::CellStore* cellStore)
     {
         mActors.dropActors(cellStore, getPlayer());
@@ -1820,6 +1826,11 @@ namespace MWMechanics
         return mActors.getEnemiesNearby(actor);
     }
 
+    MWWorld::Ptr MechanicsManager::searchActorViaActorId(int actorId) const
+    {
+        return mActors.searchActorViaActorId(actorId);
+    }
+
     void MechanicsManager::getActorsFollowing(const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out)
     {
         mActors.getActorsFollowing(actor, out);
@@ -2053,6 +2064,7 @@ namespace MWMechanics
     {
         stats.setAttribute(frameNumber, "Mechanics Actors", mActors.size());
         stats.setAttribute(frameNumber, "Mechanics Objects", mObjects.size());
+        mActors.reportStats(frameNumber, stats);
     }
 
     int MechanicsManager::getGreetingTimer(const MWWorld::Ptr& ptr) const
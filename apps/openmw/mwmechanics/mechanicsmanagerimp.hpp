@@ -54,6 +54,9 @@ namespace MWMechanics
         void updateCell(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) override;
         ///< Moves an object to a new cell
 
+        void updatePosition(const MWWorld::Ptr& ptr) override;
+        ///< Notify that an object was moved
+
         void drop(const MWWorld::CellStore* cellStore) override;
         ///< Deregister all objects in the given cell.
 
@@ -169,6 +172,8 @@ namespace MWMechanics
         std::vector<MWWorld::Ptr> getActorsFighting(const MWWorld::Ptr& actor) override;
         std::vector<MWWorld::Ptr> getEnemiesNearby(const MWWorld::Ptr& actor) override;
 
+        MWWorld::Ptr searchActorViaActorId(int actorId) const override;
+
         /// Recursive version of getActorsFollowing
         void getActorsFollowing(const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out) override;
         /// Recursive version of getActorsSidingWith
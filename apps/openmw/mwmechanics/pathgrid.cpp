@@ -1,8 +1,11 @@
 #include "pathgrid.hpp"
 
 #include <algorithm>
-#include <list>
-#include <set>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <utility>
 
 namespace
 {
@@ -45,103 +48,172 @@ namespace
     }
 
     constexpr size_t NoIndex = static_cast<size_t>(-1);
+
+    constexpr float NoCost = std::numeric_limits<float>::infinity();
+
+    // Small pathgrids are searched fast enough with the distance heuristic alone
+    constexpr size_t MinPointsForLandmarks = 32;
+    constexpr size_t MaxLandmarks = 4;
+
+    using QueueEntry = std::pair<float, size_t>; // cost, point index
+    using Queue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>>;
 }
 
 namespace MWMechanics
 {
-
+    /*
+     * mComponentIds contains the strongly connected component group id's.
+     *
+     * A cell can have disjointed pathgrids, e.g. Seyda Neen has 3
+     *
+     * mComponentIds for Seyda Neen will therefore have 3 different values.
+     * When selecting a random pathgrid point for AiWander, mComponentIds can
+     * be checked for quickly finding whether the destination is reachable.
+     *
+     * Otherwise, buildPath can automatically select a closest reachable end
+     * pathgrid point (reachable from the closest start point).
+     *
+     * Using Tarjan's algorithm without recursion, so large pathgrids can't
+     * overflow the stack:
+     *
+     *  edges of v  | E (for v) |
+     *  index       | tracking smallest unused index
+     *  stack       | S         |
+     *  calls       | vertices being visited with their next edge
+     */
     class PathgridGraph::Builder
     {
-        std::vector<Node>& mGraph;
+    public:
+        static void findComponents(PathgridGraph& graph)
+        {
+            const size_t pointsSize = graph.mEdgeOffsets.size() - 1;
+            graph.mComponentIds.assign(pointsSize, -1);
 
-        // variables used to calculate connected components
-        int mSCCId = 0;
-        size_t mSCCIndex = 0;
-        std::vector<size_t> mSCCStack;
-        std::vector<std::pair<size_t, size_t>> mSCCPoint; // first is index, second is lowlink
+            struct Call
+            {
+                size_t mPoint;
+                size_t mEdge;
+            };
 
-        // v is the pathgrid point index (some call them vertices)
-        void recursiveStrongConnect(const size_t v)
-        {
-            mSCCPoint[v].first = mSCCIndex; // index
-            mSCCPoint[v].second = mSCCIndex; // lowlink
-            mSCCIndex++;
-            mSCCStack.push_back(v);
-            size_t w;
+            int componentId = 0;
+            size_t nextIndex = 0;
+            std::vector<size_t> indexes(pointsSize, NoIndex);
+            std::vector<size_t> lowlinks(pointsSize, NoIndex);
+            std::vector<bool> onStack(pointsSize, false);
+            std::vector<size_t> stack;
+            std::vector<Call> calls;
+            stack.reserve(pointsSize);
 
-            for (const auto& edge : mGraph[v].edges)
+            const auto visit = [&](size_t v) {
+                indexes[v] = nextIndex;
+                lowlinks[v] = nextIndex;
+                ++nextIndex;
+                stack.push_back(v);
+                onStack[v] = true;
+                calls.push_back(Call{ v, graph.mEdgeOffsets[v] });
+            };
+
+            for (size_t root = 0; root < pointsSize; ++root)
             {
-                w = edge.index;
-                if (mSCCPoint[w].first == NoIndex) // not visited
+                if (indexes[root] != NoIndex) // already visited
+                    continue;
+
+                visit(root);
+
+                while (!calls.empty())
                 {
-                    recursiveStrongConnect(w); // recurse
-                    mSCCPoint[v].second = std::min(mSCCPoint[v].second, mSCCPoint[w].second);
+                    const size_t v = calls.back().mPoint;
+
+                    if (calls.back().mEdge < graph.mEdgeOffsets[v + 1])
+                    {
+                        const size_t w = graph.mEdges[calls.back().mEdge++].index;
+                        if (indexes[w] == NoIndex) // not visited
+                            visit(w);
+                        else if (onStack[w])
+                            lowlinks[v] = std::min(lowlinks[v], indexes[w]);
+                        continue;
+                    }
+
+                    calls.pop_back();
+                    if (!calls.empty())
+                    {
+                        const size_t parent = calls.back().mPoint;
+                        lowlinks[parent] = std::min(lowlinks[parent], lowlinks[v]);
+                    }
+
+                    if (lowlinks[v] == indexes[v])
+                    { // new component
+                        size_t w;
+                        do
+                        {
+                            w = stack.back();
+                            stack.pop_back();
+                            onStack[w] = false;
+                            graph.mComponentIds[w] = componentId;
+                        } while (w != v);
+                        ++componentId;
+                    }
                 }
-                else if (std::find(mSCCStack.begin(), mSCCStack.end(), w) != mSCCStack.end())
-                    mSCCPoint[v].second = std::min(mSCCPoint[v].second, mSCCPoint[w].first);
             }
+        }
 
-            if (mSCCPoint[v].second == mSCCPoint[v].first)
-            { // new component
-                do
+        // Dijkstra from the point over the whole graph, unreachable points keep NoCost
+        static void findCosts(const PathgridGraph& graph, size_t source, std::span<float> costs)
+        {
+            std::fill(costs.begin(), costs.end(), NoCost);
+            costs[source] = 0;
+            Queue queue;
+            queue.emplace(0.0f, source);
+            while (!queue.empty())
+            {
+                const auto [cost, current] = queue.top();
+                queue.pop();
+                if (cost > costs[current])
+                    continue;
+                for (const ConnectedPoint& edge : graph.getEdges(current))
                 {
-                    w = mSCCStack.back();
-                    mSCCStack.pop_back();
-                    mGraph[w].componentId = mSCCId;
-                } while (w != v);
-                mSCCId++;
+                    const float tentative = cost + edge.cost;
+                    if (tentative < costs[edge.index])
+                    {
+                        costs[edge.index] = tentative;
+                        queue.emplace(tentative, edge.index);
+                    }
+                }
             }
         }
 
-    public:
-        /*
-         * mGraph contains the strongly connected component group id's along
-         * with pre-calculated edge costs.
-         *
-         * A cell can have disjointed pathgrids, e.g. Seyda Neen has 3
-         *
-         * mGraph for Seyda Neen will therefore have 3 different values.  When
-         * selecting a random pathgrid point for AiWander, mGraph can be checked
-         * for quickly finding whether the destination is reachable.
-         *
-         * Otherwise, buildPath can automatically select a closest reachable end
-         * pathgrid point (reachable from the closest start point).
-         *
-         * Using Tarjan's algorithm:
-         *
-         *  mGraph                   | graph G   |
-         *  mSCCPoint                | V         | derived from mPoints
-         *  mGraph[v].edges          | E (for v) |
-         *  mSCCIndex                | index     | tracking smallest unused index
-         *  mSCCStack                | S         |
-         *  mGraph[v].edges[i].index | w         |
-         *
-         */
-        explicit Builder(PathgridGraph& graph)
-            : mGraph(graph.mGraph)
+        // Each next landmark is the point the farthest from the previous ones, points unreachable from them first,
+        // so the landmarks end up at the borders of the pathgrid and in each of its parts
+        static void findLandmarks(PathgridGraph& graph)
         {
-            // both of these are set to zero in the constructor
-            // mSCCId = 0; // how many strongly connected components in this cell
-            // mSCCIndex = 0;
-            size_t pointsSize = graph.mPathgrid->mPoints.size();
-            mSCCPoint.resize(pointsSize, std::pair<size_t, size_t>(NoIndex, NoIndex));
-            mSCCStack.reserve(pointsSize);
-
-            for (size_t v = 0; v < pointsSize; ++v)
+            const size_t pointsSize = graph.mComponentIds.size();
+            if (pointsSize < MinPointsForLandmarks)
+                return;
+
+            graph.mLandmarks = MaxLandmarks;
+            graph.mLandmarkCosts.resize(MaxLandmarks * pointsSize);
+            std::vector<float> minCosts(pointsSize, NoCost);
+            size_t landmark = 0;
+            for (size_t i = 0; i < MaxLandmarks; ++i)
             {
-                if (mSCCPoint[v].first == NoIndex) // undefined (haven't visited)
-                    recursiveStrongConnect(v);
+                const std::span<float> costs = std::span(graph.mLandmarkCosts).subspan(i * pointsSize, pointsSize);
+                findCosts(graph, landmark, costs);
+                for (size_t point = 0; point < pointsSize; ++point)
+                    minCosts[point] = std::min(minCosts[point], costs[point]);
+                landmark = static_cast<size_t>(
+                    std::distance(minCosts.begin(), std::max_element(minCosts.begin(), minCosts.end())));
             }
         }
     };
 
     /*
-     * mGraph is populated with the cost of each allowed edge.
+     * mEdges is populated with the cost of each allowed edge, grouped by the
+     * point they start from.
      *
      * The data structure is based on the code in buildPath2() but modified.
      * Please check git history if interested.
      *
-     * mGraph[v].edges[i].index = w
+     * getEdges(v)[i].index = w
      *
      *   v = point index of location "from"
      *   i = index of edges from point v
@@ -150,14 +222,14 @@ namespace MWMechanics
      *
      * Example: (notice from p(0) to p(2) is not allowed in this example)
      *
-     *   mGraph[0].edges[0].index = 1
-     *            .edges[1].index = 3
+     *   getEdges(0)[0].index = 1
+     *              [1].index = 3
      *
-     *   mGraph[1].edges[0].index = 0
-     *            .edges[1].index = 2
-     *            .edges[2].index = 3
+     *   getEdges(1)[0].index = 0
+     *              [1].index = 2
+     *              [2].index = 3
      *
-     *   mGraph[2].edges[0].index = 1
+     *   getEdges(2)[0].index = 1
      *
      *   (etc, etc)
      *
@@ -174,47 +246,67 @@ namespace MWMechanics
     PathgridGraph::PathgridGraph(const ESM::Pathgrid& pathgrid)
         : mPathgrid(&pathgrid)
     {
-        mGraph.resize(mPathgrid->mPoints.size());
+        const size_t pointsSize = mPathgrid->mPoints.size();
+        mEdgeOffsets.assign(pointsSize + 1, 0);
+        for (const auto& edge : mPathgrid->mEdges)
+            ++mEdgeOffsets[edge.mV0 + 1];
+        for (size_t v = 0; v < pointsSize; ++v)
+            mEdgeOffsets[v + 1] += mEdgeOffsets[v];
+
+        // only the forward path of each edge, ESM already contains the required reverse paths
+        mEdges.resize(mPathgrid->mEdges.size());
+        std::vector<size_t> next(mEdgeOffsets.begin(), mEdgeOffsets.end() - 1);
         for (const auto& edge : mPathgrid->mEdges)
         {
-            ConnectedPoint neighbour;
-            neighbour.cost = costAStar(mPathgrid->mPoints[edge.mV0], mPathgrid->mPoints[edge.mV1]);
-            // forward path of the edge
+            ConnectedPoint& neighbour = mEdges[next[edge.mV0]++];
             neighbour.index = edge.mV1;
-            mGraph[edge.mV0].edges.push_back(neighbour);
-            // reverse path of the edge
-            // NOTE: These are redundant, ESM already contains the required reverse paths
-            // neighbour.index = edge.mV0;
-            // mGraph[edge.mV1].edges.push_back(neighbour);
+            neighbour.cost = costAStar(mPathgrid->mPoints[edge.mV0], mPathgrid->mPoints[edge.mV1]);
         }
-        Builder(*this);
+
+        Builder::findComponents(*this);
+        Builder::findLandmarks(*this);
     }
 
     const PathgridGraph PathgridGraph::sEmpty = {};
 
     bool PathgridGraph::isPointConnected(const size_t start, const size_t end) const
     {
-        return (mGraph[start].componentId == mGraph[end].componentId);
+        return (mComponentIds[start] == mComponentIds[end]);
     }
 
     void PathgridGraph::getNeighbouringPoints(const size_t index, ESM::Pathgrid::PointList& nodes) const
     {
-        for (const auto& edge : mGraph[index].edges)
+        for (const auto& edge : getEdges(index))
         {
             if (edge.index != index)
                 nodes.push_back(mPathgrid->mPoints[edge.index]);
         }
     }
 
+    // Neither the distance nor the landmark bounds overestimate the cost, so neither does the largest of them
+    float PathgridGraph::getHeuristic(const size_t index, const size_t goal) const
+    {
+        float result = costAStar(mPathgrid->mPoints[index], mPathgrid->mPoints[goal]);
+        const size_t pointsSize = mComponentIds.size();
+        for (size_t i = 0; i < mLandmarks; ++i)
+        {
+            const float toIndex = mLandmarkCosts[i * pointsSize + index];
+            const float toGoal = mLandmarkCosts[i * pointsSize + goal];
+            if (toIndex != NoCost && toGoal != NoCost)
+                result = std::max(result, toGoal - toIndex);
+        }
+        return result;
+    }
+
     /*
      * NOTE: Based on buildPath2(), please check git history if interested
-     *       Should consider using a 3rd party library version (e.g. boost)
      *
      * Find the shortest path to the target goal using a well known algorithm.
-     * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
-     * that mGraph is already constructed.
+     * Uses mEdges which has pre-computed costs for allowed edges and the
+     * landmark costs to direct the search.  It is assumed that the graph is
+     * already constructed.
      *
-     * Should be possible to make this MT safe.
+     * MT safe, the search state is local.
      *
      * Returns path which may be empty.  path contains pathgrid points in local
      * cell coordinates (indoors) or world coordinates (external).
@@ -223,15 +315,10 @@ namespace MWMechanics
      *   start, goal - pathgrid point indexes (for this cell)
      *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
+     *   openset - point indexes to be traversed with their estimated costs,
+     *             lowest cost at the top, outdated entries are skipped
      *   closedset - point indexes already traversed
      *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
-     *
-     * TODO: An interesting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
      */
     std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
     {
@@ -241,59 +328,45 @@ namespace MWMechanics
             return path; // there is no path, return an empty path
         }
 
-        size_t graphSize = mGraph.size();
-        std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
+        const size_t graphSize = mComponentIds.size();
+        std::vector<float> gScore(graphSize, NoCost);
         std::vector<size_t> graphParent(graphSize, NoIndex);
+        std::vector<bool> closedset(graphSize, false);
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
         gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
 
-        std::list<size_t> openset;
-        std::set<size_t> closedset;
-        openset.push_back(start);
+        Queue openset;
+        openset.emplace(getHeuristic(start, goal), start);
 
         size_t current = start;
 
         while (!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            current = openset.top().second; // top has the lowest cost
+            openset.pop();
 
             if (current == goal)
                 break;
 
-            closedset.insert(current); // remember we've been here
+            if (closedset[current])
+                continue; // reached again through a cheaper edge before
+
+            closedset[current] = true; // remember we've been here
 
             // check all edges for the current point index
-            for (const auto& edge : mGraph[current].edges)
+            for (const auto& edge : getEdges(current))
             {
-                if (!closedset.contains(edge.index))
+                const size_t dest = edge.index;
+                if (closedset[dest])
+                    continue; // traversed this edge destination already, try the next edge
+
+                const float tentativeG = gScore[current] + edge.cost;
+                if (tentativeG < gScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    size_t dest = edge.index;
-                    float tentativeG = gScore[current] + edge.cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentativeG < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentativeG;
-                        fScore[dest] = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            auto it = openset.begin();
-                            for (; it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    graphParent[dest] = current;
+                    gScore[dest] = tentativeG;
+                    openset.emplace(tentativeG + getHeuristic(dest, goal), dest);
+                }
             }
         }
 
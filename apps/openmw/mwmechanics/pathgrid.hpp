@@ -2,6 +2,8 @@
 #define GAME_MWMECHANICS_PATHGRID_H
 
 #include <deque>
+#include <span>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -46,11 +48,10 @@ namespace MWMechanics
             float cost;
         };
 
-        struct Node // point
-        {
-            int componentId;
-            std::vector<ConnectedPoint> edges; // neighbours
-        };
+        // Edges of the point i are mEdges[mEdgeOffsets[i]] up to mEdges[mEdgeOffsets[i + 1]], so the neighbours of
+        // all points are in one allocation
+        std::vector<size_t> mEdgeOffsets;
+        std::vector<ConnectedPoint> mEdges;
 
         // componentId is an integer indicating the groups of connected
         // pathgrid points (all connected points will have the same value)
@@ -61,7 +62,19 @@ namespace MWMechanics
         //   48, 49, 50, 51, 84, 85, 86, 87, 88, 89, 90 (ship & office)
         //   all other pathgrid points are the third set
         //
-        std::vector<Node> mGraph;
+        std::vector<int> mComponentIds;
+
+        // Cost of the shortest path from each landmark to every point, mLandmarkCosts[landmark * points + point].
+        // The difference between the costs to two points bounds the cost between them from below (ALT heuristic).
+        size_t mLandmarks = 0;
+        std::vector<float> mLandmarkCosts;
+
+        std::span<const ConnectedPoint> getEdges(size_t index) const
+        {
+            return std::span(mEdges).subspan(mEdgeOffsets[index], mEdgeOffsets[index + 1] - mEdgeOffsets[index]);
+        }
+
+        float getHeuristic(size_t index, size_t goal) const;
     };
 }
 
@@ -0,0 +1,143 @@
+#ifndef OPENMW_MWMECHANICS_SPATIALGRID_H
+#define OPENMW_MWMECHANICS_SPATIALGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Vec3f>
+
+namespace MWMechanics
+{
+    /// @brief Uniform grid over the horizontal plane, to find the keys close to a position without visiting all of them.
+    /// @par Positions are only known to the grid when they are updated, a query reports the keys whose last recorded
+    /// position is within its range.
+    template <class Key>
+    class SpatialGrid
+    {
+    public:
+        explicit SpatialGrid(float cellSize)
+            : mCellSize(cellSize)
+        {
+        }
+
+        /// Insert the key or record its new position.
+        void update(const Key& key, const osg::Vec3f& position)
+        {
+            const std::uint64_t cell = getCell(position);
+            const auto [it, inserted] = mCellByKey.try_emplace(key, cell);
+            if (!inserted)
+            {
+                if (it->second == cell)
+                {
+                    for (Entry& entry : mCells[cell])
+                        if (entry.mKey == key)
+                            entry.mPosition = position;
+                    return;
+                }
+                removeFromCell(it->second, key);
+                it->second = cell;
+            }
+            mCells[cell].push_back(Entry{ key, position });
+        }
+
+        void erase(const Key& key)
+        {
+            const auto it = mCellByKey.find(key);
+            if (it == mCellByKey.end())
+                return;
+            removeFromCell(it->second, key);
+            mCellByKey.erase(it);
+        }
+
+        void clear()
+        {
+            mCells.clear();
+            mCellByKey.clear();
+        }
+
+        std::size_t size() const { return mCellByKey.size(); }
+
+        /// Call the function with each key and position within the radius, until it returns false.
+        template <class Function>
+        void forEachInRange(const osg::Vec3f& position, float radius, Function&& function) const
+        {
+            const float radius2 = radius * radius;
+            const auto visit = [&](const std::vector<Entry>& entries) {
+                for (const Entry& entry : entries)
+                    if ((entry.mPosition - position).length2() <= radius2 && !function(entry.mKey, entry.mPosition))
+                        return false;
+                return true;
+            };
+
+            const double minX = std::floor((position.x() - radius) / mCellSize);
+            const double maxX = std::floor((position.x() + radius) / mCellSize);
+            const double minY = std::floor((position.y() - radius) / mCellSize);
+            const double maxY = std::floor((position.y() + radius) / mCellSize);
+
+            // Cheaper to visit the occupied cells than to look up every cell of a large range
+            if ((maxX - minX + 1) * (maxY - minY + 1) > static_cast<double>(mCells.size()))
+            {
+                for (const auto& [cell, entries] : mCells)
+                    if (!visit(entries))
+                        return;
+                return;
+            }
+
+            for (int x = static_cast<int>(minX); x <= static_cast<int>(maxX); ++x)
+            {
+                for (int y = static_cast<int>(minY); y <= static_cast<int>(maxY); ++y)
+                {
+                    const auto it = mCells.find(makeCell(x, y));
+                    if (it != mCells.end() && !visit(it->second))
+                        return;
+                }
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            Key mKey;
+            osg::Vec3f mPosition;
+        };
+
+        float mCellSize;
+        std::unordered_map<std::uint64_t, std::vector<Entry>> mCells;
+        std::unordered_map<Key, std::uint64_t> mCellByKey;
+
+        static std::uint64_t makeCell(int x, int y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+                | static_cast<std::uint32_t>(y);
+        }
+
+        std::uint64_t getCell(const osg::Vec3f& position) const
+        {
+            return makeCell(static_cast<int>(std::floor(position.x() / mCellSize)),
+                static_cast<int>(std::floor(position.y() / mCellSize)));
+        }
+
+        void removeFromCell(std::uint64_t cell, const Key& key)
+        {
+            const auto it = mCells.find(cell);
+            if (it == mCells.end())
+                return;
+            std::vector<Entry>& entries = it->second;
+            const auto entry
+                = std::find_if(entries.begin(), entries.end(), [&](const Entry& value) { return value.mKey == key; });
+            if (entry != entries.end())
+            {
+                *entry = entries.back();
+                entries.pop_back();
+            }
+            if (entries.empty())
+                mCells.erase(it);
+        }
+    };
+}
+
+#endif
@@ -133,10 +133,7 @@ namespace MWMechanics
 
     float rateSpell(const ESM::Spell* spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool checkMagicka)
     {
-        float successChance = MWMechanics::getSpellSuccessChance(spell, actor, nullptr, true, checkMagicka);
-        if (successChance == 0.f)
-            return 0.f;
-
+        // Abilities, diseases and racial powers make up much of the list, skip them before the success chance
         if (spell->mData.mType != ESM::Spell::ST_Spell)
             return 0.f;
 
@@ -149,6 +146,10 @@ namespace MWMechanics
                 return 0.f;
         }
 
+        float successChance = MWMechanics::getSpellSuccessChance(spell, actor, nullptr, true, checkMagicka);
+        if (successChance == 0.f)
+            return 0.f;
+
         // Spells don't stack, so early out if the spell is still active on the target
         int types = getRangeTypes(spell->mEffects);
         if ((types & Self) && isSpellActive(actor, actor, spell->mId))
@@ -10,7 +10,9 @@
 
 #include <LinearMath/btTransform.h>
 
+#include <algorithm>
 #include <type_traits>
+#include <utility>
 
 #if BT_BULLET_VERSION < 310
 // Older Bullet versions only support `btScalar` heightfields.
@@ -52,17 +54,21 @@ namespace
 
 namespace MWPhysics
 {
-    HeightField::HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-        const osg::Object* holdObject, PhysicsTaskScheduler* scheduler)
+    HeightFieldShape::HeightFieldShape(
+        const float* heights, int size, int verts, float minH, float maxH, const osg::Object* holdObject)
         : mHoldObject(holdObject)
+        , mHeights(heights)
 #if BT_BULLET_VERSION < 310
-        , mHeights(makeHeights(heights, verts))
+        , mScalarHeights(makeHeights(heights, verts))
 #endif
-        , mTaskScheduler(scheduler)
+        , mSize(size)
+        , mVerts(verts)
+        , mMinH(minH)
+        , mMaxH(maxH)
     {
 #if BT_BULLET_VERSION < 310
         mShape = std::make_unique<btHeightfieldTerrainShape>(
-            verts, verts, getHeights(heights, mHeights), 1, minH, maxH, 2, PHY_FLOAT, false);
+            verts, verts, getHeights(heights, mScalarHeights), 1, minH, maxH, 2, PHY_FLOAT, false);
 #else
         mShape = std::make_unique<btHeightfieldTerrainShape>(verts, verts, heights, minH, maxH, 2, false);
 #endif
@@ -79,12 +85,39 @@ namespace MWPhysics
         // https://github.com/bulletphysics/bullet3/issues/3276
         mShape->buildAccelerator();
 #endif
+    }
 
-        const btTransform transform(
-            btQuaternion::getIdentity(), BulletHelpers::getHeightfieldShift(x, y, size, minH, maxH));
+    HeightFieldShape::~HeightFieldShape() = default;
+
+    std::size_t HeightFieldShape::estimateSize() const
+    {
+        std::size_t result = sizeof(HeightFieldShape) + sizeof(btHeightfieldTerrainShape);
+#if BT_BULLET_VERSION < 310
+        result += mScalarHeights.capacity() * sizeof(btScalar);
+#endif
+        return result;
+    }
+
+    bool HeightFieldShape::matches(const float* heights, int size, int verts, float minH, float maxH) const
+    {
+        if (size != mSize || verts != mVerts || minH != mMinH || maxH != mMaxH)
+            return false;
+        if (heights == mHeights)
+            return true;
+        // A reloaded land record gets new storage, compare the content to still reuse the shape
+        return std::equal(heights, heights + static_cast<std::ptrdiff_t>(verts * verts), mHeights);
+    }
+
+    HeightField::HeightField(std::shared_ptr<HeightFieldShape> shape, int x, int y, PhysicsTaskScheduler* scheduler)
+        : mShape(std::move(shape))
+        , mTaskScheduler(scheduler)
+    {
+        const btTransform transform(btQuaternion::getIdentity(),
+            BulletHelpers::getHeightfieldShift(
+                x, y, mShape->getSize(), mShape->getMinHeight(), mShape->getMaxHeight()));
 
         mCollisionObject = std::make_unique<btCollisionObject>();
-        mCollisionObject->setCollisionShape(mShape.get());
+        mCollisionObject->setCollisionShape(mShape->getShape());
         mCollisionObject->setWorldTransform(transform);
         mTaskScheduler->addCollisionObject(
             mCollisionObject.get(), CollisionType_HeightMap, CollisionType_Actor | CollisionType_Projectile);
@@ -107,6 +140,6 @@ namespace MWPhysics
 
     const btHeightfieldTerrainShape* HeightField::getShape() const
     {
-        return mShape.get();
+        return mShape->getShape();
     }
 }
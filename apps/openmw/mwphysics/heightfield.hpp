@@ -5,6 +5,7 @@
 
 #include <LinearMath/btScalar.h>
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -20,11 +21,48 @@ namespace MWPhysics
 {
     class PhysicsTaskScheduler;
 
+    /// Collision shape built from land heights. Construction includes the Bullet accelerator which is the expensive
+    /// part, so shapes are shared between the HeightField instances created for the same land record.
+    class HeightFieldShape
+    {
+    public:
+        HeightFieldShape(
+            const float* heights, int size, int verts, float minH, float maxH, const osg::Object* holdObject);
+        ~HeightFieldShape();
+
+        /// @return true if this shape was built from the same land data
+        bool matches(const float* heights, int size, int verts, float minH, float maxH) const;
+
+        btHeightfieldTerrainShape* getShape() { return mShape.get(); }
+        const btHeightfieldTerrainShape* getShape() const { return mShape.get(); }
+
+        int getSize() const { return mSize; }
+        float getMinHeight() const { return mMinH; }
+        float getMaxHeight() const { return mMaxH; }
+
+        /// @return Estimated memory in bytes, without the land heights owned by the hold object
+        std::size_t estimateSize() const;
+
+    private:
+        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        osg::ref_ptr<const osg::Object> mHoldObject;
+        const float* mHeights;
+#if BT_BULLET_VERSION < 310
+        std::vector<btScalar> mScalarHeights;
+#endif
+        int mSize;
+        int mVerts;
+        float mMinH;
+        float mMaxH;
+
+        void operator=(const HeightFieldShape&);
+        HeightFieldShape(const HeightFieldShape&);
+    };
+
     class HeightField
     {
     public:
-        HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-            const osg::Object* holdObject, PhysicsTaskScheduler* scheduler);
+        HeightField(std::shared_ptr<HeightFieldShape> shape, int x, int y, PhysicsTaskScheduler* scheduler);
         ~HeightField();
 
         btCollisionObject* getCollisionObject();
@@ -32,12 +70,8 @@ namespace MWPhysics
         const btHeightfieldTerrainShape* getShape() const;
 
     private:
-        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        std::shared_ptr<HeightFieldShape> mShape;
         std::unique_ptr<btCollisionObject> mCollisionObject;
-        osg::ref_ptr<const osg::Object> mHoldObject;
-#if BT_BULLET_VERSION < 310
-        std::vector<btScalar> mHeights;
-#endif
 
         PhysicsTaskScheduler* mTaskScheduler;
 
@@ -0,0 +1,107 @@
+#include "mergedstatics.hpp"
+
+#include "mtphysics.hpp"
+#include "object.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btDbvt.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+
+#include <components/bullethelpers/collisionobject.hpp>
+
+#include <cassert>
+#include <utility>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        struct FindSmallestChild : btDbvt::ICollide
+        {
+            int mIndex = -1;
+            btScalar mVolume = 0;
+
+            void Process(const btDbvtNode* leaf) override
+            {
+                const btVector3 extents = leaf->volume.Extents();
+                const btScalar volume = extents.x() * extents.y() * extents.z();
+                // Overlapping objects are common, the smallest one is the most likely to have been hit
+                if (mIndex == -1 || volume < mVolume)
+                {
+                    mIndex = leaf->dataAsInt;
+                    mVolume = volume;
+                }
+            }
+        };
+    }
+
+    MergedStatics::MergedStatics(
+        const MWWorld::CellStore& cell, std::span<Object* const> objects, PhysicsTaskScheduler* scheduler)
+        : PtrHolder(MWWorld::Ptr(), osg::Vec3f())
+        , mCell(cell)
+        , mShape(std::make_unique<btCompoundShape>(true, static_cast<int>(objects.size())))
+        , mObjects(objects.begin(), objects.end())
+        , mTaskScheduler(scheduler)
+    {
+        mChildIndices.reserve(mObjects.size());
+        for (Object* object : mObjects)
+        {
+            mChildIndices.emplace(object, mShape->getNumChildShapes());
+            mShape->addChildShape(object->getTransform(), object->getCollisionObject()->getCollisionShape());
+            object->setMergedStatics(this);
+        }
+
+        mCollisionObject = BulletHelpers::makeCollisionObject(
+            mShape.get(), btVector3(0, 0, 0), btQuaternion::getIdentity());
+        mCollisionObject->setUserPointer(this);
+        mTaskScheduler->addCollisionObject(mCollisionObject.get(), CollisionType_World, Object::sCollisionMask);
+    }
+
+    MergedStatics::~MergedStatics()
+    {
+        mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        for (Object* object : mObjects)
+            object->setMergedStatics(nullptr);
+    }
+
+    void MergedStatics::release(Object& object)
+    {
+        const auto it = mChildIndices.find(&object);
+        if (it == mChildIndices.end())
+            return;
+
+        // btCompoundShape moves the last child in place of the removed one
+        const int index = it->second;
+        mChildIndices.erase(it);
+        mTaskScheduler->removeChildShape(mCollisionObject.get(), index);
+        mObjects[index] = mObjects.back();
+        mObjects.pop_back();
+        if (static_cast<std::size_t>(index) < mObjects.size())
+            mChildIndices[mObjects[index]] = index;
+
+        object.setMergedStatics(nullptr);
+    }
+
+    const Object* MergedStatics::getObjectAt(const btVector3& position) const
+    {
+        const btDbvt* const tree = mShape->getDynamicAabbTree();
+        if (tree == nullptr)
+            return nullptr;
+
+        // Hit points are on the surface of a shape, so allow for the collision margin
+        FindSmallestChild collide;
+        tree->collideTV(tree->m_root, btDbvtVolume::FromCE(position, btVector3(1, 1, 1)), collide);
+        if (collide.mIndex < 0)
+            return nullptr;
+
+        assert(static_cast<std::size_t>(collide.mIndex) < mObjects.size());
+        return mObjects[collide.mIndex];
+    }
+
+    std::size_t MergedStatics::estimateSize() const
+    {
+        return sizeof(MergedStatics) + sizeof(btCompoundShape) + sizeof(btCollisionObject)
+            + mObjects.size()
+            * (sizeof(btCompoundShapeChild) + sizeof(btDbvtNode) + sizeof(Object*)
+                + sizeof(std::pair<const Object*, int>));
+    }
+}
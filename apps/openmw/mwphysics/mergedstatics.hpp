@@ -0,0 +1,64 @@
+#ifndef OPENMW_MWPHYSICS_MERGEDSTATICS_H
+#define OPENMW_MWPHYSICS_MERGEDSTATICS_H
+
+#include "ptrholder.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+class btCompoundShape;
+class btVector3;
+
+namespace MWWorld
+{
+    class CellStore;
+}
+
+namespace MWPhysics
+{
+    class Object;
+    class PhysicsTaskScheduler;
+
+    /// @brief Collision of static objects of a cell merged into a single collision object, so the broadphase, rays
+    /// and sweeps go through one proxy instead of one per object.
+    /// @par The objects keep their shapes, the merged collision object has no Ptr of its own, use getObjectAt to find
+    /// the object that was hit. An object is released with its own collision object put back into the world as soon
+    /// as it changes.
+    class MergedStatics final : public PtrHolder
+    {
+    public:
+        MergedStatics(
+            const MWWorld::CellStore& cell, std::span<Object* const> objects, PhysicsTaskScheduler* scheduler);
+
+        /// Releases all objects that are still merged
+        ~MergedStatics() override;
+
+        const MWWorld::CellStore& getCell() const { return mCell; }
+
+        std::size_t size() const { return mObjects.size(); }
+
+        bool empty() const { return mObjects.empty(); }
+
+        /// Put the object back into the world with its own collision object
+        void release(Object& object);
+
+        /// @return The merged object with collision at the given world position, usually a ray or sweep hit point
+        const Object* getObjectAt(const btVector3& position) const;
+
+        /// @return Estimated memory in bytes, the shapes of the objects are not included
+        std::size_t estimateSize() const;
+
+    private:
+        const MWWorld::CellStore& mCell;
+        std::unique_ptr<btCompoundShape> mShape;
+        // Same order as the children of mShape
+        std::vector<Object*> mObjects;
+        std::unordered_map<const Object*, int> mChildIndices;
+        PhysicsTaskScheduler* mTaskScheduler;
+    };
+}
+
+#endif
@@ -4,13 +4,8 @@
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionShapes/btConvexShape.h>
 
-#include <components/esm3/loadgmst.hpp>
 #include <components/misc/convert.hpp>
 
-#include "../mwbase/environment.hpp"
-
-#include "../mwworld/esmstore.hpp"
-
 #include "actor.hpp"
 #include "collisiontype.hpp"
 #include "constants.hpp"
@@ -125,30 +120,10 @@ namespace MWPhysics
         return tracer.mEndPos - offset + osg::Vec3f(0.f, 0.f, sGroundOffset);
     }
 
-    void MovementSolver::move(
-        ActorFrameData& actor, float time, const btCollisionWorld* collisionWorld, const WorldFrameData& worldData)
+    osg::Vec3f MovementSolver::computeVelocity(ActorFrameData& actor, const WorldFrameData& worldData)
     {
-        // Reset per-frame data
-        actor.mWalkingOnWater = false;
-        // Anything to collide with?
-        if (actor.mSkipCollisionDetection)
-        {
-            actor.mPosition += (osg::Quat(actor.mRotation.x(), osg::Vec3f(-1, 0, 0))
-                                   * osg::Quat(actor.mRotation.y(), osg::Vec3f(0, 0, -1)))
-                * actor.mMovement * time;
-            return;
-        }
-
-        // Adjust for collision mesh offset relative to actor's "location"
-        // (doTrace doesn't take local/interior collision shape translation into account, so we have to do it on our
-        // own) for compatibility with vanilla assets, we have to derive this from the vertical half extent instead of
-        // from internal hull translation if not for this hack, the "correct" collision hull position would be
-        // physicActor->getScaledMeshTranslation()
-        actor.mPosition.z() += actor.mHalfExtentsZ; // vanilla-accurate
-
-        float swimlevel = actor.mSwimLevel + actor.mHalfExtentsZ;
-
-        ActorTracer tracer;
+        // Expects actor.mPosition already adjusted for the collision mesh offset
+        const float swimlevel = actor.mSwimLevel + actor.mHalfExtentsZ;
 
         osg::Vec3f velocity;
 
@@ -176,14 +151,42 @@ namespace MWPhysics
         }
 
         // Now that we have the effective movement vector, apply wind forces to it
-        if (worldData.mIsInStorm && velocity.length() > 0)
+        if (worldData.mIsInStorm && velocity.length2() > 0)
         {
-            const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
-            const float fStromWalkMult = store.get<ESM::GameSetting>().find("fStromWalkMult")->mValue.getFloat();
             const float angleCos = worldData.mStormDirection * velocity / velocity.length();
-            velocity *= 1.f + fStromWalkMult * angleCos;
+            velocity *= 1.f + worldData.mStormWalkMult * angleCos;
         }
 
+        return velocity;
+    }
+
+    void MovementSolver::move(
+        ActorFrameData& actor, float time, const btCollisionWorld* collisionWorld, const WorldFrameData& worldData)
+    {
+        // Reset per-frame data
+        actor.mWalkingOnWater = false;
+        // Anything to collide with?
+        if (actor.mSkipCollisionDetection)
+        {
+            actor.mPosition += (osg::Quat(actor.mRotation.x(), osg::Vec3f(-1, 0, 0))
+                                   * osg::Quat(actor.mRotation.y(), osg::Vec3f(0, 0, -1)))
+                * actor.mMovement * time;
+            return;
+        }
+
+        // Adjust for collision mesh offset relative to actor's "location"
+        // (doTrace doesn't take local/interior collision shape translation into account, so we have to do it on our
+        // own) for compatibility with vanilla assets, we have to derive this from the vertical half extent instead of
+        // from internal hull translation if not for this hack, the "correct" collision hull position would be
+        // physicActor->getScaledMeshTranslation()
+        actor.mPosition.z() += actor.mHalfExtentsZ; // vanilla-accurate
+
+        float swimlevel = actor.mSwimLevel + actor.mHalfExtentsZ;
+
+        ActorTracer tracer;
+
+        osg::Vec3f velocity = computeVelocity(actor, worldData);
+
         Stepper stepper(collisionWorld, actor.mCollisionObject);
         osg::Vec3f origVelocity = velocity;
         osg::Vec3f newPosition = actor.mPosition;
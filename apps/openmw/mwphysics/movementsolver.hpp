@@ -43,6 +43,9 @@ namespace MWPhysics
     public:
         static osg::Vec3f traceDown(const MWWorld::Ptr& ptr, const osg::Vec3f& position, Actor* actor,
             btCollisionWorld* collisionWorld, float maxHeight);
+        /// Movement of an actor before collisions: swimming, flying, inertia and storm wind. Only reads the
+        /// frame data, never the Actor or Bullet objects.
+        static osg::Vec3f computeVelocity(ActorFrameData& actor, const WorldFrameData& worldData);
         static void move(
             ActorFrameData& actor, float time, const btCollisionWorld* collisionWorld, const WorldFrameData& worldData);
         static void move(ProjectileFrameData& projectile, float time, const btCollisionWorld* collisionWorld);
@@ -1,21 +1,27 @@
 #include "mtphysics.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <shared_mutex>
 #include <stdexcept>
+#include <utility>
 #include <variant>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <LinearMath/btThreads.h>
 
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/trace.hpp"
 #include "components/misc/convert.hpp"
+#include "components/misc/hash.hpp"
 #include <components/misc/barrier.hpp>
 #include <components/settings/values.hpp>
 
@@ -30,6 +36,7 @@
 #include "../mwbase/world.hpp"
 
 #include "actor.hpp"
+#include "closestnotmerayresultcallback.hpp"
 #include "contacttestwrapper.h"
 #include "movementsolver.hpp"
 #include "object.hpp"
@@ -131,9 +138,12 @@ namespace
         return actorData.mPosition.z() < actorData.mSwimLevel;
     }
 
-    osg::Vec3f interpolateMovements(const MWPhysics::PtrHolder& ptr, float timeAccum, float physicsDt)
+    osg::Vec3f interpolateMovements(const MWPhysics::PtrHolder& ptr, float timeAccum, float physicsDt,
+        unsigned lodPhase = 0, unsigned lodInterval = 1)
     {
-        const float interpolationFactor = std::clamp(timeAccum / physicsDt, 0.0f, 1.0f);
+        // Actors simulated at a reduced rate cover lodInterval frames with one step, spread their motion over them
+        const float interpolationFactor
+            = std::clamp((lodPhase + timeAccum / physicsDt) / static_cast<float>(lodInterval), 0.0f, 1.0f);
         return ptr.getPosition() * interpolationFactor + ptr.getPreviousPosition() * (1.f - interpolationFactor);
     }
 
@@ -200,6 +210,8 @@ namespace
             btCollisionWorld* mCollisionWorld;
             void operator()(const LockedActorSimulation& sim) const
             {
+                if (sim.second.get().mLodPhase != 0)
+                    return;
                 MWPhysics::MovementSolver::unstuck(sim.second, mCollisionWorld);
             }
             void operator()(const LockedProjectileSimulation& /*sim*/) const {}
@@ -212,6 +224,9 @@ namespace
             {
                 auto& [actor, frameDataRef] = sim;
                 auto& frameData = frameDataRef.get();
+                // Keep the previous position of skipped actors, it is still being interpolated from
+                if (frameData.mLodPhase != 0)
+                    return;
                 if (actor->setPosition(frameData.mPosition))
                 {
                     frameData.mPosition = actor->getPosition(); // account for potential position change made by script
@@ -236,7 +251,11 @@ namespace
             const MWPhysics::WorldFrameData& mWorldFrameData;
             void operator()(const LockedActorSimulation& sim) const
             {
-                MWPhysics::MovementSolver::move(sim.second, mPhysicsDt, mCollisionWorld, mWorldFrameData);
+                const MWPhysics::ActorFrameData& frameData = sim.second;
+                if (frameData.mLodPhase != 0)
+                    return;
+                MWPhysics::MovementSolver::move(
+                    sim.second, mPhysicsDt * frameData.mLodInterval, mCollisionWorld, mWorldFrameData);
             }
             void operator()(const LockedProjectileSimulation& sim) const
             {
@@ -258,6 +277,15 @@ namespace
                     return;
                 auto& [actor, frameDataRef] = *locked;
                 auto& frameData = frameDataRef.get();
+
+                // Not simulated this frame, only move along the interpolation of its last step
+                if (frameData.mLodPhase != 0)
+                {
+                    actor->setSimulationPosition(::interpolateMovements(
+                        *actor, mTimeAccum, mPhysicsDt, frameData.mLodPhase, frameData.mLodInterval));
+                    return;
+                }
+
                 auto ptr = actor->getPtr();
 
                 MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
@@ -269,7 +297,8 @@ namespace
                 else if (heightDiff < 0)
                     stats.addToFallHeight(-heightDiff);
 
-                actor->setSimulationPosition(::interpolateMovements(*actor, mTimeAccum, mPhysicsDt));
+                actor->setSimulationPosition(
+                    ::interpolateMovements(*actor, mTimeAccum, mPhysicsDt, 0, frameData.mLodInterval));
                 actor->setLastStuckPosition(frameData.mLastStuckPosition);
                 actor->setStuckFrames(frameData.mStuckFrames);
                 if (mAdvanceSimulation)
@@ -412,8 +441,8 @@ namespace MWPhysics
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::physics().mLineofsightKeepInactiveCache)
         , mAdvanceSimulation(false)
-        , mNextJob(0)
         , mNextLOS(0)
+        , mJobQueues(std::max(1u, mNumThreads))
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -430,7 +459,7 @@ namespace MWPhysics
         {
             Log(Debug::Info) << "Using " << mNumThreads << " async physics threads";
             for (unsigned i = 0; i < mNumThreads; ++i)
-                mThreads.emplace_back([&] { worker(); });
+                mThreads.emplace_back([this, i] { worker(i); });
         }
         else
         {
@@ -456,6 +485,7 @@ namespace MWPhysics
             mWorkersSync->stopWorkers();
         for (auto& thread : mThreads)
             thread.join();
+        clearAabbUpdates();
     }
 
     std::tuple<int, float> PhysicsTaskScheduler::calculateStepConfig(float timeAccum) const
@@ -552,7 +582,7 @@ namespace MWPhysics
         mAdvanceSimulation = (mRemainingSteps != 0);
         mNumJobs = mSimulations->size();
         mNextLOS.store(0, std::memory_order_relaxed);
-        mNextJob.store(0, std::memory_order_release);
+        partitionJobs();
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
@@ -562,7 +592,7 @@ namespace MWPhysics
 
         if (mNumThreads == 0)
         {
-            doSimulation();
+            doSimulation(0);
             syncWithMainThread();
             if (mAdvanceSimulation)
                 mBudget.update(mTimer->delta_s(timeStart, mTimer->tick()), numSteps, mBudgetCursor);
@@ -606,6 +636,23 @@ namespace MWPhysics
         mCollisionWorld->convexSweepTest(castShape, from, to, resultCallback);
     }
 
+    void PhysicsTaskScheduler::rayTests(std::span<ClosestNotMeRayResultCallback> callbacks) const
+    {
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (ClosestNotMeRayResultCallback& callback : callbacks)
+            mCollisionWorld->rayTest(callback.m_rayFromWorld, callback.m_rayToWorld, callback);
+    }
+
+    void PhysicsTaskScheduler::convexSweepTests(
+        const btConvexShape* castShape, std::span<btCollisionWorld::ClosestConvexResultCallback> callbacks) const
+    {
+        const btQuaternion rotation = btQuaternion::getIdentity();
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (btCollisionWorld::ClosestConvexResultCallback& callback : callbacks)
+            mCollisionWorld->convexSweepTest(castShape, btTransform(rotation, callback.m_convexFromWorld),
+                btTransform(rotation, callback.m_convexToWorld), callback);
+    }
+
     void PhysicsTaskScheduler::contactTest(
         btCollisionObject* colObj, btCollisionWorld::ContactResultCallback& resultCallback)
     {
@@ -665,68 +712,171 @@ namespace MWPhysics
         mCollisionWorld->removeCollisionObject(collisionObject);
     }
 
+    void PhysicsTaskScheduler::removeChildShape(btCollisionObject* collisionObject, int childIndex)
+    {
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        assert(collisionObject->getCollisionShape()->isCompound());
+        static_cast<btCompoundShape*>(collisionObject->getCollisionShape())->removeChildShapeByIndex(childIndex);
+    }
+
     void PhysicsTaskScheduler::updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate)
     {
         if (immediate || mNumThreads == 0)
         {
             updatePtrAabb(ptr);
         }
-        else
+        else if (ptr->markAabbDirty())
         {
-            MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
-            mUpdateAabb.insert(ptr);
+            auto* const update = new AabbUpdate{ ptr, mUpdateAabb.load(std::memory_order_relaxed) };
+            while (!mUpdateAabb.compare_exchange_weak(
+                update->mNext, update, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
         }
     }
 
+    std::size_t PhysicsTaskScheduler::LOSKeyHash::operator()(const LOSKey& key) const noexcept
+    {
+        std::size_t seed = 0;
+        Misc::hashCombine(seed, key[0]);
+        Misc::hashCombine(seed, key[1]);
+        return seed;
+    }
+
+    PhysicsTaskScheduler::LOSCacheStripe& PhysicsTaskScheduler::getLOSCacheStripe(const LOSKey& key)
+    {
+        // Use the high bits, the low ones also select the bucket inside the stripe
+        return mLOSCache[(LOSKeyHash{}(key) >> 16) % sLOSCacheStripes];
+    }
+
     bool PhysicsTaskScheduler::getLineOfSight(
         const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
     {
-        MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
-
-        auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        const LOSRequest req(actor1, actor2);
+        LOSCacheStripe& stripe = getLOSCacheStripe(req.mRawActors);
         {
-            req.mResult = hasLineOfSight(actor1.get(), actor2.get());
-            mLOSCache.push_back(req);
-            return req.mResult;
+            MaybeExclusiveLock lock(stripe.mMutex, mLockingPolicy);
+            const auto it = stripe.mRequests.find(req.mRawActors);
+            if (it != stripe.mRequests.end() && !it->second.mPending)
+            {
+                it->second.mAge = 0;
+                return it->second.mResult;
+            }
         }
-        result->mAge = 0;
-        return result->mResult;
+
+        // Raycast without holding the stripe, workers may be refreshing it
+        const bool result = hasLineOfSight(actor1.get(), actor2.get());
+
+        MaybeExclusiveLock lock(stripe.mMutex, mLockingPolicy);
+        LOSRequest& cached = stripe.mRequests.try_emplace(req.mRawActors, req).first->second;
+        cached.mResult = result;
+        cached.mPending = false;
+        cached.mAge = 0;
+        return result;
+    }
+
+    void PhysicsTaskScheduler::queueLineOfSight(
+        const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
+    {
+        LOSRequest req(actor1, actor2);
+        req.mPending = true;
+        LOSCacheStripe& stripe = getLOSCacheStripe(req.mRawActors);
+
+        MaybeExclusiveLock lock(stripe.mMutex, mLockingPolicy);
+        const auto [it, inserted] = stripe.mRequests.try_emplace(req.mRawActors, req);
+        if (!inserted)
+            it->second.mAge = 0;
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
     {
-        MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
-        int job = 0;
-        int numLOS = mLOSCache.size();
-        while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < numLOS)
+        OPENMW_TRACE_SCOPE("Physics LOS Cache");
+        std::size_t job = 0;
+        while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < sLOSCacheStripes)
+            refreshLOSCacheStripe(mLOSCache[job]);
+    }
+
+    void PhysicsTaskScheduler::refreshLOSCacheStripe(LOSCacheStripe& stripe)
+    {
+        std::vector<std::pair<LOSKey, std::array<std::shared_ptr<Actor>, 2>>> live;
         {
-            auto& req = mLOSCache[job];
-            auto actorPtr1 = req.mActors[0].lock();
-            auto actorPtr2 = req.mActors[1].lock();
+            MaybeExclusiveLock lock(stripe.mMutex, mLockingPolicy);
+            live.reserve(stripe.mRequests.size());
+            for (auto it = stripe.mRequests.begin(); it != stripe.mRequests.end();)
+            {
+                LOSRequest& req = it->second;
+                auto actorPtr1 = req.mActors[0].lock();
+                auto actorPtr2 = req.mActors[1].lock();
+                if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
+                {
+                    it = stripe.mRequests.erase(it);
+                    continue;
+                }
+                live.emplace_back(it->first, std::array{ std::move(actorPtr1), std::move(actorPtr2) });
+                ++it;
+            }
+        }
 
-            if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
-                req.mStale = true;
-            else
-                req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+        // Raycast the whole batch without holding the stripe
+        std::vector<bool> results;
+        results.reserve(live.size());
+        for (const auto& [key, actors] : live)
+            results.push_back(hasLineOfSight(actors[0].get(), actors[1].get()));
+
+        MaybeExclusiveLock lock(stripe.mMutex, mLockingPolicy);
+        for (std::size_t i = 0; i < live.size(); ++i)
+        {
+            const auto it = stripe.mRequests.find(live[i].first);
+            if (it == stripe.mRequests.end())
+                continue;
+            it->second.mResult = results[i];
+            it->second.mPending = false;
         }
     }
 
     void PhysicsTaskScheduler::updateAabbs()
     {
-        MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
-        std::for_each(mUpdateAabb.begin(), mUpdateAabb.end(), [this](const std::weak_ptr<PtrHolder>& ptr) {
-            auto p = ptr.lock();
-            if (p != nullptr)
-                updatePtrAabb(p);
-        });
-        mUpdateAabb.clear();
+        AabbUpdate* update = mUpdateAabb.exchange(nullptr, std::memory_order_acquire);
+        if (update == nullptr)
+            return;
+
+        // Locked pointers have to outlive the collision world lock, Ptr destructor also acquires it
+        std::vector<std::shared_ptr<PtrHolder>> ptrs;
+        while (update != nullptr)
+        {
+            if (auto ptr = update->mPtr.lock())
+            {
+                // Cleared before committing, so a move happening meanwhile queues the object again
+                ptr->clearAabbDirty();
+                ptrs.push_back(std::move(ptr));
+            }
+            delete std::exchange(update, update->mNext);
+        }
+
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (const auto& ptr : ptrs)
+            updatePtrAabbLocked(ptr);
+    }
+
+    void PhysicsTaskScheduler::clearAabbUpdates()
+    {
+        AabbUpdate* update = mUpdateAabb.exchange(nullptr, std::memory_order_acquire);
+        while (update != nullptr)
+        {
+            if (auto ptr = update->mPtr.lock())
+                ptr->clearAabbDirty();
+            delete std::exchange(update, update->mNext);
+        }
     }
 
     void PhysicsTaskScheduler::updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        updatePtrAabbLocked(ptr);
+    }
+
+    void PhysicsTaskScheduler::updatePtrAabbLocked(const std::shared_ptr<PtrHolder>& ptr)
+    {
         if (const auto actor = std::dynamic_pointer_cast<Actor>(ptr))
         {
             actor->updateCollisionObjectPosition();
@@ -744,14 +894,67 @@ namespace MWPhysics
         }
     }
 
-    void PhysicsTaskScheduler::worker()
+    void PhysicsTaskScheduler::worker(std::size_t threadIndex)
     {
-        mWorkersSync->runWorker([this] {
+        OPENMW_TRACE_THREAD_NAME("Physics Worker " + std::to_string(threadIndex));
+        mWorkersSync->runWorker([this, threadIndex] {
             std::shared_lock lock(mSimulationMutex);
-            doSimulation();
+            doSimulation(threadIndex);
         });
     }
 
+    void PhysicsTaskScheduler::partitionJobs()
+    {
+        // This function run in the main thread while workers are idle.
+        // Jobs are dealt largest first to the least loaded thread, using the time each one took last frame. When the
+        // set of simulations changed, costs are unknown and jobs are spread evenly.
+        const std::size_t numJobs = static_cast<std::size_t>(mNumJobs);
+        if (mJobCosts.size() != numJobs)
+            mJobCosts.assign(numJobs, 0.0);
+
+        mJobOrder.resize(numJobs);
+        std::iota(mJobOrder.begin(), mJobOrder.end(), 0);
+        std::stable_sort(
+            mJobOrder.begin(), mJobOrder.end(), [&](int lhs, int rhs) { return mJobCosts[lhs] > mJobCosts[rhs]; });
+
+        // Every job costs at least something, so zero cost jobs are still spread out
+        constexpr double minJobCost = 1e-7;
+        std::vector<double> loads(mJobQueues.size(), 0.0);
+        for (JobQueue& queue : mJobQueues)
+        {
+            queue.mJobs.clear();
+            queue.mNext.store(0, std::memory_order_relaxed);
+        }
+        for (const int job : mJobOrder)
+        {
+            const std::size_t queue = std::min_element(loads.begin(), loads.end()) - loads.begin();
+            mJobQueues[queue].mJobs.push_back(job);
+            loads[queue] += std::max(mJobCosts[job], minJobCost);
+        }
+
+        std::fill(mJobCosts.begin(), mJobCosts.end(), 0.0);
+    }
+
+    void PhysicsTaskScheduler::runJobs(std::size_t threadIndex)
+    {
+        // Drain the own queue first, then help the others. A job is claimed by exactly one thread per step.
+        const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
+        const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
+        const std::size_t numQueues = mJobQueues.size();
+        for (std::size_t i = 0; i < numQueues; ++i)
+        {
+            JobQueue& queue = mJobQueues[(threadIndex + i) % numQueues];
+            std::size_t next = 0;
+            while ((next = queue.mNext.fetch_add(1, std::memory_order_relaxed)) < queue.mJobs.size())
+            {
+                const int job = queue.mJobs[next];
+                const osg::Timer_t start = mTimer->tick();
+                std::visit(vis, (*mSimulations)[job]);
+                mJobCosts[job] += mTimer->delta_s(start, mTimer->tick());
+            }
+        }
+    }
+
     void PhysicsTaskScheduler::updateActorsPositions()
     {
         const Visitors::UpdatePosition impl{ mCollisionWorld };
@@ -778,18 +981,26 @@ namespace MWPhysics
         return !resultCallback.hasHit();
     }
 
-    void PhysicsTaskScheduler::doSimulation()
+    void PhysicsTaskScheduler::doSimulation(std::size_t threadIndex)
     {
+        OPENMW_TRACE_SCOPE("Physics Simulation");
+
+        if (mRemainingSteps)
+            mPreStepBarrier->wait([this] { afterPreStep(); });
+
         while (mRemainingSteps)
         {
-            mPreStepBarrier->wait([this] { afterPreStep(); });
-            int job = 0;
-            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
-            const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
-            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+            {
+                OPENMW_TRACE_SCOPE("Physics Step");
+                runJobs(threadIndex);
+            }
 
-            mPostStepBarrier->wait([this] { afterPostStep(); });
+            // The end of a step and the start of the next one share a single rendezvous
+            mPostStepBarrier->wait([this] {
+                afterPostStep();
+                if (mRemainingSteps)
+                    afterPreStep();
+            });
         }
 
         refreshLOSCache();
@@ -828,17 +1039,18 @@ namespace MWPhysics
     void PhysicsTaskScheduler::releaseSharedStates()
     {
         waitForWorkers();
-        std::scoped_lock lock(mSimulationMutex, mUpdateAabbMutex);
+        std::unique_lock lock(mSimulationMutex);
         if (mSimulations != nullptr)
         {
             mSimulations->clear();
             mSimulations = nullptr;
         }
-        mUpdateAabb.clear();
+        clearAabbUpdates();
     }
 
     void PhysicsTaskScheduler::afterPreStep()
     {
+        OPENMW_TRACE_SCOPE("Physics PreStep");
         updateAabbs();
         if (!mRemainingSteps)
             return;
@@ -847,26 +1059,22 @@ namespace MWPhysics
             mLockingPolicy };
         for (auto& sim : *mSimulations)
             std::visit(vis, sim);
+        for (JobQueue& queue : mJobQueues)
+            queue.mNext.store(0, std::memory_order_relaxed);
     }
 
     void PhysicsTaskScheduler::afterPostStep()
     {
+        OPENMW_TRACE_SCOPE("Physics PostStep");
         if (mRemainingSteps)
         {
             --mRemainingSteps;
             updateActorsPositions();
         }
-        mNextJob.store(0, std::memory_order_release);
     }
 
     void PhysicsTaskScheduler::afterPostSim()
     {
-        {
-            MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
-            mLOSCache.erase(
-                std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
-                mLOSCache.end());
-        }
         mTimeEnd = mTimer->tick();
         if (mWorkersSync != nullptr)
             mWorkersSync->workIsDone();
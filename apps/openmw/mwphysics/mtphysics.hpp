@@ -1,14 +1,17 @@
 #ifndef OPENMW_MWPHYSICS_MTPHYSICS_H
 #define OPENMW_MWPHYSICS_MTPHYSICS_H
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <optional>
-#include <set>
 #include <shared_mutex>
+#include <span>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
@@ -30,6 +33,8 @@ namespace MWRender
 
 namespace MWPhysics
 {
+    class ClosestNotMeRayResultCallback;
+
     enum class LockingPolicy
     {
         NoLocks,
@@ -58,6 +63,10 @@ namespace MWPhysics
             btCollisionWorld::RayResultCallback& resultCallback) const;
         void convexSweepTest(const btConvexShape* castShape, const btTransform& from, const btTransform& to,
             btCollisionWorld::ConvexResultCallback& resultCallback) const;
+        /// Casts the ray of each callback holding the collision world lock once
+        void rayTests(std::span<ClosestNotMeRayResultCallback> callbacks) const;
+        void convexSweepTests(const btConvexShape* castShape,
+            std::span<btCollisionWorld::ClosestConvexResultCallback> callbacks) const;
         void contactTest(btCollisionObject* colObj, btCollisionWorld::ContactResultCallback& resultCallback);
         std::optional<btVector3> getHitPoint(const btTransform& from, btCollisionObject* target);
         void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
@@ -65,8 +74,13 @@ namespace MWPhysics
         void setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask);
         void addCollisionObject(btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask);
         void removeCollisionObject(btCollisionObject* collisionObject);
+        /// Remove a child of a collision object with a btCompoundShape, the collision object keeps its AABB
+        void removeChildShape(btCollisionObject* collisionObject, int childIndex);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// @brief request line of sight between two actors to be computed by the physics workers,
+        /// so that a later getLineOfSight call does not have to raycast on the calling thread
+        void queueLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -75,13 +89,45 @@ namespace MWPhysics
     private:
         class WorkersSync;
 
-        void doSimulation();
-        void worker();
+        /// Simulation jobs assigned to one thread for the current frame. Any thread may claim from it once it ran
+        /// out of its own jobs.
+        using LOSKey = std::array<const Actor*, 2>;
+
+        struct LOSKeyHash
+        {
+            std::size_t operator()(const LOSKey& key) const noexcept;
+        };
+
+        /// Part of the line of sight cache with its own lock, so that lookups and refreshes of different actor
+        /// pairs do not contend
+        struct LOSCacheStripe
+        {
+            mutable std::shared_mutex mMutex;
+            std::unordered_map<LOSKey, LOSRequest, LOSKeyHash> mRequests;
+        };
+
+        static constexpr std::size_t sLOSCacheStripes = 16;
+
+        LOSCacheStripe& getLOSCacheStripe(const LOSKey& key);
+        void refreshLOSCacheStripe(LOSCacheStripe& stripe);
+
+        struct JobQueue
+        {
+            std::vector<int> mJobs;
+            std::atomic<std::size_t> mNext{ 0 };
+        };
+
+        void doSimulation(std::size_t threadIndex);
+        void worker(std::size_t threadIndex);
+        void runJobs(std::size_t threadIndex);
+        void partitionJobs();
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
+        void updatePtrAabbLocked(const std::shared_ptr<PtrHolder>& ptr);
+        void clearAabbUpdates();
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
         std::tuple<int, float> calculateStepConfig(float timeAccum) const;
         void afterPreStep();
@@ -100,8 +146,16 @@ namespace MWPhysics
         float mTimeAccum;
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
-        std::vector<LOSRequest> mLOSCache;
-        std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
+        std::array<LOSCacheStripe, sLOSCacheStripes> mLOSCache;
+
+        /// Node of the lock-free list of objects waiting for an AABB update, pushed by any thread and drained at
+        /// once. PtrHolder's dirty flag keeps each object at most once in the list.
+        struct AabbUpdate
+        {
+            std::weak_ptr<PtrHolder> mPtr;
+            AabbUpdate* mNext;
+        };
+        std::atomic<AabbUpdate*> mUpdateAabb{ nullptr };
 
         // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
         std::unique_ptr<Misc::Barrier> mPreStepBarrier;
@@ -114,14 +168,15 @@ namespace MWPhysics
         int mRemainingSteps;
         int mLOSCacheExpiry;
         bool mAdvanceSimulation;
-        std::atomic<int> mNextJob;
         std::atomic<int> mNextLOS;
         std::vector<std::thread> mThreads;
+        std::vector<JobQueue> mJobQueues;
+        // Time spent by each job over all steps of the last frame, used to balance the next one
+        std::vector<double> mJobCosts;
+        std::vector<int> mJobOrder;
 
         mutable std::shared_mutex mSimulationMutex;
         mutable std::shared_mutex mCollisionWorldMutex;
-        mutable std::shared_mutex mLOSCacheMutex;
-        mutable std::mutex mUpdateAabbMutex;
 
         unsigned int mFrameNumber;
         const osg::Timer* mTimer;
@@ -12,6 +12,8 @@
 
 #include <LinearMath/btTransform.h>
 
+#include <cassert>
+
 namespace MWPhysics
 {
     Object::Object(const MWWorld::Ptr& ptr, osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance,
@@ -23,18 +25,19 @@ namespace MWPhysics
         , mPosition(ptr.getRefData().getPosition().asVec3())
         , mRotation(rotation)
         , mTaskScheduler(scheduler)
+        , mCollisionType(collisionType)
         , mCollidedWith(ScriptedCollisionType_None)
     {
         mCollisionObject = BulletHelpers::makeCollisionObject(mShapeInstance->mCollisionShape.get(),
             Misc::Convert::toBullet(mPosition), Misc::Convert::toBullet(rotation));
         mCollisionObject->setUserPointer(this);
         mShapeInstance->setLocalScaling(mScale);
-        mTaskScheduler->addCollisionObject(mCollisionObject.get(), collisionType,
-            CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile);
+        mTaskScheduler->addCollisionObject(mCollisionObject.get(), collisionType, sCollisionMask);
     }
 
     Object::~Object()
     {
+        assert(mMergedStatics == nullptr);
         mTaskScheduler->removeCollisionObject(mCollisionObject.get());
     }
 
@@ -179,6 +182,20 @@ namespace MWPhysics
         mCollidedWith |= type;
     }
 
+    void Object::setMergedStatics(MergedStatics* value)
+    {
+        if (mMergedStatics == value)
+            return;
+        if (mMergedStatics == nullptr)
+            mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        else if (value == nullptr)
+        {
+            commitPositionChange();
+            mTaskScheduler->addCollisionObject(mCollisionObject.get(), mCollisionType, sCollisionMask);
+        }
+        mMergedStatics = value;
+    }
+
     void Object::resetCollisions()
     {
         mCollidedWith = ScriptedCollisionType_None;
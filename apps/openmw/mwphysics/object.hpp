@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWPHYSICS_OBJECT_H
 #define OPENMW_MWPHYSICS_OBJECT_H
 
+#include "collisiontype.hpp"
 #include "ptrholder.hpp"
 
 #include <LinearMath/btTransform.h>
@@ -16,6 +17,7 @@ namespace Resource
 
 namespace MWPhysics
 {
+    class MergedStatics;
     class PhysicsTaskScheduler;
 
     enum ScriptedCollisionType : char
@@ -29,6 +31,9 @@ namespace MWPhysics
     class Object final : public PtrHolder
     {
     public:
+        /// What objects collide with
+        static constexpr int sCollisionMask = CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile;
+
         Object(const MWWorld::Ptr& ptr, osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance, osg::Quat rotation,
             int collisionType, PhysicsTaskScheduler* scheduler);
         ~Object() override;
@@ -49,6 +54,13 @@ namespace MWPhysics
         bool collidedWith(ScriptedCollisionType type) const;
         void addCollision(ScriptedCollisionType type);
         void resetCollisions();
+        int getCollisionType() const { return mCollisionType; }
+
+        /// The merged collision holding the shape of this object, if any
+        MergedStatics* getMergedStatics() const { return mMergedStatics; }
+        /// Take the collision object out of the world while the shape is part of merged collision, nullptr puts it
+        /// back.
+        void setMergedStatics(MergedStatics* value);
 
     private:
         osg::ref_ptr<Resource::BulletShapeInstance> mShapeInstance;
@@ -61,6 +73,8 @@ namespace MWPhysics
         bool mTransformUpdatePending = false;
         mutable std::mutex mPositionMutex;
         PhysicsTaskScheduler* mTaskScheduler;
+        MergedStatics* mMergedStatics = nullptr;
+        int mCollisionType;
         char mCollidedWith;
     };
 }
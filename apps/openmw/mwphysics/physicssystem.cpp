@@ -1,6 +1,8 @@
 #include "physicssystem.hpp"
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -22,6 +24,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadmgef.hpp>
+#include <components/esm3/loadstat.hpp>
 #include <components/misc/convert.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
@@ -51,6 +54,7 @@
 #include "contacttestresultcallback.hpp"
 #include "hasspherecollisioncallback.hpp"
 #include "heightfield.hpp"
+#include "mergedstatics.hpp"
 #include "movementsolver.hpp"
 #include "mtphysics.hpp"
 #include "object.hpp"
@@ -88,6 +92,26 @@ namespace
         ptr.getClass().getMovementSettings(ptr).mPosition[2] = 0;
     }
 
+    MWWorld::Ptr getHitPtr(const btCollisionObject& collisionObject, const btVector3& hitPoint)
+    {
+        const auto* ptrHolder = static_cast<const MWPhysics::PtrHolder*>(collisionObject.getUserPointer());
+        if (ptrHolder == nullptr)
+            return {};
+        if (const auto* merged = dynamic_cast<const MWPhysics::MergedStatics*>(ptrHolder))
+        {
+            if (const MWPhysics::Object* object = merged->getObjectAt(hitPoint))
+                return object->getPtr();
+            return {};
+        }
+        return ptrHolder->getPtr();
+    }
+
+    bool canMergeStatic(const MWPhysics::Object& object)
+    {
+        const MWWorld::Ptr ptr = object.getPtr();
+        return ptr.getType() == ESM::Static::sRecordId && object.getCollisionType() == MWPhysics::CollisionType_World
+            && object.isSolid() && !object.isAnimated() && ptr.getClass().getScript(ptr).empty();
+    }
 }
 
 namespace MWPhysics
@@ -105,6 +129,8 @@ namespace MWPhysics
         , mWaterEnabled(false)
         , mParentNode(std::move(parentNode))
     {
+        mShapeManager->setMaxCacheSize(
+            static_cast<std::size_t>(Settings::cells().mCollisionShapeCacheMaxSize.get()) * 1024 * 1024);
         mResourceSystem->addResourceManager(mShapeManager.get());
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
@@ -143,6 +169,8 @@ namespace MWPhysics
 
         mTaskScheduler->releaseSharedStates();
         mHeightFields.clear();
+        mHeightFieldShapes.clear();
+        mMergedStatics.clear();
         mObjects.clear();
         mActors.clear();
         mProjectiles.clear();
@@ -168,6 +196,7 @@ namespace MWPhysics
         if (found == mObjects.end())
             return;
 
+        releaseMergedStatic(*found->second);
         found->second->setSolid(false);
     }
 
@@ -204,25 +233,9 @@ namespace MWPhysics
         btVector3 btFrom = Misc::Convert::toBullet(from);
         btVector3 btTo = Misc::Convert::toBullet(to);
 
-        std::vector<const btCollisionObject*> ignoreList;
+        std::vector<const btCollisionObject*> ignoreList = getIgnoredCollisionObjects(ignore);
         std::vector<const btCollisionObject*> targetCollisionObjects;
 
-        for (const auto& ptr : ignore)
-        {
-            if (!ptr.isEmpty())
-            {
-                const Actor* actor = getActor(ptr);
-                if (actor)
-                    ignoreList.push_back(actor->getCollisionObject());
-                else
-                {
-                    const Object* object = getObject(ptr);
-                    if (object)
-                        ignoreList.push_back(object->getCollisionObject());
-                }
-            }
-        }
-
         if (!targets.empty())
         {
             for (const MWWorld::Ptr& target : targets)
@@ -245,12 +258,33 @@ namespace MWPhysics
         {
             result.mHitPos = Misc::Convert::toOsg(resultCallback.m_hitPointWorld);
             result.mHitNormal = Misc::Convert::toOsg(resultCallback.m_hitNormalWorld);
-            if (PtrHolder* ptrHolder = static_cast<PtrHolder*>(resultCallback.m_collisionObject->getUserPointer()))
-                result.mHitObject = ptrHolder->getPtr();
+            result.mHitObject = getHitPtr(*resultCallback.m_collisionObject, resultCallback.m_hitPointWorld);
         }
         return result;
     }
 
+    std::vector<const btCollisionObject*> PhysicsSystem::getIgnoredCollisionObjects(
+        const std::vector<MWWorld::ConstPtr>& ignore) const
+    {
+        std::vector<const btCollisionObject*> ignoreList;
+        for (const auto& ptr : ignore)
+        {
+            if (!ptr.isEmpty())
+            {
+                const Actor* actor = getActor(ptr);
+                if (actor)
+                    ignoreList.push_back(actor->getCollisionObject());
+                else
+                {
+                    const Object* object = getObject(ptr);
+                    if (object)
+                        ignoreList.push_back(object->getCollisionObject());
+                }
+            }
+        }
+        return ignoreList;
+    }
+
     RayCastingResult PhysicsSystem::castSphere(
         const osg::Vec3f& from, const osg::Vec3f& to, float radius, int mask, int group) const
     {
@@ -271,12 +305,83 @@ namespace MWPhysics
         {
             result.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
             result.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
-            if (auto* ptrHolder = static_cast<PtrHolder*>(callback.m_hitCollisionObject->getUserPointer()))
-                result.mHitObject = ptrHolder->getPtr();
+            result.mHitObject = getHitPtr(*callback.m_hitCollisionObject, callback.m_hitPointWorld);
         }
         return result;
     }
 
+    void PhysicsSystem::castRays(std::span<const RayCastingRequest> rays, std::span<RayCastingResult> results,
+        const std::vector<MWWorld::ConstPtr>& ignore, int mask, int group) const
+    {
+        assert(rays.size() == results.size());
+
+        std::vector<const btCollisionObject*> ignoreList = getIgnoredCollisionObjects(ignore);
+
+        std::vector<ClosestNotMeRayResultCallback> callbacks;
+        std::vector<std::size_t> indices;
+        callbacks.reserve(rays.size());
+        indices.reserve(rays.size());
+        for (std::size_t i = 0; i < rays.size(); ++i)
+        {
+            results[i].mHit = false;
+            if (rays[i].mFrom == rays[i].mTo)
+                continue;
+            ClosestNotMeRayResultCallback& callback = callbacks.emplace_back(ignoreList,
+                std::span<const btCollisionObject*>(), Misc::Convert::toBullet(rays[i].mFrom),
+                Misc::Convert::toBullet(rays[i].mTo));
+            callback.m_collisionFilterGroup = group;
+            callback.m_collisionFilterMask = mask;
+            indices.push_back(i);
+        }
+
+        mTaskScheduler->rayTests(callbacks);
+
+        for (std::size_t i = 0; i < callbacks.size(); ++i)
+        {
+            const ClosestNotMeRayResultCallback& callback = callbacks[i];
+            RayCastingResult& result = results[indices[i]];
+            result.mHit = callback.hasHit();
+            if (result.mHit)
+            {
+                result.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
+                result.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
+                result.mHitObject = getHitPtr(*callback.m_collisionObject, callback.m_hitPointWorld);
+            }
+        }
+    }
+
+    void PhysicsSystem::castSpheres(std::span<const RayCastingRequest> rays, float radius,
+        std::span<RayCastingResult> results, int mask, int group) const
+    {
+        assert(rays.size() == results.size());
+
+        std::vector<btCollisionWorld::ClosestConvexResultCallback> callbacks;
+        callbacks.reserve(rays.size());
+        for (const RayCastingRequest& ray : rays)
+        {
+            btCollisionWorld::ClosestConvexResultCallback& callback = callbacks.emplace_back(
+                Misc::Convert::toBullet(ray.mFrom), Misc::Convert::toBullet(ray.mTo));
+            callback.m_collisionFilterGroup = group;
+            callback.m_collisionFilterMask = mask;
+        }
+
+        const btSphereShape shape(radius);
+        mTaskScheduler->convexSweepTests(&shape, callbacks);
+
+        for (std::size_t i = 0; i < callbacks.size(); ++i)
+        {
+            const btCollisionWorld::ClosestConvexResultCallback& callback = callbacks[i];
+            RayCastingResult& result = results[i];
+            result.mHit = callback.hasHit();
+            if (result.mHit)
+            {
+                result.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
+                result.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
+                result.mHitObject = getHitPtr(*callback.m_hitCollisionObject, callback.m_hitPointWorld);
+            }
+        }
+    }
+
     bool PhysicsSystem::getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const
     {
         if (actor1 == actor2)
@@ -290,6 +395,19 @@ namespace MWPhysics
         return mTaskScheduler->getLineOfSight(it1->second, it2->second);
     }
 
+    void PhysicsSystem::queueLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const
+    {
+        if (actor1 == actor2)
+            return;
+
+        const auto it1 = mActors.find(actor1.mRef);
+        const auto it2 = mActors.find(actor2.mRef);
+        if (it1 == mActors.end() || it2 == mActors.end())
+            return;
+
+        mTaskScheduler->queueLineOfSight(it1->second, it2->second);
+    }
+
     bool PhysicsSystem::isOnGround(const MWWorld::Ptr& actor)
     {
         Actor* physactor = getActor(actor);
@@ -385,15 +503,49 @@ namespace MWPhysics
     void PhysicsSystem::addHeightField(
         const float* heights, int x, int y, int size, int verts, float minH, float maxH, const osg::Object* holdObject)
     {
-        mHeightFields[std::make_pair(x, y)]
-            = std::make_unique<HeightField>(heights, x, y, size, verts, minH, maxH, holdObject, mTaskScheduler.get());
+        std::unique_ptr<HeightField>& heightField = mHeightFields[std::make_pair(x, y)];
+        // Release the previous one first so its shape can be reused or dropped from the cache
+        heightField.reset();
+        heightField = std::make_unique<HeightField>(
+            getHeightFieldShape(heights, x, y, size, verts, minH, maxH, holdObject), x, y, mTaskScheduler.get());
     }
 
     void PhysicsSystem::removeHeightField(int x, int y)
     {
         HeightFieldMap::iterator heightfield = mHeightFields.find(std::make_pair(x, y));
         if (heightfield != mHeightFields.end())
+        {
             mHeightFields.erase(heightfield);
+            trimHeightFieldShapes();
+        }
+    }
+
+    std::shared_ptr<HeightFieldShape> PhysicsSystem::getHeightFieldShape(const float* heights, int x, int y,
+        int size, int verts, float minH, float maxH, const osg::Object* holdObject)
+    {
+        CachedHeightFieldShape& cached = mHeightFieldShapes[std::make_pair(x, y)];
+        cached.mLastUsed = ++mHeightFieldShapeUses;
+        // Same cell in another worldspace or a changed land record builds a new shape
+        if (cached.mShape == nullptr || !cached.mShape->matches(heights, size, verts, minH, maxH))
+            cached.mShape = std::make_shared<HeightFieldShape>(heights, size, verts, minH, maxH, holdObject);
+        return cached.mShape;
+    }
+
+    void PhysicsSystem::trimHeightFieldShapes()
+    {
+        std::vector<std::map<std::pair<int, int>, CachedHeightFieldShape>::iterator> unused;
+        for (auto it = mHeightFieldShapes.begin(); it != mHeightFieldShapes.end(); ++it)
+            if (it->second.mShape.use_count() == 1)
+                unused.push_back(it);
+
+        if (unused.size() <= sMaxUnusedHeightFieldShapes)
+            return;
+
+        const auto evict = unused.begin() + (unused.size() - sMaxUnusedHeightFieldShapes);
+        std::nth_element(unused.begin(), evict, unused.end(),
+            [](const auto& l, const auto& r) { return l->second.mLastUsed < r->second.mLastUsed; });
+        for (auto it = unused.begin(); it != evict; ++it)
+            mHeightFieldShapes.erase(*it);
     }
 
     const HeightField* PhysicsSystem::getHeightField(int x, int y) const
@@ -443,6 +595,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            releaseMergedStatic(*foundObject->second);
             mAnimatedObjects.erase(foundObject->second.get());
 
             mObjects.erase(foundObject);
@@ -460,10 +613,46 @@ namespace MWPhysics
             mProjectiles.erase(foundProjectile);
     }
 
+    void PhysicsSystem::mergeStatics(const MWWorld::CellStore& cell)
+    {
+        if (mMergedStatics.contains(&cell))
+            return;
+
+        std::vector<Object*> objects;
+        for (const auto& [ref, object] : mObjects)
+            if (object->getPtr().getCell() == &cell && object->getMergedStatics() == nullptr && canMergeStatic(*object))
+                objects.push_back(object.get());
+
+        // A single object gains nothing from merging
+        if (objects.size() < 2)
+            return;
+
+        mMergedStatics.emplace(&cell, std::make_unique<MergedStatics>(cell, objects, mTaskScheduler.get()));
+    }
+
+    void PhysicsSystem::removeMergedStatics(const MWWorld::CellStore& cell)
+    {
+        mMergedStatics.erase(&cell);
+    }
+
+    void PhysicsSystem::releaseMergedStatic(Object& object)
+    {
+        MergedStatics* const merged = object.getMergedStatics();
+        if (merged == nullptr)
+            return;
+        merged->release(object);
+        if (merged->empty())
+            mMergedStatics.erase(&merged->getCell());
+    }
+
     void PhysicsSystem::updatePtr(const MWWorld::Ptr& old, const MWWorld::Ptr& updated)
     {
         if (auto foundObject = mObjects.find(old.mRef); foundObject != mObjects.end())
+        {
+            if (old.getCell() != updated.getCell())
+                releaseMergedStatic(*foundObject->second);
             foundObject->second->updatePtr(updated);
+        }
         else if (auto foundActor = mActors.find(old.mRef); foundActor != mActors.end())
             foundActor->second->updatePtr(updated);
 
@@ -516,6 +705,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            releaseMergedStatic(*foundObject->second);
             float scale = ptr.getCellRef().getScale();
             foundObject->second->setScale(scale);
             mTaskScheduler->updateSingleAabb(foundObject->second);
@@ -531,6 +721,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            releaseMergedStatic(*foundObject->second);
             foundObject->second->setRotation(rotate);
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
@@ -548,6 +739,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            releaseMergedStatic(*foundObject->second);
             foundObject->second->updatePosition();
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
@@ -646,6 +838,10 @@ namespace MWPhysics
         assert(simulations.empty());
         simulations.reserve(mActors.size() + mProjectiles.size());
         const MWBase::World* world = MWBase::Environment::get().getWorld();
+        const osg::Vec3f playerPosition = world->getPlayerConstPtr().getRefData().getPosition().asVec3();
+        const float lodDistance = Settings::physics().mActorLodDistance;
+        if (willSimulate)
+            ++mLodFrame;
         for (const auto& [ref, physicActor] : mActors)
         {
             if (!physicActor->isActive())
@@ -678,11 +874,20 @@ namespace MWPhysics
             const bool inert = stats.isDead()
                 || (!godmode && stats.getMagicEffects().getOrDefault(ESM::MagicEffect::Paralyze).getModifier() > 0);
 
-            simulations.emplace_back(ActorSimulation{
-                physicActor, ActorFrameData{ *physicActor, inert, waterCollision, slowFall, waterlevel, isPlayer } });
+            ActorFrameData frameData{ *physicActor, inert, waterCollision, slowFall, waterlevel, isPlayer };
+            if (lodDistance > 0 && !isPlayer)
+            {
+                const float distance = (ptr.getRefData().getPosition().asVec3() - playerPosition).length();
+                frameData.mLodInterval = distance >= 2 * lodDistance ? 4 : distance >= lodDistance ? 2 : 1;
+                // Spread the simulated frames of distant actors evenly
+                const auto phaseOffset = static_cast<unsigned>(reinterpret_cast<std::uintptr_t>(ref) >> 4);
+                frameData.mLodPhase = (mLodFrame + phaseOffset) % frameData.mLodInterval;
+            }
+            const bool simulated = frameData.mLodPhase == 0;
+            simulations.emplace_back(ActorSimulation{ physicActor, std::move(frameData) });
 
             // if the simulation will run, a jump request will be fulfilled. Update mechanics accordingly.
-            if (willSimulate)
+            if (willSimulate && simulated)
                 handleJump(ptr);
         }
 
@@ -867,8 +1072,27 @@ namespace MWPhysics
     {
         stats.setAttribute(frameNumber, "Physics Actors", mActors.size());
         stats.setAttribute(frameNumber, "Physics Objects", mObjects.size());
+        std::size_t mergedObjects = 0;
+        for (const auto& [cell, merged] : mMergedStatics)
+            mergedObjects += merged->size();
+        stats.setAttribute(frameNumber, "Physics Merged Objects", mergedObjects);
         stats.setAttribute(frameNumber, "Physics Projectiles", mProjectiles.size());
         stats.setAttribute(frameNumber, "Physics HeightFields", mHeightFields.size());
+        stats.setAttribute(frameNumber, "Physics HeightField Shapes", mHeightFieldShapes.size());
+    }
+
+    Resource::MemoryUsage PhysicsSystem::getMemoryUsage() const
+    {
+        Resource::MemoryUsage result;
+        result.mCpu += mObjects.size() * (sizeof(Object) + sizeof(btCollisionObject));
+        result.mCpu += mActors.size() * (sizeof(Actor) + sizeof(btCollisionObject));
+        result.mCpu += mProjectiles.size() * (sizeof(Projectile) + sizeof(btCollisionObject));
+        result.mCpu += mHeightFields.size() * (sizeof(HeightField) + sizeof(btCollisionObject));
+        for (const auto& [key, cached] : mHeightFieldShapes)
+            result.mCpu += cached.mShape->estimateSize();
+        for (const auto& [cell, merged] : mMergedStatics)
+            result.mCpu += merged->estimateSize();
+        return result;
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -921,12 +1145,17 @@ namespace MWPhysics
     WorldFrameData::WorldFrameData()
         : mIsInStorm(MWBase::Environment::get().getWorld()->isInStorm())
         , mStormDirection(MWBase::Environment::get().getWorld()->getStormDirection())
+        , mStormWalkMult(MWBase::Environment::get()
+                  .getESMStore()
+                  ->get<ESM::GameSetting>()
+                  .find("fStromWalkMult")
+                  ->mValue.getFloat())
     {
     }
 
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
         : mResult(false)
-        , mStale(false)
+        , mPending(false)
         , mAge(0)
     {
         // we use raw actor pointer pair to uniquely identify request
@@ -946,9 +1175,4 @@ namespace MWPhysics
             mRawActors = { raw2, raw1 };
         }
     }
-
-    bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept
-    {
-        return lhs.mRawActors == rhs.mRawActors;
-    }
 }
@@ -16,6 +16,7 @@
 #include <osg/Timer>
 #include <osg/ref_ptr>
 
+#include <components/resource/memoryregistry.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include "../mwworld/ptr.hpp"
@@ -49,9 +50,16 @@ class btCollisionObject;
 class btCollisionShape;
 class btVector3;
 
+namespace MWWorld
+{
+    class CellStore;
+}
+
 namespace MWPhysics
 {
     class HeightField;
+    class HeightFieldShape;
+    class MergedStatics;
     class Object;
     class Actor;
     class PhysicsTaskScheduler;
@@ -73,10 +81,9 @@ namespace MWPhysics
         std::array<std::weak_ptr<Actor>, 2> mActors;
         std::array<const Actor*, 2> mRawActors;
         bool mResult;
-        bool mStale;
+        bool mPending; // Queued ahead, no raycast done yet
         int mAge;
     };
-    bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
 
     struct ActorFrameData
     {
@@ -104,6 +111,10 @@ namespace MWPhysics
         const bool mWaterCollision;
         const bool mSkipCollisionDetection;
         const bool mIsPlayer;
+        // Distant actors are only simulated every mLodInterval frames, with steps of that many times the physics dt
+        unsigned mLodInterval = 1;
+        // Frames since the actor was last simulated, 0 if it is simulated this frame
+        unsigned mLodPhase = 0;
     };
 
     struct ProjectileFrameData
@@ -121,6 +132,7 @@ namespace MWPhysics
         WorldFrameData();
         bool mIsInStorm;
         osg::Vec3f mStormDirection;
+        float mStormWalkMult; // fStromWalkMult, looked up once per frame instead of per actor and step
     };
 
     template <class Ptr, class FrameData>
@@ -182,6 +194,14 @@ namespace MWPhysics
         // Object or Actor
         void remove(const MWWorld::Ptr& ptr);
 
+        /// Merge the collision of the static objects of the cell that are not scripted or animated, they are released
+        /// when they change.
+        void mergeStatics(const MWWorld::CellStore& cell);
+
+        /// Put the merged objects of the cell back into the world each with its own collision object, e.g. before
+        /// removing all of them.
+        void removeMergedStatics(const MWWorld::CellStore& cell);
+
         void updateScale(const MWWorld::Ptr& ptr);
         void updateRotation(const MWWorld::Ptr& ptr, osg::Quat rotate);
         void updatePosition(const MWWorld::Ptr& ptr);
@@ -219,9 +239,19 @@ namespace MWPhysics
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
+        void castRays(std::span<const RayCastingRequest> rays, std::span<RayCastingResult> results,
+            const std::vector<MWWorld::ConstPtr>& ignore = {}, int mask = CollisionType_Default,
+            int group = 0xff) const override;
+
+        void castSpheres(std::span<const RayCastingRequest> rays, float radius, std::span<RayCastingResult> results,
+            int mask = CollisionType_Default, int group = 0xff) const override;
+
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
+        /// Ask the physics workers to compute line of sight between two actors before it is needed.
+        void queueLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const;
+
         bool isOnGround(const MWWorld::Ptr& actor);
 
         bool canMoveToWaterSurface(const MWWorld::ConstPtr& actor, const float waterlevel);
@@ -285,6 +315,11 @@ namespace MWPhysics
             const MWWorld::LiveCellRefBase* actor, const osg::Vec3f& position, float radius) const;
 
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+        /// Estimate memory of the collision objects and height fields, shapes of objects are owned by the shape
+        /// manager cache.
+        Resource::MemoryUsage getMemoryUsage() const;
+
         void reportCollision(const btVector3& position, const btVector3& normal);
 
         float mPhysicsDt;
@@ -292,6 +327,8 @@ namespace MWPhysics
     private:
         void updateWater();
 
+        void releaseMergedStatic(Object& object);
+
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
@@ -308,6 +345,8 @@ namespace MWPhysics
 
         std::map<Object*, bool> mAnimatedObjects; // stores pointers to elements in mObjects
 
+        std::unordered_map<const MWWorld::CellStore*, std::unique_ptr<MergedStatics>> mMergedStatics;
+
         ActorMap mActors;
 
         using ProjectileMap = std::map<int, std::shared_ptr<Projectile>>;
@@ -316,9 +355,31 @@ namespace MWPhysics
         using HeightFieldMap = std::map<std::pair<int, int>, std::unique_ptr<HeightField>>;
         HeightFieldMap mHeightFields;
 
+        struct CachedHeightFieldShape
+        {
+            std::shared_ptr<HeightFieldShape> mShape;
+            std::size_t mLastUsed;
+        };
+
+        /// Shapes outlive their HeightField so revisiting a cell reuses them instead of building the accelerator
+        /// again. Shapes not used by any HeightField are evicted least recently used first.
+        std::map<std::pair<int, int>, CachedHeightFieldShape> mHeightFieldShapes;
+        std::size_t mHeightFieldShapeUses = 0;
+
+        static constexpr std::size_t sMaxUnusedHeightFieldShapes = 32;
+
+        std::vector<const btCollisionObject*> getIgnoredCollisionObjects(
+            const std::vector<MWWorld::ConstPtr>& ignore) const;
+
+        std::shared_ptr<HeightFieldShape> getHeightFieldShape(const float* heights, int x, int y, int size,
+            int verts, float minH, float maxH, const osg::Object* holdObject);
+
+        void trimHeightFieldShapes();
+
         bool mDebugDrawEnabled;
 
         float mTimeAccum;
+        unsigned mLodFrame = 0;
 
         unsigned int mProjectileId;
 
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWPHYSICS_PTRHOLDER_H
 #define OPENMW_MWPHYSICS_PTRHOLDER_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -50,6 +51,11 @@ namespace MWPhysics
 
         osg::Vec3d getPreviousPosition() const { return mPreviousPosition; }
 
+        /// @return true if the object was not already waiting for an AABB update
+        bool markAabbDirty() { return !mAabbDirty.exchange(true, std::memory_order_acq_rel); }
+
+        void clearAabbDirty() { mAabbDirty.store(false, std::memory_order_release); }
+
     protected:
         MWWorld::Ptr mPtr;
         std::unique_ptr<btCollisionObject> mCollisionObject;
@@ -57,6 +63,9 @@ namespace MWPhysics
         osg::Vec3f mSimulationPosition;
         osg::Vec3d mPosition;
         osg::Vec3d mPreviousPosition;
+
+    private:
+        std::atomic<bool> mAabbDirty{ false };
     };
 }
 
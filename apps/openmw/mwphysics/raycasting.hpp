@@ -3,6 +3,9 @@
 
 #include <osg/Vec3f>
 
+#include <span>
+#include <vector>
+
 #include "../mwworld/ptr.hpp"
 
 #include "collisiontype.hpp"
@@ -18,6 +21,12 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    struct RayCastingRequest
+    {
+        osg::Vec3f mFrom;
+        osg::Vec3f mTo;
+    };
+
     class RayCastingInterface
     {
     public:
@@ -37,6 +46,16 @@ namespace MWPhysics
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
+        /// Same as castRay for each ray but the collision world is locked once for the whole batch.
+        /// @param results must have the same size as rays, results[i] is the result of rays[i]
+        virtual void castRays(std::span<const RayCastingRequest> rays, std::span<RayCastingResult> results,
+            const std::vector<MWWorld::ConstPtr>& ignore = {}, int mask = CollisionType_Default,
+            int group = 0xff) const = 0;
+
+        /// Same as castSphere for each ray but the collision world is locked once for the whole batch.
+        virtual void castSpheres(std::span<const RayCastingRequest> rays, float radius,
+            std::span<RayCastingResult> results, int mask = CollisionType_Default, int group = 0xff) const = 0;
+
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
     };
@@ -1,6 +1,7 @@
 #include "animation.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <limits>
 
@@ -490,7 +491,9 @@ namespace MWRender
     {
         osg::ref_ptr<const SceneUtil::KeyframeHolder> mKeyframes;
 
-        typedef std::map<std::string, osg::ref_ptr<SceneUtil::KeyframeController>> ControllerMap;
+        // Keyed by the animated node itself, so neither adding a source nor activating it needs bone name lookups
+        typedef std::vector<std::pair<osg::ref_ptr<osg::Node>, osg::ref_ptr<SceneUtil::KeyframeController>>>
+            ControllerMap;
 
         ControllerMap mControllerMap[sNumBlendMasks];
 
@@ -597,6 +600,12 @@ namespace MWRender
             mSkeleton->setActive(static_cast<SceneUtil::Skeleton::ActiveType>(active));
     }
 
+    void Animation::setUpdateInterval(unsigned int interval, unsigned int phase)
+    {
+        if (mSkeleton)
+            mSkeleton->setUpdateInterval(interval, phase);
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr& ptr)
     {
         mPtr = ptr;
@@ -699,11 +708,11 @@ namespace MWRender
         for (SceneUtil::KeyframeHolder::KeyframeControllerMap::const_iterator it = controllerMap.begin();
              it != controllerMap.end(); ++it)
         {
-            std::string bonename = Misc::StringUtils::lowerCase(it->first);
-            NodeMap::const_iterator found = nodeMap.find(bonename);
+            NodeMap::const_iterator found = nodeMap.find(it->first);
             if (found == nodeMap.end())
             {
-                Log(Debug::Warning) << "Warning: addAnimSource: can't find bone '" + bonename << "' in " << baseModel
+                Log(Debug::Warning) << "Warning: addAnimSource: can't find bone '"
+                                    << Misc::StringUtils::lowerCase(it->first) << "' in " << baseModel
                                     << " (referenced by " << kfname << ")";
                 continue;
             }
@@ -717,7 +726,16 @@ namespace MWRender
                 = osg::clone(it->second.get(), osg::CopyOp::SHALLOW_COPY);
             cloned->setSource(mAnimationTimePtr[blendMask]);
 
-            animsrc->mControllerMap[blendMask].insert(std::make_pair(bonename, cloned));
+            animsrc->mControllerMap[blendMask].emplace_back(node, std::move(cloned));
+        }
+
+        // Bone names differing only in case refer to the same node, the first controller for each node is used
+        for (AnimSource::ControllerMap& controllers : animsrc->mControllerMap)
+        {
+            const auto byNode = [](const auto& v) { return v.first.get(); };
+            std::ranges::stable_sort(controllers, std::less<>(), byNode);
+            const auto [first, last] = std::ranges::unique(controllers, std::equal_to<>(), byNode);
+            controllers.erase(first, last);
         }
 
         mAnimSources.push_back(animsrc);
@@ -1165,8 +1183,7 @@ namespace MWRender
                 for (AnimSource::ControllerMap::iterator it = animsrc->mControllerMap[blendMask].begin();
                      it != animsrc->mControllerMap[blendMask].end(); ++it)
                 {
-                    osg::ref_ptr<osg::Node> node = getNodeMap().at(
-                        it->first); // this should not throw, we already checked for the node existing in addAnimSource
+                    const osg::ref_ptr<osg::Node>& node = it->first;
 
                     const bool useSmoothAnims = Settings::game().mSmoothAnimTransitions;
 
@@ -1305,7 +1322,7 @@ namespace MWRender
         const AnimSource::ControllerMap& ctrls = (*animsrc)->mControllerMap[0];
         for (AnimSource::ControllerMap::const_iterator it = ctrls.begin(); it != ctrls.end(); ++it)
         {
-            if (Misc::StringUtils::ciEqual(it->first, mAccumRoot->getName()))
+            if (it->first == mAccumRoot)
             {
                 velocity = calcAnimVelocity(keys, it->second, mAccumulate, groupname);
                 break;
@@ -1326,7 +1343,7 @@ namespace MWRender
                 const AnimSource::ControllerMap& ctrls2 = (*animiter)->mControllerMap[0];
                 for (AnimSource::ControllerMap::const_iterator it = ctrls2.begin(); it != ctrls2.end(); ++it)
                 {
-                    if (Misc::StringUtils::ciEqual(it->first, mAccumRoot->getName()))
+                    if (it->first == mAccumRoot)
                     {
                         velocity = calcAnimVelocity(keys2, it->second, mAccumulate, groupname);
                         break;
@@ -331,6 +331,10 @@ namespace MWRender
         /// 0 = Inactive, 1 = Active in place, 2 = Active
         void setActive(int active);
 
+        /// Update the pose of the object skeleton only every few frames, if one exists.
+        /// @see SceneUtil::Skeleton::setUpdateInterval
+        void setUpdateInterval(unsigned int interval, unsigned int phase);
+
         osg::Group* getOrCreateObjectRoot();
 
         osg::Group* getObjectRoot();
@@ -25,6 +25,7 @@
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/settings/values.hpp>
+#include <components/shader/shadermanager.hpp>
 #include <components/stereo/multiview.hpp>
 
 #include "../mwworld/class.hpp"
@@ -233,6 +234,12 @@ namespace MWRender
             .mMaximumLightDistance = Settings::shaders().mMaximumLightDistance,
             .mLightFadeStart = Settings::shaders().mLightFadeStart,
             .mLightBoundsMultiplier = Settings::shaders().mLightBoundsMultiplier,
+            .mClusteredLighting = Settings::shaders().mClusteredLighting,
+            .mLightClustersTextureUnit = Settings::shaders().mClusteredLighting
+                    && mResourceSystem->getSceneManager()->getLightingMethod() == SceneUtil::LightingMethod::SingleUBO
+                ? mResourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                    Shader::ShaderManager::Slot::LightClusters)
+                : -1,
         });
         lightManager->setStartLight(1);
         osg::ref_ptr<osg::StateSet> stateset = lightManager->getOrCreateStateSet();
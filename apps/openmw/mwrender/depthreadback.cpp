@@ -0,0 +1,91 @@
+#include "depthreadback.hpp"
+
+#include <osg/BufferObject>
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Texture>
+
+#include <components/sceneutil/depth.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace MWRender
+{
+    DepthReadback::DepthReadback(SceneUtil::OcclusionCuller& culler)
+        : mCuller(&culler)
+    {
+    }
+
+    void DepthReadback::resize(osg::State& state, int sourceWidth, int sourceHeight, GLenum internalFormat)
+    {
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+
+        mSourceWidth = sourceWidth;
+        mSourceHeight = sourceHeight;
+        mHeight = std::max(1, static_cast<int>(std::lround(sWidth * sourceHeight / static_cast<double>(sourceWidth))));
+
+        // Blitting depth requires matching formats, a color attachment keeps the framebuffer complete on older drivers
+        mFbo = new osg::FrameBufferObject;
+        mFbo->setAttachment(osg::FrameBufferObject::BufferComponent::PACKED_DEPTH_STENCIL_BUFFER,
+            osg::FrameBufferAttachment(new osg::RenderBuffer(sWidth, mHeight, internalFormat)));
+        mFbo->setAttachment(osg::FrameBufferObject::BufferComponent::COLOR_BUFFER0,
+            osg::FrameBufferAttachment(new osg::RenderBuffer(sWidth, mHeight, GL_RGBA8)));
+
+        if (mBuffers[0] == 0)
+            ext->glGenBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
+        for (GLuint buffer : mBuffers)
+        {
+            ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, buffer);
+            ext->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, sWidth * mHeight * sizeof(float), nullptr, GL_STREAM_READ_ARB);
+        }
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+        mPending = {};
+    }
+
+    void DepthReadback::readback(osg::State& state, osg::FrameBufferObject& source, const osg::Texture& depth)
+    {
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        if (!ext->isPBOSupported)
+            return;
+
+        const int sourceWidth = depth.getTextureWidth();
+        const int sourceHeight = depth.getTextureHeight();
+        if (sourceWidth <= 0 || sourceHeight <= 0)
+            return;
+
+        if (mFbo == nullptr || sourceWidth != mSourceWidth || sourceHeight != mSourceHeight)
+            resize(state, sourceWidth, sourceHeight, depth.getInternalFormat());
+
+        // Point sampling is fine for the pyramid as long as occluders are larger than a texel of the copy
+        source.apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        mFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+        ext->glBlitFramebuffer(
+            0, 0, sourceWidth, sourceHeight, 0, 0, sWidth, mHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+        mFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, mBuffers[mCurrent]);
+        glReadPixels(0, 0, sWidth, mHeight, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+        const std::size_t previous = (mCurrent + 1) % mBuffers.size();
+        const Pending& pending = mPending[previous];
+        if (pending.mViewProjection.has_value())
+        {
+            ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, mBuffers[previous]);
+            if (const void* data = ext->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB))
+            {
+                mCuller->setDepth(pending.mFrameNumber,
+                    std::span(static_cast<const float*>(data), static_cast<std::size_t>(sWidth * mHeight)), sWidth,
+                    mHeight, *pending.mViewProjection, SceneUtil::AutoDepth::isReversed());
+                ext->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+            }
+        }
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+        const unsigned frameNumber = state.getFrameStamp()->getFrameNumber();
+        mPending[mCurrent] = Pending{ frameNumber, mCuller->getViewProjection(frameNumber) };
+        mCurrent = previous;
+    }
+}
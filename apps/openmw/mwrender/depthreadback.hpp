@@ -0,0 +1,55 @@
+#ifndef OPENMW_MWRENDER_DEPTHREADBACK_H
+#define OPENMW_MWRENDER_DEPTHREADBACK_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include <osg/FrameBufferObject>
+#include <osg/Matrixf>
+#include <osg/ref_ptr>
+
+#include <components/sceneutil/occlusionculler.hpp>
+
+namespace osg
+{
+    class State;
+    class Texture;
+}
+
+namespace MWRender
+{
+    /// @brief Reads back a downscaled copy of the opaque scene depth for occlusion culling.
+    /// @par The copy is read into pixel buffer objects and only mapped while drawing the next frame, so the draw
+    /// thread does not wait for the GPU.
+    class DepthReadback
+    {
+    public:
+        explicit DepthReadback(SceneUtil::OcclusionCuller& culler);
+
+        /// Copy the depth of the source framebuffer, then publish the depth copied by the previous call.
+        void readback(osg::State& state, osg::FrameBufferObject& source, const osg::Texture& depth);
+
+    private:
+        struct Pending
+        {
+            unsigned mFrameNumber = 0;
+            std::optional<osg::Matrixf> mViewProjection;
+        };
+
+        static constexpr int sWidth = 256;
+
+        osg::ref_ptr<SceneUtil::OcclusionCuller> mCuller;
+        osg::ref_ptr<osg::FrameBufferObject> mFbo;
+        int mHeight = 0;
+        int mSourceWidth = 0;
+        int mSourceHeight = 0;
+        std::array<GLuint, 2> mBuffers{};
+        std::array<Pending, 2> mPending;
+        std::size_t mCurrent = 0;
+
+        void resize(osg::State& state, int sourceWidth, int sourceHeight, GLenum internalFormat);
+    };
+}
+
+#endif
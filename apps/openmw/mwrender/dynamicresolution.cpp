@@ -0,0 +1,60 @@
+#include "dynamicresolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MWRender
+{
+    DynamicResolution::DynamicResolution(double targetMs, float minScale, float maxScale)
+        : mTargetMs(targetMs)
+        , mMinScale(std::min(minScale, maxScale))
+        , mMaxScale(maxScale)
+        , mScale(maxScale)
+    {
+    }
+
+    bool DynamicResolution::update(double gpuTimeMs)
+    {
+        if (mSkipped < sSkippedSamples)
+        {
+            ++mSkipped;
+            return false;
+        }
+
+        mTotalMs += gpuTimeMs;
+        if (++mSamples < sSampleCount)
+            return false;
+
+        const double averageMs = mTotalMs / mSamples;
+        mTotalMs = 0;
+        mSamples = 0;
+
+        const float scale = computeScale(averageMs);
+        if (scale == mScale)
+            return false;
+
+        mScale = scale;
+        mSkipped = 0;
+        return true;
+    }
+
+    float DynamicResolution::computeScale(double averageMs) const
+    {
+        if (averageMs <= 0)
+            return mMaxScale;
+
+        // The GPU time mostly follows the number of pixels, which is the square of the scale
+        double wanted;
+        if (averageMs > mTargetMs)
+            wanted = mScale * std::sqrt(mTargetMs / averageMs);
+        else if (averageMs < mTargetMs * sUpscaleMargin)
+            wanted = mScale * std::sqrt(mTargetMs * sUpscaleMargin / averageMs);
+        else
+            return mScale;
+
+        // Round towards the smaller scale so frames that are too slow always lose at least one step
+        float stepped = static_cast<float>(std::floor(wanted / sStep + 1e-4) * sStep);
+        stepped = averageMs > mTargetMs ? std::min(stepped, mScale) : std::max(stepped, mScale);
+        return std::clamp(stepped, mMinScale, mMaxScale);
+    }
+}
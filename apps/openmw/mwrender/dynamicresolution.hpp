@@ -0,0 +1,46 @@
+#ifndef OPENMW_MWRENDER_DYNAMICRESOLUTION_H
+#define OPENMW_MWRENDER_DYNAMICRESOLUTION_H
+
+namespace MWRender
+{
+    /// Picks the scale of the scene render targets from the measured GPU time, so it stays close to a target
+    /// @par The scale changes in steps and only after averaging the frames rendered with the current one, as every
+    /// change reallocates the render targets
+    class DynamicResolution
+    {
+    public:
+        /// Frames which may still have been in flight when the scale changed
+        static constexpr unsigned sSkippedSamples = 8;
+
+        /// Frames averaged before the scale changes again
+        static constexpr unsigned sSampleCount = 30;
+
+        /// Granularity of the scale
+        static constexpr float sStep = 0.05f;
+
+        /// The scale only grows while the time is below this fraction of the target, so it doesn't oscillate
+        static constexpr double sUpscaleMargin = 0.85;
+
+        /// Starts at the maximum scale
+        DynamicResolution(double targetMs, float minScale, float maxScale);
+
+        float getScale() const { return mScale; }
+
+        /// @param gpuTimeMs GPU time of a frame, in the order the frames were rendered
+        /// @return Whether the scale changed
+        bool update(double gpuTimeMs);
+
+    private:
+        double mTargetMs;
+        float mMinScale;
+        float mMaxScale;
+        float mScale;
+        unsigned mSkipped = 0;
+        unsigned mSamples = 0;
+        double mTotalMs = 0;
+
+        float computeScale(double averageMs) const;
+    };
+}
+
+#endif
@@ -1,5 +1,10 @@
 #include "globalmap.hpp"
 
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
 #include <osg/Geometry>
 #include <osg/Group>
 #include <osg/Image>
@@ -144,9 +149,56 @@ namespace MWRender
             alphaImage->allocateImage(mWidth, mHeight, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
             unsigned char* alphaData = alphaImage->data();
 
+            // Rows of cells are independent, so bands of them are filled in parallel
+            const int rows = mMaxY - mMinY + 1;
+            const int bands = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, rows);
+            std::vector<std::future<void>> futures;
+            futures.reserve(bands - 1);
+            for (int band = 1; band < bands; ++band)
+                futures.push_back(std::async(std::launch::async, [this, band, bands, rows, data, alphaData] {
+                    fillRows(mMinY + rows * band / bands, mMinY + rows * (band + 1) / bands, data, alphaData);
+                }));
+            fillRows(mMinY, mMinY + rows / bands, data, alphaData);
+            for (std::future<void>& future : futures)
+                future.get();
+
+            mBaseTexture = new osg::Texture2D;
+            mBaseTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            mBaseTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            mBaseTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+            mBaseTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+            mBaseTexture->setImage(image);
+            mBaseTexture->setResizeNonPowerOfTwoHint(false);
+
+            mAlphaTexture = new osg::Texture2D;
+            mAlphaTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            mAlphaTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            mAlphaTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+            mAlphaTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+            mAlphaTexture->setImage(alphaImage);
+            mAlphaTexture->setResizeNonPowerOfTwoHint(false);
+
+            mOverlayImage = new osg::Image;
+            mOverlayImage->allocateImage(mWidth, mHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            assert(mOverlayImage->isDataContiguous());
+
+            memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
+
+            mOverlayTexture = new osg::Texture2D;
+            mOverlayTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            mOverlayTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            mOverlayTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+            mOverlayTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+            mOverlayTexture->setResizeNonPowerOfTwoHint(false);
+            mOverlayTexture->setInternalFormat(GL_RGBA);
+            mOverlayTexture->setTextureSize(mWidth, mHeight);
+        }
+
+        void fillRows(int beginY, int endY, unsigned char* data, unsigned char* alphaData) const
+        {
             for (int x = mMinX; x <= mMaxX; ++x)
             {
-                for (int y = mMinY; y <= mMaxY; ++y)
+                for (int y = beginY; y < endY; ++y)
                 {
                     const ESM::Land* land = mLandStore.search(x, y);
 
@@ -205,37 +257,6 @@ namespace MWRender
                     }
                 }
             }
-
-            mBaseTexture = new osg::Texture2D;
-            mBaseTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mBaseTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mBaseTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mBaseTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mBaseTexture->setImage(image);
-            mBaseTexture->setResizeNonPowerOfTwoHint(false);
-
-            mAlphaTexture = new osg::Texture2D;
-            mAlphaTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mAlphaTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mAlphaTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mAlphaTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mAlphaTexture->setImage(alphaImage);
-            mAlphaTexture->setResizeNonPowerOfTwoHint(false);
-
-            mOverlayImage = new osg::Image;
-            mOverlayImage->allocateImage(mWidth, mHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE);
-            assert(mOverlayImage->isDataContiguous());
-
-            memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
-
-            mOverlayTexture = new osg::Texture2D;
-            mOverlayTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mOverlayTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mOverlayTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mOverlayTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mOverlayTexture->setResizeNonPowerOfTwoHint(false);
-            mOverlayTexture->setInternalFormat(GL_RGBA);
-            mOverlayTexture->setTextureSize(mWidth, mHeight);
         }
 
         int mWidth, mHeight;
@@ -0,0 +1,151 @@
+#include "gpuprecipitation.hpp"
+
+#include <cmath>
+
+#include <osg/BlendFunc>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Texture2D>
+
+#include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/statesetupdater.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/stereo/stereomanager.hpp>
+
+namespace MWRender
+{
+    class GpuPrecipitationUpdater : public SceneUtil::StateSetUpdater
+    {
+    public:
+        osg::Vec3f mRange{ 1, 1, 1 };
+        osg::Vec3f mOffset;
+        osg::Vec3f mVelocity{ 0, 0, -1 };
+        osg::Vec3f mDropSize{ 1, 1, 1 };
+        float mAlpha = 0.f;
+
+    private:
+        void setDefaults(osg::StateSet* stateset) override
+        {
+            stateset->addUniform(new osg::Uniform("precipitationRange", mRange));
+            stateset->addUniform(new osg::Uniform("precipitationOffset", mOffset));
+            stateset->addUniform(new osg::Uniform("precipitationVelocity", mVelocity));
+            stateset->addUniform(new osg::Uniform("dropSize", mDropSize));
+            stateset->addUniform(new osg::Uniform("precipitationAlpha", mAlpha));
+        }
+
+        void apply(osg::StateSet* stateset, osg::NodeVisitor* /*nv*/) override
+        {
+            stateset->getUniform("precipitationRange")->set(mRange);
+            stateset->getUniform("precipitationOffset")->set(mOffset);
+            stateset->getUniform("precipitationVelocity")->set(mVelocity);
+            stateset->getUniform("dropSize")->set(mDropSize);
+            stateset->getUniform("precipitationAlpha")->set(mAlpha);
+        }
+    };
+
+    GpuPrecipitation::GpuPrecipitation(
+        Resource::SceneManager& sceneManager, osg::ref_ptr<osg::Texture2D> texture, bool occlusion)
+        : mNode(new osg::Group)
+        , mDrawArrays(new osg::DrawArrays(GL_TRIANGLE_STRIP, 0, 4, 0))
+        , mUpdater(new GpuPrecipitationUpdater)
+    {
+        // A single quad, the drops are its instances
+        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
+        vertices->push_back(osg::Vec3f(-0.5f, -0.5f, 0.f));
+        vertices->push_back(osg::Vec3f(0.5f, -0.5f, 0.f));
+        vertices->push_back(osg::Vec3f(-0.5f, 0.5f, 0.f));
+        vertices->push_back(osg::Vec3f(0.5f, 0.5f, 0.f));
+
+        osg::ref_ptr<osg::Vec2Array> texCoords = new osg::Vec2Array;
+        texCoords->push_back(osg::Vec2f(0.f, 0.f));
+        texCoords->push_back(osg::Vec2f(1.f, 0.f));
+        texCoords->push_back(osg::Vec2f(0.f, 1.f));
+        texCoords->push_back(osg::Vec2f(1.f, 1.f));
+
+        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+        geometry->setVertexArray(vertices);
+        geometry->setTexCoordArray(0, texCoords, osg::Array::BIND_PER_VERTEX);
+        geometry->addPrimitiveSet(mDrawArrays);
+        geometry->setUseDisplayList(false);
+        geometry->setUseVertexBufferObjects(true);
+        // The instance count changes with the weather
+        geometry->setDataVariance(osg::Object::DYNAMIC);
+        // The drops surround the camera, while the bounds only know about the quad
+        geometry->setCullingActive(false);
+        mNode->addChild(geometry);
+
+        osg::StateSet* stateset = mNode->getOrCreateStateSet();
+        stateset->setTextureAttributeAndModes(0, texture);
+        stateset->addUniform(new osg::Uniform("diffuseMap", 0));
+        stateset->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
+        stateset->setNestRenderBins(false);
+        stateset->setMode(GL_CULL_FACE, osg::StateAttribute::OFF);
+        stateset->setMode(GL_BLEND, osg::StateAttribute::ON);
+        stateset->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+        osg::ref_ptr<osg::Depth> depth = new SceneUtil::AutoDepth;
+        depth->setWriteMask(false);
+        stateset->setAttributeAndModes(depth);
+
+        Shader::ShaderManager::DefineMap defines = sceneManager.getShaderManager().getGlobalDefines();
+        defines["particleOcclusion"] = occlusion ? "1" : "0";
+        Stereo::shaderStereoDefines(defines);
+        stateset->setAttributeAndModes(sceneManager.getShaderManager().getProgram("precipitation", defines),
+            osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+
+        mNode->addUpdateCallback(mUpdater);
+    }
+
+    GpuPrecipitation::~GpuPrecipitation() = default;
+
+    bool GpuPrecipitation::isSupported(const Resource::SceneManager& sceneManager)
+    {
+        return sceneManager.getForceShaders() && SceneUtil::glExtensionsReady()
+            && osg::isGLExtensionOrVersionSupported(
+                SceneUtil::getGLExtensions().contextID, "GL_ARB_draw_instanced", 3.1);
+    }
+
+    void GpuPrecipitation::setRange(const osg::Vec3f& range)
+    {
+        mUpdater->mRange = range;
+    }
+
+    void GpuPrecipitation::setVelocity(const osg::Vec3f& velocity)
+    {
+        // The shader stretches the drops along the velocity
+        mUpdater->mVelocity = velocity.length2() > 0.f ? velocity : osg::Vec3f(0, 0, -1);
+    }
+
+    void GpuPrecipitation::setDropSize(float minHeight, float maxHeight, float widthScale)
+    {
+        mUpdater->mDropSize = osg::Vec3f(minHeight, maxHeight, widthScale);
+    }
+
+    void GpuPrecipitation::setDropCount(unsigned count)
+    {
+        mDrawArrays->setNumInstances(count);
+    }
+
+    void GpuPrecipitation::setAlpha(float alpha)
+    {
+        mUpdater->mAlpha = alpha;
+    }
+
+    void GpuPrecipitation::update(float duration)
+    {
+        if (mFrozen)
+            return;
+
+        // Keep the offset within the volume so it does not lose precision over time
+        osg::Vec3f& offset = mUpdater->mOffset;
+        offset += mUpdater->mVelocity * duration;
+        for (int i = 0; i < 3; ++i)
+        {
+            offset[i] = std::fmod(offset[i], mUpdater->mRange[i]);
+            if (offset[i] < 0)
+                offset[i] += mUpdater->mRange[i];
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef OPENMW_MWRENDER_GPUPRECIPITATION_H
+#define OPENMW_MWRENDER_GPUPRECIPITATION_H
+
+#include <osg/Vec3f>
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class DrawArrays;
+    class Group;
+    class Texture2D;
+}
+
+namespace Resource
+{
+    class SceneManager;
+}
+
+namespace MWRender
+{
+    class GpuPrecipitationUpdater;
+
+    /// @brief Precipitation drawn as a fixed volume of instanced drops wrapping around the camera.
+    /// @par The vertex shader places every drop from its instance id and moves it by an offset advanced once per frame,
+    /// so nothing is emitted or updated per drop on the CPU. The node must be a child of a CameraRelativeTransform.
+    class GpuPrecipitation
+    {
+    public:
+        /// @param occlusion Hide the drops using the depth rendered by PrecipitationOccluder
+        GpuPrecipitation(Resource::SceneManager& sceneManager, osg::ref_ptr<osg::Texture2D> texture, bool occlusion);
+
+        ~GpuPrecipitation();
+
+        /// Shaders and instanced drawing are available.
+        static bool isSupported(const Resource::SceneManager& sceneManager);
+
+        osg::Group* getNode() const { return mNode; }
+
+        /// Size of the volume centered on the camera.
+        void setRange(const osg::Vec3f& range);
+
+        void setVelocity(const osg::Vec3f& velocity);
+
+        /// Minimum and maximum height of the drops, width relative to the height.
+        void setDropSize(float minHeight, float maxHeight, float widthScale);
+
+        void setDropCount(unsigned count);
+
+        void setAlpha(float alpha);
+
+        /// Move the drops, does nothing while frozen.
+        void update(float duration);
+
+        void setFrozen(bool frozen) { mFrozen = frozen; }
+
+    private:
+        osg::ref_ptr<osg::Group> mNode;
+        osg::ref_ptr<osg::DrawArrays> mDrawArrays;
+        osg::ref_ptr<GpuPrecipitationUpdater> mUpdater;
+        bool mFrozen = false;
+    };
+}
+
+#endif
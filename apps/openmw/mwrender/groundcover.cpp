@@ -10,9 +10,7 @@
 #include <osg/VertexAttribDivisor>
 #include <osgUtil/CullVisitor>
 
-#include <components/esm3/esmreader.hpp>
 #include <components/esm3/loadland.hpp>
-#include <components/esm3/readerscache.hpp>
 #include <components/misc/convert.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/nodecallback.hpp>
@@ -306,13 +304,13 @@ namespace MWRender
             osg::BoundingBox mBox;
         };
 
-        inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+        inline bool isInChunkBorders(const ESM::Position& position, osg::Vec2f& minBound, osg::Vec2f& maxBound)
         {
             osg::Vec2f size = maxBound - minBound;
             if (size.x() >= 1 && size.y() >= 1)
                 return true;
 
-            osg::Vec3f pos = ref.mPos.asVec3();
+            osg::Vec3f pos = position.asVec3();
             osg::Vec3f cellPos = pos / ESM::Land::REAL_SIZE;
             if ((minBound.x() > std::floor(minBound.x()) && cellPos.x() < minBound.x())
                 || (minBound.y() > std::floor(minBound.y()) && cellPos.y() < minBound.y())
@@ -377,52 +375,32 @@ namespace MWRender
 
         osg::Vec2f minBound = (center - osg::Vec2f(size / 2.f, size / 2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size / 2.f, size / 2.f));
-        DensityCalculator calculator(mDensity);
-        ESM::ReadersCache readers;
         osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size / 2.f), std::floor(center.y() - size / 2.f));
+        // Instances of the same object share the model, so look it up once per object
+        std::vector<std::vector<GroundcoverEntry>*> entriesById(mGroundcoverStore.getIdCount(), nullptr);
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
         {
             for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
             {
-                ESM::Cell cell;
-                mGroundcoverStore.initCell(cell, cellX, cellY);
-                if (cell.mContextList.empty())
-                    continue;
-
-                calculator.reset();
-                std::map<ESM::RefNum, ESM::CellRef> refs;
-                for (size_t i = 0; i < cell.mContextList.size(); ++i)
+                // The density is applied per cell, so chunks of every size pick the same instances
+                DensityCalculator calculator(mDensity);
+                for (const MWWorld::GroundcoverInstance& instance : mGroundcoverStore.getInstances(cellX, cellY))
                 {
-                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                    cell.restore(*reader, i);
-                    ESM::CellRef ref;
-                    bool deleted = false;
-                    while (cell.getNextRef(*reader, ref, deleted))
+                    if (!calculator.isInstanceEnabled() || !isInChunkBorders(instance.mPos, minBound, maxBound))
+                        continue;
+                    std::vector<GroundcoverEntry>*& entries = entriesById[instance.mId];
+                    if (entries == nullptr)
                     {
-                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled())
-                            deleted = true;
-                        if (!deleted && !isInChunkBorders(ref, minBound, maxBound))
-                            deleted = true;
-
-                        if (deleted)
-                        {
-                            refs.erase(ref.mRefNum);
+                        const VFS::Path::NormalizedView model = mGroundcoverStore.getModel(instance);
+                        if (model.empty())
                             continue;
-                        }
-                        refs[ref.mRefNum] = std::move(ref);
+                        auto it = instances.find(model);
+                        if (it == instances.end())
+                            it = instances.emplace_hint(
+                                it, VFS::Path::Normalized(model), std::vector<GroundcoverEntry>());
+                        entries = &it->second;
                     }
-                }
-
-                for (auto& [refNum, cellRef] : refs)
-                {
-                    const VFS::Path::NormalizedView model = mGroundcoverStore.getGroundcoverModel(cellRef.mRefID);
-                    if (model.empty())
-                        continue;
-                    auto it = instances.find(model);
-                    if (it == instances.end())
-                        it = instances.emplace_hint(it, VFS::Path::Normalized(model), std::vector<GroundcoverEntry>());
-                    it->second.emplace_back(std::move(cellRef));
+                    entries->emplace_back(instance.mPos, instance.mScale);
                 }
             }
         }
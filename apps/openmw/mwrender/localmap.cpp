@@ -1,6 +1,13 @@
 #include "localmap.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
 
 #include <osg/ComputeBoundsVisitor>
 #include <osg/Fog>
@@ -10,10 +17,14 @@
 #include <osg/Texture2D>
 
 #include <osgDB/ReadFile>
+#include <osgDB/Registry>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/fogstate.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
 #include <components/files/memorystream.hpp>
 #include <components/misc/constants.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -22,13 +33,16 @@
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/visitor.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/stereo/multiview.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/windowmanager.hpp"
+#include "../mwbase/world.hpp"
 
 #include "../mwworld/cellstore.hpp"
+#include "../mwworld/esmstore.hpp"
 
 #include "util.hpp"
 #include "vismask.hpp"
@@ -49,6 +63,105 @@ namespace
         const int segsY = static_cast<int>(std::ceil(length.y() / mapSize));
         return { segsX, segsY };
     }
+
+    // Increase when the rendering of local maps changes
+    constexpr int mapCacheFormatVersion = 1;
+
+    std::filesystem::path getCachedMapPath(const std::filesystem::path& directory, const std::string& key)
+    {
+        return directory / Files::pathFromUnicodeString(key + ".png");
+    }
+
+    class WriteMapWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        WriteMapWorkItem(osg::ref_ptr<osg::Image> image, std::filesystem::path directory, std::filesystem::path path)
+            : mImage(std::move(image))
+            , mDirectory(std::move(directory))
+            , mPath(std::move(path))
+        {
+        }
+
+        void doWork() override
+        {
+            osgDB::ReaderWriter* readerWriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
+            if (!readerWriter)
+            {
+                Log(Debug::Warning) << "Unable to cache local map, can't find a png ReaderWriter";
+                return;
+            }
+
+            // Write to a temporary file first so a partially written map is never read
+            std::filesystem::path temporary = mPath;
+            temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+            try
+            {
+                std::filesystem::create_directories(mDirectory);
+
+                {
+                    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                    if (!stream.is_open())
+                        throw std::runtime_error("failed to open file");
+                    const osgDB::ReaderWriter::WriteResult result = readerWriter->writeImage(*mImage, stream);
+                    if (!result.success())
+                        throw std::runtime_error(result.message());
+                    stream.close();
+                    if (!stream)
+                        throw std::runtime_error("failed to write file");
+                }
+
+                std::filesystem::rename(temporary, mPath);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write local map " << mPath << ": " << e.what();
+                std::error_code ec;
+                std::filesystem::remove(temporary, ec);
+            }
+        }
+
+    private:
+        const osg::ref_ptr<osg::Image> mImage;
+        const std::filesystem::path mDirectory;
+        const std::filesystem::path mPath;
+    };
+
+    // Reads back the rendered map and writes it to the cache in the background
+    class StoreMapCallback : public osg::Camera::DrawCallback
+    {
+    public:
+        StoreMapCallback(osg::ref_ptr<osg::Texture2D> texture, osg::ref_ptr<SceneUtil::WorkQueue> workQueue,
+            std::filesystem::path directory, std::filesystem::path path)
+            : mTexture(std::move(texture))
+            , mWorkQueue(std::move(workQueue))
+            , mDirectory(std::move(directory))
+            , mPath(std::move(path))
+        {
+        }
+
+        void operator()(osg::RenderInfo& renderInfo) const override
+        {
+            if (mStored.exchange(true))
+                return;
+
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->allocateImage(mTexture->getTextureWidth(), mTexture->getTextureHeight(), 1, GL_RGB, GL_UNSIGNED_BYTE);
+
+            renderInfo.getState()->applyTextureAttribute(0, mTexture);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, image->data());
+
+            mWorkQueue->addWorkItem(
+                new WriteMapWorkItem(std::move(image), mDirectory, mPath), SceneUtil::WorkPriority::Low);
+        }
+
+    private:
+        const osg::ref_ptr<osg::Texture2D> mTexture;
+        const osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        const std::filesystem::path mDirectory;
+        const std::filesystem::path mPath;
+        mutable std::atomic_bool mStored = false;
+    };
 }
 
 namespace MWRender
@@ -74,8 +187,10 @@ namespace MWRender
         void operator()(LocalMapRenderToTexture* node, osg::NodeVisitor* nv);
     };
 
-    LocalMap::LocalMap(osg::Group* root)
+    LocalMap::LocalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue, std::filesystem::path cacheDirectory)
         : mRoot(root)
+        , mWorkQueue(workQueue)
+        , mCacheDirectory(std::move(cacheDirectory))
         , mMapResolution(
               Settings::map().mLocalMapResolution * MWBase::Environment::get().getWindowManager()->getScalingFactor())
         , mMapWorldSize(Constants::CellSizeInUnits)
@@ -88,6 +203,10 @@ namespace MWRender
         mSceneRoot = find.mFoundNode;
         if (!mSceneRoot)
             throw std::runtime_error("no scene root found");
+
+        // Maps rendered with multiview are texture arrays
+        if (mWorkQueue == nullptr || Stereo::getMultiview())
+            mCacheDirectory.clear();
     }
 
     LocalMap::~LocalMap()
@@ -160,8 +279,8 @@ namespace MWRender
         }
     }
 
-    void LocalMap::setupRenderToTexture(
-        int segmentX, int segmentY, float left, float top, const osg::Vec3d& upVector, float zmin, float zmax)
+    void LocalMap::setupRenderToTexture(int segmentX, int segmentY, float left, float top,
+        const osg::Vec3d& upVector, float zmin, float zmax, const std::string& cacheKey)
     {
         mLocalMapRTTs.emplace_back(
             new LocalMapRenderToTexture(mSceneRoot, mMapResolution, mMapWorldSize, left, top, upVector, zmin, zmax));
@@ -171,6 +290,77 @@ namespace MWRender
         MapSegment& segment = mInterior ? mInteriorSegments[std::make_pair(segmentX, segmentY)]
                                         : mExteriorSegments[std::make_pair(segmentX, segmentY)];
         segment.mMapTexture = static_cast<osg::Texture2D*>(mLocalMapRTTs.back()->getColorTexture(nullptr));
+
+        if (!cacheKey.empty())
+            mLocalMapRTTs.back()->getCamera(nullptr)->setPostDrawCallback(new StoreMapCallback(
+                segment.mMapTexture, mWorkQueue, mCacheDirectory, getCachedMapPath(mCacheDirectory, cacheKey)));
+    }
+
+    std::string LocalMap::getExteriorMapCacheKey(const MWWorld::CellStore* cell) const
+    {
+        if (mCacheDirectory.empty())
+            return {};
+
+        const int x = cell->getCell()->getGridX();
+        const int y = cell->getCell()->getGridY();
+
+        std::ostringstream descriptor;
+        descriptor << mapCacheFormatVersion << ' ' << mMapResolution << ' '
+                   << cell->getCell()->getWorldSpace().serializeText() << ' ' << x << ' ' << y << ' '
+                   << static_cast<int>(getExteriorNeighbourFlags(x, y));
+
+        for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
+            descriptor << ' ' << contentFile;
+
+        // The position of the record changes with most edits of the plugin providing it
+        if (cell->getCell()->getWorldSpace() == ESM::Cell::sDefaultWorldspaceId)
+            if (const ESM::Land* land = MWBase::Environment::get().getESMStore()->get<ESM::Land>().search(x, y))
+                descriptor << ' ' << land->getPlugin() << ' ' << land->mContext.filePos;
+
+        const bool loaded = cell->forEachConst([&](const MWWorld::ConstPtr& ptr) {
+            const ESM::Position& position = ptr.getRefData().getPosition();
+            descriptor << ' ' << ptr.getCellRef().getRefId().serializeText() << ' ' << ptr.getCellRef().getScale();
+            for (int i = 0; i < 3; ++i)
+                descriptor << ' ' << position.pos[i] << ' ' << position.rot[i];
+            return true;
+        });
+        if (!loaded)
+            return {};
+
+        std::istringstream stream(descriptor.str());
+        const std::array<std::uint64_t, 2> hash = Files::getHash("local map", stream);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0');
+        for (const std::uint64_t value : hash)
+            key << std::setw(16) << value;
+        return key.str();
+    }
+
+    osg::ref_ptr<osg::Texture2D> LocalMap::readCachedMap(const std::string& key) const
+    {
+        const std::filesystem::path path = getCachedMapPath(mCacheDirectory, key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        osgDB::ReaderWriter* readerWriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
+        if (!readerWriter)
+            return nullptr;
+
+        const osgDB::ReaderWriter::ReadResult result = readerWriter->readImage(stream);
+        osg::Image* image = result.getImage();
+        if (!result.success() || image == nullptr || image->s() != mMapResolution || image->t() != mMapResolution)
+        {
+            Log(Debug::Warning) << "Failed to read local map " << path << ": " << result.message();
+            return nullptr;
+        }
+
+        osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D(image);
+        texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        return texture;
     }
 
     void LocalMap::requestMap(const MWWorld::CellStore* cell)
@@ -260,8 +450,12 @@ namespace MWRender
         float zmin = bound.center().z() - bound.radius();
         float zmax = bound.center().z() + bound.radius();
 
-        setupRenderToTexture(x, y, x * mMapWorldSize + mMapWorldSize / 2.f, y * mMapWorldSize + mMapWorldSize / 2.f,
-            osg::Vec3d(0, 1, 0), zmin, zmax);
+        const std::string cacheKey = getExteriorMapCacheKey(cell);
+        if (osg::ref_ptr<osg::Texture2D> texture = cacheKey.empty() ? nullptr : readCachedMap(cacheKey))
+            segment.mMapTexture = std::move(texture);
+        else
+            setupRenderToTexture(x, y, x * mMapWorldSize + mMapWorldSize / 2.f,
+                y * mMapWorldSize + mMapWorldSize / 2.f, osg::Vec3d(0, 1, 0), zmin, zmax, cacheKey);
 
         if (segment.mFogOfWarImage != nullptr)
             return;
@@ -396,7 +590,8 @@ namespace MWRender
 
                 osg::Vec2f pos = osg::Vec2f(rotatedCenter.x(), rotatedCenter.y()) + mCenter;
 
-                setupRenderToTexture(x, y, pos.x(), pos.y(), osg::Vec3f(north.x(), north.y(), 0.f), zMin, zMax);
+                setupRenderToTexture(
+                    x, y, pos.x(), pos.y(), osg::Vec3f(north.x(), north.y(), 0.f), zMin, zMax, std::string());
 
                 auto coords = std::make_pair(x, y);
                 MapSegment& segment = mInteriorSegments[coords];
@@ -526,25 +721,33 @@ namespace MWRender
                 if (!segment.mFogOfWarImage || !segment.mMapTexture)
                     continue;
 
-                std::uint32_t* data = reinterpret_cast<std::uint32_t*>(segment.mFogOfWarImage->data());
+                // Texels outside of the explore radius keep their alpha, only visit the ones within its bounds
+                const float centerU = (u - mx) * (sFogOfWarResolution - 1);
+                const float centerV = (v - my) * (sFogOfWarResolution - 1);
+                const int minU = std::max(0, static_cast<int>(std::ceil(centerU - exploreRadius)));
+                const int maxU
+                    = std::min(sFogOfWarResolution - 1, static_cast<int>(std::floor(centerU + exploreRadius)));
+                const int minV = std::max(0, static_cast<int>(std::ceil(centerV - exploreRadius)));
+                const int maxV
+                    = std::min(sFogOfWarResolution - 1, static_cast<int>(std::floor(centerV + exploreRadius)));
+
+                std::uint32_t* const data = reinterpret_cast<std::uint32_t*>(segment.mFogOfWarImage->data());
                 bool changed = false;
-                for (int texV = 0; texV < sFogOfWarResolution; ++texV)
+                for (int texV = minV; texV <= maxV; ++texV)
                 {
-                    for (int texU = 0; texU < sFogOfWarResolution; ++texU)
+                    for (int texU = minU; texU <= maxU; ++texU)
                     {
-                        float sqrDist = square((texU + mx * (sFogOfWarResolution - 1)) - u * (sFogOfWarResolution - 1))
-                            + square((texV + my * (sFogOfWarResolution - 1)) - v * (sFogOfWarResolution - 1));
+                        const float sqrDist = square(texU - centerU) + square(texV - centerV);
 
+                        std::uint32_t& texel = data[texV * sFogOfWarResolution + texU];
                         const std::uint8_t alpha = std::min<std::uint8_t>(
-                            *data >> 24, std::clamp(sqrDist / sqrExploreRadius, 0.f, 1.f) * 255);
-                        std::uint32_t val = static_cast<std::uint32_t>(alpha << 24);
-                        if (*data != val)
+                            texel >> 24, std::clamp(sqrDist / sqrExploreRadius, 0.f, 1.f) * 255);
+                        const std::uint32_t val = static_cast<std::uint32_t>(alpha << 24);
+                        if (texel != val)
                         {
-                            *data = val;
+                            texel = val;
                             changed = true;
                         }
-
-                        ++data;
                     }
                 }
 
@@ -2,8 +2,10 @@
 #define GAME_RENDER_LOCALMAP_H
 
 #include <cstdint>
+#include <filesystem>
 #include <map>
 #include <set>
+#include <string>
 #include <vector>
 
 #include <MyGUI_Types.h>
@@ -30,6 +32,11 @@ namespace osg
     class Node;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWRender
 {
     class LocalMapRenderToTexture;
@@ -40,7 +47,8 @@ namespace MWRender
     class LocalMap
     {
     public:
-        LocalMap(osg::Group* root);
+        /// @param cacheDirectory Directory to keep rendered exterior maps in, empty to always render them.
+        LocalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue, std::filesystem::path cacheDirectory);
         ~LocalMap();
 
         /**
@@ -104,6 +112,8 @@ namespace MWRender
     private:
         osg::ref_ptr<osg::Group> mRoot;
         osg::ref_ptr<osg::Node> mSceneRoot;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::filesystem::path mCacheDirectory;
 
         typedef std::vector<osg::ref_ptr<LocalMapRenderToTexture>> RTTVector;
         RTTVector mLocalMapRTTs;
@@ -154,8 +164,12 @@ namespace MWRender
         void requestExteriorMap(const MWWorld::CellStore* cell, MapSegment& segment);
         void requestInteriorMap(const MWWorld::CellStore* cell);
 
-        void setupRenderToTexture(
-            int segmentX, int segmentY, float left, float top, const osg::Vec3d& upVector, float zmin, float zmax);
+        void setupRenderToTexture(int segmentX, int segmentY, float left, float top, const osg::Vec3d& upVector,
+            float zmin, float zmax, const std::string& cacheKey);
+
+        /// @return Key of the cached map, empty if the map of this cell can't be cached
+        std::string getExteriorMapCacheKey(const MWWorld::CellStore* cell) const;
+        osg::ref_ptr<osg::Texture2D> readCachedMap(const std::string& key) const;
 
         osg::BoundingBox mBounds;
         osg::Vec2f mCenter;
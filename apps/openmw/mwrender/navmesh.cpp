@@ -207,7 +207,7 @@ namespace MWRender
         if (mEnabled)
             disable();
         for (const auto& workItem : mWorkItems)
-            workItem->abort();
+            mWorkQueue->abortWorkItem(*workItem);
     }
 
     bool NavMesh::toggle()
@@ -246,7 +246,8 @@ namespace MWRender
                     std::swap(latestCandidate, *it);
                 }
                 if (*it != nullptr)
-                    mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(*it)));
+                    mWorkQueue->addWorkItem(
+                        new DeallocateCreateNavMeshTileGroups(std::move(*it)), SceneUtil::WorkPriority::Low);
                 it = mWorkItems.erase(it);
             }
 
@@ -276,7 +277,8 @@ namespace MWRender
                     }
                 }
 
-                mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(latestCandidate)));
+                mWorkQueue->addWorkItem(
+                    new DeallocateCreateNavMeshTileGroups(std::move(latestCandidate)), SceneUtil::WorkPriority::Low);
             }
         }
 
@@ -320,7 +322,7 @@ namespace MWRender
     void NavMesh::reset()
     {
         for (auto& workItem : mWorkItems)
-            workItem->abort();
+            mWorkQueue->abortWorkItem(*workItem);
         mWorkItems.clear();
         for (auto& [position, tile] : mTiles)
             mRootNode->removeChild(tile.mGroup);
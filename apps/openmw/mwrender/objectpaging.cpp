@@ -1,5 +1,7 @@
 #include "objectpaging.hpp"
 
+#include <span>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
@@ -8,10 +10,12 @@
 #include <osg/MatrixTransform>
 #include <osg/Sequence>
 #include <osg/Switch>
+#include <osg/Texture2D>
 #include <osgAnimation/BasicAnimationManager>
 #include <osgParticle/ParticleProcessor>
 #include <osgParticle/ParticleSystemUpdater>
 #include <osgUtil/IncrementalCompileOperation>
+#include <osgUtil/Simplifier>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/loadacti.hpp>
@@ -30,6 +34,7 @@
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/incrementalcompileoperation.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/optimizer.hpp>
@@ -473,6 +478,59 @@ namespace MWRender
             }
         };
 
+        class SimplifyVisitor : public osg::NodeVisitor
+        {
+        public:
+            SimplifyVisitor(float ratio)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mSimplifier(ratio)
+            {
+                mSimplifier.setSmoothing(false);
+                mSimplifier.setDoTriStrip(false);
+            }
+
+            void apply(osg::Geometry& geometry) override
+            {
+                // Decimating small meshes mostly removes their shape
+                constexpr unsigned int minVertices = 64;
+                const osg::Array* vertices = geometry.getVertexArray();
+                if (vertices == nullptr || vertices->getNumElements() < minVertices)
+                    return;
+                // The simplifier only carries per vertex attributes along the collapsed edges
+                osg::Geometry::ArrayList arrays;
+                geometry.getArrayList(arrays);
+                for (const osg::ref_ptr<osg::Array>& array : arrays)
+                    if (array->getBinding() != osg::Array::BIND_PER_VERTEX
+                        || array->getNumElements() != vertices->getNumElements())
+                        return;
+
+                // The simplifier writes the arrays in place, geometry that wasn't merged still shares them with the
+                // template. The copies don't take the buffer objects of the original arrays.
+                geometry.setVertexArray(copyArray(geometry.getVertexArray()));
+                geometry.setNormalArray(copyArray(geometry.getNormalArray()));
+                geometry.setColorArray(copyArray(geometry.getColorArray()));
+                geometry.setSecondaryColorArray(copyArray(geometry.getSecondaryColorArray()));
+                geometry.setFogCoordArray(copyArray(geometry.getFogCoordArray()));
+                for (unsigned int i = 0; i < geometry.getNumTexCoordArrays(); ++i)
+                    geometry.setTexCoordArray(i, copyArray(geometry.getTexCoordArray(i)));
+                for (unsigned int i = 0; i < geometry.getNumVertexAttribArrays(); ++i)
+                    geometry.setVertexAttribArray(i, copyArray(geometry.getVertexAttribArray(i)));
+
+                mSimplifier.simplify(geometry);
+                geometry.dirtyBound();
+            }
+
+        private:
+            osgUtil::Simplifier mSimplifier;
+
+            static osg::ref_ptr<osg::Array> copyArray(const osg::Array* array)
+            {
+                if (array == nullptr)
+                    return nullptr;
+                return osg::clone(array, osg::CopyOp::DEEP_COPY_ALL);
+            }
+        };
+
         class AddRefnumMarkerVisitor : public osg::NodeVisitor
         {
         public:
@@ -491,9 +549,136 @@ namespace MWRender
                 node.getOrCreateUserDataContainer()->addUserObject(marker);
             }
         };
+
+        // Each instance takes a row of the transforms texture, see compatibility/instancing.glsl
+        constexpr std::size_t maxInstancesPerBatch = 4096;
+        // Meshes with fewer copies in a chunk are merged
+        constexpr std::size_t minInstancesPerBatch = 8;
+
+        class CollectInstancedGeometryVisitor : public osg::NodeVisitor
+        {
+        public:
+            CollectInstancedGeometryVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                // A level of detail or a callback like a billboard would be evaluated once for all instances
+                if (node.getCullCallback() != nullptr || dynamic_cast<osg::LOD*>(&node) != nullptr)
+                    mInstanceable = false;
+                else
+                    traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                osg::Geometry* const geometry = drawable.asGeometry();
+                if (geometry == nullptr || typeid(*geometry) != typeid(osg::Geometry))
+                {
+                    mInstanceable = false;
+                    return;
+                }
+                mGeometries.emplace_back(geometry, osg::computeLocalToWorld(getNodePath()));
+            }
+
+            bool mInstanceable = true;
+            // Geometries with the transform from their parent to the batch root
+            std::vector<std::pair<osg::Geometry*, osg::Matrixf>> mGeometries;
+        };
+
+        osg::ref_ptr<osg::StateSet> createInstanceStateSet(std::span<const osg::Matrixf> transforms, int textureUnit)
+        {
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->allocateImage(3, static_cast<int>(transforms.size()), 1, GL_RGBA, GL_FLOAT);
+            image->setInternalTextureFormat(GL_RGBA32F_ARB);
+            // Rows of the affine transforms as multiplied by the vertex shader
+            float* data = reinterpret_cast<float*>(image->data());
+            for (const osg::Matrixf& transform : transforms)
+                for (int row = 0; row < 3; ++row)
+                    for (int i = 0; i < 4; ++i)
+                        *data++ = transform(i, row);
+
+            osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D(image);
+            texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+            texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+            texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            texture->setResizeNonPowerOfTwoHint(false);
+
+            osg::ref_ptr<osg::StateSet> stateset = new osg::StateSet;
+            stateset->setTextureAttribute(textureUnit, texture, osg::StateAttribute::ON);
+            stateset->addUniform(new osg::Uniform("useInstancing", true));
+            stateset->addUniform(new osg::Uniform("instanceTransforms", textureUnit));
+            stateset->addUniform(new osg::Uniform("instanceCount", static_cast<float>(transforms.size())));
+            return stateset;
+        }
+
+        // Copy a mesh once and draw it for all the instances, or return nullptr if it can't be instanced
+        osg::ref_ptr<osg::Group> createInstancedBatch(
+            const osg::Node* node, CopyOp& copyop, std::span<const osg::Matrixf> instances, int textureUnit)
+        {
+            osg::ref_ptr<osg::Group> batch = new osg::Group;
+            copyop.copy(node, batch);
+
+            CollectInstancedGeometryVisitor visitor;
+            batch->accept(visitor);
+            if (!visitor.mInstanceable || visitor.mGeometries.empty())
+                return nullptr;
+
+            std::map<osg::Matrixf, osg::ref_ptr<osg::StateSet>> statesets;
+            std::vector<osg::Matrixf> transforms(instances.size());
+            for (const auto& [geometry, localToBatch] : visitor.mGeometries)
+            {
+                // The shader transforms the vertices before the transforms of the mesh apply, so conjugate the
+                // instance transforms by them
+                const osg::Matrixf batchToLocal = osg::Matrixf::inverse(localToBatch);
+                for (std::size_t i = 0; i < instances.size(); ++i)
+                    transforms[i] = localToBatch * instances[i] * batchToLocal;
+
+                osg::ref_ptr<osg::StateSet>& stateset = statesets[localToBatch];
+                if (stateset == nullptr)
+                    stateset = createInstanceStateSet(transforms, textureUnit);
+
+                const osg::BoundingBox& localBound = geometry->getBoundingBox();
+                osg::BoundingBox bound;
+                for (const osg::Matrixf& transform : transforms)
+                    for (unsigned int corner = 0; corner < 8; ++corner)
+                        bound.expandBy(localBound.corner(corner) * transform);
+                geometry->setInitialBound(bound);
+                geometry->dirtyBound();
+
+                // The primitives are cloned without their element buffer, the vertex buffers stay shared
+                geometry->setUseDisplayList(false);
+                geometry->setUseVertexBufferObjects(true);
+                osg::ref_ptr<osg::ElementBufferObject> ebo;
+                for (unsigned int i = 0; i < geometry->getNumPrimitiveSets(); ++i)
+                {
+                    osg::PrimitiveSet* const primitives = geometry->getPrimitiveSet(i);
+                    primitives->setNumInstances(static_cast<int>(instances.size()));
+                    if (osg::DrawElements* const elements = primitives->getDrawElements())
+                    {
+                        if (ebo == nullptr)
+                            ebo = new osg::ElementBufferObject;
+                        elements->setElementBufferObject(ebo);
+                    }
+                }
+
+                // Attach the transforms without cloning the state set of the template
+                osg::ref_ptr<osg::Geometry> child = geometry;
+                osg::ref_ptr<osg::Group> parent = new osg::Group;
+                parent->setDataVariance(osg::Object::STATIC);
+                parent->setStateSet(stateset);
+                geometry->getParent(0)->replaceChild(geometry, parent);
+                parent->addChild(child);
+            }
+
+            return batch;
+        }
     }
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace)
+    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace, int instancingTextureUnit)
         : GenericResourceManager<ChunkId>(nullptr, Settings::cells().mCacheExpiryDelay)
         , Terrain::QuadTreeWorld::ChunkManager(worldspace)
         , mSceneManager(sceneManager)
@@ -503,6 +688,8 @@ namespace MWRender
         , mMinSize(Settings::terrain().mObjectPagingMinSize)
         , mMinSizeMergeFactor(Settings::terrain().mObjectPagingMinSizeMergeFactor)
         , mMinSizeCostMultiplier(Settings::terrain().mObjectPagingMinSizeCostMultiplier)
+        , mSimplificationRatio(Settings::terrain().mObjectPagingSimplificationRatio)
+        , mInstancingTextureUnit(instancingTextureUnit)
         , mRefTrackerLocked(false)
     {
     }
@@ -829,6 +1016,12 @@ namespace MWRender
             const float minSizeMergeFactor2 = (1 - factor2) * mMinSizeMergeFactor + factor2;
             const float minSizeMerged = minSizeMergeFactor2 > 0 ? mMinSize * minSizeMergeFactor2 : mMinSize;
 
+            // Instancing replaces merging for meshes repeated enough, the active grid needs a node per object
+            const bool tryInstancing = merge && !activeGrid && mInstancingTextureUnit >= 0
+                && pair.second.mInstances.size() >= minInstancesPerBatch;
+            std::vector<osg::Matrixf> instanceMatrices;
+            std::vector<float> instanceScales;
+
             unsigned int numinstances = 0;
             for (const PagedCellRef* refPtr : pair.second.mInstances)
             {
@@ -853,6 +1046,12 @@ namespace MWRender
                     matrix.preMultTranslate(nodePos);
                     matrix.preMultRotate(nodeAttitude);
                     matrix.preMultScale(nodeScale);
+                    if (tryInstancing)
+                    {
+                        instanceMatrices.push_back(matrix);
+                        instanceScales.push_back(ref.mScale);
+                        continue;
+                    }
                     trans = new osg::MatrixTransform(matrix);
                     trans->setDataVariance(osg::Object::STATIC);
                 }
@@ -900,6 +1099,58 @@ namespace MWRender
                 attachTo->addChild(trans);
                 ++numinstances;
             }
+
+            bool instanced = false;
+            if (instanceMatrices.size() >= minInstancesPerBatch)
+            {
+                copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
+                    | osg::CopyOp::DEEP_COPY_PRIMITIVES);
+                // Keep billboards to reject them, they face the camera differently for every instance
+                copyop.mOptimizeBillboards = false;
+                copyop.mDistances = LODRange{ smallestDistanceToChunk, higherDistanceToChunk } / instanceScales.front();
+                for (std::size_t i = 0; i < instanceMatrices.size(); i += maxInstancesPerBatch)
+                {
+                    const std::size_t count = std::min(maxInstancesPerBatch, instanceMatrices.size() - i);
+                    const std::span<const osg::Matrixf> instances(instanceMatrices.data() + i, count);
+                    osg::ref_ptr<osg::Group> batch
+                        = createInstancedBatch(cnode, copyop, instances, mInstancingTextureUnit);
+                    if (batch == nullptr)
+                        break;
+                    group->addChild(batch);
+                    numinstances += instances.size();
+                    instanced = true;
+                    if (mDebugBatches)
+                    {
+                        DebugVisitor dv;
+                        batch->accept(dv);
+                    }
+                    if (compile)
+                    {
+                        stateToCompile._mode = osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS
+                            | osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES;
+                        batch->accept(stateToCompile);
+                    }
+                }
+            }
+            if (!instanced)
+            {
+                // Merge the copies like for other meshes
+                copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES);
+                copyop.mOptimizeBillboards = (size > 1 / 4.f);
+                copyop.mViewVector = (viewPoint - worldCenter);
+                for (std::size_t i = 0; i < instanceMatrices.size(); ++i)
+                {
+                    osg::ref_ptr<osg::MatrixTransform> trans = new osg::MatrixTransform(instanceMatrices[i]);
+                    trans->setDataVariance(osg::Object::STATIC);
+                    copyop.mNodePath.push_back(trans);
+                    copyop.mDistances = LODRange{ smallestDistanceToChunk, higherDistanceToChunk } / instanceScales[i];
+                    copyop.copy(cnode, trans);
+                    copyop.mNodePath.pop_back();
+                    mergeGroup->addChild(trans);
+                    ++numinstances;
+                }
+            }
+
             if (numinstances > 0)
             {
                 // add a ref to the original template to help verify the safety of shallow cloning operations
@@ -909,7 +1160,8 @@ namespace MWRender
                 if (pair.second.mNeedCompile)
                 {
                     int mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES;
-                    if (!merge)
+                    // Instanced batches share the vertex buffers of the template
+                    if (!merge || instanced)
                         mode |= osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
                     stateToCompile._mode = mode;
                     const_cast<osg::Node*>(cnode)->accept(stateToCompile);
@@ -933,6 +1185,14 @@ namespace MWRender
 
             optimizer.optimize(mergeGroup, options);
 
+            // Authored distant meshes are already picked by the LOD name cache, the chunks of the active grid and
+            // the nearest chunks stay at full detail
+            if (!activeGrid && size >= 1 && mSimplificationRatio < 1)
+            {
+                SimplifyVisitor simplifyVisitor(mSimplificationRatio);
+                mergeGroup->accept(simplifyVisitor);
+            }
+
             group->addChild(mergeGroup);
 
             if (mDebugBatches)
@@ -952,7 +1212,10 @@ namespace MWRender
         {
             auto compileSet = new osgUtil::IncrementalCompileOperation::CompileSet(group);
             compileSet->buildCompileMap(ico->getContextSet(), stateToCompile);
-            ico->add(compileSet, false);
+            if (auto* const budgeted = dynamic_cast<SceneUtil::IncrementalCompileOperation*>(ico))
+                budgeted->add(compileSet, worldCenter);
+            else
+                ico->add(compileSet, false);
         }
 
         group->getBound();
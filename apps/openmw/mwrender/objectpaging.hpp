@@ -20,7 +20,8 @@ namespace MWRender
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace);
+        /// @param instancingTextureUnit Texture unit of the instance transforms, -1 disables instancing
+        ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace, int instancingTextureUnit);
         ~ObjectPaging() = default;
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
@@ -55,6 +56,8 @@ namespace MWRender
         float mMinSize;
         float mMinSizeMergeFactor;
         float mMinSizeCostMultiplier;
+        float mSimplificationRatio;
+        int mInstancingTextureUnit;
 
         std::mutex mRefTrackerMutex;
         struct RefTracker
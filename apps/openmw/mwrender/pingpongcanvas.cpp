@@ -12,11 +12,13 @@
 
 namespace MWRender
 {
-    PingPongCanvas::PingPongCanvas(
-        Shader::ShaderManager& shaderManager, const std::shared_ptr<LuminanceCalculator>& luminanceCalculator)
+    PingPongCanvas::PingPongCanvas(Shader::ShaderManager& shaderManager,
+        const std::shared_ptr<LuminanceCalculator>& luminanceCalculator,
+        const std::shared_ptr<TechniqueTimer>& techniqueTimer)
         : mFallbackStateSet(new osg::StateSet)
         , mMultiviewResolveStateSet(new osg::StateSet)
         , mLuminanceCalculator(luminanceCalculator)
+        , mTechniqueTimer(techniqueTimer)
     {
         setUseDisplayList(false);
         setUseVertexBufferObjects(true);
@@ -147,11 +149,9 @@ namespace MWRender
 
             mLuminanceCalculator->dirty(mTextureScene->getTextureWidth(), mTextureScene->getTextureHeight());
 
-            if (Stereo::getStereo())
-                mRenderViewport
-                    = new osg::Viewport(0, 0, mTextureScene->getTextureWidth(), mTextureScene->getTextureHeight());
-            else
-                mRenderViewport = nullptr;
+            // The scene is smaller than the window with dynamic resolution or per eye with stereo
+            mRenderViewport
+                = new osg::Viewport(0, 0, mTextureScene->getTextureWidth(), mTextureScene->getTextureHeight());
 
             mDirty = false;
         }
@@ -231,10 +231,14 @@ namespace MWRender
             }
         }
 
+        mTechniqueTimer->collect(state);
+
         for (const size_t& index : filtered)
         {
             const auto& node = mPasses[index];
 
+            mTechniqueTimer->begin(state, node.mName);
+
             node.mRootStateSet->setTextureAttribute(PostProcessor::Unit_Depth, mTextureDepth);
 
             if (mAvgLum)
@@ -330,6 +334,8 @@ namespace MWRender
             }
 
             state.popStateSet();
+
+            mTechniqueTimer->end(state);
         }
 
         if (Stereo::getMultiview())
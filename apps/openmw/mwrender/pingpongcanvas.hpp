@@ -11,6 +11,7 @@
 #include <components/fx/technique.hpp>
 
 #include "luminancecalculator.hpp"
+#include "techniquetimer.hpp"
 
 namespace Shader
 {
@@ -22,8 +23,9 @@ namespace MWRender
     class PingPongCanvas : public osg::Geometry
     {
     public:
-        PingPongCanvas(
-            Shader::ShaderManager& shaderManager, const std::shared_ptr<LuminanceCalculator>& luminanceCalculator);
+        PingPongCanvas(Shader::ShaderManager& shaderManager,
+            const std::shared_ptr<LuminanceCalculator>& luminanceCalculator,
+            const std::shared_ptr<TechniqueTimer>& techniqueTimer);
 
         void drawGeometry(osg::RenderInfo& renderInfo) const;
 
@@ -80,6 +82,7 @@ namespace MWRender
         mutable osg::ref_ptr<osg::FrameBufferObject> mDestinationFBO;
         mutable std::array<osg::ref_ptr<osg::FrameBufferObject>, 3> mFbos;
         mutable std::shared_ptr<LuminanceCalculator> mLuminanceCalculator;
+        std::shared_ptr<TechniqueTimer> mTechniqueTimer;
     };
 }
 
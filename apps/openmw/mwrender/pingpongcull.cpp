@@ -15,15 +15,11 @@ namespace MWRender
 {
 
     PingPongCull::PingPongCull(PostProcessor* pp)
-        : mViewportStateset(nullptr)
+        : mViewportStateset(new osg::StateSet)
+        , mViewport(new osg::Viewport)
         , mPostProcessor(pp)
     {
-        if (Stereo::getStereo())
-        {
-            mViewportStateset = new osg::StateSet();
-            mViewport = new osg::Viewport;
-            mViewportStateset->setAttribute(mViewport);
-        }
+        mViewportStateset->setAttribute(mViewport);
     }
 
     PingPongCull::~PingPongCull()
@@ -50,6 +46,10 @@ namespace MWRender
         mPostProcessor->getStateUpdater()->setPrevViewMatrix(mLastViewMatrix[0]);
         mLastViewMatrix[0] = cv->getCurrentCamera()->getViewMatrix();
 
+        if (SceneUtil::OcclusionCuller* culler = mPostProcessor->getOcclusionCuller())
+            culler->setViewProjection(static_cast<unsigned>(frame),
+                cv->getCurrentCamera()->getViewMatrix() * cv->getCurrentCamera()->getProjectionMatrix());
+
         mPostProcessor->getStateUpdater()->setEyePos(cv->getEyePoint());
         mPostProcessor->getStateUpdater()->setEyeVec(cv->getLookVectorLocal());
 
@@ -69,7 +69,8 @@ namespace MWRender
                 Stereo::setMultiviewMSAAResolveCallback(renderStage);
         }
 
-        if (mViewportStateset)
+        // The render targets are smaller than the window with dynamic resolution or per eye with stereo
+        if (Stereo::getStereo() || mPostProcessor->isRenderScaled())
         {
             mViewport->setViewport(0, 0, mPostProcessor->renderWidth(), mPostProcessor->renderHeight());
             renderStage->setViewport(mViewport);
@@ -18,6 +18,7 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
@@ -31,7 +32,9 @@
 
 #include "../mwgui/postprocessorhud.hpp"
 
+#include "depthreadback.hpp"
 #include "distortion.hpp"
+#include "dynamicresolution.hpp"
 #include "pingpongcull.hpp"
 #include "renderbin.hpp"
 #include "renderingmanager.hpp"
@@ -125,13 +128,14 @@ namespace MWRender
         , mSamples(Settings::video().mAntialiasing)
         , mPingPongCull(new PingPongCull(this))
         , mDistortionCallback(new DistortionCallback)
+        , mTechniqueTimer(std::make_shared<TechniqueTimer>())
     {
         auto& shaderManager = mRendering.getResourceSystem()->getSceneManager()->getShaderManager();
 
         std::shared_ptr<LuminanceCalculator> luminanceCalculator = std::make_shared<LuminanceCalculator>(shaderManager);
 
         for (auto& canvas : mCanvases)
-            canvas = new PingPongCanvas(shaderManager, luminanceCalculator);
+            canvas = new PingPongCanvas(shaderManager, luminanceCalculator, mTechniqueTimer);
 
         mHUDCamera->setReferenceFrame(osg::Camera::ABSOLUTE_RF);
         mHUDCamera->setRenderOrder(osg::Camera::POST_RENDER);
@@ -146,6 +150,7 @@ namespace MWRender
         mHUDCamera->addChild(mCanvases[0]);
         mHUDCamera->addChild(mCanvases[1]);
         mHUDCamera->setCullCallback(new HUDCullCallback);
+        SceneUtil::addGpuTimer(*mHUDCamera, new SceneUtil::GpuTimer("Post Processing"));
         mViewer->getCamera()->addCullCallback(mPingPongCull);
 
         // resolves the multisampled depth buffer and optionally draws an additional depth postpass
@@ -153,6 +158,19 @@ namespace MWRender
             = new TransparentDepthBinCallback(mRendering.getResourceSystem()->getSceneManager()->getShaderManager(),
                 Settings::postProcessing().mTransparentPostpass);
         osgUtil::RenderBin::getRenderBinPrototype("DepthSortedBin")->setDrawCallback(mTransparentDepthPostPass);
+        if (Settings::video().mDynamicResolution && !Stereo::getStereo())
+        {
+            mDynamicResolution = std::make_unique<DynamicResolution>(Settings::video().mDynamicResolutionTargetTime,
+                Settings::video().mDynamicResolutionMinimumScale, Settings::video().mDynamicResolutionMaximumScale);
+            mRenderScale = mDynamicResolution->getScale();
+            // shadow maps and water are rendered before the scene and don't depend on its resolution
+            mSceneTimer = new SceneUtil::GpuTimer("Scaled Scene");
+            mSceneTimer->setAlwaysEnabled(true);
+            SceneUtil::addGpuTimer(*mViewer->getCamera(), *mHUDCamera, mSceneTimer);
+        }
+
+        if (Settings::postProcessing().mOrderIndependentAdditiveTransparency)
+            osgUtil::RenderBin::getRenderBinPrototype("DepthSortedBin")->setSortCallback(new TransparentSortCallback);
 
         osg::ref_ptr<osgUtil::RenderBin> distortionRenderBin
             = new osgUtil::RenderBin(osgUtil::RenderBin::SORT_BACK_TO_FRONT);
@@ -226,7 +244,10 @@ namespace MWRender
     PostProcessor::~PostProcessor()
     {
         if (auto* bin = osgUtil::RenderBin::getRenderBinPrototype("DepthSortedBin"))
+        {
             bin->setDrawCallback(nullptr);
+            bin->setSortCallback(nullptr);
+        }
     }
 
     void PostProcessor::resize()
@@ -267,6 +288,13 @@ namespace MWRender
         mUsePostProcessing = true;
     }
 
+    void PostProcessor::setOcclusionCuller(SceneUtil::OcclusionCuller* culler)
+    {
+        mOcclusionCuller = culler;
+        mTransparentDepthPostPass->mDepthReadback
+            = culler != nullptr ? std::make_unique<DepthReadback>(*culler) : nullptr;
+    }
+
     void PostProcessor::disable()
     {
         mUsePostProcessing = false;
@@ -312,7 +340,8 @@ namespace MWRender
 
         size_t frame = cv->getTraversalNumber();
 
-        mStateUpdater->setResolution(osg::Vec2f(cv->getViewport()->width(), cv->getViewport()->height()));
+        mStateUpdater->setResolution(
+            osg::Vec2f(cv->getViewport()->width(), cv->getViewport()->height()) * mRenderScale);
 
         // per-frame data
         if (frame != mLastFrameNumber)
@@ -379,6 +408,19 @@ namespace MWRender
         resize();
     }
 
+    void PostProcessor::updateDynamicResolution()
+    {
+        if (!mDynamicResolution)
+            return;
+
+        const std::optional<double> timeMs = mSceneTimer->takeLatestMs();
+        if (!timeMs.has_value() || !mDynamicResolution->update(*timeMs))
+            return;
+
+        mRenderScale = mDynamicResolution->getScale();
+        resize();
+    }
+
     void PostProcessor::update(size_t frameId)
     {
         while (!mQueuedTemplates.empty())
@@ -392,6 +434,8 @@ namespace MWRender
 
         reloadIfRequired();
 
+        updateDynamicResolution();
+
         mCanvases[frameId]->setNodeMask(~0u);
         mCanvases[!frameId]->setNodeMask(0);
 
@@ -581,6 +625,7 @@ namespace MWRender
 
             Fx::DispatchNode node;
 
+            node.mName = technique->getName();
             node.mFlags = technique->getFlags();
 
             if (technique->getHDR())
@@ -860,14 +905,14 @@ namespace MWRender
     {
         if (Stereo::getStereo())
             return Stereo::Manager::instance().eyeResolution().x();
-        return mWidth;
+        return std::max(1, static_cast<int>(mWidth * mRenderScale));
     }
 
     int PostProcessor::renderHeight() const
     {
         if (Stereo::getStereo())
             return Stereo::Manager::instance().eyeResolution().y();
-        return mHeight;
+        return std::max(1, static_cast<int>(mHeight * mRenderScale));
     }
 
     void PostProcessor::triggerShaderReload()
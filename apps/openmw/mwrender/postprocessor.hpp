@@ -19,6 +19,7 @@
 #include <components/fx/stateupdater.hpp>
 #include <components/fx/technique.hpp>
 #include <components/misc/strings/algorithm.hpp>
+#include <components/sceneutil/occlusionculler.hpp>
 
 #include "pingpongcanvas.hpp"
 #include "transparentpass.hpp"
@@ -45,6 +46,11 @@ namespace Shader
     class ShaderManager;
 }
 
+namespace SceneUtil
+{
+    class GpuTimer;
+}
+
 namespace MWRender
 {
     class RenderingManager;
@@ -52,6 +58,7 @@ namespace MWRender
     class PingPongCanvas;
     class TransparentDepthBinCallback;
     class DistortionCallback;
+    class DynamicResolution;
 
     class PostProcessor : public osg::Group
     {
@@ -124,6 +131,11 @@ namespace MWRender
 
         osg::ref_ptr<Fx::StateUpdater> getStateUpdater() { return mStateUpdater; }
 
+        /// Read back the opaque depth of the scene camera for the culler, must be called before the first frame.
+        void setOcclusionCuller(SceneUtil::OcclusionCuller* culler);
+
+        SceneUtil::OcclusionCuller* getOcclusionCuller() const { return mOcclusionCuller.get(); }
+
         const TechniqueList& getTechniques() { return mTechniques; }
 
         const TechniqueList& getTemplates() const { return mTemplates; }
@@ -198,8 +210,20 @@ namespace MWRender
         int renderWidth() const;
         int renderHeight() const;
 
+        /// @return Whether the scene is rendered at a lower resolution than the window because of dynamic resolution
+        bool isRenderScaled() const { return mRenderScale != 1.f; }
+
         void triggerShaderReload();
 
+        /// Measure the GPU time of the enabled techniques, off by default as the queries have a cost
+        void setTechniqueTimingEnabled(bool enabled) { mTechniqueTimer->setEnabled(enabled); }
+
+        /// @return Averaged GPU time of the technique in milliseconds, nothing if it has not been measured
+        std::optional<double> getTechniqueGpuTime(std::string_view name) const
+        {
+            return mTechniqueTimer->getTimeMs(name);
+        }
+
         bool mEnableLiveReload = false;
 
         void loadChain();
@@ -220,6 +244,8 @@ namespace MWRender
 
         void updateLiveReload();
 
+        void updateDynamicResolution();
+
         void cull(size_t frameId, osgUtil::CullVisitor* cv);
 
         osg::ref_ptr<osg::Group> mRootNode;
@@ -268,6 +294,12 @@ namespace MWRender
         std::array<osg::ref_ptr<PingPongCanvas>, 2> mCanvases;
         osg::ref_ptr<TransparentDepthBinCallback> mTransparentDepthPostPass;
         osg::ref_ptr<DistortionCallback> mDistortionCallback;
+        osg::ref_ptr<SceneUtil::OcclusionCuller> mOcclusionCuller;
+        std::shared_ptr<TechniqueTimer> mTechniqueTimer;
+
+        std::unique_ptr<DynamicResolution> mDynamicResolution;
+        osg::ref_ptr<SceneUtil::GpuTimer> mSceneTimer;
+        float mRenderScale = 1.f;
 
         Fx::DispatchArray mTemplateData;
     };
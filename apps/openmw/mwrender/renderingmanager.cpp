@@ -35,6 +35,8 @@
 
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/incrementalcompileoperation.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/rtt.hpp>
@@ -46,7 +48,9 @@
 
 #include <components/misc/constants.hpp>
 
+#include <components/terrain/compositemapcache.hpp>
 #include <components/terrain/quadtreeworld.hpp>
+#include <components/terrain/snowdeformation.hpp>
 #include <components/terrain/terraingrid.hpp>
 
 #include <components/esm3/loadcell.hpp>
@@ -66,6 +70,7 @@
 #include "../mwmechanics/actorutil.hpp"
 
 #include "../mwbase/environment.hpp"
+#include "../mwbase/mechanicsmanager.hpp"
 #include "../mwbase/windowmanager.hpp"
 #include "../mwbase/world.hpp"
 
@@ -175,6 +180,9 @@ namespace MWRender
             stateset->addUniform(new osg::Uniform("windSpeed", 0.0f));
             stateset->addUniform(new osg::Uniform("playerPos", osg::Vec3f(0.f, 0.f, 0.f)));
             stateset->addUniform(new osg::Uniform("useTreeAnim", false));
+            stateset->addUniform(new osg::Uniform("useGpuSkinning", false));
+            stateset->addUniform(new osg::Uniform("useGpuMorphing", false));
+            stateset->addUniform(new osg::Uniform("useInstancing", false));
         }
 
         void apply(osg::StateSet* stateset, osg::NodeVisitor* nv) override
@@ -400,9 +408,23 @@ namespace MWRender
             .mMaximumLightDistance = Settings::shaders().mMaximumLightDistance,
             .mLightFadeStart = Settings::shaders().mLightFadeStart,
             .mLightBoundsMultiplier = Settings::shaders().mLightBoundsMultiplier,
+            .mClusteredLighting = Settings::shaders().mClusteredLighting,
+            .mLightClustersTextureUnit
+            = Settings::shaders().mClusteredLighting && lightingMethod == SceneUtil::LightingMethod::SingleUBO
+                ? resourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                    Shader::ShaderManager::Slot::LightClusters)
+                : -1,
         });
         resourceSystem->getSceneManager()->setLightingMethod(sceneRoot->getLightingMethod());
         resourceSystem->getSceneManager()->setSupportedLightingMethods(sceneRoot->getSupportedLightingMethods());
+        resourceSystem->getSceneManager()->setGpuSkinning(Settings::shaders().mGpuSkinning);
+        resourceSystem->getSceneManager()->setGpuMorphing(Settings::shaders().mGpuMorphing);
+        if (Settings::terrain().mObjectPagingInstancing && forceShaders && SceneUtil::glExtensionsReady()
+            && osg::isGLExtensionOrVersionSupported(
+                SceneUtil::getGLExtensions().contextID, "GL_ARB_draw_instanced", 3.1))
+            mObjectPagingInstancingUnit
+                = resourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                    Shader::ShaderManager::Slot::InstanceTransforms);
 
         sceneRoot->setLightingMask(Mask_Lighting);
         mSceneRoot = sceneRoot;
@@ -422,9 +444,21 @@ namespace MWRender
         if (Settings::shadows().mTerrainShadows)
             shadowCastingTraversalMask |= Mask_Terrain;
 
+        {
+            // The shadow casting shader is created together with the shadow manager
+            Shader::ShaderManager& shaderManager = mResourceSystem->getSceneManager()->getShaderManager();
+            Shader::ShaderManager::DefineMap defines = shaderManager.getGlobalDefines();
+            defines["gpuSkinning"] = Settings::shaders().mGpuSkinning ? "1" : "0";
+            defines["gpuMorphing"] = Settings::shaders().mGpuMorphing ? "1" : "0";
+            defines["objectInstancing"] = mObjectPagingInstancingUnit >= 0 ? "1" : "0";
+            shaderManager.setGlobalDefines(defines);
+        }
+
         mShadowManager = std::make_unique<SceneUtil::ShadowManager>(sceneRoot, mRootNode, shadowCastingTraversalMask,
             indoorShadowCastingTraversalMask, Mask_Terrain | Mask_Object | Mask_Static, Settings::shadows(),
             mResourceSystem->getSceneManager()->getShaderManager());
+        mShadowManager->setShadowCastingCacheMasks(
+            Settings::shadows(), Mask_Terrain | Mask_Static, Mask_Actor | Mask_Player | Mask_Object);
 
         Shader::ShaderManager::DefineMap shadowDefines = mShadowManager->getShadowDefines(Settings::shadows());
         Shader::ShaderManager::DefineMap lightDefines = sceneRoot->getLightDefines();
@@ -455,6 +489,7 @@ namespace MWRender
         const float groundcoverDistance = Settings::groundcover().mRenderingDistance;
         globalDefines["groundcoverFadeStart"] = std::to_string(groundcoverDistance * 0.9f);
         globalDefines["groundcoverFadeEnd"] = std::to_string(groundcoverDistance);
+        globalDefines["groundcoverDistantDensity"] = std::to_string(Settings::groundcover().mDistantDensity);
         globalDefines["groundcoverStompMode"] = std::to_string(Settings::groundcover().mStompMode);
         globalDefines["groundcoverStompIntensity"] = std::to_string(Settings::groundcover().mStompIntensity);
 
@@ -473,8 +508,11 @@ namespace MWRender
 
         if (getenv("OPENMW_DONT_PRECOMPILE") == nullptr)
         {
-            mViewer->setIncrementalCompileOperation(new osgUtil::IncrementalCompileOperation);
-            mViewer->getIncrementalCompileOperation()->setTargetFrameRate(Settings::cells().mTargetFramerate);
+            mIncrementalCompileOperation = new SceneUtil::IncrementalCompileOperation;
+            mIncrementalCompileOperation->setTargetFrameRate(Settings::cells().mTargetFramerate);
+            mIncrementalCompileOperation->setMaxBytesPerFrame(
+                static_cast<std::size_t>(Settings::cells().mMaxCompileSizePerFrame) * 1024);
+            mViewer->setIncrementalCompileOperation(mIncrementalCompileOperation);
         }
 
         mDebugDraw = new Debug::DebugDrawer(mResourceSystem->getSceneManager()->getShaderManager());
@@ -499,6 +537,14 @@ namespace MWRender
         mGroundcover = chunkMgr.mGroundcover.get();
         mObjectPaging = chunkMgr.mObjectPaging.get();
 
+        mResourceSystem->getMemoryRegistry().add("Snow", [this] {
+            Resource::MemoryUsage result;
+            for (auto& [worldspace, chunks] : mWorldspaceChunks)
+                if (const Terrain::SnowDeformationManager* snow = chunks.mTerrain->getSnowDeformationManager())
+                    result += snow->getMemoryUsage();
+            return result;
+        });
+
         mStateUpdater = new StateUpdater;
         sceneRoot->addUpdateCallback(mStateUpdater);
 
@@ -514,6 +560,9 @@ namespace MWRender
             mPostProcessor->getTexture(PostProcessor::Tex_OpaqueDepth, 1));
         resourceSystem->getSceneManager()->setSupportsNormalsRT(mPostProcessor->getSupportsNormalsRT());
         resourceSystem->getSceneManager()->setWeatherParticleOcclusion(Settings::shaders().mWeatherParticleOcclusion);
+        // The depth is read back after it is resolved, which multiview does separately
+        if (Settings::camera().mOcclusionCulling && !Stereo::getMultiview())
+            mPostProcessor->setOcclusionCuller(new SceneUtil::OcclusionCuller);
 
         // water goes after terrain for correct waterculling order
         mWater = std::make_unique<Water>(
@@ -583,6 +632,7 @@ namespace MWRender
         NifOsg::Loader::setHiddenNodeMask(Mask_UpdateVisitor);
         NifOsg::Loader::setIntersectionDisabledNodeMask(Mask_Effect);
         NifOsg::Loader::setSoftEffectEnabled(Settings::shaders().mSoftParticles);
+        NifOsg::Loader::setPauseOffscreenParticles(Settings::models().mPauseOffscreenParticles);
         Nif::Reader::setLoadUnsupportedFiles(Settings::models().mLoadUnsupportedNifFiles);
 
         mStateUpdater->setFogEnd(mViewDistance);
@@ -610,6 +660,8 @@ namespace MWRender
 
     RenderingManager::~RenderingManager()
     {
+        mResourceSystem->getMemoryRegistry().remove("Snow");
+
         // let background loading thread finish before we delete anything else
         mWorkQueue = nullptr;
     }
@@ -634,6 +686,14 @@ namespace MWRender
         return mWorkQueue.get();
     }
 
+    void RenderingManager::setCompositeMapCacheDirectory(const std::filesystem::path& directory)
+    {
+        mCompositeMapCache = std::make_unique<Terrain::CompositeMapCache>(*mResourceSystem->getVFS(), directory);
+        mCompositeMapCache->setWorkQueue(mWorkQueue.get());
+        for (auto& [worldspace, chunkMgr] : mWorldspaceChunks)
+            chunkMgr.mTerrain->setCompositeMapCache(mCompositeMapCache.get());
+    }
+
     Terrain::World* RenderingManager::getTerrain()
     {
         return mTerrain;
@@ -782,6 +842,8 @@ namespace MWRender
             enableTerrain(true, store->getCell()->getWorldSpace());
             mTerrain->loadCell(store->getCell()->getGridX(), store->getCell()->getGridY());
         }
+
+        mShadowManager->invalidateStaticShadows();
     }
     void RenderingManager::removeCell(const MWWorld::CellStore* store)
     {
@@ -796,6 +858,7 @@ namespace MWRender
         }
 
         mWater->removeCell(store);
+        mShadowManager->invalidateStaticShadows();
     }
 
     void RenderingManager::enableTerrain(bool enable, ESM::RefId worldspace)
@@ -918,6 +981,20 @@ namespace MWRender
             mTerrain->setPlayerPosition(playerPos);
             mTerrain->updateSubdivisionTracker(dt);
 
+            // Other actors near the player leave footprints too, they are stamped with the player's in one pass
+            if (Terrain::SnowDeformationManager* snow = mTerrain->getSnowDeformationManager())
+            {
+                osg::Vec2f center;
+                float radius;
+                snow->getDeformationTextureParams(center, radius);
+                std::vector<MWWorld::Ptr> actors;
+                MWBase::Environment::get().getMechanicsManager()->getActorsInRange(playerPos, radius, actors);
+                for (const MWWorld::Ptr& actor : actors)
+                    if (actor != player)
+                        snow->trackActor(reinterpret_cast<std::uintptr_t>(actor.getBase()),
+                            actor.getRefData().getPosition().asVec3());
+            }
+
             // Update snow deformation system
             mTerrain->updateSnowDeformation(dt, playerPos);
         }
@@ -932,6 +1009,9 @@ namespace MWRender
         }
         mCamera->update(dt, paused);
 
+        if (mIncrementalCompileOperation != nullptr)
+            mIncrementalCompileOperation->setViewPoint(mCamera->getPosition());
+
         bool isUnderwater = mWater->isUnderwater(mCamera->getPosition());
 
         float fogStart = mFog->getFogStart(isUnderwater);
@@ -1470,10 +1550,12 @@ namespace MWRender
             auto quadTreeWorld = std::make_unique<Terrain::QuadTreeWorld>(mSceneRoot, mRootNode, mResourceSystem,
                 mTerrainStorage.get(), Mask_Terrain, Mask_PreCompile, Mask_Debug, compMapResolution, compMapLevel,
                 lodFactor, vertexLodMod, maxCompGeometrySize, debugChunks, worldspace, expiryDelay);
+            quadTreeWorld->setOcclusionCuller(mPostProcessor->getOcclusionCuller());
             if (Settings::terrain().mObjectPaging)
             {
                 newChunkMgr.mObjectPaging
-                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace);
+                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace,
+                        mObjectPagingInstancingUnit);
                 quadTreeWorld->addChunkManager(newChunkMgr.mObjectPaging.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mObjectPaging.get());
             }
@@ -1494,6 +1576,9 @@ namespace MWRender
                 mTerrainStorage.get(), Mask_Terrain, worldspace, expiryDelay, Mask_PreCompile, Mask_Debug);
 
         newChunkMgr.mTerrain->setTargetFrameRate(Settings::cells().mTargetFramerate);
+        newChunkMgr.mTerrain->setWorkQueue(mWorkQueue.get());
+        if (mCompositeMapCache != nullptr)
+            newChunkMgr.mTerrain->setCompositeMapCache(mCompositeMapCache.get());
         float distanceMult = std::cos(osg::DegreesToRadians(std::min(mFieldOfView, 140.f)) / 2.f);
         newChunkMgr.mTerrain->setViewDistance(mViewDistance * (distanceMult ? 1.f / distanceMult : 1.f));
         newChunkMgr.mTerrain->enableHeightCullCallback(Settings::terrain().mWaterCulling);
@@ -1508,6 +1593,8 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            if (mIncrementalCompileOperation != nullptr)
+                mIncrementalCompileOperation->reportStats(frameNumber, *stats);
         }
     }
 
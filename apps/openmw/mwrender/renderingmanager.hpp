@@ -14,6 +14,7 @@
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <deque>
+#include <filesystem>
 #include <memory>
 #include <span>
 #include <unordered_map>
@@ -49,6 +50,7 @@ namespace ESM
 
 namespace Terrain
 {
+    class CompositeMapCache;
     class World;
 }
 
@@ -59,6 +61,7 @@ namespace Fallback
 
 namespace SceneUtil
 {
+    class IncrementalCompileOperation;
     class ShadowManager;
     class WorkQueue;
     class LightManager;
@@ -125,6 +128,9 @@ namespace MWRender
         SceneUtil::WorkQueue* getWorkQueue();
         Terrain::World* getTerrain();
 
+        /// Keep composite maps of distant terrain in this directory between runs
+        void setCompositeMapCacheDirectory(const std::filesystem::path& directory);
+
         void preloadCommonAssets();
 
         double getReferenceTime() const;
@@ -309,6 +315,7 @@ namespace MWRender
         Resource::ResourceSystem* mResourceSystem;
 
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        osg::ref_ptr<SceneUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
 
         osg::ref_ptr<osg::Light> mSunLight;
 
@@ -320,10 +327,14 @@ namespace MWRender
         std::unique_ptr<Pathgrid> mPathgrid;
         std::unique_ptr<Objects> mObjects;
         std::unique_ptr<Water> mWater;
+        // Used by the terrain of all worldspaces, must outlive them
+        std::unique_ptr<Terrain::CompositeMapCache> mCompositeMapCache;
         std::unordered_map<ESM::RefId, WorldspaceChunkMgr> mWorldspaceChunks;
         Terrain::World* mTerrain;
         std::unique_ptr<TerrainStorage> mTerrainStorage;
         ObjectPaging* mObjectPaging;
+        // Texture unit of the instance transforms of object paging, or -1 when instancing is not used
+        int mObjectPagingInstancingUnit = -1;
         Groundcover* mGroundcover;
         std::unique_ptr<SkyManager> mSky;
         std::unique_ptr<FogManager> mFog;
@@ -10,6 +10,7 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/dynamicsurface.hpp>
 #include <components/sceneutil/glextensions.hpp>
 #include <components/shader/shadermanager.hpp>
 
@@ -65,15 +66,8 @@ namespace MWRender
 
         for (size_t i = 0; i < mTextures.size(); ++i)
         {
-            osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-            texture->setSourceFormat(GL_RGBA);
-            texture->setInternalFormat(GL_RGBA16F);
-            texture->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture::LINEAR);
-            texture->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture::LINEAR);
-            texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_BORDER);
-            texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_BORDER);
-            texture->setBorderColor(osg::Vec4(0, 0, 0, 0));
-            texture->setTextureSize(sRTTSize, sRTTSize);
+            osg::ref_ptr<osg::Texture2D> texture
+                = SceneUtil::createDynamicSurfaceTexture(sRTTSize, osg::Texture::CLAMP_TO_BORDER);
 
             mTextures[i] = texture;
 
@@ -298,6 +292,13 @@ namespace MWRender
         mPositionCount++;
     }
 
+    bool RipplesSurface::isInSimulationArea(const osg::Vec3f& pos) const
+    {
+        constexpr float halfSize = sRTTSize * sWorldScaleFactor / 2;
+        const osg::Vec3f playerPos = MWMechanics::getPlayer().getRefData().getPosition().asVec3();
+        return std::abs(pos.x() - playerPos.x()) < halfSize && std::abs(pos.y() - playerPos.y()) < halfSize;
+    }
+
     void RipplesSurface::releaseGLObjects(osg::State* state) const
     {
         for (const auto& tex : mTextures)
@@ -337,6 +338,11 @@ namespace MWRender
         mRipples->emit(pos, sizeInCellUnits);
     }
 
+    bool Ripples::isInSimulationArea(const osg::Vec3f& pos) const
+    {
+        return mRipples->isInSimulationArea(pos);
+    }
+
     void Ripples::setPaused(bool paused)
     {
         mRipples->setPaused(paused);
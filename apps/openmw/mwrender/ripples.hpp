@@ -38,6 +38,9 @@ namespace MWRender
 
         void emit(const osg::Vec3f pos, float sizeInCellUnits);
 
+        /// @return Whether ripples emitted at pos are inside the simulated area around the player.
+        bool isInSimulationArea(const osg::Vec3f& pos) const;
+
         void drawImplementation(osg::RenderInfo& renderInfo) const override;
 
         void setPaused(bool paused) { mPaused = paused; }
@@ -95,6 +98,8 @@ namespace MWRender
 
         void emit(const osg::Vec3f pos, float sizeInCellUnits);
 
+        bool isInSimulationArea(const osg::Vec3f& pos) const;
+
         void setPaused(bool paused);
 
         osg::ref_ptr<RipplesSurface> mRipples;
@@ -165,7 +165,7 @@ namespace MWRender
             {
                 emitter.mTimer = 0.f;
             }
-            else if (mRipples)
+            else if (mRipples && mRipples->isInSimulationArea(currentPos))
             {
                 // Ripple simulation needs to continously apply impulses to keep simulation alive.
                 // Adding a timer delay will introduce many smaller ripples around actor instead of a smooth wake
@@ -236,7 +236,8 @@ namespace MWRender
     {
         if (std::abs(pos.z() - mParticleNode->getPosition().z()) < 20)
         {
-            if (mRipples)
+            // The ripple map covers only the area around the player, farther water still gets particles
+            if (mRipples && mRipples->isInSimulationArea(pos))
             {
                 constexpr float particleRippleSizeInUnits = 12.f;
                 mRipples->emit(osg::Vec3f(pos.x(), pos.y(), 0.f), particleRippleSizeInUnits);
@@ -1,5 +1,7 @@
 #include "sky.hpp"
 
+#include <algorithm>
+
 #include <osg/Depth>
 #include <osg/PositionAttitudeTransform>
 
@@ -9,10 +11,12 @@
 #include <osgParticle/Operator>
 #include <osgParticle/ParticleSystemUpdater>
 
+#include <components/debug/debuglog.hpp>
 #include <components/settings/values.hpp>
 
 #include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/visitor.hpp>
@@ -33,6 +37,7 @@
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
+#include "gpuprecipitation.hpp"
 #include "renderbin.hpp"
 #include "skyutil.hpp"
 #include "util.hpp"
@@ -40,6 +45,8 @@
 
 namespace
 {
+    constexpr float rainThreshold = 0.6f; // Rain_Threshold?
+
     class WrapAroundOperator : public osgParticle::Operator
     {
     public:
@@ -121,7 +128,6 @@ namespace
 
         void operate(osgParticle::Particle* particle, double dt) override
         {
-            constexpr float rainThreshold = 0.6f; // Rain_Threshold?
             float alpha = mIsRain ? mAlpha * rainThreshold : mAlpha;
             particle->setAlphaRange(osgParticle::rangef(alpha, alpha));
         }
@@ -211,6 +217,7 @@ namespace
             , mEarlyRenderBinRoot(earlyRenderBinRoot)
         {
             setDepthBufferInternalFormat(GL_DEPTH24_STENCIL8);
+            setGpuTimer(new SceneUtil::GpuTimer("Sky"));
         }
 
         void setDefaults(osg::Camera* camera) override
@@ -293,6 +300,10 @@ namespace MWRender
 
         mPrecipitationOcclusion = Settings::shaders().mWeatherParticleOcclusion;
         mPrecipitationOccluder = std::make_unique<PrecipitationOccluder>(mSkyRootNode, parentNode, rootNode, camera);
+
+        mUseGpuRain = Settings::shaders().mGpuRain && GpuPrecipitation::isSupported(*mSceneManager);
+        if (Settings::shaders().mGpuRain && !mUseGpuRain)
+            Log(Debug::Warning) << "GPU rain requires shaders and instanced drawing, using particles instead";
     }
 
     void SkyManager::create()
@@ -387,6 +398,28 @@ namespace MWRender
 
         mRainNode = new osg::Group;
 
+        constexpr VFS::Path::NormalizedView raindropImage("textures/tx_raindrop_01.dds");
+        osg::ref_ptr<osg::Texture2D> raindropTex
+            = new osg::Texture2D(mSceneManager->getImageManager()->getImage(raindropImage));
+        raindropTex->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        raindropTex->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+
+        if (mUseGpuRain)
+        {
+            mGpuRain = std::make_unique<GpuPrecipitation>(*mSceneManager, raindropTex, mPrecipitationOcclusion);
+            // Same size as the particles, see below
+            mGpuRain->setDropSize(5.f, 15.f, 0.1f);
+            mRainNode->addChild(mGpuRain->getNode());
+            mRainNode->addCullCallback(mUnderwaterSwitch);
+            mRainNode->setNodeMask(Mask_WeatherParticles);
+            updateRainParameters();
+
+            mSkyNode->addChild(mRainNode);
+            if (mPrecipitationOcclusion)
+                mPrecipitationOccluder->enable();
+            return;
+        }
+
         mRainParticleSystem = new NifOsg::ParticleSystem;
         osg::Vec3 rainRange = osg::Vec3(mRainDiameter, mRainDiameter, (mRainMinHeight + mRainMaxHeight) / 2.f);
 
@@ -396,12 +429,6 @@ namespace MWRender
 
         osg::ref_ptr<osg::StateSet> stateset = mRainParticleSystem->getOrCreateStateSet();
 
-        constexpr VFS::Path::NormalizedView raindropImage("textures/tx_raindrop_01.dds");
-        osg::ref_ptr<osg::Texture2D> raindropTex
-            = new osg::Texture2D(mSceneManager->getImageManager()->getImage(raindropImage));
-        raindropTex->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-        raindropTex->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-
         stateset->setTextureAttributeAndModes(0, raindropTex);
         stateset->setNestRenderBins(false);
         stateset->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
@@ -479,6 +506,7 @@ namespace MWRender
         mCounter = nullptr;
         mRainParticleSystem = nullptr;
         mRainShooter = nullptr;
+        mGpuRain = nullptr;
         mPrecipitationOccluder->disable();
     }
 
@@ -544,6 +572,12 @@ namespace MWRender
 
         switchUnderwaterRain();
 
+        if (mGpuRain)
+        {
+            mGpuRain->setAlpha(mPrecipitationAlpha * rainThreshold);
+            mGpuRain->update(duration);
+        }
+
         if (mIsStorm && mParticleNode)
         {
             osg::Quat quat;
@@ -629,10 +663,25 @@ namespace MWRender
             mCounter->setNumberOfParticlesPerSecondToCreate(mRainMaxRaindrops / mRainEntranceSpeed * 20);
             mPrecipitationOccluder->updateRange(rainRange);
         }
+        else if (mGpuRain)
+        {
+            float angle = -std::atan(mWindSpeed / 50.f);
+            mGpuRain->setVelocity(osg::Vec3f(0, mRainSpeed * std::sin(angle), -mRainSpeed / std::cos(angle)));
+
+            osg::Vec3 rainRange = osg::Vec3(mRainDiameter, mRainDiameter, (mRainMinHeight + mRainMaxHeight) / 2.f);
+            mGpuRain->setRange(rainRange);
+
+            // As many drops as the particle system keeps alive, its particles live for a second
+            mGpuRain->setDropCount(static_cast<unsigned>(std::max(0.f, mRainMaxRaindrops / mRainEntranceSpeed * 20)));
+            mPrecipitationOccluder->updateRange(rainRange);
+        }
     }
 
     void SkyManager::switchUnderwaterRain()
     {
+        if (mGpuRain)
+            mGpuRain->setFrozen(mUnderwaterSwitch->isUnderwater());
+
         if (!mRainParticleSystem)
             return;
 
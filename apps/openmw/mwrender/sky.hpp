@@ -40,6 +40,8 @@ namespace SceneUtil
 
 namespace MWRender
 {
+    class GpuPrecipitation;
+
     ///@brief The SkyManager handles rendering of the sky domes, celestial bodies as well as other objects that need to
     /// be rendered
     /// relative to the camera (e.g. weather particle effects)
@@ -150,6 +152,9 @@ namespace MWRender
         osg::ref_ptr<osgParticle::BoxPlacer> mPlacer;
         osg::ref_ptr<RainCounter> mCounter;
         osg::ref_ptr<RainShooter> mRainShooter;
+        // Replaces the rain particle system when enabled
+        bool mUseGpuRain = false;
+        std::unique_ptr<GpuPrecipitation> mGpuRain;
 
         bool mPrecipitationOcclusion = false;
         std::unique_ptr<PrecipitationOccluder> mPrecipitationOccluder;
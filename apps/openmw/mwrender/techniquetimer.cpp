@@ -0,0 +1,120 @@
+#include "techniquetimer.hpp"
+
+#include <osg/GLExtensions>
+#include <osg/State>
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+namespace MWRender
+{
+    namespace
+    {
+        // Weight of a new measurement, single frames vary too much to be readable
+        constexpr double smoothing = 0.1;
+
+        const osg::GLExtensions* getTimerExtensions(osg::State& state)
+        {
+            const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+            if (!extensions || !extensions->isTimerQuerySupported)
+                return nullptr;
+            return extensions;
+        }
+    }
+
+    void TechniqueTimer::setEnabled(bool enabled)
+    {
+        if (enabled && !isEnabled())
+        {
+            const std::lock_guard lock(mMutex);
+            mTimesMs.clear();
+        }
+        mEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void TechniqueTimer::collect(osg::State& state)
+    {
+        const osg::GLExtensions* extensions = getTimerExtensions(state);
+        if (!extensions)
+            return;
+
+        const auto it = mQueries.find(state.getContextID());
+        if (it == mQueries.end())
+            return;
+
+        Queries& queries = it->second;
+
+        // Oldest first, results of a frame are only available after the ones of the previous frames
+        for (std::size_t i = 0; i < sQueryCount; ++i)
+        {
+            const std::size_t index = (queries.mNext + i) % sQueryCount;
+            if (!queries.mIssued[index])
+                continue;
+
+            GLint available = 0;
+            extensions->glGetQueryObjectiv(queries.mIds[index], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                break;
+
+            GLuint64 elapsed = 0;
+            extensions->glGetQueryObjectui64v(queries.mIds[index], GL_QUERY_RESULT, &elapsed);
+            queries.mIssued[index] = false;
+
+            const double timeMs = static_cast<double>(elapsed) / 1e6;
+            const std::lock_guard lock(mMutex);
+            const auto [time, inserted] = mTimesMs.emplace(queries.mNames[index], timeMs);
+            if (!inserted)
+                time->second += (timeMs - time->second) * smoothing;
+        }
+    }
+
+    void TechniqueTimer::begin(osg::State& state, const std::string& name)
+    {
+        if (!isEnabled())
+            return;
+
+        const osg::GLExtensions* extensions = getTimerExtensions(state);
+        if (!extensions)
+            return;
+
+        Queries& queries = mQueries[state.getContextID()];
+        if (!queries.mGenerated)
+        {
+            extensions->glGenQueries(static_cast<GLsizei>(sQueryCount), queries.mIds.data());
+            queries.mGenerated = true;
+        }
+
+        // Every query is still in flight, skip timing this technique rather than waiting
+        const std::size_t index = queries.mNext;
+        if (queries.mIssued[index])
+            return;
+
+        extensions->glBeginQuery(GL_TIME_ELAPSED, queries.mIds[index]);
+        queries.mNames[index] = name;
+        queries.mActive = true;
+    }
+
+    void TechniqueTimer::end(osg::State& state)
+    {
+        const auto it = mQueries.find(state.getContextID());
+        if (it == mQueries.end() || !it->second.mActive)
+            return;
+
+        Queries& queries = it->second;
+        state.get<osg::GLExtensions>()->glEndQuery(GL_TIME_ELAPSED);
+
+        queries.mIssued[queries.mNext] = true;
+        queries.mNext = (queries.mNext + 1) % sQueryCount;
+        queries.mActive = false;
+    }
+
+    std::optional<double> TechniqueTimer::getTimeMs(std::string_view name) const
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mTimesMs.find(name);
+        if (it == mTimesMs.end())
+            return std::nullopt;
+        return it->second;
+    }
+}
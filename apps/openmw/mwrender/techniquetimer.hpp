@@ -0,0 +1,65 @@
+#ifndef OPENMW_MWRENDER_TECHNIQUETIMER_H
+#define OPENMW_MWRENDER_TECHNIQUETIMER_H
+
+#include <osg/GL>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace osg
+{
+    class State;
+}
+
+namespace MWRender
+{
+    /// Measures the GPU time of every post-processing technique with GL_TIME_ELAPSED queries
+    /// Results are read back in later frames once available, so timing never stalls the pipeline
+    /// @note Does nothing while disabled or when timer queries are not supported
+    class TechniqueTimer
+    {
+    public:
+        /// Times measured before the timer was last disabled are dropped when it is enabled again
+        void setEnabled(bool enabled);
+
+        bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        /// Read back the finished queries, called once per frame before the first technique is drawn
+        void collect(osg::State& state);
+
+        /// Start timing the draws of the technique until end is called
+        void begin(osg::State& state, const std::string& name);
+
+        void end(osg::State& state);
+
+        /// @return Averaged GPU time of the technique in milliseconds, nothing if it has not been measured yet
+        std::optional<double> getTimeMs(std::string_view name) const;
+
+    private:
+        /// Queries in flight per graphics context, enough to cover a few frames of latency of a long chain
+        static constexpr std::size_t sQueryCount = 64;
+
+        struct Queries
+        {
+            std::array<GLuint, sQueryCount> mIds{};
+            std::array<std::string, sQueryCount> mNames;
+            std::array<bool, sQueryCount> mIssued{};
+            std::size_t mNext = 0;
+            bool mGenerated = false;
+            bool mActive = false;
+        };
+
+        std::atomic<bool> mEnabled{ false };
+        std::map<unsigned int, Queries> mQueries;
+        mutable std::mutex mMutex;
+        std::map<std::string, double, std::less<>> mTimesMs;
+    };
+}
+
+#endif
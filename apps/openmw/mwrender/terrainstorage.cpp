@@ -18,8 +18,8 @@ namespace MWRender
         bool autoUseSpecularMaps)
         : ESMTerrain::Storage(resourceSystem->getVFS(), normalMapPattern, normalHeightMapPattern, autoUseNormalMaps,
             specularMapPattern, autoUseSpecularMaps)
-        , mLandManager(new LandManager(
-              ESM::Land::DATA_VCLR | ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VTEX))
+        // Data types are loaded on request, physics and navigation only need heights
+        , mLandManager(new LandManager(0))
         , mResourceSystem(resourceSystem)
     {
         mResourceSystem->addResourceManager(mLandManager.get());
@@ -1,22 +1,139 @@
 #include "transparentpass.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include <osg/AlphaFunc>
+#include <osg/BlendEquation>
 #include <osg/BlendFunc>
+#include <osg/Depth>
 #include <osg/Material>
+#include <osg/Math>
 #include <osg/Texture2D>
 #include <osg/Texture2DArray>
 
 #include <osgUtil/RenderStage>
+#include <osgUtil/StateGraph>
 
 #include <components/sceneutil/depth.hpp>
 #include <components/shader/shadermanager.hpp>
 #include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
 
+#include "depthreadback.hpp"
 #include "vismask.hpp"
 
 namespace MWRender
 {
+    namespace
+    {
+        bool overrides(unsigned int outer, unsigned int inner)
+        {
+            return (outer & osg::StateAttribute::OVERRIDE) && !(inner & osg::StateAttribute::PROTECTED);
+        }
+
+        template <class T>
+        const T* getEffectiveAttribute(const osgUtil::StateGraph* graph, osg::StateAttribute::Type type)
+        {
+            const osg::StateSet::RefAttributePair* result = nullptr;
+            for (; graph != nullptr; graph = graph->_parent)
+            {
+                if (graph->getStateSet() == nullptr)
+                    continue;
+                const osg::StateSet::RefAttributePair* pair = graph->getStateSet()->getAttributePair(type);
+                if (pair != nullptr && (result == nullptr || overrides(pair->second, result->second)))
+                    result = pair;
+            }
+            return result != nullptr ? static_cast<const T*>(result->first.get()) : nullptr;
+        }
+
+        bool isModeOn(const osgUtil::StateGraph* graph, GLenum mode)
+        {
+            osg::StateAttribute::GLModeValue result = osg::StateAttribute::INHERIT;
+            for (; graph != nullptr; graph = graph->_parent)
+            {
+                if (graph->getStateSet() == nullptr)
+                    continue;
+                const osg::StateAttribute::GLModeValue value = graph->getStateSet()->getMode(mode);
+                if (value != osg::StateAttribute::INHERIT
+                    && (result == osg::StateAttribute::INHERIT || overrides(value, result)))
+                    result = value;
+            }
+            return result != osg::StateAttribute::INHERIT && (result & osg::StateAttribute::ON);
+        }
+
+        bool isCommutativeSource(GLenum factor)
+        {
+            switch (factor)
+            {
+                case GL_ZERO:
+                case GL_ONE:
+                case GL_SRC_ALPHA:
+                case GL_ONE_MINUS_SRC_ALPHA:
+                case GL_SRC_COLOR:
+                case GL_ONE_MINUS_SRC_COLOR:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // The destination is only ever added to, and nothing is written to the depth buffer to occlude other leaves
+        bool isOrderIndependent(const osgUtil::StateGraph* graph)
+        {
+            if (!isModeOn(graph, GL_BLEND))
+                return false;
+
+            const osg::Depth* depth = getEffectiveAttribute<osg::Depth>(graph, osg::StateAttribute::DEPTH);
+            if (depth == nullptr || depth->getWriteMask())
+                return false;
+
+            const osg::BlendFunc* blendFunc
+                = getEffectiveAttribute<osg::BlendFunc>(graph, osg::StateAttribute::BLENDFUNC);
+            if (blendFunc == nullptr || blendFunc->getDestinationRGB() != GL_ONE
+                || blendFunc->getDestinationAlpha() != GL_ONE || !isCommutativeSource(blendFunc->getSourceRGB())
+                || !isCommutativeSource(blendFunc->getSourceAlpha()))
+                return false;
+
+            const osg::BlendEquation* blendEquation
+                = getEffectiveAttribute<osg::BlendEquation>(graph, osg::StateAttribute::BLENDEQUATION);
+            return blendEquation == nullptr
+                || (blendEquation->getEquationRGB() == osg::BlendEquation::FUNC_ADD
+                    && blendEquation->getEquationAlpha() == osg::BlendEquation::FUNC_ADD);
+        }
+    }
+
+    void TransparentSortCallback::sortImplementation(osgUtil::RenderBin* bin)
+    {
+        osgUtil::RenderBin::StateGraphList& graphs = bin->getStateGraphList();
+        osgUtil::RenderBin::RenderLeafList& leaves = bin->getRenderLeafList();
+        leaves.clear();
+
+        std::vector<const osgUtil::StateGraph*> unsorted;
+        for (const osgUtil::StateGraph* graph : graphs)
+        {
+            if (isOrderIndependent(graph))
+            {
+                unsorted.push_back(graph);
+                continue;
+            }
+            for (const osg::ref_ptr<osgUtil::RenderLeaf>& leaf : graph->_leaves)
+                if (!osg::isNaN(leaf->_depth))
+                    leaves.push_back(leaf.get());
+        }
+
+        std::sort(leaves.begin(), leaves.end(),
+            [](const osgUtil::RenderLeaf* lhs, const osgUtil::RenderLeaf* rhs) { return lhs->_depth > rhs->_depth; });
+
+        // Grouped by state as they were collected to keep the state changes down
+        for (const osgUtil::StateGraph* graph : unsorted)
+            for (const osg::ref_ptr<osgUtil::RenderLeaf>& leaf : graph->_leaves)
+                if (!osg::isNaN(leaf->_depth))
+                    leaves.push_back(leaf.get());
+
+        graphs.clear();
+    }
+
     TransparentDepthBinCallback::TransparentDepthBinCallback(Shader::ShaderManager& shaderManager, bool postPass)
         : mStateSet(new osg::StateSet)
         , mPostPass(postPass)
@@ -45,6 +162,8 @@ namespace MWRender
             mStateSet->setTextureMode(unit, GL_TEXTURE_2D, modeOff);
     }
 
+    TransparentDepthBinCallback::~TransparentDepthBinCallback() = default;
+
     void TransparentDepthBinCallback::drawImplementation(
         osgUtil::RenderBin* bin, osg::RenderInfo& renderInfo, osgUtil::RenderLeaf*& previous)
     {
@@ -94,6 +213,13 @@ namespace MWRender
             opaqueFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
             ext->glBlitFramebuffer(0, 0, tex->getTextureWidth(), tex->getTextureHeight(), 0, 0, tex->getTextureWidth(),
                 tex->getTextureHeight(), GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+            if (mDepthReadback)
+            {
+                mDepthReadback->readback(state, *opaqueFbo, *tex);
+                msaaFbo ? msaaFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER)
+                        : fbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+            }
         }
 
         msaaFbo ? msaaFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER)
@@ -21,10 +21,13 @@ namespace Stereo
 
 namespace MWRender
 {
+    class DepthReadback;
+
     class TransparentDepthBinCallback : public osgUtil::RenderBin::DrawCallback
     {
     public:
         TransparentDepthBinCallback(Shader::ShaderManager& shaderManager, bool postPass);
+        ~TransparentDepthBinCallback();
 
         void drawImplementation(
             osgUtil::RenderBin* bin, osg::RenderInfo& renderInfo, osgUtil::RenderLeaf*& previous) override;
@@ -35,11 +38,22 @@ namespace MWRender
 
         std::array<std::unique_ptr<Stereo::MultiviewFramebufferResolve>, 2> mMultiviewResolve;
 
+        // Reads back the opaque depth after it was resolved, only without multiview
+        std::unique_ptr<DepthReadback> mDepthReadback;
+
     private:
         osg::ref_ptr<osg::StateSet> mStateSet;
         bool mPostPass;
     };
 
+    /// Sorts the transparent bin back to front except for the additive leaves which don't write depth. These blend the
+    /// same in any order, so they are drawn unsorted after the others without paying the per-leaf sort.
+    class TransparentSortCallback : public osgUtil::RenderBin::SortCallback
+    {
+    public:
+        void sortImplementation(osgUtil::RenderBin* bin) override;
+    };
+
 }
 
 #endif
@@ -1,5 +1,6 @@
 #include "water.hpp"
 
+#include <map>
 #include <sstream>
 
 #include <osg/ClipNode>
@@ -20,6 +21,7 @@
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/waterutil.hpp>
@@ -252,6 +254,8 @@ namespace MWRender
             , mNodeMask(Refraction::sDefaultCullMask)
         {
             setDepthBufferInternalFormat(GL_DEPTH24_STENCIL8);
+            setUpdateInterval(getReflectionUpdateInterval());
+            setGpuTimer(new SceneUtil::GpuTimer("Water Refraction"));
             mClipCullNode = new ClipCullNode;
         }
 
@@ -323,6 +327,17 @@ namespace MWRender
             | Mask_Groundcover;
     };
 
+    namespace
+    {
+        // The reprojection of skipped frames only knows the view matrix of a single view
+        unsigned getReflectionUpdateInterval()
+        {
+            if (Stereo::getStereo())
+                return 1;
+            return static_cast<unsigned>(Settings::water().mReflectionUpdateInterval.get());
+        }
+    }
+
     class Reflection : public SceneUtil::RTTNode
     {
     public:
@@ -331,6 +346,7 @@ namespace MWRender
         {
             setInterior(isInterior);
             setDepthBufferInternalFormat(GL_DEPTH24_STENCIL8);
+            setGpuTimer(new SceneUtil::GpuTimer("Water Reflection"));
             mClipCullNode = new ClipCullNode;
         }
 
@@ -641,6 +657,8 @@ namespace MWRender
             stateset->setAttributeAndModes(mProgram, osg::StateAttribute::ON);
 
             stateset->addUniform(new osg::Uniform("reflectionMap", 1));
+            if (mReflection->getUpdateInterval() > 1)
+                stateset->addUniform(new osg::Uniform("reflectionReprojection", osg::Matrixf()));
             if (mRefraction)
             {
                 stateset->addUniform(new osg::Uniform("refractionMap", 2));
@@ -666,6 +684,16 @@ namespace MWRender
         {
             osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(nv);
             stateset->setTextureAttributeAndModes(1, mReflection->getColorTexture(cv), osg::StateAttribute::ON);
+            if (const unsigned interval = mReflection->getUpdateInterval(); interval > 1)
+            {
+                // Map view space positions of this frame to the screen of the frame the reflection was rendered in
+                const osg::Matrixf view = cv->getCurrentCamera()->getViewMatrix();
+                osg::Matrixf& reflectionViewProjection = mReflectionViewProjections[cv];
+                if (cv->getFrameStamp()->getFrameNumber() % interval == 0)
+                    reflectionViewProjection = view * *cv->getProjectionMatrix();
+                stateset->getUniform("reflectionReprojection")
+                    ->set(osg::Matrixf::inverse(view) * reflectionViewProjection);
+            }
 
             if (mRefraction)
             {
@@ -686,6 +714,7 @@ namespace MWRender
         Ripples* mRipples;
         osg::ref_ptr<osg::Program> mProgram;
         osg::ref_ptr<osg::Texture2D> mNormalMap;
+        std::map<osgUtil::CullVisitor*, osg::Matrixf> mReflectionViewProjections;
     };
 
     void Water::createShaderWaterStateSet(osg::Node* node)
@@ -699,6 +728,7 @@ namespace MWRender
         defineMap["rippleMapSize"] = std::to_string(RipplesSurface::sRTTSize) + ".0";
         defineMap["sunlightScattering"] = Settings::water().mSunlightScattering ? "1" : "0";
         defineMap["wobblyShores"] = Settings::water().mWobblyShores ? "1" : "0";
+        defineMap["reflectionReprojection"] = mReflection->getUpdateInterval() > 1 ? "1" : "0";
 
         Stereo::shaderStereoDefines(defineMap);
 
@@ -15,6 +15,8 @@
 #include <components/interpreter/opcodes.hpp>
 #include <components/interpreter/runtime.hpp>
 
+#include <components/lua/luastate.hpp>
+
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 
@@ -1756,6 +1758,33 @@ namespace MWScript
             }
         };
 
+        class OpLuaProfile : public Interpreter::Opcode0
+        {
+        public:
+            void execute(Interpreter::Runtime& runtime) override
+            {
+                if (!LuaUtil::LuaState::isProfilerEnabled())
+                {
+                    runtime.getContext().report("Lua profiler is disabled");
+                    return;
+                }
+                const auto filename = MWBase::Environment::get().getLuaManager()->exportProfile();
+                runtime.getContext().report("Wrote '" + Files::pathToUnicodeString(filename) + "'");
+            }
+        };
+
+        class OpReportMemory : public Interpreter::Opcode0
+        {
+        public:
+            void execute(Interpreter::Runtime& runtime) override
+            {
+                Resource::MemoryRegistry& registry
+                    = MWBase::Environment::get().getResourceSystem()->getMemoryRegistry();
+                registry.update();
+                runtime.getContext().report(Resource::formatMemoryUsage(registry.getSubsystems()));
+            }
+        };
+
         class OpTestModels : public Interpreter::Opcode0
         {
             template <class T>
@@ -1937,6 +1966,8 @@ namespace MWScript
             interpreter.installSegment5<OpHelp>(Compiler::Misc::opcodeHelp);
             interpreter.installSegment5<OpReloadLua>(Compiler::Misc::opcodeReloadLua);
             interpreter.installSegment5<OpTestModels>(Compiler::Misc::opcodeTestModels);
+            interpreter.installSegment5<OpLuaProfile>(Compiler::Misc::opcodeLuaProfile);
+            interpreter.installSegment5<OpReportMemory>(Compiler::Misc::opcodeReportMemory);
         }
     }
 }
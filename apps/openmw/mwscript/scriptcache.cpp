@@ -0,0 +1,187 @@
+#include "scriptcache.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/defs.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/version/version.hpp>
+
+namespace MWScript
+{
+    namespace
+    {
+        // Increase when the compiled code or the way it is stored changes in a way not covered by the engine version
+        constexpr int formatVersion = 1;
+
+        constexpr std::string_view localTypes = "slf";
+
+        template <class T>
+        void writeValues(ESM::ESMWriter& writer, ESM::NAME name, const std::vector<T>& values)
+        {
+            writer.startSubRecord(name);
+            for (const T& value : values)
+                writer.writeT(value);
+            writer.endRecord(name);
+        }
+
+        template <class T>
+        void readValues(ESM::ESMReader& reader, ESM::NAME name, std::vector<T>& values)
+        {
+            reader.getSubNameIs(name);
+            reader.getSubHeader();
+            const std::size_t size = reader.getSubSize();
+            if (size % sizeof(T) != 0)
+                reader.fail("Invalid size of compiled script data");
+            values.resize(size / sizeof(T));
+            reader.getExact(values.data(), size);
+        }
+
+        void writeEntry(ESM::ESMWriter& writer, const ScriptCache::Entry& entry)
+        {
+            writer.startRecord(ESM::REC_SCPT);
+            writer.writeHNRefId("NAME", entry.mId);
+            writer.writeHNT("HASH", entry.mSourceHash);
+            writeValues(writer, "INST", entry.mProgram.mInstructions);
+            writeValues(writer, "INTV", entry.mProgram.mIntegers);
+            writeValues(writer, "FLTV", entry.mProgram.mFloats);
+            for (const std::string& value : entry.mProgram.mStrings)
+                writer.writeHNString("STRV", value);
+            for (const char type : localTypes)
+                for (const std::string& name : entry.mLocals.get(type))
+                {
+                    writer.writeHNT("LTYP", type);
+                    writer.writeHNString("LNAM", name);
+                }
+            writer.endRecord(ESM::REC_SCPT);
+        }
+
+        ScriptCache::Entry readEntry(ESM::ESMReader& reader)
+        {
+            ScriptCache::Entry entry;
+            entry.mId = reader.getHNRefId("NAME");
+            reader.getHNT(entry.mSourceHash, "HASH");
+            readValues(reader, "INST", entry.mProgram.mInstructions);
+            readValues(reader, "INTV", entry.mProgram.mIntegers);
+            readValues(reader, "FLTV", entry.mProgram.mFloats);
+            while (reader.isNextSub("STRV"))
+                entry.mProgram.mStrings.push_back(reader.getHString());
+            while (reader.isNextSub("LTYP"))
+            {
+                char type = 0;
+                reader.getHT(type);
+                if (localTypes.find(type) == std::string_view::npos)
+                    reader.fail("Invalid local variable type");
+                entry.mLocals.declare(type, reader.getHNString("LNAM"));
+            }
+            return entry;
+        }
+    }
+
+    ScriptCache::ScriptCache(std::filesystem::path path)
+        : mPath(std::move(path))
+    {
+    }
+
+    std::string ScriptCache::makeKey(std::string_view contentKey, int warningsMode)
+    {
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << Version::getVersion() << ' ' << Version::getCommitHash() << ' '
+                   << warningsMode << ' ' << contentKey;
+
+        std::istringstream stream(descriptor.str());
+        const Hash hash = Files::getHash("script cache key", stream);
+
+        std::ostringstream result;
+        result << std::hex << std::setfill('0');
+        for (const std::uint64_t value : hash)
+            result << std::setw(16) << value;
+        return result.str();
+    }
+
+    ScriptCache::Hash ScriptCache::getSourceHash(std::string_view source)
+    {
+        std::istringstream stream{ std::string(source) };
+        return Files::getHash("script", stream);
+    }
+
+    std::vector<ScriptCache::Entry> ScriptCache::read(const std::string& key) const
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(mPath, ec))
+            return {};
+
+        try
+        {
+            ESM::ESMReader reader;
+            reader.open(mPath);
+            if (reader.getDesc() != key)
+            {
+                Log(Debug::Info) << "Script cache " << mPath << " doesn't match the content files";
+                return {};
+            }
+
+            std::vector<Entry> result;
+            while (reader.hasMoreRecs())
+            {
+                const ESM::NAME name = reader.getRecName();
+                reader.getRecHeader();
+                if (name != ESM::REC_SCPT)
+                    reader.fail("Unexpected record in script cache");
+                result.push_back(readEntry(reader));
+            }
+
+            Log(Debug::Info) << "Loaded " << result.size() << " compiled scripts from script cache " << mPath;
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read script cache " << mPath << ": " << e.what();
+            return {};
+        }
+    }
+
+    void ScriptCache::write(const std::string& key, std::span<const Entry> entries) const
+    {
+        // Write to a temporary file first so a failure never leaves a partially written cache
+        std::filesystem::path temporary = mPath;
+        temporary += ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mPath.parent_path());
+
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                ESM::ESMWriter writer;
+                writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+                writer.setAuthor("OpenMW");
+                writer.setDescription(key);
+                writer.save(stream);
+                for (const Entry& entry : entries)
+                    writeEntry(writer, entry);
+                writer.close();
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+
+            std::filesystem::rename(temporary, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write script cache " << mPath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+}
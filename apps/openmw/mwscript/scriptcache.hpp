@@ -0,0 +1,53 @@
+#ifndef OPENMW_APPS_OPENMW_MWSCRIPT_SCRIPTCACHE_H
+#define OPENMW_APPS_OPENMW_MWSCRIPT_SCRIPTCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <components/compiler/locals.hpp>
+#include <components/esm/refid.hpp>
+#include <components/interpreter/program.hpp>
+
+namespace MWScript
+{
+    /// @brief Programs of successfully compiled scripts kept on disk between runs.
+    /// @par The cache is a single ESM3 file with the key written as the header description. Compiling a script
+    /// depends on records of other content files, so the key covers the content files, the engine version and the
+    /// warnings mode. Each script is stored with a hash of its source.
+    class ScriptCache
+    {
+    public:
+        using Hash = std::array<std::uint64_t, 2>;
+
+        struct Entry
+        {
+            ESM::RefId mId;
+            Hash mSourceHash;
+            Interpreter::Program mProgram;
+            Compiler::Locals mLocals;
+        };
+
+        explicit ScriptCache(std::filesystem::path path);
+
+        /// @param contentKey identifies the content files in load order, see MWWorld::ContentCache::makeKey
+        static std::string makeKey(std::string_view contentKey, int warningsMode);
+
+        static Hash getSourceHash(std::string_view source);
+
+        /// @return cached scripts, nothing if there is no cache with the key or it can't be read
+        std::vector<Entry> read(const std::string& key) const;
+
+        /// Replace the cache by the given scripts, failures are only logged.
+        void write(const std::string& key, std::span<const Entry> entries) const;
+
+    private:
+        std::filesystem::path mPath;
+    };
+}
+
+#endif
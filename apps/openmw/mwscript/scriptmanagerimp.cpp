@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <iomanip>
 #include <sstream>
+#include <vector>
 
 #include <components/debug/debuglog.hpp>
 
@@ -30,6 +32,7 @@ namespace MWScript
         , mCompilerContext(compilerContext)
         , mParser(mErrorHandler, mCompilerContext)
         , mGlobalScripts(store)
+        , mWarningsMode(warningsMode)
     {
         installOpcodes(mInterpreter);
 
@@ -76,6 +79,7 @@ namespace MWScript
             if (success)
             {
                 mScripts.emplace(name, CompiledScript(mParser.getProgram(), mParser.getLocals()));
+                mCacheModified = true;
 
                 return true;
             }
@@ -107,20 +111,31 @@ namespace MWScript
         if (!iter->second.mProgram.mInstructions.empty()
             && iter->second.mInactive.find(target) == iter->second.mInactive.end())
         {
+            CompiledScript& script = iter->second;
+            const auto start = std::chrono::steady_clock::now();
+            const auto updateStats = [&] {
+                const auto time = std::chrono::steady_clock::now() - start;
+                ++script.mRunCount;
+                script.mRunTime += time;
+                script.mMaxRunTime = std::max(script.mMaxRunTime, time);
+            };
             try
             {
-                mInterpreter.run(iter->second.mProgram, interpreterContext);
+                mInterpreter.run(script.mProgram, interpreterContext);
+                updateStats();
                 return true;
             }
             catch (const MissingImplicitRefError& e)
             {
+                updateStats();
                 Log(Debug::Error) << "Execution of script " << name << " failed: " << e.what();
             }
             catch (const std::exception& e)
             {
+                updateStats();
                 Log(Debug::Error) << "Execution of script " << name << " failed: " << e.what();
 
-                iter->second.mInactive.insert(target); // don't execute again.
+                script.mInactive.insert(target); // don't execute again.
             }
         }
         return false;
@@ -131,6 +146,9 @@ namespace MWScript
         for (auto& script : mScripts)
         {
             script.second.mInactive.clear();
+            script.second.mRunCount = 0;
+            script.second.mRunTime = {};
+            script.second.mMaxRunTime = {};
         }
 
         mGlobalScripts.clear();
@@ -145,6 +163,13 @@ namespace MWScript
         {
             ++count;
 
+            // Cached scripts compiled successfully with the same content
+            if (const auto it = mScripts.find(script.mId); it != mScripts.end() && it->second.mCached)
+            {
+                ++success;
+                continue;
+            }
+
             if (compile(script.mId))
                 ++success;
         }
@@ -209,4 +234,95 @@ namespace MWScript
     {
         return *mCompilerContext.getExtensions();
     }
+
+    std::string ScriptManager::formatExecutionStats() const
+    {
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        using Microseconds = std::chrono::duration<double, std::micro>;
+
+        std::vector<std::pair<const ESM::RefId*, const CompiledScript*>> scripts;
+        std::chrono::steady_clock::duration total{};
+        for (const auto& [name, script] : mScripts)
+        {
+            if (script.mRunCount == 0)
+                continue;
+            scripts.emplace_back(&name, &script);
+            total += script.mRunTime;
+        }
+        std::sort(scripts.begin(), scripts.end(),
+            [](const auto& l, const auto& r) { return l.second->mRunTime > r.second->mRunTime; });
+
+        constexpr int valueW = 12;
+
+        std::stringstream out;
+        out << std::fixed << std::setprecision(1);
+        out << "Total time in MWScript: " << Milliseconds(total).count() << " ms in " << scripts.size()
+            << " scripts\n\n";
+        out << "Legend\n";
+        out << "  runs:       Number of times the script has run;\n";
+        out << "  total:      Time spent in the script, in milliseconds;\n";
+        out << "  average:    Average time of a single run, in microseconds;\n";
+        out << "  max:        Longest single run, in microseconds.\n\n";
+
+        out << std::right << std::setw(valueW) << "runs" << std::setw(valueW) << "total" << std::setw(valueW)
+            << "average" << std::setw(valueW) << "max"
+            << "  script\n";
+        for (const auto& [name, script] : scripts)
+        {
+            out << std::setw(valueW) << script->mRunCount << std::setw(valueW)
+                << Milliseconds(script->mRunTime).count() << std::setw(valueW)
+                << Microseconds(script->mRunTime).count() / script->mRunCount << std::setw(valueW)
+                << Microseconds(script->mMaxRunTime).count() << "  " << name->toString() << "\n";
+        }
+
+        return out.str();
+    }
+
+    void ScriptManager::readCache(const std::filesystem::path& path, std::string_view contentKey)
+    {
+        mCache.emplace(path);
+        mCacheKey = ScriptCache::makeKey(contentKey, mWarningsMode);
+
+        std::size_t outdated = 0;
+        for (ScriptCache::Entry& entry : mCache->read(mCacheKey))
+        {
+            const ESM::Script* script = mStore.get<ESM::Script>().search(entry.mId);
+            if (script == nullptr || ScriptCache::getSourceHash(script->mScriptText) != entry.mSourceHash)
+            {
+                ++outdated;
+                continue;
+            }
+            CompiledScript compiled(std::move(entry.mProgram), entry.mLocals);
+            compiled.mCached = true;
+            mScripts.insert_or_assign(entry.mId, std::move(compiled));
+        }
+
+        if (outdated > 0)
+        {
+            Log(Debug::Info) << "Ignored " << outdated << " outdated scripts from script cache";
+            mCacheModified = true;
+        }
+    }
+
+    void ScriptManager::writeCache()
+    {
+        if (!mCache.has_value() || !mCacheModified)
+            return;
+
+        std::vector<ScriptCache::Entry> entries;
+        for (const auto& [id, compiled] : mScripts)
+        {
+            // Failed scripts are compiled again to report the errors
+            if (compiled.mProgram.mInstructions.empty())
+                continue;
+            const ESM::Script* script = mStore.get<ESM::Script>().search(id);
+            if (script == nullptr)
+                continue;
+            entries.push_back(ScriptCache::Entry{
+                id, ScriptCache::getSourceHash(script->mScriptText), compiled.mProgram, compiled.mLocals });
+        }
+
+        mCache->write(mCacheKey, entries);
+        mCacheModified = false;
+    }
 }
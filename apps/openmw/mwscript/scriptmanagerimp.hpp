@@ -1,9 +1,13 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <chrono>
+#include <filesystem>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 
 #include <components/compiler/fileparser.hpp>
 #include <components/compiler/streamerrorhandler.hpp>
@@ -16,6 +20,7 @@
 #include "../mwbase/scriptmanager.hpp"
 
 #include "globalscripts.hpp"
+#include "scriptcache.hpp"
 
 namespace MWWorld
 {
@@ -48,6 +53,10 @@ namespace MWScript
             Interpreter::Program mProgram;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
+            bool mCached = false;
+            std::size_t mRunCount = 0;
+            std::chrono::steady_clock::duration mRunTime{};
+            std::chrono::steady_clock::duration mMaxRunTime{};
 
             explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
                 : mProgram(std::move(program))
@@ -59,6 +68,10 @@ namespace MWScript
         std::unordered_map<ESM::RefId, CompiledScript> mScripts;
         GlobalScripts mGlobalScripts;
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
+        int mWarningsMode;
+        std::optional<ScriptCache> mCache;
+        std::string mCacheKey;
+        bool mCacheModified = false;
 
     public:
         ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode);
@@ -82,6 +95,15 @@ namespace MWScript
         GlobalScripts& getGlobalScripts() override;
 
         const Compiler::Extensions& getExtensions() const override;
+
+        std::string formatExecutionStats() const override;
+
+        /// Add compiled scripts from the cache, scripts changed since they were cached are compiled again.
+        /// @param contentKey identifies the content files, see MWWorld::ContentCache::makeKey
+        void readCache(const std::filesystem::path& path, std::string_view contentKey);
+
+        /// Store all successfully compiled scripts if any was compiled since the cache was read.
+        void writeCache();
     };
 }
 
@@ -2,8 +2,10 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string_view>
 #include <thread>
@@ -979,6 +981,7 @@ namespace MWSound
         for (ALuint source : mFreeSources)
             alDeleteSources(1, &source);
         mFreeSources.clear();
+        mVirtualSounds.clear();
 
         if (mEffectSlot)
             alDeleteAuxiliaryEffectSlots(1, &mEffectSlot);
@@ -1031,41 +1034,50 @@ namespace MWSound
 
     std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
     {
-        getALError();
-
-        std::vector<char> data;
-        ALenum format = AL_NONE;
-        int srate = 0;
+        DecodedSound sound;
 
         try
         {
             DecoderPtr decoder = mManager.getDecoder();
             decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder->mResourceMgr));
 
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
+            decoder->getInfo(&sound.mSampleRate, &sound.mChannels, &sound.mType);
+            if (getALFormat(sound.mChannels, sound.mType))
+                decoder->readAll(sound.mData);
         }
         catch (std::exception& e)
         {
             Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
         }
 
-        if (data.empty())
+        return loadSound(sound);
+    }
+
+    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(const DecodedSound& sound)
+    {
+        getALError();
+
+        ALenum format = AL_NONE;
+        if (!sound.mData.empty())
+            format = getALFormat(sound.mChannels, sound.mType);
+
+        const char* data = sound.mData.data();
+        std::size_t dataSize = sound.mData.size();
+        int srate = sound.mSampleRate;
+        static const std::vector<char> silence(8000, -128);
+        if (format == AL_NONE)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            data = silence.data();
+            dataSize = silence.size();
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), data.size(), srate);
+        alBufferData(buf, format, data, dataSize, srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1083,6 +1095,8 @@ namespace MWSound
         if (!buffer)
             return 0;
 
+        std::erase_if(mVirtualSounds, [&](const VirtualSound& sound) { return sound.mBuffer == data; });
+
         // Make sure no sources are playing this buffer before unloading it.
         SoundVec::const_iterator iter = mActiveSounds.begin();
         for (; iter != mActiveSounds.end(); ++iter)
@@ -1202,35 +1216,18 @@ namespace MWSound
 
     bool OpenALOutput::playSound(Sound* sound, Sound_Handle data, float offset)
     {
-        ALuint source;
-
-        if (mFreeSources.empty())
+        // Sounds without a position are never made virtual, any 3D sound may give its source to them
+        if (!takeSource(std::numeric_limits<float>::infinity()))
         {
             Log(Debug::Warning) << "No free sources!";
             return false;
         }
-        source = mFreeSources.front();
+        ALuint source = mFreeSources.front();
 
         initCommon2D(source, sound->getPosition(), sound->getRealVolume(), getTimeScaledPitch(sound),
             sound->getIsLooping(), sound->getUseEnv());
-        alSourcei(source, AL_BUFFER, GET_PTRID(data));
-        alSourcef(source, AL_SEC_OFFSET, offset);
-        if (getALError() != AL_NO_ERROR)
-        {
-            alSourceRewind(source);
-            alSourcei(source, AL_BUFFER, 0);
-            alGetError();
+        if (!startSource(source, data, offset))
             return false;
-        }
-
-        alSourcePlay(source);
-        if (getALError() != AL_NO_ERROR)
-        {
-            alSourceRewind(source);
-            alSourcei(source, AL_BUFFER, 0);
-            alGetError();
-            return false;
-        }
 
         mFreeSources.pop_front();
         sound->mHandle = MAKE_PTRID(source);
@@ -1241,18 +1238,41 @@ namespace MWSound
 
     bool OpenALOutput::playSound3D(Sound* sound, Sound_Handle data, float offset)
     {
-        ALuint source;
+        const float audibility = getAudibility(*sound);
+        if (audibility < sMinAudibility)
+        {
+            mVirtualSounds.push_back(makeVirtualSound(sound, data, offset));
+            return true;
+        }
 
-        if (mFreeSources.empty())
+        if (!takeSource(audibility))
         {
             Log(Debug::Warning) << "No free sources!";
             return false;
         }
-        source = mFreeSources.front();
+
+        return playSource3D(sound, data, offset);
+    }
+
+    bool OpenALOutput::playSource3D(Sound* sound, Sound_Handle data, float offset)
+    {
+        ALuint source = mFreeSources.front();
 
         initCommon3D(source, sound->getPosition(), sound->getVelocity(), sound->getMinDistance(),
             sound->getMaxDistance(), sound->getRealVolume(), getTimeScaledPitch(sound), sound->getIsLooping(),
             sound->getUseEnv());
+        if (!startSource(source, data, offset))
+            return false;
+
+        mFreeSources.pop_front();
+        sound->mHandle = MAKE_PTRID(source);
+        mActiveSounds.push_back(sound);
+
+        return true;
+    }
+
+    bool OpenALOutput::startSource(ALuint source, Sound_Handle data, float offset)
+    {
         alSourcei(source, AL_BUFFER, GET_PTRID(data));
         alSourcef(source, AL_SEC_OFFSET, offset);
         if (getALError() != AL_NO_ERROR)
@@ -1272,17 +1292,18 @@ namespace MWSound
             return false;
         }
 
-        mFreeSources.pop_front();
-        sound->mHandle = MAKE_PTRID(source);
-        mActiveSounds.push_back(sound);
-
         return true;
     }
 
     void OpenALOutput::finishSound(Sound* sound)
     {
         if (!sound->mHandle)
+        {
+            const auto it = findVirtualSound(sound);
+            if (it != mVirtualSounds.end())
+                mVirtualSounds.erase(it);
             return;
+        }
         ALuint source = GET_PTRID(sound->mHandle);
         sound->mHandle = nullptr;
 
@@ -1299,7 +1320,10 @@ namespace MWSound
     bool OpenALOutput::isSoundPlaying(Sound* sound)
     {
         if (!sound->mHandle)
-            return false;
+        {
+            const auto it = findVirtualSound(sound);
+            return it != mVirtualSounds.end() && (sound->getIsLooping() || getOffset(*it) < it->mDuration);
+        }
         ALuint source = GET_PTRID(sound->mHandle);
         ALint state = AL_STOPPED;
 
@@ -1309,6 +1333,151 @@ namespace MWSound
         return state == AL_PLAYING || state == AL_PAUSED;
     }
 
+    float OpenALOutput::getAudibility(const Sound& sound) const
+    {
+        if (!sound.getIs3D())
+            return std::numeric_limits<float>::infinity();
+
+        const float distance = (sound.getPosition() - mListenerPos).length();
+        if (distance > sound.getMaxDistance())
+            return 0.0f;
+
+        // Gain of the inverse distance clamped model with the rolloff factor used for all 3D sources
+        return sound.getRealVolume() * sound.getMinDistance() / std::max(distance, sound.getMinDistance());
+    }
+
+    bool OpenALOutput::takeSource(float audibility)
+    {
+        if (!mFreeSources.empty())
+            return true;
+
+        // The least audible 3D sound goes on silently, if it is less audible than the one needing the source
+        Sound* weakest = nullptr;
+        float weakestAudibility = audibility;
+        for (Sound* sound : mActiveSounds)
+        {
+            const float value = getAudibility(*sound);
+            if (value < weakestAudibility)
+            {
+                weakest = sound;
+                weakestAudibility = value;
+            }
+        }
+
+        if (weakest == nullptr)
+            return false;
+
+        makeVirtual(weakest);
+        return !mFreeSources.empty();
+    }
+
+    void OpenALOutput::makeVirtual(Sound* sound)
+    {
+        const ALuint source = GET_PTRID(sound->mHandle);
+        ALint state = AL_STOPPED;
+        ALint buffer = 0;
+        ALfloat offset = 0.0f;
+        alGetSourcei(source, AL_SOURCE_STATE, &state);
+        alGetSourcei(source, AL_BUFFER, &buffer);
+        alGetSourcef(source, AL_SEC_OFFSET, &offset);
+        getALError();
+
+        finishSound(sound);
+
+        // A sound that has already ended is not tracked anymore and gets removed by the next update
+        if (state != AL_PLAYING && state != AL_PAUSED)
+            return;
+
+        VirtualSound& virtualSound = mVirtualSounds.emplace_back(makeVirtualSound(sound, MAKE_PTRID(buffer), offset));
+        virtualSound.mPaused = state == AL_PAUSED;
+    }
+
+    OpenALOutput::VirtualSound OpenALOutput::makeVirtualSound(Sound* sound, Sound_Handle data, float offset)
+    {
+        const ALuint buffer = GET_PTRID(data);
+        ALint size = 0;
+        ALint frequency = 0;
+        ALint channels = 1;
+        ALint bits = 8;
+        alGetBufferi(buffer, AL_SIZE, &size);
+        alGetBufferi(buffer, AL_FREQUENCY, &frequency);
+        alGetBufferi(buffer, AL_CHANNELS, &channels);
+        alGetBufferi(buffer, AL_BITS, &bits);
+        getALError();
+
+        const int frameSize = channels * bits / 8;
+        const float duration
+            = frequency > 0 && frameSize > 0 ? static_cast<float>(size / frameSize) / frequency : 0.0f;
+
+        return VirtualSound{
+            .mSound = sound,
+            .mBuffer = data,
+            .mOffset = offset,
+            .mStart = std::chrono::steady_clock::now(),
+            .mDuration = duration,
+            .mPaused = false,
+        };
+    }
+
+    std::vector<OpenALOutput::VirtualSound>::iterator OpenALOutput::findVirtualSound(const Sound* sound)
+    {
+        return std::find_if(mVirtualSounds.begin(), mVirtualSounds.end(),
+            [&](const VirtualSound& virtualSound) { return virtualSound.mSound == sound; });
+    }
+
+    float OpenALOutput::getOffset(const VirtualSound& sound)
+    {
+        if (sound.mPaused)
+            return sound.mOffset;
+        const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - sound.mStart;
+        return sound.mOffset + elapsed.count() * getTimeScaledPitch(sound.mSound);
+    }
+
+    void OpenALOutput::updateVirtualSounds()
+    {
+        // Sounds that can not be heard anymore give their sources back
+        for (std::size_t i = 0; i < mActiveSounds.size();)
+        {
+            if (getAudibility(*mActiveSounds[i]) < sMinAudibility)
+                makeVirtual(mActiveSounds[i]);
+            else
+                ++i;
+        }
+
+        if (mVirtualSounds.empty())
+            return;
+
+        std::vector<std::pair<float, Sound*>> audible;
+        for (const VirtualSound& sound : mVirtualSounds)
+        {
+            if (sound.mPaused || (!sound.mSound->getIsLooping() && getOffset(sound) >= sound.mDuration))
+                continue;
+            const float audibility = getAudibility(*sound.mSound);
+            if (audibility >= sMinAudibility)
+                audible.emplace_back(audibility, sound.mSound);
+        }
+
+        std::sort(audible.begin(), audible.end(), [](const auto& l, const auto& r) { return l.first > r.first; });
+
+        // The most audible ones resume where they would be now, a playing sound is made virtual again only when it is
+        // much less audible, so the ones of about the same audibility do not exchange their sources every frame
+        for (const auto& [audibility, sound] : audible)
+        {
+            if (!takeSource(audibility * 0.5f))
+                break;
+
+            const auto it = findVirtualSound(sound);
+            const VirtualSound virtualSound = *it;
+            mVirtualSounds.erase(it);
+
+            float offset = getOffset(virtualSound);
+            if (sound->getIsLooping() && virtualSound.mDuration > 0.0f)
+                offset = std::fmod(offset, virtualSound.mDuration);
+
+            playSource3D(sound, virtualSound.mBuffer, offset);
+        }
+    }
+
     void OpenALOutput::updateSound(Sound* sound)
     {
         if (!sound->mHandle)
@@ -1458,6 +1627,7 @@ namespace MWSound
 
     void OpenALOutput::finishUpdate()
     {
+        updateVirtualSounds();
         alcProcessContext(alcGetCurrentContext());
     }
 
@@ -1507,6 +1677,15 @@ namespace MWSound
 
     void OpenALOutput::pauseSounds(int types)
     {
+        for (VirtualSound& sound : mVirtualSounds)
+        {
+            if ((types & sound.mSound->getPlayType()) && !sound.mPaused)
+            {
+                sound.mOffset = getOffset(sound);
+                sound.mPaused = true;
+            }
+        }
+
         std::vector<ALuint> sources;
         for (Sound* sound : mActiveSounds)
         {
@@ -1562,6 +1741,15 @@ namespace MWSound
 
     void OpenALOutput::resumeSounds(int types)
     {
+        for (VirtualSound& sound : mVirtualSounds)
+        {
+            if ((types & sound.mSound->getPlayType()) && sound.mPaused)
+            {
+                sound.mStart = std::chrono::steady_clock::now();
+                sound.mPaused = false;
+            }
+        }
+
         std::vector<ALuint> sources;
         for (Sound* sound : mActiveSounds)
         {
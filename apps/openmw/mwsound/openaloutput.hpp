@@ -1,6 +1,7 @@
 #ifndef GAME_SOUND_OPENALOUTPUT_H
 #define GAME_SOUND_OPENALOUTPUT_H
 
+#include <chrono>
 #include <deque>
 #include <map>
 #include <mutex>
@@ -42,6 +43,23 @@ namespace MWSound
 
         typedef std::vector<Sound*> SoundVec;
         SoundVec mActiveSounds;
+
+        // A sound that is tracked without a source, because it can not be heard or the sources ran out
+        struct VirtualSound
+        {
+            Sound* mSound;
+            Sound_Handle mBuffer;
+            // Offset in seconds at mStart
+            float mOffset;
+            std::chrono::steady_clock::time_point mStart;
+            float mDuration;
+            bool mPaused;
+        };
+
+        // About -60 dB
+        static constexpr float sMinAudibility = 0.001f;
+
+        std::vector<VirtualSound> mVirtualSounds;
         typedef std::vector<Stream*> StreamVec;
         StreamVec mActiveStreams;
 
@@ -73,6 +91,21 @@ namespace MWSound
 
         float getTimeScaledPitch(SoundBase* sound);
 
+        /// @return Gain of the sound at the listener position, infinite for the sounds without a position.
+        float getAudibility(const Sound& sound) const;
+
+        /// Ensure there is a free source, taking it from a less audible 3D sound if needed.
+        bool takeSource(float audibility);
+
+        bool startSource(ALuint source, Sound_Handle data, float offset);
+        bool playSource3D(Sound* sound, Sound_Handle data, float offset);
+
+        void makeVirtual(Sound* sound);
+        VirtualSound makeVirtualSound(Sound* sound, Sound_Handle data, float offset);
+        std::vector<VirtualSound>::iterator findVirtualSound(const Sound* sound);
+        float getOffset(const VirtualSound& sound);
+        void updateVirtualSounds();
+
         OpenALOutput& operator=(const OpenALOutput& rhs);
         OpenALOutput(const OpenALOutput& rhs);
 
@@ -89,6 +122,7 @@ namespace MWSound
         std::vector<std::string> enumerateHrtf() override;
 
         std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override;
+        std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound* sound, Sound_Handle data, float offset) override;
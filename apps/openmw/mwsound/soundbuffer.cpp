@@ -43,6 +43,7 @@ namespace MWSound
         , mBufferCacheMax(Settings::sound().mBufferCacheMax * 1024 * 1024)
         , mBufferCacheMin(
               std::min(static_cast<std::size_t>(Settings::sound().mBufferCacheMin) * 1024 * 1024, mBufferCacheMax))
+        , mPreloadCacheMax(static_cast<std::size_t>(Settings::sound().mPreloadCacheMax) * 1024 * 1024)
     {
     }
 
@@ -80,12 +81,19 @@ namespace MWSound
         if (sfx->getHandle() != nullptr)
             return sfx;
 
-        auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+        const std::optional<DecodedSound> preloaded = takePreloaded(sfx->getResourceName());
+        auto [handle, size]
+            = preloaded.has_value() ? mOutput->loadSound(*preloaded) : mOutput->loadSound(sfx->getResourceName());
         if (handle == nullptr)
             return {};
 
         sfx->mHandle = handle;
 
+        {
+            const std::lock_guard lock(mPreloadedMutex);
+            mLoadedNames.insert(sfx->getResourceName());
+        }
+
         mBufferCacheSize += size;
         if (mBufferCacheSize > mBufferCacheMax)
         {
@@ -152,6 +160,63 @@ namespace MWSound
         mBufferFileNameMap.clear();
         mBufferNameMap.clear();
         mUnusedBuffers.clear();
+
+        const std::lock_guard lock(mPreloadedMutex);
+        mPreloaded.clear();
+        mPreloadedIndex.clear();
+        mLoadedNames.clear();
+        mPreloadedSize = 0;
+    }
+
+    void SoundBufferPool::preload(VFS::Path::NormalizedView fileName, SoundDecoder& decoder)
+    {
+        {
+            const std::lock_guard lock(mPreloadedMutex);
+            if (mPreloadCacheMax == 0 || mLoadedNames.contains(fileName) || mPreloadedIndex.contains(fileName))
+                return;
+        }
+
+        DecodedSound sound;
+        try
+        {
+            decoder.open(Misc::ResourceHelpers::correctSoundPath(fileName, *decoder.mResourceMgr));
+            decoder.getInfo(&sound.mSampleRate, &sound.mChannels, &sound.mType);
+            decoder.readAll(sound.mData);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to preload audio from " << fileName << ": " << e.what();
+            return;
+        }
+
+        const std::lock_guard lock(mPreloadedMutex);
+        if (sound.mData.size() > mPreloadCacheMax || mLoadedNames.contains(fileName)
+            || mPreloadedIndex.contains(fileName))
+            return;
+
+        mPreloadedSize += sound.mData.size();
+        mPreloaded.emplace_front(VFS::Path::Normalized(fileName), std::move(sound));
+        mPreloadedIndex.emplace(mPreloaded.front().first, mPreloaded.begin());
+
+        while (mPreloadedSize > mPreloadCacheMax)
+        {
+            mPreloadedSize -= mPreloaded.back().second.mData.size();
+            mPreloadedIndex.erase(mPreloaded.back().first);
+            mPreloaded.pop_back();
+        }
+    }
+
+    std::optional<DecodedSound> SoundBufferPool::takePreloaded(VFS::Path::NormalizedView fileName)
+    {
+        const std::lock_guard lock(mPreloadedMutex);
+        const auto it = mPreloadedIndex.find(fileName);
+        if (it == mPreloadedIndex.end())
+            return std::nullopt;
+        DecodedSound result = std::move(it->second->second);
+        mPreloadedSize -= result.mData.size();
+        mPreloaded.erase(it->second);
+        mPreloadedIndex.erase(it);
+        return result;
     }
 
     SoundBuffer* SoundBufferPool::insertSound(std::string_view fileName)
@@ -229,6 +294,11 @@ namespace MWSound
             mBufferCacheSize -= mOutput->unloadSound(unused->getHandle());
             unused->mHandle = nullptr;
 
+            {
+                const std::lock_guard lock(mPreloadedMutex);
+                mLoadedNames.erase(unused->getResourceName());
+            }
+
             mUnusedBuffers.pop_back();
         }
     }
@@ -3,11 +3,19 @@
 
 #include <algorithm>
 #include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include <components/esm/refid.hpp>
 
+#include "sounddecoder.hpp"
 #include "soundoutput.hpp"
 
 namespace ESM
@@ -105,9 +113,15 @@ namespace MWSound
 
         void clear();
 
+        /// Decode a sound file in advance, so loading it later only has to create the buffer of the output.
+        /// @note Unlike the rest of the pool, thread safe.
+        void preload(VFS::Path::NormalizedView fileName, SoundDecoder& decoder);
+
     private:
         SoundBuffer* loadSfx(SoundBuffer* sfx);
 
+        std::optional<DecodedSound> takePreloaded(VFS::Path::NormalizedView fileName);
+
         SoundOutput* mOutput;
         std::deque<SoundBuffer> mSoundBuffers;
         std::unordered_map<ESM::RefId, SoundBuffer*> mBufferNameMap;
@@ -118,6 +132,15 @@ namespace MWSound
         // NOTE: unused buffers are stored in front-newest order.
         std::deque<SoundBuffer*> mUnusedBuffers;
 
+        // Decoded sounds waiting for their buffer to be loaded, front-newest as well
+        std::mutex mPreloadedMutex;
+        std::list<std::pair<VFS::Path::Normalized, DecodedSound>> mPreloaded;
+        std::map<VFS::Path::Normalized, decltype(mPreloaded)::iterator, std::less<>> mPreloadedIndex;
+        // Resource names of the loaded buffers, so they are not decoded again
+        std::set<VFS::Path::Normalized, std::less<>> mLoadedNames;
+        std::size_t mPreloadedSize = 0;
+        std::size_t mPreloadCacheMax;
+
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM::Sound& sound);
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM4::Sound& sound);
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM4::SoundReference& sound);
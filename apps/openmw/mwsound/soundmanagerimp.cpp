@@ -8,6 +8,7 @@
 #include <osg/Matrixf>
 
 #include <components/debug/debuglog.hpp>
+#include <components/esm3/loadsoun.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/settings/values.hpp>
@@ -637,6 +638,20 @@ namespace MWSound
         return result;
     }
 
+    void SoundManager::preloadSound(const ESM::RefId& soundId)
+    {
+        if (!mOutput->isInitialized())
+            return;
+
+        // Only reads the records, unlike looking up the buffer of the sound
+        const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
+        if (sound == nullptr)
+            return;
+
+        mSoundBuffers.preload(
+            Misc::ResourceHelpers::correctSoundPath(VFS::Path::Normalized(sound->mSound)), *getDecoder());
+    }
+
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
@@ -242,6 +242,10 @@ namespace MWSound
         ///< Sound::setPosition.
         ///< @param offset Number of seconds into the sound to start playback.
 
+        void preloadSound(const ESM::RefId& soundId) override;
+        ///< Decode the sound in advance, so it does not have to be read when it is played for the first time.
+        /// \note Can be called from any thread.
+
         void stopSound(Sound* sound) override;
         ///< Stop the given sound from playing
         /// @note no-op if \a sound is null
@@ -14,6 +14,7 @@ namespace MWSound
 {
     class SoundManager;
     struct SoundDecoder;
+    struct DecodedSound;
     class Sound;
     class Stream;
 
@@ -41,6 +42,7 @@ namespace MWSound
         virtual std::vector<std::string> enumerateHrtf() = 0;
 
         virtual std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound* sound, Sound_Handle data, float offset) = 0;
@@ -1,6 +1,11 @@
 #include "statemanagerimp.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
 
 #include <SDL_clipboard.h>
 
@@ -15,6 +20,7 @@
 
 #include <components/loadinglistener/loadinglistener.hpp>
 
+#include <components/files/compressedfile.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/algorithm.hpp>
 #include <components/settings/values.hpp>
@@ -49,6 +55,59 @@
 
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    void writeSaveFile(const std::string& data, const std::filesystem::path& path, bool compress)
+    {
+        // Replace the existing file only once the new one is complete
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+
+        {
+            std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+            if (compress)
+                Files::writeCompressedFile(data, stream);
+            else
+                stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            stream.close();
+
+            if (stream.fail())
+            {
+                const std::string message = std::generic_category().message(errno);
+                std::error_code ec;
+                std::filesystem::remove(temporary, ec);
+                throw std::runtime_error("Write operation failed (file stream): " + message);
+            }
+        }
+
+        std::filesystem::rename(temporary, path);
+    }
+
+    constexpr std::string_view cellsFileExtension = ".omwcells";
+
+    std::filesystem::path makeCellsFilePath(const std::filesystem::path& directory)
+    {
+        std::filesystem::path result = directory / ("cells" + std::string(cellsFileExtension));
+        for (int i = 1; std::filesystem::exists(result); ++i)
+            result = directory / ("cells - " + std::to_string(i) + std::string(cellsFileExtension));
+        return result;
+    }
+
+    void initSaveWriter(ESM::ESMWriter& writer, const std::vector<std::string>& contentFiles)
+    {
+        for (const std::string& contentFile : contentFiles)
+            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
+
+        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+
+        // all unused
+        writer.setVersion(0);
+        writer.setType(0);
+        writer.setAuthor("");
+        writer.setDescription("");
+    }
+}
+
 void MWState::StateManager::cleanup(bool force)
 {
     if (mState != State_NoGame || force)
@@ -65,6 +124,8 @@ void MWState::StateManager::cleanup(bool force)
         mCharacterManager.setCurrentCharacter(nullptr);
         mTimePlayed = 0;
         mLastSavegame.clear();
+        mCellsFile.clear();
+        mCellsFileSaves = 0;
         MWMechanics::CreatureStats::cleanup();
 
         mState = State_NoGame;
@@ -107,6 +168,20 @@ MWState::StateManager::StateManager(const std::filesystem::path& saves, const st
 {
 }
 
+MWState::StateManager::~StateManager()
+{
+    if (!mSaveWriting.valid())
+        return;
+    try
+    {
+        mSaveWriting.get();
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Error) << "Failed to save game: " << e.what();
+    }
+}
+
 void MWState::StateManager::requestQuit()
 {
     mQuitRequest = true;
@@ -211,8 +286,80 @@ void MWState::StateManager::resumeGame()
     MWBase::Environment::get().getLuaManager()->gameLoaded();
 }
 
+void MWState::StateManager::finishSaveWriting(bool wait)
+{
+    if (!mSaveWriting.valid())
+        return;
+    if (!wait && mSaveWriting.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+    try
+    {
+        mSaveWriting.get();
+        if (mSaveWritingCharacter != nullptr)
+            removeUnusedCellsFiles(*mSaveWritingCharacter);
+    }
+    catch (const std::exception& e)
+    {
+        reportSaveError(e.what(), mSaveWritingCharacter, mSaveWritingPath);
+    }
+    mSaveWritingCharacter = nullptr;
+    mSaveWritingPath.clear();
+}
+
+void MWState::StateManager::reportSaveError(
+    std::string_view message, Character* character, const std::filesystem::path& path)
+{
+    std::stringstream error;
+    error << "Failed to save game: " << message;
+
+    Log(Debug::Error) << error.str();
+
+    // The cells file may be missing, so the next saved game has to write a new one
+    mCellsFile.clear();
+    MWBase::Environment::get().getWorld()->clearCellsFile();
+
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{Interface:OK}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+    // If no file was written, clean up the slot
+    if (character == nullptr || path.empty() || std::filesystem::exists(path))
+        return;
+    const auto slot
+        = std::find_if(character->begin(), character->end(), [&](const Slot& v) { return v.mPath == path; });
+    if (slot != character->end())
+    {
+        character->deleteSlot(&*slot);
+        character->cleanup();
+    }
+}
+
+void MWState::StateManager::removeUnusedCellsFiles(const Character& character, const Slot* ignored) const
+{
+    std::vector<std::string> used;
+    for (const Slot& slot : character)
+        if (&slot != ignored && !slot.mProfile.mCellsFile.empty())
+            used.push_back(slot.mProfile.mCellsFile);
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(character.getPath(), ec))
+    {
+        const std::filesystem::path& path = entry.path();
+        if (path.extension() != cellsFileExtension || path == mCellsFile)
+            continue;
+        const std::string name = Files::pathToUnicodeString(path.filename());
+        if (std::find(used.begin(), used.end(), name) != used.end())
+            continue;
+        Log(Debug::Info) << "Removing unused cells file " << path;
+        std::filesystem::remove(path, ec);
+    }
+}
+
 void MWState::StateManager::saveGame(std::string_view description, const Slot* slot)
 {
+    // Slots of the current character may change
+    finishSaveWriting(true);
+
     MWBase::Environment::get().getLuaManager()->applyDelayedActions();
 
     MWState::Character* character = getCurrentCharacter();
@@ -259,6 +406,28 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         profile.mCurrentHealth = stats.getHealth().getCurrent();
         profile.mMaximumHealth = stats.getHealth().getModified();
 
+        // With delta saves the state of all cells is written to a separate file shared by the following saved games,
+        // which store only the cells with a changed state
+        const int deltaSaves = Settings::saves().mDeltaSaves;
+        bool writeCellsFile = false;
+        if (deltaSaves == 0 || mCellsFile.parent_path() != character->getPath() || mCellsFileSaves > deltaSaves
+            || !std::filesystem::exists(mCellsFile))
+        {
+            world.clearCellsFile();
+            mCellsFile.clear();
+            mCellsFileSaves = 0;
+            if (deltaSaves > 0)
+            {
+                mCellsFile = makeCellsFilePath(character->getPath());
+                writeCellsFile = true;
+            }
+        }
+        if (!mCellsFile.empty())
+        {
+            profile.mCellsFile = Files::pathToUnicodeString(mCellsFile.filename());
+            ++mCellsFileSaves;
+        }
+
         Log(Debug::Info) << "Making a screenshot for saved game '" << description << "'";
         writeScreenshot(profile.mScreenshot);
 
@@ -272,22 +441,10 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
 
         Log(Debug::Info) << "Writing saved game '" << description << "' for character '" << profile.mPlayerName << "'";
 
-        // Write to a memory stream first. If there is an exception during the save process, we don't want to trash the
-        // existing save file we are overwriting.
-        std::stringstream stream;
-
+        // Write to memory first, it's written to the file in background. If there is an exception during the save
+        // process, we don't want to trash the existing save file we are overwriting.
         ESM::ESMWriter writer;
-
-        for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
-            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
-
-        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
-
-        // all unused
-        writer.setVersion(0);
-        writer.setType(0);
-        writer.setAuthor("");
-        writer.setDescription("");
+        initSaveWriter(writer, world.getContentFiles());
 
         int recordCount = 1 // saved game header
             + MWBase::Environment::get().getJournal()->countSavedGameRecords()
@@ -300,15 +457,28 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
             + MWBase::Environment::get().getWindowManager()->countSavedGameRecords();
         writer.setRecordCount(recordCount);
 
-        writer.save(stream);
+        writer.save();
 
         Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         // Using only Cells for progress information, since they typically have the largest records by far
-        listener.setProgressRange(MWBase::Environment::get().getWorld()->countSavedGameCells());
+        const int cellCount = MWBase::Environment::get().getWorld()->countSavedGameCells();
+        listener.setProgressRange(writeCellsFile ? 2 * cellCount : cellCount);
         listener.setLabel("#{OMWEngine:SavingInProgress}", true);
 
         Loading::ScopedLoad load(&listener);
 
+        std::string cellsFileData;
+        if (writeCellsFile)
+        {
+            ESM::ESMWriter cellsWriter;
+            initSaveWriter(cellsWriter, world.getContentFiles());
+            cellsWriter.setRecordCount(cellCount);
+            cellsWriter.save();
+            world.writeCellsFile(cellsWriter, listener);
+            cellsWriter.close();
+            cellsFileData = cellsWriter.takeData();
+        }
+
         writer.startRecord(ESM::REC_SAVE);
         slot->mProfile.save(writer);
         writer.endRecord(ESM::REC_SAVE);
@@ -324,23 +494,27 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         MWBase::Environment::get().getInputManager()->write(writer, listener);
         MWBase::Environment::get().getWindowManager()->write(writer, listener);
 
-        // Ensure we have written the number of records that was estimated
-        if (writer.getRecordCount() != recordCount + 1) // 1 extra for TES3 record
+        // Ensure we have written the number of records that was estimated (1 extra for TES3 record). Unchanged cells are
+        // not written when there is a cells file.
+        const int writtenRecords = writer.getRecordCount();
+        if (mCellsFile.empty() ? writtenRecords != recordCount + 1 : writtenRecords > recordCount + 1)
             Log(Debug::Warning) << "Warning: number of written savegame records does not match. Estimated: "
-                                << recordCount + 1 << ", written: " << writer.getRecordCount();
+                                << recordCount + 1 << ", written: " << writtenRecords;
 
         writer.close();
 
-        if (stream.fail())
-            throw std::runtime_error(
-                "Write operation failed (memory stream): " + std::generic_category().message(errno));
-
         // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream): " + std::generic_category().message(errno));
+        mSaveWriting = std::async(std::launch::async,
+            [data = writer.takeData(), path = slot->mPath, cellsFileData = std::move(cellsFileData),
+                cellsFile = writeCellsFile ? mCellsFile : std::filesystem::path(),
+                compress = Settings::saves().mCompress.get()] {
+                // The saved game can't be loaded without its cells file
+                if (!cellsFile.empty())
+                    writeSaveFile(cellsFileData, cellsFile, compress);
+                writeSaveFile(data, path, compress);
+            });
+        mSaveWritingCharacter = character;
+        mSaveWritingPath = slot->mPath;
 
         Settings::saves().mCharacter.set(Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
         mLastSavegame = slot->mPath;
@@ -353,21 +527,7 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
-
-        Log(Debug::Error) << error.str();
-
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{Interface:OK}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
-
-        // If no file was written, clean up the slot
-        if (character && slot && !std::filesystem::exists(slot->mPath))
-        {
-            character->deleteSlot(slot);
-            character->cleanup();
-        }
+        reportSaveError(e.what(), character, slot != nullptr ? slot->mPath : std::filesystem::path());
     }
 }
 
@@ -451,8 +611,39 @@ struct SaveVersionTooNewError : SaveFormatVersionError
     }
 };
 
+void MWState::StateManager::loadCellsFile(const std::filesystem::path& path)
+{
+    if (!std::filesystem::exists(path))
+        throw std::runtime_error("Cells file " + Files::pathToUnicodeString(path) + " is missing");
+
+    Log(Debug::Info) << "Reading cells file " << path.filename();
+
+    ESM::ESMReader reader;
+    reader.open(path);
+
+    const ESM::FormatVersion version = reader.getFormatVersion();
+    if (version > ESM::CurrentSaveGameFormatVersion)
+        throw SaveVersionTooNewError(version);
+
+    std::map<int, int> contentFileMap = buildContentFileIndexMap(reader);
+    reader.setContentFileMapping(&contentFileMap);
+
+    while (reader.hasMoreRecs())
+    {
+        const ESM::NAME n = reader.getRecName();
+        reader.getRecHeader();
+
+        if (n.toInt() == ESM::REC_CSTA)
+            MWBase::Environment::get().getWorld()->readRecord(reader, n.toInt());
+        else
+            reader.skipRecord();
+    }
+}
+
 void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
 {
+    finishSaveWriting(true);
+
     try
     {
         cleanup();
@@ -480,6 +671,7 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
         Loading::ScopedLoad load(&listener);
 
         bool firstPersonCam = false;
+        std::filesystem::path cellsFile;
 
         size_t total = reader.getFileSize();
         int currentPercent = 0;
@@ -488,6 +680,13 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
             ESM::NAME n = reader.getRecName();
             reader.getRecHeader();
 
+            // Cells of the saved game take precedence, all of them need to be read before the player
+            if (n.toInt() == ESM::REC_PLAY && !cellsFile.empty())
+            {
+                loadCellsFile(cellsFile);
+                cellsFile.clear();
+            }
+
             switch (n.toInt())
             {
                 case ESM::REC_SAVE:
@@ -503,6 +702,8 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
                         return;
                     }
                     mTimePlayed = profile.mTimePlayed;
+                    if (!profile.mCellsFile.empty())
+                        cellsFile = filepath.parent_path() / Files::pathFromUnicodeString(profile.mCellsFile);
                     Log(Debug::Info) << "Loading saved game '" << profile.mDescription << "' for character '"
                                      << profile.mPlayerName << "'";
                 }
@@ -593,6 +794,9 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
             }
         }
 
+        if (!cellsFile.empty())
+            loadCellsFile(cellsFile);
+
         mCharacterManager.setCurrentCharacter(character);
 
         mState = State_Running;
@@ -706,6 +910,16 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    finishSaveWriting(true);
+
+    // Remove the cells file used only by this saved game before the directory is removed with the last one
+    if (std::next(character->begin()) == character->end() && mCellsFile.parent_path() == character->getPath())
+    {
+        mCellsFile.clear();
+        MWBase::Environment::get().getWorld()->clearCellsFile();
+    }
+    removeUnusedCellsFiles(*character, slot);
+
     const std::filesystem::path savePath = slot->mPath;
     mCharacterManager.deleteSlot(slot, character);
     if (mLastSavegame == savePath)
@@ -736,6 +950,8 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    finishSaveWriting(false);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
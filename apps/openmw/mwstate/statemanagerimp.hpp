@@ -2,6 +2,7 @@
 #define GAME_STATE_STATEMANAGER_H
 
 #include <filesystem>
+#include <future>
 #include <map>
 
 #include "../mwbase/statemanager.hpp"
@@ -20,10 +21,27 @@ namespace MWState
         CharacterManager mCharacterManager;
         double mTimePlayed;
         std::filesystem::path mLastSavegame;
+        // Saved game being written to disk in background
+        std::future<void> mSaveWriting;
+        Character* mSaveWritingCharacter = nullptr;
+        std::filesystem::path mSaveWritingPath;
+        // File with the state of all cells used by the saved games written since
+        std::filesystem::path mCellsFile;
+        int mCellsFileSaves = 0;
 
     private:
         void cleanup(bool force = false);
 
+        /// Report the result of writing a saved game in background, if it's done or when \a wait is true.
+        void finishSaveWriting(bool wait);
+
+        void reportSaveError(std::string_view message, Character* character, const std::filesystem::path& path);
+
+        /// Remove the cells files in the character directory which are not used by its saved games except \a ignored.
+        void removeUnusedCellsFiles(const Character& character, const Slot* ignored = nullptr) const;
+
+        void loadCellsFile(const std::filesystem::path& path);
+
         void printSavegameFormatError(const std::string& exceptionText, const std::string& messageBoxText);
 
         bool confirmLoading(const std::vector<std::string_view>& missingFiles) const;
@@ -35,6 +53,8 @@ namespace MWState
     public:
         StateManager(const std::filesystem::path& saves, const std::vector<std::string>& contentFiles);
 
+        ~StateManager() override;
+
         void requestQuit() override;
 
         bool hasQuitRequest() const override;
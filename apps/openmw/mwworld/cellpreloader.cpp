@@ -3,12 +3,15 @@
 #include <algorithm>
 #include <atomic>
 #include <limits>
+#include <mutex>
 #include <span>
 
 #include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/pathhelpers.hpp>
@@ -21,8 +24,12 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/view.hpp>
 #include <components/terrain/world.hpp>
+#include <components/toutf8/toutf8.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/soundmanager.hpp"
+
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
@@ -50,16 +57,18 @@ namespace MWWorld
         }
     }
 
-    struct ListModelsVisitor
+    struct ListResourcesVisitor
     {
         bool operator()(const MWWorld::ConstPtr& ptr)
         {
-            ptr.getClass().getModelsToPreload(ptr, mOut);
+            ptr.getClass().getModelsToPreload(ptr, mModels);
+            ptr.getClass().getSoundsToPreload(ptr, mSounds);
 
             return true;
         }
 
-        std::vector<std::string_view>& mOut;
+        std::vector<std::string_view>& mModels;
+        std::vector<ESM::RefId>& mSounds;
     };
 
     /// Worker thread item: preload models in a cell.
@@ -69,7 +78,8 @@ namespace MWWorld
         /// Constructor to be called from the main thread.
         explicit PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager,
             Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager,
-            Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
+            Terrain::World* terrain, MWRender::LandManager* landManager, SceneUtil::WorkQueue* workQueue,
+            bool preloadInstances)
             : mIsExterior(cell->getCell()->isExterior())
             , mCellLocation(cell->getCell()->getExteriorCellLocation())
             , mCellId(cell->getCell()->getId())
@@ -78,13 +88,17 @@ namespace MWWorld
             , mKeyframeManager(keyframeManager)
             , mTerrain(terrain)
             , mLandManager(landManager)
+            , mWorkQueue(workQueue)
             , mPreloadInstances(preloadInstances)
             , mAbort(false)
         {
             mTerrainView = mTerrain->createView();
 
-            ListModelsVisitor visitor{ mMeshes };
+            ListResourcesVisitor visitor{ mMeshes, mSounds };
             cell->forEachConst(visitor);
+
+            std::sort(mSounds.begin(), mSounds.end());
+            mSounds.erase(std::unique(mSounds.begin(), mSounds.end()), mSounds.end());
         }
 
         void abort() override { mAbort = true; }
@@ -92,12 +106,18 @@ namespace MWWorld
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
+            OPENMW_TRACE_SCOPE("Preload Cell");
+
             if (mIsExterior)
             {
                 try
                 {
                     mTerrain->cacheCell(mTerrainView.get(), mCellLocation.mX, mCellLocation.mY);
-                    mPreloadedObjects.insert(mLandManager->getLand(mCellLocation));
+                    const osg::ref_ptr<ESMTerrain::LandObject> land = mLandManager->getLand(mCellLocation);
+                    // Heights are used for the physics heightfield once the cell is loaded
+                    if (land != nullptr)
+                        land->getData(ESM::Land::DATA_VHGT);
+                    mPreloadedObjects.insert(land);
                 }
                 catch (const std::exception& e)
                 {
@@ -106,54 +126,95 @@ namespace MWWorld
                 }
             }
 
-            VFS::Path::Normalized mesh;
-            VFS::Path::Normalized kfname;
+            const VFS::Manager& vfs = *mSceneManager->getVFS();
+            std::vector<VFS::Path::Normalized> meshes;
+            std::vector<VFS::Path::Normalized> files;
+            meshes.reserve(mMeshes.size());
             for (std::string_view path : mMeshes)
+            {
+                VFS::Path::Normalized mesh = Misc::ResourceHelpers::correctMeshPath(VFS::Path::Normalized(path));
+                mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
+                if (!vfs.exists(mesh))
+                    continue;
+                if (Misc::getFileName(mesh).starts_with('x') && Misc::getFileExtension(mesh) == "nif")
+                {
+                    VFS::Path::Normalized kfname = mesh;
+                    kfname.changeExtension("kf");
+                    files.push_back(std::move(kfname));
+                }
+                files.push_back(mesh);
+                meshes.push_back(std::move(mesh));
+            }
+
+            // Read the files in archive order in one pass instead of seeking back and forth from the worker threads
+            if (!mAbort)
+                vfs.prefetch(files);
+
+            // Models of a cell are independent, so load them on idle worker threads too, archive reads and
+            // decompression dominate the time spent here
+            const std::size_t helpers = mWorkQueue->getNumThreads() > 0 ? mWorkQueue->getNumThreads() - 1 : 0;
+            SceneUtil::parallelFor(
+                *mWorkQueue, meshes.size(), helpers, [&](std::size_t i) { preloadMesh(meshes[i]); });
+
+            // Ambient loops and creature sounds would otherwise be decoded when they start to play
+            MWBase::SoundManager& soundManager = *MWBase::Environment::get().getSoundManager();
+            for (const ESM::RefId& sound : mSounds)
             {
                 if (mAbort)
                     break;
+                soundManager.preloadSound(sound);
+            }
+        }
 
-                try
-                {
-                    const VFS::Manager& vfs = *mSceneManager->getVFS();
-                    mesh = Misc::ResourceHelpers::correctMeshPath(VFS::Path::Normalized(path));
-                    mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
-
-                    if (!vfs.exists(mesh))
-                        continue;
-
-                    if (Misc::getFileName(mesh).starts_with('x') && Misc::getFileExtension(mesh) == "nif")
-                    {
-                        kfname = mesh;
-                        kfname.changeExtension("kf");
-                        if (vfs.exists(kfname))
-                            mPreloadedObjects.insert(mKeyframeManager->get(kfname));
-                    }
-
-                    mPreloadedObjects.insert(mSceneManager->getTemplate(mesh));
-                    if (mPreloadInstances)
-                        mPreloadedObjects.insert(mBulletShapeManager->cacheInstance(mesh));
-                    else
-                        mPreloadedObjects.insert(mBulletShapeManager->getShape(mesh));
-                }
-                catch (const std::exception& e)
+    private:
+        void preloadMesh(const VFS::Path::Normalized& mesh)
+        {
+            if (mAbort)
+                return;
+
+            try
+            {
+                const VFS::Manager& vfs = *mSceneManager->getVFS();
+                osg::ref_ptr<const osg::Object> keyframes;
+                if (Misc::getFileName(mesh).starts_with('x') && Misc::getFileExtension(mesh) == "nif")
                 {
-                    Log(Debug::Warning) << "Failed to preload mesh \"" << path << "\" from cell " << mCellId << ": "
-                                        << e.what();
+                    VFS::Path::Normalized kfname = mesh;
+                    kfname.changeExtension("kf");
+                    if (vfs.exists(kfname))
+                        keyframes = mKeyframeManager->get(kfname);
                 }
+
+                osg::ref_ptr<const osg::Object> node = mSceneManager->getTemplate(mesh);
+                osg::ref_ptr<const osg::Object> shape;
+                if (mPreloadInstances)
+                    shape = mBulletShapeManager->cacheInstance(mesh);
+                else
+                    shape = mBulletShapeManager->getShape(mesh);
+
+                const std::lock_guard lock(mPreloadedObjectsMutex);
+                if (keyframes != nullptr)
+                    mPreloadedObjects.insert(std::move(keyframes));
+                mPreloadedObjects.insert(std::move(node));
+                mPreloadedObjects.insert(std::move(shape));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to preload mesh \"" << mesh << "\" from cell " << mCellId << ": "
+                                    << e.what();
             }
         }
 
-    private:
         bool mIsExterior;
         ESM::ExteriorCellLocation mCellLocation;
         ESM::RefId mCellId;
         std::vector<std::string_view> mMeshes;
+        std::vector<ESM::RefId> mSounds;
         Resource::SceneManager* mSceneManager;
         Resource::BulletShapeManager* mBulletShapeManager;
         Resource::KeyframeManager* mKeyframeManager;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
+        SceneUtil::WorkQueue* mWorkQueue;
         bool mPreloadInstances;
 
         std::atomic<bool> mAbort;
@@ -161,6 +222,7 @@ namespace MWWorld
         osg::ref_ptr<Terrain::View> mTerrainView;
 
         // keep a ref to the loaded objects to make sure it stays loaded as long as this cell is in the preloaded state
+        std::mutex mPreloadedObjectsMutex;
         std::set<osg::ref_ptr<const osg::Object>> mPreloadedObjects;
     };
 
@@ -178,6 +240,8 @@ namespace MWWorld
 
         void doWork() override
         {
+            OPENMW_TRACE_SCOPE("Preload Terrain");
+
             for (unsigned int i = 0; i < mTerrainViews.size() && i < mPreloadPositions.size() && !mAbort; ++i)
             {
                 mTerrainViews[i]->reset();
@@ -216,6 +280,69 @@ namespace MWWorld
         Resource::ResourceSystem* mResourceSystem;
     };
 
+    /// Content file readers for the worker threads, the ones of the main thread are not thread safe.
+    class ContentRefsReader
+    {
+    public:
+        explicit ContentRefsReader(const ToUTF8::Utf8Encoder& encoder)
+            : mEncoder(encoder)
+        {
+        }
+
+        std::vector<CellStore::ContentRef> read(const ESM::Cell& cell)
+        {
+            const std::lock_guard lock(mMutex);
+            return CellStore::readContentRefs(cell, mReaders, &mEncoder);
+        }
+
+    private:
+        // Cells are read one at a time, only a few content files are needed at once
+        static constexpr std::size_t sMaxOpenReaders = 16;
+
+        std::mutex mMutex;
+        ESM::ReadersCache mReaders{ sMaxOpenReaders };
+        // A copy, the conversion buffer of the main thread's encoder can't be shared
+        ToUTF8::Utf8Encoder mEncoder;
+    };
+
+    /// Worker thread item: read the references of a cell from the content files, so loading the cell on the main
+    /// thread does not need to.
+    class ReadRefsItem : public SceneUtil::WorkItem
+    {
+    public:
+        /// Constructor to be called from the main thread.
+        explicit ReadRefsItem(CellStore& cell, std::shared_ptr<ContentRefsReader> reader)
+            : mCell(cell)
+            , mEsmCell(cell.getCell()->getEsm3())
+            , mReader(std::move(reader))
+            , mAbort(false)
+        {
+        }
+
+        void abort() override { mAbort = true; }
+
+        /// Read work to be called from the worker thread.
+        void doWork() override
+        {
+            OPENMW_TRACE_SCOPE("Read Cell References");
+
+            if (!mAbort)
+                mRefs = mReader->read(mEsmCell);
+        }
+
+        CellStore& getCell() const { return mCell; }
+
+        /// To be called from the main thread once the item is done.
+        std::vector<CellStore::ContentRef> takeRefs() { return std::move(mRefs); }
+
+    private:
+        CellStore& mCell;
+        const ESM::Cell& mEsmCell;
+        std::shared_ptr<ContentRefsReader> mReader;
+        std::atomic<bool> mAbort;
+        std::vector<CellStore::ContentRef> mRefs;
+    };
+
     CellPreloader::CellPreloader(Resource::ResourceSystem* resourceSystem,
         Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager)
         : mResourceSystem(resourceSystem)
@@ -241,11 +368,6 @@ namespace MWWorld
             Log(Debug::Error) << "Error: can't preload, no work queue set";
             return;
         }
-        if (cell.getState() == CellStore::State_Unloaded)
-        {
-            Log(Debug::Error) << "Error: can't preload objects for unloaded cell";
-            return;
-        }
 
         PreloadMap::iterator found = mPreloadCells.find(&cell);
         if (found != mPreloadCells.end())
@@ -272,7 +394,7 @@ namespace MWWorld
 
             if (oldestTimestamp + threshold < timestamp)
             {
-                oldestCell->second.mWorkItem->abort();
+                mWorkQueue->abortWorkItem(*oldestCell->second.mWorkItem);
                 mPreloadCells.erase(oldestCell);
                 ++mEvicted;
             }
@@ -280,14 +402,32 @@ namespace MWWorld
                 return;
         }
 
-        osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
-            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
-        mWorkQueue->addWorkItem(item);
+        // Only ESM3 references are read from the content files, the others are in memory already
+        if (cell.getState() != CellStore::State_Loaded && (mContentRefsReader == nullptr || cell.getCell()->isEsm4()))
+            cell.load();
+
+        PreloadEntry entry(timestamp, nullptr);
+        if (cell.getState() == CellStore::State_Loaded)
+            entry.mWorkItem = startPreload(cell);
+        else
+        {
+            entry.mReadRefsItem = new ReadRefsItem(cell, mContentRefsReader);
+            entry.mWorkItem = entry.mReadRefsItem;
+            mWorkQueue->addWorkItem(entry.mReadRefsItem, SceneUtil::WorkPriority::Low);
+        }
 
-        mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
+        mPreloadCells.emplace(&cell, std::move(entry));
         ++mAdded;
     }
 
+    osg::ref_ptr<SceneUtil::WorkItem> CellPreloader::startPreload(CellStore& cell)
+    {
+        osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
+            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mWorkQueue.get(), mPreloadInstances));
+        mWorkQueue->addWorkItem(item, SceneUtil::WorkPriority::Low);
+        return item;
+    }
+
     void CellPreloader::notifyLoaded(CellStore* cell)
     {
         PreloadMap::iterator found = mPreloadCells.find(cell);
@@ -295,13 +435,15 @@ namespace MWWorld
         {
             if (found->second.mWorkItem)
             {
-                found->second.mWorkItem->abort();
+                mWorkQueue->abortWorkItem(*found->second.mWorkItem);
                 found->second.mWorkItem = nullptr;
             }
 
             mPreloadCells.erase(found);
             ++mLoaded;
         }
+        else
+            ++mMissed;
     }
 
     void CellPreloader::clear()
@@ -310,7 +452,7 @@ namespace MWWorld
         {
             if (it->second.mWorkItem)
             {
-                it->second.mWorkItem->abort();
+                mWorkQueue->abortWorkItem(*it->second.mWorkItem);
                 it->second.mWorkItem = nullptr;
             }
 
@@ -320,13 +462,24 @@ namespace MWWorld
 
     void CellPreloader::updateCache(double timestamp)
     {
+        // Loading a cell with the references read in advance only creates the objects, there is no file access
+        for (auto& [cell, entry] : mPreloadCells)
+        {
+            if (entry.mReadRefsItem == nullptr || !entry.mReadRefsItem->isDone())
+                continue;
+            CellStore& cellStore = entry.mReadRefsItem->getCell();
+            cellStore.load(entry.mReadRefsItem->takeRefs());
+            entry.mReadRefsItem = nullptr;
+            entry.mWorkItem = startPreload(cellStore);
+        }
+
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
         {
             if (mPreloadCells.size() >= mMinCacheSize && it->second.mTimeStamp < timestamp - mExpiryDelay)
             {
                 if (it->second.mWorkItem)
                 {
-                    it->second.mWorkItem->abort();
+                    mWorkQueue->abortWorkItem(*it->second.mWorkItem);
                     it->second.mWorkItem = nullptr;
                 }
                 mPreloadCells.erase(it++);
@@ -367,6 +520,11 @@ namespace MWWorld
         mWorkQueue = workQueue;
     }
 
+    void CellPreloader::setEncoder(const ToUTF8::Utf8Encoder* encoder)
+    {
+        mContentRefsReader = encoder != nullptr ? std::make_shared<ContentRefsReader>(*encoder) : nullptr;
+    }
+
     void CellPreloader::syncTerrainLoad(Loading::Listener& listener)
     {
         if (mTerrainPreloadItem != nullptr && !mTerrainPreloadItem->isDone())
@@ -379,7 +537,7 @@ namespace MWWorld
             return;
         if (mTerrainPreloadItem && !mTerrainPreloadItem->isDone())
         {
-            mTerrainPreloadItem->abort();
+            mWorkQueue->abortWorkItem(*mTerrainPreloadItem);
             mTerrainPreloadItem->waitTillDone();
         }
         setTerrainPreloadPositions({});
@@ -434,7 +592,7 @@ namespace MWWorld
     {
         if (mTerrainPreloadItem)
         {
-            mTerrainPreloadItem->abort();
+            mWorkQueue->abortWorkItem(*mTerrainPreloadItem);
             mTerrainPreloadItem->waitTillDone();
             mTerrainPreloadItem = nullptr;
         }
@@ -446,7 +604,7 @@ namespace MWWorld
         }
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
-            it->second.mWorkItem->abort();
+            mWorkQueue->abortWorkItem(*it->second.mWorkItem);
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
             it->second.mWorkItem->waitTillDone();
@@ -460,6 +618,7 @@ namespace MWWorld
         stats.setAttribute(frameNumber, "CellPreloader Added", mAdded);
         stats.setAttribute(frameNumber, "CellPreloader Evicted", mEvicted);
         stats.setAttribute(frameNumber, "CellPreloader Loaded", mLoaded);
+        stats.setAttribute(frameNumber, "CellPreloader Missed", mMissed);
         stats.setAttribute(frameNumber, "CellPreloader Expired", mExpired);
     }
 }
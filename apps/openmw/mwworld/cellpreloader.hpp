@@ -8,6 +8,7 @@
 #include <osg/ref_ptr>
 
 #include <map>
+#include <memory>
 #include <span>
 
 namespace osg
@@ -37,10 +38,17 @@ namespace Loading
     class Listener;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class CellStore;
     class TerrainPreloadItem;
+    class ReadRefsItem;
+    class ContentRefsReader;
 
     class CellPreloader
     {
@@ -50,7 +58,8 @@ namespace MWWorld
         ~CellPreloader();
 
         /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
-        /// @note The cell itself must be in State_Loaded or State_Preloaded.
+        /// @note The references of a cell that is not loaded yet are read by a background thread too, the cell is
+        /// loaded with them by updateCache once they are read.
         void preload(MWWorld::CellStore& cell, double timestamp);
 
         void notifyLoaded(MWWorld::CellStore* cell);
@@ -78,6 +87,10 @@ namespace MWWorld
 
         void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
 
+        /// Encoding of the content files. Without it the references of cells that are not loaded yet are read on the
+        /// main thread.
+        void setEncoder(const ToUTF8::Utf8Encoder* encoder);
+
         void setTerrainPreloadPositions(std::span<const PositionCellGrid> positions);
 
         void syncTerrainLoad(Loading::Listener& listener);
@@ -90,6 +103,8 @@ namespace MWWorld
     private:
         void clearAllTasks();
 
+        osg::ref_ptr<SceneUtil::WorkItem> startPreload(MWWorld::CellStore& cell);
+
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
         Terrain::World* mTerrain;
@@ -116,6 +131,8 @@ namespace MWWorld
 
             double mTimeStamp;
             osg::ref_ptr<SceneUtil::WorkItem> mWorkItem;
+            // Same as the work item while the references of the cell are read, before it is loaded
+            osg::ref_ptr<ReadRefsItem> mReadRefsItem;
         };
         typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
@@ -126,6 +143,7 @@ namespace MWWorld
         std::vector<PositionCellGrid> mTerrainPreloadPositions;
         osg::ref_ptr<TerrainPreloadItem> mTerrainPreloadItem;
         osg::ref_ptr<SceneUtil::WorkItem> mUpdateCacheItem;
+        std::shared_ptr<ContentRefsReader> mContentRefsReader;
 
         std::vector<PositionCellGrid> mLoadedTerrainPositions;
         double mLoadedTerrainTimestamp;
@@ -133,6 +151,8 @@ namespace MWWorld
         std::size_t mAdded = 0;
         std::size_t mExpired = 0;
         std::size_t mLoaded = 0;
+        // Cells loaded without a preload request
+        std::size_t mMissed = 0;
     };
 
 }
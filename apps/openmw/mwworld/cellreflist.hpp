@@ -1,9 +1,8 @@
 #ifndef GAME_MWWORLD_CELLREFLIST_H
 #define GAME_MWWORLD_CELLREFLIST_H
 
-#include <list>
-
 #include "livecellref.hpp"
+#include "stablelist.hpp"
 
 namespace MWWorld
 {
@@ -16,7 +15,8 @@ namespace MWWorld
     struct CellRefList : public CellRefListBase
     {
         typedef LiveCellRef<X> LiveRef;
-        typedef std::list<LiveRef> List;
+        // Ptrs refer to the references by address, so they never move
+        typedef StableList<LiveRef> List;
         List mList;
 
         /// Search for the given reference in the given reclist from
@@ -43,7 +43,7 @@ namespace MWWorld
             for (typename List::iterator it = mList.begin(); it != mList.end();)
             {
                 if (*it == refNum)
-                    mList.erase(it++);
+                    it = mList.erase(it);
                 else
                     ++it;
             }
@@ -418,7 +418,7 @@ namespace MWWorld
 
         if (const X* ptr = store.search(ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
+            typename List::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
 
             LiveRef liveCellRef(ref, ptr);
 
@@ -855,7 +855,9 @@ namespace MWWorld
         std::sort(mIds.begin(), mIds.end());
     }
 
-    void CellStore::loadRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    template <class PrepareReader, class ReferenceInvocable>
+    static void visitCell3ContentReferences(const ESM::Cell& cell, ESM::ReadersCache& readers,
+        PrepareReader&& prepareReader, ReferenceInvocable&& invocable)
     {
         if (cell.mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
@@ -867,7 +869,8 @@ namespace MWWorld
             {
                 // Reopen the ESM reader and seek to the right position.
                 const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
+                const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                prepareReader(*reader, cell.mContextList[i]);
                 cell.restore(*reader, i);
 
                 ESM::CellRef ref;
@@ -889,15 +892,28 @@ namespace MWWorld
                         continue;
                     }
 
-                    loadRef(ref, deleted, refNumToID);
+                    invocable(ref, deleted);
                 }
             }
             catch (std::exception& e)
             {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription()
-                                  << ": " << e.what();
+                Log(Debug::Error) << "An error occurred loading references for cell " << cell.getDescription() << ": "
+                                  << e.what();
             }
         }
+    }
+
+    void CellStore::loadRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    {
+        // The readers of the cell store are opened with their headers and have the encoding of the content files
+        const auto prepareReader = [](ESM::ESMReader& /*reader*/, const ESM::ESM_Context& /*context*/) {};
+        visitCell3ContentReferences(cell, mReaders, prepareReader,
+            [&](ESM::CellRef& ref, bool deleted) { loadRef(ref, deleted, refNumToID); });
+        loadLeasedRefs(cell, refNumToID);
+    }
+
+    void CellStore::loadLeasedRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    {
         // Load moved references, from separately tracked list.
         for (const auto& leasedRef : cell.mLeasedRefs)
         {
@@ -908,6 +924,39 @@ namespace MWWorld
         }
     }
 
+    void CellStore::load(std::vector<ContentRef>&& contentRefs)
+    {
+        if (mState == State_Loaded)
+            return;
+
+        if (mState == State_Preloaded)
+            mIds.clear();
+
+        std::map<ESM::RefNum, ESM::RefId> refNumToID; // used to detect refID modifications
+        for (ContentRef& contentRef : contentRefs)
+            loadRef(contentRef.mRef, contentRef.mDeleted, refNumToID);
+        loadLeasedRefs(mCellVariant.getEsm3(), refNumToID);
+
+        requestMergedRefsUpdate();
+
+        mState = State_Loaded;
+    }
+
+    std::vector<CellStore::ContentRef> CellStore::readContentRefs(
+        const ESM::Cell& cell, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder)
+    {
+        std::vector<ContentRef> result;
+        const auto prepareReader = [&](ESM::ESMReader& reader, const ESM::ESM_Context& context) {
+            reader.setEncoder(encoder);
+            // Restoring the context alone would not read the header, the format version is needed to load references
+            if (!reader.isOpen())
+                reader.open(context.filename);
+        };
+        visitCell3ContentReferences(cell, readers, prepareReader,
+            [&](ESM::CellRef& ref, bool deleted) { result.push_back(ContentRef{ std::move(ref), deleted }); });
+        return result;
+    }
+
     void CellStore::loadRefs(const ESM4::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
     {
         visitCell4References(cell, mStore, mReaders, [&](const ESM4::Reference& ref) { loadRef(ref); });
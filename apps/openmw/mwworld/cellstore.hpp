@@ -53,6 +53,11 @@ namespace ESM
     struct CellCommon;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace ESM4
 {
     class Reader;
@@ -106,6 +111,13 @@ namespace MWWorld
     class CellStore
     {
     public:
+        /// Reference of an ESM3 cell as it is stored in a content file
+        struct ContentRef
+        {
+            ESM::CellRef mRef;
+            bool mDeleted;
+        };
+
         enum State
         {
             State_Unloaded,
@@ -203,6 +215,15 @@ namespace MWWorld
         void load();
         ///< Load references from content file.
 
+        void load(std::vector<ContentRef>&& contentRefs);
+        ///< Load references of an ESM3 cell read in advance by readContentRefs, without reading content files.
+        /// Does nothing if the cell is already loaded.
+
+        static std::vector<ContentRef> readContentRefs(
+            const ESM::Cell& cell, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder);
+        ///< Read references of an ESM3 cell from content files without touching any cell store, so it can be done by
+        /// another thread with its own readers and encoder.
+
         void preload();
         ///< Build ID list from content file.
 
@@ -427,6 +448,8 @@ namespace MWWorld
 
         void loadRefs();
 
+        void loadLeasedRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID);
+
         void loadRef(const ESM4::Reference& ref);
         void loadRef(const ESM4::ActorCharacter& ref);
         void loadRef(ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID);
@@ -331,6 +331,13 @@ namespace MWWorld
             models.push_back(model);
     }
 
+    void Class::getSoundsToPreload(const ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const
+    {
+        ESM::RefId sound = getSound(ptr);
+        if (!sound.empty())
+            sounds.push_back(std::move(sound));
+    }
+
     const ESM::RefId& Class::applyEnchantment(
         const MWWorld::ConstPtr& ptr, const ESM::RefId& enchId, int enchCharge, const std::string& newName) const
     {
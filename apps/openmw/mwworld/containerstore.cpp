@@ -1,6 +1,8 @@
 #include "containerstore.hpp"
 #include "inventorystore.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <stdexcept>
 
@@ -29,6 +31,12 @@
 
 namespace
 {
+    std::uint64_t makeRevision()
+    {
+        static std::atomic<std::uint64_t> lastRevision{ 0 };
+        return ++lastRevision;
+    }
+
     void addScripts(MWWorld::ContainerStore& store, MWWorld::CellStore* cell)
     {
         auto& scripts = MWBase::Environment::get().getWorld()->getLocalScripts();
@@ -57,24 +65,6 @@ namespace
 
         return sum;
     }
-
-    template <typename T>
-    MWWorld::Ptr searchId(MWWorld::CellRefList<T>& list, const ESM::RefId& id, MWWorld::ContainerStore* store)
-    {
-        store->resolve();
-
-        for (MWWorld::LiveCellRef<T>& liveCellRef : list.mList)
-        {
-            if ((liveCellRef.mBase->mId == id) && liveCellRef.mRef.getCount())
-            {
-                MWWorld::Ptr ptr(&liveCellRef, nullptr);
-                ptr.setContainerStore(store);
-                return ptr;
-            }
-        }
-
-        return MWWorld::Ptr();
-    }
 }
 
 MWWorld::ResolutionListener::~ResolutionListener()
@@ -104,6 +94,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::getState(
     LiveCellRef<T> ref(ESM::makeBlankCellRef(), record);
     ref.load(state);
     collection.mList.push_back(std::move(ref));
+    addToStacksIndex(collection.mList.back());
     auto it = ContainerStoreIterator(this, --collection.mList.end());
     MWBase::Environment::get().getWorldModel()->registerPtr(*it);
 
@@ -152,6 +143,7 @@ MWWorld::ContainerStore::ContainerStore()
     , mWeightUpToDate(false)
     , mModified(false)
     , mResolved(false)
+    , mRevision(makeRevision())
     , mSeed()
     , mPtr()
 {
@@ -190,12 +182,85 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::end()
 int MWWorld::ContainerStore::count(const ESM::RefId& id) const
 {
     int total = 0;
-    for (const auto&& iter : *this)
-        if (iter.getCellRef().getRefId() == id)
-            total += iter.getCellRef().getCount();
+    for (const LiveCellRefBase* ref : getStacks(id))
+        if (const int count = ref->mRef.getCount(); count > 0)
+            total += count;
     return total;
 }
 
+const std::vector<MWWorld::LiveCellRefBase*>& MWWorld::ContainerStore::getStacks(const ESM::RefId& id) const
+{
+    if (!mStacksIndex.mUpToDate)
+    {
+        mStacksIndex.mStacks.clear();
+        mStacksIndex.mUpToDate = true;
+        const auto addList = [&](const auto& list) {
+            for (const LiveCellRefBase& ref : list.mList)
+                addToStacksIndex(ref);
+        };
+        addList(potions);
+        addList(appas);
+        addList(armors);
+        addList(books);
+        addList(clothes);
+        addList(ingreds);
+        addList(lights);
+        addList(lockpicks);
+        addList(miscItems);
+        addList(probes);
+        addList(repairs);
+        addList(weapons);
+    }
+
+    static const std::vector<LiveCellRefBase*> none;
+    const auto it = mStacksIndex.mStacks.find(id);
+    return it == mStacksIndex.mStacks.end() ? none : it->second;
+}
+
+void MWWorld::ContainerStore::addToStacksIndex(const LiveCellRefBase& ref) const
+{
+    // The index is only a cache, the stacks belong to this store
+    if (mStacksIndex.mUpToDate)
+        mStacksIndex.mStacks[ref.mRef.getRefId()].push_back(const_cast<LiveCellRefBase*>(&ref));
+}
+
+MWWorld::ContainerStoreIterator MWWorld::ContainerStore::getIterator(LiveCellRefBase& ref)
+{
+    const auto getListIterator = [&](auto& list) {
+        using LiveRef = typename std::decay_t<decltype(list)>::LiveRef;
+        return ContainerStoreIterator(this, list.mList.iteratorTo(static_cast<LiveRef&>(ref)));
+    };
+
+    switch (getType(ConstPtr(&ref, nullptr)))
+    {
+        case Type_Potion:
+            return getListIterator(potions);
+        case Type_Apparatus:
+            return getListIterator(appas);
+        case Type_Armor:
+            return getListIterator(armors);
+        case Type_Book:
+            return getListIterator(books);
+        case Type_Clothing:
+            return getListIterator(clothes);
+        case Type_Ingredient:
+            return getListIterator(ingreds);
+        case Type_Light:
+            return getListIterator(lights);
+        case Type_Lockpick:
+            return getListIterator(lockpicks);
+        case Type_Miscellaneous:
+            return getListIterator(miscItems);
+        case Type_Probe:
+            return getListIterator(probes);
+        case Type_Repair:
+            return getListIterator(repairs);
+        case Type_Weapon:
+            return getListIterator(weapons);
+    }
+    return end();
+}
+
 void MWWorld::ContainerStore::updateRefNums()
 {
     for (const auto& iter : *this)
@@ -240,31 +305,25 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::unstack(const Ptr& ptr,
 MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::Ptr& item)
 {
     resolve();
-    MWWorld::ContainerStoreIterator retval = end();
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
-    {
-        if (item == *iter)
-        {
-            retval = iter;
-            break;
-        }
-    }
-
-    if (retval == end())
+    const std::vector<LiveCellRefBase*>& stacksOfItem = getStacks(item.getCellRef().getRefId());
+    if (item.getCellRef().getCount() <= 0
+        || std::find(stacksOfItem.begin(), stacksOfItem.end(), item.mRef) == stacksOfItem.end())
         throw std::runtime_error("item is not from this container");
 
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
+    for (LiveCellRefBase* stack : stacksOfItem)
     {
+        if (stack->mRef.getCount() <= 0)
+            continue;
+        MWWorld::ContainerStoreIterator iter = getIterator(*stack);
         if (stacks(*iter, item))
         {
             iter->getCellRef().setCount(
                 addItems(iter->getCellRef().getCount(false), item.getCellRef().getCount(false)));
             item.getCellRef().setCount(0);
-            retval = iter;
-            break;
+            return iter;
         }
     }
-    return retval;
+    return getIterator(*item.mRef);
 }
 
 bool MWWorld::ContainerStore::stacks(const ConstPtr& ptr1, const ConstPtr& ptr2) const
@@ -378,7 +437,6 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
 {
     if (markModified)
         resolve();
-    int type = getType(ptr);
 
     const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
 
@@ -391,13 +449,13 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
     // world and picks it up again. We just turn it into gold_001 here and ignore that oddity.
     if (ptr.getClass().isGold(ptr))
     {
-        for (MWWorld::ContainerStoreIterator iter(begin(type)); iter != end(); ++iter)
+        for (LiveCellRefBase* stack : getStacks(MWWorld::ContainerStore::sGoldId))
         {
-            if (iter->getCellRef().getRefId() == MWWorld::ContainerStore::sGoldId)
+            if (stack->mRef.getCount() > 0)
             {
-                iter->getCellRef().setCount(addItems(iter->getCellRef().getCount(false), count));
+                stack->mRef.setCount(addItems(stack->mRef.getCount(false), count));
                 flagAsModified();
-                return iter;
+                return getIterator(*stack);
             }
         }
 
@@ -406,8 +464,12 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
     }
 
     // determine whether to stack or not
-    for (MWWorld::ContainerStoreIterator iter(begin(type)); iter != end(); ++iter)
+    for (LiveCellRefBase* stack : getStacks(ptr.getCellRef().getRefId()))
     {
+        if (stack->mRef.getCount() <= 0)
+            continue;
+        const MWWorld::ContainerStoreIterator iter = getIterator(*stack);
+
         // Don't stack with equipped items
         if (auto* inventoryStore = dynamic_cast<InventoryStore*>(this))
             if (inventoryStore->isEquipped(*iter))
@@ -483,6 +545,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addNewStack(const Const
     }
 
     it->getCellRef().setCount(count);
+    addToStacksIndex(*it->mRef);
 
     flagAsModified();
     return it;
@@ -536,9 +599,11 @@ int MWWorld::ContainerStore::remove(const ESM::RefId& itemId, int count, bool eq
         resolve();
     int toRemove = count;
 
-    for (ContainerStoreIterator iter(begin()); iter != end() && toRemove > 0; ++iter)
-        if (iter->getCellRef().getRefId() == itemId)
-            toRemove -= remove(*iter, toRemove, equipReplacement, resolveFirst);
+    // Removing may add stacks of other items, like equipment replacements
+    const std::vector<LiveCellRefBase*> stacksOfItem = getStacks(itemId);
+    for (auto it = stacksOfItem.begin(); it != stacksOfItem.end() && toRemove > 0; ++it)
+        if ((*it)->mRef.getCount() > 0)
+            toRemove -= remove(*getIterator(**it), toRemove, equipReplacement, resolveFirst);
 
     flagAsModified();
 
@@ -679,6 +744,7 @@ void MWWorld::ContainerStore::flagAsModified()
 {
     mWeightUpToDate = false;
     mRechargingItemsUpToDate = false;
+    mRevision = makeRevision();
 }
 
 bool MWWorld::ContainerStore::isResolved() const
@@ -833,78 +899,15 @@ MWWorld::Ptr MWWorld::ContainerStore::findReplacement(const ESM::RefId& id)
 MWWorld::Ptr MWWorld::ContainerStore::search(const ESM::RefId& id)
 {
     resolve();
+    for (LiveCellRefBase* stack : getStacks(id))
     {
-        Ptr ptr = searchId(potions, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(appas, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(armors, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(books, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(clothes, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(ingreds, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(lights, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(lockpicks, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(miscItems, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(probes, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(repairs, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(weapons, id, this);
-        if (!ptr.isEmpty())
+        if (stack->mRef.getCount() > 0)
+        {
+            Ptr ptr(stack, nullptr);
+            ptr.setContainerStore(this);
             return ptr;
+        }
     }
-
     return Ptr();
 }
 
@@ -1,10 +1,13 @@
 #ifndef GAME_MWWORLD_CONTAINERSTORE_H
 #define GAME_MWWORLD_CONTAINERSTORE_H
 
+#include <cstdint>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <components/esm3/loadalch.hpp>
 #include <components/esm3/loadappa.hpp>
@@ -142,13 +145,42 @@ namespace MWWorld
         mutable float mCachedWeight;
         mutable bool mWeightUpToDate;
 
+        // Stacks by item id in the order they were added, including the emptied ones. Stacks are never removed from
+        // the lists, so the index is built once and then extended by every new stack.
+        struct StacksIndex
+        {
+            std::unordered_map<ESM::RefId, std::vector<LiveCellRefBase*>> mStacks;
+            bool mUpToDate = false;
+
+            StacksIndex() = default;
+
+            // A copy would refer to the stacks of another store
+            StacksIndex(const StacksIndex& /*other*/) {}
+
+            StacksIndex& operator=(const StacksIndex& /*other*/)
+            {
+                mStacks.clear();
+                mUpToDate = false;
+                return *this;
+            }
+        };
+
+        mutable StacksIndex mStacksIndex;
+
         bool mModified;
         bool mResolved;
+        std::uint64_t mRevision;
         unsigned int mSeed;
         MWWorld::SafePtr mPtr; // Container or actor that holds this store.
         std::weak_ptr<ResolutionListener> mResolutionListener;
 
         ContainerStoreIterator addImp(const Ptr& ptr, int count, bool markModified = true);
+
+        const std::vector<LiveCellRefBase*>& getStacks(const ESM::RefId& id) const;
+
+        void addToStacksIndex(const LiveCellRefBase& ref) const;
+
+        ContainerStoreIterator getIterator(LiveCellRefBase& ref);
         void addInitialItem(
             const ESM::RefId& id, const ESM::RefId& owner, int count, Misc::Rng::Generator* prng, bool topLevel = true);
         void addInitialItemImp(const MWWorld::Ptr& ptr, const ESM::RefId& owner, int count, Misc::Rng::Generator* prng,
@@ -181,6 +213,7 @@ namespace MWWorld
         {
             auto res = std::make_unique<ContainerStore>(*this);
             res->updateRefNums();
+            res->flagAsModified();
             return res;
         }
 
@@ -198,6 +231,10 @@ namespace MWWorld
 
         bool hasVisibleItems() const;
 
+        /// Changes whenever items are added, removed, restacked or equipped. Never the same for two stores, so
+        /// pointers to the items can be kept for as long as the store reports the same revision.
+        std::uint64_t getRevision() const { return mRevision; }
+
         virtual ContainerStoreIterator add(
             const Ptr& itemPtr, int count, bool allowAutoEquip = true, bool resolve = true);
         ///< Add the item pointed to by \a ptr to this container. (Stacks automatically if needed)
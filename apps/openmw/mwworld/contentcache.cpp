@@ -0,0 +1,143 @@
+#include "contentcache.hpp"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/files/openfile.hpp>
+#include <components/toutf8/toutf8.hpp>
+
+#include "esmstore.hpp"
+
+namespace MWWorld
+{
+    namespace
+    {
+        // Increase when records written by ESMStore::writeDecodable change in a way not covered by the format version
+        constexpr int formatVersion = 1;
+
+        std::string toHex(const std::array<std::uint64_t, 2>& hash)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (const std::uint64_t value : hash)
+                stream << std::setw(16) << value;
+            return stream.str();
+        }
+
+        // Only the upper half of the code page differs between encodings
+        std::string getEncodingFingerprint(const ToUTF8::Utf8Encoder* encoder)
+        {
+            if (encoder == nullptr)
+                return "none";
+            std::string input;
+            for (int i = 0x80; i <= 0xff; ++i)
+                input.push_back(static_cast<char>(i));
+            std::string buffer;
+            return std::string(encoder->getStatelessEncoder().getUtf8(
+                input, ToUTF8::BufferAllocationPolicy::FitToRequiredSize, buffer));
+        }
+    }
+
+    ContentCache::ContentCache(std::filesystem::path path)
+        : mPath(std::move(path))
+    {
+    }
+
+    std::string ContentCache::makeKey(
+        std::span<const std::filesystem::path> files, const ToUTF8::Utf8Encoder* encoder)
+    {
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << ESM::CurrentContentFormatVersion << ' ' << files.size();
+        for (const std::filesystem::path& file : files)
+        {
+            const std::string name = Files::pathToUnicodeString(file.filename());
+            descriptor << ' ' << name << ' ' << toHex(Files::getHash(name, *Files::openBinaryInputFileStream(file)));
+        }
+        descriptor << ' ' << getEncodingFingerprint(encoder);
+
+        std::istringstream stream(descriptor.str());
+        return toHex(Files::getHash("content cache key", stream));
+    }
+
+    bool ContentCache::read(const std::string& key, ESMStore& store) const
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(mPath, ec))
+            return false;
+
+        ESM::ESMReader reader;
+        ESM::ESM_Context start;
+        DecodedContentFile decoded;
+
+        // Decode everything first to leave the store untouched when the cache is broken
+        try
+        {
+            reader.open(mPath);
+            if (reader.getDesc() != key)
+            {
+                Log(Debug::Info) << "Content cache " << mPath << " doesn't match the content files";
+                return false;
+            }
+            start = reader.getContext();
+            decoded = store.decode(reader);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read content cache " << mPath << ": " << e.what();
+            return false;
+        }
+
+        reader.restoreContext(start);
+        ESM::Dialogue* dialogue = nullptr;
+        store.load(reader, nullptr, dialogue, &decoded);
+
+        Log(Debug::Info) << "Loaded " << decoded.mRecords.size() << " records from content cache " << mPath;
+        return true;
+    }
+
+    void ContentCache::write(const std::string& key, const ESMStore& store) const
+    {
+        // Write to a temporary file first so a failure or another process never leaves a partially written cache
+        std::filesystem::path temporary = mPath;
+        temporary += ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mPath.parent_path());
+
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                ESM::ESMWriter writer;
+                writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+                writer.setAuthor("OpenMW");
+                writer.setDescription(key);
+                writer.save(stream);
+                store.writeDecodable(writer);
+                writer.close();
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+
+            std::filesystem::rename(temporary, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write content cache " << mPath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+}
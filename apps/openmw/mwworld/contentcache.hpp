@@ -0,0 +1,42 @@
+#ifndef OPENMW_APPS_OPENMW_MWWORLD_CONTENTCACHE_H
+#define OPENMW_APPS_OPENMW_MWWORLD_CONTENTCACHE_H
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// @brief Decodable records merged from the content files kept on disk between runs, see
+    /// ESMStore::writeDecodable.
+    /// @par The cache is a single ESM3 file with the key written as the header description. The key covers names and
+    /// contents of the content files in load order and the encoding they are read with, so any change to the load
+    /// order invalidates the cache.
+    class ContentCache
+    {
+    public:
+        explicit ContentCache(std::filesystem::path path);
+
+        /// @param files content files in load order
+        static std::string makeKey(std::span<const std::filesystem::path> files, const ToUTF8::Utf8Encoder* encoder);
+
+        /// Add cached records to the store.
+        /// @return false if there is no cache with the key or it can't be read, the store is not modified then.
+        bool read(const std::string& key, ESMStore& store) const;
+
+        /// Replace the cache by the decodable records of the store, failures are only logged.
+        void write(const std::string& key, const ESMStore& store) const;
+
+    private:
+        std::filesystem::path mPath;
+    };
+}
+
+#endif
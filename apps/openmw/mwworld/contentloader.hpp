@@ -15,6 +15,9 @@ namespace MWWorld
     {
         virtual ~ContentLoader() = default;
 
+        /// Called for each file in load order before any is loaded, allows to start reading the files in background.
+        virtual void prepare(const std::filesystem::path& filepath, int index) {}
+
         virtual void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) = 0;
     };
 
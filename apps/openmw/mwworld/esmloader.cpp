@@ -1,8 +1,12 @@
 #include "esmloader.hpp"
+#include "contentcache.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <thread>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/format.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/readerscache.hpp>
@@ -11,6 +15,7 @@
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 #include "../mwbase/environment.hpp"
 
@@ -25,11 +30,62 @@ namespace MWWorld
         , mDialogue(nullptr) // A content file containing INFO records without a DIAL record appends them to the
                              // previous file's dialogue
         , mESMVersions(esmVersions)
+        , mMaxDecoding(std::max(1u, std::thread::hardware_concurrency()))
     {
     }
 
+    void EsmLoader::prepare(const std::filesystem::path& filepath, int index)
+    {
+        mPending.push_back(PendingFile{ filepath, index });
+    }
+
+    void EsmLoader::startDecoding()
+    {
+        // Decoded records take about as much memory as the files, so don't get too far ahead of loading
+        while (mDecoding.size() < mMaxDecoding && !mPending.empty())
+        {
+            PendingFile file = std::move(mPending.front());
+            mPending.pop_front();
+            // Utf8Encoder is not thread safe
+            std::optional<ToUTF8::Utf8Encoder> encoder;
+            if (mEncoder != nullptr)
+                encoder.emplace(*mEncoder);
+            const int index = file.mIndex;
+            mDecoding.emplace(index,
+                std::async(std::launch::async,
+                    [&store = mStore, file = std::move(file), encoder = std::move(encoder)]() mutable {
+                        if (ESM::readFormat(*Files::openBinaryInputFileStream(file.mPath)) != ESM::Format::Tes3)
+                            return DecodedContentFile();
+                        ESM::ESMReader reader;
+                        if (encoder.has_value())
+                            reader.setEncoder(&*encoder);
+                        reader.setIndex(file.mIndex);
+                        reader.open(file.mPath);
+                        return store.decode(reader);
+                    }));
+        }
+    }
+
     void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
     {
+        std::optional<DecodedContentFile> decoded;
+        startDecoding();
+        if (const auto it = mDecoding.find(index); it != mDecoding.end())
+        {
+            std::future<DecodedContentFile> future = std::move(it->second);
+            mDecoding.erase(it);
+            // Keep the threads busy while this file is loaded
+            startDecoding();
+            // Errors are reported by loading the file
+            try
+            {
+                decoded = future.get();
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Verbose) << "Failed to decode content file " << filepath << ": " << e.what();
+            }
+        }
 
         auto stream = Files::openBinaryInputFileStream(filepath);
         const ESM::Format format = ESM::readFormat(*stream);
@@ -55,7 +111,8 @@ namespace MWWorld
                   "Please run the launcher to fix this issue.");
 
                 mESMVersions[index] = reader->getVer();
-                mStore.load(*reader, listener, mDialogue);
+                mStore.load(
+                    *reader, listener, mDialogue, decoded.has_value() ? &*decoded : nullptr, mSkipDecodable);
 
                 if (!mMasterFileFormat.has_value()
                     && (Misc::StringUtils::ciEndsWith(reader->getName().u8string(), u8".esm")
@@ -65,16 +122,44 @@ namespace MWWorld
             }
             case ESM::Format::Tes4:
             {
-                ESM4::Reader reader(std::move(stream), filepath,
-                    MWBase::Environment::get().getResourceSystem()->getVFS(),
-                    mEncoder != nullptr ? &mEncoder->getStatelessEncoder() : nullptr);
+                const VFS::Manager* vfs = MWBase::Environment::get().getResourceSystem()->getVFS();
+                const ToUTF8::StatelessUtf8Encoder* encoder
+                    = mEncoder != nullptr ? &mEncoder->getStatelessEncoder() : nullptr;
+                ESM4::Reader reader(std::move(stream), filepath, vfs, encoder);
                 reader.setModIndex(index);
                 reader.updateModIndices(mNameToIndex);
-                mStore.loadESM4(reader, listener);
+                // Most records of large ESM4 files are compressed, inflating them takes most of the loading time
+                reader.startInflatingAhead(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+                mStore.loadESM4(reader, listener, [vfs, encoder](const std::filesystem::path& path) {
+                    return std::make_shared<ESM4::Reader>(Files::openBinaryInputFileStream(path), path, vfs, encoder);
+                });
                 break;
             }
         }
         mNameToIndex[Misc::StringUtils::lowerCase(Files::pathToUnicodeString(filepath.filename()))] = index;
     }
 
+    bool EsmLoader::readCache(const ContentCache& cache)
+    {
+        std::vector<std::filesystem::path> files;
+        files.reserve(mPending.size());
+        for (const PendingFile& file : mPending)
+            files.push_back(file.mPath);
+        mCacheKey = ContentCache::makeKey(files, mEncoder);
+
+        if (!cache.read(mCacheKey, mStore))
+            return false;
+
+        // Nothing left to decode in background
+        mPending.clear();
+        mSkipDecodable = true;
+        return true;
+    }
+
+    void EsmLoader::writeCache(const ContentCache& cache) const
+    {
+        if (!mSkipDecodable && !mCacheKey.empty())
+            cache.write(mCacheKey, mStore);
+    }
+
 } /* namespace MWWorld */
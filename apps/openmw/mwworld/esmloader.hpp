@@ -1,11 +1,16 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <cstddef>
+#include <deque>
+#include <future>
 #include <map>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "contentloader.hpp"
+#include "esmstore.hpp"
 
 namespace ToUTF8
 {
@@ -20,8 +25,7 @@ namespace ESM
 
 namespace MWWorld
 {
-
-    class ESMStore;
+    class ContentCache;
 
     struct EsmLoader : public ContentLoader
     {
@@ -30,9 +34,30 @@ namespace MWWorld
 
         std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+        /// Queue the file to be decoded in a background thread, see ESMStore::decode. A few files following the one
+        /// being loaded are decoded at the same time.
+        void prepare(const std::filesystem::path& filepath, int index) override;
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
+        /// Add decodable records of the prepared files from the cache, then only the rest is read from the files.
+        /// Must be called after prepare and before load.
+        /// @return false if the cache doesn't match the prepared files
+        bool readCache(const ContentCache& cache);
+
+        /// Store decodable records of all loaded files unless they were read from the cache.
+        void writeCache(const ContentCache& cache) const;
+
+        /// @return the key of the prepared files computed by readCache
+        const std::string& getCacheKey() const { return mCacheKey; }
+
     private:
+        struct PendingFile
+        {
+            std::filesystem::path mPath;
+            int mIndex;
+        };
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
@@ -40,6 +65,13 @@ namespace MWWorld
         std::optional<int> mMasterFileFormat;
         std::vector<int>& mESMVersions;
         std::map<std::string, int> mNameToIndex;
+        std::size_t mMaxDecoding;
+        std::deque<PendingFile> mPending;
+        std::map<int, std::future<DecodedContentFile>> mDecoding;
+        std::string mCacheKey;
+        bool mSkipDecodable = false;
+
+        void startDecoding();
     };
 
 } /* namespace MWWorld */
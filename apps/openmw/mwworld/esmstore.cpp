@@ -386,8 +386,39 @@ namespace MWWorld
         return false;
     }
 
-    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue)
+    DecodedContentFile ESMStore::decode(ESM::ESMReader& esm) const
     {
+        DecodedContentFile result;
+
+        // Same order of records and the same rules to skip them as in load
+        while (esm.hasMoreRecs())
+        {
+            const ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+            if (esm.getRecordFlags() & ESM::FLAG_Ignored)
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            const auto it = mStoreImp->mRecNameToStore.find(static_cast<ESM::RecNameInts>(n.toInt()));
+            if (it == mStoreImp->mRecNameToStore.end() || !it->second->isDecodable())
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            result.mRecords.push_back(it->second->decode(esm));
+        }
+
+        return result;
+    }
+
+    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+        DecodedContentFile* decoded, bool skipDecodable)
+    {
+        std::size_t nextDecoded = 0;
+
         if (listener != nullptr)
             listener->setProgressRange(::EsmLoader::fileProgress);
 
@@ -445,9 +476,27 @@ namespace MWWorld
                     throw std::runtime_error("Unknown record: " + n.toString());
                 }
             }
+            else if (skipDecodable && it->second->isDecodable())
+            {
+                // Only a deleted record keeps the following INFO records attached to the dialogue
+                if (dialogue != nullptr && !it->second->decode(esm)->mIsDeleted)
+                    dialogue = nullptr;
+                else if (dialogue == nullptr)
+                    esm.skipRecord();
+            }
             else
             {
-                RecordId id = it->second->load(esm);
+                RecordId id;
+                if (decoded != nullptr && it->second->isDecodable())
+                {
+                    if (nextDecoded >= decoded->mRecords.size())
+                        throw std::logic_error("Decoded records don't match the content file");
+                    esm.skipRecord();
+                    id = it->second->apply(std::move(*decoded->mRecords[nextDecoded]));
+                    decoded->mRecords[nextDecoded++].reset();
+                }
+                else
+                    id = it->second->load(esm);
                 if (id.mIsDeleted)
                 {
                     it->second->eraseStatic(id.mId);
@@ -468,17 +517,37 @@ namespace MWWorld
         }
     }
 
-    void ESMStore::loadESM4(ESM4::Reader& reader, Loading::Listener* listener)
+    void ESMStore::writeDecodable(ESM::ESMWriter& writer) const
+    {
+        for (const auto& [_, store] : mStoreImp->mRecNameToStore)
+            if (store->isDecodable())
+                store->writeStatic(writer);
+    }
+
+    void ESMStore::loadESM4(ESM4::Reader& reader, Loading::Listener* listener,
+        const std::function<std::shared_ptr<ESM4::Reader>(const std::filesystem::path& path)>& openReader)
     {
         if (listener != nullptr)
             listener->setProgressRange(::EsmLoader::fileProgress);
-        auto visitorRec = [this, listener](ESM4::Reader& r) {
-            bool result = ESMStoreImp::readRecord(r, *this);
+        // Temporary children groups hold no nested groups, so records before this offset belong to the last one
+        std::size_t temporaryGroupEnd = 0;
+        auto visitorRec = [this, listener, &temporaryGroupEnd](ESM4::Reader& r) {
+            // Skipped references are read by Store<ESM4::Reference>::getByCell
+            const bool lazy = r.hdr().record.typeId == ESM4::REC_REFR && r.getFileOffset() < temporaryGroupEnd;
+            bool result = !lazy && ESMStoreImp::readRecord(r, *this);
             if (listener != nullptr)
                 listener->setProgress(::EsmLoader::fileProgress * r.getFileOffset() / r.getFileSize());
             return result;
         };
-        ESM4::ReaderUtils::readAll(reader, visitorRec, [](ESM4::Reader&) {});
+        auto visitorGroup = [this, &openReader, &temporaryGroupEnd](ESM4::Reader& r) {
+            const ESM4::RecordHeader& header = r.hdr();
+            if (header.group.type != ESM4::Grp_CellTemporaryChild)
+                return;
+            const ESM4::ReaderContext context = r.getContext();
+            temporaryGroupEnd = static_cast<std::size_t>(context.filePos) + header.group.groupSize;
+            getWritable<ESM4::Reference>().addLazyGroup(context, ESM::RefId(r.currCell()), openReader);
+        };
+        ESM4::ReaderUtils::readAll(reader, visitorRec, visitorGroup);
     }
 
     void ESMStore::setIdType(const ESM::RefId& id, ESM::RecNameInts type)
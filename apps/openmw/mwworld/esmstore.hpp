@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_ESMSTORE_H
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <tuple>
@@ -120,6 +121,12 @@ namespace MWWorld
 {
     struct ESMStoreImp;
 
+    /// Records of a content file read by ESMStore::decode to be added by ESMStore::load.
+    struct DecodedContentFile
+    {
+        std::vector<std::unique_ptr<DecodedRecord>> mRecords;
+    };
+
     class ESMStore
     {
         friend struct ESMStoreImp; // This allows StoreImp to extend esmstore without beeing included everywhere
@@ -221,8 +228,23 @@ namespace MWWorld
         /// Validate entries in store after loading a save
         void validateDynamic();
 
-        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
-        void loadESM4(ESM4::Reader& esm, Loading::Listener* listener);
+        /// Read records of the content file that don't depend on the state of the store, see
+        /// DynamicStoreBase::isDecodable. Safe to call from any thread while the store is loading other files.
+        DecodedContentFile decode(ESM::ESMReader& esm) const;
+
+        /// @param decoded records of the same file returned by decode, added instead of being read again
+        /// @param skipDecodable don't read decodable records, they are already in the store (see writeDecodable)
+        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+            DecodedContentFile* decoded = nullptr, bool skipDecodable = false);
+
+        /// Write all decodable records loaded so far. Loading the result gives the same stores as loading the
+        /// content files they came from.
+        void writeDecodable(ESM::ESMWriter& writer) const;
+
+        /// References in the temporary children of cells are only read once their cell is loaded, by readers
+        /// opened with openReader.
+        void loadESM4(ESM4::Reader& esm, Loading::Listener* listener,
+            const std::function<std::shared_ptr<ESM4::Reader>(const std::filesystem::path& path)>& openReader);
 
         template <class T>
         const Store<T>& get() const
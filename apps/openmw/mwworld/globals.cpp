@@ -1,5 +1,6 @@
 #include "globals.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <components/esm3/esmreader.hpp>
@@ -9,56 +10,58 @@
 
 namespace MWWorld
 {
-    Globals::Collection::const_iterator Globals::find(std::string_view name) const
+    std::size_t Globals::search(std::string_view name) const
     {
-        Collection::const_iterator iter = mVariables.find(name);
-
-        if (iter == mVariables.end())
-            throw std::runtime_error("unknown global variable: " + std::string{ name });
-
-        return iter;
+        const auto iter = mIndices.find(name);
+        return iter == mIndices.end() ? sNoIndex : iter->second;
     }
 
-    Globals::Collection::iterator Globals::find(std::string_view name)
+    std::size_t Globals::find(std::string_view name) const
     {
-        Collection::iterator iter = mVariables.find(name);
+        const std::size_t index = search(name);
 
-        if (iter == mVariables.end())
+        if (index == sNoIndex)
             throw std::runtime_error("unknown global variable: " + std::string{ name });
 
-        return iter;
+        return index;
     }
 
     void Globals::fill(const MWWorld::ESMStore& store)
     {
         mVariables.clear();
+        mIndices.clear();
 
         const MWWorld::Store<ESM::Global>& globals = store.get<ESM::Global>();
 
+        mVariables.reserve(globals.getSize());
         for (const ESM::Global& esmGlobal : globals)
-        {
-            mVariables.emplace(esmGlobal.mId, esmGlobal);
-        }
+            mVariables.push_back(esmGlobal);
+        std::sort(mVariables.begin(), mVariables.end(),
+            [](const ESM::Global& left, const ESM::Global& right) { return left.mId < right.mId; });
+
+        mIndices.reserve(mVariables.size());
+        for (std::size_t i = 0; i < mVariables.size(); ++i)
+            mIndices.emplace(mVariables[i].mId.getRefIdString(), i);
     }
 
     const ESM::Variant& Globals::operator[](GlobalVariableName name) const
     {
-        return find(name.getValue())->second.mValue;
+        return mVariables[find(name.getValue())].mValue;
     }
 
     ESM::Variant& Globals::operator[](GlobalVariableName name)
     {
-        return find(name.getValue())->second.mValue;
+        return mVariables[find(name.getValue())].mValue;
     }
 
     char Globals::getType(GlobalVariableName name) const
     {
-        Collection::const_iterator iter = mVariables.find(name.getValue());
+        const std::size_t index = search(name.getValue());
 
-        if (iter == mVariables.end())
+        if (index == sNoIndex)
             return ' ';
 
-        switch (iter->second.mValue.getType())
+        switch (mVariables[index].mValue.getType())
         {
             case ESM::VT_Short:
                 return 's';
@@ -79,10 +82,10 @@ namespace MWWorld
 
     void Globals::write(ESM::ESMWriter& writer, Loading::Listener& progress) const
     {
-        for (const auto& variable : mVariables)
+        for (const ESM::Global& variable : mVariables)
         {
             writer.startRecord(ESM::REC_GLOB);
-            variable.second.save(writer);
+            variable.save(writer);
             writer.endRecord(ESM::REC_GLOB);
         }
     }
@@ -98,8 +101,8 @@ namespace MWWorld
             // Deleted globals can't appear there, so isDeleted will be ignored here.
             global.load(reader, isDeleted);
 
-            if (const auto iter = mVariables.find(global.mId); iter != mVariables.end())
-                iter->second = std::move(global);
+            if (const auto iter = mIndices.find(global.mId.getRefIdString()); iter != mIndices.end())
+                mVariables[iter->second] = std::move(global);
 
             return true;
         }
@@ -2,8 +2,8 @@
 #define GAME_MWWORLD_GLOBALS_H
 
 #include <cstdint>
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <components/esm3/loadglob.hpp>
@@ -29,13 +29,15 @@ namespace MWWorld
     class Globals
     {
     private:
-        using Collection = std::map<ESM::RefId, ESM::Global, std::less<>>;
+        // Sorted by id, so saved games list them in the same order as before
+        std::vector<ESM::Global> mVariables;
+        std::unordered_map<std::string, std::size_t, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> mIndices;
 
-        Collection mVariables; // type, value
+        static constexpr std::size_t sNoIndex = static_cast<std::size_t>(-1);
 
-        Collection::const_iterator find(std::string_view name) const;
+        std::size_t search(std::string_view name) const;
 
-        Collection::iterator find(std::string_view name);
+        std::size_t find(std::string_view name) const;
 
     public:
         static constexpr GlobalVariableName sDaysPassed{ "dayspassed" };
@@ -1,20 +1,225 @@
 #include "groundcoverstore.hpp"
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/esm3/loadstat.hpp>
 #include <components/esm3/readerscache.hpp>
 #include <components/esmloader/esmdata.hpp>
 #include <components/esmloader/load.hpp>
+#include <components/files/collections.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/platform/file.hpp>
 #include <components/resource/resourcesystem.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "contentcache.hpp"
 #include "store.hpp"
 
 namespace MWWorld
 {
+    namespace
+    {
+        constexpr std::array<char, 8> signature = { 'O', 'M', 'W', 'G', 'C', 'O', 'V', 'R' };
+        // Increase when the layout of the packed arrays changes
+        constexpr std::uint32_t formatVersion = 1;
+
+        constexpr std::string_view prefix = "grass/";
+
+        struct Header
+        {
+            std::array<char, 8> mSignature;
+            std::uint32_t mVersion;
+            std::uint32_t mKeySize;
+            std::uint32_t mCellCount;
+            std::uint32_t mInstanceCount;
+            std::uint32_t mIdCount;
+            std::uint32_t mStaticCount;
+            std::uint32_t mStringsSize;
+        };
+
+        struct StringRef
+        {
+            std::uint32_t mOffset;
+            std::uint32_t mSize;
+        };
+
+        struct PackedStatic
+        {
+            StringRef mId;
+            StringRef mModel;
+        };
+
+        static_assert(std::is_trivially_copyable_v<GroundcoverInstance>);
+        static_assert(sizeof(GroundcoverInstance) % alignof(Header) == 0);
+
+        // Sections are padded to keep the arrays aligned when the file is mapped
+        std::size_t alignUp(std::size_t value)
+        {
+            return (value + alignof(Header) - 1) / alignof(Header) * alignof(Header);
+        }
+
+        class Writer
+        {
+        public:
+            explicit Writer(std::vector<char>& data)
+                : mData(data)
+            {
+            }
+
+            template <class T>
+            void writeArray(std::span<const T> values)
+            {
+                const char* const begin = reinterpret_cast<const char*>(values.data());
+                mData.insert(mData.end(), begin, begin + values.size_bytes());
+                mData.resize(alignUp(mData.size()));
+            }
+
+            template <class T>
+            void write(const T& value)
+            {
+                writeArray(std::span<const T>(&value, 1));
+            }
+
+        private:
+            std::vector<char>& mData;
+        };
+
+        class Reader
+        {
+        public:
+            explicit Reader(std::span<const char> data)
+                : mData(data)
+            {
+            }
+
+            template <class T>
+            std::span<const T> read(std::size_t count)
+            {
+                const std::size_t size = count * sizeof(T);
+                if (size > mData.size())
+                    throw std::runtime_error("unexpected end of file");
+                const std::span<const T> result(reinterpret_cast<const T*>(mData.data()), count);
+                mData = mData.subspan(std::min(mData.size(), alignUp(size)));
+                return result;
+            }
+
+        private:
+            std::span<const char> mData;
+        };
+
+        std::string_view getString(std::span<const char> strings, const StringRef& ref)
+        {
+            if (ref.mOffset > strings.size() || ref.mSize > strings.size() - ref.mOffset)
+                throw std::runtime_error("string is out of bounds");
+            return std::string_view(strings.data() + ref.mOffset, ref.mSize);
+        }
+
+        StringRef addString(std::string& strings, std::string_view value)
+        {
+            const StringRef result{ static_cast<std::uint32_t>(strings.size()),
+                static_cast<std::uint32_t>(value.size()) };
+            strings += value;
+            return result;
+        }
+
+        VFS::Path::Normalized getGroundcoverMesh(std::string_view model)
+        {
+            const VFS::Path::Normalized path = VFS::Path::toNormalized(model);
+            if (!path.value().starts_with(prefix))
+                return {};
+            return Misc::ResourceHelpers::correctMeshPath(path);
+        }
+    }
+
+    GroundcoverStore::GroundcoverStore() = default;
+
+    GroundcoverStore::~GroundcoverStore() = default;
+
     void GroundcoverStore::init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections,
-        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
+        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener,
+        const std::filesystem::path& cachePath)
+    {
+        for (const ESM::Static& stat : statics)
+        {
+            VFS::Path::Normalized model = getGroundcoverMesh(stat.mModel);
+            if (!model.value().empty())
+                mMeshCache[stat.mId] = std::move(model);
+        }
+
+        std::string key;
+        bool useCache = false;
+        if (!cachePath.empty())
+        {
+            try
+            {
+                std::vector<std::filesystem::path> paths;
+                for (const std::string& file : groundcoverFiles)
+                    paths.push_back(fileCollections.getPath(file));
+                key = ContentCache::makeKey(paths, encoder);
+                useCache = true;
+
+                std::error_code ec;
+                if (std::filesystem::exists(cachePath, ec))
+                {
+                    auto mapping = std::make_unique<const Platform::File::ScopedMapping>(cachePath);
+                    parse(std::span(mapping->data(), mapping->size()), key);
+                    mMapping = std::move(mapping);
+                    Log(Debug::Info) << "Loaded " << mInstances.size() << " groundcover instances of " << mCells.size()
+                                     << " cells from " << cachePath;
+                    return;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Info) << "Groundcover cache " << cachePath << " will be rebuilt: " << e.what();
+            }
+        }
+
+        mBuffer = build(fileCollections, groundcoverFiles, encoder, listener, key);
+        parse(mBuffer, key);
+
+        if (!useCache)
+            return;
+
+        // Write to a temporary file first so a failure or another process never leaves a partially written cache
+        std::filesystem::path temporary = cachePath;
+        temporary += ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(cachePath.parent_path());
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                stream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(temporary, cachePath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write groundcover cache " << cachePath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
+    std::vector<char> GroundcoverStore::build(const Files::Collections& fileCollections,
+        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener,
+        const std::string& key)
     {
         ::EsmLoader::Query query;
         query.mLoadStatics = true;
@@ -24,38 +229,138 @@ namespace MWWorld
         ::EsmLoader::EsmData content
             = ::EsmLoader::loadEsmData(query, groundcoverFiles, fileCollections, readers, encoder, listener);
 
-        static constexpr std::string_view prefix = "grass/";
-        for (const ESM::Static& stat : statics)
-        {
-            VFS::Path::Normalized model = VFS::Path::toNormalized(stat.mModel);
-            if (!model.value().starts_with(prefix))
-                continue;
-            mMeshCache[stat.mId] = Misc::ResourceHelpers::correctMeshPath(model);
-        }
-
+        std::string strings;
+        std::vector<PackedStatic> packedStatics;
         for (const ESM::Static& stat : content.mStatics)
         {
-            VFS::Path::Normalized model = VFS::Path::toNormalized(stat.mModel);
-            if (!model.value().starts_with(prefix))
+            if (getGroundcoverMesh(stat.mModel).value().empty())
                 continue;
-            mMeshCache[stat.mId] = Misc::ResourceHelpers::correctMeshPath(model);
+            const StringRef id = addString(strings, stat.mId.serializeText());
+            packedStatics.push_back(PackedStatic{ id, addString(strings, stat.mModel) });
         }
 
+        // Sorted by position, the same cell may be listed by several files
+        std::map<std::pair<int, int>, ESM::Cell*> cells;
         for (ESM::Cell& cell : content.mCells)
+            if (cell.isExterior())
+                cells[std::make_pair(cell.getGridX(), cell.getGridY())] = &cell;
+
+        std::vector<PackedCell> packedCells;
+        std::vector<GroundcoverInstance> instances;
+        std::vector<StringRef> ids;
+        std::map<ESM::RefId, std::uint32_t> idIndices;
+        for (const auto& [position, cell] : cells)
         {
-            if (!cell.isExterior())
+            std::map<ESM::RefNum, ESM::CellRef> refs;
+            for (std::size_t i = 0; i < cell->mContextList.size(); ++i)
+            {
+                const std::size_t index = static_cast<std::size_t>(cell->mContextList[i].index);
+                const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                cell->restore(*reader, i);
+                ESM::CellRef ref;
+                bool deleted = false;
+                while (cell->getNextRef(*reader, ref, deleted))
+                {
+                    if (deleted)
+                        refs.erase(ref.mRefNum);
+                    else
+                        refs[ref.mRefNum] = std::move(ref);
+                }
+            }
+
+            if (refs.empty())
                 continue;
-            auto cellIndex = std::make_pair(cell.getGridX(), cell.getGridY());
-            mCellContexts[cellIndex] = std::move(cell.mContextList);
+
+            packedCells.push_back(PackedCell{ position.first, position.second,
+                static_cast<std::uint32_t>(instances.size()), static_cast<std::uint32_t>(refs.size()) });
+            for (const auto& [refNum, ref] : refs)
+            {
+                const auto [it, inserted] = idIndices.emplace(ref.mRefID, static_cast<std::uint32_t>(ids.size()));
+                if (inserted)
+                    ids.push_back(addString(strings, ref.mRefID.serializeText()));
+                instances.push_back(GroundcoverInstance{ ref.mPos, ref.mScale, it->second });
+            }
         }
+
+        const Header header{
+            .mSignature = signature,
+            .mVersion = formatVersion,
+            .mKeySize = static_cast<std::uint32_t>(key.size()),
+            .mCellCount = static_cast<std::uint32_t>(packedCells.size()),
+            .mInstanceCount = static_cast<std::uint32_t>(instances.size()),
+            .mIdCount = static_cast<std::uint32_t>(ids.size()),
+            .mStaticCount = static_cast<std::uint32_t>(packedStatics.size()),
+            .mStringsSize = static_cast<std::uint32_t>(strings.size()),
+        };
+
+        std::vector<char> result;
+        Writer writer(result);
+        writer.write(header);
+        writer.writeArray(std::span<const char>(key));
+        writer.writeArray(std::span<const PackedCell>(packedCells));
+        writer.writeArray(std::span<const GroundcoverInstance>(instances));
+        writer.writeArray(std::span<const StringRef>(ids));
+        writer.writeArray(std::span<const PackedStatic>(packedStatics));
+        writer.writeArray(std::span<const char>(strings));
+        return result;
     }
 
-    void GroundcoverStore::initCell(ESM::Cell& cell, int cellX, int cellY) const
+    void GroundcoverStore::parse(std::span<const char> data, const std::string& key)
     {
-        cell.blank();
+        Reader reader(data);
+        const Header& header = reader.read<Header>(1).front();
+        if (header.mSignature != signature)
+            throw std::runtime_error("invalid signature");
+        if (header.mVersion != formatVersion)
+            throw std::runtime_error("unsupported version: " + std::to_string(header.mVersion));
+        const std::span<const char> fileKey = reader.read<char>(header.mKeySize);
+        if (std::string_view(fileKey.data(), fileKey.size()) != key)
+            throw std::runtime_error("groundcover files have changed");
 
-        auto searchCell = mCellContexts.find(std::make_pair(cellX, cellY));
-        if (searchCell != mCellContexts.end())
-            cell.mContextList = searchCell->second;
+        const std::span<const PackedCell> cells = reader.read<PackedCell>(header.mCellCount);
+        const std::span<const GroundcoverInstance> instances = reader.read<GroundcoverInstance>(header.mInstanceCount);
+        const std::span<const StringRef> ids = reader.read<StringRef>(header.mIdCount);
+        const std::span<const PackedStatic> packedStatics = reader.read<PackedStatic>(header.mStaticCount);
+        const std::span<const char> strings = reader.read<char>(header.mStringsSize);
+
+        // Validate everything first to leave the store untouched when the cache is broken
+        for (const PackedCell& cell : cells)
+            if (cell.mFirst > instances.size() || cell.mCount > instances.size() - cell.mFirst)
+                throw std::runtime_error("cell is out of bounds");
+        for (const GroundcoverInstance& instance : instances)
+            if (instance.mId >= ids.size())
+                throw std::runtime_error("object id is out of bounds");
+
+        std::vector<std::pair<ESM::RefId, VFS::Path::Normalized>> meshes;
+        for (const PackedStatic& stat : packedStatics)
+            meshes.emplace_back(ESM::RefId::deserializeText(getString(strings, stat.mId)),
+                getGroundcoverMesh(getString(strings, stat.mModel)));
+        std::vector<ESM::RefId> refIds;
+        for (const StringRef& id : ids)
+            refIds.push_back(ESM::RefId::deserializeText(getString(strings, id)));
+
+        // Groundcover files override statics of the content files
+        for (auto& [id, mesh] : meshes)
+            mMeshCache[id] = std::move(mesh);
+
+        mModels.clear();
+        for (const ESM::RefId& id : refIds)
+        {
+            const auto it = mMeshCache.find(id);
+            mModels.push_back(it == mMeshCache.end() ? nullptr : &it->second);
+        }
+        mCells = cells;
+        mInstances = instances;
+    }
+
+    std::span<const GroundcoverInstance> GroundcoverStore::getInstances(int cellX, int cellY) const
+    {
+        const auto it = std::lower_bound(mCells.begin(), mCells.end(), std::make_pair(cellX, cellY),
+            [](const PackedCell& cell, const std::pair<int, int>& position) {
+                return std::make_pair(cell.mX, cell.mY) < position;
+            });
+        if (it == mCells.end() || it->mX != cellX || it->mY != cellY)
+            return {};
+        return mInstances.subspan(it->mFirst, it->mCount);
     }
 }
@@ -1,18 +1,21 @@
 #ifndef GAME_MWWORLD_GROUNDCOVER_STORE_H
 #define GAME_MWWORLD_GROUNDCOVER_STORE_H
 
+#include <components/esm/position.hpp>
 #include <components/esm/refid.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include <cstdint>
+#include <filesystem>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace ESM
 {
-    struct ESM_Context;
     struct Static;
-    struct Cell;
 }
 
 namespace Loading
@@ -25,6 +28,11 @@ namespace Files
     class Collections;
 }
 
+namespace Platform::File
+{
+    class ScopedMapping;
+}
+
 namespace ToUTF8
 {
     class Utf8Encoder;
@@ -35,16 +43,30 @@ namespace MWWorld
     template <class T>
     class Store;
 
-    class GroundcoverStore
+    /// Reference of a groundcover file as it is stored in the instance cache
+    struct GroundcoverInstance
     {
-    private:
-        std::map<ESM::RefId, VFS::Path::Normalized> mMeshCache;
-        std::map<std::pair<int, int>, std::vector<ESM::ESM_Context>> mCellContexts;
+        ESM::Position mPos;
+        float mScale;
+        // Index of the object id, see GroundcoverStore::getModel
+        std::uint32_t mId;
+    };
 
+    /// @brief References of the groundcover files merged per exterior cell into packed arrays.
+    /// @par The arrays are built once from the groundcover files and kept on disk between runs, later runs map the
+    /// file instead of reading the references again. The cache is rebuilt when the groundcover files or their
+    /// encoding change.
+    class GroundcoverStore
+    {
     public:
+        GroundcoverStore();
+
+        ~GroundcoverStore();
+
+        /// @param cachePath file to keep the instances in, built in memory for this run only when empty
         void init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
-            Loading::Listener* listener);
+            Loading::Listener* listener, const std::filesystem::path& cachePath);
 
         VFS::Path::NormalizedView getGroundcoverModel(ESM::RefId id) const
         {
@@ -54,7 +76,44 @@ namespace MWWorld
             return it->second;
         }
 
-        void initCell(ESM::Cell& cell, int cellX, int cellY) const;
+        /// @return References left in the cell after the groundcover files replaced and deleted them, in RefNum order
+        std::span<const GroundcoverInstance> getInstances(int cellX, int cellY) const;
+
+        /// @return Model of the instance or empty view if its object isn't a groundcover static
+        VFS::Path::NormalizedView getModel(const GroundcoverInstance& instance) const
+        {
+            const VFS::Path::Normalized* const model = mModels[instance.mId];
+            if (model == nullptr)
+                return {};
+            return *model;
+        }
+
+        /// Number of distinct object ids, indices of GroundcoverInstance::mId are below
+        std::size_t getIdCount() const { return mModels.size(); }
+
+    private:
+        struct PackedCell
+        {
+            std::int32_t mX;
+            std::int32_t mY;
+            std::uint32_t mFirst;
+            std::uint32_t mCount;
+        };
+
+        std::map<ESM::RefId, VFS::Path::Normalized> mMeshCache;
+        std::unique_ptr<const Platform::File::ScopedMapping> mMapping;
+        std::vector<char> mBuffer;
+        // Sorted by position, point into the mapping or the buffer
+        std::span<const PackedCell> mCells;
+        std::span<const GroundcoverInstance> mInstances;
+        // By GroundcoverInstance::mId
+        std::vector<const VFS::Path::Normalized*> mModels;
+
+        static std::vector<char> build(const Files::Collections& fileCollections,
+            const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
+            Loading::Listener* listener, const std::string& key);
+
+        void parse(std::span<const char> data, const std::string& key);
     };
 }
 
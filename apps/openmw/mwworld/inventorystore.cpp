@@ -121,8 +121,10 @@ MWWorld::InventoryStore& MWWorld::InventoryStore::operator=(const InventoryStore
     mFirstAutoEquip = store.mFirstAutoEquip;
     mRechargingItemsUpToDate = false;
     ContainerStore::operator=(store);
+    mAutoEquipCache.reset();
     mSlots.clear();
     copySlots(store);
+    flagAsModified();
     return *this;
 }
 
@@ -492,8 +494,50 @@ void MWWorld::InventoryStore::autoEquipArmor(TSlots& slots)
     }
 }
 
+std::vector<float> MWWorld::InventoryStore::getAutoEquipInputs()
+{
+    static const ESM::RefId skills[] = {
+        ESM::Skill::LongBlade,
+        ESM::Skill::Axe,
+        ESM::Skill::Spear,
+        ESM::Skill::ShortBlade,
+        ESM::Skill::Marksman,
+        ESM::Skill::BluntWeapon,
+        ESM::Skill::Unarmored,
+        ESM::Skill::LightArmor,
+        ESM::Skill::MediumArmor,
+        ESM::Skill::HeavyArmor,
+    };
+
+    const Ptr& actor = getPtr();
+    std::vector<float> inputs;
+    for (const ESM::RefId& skill : skills)
+        inputs.push_back(actor.getClass().getSkill(actor, skill));
+
+    // Broken items can not be equipped, creatures prefer the shields in the best condition
+    for (ContainerStoreIterator iter(begin(ContainerStore::Type_Weapon | ContainerStore::Type_Armor)); iter != end();
+         ++iter)
+    {
+        if (iter->getClass().hasItemHealth(*iter))
+            inputs.push_back(static_cast<float>(iter->getClass().getItemHealth(*iter)));
+    }
+
+    return inputs;
+}
+
 void MWWorld::InventoryStore::autoEquip()
 {
+    // The choice of the player may depend on Lua interfaces, so it is always made again
+    const bool useCache = getPtr() != MWMechanics::getPlayer();
+    std::vector<float> inputs;
+    if (useCache)
+    {
+        inputs = getAutoEquipInputs();
+        if (mAutoEquipCache.has_value() && mAutoEquipCache->mRevision == getRevision()
+            && mAutoEquipCache->mSlots == mSlots && mAutoEquipCache->mInputs == inputs)
+            return;
+    }
+
     TSlots slots;
     initSlots(slots);
 
@@ -523,6 +567,10 @@ void MWWorld::InventoryStore::autoEquip()
         fireEquipmentChangedEvent();
         flagAsModified();
     }
+
+    // Unstacking the equipped items adds new ones
+    if (useCache)
+        mAutoEquipCache = AutoEquipCache{ getRevision(), getAutoEquipInputs(), mSlots };
 }
 
 MWWorld::ContainerStoreIterator MWWorld::InventoryStore::getPreferredShield()
@@ -719,6 +767,7 @@ void MWWorld::InventoryStore::clear()
 {
     mSlots.clear();
     initSlots(mSlots);
+    mAutoEquipCache.reset();
     ContainerStore::clear();
 }
 
@@ -3,6 +3,10 @@
 
 #include "containerstore.hpp"
 
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 namespace ESM
 {
     struct MagicEffect;
@@ -67,9 +71,22 @@ namespace MWWorld
 
         TSlots mSlots;
 
+        // Inputs and result of the last auto-equip, it is not repeated while none of them change
+        struct AutoEquipCache
+        {
+            std::uint64_t mRevision;
+            std::vector<float> mInputs;
+            TSlots mSlots;
+        };
+
+        std::optional<AutoEquipCache> mAutoEquipCache;
+
         void autoEquipWeapon(TSlots& slots);
         void autoEquipArmor(TSlots& slots);
 
+        /// @return Skills of the actor and condition of the items the choice of auto-equip depends on.
+        std::vector<float> getAutoEquipInputs();
+
         // selected magic item (for using enchantments of type "Cast once" or "Cast when used")
         ContainerStoreIterator mSelectedEnchantItem;
 
@@ -97,6 +114,7 @@ namespace MWWorld
         {
             auto res = std::make_unique<InventoryStore>(*this);
             res->updateRefNums();
+            res->flagAsModified();
             return res;
         }
 
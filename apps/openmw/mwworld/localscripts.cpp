@@ -5,6 +5,7 @@
 #include <components/esm3/loadcrea.hpp>
 #include <components/esm3/loadnpc.hpp>
 #include <components/esm3/loadscpt.hpp>
+#include <components/settings/values.hpp>
 
 #include "cellstore.hpp"
 #include "class.hpp"
@@ -72,6 +73,25 @@ MWWorld::LocalScripts::LocalScripts(const MWWorld::ESMStore& store)
     : mStore(store)
 {
     mIter = mScripts.end();
+    mDeferredIter = mDeferredScripts.end();
+
+    if (Settings::game().mLocalScriptsTimeBudget > 0)
+        for (const std::string& name : Settings::game().mDeferrableLocalScripts.get())
+            mDeferrable.insert(ESM::RefId::stringRefId(name));
+}
+
+MWWorld::LocalScripts::Scripts& MWWorld::LocalScripts::getList(const ESM::RefId& scriptName)
+{
+    return mDeferrable.contains(scriptName) ? mDeferredScripts : mScripts;
+}
+
+void MWWorld::LocalScripts::erase(Scripts& scripts, Scripts::iterator iter)
+{
+    Scripts::iterator& current = &scripts == &mScripts ? mIter : mDeferredIter;
+    if (iter == current)
+        ++current;
+
+    scripts.erase(iter);
 }
 
 void MWWorld::LocalScripts::startIteration()
@@ -90,6 +110,24 @@ bool MWWorld::LocalScripts::getNext(std::pair<ESM::RefId, Ptr>& script)
     return false;
 }
 
+void MWWorld::LocalScripts::startDeferredIteration()
+{
+    mDeferredRemaining = mDeferredScripts.size();
+}
+
+bool MWWorld::LocalScripts::getNextDeferred(std::pair<ESM::RefId, Ptr>& script)
+{
+    if (mDeferredRemaining == 0 || mDeferredScripts.empty())
+        return false;
+
+    if (mDeferredIter == mDeferredScripts.end())
+        mDeferredIter = mDeferredScripts.begin();
+
+    --mDeferredRemaining;
+    script = *mDeferredIter++;
+    return true;
+}
+
 void MWWorld::LocalScripts::add(const ESM::RefId& scriptName, const Ptr& ptr)
 {
     if (const ESM::Script* script = mStore.get<ESM::Script>().search(scriptName))
@@ -98,15 +136,13 @@ void MWWorld::LocalScripts::add(const ESM::RefId& scriptName, const Ptr& ptr)
         {
             ptr.getRefData().setLocals(*script);
 
-            for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-                if (iter->second == ptr)
-                {
-                    Log(Debug::Warning) << "Error: tried to add local script twice for " << ptr.getCellRef().getRefId();
-                    remove(ptr);
-                    break;
-                }
+            if (isRunning(ptr))
+            {
+                Log(Debug::Warning) << "Error: tried to add local script twice for " << ptr.getCellRef().getRefId();
+                remove(ptr);
+            }
 
-            mScripts.emplace_back(scriptName, ptr);
+            getList(scriptName).emplace_back(scriptName, ptr);
         }
         catch (const std::exception& exception)
         {
@@ -132,53 +168,58 @@ void MWWorld::LocalScripts::addCell(CellStore* cell)
 void MWWorld::LocalScripts::clear()
 {
     mScripts.clear();
+    mDeferredScripts.clear();
+    mIter = mScripts.end();
+    mDeferredIter = mDeferredScripts.end();
+    mDeferredRemaining = 0;
 }
 
 void MWWorld::LocalScripts::clearCell(CellStore* cell)
 {
-    auto iter = mScripts.begin();
-
-    while (iter != mScripts.end())
+    for (Scripts* scripts : { &mScripts, &mDeferredScripts })
     {
-        if (iter->second.mCell == cell)
-        {
-            if (iter == mIter)
-                ++mIter;
+        auto iter = scripts->begin();
 
-            mScripts.erase(iter++);
+        while (iter != scripts->end())
+        {
+            if (iter->second.mCell == cell)
+                erase(*scripts, iter++);
+            else
+                ++iter;
         }
-        else
-            ++iter;
     }
 }
 
 void MWWorld::LocalScripts::remove(const MWWorld::CellRef* ref)
 {
-    for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-        if (&(iter->second.getCellRef()) == ref)
-        {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter);
-            break;
-        }
+    for (Scripts* scripts : { &mScripts, &mDeferredScripts })
+        for (auto iter = scripts->begin(); iter != scripts->end(); ++iter)
+            if (&(iter->second.getCellRef()) == ref)
+            {
+                erase(*scripts, iter);
+                return;
+            }
 }
 
 void MWWorld::LocalScripts::remove(const Ptr& ptr)
 {
-    for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-        if (iter->second == ptr)
-        {
-            if (iter == mIter)
-                ++mIter;
+    for (Scripts* scripts : { &mScripts, &mDeferredScripts })
+        for (auto iter = scripts->begin(); iter != scripts->end(); ++iter)
+            if (iter->second == ptr)
+            {
+                erase(*scripts, iter);
+                return;
+            }
+}
 
-            mScripts.erase(iter);
-            break;
-        }
+bool MWWorld::LocalScripts::isRunning(const Ptr& ptr) const
+{
+    const auto hasPtr = [&](const auto& script) { return script.second == ptr; };
+    return std::ranges::any_of(mScripts, hasPtr) || std::ranges::any_of(mDeferredScripts, hasPtr);
 }
 
 bool MWWorld::LocalScripts::isRunning(const ESM::RefId& scriptName, const Ptr& ptr) const
 {
-    return std::ranges::find(mScripts, std::pair(scriptName, ptr)) != mScripts.end();
+    const Scripts& scripts = mDeferrable.contains(scriptName) ? mDeferredScripts : mScripts;
+    return std::ranges::find(scripts, std::pair(scriptName, ptr)) != scripts.end();
 }
@@ -3,6 +3,7 @@
 
 #include <list>
 #include <string>
+#include <unordered_set>
 
 #include "ptr.hpp"
 
@@ -15,10 +16,23 @@ namespace MWWorld
     /// \brief List of active local scripts
     class LocalScripts
     {
-        std::list<std::pair<ESM::RefId, Ptr>> mScripts;
-        std::list<std::pair<ESM::RefId, Ptr>>::iterator mIter;
+        using Scripts = std::list<std::pair<ESM::RefId, Ptr>>;
+
+        Scripts mScripts;
+        Scripts::iterator mIter;
+        // Scripts which may skip frames when the time budget is exhausted, iterated round-robin across frames
+        Scripts mDeferredScripts;
+        Scripts::iterator mDeferredIter;
+        std::size_t mDeferredRemaining = 0;
+        std::unordered_set<ESM::RefId> mDeferrable;
         const MWWorld::ESMStore& mStore;
 
+        Scripts& getList(const ESM::RefId& scriptName);
+
+        bool isRunning(const Ptr& ptr) const;
+
+        void erase(Scripts& scripts, Scripts::iterator iter);
+
     public:
         LocalScripts(const MWWorld::ESMStore& store);
 
@@ -29,6 +43,13 @@ namespace MWWorld
         ///< Get next local script
         /// @return Did we get a script?
 
+        void startDeferredIteration();
+        ///< Continue iterating deferrable scripts from where the previous frame has stopped.
+
+        bool getNextDeferred(std::pair<ESM::RefId, Ptr>& script);
+        ///< Get next deferrable local script, an iteration stops after as many scripts as there were at its start.
+        /// @return Did we get a script?
+
         void add(const ESM::RefId& scriptName, const Ptr& ptr);
         ///< Add script to collection of active local scripts.
 
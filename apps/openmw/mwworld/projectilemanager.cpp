@@ -60,6 +60,9 @@
 
 namespace
 {
+    // Enough for a battle of archers, without keeping every model ever shot
+    constexpr std::size_t maxPooledNodesPerModel = 32;
+
     ESM::EffectList getMagicBoltData(std::vector<ESM::RefId>& projectileIDs, std::set<ESM::RefId>& sounds, float& speed,
         std::string& texture, std::string& sourceName, const ESM::RefId& id)
     {
@@ -258,6 +261,29 @@ namespace MWWorld
         MWRender::overrideFirstRootTexture(texture, mResourceSystem, *projectile);
     }
 
+    void ProjectileManager::createProjectileModel(
+        ProjectileState& state, VFS::Path::NormalizedView model, const osg::Vec3f& pos, const osg::Quat& orient)
+    {
+        state.mPooledModel = VFS::Path::Normalized(model);
+
+        const auto pool = mProjectileNodePool.find(model);
+        if (pool == mProjectileNodePool.end() || pool->second.empty())
+        {
+            createModel(state, model, pos, orient, false, false, osg::Vec4(0, 0, 0, 0));
+            return;
+        }
+
+        PooledNode& pooled = pool->second.back();
+        state.mNode = std::move(pooled.mNode);
+        state.mEffectAnimationTime = std::move(pooled.mEffectAnimationTime);
+        pool->second.pop_back();
+
+        state.mNode->setPosition(pos);
+        state.mNode->setAttitude(orient);
+        state.mEffectAnimationTime->resetTime(0);
+        mParent->addChild(state.mNode);
+    }
+
     void ProjectileManager::update(State& state, float duration)
     {
         state.mEffectAnimationTime->addTime(duration);
@@ -355,9 +381,13 @@ namespace MWWorld
         MWWorld::Ptr ptr = ref.getPtr();
 
         const VFS::Path::Normalized model = ptr.getClass().getCorrectedModel(ptr);
-        createModel(state, model, pos, orient, false, false, osg::Vec4(0, 0, 0, 0));
         if (!ptr.getClass().getEnchantment(ptr).empty())
+        {
+            createModel(state, model, pos, orient, false, false, osg::Vec4(0, 0, 0, 0));
             SceneUtil::addEnchantedGlow(state.mNode, mResourceSystem, ptr.getClass().getEnchantmentColor(ptr));
+        }
+        else
+            createProjectileModel(state, model, pos, orient);
 
         state.mProjectileId = mPhysics->addProjectile(actor, pos, model, false);
         state.mToDelete = false;
@@ -516,19 +546,45 @@ namespace MWWorld
 
     void ProjectileManager::processHits()
     {
-        for (auto& projectileState : mProjectiles)
+        // The scene is synced with the simulation first, the hits are then delivered from a compact list
+        mProjectileHits.clear();
+        for (std::size_t i = 0; i < mProjectiles.size(); ++i)
         {
+            ProjectileState& projectileState = mProjectiles[i];
             if (projectileState.mToDelete)
                 continue;
 
-            auto* projectile = mPhysics->getProjectile(projectileState.mProjectileId);
+            const auto* projectile = mPhysics->getProjectile(projectileState.mProjectileId);
+            projectileState.mNode->setPosition(projectile->getSimulationPosition());
 
-            const auto pos = projectile->getSimulationPosition();
-            projectileState.mNode->setPosition(pos);
+            if (!projectile->isActive())
+                mProjectileHits.push_back(i);
+        }
 
-            if (projectile->isActive())
+        const MWBase::World& world = *MWBase::Environment::get().getWorld();
+        mMagicBoltHits.clear();
+        for (std::size_t i = 0; i < mMagicBolts.size(); ++i)
+        {
+            MagicBoltState& magicBoltState = mMagicBolts[i];
+            if (magicBoltState.mToDelete)
                 continue;
 
+            const auto* projectile = mPhysics->getProjectile(magicBoltState.mProjectileId);
+
+            const auto pos = projectile->getSimulationPosition();
+            magicBoltState.mNode->setPosition(pos);
+            for (const auto& sound : magicBoltState.mSounds)
+                sound->setPosition(pos);
+
+            if (!projectile->isActive() || world.isUnderwater(magicBoltState.getCaster().getCell(), pos))
+                mMagicBoltHits.push_back(i);
+        }
+
+        for (const std::size_t i : mProjectileHits)
+        {
+            ProjectileState& projectileState = mProjectiles[i];
+            const auto* projectile = mPhysics->getProjectile(projectileState.mProjectileId);
+
             const auto target = projectile->getTarget();
             auto caster = projectileState.getCaster();
             assert(target != caster);
@@ -554,34 +610,24 @@ namespace MWWorld
 
             MWMechanics::projectileHit(
                 caster, target, bow, projectileRef.getPtr(), hitPosition, projectileState.mAttackStrength);
-            projectileState.mToDelete = true;
+            mProjectiles[i].mToDelete = true;
         }
+
         const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
-        for (auto& magicBoltState : mMagicBolts)
+        for (const std::size_t i : mMagicBoltHits)
         {
-            if (magicBoltState.mToDelete)
-                continue;
-
-            auto* projectile = mPhysics->getProjectile(magicBoltState.mProjectileId);
-
-            const auto pos = projectile->getSimulationPosition();
-            magicBoltState.mNode->setPosition(pos);
-            for (const auto& sound : magicBoltState.mSounds)
-                sound->setPosition(pos);
+            MagicBoltState& magicBoltState = mMagicBolts[i];
+            const auto* projectile = mPhysics->getProjectile(magicBoltState.mProjectileId);
 
             const Ptr caster = magicBoltState.getCaster();
-
-            const MWBase::World& world = *MWBase::Environment::get().getWorld();
             const bool active = projectile->isActive();
-            if (active && !world.isUnderwater(caster.getCell(), pos))
-                continue;
-
             const Ptr target = !active ? projectile->getTarget() : Ptr();
 
             assert(target != caster);
 
             MWMechanics::CastSpell cast(caster, target);
-            cast.mHitPosition = !active ? Misc::Convert::toOsg(projectile->getHitPosition()) : pos;
+            cast.mHitPosition
+                = !active ? Misc::Convert::toOsg(projectile->getHitPosition()) : magicBoltState.mNode->getPosition();
             cast.mId = magicBoltState.mSpellId;
             cast.mSourceName = magicBoltState.mSourceName;
             cast.mItem = magicBoltState.mItem;
@@ -597,13 +643,17 @@ namespace MWWorld
             }
             cast.inflict(target, *effects, ESM::RT_Target);
 
-            magicBoltState.mToDelete = true;
+            mMagicBolts[i].mToDelete = true;
         }
 
+        // Projectiles cleaned up earlier are cleaned up again, so their nodes are only pooled here
         for (auto& projectileState : mProjectiles)
         {
             if (projectileState.mToDelete)
+            {
                 cleanupProjectile(projectileState);
+                poolProjectileNode(projectileState);
+            }
         }
 
         for (auto& magicBoltState : mMagicBolts)
@@ -626,6 +676,15 @@ namespace MWWorld
         state.mToDelete = true;
     }
 
+    void ProjectileManager::poolProjectileNode(ProjectileState& state)
+    {
+        if (state.mPooledModel.value().empty())
+            return;
+        std::vector<PooledNode>& pool = mProjectileNodePool[state.mPooledModel];
+        if (pool.size() < maxPooledNodesPerModel)
+            pool.push_back(PooledNode{ std::move(state.mNode), std::move(state.mEffectAnimationTime) });
+    }
+
     void ProjectileManager::cleanupMagicBolt(ProjectileManager::MagicBoltState& state)
     {
         mParent->removeChild(state.mNode);
@@ -640,7 +699,10 @@ namespace MWWorld
     void ProjectileManager::clear()
     {
         for (auto& mProjectile : mProjectiles)
+        {
             cleanupProjectile(mProjectile);
+            poolProjectileNode(mProjectile);
+        }
         mProjectiles.clear();
 
         for (auto& mMagicBolt : mMagicBolts)
@@ -722,8 +784,7 @@ namespace MWWorld
                 return true;
             }
 
-            createModel(state, model, osg::Vec3f(esm.mPosition), osg::Quat(esm.mOrientation), false, false,
-                osg::Vec4(0, 0, 0, 0));
+            createProjectileModel(state, model, osg::Vec3f(esm.mPosition), osg::Quat(esm.mOrientation));
 
             mProjectiles.push_back(std::move(state));
             return true;
@@ -1,7 +1,9 @@
 #ifndef OPENMW_MWWORLD_PROJECTILEMANAGER_H
 #define OPENMW_MWWORLD_PROJECTILEMANAGER_H
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include <osg/PositionAttitudeTransform>
 #include <osg/ref_ptr>
@@ -121,15 +123,33 @@ namespace MWWorld
             // RefID of the bow or crossbow the actor was using when this projectile was fired (may be empty)
             ESM::RefId mBowId;
 
+            // Model to return the scene node to the pool for, empty when the node is not to be reused
+            VFS::Path::Normalized mPooledModel;
+
             osg::Vec3f mVelocity;
             float mAttackStrength;
             bool mThrown;
         };
 
+        struct PooledNode
+        {
+            osg::ref_ptr<osg::PositionAttitudeTransform> mNode;
+            std::shared_ptr<MWRender::EffectAnimationTime> mEffectAnimationTime;
+        };
+
         std::vector<MagicBoltState> mMagicBolts;
         std::vector<ProjectileState> mProjectiles;
 
+        // Nodes of projectiles that hit or were cleaned up, to reuse instead of instancing the model for every shot.
+        // Magic bolts are not pooled, their particle systems would carry over to the next one.
+        std::map<VFS::Path::Normalized, std::vector<PooledNode>, std::less<>> mProjectileNodePool;
+
+        // Indices of the projectiles and magic bolts that hit something in the last simulation step
+        std::vector<std::size_t> mProjectileHits;
+        std::vector<std::size_t> mMagicBoltHits;
+
         void cleanupProjectile(ProjectileState& state);
+        void poolProjectileNode(ProjectileState& state);
         void cleanupMagicBolt(MagicBoltState& state);
         void periodicCleanup(float dt);
 
@@ -138,6 +158,8 @@ namespace MWWorld
 
         void createModel(State& state, VFS::Path::NormalizedView model, const osg::Vec3f& pos, const osg::Quat& orient,
             bool rotate, bool createLight, osg::Vec4 lightDiffuseColor, const std::string& texture = "");
+        void createProjectileModel(
+            ProjectileState& state, VFS::Path::NormalizedView model, const osg::Vec3f& pos, const osg::Quat& orient);
         void update(State& state, float duration);
 
         void operator=(const ProjectileManager&);
@@ -1,5 +1,6 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <limits>
@@ -7,6 +8,7 @@
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/heightfieldshape.hpp>
@@ -352,9 +354,11 @@ namespace MWWorld
         if (mChangeCellGridRequest.has_value())
         {
             changeCellGrid(mChangeCellGridRequest->mPosition, mChangeCellGridRequest->mCellIndex,
-                mChangeCellGridRequest->mChangeEvent);
+                mChangeCellGridRequest->mChangeEvent, true);
             mChangeCellGridRequest.reset();
         }
+        else
+            activatePendingCells();
 
         mPreloader->updateCache(mRendering.getReferenceTime());
         preloadCells(duration);
@@ -364,8 +368,12 @@ namespace MWWorld
     {
         if (mActiveCells.find(cell) == mActiveCells.end())
             return;
+        OPENMW_TRACE_SCOPE("Unload Cell");
         Log(Debug::Info) << "Unloading cell " << cell->getCell()->getDescription();
 
+        // Releasing the objects one by one would rebuild the merged shape bounds every time
+        mPhysics->removeMergedStatics(*cell);
+
         ListAndResetObjectsVisitor visitor;
 
         cell->forEach(visitor, true); // Include objects being teleported by Lua
@@ -426,6 +434,8 @@ namespace MWWorld
     void Scene::loadCell(CellStore& cell, Loading::Listener* loadingListener, bool respawn, const osg::Vec3f& position,
         const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
     {
+        OPENMW_TRACE_SCOPE("Load Cell");
+
         using DetourNavigator::HeightfieldShape;
 
         assert(mActiveCells.find(&cell) == mActiveCells.end());
@@ -499,6 +509,9 @@ namespace MWWorld
 
         insertCell(cell, loadingListener, navigatorUpdateGuard);
 
+        if (Settings::physics().mMergeStaticCollision)
+            mPhysics->mergeStatics(cell);
+
         mRendering.addCell(&cell);
 
         MWBase::Environment::get().getWindowManager()->addCell(&cell);
@@ -541,6 +554,7 @@ namespace MWWorld
         }
         navigatorUpdateGuard.reset();
         assert(mActiveCells.empty());
+        mCellsToActivate.clear();
         mCurrentCell = nullptr;
         mLowestPoint = std::numeric_limits<float>::max();
 
@@ -614,8 +628,11 @@ namespace MWWorld
             ESM::ExteriorCellLocation(cell.x(), cell.y(), mCurrentCell->getCell()->getWorldSpace()), changeEvent };
     }
 
-    void Scene::changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent)
+    void Scene::changeCellGrid(
+        const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent, bool incremental)
     {
+        OPENMW_TRACE_SCOPE("Change Cell Grid");
+
         const int halfGridSize
             = isEsm4Ext(playerCellIndex.mWorldspace) ? Constants::ESM4CellGridRadius : Constants::CellGridRadius;
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
@@ -661,23 +678,41 @@ namespace MWWorld
 
         addPostponedPhysicsObjects();
 
-        std::size_t refsToLoad = 0;
         std::vector<std::pair<int, int>> cellsPositionsToLoad;
         iterateOverCellsAround(playerCellX, playerCellY, mHalfGridSize, [&](int x, int y) {
             const ESM::ExteriorCellLocation location(x, y, playerCellIndex.mWorldspace);
             if (isCellInCollection(location, mActiveCells))
                 return;
-            refsToLoad += mWorld.getWorldModel().getExterior(location).count();
             cellsPositionsToLoad.emplace_back(x, y);
         });
 
+        sortCellsToLoad(playerCellX, playerCellY, cellsPositionsToLoad);
+
+        // The player can only reach the objects of the adjacent cells before the next frames, the other ones are
+        // loaded nearest first as long as the frame budget allows
+        mCellsToActivate.clear();
+        mRespawnCellsToActivate = changeEvent;
+        if (incremental && mCellActivationBudget > 0)
+        {
+            const auto isAdjacent = [&](const std::pair<int, int>& position) {
+                return std::abs(position.first - playerCellX) <= 1 && std::abs(position.second - playerCellY) <= 1;
+            };
+            const auto distant
+                = std::stable_partition(cellsPositionsToLoad.begin(), cellsPositionsToLoad.end(), isAdjacent);
+            for (auto it = distant; it != cellsPositionsToLoad.end(); ++it)
+                mCellsToActivate.emplace_back(it->first, it->second, playerCellIndex.mWorldspace);
+            cellsPositionsToLoad.erase(distant, cellsPositionsToLoad.end());
+        }
+
+        std::size_t refsToLoad = 0;
+        for (const auto& [x, y] : cellsPositionsToLoad)
+            refsToLoad += mWorld.getWorldModel().getExterior({ x, y, playerCellIndex.mWorldspace }).count();
+
         Loading::Listener* loadingListener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         Loading::ScopedLoad load(loadingListener);
         loadingListener->setLabel("#{OMWEngine:LoadingExterior}");
         loadingListener->setProgressRange(refsToLoad);
 
-        sortCellsToLoad(playerCellX, playerCellY, cellsPositionsToLoad);
-
         for (const auto& [x, y] : cellsPositionsToLoad)
         {
             ESM::ExteriorCellLocation indexToLoad = { x, y, playerCellIndex.mWorldspace };
@@ -701,6 +736,32 @@ namespace MWWorld
         mCellLoaded = true;
     }
 
+    void Scene::activatePendingCells()
+    {
+        if (mCellsToActivate.empty())
+            return;
+
+        const auto deadline = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float, std::milli>(mCellActivationBudget));
+        const osg::Vec3f playerPos = mWorld.getPlayerPtr().getRefData().getPosition().asVec3();
+        auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
+
+        // At least one cell a frame, so the grid gets complete whatever the budget
+        do
+        {
+            const ESM::ExteriorCellLocation location = mCellsToActivate.front();
+            mCellsToActivate.pop_front();
+            if (!isCellInCollection(location, mActiveCells))
+            {
+                CellStore& cell = mWorld.getWorldModel().getExterior(location);
+                loadCell(cell, nullptr, mRespawnCellsToActivate, playerPos, navigatorUpdateGuard.get());
+            }
+        } while (!mCellsToActivate.empty() && std::chrono::steady_clock::now() < deadline);
+
+        mNavigator.update(playerPos, navigatorUpdateGuard.get());
+    }
+
     void Scene::addPostponedPhysicsObjects()
     {
         for (const auto& cell : mActiveCells)
@@ -882,10 +943,11 @@ namespace MWWorld
         mWorld.adjustSky();
 
         mLastPlayerPos = player.getRefData().getPosition().asVec3();
+        mPlayerVelocity = osg::Vec3f();
     }
 
     Scene::Scene(MWWorld::World& world, MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem* physics,
-        DetourNavigator::Navigator& navigator)
+        DetourNavigator::Navigator& navigator, const ToUTF8::Utf8Encoder* encoder)
         : mCurrentCell(nullptr)
         , mCellChanged(false)
         , mWorld(world)
@@ -899,11 +961,13 @@ namespace MWWorld
         , mPreloadDoors(Settings::cells().mPreloadDoors)
         , mPreloadFastTravel(Settings::cells().mPreloadFastTravel)
         , mPredictionTime(Settings::cells().mPredictionTime)
+        , mCellActivationBudget(Settings::cells().mCellActivationBudget)
         , mLowestPoint(std::numeric_limits<float>::max())
     {
         mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(),
             rendering.getTerrain(), rendering.getLandManager());
         mPreloader->setWorkQueue(mRendering.getWorkQueue());
+        mPreloader->setEncoder(encoder);
         mPreloader->setExpiryDelay(Settings::cells().mPreloadCellExpiryDelay);
         mPreloader->setMinCacheSize(Settings::cells().mPreloadCellCacheMin);
         mPreloader->setMaxCacheSize(Settings::cells().mPreloadCellCacheMax);
@@ -913,7 +977,7 @@ namespace MWWorld
     Scene::~Scene()
     {
         for (const osg::ref_ptr<SceneUtil::WorkItem>& v : mWorkItems)
-            v->abort();
+            mRendering.getWorkQueue()->abortWorkItem(*v);
 
         for (const osg::ref_ptr<SceneUtil::WorkItem>& v : mWorkItems)
             v->waitTillDone();
@@ -963,6 +1027,7 @@ namespace MWWorld
             unloadCell(cellToUnload, navigatorUpdateGuard.get());
         }
         assert(mActiveCells.empty());
+        mCellsToActivate.clear();
 
         loadingListener->setProgressRange(cell.count());
 
@@ -1140,7 +1205,7 @@ namespace MWWorld
 
         osg::ref_ptr<PreloadMeshItem> item(
             new PreloadMeshItem(meshPath, mRendering.getResourceSystem()->getSceneManager()));
-        mRendering.getWorkQueue()->addWorkItem(item);
+        mRendering.getWorkQueue()->addWorkItem(item, SceneUtil::WorkPriority::Low);
         const auto isDone = [](const osg::ref_ptr<SceneUtil::WorkItem>& v) { return v->isDone(); };
         mWorkItems.erase(std::remove_if(mWorkItems.begin(), mWorkItems.end(), isDone), mWorkItems.end());
         mWorkItems.emplace_back(std::move(item));
@@ -1150,12 +1215,15 @@ namespace MWWorld
     {
         if (dt <= 1e-06)
             return;
+        OPENMW_TRACE_SCOPE("Preload Cells");
         std::vector<PositionCellGrid> exteriorPositions;
 
         const MWWorld::ConstPtr player = mWorld.getPlayerPtr();
         osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
         osg::Vec3f moved = playerPos - mLastPlayerPos;
-        osg::Vec3f predictedPos = playerPos + moved / dt * mPredictionTime;
+        constexpr float velocitySmoothingTime = 0.5f;
+        mPlayerVelocity += (moved / dt - mPlayerVelocity) * std::min(1.f, dt / velocitySmoothingTime);
+        osg::Vec3f predictedPos = playerPos + mPlayerVelocity * mPredictionTime;
 
         if (mCurrentCell->isExterior())
             exteriorPositions.push_back(PositionCellGrid{
@@ -1203,7 +1271,7 @@ namespace MWWorld
             {
                 try
                 {
-                    preloadCellWithSurroundings(mWorld.getWorldModel().getCell(door.getCellRef().getDestCell()));
+                    preloadCellWithSurroundings(mWorld.getWorldModel().getCell(door.getCellRef().getDestCell(), false));
                 }
                 catch (const std::exception& e)
                 {
@@ -1246,7 +1314,7 @@ namespace MWWorld
                 float loadDist = cellSize / 2 + cellSize - mCellLoadingThreshold + mPreloadDistance;
 
                 if (dist < loadDist)
-                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex));
+                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex, false));
             }
         }
     }
@@ -1284,7 +1352,7 @@ namespace MWWorld
 
         const ESM::RefId worldspace = cell.getCell()->getWorldSpace();
         for (const auto& [x, y] : cells)
-            mPreloader->preload(mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace)),
+            mPreloader->preload(mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace), false),
                 mRendering.getReferenceTime());
     }
 
@@ -1362,13 +1430,13 @@ namespace MWWorld
         for (ESM::Transport::Dest& dest : listVisitor.mList)
         {
             if (!dest.mCellName.empty())
-                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName));
+                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName, false));
             else
             {
                 osg::Vec3f pos = dest.mPos.asVec3();
                 const ESM::ExteriorCellLocation cellIndex
                     = ESM::positionToExteriorCellLocation(pos.x(), pos.y(), extWorldspace);
-                preloadCellWithSurroundings(mWorld.getWorldModel().getExterior(cellIndex));
+                preloadCellWithSurroundings(mWorld.getWorldModel().getExterior(cellIndex, false));
                 exteriorPositions.push_back(PositionCellGrid{ pos, gridCenterToBounds(getNewGridCenter(pos)) });
             }
         }
@@ -8,6 +8,7 @@
 #include "positioncellgrid.hpp"
 #include "ptr.hpp"
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <set>
@@ -59,6 +60,11 @@ namespace SceneUtil
     class WorkItem;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class Player;
@@ -102,11 +108,14 @@ namespace MWWorld
         bool mPreloadDoors;
         bool mPreloadFastTravel;
         float mPredictionTime;
+        float mCellActivationBudget;
         float mLowestPoint;
 
         int mHalfGridSize = Constants::CellGridRadius;
 
         osg::Vec3f mLastPlayerPos;
+        // Averaged over the last frames, a single frame may have no physics step or several ones
+        osg::Vec3f mPlayerVelocity;
 
         std::vector<ESM::RefNum> mPagedRefs;
 
@@ -114,13 +123,21 @@ namespace MWWorld
 
         std::optional<ChangeCellGridRequest> mChangeCellGridRequest;
 
+        // Exterior cells of the grid left to load by the following frames, nearest first
+        std::deque<ESM::ExteriorCellLocation> mCellsToActivate;
+        bool mRespawnCellsToActivate = false;
+
         void insertCell(CellStore& cell, Loading::Listener* loadingListener,
             const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
 
         osg::Vec2i mCurrentGridCenter;
 
         // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
-        void changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent = true);
+        // When incremental, the cells not adjacent to the player cell are left for the following frames
+        void changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent = true,
+            bool incremental = false);
+
+        void activatePendingCells();
 
         void requestChangeCellGrid(const osg::Vec3f& position, const osg::Vec2i& cell, bool changeEvent = true);
 
@@ -142,7 +159,7 @@ namespace MWWorld
 
     public:
         Scene(MWWorld::World& world, MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem* physics,
-            DetourNavigator::Navigator& navigator);
+            DetourNavigator::Navigator& navigator, const ToUTF8::Utf8Encoder* encoder);
 
         ~Scene();
 
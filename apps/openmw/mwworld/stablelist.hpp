@@ -0,0 +1,258 @@
+#ifndef OPENMW_MWWORLD_STABLELIST_H
+#define OPENMW_MWWORLD_STABLELIST_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MWWorld
+{
+    /// @brief Sequence of values kept in blocks of contiguous slots instead of a heap node each.
+    /// @par Values never move, references and iterators to them are valid until they are erased, like the ones of a
+    /// list. Every block is twice as large as the previous one, so short lists stay small. Erased slots are skipped
+    /// through a bitmap and not reused, values are always iterated in the order they were added.
+    template <class T>
+    class StableList
+    {
+        template <class List, class Value>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            Iterator() = default;
+
+            Iterator(List& list, std::size_t slot)
+                : mList(&list)
+                , mSlot(slot)
+            {
+            }
+
+            template <class OtherList, class OtherValue>
+                requires(std::is_const_v<Value> && !std::is_const_v<OtherValue>)
+            Iterator(const Iterator<OtherList, OtherValue>& other)
+                : mList(other.mList)
+                , mSlot(other.mSlot)
+            {
+            }
+
+            reference operator*() const { return mList->get(mSlot); }
+
+            pointer operator->() const { return &mList->get(mSlot); }
+
+            Iterator& operator++()
+            {
+                mSlot = mList->findNext(mSlot + 1);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            Iterator& operator--()
+            {
+                mSlot = mList->findPrevious(mSlot);
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                Iterator result = *this;
+                --*this;
+                return result;
+            }
+
+            template <class OtherList, class OtherValue>
+            bool operator==(const Iterator<OtherList, OtherValue>& other) const
+            {
+                return mSlot == other.mSlot && mList == other.mList;
+            }
+
+        private:
+            List* mList = nullptr;
+            std::size_t mSlot = 0;
+
+            template <class, class>
+            friend class Iterator;
+
+            friend class StableList;
+        };
+
+    public:
+        using value_type = T;
+        using iterator = Iterator<StableList, T>;
+        using const_iterator = Iterator<const StableList, const T>;
+
+        StableList() = default;
+
+        StableList(const StableList& other)
+        {
+            for (const T& value : other)
+                emplace_back(value);
+        }
+
+        StableList(StableList&& other) noexcept
+            : mBlocks(std::move(other.mBlocks))
+            , mAlive(std::move(other.mAlive))
+            , mSize(std::exchange(other.mSize, 0))
+        {
+        }
+
+        StableList& operator=(const StableList& other)
+        {
+            if (this != &other)
+                *this = StableList(other);
+            return *this;
+        }
+
+        StableList& operator=(StableList&& other) noexcept
+        {
+            mBlocks = std::move(other.mBlocks);
+            mAlive = std::move(other.mAlive);
+            mSize = std::exchange(other.mSize, 0);
+            return *this;
+        }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            const std::size_t slot = mAlive.size();
+            const std::size_t block = getBlock(slot);
+            if (block == mBlocks.size())
+                mBlocks.push_back(std::make_unique<std::optional<T>[]>(sFirstBlockSize << block));
+            mAlive.push_back(false);
+            try
+            {
+                getSlot(slot).emplace(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                mAlive.pop_back();
+                throw;
+            }
+            mAlive[slot] = true;
+            ++mSize;
+            return *getSlot(slot);
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        /// Destroy the value at the position of the iterator.
+        /// @return Iterator to the next value.
+        iterator erase(iterator it)
+        {
+            const std::size_t slot = it.mSlot;
+            getSlot(slot).reset();
+            mAlive[slot] = false;
+            --mSize;
+            return iterator(*this, findNext(slot + 1));
+        }
+
+        /// @return Iterator to the value at this address, the end if it is not in the list.
+        iterator iteratorTo(const T& value)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(&value);
+            for (std::size_t block = 0; block < mBlocks.size(); ++block)
+            {
+                const auto first = reinterpret_cast<std::uintptr_t>(mBlocks[block].get());
+                const std::size_t offset = (address - first) / sizeof(std::optional<T>);
+                if (address >= first && offset < (sFirstBlockSize << block))
+                {
+                    const std::size_t slot = getBlockStart(block) + offset;
+                    return slot < mAlive.size() && mAlive[slot] ? iterator(*this, slot) : end();
+                }
+            }
+            return end();
+        }
+
+        void clear()
+        {
+            mBlocks.clear();
+            mAlive.clear();
+            mSize = 0;
+        }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        T& front() { return *begin(); }
+        const T& front() const { return *begin(); }
+
+        T& back() { return *std::prev(end()); }
+        const T& back() const { return *std::prev(end()); }
+
+        iterator begin() { return iterator(*this, findNext(0)); }
+        const_iterator begin() const { return const_iterator(*this, findNext(0)); }
+
+        iterator end() { return iterator(*this, mAlive.size()); }
+        const_iterator end() const { return const_iterator(*this, mAlive.size()); }
+
+    private:
+        static constexpr std::size_t sFirstBlockSize = 4;
+
+        std::vector<std::unique_ptr<std::optional<T>[]>> mBlocks;
+        // Kept apart from the values, so skipping the erased slots does not touch them
+        std::vector<bool> mAlive;
+        std::size_t mSize = 0;
+
+        static std::size_t getBlock(std::size_t slot)
+        {
+            return static_cast<std::size_t>(std::bit_width(slot / sFirstBlockSize + 1)) - 1;
+        }
+
+        static std::size_t getBlockStart(std::size_t block)
+        {
+            return sFirstBlockSize * ((std::size_t(1) << block) - 1);
+        }
+
+        std::optional<T>& getSlot(std::size_t slot)
+        {
+            const std::size_t block = getBlock(slot);
+            return mBlocks[block][slot - getBlockStart(block)];
+        }
+
+        const std::optional<T>& getSlot(std::size_t slot) const
+        {
+            const std::size_t block = getBlock(slot);
+            return mBlocks[block][slot - getBlockStart(block)];
+        }
+
+        T& get(std::size_t slot) { return *getSlot(slot); }
+
+        const T& get(std::size_t slot) const { return *getSlot(slot); }
+
+        std::size_t findNext(std::size_t slot) const
+        {
+            while (slot < mAlive.size() && !mAlive[slot])
+                ++slot;
+            return slot;
+        }
+
+        std::size_t findPrevious(std::size_t slot) const
+        {
+            --slot;
+            while (!mAlive[slot])
+                --slot;
+            return slot;
+        }
+    };
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <components/esm/records.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
+#include <components/esm4/reader.hpp>
 
 #include <components/fallback/fallback.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
@@ -46,6 +47,12 @@ namespace
             return setting->mValue.getFloat();
         return {};
     }
+
+    template <class T>
+    struct TypedDecodedRecord final : MWWorld::DecodedRecord
+    {
+        T mRecord;
+    };
 }
 
 namespace MWWorld
@@ -214,14 +221,7 @@ namespace MWWorld
             bool isDeleted = false;
             record.load(esm, isDeleted);
 
-            std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
-            if (inserted.second)
-                mShared.push_back(&inserted.first->second);
-
-            if constexpr (std::is_same_v<Id, ESM::RefId>)
-                return RecordId(record.mId, isDeleted);
-            else
-                return RecordId();
+            return insertLoaded(std::move(record), isDeleted);
         }
         else
         {
@@ -232,6 +232,46 @@ namespace MWWorld
         }
     }
 
+    template <class T, class Id>
+    std::unique_ptr<DecodedRecord> TypedDynamicStore<T, Id>::decode(ESM::ESMReader& esm) const
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            auto result = std::make_unique<TypedDecodedRecord<T>>();
+            result->mRecord.load(esm, result->mIsDeleted);
+            return result;
+        }
+        else
+            return DynamicStoreBase<Id>::decode(esm);
+    }
+
+    template <class T, class Id>
+    RecordId TypedDynamicStore<T, Id>::apply(DecodedRecord&& record)
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            TypedDecodedRecord<T>& decoded = static_cast<TypedDecodedRecord<T>&>(record);
+            return insertLoaded(std::move(decoded.mRecord), decoded.mIsDeleted);
+        }
+        else
+            return DynamicStoreBase<Id>::apply(std::move(record));
+    }
+
+    template <class T, class Id>
+    RecordId TypedDynamicStore<T, Id>::insertLoaded(T&& record, bool isDeleted)
+    {
+        const Id id = record.mId;
+
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id, std::move(record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        if constexpr (std::is_same_v<Id, ESM::RefId>)
+            return RecordId(id, isDeleted);
+        else
+            return RecordId();
+    }
+
     template <class T, class Id>
     void TypedDynamicStore<T, Id>::setUp()
     {
@@ -356,6 +396,24 @@ namespace MWWorld
         }
     }
     template <class T, class Id>
+    void TypedDynamicStore<T, Id>::writeStatic(ESM::ESMWriter& writer) const
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            // Static records are at the beginning of mShared in the order of loading
+            for (std::size_t i = 0, n = mStatic.size(); i < n; ++i)
+            {
+                const T& record = *mShared[i];
+                std::uint32_t flags = 0;
+                if constexpr (requires { record.mRecordFlags; })
+                    flags = record.mRecordFlags;
+                writer.startRecord(T::sRecordId, flags);
+                record.save(writer);
+                writer.endRecord(T::sRecordId);
+            }
+        }
+    }
+    template <class T, class Id>
     RecordId TypedDynamicStore<T, Id>::read(ESM::ESMReader& reader, bool overrideOnly)
     {
         if constexpr (!ESM::isESM4Rec(T::sRecordId))
@@ -1076,9 +1134,24 @@ namespace MWWorld
     {
         // DialInfos marked as deleted are kept during the loading phase, so that the linked list
         // structure is kept intact for inserting further INFOs. Delete them now that loading is done.
+        mInfoIndex.clear();
         for (auto& [_, dial] : mStatic)
+        {
             dial.setUp();
 
+            // Most of the infos of large topics are for specific actors, so only a small part has to be tested
+            InfoIndex& index = mInfoIndex[&dial];
+            std::size_t position = 0;
+            for (const ESM::DialInfo& info : dial.mInfo)
+            {
+                if (info.mActor.empty())
+                    index.mAnyActor.emplace_back(position, &info);
+                else
+                    index.mByActor[info.mActor].emplace_back(position, &info);
+                ++position;
+            }
+        }
+
         mShared.clear();
         mShared.reserve(mStatic.size());
         for (auto& [_, dial] : mStatic)
@@ -1154,6 +1227,9 @@ namespace MWWorld
 
     bool Store<ESM::Dialogue>::eraseStatic(const ESM::RefId& id)
     {
+        if (const auto it = mStatic.find(id); it != mStatic.end())
+            mInfoIndex.erase(&it->second);
+
         if (eraseFromMap(mStatic, id))
             mKeywordSearchModFlag = true;
 
@@ -1182,6 +1258,41 @@ namespace MWWorld
         return mKeywordSearch;
     }
 
+    void Store<ESM::Dialogue>::getInfos(
+        const ESM::Dialogue& dialogue, const ESM::RefId& actorId, std::vector<const ESM::DialInfo*>& infos) const
+    {
+        infos.clear();
+
+        const auto index = mInfoIndex.find(&dialogue);
+        if (index == mInfoIndex.end())
+        {
+            for (const ESM::DialInfo& info : dialogue.mInfo)
+                infos.push_back(&info);
+            return;
+        }
+
+        const InfoIndex::Infos& anyActor = index->second.mAnyActor;
+        const auto byActor = index->second.mByActor.find(actorId);
+        if (byActor == index->second.mByActor.end())
+        {
+            for (const auto& [position, info] : anyActor)
+                infos.push_back(info);
+            return;
+        }
+
+        const InfoIndex::Infos& forActor = byActor->second;
+        infos.reserve(anyActor.size() + forActor.size());
+        auto any = anyActor.begin();
+        auto actor = forActor.begin();
+        while (any != anyActor.end() || actor != forActor.end())
+        {
+            if (actor == forActor.end() || (any != anyActor.end() && any->first < actor->first))
+                infos.push_back((any++)->second);
+            else
+                infos.push_back((actor++)->second);
+        }
+    }
+
     // ESM4 Cell
     //=========================================================================
 
@@ -1269,6 +1380,86 @@ namespace MWWorld
             return nullptr;
         return foundLand->second;
     }
+
+    // ESM4 references
+    //=========================================================================
+    template <typename T>
+    void ESM4RefsStore<T>::addLazyGroup(
+        const ESM4::ReaderContext& context, ESM::RefId cellId, const OpenReader& openReader)
+    {
+        mLazyGroups[cellId].push_back(LazyGroup{ std::make_shared<const ESM4::ReaderContext>(context), openReader });
+    }
+
+    template <typename T>
+    std::span<const T* const> ESM4RefsStore<T>::getByCell(ESM::RefId cellId) const
+    {
+        const std::lock_guard lock(mMutex);
+        loadLazyGroups(cellId);
+        auto it = mPerCellReferences.find(cellId);
+        if (it == mPerCellReferences.end())
+            return {};
+        // Vectors are not changed after their lazy groups are loaded, so the span stays valid without the lock
+        return it->second;
+    }
+
+    template <typename T>
+    void ESM4RefsStore<T>::loadLazyGroups(ESM::RefId cellId) const
+    {
+        const auto groups = mLazyGroups.find(cellId);
+        if (groups == mLazyGroups.end())
+            return;
+
+        std::vector<T*>& refs = mPerCellReferences[cellId];
+        // Groups are in the load order, a later reference replaces any earlier one with the same id
+        std::unordered_map<ESM::FormId, std::size_t> indices;
+        for (std::size_t i = 0; i < refs.size(); ++i)
+            indices.emplace(refs[i]->mId, i);
+
+        for (const LazyGroup& group : groups->second)
+        {
+            const ESM4::ReaderContext& context = *group.mContext;
+            std::shared_ptr<ESM4::Reader>& reader = mReaders[context.filename];
+            try
+            {
+                if (reader == nullptr)
+                    reader = group.mOpenReader(context.filename);
+
+                // Re-reads the group header
+                reader->restoreContext(context);
+                const std::size_t end = static_cast<std::size_t>(context.filePos) + reader->hdr().group.groupSize;
+                while (reader->getFileOffset() < end && reader->getRecordHeader())
+                {
+                    const ESM4::RecordHeader& header = reader->hdr();
+                    if (header.record.typeId == ESM4::REC_GRUP)
+                    {
+                        reader->skipGroup();
+                        continue;
+                    }
+                    if (ESM::esm4Recname(static_cast<ESM4::RecordTypes>(header.record.typeId)) != T::sRecordId)
+                    {
+                        reader->skipRecordData();
+                        continue;
+                    }
+                    reader->getRecordData();
+                    T& ref = mLazyReferences.emplace_back();
+                    ref.load(*reader);
+                    const auto [index, inserted] = indices.emplace(ref.mId, refs.size());
+                    if (inserted)
+                        refs.push_back(&ref);
+                    else
+                        refs[index->second] = &ref;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to load references of cell " << cellId << " from "
+                                  << context.filename << ": " << e.what();
+                reader = nullptr;
+            }
+        }
+
+        mLazyGroups.erase(groups);
+    }
 }
 
 template class MWWorld::TypedDynamicStore<ESM::Activator>;
@@ -1317,6 +1508,9 @@ template class MWWorld::TypedDynamicStore<ESM::Weapon>;
 template class MWWorld::TypedDynamicStore<ESM4::Reference, ESM::FormId>;
 template class MWWorld::TypedDynamicStore<ESM4::ActorCharacter, ESM::FormId>;
 template class MWWorld::TypedDynamicStore<ESM4::ActorCreature, ESM::FormId>;
+template class MWWorld::ESM4RefsStore<ESM4::Reference>;
+template class MWWorld::ESM4RefsStore<ESM4::ActorCharacter>;
+template class MWWorld::ESM4RefsStore<ESM4::ActorCreature>;
 
 template class MWWorld::TypedDynamicStore<ESM4::Activator>;
 template class MWWorld::TypedDynamicStore<ESM4::Ammunition>;
@@ -1,10 +1,15 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <deque>
+#include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +42,12 @@ namespace ESM
     class ESMWriter;
 }
 
+namespace ESM4
+{
+    class Reader;
+    struct ReaderContext;
+}
+
 namespace Loading
 {
     class Listener;
@@ -53,6 +64,14 @@ namespace MWWorld
         RecordId(const ESM::RefId& id = {}, bool isDeleted = false);
     };
 
+    /// Record read from a content file but not added to a store yet, see DynamicStoreBase::decode.
+    struct DecodedRecord
+    {
+        bool mIsDeleted = false;
+
+        virtual ~DecodedRecord() = default;
+    };
+
     class StoreBase
     {
     }; // Empty interface to be parent of all store types
@@ -73,11 +92,30 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader& esm) = 0;
 
+        /// Whether records can be read by decode and added later by apply instead of load. Only for records not
+        /// depending on the state of the store and the reader beyond the content file header.
+        virtual bool isDecodable() const { return false; }
+
+        /// Read a record without modifying the store. Safe to call concurrently with anything but destruction.
+        virtual std::unique_ptr<DecodedRecord> decode(ESM::ESMReader& esm) const
+        {
+            throw std::logic_error("Store doesn't support decoding records");
+        }
+
+        /// Add a record returned by decode, same as load would.
+        virtual RecordId apply(DecodedRecord&& record)
+        {
+            throw std::logic_error("Store doesn't support decoding records");
+        }
+
         virtual bool eraseStatic(const Id& id) { return false; }
         virtual void clearDynamic() {}
 
         virtual void write(ESM::ESMWriter& writer, Loading::Listener& progress) const {}
 
+        /// Write records loaded from content files, in the order they were added. Only for decodable stores.
+        virtual void writeStatic(ESM::ESMWriter& writer) const {}
+
         virtual RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) { return RecordId(); }
         ///< Read into dynamic storage
     };
@@ -243,8 +281,15 @@ namespace MWWorld
         bool erase(const T& item);
 
         RecordId load(ESM::ESMReader& esm) override;
+        bool isDecodable() const override { return !ESM::isESM4Rec(T::sRecordId); }
+        std::unique_ptr<DecodedRecord> decode(ESM::ESMReader& esm) const override;
+        RecordId apply(DecodedRecord&& record) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
+        void writeStatic(ESM::ESMWriter& writer) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+
+    private:
+        RecordId insertLoaded(T&& record, bool isDeleted);
     };
 
     template <class T>
@@ -534,6 +579,17 @@ namespace MWWorld
         mutable bool mKeywordSearchModFlag;
         mutable MWDialogue::KeywordSearch<int /*unused*/> mKeywordSearch;
 
+        // Infos with their positions in the dialogue, split by the required actor id
+        struct InfoIndex
+        {
+            using Infos = std::vector<std::pair<std::size_t, const ESM::DialInfo*>>;
+
+            Infos mAnyActor;
+            std::unordered_map<ESM::RefId, Infos> mByActor;
+        };
+
+        std::unordered_map<const ESM::Dialogue*, InfoIndex> mInfoIndex;
+
     public:
         Store();
 
@@ -556,6 +612,11 @@ namespace MWWorld
         void listIdentifier(std::vector<ESM::RefId>& list) const override;
 
         const MWDialogue::KeywordSearch<int>& getDialogIdKeywordSearch() const;
+
+        /// Get the infos of the dialogue which don't require an actor id different from the given one, in the
+        /// dialogue order.
+        void getInfos(
+            const ESM::Dialogue& dialogue, const ESM::RefId& actorId, std::vector<const ESM::DialInfo*>& infos) const;
     };
 
     template <typename T>
@@ -578,16 +639,29 @@ namespace MWWorld
             }
         }
 
-        std::span<const T* const> getByCell(ESM::RefId cellId) const
-        {
-            auto it = mPerCellReferences.find(cellId);
-            if (it == mPerCellReferences.end())
-                return {};
-            return it->second;
-        }
+        using OpenReader = std::function<std::shared_ptr<ESM4::Reader>(const std::filesystem::path& path)>;
+
+        /// Read the references of a group only once the references of its cell are requested.
+        /// @param context Context of the reader right after reading the group header.
+        void addLazyGroup(const ESM4::ReaderContext& context, ESM::RefId cellId, const OpenReader& openReader);
+
+        /// @note May be called from any thread, loads the references of lazy groups of the cell on the first call.
+        std::span<const T* const> getByCell(ESM::RefId cellId) const;
 
     private:
-        std::unordered_map<ESM::RefId, std::vector<T*>> mPerCellReferences;
+        struct LazyGroup
+        {
+            std::shared_ptr<const ESM4::ReaderContext> mContext;
+            OpenReader mOpenReader;
+        };
+
+        mutable std::mutex mMutex;
+        mutable std::unordered_map<ESM::RefId, std::vector<T*>> mPerCellReferences;
+        mutable std::unordered_map<ESM::RefId, std::vector<LazyGroup>> mLazyGroups;
+        mutable std::deque<T> mLazyReferences;
+        mutable std::map<std::filesystem::path, std::shared_ptr<ESM4::Reader>> mReaders;
+
+        void loadLazyGroups(ESM::RefId cellId) const;
     };
 
     template <>
@@ -1,6 +1,7 @@
 #include "worldimp.hpp"
 
 #include <charconv>
+#include <optional>
 #include <vector>
 
 #include <osg/ComputeBoundsVisitor>
@@ -103,6 +104,7 @@
 #include "projectilemanager.hpp"
 #include "weather.hpp"
 
+#include "contentcache.hpp"
 #include "contentloader.hpp"
 #include "esmloader.hpp"
 
@@ -201,6 +203,14 @@ namespace MWWorld
             mLoaders.emplace(std::move(extension), &loader);
         }
 
+        void prepare(const std::filesystem::path& filepath, int index) override
+        {
+            const auto it
+                = mLoaders.find(Misc::StringUtils::lowerCase(Files::pathToUnicodeString(filepath.extension())));
+            if (it != mLoaders.end())
+                it->second->prepare(filepath, index);
+        }
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override
         {
             const auto it
@@ -274,13 +284,16 @@ namespace MWWorld
     }
 
     void World::loadData(const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles,
-        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
+        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
+        const std::filesystem::path& contentCache, const std::filesystem::path& groundcoverCache,
+        Loading::Listener* listener)
     {
         mContentFiles = contentFiles;
         mESMVersions.resize(mContentFiles.size(), -1);
+        mEncoder = encoder;
 
-        loadContentFiles(fileCollections, contentFiles, encoder, listener);
-        loadGroundcoverFiles(fileCollections, groundcoverFiles, encoder, listener);
+        loadContentFiles(fileCollections, contentFiles, encoder, contentCache, listener);
+        loadGroundcoverFiles(fileCollections, groundcoverFiles, encoder, groundcoverCache, listener);
 
         fillGlobalVariables();
 
@@ -315,7 +328,14 @@ namespace MWWorld
 
         mWeatherManager = std::make_unique<MWWorld::WeatherManager>(*mRendering, mStore);
 
-        mWorldScene = std::make_unique<Scene>(*this, *mRendering.get(), mPhysics.get(), *mNavigator);
+        mWorldScene = std::make_unique<Scene>(*this, *mRendering.get(), mPhysics.get(), *mNavigator, mEncoder);
+
+        Resource::MemoryRegistry& memoryRegistry = mResourceSystem->getMemoryRegistry();
+        memoryRegistry.add("Cells", [this] { return mWorldModel.getMemoryUsage(); });
+        memoryRegistry.add("Physics", [this] { return mPhysics->getMemoryUsage(); });
+        memoryRegistry.add("NavMesh", [this] {
+            return Resource::MemoryUsage{ .mCpu = mNavigator->getStats().mUpdater.mCache.mNavMeshCacheSize };
+        });
     }
 
     void World::fillGlobalVariables()
@@ -492,6 +512,19 @@ namespace MWWorld
         writer.endRecord(ESM::REC_CAM_);
     }
 
+    void World::writeCellsFile(ESM::ESMWriter& writer, Loading::Listener& progress)
+    {
+        for (CellStore* cellstore : mWorldScene->getActiveCells())
+            MWBase::Environment::get().getWindowManager()->writeFog(cellstore);
+
+        mWorldModel.writeCellsFile(writer, progress);
+    }
+
+    void World::clearCellsFile()
+    {
+        mWorldModel.clearCellsFile();
+    }
+
     void World::readRecord(ESM::ESMReader& reader, uint32_t type)
     {
         switch (type)
@@ -592,6 +625,11 @@ namespace MWWorld
 
     World::~World()
     {
+        Resource::MemoryRegistry& memoryRegistry = mResourceSystem->getMemoryRegistry();
+        memoryRegistry.remove("Cells");
+        memoryRegistry.remove("Physics");
+        memoryRegistry.remove("NavMesh");
+
         // Must be cleared before mRendering is destroyed
         if (mProjectileManager)
             mProjectileManager->clear();
@@ -755,7 +793,9 @@ namespace MWWorld
         // The player is not registered in any CellStore so must be checked manually
         if (actorId == getPlayerPtr().getClass().getCreatureStats(getPlayerPtr()).getActorId())
             return getPlayerPtr();
-        // Now search cells
+        // Actors in the scene are indexed by the mechanics, searching the cells is only needed for the others
+        if (Ptr ptr = MWBase::Environment::get().getMechanicsManager()->searchActorViaActorId(actorId); !ptr.isEmpty())
+            return ptr;
         return mWorldScene->searchPtrViaActorId(actorId);
     }
 
@@ -1194,6 +1234,8 @@ namespace MWWorld
             }
         }
 
+        MWBase::Environment::get().getMechanicsManager()->updatePosition(newPtr);
+
         if (isPlayer)
             mWorldScene->playerMoved(position);
         else
@@ -2629,6 +2671,16 @@ namespace MWWorld
         return mPhysics->getLineOfSight(actor, targetActor);
     }
 
+    void World::queueLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor)
+    {
+        if (!targetActor.getRefData().isEnabled() || !actor.getRefData().isEnabled())
+            return;
+        if (!targetActor.getRefData().getBaseNode() || !actor.getRefData().getBaseNode())
+            return;
+
+        mPhysics->queueLineOfSight(actor, targetActor);
+    }
+
     float World::getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater)
     {
         osg::Vec3f to(dir);
@@ -2883,6 +2935,21 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
+        for (std::size_t i = 0; i < content.size(); ++i)
+        {
+            const Files::MultiDirCollection& col = fileCollections.getCollection(Misc::getFileExtension(content[i]));
+            if (col.doesExist(content[i]))
+                gameContentLoader.prepare(col.getPath(content[i]), static_cast<int>(i));
+        }
+
+        std::optional<ContentCache> cache;
+        if (!contentCache.empty())
+        {
+            cache.emplace(contentCache);
+            esmLoader.readCache(*cache);
+            mContentKey = esmLoader.getCacheKey();
+        }
+
         int idx = 0;
         for (const std::string& file : content)
         {
@@ -2899,19 +2966,25 @@ namespace MWWorld
             idx++;
         }
 
+        // Before adding records missing in the content files
+        if (cache.has_value())
+            esmLoader.writeCache(*cache);
+
         if (const auto v = esmLoader.getMasterFileFormat(); v.has_value() && *v == 0)
             ensureNeededRecords(); // Insert records that may not be present in all versions of master files.
     }
 
     void World::loadGroundcoverFiles(const Files::Collections& fileCollections,
-        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
+        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
+        const std::filesystem::path& groundcoverCache, Loading::Listener* listener)
     {
         if (!Settings::groundcover().mEnabled)
             return;
 
         Log(Debug::Info) << "Loading groundcover:";
 
-        mGroundcoverStore.init(mStore.get<ESM::Static>(), fileCollections, groundcoverFiles, encoder, listener);
+        mGroundcoverStore.init(
+            mStore.get<ESM::Static>(), fileCollections, groundcoverFiles, encoder, listener, groundcoverCache);
     }
 
     MWWorld::SpellCastState World::startSpellCast(const Ptr& actor)
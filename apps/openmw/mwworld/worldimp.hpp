@@ -119,8 +119,13 @@ namespace MWWorld
 
         std::string mStartCell;
 
+        std::string mContentKey;
+
         float mSwimHeightScale;
 
+        // Encoding of the content files, for reading cell references again
+        const ToUTF8::Utf8Encoder* mEncoder = nullptr;
+
         float mDistanceToFocusObject;
 
         bool mTeleportEnabled;
@@ -174,11 +179,11 @@ namespace MWWorld
         void fillGlobalVariables();
 
         void loadContentFiles(const Files::Collections& fileCollections, const std::vector<std::string>& content,
-            ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener);
+            ToUTF8::Utf8Encoder* encoder, const std::filesystem::path& contentCache, Loading::Listener* listener);
 
         void loadGroundcoverFiles(const Files::Collections& fileCollections,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
-            Loading::Listener* listener);
+            const std::filesystem::path& groundcoverCache, Loading::Listener* listener);
 
         float feetToGameUnits(float feet);
         float getActivationDistancePlusTelekinesis();
@@ -197,10 +202,15 @@ namespace MWWorld
         World(Resource::ResourceSystem* resourceSystem, int activationDistanceOverride, const std::string& startCell,
             const std::filesystem::path& userDataPath);
 
+        /// @param contentCache file to keep records merged from the content files in, empty to read them every time
         void loadData(const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
+            const std::filesystem::path& contentCache, const std::filesystem::path& groundcoverCache,
             Loading::Listener* listener);
 
+        /// @return key identifying the loaded content files, empty if loadData was used without the content cache
+        const std::string& getContentKey() const { return mContentKey; }
+
         // Must be called after `loadData`.
         void init(Debug::Level maxRecastLogLevel, osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue);
@@ -219,6 +229,10 @@ namespace MWWorld
 
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
 
+        void writeCellsFile(ESM::ESMWriter& writer, Loading::Listener& progress) override;
+
+        void clearCellsFile() override;
+
         void readRecord(ESM::ESMReader& reader, uint32_t type) override;
 
         // switch to POV before showing player's death animation
@@ -507,6 +521,9 @@ namespace MWWorld
         bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        void queueLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
+        ///< request Line of Sight to be computed in background, so that a later getLOS is a cache lookup
+
         float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false) override;
 
@@ -673,6 +690,8 @@ namespace MWWorld
 
         MWRender::RenderingManager* getRenderingManager() override { return mRendering.get(); }
 
+        MWPhysics::PhysicsSystem* getPhysics() { return mPhysics.get(); }
+
         MWRender::PostProcessor* getPostProcessor() override;
 
         DateTimeManager* getTimeManager() override { return mTimeManager.get(); }
@@ -14,6 +14,8 @@
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadregn.hpp>
 #include <components/esm4/loadwrld.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/settings/values.hpp>
 
@@ -103,6 +105,16 @@ namespace MWWorld
             return std::nullopt;
         }
 
+        void openCellState(ESM::ESMReader& reader, const std::filesystem::path& name, std::string_view record,
+            ESM::FormatVersion formatVersion, const std::map<int, int>* contentFileMapping)
+        {
+            reader.openRaw(std::make_unique<Files::IMemStream>(record.data(), record.size()), name);
+            reader.setFormatVersion(formatVersion);
+            reader.setContentFileMapping(contentFileMapping);
+            reader.getRecName();
+            reader.getRecHeader();
+        }
+
         CellStore* getOrCreateExterior(const ESM::ExteriorCellLocation& location,
             std::map<ESM::ExteriorCellLocation, MWWorld::CellStore*>& exteriors, ESMStore& store,
             ESM::ReadersCache& readers, std::unordered_map<ESM::RefId, CellStore>& cells, bool triggerEvent)
@@ -139,6 +151,7 @@ MWWorld::CellStore& MWWorld::WorldModel::insertCellStore(const ESM::Cell& cell)
     else
         mExteriors.emplace(
             ESM::ExteriorCellLocation(cell.getGridX(), cell.getGridY(), ESM::Cell::sDefaultWorldspaceId), &cellStore);
+    restoreCellState(cellStore);
     return cellStore;
 }
 
@@ -148,6 +161,11 @@ void MWWorld::WorldModel::clear()
     mInteriors.clear();
     mExteriors.clear();
     mCells.clear();
+    mCellsFileHashes.clear();
+    mReadCellStates.clear();
+    mPendingCellStates.clear();
+    mPendingMovedRefSources.clear();
+    mContentFileMapping = nullptr;
     std::fill(mIdCache.begin(), mIdCache.end(), std::make_pair(ESM::RefId(), (MWWorld::CellStore*)nullptr));
     mIdCacheIndex = 0;
 }
@@ -185,6 +203,16 @@ void MWWorld::WorldModel::writeCell(ESM::ESMWriter& writer, CellStore& cell) con
     writer.endRecord(ESM::REC_CSTA);
 }
 
+std::string MWWorld::WorldModel::serializeCell(CellStore& cell, ESM::FormatVersion formatVersion) const
+{
+    ESM::ESMWriter writer;
+    writer.setFormatVersion(formatVersion);
+    writer.saveRecords();
+    writeCell(writer, cell);
+    writer.close();
+    return writer.takeData();
+}
+
 MWWorld::WorldModel::WorldModel(MWWorld::ESMStore& store, ESM::ReadersCache& readers)
     : mStore(store)
     , mReaders(readers)
@@ -198,6 +226,7 @@ namespace MWWorld
     CellStore& WorldModel::getExterior(ESM::ExteriorCellLocation location, bool forceLoad) const
     {
         CellStore* cellStore = getOrCreateExterior(location, mExteriors, mStore, mReaders, mCells, true);
+        restoreCellState(*cellStore);
 
         if (forceLoad && cellStore->getState() != CellStore::State_Loaded)
             cellStore->load();
@@ -216,6 +245,7 @@ namespace MWWorld
             if (cellStore == nullptr)
                 return cellStore;
             mInteriors.emplace(name, cellStore);
+            restoreCellState(*cellStore);
         }
         else
         {
@@ -273,6 +303,8 @@ namespace MWWorld
         else
             mInteriors.emplace(cellStore.getCell()->getNameId(), &cellStore);
 
+        restoreCellState(cellStore);
+
         if (forceLoad && cellStore.getState() != CellStore::State_Loaded)
             cellStore.load();
 
@@ -429,6 +461,7 @@ void MWWorld::WorldModel::getExteriorPtrs(const ESM::RefId& name, std::vector<MW
 
 std::vector<MWWorld::Ptr> MWWorld::WorldModel::getAll(const ESM::RefId& id)
 {
+    restorePendingCellStates();
     std::vector<Ptr> result;
     for (auto& [cellId, cellStore] : mCells)
     {
@@ -451,45 +484,130 @@ std::vector<MWWorld::Ptr> MWWorld::WorldModel::getAll(const ESM::RefId& id)
 
 int MWWorld::WorldModel::countSavedGameRecords() const
 {
-    return std::count_if(mCells.begin(), mCells.end(), [](const auto& v) { return v.second.hasState(); });
+    return std::count_if(mCells.begin(), mCells.end(), [](const auto& v) { return v.second.hasState(); })
+        + static_cast<int>(mPendingCellStates.size());
+}
+
+Resource::MemoryUsage MWWorld::WorldModel::getMemoryUsage() const
+{
+    Resource::MemoryUsage result;
+    for (const auto& [id, cell] : mCells)
+        result.mCpu += sizeof(CellStore) + cell.count() * sizeof(LiveCellRefBase);
+    for (const auto& [id, state] : mPendingCellStates)
+        result.mCpu += sizeof(state) + state.mRecord.capacity();
+    return result;
 }
 
 void MWWorld::WorldModel::write(ESM::ESMWriter& writer, Loading::Listener& progress) const
 {
+    restoreNotCopyableCellStates();
+
+    const auto writeChanged = [&](const ESM::RefId& id, std::string_view record) {
+        const auto it = mCellsFileHashes.find(id);
+        if (it == mCellsFileHashes.end() || it->second != std::hash<std::string_view>()(record))
+            writer.writeRecord(record);
+    };
+
     for (auto& [id, cellStore] : mCells)
         if (cellStore.hasState())
         {
-            writeCell(writer, cellStore);
+            if (mCellsFileHashes.empty())
+                writeCell(writer, cellStore);
+            else
+            {
+                // Compare the serialized state since objects can be changed without the cell knowing about it
+                writeChanged(id, serializeCell(cellStore, writer.getFormatVersion()));
+            }
             progress.increaseProgress();
         }
+
+    for (const auto& [id, pending] : mPendingCellStates)
+    {
+        if (mCellsFileHashes.empty())
+            writer.writeRecord(pending.mRecord);
+        else
+            writeChanged(id, pending.mRecord);
+        progress.increaseProgress();
+    }
+}
+
+void MWWorld::WorldModel::writeCellsFile(ESM::ESMWriter& writer, Loading::Listener& progress)
+{
+    restoreNotCopyableCellStates();
+
+    mCellsFileHashes.clear();
+    for (auto& [id, cellStore] : mCells)
+        if (cellStore.hasState())
+        {
+            const std::string record = serializeCell(cellStore, writer.getFormatVersion());
+            mCellsFileHashes.emplace(id, std::hash<std::string_view>()(record));
+            writer.writeRecord(record);
+            progress.increaseProgress();
+        }
+
+    for (const auto& [id, pending] : mPendingCellStates)
+    {
+        mCellsFileHashes.emplace(id, std::hash<std::string_view>()(pending.mRecord));
+        writer.writeRecord(pending.mRecord);
+        progress.increaseProgress();
+    }
 }
 
 struct MWWorld::WorldModel::GetCellStoreCallback : public CellStore::GetCellStoreCallback
 {
 public:
-    GetCellStoreCallback(WorldModel& worldModel)
+    GetCellStoreCallback(const WorldModel& worldModel)
         : mWorldModel(worldModel)
     {
     }
 
-    WorldModel& mWorldModel;
+    const WorldModel& mWorldModel;
 
     CellStore* getCellStore(const ESM::RefId& cellId) override
     {
         if (const auto* exteriorId = cellId.getIf<ESM::ESM3ExteriorCellRefId>())
         {
             ESM::ExteriorCellLocation location(exteriorId->getX(), exteriorId->getY(), ESM::Cell::sDefaultWorldspaceId);
-            return getOrCreateExterior(
+            CellStore* const cellStore = getOrCreateExterior(
                 location, mWorldModel.mExteriors, mWorldModel.mStore, mWorldModel.mReaders, mWorldModel.mCells, false);
+            mWorldModel.restoreCellState(*cellStore);
+            return cellStore;
         }
         return mWorldModel.findCell(cellId);
     }
 };
 
-bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type)
+void MWWorld::WorldModel::restoreCellState(ESM::RefId id) const
 {
-    if (type == ESM::REC_CSTA)
+    if (mPendingCellStates.empty())
+        return;
+
+    // References moved into the cell are read with the cells they were moved from
+    if (const auto it = mPendingMovedRefSources.find(id); it != mPendingMovedRefSources.end())
     {
+        const std::vector<ESM::RefId> sources = std::move(it->second);
+        mPendingMovedRefSources.erase(it);
+        for (const ESM::RefId& source : sources)
+            restoreCellState(source);
+    }
+
+    const auto it = mPendingCellStates.find(id);
+    if (it == mPendingCellStates.end())
+        return;
+
+    const PendingCellState pending = std::move(it->second);
+    mPendingCellStates.erase(it);
+    if (mPendingCellStates.empty())
+        mPendingMovedRefSources.clear();
+
+    ++mRestoringCellStates;
+
+    try
+    {
+        ESM::ESMReader reader;
+        openCellState(reader, Files::pathFromUnicodeString(id.toDebugString()), pending.mRecord,
+            pending.mFormatVersion, pending.mContentFileMapping.get());
+
         ESM::CellState state;
         state.mId = reader.getCellId();
 
@@ -498,25 +616,109 @@ bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type)
         CellStore* const cellStore = callback.getCellStore(state.mId);
 
         if (cellStore == nullptr)
-        {
             Log(Debug::Warning) << "Dropping state for cell " << state.mId << " (cell no longer exists)";
-            reader.skipRecord();
-            return true;
+        else
+        {
+            state.load(reader);
+            cellStore->loadState(state);
+
+            if (state.mHasFogOfWar)
+                cellStore->readFog(reader);
+
+            if (cellStore->getState() != CellStore::State_Loaded)
+                cellStore->load();
+
+            cellStore->readReferences(reader, &callback);
         }
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Error) << "Failed to restore state for cell " << id << ": " << e.what();
+    }
 
-        state.load(reader);
-        cellStore->loadState(state);
+    --mRestoringCellStates;
+}
 
-        if (state.mHasFogOfWar)
-            cellStore->readFog(reader);
+void MWWorld::WorldModel::restoreCellState(const CellStore& cellStore) const
+{
+    if (!mPendingCellStates.empty())
+        restoreCellState(cellStore.getCell()->getId());
+}
 
-        if (cellStore->getState() != CellStore::State_Loaded)
-            cellStore->load();
+void MWWorld::WorldModel::restorePendingCellStates() const
+{
+    while (!mPendingCellStates.empty())
+        restoreCellState(mPendingCellStates.begin()->first);
+}
+
+void MWWorld::WorldModel::restoreNotCopyableCellStates() const
+{
+    std::vector<ESM::RefId> ids;
+    for (const auto& [id, pending] : mPendingCellStates)
+        if (!pending.mCopyable)
+            ids.push_back(id);
+    for (const ESM::RefId& id : ids)
+        restoreCellState(id);
+}
+
+bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type)
+{
+    if (type != ESM::REC_CSTA)
+        return false;
 
-        cellStore->readReferences(reader, &callback);
+    const std::map<int, int>* const contentFileMapping = reader.getContentFileMapping();
+    if (contentFileMapping == nullptr)
+        mContentFileMapping = nullptr;
+    else if (mContentFileMapping == nullptr || *mContentFileMapping != *contentFileMapping)
+        mContentFileMapping = std::make_shared<const std::map<int, int>>(*contentFileMapping);
 
+    // The references are written with the indices of the content files they were read with
+    const bool sameContentFiles = contentFileMapping == nullptr
+        || std::all_of(contentFileMapping->begin(), contentFileMapping->end(),
+            [](const auto& v) { return v.first == v.second; });
+
+    PendingCellState pending{
+        .mRecord = reader.getRecord(),
+        .mFormatVersion = reader.getFormatVersion(),
+        .mContentFileMapping = mContentFileMapping,
+        .mCopyable = sameContentFiles && reader.getFormatVersion() == ESM::CurrentSaveGameFormatVersion,
+    };
+
+    ESM::ESMReader recordReader;
+    openCellState(recordReader, reader.getName(), pending.mRecord, pending.mFormatVersion, contentFileMapping);
+
+    const ESM::RefId id = recordReader.getCellId();
+
+    if (!mReadCellStates.insert(id).second)
         return true;
+
+    // Only the cells getting references moved from this one have to be known before it is restored
+    std::vector<ESM::RefId> movedTo;
+    while (recordReader.hasMoreSubs())
+    {
+        if (recordReader.isNextSub("MVRF"))
+        {
+            recordReader.cacheSubName();
+            recordReader.getFormId(true, "MVRF");
+            movedTo.push_back(recordReader.getCellId());
+        }
+        else
+        {
+            recordReader.getSubName();
+            recordReader.skipHSub();
+        }
     }
 
-    return false;
+    // Cells that already exist won't be created again
+    const bool restore = mCells.contains(id)
+        || std::any_of(movedTo.begin(), movedTo.end(), [&](const ESM::RefId& v) { return mCells.contains(v); });
+
+    for (const ESM::RefId& target : movedTo)
+        mPendingMovedRefSources[target].push_back(id);
+    mPendingCellStates.emplace(id, std::move(pending));
+
+    if (restore)
+        restoreCellState(id);
+
+    return true;
 }
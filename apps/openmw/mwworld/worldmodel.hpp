@@ -3,12 +3,17 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <components/esm/exteriorcelllocation.hpp>
+#include <components/esm3/formatversion.hpp>
 #include <components/misc/algorithm.hpp>
+#include <components/resource/memoryregistry.hpp>
 
 #include "cellstore.hpp"
 #include "ptr.hpp"
@@ -67,7 +72,17 @@ namespace MWWorld
 
         Ptr getPtrByRefId(const ESM::RefId& name);
 
-        Ptr getPtr(ESM::RefNum refNum) const { return mPtrRegistry.getOrEmpty(refNum); }
+        Ptr getPtr(ESM::RefNum refNum) const
+        {
+            Ptr ptr = mPtrRegistry.getOrEmpty(refNum);
+            if (ptr.isEmpty() && !mPendingCellStates.empty() && mRestoringCellStates == 0)
+            {
+                // The object may be in a cell with a state that is not restored yet
+                restorePendingCellStates();
+                ptr = mPtrRegistry.getOrEmpty(refNum);
+            }
+            return ptr;
+        }
 
         PtrRegistryView getPtrRegistryView() const { return PtrRegistryView(mPtrRegistry); }
 
@@ -99,13 +114,33 @@ namespace MWWorld
 
         int countSavedGameRecords() const;
 
+        /// Estimate memory of the cell stores with their references and of the cell states waiting to be restored.
+        Resource::MemoryUsage getMemoryUsage() const;
+
+        /// Write the state of the cells. After writeCellsFile only the cells with a different state are written.
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const;
 
+        /// Write the state of all cells to a file shared by the following saved games.
+        void writeCellsFile(ESM::ESMWriter& writer, Loading::Listener& progress);
+
+        void clearCellsFile() { mCellsFileHashes.clear(); }
+
+        /// @note Only the first state read for a cell is used, so a saved game has to be read before its cells file.
+        /// @note Cell states are kept as they are read and restored when their cell is first needed.
         bool readRecord(ESM::ESMReader& reader, uint32_t type);
 
     private:
         struct GetCellStoreCallback;
 
+        struct PendingCellState
+        {
+            std::string mRecord;
+            ESM::FormatVersion mFormatVersion;
+            std::shared_ptr<const std::map<int, int>> mContentFileMapping;
+            // Whether the record can be written to a saved game as it is
+            bool mCopyable;
+        };
+
         PtrRegistry mPtrRegistry; // defined before mCells because during destruction it should be the last
 
         MWWorld::ESMStore& mStore;
@@ -116,6 +151,14 @@ namespace MWWorld
         ESM::Cell mDraftCell;
         std::vector<std::pair<ESM::RefId, CellStore*>> mIdCache;
         std::size_t mIdCacheIndex = 0;
+        // Hashes of the cell states written by writeCellsFile
+        std::unordered_map<ESM::RefId, std::size_t> mCellsFileHashes;
+        std::unordered_set<ESM::RefId> mReadCellStates;
+        mutable std::unordered_map<ESM::RefId, PendingCellState> mPendingCellStates;
+        // Cells with a pending state moving references into the key cell
+        mutable std::unordered_map<ESM::RefId, std::vector<ESM::RefId>> mPendingMovedRefSources;
+        mutable std::size_t mRestoringCellStates = 0;
+        std::shared_ptr<const std::map<int, int>> mContentFileMapping;
 
         CellStore& getOrInsertCellStore(const ESM::Cell& cell);
 
@@ -124,6 +167,16 @@ namespace MWWorld
         Ptr getPtrAndCache(const ESM::RefId& name, CellStore& cellStore);
 
         void writeCell(ESM::ESMWriter& writer, CellStore& cell) const;
+
+        std::string serializeCell(CellStore& cell, ESM::FormatVersion formatVersion) const;
+
+        void restoreCellState(ESM::RefId id) const;
+
+        void restoreCellState(const CellStore& cellStore) const;
+
+        void restorePendingCellStates() const;
+
+        void restoreNotCopyableCellStates() const;
     };
 }
 
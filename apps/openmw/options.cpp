@@ -52,6 +52,9 @@ namespace OpenMW
         addOption("script-all-dialogue", bpo::value<bool>()->implicit_value(true)->default_value(false),
             "compile all dialogue scripts at startup");
 
+        addOption("warm-shaders", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "compile all shader programs used by previous runs before the first frame");
+
         addOption("script-console", bpo::value<bool>()->implicit_value(true)->default_value(false),
             "enable console-only script functionality");
 
@@ -68,6 +71,14 @@ namespace OpenMW
             "load a save game file on game startup (specify an absolute filename or a filename relative to the current "
             "working directory)");
 
+        addOption("benchmark", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "follow a route file with the player after loading the save game or starting a new game, then write a "
+            "performance report and quit");
+
+        addOption("benchmark-report",
+            bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath("benchmark.json"), "benchmark.json"),
+            "file to write the benchmark report to");
+
         addOption("skip-menu", bpo::value<bool>()->implicit_value(true)->default_value(false),
             "skip main menu on game startup");
 
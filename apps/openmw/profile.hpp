@@ -4,6 +4,8 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
+#include <components/debug/trace.hpp>
+
 #include <cstddef>
 #include <string>
 
@@ -142,6 +144,9 @@ namespace OMW
         }
 
     private:
+#ifdef OPENMW_TRACING
+        const Debug::Trace::Scope mTrace{ UserStatsValue<type>::sValue.mLabel.c_str() };
+#endif
         const osg::Timer_t mScopeStart;
         const osg::Timer_t mFrameStart;
         const unsigned int mFrameNumber;
@@ -0,0 +1,75 @@
+#include "apps/openmw/benchmark.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace OMW;
+
+    BenchmarkRoute parse(const std::string& value)
+    {
+        std::istringstream stream(value);
+        return parseBenchmarkRoute(stream);
+    }
+
+    TEST(OpenMWBenchmarkRouteTest, shouldParseWaypointsAndCommands)
+    {
+        const BenchmarkRoute route = parse("# comment\n"
+                                           "0 teleport 1 2 3 90\n"
+                                           "\n"
+                                           "5 move 4 5 6 180 -10\n"
+                                           "6 console placeatpc \"cliff racer\" 1 128 0\n"
+                                           "10 end\n");
+        ASSERT_EQ(route.mWaypoints.size(), 2);
+        EXPECT_EQ(route.mWaypoints[0].mKind, BenchmarkWaypoint::Kind::Teleport);
+        EXPECT_EQ(route.mWaypoints[0].mPosition, osg::Vec3f(1, 2, 3));
+        EXPECT_EQ(route.mWaypoints[0].mZRot, 90);
+        EXPECT_EQ(route.mWaypoints[0].mXRot, 0);
+        EXPECT_EQ(route.mWaypoints[1].mKind, BenchmarkWaypoint::Kind::Move);
+        EXPECT_EQ(route.mWaypoints[1].mTime, 5);
+        EXPECT_EQ(route.mWaypoints[1].mXRot, -10);
+        ASSERT_EQ(route.mCommands.size(), 1);
+        EXPECT_EQ(route.mCommands[0].mTime, 6);
+        EXPECT_EQ(route.mCommands[0].mCommand, "placeatpc \"cliff racer\" 1 128 0");
+        EXPECT_EQ(route.mDuration, 10);
+    }
+
+    TEST(OpenMWBenchmarkRouteTest, shouldThrowOnDecreasingTime)
+    {
+        EXPECT_THROW(parse("2 teleport 0 0 0 0\n1 move 1 1 1 0\n"), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkRouteTest, shouldThrowOnUnknownAction)
+    {
+        EXPECT_THROW(parse("0 jump\n"), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkRouteTest, shouldThrowOnEntriesAfterEnd)
+    {
+        EXPECT_THROW(parse("1 end\n2 move 0 0 0 0\n"), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkFrameTimeTest, shouldReturnEmptySummaryForNoFrames)
+    {
+        EXPECT_EQ(summarizeFrameTimes({}).mFrames, 0);
+    }
+
+    TEST(OpenMWBenchmarkFrameTimeTest, shouldComputeNearestRankPercentilesAndHitches)
+    {
+        std::vector<double> frameTimes;
+        for (int i = 1; i <= 100; ++i)
+            frameTimes.push_back(i);
+        frameTimes.push_back(200);
+        const FrameTimeSummary summary = summarizeFrameTimes(frameTimes);
+        EXPECT_EQ(summary.mFrames, 101);
+        EXPECT_EQ(summary.mP50, 51);
+        EXPECT_EQ(summary.mP99, 100);
+        EXPECT_EQ(summary.mMax, 200);
+        EXPECT_EQ(summary.mOver50Ms, 51);
+        EXPECT_EQ(summary.mOver100Ms, 1);
+    }
+}
@@ -181,3 +181,55 @@ TEST_F(KeywordSearchTest, keyword_test_single_char_strings)
     EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "a");
     EXPECT_EQ(std::string(matches[1].mBeg, matches[1].mEnd), "ab");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_keyword_inside_longer_partial_match)
+{
+    // A keyword starting inside a longer keyword which doesn't match completely should still be found
+    MWDialogue::KeywordSearch<int> search;
+    search.seed("foo bar baz", 0);
+    search.seed("bar", 1);
+
+    std::string text = "foo bar qux";
+
+    std::vector<MWDialogue::KeywordSearch<int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "bar");
+    EXPECT_EQ(matches[0].mValue, 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_seed_after_search)
+{
+    MWDialogue::KeywordSearch<int> search;
+    search.seed("dwemer", 0);
+
+    std::string text = "the dwemer ruins";
+
+    std::vector<MWDialogue::KeywordSearch<int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_EQ(matches.size(), 1);
+
+    search.seed("dwemer ruins", 1);
+
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "dwemer ruins");
+    EXPECT_EQ(matches[0].mValue, 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_contains_keyword)
+{
+    MWDialogue::KeywordSearch<int> search;
+    search.seed("Dwemer", 1);
+    search.seed("dwemer ruins", 2);
+
+    int value = 0;
+    EXPECT_TRUE(search.containsKeyword("dwemer", value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(search.containsKeyword("Dwemer Ruins", value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(search.containsKeyword("dwemer r", value));
+    EXPECT_THROW(search.seed("DWEMER", 3), std::runtime_error);
+}
@@ -0,0 +1,124 @@
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    constexpr int gridSize = 8;
+    constexpr int spacing = 100;
+
+    ESM::Pathgrid::Point makePoint(int x, int y)
+    {
+        return ESM::Pathgrid::Point(x * spacing, y * spacing, 0);
+    }
+
+    void addEdge(ESM::Pathgrid& pathgrid, size_t from, size_t to)
+    {
+        pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ from, to });
+        pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ to, from });
+    }
+
+    // Square grid of points connected to their horizontal and vertical neighbours, large enough to use landmarks
+    ESM::Pathgrid makeGrid()
+    {
+        ESM::Pathgrid pathgrid;
+        for (int y = 0; y < gridSize; ++y)
+            for (int x = 0; x < gridSize; ++x)
+                pathgrid.mPoints.push_back(makePoint(x, y));
+        for (size_t y = 0; y < gridSize; ++y)
+        {
+            for (size_t x = 0; x < gridSize; ++x)
+            {
+                const size_t index = y * gridSize + x;
+                if (x + 1 < gridSize)
+                    addEdge(pathgrid, index, index + 1);
+                if (y + 1 < gridSize)
+                    addEdge(pathgrid, index, index + gridSize);
+            }
+        }
+        return pathgrid;
+    }
+
+    bool isConnectedPath(const std::deque<ESM::Pathgrid::Point>& path)
+    {
+        for (size_t i = 1; i < path.size(); ++i)
+            if (std::abs(path[i].mX - path[i - 1].mX) + std::abs(path[i].mY - path[i - 1].mY) != spacing)
+                return false;
+        return true;
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, shouldFindShortestPathBetweenCorners)
+    {
+        const ESM::Pathgrid pathgrid = makeGrid();
+        const PathgridGraph graph(pathgrid);
+        const std::deque<ESM::Pathgrid::Point> path = graph.aStarSearch(0, gridSize * gridSize - 1);
+        ASSERT_EQ(path.size(), 2 * gridSize - 1);
+        EXPECT_EQ(path.front().mX, 0);
+        EXPECT_EQ(path.front().mY, 0);
+        EXPECT_EQ(path.back().mX, (gridSize - 1) * spacing);
+        EXPECT_EQ(path.back().mY, (gridSize - 1) * spacing);
+        EXPECT_TRUE(isConnectedPath(path));
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, shouldGoAroundMissingConnections)
+    {
+        ESM::Pathgrid pathgrid = makeGrid();
+        // Wall between the first two columns except for the last row
+        std::erase_if(pathgrid.mEdges, [](const ESM::Pathgrid::Edge& edge) {
+            const size_t from = std::min(edge.mV0, edge.mV1);
+            const size_t to = std::max(edge.mV0, edge.mV1);
+            return from % gridSize == 0 && to == from + 1 && from / gridSize != gridSize - 1;
+        });
+        const PathgridGraph graph(pathgrid);
+        const std::deque<ESM::Pathgrid::Point> path = graph.aStarSearch(0, 1);
+        EXPECT_EQ(path.size(), 2 * gridSize);
+        EXPECT_TRUE(isConnectedPath(path));
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, shouldNotFindPathBetweenDisconnectedParts)
+    {
+        ESM::Pathgrid pathgrid = makeGrid();
+        pathgrid.mPoints.push_back(makePoint(gridSize + 1, 0));
+        pathgrid.mPoints.push_back(makePoint(gridSize + 2, 0));
+        addEdge(pathgrid, gridSize * gridSize, gridSize * gridSize + 1);
+        const PathgridGraph graph(pathgrid);
+        EXPECT_FALSE(graph.isPointConnected(0, gridSize * gridSize));
+        EXPECT_TRUE(graph.isPointConnected(gridSize * gridSize, gridSize * gridSize + 1));
+        EXPECT_THAT(graph.aStarSearch(0, gridSize * gridSize), IsEmpty());
+        EXPECT_EQ(graph.aStarSearch(gridSize * gridSize, gridSize * gridSize + 1).size(), 2);
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, oneWayEdgeShouldNotConnectPoints)
+    {
+        ESM::Pathgrid pathgrid;
+        pathgrid.mPoints = { makePoint(0, 0), makePoint(1, 0) };
+        pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ 0, 1 });
+        const PathgridGraph graph(pathgrid);
+        EXPECT_FALSE(graph.isPointConnected(0, 1));
+        EXPECT_THAT(graph.aStarSearch(0, 1), IsEmpty());
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, pathToStartShouldContainSinglePoint)
+    {
+        const ESM::Pathgrid pathgrid = makeGrid();
+        const PathgridGraph graph(pathgrid);
+        EXPECT_EQ(graph.aStarSearch(5, 5).size(), 1);
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, shouldProvideNeighbours)
+    {
+        const ESM::Pathgrid pathgrid = makeGrid();
+        const PathgridGraph graph(pathgrid);
+        ESM::Pathgrid::PointList neighbours;
+        graph.getNeighbouringPoints(gridSize + 1, neighbours);
+        EXPECT_EQ(neighbours.size(), 4);
+    }
+}
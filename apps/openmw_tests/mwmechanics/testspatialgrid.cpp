@@ -0,0 +1,83 @@
+#include "apps/openmw/mwmechanics/spatialgrid.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    std::vector<int> findInRange(const SpatialGrid<int>& grid, const osg::Vec3f& position, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachInRange(position, radius, [&](int key, const osg::Vec3f&) {
+            result.push_back(key);
+            return true;
+        });
+        return result;
+    }
+
+    TEST(MWMechanicsSpatialGridTest, shouldFindKeysWithinRadius)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(10, 10, 0));
+        grid.update(2, osg::Vec3f(150, -30, 0));
+        grid.update(3, osg::Vec3f(1000, 1000, 0));
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), 200), UnorderedElementsAre(1, 2));
+    }
+
+    TEST(MWMechanicsSpatialGridTest, shouldUseDistanceInThreeDimensions)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(0, 0, 500));
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), 200), IsEmpty());
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 400), 200), ElementsAre(1));
+    }
+
+    TEST(MWMechanicsSpatialGridTest, shouldFindMovedKeysAtTheirNewPosition)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(10, 10, 0));
+        grid.update(1, osg::Vec3f(20, 20, 0));
+        grid.update(1, osg::Vec3f(-5000, 300, 0));
+        EXPECT_EQ(grid.size(), 1);
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), 100), IsEmpty());
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(-5000, 250, 0), 100), ElementsAre(1));
+    }
+
+    TEST(MWMechanicsSpatialGridTest, shouldNotFindErasedKeys)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(10, 10, 0));
+        grid.update(2, osg::Vec3f(20, 20, 0));
+        grid.erase(1);
+        grid.erase(3);
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), 100), ElementsAre(2));
+    }
+
+    TEST(MWMechanicsSpatialGridTest, shouldSupportUnboundedRadius)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(-1e6f, 1e6f, 0));
+        grid.update(2, osg::Vec3f(1e6f, -1e6f, 0));
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), std::numeric_limits<float>::max()),
+            UnorderedElementsAre(1, 2));
+    }
+
+    TEST(MWMechanicsSpatialGridTest, shouldStopWhenFunctionReturnsFalse)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(10, 10, 0));
+        grid.update(2, osg::Vec3f(20, 20, 0));
+        int calls = 0;
+        grid.forEachInRange(osg::Vec3f(0, 0, 0), 100, [&](int, const osg::Vec3f&) {
+            ++calls;
+            return false;
+        });
+        EXPECT_EQ(calls, 1);
+    }
+}
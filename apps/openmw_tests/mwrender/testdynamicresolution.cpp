@@ -0,0 +1,79 @@
+#include "apps/openmw/mwrender/dynamicresolution.hpp"
+
+#include <gtest/gtest.h>
+
+namespace MWRender
+{
+    namespace
+    {
+        constexpr unsigned framesPerUpdate = DynamicResolution::sSkippedSamples + DynamicResolution::sSampleCount;
+
+        bool renderFrames(DynamicResolution& resolution, double gpuTimeMs, unsigned count = framesPerUpdate)
+        {
+            bool changed = false;
+            for (unsigned i = 0; i < count; ++i)
+                changed = resolution.update(gpuTimeMs) || changed;
+            return changed;
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldStartAtMaximumScale)
+        {
+            const DynamicResolution resolution(10, 0.5f, 0.9f);
+            EXPECT_EQ(resolution.getScale(), 0.9f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldKeepScaleWithinTarget)
+        {
+            DynamicResolution resolution(10, 0.5f, 1);
+            EXPECT_FALSE(renderFrames(resolution, 9.5));
+            EXPECT_EQ(resolution.getScale(), 1);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldWaitForEnoughFramesBeforeChangingScale)
+        {
+            DynamicResolution resolution(10, 0.5f, 1);
+            EXPECT_FALSE(renderFrames(resolution, 40, framesPerUpdate - 1));
+            EXPECT_TRUE(resolution.update(40));
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldReduceScaleByPixelCount)
+        {
+            DynamicResolution resolution(10, 0.1f, 1);
+            EXPECT_TRUE(renderFrames(resolution, 40));
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.5f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldReduceScaleByAtLeastOneStepWhenTooSlow)
+        {
+            DynamicResolution resolution(10, 0.5f, 1);
+            EXPECT_TRUE(renderFrames(resolution, 10.1));
+            EXPECT_FLOAT_EQ(resolution.getScale(), 1 - DynamicResolution::sStep);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldNotGoBelowMinimumScale)
+        {
+            DynamicResolution resolution(10, 0.6f, 1);
+            EXPECT_TRUE(renderFrames(resolution, 100));
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.6f);
+            EXPECT_FALSE(renderFrames(resolution, 100));
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.6f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldIncreaseScaleWhenWellBelowTarget)
+        {
+            DynamicResolution resolution(10, 0.1f, 1);
+            renderFrames(resolution, 40);
+            ASSERT_FLOAT_EQ(resolution.getScale(), 0.5f);
+            EXPECT_TRUE(renderFrames(resolution, 2));
+            EXPECT_GT(resolution.getScale(), 0.5f);
+            EXPECT_LE(resolution.getScale(), 1);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldNotGoAboveMaximumScale)
+        {
+            DynamicResolution resolution(10, 0.5f, 0.8f);
+            EXPECT_FALSE(renderFrames(resolution, 1));
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.8f);
+        }
+    }
+}
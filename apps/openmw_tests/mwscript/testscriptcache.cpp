@@ -0,0 +1,66 @@
+#include "apps/openmw/mwscript/scriptcache.hpp"
+
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWScript;
+
+    ScriptCache::Entry makeEntry()
+    {
+        ScriptCache::Entry entry;
+        entry.mId = ESM::RefId::stringRefId("script");
+        entry.mSourceHash = ScriptCache::getSourceHash("begin script\nend");
+        entry.mProgram.mInstructions = { 1, 2, 3 };
+        entry.mProgram.mIntegers = { -4 };
+        entry.mProgram.mFloats = { 0.5f, 1.5f };
+        entry.mProgram.mStrings = { "first", "", "third" };
+        entry.mLocals.declare('s', "short");
+        entry.mLocals.declare('f', "float");
+        entry.mLocals.declare('l', "long1");
+        entry.mLocals.declare('l', "long2");
+        return entry;
+    }
+
+    TEST(MWScriptScriptCacheTest, shouldReadWrittenScripts)
+    {
+        const ScriptCache cache(TestingOpenMW::outputFilePath("scripts.omwcache"));
+        const std::string key = ScriptCache::makeKey("content", 1);
+        const std::array entries{ makeEntry() };
+        cache.write(key, entries);
+
+        const std::vector<ScriptCache::Entry> result = cache.read(key);
+        ASSERT_EQ(result.size(), 1);
+        const ScriptCache::Entry& entry = result.front();
+        EXPECT_EQ(entry.mId, entries[0].mId);
+        EXPECT_EQ(entry.mSourceHash, entries[0].mSourceHash);
+        EXPECT_EQ(entry.mProgram.mInstructions, entries[0].mProgram.mInstructions);
+        EXPECT_EQ(entry.mProgram.mIntegers, entries[0].mProgram.mIntegers);
+        EXPECT_EQ(entry.mProgram.mFloats, entries[0].mProgram.mFloats);
+        EXPECT_EQ(entry.mProgram.mStrings, entries[0].mProgram.mStrings);
+        EXPECT_EQ(entry.mLocals.get('s'), entries[0].mLocals.get('s'));
+        EXPECT_EQ(entry.mLocals.get('l'), entries[0].mLocals.get('l'));
+        EXPECT_EQ(entry.mLocals.get('f'), entries[0].mLocals.get('f'));
+    }
+
+    TEST(MWScriptScriptCacheTest, shouldIgnoreCacheWithDifferentKey)
+    {
+        const ScriptCache cache(TestingOpenMW::outputFilePath("scriptsKey.omwcache"));
+        const std::array entries{ makeEntry() };
+        cache.write(ScriptCache::makeKey("content", 1), entries);
+
+        EXPECT_TRUE(cache.read(ScriptCache::makeKey("content", 2)).empty());
+        EXPECT_TRUE(cache.read(ScriptCache::makeKey("otherContent", 1)).empty());
+    }
+
+    TEST(MWScriptScriptCacheTest, sourceHashShouldDependOnSource)
+    {
+        EXPECT_EQ(ScriptCache::getSourceHash("begin a\nend"), ScriptCache::getSourceHash("begin a\nend"));
+        EXPECT_NE(ScriptCache::getSourceHash("begin a\nend"), ScriptCache::getSourceHash("begin b\nend"));
+    }
+}
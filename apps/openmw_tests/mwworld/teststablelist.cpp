@@ -0,0 +1,136 @@
+#include "apps/openmw/mwworld/stablelist.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    std::vector<int> toVector(const StableList<int>& list)
+    {
+        return std::vector<int>(list.begin(), list.end());
+    }
+
+    StableList<int> makeList(int count)
+    {
+        StableList<int> list;
+        for (int i = 0; i < count; ++i)
+            list.push_back(i);
+        return list;
+    }
+
+    TEST(MWWorldStableListTest, emptyListShouldHaveNoValues)
+    {
+        const StableList<int> list;
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.size(), 0);
+        EXPECT_EQ(list.begin(), list.end());
+    }
+
+    TEST(MWWorldStableListTest, shouldIterateInInsertionOrder)
+    {
+        const StableList<int> list = makeList(100);
+        EXPECT_EQ(list.size(), 100);
+        EXPECT_EQ(list.front(), 0);
+        EXPECT_EQ(list.back(), 99);
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_EQ(toVector(list), expected);
+    }
+
+    TEST(MWWorldStableListTest, valuesShouldNotMoveWhenAddingMore)
+    {
+        StableList<int> list;
+        const int* const first = &list.emplace_back(42);
+        const StableList<int>::iterator firstIt = list.begin();
+        for (int i = 0; i < 1000; ++i)
+            list.push_back(i);
+        EXPECT_EQ(&list.front(), first);
+        EXPECT_EQ(firstIt, list.begin());
+        EXPECT_EQ(*first, 42);
+    }
+
+    TEST(MWWorldStableListTest, eraseShouldSkipErasedValuesAndReturnNext)
+    {
+        StableList<int> list = makeList(10);
+        auto it = std::find(list.begin(), list.end(), 3);
+        it = list.erase(it);
+        EXPECT_EQ(*it, 4);
+        list.erase(list.begin());
+        list.erase(std::prev(list.end()));
+        EXPECT_EQ(list.size(), 7);
+        EXPECT_THAT(toVector(list), ElementsAre(1, 2, 4, 5, 6, 7, 8));
+        EXPECT_EQ(list.front(), 1);
+        EXPECT_EQ(list.back(), 8);
+    }
+
+    TEST(MWWorldStableListTest, valuesAddedAfterEraseShouldBeLast)
+    {
+        StableList<int> list = makeList(3);
+        list.erase(std::next(list.begin()));
+        list.push_back(3);
+        EXPECT_THAT(toVector(list), ElementsAre(0, 2, 3));
+    }
+
+    TEST(MWWorldStableListTest, shouldIterateBackwards)
+    {
+        StableList<int> list = makeList(20);
+        list.erase(std::find(list.begin(), list.end(), 18));
+        std::vector<int> values;
+        for (auto it = list.end(); it != list.begin();)
+            values.push_back(*--it);
+        EXPECT_EQ(values.size(), 19);
+        EXPECT_EQ(values.front(), 19);
+        EXPECT_EQ(values[1], 17);
+        EXPECT_EQ(values.back(), 0);
+    }
+
+    TEST(MWWorldStableListTest, copyShouldHaveSameValues)
+    {
+        StableList<int> list = makeList(10);
+        list.erase(list.begin());
+        const StableList<int> copy(list);
+        EXPECT_EQ(toVector(copy), toVector(list));
+        EXPECT_EQ(copy.size(), list.size());
+        EXPECT_NE(&copy.front(), &list.front());
+    }
+
+    TEST(MWWorldStableListTest, moveShouldKeepValuesInPlace)
+    {
+        StableList<int> list = makeList(10);
+        const int* const first = &list.front();
+        const StableList<int> moved(std::move(list));
+        EXPECT_EQ(&moved.front(), first);
+        EXPECT_EQ(moved.size(), 10);
+        EXPECT_TRUE(list.empty());
+    }
+
+    TEST(MWWorldStableListTest, iteratorToShouldFindValueByAddress)
+    {
+        StableList<int> list = makeList(100);
+        for (auto it = list.begin(); it != list.end(); ++it)
+            EXPECT_EQ(list.iteratorTo(*it), it);
+        const int other = 42;
+        EXPECT_EQ(list.iteratorTo(other), list.end());
+        const int* const erased = &*std::next(list.begin(), 50);
+        list.erase(std::next(list.begin(), 50));
+        EXPECT_EQ(list.iteratorTo(*erased), list.end());
+    }
+
+    TEST(MWWorldStableListTest, iteratorShouldBeComparableWithConstIterator)
+    {
+        StableList<int> list = makeList(2);
+        const StableList<int>::iterator it = list.begin();
+        const StableList<int>::const_iterator constIt = it;
+        EXPECT_EQ(it, constIt);
+        EXPECT_EQ(constIt, it);
+        EXPECT_NE(std::next(it), constIt);
+    }
+}
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <array>
 #include <fstream>
+#include <memory>
+#include <sstream>
 #include <span>
 
 #include <boost/program_options/options_description.hpp>
@@ -419,6 +421,110 @@ TYPED_TEST_P(StoreTest, overwrite_test)
     }
 }
 
+/// Load a file containing the record using records decoded from another reader of the same file.
+template <typename T>
+static void loadDecoded(MWWorld::ESMStore& esmStore, const T& record, bool deleted, ESM::FormatVersion formatVersion,
+    ESM::Dialogue*& dialogue)
+{
+    ESM::ESMReader decodeReader;
+    decodeReader.open(getEsmFile(record, deleted, formatVersion), "filename");
+    MWWorld::DecodedContentFile decoded = esmStore.decode(decodeReader);
+    ASSERT_EQ(decoded.mRecords.size(), 1);
+
+    ESM::ESMReader reader;
+    reader.open(getEsmFile(record, deleted, formatVersion), "filename");
+    esmStore.load(reader, &dummyListener, dialogue, &decoded);
+}
+
+/// Tests that loading decoded records overwrites and deletes the same way as loading them directly.
+TYPED_TEST_P(StoreTest, decoded_load_test)
+{
+    using RecordType = TypeParam;
+
+    for (const ESM::FormatVersion formatVersion : getFormats())
+    {
+        SCOPED_TRACE("FormatVersion: " + std::to_string(formatVersion));
+        const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+        RecordType record;
+        if constexpr (hasBlankFunction<RecordType>)
+            record.blank();
+        record.mId = recordId;
+
+        ESM::Dialogue* dialogue = nullptr;
+
+        {
+            MWWorld::ESMStore esmStore;
+            loadDecoded(esmStore, record, false, formatVersion, dialogue);
+            RecordType changed = record;
+            changed.mModel = "the_new_model";
+            loadDecoded(esmStore, changed, false, formatVersion, dialogue);
+            esmStore.setUp();
+
+            const RecordType* overwrittenRec = esmStore.get<RecordType>().search(recordId);
+            ASSERT_NE(overwrittenRec, nullptr);
+            EXPECT_EQ(overwrittenRec->mModel, "the_new_model");
+            EXPECT_EQ(esmStore.get<RecordType>().getSize(), 1);
+        }
+        {
+            MWWorld::ESMStore esmStore;
+            loadDecoded(esmStore, record, false, formatVersion, dialogue);
+            loadDecoded(esmStore, record, true, formatVersion, dialogue);
+            esmStore.setUp();
+
+            EXPECT_EQ(esmStore.get<RecordType>().getSize(), 0);
+        }
+    }
+}
+
+/// Tests that records written by writeDecodable and loaded back give the same store when the content files are loaded
+/// skipping them.
+TYPED_TEST_P(StoreTest, cached_load_test)
+{
+    using RecordType = TypeParam;
+
+    const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+    RecordType record;
+    if constexpr (hasBlankFunction<RecordType>)
+        record.blank();
+    record.mId = recordId;
+    RecordType changed = record;
+    changed.mModel = "the_new_model";
+
+    ESM::Dialogue* dialogue = nullptr;
+    ESM::ESMReader reader;
+
+    std::stringstream cache;
+    {
+        MWWorld::ESMStore esmStore;
+        reader.open(getEsmFile(record, false, ESM::CurrentContentFormatVersion), "master");
+        esmStore.load(reader, &dummyListener, dialogue);
+        reader.open(getEsmFile(changed, false, ESM::CurrentContentFormatVersion), "plugin");
+        esmStore.load(reader, &dummyListener, dialogue);
+
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+        writer.save(cache);
+        esmStore.writeDecodable(writer);
+        writer.close();
+    }
+
+    MWWorld::ESMStore esmStore;
+    reader.open(std::make_unique<std::istringstream>(cache.str()), "cache");
+    esmStore.load(reader, &dummyListener, dialogue);
+    reader.open(getEsmFile(record, false, ESM::CurrentContentFormatVersion), "master");
+    esmStore.load(reader, &dummyListener, dialogue, nullptr, true);
+    reader.open(getEsmFile(changed, false, ESM::CurrentContentFormatVersion), "plugin");
+    esmStore.load(reader, &dummyListener, dialogue, nullptr, true);
+    esmStore.setUp();
+
+    const RecordType* cachedRec = esmStore.get<RecordType>().search(recordId);
+    ASSERT_NE(cachedRec, nullptr);
+    EXPECT_EQ(cachedRec->mModel, "the_new_model");
+    EXPECT_EQ(esmStore.get<RecordType>().getSize(), 1);
+}
+
 namespace
 {
     using namespace ::testing;
@@ -580,7 +686,7 @@ namespace
         RecordTypesTest, StoreSaveLoadTest, typename AsTestingTypes<RecordTypesWithSave>::Type);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test);
+REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test, decoded_load_test, cached_load_test);
 
 static_assert(std::tuple_size_v<RecordTypesWithModel> == 19);
 
@@ -868,4 +974,28 @@ namespace
         ASSERT_NE(dialogue, nullptr);
         EXPECT_THAT(dialogue->mInfo, ElementsAre(HasIdEqualTo("info0"), HasIdEqualTo("info2")));
     }
+
+    TEST(MWWorldStoreTest, getInfosShouldReturnInfosForAnyAndGivenActorInDialogueOrder)
+    {
+        DialogueData data = generateDialogueWithInfos(4);
+        data.mInfos[1].mActor = ESM::RefId::stringRefId("actor");
+        data.mInfos[3].mActor = ESM::RefId::stringRefId("otherActor");
+
+        MWWorld::ESMStore esmStore;
+        loadEsmStore(0, saveDialogueWithInfos(data.mDialogue, data.mInfos), esmStore);
+        esmStore.setUp();
+
+        const MWWorld::Store<ESM::Dialogue>& store = esmStore.get<ESM::Dialogue>();
+        const ESM::Dialogue* dialogue = store.search(ESM::RefId::stringRefId("dialogue"));
+        ASSERT_NE(dialogue, nullptr);
+
+        std::vector<const ESM::DialInfo*> infos;
+        store.getInfos(*dialogue, ESM::RefId::stringRefId("actor"), infos);
+        EXPECT_THAT(infos,
+            ElementsAre(
+                Pointee(HasIdEqualTo("info0")), Pointee(HasIdEqualTo("info1")), Pointee(HasIdEqualTo("info2"))));
+
+        store.getInfos(*dialogue, ESM::RefId::stringRefId("unknownActor"), infos);
+        EXPECT_THAT(infos, ElementsAre(Pointee(HasIdEqualTo("info0")), Pointee(HasIdEqualTo("info2"))));
+    }
 }
@@ -6,16 +6,16 @@
 #include <filesystem>
 #include <format>
 #include <istream>
-
-#include <zlib.h>
+#include <span>
 
 #include <components/esm/fourcc.hpp>
-#include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/strings/lower.hpp>
 
 #include "ba2file.hpp"
+#include "decompression.hpp"
 #include "memorystream.hpp"
 
 namespace Bsa
@@ -629,7 +629,9 @@ namespace Bsa
 
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(textureSize);
         char* buff = memoryStreamPtr->getRawData();
-        std::vector<char> inputBuffer(maxPackedChunkSize);
+        std::vector<char>& inputBuffer = getScratchBuffer();
+        if (mMapping == nullptr)
+            inputBuffer.reserve(maxPackedChunkSize);
 
         uint32_t dds = ESM::fourCC("DDS ");
         buff = (char*)std::memcpy(buff, &dds, sizeof(uint32_t)) + sizeof(uint32_t);
@@ -640,21 +642,16 @@ namespace Bsa
         for (const auto& c : fileRecord.texturesChunks)
         {
             const uint32_t inputSize = c.packedSize != 0 ? c.packedSize : c.size;
-            Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+            const std::span<const char> data = readData(c.offset, inputSize, inputBuffer);
             if (c.packedSize != 0)
             {
-                streamPtr->read(inputBuffer.data(), c.packedSize);
-                uLongf destSize = static_cast<uLongf>(c.size);
-                int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData() + offset), &destSize,
-                    reinterpret_cast<Bytef*>(inputBuffer.data()), static_cast<uLong>(c.packedSize));
-
-                if (ec != Z_OK)
-                    fail("zlib uncompress failed: " + std::string(::zError(ec)));
+                if (const char* error = inflateZlib(data, std::span(memoryStreamPtr->getRawData() + offset, c.size)))
+                    fail("zlib uncompress failed: " + std::string(error));
             }
             // uncompressed chunk
             else
             {
-                streamPtr->read(memoryStreamPtr->getRawData() + offset, c.size);
+                std::memcpy(memoryStreamPtr->getRawData() + offset, data.data(), data.size());
             }
             offset += c.size;
         }
@@ -2,19 +2,20 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <fstream>
-
-#include <zlib.h>
+#include <span>
 
 #include <components/esm/fourcc.hpp>
-#include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/strings/lower.hpp>
 
 #include "ba2file.hpp"
+#include "decompression.hpp"
 #include "memorystream.hpp"
 
 namespace Bsa
@@ -196,22 +197,18 @@ namespace Bsa
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
         const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
+        if (!fileRecord.packedSize && mMapping != nullptr)
+            return openData(fileRecord.offset, inputSize);
+        const std::span<const char> data = readData(fileRecord.offset, inputSize, getScratchBuffer());
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
         if (fileRecord.packedSize)
         {
-            std::vector<char> buffer(inputSize);
-            streamPtr->read(buffer.data(), inputSize);
-            uLongf destSize = static_cast<uLongf>(fileRecord.size);
-            int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
-
-            if (ec != Z_OK)
-                fail("zlib uncompress failed: " + std::string(::zError(ec)));
+            if (const char* error = inflateZlib(data, std::span(memoryStreamPtr->getRawData(), fileRecord.size)))
+                fail("zlib uncompress failed: " + std::string(error));
         }
         else
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), fileRecord.size);
+            std::memcpy(memoryStreamPtr->getRawData(), data.data(), data.size());
         }
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
@@ -36,6 +36,9 @@
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/utils.hpp>
+#include <components/platform/file.hpp>
+
+#include "memorystream.hpp"
 
 using namespace Bsa;
 
@@ -265,9 +268,21 @@ void BSAFile::open(const std::filesystem::path& file)
     mFilepath = file;
     if (std::filesystem::exists(file))
     {
-        std::ifstream input(mFilepath, std::ios_base::binary);
-        readHeader(input);
+        {
+            std::ifstream input(mFilepath, std::ios_base::binary);
+            readHeader(input);
+        }
         mIsLoaded = true;
+
+        try
+        {
+            mMapping = std::make_shared<const Platform::File::ScopedMapping>(mFilepath);
+        }
+        catch (const std::exception&)
+        {
+            // Fall back to reading through file streams
+            mMapping = nullptr;
+        }
     }
     else
     {
@@ -287,12 +302,37 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMapping = nullptr;
     mIsLoaded = false;
 }
 
+std::span<const char> Bsa::BSAFile::readData(std::size_t offset, std::size_t size, std::vector<char>& buffer) const
+{
+    if (mMapping != nullptr)
+    {
+        if (offset > mMapping->size() || size > mMapping->size() - offset)
+            fail(std::format("Data range {}+{} is outside of the archive", offset, size));
+        return std::span<const char>(mMapping->data() + offset, size);
+    }
+
+    buffer.resize(size);
+    Files::openConstrainedFileStream(mFilepath, offset, size)->read(buffer.data(), size);
+    return buffer;
+}
+
+Files::IStreamPtr Bsa::BSAFile::openData(std::size_t offset, std::size_t size) const
+{
+    if (mMapping == nullptr)
+        return Files::openConstrainedFileStream(mFilepath, offset, size);
+
+    if (offset > mMapping->size() || size > mMapping->size() - offset)
+        fail(std::format("Data range {}+{} is outside of the archive", offset, size));
+    return std::make_unique<MappedInputStream>(mMapping, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->mOffset, file->mFileSize);
+    return openData(file->mOffset, file->mFileSize);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -300,6 +340,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // The archive is about to be rewritten, streams opened before keep the old mapping
+    mMapping = nullptr;
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
@@ -27,11 +27,14 @@
 #include <cstdint>
 #include <filesystem>
 #include <iosfwd>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
@@ -92,9 +95,20 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Whole archive mapped into memory, null when the platform can't map it
+        std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
+        /// Get a range of the archive, straight from the mapping when there is one, otherwise read into buffer.
+        /// @note Thread safe.
+        std::span<const char> readData(std::size_t offset, std::size_t size, std::vector<char>& buffer) const;
+
+        /// Open a stream over a range of the archive, without copying the data when the archive is mapped.
+        /// @note Thread safe.
+        Files::IStreamPtr openData(std::size_t offset, std::size_t size) const;
+
         /// Read header information from the input source
         virtual void readHeader(std::istream& input);
         virtual void writeHeader();
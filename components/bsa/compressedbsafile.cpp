@@ -27,19 +27,19 @@
 #include <algorithm>
 #include <cassert>
 #include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <istream>
+#include <span>
 #include <system_error>
 
-#include <lz4frame.h>
-#include <zlib.h>
-
-#include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/strings/lower.hpp>
 
+#include "decompression.hpp"
 #include "memorystream.hpp"
 
 namespace Bsa
@@ -276,62 +276,54 @@ namespace Bsa
     {
         size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
         size_t resultSize = size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.mOffset, size);
+        std::span<const char> data = readData(fileRecord.mOffset, size, getScratchBuffer());
         bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
         if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
             // Skip over the embedded file name
-            uint8_t length = 0;
-            streamPtr->read(reinterpret_cast<char*>(&length), 1);
-            streamPtr->ignore(length);
-            size -= length + sizeof(uint8_t);
+            if (data.empty() || data.size() < sizeof(uint8_t) + static_cast<uint8_t>(data.front()))
+                fail("Embedded file name is longer than the file record");
+            data = data.subspan(sizeof(uint8_t) + static_cast<uint8_t>(data.front()));
         }
         if (compressed)
         {
-            streamPtr->read(reinterpret_cast<char*>(&resultSize), sizeof(uint32_t));
-            size -= sizeof(uint32_t);
+            uint32_t value = 0;
+            if (data.size() < sizeof(uint32_t))
+                fail("Compressed file record is too small");
+            std::memcpy(&value, data.data(), sizeof(uint32_t));
+            resultSize = value;
+            data = data.subspan(sizeof(uint32_t));
+        }
+        else if (mMapping != nullptr)
+        {
+            const std::size_t skipped = size - data.size();
+            return openData(fileRecord.mOffset + skipped, data.size());
         }
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(resultSize);
 
         if (compressed)
         {
-            std::vector<char> buffer(size);
-            streamPtr->read(buffer.data(), size);
-
+            const std::span<char> output(memoryStreamPtr->getRawData(), resultSize);
             if (mHeader.mVersion != Version_SSE)
             {
-                uLongf destSize = static_cast<uLongf>(resultSize);
-                int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                    reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
-
-                if (ec != Z_OK)
+                if (const char* error = inflateZlib(data, output))
                 {
                     std::string message = "zlib uncompress failed for file ";
                     message.append(fileRecord.mName.begin(), fileRecord.mName.end());
                     message += ": ";
-                    message += ::zError(ec);
+                    message += error;
                     fail(message);
                 }
             }
             else
             {
-                LZ4F_decompressionContext_t context = nullptr;
-                LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-                LZ4F_decompressOptions_t options = {};
-                LZ4F_errorCode_t errorCode = LZ4F_decompress(
-                    context, memoryStreamPtr->getRawData(), &resultSize, buffer.data(), &size, &options);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-                errorCode = LZ4F_freeDecompressionContext(context);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
+                if (const char* error = decompressLZ4Frame(data, output))
+                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath) + "): " + error);
             }
         }
         else
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), size);
+            std::memcpy(memoryStreamPtr->getRawData(), data.data(), data.size());
         }
 
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
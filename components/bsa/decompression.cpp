@@ -0,0 +1,132 @@
+#include "decompression.hpp"
+
+#include <limits>
+
+#include <lz4frame.h>
+#include <zlib.h>
+
+namespace Bsa
+{
+    namespace
+    {
+        // Entries bigger than this are rare, don't keep their buffers around
+        constexpr std::size_t maxRetainedScratchBufferSize = 16 * 1024 * 1024;
+
+        class ZlibInflater
+        {
+        public:
+            ZlibInflater() { mInitResult = inflateInit(&mStream); }
+
+            ~ZlibInflater()
+            {
+                if (mInitResult == Z_OK)
+                    inflateEnd(&mStream);
+            }
+
+            ZlibInflater(const ZlibInflater&) = delete;
+            ZlibInflater& operator=(const ZlibInflater&) = delete;
+
+            int inflate(std::span<const char> input, std::span<char> output)
+            {
+                if (mInitResult != Z_OK)
+                    return mInitResult;
+
+                if (input.size() > std::numeric_limits<uInt>::max() || output.size() > std::numeric_limits<uInt>::max())
+                    return Z_BUF_ERROR;
+
+                if (const int ec = inflateReset(&mStream); ec != Z_OK)
+                    return ec;
+
+                mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+                mStream.avail_in = static_cast<uInt>(input.size());
+                mStream.next_out = reinterpret_cast<Bytef*>(output.data());
+                mStream.avail_out = static_cast<uInt>(output.size());
+
+                // Same result codes as ::uncompress
+                const int ec = ::inflate(&mStream, Z_FINISH);
+                if (ec == Z_STREAM_END)
+                    return Z_OK;
+                if (ec == Z_NEED_DICT || (ec == Z_BUF_ERROR && mStream.avail_in == 0))
+                    return Z_DATA_ERROR;
+                return ec;
+            }
+
+        private:
+            z_stream mStream{};
+            int mInitResult;
+        };
+
+        class LZ4Decompressor
+        {
+        public:
+            LZ4Decompressor() = default;
+
+            ~LZ4Decompressor() { reset(); }
+
+            LZ4Decompressor(const LZ4Decompressor&) = delete;
+            LZ4Decompressor& operator=(const LZ4Decompressor&) = delete;
+
+            const char* decompress(std::span<const char> input, std::span<char> output)
+            {
+                if (mContext == nullptr)
+                {
+                    const LZ4F_errorCode_t errorCode = LZ4F_createDecompressionContext(&mContext, LZ4F_VERSION);
+                    if (LZ4F_isError(errorCode))
+                    {
+                        mContext = nullptr;
+                        return LZ4F_getErrorName(errorCode);
+                    }
+                }
+
+                std::size_t outputSize = output.size();
+                std::size_t inputSize = input.size();
+                LZ4F_decompressOptions_t options = {};
+                const std::size_t result
+                    = LZ4F_decompress(mContext, output.data(), &outputSize, input.data(), &inputSize, &options);
+                if (LZ4F_isError(result))
+                {
+                    // The context is left in an undefined state
+                    reset();
+                    return LZ4F_getErrorName(result);
+                }
+                // A non zero hint means the frame is incomplete, don't let its state leak into the next one
+                if (result != 0)
+                    reset();
+                return nullptr;
+            }
+
+        private:
+            LZ4F_decompressionContext_t mContext = nullptr;
+
+            void reset()
+            {
+                if (mContext != nullptr)
+                    LZ4F_freeDecompressionContext(mContext);
+                mContext = nullptr;
+            }
+        };
+    }
+
+    const char* inflateZlib(std::span<const char> input, std::span<char> output)
+    {
+        thread_local ZlibInflater inflater;
+        const int ec = inflater.inflate(input, output);
+        if (ec != Z_OK)
+            return ::zError(ec);
+        return nullptr;
+    }
+
+    const char* decompressLZ4Frame(std::span<const char> input, std::span<char> output)
+    {
+        thread_local LZ4Decompressor decompressor;
+        return decompressor.decompress(input, output);
+    }
+
+    std::vector<char>& getScratchBuffer()
+    {
+        thread_local std::vector<char> buffer;
+        if (buffer.capacity() > maxRetainedScratchBufferSize)
+            std::vector<char>().swap(buffer);
+        return buffer;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef OPENMW_COMPONENTS_BSA_DECOMPRESSION_HPP
+#define OPENMW_COMPONENTS_BSA_DECOMPRESSION_HPP
+
+#include <span>
+#include <vector>
+
+namespace Bsa
+{
+    /// Inflate a zlib stream into output using a decompressor owned by the calling thread.
+    /// @return nullptr on success, otherwise an error description.
+    const char* inflateZlib(std::span<const char> input, std::span<char> output);
+
+    /// Decompress a single LZ4 frame into output using a context owned by the calling thread.
+    /// @return nullptr on success, otherwise an error description.
+    const char* decompressLZ4Frame(std::span<const char> input, std::span<char> output);
+
+    /// Get a buffer owned by the calling thread to read compressed data into when an archive is not mapped.
+    /// @note Contents are only valid until the next call from the same thread.
+    std::vector<char>& getScratchBuffer();
+}
+
+#endif
@@ -27,9 +27,11 @@
 #define OPENMW_COMPONENTS_BSA_MEMORYSTREAM_HPP
 
 #include <istream>
+#include <memory>
 #include <vector>
 
 #include <components/files/memorystream.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
@@ -54,5 +56,25 @@ namespace Bsa
         char* getRawData() { return this->data(); }
     };
 
+    /**
+        Reads a range of a memory mapped archive without copying it.
+
+        Keeps the mapping alive for as long as the stream exists, so the archive may be closed in the meantime.
+     */
+    class MappedInputStream : public Files::MemBuf, public std::istream
+    {
+    public:
+        explicit MappedInputStream(
+            std::shared_ptr<const Platform::File::ScopedMapping> mapping, std::size_t offset, std::size_t size)
+            : Files::MemBuf(mapping->data() + offset, size)
+            , std::istream(static_cast<std::streambuf*>(this))
+            , mMapping(std::move(mapping))
+        {
+        }
+
+    private:
+        std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+    };
+
 }
 #endif
@@ -330,6 +330,8 @@ namespace Compiler
         const int opcodeHelp = 0x2000320;
         const int opcodeReloadLua = 0x2000321;
         const int opcodeTestModels = 0x2000325;
+        const int opcodeLuaProfile = 0x2000327;
+        const int opcodeReportMemory = 0x2000328;
     }
 
     namespace Sky
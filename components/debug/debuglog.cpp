@@ -1,11 +1,56 @@
 #include "debuglog.hpp"
 
 #include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
 
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/conversion.hpp>
 
-static std::mutex sLock;
+namespace
+{
+    std::mutex sLock;
+
+    class StringBuffer final : public std::streambuf
+    {
+    public:
+        std::string mData;
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                mData.push_back(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize count) override
+        {
+            mData.append(s, static_cast<std::size_t>(count));
+            return count;
+        }
+    };
+
+    thread_local bool sThreadBufferDestroyed = false;
+
+    struct ThreadBuffer
+    {
+        StringBuffer mBuffer;
+        std::ostream mStream{ &mBuffer };
+
+        ~ThreadBuffer() { sThreadBufferDestroyed = true; }
+    };
+
+    // nullptr when logging from destructors of static objects, after the buffer of the main thread is gone
+    ThreadBuffer* getThreadBuffer()
+    {
+        if (sThreadBufferDestroyed)
+            return nullptr;
+        thread_local ThreadBuffer buffer;
+        return &buffer;
+    }
+}
 
 Debug::Level Log::sMinDebugLevel = Debug::All;
 bool Log::sWriteLevel = false;
@@ -13,17 +58,35 @@ bool Log::sWriteLevel = false;
 Log::Log(Debug::Level level)
     : mShouldLog(level <= sMinDebugLevel)
 {
-    // No need to hold the lock if there will be no logging anyway
     if (!mShouldLog)
         return;
 
-    // Locks a global lock while the object is alive
-    sLock.lock();
+    ThreadBuffer* const buffer = getThreadBuffer();
+    if (buffer == nullptr)
+    {
+        // Write directly, holding the lock while the object is alive
+        sLock.lock();
+        mStream = &std::cout;
+        if (sWriteLevel)
+            std::cout << static_cast<unsigned char>(level);
+        return;
+    }
+
+    mStream = &buffer->mStream;
+    // A message can be logged while formatting another one on the same thread, each keeps its own part of the buffer
+    mStart = buffer->mBuffer.mData.size();
+    if (mStart == 0)
+    {
+        // Formatting set by a previous message doesn't leak into this one
+        mStream->flags(std::ios_base::dec | std::ios_base::skipws);
+        mStream->precision(6);
+        mStream->fill(' ');
+    }
 
     if (!sWriteLevel)
         return;
 
-    std::cout << static_cast<unsigned char>(level);
+    *mStream << static_cast<unsigned char>(level);
 }
 
 Log::~Log()
@@ -31,14 +94,27 @@ Log::~Log()
     if (!mShouldLog)
         return;
 
-    std::cout << std::endl;
-    sLock.unlock();
+    if (mStream == &std::cout)
+    {
+        std::cout << std::endl;
+        sLock.unlock();
+        return;
+    }
+
+    std::string& data = static_cast<StringBuffer*>(mStream->rdbuf())->mData;
+    data.push_back('\n');
+    {
+        const std::lock_guard lock(sLock);
+        std::cout.write(data.data() + mStart, static_cast<std::streamsize>(data.size() - mStart));
+        std::cout.flush();
+    }
+    data.resize(mStart);
 }
 
 Log& Log::operator<<(const std::filesystem::path& rhs)
 {
     if (mShouldLog)
-        std::cout << Files::pathToUnicodeString(rhs);
+        *mStream << Files::pathToUnicodeString(rhs);
 
     return *this;
 }
@@ -46,7 +122,7 @@ Log& Log::operator<<(const std::filesystem::path& rhs)
 Log& Log::operator<<(const std::u8string& rhs)
 {
     if (mShouldLog)
-        std::cout << Misc::StringUtils::u8StringToString(rhs);
+        *mStream << Misc::StringUtils::u8StringToString(rhs);
 
     return *this;
 }
@@ -54,7 +130,7 @@ Log& Log::operator<<(const std::u8string& rhs)
 Log& Log::operator<<(const std::u8string_view rhs)
 {
     if (mShouldLog)
-        std::cout << Misc::StringUtils::u8StringToString(rhs);
+        *mStream << Misc::StringUtils::u8StringToString(rhs);
 
     return *this;
 }
@@ -62,7 +138,7 @@ Log& Log::operator<<(const std::u8string_view rhs)
 Log& Log::operator<<(const char8_t* rhs)
 {
     if (mShouldLog)
-        std::cout << Misc::StringUtils::u8StringToString(rhs);
+        *mStream << Misc::StringUtils::u8StringToString(rhs);
 
     return *this;
 }
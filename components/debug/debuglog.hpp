@@ -30,7 +30,7 @@ public:
     Log& operator<<(const T& rhs)
     {
         if (mShouldLog)
-            std::cout << rhs;
+            *mStream << rhs;
 
         return *this;
     }
@@ -45,6 +45,9 @@ public:
 
 private:
     const bool mShouldLog;
+    // The message is formatted into a buffer of the calling thread, only writing the finished line takes the lock
+    std::ostream* mStream = nullptr;
+    std::size_t mStart = 0;
 };
 
 #endif
@@ -0,0 +1,150 @@
+#include "trace.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Debug::Trace
+{
+    namespace
+    {
+        // A few seconds of the busiest threads, memory is only used by threads recording scopes
+        constexpr std::size_t bufferCapacity = std::size_t(1) << 16;
+
+        struct Event
+        {
+            const char* mName;
+            Clock::time_point mBegin;
+            Clock::time_point mEnd;
+        };
+
+        struct Buffer
+        {
+            std::mutex mMutex;
+            std::size_t mThreadId = 0;
+            std::string mThreadName;
+            std::vector<Event> mEvents;
+            // Position of the oldest event once the buffer is full
+            std::size_t mNext = 0;
+        };
+
+        struct Registry
+        {
+            std::mutex mMutex;
+            // Buffers outlive their threads so that scopes of finished threads are still written
+            std::vector<std::shared_ptr<Buffer>> mBuffers;
+            const Clock::time_point mStart = Clock::now();
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        Buffer& getBuffer()
+        {
+            thread_local const std::shared_ptr<Buffer> buffer = [] {
+                auto result = std::make_shared<Buffer>();
+                Registry& registry = getRegistry();
+                const std::lock_guard lock(registry.mMutex);
+                result->mThreadId = registry.mBuffers.size();
+                registry.mBuffers.push_back(result);
+                return result;
+            }();
+            return *buffer;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << ' ';
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+
+        double toMicroseconds(Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+    }
+
+    void record(const char* name, Clock::time_point begin, Clock::time_point end)
+    {
+        Buffer& buffer = getBuffer();
+        const std::lock_guard lock(buffer.mMutex);
+        if (buffer.mEvents.size() < bufferCapacity)
+        {
+            buffer.mEvents.push_back(Event{ .mName = name, .mBegin = begin, .mEnd = end });
+            return;
+        }
+        buffer.mEvents[buffer.mNext] = Event{ .mName = name, .mBegin = begin, .mEnd = end };
+        buffer.mNext = (buffer.mNext + 1) % bufferCapacity;
+    }
+
+    void setThreadName(std::string name)
+    {
+        Buffer& buffer = getBuffer();
+        const std::lock_guard lock(buffer.mMutex);
+        buffer.mThreadName = std::move(name);
+    }
+
+    void writeChromeTrace(std::ostream& stream)
+    {
+        Registry& registry = getRegistry();
+
+        std::vector<std::shared_ptr<Buffer>> buffers;
+        {
+            const std::lock_guard lock(registry.mMutex);
+            buffers = registry.mBuffers;
+        }
+
+        stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+        bool first = true;
+        const auto separate = [&] {
+            if (!first)
+                stream << ",\n";
+            first = false;
+        };
+
+        for (const std::shared_ptr<Buffer>& buffer : buffers)
+        {
+            const std::lock_guard lock(buffer->mMutex);
+
+            if (!buffer->mThreadName.empty())
+            {
+                separate();
+                stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->mThreadId
+                       << ",\"args\":{\"name\":";
+                writeString(stream, buffer->mThreadName);
+                stream << "}}";
+            }
+
+            for (std::size_t i = 0; i < buffer->mEvents.size(); ++i)
+            {
+                const Event& event = buffer->mEvents[(buffer->mNext + i) % buffer->mEvents.size()];
+                separate();
+                stream << "{\"name\":";
+                writeString(stream, event.mName);
+                stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->mThreadId
+                       << ",\"ts\":" << toMicroseconds(event.mBegin - registry.mStart)
+                       << ",\"dur\":" << toMicroseconds(event.mEnd - event.mBegin) << '}';
+            }
+        }
+
+        stream << "]}\n";
+    }
+}
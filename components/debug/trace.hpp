@@ -0,0 +1,55 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACE_H
+#define OPENMW_COMPONENTS_DEBUG_TRACE_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace Debug::Trace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// Record a finished scope in the buffer of the calling thread, the oldest scopes of a full buffer are dropped.
+    /// @param name has to outlive the trace, usually a string literal.
+    void record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+    /// Name the calling thread in the trace.
+    void setThreadName(std::string name);
+
+    /// Write the scopes recorded by all threads in the Chrome trace event format, readable by chrome://tracing and
+    /// Perfetto.
+    void writeChromeTrace(std::ostream& stream);
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name)
+            : mName(name)
+            , mBegin(Clock::now())
+        {
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() { record(mName, mBegin, Clock::now()); }
+
+    private:
+        const char* const mName;
+        const Clock::time_point mBegin;
+    };
+}
+
+#define OPENMW_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENMW_TRACE_CONCAT(a, b) OPENMW_TRACE_CONCAT_IMPL(a, b)
+
+// Compiled in only with the OPENMW_TRACING CMake option, so scopes cost nothing otherwise
+#ifdef OPENMW_TRACING
+#define OPENMW_TRACE_SCOPE(name) const ::Debug::Trace::Scope OPENMW_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define OPENMW_TRACE_THREAD_NAME(name) ::Debug::Trace::setThreadName(name)
+#else
+#define OPENMW_TRACE_SCOPE(name) static_cast<void>(0)
+#define OPENMW_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif
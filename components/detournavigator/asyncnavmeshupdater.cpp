@@ -8,6 +8,7 @@
 #include "version.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/thread.hpp>
@@ -62,7 +63,7 @@ namespace DetourNavigator
             if (db == nullptr)
                 return nullptr;
             return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion),
-                settings.mRecast, settings.mWriteToNavMeshDb);
+                settings.mRecast, settings.mWriteToNavMeshDb, settings.mMaxDbWritesPerTransaction);
         }
 
         std::size_t getNextJobId()
@@ -278,7 +279,7 @@ namespace DetourNavigator
         , mRecastMeshManager(recastMeshManager)
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
-        , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize, 2 * settings.mAsyncNavMeshUpdaterThreads)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -449,6 +450,7 @@ namespace DetourNavigator
     void AsyncNavMeshUpdater::process() noexcept
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
+        OPENMW_TRACE_THREAD_NAME("NavMesh Updater");
         Misc::setCurrentThreadIdlePriority();
         while (!mShouldStop)
         {
@@ -500,6 +502,8 @@ namespace DetourNavigator
 
     JobStatus AsyncNavMeshUpdater::processJob(Job& job)
     {
+        OPENMW_TRACE_SCOPE("NavMesh Job");
+
         Log(Debug::Debug) << "Processing job " << job.mId << "  for worldspace=" << job.mWorldspace
                           << " agent=" << job.mAgentBounds << ""
                           << " changedTile=(" << job.mChangedTile << ")"
@@ -856,12 +860,13 @@ namespace DetourNavigator
     }
 
     DbWorker::DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-        const RecastSettings& recastSettings, bool writeToDb)
+        const RecastSettings& recastSettings, bool writeToDb, std::size_t maxWritesPerTransaction)
         : mUpdater(updater)
         , mRecastSettings(recastSettings)
         , mDb(std::move(db))
         , mVersion(version)
         , mWriteToDb(writeToDb)
+        , mMaxWritesPerTransaction(maxWritesPerTransaction)
         , mNextTileId(mDb->getMaxTileId() + 1)
         , mNextShapeId(mDb->getMaxShapeId() + 1)
         , mThread([this] { run(); })
@@ -884,6 +889,8 @@ namespace DetourNavigator
         return DbWorkerStats{
             .mJobs = mQueue.getStats(),
             .mGetTileCount = mGetTileCount.load(std::memory_order_relaxed),
+            .mWrittenTileCount = mWrittenTileCount.load(std::memory_order_relaxed),
+            .mCommitCount = mCommitCount.load(std::memory_order_relaxed),
         };
     }
 
@@ -897,6 +904,8 @@ namespace DetourNavigator
 
     void DbWorker::run() noexcept
     {
+        OPENMW_TRACE_THREAD_NAME("NavMesh Db");
+
         while (!mShouldStop)
         {
             try
@@ -909,10 +918,21 @@ namespace DetourNavigator
                 Log(Debug::Error) << "DbWorker exception: " << e.what();
             }
         }
+
+        try
+        {
+            commitWrites(true);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker exception while committing writes: " << e.what();
+        }
     }
 
     void DbWorker::processJob(JobIt job)
     {
+        OPENMW_TRACE_SCOPE("NavMesh Db Job");
+
         const auto process = [&](auto f) {
             try
             {
@@ -960,6 +980,8 @@ namespace DetourNavigator
         if (isWritingDbJob(*job))
         {
             process([&](JobIt it) { processWritingJob(it); });
+            // Commit before the job is removed so the tile is in the database once all jobs are done
+            process([&](JobIt) { commitWrites(false); });
             mUpdater.removeJob(job);
             return;
         }
@@ -1027,6 +1049,8 @@ namespace DetourNavigator
 
         Log(Debug::Debug) << "Processing db write job " << job->mId;
 
+        mDb->startWriteBatch();
+
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
@@ -1041,6 +1065,7 @@ namespace DetourNavigator
             Log(Debug::Debug) << "Update db tile by job " << job->mId;
             job->mGeneratedNavMeshData->mUserId = cachedTileData->mTileId;
             mDb->updateTile(cachedTileData->mTileId, mVersion, serialize(*job->mGeneratedNavMeshData));
+            ++mWrittenTileCount;
             return;
         }
 
@@ -1056,5 +1081,19 @@ namespace DetourNavigator
         mDb->insertTile(mNextTileId, job->mWorldspace, job->mChangedTile, mVersion, job->mInput,
             serialize(*job->mGeneratedNavMeshData));
         ++mNextTileId;
+        ++mWrittenTileCount;
+    }
+
+    void DbWorker::commitWrites(bool force)
+    {
+        if (!mDb->hasWriteBatch())
+            return;
+        // Keep the transaction open while more tiles are about to be written
+        if (!force && mWriteToDb && mDb->getWriteBatchSize() < mMaxWritesPerTransaction
+            && mQueue.getStats().mWritingJobs > 0)
+            return;
+        Log(Debug::Debug) << "Committing " << mDb->getWriteBatchSize() << " db writes";
+        mDb->commitWriteBatch();
+        ++mCommitCount;
     }
 }
@@ -157,7 +157,7 @@ namespace DetourNavigator
     {
     public:
         DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-            const RecastSettings& recastSettings, bool writeToDb);
+            const RecastSettings& recastSettings, bool writeToDb, std::size_t maxWritesPerTransaction);
 
         ~DbWorker();
 
@@ -175,11 +175,14 @@ namespace DetourNavigator
         const std::unique_ptr<NavMeshDb> mDb;
         const TileVersion mVersion;
         bool mWriteToDb;
+        const std::size_t mMaxWritesPerTransaction;
         TileId mNextTileId;
         ShapeId mNextShapeId;
         DbJobQueue mQueue;
         std::atomic_bool mShouldStop{ false };
         std::atomic_size_t mGetTileCount{ 0 };
+        std::atomic_size_t mWrittenTileCount{ 0 };
+        std::atomic_size_t mCommitCount{ 0 };
         std::thread mThread;
 
         inline void run() noexcept;
@@ -189,6 +192,8 @@ namespace DetourNavigator
         inline void processReadingJob(JobIt job);
 
         inline void processWritingJob(JobIt job);
+
+        inline void commitWrites(bool force);
     };
 
     class AsyncNavMeshUpdater
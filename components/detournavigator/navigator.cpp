@@ -25,6 +25,17 @@ namespace DetourNavigator
             {
                 Log(Debug::Error) << e.what() << ", navigation mesh disk cache will be disabled";
             }
+            if (db != nullptr)
+            {
+                try
+                {
+                    db->setWriteAheadLog(settings.mDbWriteAheadLog);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << e.what() << ", navigation mesh disk cache journal mode is not changed";
+                }
+            }
         }
 
         return std::make_unique<NavigatorImpl>(settings, std::move(db));
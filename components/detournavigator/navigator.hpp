@@ -34,6 +34,7 @@ namespace DetourNavigator
     struct Settings;
     struct AgentBounds;
     struct Stats;
+    class PathCache;
 
     struct ObjectShapes
     {
@@ -197,6 +198,12 @@ namespace DetourNavigator
         virtual RecastMeshTiles getRecastMeshTiles() const = 0;
 
         virtual float getMaxNavmeshAreaRealRadius() const = 0;
+
+        /**
+         * @brief getPathCache returns recently found paths shared by all callers
+         * @return nullptr if paths are not cached
+         */
+        virtual PathCache* getPathCache() const = 0;
     };
 
     std::unique_ptr<Navigator> makeNavigator(const Settings& settings, const std::filesystem::path& userDataPath);
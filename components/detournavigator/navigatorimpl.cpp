@@ -12,6 +12,7 @@ namespace DetourNavigator
     NavigatorImpl::NavigatorImpl(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
+        , mPathCache(settings.mMaxPathCacheSize)
     {
     }
 
@@ -172,7 +173,9 @@ namespace DetourNavigator
 
     Stats NavigatorImpl::getStats() const
     {
-        return mNavMeshManager.getStats();
+        Stats result = mNavMeshManager.getStats();
+        result.mPathCache = mPathCache.getStats();
+        return result;
     }
 
     RecastMeshTiles NavigatorImpl::getRecastMeshTiles() const
@@ -212,4 +215,11 @@ namespace DetourNavigator
         const auto& settings = getSettings();
         return getRealTileSize(settings.mRecast) * getMaxNavmeshAreaRadius(settings);
     }
+
+    PathCache* NavigatorImpl::getPathCache() const
+    {
+        if (mSettings.mMaxPathCacheSize == 0)
+            return nullptr;
+        return &mPathCache;
+    }
 }
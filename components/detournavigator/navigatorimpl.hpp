@@ -3,6 +3,7 @@
 
 #include "navigator.hpp"
 #include "navmeshmanager.hpp"
+#include "pathcache.hpp"
 #include "updateguard.hpp"
 
 #include <map>
@@ -73,9 +74,12 @@ namespace DetourNavigator
 
         float getMaxNavmeshAreaRealRadius() const override;
 
+        PathCache* getPathCache() const override;
+
     private:
         Settings mSettings;
         NavMeshManager mNavMeshManager;
+        mutable PathCache mPathCache;
         std::optional<TilePosition> mLastPlayerPosition;
         std::map<AgentBounds, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
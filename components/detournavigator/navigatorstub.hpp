@@ -88,6 +88,8 @@ namespace DetourNavigator
 
         float getMaxNavmeshAreaRealRadius() const override { return std::numeric_limits<float>::max(); }
 
+        PathCache* getPathCache() const override { return nullptr; }
+
     private:
         Settings mDefaultSettings{};
         SharedNavMeshCacheItem mEmptyNavMeshCacheItem;
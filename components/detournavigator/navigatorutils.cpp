@@ -6,8 +6,43 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <cassert>
+#include <cstdlib>
+
 namespace DetourNavigator
 {
+    namespace
+    {
+        // Manhattan distance in tiles from which the coarse search is used
+        constexpr int portalPathMinTiles = 8;
+        // Number of tiles between checkpoints, each part has to fit into the polygon path limit
+        constexpr std::size_t portalPathStride = 4;
+        constexpr std::size_t portalPathMaxNodes = 4096;
+    }
+
+    std::vector<osg::Vec3f> findPortalCheckpoints(const NavMeshCacheItem& navMesh, const RecastSettings& settings,
+        const osg::Vec3f& start, const osg::Vec3f& end)
+    {
+        const osg::Vec3f navMeshStart = toNavMeshCoordinates(settings, start);
+        const osg::Vec3f navMeshEnd = toNavMeshCoordinates(settings, end);
+        const TilePosition startTile = getTilePosition(settings, navMeshStart);
+        const TilePosition endTile = getTilePosition(settings, navMeshEnd);
+
+        std::vector<osg::Vec3f> result;
+
+        if (std::abs(startTile.x() - endTile.x()) + std::abs(startTile.y() - endTile.y()) < portalPathMinTiles)
+            return result;
+
+        if (!navMesh.getPortalGraph().findPortalPath(
+                startTile, navMeshStart, endTile, navMeshEnd, portalPathStride, portalPathMaxNodes, result))
+            return {};
+
+        for (osg::Vec3f& position : result)
+            position = fromNavMeshCoordinates(settings, position);
+
+        return result;
+    }
+
     std::optional<osg::Vec3f> findRandomPointAroundCircle(const Navigator& navigator, const AgentBounds& agentBounds,
         const osg::Vec3f& start, const float maxRadius, const Flags includeFlags, float (*prng)())
     {
@@ -41,6 +76,28 @@ namespace DetourNavigator
         return fromNavMeshCoordinates(settings.mRecast, *result);
     }
 
+    void raycast(const Navigator& navigator, const AgentBounds& agentBounds, std::span<const RaycastRequest> requests,
+        const Flags includeFlags, std::span<std::optional<osg::Vec3f>> results)
+    {
+        assert(requests.size() == results.size());
+        std::fill(results.begin(), results.end(), std::nullopt);
+        const auto navMesh = navigator.getNavMesh(agentBounds);
+        if (navMesh == nullptr)
+            return;
+        const Settings& settings = navigator.getSettings();
+        const osg::Vec3f halfExtents = toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents);
+        const auto locked = navMesh->lock();
+        const dtNavMeshQuery& query = locked->getQuery();
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            const auto result = DetourNavigator::raycast(query, halfExtents,
+                toNavMeshCoordinates(settings.mRecast, requests[i].mStart),
+                toNavMeshCoordinates(settings.mRecast, requests[i].mEnd), includeFlags);
+            if (result)
+                results[i] = fromNavMeshCoordinates(settings.mRecast, *result);
+        }
+    }
+
     std::optional<osg::Vec3f> findNearestNavMeshPosition(const Navigator& navigator, const AgentBounds& agentBounds,
         const osg::Vec3f& position, const osg::Vec3f& searchAreaHalfExtents, const Flags includeFlags)
     {
@@ -5,16 +5,47 @@
 #include "flags.hpp"
 #include "navigator.hpp"
 #include "navmeshcacheitem.hpp"
+#include "pathcache.hpp"
 #include "settings.hpp"
 
 #include <components/misc/guarded.hpp>
 
+#include <algorithm>
 #include <iterator>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace DetourNavigator
 {
+    /**
+     * @brief findPortalCheckpoints makes a coarse path over navmesh tiles for long distance queries.
+     * @param start path from given point.
+     * @param end path at given point.
+     * @return border crossings in world coordinates splitting the path into parts of a few tiles, empty when start
+     * and end are close or there is no coarse path.
+     */
+    std::vector<osg::Vec3f> findPortalCheckpoints(const NavMeshCacheItem& navMesh, const RecastSettings& settings,
+        const osg::Vec3f& start, const osg::Vec3f& end);
+
+    inline Status findPath(NavMeshCacheItem& navMesh, const Settings& settings, const AgentBounds& agentBounds,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
+        float endTolerance, std::span<const osg::Vec3f> checkpoints, std::output_iterator<osg::Vec3f> auto out)
+    {
+        FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
+        // Long paths don't fit into the polygon path limit, search over tiles first and refine between crossings
+        std::vector<osg::Vec3f> portalCheckpoints;
+        if (checkpoints.empty())
+        {
+            portalCheckpoints = findPortalCheckpoints(navMesh, settings.mRecast, start, end);
+            checkpoints = portalCheckpoints;
+        }
+        return findSmoothPath(navMesh.getQuery(), toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
+            toNavMeshCoordinates(settings.mRecast, start), toNavMeshCoordinates(settings.mRecast, end), includeFlags,
+            areaCosts, settings.mDetour, endTolerance, ToNavMeshCoordinatesSpan(checkpoints, settings.mRecast),
+            outTransform);
+    }
+
     /**
      * @brief findPath fills output iterator with points of scene surfaces to be used for actor to walk through.
      * @param agentBounds defines which navmesh to use.
@@ -34,12 +65,23 @@ namespace DetourNavigator
         if (navMesh == nullptr)
             return Status::NavMeshNotFound;
         const Settings& settings = navigator.getSettings();
-        FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
         const auto locked = navMesh->lock();
-        return findSmoothPath(locked->getQuery(), toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
-            toNavMeshCoordinates(settings.mRecast, start), toNavMeshCoordinates(settings.mRecast, end), includeFlags,
-            areaCosts, settings.mDetour, endTolerance, ToNavMeshCoordinatesSpan(checkpoints, settings.mRecast),
-            outTransform);
+        // Paths over the given checkpoints are specific to the caller
+        PathCache* const pathCache = checkpoints.empty() ? navigator.getPathCache() : nullptr;
+        if (pathCache == nullptr)
+            return findPath(
+                *locked, settings, agentBounds, start, end, includeFlags, areaCosts, endTolerance, checkpoints, out);
+        const PathCache::Key key = PathCache::makeKey(agentBounds, start, end, includeFlags, areaCosts, endTolerance);
+        std::vector<osg::Vec3f> path;
+        std::optional<Status> status = pathCache->get(key, *locked, path);
+        if (!status.has_value())
+        {
+            status = findPath(*locked, settings, agentBounds, start, end, includeFlags, areaCosts, endTolerance,
+                checkpoints, std::back_inserter(path));
+            pathCache->set(key, *locked, settings.mRecast, *status, path);
+        }
+        std::copy(path.begin(), path.end(), out);
+        return *status;
     }
 
     /**
@@ -64,6 +106,22 @@ namespace DetourNavigator
     std::optional<osg::Vec3f> raycast(const Navigator& navigator, const AgentBounds& agentBounds,
         const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags);
 
+    struct RaycastRequest
+    {
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+    };
+
+    /**
+     * @brief raycast does the same as raycast for each request but locks the navmesh once for the whole batch.
+     * @param agentBounds defines which navmesh to use.
+     * @param requests lines to cast.
+     * @param includeFlags setup allowed navmesh areas.
+     * @param results receives result for each request in the same order, must have the same size as requests.
+     */
+    void raycast(const Navigator& navigator, const AgentBounds& agentBounds, std::span<const RaycastRequest> requests,
+        const Flags includeFlags, std::span<std::optional<osg::Vec3f>> results);
+
     /**
      * @brief findNearestNavMeshPosition finds nearest position on navmesh within given area having given flags.
      * @param agentBounds defines which navmesh to use.
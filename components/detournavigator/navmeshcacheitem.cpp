@@ -5,6 +5,7 @@
 #include "navmeshtilescache.hpp"
 #include "navmeshtileview.hpp"
 #include "settings.hpp"
+#include "tileportalgraph.hpp"
 #include "tileposition.hpp"
 
 #include <DetourNavMesh.h>
@@ -110,6 +111,8 @@ namespace DetourNavigator
                 tile->second.mCached = std::move(cached);
                 tile->second.mData = std::move(navMeshData);
             }
+            if (const dtMeshTile* addedTile = getTile(mImpl, position))
+                mPortalGraph.setTile(position, makeTilePortals(*addedTile));
             ++mVersion.mRevision;
             return UpdateNavMeshStatusBuilder().added(true).removed(removed).getResult();
         }
@@ -118,6 +121,7 @@ namespace DetourNavigator
             if (removed)
             {
                 mUsedTiles.erase(position);
+                mPortalGraph.removeTile(position);
                 ++mVersion.mRevision;
             }
             return UpdateNavMeshStatusBuilder()
@@ -134,6 +138,7 @@ namespace DetourNavigator
         if (removed)
         {
             mUsedTiles.erase(position);
+            mPortalGraph.removeTile(position);
             ++mVersion.mRevision;
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
@@ -146,6 +151,7 @@ namespace DetourNavigator
         if (removed)
         {
             mUsedTiles.erase(position);
+            mPortalGraph.removeTile(position);
             ++mVersion.mRevision;
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
@@ -155,4 +161,12 @@ namespace DetourNavigator
     {
         return mEmptyTiles.find(position) != mEmptyTiles.end();
     }
+
+    std::optional<Version> NavMeshCacheItem::getUsedTileVersion(const TilePosition& position) const
+    {
+        const auto it = mUsedTiles.find(position);
+        if (it == mUsedTiles.end())
+            return std::nullopt;
+        return it->second.mVersion;
+    }
 }
@@ -3,6 +3,7 @@
 
 #include "navmeshdata.hpp"
 #include "navmeshtilescache.hpp"
+#include "tileportalgraph.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
 
@@ -11,6 +12,7 @@
 
 #include <iosfwd>
 #include <map>
+#include <optional>
 #include <set>
 
 struct dtMeshTile;
@@ -114,6 +116,8 @@ namespace DetourNavigator
 
         const Version& getVersion() const { return mVersion; }
 
+        const TilePortalGraph& getPortalGraph() const { return mPortalGraph; }
+
         UpdateNavMeshStatus updateTile(
             const TilePosition& position, NavMeshTilesCache::Value&& cached, NavMeshData&& navMeshData);
 
@@ -123,6 +127,8 @@ namespace DetourNavigator
 
         bool isEmptyTile(const TilePosition& position) const;
 
+        std::optional<Version> getUsedTileVersion(const TilePosition& position) const;
+
         template <class Function>
         void forEachUsedTile(Function&& function) const
         {
@@ -153,6 +159,7 @@ namespace DetourNavigator
         dtNavMeshQuery mQuery;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
+        TilePortalGraph mPortalGraph;
     };
 }
 
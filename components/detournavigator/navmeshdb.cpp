@@ -5,12 +5,17 @@
 #include <components/sqlite3/db.hpp>
 #include <components/sqlite3/request.hpp>
 
+#include <extern/smhasher/MurmurHash3.h>
+
 #include <DetourAlloc.h>
 
 #include <sqlite3.h>
 
+#include <array>
 #include <cstddef>
 #include <format>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -29,12 +34,10 @@ namespace DetourNavigator
                 tile_position_y INTEGER NOT NULL,
                 version INTEGER NOT NULL,
                 input BLOB,
-                data BLOB
+                data BLOB,
+                input_hash BLOB
             );
 
-            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input
-                ON tiles (worldspace, tile_position_x, tile_position_y, input);
-
             CREATE INDEX IF NOT EXISTS index_tiles_by_worldspace_and_tile_position
                 ON tiles (worldspace, tile_position_x, tile_position_y);
 
@@ -51,31 +54,52 @@ namespace DetourNavigator
             COMMIT;
         )";
 
+        // Databases created before tiles were looked up by the hash of their input have no hashes for the stored
+        // tiles, so they are generated again
+        constexpr const char addTileInputHashMigration[] = R"(
+            BEGIN TRANSACTION;
+
+            DROP INDEX IF EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input;
+
+            DELETE FROM tiles;
+
+            ALTER TABLE tiles ADD COLUMN input_hash BLOB;
+
+            COMMIT;
+        )";
+
+        constexpr const char tileInputHashIndex[] = R"(
+            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input_hash
+                ON tiles (worldspace, tile_position_x, tile_position_y, input_hash);
+        )";
+
         constexpr std::string_view getMaxTileIdQuery = R"(
             SELECT max(tile_id) FROM tiles
         )";
 
         constexpr std::string_view findTileQuery = R"(
-            SELECT tile_id, version
+            SELECT tile_id, version, input
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view getTileDataQuery = R"(
-            SELECT tile_id, version, data
+            SELECT tile_id, version, input, data
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view insertTileQuery = R"(
-            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
-                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
+            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,
+                                input_hash,  data)
+                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input,
+                               :input_hash, :data)
         )";
 
         constexpr std::string_view updateTileQuery = R"(
@@ -123,6 +147,12 @@ namespace DetourNavigator
                AND hash = :hash
         )";
 
+        constexpr std::string_view hasShapeIdQuery = R"(
+            SELECT 1
+              FROM shapes
+             WHERE shape_id = :shape_id
+        )";
+
         constexpr std::string_view insertShapeQuery = R"(
             INSERT INTO shapes ( shape_id,  name,  type,  hash)
                    VALUES      (:shape_id, :name, :type, :hash)
@@ -132,6 +162,54 @@ namespace DetourNavigator
             VACUUM;
         )";
 
+        constexpr std::string_view attachSourceQuery = R"(
+            ATTACH DATABASE :path AS source
+        )";
+
+        constexpr std::string_view detachSourceQuery = R"(
+            DETACH DATABASE source
+        )";
+
+        // Tiles refer to shapes by id in their input, so the merged databases have to agree on them
+        constexpr std::string_view countConflictingShapesQuery = R"(
+            SELECT count(*)
+              FROM source.shapes AS s
+              JOIN main.shapes AS m
+                ON m.shape_id = s.shape_id
+                   OR (m.name = s.name AND m.type = s.type AND m.hash = s.hash)
+             WHERE m.shape_id != s.shape_id
+                OR m.name != s.name
+                OR m.type != s.type
+                OR m.hash != s.hash
+        )";
+
+        constexpr std::string_view insertSourceShapesQuery = R"(
+            INSERT INTO main.shapes (shape_id, name, type, hash)
+                 SELECT shape_id, name, type, hash
+                   FROM source.shapes AS s
+                  WHERE NOT EXISTS (SELECT 1 FROM main.shapes AS m WHERE m.shape_id = s.shape_id)
+        )";
+
+        constexpr std::string_view deleteTilesReplacedBySourceQuery = R"(
+            DELETE FROM main.tiles
+             WHERE EXISTS (
+                       SELECT 1
+                         FROM source.tiles AS s
+                        WHERE s.worldspace = main.tiles.worldspace
+                          AND s.tile_position_x = main.tiles.tile_position_x
+                          AND s.tile_position_y = main.tiles.tile_position_y
+                          AND (:replace_tiles_at_same_position OR s.input_hash = main.tiles.input_hash)
+                   )
+        )";
+
+        constexpr std::string_view insertSourceTilesQuery = R"(
+            INSERT INTO main.tiles (tile_id, revision, worldspace, tile_position_x, tile_position_y, version, input,
+                                    data, input_hash)
+                 SELECT tile_id + :tile_id_offset, revision, worldspace, tile_position_x, tile_position_y, version,
+                        input, data, input_hash
+                   FROM source.tiles
+        )";
+
         struct GetPageSize
         {
             static std::string_view text() noexcept { return "pragma page_size;"; }
@@ -152,6 +230,100 @@ namespace DetourNavigator
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        struct HasTileInputHash
+        {
+            static std::string_view text() noexcept
+            {
+                return "SELECT count(*) FROM pragma_table_info('tiles') WHERE name = 'input_hash';";
+            }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        void migrate(sqlite3& db)
+        {
+            std::int64_t hasTileInputHash = 0;
+            {
+                Sqlite3::Statement<HasTileInputHash> statement(db);
+                request(db, statement, &hasTileInputHash, 1);
+            }
+            if (hasTileInputHash == 0)
+                if (const int ec = sqlite3_exec(&db, addTileInputHashMigration, nullptr, nullptr, nullptr);
+                    ec != SQLITE_OK)
+                    throw std::runtime_error("Failed to add tile input hash: " + std::string(sqlite3_errmsg(&db)));
+            if (const int ec = sqlite3_exec(&db, tileInputHashIndex, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed to create tile input hash index: " + std::string(sqlite3_errmsg(&db)));
+        }
+
+        struct AttachSource
+        {
+            static std::string_view text() noexcept { return attachSourceQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view path)
+            {
+                Sqlite3::bindParameter(db, statement, ":path", path);
+            }
+        };
+
+        struct DetachSource
+        {
+            static std::string_view text() noexcept { return detachSourceQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct CountConflictingShapes
+        {
+            static std::string_view text() noexcept { return countConflictingShapesQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct InsertSourceShapes
+        {
+            static std::string_view text() noexcept { return insertSourceShapesQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct DeleteTilesReplacedBySource
+        {
+            static std::string_view text() noexcept { return deleteTilesReplacedBySourceQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, bool replaceTilesAtSamePosition)
+            {
+                Sqlite3::bindParameter(
+                    db, statement, ":replace_tiles_at_same_position", static_cast<int>(replaceTilesAtSamePosition));
+            }
+        };
+
+        struct InsertSourceTiles
+        {
+            static std::string_view text() noexcept { return insertSourceTilesQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileIdOffset)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id_offset", tileIdOffset);
+            }
+        };
+
+        Sqlite3::Db makeDb(std::string_view path)
+        {
+            Sqlite3::Db db = Sqlite3::makeDb(path, schema);
+            migrate(*db);
+            return db;
+        }
+
+        using InputHash = std::array<std::uint64_t, 2>;
+
+        // Looking tiles up by the hash is cheaper than compressing the input to compare it with the stored one. The
+        // stored input is still compared on a match to rule out collisions.
+        InputHash getInputHash(const std::vector<std::byte>& input)
+        {
+            const InputHash seed{ 0, 0 };
+            InputHash hash{ 0, 0 };
+            MurmurHash3_x64_128(input.data(), static_cast<int>(input.size()), seed.data(), hash.data());
+            return hash;
+        }
+
+        Sqlite3::ConstBlob toBlob(const InputHash& hash)
+        {
+            return Sqlite3::ConstBlob{ reinterpret_cast<const char*>(hash.data()), static_cast<int>(sizeof(hash)) };
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -167,7 +339,7 @@ namespace DetourNavigator
     }
 
     NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize)
-        : mDb(Sqlite3::makeDb(path, schema))
+        : mDb(makeDb(path))
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
@@ -178,6 +350,7 @@ namespace DetourNavigator
         , mDeleteTilesOutsideRange(*mDb, DbQueries::DeleteTilesOutsideRange{})
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId{})
         , mFindShapeId(*mDb, DbQueries::FindShapeId{})
+        , mHasShapeId(*mDb, DbQueries::HasShapeId{})
         , mInsertShape(*mDb, DbQueries::InsertShape{})
         , mVacuum(*mDb, DbQueries::Vacuum{})
     {
@@ -192,6 +365,66 @@ namespace DetourNavigator
         return Sqlite3::Transaction(*mDb, mode);
     }
 
+    void NavMeshDb::setWriteAheadLog(bool value)
+    {
+        const char* const query = value ? "pragma journal_mode = wal; pragma synchronous = normal;"
+                                        : "pragma journal_mode = delete; pragma synchronous = full;";
+        if (const int ec = sqlite3_exec(mDb.get(), query, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+            throw std::runtime_error("Failed set journal mode: " + std::string(sqlite3_errmsg(mDb.get())));
+    }
+
+    void NavMeshDb::startWriteBatch()
+    {
+        if (!mWriteBatch.has_value())
+            mWriteBatch.emplace(*mDb, Sqlite3::TransactionMode::Immediate);
+    }
+
+    void NavMeshDb::commitWriteBatch()
+    {
+        if (!mWriteBatch.has_value())
+            return;
+        try
+        {
+            mWriteBatch->commit();
+        }
+        catch (...)
+        {
+            abortWriteBatch();
+            throw;
+        }
+        mWriteBatch.reset();
+        mWriteBatchWrites.clear();
+    }
+
+    template <class Write>
+    int NavMeshDb::write(Write&& write)
+    {
+        if (!mWriteBatch.has_value())
+            return write();
+        int result = 0;
+        try
+        {
+            result = write();
+        }
+        catch (...)
+        {
+            abortWriteBatch();
+            throw;
+        }
+        mWriteBatchWrites.emplace_back(std::forward<Write>(write));
+        return result;
+    }
+
+    void NavMeshDb::abortWriteBatch()
+    {
+        mWriteBatch.reset();
+        // SQLite rolls back the whole transaction on some errors like a full database
+        const std::vector<std::function<int()>> writes = std::move(mWriteBatchWrites);
+        mWriteBatchWrites.clear();
+        for (const std::function<int()>& write : writes)
+            write();
+    }
+
     TileId NavMeshDb::getMaxTileId()
     {
         TileId tileId{ 0 };
@@ -203,9 +436,12 @@ namespace DetourNavigator
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
         Tile result;
-        auto row = std::tie(result.mTileId, result.mVersion);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mFindTile, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
+        std::vector<std::byte> storedInput;
+        auto row = std::tie(result.mTileId, result.mVersion, storedInput);
+        const InputHash inputHash = getInputHash(input);
+        if (&row == request(*mDb, mFindTile, &row, 1, worldspace.serializeText(), tilePosition, toBlob(inputHash)))
+            return {};
+        if (Misc::decompress(storedInput) != input)
             return {};
         return result;
     }
@@ -214,9 +450,12 @@ namespace DetourNavigator
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
         TileData result;
-        auto row = std::tie(result.mTileId, result.mVersion, result.mData);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
+        std::vector<std::byte> storedInput;
+        auto row = std::tie(result.mTileId, result.mVersion, storedInput, result.mData);
+        const InputHash inputHash = getInputHash(input);
+        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace.serializeText(), tilePosition, toBlob(inputHash)))
+            return {};
+        if (Misc::decompress(storedInput) != input)
             return {};
         result.mData = Misc::decompress(result.mData);
         return result;
@@ -225,16 +464,19 @@ namespace DetourNavigator
     int NavMeshDb::insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition,
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        const std::vector<std::byte> compressedData = Misc::compress(data);
-        return execute(*mDb, mInsertTile, tileId, worldspace.serializeText(), tilePosition, version, compressedInput,
-            compressedData);
+        return write([this, tileId, worldspace = worldspace.serializeText(), tilePosition, version,
+                         compressedInput = Misc::compress(input), inputHash = getInputHash(input),
+                         compressedData = Misc::compress(data)] {
+            return execute(*mDb, mInsertTile, tileId, worldspace, tilePosition, version, compressedInput,
+                toBlob(inputHash), compressedData);
+        });
     }
 
     int NavMeshDb::updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data)
     {
-        const std::vector<std::byte> compressedData = Misc::compress(data);
-        return execute(*mDb, mUpdateTile, tileId, version, compressedData);
+        return write([this, tileId, version, compressedData = Misc::compress(data)] {
+            return execute(*mDb, mUpdateTile, tileId, version, compressedData);
+        });
     }
 
     int NavMeshDb::deleteTilesAt(ESM::RefId worldspace, const TilePosition& tilePosition)
@@ -267,9 +509,19 @@ namespace DetourNavigator
         return shapeId;
     }
 
+    bool NavMeshDb::hasShapeId(ShapeId shapeId)
+    {
+        int found = 0;
+        request(*mDb, mHasShapeId, &found, 1, shapeId);
+        return found != 0;
+    }
+
     int NavMeshDb::insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash)
     {
-        return execute(*mDb, mInsertShape, shapeId, name, type, hash);
+        return write([this, shapeId, name = std::string(name), type, hash = std::string(hash.mData, hash.mSize)] {
+            const Sqlite3::ConstBlob blob{ hash.data(), static_cast<int>(hash.size()) };
+            return execute(*mDb, mInsertShape, shapeId, name, type, blob);
+        });
     }
 
     void NavMeshDb::vacuum()
@@ -277,6 +529,50 @@ namespace DetourNavigator
         execute(*mDb, mVacuum);
     }
 
+    std::size_t NavMeshDb::merge(std::string_view path, bool replaceTilesAtSamePosition)
+    {
+        // Bring the source to the current schema
+        makeDb(path);
+
+        Sqlite3::Statement<AttachSource> attach(*mDb);
+        execute(*mDb, attach, path);
+
+        std::size_t merged = 0;
+        try
+        {
+            // The statements using the attached database have to be finalized before it is detached
+            Sqlite3::Statement<CountConflictingShapes> countConflictingShapes(*mDb);
+            Sqlite3::Statement<InsertSourceShapes> insertSourceShapes(*mDb);
+            Sqlite3::Statement<DeleteTilesReplacedBySource> deleteTilesReplacedBySource(*mDb);
+            Sqlite3::Statement<InsertSourceTiles> insertSourceTiles(*mDb);
+
+            Sqlite3::Transaction transaction(*mDb, Sqlite3::TransactionMode::Immediate);
+
+            std::int64_t conflictingShapes = 0;
+            request(*mDb, countConflictingShapes, &conflictingShapes, 1);
+            if (conflictingShapes != 0)
+                throw std::runtime_error(std::to_string(conflictingShapes) + " shapes of \"" + std::string(path)
+                    + "\" have other ids than in the target navmeshdb");
+
+            execute(*mDb, insertSourceShapes);
+            execute(*mDb, deleteTilesReplacedBySource, replaceTilesAtSamePosition);
+            merged = static_cast<std::size_t>(execute(*mDb, insertSourceTiles, getMaxTileId()));
+
+            transaction.commit();
+        }
+        catch (...)
+        {
+            Sqlite3::Statement<DetachSource> detach(*mDb);
+            execute(*mDb, detach);
+            throw;
+        }
+
+        Sqlite3::Statement<DetachSource> detach(*mDb);
+        execute(*mDb, detach);
+
+        return merged;
+    }
+
     namespace DbQueries
     {
         std::string_view GetMaxTileId::text() noexcept
@@ -290,12 +586,12 @@ namespace DetourNavigator
         }
 
         void FindTile::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view GetTileData::text() noexcept
@@ -304,12 +600,12 @@ namespace DetourNavigator
         }
 
         void GetTileData::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view InsertTile::text() noexcept
@@ -319,7 +615,7 @@ namespace DetourNavigator
 
         void InsertTile::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
             const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-            const std::vector<std::byte>& data)
+            const Sqlite3::ConstBlob& inputHash, const std::vector<std::byte>& data)
         {
             Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
@@ -327,6 +623,7 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
             Sqlite3::bindParameter(db, statement, ":version", version);
             Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
             Sqlite3::bindParameter(db, statement, ":data", data);
         }
 
@@ -403,6 +700,16 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":hash", hash);
         }
 
+        std::string_view HasShapeId::text() noexcept
+        {
+            return hasShapeIdQuery;
+        }
+
+        void HasShapeId::bind(sqlite3& db, sqlite3_stmt& statement, ShapeId shapeId)
+        {
+            Sqlite3::bindParameter(db, statement, ":shape_id", shapeId);
+        }
+
         std::string_view InsertShape::text() noexcept
         {
             return insertShapeQuery;
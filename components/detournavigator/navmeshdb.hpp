@@ -13,6 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string_view>
 #include <vector>
@@ -60,14 +61,14 @@ namespace DetourNavigator
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct GetTileData
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct InsertTile
@@ -75,7 +76,7 @@ namespace DetourNavigator
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
                 const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-                const std::vector<std::byte>& data);
+                const Sqlite3::ConstBlob& inputHash, const std::vector<std::byte>& data);
         };
 
         struct UpdateTile
@@ -119,6 +120,12 @@ namespace DetourNavigator
                 const Sqlite3::ConstBlob& hash);
         };
 
+        struct HasShapeId
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, ShapeId shapeId);
+        };
+
         struct InsertShape
         {
             static std::string_view text() noexcept;
@@ -140,6 +147,21 @@ namespace DetourNavigator
 
         Sqlite3::Transaction startTransaction(Sqlite3::TransactionMode mode = Sqlite3::TransactionMode::Default);
 
+        /// Use the write-ahead log instead of the rollback journal. Commits don't wait for the data to reach the disk
+        /// then, an interrupted process loses only the last commits.
+        void setWriteAheadLog(bool value);
+
+        /// Group the following tile and shape writes into a single transaction until commitWriteBatch. When a write
+        /// fails the transaction is rolled back and the previous writes of the batch are applied one by one, so a full
+        /// database still keeps all writes that fit.
+        void startWriteBatch();
+
+        void commitWriteBatch();
+
+        bool hasWriteBatch() const { return mWriteBatch.has_value(); }
+
+        std::size_t getWriteBatchSize() const { return mWriteBatchWrites.size(); }
+
         TileId getMaxTileId();
 
         std::optional<Tile> findTile(
@@ -163,10 +185,18 @@ namespace DetourNavigator
 
         std::optional<ShapeId> findShapeId(std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
+        bool hasShapeId(ShapeId shapeId);
+
         int insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
         void vacuum();
 
+        /// Copy the shapes and tiles of another navmeshdb, for example generated for a part of the tiles on another
+        /// machine. The copied tiles replace the tiles with the same input or, if replaceTilesAtSamePosition is set,
+        /// all tiles at their positions.
+        /// @return Number of copied tiles
+        std::size_t merge(std::string_view path, bool replaceTilesAtSamePosition);
+
     private:
         Sqlite3::Db mDb;
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
@@ -179,8 +209,16 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::DeleteTilesOutsideRange> mDeleteTilesOutsideRange;
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
+        Sqlite3::Statement<DbQueries::HasShapeId> mHasShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
+        std::vector<std::function<int()>> mWriteBatchWrites;
+        std::optional<Sqlite3::Transaction> mWriteBatch;
+
+        template <class Write>
+        int write(Write&& write);
+
+        void abortWriteBatch();
     };
 }
 
@@ -5,7 +5,11 @@
 #include "components/debug/debuglog.hpp"
 #include "components/misc/strings/conversion.hpp"
 
+#include <extern/smhasher/MurmurHash3.h>
+
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <optional>
 #include <string_view>
 
@@ -20,17 +24,35 @@ namespace DetourNavigator
             return db.findShapeId(name, type, hashData);
         }
 
+        // Databases generated independently give the same ids to the same shapes, so they can be merged. Leaves room
+        // for the sequential ids given when the id is already taken.
+        ShapeId makeShapeId(std::string_view name, ShapeType type, const std::string& hash)
+        {
+            std::string key(name);
+            key += '\0';
+            key += static_cast<char>(type);
+            key += hash;
+            const std::array<std::uint64_t, 2> seed{ 0, 0 };
+            std::array<std::uint64_t, 2> value{ 0, 0 };
+            MurmurHash3_x64_128(key.data(), static_cast<int>(key.size()), seed.data(), value.data());
+            return ShapeId(static_cast<std::int64_t>(value[0] & ((std::uint64_t(1) << 62) - 1)) + 1);
+        }
+
         ShapeId getShapeId(
             NavMeshDb& db, std::string_view name, ShapeType type, const std::string& hash, ShapeId& nextShapeId)
         {
             const Sqlite3::ConstBlob hashData{ hash.data(), static_cast<int>(hash.size()) };
             if (const auto existingShapeId = db.findShapeId(name, type, hashData))
                 return *existingShapeId;
-            const ShapeId newShapeId = nextShapeId;
+            ShapeId newShapeId = makeShapeId(name, type, hash);
+            if (db.hasShapeId(newShapeId))
+            {
+                newShapeId = nextShapeId;
+                ++nextShapeId;
+            }
             db.insertShape(newShapeId, name, type, hashData);
             Log(Debug::Verbose) << "Added " << name << " " << Misc::StringUtils::toHex(hash) << " " << type
                                 << " shape to navmeshdb with id " << newShapeId;
-            ++nextShapeId;
             return newShapeId;
         }
     }
@@ -1,21 +1,58 @@
 #include "navmeshtilescache.hpp"
 #include "stats.hpp"
 
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
 #include <cstring>
 
 namespace DetourNavigator
 {
-    NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize)
-        : mMaxNavMeshDataSize(maxNavMeshDataSize)
-        , mUsedNavMeshDataSize(0)
-        , mFreeNavMeshDataSize(0)
-        , mHitCount(0)
-        , mGetCount(0)
+    NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize, std::size_t shardCount)
+        : mShards(std::max<std::size_t>(shardCount, 1))
     {
+        const std::size_t shardSize = maxNavMeshDataSize / mShards.size();
+        for (Shard& shard : mShards)
+            shard.setMaxNavMeshDataSize(shardSize);
+        // Do not lose the remainder, it matters for small limits
+        mShards.front().setMaxNavMeshDataSize(maxNavMeshDataSize - shardSize * (mShards.size() - 1));
     }
 
     NavMeshTilesCache::Value NavMeshTilesCache::get(
         const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh)
+    {
+        return getShard(agentBounds, changedTile).get(agentBounds, changedTile, recastMesh);
+    }
+
+    NavMeshTilesCache::Value NavMeshTilesCache::set(const AgentBounds& agentBounds, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value)
+    {
+        return getShard(agentBounds, changedTile).set(agentBounds, changedTile, recastMesh, std::move(value));
+    }
+
+    NavMeshTilesCacheStats NavMeshTilesCache::getStats() const
+    {
+        NavMeshTilesCacheStats result;
+        for (const Shard& shard : mShards)
+            shard.addStats(result);
+        return result;
+    }
+
+    NavMeshTilesCache::Shard& NavMeshTilesCache::getShard(
+        const AgentBounds& agentBounds, const TilePosition& changedTile)
+    {
+        if (mShards.size() == 1)
+            return mShards.front();
+        std::size_t hash = Misc::hash2dCoord(changedTile.x(), changedTile.y());
+        Misc::hashCombine(hash, static_cast<int>(agentBounds.mShapeType));
+        Misc::hashCombine(hash, agentBounds.mHalfExtents.x());
+        Misc::hashCombine(hash, agentBounds.mHalfExtents.y());
+        Misc::hashCombine(hash, agentBounds.mHalfExtents.z());
+        return mShards[hash % mShards.size()];
+    }
+
+    NavMeshTilesCache::Value NavMeshTilesCache::Shard::get(
+        const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh)
     {
         const std::lock_guard<std::mutex> lock(mMutex);
 
@@ -32,8 +69,8 @@ namespace DetourNavigator
         return Value(*this, tile->second);
     }
 
-    NavMeshTilesCache::Value NavMeshTilesCache::set(const AgentBounds& agentBounds, const TilePosition& changedTile,
-        const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value)
+    NavMeshTilesCache::Value NavMeshTilesCache::Shard::set(const AgentBounds& agentBounds,
+        const TilePosition& changedTile, const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value)
     {
         const auto itemSize = sizeof(RecastMesh) + getSize(recastMesh)
             + (value == nullptr ? 0 : sizeof(PreparedNavMeshData) + getSize(*value));
@@ -64,27 +101,24 @@ namespace DetourNavigator
 
         iterator->mPreparedNavMeshData = std::move(value);
         ++iterator->mUseCount;
+        iterator->mFree = false;
         mUsedNavMeshDataSize += itemSize;
         mBusyItems.splice(mBusyItems.end(), mFreeItems, iterator);
 
         return Value(*this, iterator);
     }
 
-    NavMeshTilesCacheStats NavMeshTilesCache::getStats() const
+    void NavMeshTilesCache::Shard::addStats(NavMeshTilesCacheStats& stats) const
     {
-        NavMeshTilesCacheStats result;
-        {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            result.mNavMeshCacheSize = mUsedNavMeshDataSize;
-            result.mUsedNavMeshTiles = mBusyItems.size();
-            result.mCachedNavMeshTiles = mFreeItems.size();
-            result.mHitCount = mHitCount;
-            result.mGetCount = mGetCount;
-        }
-        return result;
+        const std::lock_guard<std::mutex> lock(mMutex);
+        stats.mNavMeshCacheSize += mUsedNavMeshDataSize;
+        stats.mUsedNavMeshTiles += mBusyItems.size();
+        stats.mCachedNavMeshTiles += mFreeItems.size();
+        stats.mHitCount += mHitCount;
+        stats.mGetCount += mGetCount;
     }
 
-    void NavMeshTilesCache::removeLeastRecentlyUsed()
+    void NavMeshTilesCache::Shard::removeLeastRecentlyUsed()
     {
         const auto& item = mFreeItems.back();
 
@@ -99,22 +133,31 @@ namespace DetourNavigator
         mFreeItems.pop_back();
     }
 
-    void NavMeshTilesCache::acquireItemUnsafe(ItemIterator iterator)
+    void NavMeshTilesCache::Shard::acquireItemUnsafe(ItemIterator iterator)
     {
-        if (++iterator->mUseCount > 1)
+        ++iterator->mUseCount;
+
+        // The last user may have released the item without moving it to the free list yet
+        if (!iterator->mFree)
             return;
 
+        iterator->mFree = false;
         mBusyItems.splice(mBusyItems.end(), mFreeItems, iterator);
         mFreeNavMeshDataSize -= iterator->mSize;
     }
 
-    void NavMeshTilesCache::releaseItem(ItemIterator iterator)
+    void NavMeshTilesCache::Shard::releaseItem(ItemIterator iterator)
     {
         if (--iterator->mUseCount > 0)
             return;
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
+        // Acquired again before the lock was taken
+        if (iterator->mUseCount > 0 || iterator->mFree)
+            return;
+
+        iterator->mFree = true;
         mFreeItems.splice(mFreeItems.begin(), mBusyItems, iterator);
         mFreeNavMeshDataSize += iterator->mSize;
     }
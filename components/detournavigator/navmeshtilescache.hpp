@@ -50,6 +50,7 @@ namespace DetourNavigator
         struct Item
         {
             std::atomic<std::int64_t> mUseCount;
+            bool mFree = true; // guarded by the shard mutex
             AgentBounds mAgentBounds;
             TilePosition mChangedTile;
             RecastMeshData mRecastMeshData;
@@ -69,6 +70,8 @@ namespace DetourNavigator
 
         using ItemIterator = std::list<Item>::iterator;
 
+        class Shard;
+
         class Value
         {
         public:
@@ -78,7 +81,7 @@ namespace DetourNavigator
             {
             }
 
-            Value(NavMeshTilesCache& owner, ItemIterator iterator)
+            Value(Shard& owner, ItemIterator iterator)
                 : mOwner(&owner)
                 , mIterator(iterator)
             {
@@ -119,11 +122,13 @@ namespace DetourNavigator
             operator bool() const { return mOwner; }
 
         private:
-            NavMeshTilesCache* mOwner;
+            Shard* mOwner;
             ItemIterator mIterator;
         };
 
-        NavMeshTilesCache(const std::size_t maxNavMeshDataSize);
+        /// Items are split between shards by agent bounds and tile position so lookups from different async workers
+        /// rarely wait for each other. Each shard has its own part of the size limit and its own LRU order.
+        NavMeshTilesCache(const std::size_t maxNavMeshDataSize, std::size_t shardCount = 1);
 
         Value get(const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh);
 
@@ -132,24 +137,42 @@ namespace DetourNavigator
 
         NavMeshTilesCacheStats getStats() const;
 
+        class Shard
+        {
+        public:
+            void setMaxNavMeshDataSize(std::size_t value) { mMaxNavMeshDataSize = value; }
+
+            Value get(const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh);
+
+            Value set(const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh,
+                std::unique_ptr<PreparedNavMeshData>&& value);
+
+            void addStats(NavMeshTilesCacheStats& stats) const;
+
+            void releaseItem(ItemIterator iterator);
+
+        private:
+            mutable std::mutex mMutex;
+            std::size_t mMaxNavMeshDataSize = 0;
+            std::size_t mUsedNavMeshDataSize = 0;
+            std::size_t mFreeNavMeshDataSize = 0;
+            std::size_t mHitCount = 0;
+            std::size_t mGetCount = 0;
+            std::list<Item> mBusyItems;
+            std::list<Item> mFreeItems;
+            std::map<std::tuple<AgentBounds, TilePosition, std::reference_wrapper<const RecastMeshData>>,
+                ItemIterator, std::less<>>
+                mValues;
+
+            void removeLeastRecentlyUsed();
+
+            void acquireItemUnsafe(ItemIterator iterator);
+        };
+
     private:
-        mutable std::mutex mMutex;
-        std::size_t mMaxNavMeshDataSize;
-        std::size_t mUsedNavMeshDataSize;
-        std::size_t mFreeNavMeshDataSize;
-        std::size_t mHitCount;
-        std::size_t mGetCount;
-        std::list<Item> mBusyItems;
-        std::list<Item> mFreeItems;
-        std::map<std::tuple<AgentBounds, TilePosition, std::reference_wrapper<const RecastMeshData>>, ItemIterator,
-            std::less<>>
-            mValues;
-
-        void removeLeastRecentlyUsed();
-
-        void acquireItemUnsafe(ItemIterator iterator);
-
-        void releaseItem(ItemIterator iterator);
+        std::vector<Shard> mShards;
+
+        Shard& getShard(const AgentBounds& agentBounds, const TilePosition& changedTile);
     };
 }
 
@@ -0,0 +1,158 @@
+#include "pathcache.hpp"
+
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        int getStartCell(float value)
+        {
+            return static_cast<int>(std::floor(value / PathCache::sStartCellSize));
+        }
+
+        // Tiles under the path, segments are sampled often enough to not step over a tile
+        std::optional<std::vector<std::pair<TilePosition, Version>>> getPathTiles(
+            const NavMeshCacheItem& navMesh, const RecastSettings& settings, const std::vector<osg::Vec3f>& path)
+        {
+            const float step = getTileSize(settings) / 2;
+            std::vector<TilePosition> positions;
+            for (std::size_t i = 0; i < path.size(); ++i)
+            {
+                const osg::Vec3f point = toNavMeshCoordinates(settings, path[i]);
+                positions.push_back(getTilePosition(settings, point));
+                if (i + 1 == path.size())
+                    break;
+                const osg::Vec3f segment = toNavMeshCoordinates(settings, path[i + 1]) - point;
+                const int samples = static_cast<int>(segment.length() / step);
+                for (int j = 1; j <= samples; ++j)
+                    positions.push_back(getTilePosition(settings, point + segment * (j * step / segment.length())));
+            }
+
+            std::sort(positions.begin(), positions.end());
+            positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+            std::vector<std::pair<TilePosition, Version>> result;
+            result.reserve(positions.size());
+            for (const TilePosition& position : positions)
+            {
+                const std::optional<Version> version = navMesh.getUsedTileVersion(position);
+                if (!version.has_value())
+                    return std::nullopt;
+                result.emplace_back(position, *version);
+            }
+            return result;
+        }
+    }
+
+    PathCache::PathCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    PathCache::Key PathCache::makeKey(const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end,
+        Flags includeFlags, const AreaCosts& areaCosts, float endTolerance)
+    {
+        return Key{
+            .mAgentBounds = agentBounds,
+            .mIncludeFlags = includeFlags,
+            .mAreaCosts = areaCosts,
+            .mEndTolerance = endTolerance,
+            .mStart = osg::Vec3i(getStartCell(start.x()), getStartCell(start.y()), getStartCell(start.z())),
+            .mEnd = end,
+        };
+    }
+
+    std::optional<Status> PathCache::get(const Key& key, const NavMeshCacheItem& navMesh, std::vector<osg::Vec3f>& path)
+    {
+        const std::lock_guard lock(mMutex);
+        ++mGetCount;
+
+        const auto it = mIndex.find(key);
+        if (it == mIndex.end())
+            return std::nullopt;
+
+        const ItemIterator item = it->second;
+        if (!isValid(*item, navMesh))
+        {
+            mItems.erase(item);
+            mIndex.erase(it);
+            return std::nullopt;
+        }
+
+        mItems.splice(mItems.begin(), mItems, item);
+        ++mHitCount;
+        path = item->mPath;
+        return item->mStatus;
+    }
+
+    void PathCache::set(const Key& key, const NavMeshCacheItem& navMesh, const RecastSettings& settings,
+        Status status, const std::vector<osg::Vec3f>& path)
+    {
+        if (mMaxSize == 0)
+            return;
+
+        Item item{
+            .mKey = key,
+            .mStatus = status,
+            .mPath = path,
+            .mVersion = navMesh.getVersion(),
+            .mTiles = {},
+        };
+
+        // Other results may change with any new tile, a found path only when its own tiles change
+        if (status == Status::Success && !path.empty())
+        {
+            std::optional<std::vector<std::pair<TilePosition, Version>>> tiles
+                = getPathTiles(navMesh, settings, path);
+            if (!tiles.has_value())
+                return;
+            item.mTiles = std::move(*tiles);
+        }
+
+        const std::lock_guard lock(mMutex);
+
+        if (const auto it = mIndex.find(key); it != mIndex.end())
+        {
+            mItems.erase(it->second);
+            mIndex.erase(it);
+        }
+
+        mItems.push_front(std::move(item));
+        mIndex.emplace(key, mItems.begin());
+
+        while (mItems.size() > mMaxSize)
+        {
+            mIndex.erase(mItems.back().mKey);
+            mItems.pop_back();
+        }
+    }
+
+    PathCacheStats PathCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return PathCacheStats{
+            .mSize = mItems.size(),
+            .mGetCount = mGetCount,
+            .mHitCount = mHitCount,
+        };
+    }
+
+    bool PathCache::isValid(const Item& item, const NavMeshCacheItem& navMesh)
+    {
+        if (item.mTiles.empty())
+            return item.mVersion == navMesh.getVersion();
+
+        // Tile versions are only unique within a navmesh
+        if (item.mVersion.mGeneration != navMesh.getVersion().mGeneration)
+            return false;
+
+        return std::all_of(item.mTiles.begin(), item.mTiles.end(),
+            [&](const auto& tile) { return navMesh.getUsedTileVersion(tile.first) == tile.second; });
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHCACHE_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "stats.hpp"
+#include "status.hpp"
+#include "tileposition.hpp"
+#include "version.hpp"
+
+#include <osg/Vec3f>
+#include <osg/Vec3i>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace DetourNavigator
+{
+    class NavMeshCacheItem;
+    struct RecastSettings;
+
+    /// @brief Recently found paths shared by the actors going to the same destination from about the same place.
+    /// @par A found path stays valid while the navmesh tiles it goes over are not changed, any other result only while
+    /// the whole navmesh is not changed. Starts are rounded to cubes of sStartCellSize, ends have to match exactly.
+    /// @note Thread safe.
+    class PathCache
+    {
+    public:
+        struct Key
+        {
+            AgentBounds mAgentBounds;
+            Flags mIncludeFlags;
+            AreaCosts mAreaCosts;
+            float mEndTolerance;
+            osg::Vec3i mStart;
+            osg::Vec3f mEnd;
+
+            friend inline auto tie(const Key& value)
+            {
+                return std::tie(value.mAgentBounds.mShapeType, value.mAgentBounds.mHalfExtents, value.mIncludeFlags,
+                    value.mAreaCosts.mWater, value.mAreaCosts.mDoor, value.mAreaCosts.mPathgrid,
+                    value.mAreaCosts.mGround, value.mEndTolerance, value.mStart, value.mEnd);
+            }
+
+            friend inline bool operator<(const Key& lhs, const Key& rhs) { return tie(lhs) < tie(rhs); }
+        };
+
+        static constexpr float sStartCellSize = 32;
+
+        explicit PathCache(std::size_t maxSize);
+
+        static Key makeKey(const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end,
+            Flags includeFlags, const AreaCosts& areaCosts, float endTolerance);
+
+        /// @return Status of the cached result with the path in world coordinates, none if there is no valid one.
+        /// @note The navmesh has to be locked by the caller.
+        std::optional<Status> get(const Key& key, const NavMeshCacheItem& navMesh, std::vector<osg::Vec3f>& path);
+
+        /// Store a result found with the navmesh locked by the caller, the path is in world coordinates.
+        void set(const Key& key, const NavMeshCacheItem& navMesh, const RecastSettings& settings, Status status,
+            const std::vector<osg::Vec3f>& path);
+
+        PathCacheStats getStats() const;
+
+    private:
+        struct Item
+        {
+            Key mKey;
+            Status mStatus;
+            std::vector<osg::Vec3f> mPath;
+            Version mVersion;
+            std::vector<std::pair<TilePosition, Version>> mTiles;
+        };
+
+        using ItemIterator = std::list<Item>::iterator;
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        // Most recently used first
+        std::list<Item> mItems;
+        std::map<Key, ItemIterator> mIndex;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+
+        static bool isValid(const Item& item, const NavMeshCacheItem& navMesh);
+    };
+}
+
+#endif
@@ -10,6 +10,9 @@
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btConcaveShape.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btStridingMeshInterface.h>
+#include <BulletCollision/CollisionShapes/btTriangleMeshShape.h>
 #include <LinearMath/btAabbUtil2.h>
 #include <LinearMath/btTransform.h>
 
@@ -17,7 +20,10 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 namespace DetourNavigator
@@ -40,6 +46,98 @@ namespace DetourNavigator
             return static_cast<float>(cellSize) / (dataSize - 1);
         }
 
+        std::pair<btVector3, btVector3> getClipBounds(const TileBounds& bounds)
+        {
+            return { btVector3(bounds.mMin.x(), bounds.mMin.y(),
+                         -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon()),
+                btVector3(bounds.mMax.x(), bounds.mMax.y(),
+                    std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon()) };
+        }
+
+        bool isSupportedMeshPart(PHY_ScalarType vertexType, PHY_ScalarType indexType)
+        {
+            return (vertexType == PHY_FLOAT || vertexType == PHY_DOUBLE)
+                && (indexType == PHY_INTEGER || indexType == PHY_SHORT || indexType == PHY_UCHAR);
+        }
+
+        struct MeshPart
+        {
+            const unsigned char* mVertexBase;
+            int mNumVertices;
+            PHY_ScalarType mVertexType;
+            int mVertexStride;
+            const unsigned char* mIndexBase;
+            int mIndexStride;
+            int mNumFaces;
+            PHY_ScalarType mIndexType;
+        };
+
+        // Keeps the part locked for reading while it is used
+        class LockedMeshPart
+        {
+        public:
+            LockedMeshPart(const btStridingMeshInterface& mesh, int part)
+                : mMesh(mesh)
+                , mPart(part)
+            {
+                mesh.getLockedReadOnlyVertexIndexBase(&mValue.mVertexBase, mValue.mNumVertices, mValue.mVertexType,
+                    mValue.mVertexStride, &mValue.mIndexBase, mValue.mIndexStride, mValue.mNumFaces,
+                    mValue.mIndexType, part);
+            }
+
+            ~LockedMeshPart() { mMesh.unLockReadOnlyVertexBase(mPart); }
+
+            const MeshPart& get() const { return mValue; }
+
+        private:
+            const btStridingMeshInterface& mMesh;
+            const int mPart;
+            MeshPart mValue;
+        };
+
+        btVector3 getVertex(const MeshPart& part, int index)
+        {
+            const unsigned char* const data
+                = part.mVertexBase + static_cast<std::ptrdiff_t>(index) * part.mVertexStride;
+            if (part.mVertexType == PHY_FLOAT)
+            {
+                const float* const vertex = reinterpret_cast<const float*>(data);
+                return btVector3(vertex[0], vertex[1], vertex[2]);
+            }
+            const double* const vertex = reinterpret_cast<const double*>(data);
+            return btVector3(static_cast<btScalar>(vertex[0]), static_cast<btScalar>(vertex[1]),
+                static_cast<btScalar>(vertex[2]));
+        }
+
+        template <class Index>
+        std::array<int, 3> getFace(const MeshPart& part, int face)
+        {
+            const unsigned char* const data = part.mIndexBase + static_cast<std::ptrdiff_t>(face) * part.mIndexStride;
+            const Index* const indices = reinterpret_cast<const Index*>(data);
+            return { static_cast<int>(indices[0]), static_cast<int>(indices[1]), static_cast<int>(indices[2]) };
+        }
+
+        std::array<int, 3> getFace(const MeshPart& part, int face)
+        {
+            switch (part.mIndexType)
+            {
+                case PHY_INTEGER:
+                    return getFace<std::uint32_t>(part, face);
+                case PHY_SHORT:
+                    return getFace<std::uint16_t>(part, face);
+                default:
+                    return getFace<std::uint8_t>(part, face);
+            }
+        }
+
+        void reserveMore(std::vector<RecastMeshTriangle>& triangles, std::size_t count)
+        {
+            // Grow geometrically, exact reservations for every object would copy the triangles over and over
+            const std::size_t required = triangles.size() + count;
+            if (required > triangles.capacity())
+                triangles.reserve(std::max(required, 2 * triangles.capacity()));
+        }
+
         bool isNan(const RecastMeshTriangle& triangle)
         {
             for (std::size_t i = 0; i < 3; ++i)
@@ -171,6 +269,9 @@ namespace DetourNavigator
     void RecastMeshBuilder::addObject(
         const btConcaveShape& shape, const btTransform& transform, const AreaType areaType)
     {
+        if (addTriangleMesh(shape, transform, areaType))
+            return;
+
         return addObject(shape, transform, makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
             RecastMeshTriangle triangle = makeRecastMeshTriangle(vertices, areaType);
             std::reverse(triangle.mVertices.begin(), triangle.mVertices.end());
@@ -216,6 +317,14 @@ namespace DetourNavigator
         }
     }
 
+    void RecastMeshBuilder::addTriangles(std::span<const RecastMeshTriangle> triangles,
+        osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform,
+        const AreaType areaType)
+    {
+        mTriangles.insert(mTriangles.end(), triangles.begin(), triangles.end());
+        mSources.push_back(MeshSource{ std::move(source), objectTransform, areaType });
+    }
+
     void RecastMeshBuilder::addWater(const osg::Vec2i& cellPosition, const Water& water)
     {
         mWater.push_back(CellWater{ cellPosition, water });
@@ -286,16 +395,13 @@ namespace DetourNavigator
 
         shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
 
-        const btVector3 boundsMin(mBounds.mMin.x(), mBounds.mMin.y(),
-            -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
-        const btVector3 boundsMax(mBounds.mMax.x(), mBounds.mMax.y(),
-            std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
+        const std::pair<btVector3, btVector3> bounds = getClipBounds(mBounds);
 
         auto wrapper = makeProcessTriangleCallback([&](btVector3* triangle, int partId, int triangleIndex) {
             std::array<btVector3, 3> transformed;
             for (std::size_t i = 0; i < 3; ++i)
                 transformed[i] = transform(triangle[i]);
-            if (TestTriangleAgainstAabb2(transformed.data(), boundsMin, boundsMax))
+            if (TestTriangleAgainstAabb2(transformed.data(), bounds.first, bounds.second))
                 callback.processTriangle(transformed.data(), partId, triangleIndex);
         });
 
@@ -335,4 +441,69 @@ namespace DetourNavigator
 
         shape.processAllTriangles(&wrapper, aabbMin, aabbMax);
     }
+
+    bool RecastMeshBuilder::addTriangleMesh(
+        const btConcaveShape& shape, const btTransform& transform, const AreaType areaType)
+    {
+        const btStridingMeshInterface* mesh = nullptr;
+        const btVector3* shapeScaling = nullptr;
+        if (shape.getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+            mesh = static_cast<const btTriangleMeshShape&>(shape).getMeshInterface();
+        else if (shape.getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
+        {
+            const auto& scaled = static_cast<const btScaledBvhTriangleMeshShape&>(shape);
+            mesh = scaled.getChildShape()->getMeshInterface();
+            shapeScaling = &scaled.getLocalScaling();
+        }
+
+        if (mesh == nullptr)
+            return false;
+
+        const int numParts = mesh->getNumSubParts();
+        std::size_t numFaces = 0;
+        for (int i = 0; i < numParts; ++i)
+        {
+            const LockedMeshPart part(*mesh, i);
+            if (!isSupportedMeshPart(part.get().mVertexType, part.get().mIndexType))
+                return false;
+            numFaces += static_cast<std::size_t>(part.get().mNumFaces);
+        }
+
+        reserveMore(mTriangles, numFaces);
+
+        const std::pair<btVector3, btVector3> bounds = getClipBounds(mBounds);
+        const btVector3& meshScaling = mesh->getScaling();
+        std::vector<btVector3> vertices;
+
+        for (int i = 0; i < numParts; ++i)
+        {
+            const LockedMeshPart lockedPart(*mesh, i);
+            const MeshPart& part = lockedPart.get();
+
+            // Vertices are shared by several faces, each is transformed once. Scaling is applied in the same order as
+            // the scaled shape does for the same result
+            vertices.clear();
+            vertices.reserve(static_cast<std::size_t>(part.mNumVertices));
+            for (int j = 0; j < part.mNumVertices; ++j)
+            {
+                btVector3 vertex = getVertex(part, j) * meshScaling;
+                if (shapeScaling != nullptr)
+                    vertex *= *shapeScaling;
+                vertices.push_back(transform(vertex));
+            }
+
+            for (int j = 0; j < part.mNumFaces; ++j)
+            {
+                const std::array<int, 3> face = getFace(part, j);
+                const std::array<btVector3, 3> triangle{ vertices[face[0]], vertices[face[1]], vertices[face[2]] };
+                if (!TestTriangleAgainstAabb2(triangle.data(), bounds.first, bounds.second))
+                    continue;
+                // Same winding as the triangles reported through btTriangleCallback for concave shapes
+                RecastMeshTriangle& added = mTriangles.emplace_back(makeRecastMeshTriangle(triangle.data(), areaType));
+                std::reverse(added.mVertices.begin(), added.mVertices.end());
+            }
+        }
+
+        return true;
+    }
 }
@@ -12,6 +12,7 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -51,6 +52,11 @@ namespace DetourNavigator
 
         void addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType);
 
+        /// Adds triangles of an object previously collected with takeTriangles for the same bounds
+        void addTriangles(std::span<const RecastMeshTriangle> triangles,
+            osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform,
+            const AreaType areaType);
+
         void addWater(const osg::Vec2i& cellPosition, const Water& water);
 
         void addHeightfield(const osg::Vec2i& cellPosition, int cellSize, float height);
@@ -60,6 +66,8 @@ namespace DetourNavigator
 
         std::shared_ptr<RecastMesh> create(const Version& version) &&;
 
+        std::vector<RecastMeshTriangle> takeTriangles() && { return std::move(mTriangles); }
+
     private:
         const TileBounds mBounds;
         std::vector<RecastMeshTriangle> mTriangles;
@@ -74,6 +82,10 @@ namespace DetourNavigator
 
         void addObject(
             const btHeightfieldTerrainShape& shape, const btTransform& transform, btTriangleCallback&& callback);
+
+        /// Adds the triangles of a triangle mesh shape reading its vertex and index arrays directly
+        /// @return false when the shape is not a triangle mesh or the arrays have an unsupported type
+        bool addTriangleMesh(const btConcaveShape& shape, const btTransform& transform, const AreaType areaType);
     };
 
     Mesh makeMesh(std::vector<RecastMeshTriangle>&& triangles, const osg::Vec3f& shift = osg::Vec3f());
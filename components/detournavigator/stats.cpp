@@ -24,6 +24,10 @@ namespace DetourNavigator
 
                 out.setAttribute(frameNumber, "NavMesh DbCache Get", static_cast<double>(stats.mDb->mGetTileCount));
                 out.setAttribute(frameNumber, "NavMesh DbCache Hit", static_cast<double>(stats.mDbGetTileHits));
+
+                out.setAttribute(
+                    frameNumber, "NavMesh DbWrite Tiles", static_cast<double>(stats.mDb->mWrittenTileCount));
+                out.setAttribute(frameNumber, "NavMesh DbWrite Commits", static_cast<double>(stats.mDb->mCommitCount));
             }
 
             out.setAttribute(frameNumber, "NavMesh CacheSize", static_cast<double>(stats.mCache.mNavMeshCacheSize));
@@ -40,11 +44,19 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh Recast Heightfields", static_cast<double>(stats.mHeightfields));
             out.setAttribute(frameNumber, "NavMesh Recast Water", static_cast<double>(stats.mWater));
         }
+
+        void reportStats(const PathCacheStats& stats, unsigned int frameNumber, osg::Stats& out)
+        {
+            out.setAttribute(frameNumber, "NavMesh PathCache Size", static_cast<double>(stats.mSize));
+            out.setAttribute(frameNumber, "NavMesh PathCache Get", static_cast<double>(stats.mGetCount));
+            out.setAttribute(frameNumber, "NavMesh PathCache Hit", static_cast<double>(stats.mHitCount));
+        }
     }
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out)
     {
         reportStats(stats.mUpdater, frameNumber, out);
         reportStats(stats.mRecast, frameNumber, out);
+        reportStats(stats.mPathCache, frameNumber, out);
     }
 }
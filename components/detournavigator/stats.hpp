@@ -28,6 +28,8 @@ namespace DetourNavigator
     {
         DbJobQueueStats mJobs;
         std::size_t mGetTileCount = 0;
+        std::size_t mWrittenTileCount = 0;
+        std::size_t mCommitCount = 0;
     };
 
     struct NavMeshTilesCacheStats
@@ -58,10 +60,18 @@ namespace DetourNavigator
         std::size_t mWater = 0;
     };
 
+    struct PathCacheStats
+    {
+        std::size_t mSize = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+    };
+
     struct Stats
     {
         AsyncNavMeshUpdaterStats mUpdater;
         TileCachedRecastMeshManagerStats mRecast;
+        PathCacheStats mPathCache;
     };
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out);
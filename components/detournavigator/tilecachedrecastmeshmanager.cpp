@@ -170,6 +170,7 @@ namespace DetourNavigator
                 = mObjects
                       .emplace_hint(it, id,
                           std::unique_ptr<ObjectData>(new ObjectData{
+                              .mId = id,
                               .mObject = RecastMeshObject(shape, transform, areaType),
                               .mRange = range,
                               .mAabb = CommulativeAabb(revision, BulletHelpers::getAabb(shape.getShape(), transform)),
@@ -177,6 +178,7 @@ namespace DetourNavigator
                               .mRevision = revision,
                               .mLastNavMeshReportedChange = {},
                               .mLastNavMeshReport = {},
+                              .mTriangles = {},
                           }))
                       ->second.get();
             assert(range.mBegin != range.mEnd);
@@ -200,6 +202,7 @@ namespace DetourNavigator
                 return false;
             if (!it->second->mObject.update(transform, areaType))
                 return false;
+            it->second->mTriangles.clear();
             const std::size_t lastChangeRevision = it->second->mLastNavMeshReportedChange.has_value()
                 ? it->second->mLastNavMeshReportedChange->mRevision
                 : mRevision;
@@ -488,9 +491,19 @@ namespace DetourNavigator
 
     std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::makeMesh(const TilePosition& tilePosition) const
     {
-        RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings, tilePosition));
-        using Object = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>, ObjectTransform,
-            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType>;
+        const TileBounds bounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
+        RecastMeshBuilder builder(bounds);
+        struct Object
+        {
+            ObjectId mId;
+            std::size_t mRevision;
+            osg::ref_ptr<const Resource::BulletShapeInstance> mInstance;
+            ObjectTransform mObjectTransform;
+            std::reference_wrapper<const btCollisionShape> mShape;
+            btTransform mTransform;
+            AreaType mAreaType;
+            ObjectTriangles mTriangles;
+        };
         std::vector<Object> objects;
         Version version;
         bool hasInput = false;
@@ -511,9 +524,19 @@ namespace DetourNavigator
             objects.reserve(mObjects.size());
             for (auto it = mObjectIndex.qbegin(makeIndexQuery(tilePosition)); it != mObjectIndex.qend(); ++it)
             {
-                const auto& object = it->second->mObject;
-                objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
-                    object.getTransform(), object.getAreaType());
+                const ObjectData& data = *it->second;
+                const auto& object = data.mObject;
+                const auto triangles = data.mTriangles.find(tilePosition);
+                objects.push_back(Object{
+                    .mId = data.mId,
+                    .mRevision = data.mRevision,
+                    .mInstance = object.getInstance(),
+                    .mObjectTransform = object.getObjectTransform(),
+                    .mShape = object.getShape(),
+                    .mTransform = object.getTransform(),
+                    .mAreaType = object.getAreaType(),
+                    .mTriangles = triangles == data.mTriangles.end() ? nullptr : triangles->second,
+                });
                 hasInput = true;
             }
             if (hasInput)
@@ -530,8 +553,34 @@ namespace DetourNavigator
         }
         if (!hasInput)
             return nullptr;
-        for (const auto& [instance, objectTransform, shape, transform, areaType] : objects)
-            builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        bool hasNewTriangles = false;
+        for (Object& object : objects)
+        {
+            if (object.mTriangles == nullptr)
+            {
+                RecastMeshBuilder objectBuilder(bounds);
+                objectBuilder.addObject(object.mShape, object.mTransform, object.mAreaType,
+                    object.mInstance->getSource(), object.mObjectTransform);
+                object.mTriangles
+                    = std::make_shared<const std::vector<RecastMeshTriangle>>(std::move(objectBuilder).takeTriangles());
+                hasNewTriangles = true;
+            }
+            builder.addTriangles(
+                *object.mTriangles, object.mInstance->getSource(), object.mObjectTransform, object.mAreaType);
+        }
+        if (hasNewTriangles)
+        {
+            const std::lock_guard lock(mMutex);
+            for (const Object& object : objects)
+            {
+                const auto it = mObjects.find(object.mId);
+                // Object could be changed or removed while the lock was released
+                if (it == mObjects.end() || it->second->mRevision != object.mRevision
+                    || it->second->mGeneration != version.mGeneration)
+                    continue;
+                it->second->mTriangles.emplace(tilePosition, object.mTriangles);
+            }
+        }
         return std::move(builder).create(version);
     }
 
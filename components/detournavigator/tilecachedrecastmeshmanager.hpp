@@ -8,6 +8,7 @@
 #include "heightfieldshape.hpp"
 #include "objectid.hpp"
 #include "recastmesh.hpp"
+#include "recastmeshbuilder.hpp"
 #include "recastmeshobject.hpp"
 #include "tileposition.hpp"
 #include "updateguard.hpp"
@@ -26,6 +27,7 @@
 #include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -88,8 +90,11 @@ namespace DetourNavigator
             Version mNavMeshVersion;
         };
 
+        using ObjectTriangles = std::shared_ptr<const std::vector<RecastMeshTriangle>>;
+
         struct ObjectData
         {
+            ObjectId mId;
             RecastMeshObject mObject;
             TilesPositionsRange mRange;
             CommulativeAabb mAabb;
@@ -97,6 +102,9 @@ namespace DetourNavigator
             std::size_t mRevision = 0;
             std::optional<Report> mLastNavMeshReportedChange;
             std::optional<Report> mLastNavMeshReport;
+            // Object triangles clipped by tile bounds, valid for mRevision. Moving one object recomposes tile
+            // meshes from these instead of gathering every other object geometry again.
+            std::map<TilePosition, ObjectTriangles> mTriangles;
         };
 
         struct WaterData
@@ -0,0 +1,186 @@
+#include "tileportalgraph.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        const std::array<TilePosition, 4> sideOffsets{
+            TilePosition(1, 0),
+            TilePosition(0, 1),
+            TilePosition(-1, 0),
+            TilePosition(0, -1),
+        };
+
+        std::size_t getOppositeSide(std::size_t side)
+        {
+            return (side + 2) % 4;
+        }
+
+        float getDistance2d(const osg::Vec3f& lhs, const osg::Vec3f& rhs)
+        {
+            const float dx = lhs.x() - rhs.x();
+            const float dz = lhs.z() - rhs.z();
+            return std::sqrt(dx * dx + dz * dz);
+        }
+
+        struct Node
+        {
+            float mCost;
+            float mEstimate;
+            osg::Vec3f mPosition;
+            std::optional<TilePosition> mParent;
+            bool mClosed = false;
+        };
+
+        struct OpenItem
+        {
+            float mEstimate;
+            TilePosition mTile;
+
+            friend bool operator>(const OpenItem& lhs, const OpenItem& rhs) { return lhs.mEstimate > rhs.mEstimate; }
+        };
+    }
+
+    TilePortals makeTilePortals(const dtMeshTile& tile)
+    {
+        std::array<std::vector<osg::Vec3f>, 4> edges;
+
+        for (int i = 0; i < tile.header->polyCount; ++i)
+        {
+            const dtPoly& poly = tile.polys[i];
+            if (poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION)
+                continue;
+            for (unsigned j = 0; j < poly.vertCount; ++j)
+            {
+                if ((poly.neis[j] & DT_EXT_LINK) == 0)
+                    continue;
+                // Only the sides, corners have no edges
+                const unsigned side = poly.neis[j] & 0xff;
+                if (side % 2 != 0 || side > 6)
+                    continue;
+                const float* const a = &tile.verts[poly.verts[j] * 3];
+                const float* const b = &tile.verts[poly.verts[(j + 1) % poly.vertCount] * 3];
+                edges[side / 2].emplace_back((a[0] + b[0]) / 2, (a[1] + b[1]) / 2, (a[2] + b[2]) / 2);
+            }
+        }
+
+        TilePortals result;
+
+        for (std::size_t side = 0; side < edges.size(); ++side)
+        {
+            const std::vector<osg::Vec3f>& sideEdges = edges[side];
+            if (sideEdges.empty())
+                continue;
+            osg::Vec3f center;
+            for (const osg::Vec3f& v : sideEdges)
+                center += v;
+            center /= static_cast<float>(sideEdges.size());
+            // Take an existing edge, the center may fall into a gap between them
+            result.mSides[side] = *std::min_element(
+                sideEdges.begin(), sideEdges.end(), [&](const osg::Vec3f& l, const osg::Vec3f& r) {
+                    return (l - center).length2() < (r - center).length2();
+                });
+        }
+
+        return result;
+    }
+
+    void TilePortalGraph::setTile(const TilePosition& position, const TilePortals& portals)
+    {
+        mTiles.insert_or_assign(position, portals);
+    }
+
+    void TilePortalGraph::removeTile(const TilePosition& position)
+    {
+        mTiles.erase(position);
+    }
+
+    bool TilePortalGraph::findPortalPath(const TilePosition& startTile, const osg::Vec3f& start,
+        const TilePosition& endTile, const osg::Vec3f& end, std::size_t stride, std::size_t maxNodes,
+        std::vector<osg::Vec3f>& out) const
+    {
+        if (mTiles.find(startTile) == mTiles.end() || mTiles.find(endTile) == mTiles.end())
+            return false;
+
+        std::map<TilePosition, Node> nodes;
+        std::priority_queue<OpenItem, std::vector<OpenItem>, std::greater<>> open;
+
+        const float startEstimate = getDistance2d(start, end);
+        nodes.emplace(startTile, Node{ 0, startEstimate, start, std::nullopt });
+        open.push(OpenItem{ startEstimate, startTile });
+
+        bool found = false;
+
+        while (!open.empty() && nodes.size() <= maxNodes)
+        {
+            const TilePosition tile = open.top().mTile;
+            open.pop();
+
+            Node& current = nodes.find(tile)->second;
+            if (current.mClosed)
+                continue;
+            current.mClosed = true;
+
+            if (tile == endTile)
+            {
+                found = true;
+                break;
+            }
+
+            const TilePortals& portals = mTiles.find(tile)->second;
+
+            for (std::size_t side = 0; side < sideOffsets.size(); ++side)
+            {
+                if (!portals.mSides[side].has_value())
+                    continue;
+
+                const TilePosition neighbourTile = tile + sideOffsets[side];
+                const auto neighbour = mTiles.find(neighbourTile);
+                if (neighbour == mTiles.end())
+                    continue;
+
+                const std::optional<osg::Vec3f>& opposite = neighbour->second.mSides[getOppositeSide(side)];
+                if (!opposite.has_value())
+                    continue;
+
+                const osg::Vec3f crossing = (*portals.mSides[side] + *opposite) / 2;
+                const float cost = current.mCost + getDistance2d(current.mPosition, crossing);
+
+                const auto [it, inserted] = nodes.emplace(neighbourTile, Node{ cost, 0, crossing, tile });
+                Node& next = it->second;
+                if (!inserted)
+                {
+                    if (next.mClosed || next.mCost <= cost)
+                        continue;
+                    next.mCost = cost;
+                    next.mPosition = crossing;
+                    next.mParent = tile;
+                }
+                next.mEstimate = cost + getDistance2d(crossing, end);
+                open.push(OpenItem{ next.mEstimate, neighbourTile });
+            }
+        }
+
+        if (!found)
+            return false;
+
+        std::vector<osg::Vec3f> crossings;
+        for (auto node = nodes.find(endTile); node->second.mParent.has_value();
+             node = nodes.find(*node->second.mParent))
+            crossings.push_back(node->second.mPosition);
+        std::reverse(crossings.begin(), crossings.end());
+
+        stride = std::max<std::size_t>(stride, 1);
+        for (std::size_t i = stride - 1; i + 1 < crossings.size(); i += stride)
+            out.push_back(crossings[i]);
+
+        return true;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEPORTALGRAPH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEPORTALGRAPH_H
+
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <vector>
+
+struct dtMeshTile;
+
+namespace DetourNavigator
+{
+    /// Points where a tile polygons touch the tile border, one per side in navmesh coordinates.
+    /// Sides follow Detour order: +x, +z, -x, -z.
+    struct TilePortals
+    {
+        std::array<std::optional<osg::Vec3f>, 4> mSides;
+    };
+
+    TilePortals makeTilePortals(const dtMeshTile& tile);
+
+    /// Abstract graph where nodes are navmesh tiles and edges connect neighbouring tiles having portals on the shared
+    /// border. Used to split long paths into short ones each fitting into the polygon path limit.
+    class TilePortalGraph
+    {
+    public:
+        void setTile(const TilePosition& position, const TilePortals& portals);
+
+        void removeTile(const TilePosition& position);
+
+        std::size_t getTilesCount() const { return mTiles.size(); }
+
+        /// Finds a sequence of border crossings from start to end tile with A* over tiles.
+        /// @param stride defines which crossings to return, every stride-th one and never the last
+        /// @param maxNodes limits the number of visited tiles
+        /// @return false if end is not reachable within the limit
+        bool findPortalPath(const TilePosition& startTile, const osg::Vec3f& start, const TilePosition& endTile,
+            const osg::Vec3f& end, std::size_t stride, std::size_t maxNodes, std::vector<osg::Vec3f>& out) const;
+
+    private:
+        std::map<TilePosition, TilePortals> mTiles;
+    };
+}
+
+#endif
@@ -7,13 +7,6 @@
 namespace
 {
     constexpr std::uint16_t textures[ESM::LandRecordData::sLandNumTextures]{ 0 };
-
-    std::unique_ptr<const ESM::LandRecordData> loadData(const ESM::Land& land, int loadFlags)
-    {
-        std::unique_ptr<ESM::LandRecordData> result = std::make_unique<ESM::LandRecordData>();
-        land.loadData(loadFlags, *result);
-        return result;
-    }
 }
 
 namespace ESM
@@ -22,18 +15,32 @@ namespace ESM
 }
 
 ESM::LandData::LandData(const ESM::Land& land, int loadFlags)
-    : mData(loadData(land, loadFlags))
-    , mHeights(mData->mHeights)
-    , mNormals(mData->mNormals)
-    , mColors(mData->mColours)
-    , mTextures(mData->mTextures)
-    , mLoadFlags(mData->mDataLoaded)
-    , mMinHeight(mData->mMinHeight)
-    , mMaxHeight(mData->mMaxHeight)
-    , mSize(Constants::CellSizeInUnits)
+    : mSize(Constants::CellSizeInUnits)
     , mLandSize(ESM::Land::LAND_SIZE)
     , mPlugin(land.getPlugin())
 {
+    const std::unique_ptr<ESM::LandRecordData> data = std::make_unique<ESM::LandRecordData>();
+    land.loadData(loadFlags, *data);
+
+    // Keep only the requested data types, a consumer of heights doesn't pay for normals and colours
+    mLoadFlags = data->mDataLoaded & loadFlags;
+    if (mLoadFlags & ESM::Land::DATA_VHGT)
+    {
+        mHeightsData.assign(data->mHeights.begin(), data->mHeights.end());
+        mMinHeight = data->mMinHeight;
+        mMaxHeight = data->mMaxHeight;
+    }
+    if (mLoadFlags & ESM::Land::DATA_VNML)
+        mNormalsData.assign(data->mNormals.begin(), data->mNormals.end());
+    if (mLoadFlags & ESM::Land::DATA_VCLR)
+        mColorsData.assign(data->mColours.begin(), data->mColours.end());
+    if (mLoadFlags & ESM::Land::DATA_VTEX)
+        mTexturesData.assign(data->mTextures.begin(), data->mTextures.end());
+
+    mHeights = mHeightsData;
+    mNormals = mNormalsData;
+    mColors = mColorsData;
+    mTextures = mTexturesData;
 }
 
 ESM::LandData::LandData(const ESM4::Land& land, int /*loadFlags*/)
@@ -21,8 +21,12 @@ namespace ESM
         explicit LandData(const ESM::Land& land, int loadFlags);
         explicit LandData(const ESM4::Land& land, int loadFlags);
 
+        LandData(const LandData&) = delete;
+
         ~LandData();
 
+        LandData& operator=(const LandData&) = delete;
+
         std::span<const float> getHeights() const { return mHeights; }
         std::span<const std::int8_t> getNormals() const { return mNormals; }
         std::span<const std::uint8_t> getColors() const { return mColors; }
@@ -50,8 +54,10 @@ namespace ESM
         }
 
     private:
-        std::unique_ptr<const ESM::LandRecordData> mData;
         std::vector<float> mHeightsData;
+        std::vector<std::int8_t> mNormalsData;
+        std::vector<std::uint8_t> mColorsData;
+        std::vector<std::uint16_t> mTexturesData;
         std::span<const float> mHeights;
         std::span<const std::int8_t> mNormals;
         std::span<const std::uint8_t> mColors;
@@ -1,6 +1,7 @@
 #include "stringrefid.hpp"
 #include "serializerefid.hpp"
 
+#include <array>
 #include <charconv>
 #include <iomanip>
 #include <mutex>
@@ -17,23 +18,67 @@ namespace ESM
 {
     namespace
     {
-        using StringsSet = std::unordered_set<std::string, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>;
+        // Case insensitive hash is stored to compute it only once per lookup and never on rehash
+        struct InternedString
+        {
+            std::string mValue;
+            std::size_t mHash;
+        };
+
+        struct InternedStringView
+        {
+            std::string_view mValue;
+            std::size_t mHash;
+
+            explicit InternedStringView(std::string_view value)
+                : mValue(value)
+                , mHash(Misc::StringUtils::CiHash()(value))
+            {
+            }
+        };
+
+        struct InternedStringHash
+        {
+            using is_transparent = void;
+
+            std::size_t operator()(const InternedString& value) const noexcept { return value.mHash; }
+
+            std::size_t operator()(const InternedStringView& value) const noexcept { return value.mHash; }
+        };
+
+        struct InternedStringEqual
+        {
+            using is_transparent = void;
+
+            template <class L, class R>
+            bool operator()(const L& lhs, const R& rhs) const noexcept
+            {
+                return lhs.mHash == rhs.mHash && Misc::StringUtils::ciEqual(lhs.mValue, rhs.mValue);
+            }
+        };
+
+        using StringsSet = std::unordered_set<InternedString, InternedStringHash, InternedStringEqual>;
+
+        // Content files are loaded by multiple threads creating a lot of ids, split the set to reduce contention
+        constexpr std::size_t refIdsShards = 16;
 
         const std::string emptyString;
 
-        Misc::ScopeGuarded<StringsSet>& getRefIds()
+        Misc::ScopeGuarded<StringsSet>& getRefIds(const InternedStringView& id)
         {
-            static Misc::ScopeGuarded<StringsSet> refIds;
-            return refIds;
+            static std::array<Misc::ScopeGuarded<StringsSet>, refIdsShards> refIds;
+            // Low bits are used by the set buckets
+            return refIds[(id.mHash >> (sizeof(std::size_t) * 4)) % refIdsShards];
         }
 
-        Misc::NotNullPtr<const std::string> getOrInsertString(std::string_view id)
+        Misc::NotNullPtr<const std::string> getOrInsertString(std::string_view value)
         {
-            const auto locked = getRefIds().lock();
+            const InternedStringView id(value);
+            const auto locked = getRefIds(id).lock();
             auto it = locked->find(id);
             if (it == locked->end())
-                it = locked->emplace(id).first;
-            return &*it;
+                it = locked->emplace(InternedString{ std::string(value), id.mHash }).first;
+            return &it->mValue;
         }
 
         void addHex(unsigned char value, std::string& result)
@@ -66,6 +111,8 @@ namespace ESM
 
     bool StringRefId::operator<(StringRefId rhs) const noexcept
     {
+        if (mValue == rhs.mValue)
+            return false;
         return Misc::StringUtils::ciLess(*mValue, *rhs.mValue);
     }
 
@@ -137,12 +184,13 @@ namespace ESM
 
     std::optional<StringRefId> StringRefId::deserializeExisting(std::string_view value)
     {
-        const auto locked = getRefIds().lock();
-        auto it = locked->find(value);
+        const InternedStringView key(value);
+        const auto locked = getRefIds(key).lock();
+        auto it = locked->find(key);
         if (it == locked->end())
             return {};
         StringRefId id;
-        id.mValue = &*it;
+        id.mValue = &it->mValue;
         return id;
     }
 }
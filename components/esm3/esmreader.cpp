@@ -4,9 +4,11 @@
 
 #include <components/esm3/cellid.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/files/compressedfile.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/algorithm.hpp>
+#include <components/platform/file.hpp>
 
 #include <filesystem>
 #include <fstream>
@@ -19,7 +21,7 @@ namespace ESM
     ESM_Context ESMReader::getContext()
     {
         // Update the file position before returning
-        mCtx.filePos = mEsm->tellg();
+        mCtx.filePos = getFileOffset();
         return mCtx;
     }
 
@@ -43,12 +45,15 @@ namespace ESM
         mCtx = rc;
 
         // Make sure we seek to the right place
-        mEsm->seekg(mCtx.filePos);
+        seek(mCtx.filePos);
     }
 
     void ESMReader::close()
     {
         mEsm.reset();
+        mMapping.reset();
+        mMappedData = nullptr;
+        mPosition = 0;
         clearCtx();
         mHeader.blank();
     }
@@ -127,15 +132,42 @@ namespace ESM
         mEsm->seekg(0, mEsm->beg);
     }
 
-    void ESMReader::openRaw(const std::filesystem::path& filename)
+    bool ESMReader::openMapped(const std::filesystem::path& filename)
     {
-        openRaw(Files::openBinaryInputFileStream(filename), filename);
+        close();
+        try
+        {
+            mMapping = std::make_shared<const Platform::File::ScopedMapping>(filename);
+        }
+        catch (const std::exception&)
+        {
+            // Fall back to reading through a file stream
+            return false;
+        }
+        mMappedData = mMapping->data();
+        mCtx.filename = filename;
+        mCtx.leftFile = mFileSize = mMapping->size();
+        return true;
     }
 
-    void ESMReader::open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name)
+    void ESMReader::openRaw(const std::filesystem::path& filename)
     {
-        openRaw(std::move(stream), name);
+        // Saved games may be compressed
+        if (openMapped(filename))
+        {
+            if (!Files::isCompressedFile(std::string_view(mMappedData, mFileSize)))
+                return;
+        }
+        else if (!Files::isCompressedFile(filename))
+        {
+            openRaw(Files::openBinaryInputFileStream(filename), filename);
+            return;
+        }
+        openRaw(Files::openCompressedFileStream(filename), filename);
+    }
 
+    void ESMReader::loadHeader()
+    {
         if (getRecName() != "TES3")
             fail("Not a valid Morrowind file");
 
@@ -144,9 +176,16 @@ namespace ESM
         mHeader.load(*this);
     }
 
+    void ESMReader::open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name)
+    {
+        openRaw(std::move(stream), name);
+        loadHeader();
+    }
+
     void ESMReader::open(const std::filesystem::path& file)
     {
-        open(Files::openBinaryInputFileStream(file), file);
+        openRaw(file);
+        loadHeader();
     }
 
     std::string ESMReader::getHNOString(NAME name)
@@ -198,7 +237,7 @@ namespace ESM
         // them. For some reason, they break the rules, and contain a byte
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
-        if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
+        if (mCtx.leftSub == 0 && hasMoreSubs() && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -228,7 +267,7 @@ namespace ESM
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
         if (mHeader.mFormatVersion <= MaxStringRefIdFormatVersion && mCtx.leftSub == 0 && hasMoreSubs()
-            && !mEsm->peek())
+            && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -352,7 +391,7 @@ namespace ESM
 
         // We went out of the previous record's bounds. Backtrack.
         if (mCtx.leftRec < 0)
-            mEsm->seekg(mCtx.leftRec, std::ios::cur);
+            seek(static_cast<std::size_t>(static_cast<std::streamoff>(getFileOffset()) + mCtx.leftRec));
 
         getName(mCtx.recName);
         mCtx.leftFile -= decltype(mCtx.recName)::sCapacity;
@@ -372,6 +411,19 @@ namespace ESM
         mCtx.subCached = false;
     }
 
+    std::string ESMReader::getRecord()
+    {
+        constexpr std::size_t headerSize = sizeof(NAME) + 3 * sizeof(std::uint32_t);
+        const std::uint32_t header[] = { static_cast<std::uint32_t>(mCtx.leftRec), 0, mRecordFlags };
+        std::string result(headerSize + static_cast<std::size_t>(mCtx.leftRec), '\0');
+        std::memcpy(result.data(), mCtx.recName.mData, sizeof(NAME));
+        std::memcpy(result.data() + sizeof(NAME), header, sizeof(header));
+        getExact(result.data() + headerSize, static_cast<std::size_t>(mCtx.leftRec));
+        mCtx.leftRec = 0;
+        mCtx.subCached = false;
+        return result;
+    }
+
     void ESMReader::getRecHeader(uint32_t& flags)
     {
         if (mCtx.leftFile < static_cast<std::streamsize>(3 * sizeof(uint32_t)))
@@ -422,6 +474,16 @@ namespace ESM
 
     std::string_view ESMReader::getStringView(std::size_t size)
     {
+        if (mMapping != nullptr)
+        {
+            // Refer to the mapped data instead of copying it, the view is valid until the file is closed
+            const char* const ptr = getMapped(size);
+            const std::string_view result(ptr, strnlen(ptr, size));
+            if (mEncoder != nullptr)
+                return mEncoder->getUtf8(result);
+            return result;
+        }
+
         if (mBuffer.size() <= size)
             // Add some extra padding to reduce the chance of having to resize
             // again later.
@@ -522,9 +584,31 @@ namespace ESM
         ss << "\n  File: " << Files::pathToUnicodeString(mCtx.filename);
         ss << "\n  Record: " << mCtx.recName.toStringView();
         ss << "\n  Subrecord: " << mCtx.subName.toStringView();
-        if (mEsm.get())
-            ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+        if (isOpen())
+            ss << "\n  Offset: 0x" << std::hex << getFileOffset();
         throw std::runtime_error(ss.str());
     }
 
+    [[noreturn]] void ESMReader::reportEndOfFile(std::size_t size)
+    {
+        fail("Unexpected end of file while reading " + std::to_string(size) + " bytes");
+    }
+
+    void ESMReader::seek(std::size_t offset)
+    {
+        if (mMapping != nullptr)
+            mPosition = offset;
+        else
+            mEsm->seekg(offset);
+    }
+
+    int ESMReader::peek()
+    {
+        if (mMapping == nullptr)
+            return mEsm->peek();
+        if (mPosition >= mFileSize)
+            return std::char_traits<char>::eof();
+        return static_cast<unsigned char>(mMappedData[mPosition]);
+    }
+
 }
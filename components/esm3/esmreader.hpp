@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <istream>
 #include <map>
@@ -18,6 +19,11 @@
 
 #include "loadtes3.hpp"
 
+namespace Platform::File
+{
+    class ScopedMapping;
+}
+
 namespace ESM
 {
     template <class T>
@@ -63,10 +69,12 @@ namespace ESM
         const std::vector<Header::MasterData>& getGameFiles() const { return mHeader.mMaster; }
         const Header& getHeader() const { return mHeader; }
         FormatVersion getFormatVersion() const { return mHeader.mFormatVersion; }
+        // Used for records stored apart from their file, see getRecord.
+        void setFormatVersion(FormatVersion value) { mHeader.mFormatVersion = value; }
         const NAME& retSubName() const { return mCtx.subName; }
         uint32_t getSubSize() const { return mCtx.leftSub; }
         const std::filesystem::path& getName() const { return mCtx.filename; }
-        bool isOpen() const { return mEsm != nullptr; }
+        bool isOpen() const { return mEsm != nullptr || mMapping != nullptr; }
 
         /*************************************************************************
          *
@@ -95,12 +103,19 @@ namespace ESM
         /// currently open file first, if any.
         void open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name);
 
+        /// Reads straight from a memory mapping of the file when the platform supports it, from a file stream
+        /// otherwise.
         void open(const std::filesystem::path& file);
 
         void openRaw(const std::filesystem::path& filename);
 
         /// Get the current position in the file. Make sure that the file has been opened!
-        size_t getFileOffset() const { return mEsm->tellg(); }
+        size_t getFileOffset() const
+        {
+            if (mMapping != nullptr)
+                return mPosition;
+            return mEsm->tellg();
+        }
 
         // This is a quick hack for multiple esm/esp files. Each plugin introduces its own
         //  terrain palette, but ESMReader does not pass a reference to the correct plugin
@@ -292,6 +307,10 @@ namespace ESM
         // already been read
         void skipRecord();
 
+        // Read the rest of this record including the name and header, the result can be written with
+        // ESMWriter::writeRecord. Assumes the name and header have already been read and nothing else.
+        std::string getRecord();
+
         /* Read record header. This updatesleftFile BEYOND the data that
            follows the header, ie beyond the entire record. You should use
            leftRec to orient yourself inside the record itself.
@@ -322,6 +341,11 @@ namespace ESM
 
         void getExact(void* x, std::size_t size)
         {
+            if (mMapping != nullptr)
+            {
+                std::memcpy(x, getMapped(size), size);
+                return;
+            }
             mEsm->read(static_cast<char*>(x), static_cast<std::streamsize>(size));
         }
 
@@ -340,6 +364,11 @@ namespace ESM
 
         void skip(std::size_t bytes)
         {
+            if (mMapping != nullptr)
+            {
+                mPosition += bytes;
+                return;
+            }
             char buffer[4096];
             if (bytes > std::size(buffer))
                 mEsm->seekg(getFileOffset() + bytes);
@@ -368,8 +397,34 @@ namespace ESM
 
         RefId getRefIdImpl(std::size_t size);
 
+        /// @return false if the file can't be mapped, the reader is closed then
+        bool openMapped(const std::filesystem::path& filename);
+
+        void loadHeader();
+
+        /// Get the next bytes of a memory mapped file and move past them.
+        const char* getMapped(std::size_t size)
+        {
+            if (mPosition > mFileSize || size > mFileSize - mPosition)
+                reportEndOfFile(size);
+            const char* const result = mMappedData + mPosition;
+            mPosition += size;
+            return result;
+        }
+
+        [[noreturn]] void reportEndOfFile(std::size_t size);
+
+        void seek(std::size_t offset);
+
+        int peek();
+
         std::unique_ptr<std::istream> mEsm;
 
+        // Set instead of mEsm when reading from a memory mapping, mPosition is the offset in the file then
+        std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+        const char* mMappedData = nullptr;
+        std::size_t mPosition = 0;
+
         ESM_Context mCtx;
 
         uint32_t mRecordFlags;
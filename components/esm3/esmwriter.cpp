@@ -1,7 +1,8 @@
 #include "esmwriter.hpp"
 
 #include <cassert>
-#include <fstream>
+#include <cstring>
+#include <ostream>
 #include <stdexcept>
 
 #include <components/debug/debuglog.hpp>
@@ -74,10 +75,8 @@ namespace ESM
     ESMWriter::ESMWriter()
         : mRecords()
         , mStream(nullptr)
-        , mHeaderPos()
         , mEncoder(nullptr)
         , mRecordCount(0)
-        , mCounting(true)
         , mHeader()
     {
     }
@@ -131,12 +130,40 @@ namespace ESM
     }
 
     void ESMWriter::save(std::ostream& file)
+    {
+        saveRecords(file);
+        writeHeader();
+    }
+
+    void ESMWriter::save()
+    {
+        saveRecords();
+        writeHeader();
+    }
+
+    void ESMWriter::saveRecords(std::ostream& file)
+    {
+        saveRecords();
+        mStream = &file;
+    }
+
+    void ESMWriter::saveRecords()
     {
         mRecordCount = 0;
         mRecords.clear();
-        mCounting = true;
-        mStream = &file;
+        mBuffer.clear();
+        mStream = nullptr;
+    }
+
+    std::string ESMWriter::takeData()
+    {
+        std::string result = std::move(mBuffer);
+        mBuffer.clear();
+        return result;
+    }
 
+    void ESMWriter::writeHeader()
+    {
         startRecord("TES3", 0);
 
         mHeader.save(*this);
@@ -144,6 +171,14 @@ namespace ESM
         endRecord("TES3");
     }
 
+    void ESMWriter::writeRecord(std::string_view data)
+    {
+        if (!mRecords.empty())
+            throw std::runtime_error("Unclosed record remaining");
+        ++mRecordCount;
+        write(data.data(), data.size());
+    }
+
     void ESMWriter::close()
     {
         if (!mRecords.empty())
@@ -154,17 +189,12 @@ namespace ESM
     {
         mRecordCount++;
 
-        writeName(name);
-        RecordData rec;
-        rec.name = name;
-        rec.position = mStream->tellp();
-        rec.size = 0;
-        writeT<uint32_t>(0); // Size goes here
-        writeT<uint32_t>(0); // Unused header?
-        writeT(flags);
-        mRecords.push_back(rec);
-
-        assert(mRecords.back().size == 0);
+        mBuffer.append(name.mData, NAME::sCapacity);
+        const std::size_t sizePosition = mBuffer.size();
+        // Size goes first, followed by an unused field
+        const uint32_t header[] = { 0, 0, flags };
+        mBuffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+        mRecords.push_back(RecordData{ name, sizePosition, mBuffer.size() });
     }
 
     void ESMWriter::startRecord(uint32_t name, uint32_t flags)
@@ -177,30 +207,26 @@ namespace ESM
         // Sub-record hierarchies are not properly supported in ESMReader. This should be fixed later.
         assert(mRecords.size() <= 1);
 
-        writeName(name);
-        RecordData rec;
-        rec.name = name;
-        rec.position = mStream->tellp();
-        rec.size = 0;
-        writeT<uint32_t>(0); // Size goes here
-        mRecords.push_back(rec);
-
-        assert(mRecords.back().size == 0);
+        mBuffer.append(name.mData, NAME::sCapacity);
+        const std::size_t sizePosition = mBuffer.size();
+        mBuffer.append(sizeof(uint32_t), '\0');
+        mRecords.push_back(RecordData{ name, sizePosition, mBuffer.size() });
     }
 
     void ESMWriter::endRecord(NAME name)
     {
-        RecordData rec = mRecords.back();
-        assert(rec.name == name);
+        const RecordData rec = mRecords.back();
+        assert(rec.mName == name);
         mRecords.pop_back();
 
-        mStream->seekp(rec.position);
+        const uint32_t size = static_cast<uint32_t>(mBuffer.size() - rec.mStart);
+        std::memcpy(mBuffer.data() + rec.mSizePosition, &size, sizeof(size));
 
-        mCounting = false;
-        write(reinterpret_cast<const char*>(&rec.size), sizeof(uint32_t));
-        mCounting = true;
-
-        mStream->seekp(0, std::ios::end);
+        if (mRecords.empty() && mStream != nullptr)
+        {
+            mStream->write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+            mBuffer.clear();
+        }
     }
 
     void ESMWriter::endRecord(uint32_t name)
@@ -331,13 +357,11 @@ namespace ESM
 
     void ESMWriter::write(const char* data, size_t size)
     {
-        if (mCounting && !mRecords.empty())
-        {
-            for (std::list<RecordData>::iterator it = mRecords.begin(); it != mRecords.end(); ++it)
-                it->size += static_cast<uint32_t>(size);
-        }
-
-        mStream->write(data, size);
+        // Everything written outside of a record is complete already
+        if (mRecords.empty() && mStream != nullptr)
+            mStream->write(data, static_cast<std::streamsize>(size));
+        else
+            mBuffer.append(data, size);
     }
 
     void ESMWriter::writeFormId(const FormId& formId, bool wide, NAME tag)
@@ -1,9 +1,11 @@
 #ifndef OPENMW_ESM_WRITER_H
 #define OPENMW_ESM_WRITER_H
 
+#include <cstddef>
 #include <iosfwd>
-#include <list>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "components/esm/decompose.hpp"
 #include "components/esm/esmcommon.hpp"
@@ -19,13 +21,16 @@ namespace ToUTF8
 namespace ESM
 {
 
+    /// Records are built in memory and their sizes are filled in there. A record is written to the stream once it is
+    /// complete, when there is no stream everything is kept in memory, see takeData.
     class ESMWriter
     {
         struct RecordData
         {
-            NAME name;
-            std::streampos position;
-            uint32_t size;
+            NAME mName;
+            // Offsets in the buffer of the size and of the data counted in it
+            std::size_t mSizePosition;
+            std::size_t mStart;
         };
 
     public:
@@ -59,6 +64,21 @@ namespace ESM
         void save(std::ostream& file);
         ///< Start saving a file by writing the TES3 header.
 
+        void save();
+        ///< Same as save(std::ostream&) but writes into memory.
+
+        void saveRecords(std::ostream& file);
+        ///< Start writing records without the TES3 header, e.g. to copy them later with writeRecord.
+
+        void saveRecords();
+        ///< Same as saveRecords(std::ostream&) but writes into memory.
+
+        std::string takeData();
+        ///< Data written into memory since save or saveRecords without a stream.
+
+        void writeRecord(std::string_view data);
+        ///< Write a complete record written by another writer using the same format version.
+
         void close();
         ///< \note Does not close the stream.
 
@@ -198,15 +218,16 @@ namespace ESM
         void writeFormId(const ESM::FormId&, bool wide = false, NAME tag = "FRMR");
 
     private:
-        std::list<RecordData> mRecords;
+        std::vector<RecordData> mRecords;
+        std::string mBuffer;
         std::ostream* mStream;
-        std::streampos mHeaderPos;
         ToUTF8::Utf8Encoder* mEncoder;
         int mRecordCount;
-        bool mCounting;
 
         Header mHeader;
 
+        void writeHeader();
+
         void writeRefId(RefId value);
     };
 }
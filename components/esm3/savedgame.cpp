@@ -41,6 +41,7 @@ namespace ESM
         esm.getHNOT(mCurrentDay, "CDAY");
         esm.getHNOT(mCurrentHealth, "CHLT");
         esm.getHNOT(mMaximumHealth, "MHLT");
+        mCellsFile = esm.getHNOString("CELF");
     }
 
     void SavedGame::save(ESMWriter& esm) const
@@ -68,6 +69,7 @@ namespace ESM
         esm.writeHNT("CDAY", mCurrentDay);
         esm.writeHNT("CHLT", mCurrentHealth);
         esm.writeHNT("MHLT", mMaximumHealth);
+        esm.writeHNOString("CELF", mCellsFile);
     }
 
     std::vector<std::string_view> SavedGame::getMissingContentFiles(
@@ -38,6 +38,9 @@ namespace ESM
         float mCurrentHealth = 0;
         float mMaximumHealth = 0;
 
+        // Name of the file in the same directory with the state of the cells not stored in this saved game
+        std::string mCellsFile;
+
         void load(ESMReader& esm);
         void save(ESMWriter& esm) const;
 
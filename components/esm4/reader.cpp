@@ -32,8 +32,6 @@
 #include <sstream>
 #include <stdexcept>
 
-#include <zlib.h>
-
 #include <components/bsa/memorystream.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/esm/refid.hpp>
@@ -52,11 +50,6 @@ namespace ESM4
         using FormId = ESM::FormId;
         using FormId32 = ESM::FormId32;
 
-        std::string getError(const std::string& header, const int errorCode, const char* msg)
-        {
-            return header + ": code " + std::to_string(errorCode) + ", " + std::string(msg != nullptr ? msg : "(null)");
-        }
-
         std::u8string_view getStringsSuffix(LocalizedStringType type)
         {
             switch (type)
@@ -71,92 +64,6 @@ namespace ESM4
 
             throw std::logic_error("Unsupported LocalizedStringType: " + std::to_string(static_cast<int>(type)));
         }
-
-        struct InflateEnd
-        {
-            void operator()(z_stream* stream) const { inflateEnd(stream); }
-        };
-
-        std::optional<std::string> tryDecompressAll(std::span<char> compressed, std::span<char> decompressed)
-        {
-            z_stream stream{};
-
-            stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
-            stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
-            stream.avail_in = static_cast<uInt>(compressed.size());
-            stream.avail_out = static_cast<uInt>(decompressed.size());
-
-            if (const int ec = inflateInit(&stream); ec != Z_OK)
-                return getError("inflateInit error", ec, stream.msg);
-
-            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
-
-            if (const int ec = inflate(&stream, Z_NO_FLUSH); ec != Z_STREAM_END)
-                return getError("inflate error", ec, stream.msg);
-
-            return std::nullopt;
-        }
-
-        std::optional<std::string> tryDecompressByBlock(
-            std::span<char> compressed, std::span<char> decompressed, std::size_t blockSize)
-        {
-            z_stream stream{};
-
-            if (const int ec = inflateInit(&stream); ec != Z_OK)
-                return getError("inflateInit error", ec, stream.msg);
-
-            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
-
-            while (!compressed.empty() && !decompressed.empty())
-            {
-                const auto prevTotalIn = stream.total_in;
-                const auto prevTotalOut = stream.total_out;
-                stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
-                stream.avail_in = static_cast<uInt>(std::min(blockSize, compressed.size()));
-                stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
-                stream.avail_out = static_cast<uInt>(std::min(blockSize, decompressed.size()));
-                const int ec = inflate(&stream, Z_NO_FLUSH);
-                if (ec == Z_STREAM_END)
-                    break;
-                if (ec != Z_OK)
-                    return getError(
-                        "inflate error after reading " + std::to_string(stream.total_in) + " bytes", ec, stream.msg);
-                compressed = compressed.subspan(stream.total_in - prevTotalIn);
-                decompressed = decompressed.subspan(stream.total_out - prevTotalOut);
-            }
-
-            return std::nullopt;
-        }
-
-        std::unique_ptr<Bsa::MemoryInputStream> decompress(
-            std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
-        {
-            auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
-
-            const std::span decompressed(result->getRawData(), uncompressedSize);
-
-            const auto allError = tryDecompressAll(compressed, decompressed);
-            if (!allError.has_value())
-                return result;
-
-            Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
-                                << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-                                << " uncompressed size = " << uncompressedSize << ": " << *allError
-                                << ". Trying to decompress by block...";
-
-            std::memset(result->getRawData(), 0, uncompressedSize);
-
-            constexpr std::size_t blockSize = 4;
-            const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
-            if (!blockError.has_value())
-                return result;
-
-            std::ostringstream s;
-            s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
-              << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-              << " uncompressed size = " << uncompressedSize << ": " << *blockError;
-            throw std::runtime_error(s.str());
-        }
     }
 
     ReaderContext::ReaderContext()
@@ -250,11 +157,19 @@ namespace ESM4
 
     void Reader::close()
     {
+        mInflater.reset();
         mStream.reset();
         // clearCtx();
         // mHeader.blank();
     }
 
+    void Reader::startInflatingAhead(std::size_t threads)
+    {
+        // Enough to keep the threads busy while the reader is slower on some records than on others
+        const std::size_t maxRecords = 64 * std::max<std::size_t>(threads, 1);
+        mInflater = std::make_unique<RecordInflater>(mCtx.filename, mCtx.recHeaderSize, threads, maxRecords);
+    }
+
     void Reader::openRaw(Files::IStreamPtr&& stream, const std::filesystem::path& filename)
     {
         close();
@@ -523,14 +438,20 @@ namespace ESM4
             const std::streamoff position = mStream->tellg();
 
             const std::uint32_t recordSize = mCtx.recordHeader.record.dataSize - sizeof(std::uint32_t);
-            std::vector<char> compressed(recordSize);
-            mStream->read(compressed.data(), recordSize);
+            std::unique_ptr<Bsa::MemoryInputStream> memoryStreamPtr
+                = mInflater != nullptr ? mInflater->take(position, uncompressedSize) : nullptr;
+            if (memoryStreamPtr != nullptr)
+                mStream->seekg(recordSize, std::ios_base::cur);
+            else
+            {
+                std::vector<char> compressed(recordSize);
+                mStream->read(compressed.data(), recordSize);
+                memoryStreamPtr = inflateRecord(position, compressed, uncompressedSize);
+            }
             mSavedStream = std::move(mStream);
 
             mCtx.recordHeader.record.dataSize = uncompressedSize - sizeof(uncompressedSize);
 
-            auto memoryStreamPtr = decompress(position, compressed, uncompressedSize);
-
             // For debugging only
             // #if 0
             if (dump)
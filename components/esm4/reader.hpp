@@ -33,6 +33,7 @@
 #include "cellgrid.hpp"
 #include "common.hpp"
 #include "loadtes4.hpp"
+#include "recordinflater.hpp"
 
 #include <components/esm/formid.hpp>
 #include <components/files/istreamptr.hpp>
@@ -156,6 +157,7 @@ namespace ESM4
 
         Files::IStreamPtr mStream;
         Files::IStreamPtr mSavedStream; // mStream is saved here while using deflated memory stream
+        std::unique_ptr<RecordInflater> mInflater;
 
         Files::IStreamPtr mStrings;
         Files::IStreamPtr mILStrings;
@@ -202,6 +204,10 @@ namespace ESM4
 
         void close();
 
+        /// Read and inflate compressed records on the given number of threads ahead of the calls to getRecordData().
+        /// @note Records are still read in order, the file is opened once more by name.
+        void startInflatingAhead(std::size_t threads);
+
         inline bool isEsm4() const { return true; }
 
         const std::vector<ESM::MasterData>& getGameFiles() const { return mHeader.mMaster; }
@@ -0,0 +1,291 @@
+#include "recordinflater.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+#include <components/bsa/memorystream.hpp>
+#include <components/debug/debuglog.hpp>
+#include <components/files/constrainedfilestream.hpp>
+
+#include "common.hpp"
+#include "reader.hpp"
+
+namespace ESM4
+{
+    namespace
+    {
+        std::string getError(const std::string& header, const int errorCode, const char* msg)
+        {
+            return header + ": code " + std::to_string(errorCode) + ", " + std::string(msg != nullptr ? msg : "(null)");
+        }
+
+        struct InflateEnd
+        {
+            void operator()(z_stream* stream) const { inflateEnd(stream); }
+        };
+
+        // Initializing a zlib stream allocates its window, records are small enough for this to matter
+        class ReusedInflateStream
+        {
+        public:
+            std::optional<std::string> tryInflate(std::span<char> compressed, std::span<char> decompressed)
+            {
+                if (mStream == nullptr)
+                {
+                    if (const int ec = inflateInit(&mStorage); ec != Z_OK)
+                        return getError("inflateInit error", ec, mStorage.msg);
+                    mStream.reset(&mStorage);
+                }
+                else if (const int ec = inflateReset(mStream.get()); ec != Z_OK)
+                    return getError("inflateReset error", ec, mStream->msg);
+
+                mStream->next_in = reinterpret_cast<Bytef*>(compressed.data());
+                mStream->next_out = reinterpret_cast<Bytef*>(decompressed.data());
+                mStream->avail_in = static_cast<uInt>(compressed.size());
+                mStream->avail_out = static_cast<uInt>(decompressed.size());
+
+                if (const int ec = ::inflate(mStream.get(), Z_NO_FLUSH); ec != Z_STREAM_END)
+                    return getError("inflate error", ec, mStream->msg);
+
+                return std::nullopt;
+            }
+
+        private:
+            z_stream mStorage{};
+            std::unique_ptr<z_stream, InflateEnd> mStream;
+        };
+
+        std::optional<std::string> tryDecompressByBlock(
+            std::span<char> compressed, std::span<char> decompressed, std::size_t blockSize)
+        {
+            z_stream stream{};
+
+            if (const int ec = inflateInit(&stream); ec != Z_OK)
+                return getError("inflateInit error", ec, stream.msg);
+
+            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
+
+            while (!compressed.empty() && !decompressed.empty())
+            {
+                const auto prevTotalIn = stream.total_in;
+                const auto prevTotalOut = stream.total_out;
+                stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
+                stream.avail_in = static_cast<uInt>(std::min(blockSize, compressed.size()));
+                stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
+                stream.avail_out = static_cast<uInt>(std::min(blockSize, decompressed.size()));
+                const int ec = ::inflate(&stream, Z_NO_FLUSH);
+                if (ec == Z_STREAM_END)
+                    break;
+                if (ec != Z_OK)
+                    return getError(
+                        "inflate error after reading " + std::to_string(stream.total_in) + " bytes", ec, stream.msg);
+                compressed = compressed.subspan(stream.total_in - prevTotalIn);
+                decompressed = decompressed.subspan(stream.total_out - prevTotalOut);
+            }
+
+            return std::nullopt;
+        }
+    }
+
+    std::unique_ptr<Bsa::MemoryInputStream> inflateRecord(
+        std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
+    {
+        thread_local ReusedInflateStream stream;
+
+        auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
+
+        const std::span decompressed(result->getRawData(), uncompressedSize);
+
+        const auto allError = stream.tryInflate(compressed, decompressed);
+        if (!allError.has_value())
+            return result;
+
+        Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
+                            << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
+                            << " uncompressed size = " << uncompressedSize << ": " << *allError
+                            << ". Trying to decompress by block...";
+
+        std::memset(result->getRawData(), 0, uncompressedSize);
+
+        constexpr std::size_t blockSize = 4;
+        const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
+        if (!blockError.has_value())
+            return result;
+
+        std::ostringstream s;
+        s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
+          << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
+          << " uncompressed size = " << uncompressedSize << ": " << *blockError;
+        throw std::runtime_error(s.str());
+    }
+
+    struct RecordInflater::Record
+    {
+        enum class State
+        {
+            Queued,
+            Inflating,
+            Done,
+        };
+
+        std::streamoff mPosition;
+        std::uint32_t mUncompressedSize;
+        std::vector<char> mCompressed;
+        State mState = State::Queued;
+        std::unique_ptr<Bsa::MemoryInputStream> mResult;
+        std::exception_ptr mError;
+    };
+
+    RecordInflater::RecordInflater(
+        const std::filesystem::path& path, std::size_t recordHeaderSize, std::size_t threads, std::size_t maxRecords)
+        : mRecordHeaderSize(recordHeaderSize)
+        , mMaxRecords(std::max<std::size_t>(maxRecords, 1))
+    {
+        mThreads.reserve(threads + 1);
+        mThreads.emplace_back([this, path] { scan(path); });
+        for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i)
+            mThreads.emplace_back([this] { inflate(); });
+    }
+
+    RecordInflater::~RecordInflater()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStopped = true;
+        }
+        mCondition.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    std::unique_ptr<Bsa::MemoryInputStream> RecordInflater::take(
+        std::streamoff position, std::uint32_t uncompressedSize)
+    {
+        std::unique_lock lock(mMutex);
+
+        while (true)
+        {
+            // The reader skipped these records without reading their data
+            bool dropped = false;
+            while (!mRecords.empty() && mRecords.front()->mPosition < position)
+            {
+                mRecords.pop_front();
+                dropped = true;
+            }
+            if (dropped)
+                mCondition.notify_all();
+
+            if (!mRecords.empty())
+                break;
+
+            // The reader went back or past the end of the file
+            if (mScanned || mScannedPosition > position)
+                return nullptr;
+
+            mCondition.wait(lock);
+        }
+
+        const std::shared_ptr<Record> record = mRecords.front();
+        if (record->mPosition != position || record->mUncompressedSize != uncompressedSize)
+            return nullptr;
+
+        mCondition.wait(lock, [&] { return record->mState == Record::State::Done; });
+        mRecords.pop_front();
+        mCondition.notify_all();
+
+        if (record->mError != nullptr)
+            std::rethrow_exception(record->mError);
+
+        return std::move(record->mResult);
+    }
+
+    void RecordInflater::scan(const std::filesystem::path& path)
+    {
+        try
+        {
+            const Files::IStreamPtr stream = Files::openConstrainedFileStream(path);
+            RecordHeader header;
+
+            while (stream->read(reinterpret_cast<char*>(&header), mRecordHeaderSize))
+            {
+                // Groups are followed by their records
+                if (header.record.typeId == REC_GRUP)
+                    continue;
+
+                if ((header.record.flags & Rec_Compressed) == 0 || header.record.dataSize < sizeof(std::uint32_t))
+                {
+                    stream->seekg(header.record.dataSize, std::ios_base::cur);
+                    continue;
+                }
+
+                auto record = std::make_shared<Record>();
+                stream->read(reinterpret_cast<char*>(&record->mUncompressedSize), sizeof(std::uint32_t));
+                record->mPosition = stream->tellg();
+                record->mCompressed.resize(header.record.dataSize - sizeof(std::uint32_t));
+                if (!stream->read(record->mCompressed.data(), record->mCompressed.size()))
+                    break;
+
+                std::unique_lock lock(mMutex);
+                mCondition.wait(lock, [&] { return mStopped || mRecords.size() < mMaxRecords; });
+                if (mStopped)
+                    return;
+                mScannedPosition = stream->tellg();
+                mRecords.push_back(std::move(record));
+                mCondition.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read ahead records of " << path << ": " << e.what();
+        }
+
+        {
+            const std::lock_guard lock(mMutex);
+            mScanned = true;
+        }
+        mCondition.notify_all();
+    }
+
+    void RecordInflater::inflate()
+    {
+        while (true)
+        {
+            std::shared_ptr<Record> record;
+
+            {
+                std::unique_lock lock(mMutex);
+                const auto isQueued = [](const auto& v) { return v->mState == Record::State::Queued; };
+                mCondition.wait(lock,
+                    [&] { return mStopped || std::any_of(mRecords.begin(), mRecords.end(), isQueued); });
+                if (mStopped)
+                    return;
+                record = *std::find_if(mRecords.begin(), mRecords.end(), isQueued);
+                record->mState = Record::State::Inflating;
+            }
+
+            try
+            {
+                record->mResult = inflateRecord(record->mPosition, record->mCompressed, record->mUncompressedSize);
+            }
+            catch (...)
+            {
+                record->mError = std::current_exception();
+            }
+            record->mCompressed = std::vector<char>();
+
+            {
+                const std::lock_guard lock(mMutex);
+                record->mState = Record::State::Done;
+            }
+            mCondition.notify_all();
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef OPENMW_COMPONENTS_ESM4_RECORDINFLATER
+#define OPENMW_COMPONENTS_ESM4_RECORDINFLATER
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Bsa
+{
+    class MemoryInputStream;
+}
+
+namespace ESM4
+{
+    /// Inflate the data of a compressed record. Reuses the zlib stream of the calling thread.
+    /// @param position File offset of the compressed data, used for error messages.
+    std::unique_ptr<Bsa::MemoryInputStream> inflateRecord(
+        std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize);
+
+    /// @brief Reads and inflates the compressed records of a file on worker threads ahead of the Reader.
+    /// @par The file is opened once more and its records are walked in file order, descending into every group. At
+    /// most a fixed amount of records is kept read ahead, the oldest ones are dropped when the Reader skips them.
+    class RecordInflater
+    {
+    public:
+        explicit RecordInflater(const std::filesystem::path& path, std::size_t recordHeaderSize, std::size_t threads,
+            std::size_t maxRecords);
+
+        ~RecordInflater();
+
+        /// @return Inflated data of the compressed record with the data at the position, nullptr when the record
+        /// wasn't read ahead and has to be inflated by the caller.
+        /// @note Records are expected to be taken in file order, those before the position are dropped.
+        std::unique_ptr<Bsa::MemoryInputStream> take(std::streamoff position, std::uint32_t uncompressedSize);
+
+    private:
+        struct Record;
+
+        const std::size_t mRecordHeaderSize;
+        const std::size_t mMaxRecords;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<std::shared_ptr<Record>> mRecords;
+        std::streamoff mScannedPosition = 0;
+        bool mScanned = false;
+        bool mStopped = false;
+        std::vector<std::thread> mThreads;
+
+        void scan(const std::filesystem::path& path);
+
+        void inflate();
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "blendmapcache.hpp"
+
+#include <osg/Image>
+
+namespace ESMTerrain
+{
+    namespace
+    {
+        std::size_t getDataSize(const Blendmaps& value)
+        {
+            std::size_t result = 0;
+            for (const osg::ref_ptr<osg::Image>& image : value.mImages)
+                result += image->getTotalDataSize();
+            return result;
+        }
+    }
+
+    BlendmapCache::BlendmapCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::shared_ptr<const Blendmaps> BlendmapCache::get(const BlendmapKey& key)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mIndex.find(key);
+        if (it == mIndex.end())
+            return nullptr;
+        mItems.splice(mItems.begin(), mItems, it->second);
+        return it->second->mValue;
+    }
+
+    void BlendmapCache::insert(const BlendmapKey& key, std::shared_ptr<const Blendmaps> value)
+    {
+        const std::size_t size = getDataSize(*value);
+        const std::lock_guard lock(mMutex);
+        if (const auto it = mIndex.find(key); it != mIndex.end())
+        {
+            mSize -= it->second->mSize;
+            mItems.erase(it->second);
+            mIndex.erase(it);
+        }
+        mItems.push_front(Item{ key, std::move(value), size });
+        mIndex.emplace(key, mItems.begin());
+        mSize += size;
+        // The inserted item stays even when it alone is larger than the limit
+        while (mSize > mMaxSize && mItems.size() > 1)
+        {
+            const Item& last = mItems.back();
+            mSize -= last.mSize;
+            mIndex.erase(last.mKey);
+            mItems.pop_back();
+        }
+    }
+
+    void BlendmapCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mIndex.clear();
+        mItems.clear();
+        mSize = 0;
+    }
+
+    std::size_t BlendmapCache::getSize() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mSize;
+    }
+
+    std::size_t BlendmapCache::getCount() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mItems.size();
+    }
+}
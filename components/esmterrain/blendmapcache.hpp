@@ -0,0 +1,75 @@
+#ifndef OPENMW_COMPONENTS_ESMTERRAIN_BLENDMAPCACHE_H
+#define OPENMW_COMPONENTS_ESMTERRAIN_BLENDMAPCACHE_H
+
+#include <components/esm/refid.hpp>
+#include <components/terrain/defs.hpp>
+#include <components/terrain/storage.hpp>
+
+#include <osg/Vec2f>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace ESMTerrain
+{
+    struct Blendmaps
+    {
+        Terrain::Storage::ImageVector mImages;
+        std::vector<Terrain::LayerInfo> mLayers;
+    };
+
+    struct BlendmapKey
+    {
+        ESM::RefId mWorldspace;
+        float mChunkSize;
+        osg::Vec2f mChunkCenter;
+
+        friend bool operator<(const BlendmapKey& l, const BlendmapKey& r)
+        {
+            return std::tie(l.mWorldspace, l.mChunkSize, l.mChunkCenter)
+                < std::tie(r.mWorldspace, r.mChunkSize, r.mChunkCenter);
+        }
+    };
+
+    /// @brief Keeps the blendmaps of the most recently requested terrain chunks, so chunks of every LOD level,
+    /// composite maps and snow detection don't each generate them again from the land records.
+    /// @note Thread safe. The cached images are shared with every consumer and must not be changed.
+    class BlendmapCache
+    {
+    public:
+        /// @param maxSize how many bytes of image data may be kept before the least recently used chunks are evicted
+        explicit BlendmapCache(std::size_t maxSize);
+
+        std::shared_ptr<const Blendmaps> get(const BlendmapKey& key);
+
+        void insert(const BlendmapKey& key, std::shared_ptr<const Blendmaps> value);
+
+        void clear();
+
+        std::size_t getSize() const;
+
+        std::size_t getCount() const;
+
+    private:
+        struct Item
+        {
+            BlendmapKey mKey;
+            std::shared_ptr<const Blendmaps> mValue;
+            std::size_t mSize;
+        };
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        std::size_t mSize = 0;
+        // Most recently used first
+        std::list<Item> mItems;
+        std::map<BlendmapKey, std::list<Item>::iterator> mIndex;
+    };
+}
+
+#endif
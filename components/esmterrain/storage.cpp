@@ -1,6 +1,9 @@
 #include "storage.hpp"
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 #include <stdexcept>
 
@@ -24,6 +27,9 @@ namespace ESMTerrain
 {
     namespace
     {
+        // Enough for the chunks around the player at every LOD level and their composite maps
+        constexpr std::size_t blendmapCacheSize = 64 * 1024 * 1024;
+
         UniqueTextureId getTextureIdAt(const LandObject* land, std::size_t x, std::size_t y)
         {
             assert(x < ESM::Land::LAND_TEXTURE_SIZE);
@@ -98,6 +104,10 @@ namespace ESMTerrain
     LandObject::LandObject(const ESM::Land& land, int loadFlags)
         : mData(land, loadFlags)
     {
+        constexpr int loadableTypes
+            = ESM::Land::DATA_VNML | ESM::Land::DATA_VHGT | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+        if ((land.mDataTypes & loadableTypes & ~mData.getLoadFlags()) != 0)
+            mLand = land;
     }
 
     LandObject::LandObject(const LandObject& /*copy*/, const osg::CopyOp& /*copyOp*/)
@@ -105,6 +115,25 @@ namespace ESMTerrain
         throw std::logic_error("LandObject copy constructor is not implemented");
     }
 
+    const ESM::LandData* LandObject::getData(int flags) const
+    {
+        if ((mData.getLoadFlags() & flags) == flags)
+            return &mData;
+
+        if (!mLand.has_value())
+            return nullptr;
+
+        const std::lock_guard lock(mMutex);
+        auto it = mLazyData.find(flags);
+        if (it == mLazyData.end())
+            it = mLazyData.emplace(flags, std::make_unique<const ESM::LandData>(*mLand, flags)).first;
+
+        if ((it->second->getLoadFlags() & flags) != flags)
+            return nullptr;
+
+        return it->second.get();
+    }
+
     const float defaultHeight = ESM::Land::DEFAULT_HEIGHT;
 
     Storage::Storage(const VFS::Manager* vfs, std::string_view normalMapPattern,
@@ -116,6 +145,7 @@ namespace ESMTerrain
         , mAutoUseNormalMaps(autoUseNormalMaps)
         , mSpecularMapPattern(specularMapPattern)
         , mAutoUseSpecularMaps(autoUseSpecularMaps)
+        , mBlendmapCache(blendmapCacheSize)
     {
     }
 
@@ -482,12 +512,25 @@ namespace ESMTerrain
     void Storage::getBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
         std::vector<Terrain::LayerInfo>& layerList, ESM::RefId worldspace)
     {
-        if (ESM::isEsm4Ext(worldspace))
+        const BlendmapKey key{ worldspace, chunkSize, chunkCenter };
+        std::shared_ptr<const Blendmaps> cached = mBlendmapCache.get(key);
+        if (cached == nullptr)
         {
-            getEsm4Blendmaps(chunkSize, chunkCenter, blendmaps, layerList, worldspace);
-            return;
+            auto generated = std::make_shared<Blendmaps>();
+            if (ESM::isEsm4Ext(worldspace))
+                getEsm4Blendmaps(chunkSize, chunkCenter, generated->mImages, generated->mLayers, worldspace);
+            else
+                getEsm3Blendmaps(chunkSize, chunkCenter, generated->mImages, generated->mLayers, worldspace);
+            mBlendmapCache.insert(key, generated);
+            cached = std::move(generated);
         }
+        blendmaps.insert(blendmaps.end(), cached->mImages.begin(), cached->mImages.end());
+        layerList.insert(layerList.end(), cached->mLayers.begin(), cached->mLayers.end());
+    }
 
+    void Storage::getEsm3Blendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
+        std::vector<Terrain::LayerInfo>& layerList, ESM::RefId worldspace)
+    {
         const osg::Vec2f origin = chunkCenter - osg::Vec2f(chunkSize, chunkSize) * 0.5f;
         const int startCellX = static_cast<int>(std::floor(origin.x()));
         const int startCellY = static_cast<int>(std::floor(origin.y()));
@@ -515,13 +558,16 @@ namespace ESMTerrain
 
         sampleBlendmaps(chunkSize, origin.x(), origin.y(), ESM::Land::LAND_TEXTURE_SIZE, handleSample);
 
-        std::map<UniqueTextureId, std::size_t> textureIndicesMap;
+        // Neighbouring samples mostly have the same texture, so the map is only searched when it changes
+        std::map<UniqueTextureId, std::uint16_t> textureIndicesMap;
+        std::vector<std::uint16_t> layerIndices(textureIds.size());
+        std::optional<std::pair<UniqueTextureId, std::uint16_t>> lastTexture;
 
-        for (std::size_t y = 0; y < blendmapSize; ++y)
+        for (std::size_t i = 0; i < textureIds.size(); ++i)
         {
-            for (std::size_t x = 0; x < blendmapSize; ++x)
+            const UniqueTextureId id = textureIds[i];
+            if (!lastTexture.has_value() || lastTexture->first != id)
             {
-                const UniqueTextureId id = textureIds[y * blendmapSize + x];
                 auto found = textureIndicesMap.find(id);
                 if (found == textureIndicesMap.end())
                 {
@@ -529,40 +575,55 @@ namespace ESMTerrain
                     Terrain::LayerInfo info = getLayerInfo(getTextureName(id));
 
                     // look for existing diffuse map, which may be present when several plugins use the same texture
-                    for (std::size_t i = 0; i < layerList.size(); ++i)
+                    for (std::size_t j = 0; j < layerList.size(); ++j)
                     {
-                        if (layerList[i].mDiffuseMap == info.mDiffuseMap)
+                        if (layerList[j].mDiffuseMap == info.mDiffuseMap)
                         {
-                            layerIndex = i;
+                            layerIndex = j;
                             break;
                         }
                     }
 
-                    found = textureIndicesMap.emplace(id, layerIndex).first;
+                    found = textureIndicesMap.emplace(id, static_cast<std::uint16_t>(layerIndex)).first;
 
                     if (layerIndex >= layerList.size())
-                    {
-                        osg::ref_ptr<osg::Image> image(new osg::Image);
-                        image->allocateImage(static_cast<int>(blendmapImageSize), static_cast<int>(blendmapImageSize),
-                            1, GL_ALPHA, GL_UNSIGNED_BYTE);
-                        std::memset(image->data(), 0, image->getTotalDataSize());
-                        blendmaps.push_back(std::move(image));
                         layerList.push_back(std::move(info));
-                    }
                 }
-                const std::size_t layerIndex = found->second;
-                unsigned char* const data = blendmaps[layerIndex]->data();
-                const std::size_t realY = (blendmapSize - y - 1) * imageScaleFactor;
-                const std::size_t realX = x * imageScaleFactor;
-                data[((realY + 0) * blendmapImageSize + realX + 0)] = 255;
-                data[((realY + 1) * blendmapImageSize + realX + 0)] = 255;
-                data[((realY + 0) * blendmapImageSize + realX + 1)] = 255;
-                data[((realY + 1) * blendmapImageSize + realX + 1)] = 255;
+                lastTexture.emplace(id, found->second);
             }
+            layerIndices[i] = lastTexture->second;
         }
 
-        if (blendmaps.size() == 1)
-            blendmaps.clear(); // If a single texture fills the whole terrain, there is no need to blend
+        // If a single texture fills the whole terrain, there is no need to blend
+        if (layerList.size() <= 1)
+            return;
+
+        // Every image is written whole by a branchless loop over packed indices, which compilers vectorize
+        for (std::size_t layer = 0; layer < layerList.size(); ++layer)
+        {
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->allocateImage(static_cast<int>(blendmapImageSize), static_cast<int>(blendmapImageSize), 1,
+                GL_ALPHA, GL_UNSIGNED_BYTE);
+            unsigned char* const data = image->data();
+            for (std::size_t y = 0; y < blendmapSize; ++y)
+            {
+                const std::uint16_t* const indices = layerIndices.data() + y * blendmapSize;
+                unsigned char* const row = data + (blendmapSize - y - 1) * imageScaleFactor * blendmapImageSize;
+                for (std::size_t x = 0; x < blendmapSize; ++x)
+                {
+                    const unsigned char value = indices[x] == layer ? 255 : 0;
+                    row[x * imageScaleFactor + 0] = value;
+                    row[x * imageScaleFactor + 1] = value;
+                }
+                std::memcpy(row + blendmapImageSize, row, blendmapImageSize);
+            }
+            blendmaps.push_back(std::move(image));
+        }
+    }
+
+    void Storage::clearCache()
+    {
+        mBlendmapCache.clear();
     }
 
     float Storage::getHeightAt(const osg::Vec3f& worldPos, ESM::RefId worldspace)
@@ -571,9 +632,40 @@ namespace ESMTerrain
         int cellX = static_cast<int>(std::floor(worldPos.x() / cellSize));
         int cellY = static_cast<int>(std::floor(worldPos.y() / cellSize));
 
-        osg::ref_ptr<const LandObject> land = getLand(ESM::ExteriorCellLocation(cellX, cellY, worldspace));
+        const ESM::ExteriorCellLocation cellLocation(cellX, cellY, worldspace);
+        osg::ref_ptr<const LandObject> land = getLand(cellLocation);
+        return interpolateHeight(land.get(), worldPos, cellLocation, cellSize);
+    }
+
+    void Storage::getHeightsAt(std::span<const osg::Vec3f> worldPos, ESM::RefId worldspace, std::span<float> heights)
+    {
+        assert(heights.size() >= worldPos.size());
+        const float cellSize = ESM::getCellSize(worldspace);
+
+        // Positions of a batch are usually close to each other, so the land is only looked up when the cell changes
+        std::optional<ESM::ExteriorCellLocation> lastCellLocation;
+        osg::ref_ptr<const LandObject> land;
+        for (std::size_t i = 0; i < worldPos.size(); ++i)
+        {
+            const ESM::ExteriorCellLocation cellLocation(static_cast<int>(std::floor(worldPos[i].x() / cellSize)),
+                static_cast<int>(std::floor(worldPos[i].y() / cellSize)), worldspace);
+            if (cellLocation != lastCellLocation)
+            {
+                land = getLand(cellLocation);
+                lastCellLocation = cellLocation;
+            }
+            heights[i] = interpolateHeight(land.get(), worldPos[i], cellLocation, cellSize);
+        }
+    }
+
+    float Storage::interpolateHeight(
+        const LandObject* land, const osg::Vec3f& worldPos, ESM::ExteriorCellLocation cellLocation, float cellSize)
+    {
         if (!land)
-            return ESM::isEsm4Ext(worldspace) ? std::numeric_limits<float>::lowest() : defaultHeight;
+            return ESM::isEsm4Ext(cellLocation.mWorldspace) ? std::numeric_limits<float>::lowest() : defaultHeight;
+
+        const int cellX = cellLocation.mX;
+        const int cellY = cellLocation.mY;
 
         const ESM::LandData* data = land->getData(ESM::Land::DATA_VHGT);
         if (!data)
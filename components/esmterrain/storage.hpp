@@ -2,15 +2,21 @@
 #define OPENMW_COMPONENTS_ESMTERRAIN_STORAGE_H
 
 #include <cassert>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 
 #include <components/terrain/defs.hpp>
 #include <components/terrain/storage.hpp>
 
 #include <components/esm/esmterrain.hpp>
 #include <components/esm/exteriorcelllocation.hpp>
+#include <components/esm3/loadland.hpp>
 #include <components/esm3/loadltex.hpp>
 
+#include "blendmapcache.hpp"
+
 namespace ESM4
 {
     struct Land;
@@ -39,18 +45,17 @@ namespace ESMTerrain
     {
     public:
         LandObject() = default;
+
+        /// @param loadFlags data types to load right away, other types present in the record are loaded separately on
+        /// first request, so the consumers of heights never decode normals, colours and textures
         LandObject(const ESM::Land& land, int loadFlags);
+
         LandObject(const ESM4::Land& land, int loadFlags);
 
         META_Object(ESMTerrain, LandObject)
 
-        const ESM::LandData* getData(int flags) const
-        {
-            if ((mData.getLoadFlags() & flags) != flags)
-                return nullptr;
-
-            return &mData;
-        }
+        /// Safe to call from any thread, returned data stays valid as long as the object.
+        const ESM::LandData* getData(int flags) const;
 
         int getPlugin() const { return mData.getPlugin(); }
 
@@ -59,6 +64,11 @@ namespace ESMTerrain
     private:
         ESM::LandData mData;
 
+        // Only when there is something left to load
+        std::optional<ESM::Land> mLand;
+        mutable std::mutex mMutex;
+        mutable std::map<int, std::unique_ptr<const ESM::LandData>> mLazyData;
+
         Terrain::LayerInfo mEsm4DefaultLayerInfo;
 
         LandObject(const LandObject& copy, const osg::CopyOp& copyOp);
@@ -124,8 +134,14 @@ namespace ESMTerrain
         void getBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
             std::vector<Terrain::LayerInfo>& layerList, ESM::RefId worldspace) override;
 
+        /// Forget the blendmaps generated so far, for when land or land texture records change.
+        void clearCache() override;
+
         float getHeightAt(const osg::Vec3f& worldPos, ESM::RefId worldspace) override;
 
+        void getHeightsAt(
+            std::span<const osg::Vec3f> worldPos, ESM::RefId worldspace, std::span<float> heights) override;
+
         /// Get the transformation factor for mapping cell units to world units.
         float getCellWorldSize(ESM::RefId worldspace) override;
 
@@ -154,6 +170,9 @@ namespace ESMTerrain
 
         inline const LandObject* getLand(ESM::ExteriorCellLocation cellLocation, LandCache& cache);
 
+        float interpolateHeight(const LandObject* land, const osg::Vec3f& worldPos,
+            ESM::ExteriorCellLocation cellLocation, float cellSize);
+
         virtual bool useAlteration() const { return false; }
         virtual void adjustColor(int col, int row, const ESM::LandData* heightData, osg::Vec4ub& color) const;
         virtual float getAlteredHeight(int col, int row) const;
@@ -170,10 +189,15 @@ namespace ESMTerrain
         std::string mSpecularMapPattern;
         bool mAutoUseSpecularMaps;
 
+        BlendmapCache mBlendmapCache;
+
         Terrain::LayerInfo getLayerInfo(const std::string& texture);
         Terrain::LayerInfo getTextureSetLayerInfo(const ESM4::TextureSet& txst);
         Terrain::LayerInfo getLandTextureLayerInfo(ESM::FormId id);
 
+        void getEsm3Blendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
+            std::vector<Terrain::LayerInfo>& layerList, ESM::RefId worldspace);
+
         void getEsm4Blendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
             std::vector<Terrain::LayerInfo>& layerList, ESM::RefId worldspace);
     };
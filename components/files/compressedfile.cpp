@@ -0,0 +1,192 @@
+#include "compressedfile.hpp"
+
+#include "conversion.hpp"
+#include "streamwithbuffer.hpp"
+
+#include <components/misc/compression.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+namespace Files
+{
+    namespace
+    {
+        namespace File = Platform::File;
+
+        constexpr std::string_view magic("OMWLZ4B\x01", 8);
+
+        // Magic, size of the content and size of a block before compression
+        constexpr std::size_t headerSize = magic.size() + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+        std::uint32_t readUInt32(File::Handle handle)
+        {
+            std::uint32_t value = 0;
+            if (File::read(handle, &value, sizeof(value)) != sizeof(value))
+                throw std::runtime_error("Unexpected end of compressed file");
+            return value;
+        }
+
+        template <class T>
+        void write(std::ostream& stream, T value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    CompressedFileStreamBuf::CompressedFileStreamBuf(const std::filesystem::path& path)
+        : mFile(File::open(path))
+    {
+        std::array<char, headerSize> header;
+        if (File::read(mFile, header.data(), header.size()) != header.size()
+            || !isCompressedFile(std::string_view(header.data(), header.size())))
+            throw std::runtime_error("Not a compressed file: " + pathToUnicodeString(path));
+
+        std::uint64_t size = 0;
+        std::uint32_t blockSize = 0;
+        std::memcpy(&size, header.data() + magic.size(), sizeof(size));
+        std::memcpy(&blockSize, header.data() + magic.size() + sizeof(size), sizeof(blockSize));
+        if (blockSize == 0)
+            throw std::runtime_error("Invalid block size in compressed file: " + pathToUnicodeString(path));
+
+        mSize = static_cast<std::size_t>(size);
+        mBlockSize = blockSize;
+        mBlockOffsets.push_back(headerSize);
+
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    std::streambuf::int_type CompressedFileStreamBuf::underflow()
+    {
+        if (gptr() == egptr())
+        {
+            if (mNextBlock >= getBlockCount())
+                return traits_type::eof();
+            loadBlock(mNextBlock);
+        }
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streambuf::pos_type CompressedFileStreamBuf::seekoff(
+        off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        off_type newPos;
+        switch (whence)
+        {
+            case std::ios_base::beg:
+                newPos = offset;
+                break;
+            case std::ios_base::cur:
+                newPos = static_cast<off_type>(mBufferStart + (gptr() - eback())) + offset;
+                break;
+            case std::ios_base::end:
+                newPos = static_cast<off_type>(mSize) + offset;
+                break;
+            default:
+                return traits_type::eof();
+        }
+
+        if (newPos < 0)
+            return traits_type::eof();
+
+        return seekpos(newPos, mode);
+    }
+
+    std::streambuf::pos_type CompressedFileStreamBuf::seekpos(pos_type pos, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        const std::size_t position = static_cast<std::size_t>(pos);
+        if (position > mSize)
+            return traits_type::eof();
+
+        if (position == mSize)
+        {
+            mNextBlock = getBlockCount();
+            mBufferStart = mSize;
+            setg(nullptr, nullptr, nullptr);
+            return pos;
+        }
+
+        const std::size_t block = position / mBlockSize;
+        // Seeking within the current block is common when skipping small records
+        if (eback() == nullptr || block + 1 != mNextBlock)
+            loadBlock(block);
+
+        setg(eback(), eback() + (position - mBufferStart), egptr());
+        return pos;
+    }
+
+    void CompressedFileStreamBuf::loadBlock(std::size_t index)
+    {
+        while (mBlockOffsets.size() <= index)
+        {
+            File::seek(mFile, mBlockOffsets.back());
+            const std::uint32_t size = readUInt32(mFile);
+            mBlockOffsets.push_back(mBlockOffsets.back() + sizeof(size) + size);
+        }
+
+        File::seek(mFile, mBlockOffsets[index]);
+        const std::uint32_t size = readUInt32(mFile);
+        if (size < sizeof(std::size_t))
+            throw std::runtime_error("Invalid compressed block");
+        std::vector<std::byte> compressed(size);
+        if (File::read(mFile, compressed.data(), size) != size)
+            throw std::runtime_error("Unexpected end of compressed file");
+
+        mBuffer = Misc::decompress(compressed);
+        if (mBuffer.size() != std::min(mBlockSize, mSize - index * mBlockSize))
+            throw std::runtime_error("Invalid size of decompressed block");
+
+        mNextBlock = index + 1;
+        mBufferStart = index * mBlockSize;
+        char* const begin = reinterpret_cast<char*>(mBuffer.data());
+        setg(begin, begin, begin + mBuffer.size());
+    }
+
+    bool isCompressedFile(std::string_view prefix)
+    {
+        return prefix.starts_with(magic);
+    }
+
+    bool isCompressedFile(const std::filesystem::path& path)
+    {
+        const File::ScopedHandle file(File::open(path));
+        std::array<char, magic.size()> prefix;
+        const std::size_t size = File::read(file, prefix.data(), prefix.size());
+        return isCompressedFile(std::string_view(prefix.data(), size));
+    }
+
+    void writeCompressedFile(std::string_view data, std::ostream& stream, std::size_t blockSize)
+    {
+        stream.write(magic.data(), static_cast<std::streamsize>(magic.size()));
+        write(stream, static_cast<std::uint64_t>(data.size()));
+        write(stream, static_cast<std::uint32_t>(blockSize));
+
+        std::vector<std::byte> block;
+        for (std::size_t offset = 0; offset < data.size(); offset += blockSize)
+        {
+            const std::string_view part = data.substr(offset, blockSize);
+            block.resize(part.size());
+            std::memcpy(block.data(), part.data(), part.size());
+            const std::vector<std::byte> compressed = Misc::compress(block);
+            write(stream, static_cast<std::uint32_t>(compressed.size()));
+            stream.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+        }
+    }
+
+    IStreamPtr openCompressedFileStream(const std::filesystem::path& path)
+    {
+        return std::make_unique<StreamWithBuffer<CompressedFileStreamBuf>>(
+            std::make_unique<CompressedFileStreamBuf>(path));
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef OPENMW_COMPONENTS_FILES_COMPRESSEDFILE_H
+#define OPENMW_COMPONENTS_FILES_COMPRESSEDFILE_H
+
+#include "istreamptr.hpp"
+
+#include <components/platform/file.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+namespace Files
+{
+    /// @brief Content of a file written by writeCompressedFile. Only the blocks being read are decompressed, so reading
+    /// the beginning of a large file is cheap.
+    class CompressedFileStreamBuf final : public std::streambuf
+    {
+    public:
+        explicit CompressedFileStreamBuf(const std::filesystem::path& path);
+
+        int_type underflow() final;
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) final;
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) final;
+
+    private:
+        Platform::File::ScopedHandle mFile;
+        std::size_t mSize = 0;
+        std::size_t mBlockSize = 0;
+        // File offsets of the blocks found so far
+        std::vector<std::size_t> mBlockOffsets;
+        std::size_t mNextBlock = 0;
+        // Position of the buffer beginning in the decompressed content
+        std::size_t mBufferStart = 0;
+        std::vector<std::byte> mBuffer;
+
+        std::size_t getBlockCount() const { return (mSize + mBlockSize - 1) / mBlockSize; }
+
+        void loadBlock(std::size_t index);
+    };
+
+    /// @return Whether the data starts like a file written by writeCompressedFile.
+    bool isCompressedFile(std::string_view prefix);
+
+    bool isCompressedFile(const std::filesystem::path& path);
+
+    /// Write the data split into LZ4 compressed blocks of the given size before compression.
+    void writeCompressedFile(std::string_view data, std::ostream& stream, std::size_t blockSize = 256 * 1024);
+
+    IStreamPtr openCompressedFileStream(const std::filesystem::path& path);
+}
+
+#endif
@@ -39,6 +39,7 @@ namespace Fx
 
         DispatchNode(const DispatchNode& other, const osg::CopyOp& copyOp = osg::CopyOp::SHALLOW_COPY)
             : mHandle(other.mHandle)
+            , mName(other.mName)
             , mFlags(other.mFlags)
             , mRootStateSet(other.mRootStateSet)
         {
@@ -87,6 +88,9 @@ namespace Fx
         // not safe to read/write in draw thread
         std::shared_ptr<Fx::Technique> mHandle = nullptr;
 
+        // name of the technique, safe to read in draw thread
+        std::string mName;
+
         FlagsType mFlags = 0;
 
         std::vector<SubPass> mPasses;
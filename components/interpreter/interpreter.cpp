@@ -1,5 +1,6 @@
 #include "interpreter.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <format>
 #include <stdexcept>
@@ -34,6 +35,19 @@ namespace Interpreter
             }
             return it->second;
         }
+
+        template <typename T>
+        auto findOpcode(const T& segment, int opcode)
+        {
+            auto it = segment.find(opcode);
+            return it == segment.end() ? nullptr : it->second.get();
+        }
+    }
+
+    std::uint64_t Interpreter::makeId()
+    {
+        static std::atomic<std::uint64_t> nextId{ 1 };
+        return nextId++;
     }
 
     [[noreturn]] void Interpreter::abortDuplicateInstruction(std::string_view name, int code)
@@ -88,6 +102,41 @@ namespace Interpreter
         abortUnknownSegment(code);
     }
 
+    DecodedInstruction Interpreter::decode(Type_Code code) const
+    {
+        // Same layout as in execute
+        switch (code >> 30)
+        {
+            case 0:
+                return { nullptr, findOpcode(mSegment0, code >> 24), code & 0xffffff };
+            case 2:
+                return { nullptr, findOpcode(mSegment2, (code >> 20) & 0x3ff), code & 0xfffff };
+        }
+
+        switch (code >> 26)
+        {
+            case 0x30:
+                return { nullptr, findOpcode(mSegment3, (code >> 8) & 0x3ffff), code & 0xff };
+            case 0x32:
+                return { findOpcode(mSegment5, code & 0x3ffffff), nullptr, 0 };
+        }
+
+        return {};
+    }
+
+    const std::vector<DecodedInstruction>& Interpreter::getDecoded(const Program& program) const
+    {
+        if (program.mDecodedBy != mId)
+        {
+            program.mDecoded.clear();
+            program.mDecoded.reserve(program.mInstructions.size());
+            for (const Type_Code code : program.mInstructions)
+                program.mDecoded.push_back(decode(code));
+            program.mDecodedBy = mId;
+        }
+        return program.mDecoded;
+    }
+
     void Interpreter::begin()
     {
         if (mRunning)
@@ -123,11 +172,20 @@ namespace Interpreter
         {
             mRuntime.configure(program, context);
 
-            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < program.mInstructions.size())
+            // Opcodes are looked up once per program instead of on every executed instruction
+            const std::vector<DecodedInstruction>& decoded = getDecoded(program);
+
+            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < decoded.size())
             {
-                const Type_Code instruction = program.mInstructions[mRuntime.getPC()];
-                mRuntime.setPC(mRuntime.getPC() + 1);
-                execute(instruction);
+                const int pc = mRuntime.getPC();
+                const DecodedInstruction& instruction = decoded[pc];
+                mRuntime.setPC(pc + 1);
+                if (instruction.mOpcode1 != nullptr)
+                    instruction.mOpcode1->execute(mRuntime, instruction.mArg0);
+                else if (instruction.mOpcode0 != nullptr)
+                    instruction.mOpcode0->execute(mRuntime);
+                else
+                    execute(program.mInstructions[pc]); // Reports the unknown instruction
             }
         }
         catch (...)
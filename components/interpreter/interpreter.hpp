@@ -1,10 +1,12 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <stack>
 #include <utility>
+#include <vector>
 
 #include "opcodes.hpp"
 #include "runtime.hpp"
@@ -12,6 +14,7 @@
 
 namespace Interpreter
 {
+    struct DecodedInstruction;
     struct Program;
 
     class Interpreter
@@ -19,13 +22,21 @@ namespace Interpreter
         std::stack<Runtime> mCallstack;
         bool mRunning = false;
         Runtime mRuntime;
+        // Unique for every set of installed opcodes, so programs decoded by another interpreter are decoded again
+        std::uint64_t mId = makeId();
         std::map<int, std::unique_ptr<Opcode1>> mSegment0;
         std::map<int, std::unique_ptr<Opcode1>> mSegment2;
         std::map<int, std::unique_ptr<Opcode1>> mSegment3;
         std::map<int, std::unique_ptr<Opcode0>> mSegment5;
 
+        static std::uint64_t makeId();
+
         void execute(Type_Code code);
 
+        DecodedInstruction decode(Type_Code code) const;
+
+        const std::vector<DecodedInstruction>& getDecoded(const Program& program) const;
+
         void begin();
 
         void end();
@@ -38,6 +49,7 @@ namespace Interpreter
             if (segment.find(code) != segment.end())
                 abortDuplicateInstruction(name, code);
             segment.emplace(code, std::make_unique<T>(std::forward<Args>(args)...));
+            mId = makeId();
         }
 
     public:
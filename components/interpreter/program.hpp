@@ -3,17 +3,33 @@
 
 #include "types.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace Interpreter
 {
+    class Opcode0;
+    class Opcode1;
+
+    /// Instruction with the opcode looked up, both opcodes are null for unknown instructions.
+    struct DecodedInstruction
+    {
+        Opcode0* mOpcode0 = nullptr;
+        Opcode1* mOpcode1 = nullptr;
+        unsigned int mArg0 = 0;
+    };
+
     struct Program
     {
         std::vector<Type_Code> mInstructions;
         std::vector<Type_Integer> mIntegers;
         std::vector<Type_Float> mFloats;
         std::vector<std::string> mStrings;
+
+        // Filled on the first run by the interpreter with id mDecodedBy
+        mutable std::vector<DecodedInstruction> mDecoded;
+        mutable std::uint64_t mDecodedBy = 0;
     };
 }
 
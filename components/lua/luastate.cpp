@@ -4,11 +4,15 @@
 #include <luajit.h>
 #endif // NO_LUAJIT
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <system_error>
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "luastateptr.hpp"
@@ -78,6 +82,42 @@ namespace LuaUtil
         }
     }
 
+    namespace
+    {
+        // Small blocks come from the pool, others from the system allocator
+        void* reallocate(SmallBlockPool& pool, void* ptr, size_t osize, size_t nsize)
+        {
+            const bool oldPooled = SmallBlockPool::isPooled(osize);
+            const bool newPooled = SmallBlockPool::isPooled(nsize);
+            if (!oldPooled && !newPooled)
+            {
+                if (nsize == 0)
+                {
+                    free(ptr);
+                    return nullptr;
+                }
+                return realloc(ptr, nsize);
+            }
+            if (oldPooled && newPooled && SmallBlockPool::isSameClass(osize, nsize))
+                return ptr;
+
+            void* newPtr = nullptr;
+            if (nsize != 0)
+            {
+                newPtr = newPooled ? pool.allocate(nsize) : malloc(nsize);
+                if (!newPtr)
+                    return nullptr;
+            }
+            if (ptr != nullptr && newPtr != nullptr)
+                std::memcpy(newPtr, ptr, std::min(osize, nsize));
+            if (oldPooled)
+                pool.deallocate(ptr, osize);
+            else
+                free(ptr);
+            return newPtr;
+        }
+    }
+
     void* LuaState::trackingAllocator(void* ud, void* ptr, size_t osize, size_t nsize)
     {
         LuaState* self = static_cast<LuaState*>(ud);
@@ -103,17 +143,11 @@ namespace LuaUtil
             return nullptr;
         }
 
-        void* newPtr = nullptr;
-        if (nsize == 0)
-            free(ptr);
-        else
+        void* newPtr = reallocate(self->mSmallBlockPool, ptr, osize, nsize);
+        if (!newPtr && nsize != 0)
         {
-            newPtr = realloc(ptr, nsize);
-            if (!newPtr)
-            {
-                Log(Debug::Error) << "Lua realloc " << osize << "->" << nsize << " failed";
-                return nullptr;
-            }
+            Log(Debug::Error) << "Lua realloc " << osize << "->" << nsize << " failed";
+            return nullptr;
         }
         self->mTotalMemoryUsage += smallAllocDelta + bigAllocDelta;
         self->mSmallAllocMemoryUsage += smallAllocDelta;
@@ -400,20 +434,157 @@ namespace LuaUtil
     sol::function LuaState::loadScriptAndCache(const VFS::Path::Normalized& path)
     {
         auto iter = mCompiledScripts.find(path);
-        if (iter != mCompiledScripts.end())
+        if (iter == mCompiledScripts.end())
         {
-            sol::load_result res = mSol.load(iter->second.as_string_view(), path.value(), sol::load_mode::binary);
-            // Unless we have memory corruption issues, the bytecode is valid at this point, but loading might still
-            // fail because we've hit our Lua memory cap
-            if (!res.valid())
-                throw std::runtime_error("Lua error: " + res.get<std::string>());
-            return res;
+            Files::IStreamPtr stream = mVFS->get(path);
+            const std::array<std::uint64_t, 2> hash = Files::getHash(path.value(), *stream);
+            auto cached = mCachedScripts.find(path);
+            if (cached != mCachedScripts.end() && cached->second.mSourceHash == hash)
+            {
+                iter = mCompiledScripts.insert(mCachedScripts.extract(cached)).position;
+            }
+            else
+            {
+                std::string fileContent(std::istreambuf_iterator<char>(*stream), {});
+                sol::load_result res = mSol.load(fileContent, path.value(), sol::load_mode::text);
+                if (!res.valid())
+                    throw std::runtime_error(std::string("Lua error: ") += res.get<sol::error>().what());
+                sol::function fn = res;
+                mCompiledScripts[path] = CompiledScript{ hash, fn.dump() };
+                mScriptCacheModified = true;
+                return fn;
+            }
         }
-        sol::function res = loadFromVFS(path);
-        mCompiledScripts[path] = res.dump();
+        sol::load_result res
+            = mSol.load(iter->second.mBytecode.as_string_view(), path.value(), sol::load_mode::binary);
+        // Unless we have memory corruption issues, the bytecode is valid at this point, but loading might still
+        // fail because we've hit our Lua memory cap
+        if (!res.valid())
+            throw std::runtime_error("Lua error: " + res.get<std::string>());
         return res;
     }
 
+    namespace
+    {
+        constexpr std::string_view scriptCacheMagic = "OMWLUABC";
+
+        // Bytecode is specific to the Lua implementation and its build
+        std::string getScriptCacheKey()
+        {
+            return getLuaVersion() + ' ' + std::to_string(sizeof(void*));
+        }
+
+        template <class T>
+        T readValue(std::istream& stream)
+        {
+            T value{};
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+            if (!stream)
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        template <class T>
+        void writeValue(std::ostream& stream, T value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string value(readValue<std::uint32_t>(stream), '\0');
+            stream.read(value.data(), static_cast<std::streamsize>(value.size()));
+            if (!stream)
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+    }
+
+    void LuaState::readScriptCache(const std::filesystem::path& path)
+    {
+        mScriptCachePath = path;
+        mCachedScripts.clear();
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+            return;
+        try
+        {
+            std::ifstream stream(path, std::ios::binary);
+            stream.exceptions(std::ios::badbit);
+            std::string magic(scriptCacheMagic.size(), '\0');
+            stream.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+            if (magic != scriptCacheMagic || readString(stream) != getScriptCacheKey())
+            {
+                Log(Debug::Info) << "Lua script cache " << path << " is made by a different Lua version";
+                return;
+            }
+            const auto count = readValue<std::uint32_t>(stream);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                VFS::Path::Normalized scriptPath(readString(stream));
+                CompiledScript script;
+                script.mSourceHash[0] = readValue<std::uint64_t>(stream);
+                script.mSourceHash[1] = readValue<std::uint64_t>(stream);
+                const std::string bytecode = readString(stream);
+                const auto* const data = reinterpret_cast<const std::byte*>(bytecode.data());
+                script.mBytecode = sol::bytecode(data, data + bytecode.size());
+                mCachedScripts.insert_or_assign(std::move(scriptPath), std::move(script));
+            }
+            Log(Debug::Verbose) << "Loaded " << mCachedScripts.size() << " scripts from Lua script cache " << path;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read Lua script cache " << path << ": " << e.what();
+            mCachedScripts.clear();
+        }
+    }
+
+    void LuaState::writeScriptCache() const
+    {
+        if (mScriptCachePath.empty() || !mScriptCacheModified)
+            return;
+
+        // Write to a temporary file first to never leave a partially written cache
+        std::filesystem::path temporary = mScriptCachePath;
+        temporary += ".tmp";
+        try
+        {
+            std::filesystem::create_directories(mScriptCachePath.parent_path());
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                stream.write(scriptCacheMagic.data(), static_cast<std::streamsize>(scriptCacheMagic.size()));
+                writeString(stream, getScriptCacheKey());
+                // Scripts not used in this session are dropped to not let the cache grow forever
+                writeValue(stream, static_cast<std::uint32_t>(mCompiledScripts.size()));
+                for (const auto& [scriptPath, script] : mCompiledScripts)
+                {
+                    writeString(stream, scriptPath.value());
+                    writeValue(stream, script.mSourceHash[0]);
+                    writeValue(stream, script.mSourceHash[1]);
+                    writeString(stream, script.mBytecode.as_string_view());
+                }
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(temporary, mScriptCachePath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write Lua script cache " << mScriptCachePath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
     sol::function LuaState::loadFromVFS(const VFS::Path::Normalized& path)
     {
         std::string fileContent(std::istreambuf_iterator<char>(*mVFS->get(path)), {});
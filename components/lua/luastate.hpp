@@ -1,9 +1,12 @@
 #ifndef COMPONENTS_LUA_LUASTATE_H
 #define COMPONENTS_LUA_LUASTATE_H
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <typeinfo>
+#include <unordered_map>
 
 #include <sol/sol.hpp>
 
@@ -11,6 +14,7 @@
 
 #include "configuration.hpp"
 #include "luastateptr.hpp"
+#include "smallblockpool.hpp"
 
 namespace VFS
 {
@@ -161,6 +165,11 @@ namespace LuaUtil
 
         void dropScriptCache() { mCompiledScripts.clear(); }
 
+        // Bytecode from the file is used instead of compiling scripts with unchanged source. The file is written by
+        // writeScriptCache if any script was compiled in this session.
+        void readScriptCache(const std::filesystem::path& path);
+        void writeScriptCache() const;
+
         const ScriptsConfiguration& getConfiguration() const { return *mConf; }
 
         // Load internal Lua library. All libraries are loaded in one sandbox and shouldn't be exposed to scripts
@@ -209,7 +218,9 @@ namespace LuaUtil
         // Needed to track resource usage per script, must be initialized before mLuaHolder.
         std::vector<ScriptId> mActiveScriptIdStack;
         uint64_t mWatchdogInstructionCounter = 0;
-        std::map<void*, AllocOwner> mBigAllocOwners;
+        std::unordered_map<void*, AllocOwner> mBigAllocOwners;
+        // Owns the memory of the small blocks of mLuaState, so it must be destructed after it
+        SmallBlockPool mSmallBlockPool;
         uint64_t mTotalMemoryUsage = 0;
         uint64_t mSmallAllocMemoryUsage = 0;
         std::vector<int64_t> mMemoryUsage;
@@ -220,7 +231,16 @@ namespace LuaUtil
         sol::state_view mSol;
         const ScriptsConfiguration* mConf;
         sol::table mSandboxEnv;
-        std::map<VFS::Path::Normalized, sol::bytecode> mCompiledScripts;
+        struct CompiledScript
+        {
+            std::array<std::uint64_t, 2> mSourceHash;
+            sol::bytecode mBytecode;
+        };
+        std::map<VFS::Path::Normalized, CompiledScript> mCompiledScripts;
+        // Read from the script cache file and not used in this session yet
+        std::map<VFS::Path::Normalized, CompiledScript> mCachedScripts;
+        std::filesystem::path mScriptCachePath;
+        bool mScriptCacheModified = false;
         std::map<std::string, sol::object> mCommonPackages;
         const VFS::Manager* mVFS;
         std::vector<std::filesystem::path> mLibSearchPaths;
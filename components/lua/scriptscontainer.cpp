@@ -4,6 +4,8 @@
 
 #include <components/esm/luascripts.hpp>
 
+#include <algorithm>
+
 namespace
 {
     struct ScriptInfo
@@ -375,6 +377,7 @@ namespace LuaUtil
                 const Handler& h = list[i];
                 try
                 {
+                    const HandlerProfile profile(*this, h.mScriptId, "events");
                     sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, object);
                     if (res.is<bool>() && !res.as<bool>())
                         break; // Skip other handlers if 'false' was returned.
@@ -715,10 +718,7 @@ namespace LuaUtil
         t.mScriptId = scriptId;
         t.mSerializable = false;
         t.mTime = time;
-
-        t.mCallback = mTemporaryCallbackCounter;
-        getScript(t.mScriptId).mTemporaryCallbacks.emplace(mTemporaryCallbackCounter, std::move(callback));
-        mTemporaryCallbackCounter++;
+        t.mCallback = std::move(callback);
         LoadedData& data = ensureLoaded();
         insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
     }
@@ -727,6 +727,7 @@ namespace LuaUtil
     {
         try
         {
+            const HandlerProfile profile(*this, t.mScriptId, "timers");
             Script& script = getScript(t.mScriptId);
             if (t.mSerializable)
             {
@@ -737,11 +738,7 @@ namespace LuaUtil
                 LuaUtil::call({ this, t.mScriptId }, it->second, t.mArg);
             }
             else
-            {
-                int64_t id = std::get<int64_t>(t.mCallback);
-                LuaUtil::call({ this, t.mScriptId }, script.mTemporaryCallbacks.at(id));
-                script.mTemporaryCallbacks.erase(id);
-            }
+                LuaUtil::call({ this, t.mScriptId }, std::get<sol::main_protected_function>(t.mCallback));
         }
         catch (std::exception& e)
         {
@@ -753,14 +750,29 @@ namespace LuaUtil
     {
         while (!timerQueue.empty() && timerQueue.front().mTime <= time)
         {
-            callTimer(timerQueue.front());
+            // Remove the timer before calling it because the callback can add new timers to the same queue
             std::pop_heap(timerQueue.begin(), timerQueue.end());
+            Timer timer = std::move(timerQueue.back());
             timerQueue.pop_back();
+            callTimer(timer);
         }
     }
 
     void ScriptsContainer::processTimers(double simulationTime, double gameTime)
     {
+        // Called every frame for every active container, skip the protected call when no timer is due
+        if (const LoadedData* data = std::get_if<LoadedData>(&mData))
+        {
+            const auto isDue = [](const std::vector<Timer>& queue, double time) {
+                return !queue.empty() && queue.front().mTime <= time;
+            };
+            if (!isDue(data->mSimulationTimersQueue, simulationTime) && !isDue(data->mGameTimersQueue, gameTime))
+            {
+                mRequiredLoading = true;
+                return;
+            }
+        }
+
         mLua.protectedCall([&](LuaView& view) {
             LoadedData& data = ensureLoaded();
             updateTimerQueue(data.mSimulationTimersQueue, simulationTime);
@@ -768,18 +780,33 @@ namespace LuaUtil
         });
     }
 
-    static constexpr float instructionCountAvgCoef = 1.0f / 30; // averaging over approximately 30 frames
+    static constexpr float statsAvgCoef = 1.0f / 30; // averaging over approximately 30 frames
 
     void ScriptsContainer::statsNextFrame()
     {
+        // Instruction counts are only collected by the profiler
+        if (!LuaState::isProfilerEnabled())
+            return;
         if (LoadedData* data = std::get_if<LoadedData>(&mData))
         {
             for (auto& [scriptId, script] : data->mScripts)
             {
+                ScriptStats& stats = script.mStats;
                 // The averaging formula is: averageValue = averageValue * (1-c) + newValue * c
-                script.mStats.mAvgInstructionCount *= 1 - instructionCountAvgCoef;
-                if (script.mStats.mAvgInstructionCount < 5)
-                    script.mStats.mAvgInstructionCount = 0; // speeding up converge to zero if newValue is zero
+                stats.mAvgInstructionCount *= 1 - statsAvgCoef;
+                if (stats.mAvgInstructionCount < 5)
+                    stats.mAvgInstructionCount = 0; // speeding up converge to zero if newValue is zero
+
+                float frameTime = 0;
+                for (auto& [name, handler] : stats.mHandlers)
+                {
+                    handler.mAvgTime = handler.mAvgTime * (1 - statsAvgCoef) + handler.mFrameTime * statsAvgCoef;
+                    handler.mMaxTime = std::max(handler.mMaxTime, handler.mFrameTime);
+                    frameTime += handler.mFrameTime;
+                    handler.mFrameTime = 0;
+                }
+                stats.mAvgTime = stats.mAvgTime * (1 - statsAvgCoef) + frameTime * statsAvgCoef;
+                stats.mMaxFrameTime = std::max(stats.mMaxFrameTime, frameTime);
             }
         }
     }
@@ -790,10 +817,38 @@ namespace LuaUtil
         {
             auto it = data->mScripts.find(scriptId);
             if (it != data->mScripts.end())
-                it->second.mStats.mAvgInstructionCount += instructionCount * instructionCountAvgCoef;
+                it->second.mStats.mAvgInstructionCount += instructionCount * statsAvgCoef;
+        }
+    }
+
+    void ScriptsContainer::addHandlerTime(int scriptId, std::string_view handler, float time)
+    {
+        if (LoadedData* data = std::get_if<LoadedData>(&mData))
+        {
+            auto it = data->mScripts.find(scriptId);
+            if (it != data->mScripts.end())
+                it->second.mStats.mHandlers[handler].mFrameTime += time;
         }
     }
 
+    ScriptsContainer::HandlerProfile::HandlerProfile(
+        ScriptsContainer& container, int scriptId, std::string_view handler)
+        : mContainer(container)
+        , mScriptId(scriptId)
+        , mHandler(handler)
+    {
+        if (LuaState::isProfilerEnabled())
+            mStart = std::chrono::steady_clock::now();
+    }
+
+    ScriptsContainer::HandlerProfile::~HandlerProfile()
+    {
+        if (!mStart.has_value())
+            return;
+        const std::chrono::duration<float, std::micro> time = std::chrono::steady_clock::now() - *mStart;
+        mContainer.addHandlerTime(mScriptId, mHandler, time.count());
+    }
+
     void ScriptsContainer::addMemoryUsage(int scriptId, int64_t memoryDelta)
     {
         int64_t* usage = std::visit(
@@ -830,8 +885,17 @@ namespace LuaUtil
         {
             for (auto& [id, script] : data->mScripts)
             {
-                stats[id].mAvgInstructionCount += script.mStats.mAvgInstructionCount;
-                stats[id].mMemoryUsage += script.mStats.mMemoryUsage;
+                ScriptStats& total = stats[id];
+                total.mAvgInstructionCount += script.mStats.mAvgInstructionCount;
+                total.mMemoryUsage += script.mStats.mMemoryUsage;
+                total.mAvgTime += script.mStats.mAvgTime;
+                total.mMaxFrameTime = std::max(total.mMaxFrameTime, script.mStats.mMaxFrameTime);
+                for (const auto& [name, handler] : script.mStats.mHandlers)
+                {
+                    HandlerStats& handlerTotal = total.mHandlers[name];
+                    handlerTotal.mAvgTime += handler.mAvgTime;
+                    handlerTotal.mMaxTime = std::max(handlerTotal.mMaxTime, handler.mMaxTime);
+                }
             }
         }
         for (auto& [id, mem] : mRemovedScriptsMemoryUsage)
@@ -1,9 +1,12 @@
 #ifndef COMPONENTS_LUA_SCRIPTSCONTAINER_H
 #define COMPONENTS_LUA_SCRIPTSCONTAINER_H
 
+#include <chrono>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include <components/debug/debuglog.hpp>
@@ -154,10 +157,21 @@ namespace LuaUtil
         // Informs that new frame is started. Needed to track Lua instruction count per frame.
         void statsNextFrame();
 
+        struct HandlerStats
+        {
+            float mAvgTime = 0; // averaged time per frame, microseconds
+            float mMaxTime = 0; // the longest time in a frame, microseconds
+            float mFrameTime = 0; // time in the current frame, microseconds
+        };
+
         struct ScriptStats
         {
             float mAvgInstructionCount = 0; // averaged number of Lua instructions per frame
             int64_t mMemoryUsage = 0; // bytes
+            float mAvgTime = 0; // averaged time spent in handlers per frame, microseconds
+            float mMaxFrameTime = 0; // the longest time spent in handlers in a frame, microseconds
+            // By engine handler name, all event handlers are counted as "events" and all timers as "timers"
+            std::map<std::string_view, HandlerStats> mHandlers;
         };
         void collectStats(std::vector<ScriptStats>& stats) const;
         static int64_t getInstanceCount() { return sInstanceCount; }
@@ -215,6 +229,7 @@ namespace LuaUtil
             {
                 try
                 {
+                    const HandlerProfile profile(*this, handler.mScriptId, handlers.mName);
                     LuaUtil::call({ this, handler.mScriptId }, handler.mFn, args...);
                 }
                 catch (std::exception& e)
@@ -241,7 +256,6 @@ namespace LuaUtil
             std::string mInterfaceName;
             sol::main_table mHiddenData;
             std::map<std::string, sol::main_protected_function> mRegisteredCallbacks;
-            std::map<int64_t, sol::main_protected_function> mTemporaryCallbacks;
             VFS::Path::Normalized mPath;
             ScriptStats mStats;
 
@@ -252,7 +266,8 @@ namespace LuaUtil
             double mTime;
             bool mSerializable;
             int mScriptId;
-            std::variant<std::string, int64_t> mCallback; // string if serializable, integer otherwise
+            // Name of a registered callback if serializable, the callback itself otherwise
+            std::variant<std::string, sol::main_protected_function> mCallback;
             sol::main_object mArg;
             std::string mSerializedArg;
 
@@ -263,6 +278,22 @@ namespace LuaUtil
         friend class LuaState;
         void addInstructionCount(int scriptId, int64_t instructionCount);
         void addMemoryUsage(int scriptId, int64_t memoryDelta);
+        void addHandlerTime(int scriptId, std::string_view handler, float time);
+
+        // Adds the time until the end of the scope to the script stats if the profiler is enabled.
+        // `handler` must outlive the container.
+        class HandlerProfile
+        {
+        public:
+            HandlerProfile(ScriptsContainer& container, int scriptId, std::string_view handler);
+            ~HandlerProfile();
+
+        private:
+            ScriptsContainer& mContainer;
+            int mScriptId;
+            std::string_view mHandler;
+            std::optional<std::chrono::steady_clock::time_point> mStart;
+        };
 
         // Add to container without calling onInit/onLoad.
         bool addScript(
@@ -315,7 +346,6 @@ namespace LuaUtil
         EngineHandlerList mUpdateHandlers{ "onUpdate" };
         std::map<std::string_view, EngineHandlerList*> mEngineHandlers;
         std::variant<UnloadedData, LoadedData> mData;
-        int64_t mTemporaryCallbackCounter = 0;
 
         std::map<int, int64_t> mRemovedScriptsMemoryUsage;
         using WeakPtr = std::shared_ptr<ScriptsContainer*>;
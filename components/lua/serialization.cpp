@@ -1,5 +1,10 @@
 #include "serialization.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <osg/Matrixf>
 #include <osg/Quat>
 #include <osg/Vec2f>
@@ -32,12 +37,20 @@ namespace LuaUtil
         VEC4 = 0x14,
         COLOR = 0x15,
 
+        // Arrays with keys 1..N. Written instead of TABLE_START for big enough arrays, the same way in any version.
+        NUMBER_ARRAY = 0x18, // 32bit N + N doubles
+        INTEGER_ARRAY = 0x19, // 32bit N + N 32bit integers
+        RECORD_ARRAY = 0x1a, // 32bit N + 32bit K + K string keys + N * K values, all elements are tables with same keys
+
         // All values should be lesser than 0x20 (SHORT_STRING_FLAG).
     };
     constexpr unsigned char SHORT_STRING_FLAG = 0x20; // 0b001SSSSS. SSSSS = string length
     constexpr unsigned char CUSTOM_FULL_FLAG = 0x40; // 0b01TTTTTT + 32bit dataSize
     constexpr unsigned char CUSTOM_COMPACT_FLAG = 0x80; // 0b1SSSSTTT. SSSS = dataSize, TTT = (typeName size - 1)
 
+    // Smaller arrays are serialized as tables, packing them wouldn't save much.
+    constexpr size_t minPackedArraySize = 4;
+
     static void appendType(BinaryData& out, SerializedType type)
     {
         out.push_back(static_cast<char>(type));
@@ -195,6 +208,106 @@ namespace LuaUtil
             throw std::runtime_error("Value is not serializable.");
     }
 
+    static void serialize(
+        BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter);
+
+    static bool isInteger(double v)
+    {
+        return v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max()
+            && v == std::trunc(v) && !(v == 0 && std::signbit(v));
+    }
+
+    // Returns false if the table is not an array that can be packed, nothing is written in this case.
+    static bool serializeArray(
+        BinaryData& out, const sol::table& table, const UserdataSerializer* customSerializer, int recursionCounter)
+    {
+        size_t size = 0;
+        size_t maxKey = 0;
+        bool numbers = true;
+        bool integers = true;
+        bool tables = true;
+        for (const auto& [key, value] : table)
+        {
+            if (key.get_type() != sol::type::number)
+                return false;
+            const double index = key.as<double>();
+            if (index < 1 || index > std::numeric_limits<uint32_t>::max() || index != std::trunc(index))
+                return false;
+            maxKey = std::max(maxKey, static_cast<size_t>(index));
+            ++size;
+            if (value.get_type() == sol::type::number)
+            {
+                integers = integers && isInteger(value.as<double>());
+                tables = false;
+            }
+            else if (value.get_type() == sol::type::table)
+                numbers = false;
+            else
+                return false;
+            if (!numbers && !tables)
+                return false;
+        }
+        // Keys of a Lua table are unique, so these are exactly 1..size
+        if (size < minPackedArraySize || maxKey != size)
+            return false;
+
+        if (numbers)
+        {
+            appendType(out, integers ? SerializedType::INTEGER_ARRAY : SerializedType::NUMBER_ARRAY);
+            appendValue<uint32_t>(out, size);
+            for (size_t i = 1; i <= size; ++i)
+            {
+                const double v = table.get<double>(i);
+                if (integers)
+                    appendValue<int32_t>(out, static_cast<int32_t>(v));
+                else
+                    appendValue<double>(out, v);
+            }
+            return true;
+        }
+
+        // Keys shared by all elements are written once
+        std::vector<sol::object> keys;
+        for (const auto& [key, value] : table.get<sol::table>(1))
+        {
+            if (key.get_type() != sol::type::string)
+                return false;
+            keys.push_back(key);
+        }
+        if (keys.empty())
+            return false;
+        for (size_t i = 2; i <= size; ++i)
+        {
+            const sol::table element = table.get<sol::table>(i);
+            size_t elementSize = 0;
+            for (const auto& entry : element)
+            {
+                static_cast<void>(entry);
+                if (++elementSize > keys.size())
+                    return false;
+            }
+            if (elementSize != keys.size())
+                return false;
+            for (const sol::object& key : keys)
+                if (element.get<sol::object>(key) == sol::nil)
+                    return false;
+        }
+        if (recursionCounter + 1 >= 32)
+            throw std::runtime_error("Can not serialize more than 32 nested tables. Likely the table contains itself.");
+        appendType(out, SerializedType::RECORD_ARRAY);
+        appendValue<uint32_t>(out, size);
+        appendValue<uint32_t>(out, keys.size());
+        for (const sol::object& key : keys)
+            appendString(out, key.as<std::string_view>());
+        for (size_t i = 1; i <= size; ++i)
+        {
+            const sol::table element = table.get<sol::table>(i);
+            for (const sol::object& key : keys)
+                serialize(out, element.get<sol::object>(key), customSerializer, recursionCounter + 2);
+        }
+        return true;
+    }
+
     static void serialize(
         BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
     {
@@ -210,6 +323,8 @@ namespace LuaUtil
                 throw std::runtime_error(
                     "Can not serialize more than 32 nested tables. Likely the table contains itself.");
             sol::table table = obj;
+            if (serializeArray(out, table, customSerializer, recursionCounter))
+                return;
             appendType(out, SerializedType::TABLE_START);
             for (auto& [key, value] : table)
             {
@@ -302,6 +417,59 @@ namespace LuaUtil
             }
             case SerializedType::TABLE_END:
                 throw std::runtime_error("Unexpected end of table during deserialization.");
+            case SerializedType::NUMBER_ARRAY:
+            case SerializedType::INTEGER_ARRAY:
+            {
+                const bool integers = static_cast<SerializedType>(type) == SerializedType::INTEGER_ARRAY;
+                const uint32_t size = getValue<uint32_t>(binaryData);
+                if (binaryData.size() / (integers ? sizeof(int32_t) : sizeof(double)) < size)
+                    throw std::runtime_error("Unexpected end of serialized data.");
+                lua_createtable(lua, static_cast<int>(size), 0);
+                for (uint32_t i = 1; i <= size; ++i)
+                {
+                    if (integers)
+                        lua_pushnumber(lua, getValue<int32_t>(binaryData));
+                    else
+                        lua_pushnumber(lua, getValue<double>(binaryData));
+                    lua_rawseti(lua, -2, static_cast<int>(i));
+                }
+                if (readOnly)
+                    sol::stack::push(lua, makeReadOnly(sol::stack::pop<sol::table>(lua)));
+                return;
+            }
+            case SerializedType::RECORD_ARRAY:
+            {
+                const uint32_t size = getValue<uint32_t>(binaryData);
+                const uint32_t keyCount = getValue<uint32_t>(binaryData);
+                // Every key and value takes at least one byte
+                if (keyCount == 0 || binaryData.size() / keyCount < static_cast<size_t>(size) + 1)
+                    throw std::runtime_error("Unexpected end of serialized data.");
+                std::vector<std::string> keys(keyCount);
+                for (std::string& key : keys)
+                {
+                    deserializeImpl(lua, binaryData, customSerializer, false);
+                    if (lua_type(lua, -1) != LUA_TSTRING)
+                        throw std::runtime_error("Incorrect key in serialized record array.");
+                    key = sol::stack::pop<std::string>(lua);
+                }
+                lua_createtable(lua, static_cast<int>(size), 0);
+                for (uint32_t i = 1; i <= size; ++i)
+                {
+                    lua_createtable(lua, 0, static_cast<int>(keyCount));
+                    for (const std::string& key : keys)
+                    {
+                        lua_pushlstring(lua, key.data(), key.size());
+                        deserializeImpl(lua, binaryData, customSerializer, readOnly);
+                        lua_settable(lua, -3);
+                    }
+                    if (readOnly)
+                        sol::stack::push(lua, makeReadOnly(sol::stack::pop<sol::table>(lua)));
+                    lua_rawseti(lua, -2, static_cast<int>(i));
+                }
+                if (readOnly)
+                    sol::stack::push(lua, makeReadOnly(sol::stack::pop<sol::table>(lua)));
+                return;
+            }
             case SerializedType::VEC2:
             {
                 float x = getValue<double>(binaryData);
@@ -366,6 +534,46 @@ namespace LuaUtil
         return res;
     }
 
+    TableSerializer::TableSerializer()
+    {
+        appendType(mData, SerializedType::TABLE_START);
+    }
+
+    void TableSerializer::add(std::string_view key, std::string_view serializedValue)
+    {
+        if (serializedValue.empty())
+            return;
+        if (static_cast<unsigned char>(serializedValue[0]) != FORMAT_VERSION)
+            throw std::runtime_error("Incorrect version of Lua serialization format: "
+                + std::to_string(static_cast<unsigned char>(serializedValue[0])));
+        appendString(mData, key);
+        mData.append(serializedValue.substr(1));
+    }
+
+    void TableSerializer::add(std::string_view key, const TableSerializer& table)
+    {
+        appendString(mData, key);
+        mData.append(table.mData);
+        appendType(mData, SerializedType::TABLE_END);
+    }
+
+    BinaryData TableSerializer::finish() const
+    {
+        BinaryData res;
+        res.reserve(mData.size() + 2);
+        res.push_back(FORMAT_VERSION);
+        res.append(mData);
+        appendType(res, SerializedType::TABLE_END);
+        return res;
+    }
+
+    SharedBinaryData serializeShared(const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
+        if (obj == sol::nil)
+            return nullptr;
+        return std::make_shared<const BinaryData>(serialize(obj, customSerializer));
+    }
+
     sol::object deserialize(
         lua_State* lua, std::string_view binaryData, const UserdataSerializer* customSerializer, bool readOnly)
     {
@@ -1,6 +1,9 @@
 #ifndef COMPONENTS_LUA_SERIALIZATION_H
 #define COMPONENTS_LUA_SERIALIZATION_H
 
+#include <memory>
+#include <string_view>
+
 #include <sol/sol.hpp>
 
 #include <components/esm3/cellref.hpp>
@@ -51,6 +54,35 @@ namespace LuaUtil
     };
 
     BinaryData serialize(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+
+    // Builds the same data as `serialize` of a table with string keys, but from already serialized values and
+    // without a Lua state.
+    class TableSerializer
+    {
+    public:
+        TableSerializer();
+
+        // The value should be returned by `serialize`. Nil values are skipped the same way as in Lua tables.
+        void add(std::string_view key, std::string_view serializedValue);
+        void add(std::string_view key, const TableSerializer& table);
+
+        BinaryData finish() const;
+
+    private:
+        // Without the format version and the end of the table
+        BinaryData mData;
+    };
+
+    // Never modified after creation, so every receiver of an event can use the same data without copying.
+    // nullptr is equivalent to nil.
+    using SharedBinaryData = std::shared_ptr<const BinaryData>;
+
+    SharedBinaryData serializeShared(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+
+    inline std::string_view toStringView(const SharedBinaryData& data)
+    {
+        return data == nullptr ? std::string_view() : std::string_view(*data);
+    }
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
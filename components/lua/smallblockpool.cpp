@@ -0,0 +1,42 @@
+#include "smallblockpool.hpp"
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace LuaUtil
+{
+    void* SmallBlockPool::allocate(std::size_t size)
+    {
+        assert(isPooled(size));
+        const std::size_t sizeClass = getClass(size);
+        if (FreeBlock* block = mFreeBlocks[sizeClass])
+        {
+            mFreeBlocks[sizeClass] = block->mNext;
+            return block;
+        }
+
+        const std::size_t blockSize = (sizeClass + 1) * sGranularity;
+        if (static_cast<std::size_t>(mSlabEnd - mSlabBegin) < blockSize)
+        {
+            // The tail of the current slab is too small for this class and is lost. Lua expects a null pointer and
+            // not an exception when out of memory.
+            std::unique_ptr<std::byte[]> slab(new (std::nothrow) std::byte[sSlabSize]);
+            if (slab == nullptr)
+                return nullptr;
+            mSlabBegin = slab.get();
+            mSlabs.push_back(std::move(slab));
+            mSlabEnd = mSlabBegin + sSlabSize;
+        }
+        void* const result = mSlabBegin;
+        mSlabBegin += blockSize;
+        return result;
+    }
+
+    void SmallBlockPool::deallocate(void* ptr, std::size_t size)
+    {
+        assert(isPooled(size));
+        const std::size_t sizeClass = getClass(size);
+        mFreeBlocks[sizeClass] = new (ptr) FreeBlock{ mFreeBlocks[sizeClass] };
+    }
+}
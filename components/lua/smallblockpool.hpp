@@ -0,0 +1,55 @@
+#ifndef COMPONENTS_LUA_SMALLBLOCKPOOL_H
+#define COMPONENTS_LUA_SMALLBLOCKPOOL_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace LuaUtil
+{
+    /// @brief Allocates the small blocks of a Lua state, most of its tables, strings and closures, from slabs split in
+    /// size classes. Freed blocks are kept in a list per size class for the next allocation of that class.
+    /// @note Not thread safe, that is fine for a Lua state which is never used by two threads at once. Slabs are only
+    /// freed with the pool, so a state keeps the memory of its biggest number of small blocks.
+    class SmallBlockPool
+    {
+    public:
+        static constexpr std::size_t sGranularity = 16;
+        static constexpr std::size_t sMaxBlockSize = 256;
+        static constexpr std::size_t sSlabSize = 64 * 1024;
+
+        static constexpr bool isPooled(std::size_t size) { return size != 0 && size <= sMaxBlockSize; }
+
+        /// @return Whether blocks of both sizes are of the same class, so one can be reused for the other.
+        static constexpr bool isSameClass(std::size_t left, std::size_t right)
+        {
+            return getClass(left) == getClass(right);
+        }
+
+        /// @param size must be pooled
+        /// @return nullptr when out of memory
+        void* allocate(std::size_t size);
+
+        /// @param size the size the block was allocated with or any other of the same class
+        void deallocate(void* ptr, std::size_t size);
+
+        /// @return How much memory the slabs take.
+        std::size_t getReservedSize() const { return mSlabs.size() * sSlabSize; }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* mNext;
+        };
+
+        static constexpr std::size_t getClass(std::size_t size) { return (size - 1) / sGranularity; }
+
+        std::array<FreeBlock*, sMaxBlockSize / sGranularity> mFreeBlocks{};
+        std::vector<std::unique_ptr<std::byte[]>> mSlabs;
+        std::byte* mSlabBegin = nullptr;
+        std::byte* mSlabEnd = nullptr;
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <system_error>
 
 #include <components/debug/debuglog.hpp>
 
@@ -97,6 +98,7 @@ namespace LuaUtil
         }
         if (mStorage->mListener)
             mStorage->mListener->valueChanged(mSectionName, key, value);
+        mStorage->mChanged = true;
         runCallbacks(key);
     }
 
@@ -112,9 +114,33 @@ namespace LuaUtil
         }
         if (mStorage->mListener)
             mStorage->mListener->sectionReplaced(mSectionName, values);
+        mStorage->mChanged = true;
         runCallbacks(sol::nullopt);
     }
 
+    void LuaStorage::Section::setValues(const sol::table& values)
+    {
+        checkIfActive();
+        throwIfCallbackRecursionIsTooDeep();
+        for (const auto& [k, v] : values)
+        {
+            const std::string_view key = cast<std::string_view>(k);
+            mValues[std::string(key)] = Value(v);
+            if (mStorage->mListener)
+                mStorage->mListener->valueChanged(mSectionName, key, v);
+        }
+        mStorage->mChanged = true;
+        runCallbacks(sol::nullopt);
+    }
+
+    void LuaStorage::Section::setLifeTime(LifeTime lifeTime)
+    {
+        if (mLifeTime == lifeTime)
+            return;
+        mLifeTime = lifeTime;
+        mStorage->mChanged = true;
+    }
+
     sol::table LuaStorage::Section::asTable(lua_State* state)
     {
         checkIfActive();
@@ -154,18 +180,23 @@ namespace LuaUtil
         sview["removeOnExit"] = [](const SectionView& section) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = Section::Temporary;
+            section.mSection->setLifeTime(Section::Temporary);
         };
         sview["setLifeTime"] = [](const SectionView& section, Section::LifeTime lifeTime) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = lifeTime;
+            section.mSection->setLifeTime(lifeTime);
         };
         sview["set"] = [](const SectionView& section, std::string_view key, const sol::object& value) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
             section.mSection->set(key, value);
         };
+        sview["setValues"] = [](const SectionView& section, const sol::table& values) {
+            if (section.mReadOnly)
+                throw std::runtime_error("Access to storage is read only");
+            section.mSection->setValues(values);
+        };
     }
 
     sol::table LuaStorage::initGlobalPackage(LuaUtil::LuaView& view, LuaStorage* globalStorage)
@@ -244,6 +275,7 @@ namespace LuaUtil
     void LuaStorage::load(lua_State* state, const std::filesystem::path& path)
     {
         assert(mData.empty()); // Shouldn't be used before loading
+        waitForSave();
         try
         {
             std::uintmax_t fileSize = std::filesystem::file_size(path);
@@ -260,6 +292,8 @@ namespace LuaUtil
                 for (const auto& [key, value] : cast<sol::table>(sectionTable))
                     section->set(cast<std::string_view>(key), value);
             }
+            mChanged = false;
+            mSavedPath = path;
         }
         catch (std::exception& e)
         {
@@ -267,19 +301,58 @@ namespace LuaUtil
         }
     }
 
-    void LuaStorage::save(lua_State* state, const std::filesystem::path& path) const
+    void LuaStorage::save(const std::filesystem::path& path)
     {
-        sol::table data(state, sol::create);
+        if (!mChanged && path == mSavedPath)
+            return;
+
+        // Values are kept serialized, so the file content is built without a Lua state and is cheap to copy
+        TableSerializer data;
         for (const auto& [sectionName, section] : mData)
         {
-            if (section->mLifeTime == Section::Persistent && !section->mValues.empty())
-                data[sectionName] = section->asTable(state);
+            if (section->mLifeTime != Section::Persistent || section->mValues.empty())
+                continue;
+            TableSerializer values;
+            for (const auto& [key, value] : section->mValues)
+                values.add(key, value.getSerialized());
+            data.add(sectionName, values);
         }
-        std::string serializedData = serialize(data);
-        Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
-        std::ofstream fout(path, std::fstream::binary);
-        fout.write(serializedData.data(), serializedData.size());
-        fout.close();
+
+        waitForSave();
+        mChanged = false;
+        mSavedPath = path;
+        mSaving = std::async(std::launch::async, [path, serializedData = data.finish()] {
+            Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
+            // Write to a temporary file first to never leave a partially written storage
+            std::filesystem::path temporary = path;
+            temporary += ".tmp";
+            try
+            {
+                {
+                    std::ofstream fout(temporary, std::fstream::binary | std::fstream::trunc);
+                    fout.write(serializedData.data(), serializedData.size());
+                    fout.close();
+                    if (!fout)
+                        throw std::runtime_error("failed to write file");
+                }
+                std::filesystem::rename(temporary, path);
+                return true;
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Cannot write \"" << path << "\": " << e.what();
+                std::error_code ec;
+                std::filesystem::remove(temporary, ec);
+                return false;
+            }
+        });
+    }
+
+    void LuaStorage::waitForSave()
+    {
+        // The next save shouldn't be skipped if the file wasn't written
+        if (mSaving.valid() && !mSaving.get())
+            mSavedPath.clear();
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
@@ -1,7 +1,10 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <filesystem>
+#include <future>
 #include <map>
+#include <set>
 #include <sol/sol.hpp>
 #include <stdexcept>
 
@@ -24,9 +27,17 @@ namespace LuaUtil
 
         explicit LuaStorage() {}
 
+        ~LuaStorage() { waitForSave(); }
+
         void clearTemporaryAndRemoveCallbacks();
         void load(lua_State* state, const std::filesystem::path& path);
-        void save(lua_State* state, const std::filesystem::path& path) const;
+
+        // The file is written in a background thread. Nothing is written if the storage wasn't changed since it was
+        // loaded from or saved to the same path.
+        void save(const std::filesystem::path& path);
+
+        // Blocks until the file of the last `save` is written.
+        void waitForSave();
 
         sol::object getSection(
             lua_State* state, std::string_view sectionName, bool readOnly, bool forMenuScripts = false);
@@ -72,6 +83,7 @@ namespace LuaUtil
             }
             sol::object getCopy(lua_State* state) const;
             sol::object getReadOnly(lua_State* state) const;
+            const std::string& getSerialized() const { return mSerializedValue; }
 
         private:
             std::string mSerializedValue;
@@ -95,6 +107,8 @@ namespace LuaUtil
             const Value& get(std::string_view key) const;
             void set(std::string_view key, const sol::object& value);
             void setAll(const sol::optional<sol::table>& values);
+            void setValues(const sol::table& values);
+            void setLifeTime(LifeTime lifeTime);
             sol::table asTable(lua_State* state);
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
@@ -123,6 +137,10 @@ namespace LuaUtil
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
         bool mActive = false;
+        // Whether there are changes not written to mSavedPath
+        bool mChanged = false;
+        std::filesystem::path mSavedPath;
+        std::future<bool> mSaving;
         void checkIfActive() const
         {
             if (!mActive)
@@ -1,5 +1,10 @@
 #include "element.hpp"
 
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+
 #include <MyGUI_Gui.h>
 
 #include "content.hpp"
@@ -99,6 +104,11 @@ namespace LuaUi
         WidgetExtension* createWidget(const sol::table& layout, bool isRoot, uint64_t depth);
         void updateWidget(WidgetExtension* ext, const sol::table& layout, uint64_t depth);
 
+        bool canReuse(WidgetExtension* ext, std::string_view type)
+        {
+            return !ext->isRoot() && ext->widget()->getTypeName() == type;
+        }
+
         std::vector<WidgetExtension*> updateContent(
             const std::vector<WidgetExtension*>& children, const sol::object& contentObj, uint64_t depth)
         {
@@ -112,47 +122,69 @@ namespace LuaUi
             }
             ContentView content(LuaUtil::cast<sol::table>(contentObj));
             result.resize(content.size());
-            size_t minSize = std::min(children.size(), content.size());
-            std::vector<WidgetExtension*> toDestroy;
-            for (size_t i = 0; i < minSize; i++)
+
+            // Any widget of the right type can be updated to a layout, names only help to pick the same one as before,
+            // so inserting or removing named content doesn't update every widget after it to a different layout
+            std::vector<std::string> names(content.size());
+            std::set<std::string_view> newNames;
+            for (size_t i = 0; i < content.size(); i++)
             {
-                WidgetExtension* ext = children[i];
                 sol::object child = content.at(i);
                 if (child.is<Element>())
-                {
-                    WidgetExtension* root = pluckElementRoot(child, depth);
-                    if (ext != root)
-                        toDestroy.emplace_back(ext);
-                    result[i] = root;
-                }
-                else
-                {
-                    sol::table newLayout = child.as<sol::table>();
-                    if (ext->widget()->getTypeName() == widgetType(newLayout))
-                    {
-                        updateWidget(ext, newLayout, depth);
-                    }
-                    else
-                    {
-                        toDestroy.emplace_back(ext);
-                        ext = createWidget(newLayout, false, depth);
-                    }
-                    result[i] = ext;
-                }
+                    continue;
+                names[i] = child.as<sol::table>().get_or(LayoutKeys::name, std::string());
+                if (!names[i].empty())
+                    newNames.insert(names[i]);
             }
-            for (size_t i = minSize; i < content.size(); i++)
+            std::vector<bool> reused(children.size(), false);
+            std::multimap<std::string_view, size_t> namedChildren;
+            for (size_t i = 0; i < children.size(); i++)
+            {
+                const std::string& name = children[i]->widget()->getName();
+                if (newNames.contains(name))
+                    namedChildren.emplace(name, i);
+            }
+
+            for (size_t i = 0; i < content.size(); i++)
             {
                 sol::object child = content.at(i);
                 if (child.is<Element>())
+                {
                     result[i] = pluckElementRoot(child, depth);
+                    continue;
+                }
+                sol::table newLayout = child.as<sol::table>();
+                const std::string type = widgetType(newLayout);
+                std::optional<size_t> found;
+                const auto [begin, end] = namedChildren.equal_range(names[i]);
+                for (auto it = begin; it != end && !found; ++it)
+                    if (!reused[it->second] && canReuse(children[it->second], type))
+                        found = it->second;
+                // A widget named like other content is left for it
+                if (!found && i < children.size() && !reused[i] && canReuse(children[i], type)
+                    && !newNames.contains(children[i]->widget()->getName()))
+                    found = i;
+                WidgetExtension* ext;
+                if (found)
+                {
+                    reused[*found] = true;
+                    ext = children[*found];
+                    updateWidget(ext, newLayout, depth);
+                }
                 else
-                    result[i] = createWidget(child.as<sol::table>(), false, depth);
+                    ext = createWidget(newLayout, false, depth);
+                result[i] = ext;
             }
-            // Don't destroy anything until element creation has had a chance to throw
-            for (size_t i = minSize; i < children.size(); i++)
+            // Don't destroy anything until element creation has had a chance to throw. Only element roots may be
+            // kept without being reused.
+            for (size_t i = 0; i < children.size(); i++)
+            {
+                if (reused[i])
+                    continue;
+                if (children[i]->isRoot() && std::find(result.begin(), result.end(), children[i]) != result.end())
+                    continue;
                 destroyChild(children[i]);
-            for (WidgetExtension* ext : toDestroy)
-                destroyChild(ext);
+            }
             return result;
         }
 
@@ -215,7 +247,10 @@ namespace LuaUi
             ext->setProperties(layout.get<sol::object>(LayoutKeys::props));
             setEventCallbacks(ext, layout.get<sol::object>(LayoutKeys::events));
             ext->setChildren(updateContent(ext->children(), layout.get<sol::object>(LayoutKeys::content), depth));
-            ext->updateCoord();
+            // The coordinates of the whole tree are updated from the element root, updating them for every widget
+            // of the tree as well would be quadratic in its depth
+            if (ext->isRoot())
+                ext->updateCoord();
         }
 
         std::string setLayer(WidgetExtension* ext, const sol::table& layout)
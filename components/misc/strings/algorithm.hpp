@@ -4,6 +4,7 @@
 #include "lower.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -23,24 +24,41 @@ namespace Misc::StringUtils
         return newName;
     }
 
+    /// @return Index of the first byte of x and y different in lower case, size if there is none.
+    inline std::size_t ciMismatch(const char* x, const char* y, std::size_t size)
+    {
+        std::size_t i = 0;
+        for (; i + Simd::blockSize <= size; i += Simd::blockSize)
+        {
+            const std::size_t offset
+                = Simd::mismatch(Simd::toLower(Simd::load(x + i)), Simd::toLower(Simd::load(y + i)));
+            if (offset != Simd::blockSize)
+                return i + offset;
+        }
+        for (; i < size; ++i)
+            if (toLower(x[i]) != toLower(y[i]))
+                return i;
+        return size;
+    }
+
     inline bool ciLess(std::string_view x, std::string_view y)
     {
-        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), CiCharLess());
+        const std::size_t size = std::min(x.size(), y.size());
+        const std::size_t i = ciMismatch(x.data(), y.data(), size);
+        if (i == size)
+            return x.size() < y.size();
+        return CiCharLess()(x[i], y[i]);
     }
 
     inline bool ciEqual(std::string_view x, std::string_view y)
     {
-        if (std::size(x) != std::size(y))
-            return false;
-        return std::equal(
-            std::begin(x), std::end(x), std::begin(y), [](char l, char r) { return toLower(l) == toLower(r); });
+        return x.size() == y.size() && ciMismatch(x.data(), y.data(), x.size()) == x.size();
     }
     inline bool ciEqual(std::u8string_view x, std::u8string_view y)
     {
-        if (std::size(x) != std::size(y))
-            return false;
-        return std::equal(
-            std::begin(x), std::end(x), std::begin(y), [](char l, char r) { return toLower(l) == toLower(r); });
+        return x.size() == y.size()
+            && ciMismatch(reinterpret_cast<const char*>(x.data()), reinterpret_cast<const char*>(y.data()), x.size())
+            == x.size();
     }
 
     inline bool ciStartsWith(std::string_view value, std::string_view prefix)
@@ -50,26 +68,15 @@ namespace Misc::StringUtils
 
     inline int ciCompareLen(std::string_view x, std::string_view y, std::size_t len)
     {
-        std::string_view::const_iterator xit = x.begin();
-        std::string_view::const_iterator yit = y.begin();
-        for (; xit != x.end() && yit != y.end() && len > 0; ++xit, ++yit, --len)
-        {
-            char left = *xit;
-            char right = *yit;
-            if (left == right)
-                continue;
-
-            left = toLower(left);
-            right = toLower(right);
-            int res = left - right;
-            if (res != 0)
-                return (res > 0) ? 1 : -1;
-        }
-        if (len > 0)
+        const std::size_t size = std::min({ x.size(), y.size(), len });
+        const std::size_t i = ciMismatch(x.data(), y.data(), size);
+        if (i != size)
+            return CiCharLess()(x[i], y[i]) ? -1 : 1;
+        if (len > size)
         {
-            if (xit != x.end())
+            if (x.size() > size)
                 return 1;
-            if (yit != y.end())
+            if (y.size() > size)
                 return -1;
         }
         return 0;
@@ -146,15 +153,11 @@ namespace Misc::StringUtils
 
     inline bool ciEndsWith(std::string_view s, std::string_view suffix)
     {
-        return s.size() >= suffix.size() && std::equal(suffix.rbegin(), suffix.rend(), s.rbegin(), [](char l, char r) {
-            return toLower(l) == toLower(r);
-        });
+        return s.size() >= suffix.size() && ciEqual(s.substr(s.size() - suffix.size()), suffix);
     }
     inline bool ciEndsWith(std::u8string_view s, std::u8string_view suffix)
     {
-        return s.size() >= suffix.size() && std::equal(suffix.rbegin(), suffix.rend(), s.rbegin(), [](char l, char r) {
-            return toLower(l) == toLower(r);
-        });
+        return s.size() >= suffix.size() && ciEqual(s.substr(s.size() - suffix.size()), suffix);
     }
 
     inline void trim(std::string& s)
@@ -196,8 +199,12 @@ namespace Misc::StringUtils
     {
         if (str.size() < substr.size())
             return std::string_view::npos;
+        if (substr.empty())
+            return 0;
+        // Check the first character before comparing the rest a block at a time
+        const char first = toLower(substr.front());
         for (std::string_view::size_type i = 0, n = str.size() - substr.size() + 1; i < n; ++i)
-            if (ciEqual(str.substr(i, substr.size()), substr))
+            if (toLower(str[i]) == first && ciEqual(str.substr(i, substr.size()), substr))
                 return i;
         return std::string_view::npos;
     }
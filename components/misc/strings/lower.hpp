@@ -1,6 +1,9 @@
 #ifndef COMPONENTS_MISC_STRINGS_LOWER_H
 #define COMPONENTS_MISC_STRINGS_LOWER_H
 
+#include "simd.hpp"
+
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -32,16 +35,29 @@ namespace Misc::StringUtils
         return tolowermap[static_cast<unsigned char>(c)];
     }
 
+    inline void lowerCaseInPlace(char* data, std::size_t size)
+    {
+        if (size < Simd::blockSize)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                data[i] = toLower(data[i]);
+            return;
+        }
+        for (std::size_t i = 0; i < size - Simd::blockSize; i += Simd::blockSize)
+            Simd::store(data + i, Simd::toLower(Simd::load(data + i)));
+        // The last block may overlap the previous one, lower-casing twice changes nothing
+        char* const last = data + size - Simd::blockSize;
+        Simd::store(last, Simd::toLower(Simd::load(last)));
+    }
+
     /// Transforms input string to lower case w/o copy
     inline void lowerCaseInPlace(std::string& str)
     {
-        for (auto& ch : str)
-            ch = toLower(ch);
+        lowerCaseInPlace(str.data(), str.size());
     }
     inline void lowerCaseInPlace(std::u8string& str)
     {
-        for (auto& ch : str)
-            ch = toLower(ch);
+        lowerCaseInPlace(reinterpret_cast<char*>(str.data()), str.size());
     }
 
     /// Returns lower case copy of input string
@@ -0,0 +1,157 @@
+#ifndef COMPONENTS_MISC_STRINGS_SIMD_H
+#define COMPONENTS_MISC_STRINGS_SIMD_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENMW_MISC_STRINGS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OPENMW_MISC_STRINGS_NEON
+#endif
+
+/// Primitives to lower-case, compare and scan strings a block of bytes at a time, see lower.hpp, algorithm.hpp and
+/// ToUTF8::StatelessUtf8Encoder.
+/// SSE2 and NEON are part of the baseline of x86-64 and AArch64, so no runtime dispatch is needed. Other targets use
+/// 64 bit words.
+namespace Misc::StringUtils::Simd
+{
+#if defined(OPENMW_MISC_STRINGS_SSE2)
+    using Block = __m128i;
+
+    inline constexpr std::size_t blockSize = sizeof(Block);
+
+    inline Block load(const char* data)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    inline void store(char* data, Block block)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), block);
+    }
+
+    inline Block toLower(Block block)
+    {
+        // Signed comparison puts bytes of multibyte characters below 'A'
+        const __m128i isUpper = _mm_and_si128(
+            _mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+        return _mm_or_si128(block, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+    }
+
+    /// @return Index of the first different byte, blockSize if the blocks are equal.
+    inline std::size_t mismatch(Block left, Block right)
+    {
+        const unsigned different = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(left, right))) & 0xFFFF;
+        return different == 0 ? blockSize : static_cast<std::size_t>(std::countr_zero(different));
+    }
+
+    /// @return Index of the first byte that is zero or not ASCII, blockSize if there is none.
+    inline std::size_t findZeroOrNonAscii(Block block)
+    {
+        const unsigned found
+            = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, _mm_setzero_si128()))));
+        return found == 0 ? blockSize : static_cast<std::size_t>(std::countr_zero(found));
+    }
+#elif defined(OPENMW_MISC_STRINGS_NEON)
+    using Block = uint8x16_t;
+
+    inline constexpr std::size_t blockSize = sizeof(Block);
+
+    inline Block load(const char* data)
+    {
+        return vld1q_u8(reinterpret_cast<const std::uint8_t*>(data));
+    }
+
+    inline void store(char* data, Block block)
+    {
+        vst1q_u8(reinterpret_cast<std::uint8_t*>(data), block);
+    }
+
+    inline Block toLower(Block block)
+    {
+        const uint8x16_t isUpper = vandq_u8(vcgeq_u8(block, vdupq_n_u8('A')), vcleq_u8(block, vdupq_n_u8('Z')));
+        return vorrq_u8(block, vandq_u8(isUpper, vdupq_n_u8(0x20)));
+    }
+
+    /// @return Index of the first different byte, blockSize if the blocks are equal.
+    inline std::size_t mismatch(Block left, Block right)
+    {
+        // Narrowing the comparison result leaves 4 bits per byte, there is no movemask
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(left, right)), 4);
+        const std::uint64_t different = ~vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        return different == 0 ? blockSize : static_cast<std::size_t>(std::countr_zero(different)) / 4;
+    }
+
+    /// @return Index of the first byte that is zero or not ASCII, blockSize if there is none.
+    inline std::size_t findZeroOrNonAscii(Block block)
+    {
+        const uint8x16_t matches = vorrq_u8(vceqq_u8(block, vdupq_n_u8(0)), vcgeq_u8(block, vdupq_n_u8(0x80)));
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        const std::uint64_t found = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        return found == 0 ? blockSize : static_cast<std::size_t>(std::countr_zero(found)) / 4;
+    }
+#else
+    using Block = std::uint64_t;
+
+    inline constexpr std::size_t blockSize = sizeof(Block);
+
+    inline constexpr Block repeat(unsigned char value)
+    {
+        return ~Block(0) / 0xFF * value;
+    }
+
+    inline Block load(const char* data)
+    {
+        Block block;
+        std::memcpy(&block, data, sizeof(block));
+        return block;
+    }
+
+    inline void store(char* data, Block block)
+    {
+        std::memcpy(data, &block, sizeof(block));
+    }
+
+    inline Block toLower(Block block)
+    {
+        // The high bit of each byte tells whether the low 7 bits are at least 'A' or above 'Z'
+        const Block low = block & repeat(0x7F);
+        const Block atLeastA = low + repeat(0x80 - 'A');
+        const Block aboveZ = low + repeat(0x7F - 'Z');
+        const Block isUpper = (atLeastA ^ aboveZ) & ~block & repeat(0x80);
+        return block | (isUpper >> 2);
+    }
+
+    /// @return Index of the first byte with any bit set, blockSize if there is none.
+    inline std::size_t findFirstByte(Block flags)
+    {
+        if (flags == 0)
+            return blockSize;
+        if constexpr (std::endian::native == std::endian::little)
+            return static_cast<std::size_t>(std::countr_zero(flags)) / 8;
+        else
+            return static_cast<std::size_t>(std::countl_zero(flags)) / 8;
+    }
+
+    /// @return Index of the first different byte, blockSize if the blocks are equal.
+    inline std::size_t mismatch(Block left, Block right)
+    {
+        return findFirstByte(left ^ right);
+    }
+
+    /// @return Index of the first byte that is zero or not ASCII, blockSize if there is none.
+    inline std::size_t findZeroOrNonAscii(Block block)
+    {
+        // Exact for every byte, unlike the usual trick that may flag bytes after a zero one
+        const Block nonZero = (((block & repeat(0x7F)) + repeat(0x7F)) | block) & repeat(0x80);
+        return findFirstByte((~nonZero | block) & repeat(0x80));
+    }
+#endif
+}
+
+#endif
@@ -11,10 +11,12 @@
 #include <osgGA/GUIEventHandler>
 
 #include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/shader/shadermanager.hpp>
 
 #include "myguitexture.hpp"
+#include "textureatlas.hpp"
 
 #define MYGUI_PLATFORM_LOG_SECTION "Platform"
 #define MYGUI_PLATFORM_LOG(level, text) MYGUI_LOGGING(MYGUI_PLATFORM_LOG_SECTION, level, text)
@@ -141,7 +143,7 @@ namespace MyGUIPlatform
                         reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()) + 16);
                 }
 
-                glDrawArrays(GL_TRIANGLES, 0, batch.mVertexCount);
+                glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.mFirstVertex), batch.mVertexCount);
 
                 if (batch.mStateSet)
                 {
@@ -169,6 +171,8 @@ namespace MyGUIPlatform
         {
             setSupportsDisplayList(false);
 
+            createStreams();
+
             osg::ref_ptr<CollectDrawCalls> collectDrawCalls = new CollectDrawCalls;
             collectDrawCalls->setRenderManager(mParent);
             setCullCallback(collectDrawCalls);
@@ -203,6 +207,7 @@ namespace MyGUIPlatform
             , mReadFrom(0)
             , mDummyTexture(copy.mDummyTexture)
         {
+            createStreams();
         }
 
         // Defines the necessary information for a draw call
@@ -218,15 +223,51 @@ namespace MyGUIPlatform
             // optional
             osg::ref_ptr<osg::StateSet> mStateSet;
 
+            size_t mFirstVertex = 0;
             size_t mVertexCount;
         };
 
-        void addBatch(const Batch& batch) { mBatchVector[mWriteTo].push_back(batch); }
+        /// Draws the vertices of MyGUI directly unless they need remapping to an atlas, merges them into the previous
+        /// batch of the frame when both use the same texture and state.
+        void addBatch(const Batch& batch, const TextureAtlas::Region* region)
+        {
+            std::vector<Batch>& batches = mBatchVector[mWriteTo];
+            const bool merge = !batches.empty() && batches.back().mTexture == batch.mTexture
+                && batches.back().mStateSet == batch.mStateSet;
+            if (!merge && region == nullptr)
+            {
+                batches.push_back(batch);
+                return;
+            }
+
+            Stream& stream = mStreams[mWriteTo];
+            if (merge)
+            {
+                Batch& previous = batches.back();
+                if (previous.mVertexBuffer != stream.mVertexBuffer)
+                {
+                    const size_t vertexCount = previous.mVertexCount;
+                    previous.mFirstVertex = appendVertices(stream, *previous.mArray, vertexCount, nullptr);
+                    previous.mVertexBuffer = stream.mVertexBuffer;
+                    previous.mArray = stream.mArray;
+                }
+                appendVertices(stream, *batch.mArray, batch.mVertexCount, region);
+                previous.mVertexCount += batch.mVertexCount;
+                return;
+            }
+
+            Batch streamed = batch;
+            streamed.mFirstVertex = appendVertices(stream, *batch.mArray, batch.mVertexCount, region);
+            streamed.mVertexBuffer = stream.mVertexBuffer;
+            streamed.mArray = stream.mArray;
+            batches.push_back(std::move(streamed));
+        }
 
         void clear()
         {
             mWriteTo = (mWriteTo + 1) % sNumBuffers;
             mBatchVector[mWriteTo].clear();
+            mStreams[mWriteTo].mArray->clear();
         }
 
         osg::StateSet* getDrawableStateSet() { return mStateSet; }
@@ -237,8 +278,54 @@ namespace MyGUIPlatform
         // 2 would be enough in most cases, use 4 to get stereo working
         static const int sNumBuffers = 4;
 
+        // Vertices of the merged batches of a frame
+        struct Stream
+        {
+            osg::ref_ptr<osg::UByteArray> mArray;
+            osg::ref_ptr<osg::VertexBufferObject> mVertexBuffer;
+        };
+
+        void createStreams()
+        {
+            for (Stream& stream : mStreams)
+            {
+                stream.mArray = new osg::UByteArray;
+                stream.mVertexBuffer = new osg::VertexBufferObject;
+                stream.mVertexBuffer->setDataVariance(osg::Object::DYNAMIC);
+                stream.mVertexBuffer->setUsage(GL_DYNAMIC_DRAW);
+                // NB mVertexBuffer does not own the array
+                stream.mVertexBuffer->setArray(0, stream.mArray.get());
+            }
+        }
+
+        // @return Index of the first appended vertex
+        static size_t appendVertices(
+            Stream& stream, const osg::Array& array, size_t vertexCount, const TextureAtlas::Region* region)
+        {
+            const size_t first = stream.mArray->size() / sizeof(MyGUI::Vertex);
+            if (vertexCount == 0)
+                return first;
+
+            const auto* begin = static_cast<const GLubyte*>(array.getDataPointer());
+            stream.mArray->insert(stream.mArray->end(), begin, begin + vertexCount * sizeof(MyGUI::Vertex));
+
+            if (region != nullptr)
+            {
+                auto* vertices = reinterpret_cast<MyGUI::Vertex*>(&(*stream.mArray)[first * sizeof(MyGUI::Vertex)]);
+                for (size_t i = 0; i < vertexCount; ++i)
+                {
+                    vertices[i].u = region->mOffset.x() + vertices[i].u * region->mScale.x();
+                    vertices[i].v = region->mOffset.y() + vertices[i].v * region->mScale.y();
+                }
+            }
+
+            stream.mArray->dirty();
+            return first;
+        }
+
         // double buffering approach, to avoid the need for synchronization with the draw thread
         std::vector<Batch> mBatchVector[sNumBuffers];
+        Stream mStreams[sNumBuffers];
 
         int mWriteTo;
         mutable int mReadFrom;
@@ -357,6 +444,7 @@ namespace MyGUIPlatform
         , mSceneRoot(sceneroot)
         , mImageManager(imageManager)
         , mUpdate(false)
+        , mAtlas(std::make_unique<TextureAtlas>())
         , mIsInitialise(false)
         , mInvScalingFactor(1.f)
         , mInjectState(nullptr)
@@ -397,6 +485,7 @@ namespace MyGUIPlatform
         camera->setViewMatrix(osg::Matrix::identity());
         camera->setRenderOrder(osg::Camera::POST_RENDER);
         camera->setClearMask(GL_NONE);
+        SceneUtil::addGpuTimer(*camera, new SceneUtil::GpuTimer("UI"));
         mDrawable->setCullingActive(false);
         camera->addChild(mDrawable.get());
 
@@ -449,9 +538,12 @@ namespace MyGUIPlatform
         batch.mArray = static_cast<OSGVertexBuffer*>(buffer)->getVertexArray();
         static_cast<OSGVertexBuffer*>(buffer)->markUsed();
 
+        const TextureAtlas::Region* region = nullptr;
         if (OSGTexture* osgtexture = static_cast<OSGTexture*>(texture))
         {
             batch.mTexture = osgtexture->getTexture();
+            if (osgtexture->getAtlasRegion())
+                region = &*osgtexture->getAtlasRegion();
             if (batch.mTexture->getDataVariance() == osg::Object::DYNAMIC)
                 mDrawable->setDataVariance(osg::Object::DYNAMIC); // only for this frame, reset in begin()
             if (!mInjectState && osgtexture->getInjectState())
@@ -460,7 +552,7 @@ namespace MyGUIPlatform
         if (mInjectState)
             batch.mStateSet = mInjectState;
 
-        mDrawable->addBatch(batch);
+        mDrawable->addBatch(batch, region);
     }
 
     void RenderManager::setInjectState(osg::StateSet* stateSet)
@@ -520,7 +612,7 @@ namespace MyGUIPlatform
 
     MyGUI::ITexture* RenderManager::createTexture(const std::string& name)
     {
-        const auto it = mTextures.insert_or_assign(name, OSGTexture(name, mImageManager)).first;
+        const auto it = mTextures.insert_or_assign(name, OSGTexture(name, mImageManager, mAtlas.get())).first;
         return &it->second;
     }
 
@@ -5,6 +5,8 @@
 
 #include <osg/ref_ptr>
 
+#include <memory>
+
 namespace Resource
 {
     class ImageManager;
@@ -33,6 +35,7 @@ namespace MyGUIPlatform
 
     class Drawable;
     class OSGTexture;
+    class TextureAtlas;
 
     class RenderManager : public MyGUI::RenderManager, public MyGUI::IRenderTarget
     {
@@ -47,6 +50,7 @@ namespace MyGUIPlatform
         MyGUI::RenderTargetInfo mInfo;
 
         std::map<std::string, OSGTexture> mTextures;
+        std::unique_ptr<TextureAtlas> mAtlas;
 
         bool mIsInitialise;
 
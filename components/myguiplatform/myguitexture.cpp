@@ -11,9 +11,10 @@
 namespace MyGUIPlatform
 {
 
-    OSGTexture::OSGTexture(const std::string& name, Resource::ImageManager* imageManager)
+    OSGTexture::OSGTexture(const std::string& name, Resource::ImageManager* imageManager, TextureAtlas* atlas)
         : mName(name)
         , mImageManager(imageManager)
+        , mAtlas(atlas)
         , mFormat(MyGUI::PixelFormat::Unknow)
         , mUsage(MyGUI::TextureUsage::Default)
         , mNumElemBytes(0)
@@ -24,6 +25,7 @@ namespace MyGUIPlatform
 
     OSGTexture::OSGTexture(osg::Texture2D* texture, osg::StateSet* injectState)
         : mImageManager(nullptr)
+        , mAtlas(nullptr)
         , mTexture(texture)
         , mInjectState(injectState)
         , mFormat(MyGUI::PixelFormat::Unknow)
@@ -62,6 +64,7 @@ namespace MyGUIPlatform
         if (glfmt == GL_NONE)
             throw std::runtime_error("Texture format not supported");
 
+        mAtlasRegion.reset();
         mTexture = new osg::Texture2D();
         mTexture->setTextureSize(width, height);
         mTexture->setSourceFormat(glfmt);
@@ -83,6 +86,7 @@ namespace MyGUIPlatform
     void OSGTexture::destroy()
     {
         mTexture = nullptr;
+        mAtlasRegion.reset();
         mFormat = MyGUI::PixelFormat::Unknow;
         mUsage = MyGUI::TextureUsage::Default;
         mNumElemBytes = 0;
@@ -96,6 +100,20 @@ namespace MyGUIPlatform
             throw std::runtime_error("No imagemanager set");
 
         osg::ref_ptr<osg::Image> image(mImageManager->getImage(VFS::Path::Normalized(fname)));
+
+        mWidth = image->s();
+        mHeight = image->t();
+
+        mUsage = MyGUI::TextureUsage::Static;
+
+        // Icons and other small images are drawn from an atlas, so that consecutive widgets can be drawn together
+        mAtlasRegion = mAtlas ? mAtlas->add(*image) : std::nullopt;
+        if (mAtlasRegion)
+        {
+            mTexture = nullptr;
+            return;
+        }
+
         mTexture = new osg::Texture2D(image);
         mTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
         mTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
@@ -103,11 +121,6 @@ namespace MyGUIPlatform
         mTexture->setTextureHeight(image->t());
         // disable mip-maps
         mTexture->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture2D::LINEAR);
-
-        mWidth = image->s();
-        mHeight = image->t();
-
-        mUsage = MyGUI::TextureUsage::Static;
     }
 
     void OSGTexture::saveToFile(const std::string& fname)
@@ -118,7 +131,7 @@ namespace MyGUIPlatform
     void* OSGTexture::lock(MyGUI::TextureUsage /*access*/)
     {
         if (!mTexture.valid())
-            throw std::runtime_error("Texture is not created");
+            throw std::runtime_error(mAtlasRegion ? "Texture is packed into an atlas" : "Texture is not created");
         if (mLockedImage.valid())
             throw std::runtime_error("Texture already locked");
 
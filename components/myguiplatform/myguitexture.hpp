@@ -5,6 +5,10 @@
 
 #include <osg/ref_ptr>
 
+#include <optional>
+
+#include "textureatlas.hpp"
+
 namespace osg
 {
     class Image;
@@ -24,6 +28,8 @@ namespace MyGUIPlatform
     {
         std::string mName;
         Resource::ImageManager* mImageManager;
+        TextureAtlas* mAtlas;
+        std::optional<TextureAtlas::Region> mAtlasRegion;
 
         osg::ref_ptr<osg::Image> mLockedImage;
         osg::ref_ptr<osg::Texture2D> mTexture;
@@ -36,7 +42,8 @@ namespace MyGUIPlatform
         int mHeight;
 
     public:
-        OSGTexture(const std::string& name, Resource::ImageManager* imageManager);
+        /// @param atlas Packs the small images loaded from files, optional
+        OSGTexture(const std::string& name, Resource::ImageManager* imageManager, TextureAtlas* atlas = nullptr);
         OSGTexture(osg::Texture2D* texture, osg::StateSet* injectState = nullptr);
         ~OSGTexture() override;
 
@@ -66,7 +73,13 @@ namespace MyGUIPlatform
         void setShader(const std::string& shaderName) override;
 
         /*internal:*/
-        osg::Texture2D* getTexture() const { return mTexture.get(); }
+        osg::Texture2D* getTexture() const
+        {
+            return mAtlasRegion ? TextureAtlas::getTexture(*mAtlasRegion->mPage) : mTexture.get();
+        }
+
+        /// Texture coordinates have to be mapped to the region when the image was packed into an atlas
+        const std::optional<TextureAtlas::Region>& getAtlasRegion() const { return mAtlasRegion; }
     };
 
 }
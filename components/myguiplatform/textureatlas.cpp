@@ -0,0 +1,305 @@
+#include "textureatlas.hpp"
+
+#include <osg/Image>
+#include <osg/Texture2D>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace MyGUIPlatform
+{
+    namespace
+    {
+        constexpr int pageSize = 1024;
+        constexpr int maxImageSize = 64;
+        // Every image is surrounded by copies of its edges, so that filtering never samples neighbouring images. One
+        // block of compressed formats wide, which also keeps every image aligned to the blocks.
+        constexpr int border = 4;
+        constexpr int blockSize = 4;
+
+        enum class Compression
+        {
+            None,
+            Dxt1,
+            Dxt3,
+            Dxt5,
+            Unsupported,
+        };
+
+        Compression getCompression(const osg::Image& image)
+        {
+            switch (image.getPixelFormat())
+            {
+                case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+                case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+                    return Compression::Dxt1;
+                case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+                    return Compression::Dxt3;
+                case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+                    return Compression::Dxt5;
+            }
+            if (image.isCompressed())
+                return Compression::Unsupported;
+            return Compression::None;
+        }
+
+        std::size_t getBlockBytes(Compression compression)
+        {
+            return compression == Compression::Dxt1 ? 8 : 16;
+        }
+
+        // Index of the texel of a 4x4 block that lands at x, y once the block is mirrored
+        int getMirroredTexel(int x, int y, bool horizontal, bool vertical)
+        {
+            return (vertical ? 3 - y : y) * 4 + (horizontal ? 3 - x : x);
+        }
+
+        // Reorders the per texel indices packed in the little endian bits of a block
+        void mirrorIndices(unsigned char* data, std::size_t bytes, int bitsPerTexel, bool horizontal, bool vertical)
+        {
+            std::uint64_t indices = 0;
+            for (std::size_t i = 0; i < bytes; ++i)
+                indices |= std::uint64_t(data[i]) << (8 * i);
+
+            const std::uint64_t mask = (std::uint64_t(1) << bitsPerTexel) - 1;
+            std::uint64_t mirrored = 0;
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                {
+                    const int source = getMirroredTexel(x, y, horizontal, vertical);
+                    const std::uint64_t index = (indices >> (bitsPerTexel * source)) & mask;
+                    mirrored |= index << (bitsPerTexel * (y * 4 + x));
+                }
+
+            for (std::size_t i = 0; i < bytes; ++i)
+                data[i] = static_cast<unsigned char>(mirrored >> (8 * i));
+        }
+
+        void mirrorBlock(unsigned char* block, Compression compression, bool horizontal, bool vertical)
+        {
+            if (!horizontal && !vertical)
+                return;
+
+            unsigned char* colour = block;
+            if (compression == Compression::Dxt3)
+            {
+                mirrorIndices(block, 8, 4, horizontal, vertical);
+                colour = block + 8;
+            }
+            else if (compression == Compression::Dxt5)
+            {
+                // Skip the two reference alphas
+                mirrorIndices(block + 2, 6, 3, horizontal, vertical);
+                colour = block + 8;
+            }
+
+            // Skip the two reference colours
+            mirrorIndices(colour + 4, 4, 2, horizontal, vertical);
+        }
+
+        osg::ref_ptr<osg::Texture2D> createTexture(osg::Image* image)
+        {
+            osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D(image);
+            texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            // disable mip-maps, like for the textures of single images
+            texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+            texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+            texture->setResizeNonPowerOfTwoHint(false);
+            return texture;
+        }
+    }
+
+    class TextureAtlas::Page
+    {
+    public:
+        explicit Page(const osg::Image& format)
+            : mPixelFormat(format.getPixelFormat())
+            , mDataType(format.getDataType())
+            , mInternalFormat(format.getInternalTextureFormat())
+        {
+        }
+
+        bool hasFormat(const osg::Image& image) const
+        {
+            return image.getPixelFormat() == mPixelFormat && image.getDataType() == mDataType
+                && image.getInternalTextureFormat() == mInternalFormat;
+        }
+
+        // Finds room for a cell with a shelf packer, images of a similar size tend to be loaded together
+        bool allocate(int width, int height, int& x, int& y)
+        {
+            if (mCursorX + width > pageSize)
+            {
+                mCursorX = 0;
+                mCursorY += mShelfHeight;
+                mShelfHeight = 0;
+            }
+            if (mCursorY + height > pageSize)
+                return false;
+
+            x = mCursorX;
+            y = mCursorY;
+            mCursorX += width;
+            mShelfHeight = std::max(mShelfHeight, height);
+            return true;
+        }
+
+        // The image to write new images into, a copy if the current one may already be in use by the draw thread
+        osg::Image& getWritableImage()
+        {
+            if (mPendingImage)
+                return *mPendingImage;
+
+            if (mImage)
+                mPendingImage = new osg::Image(*mImage, osg::CopyOp::DEEP_COPY_ALL);
+            else
+            {
+                mPendingImage = new osg::Image;
+                mPendingImage->allocateImage(pageSize, pageSize, 1, mPixelFormat, mDataType, 1);
+                mPendingImage->setInternalTextureFormat(mInternalFormat);
+                std::memset(mPendingImage->data(), 0, mPendingImage->getTotalSizeInBytes());
+            }
+            return *mPendingImage;
+        }
+
+        osg::Texture2D* getTexture()
+        {
+            if (mPendingImage)
+            {
+                mImage = std::move(mPendingImage);
+                mTexture = createTexture(mImage);
+            }
+            return mTexture;
+        }
+
+    private:
+        const GLenum mPixelFormat;
+        const GLenum mDataType;
+        const GLint mInternalFormat;
+        osg::ref_ptr<osg::Image> mImage;
+        osg::ref_ptr<osg::Image> mPendingImage;
+        osg::ref_ptr<osg::Texture2D> mTexture;
+        int mCursorX = 0;
+        int mCursorY = 0;
+        int mShelfHeight = 0;
+    };
+
+    namespace
+    {
+        void copyPixels(const osg::Image& image, osg::Image& page, int x, int y)
+        {
+            const std::size_t pixelBytes
+                = osg::Image::computePixelSizeInBits(image.getPixelFormat(), image.getDataType()) / 8;
+            const std::size_t pageRowBytes = pageSize * pixelBytes;
+
+            for (int row = -border; row < image.t() + border; ++row)
+            {
+                const unsigned char* source = image.data(0, std::clamp(row, 0, image.t() - 1));
+                unsigned char* target = page.data() + (y + row) * pageRowBytes;
+                for (int column = -border; column < image.s() + border; ++column)
+                {
+                    const int sourceColumn = std::clamp(column, 0, image.s() - 1);
+                    std::memcpy(target + (x + column) * pixelBytes, source + sourceColumn * pixelBytes, pixelBytes);
+                }
+            }
+        }
+
+        void copyBlocks(const osg::Image& image, Compression compression, osg::Image& page, int x, int y)
+        {
+            const std::size_t blockBytes = getBlockBytes(compression);
+            const int blocksX = image.s() / blockSize;
+            const int blocksY = image.t() / blockSize;
+            const int pageBlocksX = pageSize / blockSize;
+            const int borderBlocks = border / blockSize;
+
+            for (int row = -borderBlocks; row < blocksY + borderBlocks; ++row)
+            {
+                const int sourceRow = std::clamp(row, 0, blocksY - 1);
+                for (int column = -borderBlocks; column < blocksX + borderBlocks; ++column)
+                {
+                    const int sourceColumn = std::clamp(column, 0, blocksX - 1);
+                    const unsigned char* source = image.data() + (sourceRow * blocksX + sourceColumn) * blockBytes;
+                    unsigned char* target = page.data()
+                        + ((y / blockSize + row) * pageBlocksX + x / blockSize + column) * blockBytes;
+                    std::memcpy(target, source, blockBytes);
+                    // Mirroring the edge blocks puts the edge texels next to the image, like clamping to the edge does
+                    mirrorBlock(target, compression, column != sourceColumn, row != sourceRow);
+                }
+            }
+        }
+    }
+
+    TextureAtlas::TextureAtlas() = default;
+
+    TextureAtlas::~TextureAtlas() = default;
+
+    std::optional<TextureAtlas::Region> TextureAtlas::add(const osg::Image& image)
+    {
+        const auto found = mRegions.find(osg::ref_ptr<const osg::Image>(&image));
+        if (found != mRegions.end())
+            return found->second;
+
+        const int width = image.s();
+        const int height = image.t();
+        if (width < 1 || height < 1 || width > maxImageSize || height > maxImageSize || image.r() != 1)
+            return std::nullopt;
+
+        const Compression compression = getCompression(image);
+        if (compression == Compression::Unsupported)
+            return std::nullopt;
+        if (compression == Compression::None
+            && (image.getDataType() != GL_UNSIGNED_BYTE
+                || osg::Image::computePixelSizeInBits(image.getPixelFormat(), image.getDataType()) % 8 != 0))
+            return std::nullopt;
+        if (compression != Compression::None && (width % blockSize != 0 || height % blockSize != 0))
+            return std::nullopt;
+
+        // Cells start on block boundaries whatever the format
+        const int cellWidth = (width + 2 * border + blockSize - 1) / blockSize * blockSize;
+        const int cellHeight = (height + 2 * border + blockSize - 1) / blockSize * blockSize;
+
+        std::shared_ptr<Page> page;
+        int x = 0;
+        int y = 0;
+        for (const std::shared_ptr<Page>& candidate : mPages)
+        {
+            if (candidate->hasFormat(image) && candidate->allocate(cellWidth, cellHeight, x, y))
+            {
+                page = candidate;
+                break;
+            }
+        }
+        if (!page)
+        {
+            page = std::make_shared<Page>(image);
+            page->allocate(cellWidth, cellHeight, x, y);
+            mPages.push_back(page);
+        }
+
+        x += border;
+        y += border;
+
+        osg::Image& pageImage = page->getWritableImage();
+        if (compression == Compression::None)
+            copyPixels(image, pageImage, x, y);
+        else
+            copyBlocks(image, compression, pageImage, x, y);
+
+        // Texture coordinates are flipped vertically when drawing, so the offset counts from the end of the page
+        const float offsetY = static_cast<float>(pageSize - y - height) / pageSize;
+        Region region{
+            .mPage = page,
+            .mOffset = osg::Vec2f(static_cast<float>(x) / pageSize, offsetY),
+            .mScale = osg::Vec2f(static_cast<float>(width) / pageSize, static_cast<float>(height) / pageSize),
+        };
+        mRegions.emplace(osg::ref_ptr<const osg::Image>(&image), region);
+        return region;
+    }
+
+    osg::Texture2D* TextureAtlas::getTexture(Page& page)
+    {
+        return page.getTexture();
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef OPENMW_COMPONENTS_MYGUIPLATFORM_TEXTUREATLAS_H
+#define OPENMW_COMPONENTS_MYGUIPLATFORM_TEXTUREATLAS_H
+
+#include <osg/Vec2f>
+#include <osg/ref_ptr>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace osg
+{
+    class Image;
+    class Texture2D;
+}
+
+namespace MyGUIPlatform
+{
+    /// @brief Packs small images such as icons into shared textures, so that the UI elements using them can be drawn
+    /// with a single draw call.
+    /// @par A page is never modified once its texture was handed out for drawing, images added later go into a copy
+    /// that replaces the texture of the page on the next getTexture call.
+    class TextureAtlas
+    {
+    public:
+        class Page;
+
+        struct Region
+        {
+            std::shared_ptr<Page> mPage;
+            // Maps the texture coordinates of the image to the page, in the top left origin used by MyGUI
+            osg::Vec2f mOffset;
+            osg::Vec2f mScale;
+        };
+
+        TextureAtlas();
+        ~TextureAtlas();
+
+        /// @return Nothing if the image is too large or its format can't be packed
+        std::optional<Region> add(const osg::Image& image);
+
+        static osg::Texture2D* getTexture(Page& page);
+
+    private:
+        std::vector<std::shared_ptr<Page>> mPages;
+        std::map<osg::ref_ptr<const osg::Image>, Region> mRegions;
+    };
+}
+
+#endif
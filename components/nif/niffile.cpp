@@ -30,6 +30,7 @@ namespace Nif
         , mBethVersion(file.mBethVersion)
         , mFilename(file.mPath)
         , mHash(file.mHash)
+        , mArena(file.mArena)
         , mRecords(file.mRecords)
         , mRoots(file.mRoots)
         , mUseSkinning(file.mUseSkinning)
@@ -38,14 +39,14 @@ namespace Nif
     }
 
     template <typename NodeType, RecordType recordType>
-    static std::unique_ptr<Record> construct()
+    static Record* construct(RecordArena& arena)
     {
-        auto result = std::make_unique<NodeType>();
+        NodeType* const result = arena.create<NodeType>();
         result->recType = recordType;
         return result;
     }
 
-    using CreateRecord = std::unique_ptr<Record> (*)();
+    using CreateRecord = Record* (*)(RecordArena&);
 
     /// These are all the record types we know how to read.
     static std::map<std::string, CreateRecord> makeFactory()
@@ -601,6 +602,8 @@ namespace Nif
             nif.read(mUserVersion);
 
         mRecords.resize(nif.get<std::uint32_t>());
+        // Rough size of an average record, the count may be bogus so a damaged file doesn't reserve too much
+        mArena.reserve(std::min<std::size_t>(mRecords.size(), 64 * 1024) * 256);
 
         // Bethesda stream header
         {
@@ -672,7 +675,7 @@ namespace Nif
 
         for (std::size_t i = 0; i < mRecords.size(); i++)
         {
-            std::unique_ptr<Record> r;
+            Record* r = nullptr;
 
             std::string rec = hasRecTypeListings ? recTypes[recTypeIndices[i]] : nif.get<std::string>();
             if (rec.empty())
@@ -691,7 +694,7 @@ namespace Nif
             if (entry == factories.end())
                 throw Nif::Exception("Unknown record type " + rec, mFilename);
 
-            r = entry->second();
+            r = entry->second(mArena);
 
             if (writeDebug)
                 Log(Debug::Verbose) << "NIF Debug: Reading record of type " << rec << ", index " << i;
@@ -701,7 +704,7 @@ namespace Nif
             r->recName = std::move(rec);
             r->recIndex = i;
             r->read(&nif);
-            mRecords[i] = std::move(r);
+            mRecords[i] = r;
         }
 
         // Determine which records are roots
@@ -712,7 +715,7 @@ namespace Nif
             nif.read(idx);
             if (idx >= 0 && static_cast<std::size_t>(idx) < mRecords.size())
             {
-                mRoots[i] = mRecords[idx].get();
+                mRoots[i] = mRecords[idx];
             }
             else
             {
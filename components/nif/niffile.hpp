@@ -11,6 +11,7 @@
 #include <components/vfs/pathutil.hpp>
 
 #include "record.hpp"
+#include "recordarena.hpp"
 
 namespace ToUTF8
 {
@@ -49,8 +50,11 @@ namespace Nif
         VFS::Path::Normalized mPath;
         std::string mHash;
 
+        /// Storage of all records, destroys them together with the file
+        RecordArena mArena;
+
         /// Record list
-        std::vector<std::unique_ptr<Record>> mRecords;
+        std::vector<Record*> mRecords;
 
         /// Root list.  This is a select portion of the pointers from records
         std::vector<Record*> mRoots;
@@ -108,8 +112,10 @@ namespace Nif
         std::string_view mFilename;
         std::string& mHash;
 
+        RecordArena& mArena;
+
         /// Record list
-        std::vector<std::unique_ptr<Record>>& mRecords;
+        std::vector<Record*>& mRecords;
 
         /// Root list.  This is a select portion of the pointers from records
         std::vector<Record*>& mRoots;
@@ -135,7 +141,7 @@ namespace Nif
         void parse(Files::IStreamPtr&& stream);
 
         /// Get a given record
-        Record* getRecord(size_t index) const { return mRecords.at(index).get(); }
+        Record* getRecord(size_t index) const { return mRecords.at(index); }
 
         /// Get a given string from the file's string table
         std::string getString(std::uint32_t index) const;
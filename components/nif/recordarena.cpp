@@ -0,0 +1,30 @@
+#include "recordarena.hpp"
+
+namespace Nif
+{
+    namespace
+    {
+        // Enough for the records of a typical small mesh, monotonic_buffer_resource grows geometrically from here
+        constexpr std::size_t defaultInitialSize = 16 * 1024;
+    }
+
+    RecordArena::~RecordArena()
+    {
+        // Records may refer to each other, but none of them accesses others on destruction
+        for (auto it = mRecords.rbegin(); it != mRecords.rend(); ++it)
+            (*it)->~Record();
+    }
+
+    void RecordArena::reserve(std::size_t bytes)
+    {
+        if (!mResource.has_value() && bytes > 0)
+            mResource.emplace(bytes);
+    }
+
+    void* RecordArena::allocate(std::size_t size, std::size_t alignment)
+    {
+        if (!mResource.has_value())
+            mResource.emplace(defaultInitialSize);
+        return mResource->allocate(size, alignment);
+    }
+}
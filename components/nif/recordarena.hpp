@@ -0,0 +1,61 @@
+#ifndef OPENMW_COMPONENTS_NIF_RECORDARENA_HPP
+#define OPENMW_COMPONENTS_NIF_RECORDARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "record.hpp"
+
+namespace Nif
+{
+    /// @brief Owns all records of a NIF file.
+    /// @par Records are placed one after another in a few large memory blocks instead of being allocated separately,
+    /// all of them are destroyed and the memory is released at once together with the arena.
+    class RecordArena
+    {
+    public:
+        RecordArena() = default;
+
+        RecordArena(const RecordArena&) = delete;
+
+        RecordArena& operator=(const RecordArena&) = delete;
+
+        ~RecordArena();
+
+        /// Set the size of the first memory block, has no effect once anything is created.
+        void reserve(std::size_t bytes);
+
+        template <class T>
+        T* create()
+        {
+            static_assert(std::is_base_of_v<Record, T>);
+            void* const memory = allocate(sizeof(T), alignof(T));
+            mRecords.push_back(nullptr);
+            try
+            {
+                T* const result = new (memory) T();
+                mRecords.back() = result;
+                return result;
+            }
+            catch (...)
+            {
+                mRecords.pop_back();
+                throw;
+            }
+        }
+
+        std::size_t size() const { return mRecords.size(); }
+
+    private:
+        std::optional<std::pmr::monotonic_buffer_resource> mResource;
+        std::vector<Record*> mRecords;
+
+        void* allocate(std::size_t size, std::size_t alignment);
+    };
+}
+
+#endif
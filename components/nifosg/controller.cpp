@@ -292,6 +292,7 @@ namespace NifOsg
         , mVScale(data->mKeyList[3], 1.f)
         , mTextureUnits(textureUnits)
     {
+        setParallel(true);
     }
 
     UVController::UVController(const UVController& copy, const osg::CopyOp& copyop)
@@ -360,6 +361,7 @@ namespace NifOsg
     VisController::VisController(const VisController& copy, const osg::CopyOp& copyop)
         : SceneUtil::NodeCallback<VisController>(copy, copyop)
         , Controller(copy)
+        , SceneUtil::ParallelUpdateCallback(copy)
         , mData(copy.mData)
         , mInterpolator(copy.mInterpolator)
         , mMask(copy.mMask)
@@ -382,13 +384,20 @@ namespace NifOsg
     }
 
     void VisController::operator()(osg::Node* node, osg::NodeVisitor* nv)
+    {
+        if (!SceneUtil::ParallelUpdateVisitor::isUpdated(*node, *this, *this, nv))
+            updateParallel(*node, *nv);
+        traverse(node, nv);
+    }
+
+    bool VisController::updateParallel(osg::Node& node, osg::NodeVisitor& nv)
     {
         if (hasInput())
         {
-            bool vis = calculate(getInputValue(nv));
-            node->setNodeMask(vis ? ~0 : mMask);
+            bool vis = calculate(getInputValue(&nv));
+            node.setNodeMask(vis ? ~0 : mMask);
         }
-        traverse(node, nv);
+        return true;
     }
 
     RollController::RollController(const Nif::NiRollController* ctrl)
@@ -439,6 +448,7 @@ namespace NifOsg
     AlphaController::AlphaController(const Nif::NiAlphaController* ctrl, const osg::Material* baseMaterial)
         : mBaseMaterial(baseMaterial)
     {
+        setParallel(true);
         if (!ctrl->mInterpolator.empty())
         {
             if (ctrl->mInterpolator->recType == Nif::RC_NiFloatInterpolator)
@@ -481,6 +491,7 @@ namespace NifOsg
         : mTargetColor(ctrl->mTargetColor)
         , mBaseMaterial(baseMaterial)
     {
+        setParallel(true);
         if (!ctrl->mInterpolator.empty())
         {
             if (ctrl->mInterpolator->recType == Nif::RC_NiPoint3Interpolator)
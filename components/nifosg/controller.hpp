@@ -1,8 +1,15 @@
 #ifndef COMPONENTS_NIFOSG_CONTROLLER_H
 #define COMPONENTS_NIFOSG_CONTROLLER_H
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <set>
 #include <type_traits>
+#include <vector>
 
 #include <osg/Texture2D>
 
@@ -34,33 +41,136 @@ namespace NifOsg
 
     class MatrixTransform;
 
+    // Type keyframe values are kept in by ValueInterpolator, quaternions are read from NIF files as floats
+    template <typename T>
+    struct PackedValue
+    {
+        using Type = T;
+
+        static T pack(const T& value) { return value; }
+
+        static T unpack(const T& value) { return value; }
+    };
+
+    template <>
+    struct PackedValue<osg::Quat>
+    {
+        using Type = osg::Vec4f;
+
+        static osg::Vec4f pack(const osg::Quat& value)
+        {
+            return osg::Vec4f(static_cast<float>(value.x()), static_cast<float>(value.y()),
+                static_cast<float>(value.z()), static_cast<float>(value.w()));
+        }
+
+        static osg::Quat unpack(const osg::Vec4f& value) { return osg::Quat(value); }
+    };
+
     // interpolation of keyframes
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+    public:
+        using ValueT = typename MapT::ValueType;
+
+    private:
+        using Packed = PackedValue<ValueT>;
+        using PackedT = typename Packed::Type;
+
+        // Keys converted once when the controller is created and shared by its copies. Times and values are kept in
+        // separate arrays, tangents only for the interpolation types using them.
+        struct Track
+        {
+            unsigned int mInterpolationType = Nif::InterpolationType_Unknown;
+            // Time between keys if they are evenly spaced, 0 otherwise
+            float mStep = 0;
+            std::vector<float> mTimes;
+            std::vector<PackedT> mValues;
+            std::vector<PackedT> mInTans;
+            std::vector<PackedT> mOutTans;
+        };
+
+        static std::shared_ptr<const Track> makeTrack(const std::shared_ptr<const MapT>& keys)
+        {
+            if (keys == nullptr || keys->mKeys.empty())
+                return nullptr;
+
+            auto track = std::make_shared<Track>();
+            track->mInterpolationType = keys->mInterpolationType;
+            const bool hasTangents = !std::is_same_v<ValueT, osg::Quat>
+                && (keys->mInterpolationType == Nif::InterpolationType_Quadratic
+                    || keys->mInterpolationType == Nif::InterpolationType_TCB);
+
+            const std::size_t size = keys->mKeys.size();
+            track->mTimes.reserve(size);
+            track->mValues.reserve(size);
+            if (hasTangents)
+            {
+                track->mInTans.reserve(size);
+                track->mOutTans.reserve(size);
+            }
+
+            for (const auto& [time, key] : keys->mKeys)
+            {
+                track->mTimes.push_back(time);
+                track->mValues.push_back(Packed::pack(key.mValue));
+                if (hasTangents)
+                {
+                    track->mInTans.push_back(Packed::pack(key.mInTan));
+                    track->mOutTans.push_back(Packed::pack(key.mOutTan));
+                }
+            }
+
+            const std::vector<float>& times = track->mTimes;
+            if (size >= 3 && times.back() > times.front())
+            {
+                const float step = (times.back() - times.front()) / static_cast<float>(size - 1);
+                bool even = true;
+                for (std::size_t i = 1; i < size && even; ++i)
+                    even = std::abs(times[i] - (times.front() + step * static_cast<float>(i))) < step * 0.01f;
+                if (even)
+                    track->mStep = step;
+            }
+
+            return track;
+        }
+
+        // Index of the first key not earlier than the time, the number of keys if there is none
+        std::size_t retrieveKey(float time) const
         {
-            // retrieve the current position in the map, optimized for the most common case
+            const std::vector<float>& times = mTrack->mTimes;
+
+            // retrieve the current position in the track, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            if (mLastHighKey < times.size())
             {
-                if (time > mLastHighKey->first)
+                if (time > times[mLastHighKey])
                 {
                     // try if we're there by incrementing one
-                    ++mLastLowKey;
                     ++mLastHighKey;
                 }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
+                if (mLastHighKey < times.size() && time >= times[mLastHighKey - 1] && time <= times[mLastHighKey])
                     return mLastHighKey;
             }
 
-            return std::lower_bound(mKeys->mKeys.begin(), mKeys->mKeys.end(), time,
-                [](const typename MapT::MapType::value_type& key, float t) { return key.first < t; });
+            if (mTrack->mStep > 0)
+            {
+                // Evenly spaced keys give the position directly, it is only corrected for rounding
+                const float position = std::ceil((time - times.front()) / mTrack->mStep);
+                const float maxPosition = static_cast<float>(times.size());
+                std::size_t index = static_cast<std::size_t>(std::clamp(position, 0.f, maxPosition));
+                while (index > 0 && times[index - 1] >= time)
+                    --index;
+                while (index < times.size() && times[index] < time)
+                    ++index;
+                return index;
+            }
+
+            return static_cast<std::size_t>(
+                std::distance(times.begin(), std::lower_bound(times.begin(), times.end(), time)));
         }
 
     public:
-        using ValueT = typename MapT::ValueType;
-
         ValueInterpolator() = default;
 
         template <class T,
@@ -74,23 +184,13 @@ namespace NifOsg
         {
             if (interpolator->mData.empty())
                 return;
-            mKeys = interpolator->mData->mKeyList;
-            if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
+            mTrack = makeTrack(interpolator->mData->mKeyList);
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
-            : mKeys(keys)
+            : mTrack(makeTrack(keys))
             , mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueT interpKey(float time) const
@@ -98,87 +198,91 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType& keys = mKeys->mKeys;
+            const Track& track = *mTrack;
 
-            if (time <= keys.front().first)
-                return keys.front().second.mValue;
+            if (time <= track.mTimes.front())
+                return Packed::unpack(track.mValues.front());
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+            const std::size_t high = retrieveKey(time);
 
             // now do the actual interpolation
-            if (it != keys.end())
+            if (high < track.mTimes.size())
             {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                mLastHighKey = high;
+                const std::size_t low = high - 1;
 
-                const float highTime = mLastHighKey->first;
-                const float lowTime = mLastLowKey->first;
+                const float highTime = track.mTimes[high];
+                const float lowTime = track.mTimes[low];
                 if (highTime == lowTime)
-                    return mLastLowKey->second.mValue;
+                    return Packed::unpack(track.mValues[low]);
 
                 const float a = (time - lowTime) / (highTime - lowTime);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
+                return interpolate(track, low, high, a);
             }
 
-            return keys.back().second.mValue;
+            return Packed::unpack(track.mValues.back());
         }
 
-        bool empty() const { return !mKeys || mKeys->mKeys.empty(); }
+        bool empty() const { return mTrack == nullptr; }
 
     private:
-        template <typename ValueType>
-        ValueType interpolate(
-            const Nif::KeyT<ValueType>& a, const Nif::KeyT<ValueType>& b, float fraction, unsigned int type) const
+        static ValueT interpolate(const Track& track, std::size_t low, std::size_t high, float fraction)
         {
-            switch (type)
+            const ValueT a = Packed::unpack(track.mValues[low]);
+            const ValueT b = Packed::unpack(track.mValues[high]);
+
+            if constexpr (std::is_same_v<ValueT, osg::Quat>)
             {
-                case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
-                case Nif::InterpolationType_Quadratic:
-                case Nif::InterpolationType_TCB:
+                switch (track.mInterpolationType)
                 {
-                    // Using a cubic Hermite spline.
-                    // b1(t) = 2t^3  - 3t^2 + 1
-                    // b2(t) = -2t^3 + 3t^2
-                    // b3(t) = t^3 - 2t^2 + t
-                    // b4(t) = t^3 - t^2
-                    // f(t) = a.mValue * b1(t) + b.mValue * b2(t) + a.mOutTan * b3(t) + b.mInTan * b4(t)
-                    const float t = fraction;
-                    const float t2 = t * t;
-                    const float t3 = t2 * t;
-                    const float b1 = 2.f * t3 - 3.f * t2 + 1;
-                    const float b2 = -2.f * t3 + 3.f * t2;
-                    const float b3 = t3 - 2.f * t2 + t;
-                    const float b4 = t3 - t2;
-                    return a.mValue * b1 + b.mValue * b2 + a.mOutTan * b3 + b.mInTan * b4;
+                    case Nif::InterpolationType_Constant:
+                        return fraction > 0.5f ? b : a;
+                    // TODO: Implement Quadratic and TBC interpolation
+                    default:
+                    {
+                        osg::Quat result;
+                        result.slerp(fraction, a, b);
+                        return result;
+                    }
                 }
-                default:
-                    return a.mValue + ((b.mValue - a.mValue) * fraction);
             }
-        }
-        osg::Quat interpolate(
-            const Nif::KeyT<osg::Quat>& a, const Nif::KeyT<osg::Quat>& b, float fraction, unsigned int type) const
-        {
-            switch (type)
+            else
             {
-                case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
-                // TODO: Implement Quadratic and TBC interpolation
-                default:
+                switch (track.mInterpolationType)
                 {
-                    osg::Quat result;
-                    result.slerp(fraction, a.mValue, b.mValue);
-                    return result;
+                    case Nif::InterpolationType_Constant:
+                        return fraction > 0.5f ? b : a;
+                    case Nif::InterpolationType_Quadratic:
+                    case Nif::InterpolationType_TCB:
+                    {
+                        // Using a cubic Hermite spline.
+                        // b1(t) = 2t^3  - 3t^2 + 1
+                        // b2(t) = -2t^3 + 3t^2
+                        // b3(t) = t^3 - 2t^2 + t
+                        // b4(t) = t^3 - t^2
+                        // f(t) = a.mValue * b1(t) + b.mValue * b2(t) + a.mOutTan * b3(t) + b.mInTan * b4(t)
+                        const ValueT outTan = track.mOutTans[low];
+                        const ValueT inTan = track.mInTans[high];
+                        const float t = fraction;
+                        const float t2 = t * t;
+                        const float t3 = t2 * t;
+                        const float b1 = 2.f * t3 - 3.f * t2 + 1;
+                        const float b2 = -2.f * t3 + 3.f * t2;
+                        const float b3 = t3 - 2.f * t2 + t;
+                        const float b4 = t3 - t2;
+                        return a * b1 + b * b2 + outTan * b3 + inTan * b4;
+                    }
+                    default:
+                        return a + ((b - a) * fraction);
                 }
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        mutable std::size_t mLastHighKey = std::numeric_limits<std::size_t>::max();
 
-        std::shared_ptr<const MapT> mKeys;
+        std::shared_ptr<const Track> mTrack;
 
         ValueT mDefaultVal = ValueT();
     };
@@ -286,7 +390,9 @@ namespace NifOsg
         std::set<unsigned int> mTextureUnits;
     };
 
-    class VisController : public SceneUtil::NodeCallback<VisController>, public SceneUtil::Controller
+    class VisController : public SceneUtil::NodeCallback<VisController>,
+                          public SceneUtil::Controller,
+                          public SceneUtil::ParallelUpdateCallback
     {
     private:
         std::shared_ptr<std::vector<std::pair<float, bool>>> mData;
@@ -303,6 +409,8 @@ namespace NifOsg
         META_Object(NifOsg, VisController)
 
         void operator()(osg::Node* node, osg::NodeVisitor* nv);
+
+        bool updateParallel(osg::Node& node, osg::NodeVisitor& nv) override;
     };
 
     class RollController : public SceneUtil::NodeCallback<RollController, osg::MatrixTransform*>,
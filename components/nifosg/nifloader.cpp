@@ -278,6 +278,18 @@ namespace NifOsg
         return sSoftEffectEnabled;
     }
 
+    bool Loader::sPauseOffscreenParticles = false;
+
+    void Loader::setPauseOffscreenParticles(bool pause)
+    {
+        sPauseOffscreenParticles = pause;
+    }
+
+    bool Loader::getPauseOffscreenParticles()
+    {
+        return sPauseOffscreenParticles;
+    }
+
     class LoaderImpl
     {
     public:
@@ -1398,6 +1410,10 @@ namespace NifOsg
 
             partsys->setParticleScaleReferenceFrame(osgParticle::ParticleSystem::LOCAL_COORDINATES);
 
+            // Bounds of world space particles are not moved with the emitter, so they could stay culled forever
+            if (rf == osgParticle::ParticleProcessor::RELATIVE_RF && Loader::getPauseOffscreenParticles())
+                partsys->setFreezeOnCull(true);
+
             handleParticleInitialState(nifNode, partsys, partctrl);
 
             partsys->getDefaultParticleTemplate().setSizeRange(
@@ -58,11 +58,17 @@ namespace NifOsg
         static void setSoftEffectEnabled(bool enabled);
         static bool getSoftEffectEnabled();
 
+        /// Set whether particle systems in object space stop updating while they are culled.
+        /// Default: false.
+        static void setPauseOffscreenParticles(bool pause);
+        static bool getPauseOffscreenParticles();
+
     private:
         static unsigned int sHiddenNodeMask;
         static unsigned int sIntersectionDisabledNodeMask;
         static bool sShowMarkers;
         static bool sSoftEffectEnabled;
+        static bool sPauseOffscreenParticles;
     };
 
 }
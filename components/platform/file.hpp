@@ -63,6 +63,22 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    /// Read-only view of a whole file mapped into memory. Throws if the platform can't map files.
+    class ScopedMapping
+    {
+        const char* mData = nullptr;
+        size_t mSize = 0;
+
+    public:
+        explicit ScopedMapping(const std::filesystem::path& filename);
+        ScopedMapping(const ScopedMapping& other) = delete;
+        ScopedMapping& operator=(const ScopedMapping& other) = delete;
+        ~ScopedMapping();
+
+        const char* data() const { return mData; }
+        size_t size() const { return mSize; }
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
@@ -6,6 +6,8 @@
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -103,4 +105,33 @@ namespace Platform::File
         return amount;
     }
 
+    ScopedMapping::ScopedMapping(const std::filesystem::path& filename)
+    {
+        const ScopedHandle handle = open(filename);
+        const int nativeHandle = getNativeHandle(handle);
+
+        struct stat info;
+        if (::fstat(nativeHandle, &info) == -1)
+            throw std::system_error(errno, std::generic_category(), "An fstat() call failed");
+
+        mSize = static_cast<size_t>(info.st_size);
+        if (mSize == 0)
+            return;
+
+        // The mapping stays valid after the descriptor is closed
+        void* const data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, nativeHandle, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                std::string("Failed to map '") + Files::pathToUnicodeString(filename) + "'");
+        }
+        mData = static_cast<const char*>(data);
+    }
+
+    ScopedMapping::~ScopedMapping()
+    {
+        if (mData != nullptr)
+            ::munmap(const_cast<char*>(mData), mSize);
+    }
+
 }
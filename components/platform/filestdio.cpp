@@ -93,4 +93,12 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    ScopedMapping::ScopedMapping(const std::filesystem::path& filename)
+    {
+        throw std::runtime_error(
+            std::string("Memory mapping is not supported, can't map '") + Files::pathToUnicodeString(filename) + "'");
+    }
+
+    ScopedMapping::~ScopedMapping() = default;
+
 }
@@ -99,4 +99,42 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    ScopedMapping::ScopedMapping(const std::filesystem::path& filename)
+    {
+        const ScopedHandle handle = open(filename);
+        const HANDLE nativeHandle = getNativeHandle(handle);
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(nativeHandle, &fileSize))
+            throw std::runtime_error("A query operation on a file failed.");
+
+        mSize = static_cast<size_t>(fileSize.QuadPart);
+        if (mSize == 0)
+            return;
+
+        const HANDLE mapping = CreateFileMappingW(nativeHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "': " + std::to_string(GetLastError()));
+        }
+
+        // The view keeps the mapping object alive
+        const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        const DWORD error = GetLastError();
+        CloseHandle(mapping);
+        if (data == nullptr)
+        {
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "': " + std::to_string(error));
+        }
+        mData = static_cast<const char*>(data);
+    }
+
+    ScopedMapping::~ScopedMapping()
+    {
+        if (mData != nullptr)
+            UnmapViewOfFile(mData);
+    }
 }
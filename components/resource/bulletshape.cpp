@@ -1,12 +1,15 @@
 #include "bulletshape.hpp"
 
+#include <cstring>
 #include <stdexcept>
 #include <string>
 
 #include <BulletCollision/CollisionShapes/btBoxShape.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
 #include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <LinearMath/btAlignedAllocator.h>
 
 namespace Resource
 {
@@ -107,4 +110,33 @@ namespace Resource
         , mSource(std::move(source))
     {
     }
+
+    SerializedBvhTriangleMeshShape::SerializedBvhTriangleMeshShape(
+        btStridingMeshInterface* meshInterface, const std::byte* bvh, std::size_t size)
+        : TriangleMeshShape(meshInterface, true, false)
+    {
+        if (size > 0)
+        {
+            // The BVH is restored in place, so the buffer lives as long as the shape
+            mBvhBuffer = btAlignedAlloc(size, 16);
+            std::memcpy(mBvhBuffer, bvh, size);
+            if (btOptimizedBvh* const restored
+                = btOptimizedBvh::deSerializeInPlace(mBvhBuffer, static_cast<unsigned>(size), false))
+            {
+                setOptimizedBvh(restored);
+                return;
+            }
+            btAlignedFree(mBvhBuffer);
+            mBvhBuffer = nullptr;
+        }
+        buildOptimizedBvh();
+    }
+
+    SerializedBvhTriangleMeshShape::~SerializedBvhTriangleMeshShape()
+    {
+        if (mBvhBuffer == nullptr)
+            return;
+        getOptimizedBvh()->~btOptimizedBvh();
+        btAlignedFree(mBvhBuffer);
+    }
 }
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_BULLETSHAPE_H
 #define OPENMW_COMPONENTS_RESOURCE_BULLETSHAPE_H
 
+#include <cstddef>
 #include <map>
 #include <memory>
 
@@ -105,6 +106,18 @@ namespace Resource
         }
     };
 
+    // TriangleMeshShape with the BVH restored from a btOptimizedBvh::serializeInPlace buffer instead of being built
+    // from the triangles. The BVH is built as usual when the buffer can't be restored.
+    struct SerializedBvhTriangleMeshShape : public TriangleMeshShape
+    {
+        SerializedBvhTriangleMeshShape(btStridingMeshInterface* meshInterface, const std::byte* bvh, std::size_t size);
+
+        ~SerializedBvhTriangleMeshShape() override;
+
+    private:
+        void* mBvhBuffer = nullptr;
+    };
+
     // btScaledBvhTriangleMeshShape that auto-deletes the child shape
     struct ScaledTriangleMeshShape : public btScaledBvhTriangleMeshShape
     {
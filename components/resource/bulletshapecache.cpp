@@ -0,0 +1,412 @@
+#include "bulletshapecache.hpp"
+
+#include "bulletshape.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+#include <LinearMath/btAlignedAllocator.h>
+#include <LinearMath/btScalar.h>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/pathhelpers.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+#include <components/vfs/manager.hpp>
+
+namespace Resource
+{
+    namespace
+    {
+        // Increase when NifBullet::BulletNifLoader output or the layout below changes
+        constexpr int formatVersion = 1;
+
+        struct MeshData
+        {
+            // Rows of the basis followed by the origin of the transform in the compound shape
+            btScalar mTransform[12] = {};
+            btScalar mScaling[3] = {};
+            std::vector<btScalar> mVertices;
+            std::vector<std::int32_t> mIndices;
+            std::vector<std::byte> mBvh;
+        };
+
+        struct CompoundShapeData
+        {
+            std::uint8_t mPresent = 0;
+            std::vector<MeshData> mChildren;
+        };
+
+        struct ShapeData
+        {
+            std::vector<char> mFileName;
+            std::vector<char> mFileHash;
+            float mCollisionBoxExtents[3] = {};
+            float mCollisionBoxCenter[3] = {};
+            std::int32_t mVisualCollisionType = 0;
+            // Pairs of the node record index and the child index
+            std::vector<std::int32_t> mAnimatedShapes;
+            CompoundShapeData mCollisionShape;
+            CompoundShapeData mAvoidCollisionShape;
+        };
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, MeshData>>
+            {
+                visitor(*this, value.mTransform);
+                visitor(*this, value.mScaling);
+                visitor(*this, value.mVertices);
+                visitor(*this, value.mIndices);
+                visitor(*this, value.mBvh);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CompoundShapeData>>
+            {
+                visitor(*this, value.mPresent);
+                visitor(*this, value.mChildren);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ShapeData>>
+            {
+                visitor(*this, value.mFileName);
+                visitor(*this, value.mFileHash);
+                visitor(*this, value.mCollisionBoxExtents);
+                visitor(*this, value.mCollisionBoxCenter);
+                visitor(*this, value.mVisualCollisionType);
+                visitor(*this, value.mAnimatedShapes);
+                visitor(*this, value.mCollisionShape);
+                visitor(*this, value.mAvoidCollisionShape);
+            }
+        };
+
+        template <class T>
+        T readValue(const unsigned char* data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        bool toMeshData(const btBvhTriangleMeshShape& shape, MeshData& data)
+        {
+            btOptimizedBvh* const bvh = const_cast<btBvhTriangleMeshShape&>(shape).getOptimizedBvh();
+            const btStridingMeshInterface* const meshInterface = shape.getMeshInterface();
+            if (bvh == nullptr || !shape.usesQuantizedAabbCompression()
+                || dynamic_cast<const btTriangleMesh*>(meshInterface) == nullptr
+                || meshInterface->getNumSubParts() != 1)
+                return false;
+
+            const unsigned char* vertexBase = nullptr;
+            int numVertices = 0;
+            PHY_ScalarType vertexType = PHY_FLOAT;
+            int vertexStride = 0;
+            const unsigned char* indexBase = nullptr;
+            int indexStride = 0;
+            int numFaces = 0;
+            PHY_ScalarType indexType = PHY_INTEGER;
+            meshInterface->getLockedReadOnlyVertexIndexBase(&vertexBase, numVertices, vertexType, vertexStride,
+                &indexBase, indexStride, numFaces, indexType);
+
+            bool supported = (vertexType == PHY_FLOAT || vertexType == PHY_DOUBLE)
+                && (indexType == PHY_INTEGER || indexType == PHY_SHORT);
+            if (supported)
+            {
+                data.mVertices.reserve(static_cast<std::size_t>(numVertices) * 3);
+                for (int i = 0; i < numVertices; ++i)
+                {
+                    const unsigned char* const vertex = vertexBase + static_cast<std::ptrdiff_t>(i) * vertexStride;
+                    for (int j = 0; j < 3; ++j)
+                        data.mVertices.push_back(vertexType == PHY_FLOAT
+                                ? static_cast<btScalar>(readValue<float>(vertex + j * sizeof(float)))
+                                : static_cast<btScalar>(readValue<double>(vertex + j * sizeof(double))));
+                }
+
+                data.mIndices.reserve(static_cast<std::size_t>(numFaces) * 3);
+                for (int i = 0; i < numFaces; ++i)
+                {
+                    const unsigned char* const face = indexBase + static_cast<std::ptrdiff_t>(i) * indexStride;
+                    for (int j = 0; j < 3; ++j)
+                        data.mIndices.push_back(indexType == PHY_INTEGER
+                                ? readValue<std::int32_t>(face + j * sizeof(std::int32_t))
+                                : readValue<std::uint16_t>(face + j * sizeof(std::uint16_t)));
+                }
+            }
+
+            meshInterface->unLockReadOnlyVertexBase(0);
+
+            if (!supported)
+                return false;
+
+            const unsigned size = bvh->calculateSerializeBufferSize();
+            std::unique_ptr<void, void (*)(void*)> buffer(btAlignedAlloc(size, 16), [](void* v) { btAlignedFree(v); });
+            if (!bvh->serializeInPlace(buffer.get(), size, false))
+                return false;
+            const std::byte* const begin = static_cast<const std::byte*>(buffer.get());
+            data.mBvh.assign(begin, begin + size);
+
+            return true;
+        }
+
+        bool toCompoundShapeData(const btCollisionShape* shape, CompoundShapeData& data)
+        {
+            if (shape == nullptr)
+                return true;
+
+            if (!shape->isCompound())
+                return false;
+
+            data.mPresent = 1;
+
+            const btCompoundShape& compound = static_cast<const btCompoundShape&>(*shape);
+            data.mChildren.resize(static_cast<std::size_t>(compound.getNumChildShapes()));
+            for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+            {
+                const btCollisionShape* const child = compound.getChildShape(i);
+                if (child->getShapeType() != SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                    return false;
+
+                const btScaledBvhTriangleMeshShape& scaled = static_cast<const btScaledBvhTriangleMeshShape&>(*child);
+                MeshData& meshData = data.mChildren[static_cast<std::size_t>(i)];
+                if (!toMeshData(*scaled.getChildShape(), meshData))
+                    return false;
+
+                const btTransform& transform = compound.getChildTransform(i);
+                for (int row = 0; row < 3; ++row)
+                    for (int column = 0; column < 3; ++column)
+                        meshData.mTransform[row * 3 + column] = transform.getBasis()[row][column];
+                for (int j = 0; j < 3; ++j)
+                {
+                    meshData.mTransform[9 + j] = transform.getOrigin()[j];
+                    meshData.mScaling[j] = scaled.getLocalScaling()[j];
+                }
+            }
+
+            return true;
+        }
+
+        bool toShapeData(const BulletShape& shape, ShapeData& data)
+        {
+            data.mFileName.assign(shape.mFileName.value().begin(), shape.mFileName.value().end());
+            data.mFileHash.assign(shape.mFileHash.begin(), shape.mFileHash.end());
+            for (int i = 0; i < 3; ++i)
+            {
+                data.mCollisionBoxExtents[i] = shape.mCollisionBox.mExtents[i];
+                data.mCollisionBoxCenter[i] = shape.mCollisionBox.mCenter[i];
+            }
+            data.mVisualCollisionType = static_cast<std::int32_t>(shape.mVisualCollisionType);
+            for (const auto& [recordIndex, childIndex] : shape.mAnimatedShapes)
+            {
+                data.mAnimatedShapes.push_back(recordIndex);
+                data.mAnimatedShapes.push_back(childIndex);
+            }
+            return toCompoundShapeData(shape.mCollisionShape.get(), data.mCollisionShape)
+                && toCompoundShapeData(shape.mAvoidCollisionShape.get(), data.mAvoidCollisionShape);
+        }
+
+        CollisionShapePtr makeCompoundShape(const CompoundShapeData& data)
+        {
+            if (data.mPresent == 0)
+                return nullptr;
+
+            std::unique_ptr<btCompoundShape, DeleteCollisionShape> compound(new btCompoundShape);
+
+            for (const MeshData& meshData : data.mChildren)
+            {
+                if (meshData.mVertices.size() % 3 != 0 || meshData.mIndices.size() % 3 != 0)
+                    throw std::runtime_error("invalid triangle mesh size");
+                const std::size_t numVertices = meshData.mVertices.size() / 3;
+
+                auto mesh = std::make_unique<btTriangleMesh>();
+                mesh->preallocateVertices(static_cast<int>(numVertices));
+                for (std::size_t i = 0; i < meshData.mVertices.size(); i += 3)
+                    mesh->findOrAddVertex(
+                        btVector3(meshData.mVertices[i], meshData.mVertices[i + 1], meshData.mVertices[i + 2]), false);
+                mesh->preallocateIndices(static_cast<int>(meshData.mIndices.size()));
+                for (std::size_t i = 0; i < meshData.mIndices.size(); i += 3)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                        if (meshData.mIndices[i + j] < 0
+                            || static_cast<std::size_t>(meshData.mIndices[i + j]) >= numVertices)
+                            throw std::runtime_error("triangle mesh index out of range");
+                    mesh->addTriangleIndices(meshData.mIndices[i], meshData.mIndices[i + 1], meshData.mIndices[i + 2]);
+                }
+
+                auto meshShape = std::make_unique<SerializedBvhTriangleMeshShape>(
+                    mesh.get(), meshData.mBvh.data(), meshData.mBvh.size());
+                std::ignore = mesh.release();
+
+                auto scaledShape = std::make_unique<ScaledTriangleMeshShape>(meshShape.get(),
+                    btVector3(meshData.mScaling[0], meshData.mScaling[1], meshData.mScaling[2]));
+                std::ignore = meshShape.release();
+
+                btTransform transform;
+                transform.getBasis().setValue(meshData.mTransform[0], meshData.mTransform[1], meshData.mTransform[2],
+                    meshData.mTransform[3], meshData.mTransform[4], meshData.mTransform[5], meshData.mTransform[6],
+                    meshData.mTransform[7], meshData.mTransform[8]);
+                transform.setOrigin(
+                    btVector3(meshData.mTransform[9], meshData.mTransform[10], meshData.mTransform[11]));
+
+                compound->addChildShape(transform, scaledShape.get());
+                std::ignore = scaledShape.release();
+            }
+
+            return CollisionShapePtr(compound.release());
+        }
+
+        osg::ref_ptr<BulletShape> makeShape(const ShapeData& data)
+        {
+            if (data.mAnimatedShapes.size() % 2 != 0)
+                throw std::runtime_error("invalid animated shapes size");
+
+            osg::ref_ptr<BulletShape> shape(new BulletShape);
+            shape->mFileName = VFS::Path::Normalized(std::string_view(data.mFileName.data(), data.mFileName.size()));
+            shape->mFileHash.assign(data.mFileHash.begin(), data.mFileHash.end());
+            for (int i = 0; i < 3; ++i)
+            {
+                shape->mCollisionBox.mExtents[i] = data.mCollisionBoxExtents[i];
+                shape->mCollisionBox.mCenter[i] = data.mCollisionBoxCenter[i];
+            }
+            shape->mVisualCollisionType = static_cast<VisualCollisionType>(data.mVisualCollisionType);
+            for (std::size_t i = 0; i < data.mAnimatedShapes.size(); i += 2)
+                shape->mAnimatedShapes.emplace(data.mAnimatedShapes[i], data.mAnimatedShapes[i + 1]);
+            shape->mCollisionShape = makeCompoundShape(data.mCollisionShape);
+            shape->mAvoidCollisionShape = makeCompoundShape(data.mAvoidCollisionShape);
+            return shape;
+        }
+
+        std::string toHex(const std::array<std::uint64_t, 2>& hash)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (const std::uint64_t value : hash)
+                stream << std::setw(16) << value;
+            return stream.str();
+        }
+    }
+
+    BulletShapeCache::BulletShapeCache(const VFS::Manager& vfs, std::filesystem::path directory)
+        : mVFS(vfs)
+        , mDirectory(std::move(directory))
+    {
+    }
+
+    std::optional<std::string> BulletShapeCache::makeKey(VFS::Path::NormalizedView path) const
+    {
+        if (Misc::getFileExtension(path.value()) != "nif")
+            return std::nullopt;
+
+        const Files::IStreamPtr file = mVFS.get(path);
+
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << btGetVersion() << ' ' << sizeof(btScalar) << ' ' << sizeof(void*) << ' '
+                   << path.value() << ' ' << toHex(Files::getHash(path.value(), *file));
+
+        std::istringstream stream(descriptor.str());
+        return toHex(Files::getHash(path.value(), stream));
+    }
+
+    osg::ref_ptr<BulletShape> BulletShapeCache::read(const std::string& key) const
+    {
+        const std::filesystem::path path = getFilePath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        try
+        {
+            std::vector<char> content{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+            if (stream.bad())
+                throw std::runtime_error("failed to read file");
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(content.data());
+            ShapeData data;
+            constexpr Format<Serialization::Mode::Read> format;
+            format(Serialization::BinaryReader(begin, begin + content.size()), data);
+            return makeShape(data);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read cached collision shape " << path << ": " << e.what();
+        }
+        return nullptr;
+    }
+
+    void BulletShapeCache::write(const std::string& key, const BulletShape& shape) const
+    {
+        ShapeData data;
+        if (!toShapeData(shape, data))
+            return;
+
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, data);
+        std::vector<std::byte> content(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(content.data(), content.data() + content.size()), data);
+
+        const std::filesystem::path path = getFilePath(key);
+        // Write to a temporary file first so other threads and processes never read a partially written shape
+        std::filesystem::path temporary = path;
+        temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mDirectory);
+
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                stream.write(
+                    reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+
+            std::filesystem::rename(temporary, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached collision shape " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
+    std::filesystem::path BulletShapeCache::getFilePath(const std::string& key) const
+    {
+        return mDirectory / Files::pathFromUnicodeString(key + ".shape");
+    }
+}
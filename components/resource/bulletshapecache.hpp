@@ -0,0 +1,49 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_BULLETSHAPECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_BULLETSHAPECACHE_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <osg/ref_ptr>
+
+#include <components/vfs/pathutil.hpp>
+
+namespace VFS
+{
+    class Manager;
+}
+
+namespace Resource
+{
+    struct BulletShape;
+
+    /// @brief Collision shapes loaded from NIF files kept on disk between runs.
+    /// @par Shapes are keyed by the source file content and stored with the triangle meshes and their BVH, so reading
+    /// a shape skips both NIF parsing and BVH building. Only shapes made of triangle meshes, as produced by
+    /// NifBullet::BulletNifLoader, are stored. The BVH is stored in the in-memory layout of Bullet, so the key includes
+    /// the Bullet version.
+    /// @note May be used from any thread, shapes are written to temporary files first.
+    class BulletShapeCache
+    {
+    public:
+        explicit BulletShapeCache(const VFS::Manager& vfs, std::filesystem::path directory);
+
+        /// @return Key of the file, nullopt when files of its format are not cached.
+        std::optional<std::string> makeKey(VFS::Path::NormalizedView path) const;
+
+        /// @return Cached shape, nullptr if there is none or it can't be read.
+        osg::ref_ptr<BulletShape> read(const std::string& key) const;
+
+        /// Store the shape if it is made of supported shape types, failures are only logged.
+        void write(const std::string& key, const BulletShape& shape) const;
+
+    private:
+        const VFS::Manager& mVFS;
+        std::filesystem::path mDirectory;
+
+        std::filesystem::path getFilePath(const std::string& key) const;
+    };
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "bulletshapemanager.hpp"
 
+#include <chrono>
 #include <cstring>
 
 #include <osg/Drawable>
@@ -7,6 +8,8 @@
 #include <osg/Transform>
 #include <osg/TriangleFunctor>
 
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 
 #include <components/misc/osguservalues.hpp>
@@ -18,6 +21,7 @@
 #include <components/nifbullet/bulletnifloader.hpp>
 
 #include "bulletshape.hpp"
+#include "bulletshapecache.hpp"
 #include "multiobjectcache.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
@@ -25,6 +29,36 @@
 
 namespace Resource
 {
+    namespace
+    {
+        // Vertices, indices and BVH nodes a triangle takes in a btBvhTriangleMeshShape, roughly
+        constexpr std::size_t sBytesPerTriangle = 64;
+
+        std::size_t estimateSize(const btCollisionShape* shape)
+        {
+            if (shape == nullptr)
+                return 0;
+
+            if (shape->isCompound())
+            {
+                const btCompoundShape& compound = static_cast<const btCompoundShape&>(*shape);
+                std::size_t result = sizeof(btCompoundShape);
+                for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                    result += sizeof(btCompoundShapeChild) + estimateSize(compound.getChildShape(i));
+                return result;
+            }
+
+            if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+            {
+                const btBvhTriangleMeshShape& meshShape = static_cast<const btBvhTriangleMeshShape&>(*shape);
+                if (const auto* mesh = dynamic_cast<const btTriangleMesh*>(meshShape.getMeshInterface()))
+                    return sizeof(btBvhTriangleMeshShape) + mesh->getNumTriangles() * sBytesPerTriangle;
+                return sizeof(btBvhTriangleMeshShape);
+            }
+
+            return sizeof(btCollisionShape);
+        }
+    }
 
     struct GetTriangleFunctor
     {
@@ -113,12 +147,22 @@ namespace Resource
         if (osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name))
             return osg::ref_ptr<BulletShape>(static_cast<BulletShape*>(obj.get()));
 
+        const auto start = std::chrono::steady_clock::now();
         osg::ref_ptr<BulletShape> shape;
 
         if (Misc::getFileExtension(name.value()) == "nif")
         {
-            NifBullet::BulletNifLoader loader;
-            shape = loader.load(*mNifFileManager->get(name));
+            const std::optional<std::string> key = mShapeCache == nullptr ? std::nullopt : mShapeCache->makeKey(name);
+            if (key.has_value())
+                shape = mShapeCache->read(*key);
+
+            if (shape == nullptr)
+            {
+                NifBullet::BulletNifLoader loader;
+                shape = loader.load(*mNifFileManager->get(name));
+                if (key.has_value() && shape != nullptr)
+                    mShapeCache->write(*key, *shape);
+            }
         }
         else
         {
@@ -160,7 +204,15 @@ namespace Resource
             }
         }
 
-        mCache->addEntryToObjectCache(name.value(), shape);
+        CacheEntryCost cost{
+            .mSize = 0,
+            .mLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+        };
+        if (shape != nullptr)
+            cost.mSize = sizeof(BulletShape) + estimateSize(shape->mCollisionShape.get())
+                + estimateSize(shape->mAvoidCollisionShape.get());
+
+        mCache->addEntryToObjectCache(name.value(), shape, cost);
 
         return shape;
     }
@@ -207,4 +259,9 @@ namespace Resource
         Resource::reportStats("Shape Instance", frameNumber, mInstanceCache->getStats(), *stats);
     }
 
+    void BulletShapeManager::setShapeCacheDirectory(const std::filesystem::path& directory)
+    {
+        mShapeCache = std::make_unique<BulletShapeCache>(*mVFS, directory);
+    }
+
 }
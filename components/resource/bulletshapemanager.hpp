@@ -1,6 +1,9 @@
 #ifndef OPENMW_COMPONENTS_BULLETSHAPEMANAGER_H
 #define OPENMW_COMPONENTS_BULLETSHAPEMANAGER_H
 
+#include <filesystem>
+#include <memory>
+
 #include <osg/ref_ptr>
 
 #include <components/vfs/pathutil.hpp>
@@ -17,6 +20,7 @@ namespace Resource
     class BulletShapeInstance;
 
     class MultiObjectCache;
+    class BulletShapeCache;
 
     /// Handles loading, caching and "instancing" of bullet shapes.
     /// A shape 'instance' is a clone of another shape, with the goal of setting a different scale on this instance.
@@ -47,12 +51,16 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        /// Keep collision shapes loaded from NIF files in the directory between runs, see BulletShapeCache.
+        void setShapeCacheDirectory(const std::filesystem::path& directory);
+
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(VFS::Path::NormalizedView name);
 
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
+        std::unique_ptr<BulletShapeCache> mShapeCache;
     };
 
 }
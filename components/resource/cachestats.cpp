@@ -21,9 +21,11 @@ namespace Resource
     {
         constexpr std::string_view suffixes[] = {
             "Count",
+            "Memory",
             "Get",
             "Hit",
             "Expired",
+            "Evicted",
         };
 
         for (std::string_view suffix : suffixes)
@@ -33,8 +35,10 @@ namespace Resource
     void reportStats(std::string_view prefix, unsigned frameNumber, const CacheStats& src, osg::Stats& dst)
     {
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Count"), static_cast<double>(src.mSize));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Memory"), static_cast<double>(src.mMemory));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Get"), static_cast<double>(src.mGet));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Hit"), static_cast<double>(src.mHit));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Expired"), static_cast<double>(src.mExpired));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Evicted"), static_cast<double>(src.mEvicted));
     }
 }
@@ -16,9 +16,11 @@ namespace Resource
     struct CacheStats
     {
         std::size_t mSize = 0;
+        std::size_t mMemory = 0;
         std::size_t mGet = 0;
         std::size_t mHit = 0;
         std::size_t mExpired = 0;
+        std::size_t mEvicted = 0;
     };
 
     void addCacheStatsAttibutes(std::string_view prefix, std::vector<std::string>& out);
@@ -0,0 +1,273 @@
+#include "compiledscenecache.hpp"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <osg/Drawable>
+#include <osg/Image>
+#include <osg/Node>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+#include <osg/Version>
+
+#include <osgDB/ObjectWrapper>
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/sceneutil/serialize.hpp>
+#include <components/vfs/manager.hpp>
+
+namespace Resource
+{
+    namespace
+    {
+        // Increase when NifOsg::Loader output changes in a way not covered by the loader settings below
+        constexpr int formatVersion = 1;
+
+        // Newer formats may refer to material files, content of which would need to be a part of the key
+        constexpr std::string_view supportedHeader = "NetImmerse File Format, Version 4.0.0.2";
+
+        bool isSupportedClass(const osg::Object& object)
+        {
+            const std::string_view library = object.libraryName();
+            std::string name(library);
+            name += "::";
+            name += object.className();
+            if (library == "NifOsg")
+            {
+                // Other NifOsg classes are controllers and particles, these have no serializers
+                if (name != "NifOsg::MatrixTransform" && name != "NifOsg::Fog")
+                    return false;
+            }
+            else if (library != "osg")
+                return false;
+            return osgDB::Registry::instance()->getObjectWrapperManager()->findWrapper(name) != nullptr;
+        }
+
+        bool hasSupportedUserData(const osg::Object& object)
+        {
+            const osg::UserDataContainer* const container = object.getUserDataContainer();
+            if (container == nullptr)
+                return true;
+            if (!isSupportedClass(*container) || container->getUserData() != nullptr)
+                return false;
+            for (unsigned i = 0; i < container->getNumUserObjects(); ++i)
+                if (const osg::Object* const userObject = container->getUserObject(i);
+                    userObject != nullptr && !isSupportedClass(*userObject))
+                    return false;
+            return true;
+        }
+
+        bool isRestorable(const osg::StateAttribute& attribute)
+        {
+            if (!isSupportedClass(attribute) || attribute.getUpdateCallback() != nullptr
+                || attribute.getEventCallback() != nullptr || !hasSupportedUserData(attribute))
+                return false;
+            if (const osg::Texture* const texture = attribute.asTexture())
+            {
+                // Images are read back through ImageManager by path, embedded ones have none
+                for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                    if (const osg::Image* const image = texture->getImage(i);
+                        image != nullptr && (image->getFileName().empty() || !isSupportedClass(*image)))
+                        return false;
+            }
+            return true;
+        }
+
+        bool isRestorable(const osg::StateSet::AttributeList& attributes)
+        {
+            for (const auto& [type, attribute] : attributes)
+                if (!isRestorable(*attribute.first))
+                    return false;
+            return true;
+        }
+
+        bool isRestorable(const osg::StateSet* stateSet)
+        {
+            if (stateSet == nullptr)
+                return true;
+            if (!isSupportedClass(*stateSet) || stateSet->getUpdateCallback() != nullptr
+                || stateSet->getEventCallback() != nullptr || !hasSupportedUserData(*stateSet))
+                return false;
+            if (!isRestorable(stateSet->getAttributeList()))
+                return false;
+            for (const osg::StateSet::AttributeList& attributes : stateSet->getTextureAttributeList())
+                if (!isRestorable(attributes))
+                    return false;
+            for (const auto& [name, uniform] : stateSet->getUniformList())
+                if (!isSupportedClass(*uniform.first) || uniform.first->getUpdateCallback() != nullptr
+                    || uniform.first->getEventCallback() != nullptr)
+                    return false;
+            return true;
+        }
+
+        class CheckRestorableVisitor : public osg::NodeVisitor
+        {
+        public:
+            CheckRestorableVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            bool isRestorable() const { return mRestorable; }
+
+            void apply(osg::Node& node) override
+            {
+                if (!mRestorable)
+                    return;
+                mRestorable = isNodeRestorable(node);
+                if (mRestorable)
+                    traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                if (!mRestorable)
+                    return;
+                mRestorable = drawable.getDrawCallback() == nullptr
+                    && drawable.getComputeBoundingBoxCallback() == nullptr && isNodeRestorable(drawable);
+            }
+
+        private:
+            bool mRestorable = true;
+
+            static bool isNodeRestorable(const osg::Node& node)
+            {
+                return isSupportedClass(node) && node.getUpdateCallback() == nullptr
+                    && node.getEventCallback() == nullptr && node.getCullCallback() == nullptr
+                    && node.getComputeBoundingSphereCallback() == nullptr && hasSupportedUserData(node)
+                    && Resource::isRestorable(node.getStateSet());
+            }
+        };
+
+        std::string toHex(const std::array<std::uint64_t, 2>& hash)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (const std::uint64_t value : hash)
+                stream << std::setw(16) << value;
+            return stream.str();
+        }
+    }
+
+    CompiledSceneCache::CompiledSceneCache(
+        const VFS::Manager& vfs, std::filesystem::path directory, osg::ref_ptr<osgDB::ReadFileCallback> readImage)
+        : mVFS(vfs)
+        , mDirectory(std::move(directory))
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("osgb"))
+        , mReadOptions(new osgDB::Options)
+        // Refer to images by path instead of embedding them, they are read through ImageManager
+        , mWriteOptions(new osgDB::Options("WriteImageHint=UseExternal"))
+    {
+        SceneUtil::registerNodeSerializers();
+        mReadOptions->setReadFileCallback(readImage);
+        if (mReaderWriter == nullptr)
+            Log(Debug::Warning) << "No readerwriter for 'osgb' found, converted models will not be cached";
+    }
+
+    CompiledSceneCache::~CompiledSceneCache() = default;
+
+    std::optional<std::string> CompiledSceneCache::makeKey(VFS::Path::NormalizedView path) const
+    {
+        if (mReaderWriter == nullptr)
+            return std::nullopt;
+
+        const Files::IStreamPtr file = mVFS.get(path);
+        std::string header(supportedHeader.size(), '\0');
+        if (!file->read(header.data(), static_cast<std::streamsize>(header.size())) || header != supportedHeader)
+            return std::nullopt;
+        file->seekg(0);
+
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << osgGetVersion() << ' ' << path.value() << ' '
+                   << toHex(Files::getHash(path.value(), *file)) << ' ' << NifOsg::Loader::getShowMarkers() << ' '
+                   << NifOsg::Loader::getHiddenNodeMask() << ' ' << NifOsg::Loader::getIntersectionDisabledNodeMask()
+                   << ' ' << NifOsg::Loader::getSoftEffectEnabled();
+
+        std::istringstream stream(descriptor.str());
+        return toHex(Files::getHash(path.value(), stream));
+    }
+
+    osg::ref_ptr<osg::Node> CompiledSceneCache::read(const std::string& key) const
+    {
+        if (mReaderWriter == nullptr)
+            return nullptr;
+
+        const std::filesystem::path path = getFilePath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        try
+        {
+            const osgDB::ReaderWriter::ReadResult result = mReaderWriter->readNode(stream, mReadOptions);
+            if (result.success() && result.getNode() != nullptr)
+                return result.getNode();
+            Log(Debug::Warning) << "Failed to read compiled scene " << path << ": " << result.message();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read compiled scene " << path << ": " << e.what();
+        }
+        return nullptr;
+    }
+
+    void CompiledSceneCache::write(const std::string& key, osg::Node& node) const
+    {
+        // Geometries would be written without data
+        if (mReaderWriter == nullptr || !SceneUtil::isGeometryDataSerialized())
+            return;
+
+        CheckRestorableVisitor visitor;
+        node.accept(visitor);
+        if (!visitor.isRestorable())
+            return;
+
+        const std::filesystem::path path = getFilePath(key);
+        // Write to a temporary file first so other threads and processes never read a partially written scene
+        std::filesystem::path temporary = path;
+        temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mDirectory);
+
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                const osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeNode(node, stream, mWriteOptions);
+                if (!result.success())
+                    throw std::runtime_error(result.message());
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+
+            std::filesystem::rename(temporary, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write compiled scene " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
+    std::filesystem::path CompiledSceneCache::getFilePath(const std::string& key) const
+    {
+        return mDirectory / Files::pathFromUnicodeString(key + ".osgb");
+    }
+}
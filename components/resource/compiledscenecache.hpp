@@ -0,0 +1,67 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_COMPILEDSCENECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_COMPILEDSCENECACHE_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <osg/ref_ptr>
+
+#include <components/vfs/pathutil.hpp>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class Options;
+    class ReadFileCallback;
+    class ReaderWriter;
+}
+
+namespace VFS
+{
+    class Manager;
+}
+
+namespace Resource
+{
+    /// @brief Scene graphs converted from NIF files kept on disk between runs.
+    /// @par Graphs are stored in the OSG binary format and keyed by the source file content and the loader settings
+    /// affecting the conversion. Only graphs that can be restored exactly are stored: made of plain OSG classes and
+    /// transforms, without callbacks and with textures referring to images from the VFS by path. Anything else, like
+    /// animated meshes and particles, is converted on every load.
+    /// @note Texture paths are stored as they were resolved on conversion, so replacing a texture by one with another
+    /// extension requires clearing the cache directory.
+    class CompiledSceneCache
+    {
+    public:
+        /// @param readImage used to load images referenced by cached graphs
+        explicit CompiledSceneCache(
+            const VFS::Manager& vfs, std::filesystem::path directory, osg::ref_ptr<osgDB::ReadFileCallback> readImage);
+
+        ~CompiledSceneCache();
+
+        /// @return Key of the file, nullopt when files of its format are not cached.
+        std::optional<std::string> makeKey(VFS::Path::NormalizedView path) const;
+
+        /// @return Cached graph, nullptr if there is none or it can't be read.
+        osg::ref_ptr<osg::Node> read(const std::string& key) const;
+
+        /// Store the graph if it can be restored exactly, failures are only logged.
+        void write(const std::string& key, osg::Node& node) const;
+
+    private:
+        const VFS::Manager& mVFS;
+        std::filesystem::path mDirectory;
+        osgDB::ReaderWriter* mReaderWriter;
+        osg::ref_ptr<osgDB::Options> mReadOptions;
+        osg::ref_ptr<osgDB::Options> mWriteOptions;
+
+        std::filesystem::path getFilePath(const std::string& key) const;
+    };
+}
+
+#endif
@@ -11,11 +11,14 @@
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/bulletshapemanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <functional>
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -83,38 +86,84 @@ namespace Resource
             return result;
         }
 
-        template <class F>
-        void forEachObject(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
-            Resource::BulletShapeManager& bulletShapeManager, ESM::ReadersCache& readers, F&& f)
+        constexpr VFS::Path::NormalizedView meshesPrefix("meshes");
+
+        struct CellObjects
         {
-            std::vector<CellRef> cellRefs = loadCellRefs(cell, esmData, readers);
+            std::vector<CellRef> mCellRefs;
+            // Paths of the models, empty when the cell ref has none
+            std::vector<VFS::Path::Normalized> mModels;
+        };
 
-            Log(Debug::Debug) << "Prepared " << cellRefs.size() << " unique cell refs";
+        CellObjects loadCellObjects(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
+            ESM::ReadersCache& readers)
+        {
+            CellObjects result;
+            result.mCellRefs = loadCellRefs(cell, esmData, readers);
+            result.mModels.reserve(result.mCellRefs.size());
 
-            for (CellRef& cellRef : cellRefs)
+            for (CellRef& cellRef : result.mCellRefs)
             {
                 VFS::Path::Normalized model(getModel(esmData, cellRef.mRefId, cellRef.mType));
+                if (!model.empty())
+                {
+                    if (cellRef.mType != ESM::REC_STAT)
+                        model = Misc::ResourceHelpers::correctActorModelPath(model, &vfs);
+                    model = meshesPrefix / model;
+                }
+                result.mModels.push_back(std::move(model));
+            }
+
+            return result;
+        }
+
+        using Shapes = std::map<VFS::Path::Normalized, osg::ref_ptr<const Resource::BulletShape>, std::less<>>;
+
+        // Shapes of different models don't depend on each other and most of the time goes into loading them
+        Shapes loadShapes(const std::vector<CellObjects>& cells, Resource::BulletShapeManager& bulletShapeManager,
+            std::size_t threadsNumber)
+        {
+            std::vector<VFS::Path::Normalized> models;
+            for (const CellObjects& cell : cells)
+                for (const VFS::Path::Normalized& model : cell.mModels)
+                    if (!model.empty())
+                        models.push_back(model);
+            std::sort(models.begin(), models.end());
+            models.erase(std::unique(models.begin(), models.end()), models.end());
+
+            Log(Debug::Info) << "Loading " << models.size() << " models using " << threadsNumber << " threads...";
+
+            std::vector<osg::ref_ptr<const Resource::BulletShape>> shapes(models.size());
+            SceneUtil::WorkQueue workQueue(threadsNumber - 1);
+            SceneUtil::parallelFor(workQueue, models.size(), threadsNumber - 1, [&](std::size_t i) {
+                try
+                {
+                    shapes[i] = bulletShapeManager.getShape(models[i]);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to load model \"" << models[i] << "\": " << e.what();
+                }
+            });
+
+            Shapes result;
+            for (std::size_t i = 0; i < models.size(); ++i)
+                result.emplace_hint(result.end(), std::move(models[i]), std::move(shapes[i]));
+            return result;
+        }
+
+        template <class F>
+        void forEachObject(const CellObjects& cell, const Shapes& shapes, F&& f)
+        {
+            for (std::size_t i = 0; i < cell.mCellRefs.size(); ++i)
+            {
+                const CellRef& cellRef = cell.mCellRefs[i];
+                const VFS::Path::Normalized& model = cell.mModels[i];
                 if (model.empty())
                     continue;
 
-                if (cellRef.mType != ESM::REC_STAT)
-                    model = Misc::ResourceHelpers::correctActorModelPath(model, &vfs);
-
-                osg::ref_ptr<const Resource::BulletShape> shape = [&] {
-                    try
-                    {
-                        constexpr VFS::Path::NormalizedView prefix("meshes");
-                        return bulletShapeManager.getShape(prefix / model);
-                    }
-                    catch (const std::exception& e)
-                    {
-                        Log(Debug::Warning) << "Failed to load cell ref \"" << cellRef.mRefId << "\" model \"" << model
-                                            << "\": " << e.what();
-                        return osg::ref_ptr<const Resource::BulletShape>();
-                    }
-                }();
-
-                if (shape == nullptr)
+                const auto shape = shapes.find(model);
+                if (shape == shapes.end() || shape->second == nullptr)
                     continue;
 
                 switch (cellRef.mType)
@@ -123,7 +172,7 @@ namespace Resource
                     case ESM::REC_CONT:
                     case ESM::REC_DOOR:
                     case ESM::REC_STAT:
-                        f(BulletObject{ std::move(shape), cellRef.mPos, cellRef.mScale });
+                        f(BulletObject{ shape->second, cellRef.mPos, cellRef.mScale });
                         break;
                     default:
                         break;
@@ -133,9 +182,18 @@ namespace Resource
     }
 
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
-        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData, std::size_t threadsNumber,
         std::function<void(const ESM::Cell& cell, const BulletObject& object)> callback)
     {
+        Log(Debug::Info) << "Loading cell refs of " << esmData.mCells.size() << " cells...";
+
+        std::vector<CellObjects> cells;
+        cells.reserve(esmData.mCells.size());
+        for (const ESM::Cell& cell : esmData.mCells)
+            cells.push_back(loadCellObjects(cell, esmData, vfs, readers));
+
+        const auto shapes = loadShapes(cells, bulletShapeManager, threadsNumber);
+
         Log(Debug::Info) << "Processing " << esmData.mCells.size() << " cells...";
 
         for (std::size_t i = 0; i < esmData.mCells.size(); ++i)
@@ -148,7 +206,7 @@ namespace Resource
 
             std::size_t objects = 0;
 
-            forEachObject(cell, esmData, vfs, bulletShapeManager, readers, [&](const BulletObject& object) {
+            forEachObject(cells[i], shapes, [&](const BulletObject& object) {
                 callback(cell, object);
                 ++objects;
             });
@@ -6,6 +6,7 @@
 
 #include <osg/ref_ptr>
 
+#include <cstddef>
 #include <functional>
 #include <vector>
 
@@ -39,8 +40,9 @@ namespace Resource
         float mScale;
     };
 
+    /// Shapes of all objects are loaded before the callback is called, using up to threadsNumber threads.
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
-        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData, std::size_t threadsNumber,
         std::function<void(const ESM::Cell&, const BulletObject& object)> callback);
 }
 
@@ -1,6 +1,9 @@
 #include "imagemanager.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <osgDB/Registry>
 
 #include <components/debug/debuglog.hpp>
@@ -10,6 +13,7 @@
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
+#include "texturecompressioncache.hpp"
 
 #ifdef OSG_LIBRARY_STATIC
 // This list of plugins should match with the list in the top-level CMakelists.txt.
@@ -42,6 +46,37 @@ namespace
         return warningImage;
     }
 
+    /// Make the image start with the largest mipmap level that fits the size, mipmaps are kept in a single block
+    /// after the base level so the levels to keep are moved to a new block.
+    void dropLargeMipmapLevels(osg::Image& image, int maxSize)
+    {
+        if (maxSize <= 0 || image.r() != 1 || !image.isMipmap() || !image.isDataContiguous()
+            || std::max(image.s(), image.t()) <= maxSize)
+            return;
+
+        unsigned level = 0;
+        while (level + 1 < image.getNumMipmapLevels() && std::max(image.s() >> level, image.t() >> level) > maxSize)
+            ++level;
+        if (level == 0)
+            return;
+
+        const unsigned offset = image.getMipmapOffset(level);
+        const unsigned size = image.getTotalSizeInBytesIncludingMipmaps() - offset;
+        unsigned char* const data = new unsigned char[size];
+        std::memcpy(data, image.data() + offset, size);
+
+        osg::Image::MipmapDataType mipmaps;
+        for (unsigned i = level + 1; i < image.getNumMipmapLevels(); ++i)
+            mipmaps.push_back(image.getMipmapOffset(i) - offset);
+
+        const osg::Image::Origin origin = image.getOrigin();
+        image.setImage(std::max(image.s() >> level, 1), std::max(image.t() >> level, 1), 1,
+            image.getInternalTextureFormat(), image.getPixelFormat(), image.getDataType(), data,
+            osg::Image::USE_NEW_DELETE, image.getPacking());
+        image.setMipmapLevels(mipmaps);
+        image.setOrigin(origin);
+    }
+
 }
 
 namespace Resource
@@ -57,6 +92,22 @@ namespace Resource
 
     ImageManager::~ImageManager() {}
 
+    void ImageManager::setTextureCompressionCacheDirectory(
+        const std::filesystem::path& directory, SceneUtil::WorkQueue* workQueue)
+    {
+        mTextureCompressionCache = std::make_unique<TextureCompressionCache>(directory, workQueue);
+    }
+
+    bool isS3TCSupported()
+    {
+        if (!SceneUtil::glExtensionsReady())
+            return true; // hashtag yolo (CS might not have context when loading assets)
+        osg::GLExtensions& exts = SceneUtil::getGLExtensions();
+        // This one works too. Should it be included in isTextureCompressionS3TCSupported()? Submitted as a patch to
+        // OSG.
+        return exts.isTextureCompressionS3TCSupported || osg::isGLExtensionSupported(exts.contextID, "GL_S3_s3tc");
+    }
+
     bool checkSupported(osg::Image* image)
     {
         switch (image->getPixelFormat())
@@ -66,16 +117,8 @@ namespace Resource
             case (GL_COMPRESSED_RGBA_S3TC_DXT3_EXT):
             case (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT):
             {
-                if (!SceneUtil::glExtensionsReady())
-                    return true; // hashtag yolo (CS might not have context when loading assets)
-                osg::GLExtensions& exts = SceneUtil::getGLExtensions();
-                if (!exts.isTextureCompressionS3TCSupported
-                    // This one works too. Should it be included in isTextureCompressionS3TCSupported()? Submitted as a
-                    // patch to OSG.
-                    && !osg::isGLExtensionSupported(exts.contextID, "GL_S3_s3tc"))
-                {
+                if (!isS3TCSupported())
                     return false;
-                }
                 break;
             }
             // not bothering with checks for other compression formats right now
@@ -92,6 +135,7 @@ namespace Resource
             return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
         else
         {
+            const auto start = std::chrono::steady_clock::now();
             Files::IStreamPtr stream;
             try
             {
@@ -104,6 +148,24 @@ namespace Resource
                 return mWarningImage;
             }
 
+            const int maxTextureSize = mMaxTextureSize;
+            std::string compressionKey;
+            if (mTextureCompressionCache != nullptr)
+            {
+                compressionKey = mTextureCompressionCache->makeKey(path, *stream, !disableFlip, maxTextureSize);
+                if (osg::ref_ptr<osg::Image> image = mTextureCompressionCache->read(compressionKey);
+                    image != nullptr && checkSupported(image))
+                {
+                    image->setFileName(std::string(path.value()));
+                    const CacheEntryCost cost{
+                        .mSize = image->getTotalSizeInBytesIncludingMipmaps(),
+                        .mLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                    };
+                    mCache->addEntryToObjectCache(path.value(), image, cost);
+                    return image;
+                }
+            }
+
             const std::string ext(Misc::getFileExtension(path.value()));
             osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
             if (!reader)
@@ -186,7 +248,18 @@ namespace Resource
                 image = newImage;
             }
 
-            mCache->addEntryToObjectCache(path.value(), image);
+            dropLargeMipmapLevels(*image, maxTextureSize);
+
+            // Nothing is compressed without knowing the graphics card can use it
+            if (!compressionKey.empty() && SceneUtil::glExtensionsReady() && isS3TCSupported())
+                mTextureCompressionCache->add(compressionKey, image);
+
+            const CacheEntryCost cost{
+                .mSize = image->getTotalSizeInBytesIncludingMipmaps(),
+                .mLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+            };
+
+            mCache->addEntryToObjectCache(path.value(), image, cost);
             return image;
         }
     }
@@ -201,4 +274,11 @@ namespace Resource
         Resource::reportStats("Image", frameNumber, mCache->getStats(), *stats);
     }
 
+    MemoryUsage ImageManager::getMemoryUsage() const
+    {
+        // Cached images are also uploaded as textures with the same size
+        const std::size_t size = mCache->getStats().mMemory;
+        return MemoryUsage{ .mCpu = size, .mGpu = size };
+    }
+
 }
@@ -1,6 +1,10 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 #define OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 
+#include <atomic>
+#include <filesystem>
+#include <memory>
+
 #include <osg/Image>
 #include <osg/Texture2D>
 #include <osg/ref_ptr>
@@ -14,8 +18,14 @@ namespace osgDB
     class Options;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
+    class TextureCompressionCache;
 
     /// @brief Handles loading/caching of Images.
     /// @note May be used from any thread.
@@ -31,12 +41,25 @@ namespace Resource
 
         osg::Image* getWarningImage();
 
+        /// Skip mipmap levels with width or height above the limit when loading images with precomputed mipmaps.
+        /// Zero means no limit. Only affects images loaded afterwards.
+        void setMaxTextureSize(int size) { mMaxTextureSize = size; }
+
+        /// Compress uncompressed images from the textures directory to DXT on the work queue and keep them in the
+        /// directory, so later loads use the compressed version. Only affects images loaded afterwards.
+        void setTextureCompressionCacheDirectory(
+            const std::filesystem::path& directory, SceneUtil::WorkQueue* workQueue);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        MemoryUsage getMemoryUsage() const override;
+
     private:
         osg::ref_ptr<osg::Image> mWarningImage;
         osg::ref_ptr<osgDB::Options> mOptions;
         osg::ref_ptr<osgDB::Options> mOptionsNoFlip;
+        std::atomic_int mMaxTextureSize = 0;
+        std::unique_ptr<TextureCompressionCache> mTextureCompressionCache;
 
         ImageManager(const ImageManager&);
         void operator=(const ImageManager&);
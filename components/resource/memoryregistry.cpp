@@ -0,0 +1,104 @@
+#include "memoryregistry.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+#include <osg/Stats>
+
+namespace Resource
+{
+    namespace
+    {
+        std::string makeAttribute(std::string_view name, std::string_view suffix)
+        {
+            std::string result;
+            result.reserve(7 + name.size() + 1 + suffix.size());
+            result += "Memory ";
+            result += name;
+            result += ' ';
+            result += suffix;
+            return result;
+        }
+
+        MemoryUsage getTotal(const MemoryRegistry::Subsystems& subsystems)
+        {
+            MemoryUsage result;
+            for (const auto& [name, usage] : subsystems)
+                result += usage;
+            return result;
+        }
+
+        double toMegabytes(std::size_t value)
+        {
+            return static_cast<double>(value) / (1024 * 1024);
+        }
+    }
+
+    void MemoryRegistry::add(std::string_view name, std::function<MemoryUsage()> getUsage)
+    {
+        mGetUsage.insert_or_assign(std::string(name), std::move(getUsage));
+    }
+
+    void MemoryRegistry::remove(std::string_view name)
+    {
+        if (const auto it = mGetUsage.find(name); it != mGetUsage.end())
+            mGetUsage.erase(it);
+        const std::lock_guard lock(mMutex);
+        std::erase_if(mSubsystems, [&](const auto& v) { return v.first == name; });
+    }
+
+    void MemoryRegistry::update()
+    {
+        Subsystems subsystems;
+        subsystems.reserve(mGetUsage.size());
+        for (const auto& [name, getUsage] : mGetUsage)
+            subsystems.emplace_back(name, getUsage());
+        const std::lock_guard lock(mMutex);
+        mSubsystems = std::move(subsystems);
+    }
+
+    MemoryRegistry::Subsystems MemoryRegistry::getSubsystems() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mSubsystems;
+    }
+
+    MemoryUsage MemoryRegistry::getTotal() const
+    {
+        const std::lock_guard lock(mMutex);
+        return Resource::getTotal(mSubsystems);
+    }
+
+    void MemoryRegistry::reportStats(unsigned frameNumber, osg::Stats& stats) const
+    {
+        const std::lock_guard lock(mMutex);
+        for (const auto& [name, usage] : mSubsystems)
+        {
+            stats.setAttribute(frameNumber, makeAttribute(name, "CPU"), static_cast<double>(usage.mCpu));
+            stats.setAttribute(frameNumber, makeAttribute(name, "GPU"), static_cast<double>(usage.mGpu));
+        }
+        const MemoryUsage total = Resource::getTotal(mSubsystems);
+        stats.setAttribute(frameNumber, makeAttribute("Total", "CPU"), static_cast<double>(total.mCpu));
+        stats.setAttribute(frameNumber, makeAttribute("Total", "GPU"), static_cast<double>(total.mGpu));
+    }
+
+    void addMemoryStatsAttributes(std::string_view name, std::vector<std::string>& out)
+    {
+        out.push_back(makeAttribute(name, "CPU"));
+        out.push_back(makeAttribute(name, "GPU"));
+    }
+
+    std::string formatMemoryUsage(const MemoryRegistry::Subsystems& subsystems)
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(1);
+        const auto write = [&](std::string_view name, const MemoryUsage& usage) {
+            stream << name << ": " << toMegabytes(usage.mCpu) << " MB CPU, " << toMegabytes(usage.mGpu)
+                   << " MB GPU\n";
+        };
+        for (const auto& [name, usage] : subsystems)
+            write(name, usage);
+        write("Total", getTotal(subsystems));
+        return stream.str();
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_MEMORYREGISTRY_H
+#define OPENMW_COMPONENTS_RESOURCE_MEMORYREGISTRY_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace Resource
+{
+    /// Estimated memory in bytes.
+    struct MemoryUsage
+    {
+        std::size_t mCpu = 0;
+        std::size_t mGpu = 0;
+
+        MemoryUsage& operator+=(const MemoryUsage& other)
+        {
+            mCpu += other.mCpu;
+            mGpu += other.mGpu;
+            return *this;
+        }
+    };
+
+    /// @brief Collects the memory used by each subsystem under a common name.
+    /// @par Subsystems add a function returning their current usage and remove it before they are destroyed. The
+    /// functions are called by update() once per frame, so the last collected values can be read from any thread.
+    class MemoryRegistry
+    {
+    public:
+        using Subsystems = std::vector<std::pair<std::string, MemoryUsage>>;
+
+        /// @note Must be called from the main thread.
+        void add(std::string_view name, std::function<MemoryUsage()> getUsage);
+
+        /// @note Must be called from the main thread.
+        void remove(std::string_view name);
+
+        /// Call the functions of all subsystems to refresh the collected values.
+        /// @note Must be called from the main thread.
+        void update();
+
+        /// @return The values collected by the last update() sorted by subsystem name.
+        /// @note May be called from any thread.
+        Subsystems getSubsystems() const;
+
+        MemoryUsage getTotal() const;
+
+        void reportStats(unsigned frameNumber, osg::Stats& stats) const;
+
+    private:
+        std::map<std::string, std::function<MemoryUsage()>, std::less<>> mGetUsage;
+        mutable std::mutex mMutex;
+        Subsystems mSubsystems;
+    };
+
+    void addMemoryStatsAttributes(std::string_view name, std::vector<std::string>& out);
+
+    /// Write a line with CPU and GPU memory in megabytes for each subsystem and the total.
+    std::string formatMemoryUsage(const MemoryRegistry::Subsystems& subsystems);
+}
+
+#endif
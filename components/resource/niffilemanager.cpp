@@ -1,9 +1,12 @@
 #include "niffilemanager.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 #include <osg/Object>
 
+#include <components/files/utils.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "objectcache.hpp"
@@ -46,11 +49,19 @@ namespace Resource
         if (obj != nullptr)
             return static_cast<NifFileHolder*>(obj.get())->mNifFile;
 
+        const auto start = std::chrono::steady_clock::now();
         auto file = std::make_shared<Nif::NIFFile>(name);
         Nif::Reader reader(*file, mEncoder);
-        reader.parse(mVFS->get(name));
+        Files::IStreamPtr stream = mVFS->get(name);
+        // Parsed records take about as much memory as the file they come from
+        const std::streamsize fileSize = Files::getStreamSizeLeft(*stream);
+        reader.parse(std::move(stream));
         obj = new NifFileHolder(file);
-        mCache->addEntryToObjectCache(name.value(), obj);
+        const CacheEntryCost cost{
+            .mSize = static_cast<std::size_t>(std::max<std::streamsize>(fileSize, 0)),
+            .mLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+        };
+        mCache->addEntryToObjectCache(name.value(), obj, cost);
         return file;
     }
 
@@ -3,6 +3,8 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - optional size bound with eviction weighted by reload cost.
+// - items are split into shards with separate locks, lookups take shared locks.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -27,10 +29,16 @@
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace osg
@@ -43,15 +51,45 @@ namespace osg
 
 namespace Resource
 {
+    /// Estimate of what keeping a cache entry is worth, used when the cache is size bounded.
+    struct CacheEntryCost
+    {
+        /// Memory in bytes freed by removing the entry.
+        std::size_t mSize = 0;
+        /// Time in seconds it took to load the object.
+        double mLoadTime = 0;
+    };
+
     struct GenericObjectCacheItem
     {
         osg::ref_ptr<osg::Object> mValue;
         double mLastUsage;
+        CacheEntryCost mCost;
     };
 
+    namespace ObjectCacheDetails
+    {
+        inline std::string_view getKeyString(const auto& key)
+        {
+            if constexpr (requires { std::string_view(key.value()); })
+                return key.value();
+            else
+                return std::string_view(key);
+        }
+    }
+
+    /// Caches holding objects by string-like paths are accessed from loading threads and the main thread at the same
+    /// time, so they are split into independently locked shards. Other key types need the global order for
+    /// lowerBound to be cheap and are kept in a single shard.
     template <typename KeyType>
+    inline constexpr std::size_t defaultObjectCacheShardCount
+        = std::is_convertible_v<const KeyType&, std::string_view> ? 16 : 1;
+
+    template <typename KeyType, std::size_t shardCount = defaultObjectCacheShardCount<KeyType>>
     class GenericObjectCache : public osg::Referenced
     {
+        static_assert(shardCount > 0);
+
     public:
         /*
          * @brief Updates usage timestamps and removes expired items
@@ -70,11 +108,14 @@ namespace Resource
         void update(double referenceTime, double expiryDelay)
         {
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            const double expiryTime = referenceTime - expiryDelay;
+            std::size_t totalSize = 0;
+
+            for (Shard& shard : mShards)
             {
-                const double expiryTime = referenceTime - expiryDelay;
-                std::lock_guard<std::mutex> lock(mMutex);
+                const std::lock_guard lock(shard.mMutex);
 
-                std::erase_if(mItems, [&](auto& v) {
+                std::erase_if(shard.mItems, [&](auto& v) {
                     Item& item = v.second;
 
                     // update last usage timestamp if item is being referenced externally
@@ -86,7 +127,8 @@ namespace Resource
                     if (item.mLastUsage > expiryTime)
                         return false;
 
-                    ++mExpired;
+                    ++shard.mExpired;
+                    shard.mTotalSize -= item.mCost.mSize;
 
                     // just mark for removal here so objects can be removed in bulk outside the lock
                     if (item.mValue != nullptr)
@@ -94,7 +136,14 @@ namespace Resource
 
                     return true;
                 });
+
+                totalSize += shard.mTotalSize;
             }
+
+            const std::size_t maxSize = mMaxSize.load(std::memory_order_relaxed);
+            if (maxSize != 0 && totalSize > maxSize)
+                evict(maxSize, objectsToRemove);
+
             // remove expired items from cache
             objectsToRemove.clear();
         }
@@ -102,44 +151,70 @@ namespace Resource
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mItems.clear();
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard lock(shard.mMutex);
+                shard.mItems.clear();
+                shard.mTotalSize = 0;
+            }
         }
 
+        /** Limit total size of cached objects, items not referenced elsewhere are evicted by update() to fit it.
+         * Zero means no limit.*/
+        void setMaxSize(std::size_t maxSize) { mMaxSize.store(maxSize, std::memory_order_relaxed); }
+
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         template <class K>
         void addEntryToObjectCache(K&& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
-                mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp });
+            addEntryToObjectCache(std::forward<K>(key), object, CacheEntryCost{}, timestamp);
+        }
+
+        /** Add an object with the estimated cost of keeping it, used when the cache is size bounded.*/
+        template <class K>
+        void addEntryToObjectCache(K&& key, osg::Object* object, const CacheEntryCost& cost, double timestamp = 0.0)
+        {
+            Shard& shard = getShard(key);
+            const std::lock_guard lock(shard.mMutex);
+            const auto it = shard.mItems.find(key);
+            shard.mTotalSize += cost.mSize;
+            if (it == shard.mItems.end())
+                shard.mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp, cost });
             else
-                it->second = Item{ object, timestamp };
+            {
+                shard.mTotalSize -= it->second.mCost.mSize;
+                it->second = Item{ object, timestamp, cost };
+            }
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto itr = mItems.find(key);
-            if (itr != mItems.end())
-                mItems.erase(itr);
+            Shard& shard = getShard(key);
+            const std::lock_guard lock(shard.mMutex);
+            const auto itr = shard.mItems.find(key);
+            if (itr != shard.mItems.end())
+            {
+                shard.mTotalSize -= itr->second.mCost.mSize;
+                shard.mItems.erase(itr);
+            }
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            const Shard& shard = getShard(key);
+            const std::shared_lock lock(shard.mMutex);
+            if (const Item* const item = find(shard, key))
                 return item->mValue;
             return nullptr;
         }
 
         std::optional<osg::ref_ptr<osg::Object>> getRefFromObjectCacheOrNone(const auto& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            const Shard& shard = getShard(key);
+            const std::shared_lock lock(shard.mMutex);
+            if (const Item* const item = find(shard, key))
                 return item->mValue;
             return std::nullopt;
         }
@@ -147,8 +222,9 @@ namespace Resource
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const auto& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            const std::lock_guard lock(shard.mMutex);
+            if (Item* const item = find(shard, key))
             {
                 item->mLastUsage = timeStamp;
                 return true;
@@ -159,67 +235,161 @@ namespace Resource
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                v.mValue->releaseGLObjects(state);
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    v.mValue->releaseGLObjects(state);
+            }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                if (osg::Object* const object = v.mValue.get())
-                    if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
-                        node->accept(nv);
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    if (osg::Object* const object = v.mValue.get())
+                        if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
+                            node->accept(nv);
+            }
         }
 
-        /** call operator()(KeyType, osg::Object*) for each object in the cache. */
+        /** call operator()(KeyType, osg::Object*) for each object in the cache.
+         * Objects are visited in key order only within a shard. */
         template <class Functor>
         void call(Functor&& f)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                f(k, v.mValue.get());
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    f(k, v.mValue.get());
+            }
         }
 
         template <class K>
         std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> lowerBound(K&& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.lower_bound(std::forward<K>(key));
-            if (it == mItems.end())
-                return std::nullopt;
-            return std::pair(it->first, it->second.mValue);
+            std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> result;
+            for (const Shard& shard : mShards)
+            {
+                const std::shared_lock lock(shard.mMutex);
+                const auto it = shard.mItems.lower_bound(key);
+                if (it != shard.mItems.end() && (!result.has_value() || it->first < result->first))
+                    result.emplace(it->first, it->second.mValue);
+            }
+            return result;
         }
 
         CacheStats getStats() const
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            return CacheStats{
-                .mSize = mItems.size(),
-                .mGet = mGet,
-                .mHit = mHit,
-                .mExpired = mExpired,
-            };
+            CacheStats result;
+            for (const Shard& shard : mShards)
+            {
+                const std::shared_lock lock(shard.mMutex);
+                result.mSize += shard.mItems.size();
+                result.mMemory += shard.mTotalSize;
+                result.mGet += shard.mGet.load(std::memory_order_relaxed);
+                result.mHit += shard.mHit.load(std::memory_order_relaxed);
+                result.mExpired += shard.mExpired;
+                result.mEvicted += shard.mEvicted;
+            }
+            return result;
         }
 
     protected:
         using Item = GenericObjectCacheItem;
 
-        std::map<KeyType, Item, std::less<>> mItems;
-        mutable std::mutex mMutex;
-        std::size_t mGet = 0;
-        std::size_t mHit = 0;
-        std::size_t mExpired = 0;
+        /// Seconds of recency one second of load time is worth when choosing what to evict, so objects that are slow
+        /// to load survive a bit longer than cheap ones used at the same time.
+        static constexpr double sLoadTimeWeight = 60;
+
+        /// Lookups only take a shared lock, so concurrent reads of a shard don't wait for each other. Counters
+        /// updated by them are atomic, everything else is modified under an exclusive lock.
+        struct Shard
+        {
+            std::map<KeyType, Item, std::less<>> mItems;
+            mutable std::shared_mutex mMutex;
+            mutable std::atomic<std::size_t> mGet = 0;
+            mutable std::atomic<std::size_t> mHit = 0;
+            std::size_t mExpired = 0;
+            std::size_t mEvicted = 0;
+            std::size_t mTotalSize = 0;
+        };
+
+        std::array<Shard, shardCount> mShards;
+        std::atomic<std::size_t> mMaxSize = 0;
+
+        Shard& getShard(const auto& key)
+        {
+            if constexpr (shardCount == 1)
+                return mShards.front();
+            else
+                return mShards[std::hash<std::string_view>{}(ObjectCacheDetails::getKeyString(key)) % shardCount];
+        }
+
+        /// Remove least valuable items not referenced elsewhere until the total size fits the limit.
+        void evict(std::size_t maxSize, std::vector<osg::ref_ptr<osg::Object>>& objectsToRemove)
+        {
+            using Iterator = typename decltype(Shard::mItems)::iterator;
+
+            // Priorities are compared across shards, so all of them are locked, always in the same order
+            std::array<std::unique_lock<std::shared_mutex>, shardCount> locks;
+            std::size_t totalSize = 0;
+            for (std::size_t i = 0; i < shardCount; ++i)
+            {
+                locks[i] = std::unique_lock(mShards[i].mMutex);
+                totalSize += mShards[i].mTotalSize;
+            }
+
+            struct Candidate
+            {
+                double mPriority;
+                Shard* mShard;
+                Iterator mIterator;
+            };
+
+            std::vector<Candidate> candidates;
+            for (Shard& shard : mShards)
+            {
+                for (auto it = shard.mItems.begin(); it != shard.mItems.end(); ++it)
+                {
+                    const Item& item = it->second;
+                    // Removing items used elsewhere frees nothing
+                    if (item.mCost.mSize == 0 || (item.mValue != nullptr && item.mValue->referenceCount() > 1))
+                        continue;
+                    candidates.push_back(
+                        Candidate{ item.mLastUsage + item.mCost.mLoadTime * sLoadTimeWeight, &shard, it });
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end(),
+                [](const Candidate& l, const Candidate& r) { return l.mPriority < r.mPriority; });
+
+            for (const Candidate& candidate : candidates)
+            {
+                if (totalSize <= maxSize)
+                    break;
+                Shard& shard = *candidate.mShard;
+                Item& item = candidate.mIterator->second;
+                ++shard.mEvicted;
+                shard.mTotalSize -= item.mCost.mSize;
+                totalSize -= item.mCost.mSize;
+                if (item.mValue != nullptr)
+                    objectsToRemove.push_back(std::move(item.mValue));
+                shard.mItems.erase(candidate.mIterator);
+            }
+        }
 
-        Item* find(const auto& key)
+        static auto find(auto& shard, const auto& key) -> decltype(&shard.mItems.begin()->second)
         {
-            ++mGet;
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
+            shard.mGet.fetch_add(1, std::memory_order_relaxed);
+            const auto it = shard.mItems.find(key);
+            if (it == shard.mItems.end())
                 return nullptr;
-            ++mHit;
+            shard.mHit.fetch_add(1, std::memory_order_relaxed);
             return &it->second;
         }
     };
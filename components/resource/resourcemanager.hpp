@@ -5,6 +5,7 @@
 
 #include <components/vfs/pathutil.hpp>
 
+#include "memoryregistry.hpp"
 #include "objectcache.hpp"
 
 namespace VFS
@@ -29,6 +30,7 @@ namespace Resource
         virtual void clearCache() = 0;
         virtual void setExpiryDelay(double expiryDelay) = 0;
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const = 0;
+        virtual MemoryUsage getMemoryUsage() const = 0;
         virtual void releaseGLObjects(osg::State* state) = 0;
     };
 
@@ -60,10 +62,16 @@ namespace Resource
         void setExpiryDelay(double expiryDelay) final { mExpiryDelay = expiryDelay; }
         double getExpiryDelay() const { return mExpiryDelay; }
 
+        /// Limit estimated memory used by cached objects in bytes, the least valuable ones are evicted by
+        /// updateCache() to fit it. Zero means no limit.
+        void setMaxCacheSize(std::size_t maxSize) { mCache->setMaxSize(maxSize); }
+
         const VFS::Manager* getVFS() const { return mVFS; }
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override {}
 
+        MemoryUsage getMemoryUsage() const override { return MemoryUsage{ .mCpu = mCache->getStats().mMemory }; }
+
         void releaseGLObjects(osg::State* state) override { mCache->releaseGLObjects(state); }
 
     protected:
@@ -31,6 +31,8 @@ namespace Resource
         addResourceManager(mSceneManager.get());
         addResourceManager(mImageManager.get());
         addResourceManager(mAnimBlendRulesManager.get());
+
+        mMemoryRegistry.add("Resource Caches", [this] { return getMemoryUsage(); });
     }
 
     ResourceSystem::~ResourceSystem()
@@ -120,6 +122,14 @@ namespace Resource
             (*it)->reportStats(frameNumber, stats);
     }
 
+    MemoryUsage ResourceSystem::getMemoryUsage() const
+    {
+        MemoryUsage result;
+        for (const BaseResourceManager* resourceManager : mResourceManagers)
+            result += resourceManager->getMemoryUsage();
+        return result;
+    }
+
     void ResourceSystem::releaseGLObjects(osg::State* state)
     {
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
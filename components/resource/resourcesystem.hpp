@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 
+#include "memoryregistry.hpp"
+
 namespace VFS
 {
     class Manager;
@@ -72,6 +74,12 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
+        /// Registry for all subsystems to publish their memory usage, includes the resource caches.
+        MemoryRegistry& getMemoryRegistry() { return mMemoryRegistry; }
+        const MemoryRegistry& getMemoryRegistry() const { return mMemoryRegistry; }
+
+        MemoryUsage getMemoryUsage() const;
+
         /// Call releaseGLObjects for each resource manager.
         void releaseGLObjects(osg::State* state);
 
@@ -89,6 +97,8 @@ namespace Resource
 
         const VFS::Manager* mVFS;
 
+        MemoryRegistry mMemoryRegistry;
+
         ResourceSystem(const ResourceSystem&);
         void operator=(const ResourceSystem&);
     };
@@ -1,11 +1,14 @@
 #include "scenemanager.hpp"
 
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
+#include <optional>
 
 #include <osg/AlphaFunc>
 #include <osg/Capability>
 #include <osg/ColorMaski>
+#include <osg/Geometry>
 #include <osg/Group>
 #include <osg/Node>
 #include <osg/UserDataContainer>
@@ -21,7 +24,6 @@
 
 #include <osgDB/FileUtils>
 #include <osgDB/Registry>
-#include <osgDB/SharedStateManager>
 
 #include <components/debug/debuglog.hpp>
 
@@ -44,7 +46,10 @@
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/optimizer.hpp>
+#include <components/sceneutil/morphgeometry.hpp>
+#include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
+#include <components/sceneutil/sharedstateregistry.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/sceneutil/visitor.hpp>
 
@@ -56,6 +61,7 @@
 #include <components/files/memorystream.hpp>
 
 #include "bgsmfilemanager.hpp"
+#include "compiledscenecache.hpp"
 #include "errormarker.hpp"
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
@@ -129,30 +135,68 @@ namespace
     private:
         unsigned int mMask;
     };
-}
-
-namespace Resource
-{
-    void TemplateMultiRef::addRef(const osg::Node* node)
-    {
-        mObjects.emplace_back(node);
-    }
 
-    class SharedStateManager : public osgDB::SharedStateManager
+    class FindParticleSystemVisitor : public osg::NodeVisitor
     {
     public:
-        unsigned int getNumSharedTextures() const { return _sharedTextureList.size(); }
+        FindParticleSystemVisitor()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        {
+        }
+
+        void apply(osg::Node& node) override
+        {
+            if (!mFound)
+                traverse(node);
+        }
+
+        void apply(osg::Drawable& drw) override
+        {
+            if (dynamic_cast<osgParticle::ParticleSystem*>(&drw) != nullptr)
+                mFound = true;
+        }
 
-        unsigned int getNumSharedStateSets() const { return _sharedStateSetList.size(); }
+        bool mFound = false;
+    };
 
-        void clearCache()
+    /// Instancing metadata computed once when the template is loaded, so instances don't need to rediscover it.
+    class TemplateInfo : public osg::Object
+    {
+    public:
+        TemplateInfo() = default;
+        explicit TemplateInfo(bool hasParticleSystems)
+            : mHasParticleSystems(hasParticleSystems)
+        {
+        }
+        TemplateInfo(const TemplateInfo& copy, const osg::CopyOp&)
+            : mHasParticleSystems(copy.mHasParticleSystems)
         {
-            std::lock_guard<OpenThreads::Mutex> lock(_listMutex);
-            _sharedTextureList.clear();
-            _sharedStateSetList.clear();
         }
+
+        META_Object(Resource, TemplateInfo)
+
+        bool mHasParticleSystems = true;
     };
 
+    const TemplateInfo* getTemplateInfo(const osg::Node& node)
+    {
+        const osg::UserDataContainer* container = node.getUserDataContainer();
+        if (container == nullptr)
+            return nullptr;
+        for (unsigned int i = 0; i < container->getNumUserObjects(); ++i)
+            if (const auto* info = dynamic_cast<const TemplateInfo*>(container->getUserObject(i)))
+                return info;
+        return nullptr;
+    }
+}
+
+namespace Resource
+{
+    void TemplateMultiRef::addRef(const osg::Node* node)
+    {
+        mObjects.emplace_back(node);
+    }
+
     /// Set texture filtering settings on textures contained in a FlipController.
     class SetFilterSettingsControllerVisitor : public SceneUtil::ControllerVisitor
     {
@@ -446,7 +490,8 @@ namespace Resource
         Resource::NifFileManager* nifFileManager, Resource::BgsmFileManager* bgsmFileManager, double expiryDelay)
         : ResourceManager(vfs, expiryDelay)
         , mShaderManager(new Shader::ShaderManager)
-        , mSharedStateManager(new SharedStateManager)
+        , mAutoTextureCache(std::make_shared<Shader::AutoTextureCache>())
+        , mSharedStateRegistry(new SceneUtil::SharedStateRegistry)
         , mImageManager(imageManager)
         , mNifFileManager(nifFileManager)
         , mBgsmFileManager(bgsmFileManager)
@@ -548,6 +593,36 @@ namespace Resource
         }
     }
 
+    void SceneManager::setGpuSkinning(bool enabled)
+    {
+        mGpuSkinning = enabled;
+        bindVertexAttributes();
+    }
+
+    void SceneManager::setGpuMorphing(bool enabled)
+    {
+        mGpuMorphing = enabled;
+        // Reserved while there is no other thread using the shader manager
+        if (enabled)
+            mShaderManager->reserveGlobalTextureUnits(Shader::ShaderManager::Slot::MorphTargets);
+        bindVertexAttributes();
+    }
+
+    void SceneManager::bindVertexAttributes()
+    {
+        if (!mGpuSkinning && !mGpuMorphing)
+            return;
+
+        const osg::Program* programTemplate = mShaderManager->getProgramTemplate();
+        osg::ref_ptr<osg::Program> program = programTemplate ? Shader::ShaderManager::cloneProgram(programTemplate)
+                                                             : osg::ref_ptr<osg::Program>(new osg::Program);
+        if (mGpuSkinning)
+            SceneUtil::RigGeometry::bindSkinningAttributes(*program);
+        if (mGpuMorphing)
+            SceneUtil::MorphGeometry::bindMorphingAttributes(*program);
+        mShaderManager->setProgramTemplate(program);
+    }
+
     SceneUtil::LightingMethod SceneManager::getLightingMethod() const
     {
         return mLightingMethod;
@@ -637,6 +712,47 @@ namespace Resource
 
     namespace
     {
+        /// Sums up vertex and index data, textures are accounted for by the ImageManager.
+        class EstimateSizeVisitor : public osg::NodeVisitor
+        {
+        public:
+            EstimateSizeVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Geometry& geometry) override
+            {
+                for (const osg::Array* array : geometry.getVertexAttribArrayList())
+                    add(array);
+                for (const osg::Array* array : geometry.getTexCoordArrayList())
+                    add(array);
+                add(geometry.getVertexArray());
+                add(geometry.getNormalArray());
+                add(geometry.getColorArray());
+                for (const osg::PrimitiveSet* primitiveSet : geometry.getPrimitiveSetList())
+                    if (primitiveSet != nullptr)
+                        mSize += primitiveSet->getTotalDataSize();
+            }
+
+            void apply(osg::Node& node) override
+            {
+                mSize += sizeof(osg::Node);
+                traverse(node);
+            }
+
+            std::size_t getSize() const { return mSize; }
+
+        private:
+            std::size_t mSize = 0;
+
+            void add(const osg::Array* array)
+            {
+                if (array != nullptr)
+                    mSize += array->getTotalDataSize();
+            }
+        };
+
         osg::ref_ptr<osg::Node> loadNonNif(
             VFS::Path::NormalizedView normalizedFilename, std::istream& model, Resource::ImageManager* imageManager)
         {
@@ -830,11 +946,25 @@ namespace Resource
 
     osg::ref_ptr<osg::Node> load(VFS::Path::NormalizedView normalizedFilename, const VFS::Manager* vfs,
         Resource::ImageManager* imageManager, Resource::NifFileManager* nifFileManager,
-        Resource::BgsmFileManager* materialMgr)
+        Resource::BgsmFileManager* materialMgr, const Resource::CompiledSceneCache* compiledSceneCache)
     {
         const std::string_view ext = Misc::getFileExtension(normalizedFilename.value());
         if (ext == "nif")
-            return NifOsg::Loader::load(*nifFileManager->get(normalizedFilename), imageManager, materialMgr);
+        {
+            if (compiledSceneCache == nullptr)
+                return NifOsg::Loader::load(*nifFileManager->get(normalizedFilename), imageManager, materialMgr);
+
+            const std::optional<std::string> key = compiledSceneCache->makeKey(normalizedFilename);
+            if (key.has_value())
+                if (osg::ref_ptr<osg::Node> cached = compiledSceneCache->read(*key))
+                    return cached;
+
+            osg::ref_ptr<osg::Node> loaded
+                = NifOsg::Loader::load(*nifFileManager->get(normalizedFilename), imageManager, materialMgr);
+            if (key.has_value())
+                compiledSceneCache->write(*key, *loaded);
+            return loaded;
+        }
         else if (ext == "spt")
         {
             Log(Debug::Warning) << "Ignoring SpeedTree data file " << normalizedFilename;
@@ -942,9 +1072,7 @@ namespace Resource
 
     void SceneManager::shareState(osg::ref_ptr<osg::Node> node)
     {
-        mSharedStateMutex.lock();
-        mSharedStateManager->share(node.get());
-        mSharedStateMutex.unlock();
+        mSharedStateRegistry->share(*node);
     }
 
     osg::ref_ptr<osg::Node> SceneManager::loadErrorMarker()
@@ -956,7 +1084,7 @@ namespace Resource
             {
                 path.changeExtension(meshType);
                 if (mVFS->exists(path))
-                    return load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+                    return load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager, mCompiledSceneCache.get());
             }
         }
         catch (const std::exception& e)
@@ -991,10 +1119,11 @@ namespace Resource
             return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
         else
         {
+            const auto start = std::chrono::steady_clock::now();
             osg::ref_ptr<osg::Node> loaded;
             try
             {
-                loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+                loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager, mCompiledSceneCache.get());
             }
             catch (const std::exception& e)
             {
@@ -1015,7 +1144,7 @@ namespace Resource
             if (canOptimize(path.value()))
             {
                 SceneUtil::Optimizer optimizer;
-                optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
+                optimizer.setSharedStateRegistry(mSharedStateRegistry);
                 optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
 
                 static const unsigned int options
@@ -1031,11 +1160,29 @@ namespace Resource
             else
                 loaded->getBound();
 
-            mCache->addEntryToObjectCache(path.value(), loaded);
+            FindParticleSystemVisitor findParticleSystemVisitor;
+            loaded->accept(findParticleSystemVisitor);
+            loaded->getOrCreateUserDataContainer()->addUserObject(
+                new TemplateInfo(findParticleSystemVisitor.mFound));
+
+            EstimateSizeVisitor estimateSizeVisitor;
+            loaded->accept(estimateSizeVisitor);
+            const CacheEntryCost cost{
+                .mSize = estimateSizeVisitor.getSize(),
+                .mLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+            };
+
+            mCache->addEntryToObjectCache(path.value(), loaded, cost);
             return loaded;
         }
     }
 
+    void SceneManager::setCompiledSceneCacheDirectory(const std::filesystem::path& directory)
+    {
+        mCompiledSceneCache
+            = std::make_unique<CompiledSceneCache>(*mVFS, directory, new ImageReadCallback(mImageManager));
+    }
+
     osg::ref_ptr<osg::Node> SceneManager::getInstance(VFS::Path::NormalizedView path)
     {
         return getInstance(getTemplate(path));
@@ -1064,10 +1211,13 @@ namespace Resource
 
     osg::ref_ptr<osg::Node> SceneManager::getInstance(const osg::Node* base)
     {
+        // templates loaded by the scene manager know whether they have particle systems, other scene graphs without
+        // update callbacks can be skipped since we know that particle emitters will have an update callback set
+        const TemplateInfo* info = getTemplateInfo(*base);
+        const bool hasParticleSystems
+            = info != nullptr ? info->mHasParticleSystems : base->getNumChildrenRequiringUpdateTraversal() > 0;
         osg::ref_ptr<osg::Node> cloned = cloneNode(base);
-        // we can skip any scene graphs without update callbacks since we know that particle emitters will have an
-        // update callback set
-        if (cloned->getNumChildrenRequiringUpdateTraversal() > 0)
+        if (hasParticleSystems)
         {
             InitParticlesVisitor visitor(mParticleSystemMask);
             cloned->accept(visitor);
@@ -1094,8 +1244,7 @@ namespace Resource
 
         mShaderManager->releaseGLObjects(state);
 
-        std::lock_guard<std::mutex> lock(mSharedStateMutex);
-        mSharedStateManager->releaseGLObjects(state);
+        mSharedStateRegistry->releaseGLObjects(state);
     }
 
     void SceneManager::setIncrementalCompileOperation(osgUtil::IncrementalCompileOperation* ico)
@@ -1178,9 +1327,7 @@ namespace Resource
     {
         ResourceManager::updateCache(referenceTime);
 
-        mSharedStateMutex.lock();
-        mSharedStateManager->prune();
-        mSharedStateMutex.unlock();
+        mSharedStateRegistry->prune();
 
         if (mIncrementalCompileOperation)
         {
@@ -1206,8 +1353,7 @@ namespace Resource
     {
         ResourceManager::clearCache();
 
-        std::lock_guard<std::mutex> lock(mSharedStateMutex);
-        mSharedStateManager->clearCache();
+        mSharedStateRegistry->clear();
     }
 
     void SceneManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
@@ -1218,11 +1364,8 @@ namespace Resource
             stats->setAttribute(frameNumber, "Compiling", mIncrementalCompileOperation->getToCompile().size());
         }
 
-        {
-            std::lock_guard<std::mutex> lock(mSharedStateMutex);
-            stats->setAttribute(frameNumber, "Texture", mSharedStateManager->getNumSharedTextures());
-            stats->setAttribute(frameNumber, "StateSet", mSharedStateManager->getNumSharedStateSets());
-        }
+        stats->setAttribute(frameNumber, "Texture", mSharedStateRegistry->getNumSharedTextures());
+        stats->setAttribute(frameNumber, "StateSet", mSharedStateRegistry->getNumSharedStateSets());
 
         Resource::reportStats("Node", frameNumber, mCache->getStats(), *stats);
     }
@@ -1242,6 +1385,9 @@ namespace Resource
         shaderVisitor->setAdjustCoverageForAlphaTest(mAdjustCoverageForAlphaTest);
         shaderVisitor->setSupportsNormalsRT(mSupportsNormalsRT);
         shaderVisitor->setWeatherParticleOcclusion(mWeatherParticleOcclusion);
+        shaderVisitor->setGpuSkinning(mGpuSkinning);
+        shaderVisitor->setGpuMorphing(mGpuMorphing);
+        shaderVisitor->setAutoTextureCache(mAutoTextureCache);
         return shaderVisitor;
     }
 }
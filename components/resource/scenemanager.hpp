@@ -33,7 +33,12 @@ namespace Resource
     class ImageManager;
     class NifFileManager;
     class BgsmFileManager;
-    class SharedStateManager;
+    class CompiledSceneCache;
+}
+
+namespace SceneUtil
+{
+    class SharedStateRegistry;
 }
 
 namespace osgUtil
@@ -43,6 +48,7 @@ namespace osgUtil
 
 namespace Shader
 {
+    class AutoTextureCache;
     class ShaderManager;
     class ShaderVisitor;
 }
@@ -154,6 +160,9 @@ namespace Resource
 
         void setShaderPath(const std::filesystem::path& path);
 
+        /// Keep scene graphs converted from NIF files in the directory between runs, see CompiledSceneCache.
+        void setCompiledSceneCacheDirectory(const std::filesystem::path& directory);
+
         /// Check if a given scene is loaded and if so, update its usage timestamp to prevent it from being unloaded
         bool checkLoaded(VFS::Path::NormalizedView name, double referenceTime);
 
@@ -232,24 +241,33 @@ namespace Resource
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        /// Skin RigGeometries rendered with the objects shader in the vertex shader.
+        /// @note Needs the gpuSkinning global shader define.
+        void setGpuSkinning(bool enabled);
+
+        /// Blend morph targets of MorphGeometries rendered with the objects shader in the vertex shader.
+        /// @note Needs the gpuMorphing global shader define.
+        void setGpuMorphing(bool enabled);
+
     private:
         osg::ref_ptr<Shader::ShaderVisitor> createShaderVisitor(const std::string& shaderPrefix = "objects");
         osg::ref_ptr<osg::Node> loadErrorMarker();
+        void bindVertexAttributes();
         osg::ref_ptr<osg::Node> cloneErrorMarker();
 
-        mutable std::mutex mSharedStateMutex;
-
         std::unique_ptr<Shader::ShaderManager> mShaderManager;
+        std::shared_ptr<Shader::AutoTextureCache> mAutoTextureCache;
         std::string mNormalMapPattern;
         std::string mNormalHeightMapPattern;
         std::string mSpecularMapPattern;
         std::array<osg::ref_ptr<osg::Texture>, 2> mOpaqueDepthTex;
 
-        osg::ref_ptr<Resource::SharedStateManager> mSharedStateManager;
+        osg::ref_ptr<SceneUtil::SharedStateRegistry> mSharedStateRegistry;
 
         Resource::ImageManager* mImageManager;
         Resource::NifFileManager* mNifFileManager;
         Resource::BgsmFileManager* mBgsmFileManager;
+        std::unique_ptr<CompiledSceneCache> mCompiledSceneCache;
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
         mutable osg::ref_ptr<osg::Node> mErrorMarker;
         mutable std::once_flag mErrorMarkerFlag;
@@ -270,6 +288,8 @@ namespace Resource
         bool mAdjustCoverageForAlphaTest = false;
         bool mSupportsNormalsRT = false;
         bool mWeatherParticleOcclusion = false;
+        bool mGpuSkinning = false;
+        bool mGpuMorphing = false;
         bool mUnRefImageDataAfterApply = false;
 
         SceneManager(const SceneManager&) = delete;
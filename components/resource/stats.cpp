@@ -21,6 +21,7 @@
 #include <components/vfs/manager.hpp>
 
 #include "cachestats.hpp"
+#include "memoryregistry.hpp"
 
 namespace Resource
 {
@@ -56,6 +57,8 @@ namespace Resource
                 "",
                 "Loading",
                 "Compiling",
+                "Compiling Queued",
+                "Compiling Uploaded",
                 "WorkQueue",
                 "WorkThread",
                 "UnrefQueue",
@@ -69,13 +72,12 @@ namespace Resource
                 "",
                 "Physics Actors",
                 "Physics Objects",
+                "Physics Merged Objects",
                 "Physics Projectiles",
                 "Physics HeightFields",
+                "Physics HeightField Shapes",
                 "",
                 "Lua UsedMemory",
-                "",
-                "",
-                "",
             };
 
             static_assert(std::size(firstPage) == itemsPerPage);
@@ -91,6 +93,7 @@ namespace Resource
                 "Groundcover Chunk",
                 "Object Chunk",
                 "Terrain Chunk",
+                "Terrain Subdivision",
                 "Terrain Texture",
                 "Land",
                 "Blending Rules",
@@ -101,6 +104,7 @@ namespace Resource
                 "CellPreloader Added",
                 "CellPreloader Evicted",
                 "CellPreloader Loaded",
+                "CellPreloader Missed",
                 "CellPreloader Expired",
             };
 
@@ -115,6 +119,8 @@ namespace Resource
                 "NavMesh DbJobs Read",
                 "NavMesh DbCache Get",
                 "NavMesh DbCache Hit",
+                "NavMesh DbWrite Tiles",
+                "NavMesh DbWrite Commits",
                 "NavMesh CacheSize",
                 "NavMesh UsedTiles",
                 "NavMesh CachedTiles",
@@ -124,6 +130,55 @@ namespace Resource
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
                 "NavMesh Recast Water",
+                "NavMesh PathCache Size",
+                "NavMesh PathCache Get",
+                "NavMesh PathCache Hit",
+            };
+
+            constexpr std::string_view snow[] = {
+                "Snow Pages",
+                "Snow Resident Pages",
+                "Snow Actor Footprints",
+                "Snow Stamp GPU",
+                "Snow Clear GPU",
+                "Snow Decay GPU",
+            };
+
+            constexpr std::string_view mechanicsAi[] = {
+                "Mechanics AI Full",
+                "Mechanics AI Visible",
+                "Mechanics AI Hidden",
+                "Mechanics AI Skipped",
+            };
+
+            constexpr std::string_view workQueue[] = {
+                "WorkQueue High",
+                "WorkQueue High Wait ms",
+                "WorkQueue Normal",
+                "WorkQueue Normal Wait ms",
+                "WorkQueue Low",
+                "WorkQueue Low Wait ms",
+            };
+
+            constexpr std::string_view gpu[] = {
+                "GPU Shadows",
+                "GPU Static Shadows",
+                "GPU Sky",
+                "GPU Water Reflection",
+                "GPU Water Refraction",
+                "GPU Composite Maps",
+                "GPU Post Processing",
+                "GPU UI",
+            };
+
+            constexpr std::string_view memory[] = {
+                "Resource Caches",
+                "Cells",
+                "Physics",
+                "NavMesh",
+                "Lua",
+                "Snow",
+                "Total",
             };
 
             std::vector<std::string> statNames;
@@ -131,11 +186,16 @@ namespace Resource
             for (std::string_view name : firstPage)
                 statNames.emplace_back(name);
 
+            // Each cache takes 6 attributes, fit as many with a separating line as possible on a page
+            constexpr std::size_t cachesPerPage = 3;
             for (std::size_t i = 0; i < std::size(caches); ++i)
             {
                 Resource::addCacheStatsAttibutes(caches[i], statNames);
-                if ((i + 1) % 5 != 0)
+                if ((i + 1) % cachesPerPage != 0)
                     statNames.emplace_back();
+                else
+                    while (statNames.size() % itemsPerPage != 0)
+                        statNames.emplace_back();
             }
 
             for (std::string_view name : cellPreloader)
@@ -147,6 +207,32 @@ namespace Resource
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : snow)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : mechanicsAi)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : gpu)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : workQueue)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : memory)
+                Resource::addMemoryStatsAttributes(name, statNames);
+
             return statNames;
         }
 
@@ -500,6 +586,8 @@ namespace Resource
                     else
                     {
                         double value = 0.0;
+                        // GPU times are in milliseconds, most of them are below one
+                        viewStr.precision(statName.starts_with("GPU ") ? 2 : 0);
                         if (mStats->getAttribute(frameNumber, statName, value))
                             viewStr << std::setw(8) << value << std::endl;
                         else
@@ -0,0 +1,223 @@
+#include "texturecompressioncache.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <osg/Image>
+
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/pathhelpers.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include "texturecompressor.hpp"
+
+namespace Resource
+{
+    namespace
+    {
+        // Increase when the compression changes
+        constexpr int formatVersion = 1;
+
+        // Interface images and others outside this directory keep their exact colors
+        constexpr std::string_view texturesDirectory = "textures/";
+
+        std::string toHex(const std::array<std::uint64_t, 2>& hash)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (const std::uint64_t value : hash)
+                stream << std::setw(16) << value;
+            return stream.str();
+        }
+
+        bool isCompressedDds(std::istream& stream)
+        {
+            // Flags of the pixel format in the header, DDPF_FOURCC is set for compressed and DX10 images
+            constexpr std::size_t headerSize = 88;
+            constexpr std::size_t pixelFormatFlagsOffset = 80;
+            constexpr std::uint32_t fourCCFlag = 0x4;
+            std::array<unsigned char, headerSize> header;
+            stream.read(reinterpret_cast<char*>(header.data()), header.size());
+            const bool compressed = !stream || (header[pixelFormatFlagsOffset] & fourCCFlag) != 0;
+            stream.clear();
+            stream.seekg(0);
+            return compressed;
+        }
+    }
+
+    struct TextureCompressionCache::Pending
+    {
+        std::mutex mMutex;
+        std::set<std::string, std::less<>> mKeys;
+    };
+
+    namespace
+    {
+        class CompressWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            CompressWorkItem(osgDB::ReaderWriter& readerWriter, osg::ref_ptr<const osgDB::Options> options,
+                std::filesystem::path directory, std::filesystem::path path, osg::ref_ptr<const osg::Image> image,
+                std::function<void()> done)
+                : mReaderWriter(readerWriter)
+                , mOptions(std::move(options))
+                , mDirectory(std::move(directory))
+                , mPath(std::move(path))
+                , mImage(std::move(image))
+                , mDone(std::move(done))
+            {
+            }
+
+            void doWork() override
+            {
+                write(*compressImage(*mImage));
+                mDone();
+            }
+
+        private:
+            osgDB::ReaderWriter& mReaderWriter;
+            const osg::ref_ptr<const osgDB::Options> mOptions;
+            const std::filesystem::path mDirectory;
+            const std::filesystem::path mPath;
+            const osg::ref_ptr<const osg::Image> mImage;
+            const std::function<void()> mDone;
+
+            void write(const osg::Image& image) const
+            {
+                // Other threads and processes must never read a partially written image
+                std::filesystem::path temporary = mPath;
+                temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+                try
+                {
+                    std::filesystem::create_directories(mDirectory);
+
+                    {
+                        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                        if (!stream.is_open())
+                            throw std::runtime_error("failed to open file");
+                        const osgDB::ReaderWriter::WriteResult result
+                            = mReaderWriter.writeImage(image, stream, mOptions);
+                        if (!result.success())
+                            throw std::runtime_error(result.message());
+                        stream.close();
+                        if (!stream)
+                            throw std::runtime_error("failed to write file");
+                    }
+
+                    std::filesystem::rename(temporary, mPath);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to write compressed texture " << mPath << " for "
+                                        << image.getFileName() << ": " << e.what();
+                    std::error_code ec;
+                    std::filesystem::remove(temporary, ec);
+                }
+            }
+        };
+    }
+
+    TextureCompressionCache::TextureCompressionCache(std::filesystem::path directory, SceneUtil::WorkQueue* workQueue)
+        : mDirectory(std::move(directory))
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("dds"))
+        // Keep the rows in the order they have in memory, so the image is read back exactly as it was compressed
+        , mOptions(new osgDB::Options("ddsNoAutoFlipWrite"))
+        , mWorkQueue(workQueue)
+        , mPending(std::make_shared<Pending>())
+    {
+        if (mReaderWriter == nullptr)
+            Log(Debug::Warning) << "No readerwriter for 'dds' found, textures will not be compressed";
+    }
+
+    TextureCompressionCache::~TextureCompressionCache() = default;
+
+    std::string TextureCompressionCache::makeKey(
+        VFS::Path::NormalizedView path, std::istream& stream, bool flip, int maxSize) const
+    {
+        if (mReaderWriter == nullptr || mWorkQueue == nullptr || !path.value().starts_with(texturesDirectory))
+            return {};
+
+        const std::string_view ext = Misc::getFileExtension(path.value());
+        if (ext == "dds")
+        {
+            if (isCompressedDds(stream))
+                return {};
+        }
+        else if (ext != "png" && ext != "tga" && ext != "bmp" && ext != "jpg" && ext != "jpeg")
+            return {};
+
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << path.value() << ' ' << toHex(Files::getHash(path.value(), stream))
+                   << ' ' << flip << ' ' << maxSize;
+        stream.clear();
+        stream.seekg(0);
+
+        std::istringstream descriptorStream(descriptor.str());
+        return toHex(Files::getHash(path.value(), descriptorStream));
+    }
+
+    osg::ref_ptr<osg::Image> TextureCompressionCache::read(const std::string& key) const
+    {
+        if (mReaderWriter == nullptr || key.empty())
+            return nullptr;
+
+        const std::filesystem::path path = getFilePath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        try
+        {
+            const osgDB::ReaderWriter::ReadResult result = mReaderWriter->readImage(stream, mOptions);
+            if (result.success() && result.getImage() != nullptr)
+                return result.getImage();
+            Log(Debug::Warning) << "Failed to read compressed texture " << path << ": " << result.message();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read compressed texture " << path << ": " << e.what();
+        }
+        return nullptr;
+    }
+
+    void TextureCompressionCache::add(const std::string& key, osg::ref_ptr<const osg::Image> image)
+    {
+        if (mReaderWriter == nullptr || mWorkQueue == nullptr || key.empty() || !canCompressImage(*image))
+            return;
+
+        {
+            const std::lock_guard lock(mPending->mMutex);
+            if (!mPending->mKeys.insert(key).second)
+                return;
+        }
+
+        std::function<void()> done = [pending = mPending, key] {
+            const std::lock_guard lock(pending->mMutex);
+            pending->mKeys.erase(key);
+        };
+        mWorkQueue->addWorkItem(new CompressWorkItem(*mReaderWriter, mOptions, mDirectory, getFilePath(key),
+                                    std::move(image), std::move(done)),
+            SceneUtil::WorkPriority::Low);
+    }
+
+    std::filesystem::path TextureCompressionCache::getFilePath(const std::string& key) const
+    {
+        return mDirectory / Files::pathFromUnicodeString(key + ".dds");
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSIONCACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSIONCACHE_H
+
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string>
+
+#include <osg/ref_ptr>
+
+#include <components/vfs/pathutil.hpp>
+
+namespace osg
+{
+    class Image;
+}
+
+namespace osgDB
+{
+    class Options;
+    class ReaderWriter;
+}
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace Resource
+{
+    /// @brief DXT compressed versions of uncompressed textures kept on disk between runs.
+    /// @par Textures are compressed on a work queue the first time they are loaded and stored as DDS images keyed by
+    /// the content of the source file, later loads use the compressed version directly.
+    class TextureCompressionCache
+    {
+    public:
+        explicit TextureCompressionCache(std::filesystem::path directory, SceneUtil::WorkQueue* workQueue);
+
+        ~TextureCompressionCache();
+
+        /// @param stream content of the file, read and rewound
+        /// @param flip whether the image is flipped on load
+        /// @param maxSize the maximum texture size the image is loaded with
+        /// @return Key of the file, empty when it is not a texture or already compressed.
+        /// @note Thread safe.
+        std::string makeKey(VFS::Path::NormalizedView path, std::istream& stream, bool flip, int maxSize) const;
+
+        /// @return Cached image, nullptr if there is none or it can't be read.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Image> read(const std::string& key) const;
+
+        /// Compress the image and store it in the background, failures are only logged. The image must not be changed
+        /// afterwards.
+        /// @note Thread safe.
+        void add(const std::string& key, osg::ref_ptr<const osg::Image> image);
+
+    private:
+        std::filesystem::path mDirectory;
+        osgDB::ReaderWriter* mReaderWriter;
+        osg::ref_ptr<osgDB::Options> mOptions;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+
+        struct Pending;
+        // Images queued for compression, so a texture loaded again meanwhile isn't compressed twice. Shared with the
+        // work items as they may outlive the cache.
+        std::shared_ptr<Pending> mPending;
+
+        std::filesystem::path getFilePath(const std::string& key) const;
+    };
+}
+
+#endif
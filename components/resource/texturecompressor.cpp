@@ -0,0 +1,347 @@
+#include "texturecompressor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <osg/Image>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr std::size_t texelsPerBlock = 16;
+
+        using Color = std::array<float, 3>;
+
+        struct Level
+        {
+            int mWidth = 0;
+            int mHeight = 0;
+            // RGBA8 rows without padding
+            std::vector<std::uint8_t> mTexels;
+        };
+
+        float dot(const Color& left, const Color& right)
+        {
+            return left[0] * right[0] + left[1] * right[1] + left[2] * right[2];
+        }
+
+        std::uint16_t toRgb565(const Color& color)
+        {
+            const auto quantize = [](float value, int max) {
+                const int quantized = static_cast<int>(std::lround(value * max / 255.f));
+                return static_cast<std::uint16_t>(std::clamp(quantized, 0, max));
+            };
+            return static_cast<std::uint16_t>(
+                (quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+        }
+
+        std::array<int, 3> fromRgb565(std::uint16_t value)
+        {
+            const int r = (value >> 11) & 31;
+            const int g = (value >> 5) & 63;
+            const int b = value & 31;
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+        }
+
+        // Direction of the largest variation of the colors, found by power iteration on their covariance
+        Color getPrincipalAxis(const std::array<Color, texelsPerBlock>& colors, const Color& mean)
+        {
+            std::array<float, 6> covariance{};
+            Color min = colors[0];
+            Color max = colors[0];
+            for (const Color& color : colors)
+            {
+                const Color d{ color[0] - mean[0], color[1] - mean[1], color[2] - mean[2] };
+                covariance[0] += d[0] * d[0];
+                covariance[1] += d[0] * d[1];
+                covariance[2] += d[0] * d[2];
+                covariance[3] += d[1] * d[1];
+                covariance[4] += d[1] * d[2];
+                covariance[5] += d[2] * d[2];
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    min[i] = std::min(min[i], color[i]);
+                    max[i] = std::max(max[i], color[i]);
+                }
+            }
+
+            Color axis{ max[0] - min[0], max[1] - min[1], max[2] - min[2] };
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                const Color next{
+                    covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                    covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                    covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+                };
+                const float length = std::sqrt(dot(next, next));
+                if (length == 0)
+                    break;
+                axis = { next[0] / length, next[1] / length, next[2] / length };
+            }
+            return axis;
+        }
+
+        void writeUint16(std::uint16_t value, std::uint8_t* out)
+        {
+            out[0] = static_cast<std::uint8_t>(value & 0xff);
+            out[1] = static_cast<std::uint8_t>(value >> 8);
+        }
+
+        unsigned getBlockSize(GLenum format)
+        {
+            return format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16;
+        }
+
+        Level readLevel(const osg::Image& image, unsigned level)
+        {
+            Level result;
+            result.mWidth = std::max(image.s() >> level, 1);
+            result.mHeight = std::max(image.t() >> level, 1);
+            result.mTexels.resize(static_cast<std::size_t>(result.mWidth) * result.mHeight * 4);
+
+            const unsigned components = image.getPixelFormat() == GL_RGBA ? 4 : 3;
+            const unsigned rowSize = osg::Image::computeRowWidthInBytes(
+                result.mWidth, image.getPixelFormat(), image.getDataType(), image.getPacking());
+            const unsigned char* const data = image.getMipmapData(level);
+            for (int y = 0; y < result.mHeight; ++y)
+            {
+                const unsigned char* source = data + static_cast<std::size_t>(y) * rowSize;
+                std::uint8_t* target = result.mTexels.data() + static_cast<std::size_t>(y) * result.mWidth * 4;
+                for (int x = 0; x < result.mWidth; ++x, source += components, target += 4)
+                {
+                    std::memcpy(target, source, components);
+                    if (components == 3)
+                        target[3] = 255;
+                }
+            }
+            return result;
+        }
+
+        Level makeNextLevel(const Level& level)
+        {
+            Level result;
+            result.mWidth = std::max(level.mWidth / 2, 1);
+            result.mHeight = std::max(level.mHeight / 2, 1);
+            result.mTexels.resize(static_cast<std::size_t>(result.mWidth) * result.mHeight * 4);
+
+            const auto at = [&](int x, int y, int channel) -> unsigned {
+                x = std::min(x, level.mWidth - 1);
+                y = std::min(y, level.mHeight - 1);
+                return level.mTexels[(static_cast<std::size_t>(y) * level.mWidth + x) * 4 + channel];
+            };
+            for (int y = 0; y < result.mHeight; ++y)
+                for (int x = 0; x < result.mWidth; ++x)
+                    for (int channel = 0; channel < 4; ++channel)
+                    {
+                        const unsigned sum = at(2 * x, 2 * y, channel) + at(2 * x + 1, 2 * y, channel)
+                            + at(2 * x, 2 * y + 1, channel) + at(2 * x + 1, 2 * y + 1, channel);
+                        result.mTexels[(static_cast<std::size_t>(y) * result.mWidth + x) * 4 + channel]
+                            = static_cast<std::uint8_t>((sum + 2) / 4);
+                    }
+            return result;
+        }
+
+        bool isOpaque(const Level& level)
+        {
+            for (std::size_t i = 3; i < level.mTexels.size(); i += 4)
+                if (level.mTexels[i] != 255)
+                    return false;
+            return true;
+        }
+
+        void encodeLevel(const Level& level, GLenum format, std::uint8_t* out)
+        {
+            std::array<std::uint8_t, texelsPerBlock * 4> block;
+            for (int blockY = 0; blockY < level.mHeight; blockY += 4)
+            {
+                for (int blockX = 0; blockX < level.mWidth; blockX += 4)
+                {
+                    // Levels smaller than a block repeat their last row and column
+                    for (int y = 0; y < 4; ++y)
+                        for (int x = 0; x < 4; ++x)
+                        {
+                            const int sourceX = std::min(blockX + x, level.mWidth - 1);
+                            const int sourceY = std::min(blockY + y, level.mHeight - 1);
+                            std::memcpy(block.data() + (y * 4 + x) * 4,
+                                level.mTexels.data() + (static_cast<std::size_t>(sourceY) * level.mWidth + sourceX) * 4,
+                                4);
+                        }
+                    if (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+                    {
+                        encodeBc3AlphaBlock(block.data(), out);
+                        out += 8;
+                    }
+                    encodeBc1Block(block.data(), out);
+                    out += 8;
+                }
+            }
+        }
+    }
+
+    void encodeBc1Block(const std::uint8_t* texels, std::uint8_t* out)
+    {
+        std::array<Color, texelsPerBlock> colors;
+        Color mean{};
+        for (std::size_t i = 0; i < texelsPerBlock; ++i)
+        {
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                colors[i][channel] = texels[i * 4 + channel];
+                mean[channel] += colors[i][channel] / texelsPerBlock;
+            }
+        }
+
+        const Color axis = getPrincipalAxis(colors, mean);
+        float minProjection = 0;
+        float maxProjection = 0;
+        for (const Color& color : colors)
+        {
+            const float projection
+                = dot(Color{ color[0] - mean[0], color[1] - mean[1], color[2] - mean[2] }, axis);
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        std::uint16_t color0 = toRgb565({ mean[0] + axis[0] * maxProjection, mean[1] + axis[1] * maxProjection,
+            mean[2] + axis[2] * maxProjection });
+        std::uint16_t color1 = toRgb565({ mean[0] + axis[0] * minProjection, mean[1] + axis[1] * minProjection,
+            mean[2] + axis[2] * minProjection });
+        // The first color has to be the greater one to select the four color mode without transparent black
+        if (color0 < color1)
+            std::swap(color0, color1);
+        writeUint16(color0, out);
+        writeUint16(color1, out + 2);
+
+        std::uint32_t indices = 0;
+        if (color0 != color1)
+        {
+            const std::array<int, 3> end0 = fromRgb565(color0);
+            const std::array<int, 3> end1 = fromRgb565(color1);
+            std::array<std::array<int, 3>, 4> palette{ end0, end1, {}, {} };
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                palette[2][channel] = (2 * end0[channel] + end1[channel]) / 3;
+                palette[3][channel] = (end0[channel] + 2 * end1[channel]) / 3;
+            }
+
+            for (std::size_t i = 0; i < texelsPerBlock; ++i)
+            {
+                std::uint32_t best = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+                for (std::uint32_t candidate = 0; candidate < 4; ++candidate)
+                {
+                    int distance = 0;
+                    for (std::size_t channel = 0; channel < 3; ++channel)
+                    {
+                        const int d = texels[i * 4 + channel] - palette[candidate][channel];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance)
+                    {
+                        best = candidate;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= best << (2 * i);
+            }
+        }
+        for (std::size_t i = 0; i < 4; ++i)
+            out[4 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+    }
+
+    void encodeBc3AlphaBlock(const std::uint8_t* texels, std::uint8_t* out)
+    {
+        int alpha0 = 0;
+        int alpha1 = 255;
+        for (std::size_t i = 0; i < texelsPerBlock; ++i)
+        {
+            alpha0 = std::max<int>(alpha0, texels[i * 4 + 3]);
+            alpha1 = std::min<int>(alpha1, texels[i * 4 + 3]);
+        }
+        out[0] = static_cast<std::uint8_t>(alpha0);
+        out[1] = static_cast<std::uint8_t>(alpha1);
+
+        std::uint64_t indices = 0;
+        if (alpha0 != alpha1)
+        {
+            // With the first alpha greater than the second one the block uses 6 interpolated values
+            std::array<int, 8> palette{ alpha0, alpha1 };
+            for (int i = 1; i < 7; ++i)
+                palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+
+            for (std::size_t i = 0; i < texelsPerBlock; ++i)
+            {
+                std::uint64_t best = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+                for (std::uint64_t candidate = 0; candidate < palette.size(); ++candidate)
+                {
+                    const int distance = std::abs(texels[i * 4 + 3] - palette[candidate]);
+                    if (distance < bestDistance)
+                    {
+                        best = candidate;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= best << (3 * i);
+            }
+        }
+        for (std::size_t i = 0; i < 6; ++i)
+            out[2 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+    }
+
+    bool canCompressImage(const osg::Image& image)
+    {
+        return (image.getPixelFormat() == GL_RGB || image.getPixelFormat() == GL_RGBA)
+            && image.getDataType() == GL_UNSIGNED_BYTE && image.r() == 1 && image.s() > 0 && image.t() > 0
+            && image.s() % 4 == 0 && image.t() % 4 == 0 && image.isDataContiguous();
+    }
+
+    osg::ref_ptr<osg::Image> compressImage(const osg::Image& image)
+    {
+        assert(canCompressImage(image));
+
+        std::vector<Level> levels;
+        levels.push_back(readLevel(image, 0));
+        if (image.isMipmap())
+        {
+            for (unsigned level = 1; level < image.getNumMipmapLevels(); ++level)
+                levels.push_back(readLevel(image, level));
+        }
+        else
+        {
+            while (levels.back().mWidth > 1 || levels.back().mHeight > 1)
+                levels.push_back(makeNextLevel(levels.back()));
+        }
+
+        const GLenum format = std::all_of(levels.begin(), levels.end(), isOpaque) ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                                                                                   : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        const unsigned blockSize = getBlockSize(format);
+
+        std::vector<unsigned> offsets;
+        unsigned size = 0;
+        for (const Level& level : levels)
+        {
+            offsets.push_back(size);
+            size += static_cast<unsigned>((level.mWidth + 3) / 4) * static_cast<unsigned>((level.mHeight + 3) / 4)
+                * blockSize;
+        }
+
+        unsigned char* const data = new unsigned char[size];
+        for (std::size_t i = 0; i < levels.size(); ++i)
+            encodeLevel(levels[i], format, data + offsets[i]);
+
+        osg::ref_ptr<osg::Image> result(new osg::Image);
+        result->setFileName(image.getFileName());
+        result->setImage(image.s(), image.t(), 1, format, format, GL_UNSIGNED_BYTE, data, osg::Image::USE_NEW_DELETE);
+        if (levels.size() > 1)
+            result->setMipmapLevels(osg::Image::MipmapDataType(offsets.begin() + 1, offsets.end()));
+        result->setOrigin(image.getOrigin());
+        return result;
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSOR_H
+#define OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSOR_H
+
+#include <cstdint>
+
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Image;
+}
+
+namespace Resource
+{
+    /// Encode 4x4 texels given as RGBA8 rows into a BC1 (DXT1) color block of 8 bytes. Alpha is ignored.
+    void encodeBc1Block(const std::uint8_t* texels, std::uint8_t* out);
+
+    /// Encode the alpha of 4x4 texels given as RGBA8 rows into a BC3 (DXT5) alpha block of 8 bytes.
+    void encodeBc3AlphaBlock(const std::uint8_t* texels, std::uint8_t* out);
+
+    /// @return Whether the image is an uncompressed 8 bit RGB or RGBA 2D image with sizes that are multiples of 4.
+    bool canCompressImage(const osg::Image& image);
+
+    /// Compress the image to DXT1 when it is opaque and to DXT5 otherwise. Precomputed mipmaps are compressed as they
+    /// are, the others are generated with a box filter.
+    /// @param image must be compressible, see canCompressImage
+    osg::ref_ptr<osg::Image> compressImage(const osg::Image& image);
+}
+
+#endif
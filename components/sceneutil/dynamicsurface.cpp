@@ -0,0 +1,21 @@
+#include "dynamicsurface.hpp"
+
+#include <osg/Texture2D>
+
+namespace SceneUtil
+{
+    osg::ref_ptr<osg::Texture2D> createDynamicSurfaceTexture(int size, osg::Texture::WrapMode wrap)
+    {
+        osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
+        texture->setTextureSize(size, size);
+        texture->setInternalFormat(GL_RGBA16F_ARB);
+        texture->setSourceFormat(GL_RGBA);
+        texture->setSourceType(GL_FLOAT);
+        texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        texture->setWrap(osg::Texture::WRAP_S, wrap);
+        texture->setWrap(osg::Texture::WRAP_T, wrap);
+        texture->setBorderColor(osg::Vec4(0, 0, 0, 0));
+        return texture;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_DYNAMICSURFACE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_DYNAMICSURFACE_H
+
+#include <osg/Texture>
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Texture2D;
+}
+
+namespace SceneUtil
+{
+    /// @brief Creates a texture for a dynamic surface, a render target simulated on the GPU around the camera and
+    /// sampled by world shaders, such as the water ripple map or the snow deformation atlas.
+    /// @par The texture is RGBA16F with linear filtering and has no image, its content only exists on the GPU. It is
+    /// undefined until the first pass renders into it. Texels outside are zero with CLAMP_TO_BORDER.
+    osg::ref_ptr<osg::Texture2D> createDynamicSurfaceTexture(int size, osg::Texture::WrapMode wrap);
+}
+
+#endif
@@ -0,0 +1,219 @@
+#include "gputimer.hpp"
+
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Stats>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        std::atomic<bool> enabled{ false };
+
+        struct Registry
+        {
+            std::mutex mMutex;
+            std::vector<GpuTimer*> mTimers;
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        const osg::GLExtensions* getTimerExtensions(osg::State& state)
+        {
+            const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+            if (!extensions || !extensions->isARBTimerQuerySupported)
+                return nullptr;
+            return extensions;
+        }
+
+        class BeginCallback : public osg::Camera::DrawCallback
+        {
+        public:
+            explicit BeginCallback(osg::ref_ptr<GpuTimer> timer)
+                : mTimer(std::move(timer))
+            {
+            }
+
+            void operator()(osg::RenderInfo& renderInfo) const override { mTimer->begin(*renderInfo.getState()); }
+
+        private:
+            osg::ref_ptr<GpuTimer> mTimer;
+        };
+
+        class EndCallback : public osg::Camera::DrawCallback
+        {
+        public:
+            explicit EndCallback(osg::ref_ptr<GpuTimer> timer)
+                : mTimer(std::move(timer))
+            {
+            }
+
+            void operator()(osg::RenderInfo& renderInfo) const override { mTimer->end(*renderInfo.getState()); }
+
+        private:
+            osg::ref_ptr<GpuTimer> mTimer;
+        };
+    }
+
+    GpuTimer::GpuTimer(std::string name)
+        : mName(std::move(name))
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        registry.mTimers.push_back(this);
+    }
+
+    GpuTimer::~GpuTimer()
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        std::erase(registry.mTimers, this);
+    }
+
+    void GpuTimer::begin(osg::State& state)
+    {
+        if (!isEnabled() && !mAlwaysEnabled.load(std::memory_order_relaxed))
+            return;
+
+        const osg::GLExtensions* extensions = getTimerExtensions(state);
+        if (!extensions)
+            return;
+
+        const std::lock_guard lock(mMutex);
+
+        Queries& queries = mQueries[state.getContextID()];
+        if (!queries.mGenerated)
+        {
+            extensions->glGenQueries(static_cast<GLsizei>(queries.mIds.size()), queries.mIds.data());
+            queries.mGenerated = true;
+        }
+
+        collect(state, queries);
+
+        // Every measurement is still in flight, skip this one rather than waiting
+        const std::size_t index = queries.mNext;
+        if (queries.mActive || queries.mIssued[index])
+            return;
+
+        extensions->glQueryCounter(queries.mIds[2 * index], GL_TIMESTAMP);
+        queries.mActive = true;
+    }
+
+    void GpuTimer::end(osg::State& state)
+    {
+        const std::lock_guard lock(mMutex);
+
+        const auto it = mQueries.find(state.getContextID());
+        if (it == mQueries.end() || !it->second.mActive)
+            return;
+
+        Queries& queries = it->second;
+        const std::size_t index = queries.mNext;
+        state.get<osg::GLExtensions>()->glQueryCounter(queries.mIds[2 * index + 1], GL_TIMESTAMP);
+
+        queries.mIssued[index] = true;
+        queries.mNext = (index + 1) % sQueryCount;
+        queries.mActive = false;
+    }
+
+    void GpuTimer::collect(osg::State& state, Queries& queries)
+    {
+        const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+
+        // Oldest first, measurements finish in the order they were issued
+        for (std::size_t i = 0; i < sQueryCount; ++i)
+        {
+            const std::size_t index = (queries.mNext + i) % sQueryCount;
+            if (!queries.mIssued[index])
+                continue;
+
+            GLint available = 0;
+            extensions->glGetQueryObjectiv(queries.mIds[2 * index + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                break;
+
+            GLuint64 beginTime = 0;
+            GLuint64 endTime = 0;
+            extensions->glGetQueryObjectui64v(queries.mIds[2 * index], GL_QUERY_RESULT, &beginTime);
+            extensions->glGetQueryObjectui64v(queries.mIds[2 * index + 1], GL_QUERY_RESULT, &endTime);
+            queries.mIssued[index] = false;
+
+            if (endTime <= beginTime)
+                continue;
+
+            const double timeMs = static_cast<double>(endTime - beginTime) / 1e6;
+            mLatestMs = timeMs;
+            // Measurements taken while timing is disabled must not show up later in the stats
+            if (isEnabled())
+                mMeasuredMs += timeMs;
+        }
+    }
+
+    std::optional<double> GpuTimer::takeLatestMs()
+    {
+        const std::lock_guard lock(mMutex);
+        return std::exchange(mLatestMs, std::nullopt);
+    }
+
+    void GpuTimer::setEnabled(bool value)
+    {
+        enabled.store(value, std::memory_order_relaxed);
+    }
+
+    bool GpuTimer::isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void GpuTimer::reportStats(unsigned frameNumber, osg::Stats& stats)
+    {
+        if (!isEnabled())
+            return;
+
+        std::map<std::string, double, std::less<>> times;
+
+        {
+            Registry& registry = getRegistry();
+            const std::lock_guard lock(registry.mMutex);
+            for (GpuTimer* timer : registry.mTimers)
+            {
+                const std::lock_guard timerLock(timer->mMutex);
+                times[timer->mName] += std::exchange(timer->mMeasuredMs, 0.0);
+            }
+        }
+
+        for (const auto& [name, time] : times)
+            stats.setAttribute(frameNumber, "GPU " + name, time);
+    }
+
+    void GpuTimerDrawCallback::drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const
+    {
+        mTimer->begin(*renderInfo.getState());
+        drawable->drawImplementation(renderInfo);
+        mTimer->end(*renderInfo.getState());
+    }
+
+    void addGpuTimer(osg::Camera& camera, osg::ref_ptr<GpuTimer> timer)
+    {
+        camera.addPreDrawCallback(new BeginCallback(timer));
+        camera.addPostDrawCallback(new EndCallback(std::move(timer)));
+    }
+
+    void addGpuTimer(osg::Camera& first, osg::Camera& last, osg::ref_ptr<GpuTimer> timer)
+    {
+        first.addPreDrawCallback(new BeginCallback(timer));
+        last.addPostDrawCallback(new EndCallback(std::move(timer)));
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_GPUTIMER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_GPUTIMER_H
+
+#include <osg/Camera>
+#include <osg/Drawable>
+#include <osg/GL>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace osg
+{
+    class State;
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    /// @brief Named scope measuring the GPU time of the commands submitted between begin and end.
+    /// @par Uses GL_TIMESTAMP queries, so scopes may overlap or nest each other and any GL_TIME_ELAPSED query.
+    /// Results are read back in later frames once available, so timing never stalls the pipeline.
+    /// @par The times of all timers with the same name are added up and reported as the "GPU <name>" stats attribute.
+    /// @note Does nothing while timing is disabled or when timer queries are not supported.
+    class GpuTimer : public osg::Referenced
+    {
+    public:
+        explicit GpuTimer(std::string name);
+
+        const std::string& getName() const { return mName; }
+
+        void begin(osg::State& state);
+
+        void end(osg::State& state);
+
+        /// Keep measuring while timing is disabled, for timers whose results are used by the engine itself
+        void setAlwaysEnabled(bool value) { mAlwaysEnabled.store(value, std::memory_order_relaxed); }
+
+        /// @return GPU time in milliseconds of the latest measurement finished since the previous call, if any
+        std::optional<double> takeLatestMs();
+
+        /// Timing has a cost, it is disabled by default
+        static void setEnabled(bool enabled);
+
+        static bool isEnabled();
+
+        /// Report the GPU time in milliseconds measured by every timer since the previous call.
+        static void reportStats(unsigned frameNumber, osg::Stats& stats);
+
+    protected:
+        ~GpuTimer() override;
+
+    private:
+        /// Measurements in flight per graphics context, enough to cover a few frames of latency
+        static constexpr std::size_t sQueryCount = 8;
+
+        struct Queries
+        {
+            std::array<GLuint, 2 * sQueryCount> mIds{};
+            std::array<bool, sQueryCount> mIssued{};
+            std::size_t mNext = 0;
+            bool mGenerated = false;
+            bool mActive = false;
+        };
+
+        const std::string mName;
+        std::atomic<bool> mAlwaysEnabled{ false };
+        std::mutex mMutex;
+        std::map<unsigned int, Queries> mQueries;
+        double mMeasuredMs = 0;
+        std::optional<double> mLatestMs;
+
+        void collect(osg::State& state, Queries& queries);
+    };
+
+    /// Draw callback measuring the GPU time of the drawable it is attached to
+    class GpuTimerDrawCallback : public osg::Drawable::DrawCallback
+    {
+    public:
+        explicit GpuTimerDrawCallback(osg::ref_ptr<GpuTimer> timer)
+            : mTimer(std::move(timer))
+        {
+        }
+
+        void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const override;
+
+    private:
+        osg::ref_ptr<GpuTimer> mTimer;
+    };
+
+    /// Measure the GPU time of the camera, the cameras rendered before and after it are excluded.
+    void addGpuTimer(osg::Camera& camera, osg::ref_ptr<GpuTimer> timer);
+
+    /// Measure the GPU time from the start of the first camera to the end of the last one, including every camera
+    /// rendered between them.
+    void addGpuTimer(osg::Camera& first, osg::Camera& last, osg::ref_ptr<GpuTimer> timer);
+}
+
+#endif
@@ -0,0 +1,157 @@
+#include "incrementalcompileoperation.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/Stats>
+#include <osg/Texture>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using CompileSet = osgUtil::IncrementalCompileOperation::CompileSet;
+        using CompileSets = osgUtil::IncrementalCompileOperation::CompileSets;
+
+        std::size_t estimateSize(const osg::Drawable& drawable)
+        {
+            const osg::Geometry* const geometry = drawable.asGeometry();
+            if (geometry == nullptr)
+                return 0;
+            std::size_t result = 0;
+            osg::Geometry::ArrayList arrays;
+            geometry->getArrayList(arrays);
+            for (const osg::ref_ptr<osg::Array>& array : arrays)
+                result += array->getTotalDataSize();
+            for (unsigned i = 0; i < geometry->getNumPrimitiveSets(); ++i)
+                result += geometry->getPrimitiveSet(i)->getTotalDataSize();
+            return result;
+        }
+
+        std::size_t estimateSize(const osg::Texture& texture)
+        {
+            std::size_t result = 0;
+            for (unsigned i = 0; i < texture.getNumImages(); ++i)
+                if (const osg::Image* const image = texture.getImage(i))
+                    result += image->getTotalSizeInBytesIncludingMipmaps();
+            return result;
+        }
+
+        // Only what is left to compile for the context, compiled operations are removed from the list
+        std::size_t estimateSize(const CompileSet& compileSet, osg::GraphicsContext* context)
+        {
+            const auto it = compileSet._compileMap.find(context);
+            if (it == compileSet._compileMap.end())
+                return 0;
+            std::size_t result = 0;
+            for (const auto& op : it->second._compileOps)
+            {
+                using Base = osgUtil::IncrementalCompileOperation;
+                if (const auto* drawableOp = dynamic_cast<const Base::CompileDrawableOp*>(op.get()))
+                    result += estimateSize(*drawableOp->_drawable);
+                else if (const auto* textureOp = dynamic_cast<const Base::CompileTextureOp*>(op.get()))
+                    result += estimateSize(*textureOp->_texture);
+            }
+            return result;
+        }
+    }
+
+    void IncrementalCompileOperation::add(CompileSet* compileSet, const osg::Vec3f& position)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mPositions.insert_or_assign(compileSet, position);
+        }
+        add(compileSet, false);
+    }
+
+    void IncrementalCompileOperation::setViewPoint(const osg::Vec3f& viewPoint)
+    {
+        const std::lock_guard lock(mMutex);
+        mViewPoint = viewPoint;
+    }
+
+    void IncrementalCompileOperation::operator()(osg::GraphicsContext* context)
+    {
+        const std::size_t maxBytes = mMaxBytesPerFrame;
+        std::vector<std::pair<osg::ref_ptr<CompileSet>, std::size_t>> scheduled;
+        CompileSets deferred;
+        std::size_t queuedBytes = 0;
+        std::size_t scheduledBytes = 0;
+
+        {
+            const std::lock_guard lock(*getToCompiledMutex());
+
+            prioritize();
+
+            for (auto it = _toCompile.begin(); it != _toCompile.end();)
+            {
+                const std::size_t size = estimateSize(**it, context);
+                queuedBytes += size;
+                // Keep the order, a distant set should not be compiled before a close one only because it's smaller
+                if (!deferred.empty() || (maxBytes != 0 && !scheduled.empty() && scheduledBytes + size > maxBytes))
+                {
+                    deferred.splice(deferred.end(), _toCompile, it++);
+                    continue;
+                }
+                scheduled.emplace_back(*it, size);
+                scheduledBytes += size;
+                ++it;
+            }
+        }
+
+        osgUtil::IncrementalCompileOperation::operator()(context);
+
+        std::size_t uploadedBytes = 0;
+
+        {
+            const std::lock_guard lock(*getToCompiledMutex());
+
+            for (const auto& [compileSet, size] : scheduled)
+                uploadedBytes += size - std::min(size, estimateSize(*compileSet, context));
+
+            // Not completed scheduled sets are still first, put the deferred ones right after them and before the sets
+            // added meanwhile
+            auto position = _toCompile.begin();
+            for (const auto& [compileSet, size] : scheduled)
+                if (position != _toCompile.end() && *position == compileSet)
+                    ++position;
+            _toCompile.splice(position, deferred);
+        }
+
+        mQueuedBytes = queuedBytes;
+        mUploadedBytes = uploadedBytes;
+    }
+
+    void IncrementalCompileOperation::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Compiling Queued", static_cast<double>(mQueuedBytes.load()));
+        stats.setAttribute(frameNumber, "Compiling Uploaded", static_cast<double>(mUploadedBytes.load()));
+    }
+
+    void IncrementalCompileOperation::prioritize()
+    {
+        const std::lock_guard lock(mMutex);
+
+        // Drop positions of sets compiled and already released by the base class or removed from the queue
+        std::erase_if(mPositions, [](const auto& v) { return v.first->referenceCount() == 1; });
+
+        if (mPositions.empty())
+            return;
+
+        const auto getPriority = [&](const osg::ref_ptr<CompileSet>& compileSet) {
+            const auto it = mPositions.find(compileSet);
+            if (it == mPositions.end())
+                return 0.0f;
+            return (it->second - mViewPoint).length2();
+        };
+
+        // Stable, sets at the same distance and sets without position keep the order of addition
+        _toCompile.sort([&](const osg::ref_ptr<CompileSet>& l, const osg::ref_ptr<CompileSet>& r) {
+            return getPriority(l) < getPriority(r);
+        });
+    }
+}
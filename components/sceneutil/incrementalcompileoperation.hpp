@@ -0,0 +1,61 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_INCREMENTALCOMPILEOPERATION_H
+#define OPENMW_COMPONENTS_SCENEUTIL_INCREMENTALCOMPILEOPERATION_H
+
+#include <osg/Vec3f>
+#include <osg/ref_ptr>
+
+#include <osgUtil/IncrementalCompileOperation>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    /// @brief IncrementalCompileOperation limiting the estimated amount of data uploaded to the GPU each frame.
+    /// @par Queued compile sets are compiled in order of distance from the view point, sets added without a position
+    /// (like templates of preloaded models) go first in order of addition. Sets that don't fit into the per frame
+    /// budget are left for the following frames, but at least one set is always compiled. The time spent on compiling
+    /// is limited by the base class according to the target frame rate.
+    class IncrementalCompileOperation : public osgUtil::IncrementalCompileOperation
+    {
+    public:
+        /// Add a set to compile placed at the given position in world space. Safe to call from any thread.
+        void add(CompileSet* compileSet, const osg::Vec3f& position);
+
+        using osgUtil::IncrementalCompileOperation::add;
+
+        /// Set the position to prioritize compile sets by. Safe to call from any thread.
+        void setViewPoint(const osg::Vec3f& viewPoint);
+
+        /// @param value estimated size in bytes, 0 means no limit
+        void setMaxBytesPerFrame(std::size_t value) { mMaxBytesPerFrame = value; }
+
+        std::size_t getMaxBytesPerFrame() const { return mMaxBytesPerFrame; }
+
+        void operator()(osg::GraphicsContext* context) override;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    protected:
+        ~IncrementalCompileOperation() override = default;
+
+    private:
+        mutable std::mutex mMutex;
+        osg::Vec3f mViewPoint;
+        std::map<osg::ref_ptr<CompileSet>, osg::Vec3f> mPositions;
+        std::atomic_size_t mMaxBytesPerFrame{ 0 };
+        std::atomic_size_t mQueuedBytes{ 0 };
+        std::atomic_size_t mUploadedBytes{ 0 };
+
+        void prioritize();
+    };
+}
+
+#endif
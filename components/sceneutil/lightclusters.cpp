@@ -0,0 +1,117 @@
+#include "lightclusters.hpp"
+
+#include <osg/Vec4f>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        int getTile(float ndc, int size)
+        {
+            return std::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * size)), 0, size - 1);
+        }
+    }
+
+    LightClusters::LightClusters(int maxLightsPerCluster)
+        : mMaxLights(maxLightsPerCluster)
+        , mData(static_cast<std::size_t>(sCount * getRowSize()), 0.f)
+    {
+    }
+
+    void LightClusters::reset(const osg::Matrixf& projection)
+    {
+        mProjection = projection;
+        for (int cluster = 0; cluster < sCount; ++cluster)
+            mData[static_cast<std::size_t>(cluster * getRowSize())] = 0.f;
+    }
+
+    void LightClusters::addLight(const osg::BoundingSphere& viewBound, int index)
+    {
+        // The camera looks towards -z
+        const osg::Vec3f& center = viewBound.center();
+        const float radius = viewBound.radius();
+        const float minDepth = -center.z() - radius;
+        const float maxDepth = -center.z() + radius;
+        if (maxDepth <= 0)
+            return;
+
+        // Project the corners of the bounding box of the sphere part in front of the camera
+        constexpr float minVisibleDepth = 1e-3f;
+        float ndcMinX = std::numeric_limits<float>::max();
+        float ndcMinY = std::numeric_limits<float>::max();
+        float ndcMaxX = std::numeric_limits<float>::lowest();
+        float ndcMaxY = std::numeric_limits<float>::lowest();
+        for (const float depth : { std::max(minDepth, minVisibleDepth), maxDepth })
+        {
+            for (const float x : { center.x() - radius, center.x() + radius })
+            {
+                for (const float y : { center.y() - radius, center.y() + radius })
+                {
+                    const osg::Vec4f clip = osg::Vec4f(x, y, -depth, 1.f) * mProjection;
+                    const float ndcX = clip.x() / clip.w();
+                    const float ndcY = clip.y() / clip.w();
+                    ndcMinX = std::min(ndcMinX, ndcX);
+                    ndcMinY = std::min(ndcMinY, ndcY);
+                    ndcMaxX = std::max(ndcMaxX, ndcX);
+                    ndcMaxY = std::max(ndcMaxY, ndcY);
+                }
+            }
+        }
+
+        if (ndcMaxX < -1.f || ndcMaxY < -1.f || ndcMinX > 1.f || ndcMinY > 1.f)
+            return;
+
+        const int minX = getTile(ndcMinX, sSizeX);
+        const int maxX = getTile(ndcMaxX, sSizeX);
+        const int minY = getTile(ndcMinY, sSizeY);
+        const int maxY = getTile(ndcMaxY, sSizeY);
+        const int minZ = getSlice(minDepth);
+        const int maxZ = getSlice(maxDepth);
+
+        for (int z = minZ; z <= maxZ; ++z)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                for (int x = minX; x <= maxX; ++x)
+                {
+                    float* const row = mData.data() + ((z * sSizeY + y) * sSizeX + x) * getRowSize();
+                    const int count = static_cast<int>(row[0]);
+                    if (count >= mMaxLights)
+                        continue;
+                    row[count + 1] = static_cast<float>(index);
+                    row[0] = static_cast<float>(count + 1);
+                }
+            }
+        }
+    }
+
+    int LightClusters::getCluster(const osg::Vec3f& viewPos) const
+    {
+        const osg::Vec4f clip = osg::Vec4f(viewPos, 1.f) * mProjection;
+        const int x = getTile(clip.x() / clip.w(), sSizeX);
+        const int y = getTile(clip.y() / clip.w(), sSizeY);
+        const int z = getSlice(-viewPos.z());
+        return (z * sSizeY + y) * sSizeX + x;
+    }
+
+    std::span<const float> LightClusters::getLights(int cluster) const
+    {
+        const float* const row = mData.data() + cluster * getRowSize();
+        return std::span(row + 1, static_cast<std::size_t>(row[0]));
+    }
+
+    float LightClusters::getDepthScale()
+    {
+        return sSizeZ / std::log(sFar / sNear);
+    }
+
+    int LightClusters::getSlice(float depth)
+    {
+        const float slice = std::floor(std::log(std::max(depth, sNear) / sNear) * getDepthScale());
+        return std::min(static_cast<int>(slice), sSizeZ - 1);
+    }
+}
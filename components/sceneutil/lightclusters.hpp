@@ -0,0 +1,59 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTCLUSTERS_H
+#define OPENMW_COMPONENTS_SCENEUTIL_LIGHTCLUSTERS_H
+
+#include <osg/BoundingSphere>
+#include <osg/Matrixf>
+
+#include <span>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Point lights assigned to view space clusters: a grid over the screen split into depth slices growing
+    /// exponentially with the distance to the camera.
+    /// @par Each cluster is a row of the data, the number of lights followed by their indices. Shaders find the
+    /// cluster of a fragment with lib/light/lighting_util.glsl, which must match getCluster.
+    class LightClusters
+    {
+    public:
+        static constexpr int sSizeX = 16;
+        static constexpr int sSizeY = 9;
+        static constexpr int sSizeZ = 24;
+        static constexpr int sCount = sSizeX * sSizeY * sSizeZ;
+
+        // Depth range of the slices, closer and further fragments use the first and the last slice
+        static constexpr float sNear = 16.f;
+        static constexpr float sFar = 16384.f;
+
+        explicit LightClusters(int maxLightsPerCluster);
+
+        int getMaxLightsPerCluster() const { return mMaxLights; }
+
+        int getRowSize() const { return mMaxLights + 1; }
+
+        /// Remove all lights, the projection is used by the following calls of addLight.
+        void reset(const osg::Matrixf& projection);
+
+        /// Add a light to every cluster intersecting the bounds, unless they are already full.
+        /// @param viewBound Bounds of the light in view space
+        void addLight(const osg::BoundingSphere& viewBound, int index);
+
+        int getCluster(const osg::Vec3f& viewPos) const;
+
+        std::span<const float> getLights(int cluster) const;
+
+        const std::vector<float>& getData() const { return mData; }
+
+        /// Factor converting log(depth / sNear) to a slice
+        static float getDepthScale();
+
+    private:
+        int mMaxLights;
+        osg::Matrixf mProjection;
+        std::vector<float> mData;
+
+        static int getSlice(float depth);
+    };
+}
+
+#endif
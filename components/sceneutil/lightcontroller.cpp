@@ -12,7 +12,8 @@ namespace SceneUtil
 {
 
     LightController::LightController()
-        : mType(LT_Normal)
+        : mPrng(Misc::Rng::getGenerator()())
+        , mType(LT_Normal)
         , mPhase(0.25f + Misc::Rng::rollClosedProbability() * 0.75f)
         , mBrightness(0.675f)
         , mStartTime(0.0)
@@ -28,7 +29,20 @@ namespace SceneUtil
 
     void LightController::operator()(SceneUtil::LightSource* node, osg::NodeVisitor* nv)
     {
-        double time = nv->getFrameStamp()->getSimulationTime();
+        if (!ParallelUpdateVisitor::isUpdated(*node, *this, *this, nv))
+            update(*node, *nv);
+        traverse(node, nv);
+    }
+
+    bool LightController::updateParallel(osg::Node& node, osg::NodeVisitor& nv)
+    {
+        update(static_cast<SceneUtil::LightSource&>(node), nv);
+        return true;
+    }
+
+    void LightController::update(SceneUtil::LightSource& node, osg::NodeVisitor& nv)
+    {
+        double time = nv.getFrameStamp()->getSimulationTime();
         if (mStartTime == 0)
             mStartTime = time;
 
@@ -36,13 +50,12 @@ namespace SceneUtil
         // if (time == mLastTime)
         //    return;
 
-        osg::Light* light = node->getLight(nv->getTraversalNumber());
+        osg::Light* light = node.getLight(nv.getTraversalNumber());
 
         if (mType == LT_Normal)
         {
             light->setDiffuse(mDiffuseColor);
             light->setSpecular(mSpecularColor);
-            traverse(node, nv);
             return;
         }
 
@@ -61,17 +74,15 @@ namespace SceneUtil
         if (std::abs(mBrightness - mPhase) < speed)
         {
             if (mType == LT_Flicker || mType == LT_FlickerSlow)
-                mPhase = 0.25f + Misc::Rng::rollClosedProbability() * 0.75f;
+                mPhase = 0.25f + Misc::Rng::rollClosedProbability(mPrng) * 0.75f;
             else // if (mType == LT_Pulse || mType == LT_PulseSlow)
                 mPhase = mPhase <= 0.5f ? 1.f : 0.25f;
         }
 
-        const float result = mBrightness * node->getActorFade();
+        const float result = mBrightness * node.getActorFade();
 
         light->setDiffuse(mDiffuseColor * result);
         light->setSpecular(mSpecularColor * result);
-
-        traverse(node, nv);
     }
 
     void LightController::setDiffuse(const osg::Vec4f& color)
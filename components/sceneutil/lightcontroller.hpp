@@ -1,7 +1,9 @@
 #ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTCONTROLLER_H
 #define OPENMW_COMPONENTS_SCENEUTIL_LIGHTCONTROLLER_H
 
+#include <components/misc/rng.hpp>
 #include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/parallelupdate.hpp>
 #include <osg/Vec4f>
 
 namespace SceneUtil
@@ -10,7 +12,9 @@ namespace SceneUtil
     class LightSource;
 
     /// @brief Controller class to handle a pulsing and/or flickering light
-    class LightController : public SceneUtil::NodeCallback<LightController, SceneUtil::LightSource*>
+    /// @note Runs in the parallel update phase, see ParallelUpdateVisitor.
+    class LightController : public SceneUtil::NodeCallback<LightController, SceneUtil::LightSource*>,
+                            public ParallelUpdateCallback
     {
     public:
         enum LightType
@@ -31,7 +35,11 @@ namespace SceneUtil
 
         void operator()(SceneUtil::LightSource* node, osg::NodeVisitor* nv);
 
+        bool updateParallel(osg::Node& node, osg::NodeVisitor& nv) override;
+
     private:
+        // Updates may run on any thread, so don't use the shared generator
+        Misc::Rng::Generator mPrng;
         LightType mType;
         osg::Vec4f mDiffuseColor;
         osg::Vec4f mSpecularColor;
@@ -40,6 +48,8 @@ namespace SceneUtil
         double mStartTime;
         double mLastTime;
         float mTicksToAdvance;
+
+        void update(SceneUtil::LightSource& node, osg::NodeVisitor& nv);
     };
 
 }
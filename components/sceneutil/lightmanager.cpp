@@ -2,19 +2,23 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <iterator>
 
 #include <osg/BufferIndexBinding>
 #include <osg/BufferObject>
 #include <osg/Endian>
+#include <osg/Texture2D>
 #include <osg/ValueObject>
 
 #include <osgUtil/CullVisitor>
 
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/lightclusters.hpp>
 #include <components/sceneutil/util.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/shader/shadermanager.hpp>
 
 #include <components/misc/constants.hpp>
@@ -73,6 +77,15 @@ namespace SceneUtil
             { "shaders compatibility", LightingMethod::PerObjectUniform },
             { "shaders", LightingMethod::SingleUBO },
         };
+
+        // Largest scale of the matrix axes, as used by transformBoundingSphere
+        float getMaxScale(const osg::Matrixf& matrix)
+        {
+            const float x = osg::Vec3f(matrix(0, 0), matrix(0, 1), matrix(0, 2)).length2();
+            const float y = osg::Vec3f(matrix(1, 0), matrix(1, 1), matrix(1, 2)).length2();
+            const float z = osg::Vec3f(matrix(2, 0), matrix(2, 1), matrix(2, 2)).length2();
+            return std::sqrt(std::max({ x, y, z }));
+        }
     }
 
     static int sLightId = 0;
@@ -605,6 +618,65 @@ namespace SceneUtil
         }
     };
 
+    namespace
+    {
+        class AssignLightClusters : public WorkItem
+        {
+        public:
+            AssignLightClusters(LightClusters& clusters, const osg::Matrixf& projection, osg::Image& image)
+                : mClusters(clusters)
+                , mProjection(projection)
+                , mImage(image)
+            {
+            }
+
+            void addLight(const osg::BoundingSphere& viewBound, int index) { mLights.emplace_back(viewBound, index); }
+
+            osg::Image& getImage() { return mImage; }
+
+            void doWork() override
+            {
+                mClusters.reset(mProjection);
+                for (const auto& [viewBound, index] : mLights)
+                    mClusters.addLight(viewBound, index);
+                const std::vector<float>& data = mClusters.getData();
+                std::memcpy(mImage.data(), data.data(), data.size() * sizeof(float));
+            }
+
+        private:
+            LightClusters& mClusters;
+            const osg::Matrixf mProjection;
+            osg::Image& mImage;
+            std::vector<std::pair<osg::BoundingSphere, int>> mLights;
+        };
+    }
+
+    struct LightClusterData
+    {
+        LightClusters mClusters;
+        // Double buffered, the texture of the previous frame can still be in use by the draw traversal
+        std::array<osg::ref_ptr<osg::Texture2D>, 2> mTextures;
+        osg::ref_ptr<AssignLightClusters> mPending;
+
+        explicit LightClusterData(int maxLights)
+            : mClusters(maxLights)
+        {
+            for (auto& texture : mTextures)
+            {
+                osg::ref_ptr<osg::Image> image = new osg::Image;
+                image->allocateImage(mClusters.getRowSize(), LightClusters::sCount, 1, GL_LUMINANCE, GL_FLOAT);
+                image->setInternalTextureFormat(GL_LUMINANCE32F_ARB);
+                texture = new osg::Texture2D(image);
+                texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+                texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+                texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+                texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+                texture->setResizeNonPowerOfTwoHint(false);
+                texture->setUnRefImageDataAfterApply(false);
+            }
+        }
+    };
+
     class LightManagerCullCallback
         : public SceneUtil::NodeCallback<LightManagerCullCallback, LightManager*, osgUtil::CullVisitor*>
     {
@@ -641,6 +713,9 @@ namespace SceneUtil
                     buffer->setDiffuse(0, sun->getDiffuse());
                     buffer->setSpecular(0, sun->getSpecular());
                 }
+
+                if (node->usingClusters() && (cv->getTraversalMask() & node->getLightingMask()))
+                    node->updateLightClusters(cv, *stateset);
             }
             else if (node->getLightingMethod() == LightingMethod::PerObjectUniform)
             {
@@ -661,6 +736,9 @@ namespace SceneUtil
             traverse(node, cv);
             cv->popStateSet();
 
+            if (node->usingClusters())
+                node->finishLightClusters(cv);
+
             if (node->getPPLightsBuffer() && cv->getCurrentCamera()->getName() == Constants::SceneCamera)
                 node->getPPLightsBuffer()->updateCount(cv->getTraversalNumber());
         }
@@ -851,6 +929,10 @@ namespace SceneUtil
             else
                 initSingleUBO(settings.mMaxLights);
 
+            if (settings.mClusteredLighting && settings.mLightClustersTextureUnit >= 0
+                && getLightingMethod() == LightingMethod::SingleUBO)
+                initLightClusters(settings.mLightClustersTextureUnit);
+
             getOrCreateStateSet()->addUniform(new osg::Uniform("PointLightCount", 0));
 
             addCullCallback(new LightManagerCullCallback(this));
@@ -870,6 +952,9 @@ namespace SceneUtil
         , mPointLightFadeStart(copy.mPointLightFadeStart)
         , mMaxLights(copy.mMaxLights)
         , mPPLightBuffer(copy.mPPLightBuffer)
+        , mClusteredLighting(copy.mClusteredLighting)
+        , mLightClustersTextureUnit(copy.mLightClustersTextureUnit)
+        , mLightClustersQueue(copy.mLightClustersQueue)
     {
     }
 
@@ -908,6 +993,10 @@ namespace SceneUtil
         defines["lightingMethodFFP"] = getLightingMethod() == LightingMethod::FFP ? "1" : "0";
         defines["lightingMethodPerObjectUniform"] = getLightingMethod() == LightingMethod::PerObjectUniform ? "1" : "0";
         defines["lightingMethodUBO"] = getLightingMethod() == LightingMethod::SingleUBO ? "1" : "0";
+        defines["lightingMethodClustered"] = usingClusters() ? "1" : "0";
+        defines["lightClusterSizeX"] = std::to_string(LightClusters::sSizeX);
+        defines["lightClusterSizeY"] = std::to_string(LightClusters::sSizeY);
+        defines["lightClusterSizeZ"] = std::to_string(LightClusters::sSizeZ);
         defines["useUBO"] = std::to_string(getLightingMethod() == LightingMethod::SingleUBO);
         // exposes bitwise operators
         defines["useGPUShader4"] = std::to_string(getLightingMethod() == LightingMethod::SingleUBO);
@@ -939,6 +1028,8 @@ namespace SceneUtil
 
         for (auto& cache : mStateSetCache)
             cache.clear();
+
+        mLightClusters.clear();
     }
 
     void LightManager::updateSettings(float lightBoundsMultiplier, float maximumLightDistance, float lightFadeStart)
@@ -975,6 +1066,19 @@ namespace SceneUtil
         getOrCreateStateSet()->setAttributeAndModes(mUBOManager);
     }
 
+    void LightManager::initLightClusters(int textureUnit)
+    {
+        mClusteredLighting = true;
+        mLightClustersTextureUnit = textureUnit;
+
+        mLightClustersQueue = new WorkQueue(1);
+
+        osg::StateSet* stateset = getOrCreateStateSet();
+        stateset->addUniform(new osg::Uniform("LightClusters", textureUnit));
+        stateset->addUniform(new osg::Uniform(
+            "LightClusterDepth", osg::Vec2f(LightClusters::sNear, LightClusters::getDepthScale())));
+    }
+
     void LightManager::setLightingMethod(LightingMethod method)
     {
         mLightingMethod = method;
@@ -1034,6 +1138,14 @@ namespace SceneUtil
         mLights.clear();
         mLightsInViewSpace.clear();
 
+        for (auto it = mLightClusters.begin(); it != mLightClusters.end();)
+        {
+            if (!it->first.valid())
+                it = mLightClusters.erase(it);
+            else
+                ++it;
+        }
+
         // Do an occasional cleanup for orphaned lights.
         for (int i = 0; i < 2; ++i)
         {
@@ -1047,6 +1159,8 @@ namespace SceneUtil
         LightSourceTransform l;
         l.mLightSource = lightSource;
         l.mWorldMatrix = worldMat;
+        l.mWorldBound = osg::BoundingSphere(osg::Vec3f(), lightSource->getRadius() * mPointLightRadiusMultiplier);
+        transformBoundingSphere(worldMat, l.mWorldBound);
         osg::Vec3f pos = osg::Vec3f(worldMat.getTrans().x(), worldMat.getTrans().y(), worldMat.getTrans().z());
         lightSource->getLight(frameNum)->setPosition(osg::Vec4f(pos, 1.f));
 
@@ -1130,15 +1244,15 @@ namespace SceneUtil
         if (it == mLightsInViewSpace.end())
         {
             it = mLightsInViewSpace.insert(std::make_pair(camPtr, LightSourceViewBoundCollection())).first;
+            it->second.reserve(mLights.size());
+
+            // Only the centers of the world bounds need to be transformed for every camera
+            const float viewScale = getMaxScale(*viewMatrix);
 
             for (const auto& transform : mLights)
             {
-                osg::Matrixf worldViewMat = transform.mWorldMatrix * (*viewMatrix);
-
-                float radius = transform.mLightSource->getRadius();
-
-                osg::BoundingSphere viewBound(osg::Vec3f(), radius * mPointLightRadiusMultiplier);
-                transformBoundingSphere(worldViewMat, viewBound);
+                const osg::BoundingSphere viewBound(
+                    transform.mWorldBound.center() * (*viewMatrix), transform.mWorldBound.radius() * viewScale);
 
                 if (transform.mLightSource->getLastAppliedFrame() != frameNum && mPointLightFadeEnd != 0.f)
                 {
@@ -1202,6 +1316,68 @@ namespace SceneUtil
         return it->second;
     }
 
+    void LightManager::updateLightClusters(osgUtil::CullVisitor* cv, osg::StateSet& stateset)
+    {
+        const size_t frameNum = cv->getTraversalNumber();
+        const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
+        const osg::Matrixf projection(*cv->getProjectionMatrix());
+
+        std::unique_ptr<LightClusterData>& data = mLightClusters[cv->getCurrentCamera()];
+        if (data == nullptr)
+            data = std::make_unique<LightClusterData>(getMaxLights());
+        else
+            finishLightClusters(cv);
+
+        // Clusters keep the first lights added when they are full, so start with the closest ones
+        const std::vector<LightSourceViewBound>& lights = getLightsInViewSpace(cv, viewMatrix, frameNum);
+        LightList sorted;
+        sorted.reserve(lights.size());
+        for (const LightSourceViewBound& light : lights)
+            sorted.push_back(&light);
+        std::sort(sorted.begin(), sorted.end(), [](const LightSourceViewBound* left, const LightSourceViewBound* right) {
+            return left->mViewBound.center().length2() - left->mViewBound.radius2()
+                < right->mViewBound.center().length2() - right->mViewBound.radius2();
+        });
+
+        osg::Texture2D* texture = data->mTextures[frameNum % 2];
+        osg::ref_ptr<AssignLightClusters> assign
+            = new AssignLightClusters(data->mClusters, projection, *texture->getImage());
+        LightIndexMap& indexMap = getLightIndexMap(frameNum);
+        for (const LightSourceViewBound* light : sorted)
+        {
+            const int id = light->mLightSource->getId();
+            auto it = indexMap.find(id);
+            if (it == indexMap.end())
+            {
+                // The first index of the buffer is the sun
+                const int index = static_cast<int>(indexMap.size()) + 1;
+                if (index >= getMaxLightsInScene())
+                    break;
+                updateGPUPointLight(index, light->mLightSource, frameNum, viewMatrix);
+                it = indexMap.emplace(id, index).first;
+            }
+            assign->addLight(light->mViewBound, it->second);
+        }
+
+        // The clusters are only needed by the draw traversal, so fill them while the scene below is culled
+        mLightClustersQueue->addWorkItem(assign, true);
+        data->mPending = std::move(assign);
+
+        stateset.setTextureAttribute(mLightClustersTextureUnit, texture, osg::StateAttribute::ON);
+        stateset.addUniform(new osg::Uniform("LightClusterProjection", projection));
+    }
+
+    void LightManager::finishLightClusters(osgUtil::CullVisitor* cv)
+    {
+        const auto it = mLightClusters.find(cv->getCurrentCamera());
+        if (it == mLightClusters.end() || it->second->mPending == nullptr)
+            return;
+
+        it->second->mPending->waitTillDone();
+        it->second->mPending->getImage().dirty();
+        it->second->mPending = nullptr;
+    }
+
     void LightManager::updateGPUPointLight(
         int index, LightSource* lightSource, size_t frameNum, const osg::RefMatrix* viewMatrix)
     {
@@ -1273,6 +1449,10 @@ namespace SceneUtil
         if (!(cv->getTraversalMask() & mLightManager->getLightingMask()))
             return false;
 
+        // All lights are already available through the clusters
+        if (mLightManager->usingClusters())
+            return false;
+
         // Possible optimizations:
         // - organize lights in a quad tree
 
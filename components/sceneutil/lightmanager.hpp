@@ -18,7 +18,9 @@
 namespace SceneUtil
 {
     class LightBuffer;
+    struct LightClusterData;
     struct StateSetGenerator;
+    class WorkQueue;
 
     class PPLightBuffer
     {
@@ -187,6 +189,9 @@ namespace SceneUtil
         float mMaximumLightDistance = 0;
         float mLightFadeStart = 0;
         float mLightBoundsMultiplier = 0;
+        // Only used with LightingMethod::SingleUBO
+        bool mClusteredLighting = false;
+        int mLightClustersTextureUnit = -1;
     };
 
     /// @brief Decorator node implementing the rendering of any number of LightSources that can be anywhere in the
@@ -202,6 +207,8 @@ namespace SceneUtil
         {
             LightSource* mLightSource;
             osg::Matrixf mWorldMatrix;
+            // Computed once per frame and shared by all cameras
+            osg::BoundingSphere mWorldBound;
         };
 
         struct LightSourceViewBound
@@ -234,6 +241,12 @@ namespace SceneUtil
         /// Internal use only, called automatically by the LightManager's UpdateCallback
         void update(size_t frameNum);
 
+        /// Internal use only, called automatically by the LightManager's CullCallback
+        void updateLightClusters(osgUtil::CullVisitor* cv, osg::StateSet& stateset);
+
+        /// Internal use only, waits for the clusters assigned by updateLightClusters once the camera was traversed
+        void finishLightClusters(osgUtil::CullVisitor* cv);
+
         /// Internal use only, called automatically by the LightSource's UpdateCallback
         void addLight(LightSource* lightSource, const osg::Matrixf& worldMat, size_t frameNum);
 
@@ -248,6 +261,9 @@ namespace SceneUtil
 
         bool usingFFP() const;
 
+        /// Whether lights are assigned to view space clusters instead of light lists, see LightClusters
+        bool usingClusters() const { return mClusteredLighting; }
+
         LightingMethod getLightingMethod() const;
 
         int getMaxLights() const;
@@ -283,6 +299,7 @@ namespace SceneUtil
         void initFFP(int targetLights);
         void initPerObjectUniform(int targetLights);
         void initSingleUBO(int targetLights);
+        void initLightClusters(int textureUnit);
 
         void updateSettings(float lightBoundsMultiplier, float maximumLightDistance, float lightFadeStart);
 
@@ -334,6 +351,12 @@ namespace SceneUtil
         SupportedMethods mSupported;
 
         std::shared_ptr<PPLightBuffer> mPPLightBuffer;
+
+        bool mClusteredLighting = false;
+        int mLightClustersTextureUnit = -1;
+        std::map<osg::observer_ptr<osg::Camera>, std::unique_ptr<LightClusterData>> mLightClusters;
+        // Assigns lights to clusters while the cull traversal of the camera goes on
+        osg::ref_ptr<WorkQueue> mLightClustersQueue;
     };
 
     /// To receive lighting, objects must be decorated by a LightListCallback. Light list callbacks must be added via
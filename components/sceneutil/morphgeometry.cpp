@@ -2,11 +2,17 @@
 
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
 #include <cassert>
 #include <components/resource/scenemanager.hpp>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        // Widely supported maximum size of a texture side
+        constexpr unsigned maxMorphTextureSize = 4096;
+    }
 
     MorphGeometry::MorphGeometry()
         : mLastFrameNumber(0)
@@ -21,6 +27,10 @@ namespace SceneUtil
         , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
+        , mGpuMorphing(copy.mGpuMorphing)
+        , mMorphTextureUnit(copy.mMorphTextureUnit)
+        , mMorphTexture(copy.mMorphTexture)
+        , mVertexIndices(copy.mVertexIndices)
     {
         setSourceGeometry(copy.getSourceGeometry());
     }
@@ -49,6 +59,28 @@ namespace SceneUtil
             to.setUseVertexBufferObjects(true);
             to.setCullingActive(false); // make sure to disable culling since that's handled by this class
 
+            if (mGpuMorphing)
+            {
+                // the base target is only read by the vertex shader, so it can be shared
+                to.setVertexArray(mMorphTargets[0].getOffsets());
+                to.setVertexAttribArray(sVertexIndexAttribute, mVertexIndices, osg::Array::BIND_PER_VERTEX);
+
+                const osg::Image& image = *mMorphTexture->getImage();
+                osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+                stateSet->setTextureAttribute(mMorphTextureUnit, mMorphTexture, osg::StateAttribute::ON);
+                stateSet->addUniform(new osg::Uniform("useGpuMorphing", true));
+                stateSet->addUniform(new osg::Uniform("morphTargets", mMorphTextureUnit));
+                stateSet->addUniform(new osg::Uniform("morphTextureLayout",
+                    osg::Vec3f(static_cast<float>(image.s()), static_cast<float>(image.t()),
+                        static_cast<float>(image.t() / (mMorphTargets.size() - 1)))));
+                stateSet->addUniform(new osg::Uniform("morphTargetCount", static_cast<int>(mMorphTargets.size() - 1)));
+                stateSet->addUniform(
+                    new osg::Uniform(osg::Uniform::FLOAT, "morphWeights", static_cast<int>(sMaxGpuMorphTargets)));
+                mMorphStateSet[i] = std::move(stateSet);
+                continue;
+            }
+            mMorphStateSet[i] = nullptr;
+
             // vertices are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
             osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
@@ -69,6 +101,9 @@ namespace SceneUtil
         mMorphTargets.push_back(MorphTarget(offsets, weight));
         mMorphedBoundingBox = false;
         dirty();
+
+        if (mGpuMorphing)
+            setGpuMorphing(false, mMorphTextureUnit);
     }
 
     void MorphGeometry::dirty()
@@ -174,15 +209,22 @@ namespace SceneUtil
     {
         if (mLastFrameNumber == nv->getTraversalNumber() || !mDirty || mMorphTargets.size() == 0)
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
+            draw(nv, mLastFrameNumber);
             return;
         }
 
         mDirty = false;
         mLastFrameNumber = nv->getTraversalNumber();
+
+        if (mGpuMorphing)
+        {
+            osg::Uniform* weights = mMorphStateSet[mLastFrameNumber % 2]->getUniform("morphWeights");
+            for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
+                weights->setElement(i - 1, mMorphTargets[i].getWeight());
+            draw(nv, mLastFrameNumber);
+            return;
+        }
+
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
         const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
@@ -205,9 +247,93 @@ namespace SceneUtil
 
         geom.osg::Drawable::dirtyGLObjects();
 
+        draw(nv, mLastFrameNumber);
+    }
+
+    void MorphGeometry::draw(osg::NodeVisitor* nv, unsigned int frame)
+    {
+        osg::Geometry& geom = *getGeometry(frame);
+        osg::StateSet* morphStateSet = mMorphStateSet[frame % 2].get();
+        osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(nv);
+        if (morphStateSet)
+            cv->pushStateSet(morphStateSet);
         nv->pushOntoNodePath(&geom);
         nv->apply(geom);
         nv->popFromNodePath();
+        if (morphStateSet)
+            cv->popStateSet();
+    }
+
+    void MorphGeometry::setGpuMorphing(bool enabled, int textureUnit)
+    {
+        if (enabled == mGpuMorphing && (!enabled || textureUnit == mMorphTextureUnit))
+            return;
+
+        if (enabled && (mMorphTargets.size() < 2 || mMorphTargets.size() - 1 > sMaxGpuMorphTargets || !mSourceGeometry))
+            return;
+
+        mMorphTextureUnit = textureUnit;
+        if (enabled && mMorphTexture == nullptr && !buildMorphTexture())
+            return;
+        if (!enabled)
+        {
+            mMorphTexture = nullptr;
+            mVertexIndices = nullptr;
+        }
+
+        mGpuMorphing = enabled;
+        // The weights need to be set on the new state sets
+        mDirty = true;
+        setSourceGeometry(mSourceGeometry);
+    }
+
+    bool MorphGeometry::buildMorphTexture()
+    {
+        const std::size_t vertexCount = mMorphTargets[0].getOffsets()->size();
+        if (vertexCount == 0)
+            return false;
+        for (const MorphTarget& target : mMorphTargets)
+            if (target.getOffsets()->size() != vertexCount)
+                return false;
+
+        // Every target takes the same number of rows, a vertex is at the same texel in each of them
+        const unsigned width = static_cast<unsigned>(std::min<std::size_t>(vertexCount, maxMorphTextureSize));
+        const unsigned rowsPerTarget = static_cast<unsigned>((vertexCount + width - 1) / width);
+        const std::size_t targetCount = mMorphTargets.size() - 1;
+        if (rowsPerTarget * targetCount > maxMorphTextureSize)
+            return false;
+        const unsigned height = static_cast<unsigned>(rowsPerTarget * targetCount);
+
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(width, height, 1, GL_RGB, GL_FLOAT);
+        image->setInternalTextureFormat(GL_RGB32F_ARB);
+        std::fill_n(reinterpret_cast<float*>(image->data()), width * height * 3, 0.f);
+        for (std::size_t i = 0; i < targetCount; ++i)
+        {
+            const osg::Vec3Array& offsets = *mMorphTargets[i + 1].getOffsets();
+            osg::Vec3f* const begin = reinterpret_cast<osg::Vec3f*>(image->data(0, i * rowsPerTarget));
+            std::copy(offsets.begin(), offsets.end(), begin);
+        }
+
+        osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D(image);
+        texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+        texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+        texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        texture->setResizeNonPowerOfTwoHint(false);
+
+        osg::ref_ptr<osg::FloatArray> indices = new osg::FloatArray(static_cast<unsigned>(vertexCount));
+        for (std::size_t i = 0; i < vertexCount; ++i)
+            (*indices)[i] = static_cast<float>(i);
+
+        mMorphTexture = std::move(texture);
+        mVertexIndices = std::move(indices);
+        return true;
+    }
+
+    void MorphGeometry::bindMorphingAttributes(osg::Program& program)
+    {
+        program.addBindAttribLocation("morphVertexIndex", sVertexIndexAttribute);
     }
 
     osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
@@ -2,6 +2,8 @@
 #define OPENMW_COMPONENTS_MORPHGEOMETRY_H
 
 #include <osg/Geometry>
+#include <osg/Program>
+#include <osg/Texture2D>
 
 namespace SceneUtil
 {
@@ -73,8 +75,26 @@ namespace SceneUtil
 
         osg::BoundingBox computeBoundingBox() const override;
 
+        /// Blend the morph targets in the vertex shader instead of on the CPU. The offsets are uploaded once to a
+        /// texture bound to the given unit. Ignored for geometries with more than sMaxGpuMorphTargets targets.
+        /// @note Only valid when the geometry is rendered with a shader including compatibility/morphing.glsl.
+        /// @note Adding a morph target switches back to the CPU.
+        void setGpuMorphing(bool enabled, int textureUnit);
+
+        bool getGpuMorphing() const { return mGpuMorphing; }
+
+        /// Should match the array size in compatibility/morphing.glsl, not counting the base target
+        static constexpr std::size_t sMaxGpuMorphTargets = 32;
+
+        /// Generic vertex attribute location which doesn't alias the fixed function arrays used by OpenMW
+        static constexpr unsigned sVertexIndexAttribute = 1;
+
+        static void bindMorphingAttributes(osg::Program& program);
+
     private:
         void cull(osg::NodeVisitor* nv);
+        void draw(osg::NodeVisitor* nv, unsigned int frame);
+        bool buildMorphTexture();
 
         MorphTargetList mMorphTargets;
 
@@ -86,6 +106,14 @@ namespace SceneUtil
         unsigned int mLastFrameNumber;
         bool mDirty; // Have any morph targets changed?
 
+        bool mGpuMorphing{ false };
+        int mMorphTextureUnit{ 0 };
+        // Offsets of all targets but the base one, shared by copies
+        osg::ref_ptr<osg::Texture2D> mMorphTexture;
+        osg::ref_ptr<osg::FloatArray> mVertexIndices;
+        // Double buffered like mGeometry, holds the weights of the frame
+        osg::ref_ptr<osg::StateSet> mMorphStateSet[2];
+
         mutable bool mMorphedBoundingBox;
     };
 
@@ -26,10 +26,16 @@
 #include <osg/Depth>
 #include <osg/ClipControl>
 
+#include <osg/GLExtensions>
+
+#include <cmath>
 #include <sstream>
 #include <vector>
 
 #include "glextensions.hpp"
+#include "gputimer.hpp"
+#include "morphgeometry.hpp"
+#include "riggeometry.hpp"
 #include "shadowsbin.hpp"
 
 // NOLINTBEGIN(readability-identifier-naming)
@@ -526,6 +532,45 @@ void MWShadowTechnique::LightData::setLightData(osg::RefMatrix* lm, const osg::L
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+//
+// CopyStaticShadowMapCallback
+//
+// Copies the cached static casters into the shadow map before the camera draws the dynamic casters on top.
+class CopyStaticShadowMapCallback : public osg::Camera::DrawCallback
+{
+    public:
+
+        CopyStaticShadowMapCallback(osg::Texture2D* source, osg::Texture2D* destination):
+            _source(new osg::FrameBufferObject),
+            _destination(new osg::FrameBufferObject),
+            _width(source->getTextureWidth()),
+            _height(source->getTextureHeight())
+        {
+            _source->setAttachment(osg::Camera::DEPTH_BUFFER, osg::FrameBufferAttachment(source));
+            _destination->setAttachment(osg::Camera::DEPTH_BUFFER, osg::FrameBufferAttachment(destination));
+        }
+
+        void operator()(osg::RenderInfo& renderInfo) const override
+        {
+            osg::State& state = *renderInfo.getState();
+            osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+
+            _source->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+            glReadBuffer(GL_NONE);
+            _destination->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+            glDrawBuffer(GL_NONE);
+            ext->glBlitFramebuffer(0, 0, _width, _height, 0, 0, _width, _height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        }
+
+    protected:
+
+        osg::ref_ptr<osg::FrameBufferObject>    _source;
+        osg::ref_ptr<osg::FrameBufferObject>    _destination;
+        int                                     _width;
+        int                                     _height;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 //
 // ShadowData
@@ -589,6 +634,8 @@ MWShadowTechnique::ShadowData::ShadowData(MWShadowTechnique::ViewDependentData*
     // set viewport
     _camera->setViewport(0,0,textureSize.x(),textureSize.y());
 
+    addGpuTimer(*_camera, new GpuTimer("Shadows"));
+
 
     if (debug)
     {
@@ -619,11 +666,50 @@ MWShadowTechnique::ShadowData::ShadowData(MWShadowTechnique::ViewDependentData*
     }
 }
 
+void MWShadowTechnique::ShadowData::setupStaticCache()
+{
+    _staticTexture = new osg::Texture2D;
+    _staticTexture->setTextureSize(_texture->getTextureWidth(), _texture->getTextureHeight());
+    _staticTexture->setInternalFormat(_texture->getInternalFormat());
+    _staticTexture->setFilter(osg::Texture2D::MIN_FILTER,osg::Texture2D::NEAREST);
+    _staticTexture->setFilter(osg::Texture2D::MAG_FILTER,osg::Texture2D::NEAREST);
+    _staticTexture->setWrap(osg::Texture2D::WRAP_S,osg::Texture2D::CLAMP_TO_EDGE);
+    _staticTexture->setWrap(osg::Texture2D::WRAP_T,osg::Texture2D::CLAMP_TO_EDGE);
+
+    _staticCamera = new osg::Camera;
+    _staticCamera->setName("StaticShadowCamera");
+    _staticCamera->setReferenceFrame(osg::Camera::ABSOLUTE_RF_INHERIT_VIEWPOINT);
+#ifndef __APPLE__ // workaround shadow issue on macOS, https://gitlab.com/OpenMW/openmw/-/issues/6057
+    _staticCamera->setImplicitBufferAttachmentMask(0, 0);
+#endif
+    _staticCamera->setClearColor(_camera->getClearColor());
+    _staticCamera->setComputeNearFarMode(osg::Camera::DO_NOT_COMPUTE_NEAR_FAR);
+    _staticCamera->setCullingMode(_camera->getCullingMode());
+    _staticCamera->setViewport(0, 0, _texture->getTextureWidth(), _texture->getTextureHeight());
+    _staticCamera->setClearMask(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+
+    // draw before the shadow camera copies the result
+    _staticCamera->setRenderOrder(osg::Camera::PRE_RENDER, -1);
+    _staticCamera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT);
+    _staticCamera->attach(osg::Camera::DEPTH_BUFFER, _staticTexture.get());
+    addGpuTimer(*_staticCamera, new GpuTimer("Static Shadows"));
+
+    _camera->setClearMask(0);
+    _camera->addPreDrawCallback(new CopyStaticShadowMapCallback(_staticTexture, _texture));
+
+    _staticValid = false;
+}
+
 void MWShadowTechnique::ShadowData::releaseGLObjects(osg::State* state) const
 {
     OSG_INFO<<"MWShadowTechnique::ShadowData::releaseGLObjects"<<std::endl;
     _texture->releaseGLObjects(state);
     _camera->releaseGLObjects(state);
+    if (_staticCamera)
+    {
+        _staticTexture->releaseGLObjects(state);
+        _staticCamera->releaseGLObjects(state);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -926,6 +1012,8 @@ void SceneUtil::MWShadowTechnique::setupCastingShader(Shader::ShaderManager & sh
         auto& program = _castingPrograms[alphaFunc - GL_NEVER];
         program = new osg::Program();
         program->addShader(castingVertexShader);
+        SceneUtil::RigGeometry::bindSkinningAttributes(*program);
+        SceneUtil::MorphGeometry::bindMorphingAttributes(*program);
         program->addShader(shaderManager.getShader("shadowcasting.frag", { {"alphaFunc", std::to_string(alphaFunc)},
                                                                                     {"alphaToCoverage", "0"},
                                                                                     {"adjustCoverage", "1"},
@@ -1363,6 +1451,7 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
             }
 
             osg::ref_ptr<osg::Camera> camera = sd->_camera;
+            setupCasterCulling(*camera, sm_i);
 
             camera->setProjectionMatrix(projectionMatrix);
             camera->setViewMatrix(viewMatrix);
@@ -1500,6 +1589,16 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
             else
                 cropShadowCameraToMainFrustum(frustum, camera, reducedNear, reducedFar, extraPlanes);
 
+            const bool staticShadowCache = _staticShadowCastingMask != 0 && !settings->getDebugDraw()
+                && settings->getShadowMapProjectionHint() != ShadowSettings::PERSPECTIVE_SHADOW_MAP;
+            bool refreshStaticShadowMap = false;
+            if (staticShadowCache)
+            {
+                if (!sd->_staticCamera)
+                    sd->setupStaticCache();
+                refreshStaticShadowMap = updateStaticShadowCache(*sd, camera, local_polytope);
+            }
+
             osg::ref_ptr<VDSMCameraCullCallback> vdsmCallback = new VDSMCameraCullCallback(this, local_polytope);
             camera->setCullCallback(vdsmCallback.get());
 
@@ -1508,7 +1607,21 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
 
             cv.pushStateSet(_shadowCastingStateSet.get());
 
-            cullShadowCastingScene(&cv, camera.get());
+            const unsigned int castsShadowTraversalMask = _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask();
+            if (staticShadowCache)
+            {
+                // the static shadow map may be reused after the view moves, so it is not cropped to the current view
+                if (refreshStaticShadowMap)
+                {
+                    osg::Polytope staticPolytope;
+                    setupCasterCulling(*sd->_staticCamera, sm_i);
+                    sd->_staticCamera->setCullCallback(new VDSMCameraCullCallback(this, staticPolytope));
+                    cullShadowCastingScene(&cv, sd->_staticCamera.get(), castsShadowTraversalMask & ~_dynamicShadowCastingMask);
+                }
+                cullShadowCastingScene(&cv, camera.get(), castsShadowTraversalMask & ~_staticShadowCastingMask);
+            }
+            else
+                cullShadowCastingScene(&cv, camera.get());
 
             cv.popStateSet();
 
@@ -1735,6 +1848,9 @@ void MWShadowTechnique::createShaders()
     _shadowCastingStateSet->setTextureAttribute(0, _fallbackBaseTexture.get(), osg::StateAttribute::ON);
     _shadowCastingStateSet->addUniform(new osg::Uniform("useDiffuseMapForShadowAlpha", true));
     _shadowCastingStateSet->addUniform(new osg::Uniform("alphaTestShadows", false));
+    _shadowCastingStateSet->addUniform(new osg::Uniform("useGpuSkinning", false));
+    _shadowCastingStateSet->addUniform(new osg::Uniform("useGpuMorphing", false));
+    _shadowCastingStateSet->addUniform(new osg::Uniform("useInstancing", false));
     osg::ref_ptr<osg::Depth> depth = new osg::Depth;
     depth->setWriteMask(true);
     osg::ref_ptr<osg::ClipControl> clipcontrol = new osg::ClipControl(osg::ClipControl::LOWER_LEFT, osg::ClipControl::NEGATIVE_ONE_TO_ONE);
@@ -3121,13 +3237,18 @@ void MWShadowTechnique::cullShadowReceivingScene(osgUtil::CullVisitor* cv) const
 }
 
 void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera) const
+{
+    cullShadowCastingScene(cv, camera, _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask());
+}
+
+void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera, unsigned int castsShadowTraversalMask) const
 {
     OSG_INFO<<"cullShadowCastingScene()"<<std::endl;
 
     // record the traversal mask on entry so we can reapply it later.
     unsigned int traversalMask = cv->getTraversalMask();
 
-    cv->setTraversalMask( traversalMask & _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask() );
+    cv->setTraversalMask( traversalMask & castsShadowTraversalMask );
 
         if (camera) camera->accept(*cv);
 
@@ -3136,6 +3257,71 @@ void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Ca
     return;
 }
 
+void MWShadowTechnique::setupCasterCulling(osg::Camera& camera, unsigned int sm_i) const
+{
+    // the further shadow maps cover so much ground that small casters only end up as a few texels
+    if (_minimumCasterSize > 0.f && sm_i > 0)
+    {
+        camera.setCullingMode(camera.getCullingMode() | osg::CullSettings::SMALL_FEATURE_CULLING);
+        camera.setSmallFeatureCullingPixelSize(_minimumCasterSize);
+    }
+    else
+        camera.setCullingMode(camera.getCullingMode() & ~osg::CullSettings::SMALL_FEATURE_CULLING);
+
+    camera.setLODScale(_casterLODScale);
+}
+
+bool MWShadowTechnique::updateStaticShadowCache(ShadowData& sd, osg::Camera* camera, osg::Polytope& polytope) const
+{
+    // The cached shadow map covers a larger area than the cascade so small camera movements stay inside of it
+    constexpr double margin = 0.25;
+    // Refresh when the cascade only covers a small part of the cache, as the shadows would be blurrier than usual
+    constexpr double minCoverage = 1.0 / ((1.0 + margin) * (1.0 + margin) * 1.5);
+    const double maxLightAngleCos = std::cos(osg::DegreesToRadians(1.0));
+
+    const osg::Matrixd& viewMatrix = camera->getViewMatrix();
+    const osg::Matrixd& projectionMatrix = camera->getProjectionMatrix();
+
+    bool refresh = !sd._staticValid || sd._staticRevision != _staticShadowRevision;
+    if (!refresh)
+    {
+        // light direction in world space is the view direction of the shadow camera
+        const osg::Vec3d lightDir(viewMatrix(0, 2), viewMatrix(1, 2), viewMatrix(2, 2));
+        const osg::Vec3d staticLightDir(sd._staticViewMatrix(0, 2), sd._staticViewMatrix(1, 2), sd._staticViewMatrix(2, 2));
+        refresh = lightDir * staticLightDir < maxLightAngleCos * lightDir.length() * staticLightDir.length();
+    }
+    if (!refresh)
+    {
+        const osg::Matrixd toStaticClip = osg::Matrixd::inverse(viewMatrix * projectionMatrix) * sd._staticViewMatrix * sd._staticProjectionMatrix;
+        osg::BoundingBoxd bounds;
+        for (unsigned int i = 0; i < 8; ++i)
+            bounds.expandBy(osg::Vec3d(i & 1 ? 1.0 : -1.0, i & 2 ? 1.0 : -1.0, i & 4 ? 1.0 : -1.0) * toStaticClip);
+
+        constexpr double epsilon = 1e-3;
+        refresh = bounds.xMin() < -1.0 - epsilon || bounds.yMin() < -1.0 - epsilon || bounds.zMin() < -1.0 - epsilon
+            || bounds.xMax() > 1.0 + epsilon || bounds.yMax() > 1.0 + epsilon || bounds.zMax() > 1.0 + epsilon
+            || bounds.xMax() - bounds.xMin() < 2.0 * minCoverage || bounds.yMax() - bounds.yMin() < 2.0 * minCoverage;
+    }
+
+    if (refresh)
+    {
+        sd._staticViewMatrix = viewMatrix;
+        sd._staticProjectionMatrix = projectionMatrix
+            * osg::Matrixd::scale(1.0 / (1.0 + margin), 1.0 / (1.0 + margin), 1.0 / (1.0 + margin));
+        sd._staticRevision = _staticShadowRevision;
+        sd._staticValid = true;
+        sd._staticCamera->setViewMatrix(sd._staticViewMatrix);
+        sd._staticCamera->setProjectionMatrix(sd._staticProjectionMatrix);
+    }
+
+    // move the polytope from the light space of the camera to the one of the cache
+    polytope.transformProvidingInverse(osg::Matrixd::inverse(sd._staticViewMatrix) * viewMatrix);
+    camera->setViewMatrix(sd._staticViewMatrix);
+    camera->setProjectionMatrix(sd._staticProjectionMatrix);
+
+    return refresh;
+}
+
 osg::StateSet* MWShadowTechnique::prepareStateSetForRenderingShadow(ViewDependentData& vdd, unsigned int traversalNumber) const
 {
     OSG_INFO<<"   prepareStateSetForRenderingShadow() "<<vdd.getStateSet(traversalNumber)<<std::endl;
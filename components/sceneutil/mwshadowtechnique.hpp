@@ -198,6 +198,16 @@ namespace SceneUtil {
             unsigned int                        _sm_i;
             osg::ref_ptr<osg::Texture2D>        _texture;
             osg::ref_ptr<osg::Camera>           _camera;
+
+            /** Create the camera rendering static casters into _staticTexture, which is copied into _texture before dynamic casters are drawn. */
+            void setupStaticCache();
+
+            osg::ref_ptr<osg::Texture2D>        _staticTexture;
+            osg::ref_ptr<osg::Camera>           _staticCamera;
+            osg::Matrixd                        _staticViewMatrix;
+            osg::Matrixd                        _staticProjectionMatrix;
+            unsigned int                        _staticRevision = 0;
+            bool                                _staticValid = false;
         };
 
         typedef std::list< osg::ref_ptr<ShadowData> > ShadowDataList;
@@ -267,10 +277,37 @@ namespace SceneUtil {
 
         virtual void cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera) const;
 
+        void cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera, unsigned int castsShadowTraversalMask) const;
+
+        /** Use the cached static shadow map matrices for the camera when they still cover it, the polytope is moved to the light space of the cache.
+          * @return true when the static shadow map must be rendered again */
+        bool updateStaticShadowCache(ShadowData& sd, osg::Camera* camera, osg::Polytope& polytope) const;
+
+        /** Apply the caster size and LOD settings to the camera rendering shadow map sm_i. */
+        void setupCasterCulling(osg::Camera& camera, unsigned int sm_i) const;
+
         virtual osg::StateSet* prepareStateSetForRenderingShadow(ViewDependentData& vdd, unsigned int traversalNumber) const;
 
         void setWorldMask(unsigned int worldMask) { _worldMask = worldMask; }
 
+        /** Render static casters into shadow maps kept until the light or the shadow map bounds move too far, and dynamic casters on top every frame.
+          * Each mask excludes the casters of the other group from its pass, a zero static mask disables the cache. Requires orthographic shadow maps. */
+        void setShadowCastingCacheMasks(unsigned int staticMask, unsigned int dynamicMask)
+        {
+            _staticShadowCastingMask = staticMask;
+            _dynamicShadowCastingMask = dynamicMask;
+        }
+
+        /** Render cached static shadow maps again, e.g. when static casters were added or removed. */
+        void invalidateStaticShadows() { ++_staticShadowRevision; }
+
+        /** Skip casters smaller than the given number of texels in all shadow maps but the nearest one, which keeps every caster for the detailed shadows close to the viewer.
+          * The size is measured before light space perspective shadow maps are warped. Zero disables this. */
+        void setMinimumCasterSize(float texels) { _minimumCasterSize = texels; }
+
+        /** Scale the distance used to select the LOD children of casters, larger values use coarser models in shadow maps. */
+        void setCasterLODScale(float scale) { _casterLODScale = scale; }
+
         osg::ref_ptr<osg::StateSet> getOrCreateShadowsBinStateSet();
 
     protected:
@@ -309,6 +346,13 @@ namespace SceneUtil {
 
         unsigned int                            _worldMask = ~0u;
 
+        unsigned int                            _staticShadowCastingMask = 0;
+        unsigned int                            _dynamicShadowCastingMask = 0;
+        unsigned int                            _staticShadowRevision = 0;
+
+        float                                   _minimumCasterSize = 0.f;
+        float                                   _casterLODScale = 1.f;
+
         class DebugHUD final : public osg::Referenced
         {
         public:
@@ -0,0 +1,147 @@
+#include "occlusionculler.hpp"
+
+#include <osg/Vec4f>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        int getTexel(float ndc, int size)
+        {
+            return std::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * size)), 0, size - 1);
+        }
+    }
+
+    void DepthPyramid::build(
+        std::span<const float> depth, int width, int height, const osg::Matrixf& viewProjection, bool reverseZ)
+    {
+        mLevels.clear();
+        mViewProjection = viewProjection;
+        mReverseZ = reverseZ;
+        if (width <= 0 || height <= 0 || depth.size() < static_cast<std::size_t>(width * height))
+            return;
+
+        Level& first = mLevels.emplace_back(Level{ width, height, {} });
+        first.mDepth.reserve(static_cast<std::size_t>(width * height));
+        for (int i = 0; i < width * height; ++i)
+            first.mDepth.push_back(reverseZ ? 1.f - depth[i] : depth[i]);
+
+        while (mLevels.back().mWidth > 1 || mLevels.back().mHeight > 1)
+        {
+            const Level& source = mLevels.back();
+            Level level{ (source.mWidth + 1) / 2, (source.mHeight + 1) / 2, {} };
+            level.mDepth.reserve(static_cast<std::size_t>(level.mWidth * level.mHeight));
+            for (int y = 0; y < level.mHeight; ++y)
+            {
+                // Odd sizes repeat the last row or column
+                const int y0 = y * 2;
+                const int y1 = std::min(y0 + 1, source.mHeight - 1);
+                for (int x = 0; x < level.mWidth; ++x)
+                {
+                    const int x0 = x * 2;
+                    const int x1 = std::min(x0 + 1, source.mWidth - 1);
+                    const float* const data = source.mDepth.data();
+                    level.mDepth.push_back(std::max({ data[y0 * source.mWidth + x0], data[y0 * source.mWidth + x1],
+                        data[y1 * source.mWidth + x0], data[y1 * source.mWidth + x1] }));
+                }
+            }
+            mLevels.push_back(std::move(level));
+        }
+    }
+
+    bool DepthPyramid::isOccluded(const osg::BoundingBox& box) const
+    {
+        if (mLevels.empty() || !box.valid())
+            return false;
+
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = std::numeric_limits<float>::lowest();
+        float maxY = std::numeric_limits<float>::lowest();
+        float minDepth = std::numeric_limits<float>::max();
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            const osg::Vec4f clip = osg::Vec4f(box.corner(i), 1.f) * mViewProjection;
+            // Boxes crossing the near plane are visible
+            if (clip.w() <= 1e-4f)
+                return false;
+            const float ndcX = clip.x() / clip.w();
+            const float ndcY = clip.y() / clip.w();
+            const float ndcZ = clip.z() / clip.w();
+            minX = std::min(minX, ndcX);
+            minY = std::min(minY, ndcY);
+            maxX = std::max(maxX, ndcX);
+            maxY = std::max(maxY, ndcY);
+            // Reversed depth uses a [0, 1] clip space depth range
+            minDepth = std::min(minDepth, mReverseZ ? 1.f - ndcZ : ndcZ * 0.5f + 0.5f);
+        }
+
+        // Nothing is known about what was outside of the view
+        if (maxX < -1.f || maxY < -1.f || minX > 1.f || minY > 1.f)
+            return false;
+
+        const Level& first = mLevels.front();
+        int x0 = getTexel(minX, first.mWidth);
+        int x1 = getTexel(maxX, first.mWidth);
+        int y0 = getTexel(minY, first.mHeight);
+        int y1 = getTexel(maxY, first.mHeight);
+
+        // Use the finest level where the box covers at most 2x2 texels
+        std::size_t index = 0;
+        while (index + 1 < mLevels.size() && (x1 - x0 > 1 || y1 - y0 > 1))
+        {
+            x0 /= 2;
+            x1 /= 2;
+            y0 /= 2;
+            y1 /= 2;
+            ++index;
+        }
+
+        const Level& level = mLevels[index];
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                if (level.mDepth[y * level.mWidth + x] >= minDepth)
+                    return false;
+
+        return true;
+    }
+
+    void OcclusionCuller::setViewProjection(unsigned frameNumber, const osg::Matrixf& viewProjection)
+    {
+        const std::lock_guard lock(mMutex);
+        ViewProjection& entry = mViewProjections[frameNumber % mViewProjections.size()];
+        entry.mFrameNumber = frameNumber;
+        entry.mMatrix = viewProjection;
+    }
+
+    std::optional<osg::Matrixf> OcclusionCuller::getViewProjection(unsigned frameNumber) const
+    {
+        const std::lock_guard lock(mMutex);
+        const ViewProjection& entry = mViewProjections[frameNumber % mViewProjections.size()];
+        if (entry.mFrameNumber != frameNumber)
+            return std::nullopt;
+        return entry.mMatrix;
+    }
+
+    void OcclusionCuller::setDepth(unsigned frameNumber, std::span<const float> depth, int width, int height,
+        const osg::Matrixf& viewProjection, bool reverseZ)
+    {
+        auto pyramid = std::make_shared<DepthPyramid>();
+        pyramid->build(depth, width, height, viewProjection, reverseZ);
+        const std::lock_guard lock(mMutex);
+        mDepthPyramid = std::move(pyramid);
+        mDepthFrameNumber = frameNumber;
+    }
+
+    std::shared_ptr<const DepthPyramid> OcclusionCuller::getDepthPyramid(unsigned frameNumber) const
+    {
+        const std::lock_guard lock(mMutex);
+        if (mDepthPyramid == nullptr || frameNumber < mDepthFrameNumber || frameNumber - mDepthFrameNumber > sMaxAge)
+            return nullptr;
+        return mDepthPyramid;
+    }
+}
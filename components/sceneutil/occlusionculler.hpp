@@ -0,0 +1,85 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_OCCLUSIONCULLER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_OCCLUSIONCULLER_H
+
+#include <osg/BoundingBox>
+#include <osg/Matrixf>
+#include <osg/Referenced>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Hierarchical depth buffer: mip levels keeping the furthest depth of the texels they cover.
+    /// @par Bounds are tested with the view and projection the depth was rendered with, so a box is only reported as
+    /// occluded when it was entirely behind the depth of that frame.
+    class DepthPyramid
+    {
+    public:
+        /// @param depth Window space depth, with rows from the bottom like glReadPixels
+        /// @param reverseZ The depth is 1 at the near plane and 0 at the far plane
+        void build(std::span<const float> depth, int width, int height, const osg::Matrixf& viewProjection,
+            bool reverseZ);
+
+        bool empty() const { return mLevels.empty(); }
+
+        std::size_t getLevelCount() const { return mLevels.size(); }
+
+        /// @param box Bounds in world space
+        bool isOccluded(const osg::BoundingBox& box) const;
+
+    private:
+        struct Level
+        {
+            int mWidth;
+            int mHeight;
+            // Distance increasing with the depth regardless of the depth range
+            std::vector<float> mDepth;
+        };
+
+        std::vector<Level> mLevels;
+        osg::Matrixf mViewProjection;
+        bool mReverseZ = false;
+    };
+
+    /// @brief Exchanges the depth read back by the draw thread of a camera with its cull traversals.
+    /// @par The depth of a frame is only available after it was drawn, so the cull traversal uses the depth of a
+    /// previous frame and objects appearing from behind an occluder may be missing for a frame.
+    class OcclusionCuller : public osg::Referenced
+    {
+    public:
+        // Older depth is ignored, the draw thread does not read back the depth of every frame
+        static constexpr unsigned sMaxAge = 3;
+
+        /// Record the matrices used to render a frame, called by the cull traversal.
+        void setViewProjection(unsigned frameNumber, const osg::Matrixf& viewProjection);
+
+        /// Matrices recorded for a frame, called by the draw thread.
+        std::optional<osg::Matrixf> getViewProjection(unsigned frameNumber) const;
+
+        /// Publish the depth of a drawn frame, called by the draw thread.
+        void setDepth(unsigned frameNumber, std::span<const float> depth, int width, int height,
+            const osg::Matrixf& viewProjection, bool reverseZ);
+
+        /// @return Depth to test bounds against while culling a frame, or nullptr when none recent is available
+        std::shared_ptr<const DepthPyramid> getDepthPyramid(unsigned frameNumber) const;
+
+    private:
+        struct ViewProjection
+        {
+            unsigned mFrameNumber = 0;
+            std::optional<osg::Matrixf> mMatrix;
+        };
+
+        mutable std::mutex mMutex;
+        std::array<ViewProjection, 4> mViewProjections;
+        std::shared_ptr<const DepthPyramid> mDepthPyramid;
+        unsigned mDepthFrameNumber = 0;
+    };
+}
+
+#endif
@@ -28,7 +28,6 @@
 #include <osg/io_utils>
 #include <osg/Depth>
 
-#include <osgDB/SharedStateManager>
 
 #include <osgUtil/TransformAttributeFunctor>
 #include <osgUtil/Statistics>
@@ -86,12 +85,8 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         cstv.removeTransforms(node);
     }
 
-    if (options & SHARE_DUPLICATE_STATE && _sharedStateManager)
-    {
-        if (_sharedStateMutex) _sharedStateMutex->lock();
-        _sharedStateManager->share(node);
-        if (_sharedStateMutex) _sharedStateMutex->unlock();
-    }
+    if (options & SHARE_DUPLICATE_STATE && _sharedStateRegistry)
+        _sharedStateRegistry->share(*node);
 
     if (options & REMOVE_REDUNDANT_NODES)
     {
@@ -30,14 +30,11 @@
 
 // NOLINTBEGIN(readability-identifier-naming)
 
-namespace osgDB
-{
-    class SharedStateManager;
-}
-
 //namespace osgUtil {
 namespace SceneUtil {
 
+class SharedStateRegistry;
+
 // forward declare
 class Optimizer;
 
@@ -74,7 +71,7 @@ class Optimizer
 
     public:
 
-        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr) {}
+        Optimizer() : _mergeAlphaBlending(false), _sharedStateRegistry(nullptr) {}
         virtual ~Optimizer() {}
 
         enum OptimizationOptions
@@ -130,7 +127,7 @@ class Optimizer
         void setMergeAlphaBlending(bool merge) { _mergeAlphaBlending = merge; }
         void setViewPoint(const osg::Vec3f& viewPoint) { _viewPoint = viewPoint; }
 
-        void setSharedStateManager(osgDB::SharedStateManager* sharedStateManager, std::mutex* sharedStateMutex) { _sharedStateMutex = sharedStateMutex; _sharedStateManager = sharedStateManager; }
+        void setSharedStateRegistry(SharedStateRegistry* sharedStateRegistry) { _sharedStateRegistry = sharedStateRegistry; }
 
         /** Reset internal data to initial state - the getPermissibleOptionsMap is cleared.*/
         void reset();
@@ -269,8 +266,7 @@ class Optimizer
         osg::Vec3f _viewPoint;
         bool _mergeAlphaBlending;
 
-        osgDB::SharedStateManager* _sharedStateManager;
-        mutable std::mutex* _sharedStateMutex;
+        SharedStateRegistry* _sharedStateRegistry;
 
     public:
 
@@ -0,0 +1,75 @@
+#include "parallelupdate.hpp"
+
+#include <components/debug/trace.hpp>
+
+#include <osg/FrameStamp>
+
+#include <algorithm>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Updates are short, so hand them out in batches to keep the scheduling overhead low
+        constexpr std::size_t batchSize = 64;
+    }
+
+    ParallelUpdateVisitor::ParallelUpdateVisitor(WorkQueue& workQueue, std::size_t maxHelpers)
+        : mWorkQueue(&workQueue)
+        , mMaxHelpers(maxHelpers)
+    {
+    }
+
+    void ParallelUpdateVisitor::updateParallel(osg::FrameStamp* frameStamp)
+    {
+        OPENMW_TRACE_SCOPE("Parallel Update");
+
+        // Same as the viewer sets for the update traversal
+        setFrameStamp(frameStamp);
+        setTraversalNumber(frameStamp->getFrameNumber());
+
+        const unsigned traversal = getTraversalNumber();
+        const std::size_t batches = (mCallbacks.size() + batchSize - 1) / batchSize;
+        parallelFor(*mWorkQueue, batches, mMaxHelpers, [&](std::size_t batch) {
+            const std::size_t end = std::min(mCallbacks.size(), (batch + 1) * batchSize);
+            for (std::size_t i = batch * batchSize; i < end; ++i)
+            {
+                const Item& item = mCallbacks[i];
+                if (item.mParallel->updateParallel(*item.mNode, *this))
+                    item.mParallel->mUpdatedTraversal = traversal;
+            }
+        });
+    }
+
+    bool ParallelUpdateVisitor::isUpdated(
+        osg::Node& node, osg::Callback& callback, ParallelUpdateCallback& parallel, osg::NodeVisitor* nv)
+    {
+        if (nv->getVisitorType() != osg::NodeVisitor::UPDATE_VISITOR)
+            return false;
+        ParallelUpdateVisitor* const visitor = dynamic_cast<ParallelUpdateVisitor*>(nv);
+        if (visitor == nullptr)
+            return false;
+        return visitor->visit(node, callback, parallel);
+    }
+
+    bool ParallelUpdateVisitor::visit(osg::Node& node, osg::Callback& callback, ParallelUpdateCallback& parallel)
+    {
+        const unsigned traversal = getTraversalNumber();
+
+        // The list of the previous traversal was used by the parallel update or is outdated
+        if (mCollectingTraversal != traversal)
+        {
+            mCallbacks.clear();
+            mCollectingTraversal = traversal;
+        }
+
+        // Nodes with several parents are visited more than once
+        if (parallel.mRegisteredTraversal != traversal)
+        {
+            parallel.mRegisteredTraversal = traversal;
+            mCallbacks.push_back(Item{ &node, &callback, &parallel });
+        }
+
+        return parallel.mUpdatedTraversal == traversal;
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_PARALLELUPDATE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_PARALLELUPDATE_H
+
+#include <osg/Callback>
+#include <osg/Node>
+#include <osg/ref_ptr>
+#include <osgUtil/UpdateVisitor>
+
+#include "workqueue.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace osg
+{
+    class FrameStamp;
+}
+
+namespace SceneUtil
+{
+    /// @brief Part of an update callback that may run concurrently with other parallel updates, before the update
+    /// traversal.
+    /// @par Only for callbacks that change nothing but themselves, their node and state owned by the node, and that
+    /// read nothing written by other update callbacks. Inputs set before the update traversal, like the frame stamp
+    /// and animation times, are fine.
+    class ParallelUpdateCallback
+    {
+    public:
+        ParallelUpdateCallback() = default;
+
+        // Copies are not visited yet
+        ParallelUpdateCallback(const ParallelUpdateCallback&) {}
+
+        ParallelUpdateCallback& operator=(const ParallelUpdateCallback&) { return *this; }
+
+        virtual ~ParallelUpdateCallback() = default;
+
+        /// Do the work of the update callback without traversing the children.
+        /// @return false if the update has to run on the update traversal this time, e.g. to set up shared state
+        virtual bool updateParallel(osg::Node& node, osg::NodeVisitor& nv) = 0;
+
+    private:
+        static constexpr unsigned sNone = std::numeric_limits<unsigned>::max();
+
+        unsigned mRegisteredTraversal = sNone;
+        unsigned mUpdatedTraversal = sNone;
+
+        friend class ParallelUpdateVisitor;
+    };
+
+    /// @brief Update visitor that runs parallel callbacks found by the previous update traversal on the work queue
+    /// before the next traversal, which then only traverses their children.
+    /// @par Callbacks run on the last traversal that are no longer visited are updated once more before they are
+    /// dropped, this is harmless as they only change their own state.
+    class ParallelUpdateVisitor : public osgUtil::UpdateVisitor
+    {
+    public:
+        ParallelUpdateVisitor(WorkQueue& workQueue, std::size_t maxHelpers);
+
+        /// Run the parallel updates of the frame, must be called after the frame stamp is advanced and before the
+        /// update traversal.
+        void updateParallel(osg::FrameStamp* frameStamp);
+
+        /// To be called from the update callback.
+        /// @return true if the parallel update already ran for this traversal and only the children are left
+        static bool isUpdated(osg::Node& node, osg::Callback& callback, ParallelUpdateCallback& parallel,
+            osg::NodeVisitor* nv);
+
+        std::size_t getCount() const { return mCallbacks.size(); }
+
+    private:
+        struct Item
+        {
+            osg::ref_ptr<osg::Node> mNode;
+            osg::ref_ptr<osg::Callback> mCallback;
+            ParallelUpdateCallback* mParallel;
+        };
+
+        osg::ref_ptr<WorkQueue> mWorkQueue;
+        std::size_t mMaxHelpers;
+        unsigned mCollectingTraversal = std::numeric_limits<unsigned>::max();
+        std::vector<Item> mCallbacks;
+
+        bool visit(osg::Node& node, osg::Callback& callback, ParallelUpdateCallback& parallel);
+    };
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "riggeometry.hpp"
 
+#include <algorithm>
+#include <span>
 #include <unordered_map>
 
 #include <osg/MatrixTransform>
@@ -15,6 +17,14 @@
 
 namespace SceneUtil
 {
+    namespace
+    {
+        template <class Array>
+        auto asSpan(Array& array)
+        {
+            return std::span(array.asVector());
+        }
+    }
 
     RigGeometry::RigGeometry()
     {
@@ -25,6 +35,7 @@ namespace SceneUtil
     RigGeometry::RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop)
         : Drawable(copy, copyop)
         , mData(copy.mData)
+        , mGpuSkinning(copy.mGpuSkinning)
     {
         setSourceGeometry(copy.mSourceGeometry);
         setNumChildrenRequiringUpdateTraversal(1);
@@ -57,6 +68,23 @@ namespace SceneUtil
             to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
             to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
 
+            if (mGpuSkinning)
+            {
+                // the source arrays are only read by the vertex shader, so they can be shared
+                to.setVertexAttribArray(sBoneIndicesAttribute, mData->mBoneIndices, osg::Array::BIND_PER_VERTEX);
+                to.setVertexAttribArray(sBoneWeightsAttribute, mData->mBoneWeights, osg::Array::BIND_PER_VERTEX);
+                mSourceTangents = nullptr;
+
+                osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+                stateSet->addUniform(new osg::Uniform("useGpuSkinning", true));
+                stateSet->addUniform(new osg::Uniform(
+                    osg::Uniform::FLOAT_MAT4, "boneMatrices", static_cast<int>(mData->mBones.size())));
+                stateSet->addUniform(new osg::Uniform("skinTransform", osg::Matrixf()));
+                mSkinningStateSet[i] = std::move(stateSet);
+                continue;
+            }
+            mSkinningStateSet[i] = nullptr;
+
             // vertices and normals are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
             osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
@@ -149,77 +177,69 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        if (mLastFrameNumber == traversalNumber
+            || (mLastFrameNumber != 0
+                && (!mSkeleton->getActive() || mSkeleton->isPoseUnchangedSince(mLastFrameNumber))))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
+            // Shadow and reflection cameras reuse what was computed for the frame, and the skeletons of distant actors
+            // which skipped their update keep the vertices skinned for their last pose
+            draw(nv, mLastFrameNumber);
             return;
         }
         mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
         mSkeleton->updateBoneMatrices(traversalNumber);
+        updateBoneMatrices();
 
-        // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-        const osg::Vec4Array* tangentSrc = mSourceTangents;
+        osg::Matrixf transform;
+        if (mSkinToSkelMatrix)
+            transform = (*mSkinToSkelMatrix) * mData->mTransform;
+        else
+            transform = mData->mTransform;
 
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+        if (mGpuSkinning)
+            updateBonePalette(mLastFrameNumber, transform);
+        else
+            skinOnCpu(*getGeometry(mLastFrameNumber), transform);
+
+        draw(nv, mLastFrameNumber);
+    }
 
-        std::vector<osg::Matrixf> boneMatrices(mNodes.size());
+    void RigGeometry::updateBoneMatrices()
+    {
+        mBoneMatrices.resize(mNodes.size());
         std::vector<Bone*>::const_iterator bone = mNodes.begin();
         std::vector<BoneInfo>::const_iterator boneInfo = mData->mBones.begin();
-        for (osg::Matrixf& boneMat : boneMatrices)
+        // Missing bones don't contribute to the vertex position
+        static const osg::Matrixf zero(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for (osg::Matrixf& boneMat : mBoneMatrices)
         {
             if (*bone != nullptr)
                 boneMat = boneInfo->mInvBindMatrix * (*bone)->mMatrixInSkeletonSpace;
+            else
+                boneMat = zero;
             ++bone;
             ++boneInfo;
         }
+    }
 
-        osg::Matrixf transform;
-        if (mSkinToSkelMatrix)
-            transform = (*mSkinToSkelMatrix) * mData->mTransform;
-        else
-            transform = mData->mTransform;
-
-        for (const auto& [influences, vertices] : mData->mInfluences)
-        {
-            osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
-
-            for (const auto& [index, weight] : influences)
-            {
-                if (mNodes[index] == nullptr)
-                    continue;
-                const float* boneMatPtr = boneMatrices[index].ptr();
-                float* resultMatPtr = resultMat.ptr();
-                for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
-                    if (i % 4 != 3)
-                        *resultMatPtr += *boneMatPtr * weight;
-            }
+    void RigGeometry::skinOnCpu(osg::Geometry& geom, const osg::Matrixf& transform)
+    {
+        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+        const osg::Vec4Array* tangentSrc = mSourceTangents;
 
-            resultMat *= transform;
+        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-            for (unsigned short vertex : vertices)
-            {
-                (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-                if (normalDst)
-                    (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+        blendSkinningMatrices(mData->mInfluences, mBoneMatrices, transform, mSkinningMatrices);
 
-                if (tangentDst)
-                {
-                    const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                    osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
-                        osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                    (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-                }
-            }
-        }
+        skinPositions(mData->mInfluences, mSkinningMatrices, asSpan(*positionSrc), asSpan(*positionDst));
+        if (normalDst)
+            skinNormals(mData->mInfluences, mSkinningMatrices, asSpan(*normalSrc), asSpan(*normalDst));
+        if (tangentDst)
+            skinTangents(mData->mInfluences, mSkinningMatrices, asSpan(*tangentSrc), asSpan(*tangentDst));
 
         positionDst->dirty();
         if (normalDst)
@@ -228,10 +248,29 @@ namespace SceneUtil
             tangentDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
+    }
 
+    void RigGeometry::updateBonePalette(unsigned int frame, const osg::Matrixf& transform)
+    {
+        osg::StateSet& stateSet = *mSkinningStateSet[frame % 2];
+        osg::Uniform* boneMatrices = stateSet.getUniform("boneMatrices");
+        for (std::size_t i = 0; i < mBoneMatrices.size(); ++i)
+            boneMatrices->setElement(static_cast<unsigned>(i), mBoneMatrices[i]);
+        stateSet.getUniform("skinTransform")->set(transform);
+    }
+
+    void RigGeometry::draw(osg::NodeVisitor* nv, unsigned int frame)
+    {
+        osg::Geometry& geom = *getGeometry(frame);
+        osg::StateSet* skinningStateSet = mSkinningStateSet[frame % 2].get();
+        osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(nv);
+        if (skinningStateSet)
+            cv->pushStateSet(skinningStateSet);
         nv->pushOntoNodePath(&geom);
         nv->apply(geom);
         nv->popFromNodePath();
+        if (skinningStateSet)
+            cv->popStateSet();
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -325,6 +364,64 @@ namespace SceneUtil
         }
     }
 
+    void RigGeometry::setGpuSkinning(bool enabled)
+    {
+        if (enabled == mGpuSkinning)
+            return;
+
+        if (enabled)
+        {
+            const osg::Array* vertices = mSourceGeometry ? mSourceGeometry->getVertexArray() : nullptr;
+            if (!mData || !vertices || mData->mBones.empty() || mData->mBones.size() > sMaxGpuBones
+                || !mData->buildVertexAttributes(vertices->getNumElements()))
+                return;
+        }
+
+        mGpuSkinning = enabled;
+        if (mSourceGeometry)
+            setSourceGeometry(mSourceGeometry);
+    }
+
+    void RigGeometry::bindSkinningAttributes(osg::Program& program)
+    {
+        program.addBindAttribLocation("boneIndices", sBoneIndicesAttribute);
+        program.addBindAttribLocation("boneWeights", sBoneWeightsAttribute);
+    }
+
+    bool RigGeometry::InfluenceData::buildVertexAttributes(std::size_t numVertices)
+    {
+        if (mBoneIndices != nullptr && mBoneIndices->size() == numVertices)
+            return true;
+
+        if (mInfluences.getMaxGroupSize() > 4)
+            return false;
+
+        const std::vector<std::uint32_t>& vertexGroups = mInfluences.mVertexGroups;
+        if (std::any_of(vertexGroups.begin() + std::min(numVertices, vertexGroups.size()), vertexGroups.end(),
+                [](std::uint32_t group) { return group != SkinningInfluences::sNoGroup; }))
+            return false;
+
+        osg::ref_ptr<osg::Vec4Array> indices = new osg::Vec4Array(static_cast<unsigned>(numVertices));
+        osg::ref_ptr<osg::Vec4Array> weights = new osg::Vec4Array(static_cast<unsigned>(numVertices));
+        for (std::size_t vertex = 0; vertex < std::min(numVertices, vertexGroups.size()); ++vertex)
+        {
+            const std::uint32_t group = vertexGroups[vertex];
+            if (group == SkinningInfluences::sNoGroup)
+                continue;
+            const std::uint32_t begin = mInfluences.mGroupOffsets[group];
+            const std::uint32_t end = mInfluences.mGroupOffsets[group + 1];
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                (*indices)[vertex][i - begin] = static_cast<float>(mInfluences.mBones[i]);
+                (*weights)[vertex][i - begin] = mInfluences.mWeights[i];
+            }
+        }
+
+        mBoneIndices = std::move(indices);
+        mBoneWeights = std::move(weights);
+        return true;
+    }
+
     void RigGeometry::setBoneInfo(std::vector<BoneInfo>&& bones)
     {
         if (!mData)
@@ -351,8 +448,9 @@ namespace SceneUtil
         for (const auto& [vertex, weights] : vertexToInfluences)
             influencesToVertices[weights].emplace_back(vertex);
 
-        mData->mInfluences.reserve(influencesToVertices.size());
-        mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mData->mInfluences = SkinningInfluences();
+        for (const auto& [weights, vertices] : influencesToVertices)
+            mData->mInfluences.addGroup(weights, vertices);
     }
 
     void RigGeometry::setInfluences(const std::vector<BoneWeights>& influences)
@@ -364,8 +462,9 @@ namespace SceneUtil
         for (size_t i = 0; i < influences.size(); i++)
             influencesToVertices[influences[i]].emplace_back(static_cast<VertexList::value_type>(i));
 
-        mData->mInfluences.reserve(influencesToVertices.size());
-        mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mData->mInfluences = SkinningInfluences();
+        for (const auto& [weights, vertices] : influencesToVertices)
+            mData->mInfluences.addGroup(weights, vertices);
     }
 
     void RigGeometry::setTransform(osg::Matrixf&& transform)
@@ -3,9 +3,12 @@
 
 #include <osg/Geometry>
 #include <osg/Matrixf>
+#include <osg/Program>
 
 #include <string_view>
 
+#include "skinning.hpp"
+
 namespace SceneUtil
 {
     class Skeleton;
@@ -64,6 +67,22 @@ namespace SceneUtil
 
         void setRootBone(std::string_view name);
 
+        /// Skin in the vertex shader instead of on the CPU. Ignored for geometries the shader can't skin, like ones
+        /// with more than sMaxGpuBones bones or more than 4 influences per vertex.
+        /// @note Only valid when the geometry is rendered with a shader including compatibility/skinning.glsl.
+        void setGpuSkinning(bool enabled);
+
+        bool getGpuSkinning() const { return mGpuSkinning; }
+
+        /// Should match the array size in compatibility/skinning.glsl
+        static constexpr std::size_t sMaxGpuBones = 64;
+
+        /// Generic vertex attribute locations which don't alias the fixed function arrays
+        static constexpr unsigned sBoneIndicesAttribute = 6;
+        static constexpr unsigned sBoneWeightsAttribute = 7;
+
+        static void bindSkinningAttributes(osg::Program& program);
+
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
         void accept(osg::NodeVisitor& nv) override;
@@ -87,6 +106,10 @@ namespace SceneUtil
     private:
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
+        void updateBoneMatrices();
+        void skinOnCpu(osg::Geometry& geom, const osg::Matrixf& transform);
+        void updateBonePalette(unsigned int frame, const osg::Matrixf& transform);
+        void draw(osg::NodeVisitor* nv, unsigned int frame);
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
@@ -101,12 +124,24 @@ namespace SceneUtil
         struct InfluenceData : public osg::Referenced
         {
             std::vector<BoneInfo> mBones;
-            std::vector<std::pair<BoneWeights, VertexList>> mInfluences;
+            SkinningInfluences mInfluences;
             osg::Matrixf mTransform;
             std::string mRootBone;
+            // Per vertex bone indices and weights for GPU skinning, built on demand
+            osg::ref_ptr<osg::Vec4Array> mBoneIndices;
+            osg::ref_ptr<osg::Vec4Array> mBoneWeights;
+
+            bool buildVertexAttributes(std::size_t numVertices);
         };
         osg::ref_ptr<InfluenceData> mData;
         std::vector<Bone*> mNodes;
+        // Scratch space reused between frames
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::vector<SkinningMatrix> mSkinningMatrices;
+
+        bool mGpuSkinning{ false };
+        // Double buffered like mGeometry, so the palette of the frame being drawn is never modified
+        osg::ref_ptr<osg::StateSet> mSkinningStateSet[2];
 
         unsigned int mLastFrameNumber{ 0 };
         bool mBoundsFirstFrame{ true };
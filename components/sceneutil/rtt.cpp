@@ -52,7 +52,7 @@ namespace SceneUtil
     {
         auto frameNumber = cv->getFrameStamp()->getFrameNumber();
         auto* vdd = getViewDependentData(cv);
-        if (frameNumber > vdd->mFrameNumber)
+        if (frameNumber > vdd->mFrameNumber && frameNumber % mUpdateInterval == 0)
         {
             apply(vdd->mCamera);
             if (Stereo::getStereo())
@@ -192,6 +192,9 @@ namespace SceneUtil
 
             setDefaults(camera);
 
+            if (mGpuTimer != nullptr)
+                addGpuTimer(*camera, mGpuTimer);
+
             if (camera->getBufferAttachmentMap().count(osg::Camera::COLOR_BUFFER))
                 vdd->mColorTexture = camera->getBufferAttachmentMap()[osg::Camera::COLOR_BUFFER]._texture;
             if (camera->getBufferAttachmentMap().count(osg::Camera::PACKED_DEPTH_STENCIL_BUFFER))
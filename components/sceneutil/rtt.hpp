@@ -3,6 +3,9 @@
 
 #include <osg/Node>
 
+#include "gputimer.hpp"
+
+#include <algorithm>
 #include <map>
 #include <memory>
 
@@ -78,6 +81,13 @@ namespace SceneUtil
         uint32_t samples() const { return mSamples; }
         bool generatesMipmaps() const { return mGenerateMipmaps; }
 
+        /// Render the texture only on frames with a number divisible by the interval, keeping its content otherwise.
+        void setUpdateInterval(unsigned interval) { mUpdateInterval = std::max(interval, 1u); }
+        unsigned getUpdateInterval() const { return mUpdateInterval; }
+
+        /// Measure the GPU time of the cameras of every view, must be set before the first cull.
+        void setGpuTimer(osg::ref_ptr<GpuTimer> timer) { mGpuTimer = std::move(timer); }
+
         void setColorBufferInternalFormat(GLint internalFormat);
         void setDepthBufferInternalFormat(GLint internalFormat);
 
@@ -111,6 +121,8 @@ namespace SceneUtil
         int mRenderOrderNum;
         StereoAwareness mStereoAwareness;
         bool mAddMSAAIntermediateTarget;
+        unsigned mUpdateInterval = 1;
+        osg::ref_ptr<GpuTimer> mGpuTimer;
     };
 }
 #endif
@@ -1,8 +1,13 @@
 #include "serialize.hpp"
 
+#include <osgDB/InputStream>
 #include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
 #include <osgDB/Registry>
 
+#include <atomic>
+#include <mutex>
+
 #include <components/nifosg/fog.hpp>
 #include <components/nifosg/matrixtransform.hpp>
 
@@ -122,6 +127,46 @@ namespace SceneUtil
             : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform",
                 "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
         {
+            // Components can't be decomposed from the matrix, keep them so controllers work on read nodes
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>("Scale", &hasComponents, &readScale,
+                              &writeScale),
+                osgDB::BaseSerializer::RW_USER);
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+                              "RotationScale", &hasComponents, &readRotationScale, &writeRotationScale),
+                osgDB::BaseSerializer::RW_USER);
+        }
+
+    private:
+        static bool hasComponents(const NifOsg::MatrixTransform& /*node*/) { return true; }
+
+        static bool readScale(osgDB::InputStream& is, NifOsg::MatrixTransform& node)
+        {
+            is >> node.mScale;
+            return true;
+        }
+
+        static bool writeScale(osgDB::OutputStream& os, const NifOsg::MatrixTransform& node)
+        {
+            os << node.mScale << std::endl;
+            return true;
+        }
+
+        static bool readRotationScale(osgDB::InputStream& is, NifOsg::MatrixTransform& node)
+        {
+            is >> is.BEGIN_BRACKET;
+            for (auto& row : node.mRotationScale.mValues)
+                is >> row[0] >> row[1] >> row[2];
+            is >> is.END_BRACKET;
+            return true;
+        }
+
+        static bool writeRotationScale(osgDB::OutputStream& os, const NifOsg::MatrixTransform& node)
+        {
+            os << os.BEGIN_BRACKET << std::endl;
+            for (const auto& row : node.mRotationScale.mValues)
+                os << row[0] << row[1] << row[2] << std::endl;
+            os << os.END_BRACKET << std::endl;
+            return true;
         }
     };
 
@@ -163,11 +208,12 @@ namespace SceneUtil
         }
     };
 
-    void registerSerializers()
+    static std::atomic_bool sGeometryDataSkipped = false;
+
+    void registerNodeSerializers()
     {
-        static bool done = false;
-        if (!done)
-        {
+        static std::once_flag flag;
+        std::call_once(flag, [] {
             osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
             mgr->addWrapper(new PositionAttitudeTransformSerializer);
             mgr->addWrapper(new SkeletonSerializer);
@@ -180,11 +226,23 @@ namespace SceneUtil
             mgr->addWrapper(new MatrixTransformSerializer);
             mgr->addWrapper(new FogSerializer);
             mgr->addWrapper(new TextureTypeSerializer);
+        });
+    }
+
+    void registerSerializers()
+    {
+        static bool done = false;
+        if (!done)
+        {
+            registerNodeSerializers();
+
+            osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
 
             // Don't serialize Geometry data as we are more interested in the overall structure rather than tons of
             // vertex data that would make the file large and hard to read.
             mgr->removeWrapper(mgr->findWrapper("osg::Geometry"));
             mgr->addWrapper(new GeometrySerializer);
+            sGeometryDataSkipped = true;
 
             // ignore the below for now to avoid warning spam
             const char* ignore[] = {
@@ -239,4 +297,9 @@ namespace SceneUtil
         }
     }
 
+    bool isGeometryDataSerialized()
+    {
+        return !sGeometryDataSkipped;
+    }
+
 }
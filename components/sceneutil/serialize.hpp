@@ -5,8 +5,15 @@ namespace SceneUtil
 {
 
     /// Register osg node serializers for certain SceneUtil classes if not already done so
+    void registerNodeSerializers();
+
+    /// Same as registerNodeSerializers but also skips geometry data and ignores classes that can't be serialized,
+    /// for writing scene graphs in a human readable form
     void registerSerializers();
 
+    /// @return false if registerSerializers was called, so written geometries have no data
+    bool isGeometryDataSerialized();
+
 }
 
 #endif
@@ -69,6 +69,9 @@ namespace SceneUtil
 
         mShadowTechnique->setPolygonOffset(settings.mPolygonOffsetFactor, settings.mPolygonOffsetUnits);
 
+        mShadowTechnique->setMinimumCasterSize(settings.mMinimumCasterSize);
+        mShadowTechnique->setCasterLODScale(settings.mCasterLodScale);
+
         if (settings.mUseFrontFaceCulling)
             mShadowTechnique->enableFrontFaceCulling();
         else
@@ -76,6 +79,10 @@ namespace SceneUtil
 
         mShadowSettings->setMultipleShadowMapHint(osgShadow::ShadowSettings::CASCADED);
 
+        // Light space perspective shadow maps change with the view direction, so they could not be cached
+        if (settings.mStaticShadowCache)
+            mShadowSettings->setShadowMapProjectionHint(osgShadow::ShadowSettings::ORTHOGRAPHIC_SHADOW_MAP);
+
         if (settings.mEnableDebugHud)
             mShadowTechnique->enableDebugHUD();
         else
@@ -196,8 +203,21 @@ namespace SceneUtil
         return definesWithoutShadows;
     }
 
+    void ShadowManager::setShadowCastingCacheMasks(
+        const Settings::ShadowsCategory& settings, unsigned int staticMask, unsigned int dynamicMask)
+    {
+        if (settings.mStaticShadowCache)
+            mShadowTechnique->setShadowCastingCacheMasks(staticMask, dynamicMask);
+    }
+
+    void ShadowManager::invalidateStaticShadows()
+    {
+        mShadowTechnique->invalidateStaticShadows();
+    }
+
     void ShadowManager::enableIndoorMode(const Settings::ShadowsCategory& settings)
     {
+        mShadowTechnique->invalidateStaticShadows();
         if (settings.mEnableIndoorShadows)
             mShadowSettings->setCastsShadowTraversalMask(mIndoorShadowCastingMask);
         else
@@ -206,6 +226,7 @@ namespace SceneUtil
 
     void ShadowManager::enableOutdoorMode()
     {
+        mShadowTechnique->invalidateStaticShadows();
         if (mEnableShadows)
             mShadowTechnique->enableShadows();
         mShadowSettings->setCastsShadowTraversalMask(mOutdoorShadowCastingMask);
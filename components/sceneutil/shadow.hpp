@@ -45,6 +45,14 @@ namespace SceneUtil
 
         void enableOutdoorMode();
 
+        /// Cache the shadows of static casters if enabled in the settings, see
+        /// MWShadowTechnique::setShadowCastingCacheMasks.
+        void setShadowCastingCacheMasks(
+            const Settings::ShadowsCategory& settings, unsigned int staticMask, unsigned int dynamicMask);
+
+        /// Render the cached shadows of static casters again, e.g. after loading cells.
+        void invalidateStaticShadows();
+
     protected:
         static ShadowManager* sInstance;
 
@@ -0,0 +1,155 @@
+#include "sharedstateregistry.hpp"
+
+#include <osg/Node>
+#include <osg/NodeVisitor>
+
+#include <map>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        bool isShareable(const osg::Object& object)
+        {
+            return object.getDataVariance() != osg::Object::DYNAMIC;
+        }
+
+        class ShareStateVisitor : public osg::NodeVisitor
+        {
+        public:
+            explicit ShareStateVisitor(SharedStateRegistry& registry)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mRegistry(registry)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (osg::StateSet* stateSet = node.getStateSet())
+                    node.setStateSet(share(*stateSet));
+                traverse(node);
+            }
+
+        private:
+            SharedStateRegistry& mRegistry;
+            // Objects used more than once in the graph are only looked up once
+            std::map<osg::StateSet*, osg::ref_ptr<osg::StateSet>> mStateSets;
+            std::map<osg::Texture*, osg::ref_ptr<osg::Texture>> mTextures;
+
+            osg::StateSet* share(osg::StateSet& stateSet)
+            {
+                const auto found = mStateSets.find(&stateSet);
+                if (found != mStateSets.end())
+                    return found->second;
+
+                osg::ref_ptr<osg::StateSet> result;
+                if (isShareable(stateSet))
+                    result = mRegistry.find(stateSet);
+                if (result == nullptr)
+                {
+                    // The textures have to be shared before the state set is, other threads may use it right away
+                    shareTextures(stateSet);
+                    result = isShareable(stateSet) ? mRegistry.findOrAdd(stateSet) : &stateSet;
+                }
+                return mStateSets.emplace(&stateSet, std::move(result)).first->second;
+            }
+
+            void shareTextures(osg::StateSet& stateSet)
+            {
+                for (unsigned unit = 0; unit < stateSet.getTextureAttributeList().size(); ++unit)
+                {
+                    const osg::StateSet::RefAttributePair* pair
+                        = stateSet.getTextureAttributePair(unit, osg::StateAttribute::TEXTURE);
+                    if (pair == nullptr)
+                        continue;
+                    osg::Texture* texture = pair->first->asTexture();
+                    if (texture == nullptr || !isShareable(*texture))
+                        continue;
+                    osg::Texture* shared = share(*texture);
+                    if (shared != texture)
+                        stateSet.setTextureAttribute(unit, shared, pair->second);
+                }
+            }
+
+            osg::Texture* share(osg::Texture& texture)
+            {
+                const auto found = mTextures.find(&texture);
+                if (found != mTextures.end())
+                    return found->second;
+                return mTextures.emplace(&texture, mRegistry.findOrAdd(texture)).first->second;
+            }
+        };
+    }
+
+    void SharedStateRegistry::share(osg::Node& node)
+    {
+        ShareStateVisitor visitor(*this);
+        node.accept(visitor);
+    }
+
+    void SharedStateRegistry::prune()
+    {
+        // Pruned state sets may hold the last references to textures
+        {
+            const std::lock_guard lock(mStateSetsMutex);
+            std::erase_if(mStateSets, [](const osg::ref_ptr<osg::StateSet>& v) { return v->referenceCount() <= 1; });
+        }
+        const std::lock_guard lock(mTexturesMutex);
+        std::erase_if(mTextures, [](const osg::ref_ptr<osg::Texture>& v) { return v->referenceCount() <= 1; });
+    }
+
+    void SharedStateRegistry::clear()
+    {
+        {
+            const std::lock_guard lock(mStateSetsMutex);
+            mStateSets.clear();
+        }
+        const std::lock_guard lock(mTexturesMutex);
+        mTextures.clear();
+    }
+
+    void SharedStateRegistry::releaseGLObjects(osg::State* state) const
+    {
+        {
+            const std::lock_guard lock(mStateSetsMutex);
+            for (const osg::ref_ptr<osg::StateSet>& stateSet : mStateSets)
+                stateSet->releaseGLObjects(state);
+        }
+        const std::lock_guard lock(mTexturesMutex);
+        for (const osg::ref_ptr<osg::Texture>& texture : mTextures)
+            texture->releaseGLObjects(state);
+    }
+
+    std::size_t SharedStateRegistry::getNumSharedTextures() const
+    {
+        const std::lock_guard lock(mTexturesMutex);
+        return mTextures.size();
+    }
+
+    std::size_t SharedStateRegistry::getNumSharedStateSets() const
+    {
+        const std::lock_guard lock(mStateSetsMutex);
+        return mStateSets.size();
+    }
+
+    osg::ref_ptr<osg::StateSet> SharedStateRegistry::find(osg::StateSet& stateSet) const
+    {
+        const std::lock_guard lock(mStateSetsMutex);
+        const auto it = mStateSets.find(osg::ref_ptr<osg::StateSet>(&stateSet));
+        if (it == mStateSets.end())
+            return nullptr;
+        return *it;
+    }
+
+    osg::ref_ptr<osg::StateSet> SharedStateRegistry::findOrAdd(osg::StateSet& stateSet)
+    {
+        const std::lock_guard lock(mStateSetsMutex);
+        return *mStateSets.emplace(&stateSet).first;
+    }
+
+    osg::ref_ptr<osg::Texture> SharedStateRegistry::findOrAdd(osg::Texture& texture)
+    {
+        const std::lock_guard lock(mTexturesMutex);
+        return *mTextures.emplace(&texture).first;
+    }
+}
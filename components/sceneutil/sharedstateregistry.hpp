@@ -0,0 +1,78 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SHAREDSTATEREGISTRY_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SHAREDSTATEREGISTRY_H
+
+#include <osg/Referenced>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <mutex>
+#include <set>
+
+namespace osg
+{
+    class Node;
+    class State;
+}
+
+namespace SceneUtil
+{
+    /// @brief Replaces equal state sets and textures in scene graphs with a single shared instance.
+    /// @par Does what osgDB::SharedStateManager does with its default mode, but that one keeps the state of its
+    /// traversal in itself, so it has to be locked for the whole traversal of every graph. Here every call to share
+    /// traverses with its own state, and the registry is only locked to find or add one object, so graphs loaded by
+    /// different threads are shared concurrently.
+    /// @note Objects with the DYNAMIC data variance are not shared.
+    class SharedStateRegistry : public osg::Referenced
+    {
+    public:
+        /// Share the state of a graph no other thread is changing.
+        void share(osg::Node& node);
+
+        /// Forget the shared objects not used by any graph anymore.
+        void prune();
+
+        void clear();
+
+        void releaseGLObjects(osg::State* state) const;
+
+        std::size_t getNumSharedTextures() const;
+
+        std::size_t getNumSharedStateSets() const;
+
+        /// @return The shared state set equal to the given one, nullptr if there is none.
+        osg::ref_ptr<osg::StateSet> find(osg::StateSet& stateSet) const;
+
+        /// @return The shared state set equal to the given one, which is added if there is none.
+        /// @note Other threads may use an added state set right away, so it must not be changed afterwards.
+        osg::ref_ptr<osg::StateSet> findOrAdd(osg::StateSet& stateSet);
+
+        /// @return The shared texture equal to the given one, which is added if there is none.
+        osg::ref_ptr<osg::Texture> findOrAdd(osg::Texture& texture);
+
+    private:
+        struct LessStateSet
+        {
+            bool operator()(const osg::ref_ptr<osg::StateSet>& lhs, const osg::ref_ptr<osg::StateSet>& rhs) const
+            {
+                return lhs->compare(*rhs, true) < 0;
+            }
+        };
+
+        struct LessTexture
+        {
+            bool operator()(const osg::ref_ptr<osg::Texture>& lhs, const osg::ref_ptr<osg::Texture>& rhs) const
+            {
+                return lhs->compare(*rhs) < 0;
+            }
+        };
+
+        mutable std::mutex mStateSetsMutex;
+        std::set<osg::ref_ptr<osg::StateSet>, LessStateSet> mStateSets;
+        mutable std::mutex mTexturesMutex;
+        std::set<osg::ref_ptr<osg::Texture>, LessTexture> mTextures;
+    };
+}
+
+#endif
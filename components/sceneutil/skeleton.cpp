@@ -6,6 +6,7 @@
 #include <components/misc/strings/lower.hpp>
 
 #include <algorithm>
+#include <limits>
 
 namespace SceneUtil
 {
@@ -94,7 +95,7 @@ namespace SceneUtil
 
     void Skeleton::updateBoneMatrices(unsigned int traversalNumber)
     {
-        if (traversalNumber != mLastFrameNumber)
+        if (traversalNumber != mLastFrameNumber && traversalNumber != mSkippedFrameNumber)
             mNeedToUpdateBoneMatrices = true;
 
         mLastFrameNumber = traversalNumber;
@@ -121,9 +122,17 @@ namespace SceneUtil
         return mActive != Inactive;
     }
 
+    void Skeleton::setUpdateInterval(unsigned int interval, unsigned int phase)
+    {
+        mUpdateInterval = std::max(interval, 1u);
+        mUpdatePhase = phase;
+    }
+
     void Skeleton::markDirty()
     {
         mLastFrameNumber = 0;
+        mSkippedFrameNumber = 0;
+        mPoseFrameNumber = std::numeric_limits<unsigned int>::max();
         mBoneCache.clear();
         mBoneCacheInit = false;
     }
@@ -136,6 +145,13 @@ namespace SceneUtil
                 return;
             if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
                 return;
+            if (mUpdateInterval > 1 && mLastFrameNumber != 0
+                && (nv.getTraversalNumber() + mUpdatePhase) % mUpdateInterval != 0)
+            {
+                mSkippedFrameNumber = nv.getTraversalNumber();
+                return;
+            }
+            mPoseFrameNumber = nv.getTraversalNumber();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
             mLastCullFrameNumber = nv.getTraversalNumber();
@@ -56,6 +56,14 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Run the update traversal of the bones, including their animation controllers, only every few frames.
+        /// The phase spreads the updates of skeletons with the same interval over its frames. 1 updates every frame.
+        void setUpdateInterval(unsigned int interval, unsigned int phase);
+
+        /// @return Whether the bones kept their pose since the given traversal, so anything computed from the pose in
+        /// that traversal can be reused.
+        bool isPoseUnchangedSince(unsigned int traversalNumber) const { return mPoseFrameNumber <= traversalNumber; }
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -78,6 +86,13 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        unsigned int mUpdateInterval = 1;
+        unsigned int mUpdatePhase = 0;
+        // Bones keep their pose on the frames their update is skipped, so their matrices don't change either
+        unsigned int mSkippedFrameNumber = 0;
+        // Last traversal that ran the update of the bones
+        unsigned int mPoseFrameNumber = 0;
     };
 
 }
@@ -0,0 +1,117 @@
+#include "skinning.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Transforms are written without osg::Matrixf calls and the perspective division, so they can be vectorized
+        template <class Vec, class Function>
+        void transformVertices(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+            std::span<const Vec> source, std::span<Vec> destination, Function&& function)
+        {
+            const std::size_t size
+                = std::min({ influences.mVertexGroups.size(), source.size(), destination.size() });
+            const std::uint32_t* const groups = influences.mVertexGroups.data();
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const std::uint32_t group = groups[i];
+                if (group == SkinningInfluences::sNoGroup)
+                    continue;
+                destination[i] = function(matrices[group].data(), source[i]);
+            }
+        }
+
+        osg::Vec3f transformDirection(const float* m, const osg::Vec3f& v)
+        {
+            return osg::Vec3f(m[0] * v.x() + m[1] * v.y() + m[2] * v.z(), m[4] * v.x() + m[5] * v.y() + m[6] * v.z(),
+                m[8] * v.x() + m[9] * v.y() + m[10] * v.z());
+        }
+    }
+
+    std::size_t SkinningInfluences::getMaxGroupSize() const
+    {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < getGroupCount(); ++i)
+            result = std::max<std::size_t>(result, mGroupOffsets[i + 1] - mGroupOffsets[i]);
+        return result;
+    }
+
+    void SkinningInfluences::addGroup(
+        std::span<const std::pair<std::size_t, float>> influences, std::span<const unsigned short> vertices)
+    {
+        const std::uint32_t group = static_cast<std::uint32_t>(getGroupCount());
+        for (const auto& [bone, weight] : influences)
+        {
+            mBones.push_back(static_cast<std::uint32_t>(bone));
+            mWeights.push_back(weight);
+        }
+        mGroupOffsets.push_back(static_cast<std::uint32_t>(mBones.size()));
+
+        for (unsigned short vertex : vertices)
+        {
+            if (vertex >= mVertexGroups.size())
+                mVertexGroups.resize(vertex + 1, sNoGroup);
+            mVertexGroups[vertex] = group;
+        }
+    }
+
+    void blendSkinningMatrices(const SkinningInfluences& influences, std::span<const osg::Matrixf> boneMatrices,
+        const osg::Matrixf& transform, std::vector<SkinningMatrix>& result)
+    {
+        const std::size_t groupCount = influences.getGroupCount();
+        result.resize(groupCount);
+
+        const float* const t = transform.ptr();
+        for (std::size_t group = 0; group < groupCount; ++group)
+        {
+            // Weighted sum of the first three columns of the bone matrices, the last one is always (0, 0, 0, 1)
+            std::array<float, 16> blended{};
+            for (std::uint32_t i = influences.mGroupOffsets[group]; i < influences.mGroupOffsets[group + 1]; ++i)
+            {
+                assert(influences.mBones[i] < boneMatrices.size());
+                const float* const bone = boneMatrices[influences.mBones[i]].ptr();
+                const float weight = influences.mWeights[i];
+                for (std::size_t j = 0; j < 16; ++j)
+                    blended[j] += bone[j] * weight;
+            }
+
+            // Multiply by the transform assuming both are affine, then transpose the result to get rows
+            SkinningMatrix& out = result[group];
+            for (std::size_t column = 0; column < 3; ++column)
+            {
+                for (std::size_t row = 0; row < 4; ++row)
+                {
+                    const float* const b = blended.data() + row * 4;
+                    out[column * 4 + row] = b[0] * t[column] + b[1] * t[4 + column] + b[2] * t[8 + column]
+                        + (row == 3 ? t[12 + column] : 0.0f);
+                }
+            }
+        }
+    }
+
+    void skinPositions(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+        std::span<const osg::Vec3f> source, std::span<osg::Vec3f> destination)
+    {
+        transformVertices(influences, matrices, source, destination, [](const float* m, const osg::Vec3f& v) {
+            return osg::Vec3f(m[0] * v.x() + m[1] * v.y() + m[2] * v.z() + m[3],
+                m[4] * v.x() + m[5] * v.y() + m[6] * v.z() + m[7], m[8] * v.x() + m[9] * v.y() + m[10] * v.z() + m[11]);
+        });
+    }
+
+    void skinNormals(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+        std::span<const osg::Vec3f> source, std::span<osg::Vec3f> destination)
+    {
+        transformVertices(influences, matrices, source, destination, transformDirection);
+    }
+
+    void skinTangents(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+        std::span<const osg::Vec4f> source, std::span<osg::Vec4f> destination)
+    {
+        transformVertices(influences, matrices, source, destination, [](const float* m, const osg::Vec4f& v) {
+            return osg::Vec4f(transformDirection(m, osg::Vec3f(v.x(), v.y(), v.z())), v.w());
+        });
+    }
+}
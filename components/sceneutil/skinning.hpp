@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Vertex influences of a skinned mesh flattened into plain arrays.
+    /// @note Vertices sharing the same bones and weights form a group, so the blended matrix is computed once per
+    /// group. Vertices are then transformed in their storage order.
+    struct SkinningInfluences
+    {
+        static constexpr std::uint32_t sNoGroup = std::numeric_limits<std::uint32_t>::max();
+
+        // Influences of the group i are in [mGroupOffsets[i], mGroupOffsets[i + 1])
+        std::vector<std::uint32_t> mGroupOffsets{ 0 };
+        std::vector<std::uint32_t> mBones;
+        std::vector<float> mWeights;
+        // Group of each vertex, sNoGroup when the vertex is not affected by any bone
+        std::vector<std::uint32_t> mVertexGroups;
+
+        std::size_t getGroupCount() const { return mGroupOffsets.size() - 1; }
+
+        std::size_t getMaxGroupSize() const;
+
+        /// @param vertices The vertices affected by the influences, each one must be in a single group.
+        void addGroup(std::span<const std::pair<std::size_t, float>> influences, std::span<const unsigned short> vertices);
+    };
+
+    /// Affine part of a skinning matrix stored by rows, so a position is transformed with three dot products.
+    using SkinningMatrix = std::array<float, 12>;
+
+    /// Blend the bone matrices of each group and apply the transform to the result.
+    void blendSkinningMatrices(const SkinningInfluences& influences, std::span<const osg::Matrixf> boneMatrices,
+        const osg::Matrixf& transform, std::vector<SkinningMatrix>& result);
+
+    /// Transform the vertices affected by a group, others are left unchanged in the destination.
+    void skinPositions(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+        std::span<const osg::Vec3f> source, std::span<osg::Vec3f> destination);
+
+    void skinNormals(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+        std::span<const osg::Vec3f> source, std::span<osg::Vec3f> destination);
+
+    void skinTangents(const SkinningInfluences& influences, std::span<const SkinningMatrix> matrices,
+        std::span<const osg::Vec4f> source, std::span<osg::Vec4f> destination);
+}
+
+#endif
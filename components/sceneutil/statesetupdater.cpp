@@ -20,6 +20,22 @@ namespace SceneUtil
     }
 
     void StateSetUpdater::applyUpdate(osg::Node* node, osg::NodeVisitor* nv)
+    {
+        if (!mParallel || !ParallelUpdateVisitor::isUpdated(*node, *this, *this, nv))
+            updateStateSet(node, nv);
+        traverse(node, nv);
+    }
+
+    bool StateSetUpdater::updateParallel(osg::Node& node, osg::NodeVisitor& nv)
+    {
+        // Copying the StateSet of the node changes the parents of shared attributes
+        if (!mStateSetsUpdate[0])
+            return false;
+        updateStateSet(&node, &nv);
+        return true;
+    }
+
+    void StateSetUpdater::updateStateSet(osg::Node* node, osg::NodeVisitor* nv)
     {
         if (!mStateSetsUpdate[0])
         {
@@ -35,7 +51,6 @@ namespace SceneUtil
         osg::ref_ptr<osg::StateSet> stateset = mStateSetsUpdate[nv->getTraversalNumber() % 2];
         apply(stateset, nv);
         node->setStateSet(stateset);
-        traverse(node, nv);
     }
 
     void StateSetUpdater::applyCull(osg::Node* node, osgUtil::CullVisitor* cv)
@@ -81,6 +96,7 @@ namespace SceneUtil
 
     StateSetUpdater::StateSetUpdater(const StateSetUpdater& copy, const osg::CopyOp& copyop)
         : SceneUtil::NodeCallback<StateSetUpdater>(copy, copyop)
+        , mParallel(copy.mParallel)
     {
     }
 
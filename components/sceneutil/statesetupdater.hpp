@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_SCENEUTIL_STATESETCONTROLLER_H
 
 #include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/parallelupdate.hpp>
 
 #include <array>
 #include <map>
@@ -33,7 +34,9 @@ namespace SceneUtil
     /// @note Do not add the same StateSetUpdater to multiple nodes.
     /// @note Do not add multiple StateSetUpdaters on the same Node as they will conflict - instead use the
     /// CompositeStateSetUpdater.
-    class StateSetUpdater : public SceneUtil::NodeCallback<StateSetUpdater>
+    /// @note As an UpdateCallback, updaters enabled with setParallel run concurrently before the update traversal, see
+    /// ParallelUpdateVisitor.
+    class StateSetUpdater : public SceneUtil::NodeCallback<StateSetUpdater>, public ParallelUpdateCallback
     {
     public:
         StateSetUpdater();
@@ -60,13 +63,22 @@ namespace SceneUtil
         /// Reset mStateSets, forcing a setDefaults() on the next frame. Can be used to change the defaults if needed.
         void reset();
 
+        bool updateParallel(osg::Node& node, osg::NodeVisitor& nv) override;
+
+    protected:
+        /// Only for updaters whose apply() changes nothing but the given StateSet and reads nothing written by other
+        /// update callbacks, see ParallelUpdateCallback.
+        void setParallel(bool value) { mParallel = value; }
+
     private:
         void applyCull(osg::Node* node, osgUtil::CullVisitor* cv);
         void applyUpdate(osg::Node* node, osg::NodeVisitor* nv);
+        void updateStateSet(osg::Node* node, osg::NodeVisitor* nv);
         osg::StateSet* getCvDependentStateset(osgUtil::CullVisitor* cv);
 
         std::array<osg::ref_ptr<osg::StateSet>, 2> mStateSetsUpdate;
         std::map<osgUtil::CullVisitor*, osg::ref_ptr<osg::StateSet>> mStateSetsCull;
+        bool mParallel = false;
     };
 
     /// @brief A variant of the StateSetController that can be made up of multiple controllers all controlling the same
@@ -2,6 +2,8 @@
 
 #include <components/sceneutil/workqueue.hpp>
 
+#include <algorithm>
+
 namespace SceneUtil
 {
     namespace
@@ -24,9 +26,19 @@ namespace SceneUtil
         if (mObjects.empty())
             return;
 
+        // A cell unload can queue thousands of objects, deleting them in bounded items lets the worker threads pick
+        // up other work in between instead of being held by one long item
+        constexpr std::size_t maxObjectsPerItem = 256;
+
         // Move only objects to keep allocated storage in mObjects
-        workQueue.addWorkItem(new ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>(
-            std::move_iterator(mObjects.begin()), std::move_iterator(mObjects.end()))));
+        for (auto it = mObjects.begin(); it != mObjects.end();)
+        {
+            const auto end = it + std::min<std::ptrdiff_t>(maxObjectsPerItem, mObjects.end() - it);
+            osg::ref_ptr<ClearVector> item = new ClearVector(
+                std::vector<osg::ref_ptr<osg::Referenced>>(std::move_iterator(it), std::move_iterator(end)));
+            workQueue.addWorkItem(std::move(item), WorkPriority::Low);
+            it = end;
+        }
         mObjects.clear();
     }
 }
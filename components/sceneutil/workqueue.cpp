@@ -1,31 +1,104 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 
+#include <osg/Stats>
+
+#include <algorithm>
+#include <exception>
 #include <numeric>
+#include <string>
+#include <utility>
 
 namespace SceneUtil
 {
-
-    void WorkItem::waitTillDone()
+    namespace
     {
-        if (mDone)
-            return;
+        constexpr std::string_view priorityNames[] = { "High", "Normal", "Low" };
 
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (!mDone)
+        static_assert(std::size(priorityNames) == sWorkPriorityCount);
+
+        class ParallelForState : public osg::Referenced
         {
-            mCondition.wait(lock);
-        }
+        public:
+            explicit ParallelForState(std::size_t count, const std::function<void(std::size_t)>& func)
+                : mCount(count)
+                , mFunc(&func)
+            {
+            }
+
+            /// Claim and process indices until there are none left.
+            void run()
+            {
+                while (true)
+                {
+                    // mFunc may already be gone when there is nothing left to claim, don't touch it
+                    const std::size_t index = mNext.fetch_add(1);
+                    if (index >= mCount)
+                        return;
+
+                    try
+                    {
+                        (*mFunc)(index);
+                    }
+                    catch (...)
+                    {
+                        const std::lock_guard lock(mMutex);
+                        if (mException == nullptr)
+                            mException = std::current_exception();
+                    }
+
+                    if (mCompleted.fetch_add(1) + 1 == mCount)
+                    {
+                        const std::lock_guard lock(mMutex);
+                        mCondition.notify_all();
+                    }
+                }
+            }
+
+            void wait()
+            {
+                std::unique_lock lock(mMutex);
+                mCondition.wait(lock, [&] { return mCompleted == mCount; });
+                if (mException != nullptr)
+                    std::rethrow_exception(mException);
+            }
+
+        private:
+            const std::size_t mCount;
+            const std::function<void(std::size_t)>* mFunc;
+            std::atomic_size_t mNext{ 0 };
+            std::atomic_size_t mCompleted{ 0 };
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::exception_ptr mException;
+        };
+
+        class ParallelForItem : public WorkItem
+        {
+        public:
+            explicit ParallelForItem(osg::ref_ptr<ParallelForState> state)
+                : mState(std::move(state))
+            {
+            }
+
+            void doWork() override { mState->run(); }
+
+        private:
+            osg::ref_ptr<ParallelForState> mState;
+        };
+    }
+
+    void WorkItem::waitTillDone()
+    {
+        mDone.wait(false);
     }
 
     void WorkItem::signalDone()
     {
-        {
-            std::unique_lock<std::mutex> lock(mMutex);
-            mDone = true;
-        }
-        mCondition.notify_all();
+        mDone = true;
+        mDone.notify_all();
     }
 
     bool WorkItem::isDone() const
@@ -58,8 +131,8 @@ namespace SceneUtil
     {
         {
             std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
+            for (std::deque<QueuedItem>& queue : mQueues)
+                queue.clear();
             mIsReleased = true;
             mCondition.notify_all();
         }
@@ -68,6 +141,11 @@ namespace SceneUtil
     }
 
     void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
+    {
+        addWorkItem(std::move(item), WorkPriority::Normal, front);
+    }
+
+    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority, bool front)
     {
         if (item->isDone())
         {
@@ -75,26 +153,54 @@ namespace SceneUtil
             return;
         }
 
+        QueuedItem queued{ std::move(item), std::chrono::steady_clock::now() };
+        std::deque<QueuedItem>& queue = mQueues[static_cast<std::size_t>(priority)];
+
         std::unique_lock<std::mutex> lock(mMutex);
         if (front)
-            mQueue.push_front(std::move(item));
+            queue.push_front(std::move(queued));
         else
-            mQueue.push_back(std::move(item));
+            queue.push_back(std::move(queued));
         mCondition.notify_one();
     }
 
+    void WorkQueue::abortWorkItem(WorkItem& item)
+    {
+        item.abort();
+
+        {
+            const std::lock_guard lock(mMutex);
+            const auto isItem = [&](const QueuedItem& queued) { return queued.mItem == &item; };
+            const auto found = std::find_if(mQueues.begin(), mQueues.end(),
+                [&](const std::deque<QueuedItem>& queue) { return std::any_of(queue.begin(), queue.end(), isItem); });
+            if (found == mQueues.end())
+                return;
+            found->erase(std::find_if(found->begin(), found->end(), isItem));
+        }
+
+        item.signalDone();
+    }
+
     osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        const auto hasItems = [&] {
+            return std::any_of(mQueues.begin(), mQueues.end(), [](const auto& queue) { return !queue.empty(); });
+        };
+        while (!hasItems() && !mIsReleased)
         {
             mCondition.wait(lock);
         }
-        if (!mQueue.empty())
+        for (std::size_t priority = 0; priority < sWorkPriorityCount; ++priority)
         {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            std::deque<QueuedItem>& queue = mQueues[priority];
+            if (queue.empty())
+                continue;
+            QueuedItem queued = std::move(queue.front());
+            queue.pop_front();
+            mStats[priority].mWaited += std::chrono::steady_clock::now() - queued.mQueued;
+            ++mStats[priority].mStarted;
+            return std::move(queued.mItem);
         }
         return nullptr;
     }
@@ -102,7 +208,8 @@ namespace SceneUtil
     unsigned int WorkQueue::getNumItems() const
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return std::accumulate(
+            mQueues.begin(), mQueues.end(), 0u, [](auto r, const auto& queue) { return r + queue.size(); });
     }
 
     unsigned int WorkQueue::getNumActiveThreads() const
@@ -111,6 +218,49 @@ namespace SceneUtil
             mThreads.begin(), mThreads.end(), 0u, [](auto r, const auto& t) { return r + t->isActive(); });
     }
 
+    void WorkQueue::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        std::array<std::size_t, sWorkPriorityCount> sizes;
+        std::array<PriorityStats, sWorkPriorityCount> priorityStats;
+
+        {
+            const std::lock_guard lock(mMutex);
+            for (std::size_t i = 0; i < sWorkPriorityCount; ++i)
+                sizes[i] = mQueues[i].size();
+            priorityStats = std::exchange(mStats, {});
+        }
+
+        stats.setAttribute(frameNumber, "WorkQueue", std::accumulate(sizes.begin(), sizes.end(), std::size_t{ 0 }));
+        stats.setAttribute(frameNumber, "WorkThread", getNumActiveThreads());
+
+        for (std::size_t i = 0; i < sWorkPriorityCount; ++i)
+        {
+            const std::string prefix = "WorkQueue " + std::string(priorityNames[i]);
+            stats.setAttribute(frameNumber, prefix, sizes[i]);
+            if (priorityStats[i].mStarted == 0)
+                continue;
+            const std::chrono::duration<double, std::milli> waited = priorityStats[i].mWaited;
+            stats.setAttribute(frameNumber, prefix + " Wait ms", waited.count() / priorityStats[i].mStarted);
+        }
+    }
+
+    void parallelFor(WorkQueue& workQueue, std::size_t count, std::size_t maxHelpers,
+        const std::function<void(std::size_t)>& func)
+    {
+        if (count == 0)
+            return;
+
+        const osg::ref_ptr<ParallelForState> state = new ParallelForState(count, func);
+
+        // Helpers go to the front to not wait behind long running items, those that start late find nothing to do
+        const std::size_t helpers = std::min(maxHelpers, count - 1);
+        for (std::size_t i = 0; i < helpers; ++i)
+            workQueue.addWorkItem(new ParallelForItem(state), WorkPriority::High, true);
+
+        state->run();
+        state->wait();
+    }
+
     WorkThread::WorkThread(WorkQueue& workQueue)
         : mWorkQueue(&workQueue)
         , mActive(false)
@@ -125,13 +275,18 @@ namespace SceneUtil
 
     void WorkThread::run()
     {
+        OPENMW_TRACE_THREAD_NAME("Work Queue");
+
         while (true)
         {
             osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
             if (!item)
                 return;
             mActive = true;
-            item->doWork();
+            {
+                OPENMW_TRACE_SCOPE("Work Item");
+                item->doWork();
+            }
             item->signalDone();
             mActive = false;
         }
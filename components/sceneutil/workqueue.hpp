@@ -4,15 +4,32 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace SceneUtil
 {
+    /// Items of a higher priority are started before any item of a lower priority.
+    enum class WorkPriority : std::size_t
+    {
+        High, ///< Something is or soon will be waiting for the item.
+        Normal,
+        Low, ///< Speculative or bulk work, like preloading and deferred deletion.
+    };
+
+    inline constexpr std::size_t sWorkPriorityCount = 3;
 
     class WorkItem : public osg::Referenced
     {
@@ -32,15 +49,14 @@ namespace SceneUtil
         virtual void abort() {}
 
     private:
+        // Most items are never waited for, so waiting doesn't need a mutex and condition variable per item
         std::atomic_bool mDone{ false };
-        std::mutex mMutex;
-        std::condition_variable mCondition;
     };
 
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
+    /// @note Work items of the same priority will be processed in the order that they were given in, however
     /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
@@ -57,7 +73,15 @@ namespace SceneUtil
         /// @param front If true, add item to the front of the queue. If false (default), add to the back.
         void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
+        /// Add a new work item to the back of the queue of the given priority.
+        /// @param front If true, add item to the front of the queue of the priority instead.
+        void addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority, bool front = false);
+
+        /// Abort the work item. If no thread has started it yet, remove it from the queue and mark it done without
+        /// calling doWork(), so waiting for a stale item doesn't wait for the items queued before it.
+        void abortWorkItem(WorkItem& item);
+
+        /// Get the next work item of the highest priority. If the queue is empty, waits until a new item is added.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
         osg::ref_ptr<WorkItem> removeWorkItem();
@@ -66,9 +90,28 @@ namespace SceneUtil
 
         unsigned int getNumActiveThreads() const;
 
+        std::size_t getNumThreads() const { return mThreads.size(); }
+
+        /// Report the number of queued items and the average time items waited before they were started since the
+        /// previous report, for every priority.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
     private:
+        struct QueuedItem
+        {
+            osg::ref_ptr<WorkItem> mItem;
+            std::chrono::steady_clock::time_point mQueued;
+        };
+
+        struct PriorityStats
+        {
+            std::chrono::steady_clock::duration mWaited{};
+            std::size_t mStarted = 0;
+        };
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
+        std::array<std::deque<QueuedItem>, sWorkPriorityCount> mQueues;
+        std::array<PriorityStats, sWorkPriorityCount> mStats;
 
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
@@ -76,6 +119,13 @@ namespace SceneUtil
         std::vector<std::unique_ptr<WorkThread>> mThreads;
     };
 
+    /// Call func for every index in [0, count) using the calling thread and up to maxHelpers threads of the work queue.
+    /// @par Returns once all calls are completed. The calling thread never waits for a helper item that hasn't started
+    /// yet, so it is safe to call from a work item running on the same queue.
+    /// @note The first exception thrown by func is rethrown after all calls are completed.
+    void parallelFor(WorkQueue& workQueue, std::size_t count, std::size_t maxHelpers,
+        const std::function<void(std::size_t)>& func);
+
     /// Internally used by WorkQueue.
     class WorkThread
     {
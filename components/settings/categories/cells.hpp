@@ -31,7 +31,17 @@ namespace Settings
             makeMaxSanitizerFloat(0) };
         SettingValue<float> mPredictionTime{ mIndex, "Cells", "prediction time", makeMaxSanitizerFloat(0) };
         SettingValue<float> mCacheExpiryDelay{ mIndex, "Cells", "cache expiry delay", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mTextureCacheMaxSize{ mIndex, "Cells", "texture cache max size", makeMaxSanitizerInt(0) };
+        SettingValue<int> mModelCacheMaxSize{ mIndex, "Cells", "model cache max size", makeMaxSanitizerInt(0) };
+        SettingValue<int> mNifCacheMaxSize{ mIndex, "Cells", "nif cache max size", makeMaxSanitizerInt(0) };
+        SettingValue<int> mCollisionShapeCacheMaxSize{ mIndex, "Cells", "collision shape cache max size",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mReadAheadCacheSize{ mIndex, "Cells", "read ahead cache size", makeMaxSanitizerInt(0) };
         SettingValue<float> mTargetFramerate{ mIndex, "Cells", "target framerate", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<int> mMaxCompileSizePerFrame{ mIndex, "Cells", "max compile size per frame",
+            makeMaxSanitizerInt(0) };
+        SettingValue<float> mCellActivationBudget{ mIndex, "Cells", "cell activation budget",
+            makeMaxSanitizerFloat(0) };
         SettingValue<int> mPointersCacheSize{ mIndex, "Cells", "pointers cache size", makeClampSanitizerInt(40, 1000) };
     };
 }
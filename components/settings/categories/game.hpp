@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Settings
 {
@@ -74,6 +75,19 @@ namespace Settings
         SettingValue<DetourNavigator::CollisionShapeType> mActorCollisionShapeType{ mIndex, "Game",
             "actor collision shape type" };
         SettingValue<bool> mPlayerMovementIgnoresAnimation{ mIndex, "Game", "player movement ignores animation" };
+        SettingValue<float> mLocalScriptsTimeBudget{ mIndex, "Game", "local scripts time budget",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<std::vector<std::string>> mDeferrableLocalScripts{ mIndex, "Game", "deferrable local scripts" };
+        SettingValue<bool> mAiUpdateLod{ mIndex, "Game", "ai update lod" };
+        SettingValue<float> mAiLodDistance{ mIndex, "Game", "ai lod distance", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mAiLodVisibleInterval{ mIndex, "Game", "ai lod visible interval",
+            makeClampSanitizerInt(1, 16) };
+        SettingValue<int> mAiLodHiddenInterval{ mIndex, "Game", "ai lod hidden interval",
+            makeClampSanitizerInt(1, 16) };
+        SettingValue<bool> mAnimationUpdateLod{ mIndex, "Game", "animation update lod" };
+        SettingValue<float> mAnimationLodDistance{ mIndex, "Game", "animation lod distance", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mAnimationLodInterval{ mIndex, "Game", "animation lod interval",
+            makeClampSanitizerInt(1, 16) };
     };
 }
 
@@ -27,11 +27,14 @@ namespace Settings
             makeEnumSanitizerString({ "nearest", "linear" }) };
         SettingValue<std::string> mTextureMipmap{ mIndex, "General", "texture mipmap",
             makeEnumSanitizerString({ "none", "nearest", "linear" }) };
+        SettingValue<int> mMaxTextureSize{ mIndex, "General", "max texture size", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mCacheCompressedTextures{ mIndex, "General", "cache compressed textures" };
         SettingValue<bool> mNotifyOnSavedScreenshot{ mIndex, "General", "notify on saved screenshot" };
         SettingValue<std::vector<std::string>> mPreferredLocales{ mIndex, "General", "preferred locales" };
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<bool> mCacheContentFiles{ mIndex, "General", "cache content files" };
     };
 }
 
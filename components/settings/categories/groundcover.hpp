@@ -21,6 +21,7 @@ namespace Settings
         SettingValue<bool> mEnabled{ mIndex, "Groundcover", "enabled" };
         SettingValue<float> mDensity{ mIndex, "Groundcover", "density", makeClampSanitizerFloat(0, 1) };
         SettingValue<float> mRenderingDistance{ mIndex, "Groundcover", "rendering distance", makeMaxSanitizerFloat(0) };
+        SettingValue<float> mDistantDensity{ mIndex, "Groundcover", "distant density", makeClampSanitizerFloat(0, 1) };
         SettingValue<int> mStompMode{ mIndex, "Groundcover", "stomp mode", makeEnumSanitizerInt({ 0, 1, 2 }) };
         SettingValue<int> mStompIntensity{ mIndex, "Groundcover", "stomp intensity",
             makeEnumSanitizerInt({ 0, 1, 2 }) };
@@ -11,6 +11,9 @@ namespace Settings
         using WithIndex::WithIndex;
 
         SettingValue<bool> mLoadUnsupportedNifFiles{ mIndex, "Models", "load unsupported nif files" };
+        SettingValue<bool> mCacheConvertedModels{ mIndex, "Models", "cache converted models" };
+        SettingValue<bool> mCacheCollisionShapes{ mIndex, "Models", "cache collision shapes" };
+        SettingValue<bool> mPauseOffscreenParticles{ mIndex, "Models", "pause offscreen particles" };
         SettingValue<VFS::Path::Normalized> mXbaseanim{ mIndex, "Models", "xbaseanim" };
         SettingValue<VFS::Path::Normalized> mBaseanim{ mIndex, "Models", "baseanim" };
         SettingValue<VFS::Path::Normalized> mXbaseanim1st{ mIndex, "Models", "xbaseanim1st" };
@@ -21,6 +21,8 @@ namespace Settings
         SettingValue<int> mAsyncNumThreads{ mIndex, "Physics", "async num threads", makeMaxSanitizerInt(0) };
         SettingValue<int> mLineofsightKeepInactiveCache{ mIndex, "Physics", "lineofsight keep inactive cache",
             makeMaxSanitizerInt(-1) };
+        SettingValue<float> mActorLodDistance{ mIndex, "Physics", "actor lod distance", makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mMergeStaticCollision{ mIndex, "Physics", "merge static collision" };
     };
 }
 
@@ -21,6 +21,8 @@ namespace Settings
         SettingValue<std::string> mCharacter{ mIndex, "Saves", "character" };
         SettingValue<bool> mAutosave{ mIndex, "Saves", "autosave" };
         SettingValue<int> mMaxQuicksaves{ mIndex, "Saves", "max quicksaves", makeMaxSanitizerInt(1) };
+        SettingValue<bool> mCompress{ mIndex, "Saves", "compress" };
+        SettingValue<int> mDeltaSaves{ mIndex, "Saves", "delta saves", makeMaxSanitizerInt(0) };
     };
 }
 
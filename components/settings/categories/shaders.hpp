@@ -48,6 +48,12 @@ namespace Settings
         SettingValue<bool> mWeatherParticleOcclusion{ mIndex, "Shaders", "weather particle occlusion" };
         SettingValue<float> mWeatherParticleOcclusionSmallFeatureCullingPixelSize{ mIndex, "Shaders",
             "weather particle occlusion small feature culling pixel size" };
+        SettingValue<bool> mGpuSkinning{ mIndex, "Shaders", "gpu skinning" };
+        SettingValue<bool> mGpuMorphing{ mIndex, "Shaders", "gpu morphing" };
+        SettingValue<bool> mClusteredLighting{ mIndex, "Shaders", "clustered lighting" };
+        SettingValue<bool> mGpuRain{ mIndex, "Shaders", "gpu rain" };
+        SettingValue<bool> mCacheProgramBinaries{ mIndex, "Shaders", "cache program binaries" };
+        SettingValue<bool> mPrecompileShaders{ mIndex, "Shaders", "precompile shaders" };
     };
 }
 
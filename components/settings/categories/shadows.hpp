@@ -42,6 +42,9 @@ namespace Settings
         SettingValue<bool> mTerrainShadows{ mIndex, "Shadows", "terrain shadows" };
         SettingValue<bool> mObjectShadows{ mIndex, "Shadows", "object shadows" };
         SettingValue<bool> mEnableIndoorShadows{ mIndex, "Shadows", "enable indoor shadows" };
+        SettingValue<bool> mStaticShadowCache{ mIndex, "Shadows", "static shadow cache" };
+        SettingValue<float> mMinimumCasterSize{ mIndex, "Shadows", "minimum caster size", makeMaxSanitizerFloat(0) };
+        SettingValue<float> mCasterLodScale{ mIndex, "Shadows", "caster lod scale", makeMaxStrictSanitizerFloat(0) };
     };
 }
 
@@ -26,6 +26,7 @@ namespace Settings
             makeMaxSanitizerInt(1) };
         SettingValue<float> mMaxCompositeGeometrySize{ mIndex, "Terrain", "max composite geometry size",
             makeMaxSanitizerFloat(1) };
+        SettingValue<bool> mCacheCompositeMaps{ mIndex, "Terrain", "cache composite maps" };
         SettingValue<bool> mDebugChunks{ mIndex, "Terrain", "debug chunks" };
         SettingValue<bool> mObjectPaging{ mIndex, "Terrain", "object paging" };
         SettingValue<bool> mObjectPagingActiveGrid{ mIndex, "Terrain", "object paging active grid" };
@@ -37,7 +38,17 @@ namespace Settings
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mObjectPagingInstancing{ mIndex, "Terrain", "object paging instancing" };
+        SettingValue<float> mObjectPagingSimplificationRatio{ mIndex, "Terrain",
+            "object paging simplification ratio", makeClampSanitizerFloat(0.01f, 1) };
         SettingValue<bool> mWaterCulling{ mIndex, "Terrain", "water culling" };
+        SettingValue<bool> mVertexArrayObjects{ mIndex, "Terrain", "vertex array objects" };
+        SettingValue<std::string> mSnowSubdivisionMethod{ mIndex, "Terrain", "snow subdivision method",
+            makeEnumSanitizerString({ "cpu", "tessellation" }) };
+        SettingValue<int> mSnowMaxActorFootprintsPerFrame{ mIndex, "Terrain", "snow max actor footprints per frame",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mSnowSubdivisionCacheSize{ mIndex, "Terrain", "snow subdivision cache size",
+            makeMaxSanitizerInt(0) };
     };
 }
 
@@ -31,6 +31,13 @@ namespace Settings
         SettingValue<float> mFramerateLimit{ mIndex, "Video", "framerate limit", makeMaxSanitizerFloat(0) };
         SettingValue<float> mContrast{ mIndex, "Video", "contrast", makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mGamma{ mIndex, "Video", "gamma", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mDynamicResolution{ mIndex, "Video", "dynamic resolution" };
+        SettingValue<float> mDynamicResolutionTargetTime{ mIndex, "Video", "dynamic resolution target time",
+            makeMaxStrictSanitizerFloat(0) };
+        SettingValue<float> mDynamicResolutionMinimumScale{ mIndex, "Video", "dynamic resolution minimum scale",
+            makeClampSanitizerFloat(0.1f, 1) };
+        SettingValue<float> mDynamicResolutionMaximumScale{ mIndex, "Video", "dynamic resolution maximum scale",
+            makeClampSanitizerFloat(0.1f, 1) };
     };
 }
 
@@ -22,6 +22,8 @@ namespace Settings
         SettingValue<int> mRttSize{ mIndex, "Water", "rtt size", makeMaxSanitizerInt(1) };
         SettingValue<bool> mRefraction{ mIndex, "Water", "refraction" };
         SettingValue<int> mReflectionDetail{ mIndex, "Water", "reflection detail", makeClampSanitizerInt(0, 5) };
+        SettingValue<int> mReflectionUpdateInterval{ mIndex, "Water", "reflection update interval",
+            makeClampSanitizerInt(1, 4) };
         SettingValue<int> mRainRippleDetail{ mIndex, "Water", "rain ripple detail", makeClampSanitizerInt(0, 2) };
         SettingValue<float> mSmallFeatureCullingPixelSize{ mIndex, "Water", "small feature culling pixel size",
             makeMaxStrictSanitizerFloat(0) };
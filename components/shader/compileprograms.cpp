@@ -0,0 +1,43 @@
+#include "compileprograms.hpp"
+
+#include <utility>
+
+#include <osg/GraphicsContext>
+#include <osg/State>
+
+#include <components/debug/debuglog.hpp>
+
+namespace Shader
+{
+    CompileProgramsOperation::CompileProgramsOperation(
+        std::vector<osg::ref_ptr<osg::Program>> programs, std::chrono::steady_clock::duration budget)
+        : osg::GraphicsOperation("CompileProgramsOperation", true)
+        , mPrograms(std::move(programs))
+        , mBudget(budget)
+    {
+    }
+
+    void CompileProgramsOperation::operator()(osg::GraphicsContext* graphicsContext)
+    {
+        osg::State* const state = graphicsContext->getState();
+        if (state == nullptr)
+            return;
+
+        const auto start = std::chrono::steady_clock::now();
+        // At least one program per frame, a single one may take longer than the budget
+        do
+        {
+            if (mNext == mPrograms.size())
+                break;
+            mPrograms[mNext]->compileGLObjects(*state);
+            ++mNext;
+        } while (mBudget == std::chrono::steady_clock::duration::zero()
+            || std::chrono::steady_clock::now() - start < mBudget);
+
+        if (mNext == mPrograms.size())
+        {
+            Log(Debug::Verbose) << "Compiled " << mPrograms.size() << " shader programs";
+            setKeep(false);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef OPENMW_COMPONENTS_SHADER_COMPILEPROGRAMS_H
+#define OPENMW_COMPONENTS_SHADER_COMPILEPROGRAMS_H
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <osg/GraphicsThread>
+#include <osg/Program>
+#include <osg/ref_ptr>
+
+namespace Shader
+{
+    /// @brief Compiles and links programs before anything is drawn with them, a few every frame.
+    /// @par Removes itself from the graphics context once all programs are linked.
+    class CompileProgramsOperation : public osg::GraphicsOperation
+    {
+    public:
+        /// @param budget time to spend compiling each frame, all programs are compiled on the first one if zero
+        explicit CompileProgramsOperation(
+            std::vector<osg::ref_ptr<osg::Program>> programs, std::chrono::steady_clock::duration budget);
+
+        void operator()(osg::GraphicsContext* graphicsContext) override;
+
+    private:
+        const std::vector<osg::ref_ptr<osg::Program>> mPrograms;
+        const std::chrono::steady_clock::duration mBudget;
+        std::size_t mNext = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,217 @@
+#include "programbinarycache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <osg/GraphicsContext>
+#include <osg/Shader>
+#include <osg/State>
+#include <osg/Version>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+
+namespace Shader
+{
+    namespace
+    {
+        // Increase when the way programs are built changes in a way not covered by the key
+        constexpr int formatVersion = 1;
+
+        std::string toHex(const std::array<std::uint64_t, 2>& hash)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (const std::uint64_t value : hash)
+                stream << std::setw(16) << value;
+            return stream.str();
+        }
+
+        template <class T>
+        void writeBindings(std::ostream& stream, const T& bindings)
+        {
+            stream << ' ' << bindings.size();
+            for (const auto& [name, index] : bindings)
+                stream << ' ' << name.size() << ' ' << name << ' ' << index;
+        }
+
+        class StoreProgramBinariesOperation final : public osg::GraphicsOperation
+        {
+        public:
+            explicit StoreProgramBinariesOperation(std::shared_ptr<ProgramBinaryCache> cache)
+                : osg::GraphicsOperation("StoreProgramBinariesOperation", true)
+                , mCache(std::move(cache))
+            {
+            }
+
+            void operator()(osg::GraphicsContext* graphicsContext) override
+            {
+                if (osg::State* const state = graphicsContext->getState())
+                    mCache->storeLinked(*state);
+            }
+
+        private:
+            const std::shared_ptr<ProgramBinaryCache> mCache;
+        };
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache(std::filesystem::path directory, std::string driver)
+        : mDirectory(std::move(directory))
+        , mDriver(std::move(driver))
+    {
+    }
+
+    ProgramBinaryCache::~ProgramBinaryCache() = default;
+
+    void ProgramBinaryCache::attach(osg::Program& program)
+    {
+        std::string key = makeKey(program);
+        osg::ref_ptr<osg::Program::ProgramBinary> binary = read(key);
+        const bool fromBinary = binary != nullptr;
+        program.setProgramBinary(binary);
+
+        const std::lock_guard lock(mMutex);
+        const auto it = std::find_if(mPending.begin(), mPending.end(),
+            [&](const Pending& pending) { return pending.mProgram == &program; });
+        if (it != mPending.end())
+        {
+            it->mKey = std::move(key);
+            it->mFromBinary = fromBinary;
+        }
+        else
+            mPending.push_back(Pending{ .mProgram = &program, .mKey = std::move(key), .mFromBinary = fromBinary });
+    }
+
+    void ProgramBinaryCache::storeLinked(osg::State& state)
+    {
+        std::vector<std::pair<osg::ref_ptr<osg::Program>, std::string>> linked;
+
+        {
+            const std::lock_guard lock(mMutex);
+            std::erase_if(mPending, [&](Pending& pending) {
+                osg::ref_ptr<osg::Program> program;
+                if (!pending.mProgram.lock(program))
+                    return true;
+                const osg::Program::PerContextProgram* const pcp = program->getPCP(state);
+                if (pcp == nullptr || pcp->needsLink())
+                    return false;
+                if (pcp->isLinked())
+                {
+                    if (!pending.mFromBinary)
+                        linked.emplace_back(std::move(program), std::move(pending.mKey));
+                    return true;
+                }
+                if (!pending.mFromBinary)
+                    return true;
+                // Drivers refuse binaries of their older versions, link from the sources and store a new one
+                Log(Debug::Verbose) << "Stored binary of program " << pending.mKey << " is refused by the driver";
+                std::error_code ec;
+                std::filesystem::remove(getFilePath(pending.mKey), ec);
+                program->setProgramBinary(nullptr);
+                program->dirtyProgram();
+                pending.mFromBinary = false;
+                return false;
+            });
+        }
+
+        for (const auto& [program, key] : linked)
+        {
+            const osg::ref_ptr<osg::Program::ProgramBinary> binary
+                = program->getPCP(state)->compileProgramBinary(state);
+            if (binary != nullptr && binary->getSize() != 0)
+                write(key, *binary);
+        }
+    }
+
+    std::string ProgramBinaryCache::makeKey(const osg::Program& program) const
+    {
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << osgGetVersion() << ' ' << mDriver.size() << ' ' << mDriver << ' '
+                   << program.getNumShaders();
+        for (unsigned i = 0; i < program.getNumShaders(); ++i)
+        {
+            const osg::Shader* const shader = program.getShader(i);
+            descriptor << ' ' << shader->getType() << ' ' << shader->getShaderSource().size() << ' '
+                       << shader->getShaderSource();
+        }
+        writeBindings(descriptor, program.getAttribBindingList());
+        writeBindings(descriptor, program.getFragDataBindingList());
+        writeBindings(descriptor, program.getUniformBlockBindingList());
+
+        std::istringstream stream(descriptor.str());
+        return toHex(Files::getHash("program", stream));
+    }
+
+    std::filesystem::path ProgramBinaryCache::getFilePath(const std::string& key) const
+    {
+        return mDirectory / Files::pathFromUnicodeString(key + ".bin");
+    }
+
+    osg::ref_ptr<osg::Program::ProgramBinary> ProgramBinaryCache::read(const std::string& key) const
+    {
+        std::ifstream stream(getFilePath(key), std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        std::uint32_t format = 0;
+        if (!stream.read(reinterpret_cast<char*>(&format), sizeof(format)))
+            return nullptr;
+        const std::vector<unsigned char> data(
+            (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        if (data.empty())
+            return nullptr;
+
+        osg::ref_ptr<osg::Program::ProgramBinary> binary = new osg::Program::ProgramBinary;
+        binary->setFormat(static_cast<GLenum>(format));
+        binary->assign(static_cast<unsigned>(data.size()), data.data());
+        return binary;
+    }
+
+    void ProgramBinaryCache::write(const std::string& key, const osg::Program::ProgramBinary& binary) const
+    {
+        const std::filesystem::path path = getFilePath(key);
+        // Write to a temporary file first so other processes never read a partially written binary
+        std::filesystem::path temporary = path;
+        temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mDirectory);
+
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                const std::uint32_t format = static_cast<std::uint32_t>(binary.getFormat());
+                stream.write(reinterpret_cast<const char*>(&format), sizeof(format));
+                stream.write(reinterpret_cast<const char*>(binary.getData()), binary.getSize());
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+
+            std::filesystem::rename(temporary, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write program binary " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
+    osg::ref_ptr<osg::GraphicsOperation> makeStoreProgramBinariesOperation(std::shared_ptr<ProgramBinaryCache> cache)
+    {
+        return new StoreProgramBinariesOperation(std::move(cache));
+    }
+}
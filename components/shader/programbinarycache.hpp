@@ -0,0 +1,68 @@
+#ifndef OPENMW_COMPONENTS_SHADER_PROGRAMBINARYCACHE_H
+#define OPENMW_COMPONENTS_SHADER_PROGRAMBINARYCACHE_H
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osg/GraphicsThread>
+#include <osg/Program>
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class State;
+}
+
+namespace Shader
+{
+    /// @brief Linked GL programs kept on disk between runs.
+    /// @par Binaries are keyed by the sources of the shaders, the bindings of the program and the driver. A program
+    /// with a stored binary is linked from it, the binary of any other program is stored once it has been linked to be
+    /// drawn. A binary the driver refuses is removed and the program is linked from its sources.
+    class ProgramBinaryCache
+    {
+    public:
+        /// @param driver identifies the GL implementation and GPU, stored binaries of other ones are never used
+        explicit ProgramBinaryCache(std::filesystem::path directory, std::string driver);
+
+        ~ProgramBinaryCache();
+
+        /// Give the program the stored binary for its current shaders, or queue it to be stored once linked.
+        /// @note Thread safe.
+        void attach(osg::Program& program);
+
+        /// Store the binaries of queued programs linked in the state since the last call.
+        /// @note Has to be called with the graphics context of the state current.
+        void storeLinked(osg::State& state);
+
+    private:
+        struct Pending
+        {
+            osg::observer_ptr<osg::Program> mProgram;
+            std::string mKey;
+            bool mFromBinary;
+        };
+
+        const std::filesystem::path mDirectory;
+        const std::string mDriver;
+        std::mutex mMutex;
+        std::vector<Pending> mPending;
+
+        std::string makeKey(const osg::Program& program) const;
+
+        std::filesystem::path getFilePath(const std::string& key) const;
+
+        osg::ref_ptr<osg::Program::ProgramBinary> read(const std::string& key) const;
+
+        void write(const std::string& key, const osg::Program::ProgramBinary& binary) const;
+    };
+
+    /// @return Operation calling ProgramBinaryCache::storeLinked every frame of the graphics context it is added to.
+    osg::ref_ptr<osg::GraphicsOperation> makeStoreProgramBinariesOperation(std::shared_ptr<ProgramBinaryCache> cache);
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "shadermanager.hpp"
 
+#include "programbinarycache.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <chrono>
@@ -9,6 +11,8 @@
 #include <regex>
 #include <set>
 #include <sstream>
+#include <stdexcept>
+#include <system_error>
 #include <unordered_map>
 
 #include <osg/Program>
@@ -54,6 +58,69 @@ namespace
         return {};
     }
 
+    // Shaders of a program as template names with defines
+    using ProgramUsage = std::vector<std::pair<std::string, Shader::ShaderManager::DefineMap>>;
+
+    constexpr std::string_view usageManifestHeader = "OpenMW shader usage 1";
+
+    // One program per line, all fields separated by tabs: number of shaders, then for each shader its template name,
+    // number of defines and their names and values
+    std::optional<ProgramUsage> parseProgramUsage(const std::string& line)
+    {
+        std::vector<std::string> fields;
+        std::istringstream stream(line);
+        for (std::string field; std::getline(stream, field, '\t');)
+            fields.push_back(std::move(field));
+
+        std::size_t next = 0;
+        const auto getCount = [&]() -> std::optional<std::size_t> {
+            if (next == fields.size())
+                return std::nullopt;
+            return Misc::StringUtils::toNumeric<std::size_t>(fields[next++]);
+        };
+
+        const std::optional<std::size_t> shaderCount = getCount();
+        if (!shaderCount.has_value() || *shaderCount == 0)
+            return std::nullopt;
+        ProgramUsage result;
+        for (std::size_t i = 0; i < *shaderCount; ++i)
+        {
+            if (next == fields.size())
+                return std::nullopt;
+            auto& [templateName, defines] = result.emplace_back(fields[next++], Shader::ShaderManager::DefineMap());
+            const std::optional<std::size_t> defineCount = getCount();
+            if (!defineCount.has_value() || fields.size() - next < *defineCount * 2)
+                return std::nullopt;
+            for (std::size_t j = 0; j < *defineCount; ++j, next += 2)
+                defines.emplace(fields[next], fields[next + 1]);
+        }
+        if (next != fields.size())
+            return std::nullopt;
+        return result;
+    }
+
+    void writeProgramUsage(const ProgramUsage& program, std::ostream& stream)
+    {
+        const auto isWritable = [](std::string_view value) { return value.find_first_of("\t\n") == value.npos; };
+        for (const auto& [templateName, defines] : program)
+        {
+            if (!isWritable(templateName))
+                return;
+            for (const auto& [name, value] : defines)
+                if (!isWritable(name) || !isWritable(value))
+                    return;
+        }
+
+        stream << program.size();
+        for (const auto& [templateName, defines] : program)
+        {
+            stream << '\t' << templateName << '\t' << defines.size();
+            for (const auto& [name, value] : defines)
+                stream << '\t' << name << '\t' << value;
+        }
+        stream << '\n';
+    }
+
     int getLineNumber(std::string_view source, std::size_t foundPos, int lineNumber, int offset)
     {
         constexpr std::string_view tag = "#line";
@@ -492,6 +559,7 @@ namespace Shader
                         }
                         shaderIt->second->setShaderSource(shaderSource);
                     }
+                    manager.reattachProgramBinaries();
                 }
             }
             if (threadsRunningToStop)
@@ -595,11 +663,52 @@ namespace Shader
             addLinkedShaders(vertexShader, program);
             addLinkedShaders(fragmentShader, program);
 
+            if (mProgramBinaryCache != nullptr)
+                mProgramBinaryCache->attach(*program);
+            if (mUsageManifestPath.has_value() && programTemplate == mProgramTemplate)
+                recordUsage({ vertexShader, fragmentShader });
+
             found = mPrograms.insert(std::make_pair(std::make_pair(vertexShader, fragmentShader), program)).first;
         }
         return found->second;
     }
 
+    osg::ref_ptr<osg::Program> ShaderManager::getTessellationProgram(
+        const std::string& templateName, const DefineMap& defines, const osg::Program* programTemplate)
+    {
+        auto vert = getShader(templateName + ".vert", defines);
+        auto tesc = getShader(templateName + ".tesc", defines);
+        auto tese = getShader(templateName + ".tese", defines);
+        auto frag = getShader(templateName + ".frag", defines);
+
+        if (!vert || !tesc || !tese || !frag)
+            throw std::runtime_error("failed initializing tessellation shader: " + templateName);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        const std::array<osg::ref_ptr<osg::Shader>, 4> key{ vert, tesc, tese, frag };
+        TessellationProgramMap::iterator found = mTessellationPrograms.find(key);
+        if (found == mTessellationPrograms.end())
+        {
+            if (!programTemplate)
+                programTemplate = mProgramTemplate;
+            osg::ref_ptr<osg::Program> program
+                = programTemplate ? cloneProgram(programTemplate) : osg::ref_ptr<osg::Program>(new osg::Program);
+            for (const osg::ref_ptr<osg::Shader>& shader : key)
+            {
+                program->addShader(shader);
+                addLinkedShaders(shader, program);
+            }
+
+            if (mProgramBinaryCache != nullptr)
+                mProgramBinaryCache->attach(*program);
+            if (mUsageManifestPath.has_value() && programTemplate == mProgramTemplate)
+                recordUsage(std::vector<osg::ref_ptr<osg::Shader>>(key.begin(), key.end()));
+
+            found = mTessellationPrograms.insert(std::make_pair(key, program)).first;
+        }
+        return found->second;
+    }
+
     osg::ref_ptr<osg::Program> ShaderManager::cloneProgram(const osg::Program* src)
     {
         osg::ref_ptr<osg::Program> program = static_cast<osg::Program*>(src->clone(osg::CopyOp::SHALLOW_COPY));
@@ -635,6 +744,17 @@ namespace Shader
 
             getLinkedShaders(shader, linkedShaderNames, defines);
         }
+        reattachProgramBinaries();
+    }
+
+    void ShaderManager::reattachProgramBinaries()
+    {
+        if (mProgramBinaryCache == nullptr)
+            return;
+        for (const auto& [_, program] : mPrograms)
+            mProgramBinaryCache->attach(*program);
+        for (const auto& [_, program] : mTessellationPrograms)
+            mProgramBinaryCache->attach(*program);
     }
 
     void ShaderManager::releaseGLObjects(osg::State* state)
@@ -647,6 +767,8 @@ namespace Shader
         }
         for (const auto& [_, program] : mPrograms)
             program->releaseGLObjects(state);
+        for (const auto& [_, program] : mTessellationPrograms)
+            program->releaseGLObjects(state);
     }
 
     bool ShaderManager::createSourceFromTemplate(std::string& source,
@@ -712,6 +834,15 @@ namespace Shader
             case Slot::ShadowMaps:
                 slotDescr = "shadow maps";
                 break;
+            case Slot::MorphTargets:
+                slotDescr = "morph targets";
+                break;
+            case Slot::LightClusters:
+                slotDescr = "light clusters";
+                break;
+            case Slot::InstanceTransforms:
+                slotDescr = "instance transforms";
+                break;
             default:
                 slotDescr = "UNKNOWN";
         }
@@ -724,6 +855,145 @@ namespace Shader
         return unit.index;
     }
 
+    void ShaderManager::setProgramBinaryCacheDirectory(
+        const std::filesystem::path& directory, const std::string& driver)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mProgramBinaryCache = std::make_shared<ProgramBinaryCache>(directory, driver);
+        reattachProgramBinaries();
+    }
+
+    void ShaderManager::recordUsage(const std::vector<osg::ref_ptr<osg::Shader>>& shaders)
+    {
+        std::vector<MapKey> keys;
+        for (const osg::ref_ptr<osg::Shader>& shader : shaders)
+        {
+            const auto it = std::find_if(
+                mShaders.begin(), mShaders.end(), [&](const auto& entry) { return entry.second == shader; });
+            // Shaders not made from a template can't be created again
+            if (it == mShaders.end())
+                return;
+            keys.push_back(it->first);
+        }
+        mUsedPrograms.insert(std::move(keys));
+    }
+
+    void ShaderManager::readUsageManifest(const std::filesystem::path& path)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mUsageManifestPath = path;
+
+        std::ifstream stream(path);
+        if (!stream.is_open())
+            return;
+
+        std::string line;
+        if (!std::getline(stream, line) || line != usageManifestHeader)
+        {
+            Log(Debug::Warning) << "Ignoring shader usage manifest " << path << " of unknown format";
+            return;
+        }
+
+        std::size_t invalid = 0;
+        while (std::getline(stream, line))
+        {
+            if (std::optional<ProgramUsage> program = parseProgramUsage(line))
+                mManifestPrograms.insert(std::move(*program));
+            else
+                ++invalid;
+        }
+
+        if (invalid > 0)
+            Log(Debug::Warning) << "Ignored " << invalid << " invalid entries of shader usage manifest " << path;
+        Log(Debug::Info) << "Read " << mManifestPrograms.size() << " shader programs from " << path;
+    }
+
+    void ShaderManager::writeUsageManifest()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mUsageManifestPath.has_value())
+            return;
+
+        ProgramUsageSet programs = mManifestPrograms;
+        programs.insert(mUsedPrograms.begin(), mUsedPrograms.end());
+
+        std::filesystem::path temporary = *mUsageManifestPath;
+        temporary += ".tmp";
+        try
+        {
+            std::filesystem::create_directories(mUsageManifestPath->parent_path());
+            {
+                std::ofstream stream(temporary, std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                stream << usageManifestHeader << '\n';
+                for (const std::vector<MapKey>& program : programs)
+                    writeProgramUsage(program, stream);
+                stream.close();
+                if (!stream)
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(temporary, *mUsageManifestPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write shader usage manifest " << *mUsageManifestPath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
+    std::vector<osg::ref_ptr<osg::Program>> ShaderManager::createManifestPrograms()
+    {
+        ProgramUsageSet manifest;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            manifest = std::move(mManifestPrograms);
+            mManifestPrograms.clear();
+        }
+
+        std::vector<osg::ref_ptr<osg::Program>> result;
+        ProgramUsageSet valid;
+        for (const std::vector<MapKey>& program : manifest)
+        {
+            std::vector<osg::ref_ptr<osg::Shader>> shaders;
+            for (const auto& [templateName, defines] : program)
+            {
+                // Templates can be removed or broken by an update, these are dropped from the manifest
+                osg::ref_ptr<osg::Shader> shader;
+                try
+                {
+                    shader = getShader(templateName, defines);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Verbose) << "Failed to create shader " << templateName << ": " << e.what();
+                }
+                if (shader == nullptr)
+                    break;
+                shaders.push_back(std::move(shader));
+            }
+            if (shaders.size() != program.size())
+                continue;
+
+            if (shaders.size() == 2)
+                result.push_back(getProgram(shaders[0], shaders[1]));
+            else if (shaders.size() == 4 && program[0].first.ends_with(".vert"))
+            {
+                std::string_view templateName = program[0].first;
+                templateName.remove_suffix(std::string_view(".vert").size());
+                result.push_back(getTessellationProgram(std::string(templateName), program[0].second));
+            }
+            else
+                continue;
+            valid.insert(program);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mManifestPrograms.insert(valid.begin(), valid.end());
+        return result;
+    }
+
     void ShaderManager::update(osgViewer::Viewer& viewer)
     {
         mHotReloadManager->update(*this, viewer);
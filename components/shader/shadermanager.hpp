@@ -7,6 +7,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -22,6 +23,8 @@ namespace osgViewer
 namespace Shader
 {
     struct HotReloadManager;
+    class ProgramBinaryCache;
+
     /// @brief Reads shader template files and turns them into a concrete shader, based on a list of define's.
     /// @par Shader templates can get the value of a define with the syntax @define.
     class ShaderManager
@@ -50,6 +53,11 @@ namespace Shader
         osg::ref_ptr<osg::Program> getProgram(osg::ref_ptr<osg::Shader> vertexShader,
             osg::ref_ptr<osg::Shader> fragmentShader, const osg::Program* programTemplate = nullptr);
 
+        /// Create or retrieve a program that also has tessellation control (.tesc) and evaluation (.tese) stages.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Program> getTessellationProgram(const std::string& templateName,
+            const DefineMap& defines = {}, const osg::Program* programTemplate = nullptr);
+
         const osg::Program* getProgramTemplate() const { return mProgramTemplate; }
         void setProgramTemplate(const osg::Program* program) { mProgramTemplate = program; }
 
@@ -80,11 +88,31 @@ namespace Shader
             OpaqueDepthTexture,
             SkyTexture,
             ShadowMaps,
+            MorphTargets,
+            LightClusters,
+            InstanceTransforms,
             SLOT_COUNT
         };
 
         int reserveGlobalTextureUnits(Slot slot, int count = 1);
 
+        /// Keep linked programs in the directory, created programs are linked from there when possible.
+        /// @param driver identifies the GL implementation and GPU
+        void setProgramBinaryCacheDirectory(const std::filesystem::path& directory, const std::string& driver);
+
+        /// @note May return nullptr if the programs are not cached.
+        const std::shared_ptr<ProgramBinaryCache>& getProgramBinaryCache() const { return mProgramBinaryCache; }
+
+        /// Read the programs used by the previous runs and record the ones created from now on.
+        /// @note Only programs created with the default program template are recorded.
+        void readUsageManifest(const std::filesystem::path& path);
+
+        /// Store the programs used by this run along with the ones read by readUsageManifest that are still valid.
+        void writeUsageManifest();
+
+        /// Create the programs read by readUsageManifest, for them to be compiled before they are drawn.
+        std::vector<osg::ref_ptr<osg::Program>> createManifestPrograms();
+
         void update(osgViewer::Viewer& viewer);
         void setHotReloadEnabled(bool value);
         void triggerShaderReload();
@@ -93,6 +121,9 @@ namespace Shader
         void getLinkedShaders(osg::ref_ptr<osg::Shader> shader, const std::vector<std::string>& linkedShaderNames,
             const DefineMap& defines);
         void addLinkedShaders(osg::ref_ptr<osg::Shader> shader, osg::ref_ptr<osg::Program> program);
+        // Stored binaries are for the previous sources of any changed shader
+        void reattachProgramBinaries();
+        void recordUsage(const std::vector<osg::ref_ptr<osg::Shader>>& shaders);
 
         std::filesystem::path mPath;
 
@@ -110,6 +141,10 @@ namespace Shader
             ProgramMap;
         ProgramMap mPrograms;
 
+        // <vertex, tessellation control, tessellation evaluation, fragment>
+        typedef std::map<std::array<osg::ref_ptr<osg::Shader>, 4>, osg::ref_ptr<osg::Program>> TessellationProgramMap;
+        TessellationProgramMap mTessellationPrograms;
+
         typedef std::vector<osg::ref_ptr<osg::Shader>> ShaderList;
         typedef std::map<osg::ref_ptr<osg::Shader>, ShaderList> LinkedShadersMap;
         LinkedShadersMap mLinkedShaders;
@@ -121,6 +156,13 @@ namespace Shader
         int mMaxTextureUnits = 0;
         int mReservedTextureUnits = 0;
         std::unique_ptr<HotReloadManager> mHotReloadManager;
+        std::shared_ptr<ProgramBinaryCache> mProgramBinaryCache;
+
+        // Keys of the shaders of each program, in the order they are added
+        typedef std::set<std::vector<MapKey>> ProgramUsageSet;
+        std::optional<std::filesystem::path> mUsageManifestPath;
+        ProgramUsageSet mManifestPrograms;
+        ProgramUsageSet mUsedPrograms;
         struct ReservedTextureUnits
         {
             int index = -1;
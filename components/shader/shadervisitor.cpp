@@ -210,6 +210,29 @@ namespace Shader
     {
     }
 
+    AutoTextureCache::Value AutoTextureCache::get(const Key& key, const std::function<Value()>& find)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            if (const auto it = mEntries.find(key); it != mEntries.end())
+            {
+                if (!it->second.mFound)
+                    return Value{};
+                osg::ref_ptr<osg::Texture2D> texture;
+                if (it->second.mTexture.lock(texture))
+                    return Value{ .mTexture = std::move(texture), .mPattern = it->second.mPattern };
+            }
+        }
+
+        // Another thread may find the same texture meanwhile, models loaded at the same time use different ones then
+        Value value = find();
+
+        const std::lock_guard lock(mMutex);
+        mEntries.insert_or_assign(key,
+            Entry{ .mTexture = value.mTexture.get(), .mFound = value.mTexture != nullptr, .mPattern = value.mPattern });
+        return value;
+    }
+
     void ShaderVisitor::setForceShaders(bool force)
     {
         mForceShaders = force;
@@ -404,27 +427,11 @@ namespace Shader
 
             if (mAutoUseNormalMaps && diffuseMap != nullptr && normalMap == nullptr && diffuseMap->getImage(0))
             {
-                std::string normalMapFileName = diffuseMap->getImage(0)->getFileName();
-
-                osg::ref_ptr<osg::Image> image;
-                bool normalHeight = false;
-                std::string normalHeightMap = normalMapFileName;
-                Misc::StringUtils::replaceLast(normalHeightMap, ".", mNormalHeightMapPattern + ".");
-                const VFS::Path::Normalized normalHeightMapPath(normalHeightMap);
-                if (mImageManager.getVFS()->exists(normalHeightMapPath))
-                {
-                    image = mImageManager.getImage(normalHeightMapPath);
-                    normalHeight = true;
-                }
-                else
-                {
-                    Misc::StringUtils::replaceLast(normalMapFileName, ".", mNormalMapPattern + ".");
-                    const VFS::Path::Normalized normalMapPath(normalMapFileName);
-                    if (mImageManager.getVFS()->exists(normalMapPath))
-                    {
-                        image = mImageManager.getImage(normalMapPath);
-                    }
-                }
+                const AutoTextureCache::Value found
+                    = getAutoTexture(*diffuseMap, { mNormalHeightMapPattern, mNormalMapPattern });
+                const osg::ref_ptr<osg::Texture2D>& normalMapTex = found.mTexture;
+                const bool normalHeight = found.mPattern == 0;
+                const osg::Image* const image = normalMapTex != nullptr ? normalMapTex->getImage() : nullptr;
                 // Avoid using the auto-detected normal map if it's already being used as a bump map.
                 // It's probably not an actual normal map.
                 bool hasNamesakeBumpMap = image && bumpMap && bumpMap->getImage(0)
@@ -432,13 +439,6 @@ namespace Shader
 
                 if (!hasNamesakeBumpMap && image)
                 {
-                    osg::ref_ptr<osg::Texture2D> normalMapTex(new osg::Texture2D(image));
-                    normalMapTex->setTextureSize(image->s(), image->t());
-                    normalMapTex->setWrap(osg::Texture::WRAP_S, diffuseMap->getWrap(osg::Texture::WRAP_S));
-                    normalMapTex->setWrap(osg::Texture::WRAP_T, diffuseMap->getWrap(osg::Texture::WRAP_T));
-                    normalMapTex->setFilter(osg::Texture::MIN_FILTER, diffuseMap->getFilter(osg::Texture::MIN_FILTER));
-                    normalMapTex->setFilter(osg::Texture::MAG_FILTER, diffuseMap->getFilter(osg::Texture::MAG_FILTER));
-                    normalMapTex->setMaxAnisotropy(diffuseMap->getMaxAnisotropy());
                     normalMap = normalMapTex;
 
                     int unit = texAttributes.size();
@@ -471,22 +471,10 @@ namespace Shader
 
             if (mAutoUseSpecularMaps && diffuseMap != nullptr && specularMap == nullptr && diffuseMap->getImage(0))
             {
-                std::string specularMapFileName = diffuseMap->getImage(0)->getFileName();
-                Misc::StringUtils::replaceLast(specularMapFileName, ".", mSpecularMapPattern + ".");
-                const VFS::Path::Normalized specularMapPath(specularMapFileName);
-                if (mImageManager.getVFS()->exists(specularMapPath))
+                const osg::ref_ptr<osg::Texture2D> specularMapTex
+                    = getAutoTexture(*diffuseMap, { mSpecularMapPattern }).mTexture;
+                if (specularMapTex != nullptr)
                 {
-                    osg::ref_ptr<osg::Image> image(mImageManager.getImage(specularMapPath));
-                    osg::ref_ptr<osg::Texture2D> specularMapTex(new osg::Texture2D(image));
-                    specularMapTex->setTextureSize(image->s(), image->t());
-                    specularMapTex->setWrap(osg::Texture::WRAP_S, diffuseMap->getWrap(osg::Texture::WRAP_S));
-                    specularMapTex->setWrap(osg::Texture::WRAP_T, diffuseMap->getWrap(osg::Texture::WRAP_T));
-                    specularMapTex->setFilter(
-                        osg::Texture::MIN_FILTER, diffuseMap->getFilter(osg::Texture::MIN_FILTER));
-                    specularMapTex->setFilter(
-                        osg::Texture::MAG_FILTER, diffuseMap->getFilter(osg::Texture::MAG_FILTER));
-                    specularMapTex->setMaxAnisotropy(diffuseMap->getMaxAnisotropy());
-
                     int unit = texAttributes.size();
                     if (!writableStateSet)
                         writableStateSet = getWritableStateSet(node);
@@ -935,6 +923,17 @@ namespace Shader
         return changed;
     }
 
+    bool ShaderVisitor::canDeformInShader(const ShaderRequirements& reqs) const
+    {
+        if (!reqs.mShaderRequired && !mForceShaders)
+            return false;
+        // Only the objects shader knows how to skin and morph
+        std::string shaderPrefix;
+        if (!reqs.mNode->getUserValue("shaderPrefix", shaderPrefix))
+            shaderPrefix = mDefaultShaderPrefix;
+        return shaderPrefix == "objects";
+    }
+
     void ShaderVisitor::apply(osg::Geometry& geometry)
     {
         bool needPop = geometry.getStateSet() || mRequirements.empty();
@@ -984,12 +983,22 @@ namespace Shader
             osg::ref_ptr<osg::Geometry> sourceGeometry = rig->getSourceGeometry();
             if (sourceGeometry && adjustGeometry(*sourceGeometry, reqs))
                 rig->setSourceGeometry(std::move(sourceGeometry));
+
+            if (mAllowedToModifyStateSets)
+                rig->setGpuSkinning(mGpuSkinning && canDeformInShader(reqs));
         }
         else if (auto morph = dynamic_cast<SceneUtil::MorphGeometry*>(&drawable))
         {
             osg::ref_ptr<osg::Geometry> sourceGeometry = morph->getSourceGeometry();
             if (sourceGeometry && adjustGeometry(*sourceGeometry, reqs))
                 morph->setSourceGeometry(std::move(sourceGeometry));
+
+            if (mAllowedToModifyStateSets)
+            {
+                const bool enabled = mGpuMorphing && canDeformInShader(reqs);
+                morph->setGpuMorphing(enabled,
+                    enabled ? mShaderManager.reserveGlobalTextureUnits(Shader::ShaderManager::Slot::MorphTargets) : 0);
+            }
         }
         else if (auto osgaRig = dynamic_cast<SceneUtil::RigGeometryHolder*>(&drawable))
         {
@@ -1006,6 +1015,55 @@ namespace Shader
             popRequirements();
     }
 
+    AutoTextureCache::Value ShaderVisitor::getAutoTexture(
+        const osg::Texture& diffuseMap, std::initializer_list<std::string_view> patterns)
+    {
+        const std::string& diffuseMapFileName = diffuseMap.getImage(0)->getFileName();
+
+        const auto find = [&] {
+            std::size_t index = 0;
+            for (const std::string_view pattern : patterns)
+            {
+                std::string fileName = diffuseMapFileName;
+                Misc::StringUtils::replaceLast(fileName, ".", std::string(pattern) + ".");
+                const VFS::Path::Normalized path(fileName);
+                if (mImageManager.getVFS()->exists(path))
+                {
+                    osg::ref_ptr<osg::Image> image = mImageManager.getImage(path);
+                    osg::ref_ptr<osg::Texture2D> texture(new osg::Texture2D(image));
+                    texture->setTextureSize(image->s(), image->t());
+                    texture->setWrap(osg::Texture::WRAP_S, diffuseMap.getWrap(osg::Texture::WRAP_S));
+                    texture->setWrap(osg::Texture::WRAP_T, diffuseMap.getWrap(osg::Texture::WRAP_T));
+                    texture->setFilter(osg::Texture::MIN_FILTER, diffuseMap.getFilter(osg::Texture::MIN_FILTER));
+                    texture->setFilter(osg::Texture::MAG_FILTER, diffuseMap.getFilter(osg::Texture::MAG_FILTER));
+                    texture->setMaxAnisotropy(diffuseMap.getMaxAnisotropy());
+                    return AutoTextureCache::Value{ .mTexture = std::move(texture), .mPattern = index };
+                }
+                ++index;
+            }
+            return AutoTextureCache::Value{};
+        };
+
+        if (mAutoTextureCache == nullptr)
+            return find();
+
+        AutoTextureCache::Key key{
+            .mDiffuseMap = diffuseMapFileName,
+            .mPatterns = {},
+            .mWrapS = diffuseMap.getWrap(osg::Texture::WRAP_S),
+            .mWrapT = diffuseMap.getWrap(osg::Texture::WRAP_T),
+            .mMinFilter = diffuseMap.getFilter(osg::Texture::MIN_FILTER),
+            .mMagFilter = diffuseMap.getFilter(osg::Texture::MAG_FILTER),
+            .mMaxAnisotropy = diffuseMap.getMaxAnisotropy(),
+        };
+        for (const std::string_view pattern : patterns)
+        {
+            key.mPatterns += pattern;
+            key.mPatterns += '\n';
+        }
+        return mAutoTextureCache->get(key, find);
+    }
+
     void ShaderVisitor::setAllowedToModifyStateSets(bool allowed)
     {
         mAllowedToModifyStateSets = allowed;
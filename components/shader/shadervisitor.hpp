@@ -1,8 +1,21 @@
 #ifndef OPENMW_COMPONENTS_SHADERVISITOR_H
 #define OPENMW_COMPONENTS_SHADERVISITOR_H
 
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
 #include <osg/NodeVisitor>
 #include <osg/Program>
+#include <osg/Texture2D>
+#include <osg/observer_ptr>
 
 namespace Resource
 {
@@ -14,6 +27,56 @@ namespace Shader
 
     class ShaderManager;
 
+    /// @brief Textures found by name next to diffuse maps, like normal and specular maps, shared by all models using a
+    /// diffuse map with the same sampling.
+    /// @par The files are looked up and the textures created once for as long as any model keeps the texture.
+    /// @note Thread safe.
+    class AutoTextureCache
+    {
+    public:
+        struct Key
+        {
+            std::string mDiffuseMap;
+            // Patterns in the order they are tried
+            std::string mPatterns;
+            osg::Texture::WrapMode mWrapS;
+            osg::Texture::WrapMode mWrapT;
+            osg::Texture::FilterMode mMinFilter;
+            osg::Texture::FilterMode mMagFilter;
+            float mMaxAnisotropy;
+
+            friend inline auto tie(const Key& value)
+            {
+                return std::tie(value.mDiffuseMap, value.mPatterns, value.mWrapS, value.mWrapT, value.mMinFilter,
+                    value.mMagFilter, value.mMaxAnisotropy);
+            }
+
+            friend inline bool operator<(const Key& lhs, const Key& rhs) { return tie(lhs) < tie(rhs); }
+        };
+
+        struct Value
+        {
+            // nullptr if there is no file for any pattern
+            osg::ref_ptr<osg::Texture2D> mTexture;
+            // Index of the pattern the file was found with
+            std::size_t mPattern = 0;
+        };
+
+        /// @param find called when there is no live texture for the key, not under the lock
+        Value get(const Key& key, const std::function<Value()>& find);
+
+    private:
+        struct Entry
+        {
+            osg::observer_ptr<osg::Texture2D> mTexture;
+            bool mFound;
+            std::size_t mPattern;
+        };
+
+        std::mutex mMutex;
+        std::map<Key, Entry> mEntries;
+    };
+
     /// @brief Adjusts the given subgraph to render using shaders.
     class ShaderVisitor : public osg::NodeVisitor
     {
@@ -53,6 +116,13 @@ namespace Shader
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        void setGpuSkinning(bool enabled) { mGpuSkinning = enabled; }
+
+        void setGpuMorphing(bool enabled) { mGpuMorphing = enabled; }
+
+        /// Share the automatically used normal and specular maps with other visitors.
+        void setAutoTextureCache(std::shared_ptr<AutoTextureCache> cache) { mAutoTextureCache = std::move(cache); }
+
         void apply(osg::Node& node) override;
 
         void apply(osg::Drawable& drawable) override;
@@ -81,9 +151,12 @@ namespace Shader
 
         bool mSupportsNormalsRT;
         bool mWeatherParticleOcclusion = false;
+        bool mGpuSkinning = false;
+        bool mGpuMorphing = false;
 
         ShaderManager& mShaderManager;
         Resource::ImageManager& mImageManager;
+        std::shared_ptr<AutoTextureCache> mAutoTextureCache;
 
         struct ShaderRequirements
         {
@@ -127,6 +200,10 @@ namespace Shader
         void createProgram(const ShaderRequirements& reqs);
         void ensureFFP(osg::Node& node);
         bool adjustGeometry(osg::Geometry& sourceGeometry, const ShaderRequirements& reqs);
+        bool canDeformInShader(const ShaderRequirements& reqs) const;
+        // Texture named after the diffuse map with the first pattern a file exists for
+        AutoTextureCache::Value getAutoTexture(
+            const osg::Texture& diffuseMap, std::initializer_list<std::string_view> patterns);
 
         osg::ref_ptr<const osg::Program> mProgramTemplate;
     };
@@ -230,11 +230,47 @@ namespace Terrain
         return buffer;
     }
 
+    osg::ref_ptr<osg::DrawElements> BufferCache::getPatchIndexBuffer(unsigned int numVerts, unsigned int flags)
+    {
+        std::pair<int, int> id = std::make_pair(numVerts, flags);
+        std::lock_guard<std::mutex> lock(mIndexBufferMutex);
+
+        if (mPatchIndexBufferMap.find(id) != mPatchIndexBufferMap.end())
+        {
+            return mPatchIndexBufferMap[id];
+        }
+
+        osg::ref_ptr<osg::DrawElements> buffer;
+
+        if (numVerts * numVerts <= (0xffffu))
+            buffer = createIndexBuffer<osg::DrawElementsUShort>(flags, numVerts);
+        else
+            buffer = createIndexBuffer<osg::DrawElementsUInt>(flags, numVerts);
+
+        buffer->setMode(GL_PATCHES);
+        buffer->setElementBufferObject(new osg::ElementBufferObject);
+
+        mPatchIndexBufferMap[id] = buffer;
+        return buffer;
+    }
+
+    osg::ref_ptr<osg::DrawArrays> BufferCache::getTriangleListBuffer(unsigned int numVerts)
+    {
+        std::lock_guard<std::mutex> lock(mIndexBufferMutex);
+
+        osg::ref_ptr<osg::DrawArrays>& buffer = mTriangleListBufferMap[numVerts];
+        if (!buffer)
+            buffer = new osg::DrawArrays(GL_TRIANGLES, 0, numVerts);
+        return buffer;
+    }
+
     void BufferCache::clearCache()
     {
         {
             std::lock_guard<std::mutex> lock(mIndexBufferMutex);
             mIndexBufferMap.clear();
+            mPatchIndexBufferMap.clear();
+            mTriangleListBufferMap.clear();
         }
         {
             std::lock_guard<std::mutex> lock(mUvBufferMutex);
@@ -248,6 +284,8 @@ namespace Terrain
             std::lock_guard<std::mutex> lock(mIndexBufferMutex);
             for (const auto& [_, indexbuffer] : mIndexBufferMap)
                 indexbuffer->releaseGLObjects(state);
+            for (const auto& [_, indexbuffer] : mPatchIndexBufferMap)
+                indexbuffer->releaseGLObjects(state);
         }
         {
             std::lock_guard<std::mutex> lock(mUvBufferMutex);
@@ -20,6 +20,14 @@ namespace Terrain
         /// @note Thread safe.
         osg::ref_ptr<osg::DrawElements> getIndexBuffer(unsigned int numVerts, unsigned int flags);
 
+        /// @brief Same indices as getIndexBuffer, drawn as 3-vertex GL_PATCHES for tessellation shaders.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::DrawElements> getPatchIndexBuffer(unsigned int numVerts, unsigned int flags);
+
+        /// @brief Draws numVerts unindexed vertices as GL_TRIANGLES, used by subdivided chunks of the same size.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::DrawArrays> getTriangleListBuffer(unsigned int numVerts);
+
         /// @note Thread safe.
         osg::ref_ptr<osg::Vec2Array> getUVBuffer(unsigned int numVerts);
 
@@ -31,6 +39,8 @@ namespace Terrain
         // Index buffers are shared across terrain batches where possible. There is one index buffer for each
         // combination of LOD deltas and index buffer LOD we may need.
         std::map<std::pair<int, int>, osg::ref_ptr<osg::DrawElements>> mIndexBufferMap;
+        std::map<std::pair<int, int>, osg::ref_ptr<osg::DrawElements>> mPatchIndexBufferMap;
+        std::map<unsigned int, osg::ref_ptr<osg::DrawArrays>> mTriangleListBufferMap;
         std::mutex mIndexBufferMutex;
 
         std::map<int, osg::ref_ptr<osg::Vec2Array>> mUvBufferMap;
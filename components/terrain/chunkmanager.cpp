@@ -1,6 +1,7 @@
 #include "chunkmanager.hpp"
 
 #include <osg/Material>
+#include <osg/PatchParameter>
 #include <osg/Texture2D>
 
 #include <osgUtil/IncrementalCompileOperation>
@@ -10,8 +11,13 @@
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
 
+#include <components/sceneutil/glextensions.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/settings/values.hpp>
+#include <components/stereo/multiview.hpp>
 
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "material.hpp"
 #include "storage.hpp"
@@ -21,6 +27,52 @@
 
 namespace Terrain
 {
+    namespace
+    {
+        float distanceToChunkEdge(const osg::Vec2f& playerPos, const osg::Vec2f& worldChunkCenter, float halfChunkSize)
+        {
+            const float x = std::max(0.0f, std::abs(playerPos.x() - worldChunkCenter.x()) - halfChunkSize);
+            const float y = std::max(0.0f, std::abs(playerPos.y() - worldChunkCenter.y()) - halfChunkSize);
+            return std::sqrt(x * x + y * y);
+        }
+    }
+
+    class ChunkManager::RebuildChunkWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        RebuildChunkWorkItem(ChunkManager* chunkManager, float size, const ChunkKey& key)
+            : mChunkManager(chunkManager)
+            , mSize(size)
+            , mKey(key)
+        {
+        }
+
+        void doWork() override
+        {
+            const std::lock_guard lock(mMutex);
+            if (mAborted)
+                return;
+            mNode = mChunkManager->createChunk(
+                mSize, mKey.mCenter, mKey.mLod, mKey.mLodFlags, true, nullptr, osg::Vec3f());
+        }
+
+        /// Blocks until a running rebuild finished, so the chunk manager can be destroyed afterwards.
+        void abort() override
+        {
+            const std::lock_guard lock(mMutex);
+            mAborted = true;
+        }
+
+        osg::ref_ptr<osg::Node> getNode() const { return mNode; }
+
+    private:
+        ChunkManager* mChunkManager;
+        float mSize;
+        ChunkKey mKey;
+        osg::ref_ptr<osg::Node> mNode;
+        std::mutex mMutex;
+        bool mAborted = false;
+    };
 
     struct UpdateTextureFilteringFunctor
     {
@@ -52,9 +104,27 @@ namespace Terrain
         , mCompositeMapLevel(1.f)
         , mMaxCompGeometrySize(1.f)
         , mPlayerPosition(0.f, 0.f, 0.f)
-        , mLastCacheClearPosition(0.f, 0.f, 0.f)
+        , mLastRebuildCheckPosition(0.f, 0.f, 0.f)
+        , mTimeSinceRebuildCheck(0.f)
         , mSubdivisionTracker(std::make_unique<SubdivisionTracker>())
+        , mSubdivisionCache(static_cast<std::size_t>(Settings::terrain().mSnowSubdivisionCacheSize) * 1024 * 1024)
+        , mWorkQueue(nullptr)
+        , mSnowTessellation(false)
+        , mUseVertexArrayObjects(Settings::terrain().mVertexArrayObjects)
     {
+        if (Settings::terrain().mSnowSubdivisionMethod.get() == "tessellation")
+        {
+            constexpr float minimumGLVersionRequiredForTessellation = 4.0;
+            if (!SceneUtil::glExtensionsReady()
+                || SceneUtil::getGLExtensions().glVersion < minimumGLVersionRequiredForTessellation)
+                Log(Debug::Warning) << "Snow tessellation requires OpenGL 4.0, falling back to CPU subdivision";
+            else if (Stereo::getMultiview())
+                Log(Debug::Warning) << "Snow tessellation is not supported with multiview, falling back to CPU "
+                                       "subdivision";
+            else
+                mSnowTessellation = true;
+        }
+
         mMultiPassRoot = new osg::StateSet;
         mMultiPassRoot->setRenderingHint(osg::StateSet::OPAQUE_BIN);
         osg::ref_ptr<osg::Material> material(new osg::Material);
@@ -62,6 +132,11 @@ namespace Terrain
         mMultiPassRoot->setAttributeAndModes(material, osg::StateAttribute::ON);
     }
 
+    ChunkManager::~ChunkManager()
+    {
+        abortRebuilds();
+    }
+
     osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f& center, unsigned char lod,
         unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
     {
@@ -75,7 +150,12 @@ namespace Terrain
             // DEBUG: Log when we return cached chunk (subdivision was decided earlier!)
             float cellSize = mStorage->getCellWorldSize(mWorldspace);
             osg::Vec2f worldChunkCenter2D(center.x() * cellSize, center.y() * cellSize);
-            float distance = (osg::Vec2f(mPlayerPosition.x(), mPlayerPosition.y()) - worldChunkCenter2D).length();
+            osg::Vec2f playerPos2D;
+            {
+                const std::lock_guard lock(mSubdivisionMutex);
+                playerPos2D = osg::Vec2f(mPlayerPosition.x(), mPlayerPosition.y());
+            }
+            float distance = (playerPos2D - worldChunkCenter2D).length();
 
             if (distance < 2048.0f)
             {
@@ -106,54 +186,138 @@ namespace Terrain
 
     void ChunkManager::setPlayerPosition(const osg::Vec3f& pos)
     {
-        // Calculate how far player has moved since last cache clear (horizontal distance only)
-        osg::Vec2f currentPos2D(pos.x(), pos.y());
-        osg::Vec2f lastClearPos2D(mLastCacheClearPosition.x(), mLastCacheClearPosition.y());
-        float movementDistance = (currentPos2D - lastClearPos2D).length();
+        // Chunks are no longer flushed when the player moves, updateSubdivisionTracker rebuilds only the chunks
+        // whose subdivision level actually changed
+        const std::lock_guard lock(mSubdivisionMutex);
+        mPlayerPosition = pos;
+    }
 
-        // NEW: More frequent cache clearing (every 128 units instead of 256)
-        // This ensures chunks update subdivision levels as player moves through them
-        const float CACHE_CLEAR_THRESHOLD = 128.0f;
+    bool ChunkManager::updateSubdivisionTracker(float dt)
+    {
+        if (!mSubdivisionTracker)
+            return false;
 
-        if (movementDistance > CACHE_CLEAR_THRESHOLD)
+        osg::Vec3f playerPosition;
         {
-            Log(Debug::Info) << "[SNOW] Player moved " << (int)movementDistance
-                            << " units, clearing chunk cache to update subdivisions";
+            const std::lock_guard lock(mSubdivisionMutex);
+            playerPosition = mPlayerPosition;
+            mSubdivisionTracker->update(dt, osg::Vec2f(playerPosition.x(), playerPosition.y()));
+        }
+
+        const bool swapped = collectRebuilds();
 
-            // Clear the cache to force chunk recreation with new subdivisions
-            clearCache();
+        // With tessellation the GPU follows the player every frame, chunks never need rebuilding
+        if (mSnowTessellation)
+            return swapped;
 
-            // Update the last clear position
-            mLastCacheClearPosition = pos;
+        // Levels change with player distance and with trail decay, check on movement and periodically
+        const float rebuildCheckDistance = 32.f;
+        const float rebuildCheckInterval = 0.5f;
+        mTimeSinceRebuildCheck += dt;
+        if ((playerPosition - mLastRebuildCheckPosition).length2() > rebuildCheckDistance * rebuildCheckDistance
+            || mTimeSinceRebuildCheck > rebuildCheckInterval)
+        {
+            mLastRebuildCheckPosition = playerPosition;
+            mTimeSinceRebuildCheck = 0.f;
+            scheduleRebuilds();
         }
 
-        // Always update the current player position for new chunk creation
-        mPlayerPosition = pos;
+        return swapped;
     }
 
-    void ChunkManager::updateSubdivisionTracker(float dt)
+    int ChunkManager::getSubdivisionLevel(
+        float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec2f& playerPos) const
     {
-        if (mSubdivisionTracker)
+        const float cellSize = mStorage->getCellWorldSize(mWorldspace);
+        const osg::Vec2f worldChunkCenter2D(chunkCenter.x() * cellSize, chunkCenter.y() * cellSize);
+        const float distance = distanceToChunkEdge(playerPos, worldChunkCenter2D, chunkSize * cellSize * 0.5f);
+        return mSubdivisionTracker->getSubdivisionLevel(chunkCenter, distance);
+    }
+
+    void ChunkManager::scheduleRebuilds()
+    {
+        // Bound the work in flight so a fast moving player does not flood the work queue
+        const std::size_t maxPendingRebuilds = 8;
+
+        std::vector<std::pair<ChunkKey, float>> outdated;
         {
-            osg::Vec2f playerPos2D(mPlayerPosition.x(), mPlayerPosition.y());
-            mSubdivisionTracker->update(dt, playerPos2D);
+            const std::lock_guard lock(mSubdivisionMutex);
+            const osg::Vec2f playerPos2D(mPlayerPosition.x(), mPlayerPosition.y());
+            for (auto it = mSubdividedChunks.begin(); it != mSubdividedChunks.end();)
+            {
+                // Drop chunks that expired from the cache, they will be recreated with the right level on demand
+                if (!mCache->getRefFromObjectCacheOrNone(it->first))
+                {
+                    it = mSubdividedChunks.erase(it);
+                    continue;
+                }
+                if (mPendingRebuilds.size() + outdated.size() < maxPendingRebuilds
+                    && !mPendingRebuilds.contains(it->first)
+                    && getSubdivisionLevel(it->second.mSize, it->first.mCenter, playerPos2D)
+                        != it->second.mSubdivisionLevel)
+                    outdated.emplace_back(it->first, it->second.mSize);
+                ++it;
+            }
+        }
+
+        for (const auto& [key, size] : outdated)
+        {
+            osg::ref_ptr<RebuildChunkWorkItem> item = new RebuildChunkWorkItem(this, size, key);
+            if (mWorkQueue)
+                mWorkQueue->addWorkItem(item);
+            else
+            {
+                item->doWork();
+                item->signalDone();
+            }
+            mPendingRebuilds.emplace(key, std::move(item));
         }
     }
 
+    bool ChunkManager::collectRebuilds()
+    {
+        bool swapped = false;
+        for (auto it = mPendingRebuilds.begin(); it != mPendingRebuilds.end();)
+        {
+            if (!it->second->isDone())
+            {
+                ++it;
+                continue;
+            }
+            if (osg::ref_ptr<osg::Node> node = it->second->getNode())
+            {
+                mCache->addEntryToObjectCache(it->first, node.get());
+                swapped = true;
+            }
+            it = mPendingRebuilds.erase(it);
+        }
+        return swapped;
+    }
+
+    void ChunkManager::abortRebuilds()
+    {
+        for (auto& [key, item] : mPendingRebuilds)
+            item->abort();
+        mPendingRebuilds.clear();
+    }
+
     void ChunkManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Terrain Chunk", frameNumber, mCache->getStats(), *stats);
+        Resource::reportStats("Terrain Subdivision", frameNumber, mSubdivisionCache.getStats(), *stats);
     }
 
     void ChunkManager::clearCache()
     {
+        abortRebuilds();
+
         GenericResourceManager<ChunkKey>::clearCache();
 
         mBufferCache.clearCache();
+        mSubdivisionCache.clear();
 
-        // Update last cache clear position to current player position
-        // This prevents immediate re-clearing after manual cache clear
-        mLastCacheClearPosition = mPlayerPosition;
+        const std::lock_guard lock(mSubdivisionMutex);
+        mSubdividedChunks.clear();
     }
 
     void ChunkManager::releaseGLObjects(osg::State* state)
@@ -175,6 +339,40 @@ namespace Terrain
         return texture;
     }
 
+    osg::ref_ptr<CompositeMap> ChunkManager::createCompositeMap(float chunkSize, const osg::Vec2f& chunkCenter)
+    {
+        osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
+
+        if (mCompositeMapCache != nullptr)
+        {
+            std::vector<LayerInfo> layerList;
+            std::vector<osg::ref_ptr<osg::Image>> blendmaps;
+            mStorage->getBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, mWorldspace);
+            compositeMap->mCacheKey = mCompositeMapCache->makeKey(
+                mWorldspace, chunkSize, chunkCenter, mCompositeMapSize, blendmaps, layerList);
+
+            if (osg::ref_ptr<osg::Image> image = mCompositeMapCache->read(compositeMap->mCacheKey))
+            {
+                // A map without drawables is never rendered, it only keeps the texture for filter updates
+                compositeMap->mTexture = new osg::Texture2D(image);
+                compositeMap->mTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+                compositeMap->mTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+                compositeMap->mTexture->setResizeNonPowerOfTwoHint(false);
+                mSceneManager->applyFilterSettings(compositeMap->mTexture);
+                compositeMap->mCacheKey.clear();
+                return compositeMap;
+            }
+        }
+
+        compositeMap->mTexture = createCompositeMapRTT();
+
+        createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
+
+        mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+
+        return compositeMap;
+    }
+
     void ChunkManager::createCompositeMapGeometry(
         float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& compositeMap)
     {
@@ -267,8 +465,9 @@ namespace Terrain
 
         float tileCount = mStorage->getTextureTileCount(chunkSize, mWorldspace);
 
-        return ::Terrain::createPasses(
-            useShaders, mSceneManager, layers, blendmapTextures, tileCount, tileCount, ESM::isEsm4Ext(mWorldspace));
+        const bool snowTessellation = mSnowTessellation && !forCompositeMap && chunkSize <= 1.f;
+        return ::Terrain::createPasses(useShaders, mSceneManager, layers, blendmapTextures, tileCount, tileCount,
+            ESM::isEsm4Ext(mWorldspace), snowTessellation);
     }
 
     osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Vec2f& chunkCenter, unsigned char lod,
@@ -316,6 +515,7 @@ namespace Terrain
 
         geometry->setUseDisplayList(false);
         geometry->setUseVertexBufferObjects(true);
+        geometry->setUseVertexArrayObject(mUseVertexArrayObjects);
 
         if (chunkSize <= 1.f)
             geometry->setLightListCallback(new SceneUtil::LightListCallback);
@@ -358,12 +558,7 @@ namespace Terrain
         {
             if (useCompositeMap)
             {
-                osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
-                compositeMap->mTexture = createCompositeMapRTT();
-
-                createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
-
-                mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+                osg::ref_ptr<CompositeMap> compositeMap = createCompositeMap(chunkSize, chunkCenter);
 
                 geometry->setCompositeMap(compositeMap);
                 geometry->setCompositeMapRenderer(mCompositeMapRenderer);
@@ -374,7 +569,8 @@ namespace Terrain
                 layer.mSpecular = false;
                 geometry->setPasses(::Terrain::createPasses(
                     mSceneManager->getForceShaders() || !mSceneManager->getClampLighting(), mSceneManager,
-                    std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1.f, 1.f));
+                    std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1.f, 1.f, false,
+                    mSnowTessellation && chunkSize <= 1.f));
             }
             else
             {
@@ -382,6 +578,15 @@ namespace Terrain
             }
         }
 
+        // Tessellated chunks are drawn as patches. The triangle index buffer was still used above so that the
+        // cluster culling callback could be computed from real triangles.
+        const bool tessellated = passesUseTessellation(geometry->getPasses());
+        if (tessellated)
+        {
+            geometry->setPrimitiveSet(0, mBufferCache.getPatchIndexBuffer(numVerts, lodFlags));
+            chunkStateSet->setAttribute(new osg::PatchParameter(3));
+        }
+
         geometry->setupWaterBoundingBox(-1, chunkSize * mStorage->getCellWorldSize(mWorldspace) / numVerts);
 
         if (!templateGeometry && compile && mSceneManager->getIncrementalCompileOperation())
@@ -399,16 +604,19 @@ namespace Terrain
 
         // Get player's horizontal position (x=east-west, y=north-south in world units)
         // Note: OSG uses (x,y,z) = (east-west, north-south, height)
-        osg::Vec2f playerPos2D(mPlayerPosition.x(), mPlayerPosition.y());
+        osg::Vec3f playerPosition;
+        {
+            const std::lock_guard lock(mSubdivisionMutex);
+            playerPosition = mPlayerPosition;
+        }
+        osg::Vec2f playerPos2D(playerPosition.x(), playerPosition.y());
 
         // Calculate chunk half-size for edge distance calculation
         float halfChunkSize = chunkSize * cellSize * 0.5f;
 
         // Calculate distance to nearest chunk edge (not center!)
         // This allows pre-subdivision before player actually enters the chunk
-        float distanceToEdgeX = std::max(0.0f, std::abs(playerPos2D.x() - worldChunkCenter2D.x()) - halfChunkSize);
-        float distanceToEdgeY = std::max(0.0f, std::abs(playerPos2D.y() - worldChunkCenter2D.y()) - halfChunkSize);
-        float distanceToEdge = std::sqrt(distanceToEdgeX * distanceToEdgeX + distanceToEdgeY * distanceToEdgeY);
+        float distanceToEdge = distanceToChunkEdge(playerPos2D, worldChunkCenter2D, halfChunkSize);
 
         // Also calculate distance to center for reference/logging
         float distanceToCenter = (playerPos2D - worldChunkCenter2D).length();
@@ -423,15 +631,20 @@ namespace Terrain
         float maxY = worldChunkCenter2D.y() + halfChunkSize;
 
         // Check if player is inside this chunk
-        bool playerInChunk = (mPlayerPosition.x() >= minX && mPlayerPosition.x() <= maxX &&
-                             mPlayerPosition.y() >= minY && mPlayerPosition.y() <= maxY);
+        bool playerInChunk = (playerPosition.x() >= minX && playerPosition.x() <= maxX &&
+                             playerPosition.y() >= minY && playerPosition.y() <= maxY);
 
         // NEW: Use subdivision tracker to determine level (creates trail effect)
         // This consults both current distance AND historical subdivision state
         int subdivisionLevel = 0;
-        if (chunkSize <= 1.0f && mSubdivisionTracker)
+        if (chunkSize <= 1.0f && mSubdivisionTracker && !tessellated)
         {
+            const std::lock_guard lock(mSubdivisionMutex);
             subdivisionLevel = mSubdivisionTracker->getSubdivisionLevel(chunkCenter, distance);
+
+            // Remember the level so the chunk can be rebuilt in the background once it no longer matches
+            const ChunkKey key{ .mCenter = chunkCenter, .mLod = lod, .mLodFlags = lodFlags };
+            mSubdividedChunks[key] = SubdividedChunk{ .mSize = chunkSize, .mSubdivisionLevel = subdivisionLevel };
         }
 
         // DEBUG: Log chunk creation with distance info for debugging subdivision
@@ -444,13 +657,28 @@ namespace Terrain
                                << " distCenter=" << (int)distanceToCenter
                                << " subdivLvl=" << subdivisionLevel
                                << (playerInChunk ? " INSIDE" : "")
-                               << " player=(" << (int)mPlayerPosition.x() << "," << (int)mPlayerPosition.y() << ")"
+                               << " player=(" << (int)playerPosition.x() << "," << (int)playerPosition.y() << ")"
                                << " chunk=(" << chunkCenter.x() << "," << chunkCenter.y() << ")";
         }
 
         if (subdivisionLevel > 0)
         {
-            osg::ref_ptr<osg::Geometry> subdivided = TerrainSubdivider::subdivide(geometry.get(), subdivisionLevel);
+            const SubdivisionKey subdivisionKey{
+                .mCenter = chunkCenter, .mLod = lod, .mLodFlags = lodFlags, .mSubdivisionLevel = subdivisionLevel
+            };
+            osg::ref_ptr<osg::Geometry> subdivided = mSubdivisionCache.get(subdivisionKey);
+            if (!subdivided)
+            {
+                subdivided = TerrainSubdivider::subdivide(geometry.get(), subdivisionLevel);
+                if (subdivided)
+                {
+                    // Only the arrays are used, chunks with the same number of vertices draw them with one primitive set
+                    subdivided->setStateSet(nullptr);
+                    subdivided->setPrimitiveSet(
+                        0, mBufferCache.getTriangleListBuffer(subdivided->getVertexArray()->getNumElements()));
+                    mSubdivisionCache.insert(subdivisionKey, subdivided);
+                }
+            }
             if (subdivided)
             {
                 // Copy TerrainDrawable-specific data to the subdivided geometry
@@ -474,6 +702,7 @@ namespace Terrain
                 subdividedDrawable->setNodeMask(geometry->getNodeMask());
                 subdividedDrawable->setUseDisplayList(false);
                 subdividedDrawable->setUseVertexBufferObjects(true);
+                subdividedDrawable->setUseVertexArrayObject(mUseVertexArrayObjects);
 
                 // Set light list callback if this is a small chunk
                 if (chunkSize <= 1.f)
@@ -485,6 +714,7 @@ namespace Terrain
                 // Mark this chunk as subdivided in the tracker (for trail persistence)
                 if (mSubdivisionTracker)
                 {
+                    const std::lock_guard lock(mSubdivisionMutex);
                     mSubdivisionTracker->markChunkSubdivided(chunkCenter, subdivisionLevel, worldChunkCenter2D);
                 }
 
@@ -1,13 +1,16 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
-#include <tuple>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <tuple>
 
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
 #include "quadtreeworld.hpp"
+#include "subdivisioncache.hpp"
 #include "subdivisiontracker.hpp"
 
 namespace osg
@@ -21,10 +24,16 @@ namespace Resource
     class SceneManager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
 
     class TextureManager;
+    class CompositeMapCache;
     class CompositeMapRenderer;
     class Storage;
     class CompositeMap;
@@ -79,6 +88,7 @@ namespace Terrain
     public:
         explicit ChunkManager(Storage* storage, Resource::SceneManager* sceneMgr, TextureManager* textureManager,
             CompositeMapRenderer* renderer, ESM::RefId worldspace, double expiryDelay);
+        ~ChunkManager();
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
             bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
@@ -86,18 +96,22 @@ namespace Terrain
         void setCompositeMapSize(unsigned int size) { mCompositeMapSize = size; }
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
+        void setCompositeMapCache(CompositeMapCache* cache) { mCompositeMapCache = cache; }
 
         void updateTextureFiltering();
 
         void setNodeMask(unsigned int mask) { mNodeMask = mask; }
         unsigned int getNodeMask() override { return mNodeMask; }
 
+        // Work queue for rebuilding chunks whose subdivision level changed, rebuilds run synchronously without one
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue) { mWorkQueue = workQueue; }
+
         // Set the player position for snow deformation subdivision calculations
-        // Updates subdivision tracker and invalidates cache if needed
         void setPlayerPosition(const osg::Vec3f& pos);
 
-        // Update subdivision tracker (call each frame)
-        void updateSubdivisionTracker(float dt);
+        // Update subdivision tracker and rebuild chunks whose subdivision level changed (call each frame)
+        // @return true if rebuilt chunks were swapped into the cache, so views referencing the old ones must be rebuilt
+        bool updateSubdivisionTracker(float dt);
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
@@ -106,11 +120,33 @@ namespace Terrain
         void releaseGLObjects(osg::State* state) override;
 
     private:
+        class RebuildChunkWorkItem;
+
+        struct SubdividedChunk
+        {
+            float mSize;
+            int mSubdivisionLevel;
+        };
+
         osg::ref_ptr<osg::Node> createChunk(float size, const osg::Vec2f& center, unsigned char lod,
             unsigned int lodFlags, bool compile, const TerrainDrawable* templateGeometry, const osg::Vec3f& viewPoint);
 
         osg::ref_ptr<osg::Texture2D> createCompositeMapRTT();
 
+        /// @return Composite map read from the cache, or one to render with the key to store it with
+        osg::ref_ptr<CompositeMap> createCompositeMap(float chunkSize, const osg::Vec2f& chunkCenter);
+
+        int getSubdivisionLevel(float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec2f& playerPos) const;
+
+        /// Queue rebuilds for cached chunks built with a subdivision level that no longer matches the tracker.
+        void scheduleRebuilds();
+
+        /// Swap finished rebuilds into the cache.
+        /// @return true if any chunk was replaced
+        bool collectRebuilds();
+
+        void abortRebuilds();
+
         void createCompositeMapGeometry(
             float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& map);
 
@@ -121,6 +157,7 @@ namespace Terrain
         Resource::SceneManager* mSceneManager;
         TextureManager* mTextureManager;
         CompositeMapRenderer* mCompositeMapRenderer;
+        CompositeMapCache* mCompositeMapCache = nullptr;
         BufferCache mBufferCache;
 
         osg::ref_ptr<osg::StateSet> mMultiPassRoot;
@@ -134,12 +171,32 @@ namespace Terrain
         // Player position for snow deformation subdivision (defaults to origin)
         osg::Vec3f mPlayerPosition;
 
-        // Track last position where we cleared cache for subdivision updates
-        // When player moves beyond threshold, we need to clear cache to force chunk recreation
-        osg::Vec3f mLastCacheClearPosition;
+        // Position and time since the last check for chunks needing a rebuild
+        osg::Vec3f mLastRebuildCheckPosition;
+        float mTimeSinceRebuildCheck;
 
         // Tracks which chunks should stay subdivided for snow trail effect
         std::unique_ptr<SubdivisionTracker> mSubdivisionTracker;
+
+        // Guards mPlayerPosition, mSubdivisionTracker and mSubdividedChunks, chunks are also created by preload threads
+        mutable std::mutex mSubdivisionMutex;
+
+        // Subdivision level each cached small chunk was built with
+        std::map<ChunkKey, SubdividedChunk> mSubdividedChunks;
+
+        // Rebuilds in flight, only accessed from the main thread
+        std::map<ChunkKey, osg::ref_ptr<RebuildChunkWorkItem>> mPendingRebuilds;
+
+        // Subdivided geometry of recently built chunks, so chunks rebuilt at a level they had before skip subdivision
+        SubdivisionCache mSubdivisionCache;
+
+        SceneUtil::WorkQueue* mWorkQueue;
+
+        // Subdivide near-player chunks with tessellation shaders instead of TerrainSubdivider
+        bool mSnowTessellation;
+
+        // Bind the vertex arrays of a chunk with a single call per draw
+        bool mUseVertexArrayObjects;
     };
 
 }
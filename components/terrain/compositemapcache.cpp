@@ -0,0 +1,192 @@
+#include "compositemapcache.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <osg/Image>
+
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/vfs/manager.hpp>
+
+namespace Terrain
+{
+    namespace
+    {
+        // Increase when the rendering of composite maps changes
+        constexpr int formatVersion = 1;
+
+        std::string toHex(const std::array<std::uint64_t, 2>& hash)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (const std::uint64_t value : hash)
+                stream << std::setw(16) << value;
+            return stream.str();
+        }
+
+        void writeFile(osgDB::ReaderWriter& readerWriter, const osgDB::Options* options,
+            const std::filesystem::path& directory, const std::filesystem::path& path, const osg::Image& image)
+        {
+            // Write to a temporary file first so other threads and processes never read a partially written map
+            std::filesystem::path temporary = path;
+            temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+            try
+            {
+                std::filesystem::create_directories(directory);
+
+                {
+                    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                    if (!stream.is_open())
+                        throw std::runtime_error("failed to open file");
+                    const osgDB::ReaderWriter::WriteResult result = readerWriter.writeImage(image, stream, options);
+                    if (!result.success())
+                        throw std::runtime_error(result.message());
+                    stream.close();
+                    if (!stream)
+                        throw std::runtime_error("failed to write file");
+                }
+
+                std::filesystem::rename(temporary, path);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write composite map " << path << ": " << e.what();
+                std::error_code ec;
+                std::filesystem::remove(temporary, ec);
+            }
+        }
+
+        class WriteWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            WriteWorkItem(osgDB::ReaderWriter& readerWriter, osg::ref_ptr<const osgDB::Options> options,
+                std::filesystem::path directory, std::filesystem::path path, osg::ref_ptr<osg::Image> image)
+                : mReaderWriter(readerWriter)
+                , mOptions(std::move(options))
+                , mDirectory(std::move(directory))
+                , mPath(std::move(path))
+                , mImage(std::move(image))
+            {
+            }
+
+            void doWork() override { writeFile(mReaderWriter, mOptions, mDirectory, mPath, *mImage); }
+
+        private:
+            osgDB::ReaderWriter& mReaderWriter;
+            const osg::ref_ptr<const osgDB::Options> mOptions;
+            const std::filesystem::path mDirectory;
+            const std::filesystem::path mPath;
+            const osg::ref_ptr<osg::Image> mImage;
+        };
+    }
+
+    CompositeMapCache::CompositeMapCache(const VFS::Manager& vfs, std::filesystem::path directory)
+        : mVFS(vfs)
+        , mDirectory(std::move(directory))
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("dds"))
+        // Keep the rows in the order they were read from the texture, so the data can be uploaded as is
+        , mOptions(new osgDB::Options("ddsNoAutoFlipWrite"))
+    {
+        if (mReaderWriter == nullptr)
+            Log(Debug::Warning) << "No readerwriter for 'dds' found, composite maps will not be cached";
+    }
+
+    CompositeMapCache::~CompositeMapCache() = default;
+
+    void CompositeMapCache::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+    {
+        mWorkQueue = workQueue;
+    }
+
+    std::string CompositeMapCache::makeKey(ESM::RefId worldspace, float chunkSize, const osg::Vec2f& chunkCenter,
+        unsigned size, const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, const std::vector<LayerInfo>& layers)
+    {
+        if (mReaderWriter == nullptr)
+            return {};
+
+        std::ostringstream descriptor;
+        descriptor << formatVersion << ' ' << worldspace.serializeText() << ' ' << chunkSize << ' ' << chunkCenter.x()
+                   << ' ' << chunkCenter.y() << ' ' << size;
+        for (const LayerInfo& layer : layers)
+            descriptor << ' ' << layer.mDiffuseMap.value() << ' ' << toHex(getTextureHash(layer.mDiffuseMap));
+        for (const osg::ref_ptr<osg::Image>& blendmap : blendmaps)
+        {
+            descriptor << ' ' << blendmap->s() << ' ' << blendmap->t() << ' ';
+            descriptor.write(reinterpret_cast<const char*>(blendmap->data()),
+                static_cast<std::streamsize>(blendmap->getTotalSizeInBytes()));
+        }
+
+        std::istringstream stream(descriptor.str());
+        return toHex(Files::getHash("composite map", stream));
+    }
+
+    osg::ref_ptr<osg::Image> CompositeMapCache::read(const std::string& key) const
+    {
+        if (mReaderWriter == nullptr || key.empty())
+            return nullptr;
+
+        const std::filesystem::path path = getFilePath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        try
+        {
+            const osgDB::ReaderWriter::ReadResult result = mReaderWriter->readImage(stream, mOptions);
+            if (result.success() && result.getImage() != nullptr)
+                return result.getImage();
+            Log(Debug::Warning) << "Failed to read composite map " << path << ": " << result.message();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read composite map " << path << ": " << e.what();
+        }
+        return nullptr;
+    }
+
+    void CompositeMapCache::write(const std::string& key, osg::ref_ptr<osg::Image> image) const
+    {
+        if (mReaderWriter == nullptr || key.empty() || image == nullptr)
+            return;
+
+        const std::filesystem::path path = getFilePath(key);
+        if (mWorkQueue != nullptr)
+            mWorkQueue->addWorkItem(new WriteWorkItem(*mReaderWriter, mOptions, mDirectory, path, std::move(image)),
+                SceneUtil::WorkPriority::Low);
+        else
+            writeFile(*mReaderWriter, mOptions, mDirectory, path, *image);
+    }
+
+    std::array<std::uint64_t, 2> CompositeMapCache::getTextureHash(VFS::Path::NormalizedView path)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            if (const auto it = mTextureHashes.find(path); it != mTextureHashes.end())
+                return it->second;
+        }
+
+        std::array<std::uint64_t, 2> hash{};
+        if (const Files::IStreamPtr file = mVFS.find(path))
+            hash = Files::getHash(path.value(), *file);
+
+        const std::lock_guard lock(mMutex);
+        return mTextureHashes.emplace(path, hash).first->second;
+    }
+
+    std::filesystem::path CompositeMapCache::getFilePath(const std::string& key) const
+    {
+        return mDirectory / Files::pathFromUnicodeString(key + ".dds");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osg/Vec2f>
+#include <osg/ref_ptr>
+
+#include <components/esm/refid.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include "defs.hpp"
+
+namespace osg
+{
+    class Image;
+}
+
+namespace osgDB
+{
+    class Options;
+    class ReaderWriter;
+}
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace VFS
+{
+    class Manager;
+}
+
+namespace Terrain
+{
+    /// @brief Composite maps of distant terrain chunks kept on disk between runs.
+    /// @par Maps are stored as DXT1 compressed DDS images keyed by the blend maps of the chunk and the content of its
+    /// layer textures, so changes to the land or to the textures produce new entries instead of stale ones.
+    class CompositeMapCache
+    {
+    public:
+        explicit CompositeMapCache(const VFS::Manager& vfs, std::filesystem::path directory);
+
+        ~CompositeMapCache();
+
+        /// Work queue used to write the maps, they are written by the calling thread without one.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
+        /// @note Thread safe.
+        std::string makeKey(ESM::RefId worldspace, float chunkSize, const osg::Vec2f& chunkCenter, unsigned size,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, const std::vector<LayerInfo>& layers);
+
+        /// @return Cached map, nullptr if there is none or it can't be read.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Image> read(const std::string& key) const;
+
+        /// Store a compressed map, failures are only logged.
+        /// @note Thread safe.
+        void write(const std::string& key, osg::ref_ptr<osg::Image> image) const;
+
+    private:
+        const VFS::Manager& mVFS;
+        std::filesystem::path mDirectory;
+        osgDB::ReaderWriter* mReaderWriter;
+        osg::ref_ptr<osgDB::Options> mOptions;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+
+        std::mutex mMutex;
+        // Textures are hashed once per run
+        std::map<VFS::Path::Normalized, std::array<std::uint64_t, 2>, std::less<>> mTextureHashes;
+
+        std::array<std::uint64_t, 2> getTextureHash(VFS::Path::NormalizedView path);
+
+        std::filesystem::path getFilePath(const std::string& key) const;
+    };
+}
+
+#endif
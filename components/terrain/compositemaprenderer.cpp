@@ -1,11 +1,16 @@
 #include "compositemaprenderer.hpp"
 
 #include <osg/FrameBufferObject>
+#include <osg/Image>
 #include <osg/RenderInfo>
 #include <osg/Texture2D>
 
 #include <algorithm>
 
+#include <components/sceneutil/gputimer.hpp>
+
+#include "compositemapcache.hpp"
+
 namespace Terrain
 {
 
@@ -18,6 +23,8 @@ namespace Terrain
 
         mFBO = new osg::FrameBufferObject;
 
+        setDrawCallback(new SceneUtil::GpuTimerDrawCallback(new SceneUtil::GpuTimer("Composite Maps")));
+
         getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
     }
 
@@ -125,7 +132,11 @@ namespace Terrain
             compositeMap.mDrawables[i] = nullptr;
         }
         if (compositeMap.mCompiled == compositeMap.mDrawables.size())
+        {
             compositeMap.mDrawables = std::vector<osg::ref_ptr<osg::Drawable>>();
+            if (mCache != nullptr && !compositeMap.mCacheKey.empty())
+                store(compositeMap, state);
+        }
 
         state.haveAppliedAttribute(osg::StateAttribute::VIEWPORT);
 
@@ -133,6 +144,33 @@ namespace Terrain
         ext->glBindFramebuffer(GL_FRAMEBUFFER_EXT, fboId);
     }
 
+    void CompositeMapRenderer::store(const CompositeMap& compositeMap, osg::State& state) const
+    {
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        if (!ext->isTextureCompressionS3TCSupported)
+            return;
+
+        const int width = compositeMap.mTexture->getTextureWidth();
+        const int height = compositeMap.mTexture->getTextureHeight();
+
+        // Let the driver compress a copy of the map and read it back, the texture is still attached to the FBO
+        mFBO->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 0, 0, width, height, 0);
+
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->readImageFromCurrentTexture(state.getContextID(), false, GL_UNSIGNED_BYTE);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &texture);
+        state.haveAppliedTextureAttribute(state.getActiveTextureUnit(), osg::StateAttribute::TEXTURE);
+
+        if (image->isCompressed())
+            mCache->write(compositeMap.mCacheKey, std::move(image));
+    }
+
     void CompositeMapRenderer::setMinimumTimeAvailableForCompile(double time)
     {
         mMinimumTimeAvailable = time;
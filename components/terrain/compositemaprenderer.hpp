@@ -5,6 +5,7 @@
 
 #include <mutex>
 #include <set>
+#include <string>
 
 namespace osg
 {
@@ -15,6 +16,7 @@ namespace osg
 
 namespace Terrain
 {
+    class CompositeMapCache;
 
     class CompositeMap : public osg::Referenced
     {
@@ -24,6 +26,8 @@ namespace Terrain
         std::vector<osg::ref_ptr<osg::Drawable>> mDrawables;
         osg::ref_ptr<osg::Texture2D> mTexture;
         unsigned int mCompiled;
+        // Key to store the map with once it is rendered, empty when it is not cached
+        std::string mCacheKey;
     };
 
     /**
@@ -54,6 +58,9 @@ namespace Terrain
 
         unsigned int getCompileSetSize() const;
 
+        /// Store rendered composite maps with a cache key in this cache
+        void setCompositeMapCache(CompositeMapCache* cache) { mCache = cache; }
+
     private:
         float mTargetFrameRate;
         double mMinimumTimeAvailable;
@@ -67,6 +74,10 @@ namespace Terrain
         mutable std::mutex mMutex;
 
         osg::ref_ptr<osg::FrameBufferObject> mFBO;
+
+        CompositeMapCache* mCache = nullptr;
+
+        void store(const CompositeMap& compositeMap, osg::State& state) const;
     };
 
 }
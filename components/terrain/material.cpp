@@ -5,6 +5,7 @@
 #include <osg/Capability>
 #include <osg/Depth>
 #include <osg/Fog>
+#include <osg/Program>
 #include <osg/TexEnvCombine>
 #include <osg/TexMat>
 #include <osg/Texture2D>
@@ -16,10 +17,21 @@
 #include <components/shader/shadermanager.hpp>
 #include <components/stereo/stereomanager.hpp>
 
+#include <array>
 #include <mutex>
+#include <string>
 
 namespace
 {
+    // Layers drawn by the pass of a previous layer, their textures use units 3 to 6 since 7 is used by snow
+    // deformation
+    constexpr std::size_t maxPackedLayers = 2;
+
+    int getPackedDiffuseMapUnit(std::size_t index)
+    {
+        return 3 + static_cast<int>(index) * 2;
+    }
+
     class BlendmapTexMat
     {
     public:
@@ -211,6 +223,8 @@ namespace
         osg::ref_ptr<osg::Uniform> mBlendMap;
         osg::ref_ptr<osg::Uniform> mNormalMap;
         osg::ref_ptr<osg::Uniform> mColorMode;
+        std::array<osg::ref_ptr<osg::Uniform>, maxPackedLayers> mPackedDiffuseMaps;
+        std::array<osg::ref_ptr<osg::Uniform>, maxPackedLayers> mPackedBlendMaps;
 
         UniformCollection()
             : mDiffuseMap(new osg::Uniform("diffuseMap", 0))
@@ -218,15 +232,27 @@ namespace
             , mNormalMap(new osg::Uniform("normalMap", 2))
             , mColorMode(new osg::Uniform("colorMode", 2))
         {
+            for (std::size_t i = 0; i < maxPackedLayers; ++i)
+            {
+                const std::string suffix = std::to_string(i + 1);
+                mPackedDiffuseMaps[i] = new osg::Uniform(("diffuseMap" + suffix).c_str(), getPackedDiffuseMapUnit(i));
+                mPackedBlendMaps[i] = new osg::Uniform(("blendMap" + suffix).c_str(), getPackedDiffuseMapUnit(i) + 1);
+            }
         }
     };
+
+    // Layers without normal or specular maps are lit the same way, so they can share a pass
+    bool canBePacked(const Terrain::TextureLayer& layer)
+    {
+        return layer.mNormalMap == nullptr && !layer.mSpecular;
+    }
 }
 
 namespace Terrain
 {
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize, bool esm4terrain)
+        int blendmapScale, float layerTileSize, bool esm4terrain, bool snowTessellation)
     {
         auto& shaderManager = sceneManager->getShaderManager();
         std::vector<osg::ref_ptr<osg::StateSet>> passes;
@@ -236,6 +262,12 @@ namespace Terrain
         {
             bool firstLayer = (it == layers.begin());
 
+            std::size_t packedLayers = 0;
+            if (useShaders && !blendmaps.empty() && canBePacked(*it))
+                while (packedLayers < maxPackedLayers && it + packedLayers + 1 != layers.end()
+                    && canBePacked(*(it + packedLayers + 1)))
+                    ++packedLayers;
+
             osg::ref_ptr<osg::StateSet> stateset(new osg::StateSet);
 
             if (!blendmaps.empty())
@@ -274,6 +306,16 @@ namespace Terrain
                     if (!esm4terrain)
                         stateset->setTextureAttributeAndModes(1, BlendmapTexMat::value(blendmapScale));
                     stateset->addUniform(UniformCollection::value().mBlendMap);
+
+                    // The shader uses the texture matrices of units 0 and 1 for all layers
+                    for (std::size_t i = 0; i < packedLayers; ++i)
+                    {
+                        const int unit = getPackedDiffuseMapUnit(i);
+                        stateset->setTextureAttributeAndModes(unit, (it + i + 1)->mDiffuseMap);
+                        stateset->setTextureAttributeAndModes(unit + 1, blendmaps.at(blendmapIndex++));
+                        stateset->addUniform(UniformCollection::value().mPackedDiffuseMaps[i]);
+                        stateset->addUniform(UniformCollection::value().mPackedBlendMaps[i]);
+                    }
                 }
 
                 bool parallax = it->mNormalMap && it->mParallax;
@@ -305,15 +347,18 @@ namespace Terrain
                 defineMap["blendMap"] = (!blendmaps.empty()) ? "1" : "0";
                 defineMap["specularMap"] = it->mSpecular ? "1" : "0";
                 defineMap["parallax"] = parallax ? "1" : "0";
-                defineMap["writeNormals"] = (it == layers.end() - 1) ? "1" : "0";
+                defineMap["packedLayers"] = std::to_string(packedLayers);
+                defineMap["writeNormals"] = (it + packedLayers == layers.end() - 1) ? "1" : "0";
                 defineMap["reconstructNormalZ"] = reconstructNormalZ ? "1" : "0";
                 // Enable snow deformation shader code
                 defineMap["snowDeformation"] = "1";
+                defineMap["snowTessellation"] = snowTessellation ? "1" : "0";
                 // Note: useUBO, useGPUShader4, forcePPL, shadows_enabled are global defines
                 // They will be automatically merged from globalDefines by ShaderManager
                 Stereo::shaderStereoDefines(defineMap);
 
-                auto program = shaderManager.getProgram("terrain", defineMap);
+                auto program = snowTessellation ? shaderManager.getTessellationProgram("terrain", defineMap)
+                                                : shaderManager.getProgram("terrain", defineMap);
 
                 // DIAGNOSTIC: Log shader compilation info for ALL programs (not just first)
                 static int programCount = 0;
@@ -418,8 +463,25 @@ namespace Terrain
             }
 
             passes.push_back(stateset);
+            it += packedLayers;
         }
         return passes;
     }
 
+    bool passesUseTessellation(const std::vector<osg::ref_ptr<osg::StateSet>>& passes)
+    {
+        if (passes.empty())
+            return false;
+
+        const osg::Program* program
+            = static_cast<const osg::Program*>(passes.front()->getAttribute(osg::StateAttribute::PROGRAM));
+        if (!program)
+            return false;
+
+        for (unsigned int i = 0; i < program->getNumShaders(); ++i)
+            if (program->getShader(i)->getType() == osg::Shader::TESSEVALUATION)
+                return true;
+        return false;
+    }
+
 }
@@ -24,9 +24,14 @@ namespace Terrain
         bool mSpecular = false;
     };
 
+    /// @param snowTessellation Use the tessellation shader stages for snow deformation. Only applies when
+    /// \a useShaders is true; the chunk must then be drawn with GL_PATCHES (see passesUseTessellation).
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize, bool esm4terrain = false);
+        int blendmapScale, float layerTileSize, bool esm4terrain = false, bool snowTessellation = false);
+
+    /// @return true if the passes were created with the snow tessellation shader stages
+    bool passesUseTessellation(const std::vector<osg::ref_ptr<osg::StateSet>>& passes);
 }
 
 #endif
@@ -12,6 +12,7 @@
 #include <components/misc/constants.hpp>
 #include <components/misc/mathutil.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/occlusionculler.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 
 #include "chunkmanager.hpp"
@@ -490,10 +491,21 @@ namespace Terrain
 
         const float cellWorldSize = ESM::getCellSize(mWorldspace);
 
+        std::shared_ptr<const SceneUtil::DepthPyramid> depthPyramid;
+        if (mOcclusionCuller != nullptr && viewer != nullptr && viewer->getName() == Constants::SceneCamera)
+            depthPyramid = mOcclusionCuller->getDepthPyramid(nv.getTraversalNumber());
+
         for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
         {
             ViewDataEntry& entry = vd->getEntry(i);
             loadRenderingNode(entry, vd, cellWorldSize, mActiveGrid, false);
+            if (depthPyramid != nullptr)
+            {
+                osg::BoundingBox box;
+                box.expandBy(entry.mRenderingNode->getBound());
+                if (depthPyramid->isOccluded(box))
+                    continue;
+            }
             entry.mRenderingNode->accept(nv);
         }
 
@@ -511,6 +523,11 @@ namespace Terrain
         }
     }
 
+    void QuadTreeWorld::setOcclusionCuller(SceneUtil::OcclusionCuller* culler)
+    {
+        mOcclusionCuller = culler;
+    }
+
     void QuadTreeWorld::ensureQuadTreeBuilt()
     {
         std::lock_guard<std::mutex> lock(mQuadTreeMutex);
@@ -568,6 +585,7 @@ namespace Terrain
 
     void QuadTreeWorld::reportStats(unsigned int frameNumber, osg::Stats* stats)
     {
+        World::reportStats(frameNumber, stats);
         if (mCompositeMapRenderer)
             stats->setAttribute(frameNumber, "Composite", mCompositeMapRenderer->getCompileSetSize());
     }
@@ -631,14 +649,19 @@ namespace Terrain
     void QuadTreeWorld::updateSubdivisionTracker(float dt)
     {
         // Update subdivision tracker in all chunk managers
+        bool chunksRebuilt = false;
         for (ChunkManager* cm : mChunkManagers)
         {
             // Cast to Terrain::ChunkManager to access updateSubdivisionTracker
             if (Terrain::ChunkManager* tcm = dynamic_cast<Terrain::ChunkManager*>(cm))
             {
-                tcm->updateSubdivisionTracker(dt);
+                chunksRebuilt |= tcm->updateSubdivisionTracker(dt);
             }
         }
+
+        // Views keep their rendering nodes, reload them so the rebuilt chunks get picked up from the cache
+        if (chunksRebuilt)
+            mViewDataMap->rebuildViews();
     }
 
     void QuadTreeWorld::updateSnowDeformation(float dt, const osg::Vec3f& playerPos)
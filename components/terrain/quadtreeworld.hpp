@@ -16,6 +16,11 @@ namespace osg
     class Stats;
 }
 
+namespace SceneUtil
+{
+    class OcclusionCuller;
+}
+
 namespace Terrain
 {
     class RootNode;
@@ -99,6 +104,9 @@ namespace Terrain
         };
         void addChunkManager(ChunkManager*);
 
+        /// Skip the chunks hidden behind the depth of previous frames while culling the scene camera.
+        void setOcclusionCuller(SceneUtil::OcclusionCuller* culler);
+
     private:
         void ensureQuadTreeBuilt();
         void loadRenderingNode(
@@ -118,6 +126,7 @@ namespace Terrain
         float mMinSize;
         bool mDebugTerrainChunks;
         std::unique_ptr<DebugChunkManager> mDebugChunkManager;
+        osg::ref_ptr<SceneUtil::OcclusionCuller> mOcclusionCuller;
     };
 
 }
@@ -1,44 +1,87 @@
 #include "snowdeformation.hpp"
 #include "snowdetection.hpp"
+#include "snowpasstimer.hpp"
 #include "storage.hpp"
 
 #include <components/debug/debuglog.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/dynamicsurface.hpp>
+#include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
 
+#include <osg/BlendEquation>
+#include <osg/BlendFunc>
 #include <osg/Geode>
 #include <osg/Program>
 #include <osg/Shader>
+#include <osg/Stats>
 #include <osg/Uniform>
 #include <osgDB/WriteFile>
 
+#include <algorithm>
+#include <cmath>
+
 namespace Terrain
 {
+    namespace
+    {
+        // The atlas is view independent, with stereo rendering the cull of the second eye would stamp and decay the
+        // footprints a second time in the same frame
+        class CullOncePerFrameCallback : public osg::NodeCallback
+        {
+        public:
+            void operator()(osg::Node* node, osg::NodeVisitor* nv) override
+            {
+                const unsigned int frameNumber = nv->getTraversalNumber();
+                if (mCulled && frameNumber == mFrameNumber)
+                    return;
+                mCulled = true;
+                mFrameNumber = frameNumber;
+                traverse(node, nv);
+            }
+
+        private:
+            bool mCulled = false;
+            unsigned int mFrameNumber = 0;
+        };
+    }
+
     SnowDeformationManager::SnowDeformationManager(
         Resource::SceneManager* sceneManager,
         Storage* terrainStorage,
         osg::Group* rootNode)
         : mSceneManager(sceneManager)
         , mTerrainStorage(terrainStorage)
+        , mSnowCoverage(terrainStorage)
         , mWorldspace(ESM::RefId())
         , mEnabled(true)
         , mActive(false)
         , mCurrentTextureIndex(0)
         , mTexturesInitialized(false)
-        , mTextureResolution(1024)  // Increased from 512 for better quality
-        , mWorldTextureRadius(300.0f)  // Increased from 150 for larger coverage
+        , mTextureResolution(2048)  // Atlas of 16x16 pages, enough for the whole residency radius
+        , mWorldTextureRadius(512.0f)  // Pages within this distance stay resident, farther ones live in their logs
         , mTextureCenter(0.0f, 0.0f)
+        , mPageResolution(128)
+        , mPageWorldSize(128.0f)  // One texel per world unit
+        , mPageTableSize(32)  // 4096 units window around the player
+        , mPagesPerRow(0)
+        , mPageTableOrigin(0.0f, 0.0f)
+        , mTimeSinceResidencyUpdate(999.0f)  // Start high to update immediately
         , mFootprintRadius(60.0f)  // Default for snow (wide, body-sized), updated per-terrain
         , mFootprintInterval(2.0f)  // Default, will be updated per-terrain
         , mDeformationDepth(100.0f)  // Default for snow (waist-deep), updated per-terrain - MUST match snowRaiseAmount in shader!
         , mLastFootprintPos(0.0f, 0.0f, 0.0f)
         , mTimeSinceLastFootprint(999.0f)  // Start high to stamp immediately
-        , mLastBlitCenter(0.0f, 0.0f)
-        , mBlitThreshold(50.0f)  // Blit when player moves 50+ units
+        , mMaxFootprintsPerBatch(256)  // Footprints rendered per batched stamping pass
+        , mMaxActorFootprintsPerFrame(Settings::terrain().mSnowMaxActorFootprintsPerFrame)
+        , mActorFootprintCount(0)
+        , mLastActorFootprintCount(0)
+        , mMaxStampsPerPage(512)
         , mDecayTime(120.0f)  // 2 minutes for full restoration
         , mTimeSinceLastDecay(0.0f)
         , mDecayUpdateInterval(0.1f)  // Apply decay every 0.1 seconds
-        , mCurrentTerrainType("snow")
+        , mTerrainTypes(std::vector<std::string>())
+        , mCurrentTerrainType(0)
         , mCurrentTime(0.0f)
     {
         Log(Debug::Info) << "[SNOW] SnowDeformationManager created";
@@ -56,23 +99,28 @@ namespace Terrain
             {20.0f, 40.0f, 4.0f, "dirt"},    // Dirt: similar to mud
             {25.0f, 50.0f, 3.5f, "sand"}     // Sand: between ash and mud
         };
+        std::vector<std::string> terrainPatterns;
+        for (const TerrainParams& params : mTerrainParams)
+            terrainPatterns.push_back(params.pattern);
+        mTerrainTypes = TerrainTypeTable(std::move(terrainPatterns));
 
         // TODO: Load settings
         // mTextureResolution = Settings::terrain().mSnowDeformationResolution;
         // mWorldTextureRadius = Settings::terrain().mSnowDeformationRadius;
         // etc.
 
+        mPagesPerRow = mTextureResolution / mPageResolution;
+        for (int slot = mPagesPerRow * mPagesPerRow - 1; slot >= 0; --slot)
+            mFreeSlots.push_back(slot);
+
         // Setup RTT system
         setupRTT(rootNode);
         createDeformationTextures();
         setupFootprintStamping();
-        setupBlitSystem();
         setupDecaySystem();
 
-        // Initialize blit center to current position (will be updated on first frame)
-        mLastBlitCenter = mTextureCenter;
-
-        Log(Debug::Info) << "[SNOW] All deformation systems initialized";
+        Log(Debug::Info) << "[SNOW] All deformation systems initialized (" << mFreeSlots.size() << " pages of "
+                         << mPageResolution << "x" << mPageResolution << ")";
     }
 
     SnowDeformationManager::~SnowDeformationManager()
@@ -108,18 +156,21 @@ namespace Terrain
             osg::Vec3(0.0f, -1.0f, 0.0f)    // Up = -Y (South), so +Y (North) is at top of texture
         );
 
-        // ENABLE clearing - the ping-pong shader handles accumulation
-        // by reading from previous texture and writing to current
-        // Clearing ensures we start fresh each frame with the shader's output
-        mRTTCamera->setClearMask(GL_COLOR_BUFFER_BIT);
-        mRTTCamera->setClearColor(osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        // NO clearing - the atlas persists between passes
+        // Stamps blend into it, newly allocated slots are cleared by the stamping pass
+        // and the decay pass rewrites every texel of the other ping-pong atlas
+        mRTTCamera->setClearMask(0);
         mRTTCamera->setViewport(0, 0, mTextureResolution, mTextureResolution);
 
         // Start disabled
         mRTTCamera->setNodeMask(0);
 
-        // Add to scene
-        rootNode->addChild(mRTTCamera);
+        // Add to scene, behind a group so that skipped culls do not even create an empty render stage
+        osg::ref_ptr<osg::Group> cullOnceGroup = new osg::Group;
+        cullOnceGroup->setCullingActive(false);
+        cullOnceGroup->addCullCallback(new CullOncePerFrameCallback);
+        cullOnceGroup->addChild(mRTTCamera);
+        rootNode->addChild(cullOnceGroup);
 
         Log(Debug::Info) << "[SNOW] RTT camera created: " << mTextureResolution << "x" << mTextureResolution
                         << " FBO implementation=" << (mRTTCamera->getRenderTargetImplementation() == osg::Camera::FRAME_BUFFER_OBJECT)
@@ -134,26 +185,9 @@ namespace Terrain
         // Create ping-pong textures for accumulation
         for (int i = 0; i < 2; ++i)
         {
-            mDeformationTexture[i] = new osg::Texture2D;
-            mDeformationTexture[i]->setTextureSize(mTextureResolution, mTextureResolution);
-            mDeformationTexture[i]->setInternalFormat(GL_RGBA16F_ARB);
-            mDeformationTexture[i]->setSourceFormat(GL_RGBA);
-            mDeformationTexture[i]->setSourceType(GL_FLOAT);
-            mDeformationTexture[i]->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture2D::LINEAR);
-            mDeformationTexture[i]->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture2D::LINEAR);
-            mDeformationTexture[i]->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mDeformationTexture[i]->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-
-            // CRITICAL FIX: Do NOT set an Image on RTT textures!
-            // RTT textures are GPU-only. Setting an Image prevents RTT from working.
-            // The texture will be initialized by the first clear operation from the RTT camera.
-            //
-            // Previously we were doing:
-            //   mDeformationTexture[i]->setImage(image);
-            // This caused the texture to have a CPU-side image that OSG would never update
-            // from the GPU render target, resulting in 0-byte saves.
-            //
-            // Instead, rely on the RTT camera's clear to initialize to zero.
+            // No image is set, RTT textures are GPU-only and are initialized by the first clear of the RTT camera
+            mDeformationTexture[i]
+                = SceneUtil::createDynamicSurfaceTexture(mTextureResolution, osg::Texture::CLAMP_TO_EDGE);
 
             Log(Debug::Info) << "[SNOW] Created deformation texture " << i
                             << " (" << mTextureResolution << "x" << mTextureResolution << ")";
@@ -161,145 +195,176 @@ namespace Terrain
 
         mCurrentTextureIndex = 0;
 
+        // Page indirection table covering the window around the player
+        // Sampled with NEAREST filtering, entries are rewritten on the CPU when pages move in or out
+        // Addressed toroidally (page coordinate modulo table size), hence the REPEAT wrap mode
+        mPageTableImage = new osg::Image;
+        mPageTableImage->allocateImage(mPageTableSize, mPageTableSize, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        std::fill_n(mPageTableImage->data(), mPageTableImage->getTotalSizeInBytes(), 0);
+
+        mPageTable = new osg::Texture2D(mPageTableImage);
+        mPageTable->setInternalFormat(GL_RGBA8);
+        mPageTable->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture2D::NEAREST);
+        mPageTable->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture2D::NEAREST);
+        mPageTable->setWrap(osg::Texture::WRAP_S, osg::Texture::REPEAT);
+        mPageTable->setWrap(osg::Texture::WRAP_T, osg::Texture::REPEAT);
+        mPageTable->setResizeNonPowerOfTwoHint(false);
+        mPageTable->setUnRefImageDataAfterApply(false);
+
         // Attach first texture to RTT camera
         mRTTCamera->attach(osg::Camera::COLOR_BUFFER, mDeformationTexture[0].get());
 
         Log(Debug::Info) << "[SNOW] Deformation textures created (ping-pong)";
     }
 
+
     void SnowDeformationManager::setupFootprintStamping()
     {
         // Create a group to hold footprint rendering geometry
         mFootprintGroup = new osg::Group;
         mRTTCamera->addChild(mFootprintGroup);
 
-        // Create a full-screen quad for footprint stamping
-        mFootprintQuad = new osg::Geometry;
-        mFootprintQuad->setUseDisplayList(false);
-        mFootprintQuad->setUseVertexBufferObjects(true);
-
-        // Create vertices for a quad covering the texture
-        // CRITICAL: In OpenMW, Z is up, so the ground plane is X-Y
-        // The quad must be in the X-Y plane (at Z=0 in local camera space)
-        // The camera will be positioned at player's altitude, so Z=0 here is correct
-        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
-        vertices->push_back(osg::Vec3(-mWorldTextureRadius, -mWorldTextureRadius, 0.0f));  // Bottom-left
-        vertices->push_back(osg::Vec3( mWorldTextureRadius, -mWorldTextureRadius, 0.0f));  // Bottom-right
-        vertices->push_back(osg::Vec3( mWorldTextureRadius,  mWorldTextureRadius, 0.0f));  // Top-right
-        vertices->push_back(osg::Vec3(-mWorldTextureRadius,  mWorldTextureRadius, 0.0f));  // Top-left
-        mFootprintQuad->setVertexArray(vertices);
-
-        // UV coordinates
-        osg::ref_ptr<osg::Vec2Array> uvs = new osg::Vec2Array;
-        uvs->push_back(osg::Vec2(0.0f, 0.0f));
-        uvs->push_back(osg::Vec2(1.0f, 0.0f));
-        uvs->push_back(osg::Vec2(1.0f, 1.0f));
-        uvs->push_back(osg::Vec2(0.0f, 1.0f));
-        mFootprintQuad->setTexCoordArray(0, uvs);
-
-        // Primitive
-        mFootprintQuad->addPrimitiveSet(new osg::DrawArrays(GL_QUADS, 0, 4));
-
-        // Create state set for footprint rendering
-        mFootprintStateSet = new osg::StateSet;
-
-        // Load and attach shaders for footprint stamping
-        osg::ref_ptr<osg::Program> program = new osg::Program;
-        program->setName("SnowFootprintStamping");
+        // Both passes compute clip space directly instead of going through the RTT camera matrices:
+        // vertices are already atlas positions in NDC, footprint quads additionally carry the world
+        // position they cover so the falloff is evaluated in world space.
+
+        // Slot clears, rebuilt each time pages are restored
+        mSlotClearBatch = new osg::Geometry;
+        mSlotClearBatch->setUseDisplayList(false);
+        mSlotClearBatch->setUseVertexBufferObjects(true);
+        mSlotClearBatch->setDataVariance(osg::Object::DYNAMIC);
+        mSlotClearBatch->setCullingActive(false);
+        mSlotClearBatch->setVertexArray(new osg::Vec3Array);
+        mSlotClearBatchPrimitive = new osg::DrawArrays(GL_QUADS, 0, 0);
+        mSlotClearBatch->addPrimitiveSet(mSlotClearBatchPrimitive);
+
+        osg::ref_ptr<osg::StateSet> clearStateSet = new osg::StateSet;
+        clearStateSet->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+        clearStateSet->setMode(GL_BLEND, osg::StateAttribute::OFF);
+        clearStateSet->setRenderBinDetails(0, "RenderBin");
+
+        osg::ref_ptr<osg::Program> clearProgram = new osg::Program;
+        clearProgram->setName("SnowSlotClear");
+
+        std::string clearVertSource = R"(
+            #version 120
 
-        // Create shaders directly (shader manager integration can come later)
-        osg::ref_ptr<osg::Shader> vertShader = new osg::Shader(osg::Shader::VERTEX);
-        osg::ref_ptr<osg::Shader> fragShader = new osg::Shader(osg::Shader::FRAGMENT);
+            void main()
+            {
+                // Quad is already in clip space
+                gl_Position = vec4(gl_Vertex.xy, 0.0, 1.0);
+            }
+        )";
 
-        // Load shader source from files
-        // For now, we'll use inline shaders to ensure they work
-        std::string vertSource = R"(
+        std::string clearFragSource = R"(
             #version 120
-            varying vec2 texUV;
 
             void main()
             {
-                // Transform vertex through RTT camera's projection/view matrices
-                // The quad covers the entire deformation texture area in world space
-                gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
-
-                // UV coordinates for sampling previous deformation texture
-                texUV = gl_MultiTexCoord0.xy;
+                gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0);
             }
         )";
 
-        std::string fragSource = R"(
+        clearProgram->addShader(new osg::Shader(osg::Shader::VERTEX, clearVertSource));
+        clearProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, clearFragSource));
+        clearStateSet->setAttributeAndModes(clearProgram, osg::StateAttribute::ON);
+        mSlotClearBatch->setStateSet(clearStateSet);
+        mClearTimer = new SnowPassTimer;
+        mSlotClearBatch->setDrawCallback(mClearTimer);
+
+        // Batched footprint quads, rebuilt each time queued footprints are flushed
+        // Per-vertex world position and stamp time are carried in texcoord unit 0, per-footprint data
+        // (center XY, radius, depth) in texcoord unit 1, so the whole batch is a single GL2-compatible draw call
+        mFootprintBatch = new osg::Geometry;
+        mFootprintBatch->setUseDisplayList(false);
+        mFootprintBatch->setUseVertexBufferObjects(true);
+        mFootprintBatch->setDataVariance(osg::Object::DYNAMIC);
+        mFootprintBatch->setCullingActive(false);  // Bounds change every flush
+
+        osg::ref_ptr<osg::Vec3Array> batchVertices = new osg::Vec3Array;
+        batchVertices->reserve(mMaxFootprintsPerBatch * 4);
+        mFootprintBatch->setVertexArray(batchVertices);
+
+        osg::ref_ptr<osg::Vec3Array> batchWorld = new osg::Vec3Array;
+        batchWorld->reserve(mMaxFootprintsPerBatch * 4);
+        mFootprintBatch->setTexCoordArray(0, batchWorld, osg::Array::BIND_PER_VERTEX);
+
+        osg::ref_ptr<osg::Vec4Array> batchParams = new osg::Vec4Array;
+        batchParams->reserve(mMaxFootprintsPerBatch * 4);
+        mFootprintBatch->setTexCoordArray(1, batchParams, osg::Array::BIND_PER_VERTEX);
+
+        mFootprintBatchPrimitive = new osg::DrawArrays(GL_QUADS, 0, 0);
+        mFootprintBatch->addPrimitiveSet(mFootprintBatchPrimitive);
+
+        mFootprintBatchStateSet = new osg::StateSet;
+        mFootprintBatchStateSet->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+        mFootprintBatchStateSet->setRenderBinDetails(1, "RenderBin");  // After the slot clears
+
+        // Keep the deepest deformation and the newest age: newDepth = max(prevDepth, stampDepth)
+        mFootprintBatchStateSet->setAttributeAndModes(new osg::BlendFunc(GL_ONE, GL_ONE), osg::StateAttribute::ON);
+        mFootprintBatchStateSet->setAttributeAndModes(
+            new osg::BlendEquation(osg::BlendEquation::RGBA_MAX), osg::StateAttribute::ON);
+
+        osg::ref_ptr<osg::Program> batchProgram = new osg::Program;
+        batchProgram->setName("SnowFootprintStamping");
+
+        std::string batchVertSource = R"(
             #version 120
-            uniform sampler2D previousDeformation;
-            uniform vec2 deformationCenter;      // World XY center of texture
-            uniform float deformationRadius;     // World radius covered by texture
-            uniform vec2 footprintCenter;        // World XY position of new footprint
-            uniform float footprintRadius;       // World radius of footprint
-            uniform float deformationDepth;      // Maximum depth in world units
-            uniform float currentTime;           // Current game time
-            varying vec2 texUV;
+            varying vec2 worldPos;
+            varying float stampTime;
+            varying vec4 footprint;              // xy = world center, z = radius, w = depth
 
             void main()
             {
-                // Sample previous deformation at this UV
-                vec4 prevDeform = texture2D(previousDeformation, texUV);
-                float prevDepth = prevDeform.r;
-                float prevAge = prevDeform.g;
+                worldPos = gl_MultiTexCoord0.xy;
+                stampTime = gl_MultiTexCoord0.z;
+                footprint = gl_MultiTexCoord1;
 
-                // Convert UV (0-1) to world position
-                // UV (0,0) = bottom-left, UV (1,1) = top-right
-                vec2 worldPos = deformationCenter + (texUV - 0.5) * 2.0 * deformationRadius;
+                // Quad is already placed in its page's atlas slot
+                gl_Position = vec4(gl_Vertex.xy, 0.0, 1.0);
+            }
+        )";
 
-                // Calculate distance from footprint center
-                float dist = length(worldPos - footprintCenter);
+        std::string batchFragSource = R"(
+            #version 120
+            varying vec2 worldPos;
+            varying float stampTime;
+            varying vec4 footprint;
 
-                // Circular falloff: full depth at center, fades to zero at radius
-                float influence = 1.0 - smoothstep(footprintRadius * 0.5, footprintRadius, dist);
+            void main()
+            {
+                float dist = length(worldPos - footprint.xy);
 
-                // Accumulate deformation (keep maximum depth)
-                float newDepth = max(prevDepth, influence * deformationDepth);
+                // Circular falloff: full depth at center, fades to zero at radius
+                float influence = 1.0 - smoothstep(footprint.z * 0.5, footprint.z, dist);
 
-                // Update age where new footprint is stamped
-                float age = (influence > 0.01) ? currentTime : prevAge;
+                // Leave previous depth and age untouched outside the footprint
+                if (influence <= 0.01)
+                    discard;
 
-                gl_FragColor = vec4(newDepth, age, 0.0, 1.0);
+                gl_FragColor = vec4(influence * footprint.w, stampTime, 0.0, 1.0);
             }
         )";
 
-        vertShader->setShaderSource(vertSource);
-        fragShader->setShaderSource(fragSource);
-
-        program->addShader(vertShader);
-        program->addShader(fragShader);
-        mFootprintStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
-
-        // Create uniforms
-        mFootprintStateSet->addUniform(new osg::Uniform("previousDeformation", 0));
-        mFootprintStateSet->addUniform(new osg::Uniform("deformationCenter", mTextureCenter));
-        mFootprintStateSet->addUniform(new osg::Uniform("deformationRadius", mWorldTextureRadius));
-        mFootprintStateSet->addUniform(new osg::Uniform("footprintCenter", osg::Vec2f(0.0f, 0.0f)));
-        mFootprintStateSet->addUniform(new osg::Uniform("footprintRadius", mFootprintRadius));
-        mFootprintStateSet->addUniform(new osg::Uniform("deformationDepth", mDeformationDepth));
-        mFootprintStateSet->addUniform(new osg::Uniform("currentTime", 0.0f));
-
-        // Bind previous deformation texture to unit 0
-        mFootprintStateSet->setTextureAttributeAndModes(0,
-            mDeformationTexture[0].get(), osg::StateAttribute::ON);
+        batchProgram->addShader(new osg::Shader(osg::Shader::VERTEX, batchVertSource));
+        batchProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, batchFragSource));
+        mFootprintBatchStateSet->setAttributeAndModes(batchProgram, osg::StateAttribute::ON);
 
-        mFootprintQuad->setStateSet(mFootprintStateSet);
+        mFootprintBatch->setStateSet(mFootprintBatchStateSet);
+        mStampTimer = new SnowPassTimer;
+        mFootprintBatch->setDrawCallback(mStampTimer);
 
         // Add to geode
         osg::ref_ptr<osg::Geode> geode = new osg::Geode;
-        geode->addDrawable(mFootprintQuad);
+        geode->addDrawable(mSlotClearBatch);
+        geode->addDrawable(mFootprintBatch);
         mFootprintGroup->addChild(geode);
 
         // Disable by default
         mFootprintGroup->setNodeMask(0);
 
-        Log(Debug::Info) << "[SNOW] Footprint stamping setup complete with inline shaders"
-                        << " Quad vertices=" << vertices->size()
-                        << " Quad UVs=" << uvs->size()
-                        << " State set valid=" << (mFootprintStateSet.valid())
+        Log(Debug::Info) << "[SNOW] Footprint stamping setup complete (batched, max "
+                        << mMaxFootprintsPerBatch << " footprints per pass)"
                         << " Footprint group children=" << mFootprintGroup->getNumChildren()
                         << " RTT camera children=" << mRTTCamera->getNumChildren();
     }
@@ -324,18 +389,16 @@ namespace Terrain
             return;
 
         // CRITICAL: Initialize textures on first activation
-        // Since we don't use setImage(), both textures need to be cleared via RTT
-        // This will happen naturally during the first few render frames
+        // Atlas slots are cleared by the stamping pass when a page gets allocated,
+        // unallocated slots are never sampled
         if (!mTexturesInitialized)
         {
-            Log(Debug::Info) << "[SNOW] First activation - textures will be initialized by RTT clear";
+            Log(Debug::Info) << "[SNOW] First activation - atlas slots will be cleared on allocation";
             mTexturesInitialized = true;
         }
 
         // Disable all RTT groups from previous frame (cleanup)
         // Each frame, we'll enable only the one operation we need
-        if (mBlitGroup)
-            mBlitGroup->setNodeMask(0);
         if (mFootprintGroup)
             mFootprintGroup->setNodeMask(0);
         if (mDecayGroup)
@@ -344,28 +407,18 @@ namespace Terrain
         // Update terrain-specific parameters based on current terrain texture
         updateTerrainParameters(playerPos);
 
-        // IMPORTANT: We can only do ONE RTT operation per frame to avoid conflicts
-        // Priority: blit > footprint > decay
+        // Pages are anchored in world space, following the player only moves the page table window
+        updateTextureCenter(playerPos);
 
-        // Check if we need to blit (texture recenter)
-        osg::Vec2f currentCenter(playerPos.x(), playerPos.y());
-        float distanceFromLastBlit = (currentCenter - mLastBlitCenter).length();
-
-        if (distanceFromLastBlit > mBlitThreshold)
+        mTimeSinceResidencyUpdate += dt;
+        if (mTimeSinceResidencyUpdate > 0.25f)
         {
-            // Blit old texture to new position before recentering
-            blitTexture(mTextureCenter, currentCenter);
-            mLastBlitCenter = currentCenter;
-
-            // Update camera position after blit
-            updateCameraPosition(playerPos);
-
-            // Skip footprint and decay this frame - blit has priority
-            return;
+            updateResidency();
+            mTimeSinceResidencyUpdate = 0.0f;
         }
 
-        // Update deformation texture center to follow player (smooth following)
-        updateCameraPosition(playerPos);
+        // IMPORTANT: We can only do ONE RTT operation per frame to avoid conflicts
+        // Priority: footprint (including page restores) > decay
 
         // Check if player has moved enough for a new footprint
         mTimeSinceLastFootprint += dt;
@@ -387,12 +440,25 @@ namespace Terrain
             stampFootprint(playerPos);
             mLastFootprintPos = playerPos;
             mTimeSinceLastFootprint = 0.0f;
+        }
+
+        // Actors that were not tracked this frame went out of range or were unloaded
+        std::erase_if(mActorTracks, [](const auto& entry) { return !entry.second.tracked; });
+        for (auto& [id, track] : mActorTracks)
+            track.tracked = false;
+        mLastActorFootprintCount = mActorFootprintCount;
+        mActorFootprintCount = 0;
+
+        // Render every footprint queued this frame (player and other actors) in one pass
+        if (!mPendingFootprints.empty() || !mRestoreQueue.empty())
+        {
+            flushFootprints();
 
             // Skip decay this frame - footprint has priority
             return;
         }
 
-        // Apply decay periodically (lowest priority)
+        // Apply decay periodically (lowest priority), idle once every page is back to zero
         mTimeSinceLastDecay += dt;
         if (mTimeSinceLastDecay > mDecayUpdateInterval)
         {
@@ -407,7 +473,7 @@ namespace Terrain
             return false;
 
         // Check if player is on snow texture
-        bool onSnow = SnowDetection::hasSnowAtPosition(worldPos, mTerrainStorage, mWorldspace);
+        bool onSnow = mSnowCoverage.hasSnowAt(worldPos, mWorldspace);
 
         // For now, also allow activation if we're in specific test regions
         // TODO: Remove this when hasSnowAtPosition is fully implemented
@@ -427,6 +493,7 @@ namespace Terrain
             if (!enabled)
             {
                 mActive = false;
+                mPendingFootprints.clear();
                 if (mRTTCamera)
                     mRTTCamera->setNodeMask(0);
             }
@@ -435,7 +502,44 @@ namespace Terrain
 
     void SnowDeformationManager::setWorldspace(ESM::RefId worldspace)
     {
+        if (worldspace == mWorldspace)
+            return;
+
+        // Pages are anchored in world space, only their logs are kept for when the player comes back. Restored logs
+        // become resident through the usual restore pass, a few pages around the player at a time.
+        std::map<PageKey, std::vector<StampRecord>>& stored = mStoredPageLogs[mWorldspace];
+        for (auto& [key, page] : mPages)
+            if (!page.stamps.empty())
+                stored[key] = std::move(page.stamps);
+        clearPages();
+        mSnowCoverage.clear();
         mWorldspace = worldspace;
+
+        // Stamps keep decaying while their worldspace is away
+        for (auto worldspaceIt = mStoredPageLogs.begin(); worldspaceIt != mStoredPageLogs.end();)
+        {
+            std::erase_if(worldspaceIt->second, [&](auto& entry) {
+                std::erase_if(
+                    entry.second, [&](const StampRecord& stamp) { return mCurrentTime - stamp.time >= mDecayTime; });
+                return entry.second.empty();
+            });
+            if (worldspaceIt->second.empty())
+                worldspaceIt = mStoredPageLogs.erase(worldspaceIt);
+            else
+                ++worldspaceIt;
+        }
+
+        const auto restored = mStoredPageLogs.find(worldspace);
+        if (restored == mStoredPageLogs.end())
+            return;
+        for (auto& [key, stamps] : restored->second)
+            mPages[key].stamps = std::move(stamps);
+        mStoredPageLogs.erase(restored);
+    }
+
+    void SnowDeformationManager::invalidateSnowCoverage(int cellX, int cellY)
+    {
+        mSnowCoverage.invalidateCell(ESM::ExteriorCellLocation(cellX, cellY, mWorldspace));
     }
 
     osg::Texture2D* SnowDeformationManager::getDeformationTexture() const
@@ -453,90 +557,434 @@ namespace Terrain
         outRadius = mWorldTextureRadius;
     }
 
-    void SnowDeformationManager::updateCameraPosition(const osg::Vec3f& playerPos)
+    void SnowDeformationManager::getPageTableParams(osg::Vec2f& outOrigin, osg::Vec4f& outParams) const
+    {
+        outOrigin = mPageTableOrigin;
+        outParams.set(mPageWorldSize, static_cast<float>(mPageTableSize), static_cast<float>(mPageResolution),
+            static_cast<float>(mTextureResolution));
+    }
+
+    size_t SnowDeformationManager::getResidentPageCount() const
+    {
+        return static_cast<size_t>(mPagesPerRow * mPagesPerRow) - mFreeSlots.size();
+    }
+
+    void SnowDeformationManager::updateTextureCenter(const osg::Vec3f& playerPos)
     {
         // CRITICAL: OpenMW coordinate system
         // X = East/West, Y = North/South, Z = Up/Down (altitude)
         // Texture center should follow player on the GROUND PLANE (X and Y), not altitude (Z)
         mTextureCenter.set(playerPos.x(), playerPos.y());  // Use XY (ground plane)
 
-        static int logCount = 0;
-        if (logCount++ < 3)
+        // Keep the player in the middle of the page table window
+        const PageKey playerPage = getPageKey(mTextureCenter);
+        const osg::Vec2f origin(static_cast<float>(playerPage.first - mPageTableSize / 2),
+            static_cast<float>(playerPage.second - mPageTableSize / 2));
+        if (origin != mPageTableOrigin)
+            scrollPageTable(origin);
+    }
+
+    SnowDeformationManager::PageKey SnowDeformationManager::getPageKey(const osg::Vec2f& worldPos) const
+    {
+        return PageKey(static_cast<int>(std::floor(worldPos.x() / mPageWorldSize)),
+            static_cast<int>(std::floor(worldPos.y() / mPageWorldSize)));
+    }
+
+    float SnowDeformationManager::getPageDistance(const PageKey& key) const
+    {
+        const float minX = key.first * mPageWorldSize;
+        const float minY = key.second * mPageWorldSize;
+        const float dx = std::max({ minX - mTextureCenter.x(), 0.0f, mTextureCenter.x() - (minX + mPageWorldSize) });
+        const float dy = std::max({ minY - mTextureCenter.y(), 0.0f, mTextureCenter.y() - (minY + mPageWorldSize) });
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    bool SnowDeformationManager::allocatePage(const PageKey& key, DeformationPage& page)
+    {
+        if (page.slot >= 0)
+            return true;
+        if (mFreeSlots.empty())
+            return false;
+
+        page.slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        // The page table entry is written once the slot has been cleared and stamped
+        page.needsRestore = true;
+        mRestoreQueue.push_back(key);
+        return true;
+    }
+
+    void SnowDeformationManager::releasePage(DeformationPage& page)
+    {
+        if (page.slot < 0)
+            return;
+
+        mFreeSlots.push_back(page.slot);
+        page.slot = -1;
+        page.needsRestore = false;
+    }
+
+    void SnowDeformationManager::clearPages()
+    {
+        mPages.clear();
+        mRestoreQueue.clear();
+        mFreeSlots.clear();
+        for (int slot = mPagesPerRow * mPagesPerRow - 1; slot >= 0; --slot)
+            mFreeSlots.push_back(slot);
+        rebuildPageTable();
+    }
+
+    void SnowDeformationManager::writePageTableEntry(const PageKey& key, int slot)
+    {
+        if (!mPageTableImage)
+            return;
+
+        const int x = key.first - static_cast<int>(mPageTableOrigin.x());
+        const int y = key.second - static_cast<int>(mPageTableOrigin.y());
+        if (x < 0 || y < 0 || x >= mPageTableSize || y >= mPageTableSize)
+            return;
+
+        // Toroidal addressing: a page always lands on the same entry, whatever the window origin
+        unsigned char* entry = mPageTableImage->data(wrapPageTableIndex(key.first), wrapPageTableIndex(key.second));
+        entry[0] = static_cast<unsigned char>(slot >= 0 ? slot % mPagesPerRow : 0);
+        entry[1] = static_cast<unsigned char>(slot >= 0 ? slot / mPagesPerRow : 0);
+        entry[2] = 0;
+        entry[3] = slot >= 0 ? 255 : 0;
+        mPageTableImage->dirty();
+    }
+
+    int SnowDeformationManager::wrapPageTableIndex(int pageCoord) const
+    {
+        const int index = pageCoord % mPageTableSize;
+        return index < 0 ? index + mPageTableSize : index;
+    }
+
+    void SnowDeformationManager::scrollPageTable(const osg::Vec2f& newOrigin)
+    {
+        const int oldX = static_cast<int>(mPageTableOrigin.x());
+        const int oldY = static_cast<int>(mPageTableOrigin.y());
+        const int newX = static_cast<int>(newOrigin.x());
+        const int newY = static_cast<int>(newOrigin.y());
+        mPageTableOrigin = newOrigin;
+
+        if (!mPageTableImage)
+            return;
+
+        if (std::abs(newX - oldX) >= mPageTableSize || std::abs(newY - oldY) >= mPageTableSize)
+        {
+            rebuildPageTable();
+            return;
+        }
+
+        // Entries that stay inside the window keep their place, only the strips of pages that just
+        // entered the window are cleared; they still hold the pages that left it on the opposite side
+        auto exposed = [&](int x, int y) {
+            return x < oldX || x >= oldX + mPageTableSize || y < oldY || y >= oldY + mPageTableSize;
+        };
+        for (int x = newX; x < newX + mPageTableSize; ++x)
         {
-            Log(Debug::Info) << "[SNOW CAMERA] Player at (" << (int)playerPos.x()
-                            << ", " << (int)playerPos.y() << ", " << (int)playerPos.z() << ")"
-                            << " → TextureCenter=(" << (int)mTextureCenter.x()
-                            << ", " << (int)mTextureCenter.y() << ")"
-                            << " [Using XY ground plane, Z=" << (int)playerPos.z() << " is altitude]";
+            for (int y = newY; y < newY + mPageTableSize; ++y)
+            {
+                if (!exposed(x, y))
+                    continue;
+                unsigned char* entry = mPageTableImage->data(wrapPageTableIndex(x), wrapPageTableIndex(y));
+                std::fill_n(entry, 4, 0);
+            }
+        }
+
+        for (const auto& [key, page] : mPages)
+        {
+            if (page.slot >= 0 && !page.needsRestore && exposed(key.first, key.second))
+                writePageTableEntry(key, page.slot);
         }
+        mPageTableImage->dirty();
+    }
+
+    void SnowDeformationManager::rebuildPageTable()
+    {
+        if (!mPageTableImage)
+            return;
 
-        // Move RTT camera to center over player
-        // Camera looks down from above (Z+) onto the XY ground plane
-        if (mRTTCamera)
+        std::fill_n(mPageTableImage->data(), mPageTableImage->getTotalSizeInBytes(), 0);
+        for (const auto& [key, page] : mPages)
         {
-            mRTTCamera->setViewMatrixAsLookAt(
-                osg::Vec3(playerPos.x(), playerPos.y(), playerPos.z() + 100.0f),  // Eye 100 units above player (Z+ is up)
-                osg::Vec3(playerPos.x(), playerPos.y(), playerPos.z()),            // Look at player position
-                osg::Vec3(0.0f, -1.0f, 0.0f)                                       // Up = -Y (South), matching setupRTT
-            );
+            // Restoring pages are not sampled until their slot is cleared and stamped, see flushFootprints
+            if (page.slot >= 0 && !page.needsRestore)
+                writePageTableEntry(key, page.slot);
         }
+        mPageTableImage->dirty();
+    }
+
+    void SnowDeformationManager::updateResidency()
+    {
+        // Evict with some hysteresis so pages at the boundary don't ping-pong in and out
+        const float evictDistance = mWorldTextureRadius * 1.25f;
+
+        std::vector<std::pair<float, PageKey>> candidates;
+        for (auto it = mPages.begin(); it != mPages.end();)
+        {
+            DeformationPage& page = it->second;
+
+            // Fully decayed stamps are dropped from the log, empty pages are released entirely
+            std::erase_if(page.stamps,
+                [&](const StampRecord& stamp) { return mCurrentTime - stamp.time >= mDecayTime; });
+            if (page.stamps.empty())
+            {
+                if (page.slot >= 0)
+                    writePageTableEntry(it->first, -1);
+                releasePage(page);
+                it = mPages.erase(it);
+                continue;
+            }
+
+            const float distance = getPageDistance(it->first);
+            if (page.slot >= 0 && distance > evictDistance)
+            {
+                // The log keeps the trail, the slot is reused
+                writePageTableEntry(it->first, -1);
+                releasePage(page);
+            }
+            else if (page.slot < 0 && distance <= mWorldTextureRadius)
+                candidates.emplace_back(distance, it->first);
+            ++it;
+        }
+
+        std::erase_if(mRestoreQueue, [&](const PageKey& key) {
+            const auto it = mPages.find(key);
+            return it == mPages.end() || !it->second.needsRestore;
+        });
+
+        // Nearest pages first when the atlas is short on slots
+        std::sort(candidates.begin(), candidates.end());
+        for (const auto& [distance, key] : candidates)
+        {
+            if (!allocatePage(key, mPages[key]))
+                break;
+        }
+    }
+
+    void SnowDeformationManager::appendStampQuad(const PageKey& key, int slot, const StampRecord& stamp)
+    {
+        osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(mFootprintBatch->getVertexArray());
+        osg::Vec3Array* world = static_cast<osg::Vec3Array*>(mFootprintBatch->getTexCoordArray(0));
+        osg::Vec4Array* params = static_cast<osg::Vec4Array*>(mFootprintBatch->getTexCoordArray(1));
+
+        // Texel centers of a slot map to the page edges: texel i sits at i / (resolution - 1) of the page,
+        // so the quad covering the whole slot reaches half a texel beyond the page on every side
+        const float texelWorldSize = mPageWorldSize / (mPageResolution - 1);
+        const float pageMinX = key.first * mPageWorldSize - texelWorldSize * 0.5f;
+        const float pageMinY = key.second * mPageWorldSize - texelWorldSize * 0.5f;
+        const float pageExtent = mPageWorldSize + texelWorldSize;
+
+        const float minX = std::max(stamp.position.x() - stamp.radius, pageMinX);
+        const float maxX = std::min(stamp.position.x() + stamp.radius, pageMinX + pageExtent);
+        const float minY = std::max(stamp.position.y() - stamp.radius, pageMinY);
+        const float maxY = std::min(stamp.position.y() + stamp.radius, pageMinY + pageExtent);
+        if (minX >= maxX || minY >= maxY)
+            return;
+
+        const float slotMinX = static_cast<float>(slot % mPagesPerRow) * mPageResolution;
+        const float slotMinY = static_cast<float>(slot / mPagesPerRow) * mPageResolution;
+        auto toClip = [&](float x, float y) {
+            const float texelX = slotMinX + (x - pageMinX) / pageExtent * mPageResolution;
+            const float texelY = slotMinY + (y - pageMinY) / pageExtent * mPageResolution;
+            return osg::Vec3(texelX / mTextureResolution * 2.0f - 1.0f, texelY / mTextureResolution * 2.0f - 1.0f,
+                0.0f);
+        };
+
+        const osg::Vec4f param(stamp.position.x(), stamp.position.y(), stamp.radius, stamp.depth);
+        const osg::Vec2f corners[4] = { { minX, minY }, { maxX, minY }, { maxX, maxY }, { minX, maxY } };
+        for (const osg::Vec2f& corner : corners)
+        {
+            vertices->push_back(toClip(corner.x(), corner.y()));
+            world->push_back(osg::Vec3(corner.x(), corner.y(), stamp.time));
+            params->push_back(param);
+        }
+    }
+
+    void SnowDeformationManager::appendClearQuad(int slot)
+    {
+        osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(mSlotClearBatch->getVertexArray());
+
+        const float size = 2.0f * mPageResolution / mTextureResolution;
+        const float minX = (slot % mPagesPerRow) * size - 1.0f;
+        const float minY = (slot / mPagesPerRow) * size - 1.0f;
+        vertices->push_back(osg::Vec3(minX, minY, 0.0f));
+        vertices->push_back(osg::Vec3(minX + size, minY, 0.0f));
+        vertices->push_back(osg::Vec3(minX + size, minY + size, 0.0f));
+        vertices->push_back(osg::Vec3(minX, minY + size, 0.0f));
     }
 
     void SnowDeformationManager::stampFootprint(const osg::Vec3f& position)
     {
-        if (!mFootprintStateSet || !mRTTCamera)
+        queueFootprint(position, mFootprintRadius, mDeformationDepth);
+    }
+
+    void SnowDeformationManager::queueFootprint(const osg::Vec3f& position, float radius, float depth)
+    {
+        if (!mEnabled || radius <= 0.0f || depth <= 0.0f)
             return;
 
-        Log(Debug::Info) << "[SNOW] Stamping footprint at "
-                        << (int)position.x() << ", " << (int)position.y()
-                        << " with depth=" << mDeformationDepth
-                        << ", radius=" << mFootprintRadius;
+        // Footprints outside the page table window would never be sampled before decaying
+        osg::Vec2f pos2D(position.x(), position.y());
+        osg::Vec2f offset = pos2D - mTextureCenter;
+        float reach = mPageTableSize * mPageWorldSize * 0.5f + radius;
+        if (std::abs(offset.x()) > reach || std::abs(offset.y()) > reach)
+            return;
 
-        // Swap ping-pong buffers
-        int prevIndex = mCurrentTextureIndex;
-        mCurrentTextureIndex = 1 - mCurrentTextureIndex;
+        // When over budget, drop the oldest footprints; the newest ones matter most visually
+        if (mPendingFootprints.size() >= mMaxFootprintsPerBatch)
+            mPendingFootprints.erase(mPendingFootprints.begin());
 
-        // Bind previous texture as input (texture unit 0)
-        mFootprintStateSet->setTextureAttributeAndModes(0,
-            mDeformationTexture[prevIndex].get(),
-            osg::StateAttribute::ON);
+        mPendingFootprints.push_back({ pos2D, radius, depth });
+    }
+
+    float SnowDeformationManager::getDeformationDepthAt(const osg::Vec3f& worldPos) const
+    {
+        if (!mEnabled)
+            return 0.0f;
+
+        const osg::Vec2f pos2D(worldPos.x(), worldPos.y());
+        // Every page logs all the footprints overlapping it
+        const auto it = mPages.find(getPageKey(pos2D));
+        if (it == mPages.end())
+            return 0.0f;
+
+        float result = 0.0f;
+        for (const StampRecord& stamp : it->second.stamps)
+        {
+            const float distance = (pos2D - stamp.position).length();
+            if (distance >= stamp.radius)
+                continue;
+            // Same as 1.0 - smoothstep(radius * 0.5, radius, distance) in snow_footprint.frag
+            const float t = std::clamp((distance - stamp.radius * 0.5f) / (stamp.radius * 0.5f), 0.0f, 1.0f);
+            const float influence = 1.0f - t * t * (3.0f - 2.0f * t);
+            const float decay = std::max(0.0f, 1.0f - (mCurrentTime - stamp.time) / mDecayTime);
+            result = std::max(result, influence * stamp.depth * decay);
+        }
+        // The decay shader zeroes out depths below this
+        return result < 0.01f ? 0.0f : result;
+    }
 
-        // Attach current texture as render target
+    void SnowDeformationManager::trackActor(std::uintptr_t actorId, const osg::Vec3f& position)
+    {
+        if (!mEnabled || !mActive)
+            return;
+
+        const osg::Vec2f offset = osg::Vec2f(position.x(), position.y()) - mTextureCenter;
+        if (offset.length2() > mWorldTextureRadius * mWorldTextureRadius)
+            return;
+
+        const auto [it, inserted] = mActorTracks.try_emplace(actorId, ActorTrack{ position });
+        ActorTrack& track = it->second;
+        track.tracked = true;
+        // Unlike the player, actors standing still don't refresh their footprint
+        if (!inserted && (position - track.lastFootprintPos).length2() <= mFootprintInterval * mFootprintInterval)
+            return;
+        if (mActorFootprintCount >= mMaxActorFootprintsPerFrame || !hasSnowAt(position))
+            return;
+
+        queueFootprint(position, mFootprintRadius, mDeformationDepth);
+        track.lastFootprintPos = position;
+        ++mActorFootprintCount;
+    }
+
+    void SnowDeformationManager::flushFootprints()
+    {
+        if (!mFootprintBatchStateSet || !mRTTCamera)
+            return;
+
+        // Stamps blend into the current atlas, no ping-pong swap is needed
         mRTTCamera->detach(osg::Camera::COLOR_BUFFER);
         mRTTCamera->attach(osg::Camera::COLOR_BUFFER,
             mDeformationTexture[mCurrentTextureIndex].get());
 
-        // Update shader uniforms (IMPORTANT: update terrain-specific parameters!)
-        osg::Uniform* footprintCenterUniform = mFootprintStateSet->getUniform("footprintCenter");
-        if (footprintCenterUniform)
-            footprintCenterUniform->set(osg::Vec2f(position.x(), position.y()));
-
-        osg::Uniform* deformationCenterUniform = mFootprintStateSet->getUniform("deformationCenter");
-        if (deformationCenterUniform)
-            deformationCenterUniform->set(mTextureCenter);
-
-        osg::Uniform* currentTimeUniform = mFootprintStateSet->getUniform("currentTime");
-        if (currentTimeUniform)
-            currentTimeUniform->set(mCurrentTime);
+        osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(mFootprintBatch->getVertexArray());
+        osg::Vec3Array* world = static_cast<osg::Vec3Array*>(mFootprintBatch->getTexCoordArray(0));
+        osg::Vec4Array* params = static_cast<osg::Vec4Array*>(mFootprintBatch->getTexCoordArray(1));
+        osg::Vec3Array* clearVertices = static_cast<osg::Vec3Array*>(mSlotClearBatch->getVertexArray());
+        vertices->clear();
+        world->clear();
+        params->clear();
+        clearVertices->clear();
+
+        // Log every footprint into the pages it overlaps, draw it into the resident ones
+        for (const PendingFootprint& footprint : mPendingFootprints)
+        {
+            const StampRecord stamp{ footprint.position, footprint.radius, footprint.depth, mCurrentTime };
+            const PageKey minPage = getPageKey(footprint.position - osg::Vec2f(footprint.radius, footprint.radius));
+            const PageKey maxPage = getPageKey(footprint.position + osg::Vec2f(footprint.radius, footprint.radius));
+            for (int x = minPage.first; x <= maxPage.first; ++x)
+            {
+                for (int y = minPage.second; y <= maxPage.second; ++y)
+                {
+                    const PageKey key(x, y);
+                    DeformationPage& page = mPages[key];
+                    if (page.stamps.size() >= mMaxStampsPerPage)
+                        page.stamps.erase(page.stamps.begin());
+                    page.stamps.push_back(stamp);
 
-        // UPDATE terrain-specific parameters that may have changed
-        osg::Uniform* deformationDepthUniform = mFootprintStateSet->getUniform("deformationDepth");
-        if (deformationDepthUniform)
-            deformationDepthUniform->set(mDeformationDepth);
+                    if (page.slot < 0 && getPageDistance(key) <= mWorldTextureRadius)
+                        allocatePage(key, page);
 
-        osg::Uniform* footprintRadiusUniform = mFootprintStateSet->getUniform("footprintRadius");
-        if (footprintRadiusUniform)
-            footprintRadiusUniform->set(mFootprintRadius);
+                    // Restoring pages stamp their whole log below
+                    if (page.slot >= 0 && !page.needsRestore)
+                    {
+                        appendStampQuad(key, page.slot, stamp);
+                        notePageStamp(page, stamp);
+                    }
+                }
+            }
+        }
 
-        // Enable RTT rendering to stamp footprint
+        // Newly resident pages: clear the slot, then stamp the log again
+        // Logged stamps are scaled by the decay they went through while the page was evicted
+        for (const PageKey& key : mRestoreQueue)
+        {
+            DeformationPage& page = mPages[key];
+            if (page.slot < 0 || !page.needsRestore)
+                continue;
+
+            appendClearQuad(page.slot);
+            page.peakDepth = 0.0f;
+            page.lastStampTime = 0.0f;
+            page.zeroWrites = 0;
+            for (StampRecord stamp : page.stamps)
+            {
+                stamp.depth *= std::max(0.0f, 1.0f - (mCurrentTime - stamp.time) / mDecayTime);
+                appendStampQuad(key, page.slot, stamp);
+                notePageStamp(page, stamp);
+            }
+            page.needsRestore = false;
+            writePageTableEntry(key, page.slot);
+        }
+        const size_t restoredPages = mRestoreQueue.size();
+        mRestoreQueue.clear();
+
+        vertices->dirty();
+        world->dirty();
+        params->dirty();
+        clearVertices->dirty();
+        mFootprintBatchPrimitive->setCount(static_cast<GLsizei>(vertices->size()));
+        mSlotClearBatchPrimitive->setCount(static_cast<GLsizei>(clearVertices->size()));
+        mFootprintBatch->dirtyBound();
+        mSlotClearBatch->dirtyBound();
+
+        // Enable RTT rendering to stamp footprints
         mRTTCamera->setNodeMask(~0u);
         mFootprintGroup->setNodeMask(~0u);
 
+        const size_t batchSize = mPendingFootprints.size();
+        mPendingFootprints.clear();
+
         // DIAGNOSTIC: Save texture after first few footprints to verify RTT is working
         static int stampCount = 0;
         stampCount++;
 
-        Log(Debug::Info) << "[SNOW] Footprint stamped, count=" << stampCount
+        Log(Debug::Info) << "[SNOW] Footprint batch stamped, count=" << stampCount
+                        << " footprints=" << batchSize
+                        << " restored pages=" << restoredPages
+                        << " resident pages=" << getResidentPageCount() << "/" << mPages.size()
                         << " RTT camera enabled=" << (mRTTCamera->getNodeMask() != 0)
                         << " Footprint group enabled=" << (mFootprintGroup->getNodeMask() != 0)
                         << " Current texture index=" << mCurrentTextureIndex;
@@ -625,97 +1073,6 @@ namespace Terrain
         }
     }
 
-    void SnowDeformationManager::setupBlitSystem()
-    {
-        // Create blit group and quad for texture scrolling
-        mBlitGroup = new osg::Group;
-        mRTTCamera->addChild(mBlitGroup);
-
-        mBlitQuad = new osg::Geometry;
-        mBlitQuad->setUseDisplayList(false);
-        mBlitQuad->setUseVertexBufferObjects(true);
-
-        // Full-screen quad in X-Y plane (Z is up in OpenMW)
-        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
-        vertices->push_back(osg::Vec3(-mWorldTextureRadius, -mWorldTextureRadius, 0.0f));
-        vertices->push_back(osg::Vec3( mWorldTextureRadius, -mWorldTextureRadius, 0.0f));
-        vertices->push_back(osg::Vec3( mWorldTextureRadius,  mWorldTextureRadius, 0.0f));
-        vertices->push_back(osg::Vec3(-mWorldTextureRadius,  mWorldTextureRadius, 0.0f));
-        mBlitQuad->setVertexArray(vertices);
-
-        osg::ref_ptr<osg::Vec2Array> uvs = new osg::Vec2Array;
-        uvs->push_back(osg::Vec2(0.0f, 0.0f));
-        uvs->push_back(osg::Vec2(1.0f, 0.0f));
-        uvs->push_back(osg::Vec2(1.0f, 1.0f));
-        uvs->push_back(osg::Vec2(0.0f, 1.0f));
-        mBlitQuad->setTexCoordArray(0, uvs);
-
-        mBlitQuad->addPrimitiveSet(new osg::DrawArrays(GL_QUADS, 0, 4));
-
-        // Create blit shader
-        mBlitStateSet = new osg::StateSet;
-        osg::ref_ptr<osg::Program> program = new osg::Program;
-
-        std::string vertSource = R"(
-            #version 120
-            varying vec2 texUV;
-            void main()
-            {
-                gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
-                texUV = gl_MultiTexCoord0.xy;
-            }
-        )";
-
-        std::string fragSource = R"(
-            #version 120
-            uniform sampler2D sourceTexture;
-            uniform vec2 oldCenter;
-            uniform vec2 newCenter;
-            uniform float textureRadius;
-            varying vec2 texUV;
-
-            void main()
-            {
-                // Calculate world position for this UV in the NEW coordinate system
-                vec2 worldPos = newCenter + (texUV - 0.5) * 2.0 * textureRadius;
-
-                // Calculate UV in the OLD coordinate system
-                vec2 oldUV = ((worldPos - oldCenter) / textureRadius) * 0.5 + 0.5;
-
-                // Sample from old texture if UV is valid, otherwise zero
-                if (oldUV.x >= 0.0 && oldUV.x <= 1.0 && oldUV.y >= 0.0 && oldUV.y <= 1.0)
-                {
-                    gl_FragColor = texture2D(sourceTexture, oldUV);
-                }
-                else
-                {
-                    gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0);  // No deformation
-                }
-            }
-        )";
-
-        osg::ref_ptr<osg::Shader> vertShader = new osg::Shader(osg::Shader::VERTEX, vertSource);
-        osg::ref_ptr<osg::Shader> fragShader = new osg::Shader(osg::Shader::FRAGMENT, fragSource);
-        program->addShader(vertShader);
-        program->addShader(fragShader);
-        mBlitStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
-
-        mBlitStateSet->addUniform(new osg::Uniform("sourceTexture", 0));
-        mBlitStateSet->addUniform(new osg::Uniform("oldCenter", osg::Vec2f(0.0f, 0.0f)));
-        mBlitStateSet->addUniform(new osg::Uniform("newCenter", osg::Vec2f(0.0f, 0.0f)));
-        mBlitStateSet->addUniform(new osg::Uniform("textureRadius", mWorldTextureRadius));
-
-        mBlitQuad->setStateSet(mBlitStateSet);
-
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode;
-        geode->addDrawable(mBlitQuad);
-        mBlitGroup->addChild(geode);
-
-        // Start disabled
-        mBlitGroup->setNodeMask(0);
-
-        Log(Debug::Info) << "[SNOW] Blit system setup complete";
-    }
 
     void SnowDeformationManager::setupDecaySystem()
     {
@@ -727,22 +1084,14 @@ namespace Terrain
         mDecayQuad->setUseDisplayList(false);
         mDecayQuad->setUseVertexBufferObjects(true);
 
-        // Full-screen quad in X-Y plane (Z is up in OpenMW)
-        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
-        vertices->push_back(osg::Vec3(-mWorldTextureRadius, -mWorldTextureRadius, 0.0f));
-        vertices->push_back(osg::Vec3( mWorldTextureRadius, -mWorldTextureRadius, 0.0f));
-        vertices->push_back(osg::Vec3( mWorldTextureRadius,  mWorldTextureRadius, 0.0f));
-        vertices->push_back(osg::Vec3(-mWorldTextureRadius,  mWorldTextureRadius, 0.0f));
-        mDecayQuad->setVertexArray(vertices);
+        // Rebuilt for every pass: only slots of pages that still hold deformation are processed
+        mDecayQuad->setDataVariance(osg::Object::DYNAMIC);
+        mDecayQuad->setCullingActive(false);
+        mDecayQuad->setVertexArray(new osg::Vec3Array);
+        mDecayQuad->setTexCoordArray(0, new osg::Vec2Array, osg::Array::BIND_PER_VERTEX);
 
-        osg::ref_ptr<osg::Vec2Array> uvs = new osg::Vec2Array;
-        uvs->push_back(osg::Vec2(0.0f, 0.0f));
-        uvs->push_back(osg::Vec2(1.0f, 0.0f));
-        uvs->push_back(osg::Vec2(1.0f, 1.0f));
-        uvs->push_back(osg::Vec2(0.0f, 1.0f));
-        mDecayQuad->setTexCoordArray(0, uvs);
-
-        mDecayQuad->addPrimitiveSet(new osg::DrawArrays(GL_QUADS, 0, 4));
+        mDecayPrimitive = new osg::DrawArrays(GL_QUADS, 0, 0);
+        mDecayQuad->addPrimitiveSet(mDecayPrimitive);
 
         // Create decay shader
         mDecayStateSet = new osg::StateSet;
@@ -753,7 +1102,8 @@ namespace Terrain
             varying vec2 texUV;
             void main()
             {
-                gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+                // Quad is already in clip space
+                gl_Position = vec4(gl_Vertex.xy, 0.0, 1.0);
                 texUV = gl_MultiTexCoord0.xy;
             }
         )";
@@ -800,6 +1150,8 @@ namespace Terrain
         mDecayStateSet->addUniform(new osg::Uniform("decayTime", mDecayTime));
 
         mDecayQuad->setStateSet(mDecayStateSet);
+        mDecayTimer = new SnowPassTimer;
+        mDecayQuad->setDrawCallback(mDecayTimer);
 
         osg::ref_ptr<osg::Geode> geode = new osg::Geode;
         geode->addDrawable(mDecayQuad);
@@ -811,48 +1163,63 @@ namespace Terrain
         Log(Debug::Info) << "[SNOW] Decay system setup complete (decay time: " << mDecayTime << "s)";
     }
 
-    void SnowDeformationManager::blitTexture(const osg::Vec2f& oldCenter, const osg::Vec2f& newCenter)
+    bool SnowDeformationManager::pageNeedsDecay(const DeformationPage& page) const
     {
-        if (!mBlitStateSet || !mRTTCamera)
-            return;
-
-        Log(Debug::Info) << "[SNOW] Blitting texture from (" << (int)oldCenter.x() << ", " << (int)oldCenter.y()
-                        << ") to (" << (int)newCenter.x() << ", " << (int)newCenter.y() << ")";
-
-        // Swap ping-pong buffers
-        int sourceIndex = mCurrentTextureIndex;
-        mCurrentTextureIndex = 1 - mCurrentTextureIndex;
+        // A page back to zero must still be written once into each ping-pong atlas
+        return page.slot >= 0 && !page.needsRestore && (page.peakDepth > 0.0f || page.zeroWrites < 2);
+    }
 
-        // Bind source texture
-        mBlitStateSet->setTextureAttributeAndModes(0,
-            mDeformationTexture[sourceIndex].get(),
-            osg::StateAttribute::ON);
+    void SnowDeformationManager::notePageStamp(DeformationPage& page, const StampRecord& stamp)
+    {
+        page.peakDepth = std::max(page.peakDepth, stamp.depth);
+        page.lastStampTime = std::max(page.lastStampTime, stamp.time);
+        page.zeroWrites = 0;
+    }
 
-        // Attach destination texture as render target
-        mRTTCamera->detach(osg::Camera::COLOR_BUFFER);
-        mRTTCamera->attach(osg::Camera::COLOR_BUFFER,
-            mDeformationTexture[mCurrentTextureIndex].get());
+    bool SnowDeformationManager::applyDecay(float dt)
+    {
+        if (!mDecayStateSet || !mRTTCamera)
+            return false;
 
-        // Update shader uniforms
-        osg::Uniform* oldCenterUniform = mBlitStateSet->getUniform("oldCenter");
-        if (oldCenterUniform)
-            oldCenterUniform->set(oldCenter);
+        osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(mDecayQuad->getVertexArray());
+        osg::Vec2Array* uvs = static_cast<osg::Vec2Array*>(mDecayQuad->getTexCoordArray(0));
+        vertices->clear();
+        uvs->clear();
 
-        osg::Uniform* newCenterUniform = mBlitStateSet->getUniform("newCenter");
-        if (newCenterUniform)
-            newCenterUniform->set(newCenter);
+        const float size = 2.0f * mPageResolution / mTextureResolution;
+        for (auto& [key, page] : mPages)
+        {
+            if (!pageNeedsDecay(page))
+                continue;
+
+            const float minX = (page.slot % mPagesPerRow) * size - 1.0f;
+            const float minY = (page.slot / mPagesPerRow) * size - 1.0f;
+            const osg::Vec2f corners[4]
+                = { { minX, minY }, { minX + size, minY }, { minX + size, minY + size }, { minX, minY + size } };
+            for (const osg::Vec2f& corner : corners)
+            {
+                vertices->push_back(osg::Vec3(corner, 0.0f));
+                uvs->push_back((corner + osg::Vec2f(1.0f, 1.0f)) * 0.5f);
+            }
 
-        // Enable blit rendering for this frame
-        mBlitGroup->setNodeMask(~0u);
-        mRTTCamera->setNodeMask(~0u);
+            // Same factor the shader applies to the newest, slowest decaying texels, and the same cutoff
+            const float decayFactor = std::clamp((mCurrentTime - page.lastStampTime) / mDecayTime, 0.0f, 1.0f);
+            page.peakDepth *= 1.0f - decayFactor;
+            if (page.peakDepth < 0.01f)
+            {
+                page.peakDepth = 0.0f;
+                ++page.zeroWrites;
+            }
+        }
 
-        // Other groups already disabled at start of update()
-    }
+        // Everything is back to zero, the decay pass stops until something is stamped again
+        if (vertices->empty())
+            return false;
 
-    void SnowDeformationManager::applyDecay(float dt)
-    {
-        if (!mDecayStateSet || !mRTTCamera)
-            return;
+        vertices->dirty();
+        uvs->dirty();
+        mDecayPrimitive->setCount(static_cast<GLsizei>(vertices->size()));
+        mDecayQuad->dirtyBound();
 
         // Swap ping-pong buffers
         int sourceIndex = mCurrentTextureIndex;
@@ -882,14 +1249,17 @@ namespace Terrain
         static int logCount = 0;
         if (logCount++ < 5)
         {
-            Log(Debug::Info) << "[SNOW] Applying decay at time " << mCurrentTime;
+            Log(Debug::Info) << "[SNOW] Applying decay at time " << mCurrentTime << " over "
+                             << vertices->size() / 4 << " pages";
         }
+        return true;
     }
 
     void SnowDeformationManager::updateTerrainParameters(const osg::Vec3f& playerPos)
     {
-        // Detect terrain texture at player position
-        std::string terrainType = detectTerrainTexture(playerPos);
+        // Detect terrain texture at player position, its parameters are matched only the first time it is seen
+        const std::string_view terrainTexture = detectTerrainTexture(playerPos);
+        const std::size_t terrainType = mTerrainTypes.getType(terrainTexture);
 
         // Only update if terrain type changed
         if (terrainType == mCurrentTerrainType)
@@ -897,28 +1267,23 @@ namespace Terrain
 
         mCurrentTerrainType = terrainType;
 
-        // Find matching parameters
-        for (const auto& params : mTerrainParams)
+        if (terrainType == TerrainTypeTable::sNoType)
         {
-            if (terrainType.find(params.pattern) != std::string::npos)
-            {
-                mFootprintRadius = params.radius;
-                mDeformationDepth = params.depth;
-                mFootprintInterval = params.interval;
-
-                Log(Debug::Info) << "[SNOW] Terrain type changed to '" << terrainType
-                                << "' - radius=" << params.radius
-                                << ", depth=" << params.depth
-                                << ", interval=" << params.interval;
-                return;
-            }
+            // Keep the current parameters if no match
+            Log(Debug::Info) << "[SNOW] Unknown terrain type '" << terrainTexture << "', keeping current parameters";
+            return;
         }
 
-        // Default to snow parameters if no match
-        Log(Debug::Info) << "[SNOW] Unknown terrain type '" << terrainType << "', using snow defaults";
+        const TerrainParams& params = mTerrainParams[terrainType];
+        mFootprintRadius = params.radius;
+        mDeformationDepth = params.depth;
+        mFootprintInterval = params.interval;
+
+        Log(Debug::Info) << "[SNOW] Terrain type changed to '" << terrainTexture << "' - radius=" << params.radius
+                         << ", depth=" << params.depth << ", interval=" << params.interval;
     }
 
-    std::string SnowDeformationManager::detectTerrainTexture(const osg::Vec3f& worldPos)
+    std::string_view SnowDeformationManager::detectTerrainTexture(const osg::Vec3f& worldPos)
     {
         // TODO: Implement actual terrain texture detection by querying terrain storage
         // For now, return snow for testing
@@ -938,4 +1303,35 @@ namespace Terrain
         outDepth = mDeformationDepth;
         outInterval = mFootprintInterval;
     }
+
+    void SnowDeformationManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
+    {
+        stats->setAttribute(frameNumber, "Snow Pages", static_cast<double>(mPages.size()));
+        stats->setAttribute(frameNumber, "Snow Resident Pages", static_cast<double>(getResidentPageCount()));
+        stats->setAttribute(frameNumber, "Snow Actor Footprints", static_cast<double>(mLastActorFootprintCount));
+        if (mStampTimer)
+            stats->setAttribute(frameNumber, "Snow Stamp GPU", mStampTimer->getLastTimeMs());
+        if (mClearTimer)
+            stats->setAttribute(frameNumber, "Snow Clear GPU", mClearTimer->getLastTimeMs());
+        if (mDecayTimer)
+            stats->setAttribute(frameNumber, "Snow Decay GPU", mDecayTimer->getLastTimeMs());
+    }
+
+    Resource::MemoryUsage SnowDeformationManager::getMemoryUsage() const
+    {
+        Resource::MemoryUsage result;
+        for (const auto& [key, page] : mPages)
+            result.mCpu += sizeof(key) + sizeof(page) + page.stamps.capacity() * sizeof(StampRecord);
+        // Ping-pong RGBA16F atlases
+        const std::size_t atlasTexels = static_cast<std::size_t>(mTextureResolution) * mTextureResolution;
+        for (const osg::ref_ptr<osg::Texture2D>& texture : mDeformationTexture)
+            if (texture != nullptr)
+                result.mGpu += atlasTexels * 4 * sizeof(std::uint16_t);
+        if (mPageTableImage != nullptr)
+        {
+            result.mCpu += mPageTableImage->getTotalSizeInBytes();
+            result.mGpu += mPageTableImage->getTotalSizeInBytes();
+        }
+        return result;
+    }
 }
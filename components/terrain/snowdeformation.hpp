@@ -5,10 +5,26 @@
 #include <osg/Texture2D>
 #include <osg/Group>
 #include <osg/Geometry>
+#include <osg/Image>
 #include <osg/Vec3f>
 #include <osg/Vec2f>
+#include <osg/Vec4f>
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <components/esm/refid.hpp>
+#include <components/resource/memoryregistry.hpp>
+
+#include "snowdetection.hpp"
+
+namespace osg
+{
+    class Stats;
+}
 
 namespace Resource
 {
@@ -17,10 +33,16 @@ namespace Resource
 
 namespace Terrain
 {
+    class SnowPassTimer;
     class Storage;
 
     /// Manages the snow deformation system
     /// Handles RTT, footprint stamping, and deformation texture management
+    ///
+    /// Deformation is stored in world-anchored pages. Resident pages live in slots of a fixed size atlas texture,
+    /// located through a small indirection table that the terrain shader samples. Every page also keeps a compact
+    /// log of the footprints stamped into it, so pages far from the player can be evicted and later restored by
+    /// stamping the log again. Recentering never copies texture data.
     class SnowDeformationManager
     {
     public:
@@ -41,6 +63,14 @@ namespace Terrain
         /// @return True if player is on snow texture
         bool shouldBeActive(const osg::Vec3f& worldPos);
 
+        /// Check if a position is on snow, using the cached per-cell coverage grids
+        /// Cheap enough to call for every actor each frame
+        bool hasSnowAt(const osg::Vec3f& worldPos) { return mSnowCoverage.hasSnowAt(worldPos, mWorldspace); }
+
+        /// Drop cached snow coverage, call when land data changes
+        void invalidateSnowCoverage(int cellX, int cellY);
+        void clearSnowCoverage() { mSnowCoverage.clear(); }
+
         /// Enable/disable the deformation system
         void setEnabled(bool enabled);
         bool isEnabled() const { return mEnabled; }
@@ -48,72 +78,194 @@ namespace Terrain
         /// Set current worldspace
         void setWorldspace(ESM::RefId worldspace);
 
-        /// Get the current deformation texture for terrain shaders
+        /// Get the current deformation page atlas for terrain shaders
         /// @return Texture containing deformation data, or nullptr if inactive
         osg::Texture2D* getDeformationTexture() const;
 
+        /// Get the page indirection table for terrain shaders
+        osg::Texture2D* getPageTableTexture() const { return mPageTable.get(); }
+
         /// Get deformation texture parameters for shader
-        /// @param outCenter World-space center of deformation texture
-        /// @param outRadius World-space radius covered by texture
+        /// @param outCenter World-space center of the deforming area (follows the player)
+        /// @param outRadius World-space radius around the center where pages are kept resident
         void getDeformationTextureParams(osg::Vec2f& outCenter, float& outRadius) const;
 
+        /// Get page table parameters for shader
+        /// @param outOrigin World page coordinates of the first page table entry
+        /// @param outParams x = page world size, y = page table size in pages, z = page resolution,
+        /// w = atlas resolution
+        void getPageTableParams(osg::Vec2f& outOrigin, osg::Vec4f& outParams) const;
+
+        /// Get number of pages with deformation data, resident or not
+        size_t getPageCount() const { return mPages.size(); }
+
+        /// Get number of pages currently occupying an atlas slot
+        size_t getResidentPageCount() const;
+
         /// Stamp a footprint at the current player position
+        /// Uses the deformation parameters of the current terrain type
         void stampFootprint(const osg::Vec3f& position);
 
+        /// Queue a footprint for this frame's batched stamping pass
+        /// Any actor (player, NPC, creature, projectile) may call this; all queued
+        /// footprints are rendered with a single draw and a single ping-pong swap
+        /// @param position World position of the footprint
+        /// @param radius Footprint radius in world units
+        /// @param depth Deformation depth in world units
+        void queueFootprint(const osg::Vec3f& position, float radius, float depth);
+
+        /// Stamp footprints of an actor other than the player while it walks on snow
+        /// Call every frame before update for each actor to track, actors not tracked for a frame are forgotten.
+        /// Only actors within the deformation radius are stamped, at most "snow max actor footprints per frame"
+        /// of them each frame; the others keep their last footprint position and stamp on a later frame.
+        /// @param actorId Any value telling actors apart, stable while the actor is tracked
+        void trackActor(std::uintptr_t actorId, const osg::Vec3f& position);
+
+        /// Get number of footprints waiting for the next stamping pass
+        size_t getPendingFootprintCount() const { return mPendingFootprints.size(); }
+
+        /// Get how deep the snow is pressed down at a position, in world units
+        /// Evaluated on the CPU from the page stamp logs with the footprint falloff and linear decay of the shaders,
+        /// so it never waits for the GPU and also covers pages that are not resident. Stamps dropped from a full log
+        /// are missing, and overlapping stamps decay separately instead of from the newest one as on the GPU.
+        float getDeformationDepthAt(const osg::Vec3f& worldPos) const;
+
         /// Get current deformation parameters (may vary by terrain texture)
         void getDeformationParams(float& outRadius, float& outDepth, float& outInterval) const;
 
+        /// Report page counts and GPU timings of the stamp, clear and decay passes
+        void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
+
+        /// Estimate memory of the page stamp logs, the atlases and the page table
+        Resource::MemoryUsage getMemoryUsage() const;
+
     private:
+        using PageKey = std::pair<int, int>;
+
+        /// Footprint as recorded in a page log
+        struct StampRecord
+        {
+            osg::Vec2f position;
+            float radius;
+            float depth;
+            float time;
+        };
+
+        struct DeformationPage
+        {
+            int slot = -1;               // Atlas slot, -1 if not resident
+            bool needsRestore = false;   // Slot was just allocated, clear it and stamp the log again
+            std::vector<StampRecord> stamps;
+
+            // Upper bound of the depth left in the slot, mirroring the decay shader on the CPU
+            float peakDepth = 0.0f;
+            float lastStampTime = 0.0f;
+            int zeroWrites = 0;          // Decay passes since the page is back to zero, one per ping-pong atlas
+        };
+
         /// Initialize RTT camera and deformation textures
         void setupRTT(osg::Group* rootNode);
 
-        /// Create ping-pong deformation textures
+        /// Create ping-pong deformation atlases and the page indirection table
         void createDeformationTextures();
 
         /// Create footprint stamping geometry and shaders
         void setupFootprintStamping();
 
-        /// Setup blit system for texture scrolling
-        void setupBlitSystem();
-
         /// Setup decay system for gradual snow restoration
         void setupDecaySystem();
 
-        /// Update RTT camera position to follow player
-        void updateCameraPosition(const osg::Vec3f& playerPos);
+        /// Move the deforming area and page table window to follow the player
+        void updateTextureCenter(const osg::Vec3f& playerPos);
+
+        /// Evict pages that left the residency radius, make logged pages that entered it resident,
+        /// and drop log entries that fully decayed
+        void updateResidency();
 
-        /// Render a footprint into the deformation texture
-        void renderFootprint(const osg::Vec3f& worldPos);
+        /// Render all queued footprints and page restores into the deformation atlas in one pass
+        void flushFootprints();
 
-        /// Blit old texture content to new position when texture recenters
-        void blitTexture(const osg::Vec2f& oldCenter, const osg::Vec2f& newCenter);
+        PageKey getPageKey(const osg::Vec2f& worldPos) const;
 
-        /// Apply decay to the deformation texture
-        void applyDecay(float dt);
+        /// Distance from the deforming area center to the nearest point of a page
+        float getPageDistance(const PageKey& key) const;
+
+        bool allocatePage(const PageKey& key, DeformationPage& page);
+
+        void releasePage(DeformationPage& page);
+
+        void clearPages();
+
+        void writePageTableEntry(const PageKey& key, int slot);
+
+        void rebuildPageTable();
+
+        /// Move the page table window, rewriting only the entries of pages that entered it
+        void scrollPageTable(const osg::Vec2f& newOrigin);
+
+        int wrapPageTableIndex(int pageCoord) const;
+
+        /// Append a quad covering a footprint's intersection with a resident page
+        void appendStampQuad(const PageKey& key, int slot, const StampRecord& stamp);
+
+        /// Append a quad writing zeros to a whole atlas slot
+        void appendClearQuad(int slot);
+
+        /// Record that a stamp was drawn into a resident page
+        static void notePageStamp(DeformationPage& page, const StampRecord& stamp);
+
+        /// Whether the decay pass still has to process a resident page
+        bool pageNeedsDecay(const DeformationPage& page) const;
+
+        /// Apply decay to the resident pages that are not back to zero yet
+        /// @return false if there was nothing to decay, no pass is rendered then
+        bool applyDecay(float dt);
 
         /// Update deformation parameters based on terrain texture at position
         void updateTerrainParameters(const osg::Vec3f& playerPos);
 
         /// Detect terrain texture at position
-        std::string detectTerrainTexture(const osg::Vec3f& worldPos);
+        std::string_view detectTerrainTexture(const osg::Vec3f& worldPos);
 
         Resource::SceneManager* mSceneManager;
         Storage* mTerrainStorage;
+        SnowCoverageCache mSnowCoverage;
         ESM::RefId mWorldspace;
         bool mEnabled;
         bool mActive;  // Currently active (player on snow)
 
         // RTT setup
         osg::ref_ptr<osg::Camera> mRTTCamera;
-        osg::ref_ptr<osg::Texture2D> mDeformationTexture[2];  // Ping-pong buffers
+        osg::ref_ptr<osg::Texture2D> mDeformationTexture[2];  // Ping-pong page atlases
         int mCurrentTextureIndex;
         bool mTexturesInitialized;  // Track if textures have been cleared once
 
         // Deformation texture parameters
-        int mTextureResolution;        // Texture size (512 or 1024)
-        float mWorldTextureRadius;     // World space coverage radius
+        int mTextureResolution;        // Atlas size in texels
+        float mWorldTextureRadius;     // Pages within this distance of the player are kept resident
         osg::Vec2f mTextureCenter;     // Current center in world space
 
+        // Page parameters
+        int mPageResolution;           // Page size in texels
+        float mPageWorldSize;          // Page size in world units
+        int mPageTableSize;            // Page table window size in pages
+        int mPagesPerRow;              // Atlas slots per row
+        osg::Vec2f mPageTableOrigin;   // World page coordinates of the first page table entry
+        float mTimeSinceResidencyUpdate;
+
+        // Pages with deformation data, resident or only logged on the CPU
+        std::map<PageKey, DeformationPage> mPages;
+        std::vector<int> mFreeSlots;
+
+        // Page logs of the other worldspaces the player visited, until their stamps fully decay
+        std::map<ESM::RefId, std::map<PageKey, std::vector<StampRecord>>> mStoredPageLogs;
+        std::vector<PageKey> mRestoreQueue;
+
+        // Indirection table, one texel per page: rg = atlas slot, a = resident
+        // Page (x, y) is stored at (x mod size, y mod size) so moving the window never shifts entries
+        osg::ref_ptr<osg::Image> mPageTableImage;
+        osg::ref_ptr<osg::Texture2D> mPageTable;
+
         // Footprint parameters
         float mFootprintRadius;        // Footprint radius in world units
         float mFootprintInterval;      // Distance between footprints
@@ -122,20 +274,42 @@ namespace Terrain
         float mTimeSinceLastFootprint; // Time accumulator
 
         // Footprint rendering
-        osg::ref_ptr<osg::Group> mFootprintGroup;  // Group for footprint geometry
-        osg::ref_ptr<osg::Geometry> mFootprintQuad;
-        osg::ref_ptr<osg::StateSet> mFootprintStateSet;
+        // The batch pass draws directly into the current atlas: newly allocated slots are cleared
+        // first, then one small quad per footprint and resident page is drawn with MAX blending
+        struct PendingFootprint {
+            osg::Vec2f position;
+            float radius;
+            float depth;
+        };
+        std::vector<PendingFootprint> mPendingFootprints;
 
-        // Blit system (for texture scrolling)
-        osg::ref_ptr<osg::Group> mBlitGroup;
-        osg::ref_ptr<osg::Geometry> mBlitQuad;
-        osg::ref_ptr<osg::StateSet> mBlitStateSet;
-        osg::Vec2f mLastBlitCenter;      // Last center position when blit was performed
-        float mBlitThreshold;            // Distance player must move before blit (units)
+        struct ActorTrack
+        {
+            osg::Vec3f lastFootprintPos;
+            bool tracked = true;     // Tracked since the last update
+        };
+        std::unordered_map<std::uintptr_t, ActorTrack> mActorTracks;
+        size_t mMaxActorFootprintsPerFrame;
+        size_t mActorFootprintCount;     // Actor footprints queued since the last update
+        size_t mLastActorFootprintCount; // Reported in stats
+        osg::ref_ptr<osg::Group> mFootprintGroup;  // Group for footprint geometry
+        osg::ref_ptr<osg::Geometry> mSlotClearBatch;          // One quad per restored slot
+        osg::ref_ptr<osg::DrawArrays> mSlotClearBatchPrimitive;
+        osg::ref_ptr<osg::Geometry> mFootprintBatch;          // One quad per footprint and page
+        osg::ref_ptr<osg::DrawArrays> mFootprintBatchPrimitive;
+        osg::ref_ptr<osg::StateSet> mFootprintBatchStateSet;
+        size_t mMaxFootprintsPerBatch;
+        size_t mMaxStampsPerPage;        // Page log budget, oldest stamps are dropped first
 
         // Decay system
         osg::ref_ptr<osg::Group> mDecayGroup;
-        osg::ref_ptr<osg::Geometry> mDecayQuad;
+        osg::ref_ptr<osg::Geometry> mDecayQuad;         // One quad per page that still needs decay
+        osg::ref_ptr<osg::DrawArrays> mDecayPrimitive;
+
+        // GPU timers of the render passes
+        osg::ref_ptr<SnowPassTimer> mStampTimer;
+        osg::ref_ptr<SnowPassTimer> mClearTimer;
+        osg::ref_ptr<SnowPassTimer> mDecayTimer;
         osg::ref_ptr<osg::StateSet> mDecayStateSet;
         float mDecayTime;                // Time for full restoration (seconds)
         float mTimeSinceLastDecay;       // Accumulator for decay updates
@@ -149,7 +323,8 @@ namespace Terrain
             std::string pattern;
         };
         std::vector<TerrainParams> mTerrainParams;
-        std::string mCurrentTerrainType;
+        TerrainTypeTable mTerrainTypes;  // Indices in mTerrainParams by texture
+        std::size_t mCurrentTerrainType;
 
         // Game time
         float mCurrentTime;
@@ -9,9 +9,13 @@ namespace Terrain
     SnowDeformationUpdater::SnowDeformationUpdater(World* terrainWorld)
         : mTerrainWorld(terrainWorld)
         , mTextureUnit(7)  // Use texture unit 7 for deformation map
+        , mPageTableTextureUnit(6)  // And unit 6 for its page table
     {
         // Create uniforms with default values
         mDeformationMapUniform = new osg::Uniform("snowDeformationMap", mTextureUnit);
+        mPageTableUniform = new osg::Uniform("snowDeformationPageTable", mPageTableTextureUnit);
+        mPageTableOriginUniform = new osg::Uniform("snowDeformationPageTableOrigin", osg::Vec2f(0.0f, 0.0f));
+        mPageParamsUniform = new osg::Uniform("snowDeformationPageParams", osg::Vec4f(128.0f, 32.0f, 128.0f, 2048.0f));
         mDeformationCenterUniform = new osg::Uniform("snowDeformationCenter", osg::Vec2f(0.0f, 0.0f));
         mDeformationRadiusUniform = new osg::Uniform("snowDeformationRadius", 150.0f);
         mDeformationEnabledUniform = new osg::Uniform("snowDeformationEnabled", false);
@@ -22,6 +26,9 @@ namespace Terrain
     {
         // Add uniforms to stateset
         stateset->addUniform(mDeformationMapUniform);
+        stateset->addUniform(mPageTableUniform);
+        stateset->addUniform(mPageTableOriginUniform);
+        stateset->addUniform(mPageParamsUniform);
         stateset->addUniform(mDeformationCenterUniform);
         stateset->addUniform(mDeformationRadiusUniform);
         stateset->addUniform(mDeformationEnabledUniform);
@@ -52,15 +59,23 @@ namespace Terrain
 
         if (deformationTexture && manager->isEnabled())
         {
-            // Bind deformation texture
+            // Bind deformation page atlas and its indirection table
             stateset->setTextureAttributeAndModes(mTextureUnit,
                 deformationTexture, osg::StateAttribute::ON);
+            stateset->setTextureAttributeAndModes(mPageTableTextureUnit,
+                manager->getPageTableTexture(), osg::StateAttribute::ON);
 
             // Get deformation texture parameters from manager
             osg::Vec2f center;
             float radius;
             manager->getDeformationTextureParams(center, radius);
 
+            osg::Vec2f pageTableOrigin;
+            osg::Vec4f pageParams;
+            manager->getPageTableParams(pageTableOrigin, pageParams);
+            mPageTableOriginUniform->set(pageTableOrigin);
+            mPageParamsUniform->set(pageParams);
+
             // Get current deformation parameters (terrain-specific)
             float footprintRadius, deformationDepth, footprintInterval;
             manager->getDeformationParams(footprintRadius, deformationDepth, footprintInterval);
@@ -89,6 +104,12 @@ namespace Terrain
                 stateset->addUniform(mDeformationRadiusUniform);
             if (!stateset->getUniform("snowDeformationMap"))
                 stateset->addUniform(mDeformationMapUniform);
+            if (!stateset->getUniform("snowDeformationPageTable"))
+                stateset->addUniform(mPageTableUniform);
+            if (!stateset->getUniform("snowDeformationPageTableOrigin"))
+                stateset->addUniform(mPageTableOriginUniform);
+            if (!stateset->getUniform("snowDeformationPageParams"))
+                stateset->addUniform(mPageParamsUniform);
             if (!stateset->getUniform("snowRaiseAmount"))
                 stateset->addUniform(mRaiseAmountUniform);
 
@@ -23,11 +23,15 @@ namespace Terrain
     private:
         World* mTerrainWorld;
         osg::ref_ptr<osg::Uniform> mDeformationMapUniform;
+        osg::ref_ptr<osg::Uniform> mPageTableUniform;
+        osg::ref_ptr<osg::Uniform> mPageTableOriginUniform;
+        osg::ref_ptr<osg::Uniform> mPageParamsUniform;
         osg::ref_ptr<osg::Uniform> mDeformationCenterUniform;
         osg::ref_ptr<osg::Uniform> mDeformationRadiusUniform;
         osg::ref_ptr<osg::Uniform> mDeformationEnabledUniform;
         osg::ref_ptr<osg::Uniform> mRaiseAmountUniform;
         int mTextureUnit;
+        int mPageTableTextureUnit;
     };
 }
 
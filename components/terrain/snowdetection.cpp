@@ -2,6 +2,7 @@
 #include "storage.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/strings/lower.hpp>
 #include <components/settings/values.hpp>
 
 #include <algorithm>
@@ -69,14 +70,63 @@ namespace Terrain
         Storage* terrainStorage,
         ESM::RefId worldspace)
     {
-        // TESTING MODE: Always return true to enable deformation on all terrain
-        // This allows testing the system without texture detection
-        // TODO: Implement actual snow texture detection when ready
+        if (!terrainStorage)
+            return false;
+
+        const float cellSize = terrainStorage->getCellWorldSize(worldspace);
+        const float cellX = worldPos.x() / cellSize;
+        const float cellY = worldPos.y() / cellSize;
+        const ESM::ExteriorCellLocation cell(
+            static_cast<int>(std::floor(cellX)), static_cast<int>(std::floor(cellY)), worldspace);
+
+        Storage::ImageVector blendmaps;
+        std::vector<LayerInfo> layers;
+        terrainStorage->getBlendmaps(1.0f, osg::Vec2f(cell.mX + 0.5f, cell.mY + 0.5f), blendmaps, layers, worldspace);
+
+        const osg::Vec2f uv(cellX - cell.mX, cellY - cell.mY);
+        float weight = 0.0f;
+        for (std::size_t i = 0; i < layers.size() && i < blendmaps.size(); ++i)
+        {
+            if (isSnowTexture(layers[i].mDiffuseMap.value()))
+                weight += sampleBlendMap(blendmaps[i].get(), uv);
+        }
+
+        return weight >= sSnowThreshold;
+    }
+
+    void SnowDetection::computeSnowCoverage(Storage* terrainStorage, const ESM::ExteriorCellLocation& cell,
+        int gridSize, std::vector<float>& coverage)
+    {
+        TerrainTypeTable snowTextures(getSnowPatterns());
+        computeSnowCoverage(terrainStorage, cell, gridSize, coverage, snowTextures);
+    }
+
+    void SnowDetection::computeSnowCoverage(Storage* terrainStorage, const ESM::ExteriorCellLocation& cell,
+        int gridSize, std::vector<float>& coverage, TerrainTypeTable& snowTextures)
+    {
+        coverage.assign(static_cast<std::size_t>(gridSize * gridSize), 0.0f);
+        if (!terrainStorage || gridSize <= 0)
+            return;
+
+        Storage::ImageVector blendmaps;
+        std::vector<LayerInfo> layers;
+        terrainStorage->getBlendmaps(
+            1.0f, osg::Vec2f(cell.mX + 0.5f, cell.mY + 0.5f), blendmaps, layers, cell.mWorldspace);
 
-        Log(Debug::Verbose) << "[SNOW] Snow detection active at position ("
-                           << (int)worldPos.x() << ", " << (int)worldPos.z() << ")";
+        for (std::size_t i = 0; i < layers.size() && i < blendmaps.size(); ++i)
+        {
+            if (snowTextures.getType(layers[i].mDiffuseMap.value()) == TerrainTypeTable::sNoType)
+                continue;
 
-        return true;  // Enable deformation everywhere for testing
+            for (int y = 0; y < gridSize; ++y)
+            {
+                for (int x = 0; x < gridSize; ++x)
+                {
+                    const osg::Vec2f uv((x + 0.5f) / gridSize, (y + 0.5f) / gridSize);
+                    coverage[y * gridSize + x] += sampleBlendMap(blendmaps[i].get(), uv);
+                }
+            }
+        }
     }
 
     float SnowDetection::sampleBlendMap(
@@ -124,4 +174,71 @@ namespace Terrain
         loadSnowPatterns();
         return sSnowPatterns;
     }
+
+    TerrainTypeTable::TerrainTypeTable(std::vector<std::string> patterns)
+        : mPatterns(std::move(patterns))
+    {
+    }
+
+    std::size_t TerrainTypeTable::getType(std::string_view texturePath)
+    {
+        if (const auto it = mTypes.find(texturePath); it != mTypes.end())
+            return it->second;
+
+        const std::string lowerPath = Misc::StringUtils::lowerCase(texturePath);
+        std::size_t type = sNoType;
+        for (std::size_t i = 0; i < mPatterns.size(); ++i)
+        {
+            if (lowerPath.find(mPatterns[i]) != std::string::npos)
+            {
+                type = i;
+                break;
+            }
+        }
+        mTypes.emplace(texturePath, type);
+        return type;
+    }
+
+    SnowCoverageCache::SnowCoverageCache(Storage* terrainStorage)
+        : mStorage(terrainStorage)
+        , mSnowTextures(SnowDetection::getSnowPatterns())
+    {
+    }
+
+    float SnowCoverageCache::getSnowCoverage(const osg::Vec3f& worldPos, ESM::RefId worldspace)
+    {
+        if (!mStorage)
+            return 0.0f;
+
+        const float cellSize = mStorage->getCellWorldSize(worldspace);
+        const float cellX = worldPos.x() / cellSize;
+        const float cellY = worldPos.y() / cellSize;
+        const ESM::ExteriorCellLocation cell(
+            static_cast<int>(std::floor(cellX)), static_cast<int>(std::floor(cellY)), worldspace);
+
+        const Grid& grid = getGrid(cell);
+        const int x = std::clamp(static_cast<int>((cellX - cell.mX) * sGridSize), 0, sGridSize - 1);
+        const int y = std::clamp(static_cast<int>((cellY - cell.mY) * sGridSize), 0, sGridSize - 1);
+        return grid[y * sGridSize + x] / 255.0f;
+    }
+
+    void SnowCoverageCache::invalidateCell(const ESM::ExteriorCellLocation& cell)
+    {
+        mCells.erase(cell);
+    }
+
+    const SnowCoverageCache::Grid& SnowCoverageCache::getGrid(const ESM::ExteriorCellLocation& cell)
+    {
+        auto it = mCells.find(cell);
+        if (it != mCells.end())
+            return it->second;
+
+        SnowDetection::computeSnowCoverage(mStorage, cell, sGridSize, mScratch, mSnowTextures);
+
+        Grid grid;
+        for (std::size_t i = 0; i < grid.size(); ++i)
+            grid[i] = static_cast<std::uint8_t>(std::clamp(mScratch[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+
+        return mCells.emplace(cell, grid).first->second;
+    }
 }
@@ -1,17 +1,25 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_SNOWDETECTION_H
 #define OPENMW_COMPONENTS_TERRAIN_SNOWDETECTION_H
 
+#include <array>
+#include <cstdint>
+#include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <osg/Vec3f>
 #include <osg/Vec2f>
 #include <osg/Image>
 
+#include <components/esm/exteriorcelllocation.hpp>
 #include <components/esm/refid.hpp>
+#include <components/misc/strings/algorithm.hpp>
 
 namespace Terrain
 {
     class Storage;
+    class TerrainTypeTable;
 
     /// Utilities for detecting snow textures at runtime
     /// Used to determine if snow deformation should be active
@@ -23,7 +31,11 @@ namespace Terrain
         /// @return True if texture appears to be snow/ice
         static bool isSnowTexture(const std::string& texturePath);
 
+        /// Minimum summed blend weight of snow layers for a position to count as snow
+        static constexpr float sSnowThreshold = 0.5f;
+
         /// Check if terrain at world position has snow texture
+        /// @note Queries the blendmaps of the whole cell, use SnowCoverageCache for repeated lookups
         /// @param worldPos Position in world space
         /// @param terrainStorage Terrain storage for layer queries
         /// @param worldspace Current worldspace ID
@@ -34,6 +46,18 @@ namespace Terrain
             ESM::RefId worldspace
         );
 
+        /// Compute the snow blend weight of a cell on a regular grid
+        /// @param terrainStorage Terrain storage for layer queries
+        /// @param cell Cell to sample
+        /// @param gridSize Number of samples on one side of the cell
+        /// @param coverage Summed snow layer weights (0-1), row-major from the south-west corner
+        static void computeSnowCoverage(Storage* terrainStorage, const ESM::ExteriorCellLocation& cell,
+            int gridSize, std::vector<float>& coverage);
+
+        /// Same as above, resolving layer textures through a table of the snow patterns
+        static void computeSnowCoverage(Storage* terrainStorage, const ESM::ExteriorCellLocation& cell,
+            int gridSize, std::vector<float>& coverage, TerrainTypeTable& snowTextures);
+
         /// Sample a blendmap to get texture weight at UV coordinate
         /// @param blendmap Blendmap image
         /// @param uv UV coordinates (0-1 range)
@@ -54,6 +78,65 @@ namespace Terrain
         static std::vector<std::string> sSnowPatterns;
         static bool sPatternsLoaded;
     };
+
+    /// Terrain types of texture paths, each path is matched against the type patterns only the first time it is seen
+    /// @note Not thread safe
+    class TerrainTypeTable
+    {
+    public:
+        static constexpr std::size_t sNoType = static_cast<std::size_t>(-1);
+
+        /// @param patterns Lowercase patterns, the first one contained in a texture path gives its type
+        explicit TerrainTypeTable(std::vector<std::string> patterns);
+
+        /// @return Index of the first pattern contained in the texture path ignoring case, or sNoType
+        std::size_t getType(std::string_view texturePath);
+
+    private:
+        std::vector<std::string> mPatterns;
+        std::unordered_map<std::string, std::size_t, Misc::StringUtils::StringHash, std::equal_to<>> mTypes;
+    };
+
+    /// Per-cell snow coverage grids, so that "is this position on snow" is an array lookup
+    /// Grids are built from the terrain blendmaps the first time a cell is queried and kept until invalidated
+    /// @note Not thread safe, meant to be used from the main thread only
+    class SnowCoverageCache
+    {
+    public:
+        /// Number of coverage samples on one side of a cell
+        static constexpr int sGridSize = 16;
+
+        explicit SnowCoverageCache(Storage* terrainStorage);
+
+        /// Get the summed snow layer weight (0-1) at a world position
+        float getSnowCoverage(const osg::Vec3f& worldPos, ESM::RefId worldspace);
+
+        /// Check if a world position is on snow with sufficient blend weight
+        bool hasSnowAt(const osg::Vec3f& worldPos, ESM::RefId worldspace)
+        {
+            return getSnowCoverage(worldPos, worldspace) >= SnowDetection::sSnowThreshold;
+        }
+
+        /// Drop the grid of a cell, call when its land data changes or is unloaded
+        void invalidateCell(const ESM::ExteriorCellLocation& cell);
+
+        /// Drop every grid
+        void clear() { mCells.clear(); }
+
+        /// Get number of cells with a coverage grid
+        size_t getCellCount() const { return mCells.size(); }
+
+    private:
+        /// Coverage scaled to 0-255, row-major from the south-west corner
+        using Grid = std::array<std::uint8_t, sGridSize * sGridSize>;
+
+        const Grid& getGrid(const ESM::ExteriorCellLocation& cell);
+
+        Storage* mStorage;
+        TerrainTypeTable mSnowTextures;
+        std::map<ESM::ExteriorCellLocation, Grid> mCells;
+        std::vector<float> mScratch;
+    };
 }
 
 #endif
@@ -0,0 +1,62 @@
+#include "snowpasstimer.hpp"
+
+#include <osg/GLExtensions>
+#include <osg/State>
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+namespace Terrain
+{
+    void SnowPassTimer::drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const
+    {
+        osg::State& state = *renderInfo.getState();
+        const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+        if (!extensions || !extensions->isTimerQuerySupported)
+        {
+            drawable->drawImplementation(renderInfo);
+            return;
+        }
+
+        Queries& queries = mQueries[state.getContextID()];
+        if (!queries.mGenerated)
+        {
+            extensions->glGenQueries(static_cast<GLsizei>(sQueryCount), queries.mIds.data());
+            queries.mGenerated = true;
+        }
+
+        // Collect finished queries, oldest first so the newest result wins
+        for (std::size_t i = 0; i < sQueryCount; ++i)
+        {
+            const std::size_t index = (queries.mNext + i) % sQueryCount;
+            if (!queries.mIssued[index])
+                continue;
+
+            GLint available = 0;
+            extensions->glGetQueryObjectiv(queries.mIds[index], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+
+            GLuint64 elapsed = 0;
+            extensions->glGetQueryObjectui64v(queries.mIds[index], GL_QUERY_RESULT, &elapsed);
+            mLastTimeMs.store(static_cast<double>(elapsed) / 1e6, std::memory_order_relaxed);
+            queries.mIssued[index] = false;
+        }
+
+        // Every query is still in flight, skip timing this draw rather than waiting
+        const std::size_t index = queries.mNext;
+        if (queries.mIssued[index])
+        {
+            drawable->drawImplementation(renderInfo);
+            return;
+        }
+
+        extensions->glBeginQuery(GL_TIME_ELAPSED, queries.mIds[index]);
+        drawable->drawImplementation(renderInfo);
+        extensions->glEndQuery(GL_TIME_ELAPSED);
+
+        queries.mIssued[index] = true;
+        queries.mNext = (index + 1) % sQueryCount;
+    }
+}
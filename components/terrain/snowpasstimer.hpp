@@ -0,0 +1,42 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_SNOWPASSTIMER_H
+#define OPENMW_COMPONENTS_TERRAIN_SNOWPASSTIMER_H
+
+#include <osg/Drawable>
+#include <osg/GL>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <map>
+
+namespace Terrain
+{
+    /// Measures the GPU time of the drawables it is attached to with GL_TIME_ELAPSED queries
+    /// Results are read back in later frames once available, so timing never stalls the pipeline
+    /// @note Falls back to drawing without timing when timer queries are not supported
+    class SnowPassTimer : public osg::Drawable::DrawCallback
+    {
+    public:
+        void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const override;
+
+        /// @return GPU time of the most recent measured draw in milliseconds
+        double getLastTimeMs() const { return mLastTimeMs.load(std::memory_order_relaxed); }
+
+    private:
+        /// Queries in flight per graphics context, enough to cover a few frames of latency
+        static constexpr std::size_t sQueryCount = 4;
+
+        struct Queries
+        {
+            std::array<GLuint, sQueryCount> mIds{};
+            std::array<bool, sQueryCount> mIssued{};
+            std::size_t mNext = 0;
+            bool mGenerated = false;
+        };
+
+        mutable std::map<unsigned int, Queries> mQueries;
+        mutable std::atomic<double> mLastTimeMs{ 0.0 };
+    };
+}
+
+#endif
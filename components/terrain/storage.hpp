@@ -1,6 +1,8 @@
 #ifndef COMPONENTS_TERRAIN_STORAGE_H
 #define COMPONENTS_TERRAIN_STORAGE_H
 
+#include <cassert>
+#include <span>
 #include <vector>
 
 #include <osg/Array>
@@ -80,8 +82,21 @@ namespace Terrain
             std::vector<LayerInfo>& layerList, ESM::RefId worldspace)
             = 0;
 
+        /// Drop any data the implementation keeps between calls, for when the terrain records have changed.
+        virtual void clearCache() {}
+
         virtual float getHeightAt(const osg::Vec3f& worldPos, ESM::RefId worldspace) = 0;
 
+        /// Get the heights at many positions at once, cheaper than separate calls for positions sharing cells.
+        /// @note May be called from background threads.
+        /// @param heights receives the height of each position, must be at least as large as worldPos
+        virtual void getHeightsAt(std::span<const osg::Vec3f> worldPos, ESM::RefId worldspace, std::span<float> heights)
+        {
+            assert(heights.size() >= worldPos.size());
+            for (std::size_t i = 0; i < worldPos.size(); ++i)
+                heights[i] = getHeightAt(worldPos[i], worldspace);
+        }
+
         /// Get the transformation factor for mapping cell units to world units.
         virtual float getCellWorldSize(ESM::RefId worldspace) = 0;
 
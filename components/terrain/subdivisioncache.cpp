@@ -0,0 +1,94 @@
+#include "subdivisioncache.hpp"
+
+#include <osg/Array>
+
+#include <utility>
+
+namespace Terrain
+{
+    namespace
+    {
+        std::size_t getDataSize(const osg::Array* array)
+        {
+            return array != nullptr ? array->getTotalDataSize() : 0;
+        }
+
+        std::size_t getDataSize(const osg::Geometry& geometry)
+        {
+            std::size_t result = getDataSize(geometry.getVertexArray()) + getDataSize(geometry.getNormalArray())
+                + getDataSize(geometry.getColorArray());
+            for (const osg::ref_ptr<osg::Array>& array : geometry.getTexCoordArrayList())
+                result += getDataSize(array.get());
+            return result;
+        }
+    }
+
+    SubdivisionCache::SubdivisionCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    osg::ref_ptr<osg::Geometry> SubdivisionCache::get(const SubdivisionKey& key)
+    {
+        const std::lock_guard lock(mMutex);
+        ++mGet;
+        const auto it = mEntries.find(key);
+        if (it == mEntries.end())
+            return nullptr;
+        ++mHit;
+        mOrder.splice(mOrder.begin(), mOrder, it->second.mOrder);
+        return it->second.mGeometry;
+    }
+
+    void SubdivisionCache::insert(const SubdivisionKey& key, osg::ref_ptr<osg::Geometry> geometry)
+    {
+        const std::size_t size = getDataSize(*geometry);
+        if (size > mMaxSize)
+            return;
+
+        const std::lock_guard lock(mMutex);
+
+        // Chunks may be subdivided by several threads at once, the first result wins
+        if (mEntries.contains(key))
+            return;
+
+        mOrder.push_front(key);
+        mEntries.emplace(key, Entry{ std::move(geometry), size, mOrder.begin() });
+        mSize += size;
+
+        while (mSize > mMaxSize)
+        {
+            const auto it = mEntries.find(mOrder.back());
+            mSize -= it->second.mSize;
+            mEntries.erase(it);
+            mOrder.pop_back();
+            ++mEvicted;
+        }
+    }
+
+    void SubdivisionCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mEntries.clear();
+        mOrder.clear();
+        mSize = 0;
+    }
+
+    std::size_t SubdivisionCache::getSize() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mSize;
+    }
+
+    Resource::CacheStats SubdivisionCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return Resource::CacheStats{
+            .mSize = mEntries.size(),
+            .mMemory = mSize,
+            .mGet = mGet,
+            .mHit = mHit,
+            .mEvicted = mEvicted,
+        };
+    }
+}
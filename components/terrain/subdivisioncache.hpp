@@ -0,0 +1,80 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_SUBDIVISIONCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_SUBDIVISIONCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <osg/Geometry>
+#include <osg/Vec2f>
+#include <osg/ref_ptr>
+
+#include <components/resource/cachestats.hpp>
+
+namespace Terrain
+{
+    struct SubdivisionKey
+    {
+        osg::Vec2f mCenter;
+        unsigned char mLod;
+        unsigned mLodFlags;
+        int mSubdivisionLevel;
+    };
+
+    inline auto tie(const SubdivisionKey& v)
+    {
+        return std::tie(v.mCenter, v.mLod, v.mLodFlags, v.mSubdivisionLevel);
+    }
+
+    inline bool operator<(const SubdivisionKey& l, const SubdivisionKey& r)
+    {
+        return tie(l) < tie(r);
+    }
+
+    /// @brief Keeps geometry produced by TerrainSubdivider for chunks that were recently dropped or rebuilt.
+    /// @par Subdividing a chunk again at a level it already had yields identical arrays, so chunks recreated when
+    /// the player walks back into a trampled area or moves back and forth over a subdivision boundary reuse them.
+    /// When the total size of the arrays exceeds the budget the least recently used geometry is dropped first.
+    /// @note Thread safe.
+    class SubdivisionCache
+    {
+    public:
+        explicit SubdivisionCache(std::size_t maxSize);
+
+        /// @return Cached geometry, nullptr if there is none.
+        osg::ref_ptr<osg::Geometry> get(const SubdivisionKey& key);
+
+        /// Geometry larger than the whole budget is not stored.
+        void insert(const SubdivisionKey& key, osg::ref_ptr<osg::Geometry> geometry);
+
+        void clear();
+
+        std::size_t getSize() const;
+
+        std::size_t getMaxSize() const { return mMaxSize; }
+
+        Resource::CacheStats getStats() const;
+
+    private:
+        struct Entry
+        {
+            osg::ref_ptr<osg::Geometry> mGeometry;
+            std::size_t mSize;
+            std::list<SubdivisionKey>::iterator mOrder;
+        };
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        std::map<SubdivisionKey, Entry> mEntries;
+        // Most recently used first
+        std::list<SubdivisionKey> mOrder;
+        std::size_t mSize = 0;
+        std::size_t mGet = 0;
+        std::size_t mHit = 0;
+        std::size_t mEvicted = 0;
+    };
+}
+
+#endif
@@ -5,14 +5,44 @@
 
 namespace Terrain
 {
+    namespace
+    {
+        // Smallest chunk the quad tree produces for Morrowind sized cells, used to size the index
+        constexpr float sMinChunkWorldSize = 1024.0f;
+
+        // Beyond max subdivision range, chunk is no longer maintained actively
+        constexpr float sActiveRange = 1536.0f;
+    }
+
     SubdivisionTracker::SubdivisionTracker()
         : mMaxTrailTime(120.0f)      // 2 minutes - chunks stay subdivided for this long
         , mMaxTrailDistance(3072.0f)  // ~375 meters - maximum trail distance
         , mDecayStartTime(30.0f)      // Subdivision starts reducing after 30 seconds
     {
+        setMaxTrailDistance(mMaxTrailDistance);
+    }
+
+    void SubdivisionTracker::setMaxTrailDistance(float units)
+    {
+        mMaxTrailDistance = units;
+
+        const std::size_t chunksAcross = static_cast<std::size_t>(2.0f * units / sMinChunkWorldSize) + 1;
+        const std::size_t expected = chunksAcross * chunksAcross;
+        std::size_t slotCount = 16;
+        while (slotCount < 2 * std::max(expected, mKeys.size()))
+            slotCount *= 2;
+        if (slotCount > mSlots.size())
+        {
+            mKeys.reserve(slotCount / 2);
+            mCenters.reserve(slotCount / 2);
+            mLevels.reserve(slotCount / 2);
+            mTimeSubdivided.reserve(slotCount / 2);
+            mTimeSincePlayerLeft.reserve(slotCount / 2);
+            rehash(slotCount);
+        }
     }
 
-    std::pair<int, int> SubdivisionTracker::chunkToKey(const osg::Vec2f& center) const
+    SubdivisionTracker::Key SubdivisionTracker::chunkToKey(const osg::Vec2f& center)
     {
         // Round to nearest 0.01 to avoid floating point precision issues
         int x = static_cast<int>(std::round(center.x() * 100.0f));
@@ -20,46 +50,126 @@ namespace Terrain
         return std::make_pair(x, y);
     }
 
-    void SubdivisionTracker::update(float dt, const osg::Vec2f& playerPos)
+    std::size_t SubdivisionTracker::hashKey(const Key& key)
     {
-        // Update all tracked chunks and remove expired ones
-        auto it = mTrackedChunks.begin();
-        while (it != mTrackedChunks.end())
+        std::uint32_t h = static_cast<std::uint32_t>(key.first) * 0x9E3779B1u;
+        h ^= static_cast<std::uint32_t>(key.second) * 0x85EBCA77u;
+        h ^= h >> 15;
+        return h;
+    }
+
+    std::size_t SubdivisionTracker::find(const Key& key) const
+    {
+        const std::size_t mask = mSlots.size() - 1;
+        for (std::size_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask)
         {
-            ChunkSubdivisionData& data = it->second;
+            const std::uint32_t entry = mSlots[slot];
+            if (entry == 0)
+                return mKeys.size();
+            if (mKeys[entry - 1] == key)
+                return entry - 1;
+        }
+    }
 
-            // Calculate distance from player to chunk (world space)
-            float distance = (playerPos - data.chunkCenter).length();
+    std::size_t SubdivisionTracker::insert(const Key& key)
+    {
+        if (2 * (mKeys.size() + 1) > mSlots.size())
+            rehash(mSlots.size() * 2);
 
-            // Update timers
-            // Check if player is beyond subdivision range (no longer maintaining this chunk actively)
-            if (distance > 1536.0f)  // Beyond max subdivision range
-            {
-                data.timeSincePlayerLeft += dt;
-            }
-            else
-            {
-                // Player is nearby, reset the "left" timer and keep tracking
-                data.timeSincePlayerLeft = 0.0f;
-                data.timeSubdivided += dt;
-            }
+        const std::size_t index = mKeys.size();
+        mKeys.push_back(key);
+        mCenters.emplace_back();
+        mLevels.push_back(0);
+        mTimeSubdivided.push_back(0.0f);
+        mTimeSincePlayerLeft.push_back(0.0f);
+
+        const std::size_t mask = mSlots.size() - 1;
+        std::size_t slot = hashKey(key) & mask;
+        while (mSlots[slot] != 0)
+            slot = (slot + 1) & mask;
+        mSlots[slot] = static_cast<std::uint32_t>(index + 1);
+        return index;
+    }
 
-            // Check if chunk should be removed from tracking
-            if (!shouldMaintainSubdivision(data, distance))
+    void SubdivisionTracker::erase(std::size_t index)
+    {
+        const std::size_t mask = mSlots.size() - 1;
+        auto slotOf = [&](std::size_t denseIndex) {
+            std::size_t slot = hashKey(mKeys[denseIndex]) & mask;
+            while (mSlots[slot] != denseIndex + 1)
+                slot = (slot + 1) & mask;
+            return slot;
+        };
+
+        // Backward shift deletion keeps probe sequences intact without tombstones
+        std::size_t hole = slotOf(index);
+        for (std::size_t slot = (hole + 1) & mask; mSlots[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const std::size_t home = hashKey(mKeys[mSlots[slot] - 1]) & mask;
+            if (((slot - home) & mask) >= ((slot - hole) & mask))
             {
-                Log(Debug::Verbose) << "[SNOW TRAIL] Releasing chunk subdivision at ("
-                                   << it->second.chunkCenter.x() << ", " << it->second.chunkCenter.y()
-                                   << ") after " << (int)data.timeSincePlayerLeft << "s";
-                it = mTrackedChunks.erase(it);
+                mSlots[hole] = mSlots[slot];
+                hole = slot;
             }
-            else
+        }
+        mSlots[hole] = 0;
+
+        // Fill the gap in the dense arrays with the last element
+        const std::size_t last = mKeys.size() - 1;
+        if (index != last)
+        {
+            mSlots[slotOf(last)] = static_cast<std::uint32_t>(index + 1);
+            mKeys[index] = mKeys[last];
+            mCenters[index] = mCenters[last];
+            mLevels[index] = mLevels[last];
+            mTimeSubdivided[index] = mTimeSubdivided[last];
+            mTimeSincePlayerLeft[index] = mTimeSincePlayerLeft[last];
+        }
+        mKeys.pop_back();
+        mCenters.pop_back();
+        mLevels.pop_back();
+        mTimeSubdivided.pop_back();
+        mTimeSincePlayerLeft.pop_back();
+    }
+
+    void SubdivisionTracker::rehash(std::size_t slotCount)
+    {
+        mSlots.assign(slotCount, 0);
+        const std::size_t mask = slotCount - 1;
+        for (std::size_t index = 0; index < mKeys.size(); ++index)
+        {
+            std::size_t slot = hashKey(mKeys[index]) & mask;
+            while (mSlots[slot] != 0)
+                slot = (slot + 1) & mask;
+            mSlots[slot] = static_cast<std::uint32_t>(index + 1);
+        }
+    }
+
+    void SubdivisionTracker::update(float dt, const osg::Vec2f& playerPos)
+    {
+        // Update timers, branch free over contiguous arrays so the compiler can vectorize it
+        const std::size_t count = mKeys.size();
+        const float activeRange2 = sActiveRange * sActiveRange;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const bool away = (playerPos - mCenters[i]).length2() > activeRange2;
+            mTimeSincePlayerLeft[i] = away ? mTimeSincePlayerLeft[i] + dt : 0.0f;
+            mTimeSubdivided[i] += away ? 0.0f : dt;
+        }
+
+        // Remove expired chunks, walking backwards so swapped in elements were already checked
+        for (std::size_t i = count; i-- > 0;)
+        {
+            if (!shouldMaintainSubdivision(mTimeSincePlayerLeft[i], (playerPos - mCenters[i]).length()))
             {
-                ++it;
+                Log(Debug::Verbose) << "[SNOW TRAIL] Releasing chunk subdivision at (" << mCenters[i].x() << ", "
+                                    << mCenters[i].y() << ") after " << (int)mTimeSincePlayerLeft[i] << "s";
+                erase(i);
             }
         }
     }
 
-    bool SubdivisionTracker::shouldMaintainSubdivision(const ChunkSubdivisionData& data, float distanceFromPlayer) const
+    bool SubdivisionTracker::shouldMaintainSubdivision(float timeSincePlayerLeft, float distanceFromPlayer) const
     {
         // Keep subdivision if:
         // 1. Player is still nearby (within trail distance), OR
@@ -68,30 +178,30 @@ namespace Terrain
         if (distanceFromPlayer <= mMaxTrailDistance)
             return true;  // Player still in range
 
-        if (data.timeSincePlayerLeft < mMaxTrailTime)
+        if (timeSincePlayerLeft < mMaxTrailTime)
             return true;  // Trail time not expired
 
         return false;  // Release subdivision
     }
 
-    int SubdivisionTracker::calculateDecayedLevel(const ChunkSubdivisionData& data) const
+    int SubdivisionTracker::calculateDecayedLevel(int level, float timeSincePlayerLeft) const
     {
         // Gradually reduce subdivision level over time after player leaves
 
-        if (data.timeSincePlayerLeft < mDecayStartTime)
+        if (timeSincePlayerLeft < mDecayStartTime)
         {
             // Keep original level during grace period
-            return data.subdivisionLevel;
+            return level;
         }
 
         // After decay start time, gradually reduce level
-        float decayProgress = (data.timeSincePlayerLeft - mDecayStartTime) / (mMaxTrailTime - mDecayStartTime);
+        float decayProgress = (timeSincePlayerLeft - mDecayStartTime) / (mMaxTrailTime - mDecayStartTime);
         decayProgress = std::min(1.0f, std::max(0.0f, decayProgress));
 
         // Reduce level based on decay progress
         // Level 2 -> Level 1 at 33% decay, Level 1 -> Level 0 at 66% decay
-        int reducedLevels = static_cast<int>(decayProgress * data.subdivisionLevel);
-        int currentLevel = std::max(0, data.subdivisionLevel - reducedLevels);
+        int reducedLevels = static_cast<int>(decayProgress * level);
+        int currentLevel = std::max(0, level - reducedLevels);
 
         return currentLevel;
     }
@@ -111,15 +221,12 @@ namespace Terrain
             distanceBasedLevel = 1;  // Medium detail
 
         // Check if chunk is being tracked (has been subdivided before)
-        auto key = chunkToKey(chunkCenter);
-        auto it = mTrackedChunks.find(key);
+        const std::size_t index = find(chunkToKey(chunkCenter));
 
-        if (it != mTrackedChunks.end())
+        if (index != mKeys.size())
         {
-            const ChunkSubdivisionData& data = it->second;
-
             // Calculate current level with decay
-            int trackedLevel = calculateDecayedLevel(data);
+            int trackedLevel = calculateDecayedLevel(mLevels[index], mTimeSincePlayerLeft[index]);
 
             // Use the HIGHER of tracked level or distance-based level
             // This ensures chunks maintain their subdivision when you return to them
@@ -135,7 +242,7 @@ namespace Terrain
                                        << ") tracked=" << trackedLevel
                                        << " distance=" << distanceBasedLevel
                                        << " using=" << finalLevel
-                                       << " timeSinceLeft=" << (int)data.timeSincePlayerLeft << "s";
+                                       << " timeSinceLeft=" << (int)mTimeSincePlayerLeft[index] << "s";
                 }
                 return finalLevel;
             }
@@ -150,34 +257,27 @@ namespace Terrain
         if (level <= 0)
             return;  // Don't track non-subdivided chunks
 
-        auto key = chunkToKey(chunkCenter);
-        auto it = mTrackedChunks.find(key);
+        const Key key = chunkToKey(chunkCenter);
+        std::size_t index = find(key);
 
-        if (it != mTrackedChunks.end())
+        if (index != mKeys.size())
         {
-            // Update existing entry
-            ChunkSubdivisionData& data = it->second;
-
             // Upgrade to higher level if needed
-            if (level > data.subdivisionLevel)
+            if (level > mLevels[index])
             {
-                data.subdivisionLevel = level;
+                mLevels[index] = level;
                 Log(Debug::Info) << "[SNOW TRAIL] Upgraded chunk subdivision to level " << level;
             }
 
             // Reset timers since player is here
-            data.timeSincePlayerLeft = 0.0f;
+            mTimeSincePlayerLeft[index] = 0.0f;
         }
         else
         {
             // Create new entry
-            ChunkSubdivisionData data;
-            data.subdivisionLevel = level;
-            data.timeSubdivided = 0.0f;
-            data.timeSincePlayerLeft = 0.0f;
-            data.chunkCenter = worldCenter;  // Store WORLD coordinates for distance calculations
-
-            mTrackedChunks[key] = data;
+            index = insert(key);
+            mLevels[index] = level;
+            mCenters[index] = worldCenter;  // Store WORLD coordinates for distance calculations
 
             Log(Debug::Info) << "[SNOW TRAIL] Started tracking chunk at cell("
                             << chunkCenter.x() << ", " << chunkCenter.y()
@@ -188,7 +288,12 @@ namespace Terrain
 
     void SubdivisionTracker::clear()
     {
-        Log(Debug::Info) << "[SNOW TRAIL] Clearing all tracked chunks (" << mTrackedChunks.size() << " total)";
-        mTrackedChunks.clear();
+        Log(Debug::Info) << "[SNOW TRAIL] Clearing all tracked chunks (" << mKeys.size() << " total)";
+        mKeys.clear();
+        mCenters.clear();
+        mLevels.clear();
+        mTimeSubdivided.clear();
+        mTimeSincePlayerLeft.clear();
+        std::fill(mSlots.begin(), mSlots.end(), 0);
     }
 }
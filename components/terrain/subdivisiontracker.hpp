@@ -1,31 +1,21 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_SUBDIVISIONTRACKER_H
 #define OPENMW_COMPONENTS_TERRAIN_SUBDIVISIONTRACKER_H
 
-#include <map>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include <osg/Vec2f>
 
 namespace Terrain
 {
     /// Tracks which chunks should remain subdivided to create a "trail" effect
     /// Chunks stay subdivided even after player leaves, creating visible snow paths
+    /// @note Chunk state is kept in dense arrays indexed by an open addressing hash table, so lookups are O(1) and
+    /// the per-frame sweep walks contiguous memory no matter how long the trail history grows.
     class SubdivisionTracker
     {
     public:
-        struct ChunkSubdivisionData
-        {
-            int subdivisionLevel;      // Current subdivision level (0-2)
-            float timeSubdivided;      // How long this chunk has been subdivided (seconds)
-            float timeSincePlayerLeft; // Time since player was last nearby (seconds)
-            osg::Vec2f chunkCenter;    // Chunk position for distance calculations
-
-            ChunkSubdivisionData()
-                : subdivisionLevel(0)
-                , timeSubdivided(0.0f)
-                , timeSincePlayerLeft(0.0f)
-                , chunkCenter(0.0f, 0.0f)
-            {}
-        };
-
         SubdivisionTracker();
 
         /// Update tracker each frame
@@ -36,7 +26,7 @@ namespace Terrain
         /// Get the subdivision level for a chunk at given position
         /// @param chunkCenter Chunk center in cell coordinates
         /// @param distance Distance from player to chunk center in world units
-        /// @return Subdivision level (0-2), or -1 if chunk should not be subdivided
+        /// @return Subdivision level (0-3)
         int getSubdivisionLevel(const osg::Vec2f& chunkCenter, float distance) const;
 
         /// Mark a chunk as subdivided (called when chunk is created with subdivision)
@@ -49,17 +39,27 @@ namespace Terrain
         void clear();
 
         /// Get number of currently tracked chunks
-        size_t getTrackedChunkCount() const { return mTrackedChunks.size(); }
+        size_t getTrackedChunkCount() const { return mKeys.size(); }
 
         /// Configuration
         void setMaxTrailTime(float seconds) { mMaxTrailTime = seconds; }
-        void setMaxTrailDistance(float units) { mMaxTrailDistance = units; }
+        /// Also resizes the index for the number of chunks that fit within the trail distance.
+        void setMaxTrailDistance(float units);
         void setDecayStartTime(float seconds) { mDecayStartTime = seconds; }
 
     private:
-        /// Map of chunk centers to their subdivision data
-        /// Key is chunk center rounded to avoid floating point precision issues
-        std::map<std::pair<int, int>, ChunkSubdivisionData> mTrackedChunks;
+        using Key = std::pair<int, int>;
+
+        /// Dense per-chunk state, element i of each array belongs to the same chunk
+        std::vector<Key> mKeys;
+        std::vector<osg::Vec2f> mCenters; // World coordinates for distance calculations
+        std::vector<int> mLevels;
+        std::vector<float> mTimeSubdivided;
+        std::vector<float> mTimeSincePlayerLeft;
+
+        /// Open addressing index with linear probing, 0 marks an empty slot, otherwise dense index + 1.
+        /// Size is always a power of two and kept at most half full.
+        std::vector<std::uint32_t> mSlots;
 
         /// Maximum time a chunk stays subdivided after player leaves (seconds)
         float mMaxTrailTime;
@@ -71,13 +71,25 @@ namespace Terrain
         float mDecayStartTime;
 
         /// Convert chunk center to integer key for map lookup
-        std::pair<int, int> chunkToKey(const osg::Vec2f& center) const;
+        /// Key is chunk center rounded to avoid floating point precision issues
+        static Key chunkToKey(const osg::Vec2f& center);
+
+        static std::size_t hashKey(const Key& key);
+
+        /// @return Index into the dense arrays, or mKeys.size() if the chunk is not tracked
+        std::size_t find(const Key& key) const;
+
+        std::size_t insert(const Key& key);
+
+        void erase(std::size_t index);
+
+        void rehash(std::size_t slotCount);
 
         /// Calculate if a chunk should still be subdivided based on time/distance
-        bool shouldMaintainSubdivision(const ChunkSubdivisionData& data, float distanceFromPlayer) const;
+        bool shouldMaintainSubdivision(float timeSincePlayerLeft, float distanceFromPlayer) const;
 
         /// Decay subdivision level based on time since player left
-        int calculateDecayedLevel(const ChunkSubdivisionData& data) const;
+        int calculateDecayedLevel(int level, float timeSincePlayerLeft) const;
     };
 }
 
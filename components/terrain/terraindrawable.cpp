@@ -86,6 +86,9 @@ namespace Terrain
 
         if (shadowcam)
         {
+            // The shadow casting program has no tessellation stages and cannot draw patches
+            if (getNumPrimitiveSets() != 0 && getPrimitiveSet(0)->getMode() == GL_PATCHES)
+                return;
             cv->addDrawableAndDepth(this, &matrix, depth);
             return;
         }
@@ -129,15 +129,16 @@ namespace Terrain
     ViewData* ViewDataMap::getViewData(
         osg::Object* viewer, const osg::Vec3f& viewPoint, const osg::Vec4i& activeGrid, bool& needsUpdate)
     {
-        ViewerMap::const_iterator found = mViewers.find(viewer);
+        const auto found = std::find_if(
+            mViewers.begin(), mViewers.end(), [&](const Viewer& v) { return v.mViewer == viewer; });
         ViewData* vd = nullptr;
         if (found == mViewers.end())
         {
             vd = createOrReuseView();
-            mViewers[viewer] = vd;
+            mViewers.push_back(Viewer{ viewer, vd });
         }
         else
-            vd = found->second;
+            vd = found->mViewData;
         needsUpdate = false;
 
         if (!(vd->suitableToUse(activeGrid)
@@ -205,13 +206,12 @@ namespace Terrain
 
     void ViewDataMap::clearUnusedViews(double referenceTime)
     {
-        for (ViewerMap::iterator it = mViewers.begin(); it != mViewers.end();)
-        {
-            if (it->second->getLastUsageTimeStamp() + mExpiryDelay < referenceTime)
-                mViewers.erase(it++);
-            else
-                ++it;
-        }
+        if (referenceTime == mLastClearTime)
+            return;
+        mLastClearTime = referenceTime;
+
+        std::erase_if(mViewers,
+            [&](const Viewer& v) { return v.mViewData->getLastUsageTimeStamp() + mExpiryDelay < referenceTime; });
         for (std::deque<ViewData*>::iterator it = mUsedViews.begin(); it != mUsedViews.end();)
         {
             if ((*it)->getLastUsageTimeStamp() + mExpiryDelay < referenceTime)
@@ -101,6 +101,7 @@ namespace Terrain
                      // LODs won't keep loading and unloading all the time.
             , mExpiryDelay(1.f)
             , mWorldUpdateRevision(0)
+            , mLastClearTime(0.0)
         {
         }
 
@@ -116,16 +117,26 @@ namespace Terrain
         float getReuseDistance() const { return mReuseDistance; }
 
     private:
-        std::list<ViewData> mViewVector;
+        // Views are never removed, so their addresses stay valid
+        std::deque<ViewData> mViewVector;
 
-        typedef std::map<osg::ref_ptr<osg::Object>, ViewData*> ViewerMap;
-        ViewerMap mViewers;
+        struct Viewer
+        {
+            osg::ref_ptr<osg::Object> mViewer;
+            ViewData* mViewData;
+        };
+
+        // There are only a few cameras, a linear search is faster than a tree lookup
+        std::vector<Viewer> mViewers;
 
         float mReuseDistance;
         float mExpiryDelay; // time in seconds for unused view to be removed
 
         unsigned int mWorldUpdateRevision;
 
+        // Views expire after a delay in seconds, so they are only checked once per frame
+        double mLastClearTime;
+
         std::deque<ViewData*> mUsedViews;
         std::deque<ViewData*> mUnusedViews;
     };
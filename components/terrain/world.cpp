@@ -132,6 +132,9 @@ namespace Terrain
             mCellBorder->destroyCellBorderGeometry(x, y);
 
         mLoadedCells.erase(std::pair<int, int>(x, y));
+
+        if (mSnowDeformationManager)
+            mSnowDeformationManager->invalidateSnowCoverage(x, y);
     }
 
     void World::setTargetFrameRate(float rate)
@@ -139,11 +142,30 @@ namespace Terrain
         mCompositeMapRenderer->setTargetFrameRate(rate);
     }
 
+    void World::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+    {
+        if (mChunkManager)
+            mChunkManager->setWorkQueue(workQueue);
+    }
+
+    void World::setCompositeMapCache(CompositeMapCache* cache)
+    {
+        if (mCompositeMapRenderer)
+            mCompositeMapRenderer->setCompositeMapCache(cache);
+        if (mChunkManager)
+            mChunkManager->setCompositeMapCache(cache);
+    }
+
     float World::getHeightAt(const osg::Vec3f& worldPos)
     {
         return mStorage->getHeightAt(worldPos, mWorldspace);
     }
 
+    void World::getHeightsAt(std::span<const osg::Vec3f> worldPos, std::span<float> heights)
+    {
+        mStorage->getHeightsAt(worldPos, mWorldspace, heights);
+    }
+
     void World::updateTextureFiltering()
     {
         if (mTextureManager)
@@ -152,10 +174,19 @@ namespace Terrain
             mChunkManager->updateTextureFiltering();
     }
 
+    void World::reportStats(unsigned int frameNumber, osg::Stats* stats)
+    {
+        if (mSnowDeformationManager)
+            mSnowDeformationManager->reportStats(frameNumber, stats);
+    }
+
     void World::clearAssociatedCaches()
     {
+        mStorage->clearCache();
         if (mChunkManager)
             mChunkManager->clearCache();
+        if (mSnowDeformationManager)
+            mSnowDeformationManager->clearSnowCoverage();
     }
 
     void World::enableHeightCullCallback(bool enable)
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <set>
+#include <span>
 
 #include <components/esm/refid.hpp>
 
@@ -28,12 +29,18 @@ namespace Loading
     class Reporter;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
     class Storage;
 
     class TextureManager;
     class ChunkManager;
+    class CompositeMapCache;
     class CompositeMapRenderer;
     class View;
     class HeightCullCallback;
@@ -59,12 +66,22 @@ namespace Terrain
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// Work queue used to rebuild snow subdivided chunks in the background.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
+        /// Read composite maps from this cache instead of rendering them, and store the rendered ones in it.
+        /// @note The cache must outlive the world.
+        void setCompositeMapCache(CompositeMapCache* cache);
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
 
         float getHeightAt(const osg::Vec3f& worldPos);
 
+        /// @see Storage::getHeightsAt
+        void getHeightsAt(std::span<const osg::Vec3f> worldPos, std::span<float> heights);
+
         /// Clears the cached land and landtexture data.
         /// @note Thread safe.
         virtual void clearAssociatedCaches();
@@ -99,7 +116,7 @@ namespace Terrain
 
         virtual void rebuildViews() {}
 
-        virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) {}
+        virtual void reportStats(unsigned int frameNumber, osg::Stats* stats);
 
         virtual void setViewDistance(float distance) {}
 
@@ -7,6 +7,7 @@
 #include <stdexcept>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/strings/simd.hpp>
 
 /* This file contains the code to translate from WINDOWS-1252 (native
    charset used in English version of Morrowind) to UTF-8. The library
@@ -49,7 +50,23 @@ namespace
 {
     std::string_view::iterator skipAscii(std::string_view input)
     {
-        return std::find_if(input.begin(), input.end(), [](unsigned char v) { return v == 0 || v >= 128; });
+        namespace Simd = Misc::StringUtils::Simd;
+        std::size_t i = 0;
+        for (; i + Simd::blockSize <= input.size(); i += Simd::blockSize)
+        {
+            const std::size_t offset = Simd::findZeroOrNonAscii(Simd::load(input.data() + i));
+            if (offset != Simd::blockSize)
+                return input.begin() + i + offset;
+        }
+        return std::find_if(input.begin() + i, input.end(), [](unsigned char v) { return v == 0 || v >= 128; });
+    }
+
+    // Copy the ASCII characters up to the next other character or null terminator in bulk
+    void copyAscii(std::string_view::iterator& it, std::string_view::iterator end, char*& out)
+    {
+        const auto ascii = skipAscii(std::string_view(it, end));
+        out = std::copy(it, ascii, out);
+        it = ascii;
     }
 
     std::span<const signed char> getTranslationArray(FromType sourceEncoding)
@@ -128,7 +145,12 @@ std::string_view StatelessUtf8Encoder::getUtf8(
 
     // Translate
     for (auto it = input.begin(); it != input.end() && *it != 0; ++it)
+    {
+        copyAscii(it, input.end(), out);
+        if (it == input.end() || *it == 0)
+            break;
         copyFromArray(*it, out);
+    }
 
     // Make sure that we wrote the correct number of bytes
     assert((out - buffer.data()) == (int)outlen);
@@ -166,7 +188,12 @@ std::string_view StatelessUtf8Encoder::getLegacyEnc(
 
     // Translate
     for (auto it = input.begin(); it != input.end() && *it != 0;)
+    {
+        copyAscii(it, input.end(), out);
+        if (it == input.end() || *it == 0)
+            break;
         copyFromArrayLegacyEnc(it, input.end(), out);
+    }
 
     // Make sure that we wrote the correct number of bytes
     assert((out - buffer.data()) == static_cast<int>(outlen));
@@ -208,6 +235,11 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLength(std::string_view in
         // lookup table.
         len += mTranslationArray[static_cast<unsigned char>(*it) * 6];
         ++it;
+
+        // Count the ASCII characters in between in bulk
+        const auto ascii = skipAscii(std::string_view(it, input.end()));
+        len += ascii - it;
+        it = ascii;
     } while (it != input.end() && *it != 0);
 
     return { len, false };
@@ -273,6 +305,14 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLengthLegacyEnc(std::strin
         }
 
         ++it;
+
+        // Count the ASCII characters in between in bulk, unless one of them completes a three byte symbol
+        if (symbolLen == 0)
+        {
+            const auto ascii = skipAscii(std::string_view(it, input.end()));
+            len += ascii - it;
+            it = ascii;
+        }
     } while (it != input.end() && *it != 0);
 
     return { len, false };
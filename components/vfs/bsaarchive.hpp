@@ -14,7 +14,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 
 namespace VFS
 {
@@ -56,6 +58,15 @@ namespace VFS
             return out;
         }
 
+        std::optional<StoredRange> getStoredRange() const override
+        {
+            // Only Morrowind archives store files as they are
+            if constexpr (std::is_same_v<FileType, Bsa::BSAFile>)
+                return StoredRange{ &mFile->getFile()->getPath(), mInfo->mOffset, mInfo->mFileSize };
+            else
+                return std::nullopt;
+        }
+
         const Bsa::BSAFile::FileStruct* mInfo;
         const BsaArchive<FileType>* mFile;
     };
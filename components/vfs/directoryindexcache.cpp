@@ -0,0 +1,232 @@
+#include "directoryindexcache.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+
+namespace VFS
+{
+    namespace
+    {
+        constexpr std::array<char, 8> signature = { 'O', 'M', 'W', 'V', 'F', 'S', 'I', 'C' };
+        constexpr std::uint32_t formatVersion = 1;
+
+        // Guard against allocating for garbage when reading a damaged file
+        constexpr std::uint32_t maxStringSize = 64 * 1024;
+
+        std::int64_t getLastModified(const std::filesystem::path& dir)
+        {
+            std::error_code ec;
+            const std::filesystem::file_time_type time = std::filesystem::last_write_time(dir, ec);
+            if (ec != std::error_code())
+                throw std::runtime_error("Failed to get modification time of \"" + Files::pathToUnicodeString(dir)
+                    + "\": " + ec.message());
+            return static_cast<std::int64_t>(time.time_since_epoch().count());
+        }
+
+        std::string join(const std::string& relative, const std::string& name)
+        {
+            if (relative.empty())
+                return name;
+            return relative + '/' + name;
+        }
+
+        void writeUInt(std::ostream& stream, std::uint64_t value, std::size_t size)
+        {
+            char buffer[sizeof(std::uint64_t)];
+            std::memcpy(buffer, &value, sizeof(value));
+            stream.write(buffer, static_cast<std::streamsize>(size));
+        }
+
+        void writeString(std::ostream& stream, const std::string& value)
+        {
+            writeUInt(stream, value.size(), sizeof(std::uint32_t));
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        void writeStrings(std::ostream& stream, const std::vector<std::string>& values)
+        {
+            writeUInt(stream, values.size(), sizeof(std::uint32_t));
+            for (const std::string& value : values)
+                writeString(stream, value);
+        }
+
+        std::uint64_t readUInt(std::istream& stream, std::size_t size)
+        {
+            std::uint64_t value = 0;
+            char buffer[sizeof(std::uint64_t)] = {};
+            if (!stream.read(buffer, static_cast<std::streamsize>(size)))
+                throw std::runtime_error("unexpected end of file");
+            std::memcpy(&value, buffer, sizeof(value));
+            return value;
+        }
+
+        std::uint32_t readCount(std::istream& stream)
+        {
+            return static_cast<std::uint32_t>(readUInt(stream, sizeof(std::uint32_t)));
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            const std::uint32_t size = readCount(stream);
+            if (size > maxStringSize)
+                throw std::runtime_error("string is too long: " + std::to_string(size));
+            std::string result(size, '\0');
+            if (!stream.read(result.data(), size))
+                throw std::runtime_error("unexpected end of file");
+            return result;
+        }
+
+        std::vector<std::string> readStrings(std::istream& stream)
+        {
+            const std::uint32_t count = readCount(stream);
+            std::vector<std::string> result;
+            for (std::uint32_t i = 0; i < count; ++i)
+                result.push_back(readString(stream));
+            return result;
+        }
+    }
+
+    DirectoryIndexCache::DirectoryIndexCache(std::filesystem::path file)
+        : mFile(std::move(file))
+    {
+        try
+        {
+            load();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load VFS index cache " << mFile << ", data directories will be scanned: "
+                                << e.what();
+            mCached.clear();
+        }
+    }
+
+    void DirectoryIndexCache::load()
+    {
+        std::ifstream stream(mFile, std::ios::binary);
+        if (!stream.is_open())
+            return;
+
+        std::array<char, signature.size()> fileSignature;
+        if (!stream.read(fileSignature.data(), fileSignature.size()) || fileSignature != signature)
+            throw std::runtime_error("invalid signature");
+
+        if (const std::uint32_t version = readCount(stream); version != formatVersion)
+            throw std::runtime_error("unsupported version: " + std::to_string(version));
+
+        const std::uint32_t rootCount = readCount(stream);
+        for (std::uint32_t i = 0; i < rootCount; ++i)
+        {
+            Directories& directories = mCached[Files::pathFromUnicodeString(readString(stream))];
+            const std::uint32_t directoryCount = readCount(stream);
+            for (std::uint32_t j = 0; j < directoryCount; ++j)
+            {
+                Directory& directory = directories[readString(stream)];
+                directory.mLastModified = static_cast<std::int64_t>(readUInt(stream, sizeof(std::int64_t)));
+                directory.mFiles = readStrings(stream);
+                directory.mSubdirectories = readStrings(stream);
+            }
+        }
+    }
+
+    std::vector<std::string> DirectoryIndexCache::listFiles(const std::filesystem::path& root)
+    {
+        const auto cached = mCached.find(root);
+        Directories& listed = mListed[root];
+        listed.clear();
+
+        std::vector<std::string> result;
+        collect(root, std::string(), cached == mCached.end() ? nullptr : &cached->second, listed, result);
+        return result;
+    }
+
+    void DirectoryIndexCache::collect(const std::filesystem::path& root, const std::string& relative,
+        const Directories* cached, Directories& listed, std::vector<std::string>& files)
+    {
+        const std::filesystem::path dir = relative.empty() ? root : root / Files::pathFromUnicodeString(relative);
+        // Read the time before listing, so changes made while scanning are picked up on the next run
+        const std::int64_t lastModified = getLastModified(dir);
+
+        Directory& directory = listed[relative];
+        const auto found = cached == nullptr ? Directories::const_iterator() : cached->find(relative);
+        if (cached != nullptr && found != cached->end() && found->second.mLastModified == lastModified)
+        {
+            directory = found->second;
+        }
+        else
+        {
+            ++mScanned;
+            directory.mLastModified = lastModified;
+
+            std::error_code ec;
+            std::filesystem::directory_iterator it(dir, ec);
+            for (const std::filesystem::directory_iterator end; ec == std::error_code() && it != end; it.increment(ec))
+            {
+                const std::filesystem::directory_entry& entry = *it;
+                std::string name = Files::pathToUnicodeString(entry.path().filename());
+                if (!entry.is_directory())
+                    directory.mFiles.push_back(std::move(name));
+                else if (!entry.is_symlink())
+                    directory.mSubdirectories.push_back(std::move(name));
+            }
+            if (ec != std::error_code())
+                throw std::runtime_error(
+                    "Failed to iterate over \"" + Files::pathToUnicodeString(dir) + "\": " + ec.message());
+        }
+
+        for (const std::string& name : directory.mFiles)
+            files.push_back(join(relative, name));
+
+        // References to std::map elements stay valid while subdirectories are inserted
+        for (const std::string& name : directory.mSubdirectories)
+            collect(root, join(relative, name), cached, listed, files);
+    }
+
+    void DirectoryIndexCache::save() const
+    {
+        if (mScanned == 0 && mListed.size() == mCached.size())
+            return;
+
+        try
+        {
+            std::filesystem::create_directories(mFile.parent_path());
+
+            // Write to a temporary file first so other processes never read a partially written cache
+            std::filesystem::path temporary = mFile;
+            temporary += ".tmp";
+
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+
+                stream.write(signature.data(), signature.size());
+                writeUInt(stream, formatVersion, sizeof(std::uint32_t));
+                writeUInt(stream, mListed.size(), sizeof(std::uint32_t));
+                for (const auto& [root, directories] : mListed)
+                {
+                    writeString(stream, Files::pathToUnicodeString(root));
+                    writeUInt(stream, directories.size(), sizeof(std::uint32_t));
+                    for (const auto& [relative, directory] : directories)
+                    {
+                        writeString(stream, relative);
+                        writeUInt(stream, static_cast<std::uint64_t>(directory.mLastModified), sizeof(std::int64_t));
+                        writeStrings(stream, directory.mFiles);
+                        writeStrings(stream, directory.mSubdirectories);
+                    }
+                }
+            }
+
+            std::filesystem::rename(temporary, mFile);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save VFS index cache " << mFile << ": " << e.what();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef OPENMW_COMPONENTS_VFS_DIRECTORYINDEXCACHE_H
+#define OPENMW_COMPONENTS_VFS_DIRECTORYINDEXCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    /// @brief Listings of data directories kept on disk between runs.
+    /// @par A listing of a directory is reused while the directory modification time stays the same as when it was
+    /// scanned, that is as long as no entries were added, removed or renamed in it. Only changed directories are
+    /// scanned again, others just have their modification time checked.
+    class DirectoryIndexCache
+    {
+    public:
+        /// Load cached listings from the file, start empty if it doesn't exist or can't be read.
+        explicit DirectoryIndexCache(std::filesystem::path file);
+
+        /// Get paths of all files under the root, relative to it with '/' as separator.
+        /// @note Directories are not followed through symlinks, same as std::filesystem::recursive_directory_iterator.
+        std::vector<std::string> listFiles(const std::filesystem::path& root);
+
+        /// Write listings of all roots listed since construction when any of them changed.
+        void save() const;
+
+        /// Number of directories scanned because they were not cached or changed.
+        std::size_t getScannedCount() const { return mScanned; }
+
+    private:
+        struct Directory
+        {
+            std::int64_t mLastModified = 0;
+            std::vector<std::string> mFiles;
+            std::vector<std::string> mSubdirectories;
+        };
+
+        /// Keyed by path relative to the root, the root itself is an empty string.
+        using Directories = std::map<std::string, Directory>;
+
+        std::filesystem::path mFile;
+        std::map<std::filesystem::path, Directories> mCached;
+        std::map<std::filesystem::path, Directories> mListed;
+        std::size_t mScanned = 0;
+
+        void load();
+
+        void collect(const std::filesystem::path& root, const std::string& relative, const Directories* cached,
+            Directories& listed, std::vector<std::string>& files);
+    };
+}
+
+#endif
@@ -1,13 +1,23 @@
 #ifndef OPENMW_COMPONENTS_VFS_FILE_H
 #define OPENMW_COMPONENTS_VFS_FILE_H
 
+#include <cstddef>
 #include <filesystem>
+#include <optional>
 #include <string>
 
 #include <components/files/istreamptr.hpp>
 
 namespace VFS
 {
+    /// Bytes of a file on disk holding the contents of a VFS file as they are
+    struct StoredRange
+    {
+        const std::filesystem::path* mPath;
+        std::size_t mOffset;
+        std::size_t mSize;
+    };
+
     class File
     {
     public:
@@ -18,6 +28,9 @@ namespace VFS
         virtual std::filesystem::file_time_type getLastModified() const = 0;
 
         virtual std::string getStem() const = 0;
+
+        /// @return Nothing when the contents need decoding, e.g. compressed archives
+        virtual std::optional<StoredRange> getStoredRange() const { return std::nullopt; }
     };
 }
 
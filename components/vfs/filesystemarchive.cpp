@@ -2,6 +2,7 @@
 
 #include <filesystem>
 
+#include "directoryindexcache.hpp"
 #include "pathutil.hpp"
 
 #include <components/debug/debuglog.hpp>
@@ -30,14 +31,7 @@ namespace VFS
             {
                 const std::filesystem::path& filePath = entry.path();
                 const std::string proper = Files::pathToUnicodeString(filePath);
-                VFS::Path::Normalized searchable(std::string_view{ proper }.substr(prefix));
-                FileSystemArchiveFile file(filePath);
-
-                const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
-                if (!inserted.second)
-                    Log(Debug::Warning)
-                        << "Found duplicate file for '" << proper
-                        << "', please check your file system for two files with the same name in different cases.";
+                addFile(std::string_view{ proper }.substr(prefix), filePath);
             }
 
             // Exception thrown by the operator++ may not contain the context of the error like what exact path caused
@@ -53,6 +47,22 @@ namespace VFS
         }
     }
 
+    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path, DirectoryIndexCache& cache)
+        : mPath(path)
+    {
+        for (const std::string& relativePath : cache.listFiles(mPath))
+            addFile(relativePath, mPath / Files::pathFromUnicodeString(relativePath));
+    }
+
+    void FileSystemArchive::addFile(std::string_view relativePath, const std::filesystem::path& filePath)
+    {
+        const auto inserted = mIndex.emplace(VFS::Path::Normalized(relativePath), FileSystemArchiveFile(filePath));
+        if (!inserted.second)
+            Log(Debug::Warning)
+                << "Found duplicate file for '" << Files::pathToUnicodeString(filePath)
+                << "', please check your file system for two files with the same name in different cases.";
+    }
+
     void FileSystemArchive::listResources(FileMap& out)
     {
         for (auto& [k, v] : mIndex)
@@ -91,4 +101,13 @@ namespace VFS
         return Files::pathToUnicodeString(mPath.stem());
     }
 
+    std::optional<StoredRange> FileSystemArchiveFile::getStoredRange() const
+    {
+        std::error_code ec;
+        const std::uintmax_t size = std::filesystem::file_size(mPath, ec);
+        if (ec)
+            return std::nullopt;
+        return StoredRange{ &mPath, 0, static_cast<std::size_t>(size) };
+    }
+
 }
@@ -6,9 +6,11 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 namespace VFS
 {
+    class DirectoryIndexCache;
 
     class FileSystemArchiveFile : public File
     {
@@ -21,6 +23,8 @@ namespace VFS
 
         std::string getStem() const override;
 
+        std::optional<StoredRange> getStoredRange() const override;
+
     private:
         std::filesystem::path mPath;
     };
@@ -30,6 +34,9 @@ namespace VFS
     public:
         FileSystemArchive(const std::filesystem::path& path);
 
+        /// Take the listing of the directory from the cache, only changed subdirectories are scanned.
+        FileSystemArchive(const std::filesystem::path& path, DirectoryIndexCache& cache);
+
         void listResources(FileMap& out) override;
 
         bool contains(Path::NormalizedView file) const override;
@@ -39,6 +46,8 @@ namespace VFS
     private:
         std::map<VFS::Path::Normalized, FileSystemArchiveFile, std::less<>> mIndex;
         std::filesystem::path mPath;
+
+        void addFile(std::string_view relativePath, const std::filesystem::path& filePath);
     };
 
 }
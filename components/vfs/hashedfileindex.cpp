@@ -0,0 +1,49 @@
+#include "hashedfileindex.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "pathutil.hpp"
+
+namespace VFS
+{
+    void HashedFileIndex::build(const FileMap& files)
+    {
+        mSlots.assign(std::bit_ceil(std::max<std::size_t>(files.size() * 2, 16)), Slot{});
+        mSize = files.size();
+
+        const std::size_t mask = mSlots.size() - 1;
+        for (const auto& [path, file] : files)
+        {
+            const std::size_t hash = Path::Hash{}(path.view());
+            std::size_t index = hash & mask;
+            // Keys are unique in the map, so there is no need to compare the paths here
+            while (!mSlots[index].isEmpty())
+                index = (index + 1) & mask;
+            mSlots[index] = Slot{ .mHash = hash, .mPath = path.view(), .mFile = file };
+        }
+    }
+
+    void HashedFileIndex::clear()
+    {
+        mSlots.clear();
+        mSize = 0;
+    }
+
+    File* HashedFileIndex::find(std::string_view normalizedPath) const
+    {
+        if (mSlots.empty())
+            return nullptr;
+
+        const std::size_t hash = Path::Hash{}(normalizedPath);
+        const std::size_t mask = mSlots.size() - 1;
+        for (std::size_t index = hash & mask;; index = (index + 1) & mask)
+        {
+            const Slot& slot = mSlots[index];
+            if (slot.isEmpty())
+                return nullptr;
+            if (slot.mHash == hash && slot.mPath == normalizedPath)
+                return slot.mFile;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef OPENMW_COMPONENTS_VFS_HASHEDFILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_HASHEDFILEINDEX_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "filemap.hpp"
+
+namespace VFS
+{
+    /// @brief Flat open addressing hash index over a FileMap for lookups by normalized path without tree walks.
+    /// @note Keys refer to the paths stored in the FileMap the index was built from, so the map must outlive the
+    /// index and stay unmodified until the index is rebuilt or cleared.
+    /// @note Lookups are thread safe, building is not.
+    class HashedFileIndex
+    {
+    public:
+        void build(const FileMap& files);
+
+        void clear();
+
+        /// @return File for the normalized path or nullptr if there is none.
+        File* find(std::string_view normalizedPath) const;
+
+        std::size_t size() const { return mSize; }
+
+    private:
+        struct Slot
+        {
+            std::size_t mHash = 0;
+            std::string_view mPath;
+            File* mFile = nullptr;
+
+            bool isEmpty() const { return mPath.data() == nullptr; }
+        };
+
+        /// Size is always a power of two and kept at most half full.
+        std::vector<Slot> mSlots;
+        std::size_t mSize = 0;
+    };
+}
+
+#endif
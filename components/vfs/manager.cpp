@@ -10,6 +10,7 @@
 #include "archive.hpp"
 #include "file.hpp"
 #include "pathutil.hpp"
+#include "readaheadcache.hpp"
 #include "recursivedirectoryiterator.hpp"
 
 namespace VFS
@@ -20,6 +21,9 @@ namespace VFS
 
     void Manager::reset()
     {
+        if (mReadAheadCache != nullptr)
+            mReadAheadCache = std::make_unique<ReadAheadCache>(mReadAheadCache->getMaxSize());
+        mHashedIndex.clear();
         mIndex.clear();
         mArchives.clear();
     }
@@ -31,10 +35,33 @@ namespace VFS
 
     void Manager::buildIndex()
     {
+        mHashedIndex.clear();
         mIndex.clear();
 
         for (const auto& archive : mArchives)
             archive->listResources(mIndex);
+
+        mHashedIndex.build(mIndex);
+    }
+
+    void Manager::setReadAheadCacheSize(std::size_t size)
+    {
+        if (size == 0)
+            mReadAheadCache = nullptr;
+        else
+            mReadAheadCache = std::make_unique<ReadAheadCache>(size);
+    }
+
+    void Manager::prefetch(std::span<const Path::Normalized> names) const
+    {
+        if (mReadAheadCache == nullptr)
+            return;
+        std::vector<const File*> files;
+        files.reserve(names.size());
+        for (const Path::Normalized& name : names)
+            if (const File* const file = mHashedIndex.find(name.view()))
+                files.push_back(file);
+        mReadAheadCache->prefetch(files);
     }
 
     Files::IStreamPtr Manager::find(Path::NormalizedView name) const
@@ -63,12 +90,12 @@ namespace VFS
 
     bool Manager::exists(const Path::Normalized& name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mHashedIndex.find(name.view()) != nullptr;
     }
 
     bool Manager::exists(Path::NormalizedView name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mHashedIndex.find(name.value()) != nullptr;
     }
 
     std::string Manager::getArchive(const Path::Normalized& name) const
@@ -83,18 +110,18 @@ namespace VFS
 
     std::filesystem::file_time_type Manager::getLastModified(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = mHashedIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getLastModified();
+        return file->getLastModified();
     }
 
     std::string Manager::getStem(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = mHashedIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getStem();
+        return file->getStem();
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
@@ -129,9 +156,12 @@ namespace VFS
     Files::IStreamPtr Manager::findNormalized(std::string_view normalizedPath) const
     {
         assert(Path::isNormalized(normalizedPath));
-        const auto it = mIndex.find(normalizedPath);
-        if (it == mIndex.end())
+        File* const file = mHashedIndex.find(normalizedPath);
+        if (file == nullptr)
             return nullptr;
-        return it->second->open();
+        if (mReadAheadCache != nullptr)
+            if (Files::IStreamPtr stream = mReadAheadCache->take(*file))
+                return stream;
+        return file->open();
     }
 }
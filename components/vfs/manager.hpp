@@ -5,16 +5,19 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "filemap.hpp"
+#include "hashedfileindex.hpp"
 #include "pathutil.hpp"
 
 namespace VFS
 {
     class Archive;
+    class ReadAheadCache;
     class RecursiveDirectoryRange;
 
     /// @brief The main class responsible for loading files from a virtual file system.
@@ -39,6 +42,14 @@ namespace VFS
         /// Build the file index. Should be called when all archives have been registered.
         void buildIndex();
 
+        /// Keep up to the given number of bytes read ahead by prefetch, 0 disables read ahead.
+        void setReadAheadCacheSize(std::size_t size);
+
+        /// Read the files in the order they are stored in the archives, so the following get calls don't have to
+        /// seek. Unknown files are ignored. Does nothing when read ahead is disabled.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(std::span<const Path::Normalized> names) const;
+
         /// Does a file with this name exist?
         /// @note May be called from any thread once the index has been built.
         bool exists(const Path::Normalized& name) const;
@@ -74,8 +85,14 @@ namespace VFS
     private:
         std::vector<std::unique_ptr<Archive>> mArchives;
 
+        /// Sorted for directory iteration
         FileMap mIndex;
 
+        /// Used for lookups by name
+        HashedFileIndex mHashedIndex;
+
+        std::unique_ptr<ReadAheadCache> mReadAheadCache;
+
         inline Files::IStreamPtr findNormalized(std::string_view normalizedPath) const;
 
         /// Retrieve a file by name (name is already normalized).
@@ -0,0 +1,186 @@
+#include "readaheadcache.hpp"
+
+#include "file.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/constrainedfilestream.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace VFS
+{
+    namespace
+    {
+        // Reading through a gap this small is cheaper than seeking over it
+        constexpr std::size_t maxGap = 64 * 1024;
+        constexpr std::size_t maxBlockSize = 8 * 1024 * 1024;
+
+        class BlockInputStream final : public Files::MemBuf, public std::istream
+        {
+        public:
+            explicit BlockInputStream(
+                std::shared_ptr<const std::vector<char>> block, std::size_t offset, std::size_t size)
+                : Files::MemBuf(block->data() + offset, size)
+                , std::istream(static_cast<std::streambuf*>(this))
+                , mBlock(std::move(block))
+            {
+            }
+
+        private:
+            std::shared_ptr<const std::vector<char>> mBlock;
+        };
+
+        struct Request
+        {
+            const File* mFile;
+            StoredRange mRange;
+        };
+
+        bool isSameStorage(const StoredRange& lhs, const StoredRange& rhs)
+        {
+            return lhs.mPath == rhs.mPath || *lhs.mPath == *rhs.mPath;
+        }
+
+        std::vector<char> readBlock(const std::filesystem::path& path, std::size_t offset, std::size_t size)
+        {
+            std::vector<char> result(size);
+            const Files::IStreamPtr stream = Files::openConstrainedFileStream(path, offset, size);
+            stream->read(result.data(), static_cast<std::streamsize>(size));
+            if (static_cast<std::size_t>(stream->gcount()) != size)
+                throw std::runtime_error("Unexpected end of file");
+            return result;
+        }
+    }
+
+    ReadAheadCache::ReadAheadCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    void ReadAheadCache::prefetch(std::span<const File* const> files)
+    {
+        std::vector<Request> requests;
+        requests.reserve(files.size());
+
+        {
+            const std::lock_guard lock(mMutex);
+            for (const File* file : files)
+            {
+                if (file == nullptr || mEntries.contains(file))
+                    continue;
+                const std::optional<StoredRange> range = file->getStoredRange();
+                if (!range.has_value() || range->mSize == 0 || range->mSize > maxBlockSize)
+                    continue;
+                requests.push_back(Request{ file, *range });
+            }
+        }
+
+        std::sort(requests.begin(), requests.end(), [](const Request& lhs, const Request& rhs) {
+            return std::tie(*lhs.mRange.mPath, lhs.mRange.mOffset, lhs.mFile)
+                < std::tie(*rhs.mRange.mPath, rhs.mRange.mOffset, rhs.mFile);
+        });
+        requests.erase(std::unique(requests.begin(), requests.end(),
+                           [](const Request& lhs, const Request& rhs) { return lhs.mFile == rhs.mFile; }),
+            requests.end());
+
+        // Older entries make room for the new ones, but a single batch can not take more than the whole cache
+        std::size_t budget = mMaxSize;
+        std::vector<std::pair<const File*, Entry>> entries;
+
+        for (auto begin = requests.begin(); begin != requests.end();)
+        {
+            const std::size_t start = begin->mRange.mOffset;
+            std::size_t end = start + begin->mRange.mSize;
+            auto last = std::next(begin);
+            for (; last != requests.end(); ++last)
+            {
+                const StoredRange& range = last->mRange;
+                const std::size_t rangeEnd = range.mOffset + range.mSize;
+                if (!isSameStorage(begin->mRange, range) || range.mOffset > end + maxGap
+                    || std::max(end, rangeEnd) - start > maxBlockSize)
+                    break;
+                end = std::max(end, rangeEnd);
+            }
+
+            if (end - start > budget)
+                break;
+            budget -= end - start;
+
+            try
+            {
+                const Block block = std::make_shared<const std::vector<char>>(
+                    readBlock(*begin->mRange.mPath, start, end - start));
+                entries.clear();
+                for (auto it = begin; it != last; ++it)
+                    entries.emplace_back(it->mFile, Entry{ block, it->mRange.mOffset - start, it->mRange.mSize, 0 });
+                insert(entries);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read ahead " << (last - begin) << " file(s) from "
+                                    << Files::pathToUnicodeString(*begin->mRange.mPath) << ": " << e.what();
+            }
+
+            begin = last;
+        }
+    }
+
+    Files::IStreamPtr ReadAheadCache::take(const File& file)
+    {
+        // Avoid locking when read ahead is not used
+        if (mSize.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+
+        const std::lock_guard lock(mMutex);
+        const auto it = mEntries.find(&file);
+        if (it == mEntries.end())
+            return nullptr;
+        Entry entry = std::move(it->second);
+        mEntries.erase(it);
+        mSize -= entry.mSize;
+        return std::make_unique<BlockInputStream>(std::move(entry.mBlock), entry.mOffset, entry.mSize);
+    }
+
+    void ReadAheadCache::insert(std::span<const std::pair<const File*, Entry>> entries)
+    {
+        const std::lock_guard lock(mMutex);
+
+        for (const auto& [file, entry] : entries)
+        {
+            const std::size_t generation = ++mGeneration;
+            if (!mEntries.emplace(file, Entry{ entry.mBlock, entry.mOffset, entry.mSize, generation }).second)
+                continue;
+            mSize += entry.mSize;
+            mOrder.emplace_back(file, generation);
+        }
+
+        const auto isStale = [&](const std::pair<const File*, std::size_t>& item) {
+            const auto it = mEntries.find(item.first);
+            return it == mEntries.end() || it->second.mGeneration != item.second;
+        };
+
+        while (mSize > mMaxSize && !mOrder.empty())
+        {
+            const auto item = mOrder.front();
+            mOrder.pop_front();
+            if (isStale(item))
+                continue;
+            const auto it = mEntries.find(item.first);
+            mSize -= it->second.mSize;
+            mEntries.erase(it);
+        }
+
+        // Files handed out leave their items behind
+        if (mOrder.size() > 2 * mEntries.size() + 64)
+            std::erase_if(mOrder, isStale);
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_VFS_READAHEADCACHE_H
+#define OPENMW_COMPONENTS_VFS_READAHEADCACHE_H
+
+#include <components/files/istreamptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace VFS
+{
+    class File;
+
+    /// @brief Holds contents of files read ahead of time in the order they are stored on disk.
+    /// @par Files requested together are sorted by the file holding them and by offset, neighbours with small gaps
+    /// in between are read in one go. Seeking is expensive on spinning disks and network storage, reading a few
+    /// extra bytes is not.
+    /// @par Each file is handed out once, the resource caches keep what is loaded from it afterwards. When the cache
+    /// is full the files read ahead first are dropped first.
+    /// @note Thread safe.
+    class ReadAheadCache
+    {
+    public:
+        explicit ReadAheadCache(std::size_t maxSize);
+
+        /// Read the files that are not cached yet. Files without stored range are ignored.
+        void prefetch(std::span<const File* const> files);
+
+        /// @return Stream over the cached contents of the file removing it from the cache or nullptr if there are
+        /// none.
+        Files::IStreamPtr take(const File& file);
+
+        std::size_t getSize() const { return mSize; }
+
+        std::size_t getMaxSize() const { return mMaxSize; }
+
+    private:
+        using Block = std::shared_ptr<const std::vector<char>>;
+
+        struct Entry
+        {
+            Block mBlock;
+            std::size_t mOffset;
+            std::size_t mSize;
+            std::size_t mGeneration;
+        };
+
+        const std::size_t mMaxSize;
+        std::atomic<std::size_t> mSize{ 0 };
+        std::mutex mMutex;
+        std::unordered_map<const File*, Entry> mEntries;
+        // Oldest first, generations tell whether a file was handed out and read ahead again in the meantime
+        std::deque<std::pair<const File*, std::size_t>> mOrder;
+        std::size_t mGeneration = 0;
+
+        void insert(std::span<const std::pair<const File*, Entry>> entries);
+    };
+}
+
+#endif
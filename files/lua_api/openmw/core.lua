@@ -295,6 +295,14 @@
 -- @type ObjectList
 -- @list <#GameObject>
 
+---
+-- Send local event to every object in the list.
+-- Faster than calling @{#GameObject.sendEvent} for each object because eventData is serialized only once.
+-- @function [parent=#ObjectList] sendEvent
+-- @param self
+-- @param #string eventName
+-- @param eventData
+
 
 ---
 -- A cell of the game world.
@@ -447,6 +455,16 @@
 -- local all = playerInventory:getAll()
 -- local weapons = playerInventory:getAll(types.Weapon)
 
+---
+-- Iterate over the record ids and counts of all item stacks without creating a @{#GameObject} for each item.
+-- The items are copied when the loop starts, so the inventory can be changed inside it.
+-- @function [parent=#Inventory] records
+-- @param self
+-- @return #function
+-- @usage for recordId, count in inventory:records() do
+--     print(recordId, count)
+-- end
+
 ---
 -- Get first item with given recordId from the inventory. Returns nil if not found.
 -- @function [parent=#Inventory] find
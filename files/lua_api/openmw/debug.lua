@@ -89,4 +89,16 @@
 ---
 -- To reload modified shaders
 -- @function [parent=#Debug] triggerShaderReload
+
+---
+-- Estimated memory usage of a subsystem, in bytes
+-- @type MemoryUsage
+-- @field #number cpu
+-- @field #number gpu
+
+---
+-- Estimated memory usage of the engine subsystems, collected about once a second
+-- @function [parent=#Debug] getMemoryUsage
+-- @return #map<#string, #MemoryUsage> Memory usage by subsystem name
+-- @usage for name, usage in pairs(debug.getMemoryUsage()) do print(name, usage.cpu, usage.gpu) end
 return nil
@@ -30,6 +30,17 @@
 -- List of nearby players. Currently (since multiplayer is not yet implemented) always has one element.
 -- @field [parent=#nearby] openmw.core#ObjectList players
 
+---
+-- Find objects of the list within the radius, sorted by distance (the closest first).
+-- Much faster than filtering the lists `activators`, `actors`, `containers`, `doors` and `items` in Lua,
+-- other lists are scanned linearly.
+-- @function [parent=#nearby] findInRadius
+-- @param openmw.util#Vector3 position
+-- @param #number radius
+-- @param openmw.core#ObjectList list For example `nearby.actors`.
+-- @return openmw.core#ObjectList
+-- @usage local closeActors = nearby.findInRadius(self.position, 1000, nearby.actors)
+
 ---
 -- Return an object by RefNum/FormId.
 -- Note: the function always returns @{openmw.core#GameObject} and doesn't validate that
@@ -89,6 +100,19 @@
 --     radius = 10,
 -- })
 
+---
+-- Cast several rays at once and return the first collision of each. Faster than calling `castRay` in a loop
+-- because the collision world is locked only once for the whole batch.
+-- @function [parent=#nearby] castRays
+-- @param #list<#table> rays A list of tables with fields `from` and `to` (@{openmw.util#Vector3}).
+-- @param #CastRayOptions options An optional table with additional optional arguments, applied to every ray
+-- @return #list<#RayCastingResult> Results in the same order as `rays`
+-- @usage local results = nearby.castRays({
+--     { from = self.position, to = self.position + util.vector3(0, 100, 0) },
+--     { from = self.position, to = self.position + util.vector3(100, 0, 0) },
+-- }, {ignore=self})
+-- if results[1].hit then print('obstacle ahead') end
+
 ---
 -- A table of parameters for @{#nearby.castRenderingRay} and @{#nearby.asyncCastRenderingRay}
 -- @type CastRenderingRayOptions
@@ -183,7 +207,8 @@
 -- @field [parent=#FindPathOptions] #table checkpoints an array of positions to build path over if possible.
 
 ---
--- A table of parameters for @{#nearby.findRandomPointAroundCircle} and @{#nearby.castNavigationRay}
+-- A table of parameters for @{#nearby.findRandomPointAroundCircle}, @{#nearby.castNavigationRay} and
+-- @{#nearby.castNavigationRays}
 -- @type NavMeshOptions
 -- @field [parent=#NavMeshOptions] #AgentBounds agentBounds Identifies which navmesh to use.
 -- @field [parent=#NavMeshOptions] #number includeFlags Allowed areas for agent to move, a sum of @{#NAVIGATOR_FLAGS}
@@ -253,6 +278,22 @@
 --     agentBounds = Actor.getPathfindingAgentBounds(self),
 -- })
 
+---
+-- Does the same as `castNavigationRay` for several rays at once. Faster than calling `castNavigationRay` in a loop
+-- because the navigation mesh is locked only once for the whole batch.
+-- @function [parent=#nearby] castNavigationRays
+-- @param #list<#table> rays A list of tables with fields `from` and `to` (@{openmw.util#Vector3}).
+-- @param #NavMeshOptions options An optional table with additional optional arguments, applied to every ray.
+-- @return #table Resulting positions with the same indices as `rays`, `nil` where the ray has no result. Iterate it
+-- with `for i = 1, #rays do` because `ipairs` stops at the first `nil`.
+-- @usage local positions = nearby.castNavigationRays({
+--     { from = self.position, to = self.position + util.vector3(500, 0, 0) },
+--     { from = self.position, to = self.position + util.vector3(0, 500, 0) },
+-- }, {
+--     agentBounds = Actor.getPathfindingAgentBounds(self),
+-- })
+-- if positions[1] then print('can walk to ' .. tostring(positions[1])) end
+
 ---
 -- Finds a nearest position on navigation mesh to the given position within given search area.
 -- @function [parent=#nearby] findNearestNavMeshPosition
@@ -73,7 +73,7 @@
 ---
 -- Subscribe to changes in this section.
 -- First argument of the callback is the name of the section (so one callback can be used for different sections).
--- The second argument is the changed key (or `nil` if `reset` was used and all values were changed at the same time)
+-- The second argument is the changed key (or `nil` if `reset` or `setValues` was used and several values were changed at the same time)
 -- @function [parent=#StorageSection] subscribe
 -- @param self
 -- @param openmw.async#Callback callback
@@ -123,4 +123,11 @@
 -- @param #string key
 -- @param #any value
 
+---
+-- Set several values at once; subscribers are called only once with `nil` as the changed key.
+-- Other values of the section are kept. Can not be used for global storage from a local script.
+-- @function [parent=#StorageSection] setValues
+-- @param self
+-- @param #table values
+
 return nil
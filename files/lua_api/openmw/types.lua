@@ -481,6 +481,20 @@
 -- @param openmw.core#GameObject actor
 -- @return #DynamicStat
 
+---
+-- Read one property of the dynamic stats of many actors at once, without creating a @{#DynamicStat} for each of them.
+-- The result has three values per actor: health, magicka and fatigue. Values are nil for objects that are not available actors.
+-- @function [parent=#DynamicStats] getValues
+-- @param #any actors @{openmw.core#ObjectList} or a list of @{openmw.core#GameObject}
+-- @param #string property "base", "current" or "modifier"
+-- @param #table result (optional) a table to fill and return instead of creating a new one; reusing it avoids garbage
+-- @return #table
+-- @usage local values = {}
+-- types.Actor.stats.dynamic.getValues(party, 'current', values)
+-- for i, actor in ipairs(party) do
+--     local health, magicka, fatigue = values[3 * i - 2], values[3 * i - 1], values[3 * i]
+-- end
+
 ---
 -- @type AIStats
 
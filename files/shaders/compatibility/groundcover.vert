@@ -117,6 +117,15 @@ mat4 rotation(in vec3 angle)
         0.0, 0.0, 0.0, 1.0);
 }
 
+// Stable random value of an instance, the density falls off from half of the rendering distance
+bool isInstanceVisible(vec2 worldPos, float distance)
+{
+    if (distance > @groundcoverFadeEnd)
+        return false;
+    float density = mix(1.0, @groundcoverDistantDensity, clamp(distance * 2.0 / @groundcoverFadeEnd - 1.0, 0.0, 1.0));
+    return fract(sin(dot(floor(worldPos), vec2(12.9898, 78.233))) * 43758.5453) < density;
+}
+
 mat3 rotation3(in mat4 rot4)
 {
     return mat3(
@@ -142,7 +151,8 @@ void main(void)
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
 
-    if (length(gl_ModelViewMatrix * vec4(position, 1.0)) > @groundcoverFadeEnd)
+    vec4 instanceViewPos = gl_ModelViewMatrix * vec4(position, 1.0);
+    if (!isInstanceVisible((osg_ViewMatrixInverse * instanceViewPos).xy, length(instanceViewPos.xyz)))
         gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
     else
         gl_Position = viewToClip(viewPos);
@@ -0,0 +1,36 @@
+#if @objectInstancing
+// Set per batch by MWRender::ObjectPaging, each row of the texture holds the first three rows of an instance transform
+uniform bool useInstancing;
+uniform sampler2D instanceTransforms;
+uniform float instanceCount;
+
+vec4 getInstanceRow(float row)
+{
+    vec2 uv = vec2((row + 0.5) / 3.0, (float(gl_InstanceIDARB) + 0.5) / instanceCount);
+    return texture2DLod(instanceTransforms, uv, 0.0);
+}
+#endif
+
+vec4 instancePosition(vec4 position)
+{
+#if @objectInstancing
+    if (useInstancing)
+        return vec4(dot(getInstanceRow(0.0), position), dot(getInstanceRow(1.0), position),
+            dot(getInstanceRow(2.0), position), position.w);
+#endif
+    return position;
+}
+
+void instanceVertex(inout vec4 position, inout vec3 normal, inout vec4 tangent)
+{
+#if @objectInstancing
+    if (!useInstancing)
+        return;
+    vec4 row0 = getInstanceRow(0.0);
+    vec4 row1 = getInstanceRow(1.0);
+    vec4 row2 = getInstanceRow(2.0);
+    position = vec4(dot(row0, position), dot(row1, position), dot(row2, position), position.w);
+    normal = vec3(dot(row0.xyz, normal), dot(row1.xyz, normal), dot(row2.xyz, normal));
+    tangent.xyz = vec3(dot(row0.xyz, tangent.xyz), dot(row1.xyz, tangent.xyz), dot(row2.xyz, tangent.xyz));
+#endif
+}
@@ -0,0 +1,32 @@
+#if @gpuMorphing
+// Set per drawable by SceneUtil::MorphGeometry, the array size should match MorphGeometry::sMaxGpuMorphTargets
+uniform bool useGpuMorphing;
+uniform sampler2D morphTargets;
+// Width and height of the texture and the number of rows taken by each target
+uniform vec3 morphTextureLayout;
+uniform int morphTargetCount;
+uniform float morphWeights[32];
+
+attribute float morphVertexIndex;
+#endif
+
+vec4 morphPosition(vec4 position)
+{
+#if @gpuMorphing
+    if (!useGpuMorphing)
+        return position;
+
+    float column = mod(morphVertexIndex, morphTextureLayout.x);
+    float row = floor(morphVertexIndex / morphTextureLayout.x);
+    for (int i = 0; i < 32; ++i)
+    {
+        if (i >= morphTargetCount)
+            break;
+        if (morphWeights[i] == 0.0)
+            continue;
+        vec2 uv = vec2(column + 0.5, row + float(i) * morphTextureLayout.z + 0.5) / morphTextureLayout.xy;
+        position.xyz += texture2DLod(morphTargets, uv, 0.0).xyz * morphWeights[i];
+    }
+#endif
+    return position;
+}
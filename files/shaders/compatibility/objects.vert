@@ -8,6 +8,10 @@
     #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if @objectInstancing
+    #extension GL_ARB_draw_instanced : require
+#endif
+
 #include "lib/core/vertex.h.glsl"
 #if @diffuseMap
 varying vec2 diffuseMapUV;
@@ -68,6 +72,9 @@ varying vec4 passTangent;
 #include "vertexcolors.glsl"
 #include "shadows_vertex.glsl"
 #include "compatibility/normals.glsl"
+#include "compatibility/skinning.glsl"
+#include "compatibility/morphing.glsl"
+#include "compatibility/instancing.glsl"
 
 #include "lib/light/lighting.glsl"
 #include "lib/view/depth.glsl"
@@ -81,22 +88,28 @@ uniform mat4 osg_ViewMatrixInverse;
 
 void main(void)
 {
+    vec4 position = morphPosition(gl_Vertex);
+    vec3 normal = gl_Normal.xyz;
+    vec4 tangent = gl_MultiTexCoord7.xyzw;
+    skinVertex(position, normal, tangent);
+    instanceVertex(position, normal, tangent);
+
 #if @particleOcclusion
     mat4 model = osg_ViewMatrixInverse * gl_ModelViewMatrix;
-    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(gl_Vertex.xyz, 1.0)).xyz;
+    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(position.xyz, 1.0)).xyz;
 #endif
 
-    gl_Position = modelToClip(gl_Vertex);
+    gl_Position = modelToClip(position);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(position);
     gl_ClipVertex = viewPos;
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
     normalToViewMatrix = gl_NormalMatrix;
 
 #if @normalMap || @diffuseParallax
-    passTangent = gl_MultiTexCoord7.xyzw;
+    passTangent = tangent;
     normalToViewMatrix *= generateTangentSpace(passTangent, passNormal);
 #endif
 
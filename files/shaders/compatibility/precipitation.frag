@@ -0,0 +1,16 @@
+#version 120
+
+uniform sampler2D diffuseMap;
+uniform float precipitationAlpha;
+
+varying vec2 diffuseMapUV;
+varying vec3 passLighting;
+
+void main()
+{
+    vec4 color = texture2D(diffuseMap, diffuseMapUV);
+    color.xyz *= passLighting;
+    color.a *= precipitationAlpha;
+
+    gl_FragData[0] = color;
+}
@@ -0,0 +1,74 @@
+#version 120
+
+#if @useUBO
+    #extension GL_ARB_uniform_buffer_object : require
+#endif
+
+#if @useGPUShader4
+    #extension GL_EXT_gpu_shader4: require
+#endif
+
+#extension GL_ARB_draw_instanced : require
+
+#include "lib/core/vertex.h.glsl"
+#include "lib/light/lighting_util.glsl"
+
+// Drops are drawn relative to the camera, see MWRender::GpuPrecipitation
+uniform mat4 osg_ViewMatrixInverse;
+uniform vec3 precipitationRange;
+uniform vec3 precipitationOffset;
+uniform vec3 precipitationVelocity;
+// Minimum and maximum height, width relative to the height
+uniform vec3 dropSize;
+
+#if @particleOcclusion
+#include "lib/particle/occlusion.glsl"
+
+uniform sampler2D orthoDepthMap;
+uniform mat4 depthSpaceMatrix;
+#endif
+
+varying vec2 diffuseMapUV;
+varying vec3 passLighting;
+
+vec3 random3(float seed)
+{
+    return fract(sin(vec3(seed, seed + 17.0, seed + 43.0) * 0.7071) * vec3(43758.5453, 22578.1459, 19642.3490));
+}
+
+void main()
+{
+    vec3 random = random3(float(gl_InstanceIDARB));
+    vec3 cameraPos = osg_ViewMatrixInverse[3].xyz;
+    // Wrap the drops into the volume centered on the camera, like WrapAroundOperator does for the particle system
+    vec3 pos = mod(random * precipitationRange + precipitationOffset - cameraPos, precipitationRange)
+        - precipitationRange * 0.5;
+
+#if @particleOcclusion
+    // The whole drop is hidden, so it is enough to test its center
+    vec3 depthCoord = (depthSpaceMatrix * vec4(pos + cameraPos, 1.0)).xyz;
+    if (isOccluded(depthCoord, texture2DLod(orthoDepthMap, depthCoord.xy * 0.5 + 0.5, 0.0).r))
+    {
+        // Outside of the clip volume, the triangles of the drop are degenerate
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+        diffuseMapUV = vec2(0.0);
+        passLighting = vec3(0.0);
+        return;
+    }
+#endif
+
+    // Stretch the drop along its velocity and turn it to face the camera
+    vec4 viewCenter = modelToView(vec4(pos, 1.0));
+    vec3 axis = normalize(modelToView(vec4(precipitationVelocity, 0.0)).xyz);
+    vec3 side = cross(axis, normalize(viewCenter.xyz));
+    side = dot(side, side) > 1e-6 ? normalize(side) : vec3(1.0, 0.0, 0.0);
+
+    float height = mix(dropSize.x, dropSize.y, fract(random.x * 31.0));
+    vec4 viewPos = viewCenter + vec4(side * gl_Vertex.x * height * dropSize.z + axis * gl_Vertex.y * height, 0.0);
+
+    gl_Position = viewToClip(viewPos);
+    gl_ClipVertex = viewPos;
+
+    diffuseMapUV = gl_MultiTexCoord0.xy;
+    passLighting = clamp(gl_LightModel.ambient.xyz + lcalcDiffuse(0), 0.0, 1.0);
+}
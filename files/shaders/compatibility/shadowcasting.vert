@@ -1,5 +1,9 @@
 #version 120
 
+#if @objectInstancing
+    #extension GL_ARB_draw_instanced : require
+#endif
+
 varying vec2 diffuseMapUV;
 
 varying float alphaPassthrough;
@@ -9,11 +13,16 @@ uniform bool useTreeAnim;
 uniform bool useDiffuseMapForShadowAlpha = true;
 uniform bool alphaTestShadows = true;
 
+#include "compatibility/skinning.glsl"
+#include "compatibility/morphing.glsl"
+#include "compatibility/instancing.glsl"
+
 void main(void)
 {
-    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    vec4 position = instancePosition(skinPosition(morphPosition(gl_Vertex)));
+    gl_Position = gl_ModelViewProjectionMatrix * position;
 
-    vec4 viewPos = (gl_ModelViewMatrix * gl_Vertex);
+    vec4 viewPos = (gl_ModelViewMatrix * position);
     gl_ClipVertex = viewPos;
 
     if (useDiffuseMapForShadowAlpha)
@@ -0,0 +1,49 @@
+#if @gpuSkinning
+// Set per drawable by SceneUtil::RigGeometry, the array size should match RigGeometry::sMaxGpuBones
+uniform bool useGpuSkinning;
+uniform mat4 boneMatrices[64];
+uniform mat4 skinTransform;
+
+attribute vec4 boneIndices;
+attribute vec4 boneWeights;
+
+mat4 getSkinningMatrix()
+{
+    return boneMatrices[int(boneIndices.x)] * boneWeights.x
+        + boneMatrices[int(boneIndices.y)] * boneWeights.y
+        + boneMatrices[int(boneIndices.z)] * boneWeights.z
+        + boneMatrices[int(boneIndices.w)] * boneWeights.w;
+}
+#endif
+
+// Vertices without influences are left untouched, same as on the CPU
+bool hasSkinning()
+{
+#if @gpuSkinning
+    return useGpuSkinning && dot(boneWeights, vec4(1.0)) != 0.0;
+#else
+    return false;
+#endif
+}
+
+vec4 skinPosition(vec4 position)
+{
+#if @gpuSkinning
+    if (hasSkinning())
+        return skinTransform * vec4((getSkinningMatrix() * position).xyz, 1.0);
+#endif
+    return position;
+}
+
+void skinVertex(inout vec4 position, inout vec3 normal, inout vec4 tangent)
+{
+#if @gpuSkinning
+    if (!hasSkinning())
+        return;
+    mat4 skinning = getSkinningMatrix();
+    mat3 rotation = mat3(skinTransform) * mat3(skinning);
+    position = skinTransform * vec4((skinning * position).xyz, 1.0);
+    normal = rotation * normal;
+    tangent.xyz = rotation * tangent.xyz;
+#endif
+}
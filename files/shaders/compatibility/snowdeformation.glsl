@@ -0,0 +1,49 @@
+// Snow deformation shared by the terrain vertex and tessellation evaluation shaders
+uniform sampler2D snowDeformationMap;     // Page atlas (R=depth, G=age)
+uniform sampler2D snowDeformationPageTable; // Page indirection table (RG=atlas slot, A=resident)
+uniform vec2 snowDeformationPageTableOrigin; // World page coordinates of the first page table entry
+uniform vec4 snowDeformationPageParams;   // x=page world size, y=page table size, z=page resolution, w=atlas resolution
+uniform vec2 snowDeformationCenter;       // World XY center of the deforming area
+uniform float snowDeformationRadius;      // World radius of the deforming area
+uniform bool snowDeformationEnabled;      // Runtime enable/disable
+uniform vec3 chunkWorldOffset;            // Chunk's world position (for local->world conversion)
+uniform float snowRaiseAmount;            // How much to raise terrain (matches deformation depth)
+
+float sampleSnowDeformation(vec2 worldPos)
+{
+    // Find the page and its entry in the indirection table
+    vec2 pageCoord = worldPos / snowDeformationPageParams.x;
+    vec2 page = floor(pageCoord);
+    vec2 tableCoord = page - snowDeformationPageTableOrigin;
+    if (any(lessThan(tableCoord, vec2(0.0))) || any(greaterThanEqual(tableCoord, snowDeformationPageParams.yy)))
+        return 0.0;
+
+    // The table is addressed toroidally, the REPEAT wrap mode applies the modulo
+    vec4 entry = texture2D(snowDeformationPageTable, (page + 0.5) / snowDeformationPageParams.y);
+    if (entry.a < 0.5)
+        return 0.0;
+
+    // Texel centers span the page edge to edge, so bilinear filtering never reads a neighbouring slot
+    vec2 slot = floor(entry.rg * 255.0 + 0.5);
+    vec2 texel = slot * snowDeformationPageParams.z + 0.5 + (pageCoord - page) * (snowDeformationPageParams.z - 1.0);
+    return texture2D(snowDeformationMap, texel / snowDeformationPageParams.w).r;
+}
+
+vec4 applySnowDeformation(vec4 vertex)
+{
+    if (!snowDeformationEnabled)
+        return vertex;
+
+    // Convert vertex from chunk-local space to world space
+    // OpenMW: X = East/West, Y = North/South, Z = Up, so the ground plane is X-Y
+    vec3 worldPos = vertex.xyz + chunkWorldOffset;
+
+    // Sample deformation depth from the trail pages (R channel)
+    float deformationDepth = sampleSnowDeformation(worldPos.xy);
+
+    // Raise all snow terrain uniformly, then dig the trails back down
+    // - Untouched snow: raised by snowRaiseAmount
+    // - Where actors walked: back at ground level
+    vertex.z += snowRaiseAmount - deformationDepth;
+    return vertex;
+}
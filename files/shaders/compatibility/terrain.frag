@@ -20,6 +20,16 @@ uniform sampler2D normalMap;
 uniform sampler2D blendMap;
 #endif
 
+#if @packedLayers > 0
+uniform sampler2D diffuseMap1;
+uniform sampler2D blendMap1;
+#endif
+
+#if @packedLayers > 1
+uniform sampler2D diffuseMap2;
+uniform sampler2D blendMap2;
+#endif
+
 varying float euclideanDepth;
 varying float linearDepth;
 
@@ -60,7 +70,22 @@ void main()
 
 #if @blendMap
     vec2 blendMapUV = (gl_TextureMatrix[1] * vec4(uv, 0.0, 1.0)).xy;
-    gl_FragData[0].a *= texture2D(blendMap, blendMapUV).a;
+    float blend = texture2D(blendMap, blendMapUV).a;
+#if @packedLayers > 0
+    // Lighting and fog are linear in the diffuse texture, so packed layers are blended before them and give the same
+    // result as additional passes
+    vec3 blendedTex = diffuseTex.xyz * blend;
+    float packedBlend = texture2D(blendMap1, blendMapUV).a;
+    blendedTex += texture2D(diffuseMap1, adjustedUV).xyz * packedBlend;
+    blend += packedBlend;
+#if @packedLayers > 1
+    packedBlend = texture2D(blendMap2, blendMapUV).a;
+    blendedTex += texture2D(diffuseMap2, adjustedUV).xyz * packedBlend;
+    blend += packedBlend;
+#endif
+    gl_FragData[0].xyz = blendedTex / max(blend, 1e-4);
+#endif
+    gl_FragData[0].a *= blend;
 #endif
 
 #if @normalMap
@@ -32,15 +32,24 @@ varying vec3 passNormal;
 #include "lib/view/depth.glsl"
 
 // Snow deformation system - ALWAYS ENABLED FOR TESTING
-uniform sampler2D snowDeformationMap;     // Deformation texture (R=depth, G=age)
-uniform vec2 snowDeformationCenter;       // World XZ center of deformation texture
-uniform float snowDeformationRadius;      // World radius covered by texture
-uniform bool snowDeformationEnabled;      // Runtime enable/disable
-uniform vec3 chunkWorldOffset;            // Chunk's world position (for local->world conversion)
-uniform float snowRaiseAmount;            // How much to raise terrain (matches deformation depth)
+#include "compatibility/snowdeformation.glsl"
+
+#if @snowTessellation
+// Tessellated path: the control points are forwarded untouched and terrain.tese
+// deforms and lights the generated vertices
+varying vec3 tcNormal;
+varying vec4 tcColor;
+varying vec2 tcUV;
+#endif
 
 void main(void)
 {
+#if @snowTessellation
+    gl_Position = gl_Vertex;
+    tcNormal = gl_Normal.xyz;
+    tcColor = gl_Color;
+    tcUV = gl_MultiTexCoord0.xy;
+#else
     vec4 vertex = gl_Vertex;
 
     // SNOW DEFORMATION DIAGNOSTIC TEST
@@ -183,42 +192,13 @@ void main(void)
     //     if (deformationDepth > 0.01) vertex.z += 500.0;
     // }
 
-    if (snowDeformationEnabled)
-    {
-        // Convert vertex from chunk-local space to world space
-        vec3 worldPos = vertex.xyz + chunkWorldOffset;
-
-        // CRITICAL: OpenMW coordinate system
-        // X = East/West, Y = North/South, Z = Up/Down (altitude)
-        // Ground plane is X-Y, deformation is on Z axis
-        // Calculate relative position from deformation texture center (player position) on ground plane
-        vec2 relativePos = worldPos.xy - snowDeformationCenter;  // Use XY (ground plane)
-
-        // Convert world position to deformation texture UV coordinates (0-1)
-        vec2 deformUV = (relativePos / snowDeformationRadius) * 0.5 + 0.5;
-
-        // Sample deformation depth from trail texture (R channel)
-        float deformationDepth = texture2D(snowDeformationMap, deformUV).r;
-
-        // Apply deformation: raise ALL terrain uniformly, then subtract deformation depth
-        // snowRaiseAmount comes from C++ and matches the footprint depth exactly
-        // Deformation is applied to Z axis (vertical in OpenMW - Z is UP!)
-        vertex.z += snowRaiseAmount - deformationDepth;  // Deform Z (up)!
-
-        // This creates:
-        // - Untouched snow: vertex.z += snowRaiseAmount (raised terrain)
-        // - Where player walked: vertex.z += snowRaiseAmount - snowRaiseAmount = 0 (ground level)
-        // - Visible trails as if plowing through deep snow
-        // - Character walks on top of raised snow, trails show where they've been
-
-        // FUTURE ENHANCEMENT: Weight by snow texture coverage for gradual transitions
-        // This would require per-vertex texture blend weights from CPU:
-        // float snowWeight = getSnowCoverage(worldPos);  // 0.0 to 1.0
-        // vertex.z += (snowRaiseAmount * snowWeight) - (deformationDepth * snowWeight);
-        // This would allow smooth transitions between snow and non-snow areas
-    }
-    
+    vertex = applySnowDeformation(vertex);
 
+    // FUTURE ENHANCEMENT: Weight by snow texture coverage for gradual transitions
+    // This would require per-vertex texture blend weights from CPU:
+    // float snowWeight = getSnowCoverage(worldPos);  // 0.0 to 1.0
+    // vertex.z += (snowRaiseAmount * snowWeight) - (deformationDepth * snowWeight);
+    // This would allow smooth transitions between snow and non-snow areas
 
     gl_Position = modelToClip(vertex);
 
@@ -257,4 +237,5 @@ void main(void)
 #if (@shadows_enabled)
     setupShadowCoords(viewPos, viewNormal);
 #endif
+#endif // @snowTessellation
 }
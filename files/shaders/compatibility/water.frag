@@ -72,6 +72,11 @@ varying vec2 rippleMapUV;
 varying vec4 position;
 varying float linearDepth;
 
+#if @reflectionReprojection
+// position on the screen of the frame the reflection was last rendered in
+varying vec4 reflectionClipPos;
+#endif
+
 uniform sampler2D normalMap;
 
 uniform float osg_SimulationTime;
@@ -154,7 +159,12 @@ void main(void)
     screenCoordsOffset *= clamp(realWaterDepth / BUMP_SUPPRESS_DEPTH, 0.0, 1.0);
 #endif
     // reflection
-    vec3 reflection = sampleReflectionMap(screenCoords + screenCoordsOffset).rgb;
+#if @reflectionReprojection
+    vec2 reflectionCoords = reflectionClipPos.xy / reflectionClipPos.w * 0.5 + 0.5;
+#else
+    vec2 reflectionCoords = screenCoords;
+#endif
+    vec3 reflection = sampleReflectionMap(reflectionCoords + screenCoordsOffset).rgb;
 
     vec3 waterColor = WATER_COLOR * sunFade;
 
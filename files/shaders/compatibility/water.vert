@@ -14,6 +14,11 @@ uniform vec3 playerPos;
 varying vec3 worldPos;
 varying vec2 rippleMapUV;
 
+#if @reflectionReprojection
+uniform mat4 reflectionReprojection;
+varying vec4 reflectionClipPos;
+#endif
+
 void main(void)
 {
     gl_Position = modelToClip(gl_Vertex);
@@ -26,5 +31,9 @@ void main(void)
     vec4 viewPos = modelToView(gl_Vertex);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
 
+#if @reflectionReprojection
+    reflectionClipPos = reflectionReprojection * viewPos;
+#endif
+
     setupShadowCoords(viewPos, normalize((gl_NormalMatrix * gl_Normal).xyz));
 }
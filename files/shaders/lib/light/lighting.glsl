@@ -55,12 +55,22 @@ void doLighting(vec3 viewPos, vec3 viewNormal, float shininess, out vec3 diffuse
     specularLight = vec3(0.0);
 #endif
 
+#if @lightingMethodClustered
+    int cluster = lcalcCluster(viewPos);
+    int clusterLightCount = lcalcClusterValue(cluster, 0);
+    for (int i = 0; i < @maxLights; ++i)
+    {
+        if (i >= clusterLightCount)
+            break;
+        int lightIndex = lcalcClusterValue(cluster, i + 1);
+#else
     for (int i = @startLight; i < @endLight; ++i)
     {
 #if @lightingMethodUBO
         int lightIndex = PointLightIndex[i];
 #else
         int lightIndex = i;
+#endif
 #endif
         vec3 lightPos = lcalcPosition(lightIndex) - viewPos;
         float lightDistance = length(lightPos);
@@ -38,6 +38,32 @@ struct LightData
 uniform int PointLightIndex[@maxLights];
 uniform int PointLightCount;
 
+#if @lightingMethodClustered
+// Rows of light counts followed by light indices, see SceneUtil::LightClusters
+uniform sampler2D LightClusters;
+uniform mat4 LightClusterProjection;
+// Near plane and scale of the depth slices
+uniform vec2 LightClusterDepth;
+
+int lcalcCluster(vec3 viewPos)
+{
+    const vec2 size = vec2(@lightClusterSizeX, @lightClusterSizeY);
+    vec4 clip = LightClusterProjection * vec4(viewPos, 1.0);
+    vec2 tile = clamp(floor((clip.xy / clip.w * 0.5 + 0.5) * size), vec2(0.0), size - 1.0);
+    float slice = min(floor(log(max(-viewPos.z, LightClusterDepth.x) / LightClusterDepth.x) * LightClusterDepth.y), float(@lightClusterSizeZ - 1));
+    return int((slice * size.y + tile.y) * size.x + tile.x);
+}
+
+int lcalcClusterValue(int cluster, int column)
+{
+#if __VERSION__ >= 130
+    return int(texelFetch(LightClusters, ivec2(column, cluster), 0).r);
+#else
+    return int(texelFetch2D(LightClusters, ivec2(column, cluster), 0).r);
+#endif
+}
+#endif
+
 // Defaults to shared layout. If we ever move to GLSL 140, std140 layout should be considered
 uniform LightBufferBinding
 {
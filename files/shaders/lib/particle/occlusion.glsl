@@ -1,15 +1,19 @@
 #ifndef LIB_PARTICLE_OCCLUSION
 #define LIB_PARTICLE_OCCLUSION
 
-void applyOcclusionDiscard(in vec3 coord, float sceneDepth)
+bool isOccluded(in vec3 coord, float sceneDepth)
 {
 #if @reverseZ
-    if (coord.z < sceneDepth)
-        discard;
+    return coord.z < sceneDepth;
 #else
-    if (coord.z * 0.5 + 0.5 > sceneDepth)
-        discard;
+    return coord.z * 0.5 + 0.5 > sceneDepth;
 #endif
 }
 
+void applyOcclusionDiscard(in vec3 coord, float sceneDepth)
+{
+    if (isOccluded(coord, sceneDepth))
+        discard;
+}
+
 #endif
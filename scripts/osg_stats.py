@@ -7,6 +7,7 @@ set of keys over given range of frames.
 
 import click
 import collections
+import csv
 import json
 import matplotlib.pyplot
 import numpy
@@ -72,12 +73,14 @@ import termtables
               help='Threshold for hist_over.')
 @click.option('--show_common_path_prefix', is_flag=True,
               help='Show common path prefix when applied to multiple files.')
+@click.option('--export_csv', type=click.Path(), default=None,
+              help='Write values of all metrics per frame to a CSV file.')
 @click.argument('path', type=click.Path(), nargs=-1)
 def main(print_keys, regexp_match, timeseries, hist, hist_ratio, stdev_hist, plot, stats, precision,
          timeseries_sum, stats_sum, begin_frame, end_frame, path,
          cumulative_timeseries, cumulative_timeseries_sum, frame_number_name,
          hist_threshold, threshold_name, threshold_value, show_common_path_prefix, stats_sort_by,
-         timeseries_delta, timeseries_delta_sum, stats_table_format):
+         timeseries_delta, timeseries_delta_sum, stats_table_format, export_csv):
     sources = {v: list(read_data(v)) for v in path} if path else {'stdin': list(read_data(None))}
     if not show_common_path_prefix and len(sources) > 1:
         longest_common_prefix = os.path.commonprefix(list(sources.keys()))
@@ -117,6 +120,8 @@ def main(print_keys, regexp_match, timeseries, hist, hist_ratio, stdev_hist, plo
     if hist_threshold:
         draw_hist_threshold(sources=frames, keys=matching_keys(hist_threshold), begin_frame=begin_frame,
                             threshold_name=threshold_name, threshold_value=threshold_value)
+    if export_csv:
+        write_csv(sources=frames, keys=keys, begin_frame=begin_frame, path=export_csv)
     matplotlib.pyplot.show()
 
 
@@ -317,6 +322,21 @@ def print_stats(sources, keys, stats_sum, precision, sort_by, table_format):
         print(f'Unsupported table format: {table_format}')
 
 
+def write_csv(sources, keys, begin_frame, path):
+    with open(path, 'w', newline='') as stream:
+        writer = csv.writer(stream)
+        writer.writerow(['source', 'frame'] + keys)
+        for name, frames in sources.items():
+            length = max((len(frames[key]) for key in keys), default=0)
+            for index in range(length):
+                row = [name, begin_frame + index]
+                for key in keys:
+                    values = frames[key]
+                    value = values[index] if index < len(values) else None
+                    row.append('' if value is None else value)
+                writer.writerow(row)
+
+
 def draw_hist_threshold(sources, keys, begin_frame, threshold_name, threshold_value):
     for name, frames in sources.items():
         indices = [n for n, v in enumerate(frames[threshold_name]) if v > threshold_value]